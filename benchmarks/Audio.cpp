@@ -0,0 +1,58 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Benchmark.hpp"
+#include <SFML/Audio.hpp>
+
+
+namespace
+{
+    ////////////////////////////////////////////////////////////
+    // Decode a whole sound file from memory
+    ////////////////////////////////////////////////////////////
+    class AudioDecode : public Benchmark
+    {
+    public:
+
+        AudioDecode(const std::string& name, const std::string& filename) :
+        Benchmark(name, 0, "samples"),
+        m_filename(filename),
+        m_samples (4096)
+        {
+        }
+
+        virtual bool setup()
+        {
+            sf::InputSoundFile file;
+            if (!loadResource(m_filename, m_data) || !file.openFromMemory(&m_data[0], m_data.size()))
+                return false;
+
+            setItems(static_cast<double>(file.getSampleCount()));
+            return true;
+        }
+
+        virtual void run()
+        {
+            sf::InputSoundFile file;
+            file.openFromMemory(&m_data[0], m_data.size());
+            while (file.read(&m_samples[0], m_samples.size()) > 0)
+                keep(m_samples[0]);
+        }
+
+    private:
+
+        std::string            m_filename;
+        std::vector<char>      m_data;
+        std::vector<sf::Int16> m_samples;
+    };
+}
+
+
+////////////////////////////////////////////////////////////
+void addAudioBenchmarks(std::vector<Benchmark*>& benchmarks)
+{
+    benchmarks.push_back(new AudioDecode("audio/decode wav", "sound/resources/canary.wav"));
+    benchmarks.push_back(new AudioDecode("audio/decode flac", "sound/resources/ding.flac"));
+    benchmarks.push_back(new AudioDecode("audio/decode ogg", "sound/resources/orchestral.ogg"));
+}
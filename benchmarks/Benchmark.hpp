@@ -0,0 +1,124 @@
+
+#ifndef SFML_BENCHMARK_HPP
+#define SFML_BENCHMARK_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <string>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////
+/// Base class for benchmarks
+///
+/// A benchmark prepares its data in setup, then the runner
+/// calls run repeatedly and measures it.
+///
+////////////////////////////////////////////////////////////
+class Benchmark
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// Constructor
+    ///
+    /// \param name  Name of the benchmark, used to filter and report it
+    /// \param items Number of items processed by one run
+    /// \param unit  Name of the items, used to report the throughput
+    ///
+    ////////////////////////////////////////////////////////////
+    Benchmark(const std::string& name, double items, const std::string& unit) :
+    m_name (name),
+    m_items(items),
+    m_unit (unit)
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~Benchmark() {}
+
+    ////////////////////////////////////////////////////////////
+    /// Prepare the data of the benchmark
+    ///
+    /// \return False if the benchmark can't run
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool setup() {return true;}
+
+    ////////////////////////////////////////////////////////////
+    /// Run one iteration of the benchmark
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void run() = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// Release the data of the benchmark
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void teardown() {}
+
+    const std::string& getName() const {return m_name;}
+    double getItems() const {return m_items;}
+    const std::string& getUnit() const {return m_unit;}
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// Change the number of items processed by one run
+    ///
+    /// Useful when it depends on data loaded in setup.
+    ///
+    ////////////////////////////////////////////////////////////
+    void setItems(double items) {m_items = items;}
+
+private:
+
+    std::string m_name;  ///< Name of the benchmark
+    double      m_items; ///< Number of items processed by one run
+    std::string m_unit;  ///< Name of the items
+};
+
+////////////////////////////////////////////////////////////
+/// Read a file of the resources directory in memory
+///
+/// \param filename Path of the file, relative to the resources directory
+/// \param contents Receives the contents of the file
+///
+/// \return True on success
+///
+////////////////////////////////////////////////////////////
+bool loadResource(const std::string& filename, std::vector<char>& contents);
+
+////////////////////////////////////////////////////////////
+/// Get a deterministic pseudo-random number
+///
+/// The sequence is the same on every run and platform, so
+/// that the benchmarks process the same data every time.
+///
+/// \return Number in range [0, 2^31 - 1]
+///
+////////////////////////////////////////////////////////////
+sf::Uint32 nextRandom();
+
+////////////////////////////////////////////////////////////
+/// Make sure that the compiler doesn't optimize a result away
+///
+/// \param value Result of a computation
+///
+////////////////////////////////////////////////////////////
+void keep(double value);
+
+////////////////////////////////////////////////////////////
+// Functions adding the benchmarks of each module
+////////////////////////////////////////////////////////////
+void addAudioBenchmarks(std::vector<Benchmark*>& benchmarks);
+void addGraphicsBenchmarks(std::vector<Benchmark*>& benchmarks);
+void addNetworkBenchmarks(std::vector<Benchmark*>& benchmarks);
+
+
+#endif // SFML_BENCHMARK_HPP
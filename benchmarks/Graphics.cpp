@@ -0,0 +1,343 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Benchmark.hpp"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    ////////////////////////////////////////////////////////////
+    // Base class for the benchmarks that draw to an offscreen target
+    ////////////////////////////////////////////////////////////
+    class DrawBenchmark : public Benchmark
+    {
+    public:
+
+        DrawBenchmark(const std::string& name, double items, const std::string& unit) :
+        Benchmark(name, items, unit)
+        {
+        }
+
+        virtual bool setup()
+        {
+            return m_target.create(1024, 768);
+        }
+
+    protected:
+
+        sf::RenderTexture m_target;
+    };
+
+
+    ////////////////////////////////////////////////////////////
+    // Draw many small textured sprites
+    ////////////////////////////////////////////////////////////
+    class SpriteDraw : public DrawBenchmark
+    {
+    public:
+
+        SpriteDraw() :
+        DrawBenchmark("graphics/draw sprites", 10000, "sprites")
+        {
+        }
+
+        virtual bool setup()
+        {
+            if (!DrawBenchmark::setup() || !m_texture.create(32, 32))
+                return false;
+
+            m_sprites.resize(10000, sf::Sprite(m_texture));
+            for (std::size_t i = 0; i < m_sprites.size(); ++i)
+            {
+                m_sprites[i].setPosition(static_cast<float>(nextRandom() % 1000), static_cast<float>(nextRandom() % 750));
+                m_sprites[i].setRotation(static_cast<float>(nextRandom() % 360));
+            }
+            return true;
+        }
+
+        virtual void run()
+        {
+            m_target.clear();
+            for (std::size_t i = 0; i < m_sprites.size(); ++i)
+                m_target.draw(m_sprites[i]);
+            m_target.display();
+        }
+
+    private:
+
+        sf::Texture             m_texture;
+        std::vector<sf::Sprite> m_sprites;
+    };
+
+
+    ////////////////////////////////////////////////////////////
+    // Draw untextured circles and rectangles
+    ////////////////////////////////////////////////////////////
+    class ShapeDraw : public DrawBenchmark
+    {
+    public:
+
+        ShapeDraw() :
+        DrawBenchmark("graphics/draw shapes", 2000, "shapes")
+        {
+        }
+
+        virtual bool setup()
+        {
+            if (!DrawBenchmark::setup())
+                return false;
+
+            m_circles.resize(1000, sf::CircleShape(10.f, 30));
+            m_rectangles.resize(1000, sf::RectangleShape(sf::Vector2f(20.f, 10.f)));
+            for (std::size_t i = 0; i < 1000; ++i)
+            {
+                m_circles[i].setPosition(static_cast<float>(nextRandom() % 1000), static_cast<float>(nextRandom() % 750));
+                m_circles[i].setOutlineThickness(2.f);
+                m_rectangles[i].setPosition(static_cast<float>(nextRandom() % 1000), static_cast<float>(nextRandom() % 750));
+                m_rectangles[i].setFillColor(sf::Color(nextRandom() % 256, nextRandom() % 256, nextRandom() % 256));
+            }
+            return true;
+        }
+
+        virtual void run()
+        {
+            m_target.clear();
+            for (std::size_t i = 0; i < 1000; ++i)
+            {
+                m_target.draw(m_circles[i]);
+                m_target.draw(m_rectangles[i]);
+            }
+            m_target.display();
+        }
+
+    private:
+
+        std::vector<sf::CircleShape>    m_circles;
+        std::vector<sf::RectangleShape> m_rectangles;
+    };
+
+
+    ////////////////////////////////////////////////////////////
+    // Base class for the benchmarks that use a font
+    ////////////////////////////////////////////////////////////
+    class FontBenchmark : public DrawBenchmark
+    {
+    public:
+
+        FontBenchmark(const std::string& name, double items, const std::string& unit) :
+        DrawBenchmark(name, items, unit)
+        {
+        }
+
+        virtual bool setup()
+        {
+            // Build a long string of pseudo-random words
+            m_string.clear();
+            for (std::size_t i = 0; i < 1000; ++i)
+                m_string += (nextRandom() % 8 == 0) ? ((nextRandom() % 5 == 0) ? '\n' : ' ') : static_cast<char>('a' + nextRandom() % 26);
+
+            return DrawBenchmark::setup() && loadResource("pong/resources/sansation.ttf", m_fontData) &&
+                   m_font.loadFromMemory(&m_fontData[0], m_fontData.size());
+        }
+
+    protected:
+
+        std::vector<char> m_fontData;
+        sf::Font          m_font;
+        std::string       m_string;
+    };
+
+
+    ////////////////////////////////////////////////////////////
+    // Draw a text whose glyphs are already rasterized
+    ////////////////////////////////////////////////////////////
+    class TextDraw : public FontBenchmark
+    {
+    public:
+
+        TextDraw() :
+        FontBenchmark("graphics/draw text", 1000, "characters")
+        {
+        }
+
+        virtual bool setup()
+        {
+            if (!FontBenchmark::setup())
+                return false;
+
+            m_text.setFont(m_font);
+            m_text.setString(m_string);
+            m_text.setCharacterSize(16);
+            return true;
+        }
+
+        virtual void run()
+        {
+            m_target.clear();
+            m_target.draw(m_text);
+            m_target.display();
+        }
+
+    private:
+
+        sf::Text m_text;
+    };
+
+
+    ////////////////////////////////////////////////////////////
+    // Rebuild the geometry of a text after its string changes
+    ////////////////////////////////////////////////////////////
+    class TextGeometry : public FontBenchmark
+    {
+    public:
+
+        TextGeometry() :
+        FontBenchmark("graphics/text geometry update", 1000, "characters"),
+        m_flip(false)
+        {
+        }
+
+        virtual bool setup()
+        {
+            if (!FontBenchmark::setup())
+                return false;
+
+            m_other = m_string;
+            std::reverse(m_other.begin(), m_other.end());
+            m_text.setFont(m_font);
+            m_text.setCharacterSize(16);
+            return true;
+        }
+
+        virtual void run()
+        {
+            m_flip = !m_flip;
+            m_text.setString(m_flip ? m_string : m_other);
+            keep(m_text.getLocalBounds().width);
+        }
+
+    private:
+
+        sf::Text    m_text;
+        std::string m_other;
+        bool        m_flip;
+    };
+
+
+    ////////////////////////////////////////////////////////////
+    // Rasterize glyphs that are not in the cache yet
+    ////////////////////////////////////////////////////////////
+    class GlyphRasterization : public FontBenchmark
+    {
+    public:
+
+        GlyphRasterization() :
+        FontBenchmark("graphics/glyph rasterization", 94, "glyphs")
+        {
+        }
+
+        virtual void run()
+        {
+            // A new font starts with an empty cache
+            sf::Font font;
+            font.loadFromMemory(&m_fontData[0], m_fontData.size());
+            for (sf::Uint32 character = 33; character < 127; ++character)
+                keep(font.getGlyph(character, 32, false).advance);
+        }
+    };
+
+
+    ////////////////////////////////////////////////////////////
+    // Decode an image file from memory
+    ////////////////////////////////////////////////////////////
+    class ImageDecode : public Benchmark
+    {
+    public:
+
+        ImageDecode(const std::string& name, const std::string& filename) :
+        Benchmark(name, 0, "pixels"),
+        m_filename(filename)
+        {
+        }
+
+        virtual bool setup()
+        {
+            if (!loadResource(m_filename, m_data))
+                return false;
+
+            // Report the throughput in decoded pixels
+            sf::Image image;
+            if (!image.loadFromMemory(&m_data[0], m_data.size()))
+                return false;
+
+            setItems(image.getSize().x * image.getSize().y);
+            return true;
+        }
+
+        virtual void run()
+        {
+            sf::Image image;
+            image.loadFromMemory(&m_data[0], m_data.size());
+            keep(image.getSize().x);
+        }
+
+    private:
+
+        std::string       m_filename;
+        std::vector<char> m_data;
+    };
+
+
+    ////////////////////////////////////////////////////////////
+    // Copy an image into another one
+    ////////////////////////////////////////////////////////////
+    class ImageCopy : public Benchmark
+    {
+    public:
+
+        ImageCopy(const std::string& name, bool applyAlpha) :
+        Benchmark(name, 1024 * 1024, "pixels"),
+        m_applyAlpha(applyAlpha)
+        {
+        }
+
+        virtual bool setup()
+        {
+            m_source.create(1024, 1024);
+            for (unsigned int y = 0; y < 1024; ++y)
+                for (unsigned int x = 0; x < 1024; ++x)
+                    m_source.setPixel(x, y, sf::Color(nextRandom() % 256, nextRandom() % 256, nextRandom() % 256, nextRandom() % 256));
+            m_destination.create(1024, 1024, sf::Color::Blue);
+            return true;
+        }
+
+        virtual void run()
+        {
+            m_destination.copy(m_source, 0, 0, sf::IntRect(0, 0, 0, 0), m_applyAlpha);
+        }
+
+    private:
+
+        sf::Image m_source;
+        sf::Image m_destination;
+        bool      m_applyAlpha;
+    };
+}
+
+
+////////////////////////////////////////////////////////////
+void addGraphicsBenchmarks(std::vector<Benchmark*>& benchmarks)
+{
+    benchmarks.push_back(new SpriteDraw);
+    benchmarks.push_back(new ShapeDraw);
+    benchmarks.push_back(new TextDraw);
+    benchmarks.push_back(new TextGeometry);
+    benchmarks.push_back(new GlyphRasterization);
+    benchmarks.push_back(new ImageDecode("graphics/image decode png", "shader/resources/sfml.png"));
+    benchmarks.push_back(new ImageDecode("graphics/image decode jpg", "shader/resources/background.jpg"));
+    benchmarks.push_back(new ImageCopy("graphics/image copy", false));
+    benchmarks.push_back(new ImageCopy("graphics/image copy alpha", true));
+}
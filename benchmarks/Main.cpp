@@ -0,0 +1,134 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Benchmark.hpp"
+#include <SFML/System.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+
+namespace
+{
+    std::string resourcesPath = SFML_BENCHMARK_RESOURCES;
+    sf::Uint32 randomState = 12345;
+    volatile double sink = 0;
+
+    // Duration of each measured sample, and number of samples
+    const sf::Time sampleDuration = sf::milliseconds(50);
+    const std::size_t sampleCount = 15;
+
+    // Run a benchmark until it has been measured enough, and report the results
+    void measure(Benchmark& benchmark)
+    {
+        // Warm up the caches and find how many iterations fill a sample
+        sf::Clock clock;
+        sf::Uint64 iterations = 0;
+        while ((clock.getElapsedTime() < sampleDuration) || (iterations == 0))
+        {
+            benchmark.run();
+            ++iterations;
+        }
+
+        // Measure the samples, the median is robust to the noise of the system
+        std::vector<double> samples;
+        for (std::size_t i = 0; i < sampleCount; ++i)
+        {
+            clock.restart();
+            for (sf::Uint64 j = 0; j < iterations; ++j)
+                benchmark.run();
+            samples.push_back(clock.getElapsedTime().asMicroseconds() / static_cast<double>(iterations));
+        }
+        std::sort(samples.begin(), samples.end());
+        double median = samples[samples.size() / 2];
+
+        std::printf("%-36s %12.2f us %12.2f us", benchmark.getName().c_str(), median, samples.front());
+        if ((benchmark.getItems() > 0) && (median > 0))
+            std::printf(" %14.0f %s/s", benchmark.getItems() * 1000000.0 / median, benchmark.getUnit().c_str());
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool loadResource(const std::string& filename, std::vector<char>& contents)
+{
+    std::ifstream file((resourcesPath + "/" + filename).c_str(), std::ios_base::binary);
+    if (!file)
+    {
+        std::cerr << "Failed to load resource \"" << filename << "\"" << std::endl;
+        return false;
+    }
+
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return !contents.empty();
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint32 nextRandom()
+{
+    randomState = randomState * 1103515245 + 12345;
+    return (randomState >> 1) & 0x7FFFFFFF;
+}
+
+
+////////////////////////////////////////////////////////////
+void keep(double value)
+{
+    sink = sink + value;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// Usage: benchmarks [filter] [resources directory]
+///
+/// Only the benchmarks whose name contains the filter are run.
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    std::string filter = argc > 1 ? argv[1] : "";
+    if (argc > 2)
+        resourcesPath = argv[2];
+
+    std::vector<Benchmark*> benchmarks;
+    addAudioBenchmarks(benchmarks);
+    addGraphicsBenchmarks(benchmarks);
+    addNetworkBenchmarks(benchmarks);
+
+    std::printf("%-36s %15s %15s %16s\n", "benchmark", "median", "min", "throughput");
+
+    int result = EXIT_SUCCESS;
+    for (std::vector<Benchmark*>::iterator it = benchmarks.begin(); it != benchmarks.end(); ++it)
+    {
+        Benchmark& benchmark = **it;
+        if (benchmark.getName().find(filter) != std::string::npos)
+        {
+            // Every benchmark sees the same pseudo-random sequence
+            randomState = 12345;
+
+            if (benchmark.setup())
+            {
+                measure(benchmark);
+                benchmark.teardown();
+            }
+            else
+            {
+                std::printf("%-36s %15s\n", benchmark.getName().c_str(), "skipped");
+                result = EXIT_FAILURE;
+            }
+        }
+        delete &benchmark;
+    }
+
+    return result;
+}
@@ -0,0 +1,209 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Benchmark.hpp"
+#include <SFML/Network.hpp>
+
+
+namespace
+{
+    ////////////////////////////////////////////////////////////
+    // Serialize mixed values into a packet
+    ////////////////////////////////////////////////////////////
+    class PacketEncode : public Benchmark
+    {
+    public:
+
+        PacketEncode() :
+        Benchmark("network/packet encode", 4000, "values")
+        {
+        }
+
+        virtual void run()
+        {
+            m_packet.clear();
+            for (sf::Uint32 i = 0; i < 1000; ++i)
+                m_packet << i << static_cast<sf::Int16>(i) << static_cast<float>(i) * 0.5f << "value";
+            keep(static_cast<double>(m_packet.getDataSize()));
+        }
+
+    private:
+
+        sf::Packet m_packet;
+    };
+
+
+    ////////////////////////////////////////////////////////////
+    // Deserialize mixed values from a packet
+    ////////////////////////////////////////////////////////////
+    class PacketDecode : public Benchmark
+    {
+    public:
+
+        PacketDecode() :
+        Benchmark("network/packet decode", 4000, "values")
+        {
+        }
+
+        virtual bool setup()
+        {
+            for (sf::Uint32 i = 0; i < 1000; ++i)
+                m_source << i << static_cast<sf::Int16>(i) << static_cast<float>(i) * 0.5f << "value";
+            return true;
+        }
+
+        virtual void run()
+        {
+            sf::Packet packet;
+            packet.append(m_source.getData(), m_source.getDataSize());
+
+            sf::Uint32 integer;
+            sf::Int16 shortInteger;
+            float real;
+            std::string string;
+            for (sf::Uint32 i = 0; i < 1000; ++i)
+                packet >> integer >> shortInteger >> real >> string;
+            keep(integer + real);
+        }
+
+    private:
+
+        sf::Packet m_source;
+    };
+
+
+    ////////////////////////////////////////////////////////////
+    // Stream bytes through a TCP connection on the loopback interface
+    ////////////////////////////////////////////////////////////
+    class TcpThroughput : public Benchmark
+    {
+    public:
+
+        TcpThroughput() :
+        Benchmark("network/tcp loopback", 4 * 1024 * 1024, "bytes"),
+        m_sender(&TcpThroughput::send, this),
+        m_buffer(64 * 1024)
+        {
+        }
+
+        virtual bool setup()
+        {
+            sf::TcpListener listener;
+            if (listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) != sf::Socket::Done)
+                return false;
+            if (m_client.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) != sf::Socket::Done)
+                return false;
+            return listener.accept(m_server) == sf::Socket::Done;
+        }
+
+        virtual void run()
+        {
+            // Receive everything the sender thread sends
+            m_sender.launch();
+            std::size_t total = 0;
+            while (total < m_buffer.size() * 64)
+            {
+                std::size_t received = 0;
+                if (m_server.receive(&m_buffer[0], m_buffer.size(), received) != sf::Socket::Done)
+                    break;
+                total += received;
+            }
+            m_sender.wait();
+        }
+
+        virtual void teardown()
+        {
+            m_client.disconnect();
+            m_server.disconnect();
+        }
+
+    private:
+
+        void send()
+        {
+            std::vector<char> data(m_buffer.size());
+            for (std::size_t i = 0; i < 64; ++i)
+                m_client.send(&data[0], data.size());
+        }
+
+        sf::TcpSocket     m_client;
+        sf::TcpSocket     m_server;
+        sf::Thread        m_sender;
+        std::vector<char> m_buffer;
+    };
+
+
+    ////////////////////////////////////////////////////////////
+    // Exchange datagrams with an echo thread on the loopback interface
+    ////////////////////////////////////////////////////////////
+    class UdpRoundTrip : public Benchmark
+    {
+    public:
+
+        UdpRoundTrip() :
+        Benchmark("network/udp loopback round trips", 100, "round trips"),
+        m_echo(&UdpRoundTrip::echo, this)
+        {
+        }
+
+        virtual bool setup()
+        {
+            if ((m_client.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) != sf::Socket::Done) ||
+                (m_server.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) != sf::Socket::Done))
+                return false;
+
+            m_echo.launch();
+            return true;
+        }
+
+        virtual void run()
+        {
+            char data[512] = {1};
+            for (int i = 0; i < 100; ++i)
+            {
+                std::size_t received;
+                sf::IpAddress address;
+                unsigned short port;
+                m_client.send(data, sizeof(data), sf::IpAddress::LocalHost, m_server.getLocalPort());
+                m_client.receive(data, sizeof(data), received, address, port);
+            }
+        }
+
+        virtual void teardown()
+        {
+            // A short datagram stops the echo thread
+            char stop = 0;
+            m_client.send(&stop, 1, sf::IpAddress::LocalHost, m_server.getLocalPort());
+            m_echo.wait();
+            m_client.unbind();
+            m_server.unbind();
+        }
+
+    private:
+
+        void echo()
+        {
+            char data[512];
+            std::size_t received = 0;
+            sf::IpAddress address;
+            unsigned short port;
+            while ((m_server.receive(data, sizeof(data), received, address, port) == sf::Socket::Done) && (received == sizeof(data)))
+                m_server.send(data, received, address, port);
+        }
+
+        sf::UdpSocket m_client;
+        sf::UdpSocket m_server;
+        sf::Thread    m_echo;
+    };
+}
+
+
+////////////////////////////////////////////////////////////
+void addNetworkBenchmarks(std::vector<Benchmark*>& benchmarks)
+{
+    benchmarks.push_back(new PacketEncode);
+    benchmarks.push_back(new PacketDecode);
+    benchmarks.push_back(new TcpThroughput);
+    benchmarks.push_back(new UdpRoundTrip);
+}
@@ -7,8 +7,13 @@
 # GLES_LIBRARY
 #
 
-find_path(GLES_INCLUDE_DIR GLES/gl.h)
-find_library(GLES_LIBRARY NAMES GLESv1_CM)
+if(SFML_OPENGL_ES2)
+    find_path(GLES_INCLUDE_DIR GLES2/gl2.h)
+    find_library(GLES_LIBRARY NAMES GLESv2)
+else()
+    find_path(GLES_INCLUDE_DIR GLES/gl.h)
+    find_library(GLES_LIBRARY NAMES GLESv1_CM)
+endif()
 
 include(FindPackageHandleStandardArgs)
 find_package_handle_standard_args(GLES DEFAULT_MSG GLES_LIBRARY GLES_INCLUDE_DIR)
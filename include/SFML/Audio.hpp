@@ -30,19 +30,32 @@
 ////////////////////////////////////////////////////////////
 
 #include <SFML/System.hpp>
+#include <SFML/Audio/AudioBus.hpp>
+#include <SFML/Audio/AudioMixer.hpp>
+#include <SFML/Audio/AudioStatistics.hpp>
+#include <SFML/Audio/BusSound.hpp>
+#include <SFML/Audio/CompressedSoundBuffer.hpp>
+#include <SFML/Audio/DuplexStream.hpp>
 #include <SFML/Audio/InputSoundFile.hpp>
 #include <SFML/Audio/Listener.hpp>
 #include <SFML/Audio/Music.hpp>
 #include <SFML/Audio/OutputSoundFile.hpp>
+#include <SFML/Audio/Playlist.hpp>
 #include <SFML/Audio/Sound.hpp>
+#include <SFML/Audio/SoundAtlas.hpp>
 #include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/Audio/SoundBufferLoadQueue.hpp>
 #include <SFML/Audio/SoundBufferRecorder.hpp>
 #include <SFML/Audio/SoundFileFactory.hpp>
 #include <SFML/Audio/SoundFileReader.hpp>
 #include <SFML/Audio/SoundFileWriter.hpp>
+#include <SFML/Audio/SoundQueueRecorder.hpp>
 #include <SFML/Audio/SoundRecorder.hpp>
 #include <SFML/Audio/SoundSource.hpp>
 #include <SFML/Audio/SoundStream.hpp>
+#include <SFML/Audio/VirtualSound.hpp>
+#include <SFML/Audio/VoiceManager.hpp>
+#include <SFML/Audio/VoicePool.hpp>
 
 
 #endif // SFML_AUDIO_HPP
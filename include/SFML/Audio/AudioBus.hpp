@@ -0,0 +1,264 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_AUDIOBUS_HPP
+#define SFML_AUDIOBUS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+    class Reverb;
+}
+
+class AudioMixer;
+class BusSound;
+
+////////////////////////////////////////////////////////////
+/// \brief Node of the software mixer, which mixes its inputs and applies effects to them
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API AudioBus : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a bus of a mixer
+    ///
+    /// The new bus feeds the master bus of the mixer, call
+    /// setOutput to connect it to another bus.
+    ///
+    /// \param mixer Mixer that the bus belongs to
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit AudioBus(AudioMixer& mixer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The inputs of the bus (sounds and other buses) are
+    /// connected to its output bus.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~AudioBus();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the bus receiving the output of this one
+    ///
+    /// The output bus must belong to the same mixer, and must
+    /// not be fed by this bus (directly or not). The output of
+    /// the master bus can't be changed.
+    ///
+    /// \param output New output bus
+    ///
+    /// \see getOutput
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOutput(AudioBus& output);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bus receiving the output of this one
+    ///
+    /// \return Output bus, or NULL for the master bus
+    ///
+    /// \see setOutput
+    ///
+    ////////////////////////////////////////////////////////////
+    AudioBus* getOutput() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the volume of the bus
+    ///
+    /// The volume is applied after the effects, like
+    /// sf::SoundSource::setVolume it's a value between
+    /// 0 (mute) and 100 (full volume, the default).
+    ///
+    /// \param volume Volume of the bus
+    ///
+    /// \see getVolume
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVolume(float volume);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the volume of the bus
+    ///
+    /// \return Volume of the bus, in the range [0, 100]
+    ///
+    /// \see setVolume
+    ///
+    ////////////////////////////////////////////////////////////
+    float getVolume() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the cutoff frequency of the low-pass filter
+    ///
+    /// The filter attenuates the frequencies above the cutoff,
+    /// which muffles the sound (occlusion, underwater, ...).
+    /// A cutoff of 0, the default, disables the filter.
+    ///
+    /// \param frequency Cutoff frequency, in Hz
+    ///
+    /// \see getLowPass
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLowPass(float frequency);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the cutoff frequency of the low-pass filter
+    ///
+    /// \return Cutoff frequency, in Hz (0 if the filter is disabled)
+    ///
+    /// \see setLowPass
+    ///
+    ////////////////////////////////////////////////////////////
+    float getLowPass() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the parameters of the reverb
+    ///
+    /// A wet proportion of 0, the default, disables the reverb.
+    ///
+    /// \param wet      Proportion of reverberated signal, in [0, 1]
+    /// \param roomSize Size of the simulated room, in [0, 1]
+    ///
+    /// \see getReverbWet, getReverbRoomSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setReverb(float wet, float roomSize = 0.5f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the proportion of reverberated signal
+    ///
+    /// \return Wet proportion of the reverb, in [0, 1]
+    ///
+    /// \see setReverb
+    ///
+    ////////////////////////////////////////////////////////////
+    float getReverbWet() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the room simulated by the reverb
+    ///
+    /// \return Room size, in [0, 1]
+    ///
+    /// \see setReverb
+    ///
+    ////////////////////////////////////////////////////////////
+    float getReverbRoomSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the mixer that this bus belongs to
+    ///
+    /// \return Mixer playing the output of the bus
+    ///
+    ////////////////////////////////////////////////////////////
+    AudioMixer& getMixer() const;
+
+private:
+
+    friend class AudioMixer;
+    friend class BusSound;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether this bus feeds another one, directly or not
+    ///
+    /// \param bus Bus to look for
+    ///
+    /// \return True if the output of this bus reaches \a bus
+    ///
+    ////////////////////////////////////////////////////////////
+    bool feeds(const AudioBus& bus) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mix the inputs, apply the effects and add the result to an output block
+    ///
+    /// \param output     Interleaved samples to mix into
+    /// \param frameCount Number of frames to process
+    ///
+    ////////////////////////////////////////////////////////////
+    void process(float* output, std::size_t frameCount);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    AudioMixer&            m_mixer;     ///< Mixer that the bus belongs to
+    AudioBus*              m_output;    ///< Bus receiving the output of this one (NULL for the master bus)
+    std::vector<AudioBus*> m_buses;     ///< Buses feeding this one
+    std::vector<BusSound*> m_sounds;    ///< Sounds feeding this one
+    float                  m_volume;    ///< Volume of the bus
+    float                  m_cutoff;    ///< Cutoff frequency of the low-pass filter
+    std::vector<float>     m_lowPass;   ///< State of the low-pass filter, for each channel
+    float                  m_reverbWet; ///< Proportion of reverberated signal
+    float                  m_roomSize;  ///< Size of the room simulated by the reverb
+    priv::Reverb*          m_reverb;    ///< State of the reverb (allocated when enabled)
+    std::vector<float>     m_block;     ///< Block of samples mixed by the bus
+};
+
+} // namespace sf
+
+
+#endif // SFML_AUDIOBUS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::AudioBus
+/// \ingroup audio
+///
+/// Buses form the graph of a sf::AudioMixer: sf::BusSound
+/// instances and other buses feed a bus, which mixes them,
+/// applies its effects (low-pass filter, reverb) and volume,
+/// and adds the result to its output bus. The master bus of
+/// the mixer is the root of the graph.
+///
+/// Grouping sounds in buses allows controlling whole categories
+/// at once, for example the volume of all the sound effects, or
+/// a reverb applied to the sounds of a cave only.
+///
+/// Usage example:
+/// \code
+/// sf::AudioMixer mixer;
+/// sf::AudioBus effects(mixer);
+/// sf::AudioBus cave(mixer);
+/// cave.setOutput(effects);
+/// cave.setReverb(0.4f, 0.8f);
+/// effects.setVolume(60);
+///
+/// sf::BusSound drop(cave, dropBuffer);
+/// drop.play();
+/// mixer.play();
+/// \endcode
+///
+/// \see sf::AudioMixer, sf::BusSound
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_AUDIOMIXER_HPP
+#define SFML_AUDIOMIXER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/AudioBus.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Software mixer playing a graph of buses through a single stream
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API AudioMixer : public SoundStream
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param channelCount Number of channels of the mixed output
+    /// \param sampleRate   Sample rate of the mixed output
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit AudioMixer(unsigned int channelCount = 2, unsigned int sampleRate = 44100);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// All the buses and sounds of the mixer must be
+    /// destroyed before the mixer itself.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~AudioMixer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the master bus of the mixer
+    ///
+    /// The master bus is the root of the graph: its output
+    /// is what the mixer plays.
+    ///
+    /// \return Master bus
+    ///
+    ////////////////////////////////////////////////////////////
+    AudioBus& getMaster();
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request a new chunk of audio samples from the stream source
+    ///
+    /// This function mixes the graph of buses for the
+    /// duration of a buffer.
+    ///
+    /// \param data Chunk of data to fill
+    ///
+    /// \return Always true, the mixer plays until it is stopped
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onGetData(Chunk& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current playing position in the stream source
+    ///
+    /// The mixer has no position: this function does nothing.
+    ///
+    /// \param timeOffset New playing position
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onSeek(Time timeOffset);
+
+private:
+
+    friend class AudioBus;
+    friend class BusSound;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Mutex              m_mutex;   ///< Mutex protecting the graph, shared by all its buses and sounds
+    AudioBus           m_master;  ///< Root bus of the graph
+    std::vector<float> m_samples; ///< Mixed samples
+};
+
+} // namespace sf
+
+
+#endif // SFML_AUDIOMIXER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::AudioMixer
+/// \ingroup audio
+///
+/// sf::AudioMixer mixes sounds on the CPU and plays the result
+/// through a single sound stream, so that hundreds of sounds
+/// can be played at once while OpenAL only sees one source.
+/// The sounds (sf::BusSound) are grouped into a graph of
+/// sf::AudioBus, each bus applying its own volume and effects
+/// before passing the result to its output bus, up to the
+/// master bus of the mixer.
+///
+/// Mixing happens in the streaming thread, block by block
+/// (a block being a buffer of the stream), with the inner
+/// loops vectorized when SSE or NEON are available. The
+/// samples are mixed as floats and played as such when the
+/// audio device supports it.
+///
+/// The mixer is a sound stream: it is started with play(),
+/// and its volume, position, etc. can be changed like those
+/// of any other source. Its buffers are short (20 ms, see
+/// setBufferDuration) so that changes of the graph are heard
+/// quickly.
+///
+/// Usage example:
+/// \code
+/// sf::AudioMixer mixer;
+/// mixer.play();
+///
+/// std::vector<sf::BusSound*> footsteps;
+/// for (int i = 0; i < 200; ++i)
+///     footsteps.push_back(new sf::BusSound(mixer.getMaster(), stepBuffer));
+/// ...
+/// \endcode
+///
+/// \see sf::AudioBus, sf::BusSound
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_AUDIOSTATISTICS_HPP
+#define SFML_AUDIOSTATISTICS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Global counters of the audio module
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API AudioStatistics
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Global audio counters
+    ///
+    /// \see getCounters
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Counters
+    {
+        Uint64       alCalls;        ///< Number of OpenAL calls, counted while enabled
+        unsigned int sources;        ///< Number of existing sound sources
+        unsigned int playingSources; ///< Number of sound sources currently playing
+        unsigned int streams;        ///< Number of sound streams currently streaming
+        Uint32       underruns;      ///< Number of times a sound stream ran out of data
+        Uint64       chunks;         ///< Number of chunks requested by the sound streams
+        Time         decodeTime;     ///< Total time spent by the sound streams producing chunks
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the counting of OpenAL calls
+    ///
+    /// Counting OpenAL calls adds a small cost to each of
+    /// them, so it is disabled by default. The other counters
+    /// are always maintained.
+    ///
+    /// \param enabled True to count OpenAL calls, false to stop
+    ///
+    /// \see isEnabled, getCounters
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether OpenAL calls are counted
+    ///
+    /// \return True if OpenAL calls are counted
+    ///
+    /// \see setEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isEnabled();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current value of the counters
+    ///
+    /// The number of sources, playing sources and streams is
+    /// the current state; the other counters accumulate until
+    /// resetCounters is called.
+    ///
+    /// \return Current counters
+    ///
+    /// \see resetCounters
+    ///
+    ////////////////////////////////////////////////////////////
+    static Counters getCounters();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the accumulated counters to zero
+    ///
+    /// \see getCounters
+    ///
+    ////////////////////////////////////////////////////////////
+    static void resetCounters();
+};
+
+} // namespace sf
+
+
+#endif // SFML_AUDIOSTATISTICS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::AudioStatistics
+/// \ingroup audio
+///
+/// sf::AudioStatistics gives an overview of the activity of
+/// the audio module: how many sources exist and play, how
+/// often the sound streams run out of data (an underrun is
+/// heard as a gap in the sound), how long they take to decode
+/// their chunks, and how many OpenAL calls are made. It is
+/// meant to feed profiling tools and debug overlays.
+///
+/// Statistics of a single stream are available with
+/// sf::SoundStream::getStatistics.
+///
+/// Usage example:
+/// \code
+/// sf::AudioStatistics::setEnabled(true);
+///
+/// // Once per second
+/// sf::AudioStatistics::Counters counters = sf::AudioStatistics::getCounters();
+/// std::cout << counters.playingSources << " sources playing, "
+///           << counters.underruns << " underruns, "
+///           << counters.alCalls << " OpenAL calls" << std::endl;
+/// sf::AudioStatistics::resetCounters();
+/// \endcode
+///
+/// \see sf::SoundStream
+///
+////////////////////////////////////////////////////////////
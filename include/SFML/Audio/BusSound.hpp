@@ -0,0 +1,339 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_BUSSOUND_HPP
+#define SFML_BUSSOUND_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundSource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+class AudioBus;
+class SoundBuffer;
+
+////////////////////////////////////////////////////////////
+/// \brief Sound played by the software mixer
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API BusSound : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the sound with a bus
+    ///
+    /// \param bus Bus to feed
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit BusSound(AudioBus& bus);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the sound with a bus and a buffer
+    ///
+    /// \param bus    Bus to feed
+    /// \param buffer Sound buffer containing the audio data to play
+    ///
+    ////////////////////////////////////////////////////////////
+    BusSound(AudioBus& bus, const SoundBuffer& buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~BusSound();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start or resume playing the sound
+    ///
+    /// \see pause, stop
+    ///
+    ////////////////////////////////////////////////////////////
+    void play();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pause the sound
+    ///
+    /// \see play, stop
+    ///
+    ////////////////////////////////////////////////////////////
+    void pause();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop playing the sound, and rewind it
+    ///
+    /// \see play, pause
+    ///
+    ////////////////////////////////////////////////////////////
+    void stop();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the source buffer containing the audio data to play
+    ///
+    /// The mixer reads the samples kept in memory by the
+    /// buffer, which must not release them (see
+    /// SoundBuffer::releaseSamples). The buffer must remain
+    /// alive as long as the sound uses it. Its channel count
+    /// and sample rate may differ from the ones of the mixer,
+    /// the sound is converted on the fly.
+    ///
+    /// \param buffer Sound buffer to attach to the sound
+    ///
+    /// \see getBuffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBuffer(const SoundBuffer& buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the audio buffer attached to the sound
+    ///
+    /// \return Sound buffer attached to the sound (can be NULL)
+    ///
+    ////////////////////////////////////////////////////////////
+    const SoundBuffer* getBuffer() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the bus fed by the sound
+    ///
+    /// The new bus must belong to the same mixer.
+    ///
+    /// \param bus New bus
+    ///
+    /// \see getBus
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBus(AudioBus& bus);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bus fed by the sound
+    ///
+    /// \return Bus of the sound
+    ///
+    /// \see setBus
+    ///
+    ////////////////////////////////////////////////////////////
+    AudioBus& getBus() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set whether or not the sound should loop after reaching the end
+    ///
+    /// \param loop True to play in loop, false to play once
+    ///
+    /// \see getLoop
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLoop(bool loop);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the sound is in loop mode
+    ///
+    /// \return True if the sound is looping, false otherwise
+    ///
+    /// \see setLoop
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getLoop() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the pitch of the sound
+    ///
+    /// Like for sf::SoundSource, the pitch changes both the
+    /// speed and the tone of the sound. The default pitch is 1.
+    ///
+    /// \param pitch New pitch to apply to the sound
+    ///
+    /// \see getPitch
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPitch(float pitch);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the pitch of the sound
+    ///
+    /// \return Pitch of the sound
+    ///
+    /// \see setPitch
+    ///
+    ////////////////////////////////////////////////////////////
+    float getPitch() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the volume of the sound
+    ///
+    /// The volume is a value between 0 (mute) and 100
+    /// (full volume and default value).
+    ///
+    /// \param volume Volume of the sound
+    ///
+    /// \see getVolume
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVolume(float volume);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the volume of the sound
+    ///
+    /// \return Volume of the sound, in the range [0, 100]
+    ///
+    /// \see setVolume
+    ///
+    ////////////////////////////////////////////////////////////
+    float getVolume() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the stereo balance of the sound
+    ///
+    /// The balance goes from -1 (left only) to 1 (right only),
+    /// 0 being the center and the default. It has no effect
+    /// if the mixer doesn't output stereo.
+    ///
+    /// \param pan Balance of the sound
+    ///
+    /// \see getPan
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPan(float pan);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the stereo balance of the sound
+    ///
+    /// \return Balance of the sound, in the range [-1, 1]
+    ///
+    /// \see setPan
+    ///
+    ////////////////////////////////////////////////////////////
+    float getPan() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current playing position of the sound
+    ///
+    /// \param timeOffset New playing position, from the beginning of the sound
+    ///
+    /// \see getPlayingOffset
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPlayingOffset(Time timeOffset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current playing position of the sound
+    ///
+    /// \return Current playing position, from the beginning of the sound
+    ///
+    /// \see setPlayingOffset
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getPlayingOffset() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current status of the sound (stopped, paused, playing)
+    ///
+    /// \return Current status of the sound
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundSource::Status getStatus() const;
+
+private:
+
+    friend class AudioBus;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render the sound and add it to an output block
+    ///
+    /// \param output       Interleaved samples to mix into
+    /// \param frameCount   Number of frames to process
+    /// \param channelCount Number of channels of the output
+    /// \param sampleRate   Sample rate of the output
+    ///
+    ////////////////////////////////////////////////////////////
+    void process(float* output, std::size_t frameCount, unsigned int channelCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a sample of the buffer
+    ///
+    /// \param frame   Index of the frame
+    /// \param channel Channel of the sample
+    ///
+    /// \return Normalized sample
+    ///
+    ////////////////////////////////////////////////////////////
+    float getSample(std::size_t frame, unsigned int channel) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    AudioBus*           m_bus;          ///< Bus fed by the sound
+    const SoundBuffer*  m_buffer;       ///< Sound buffer played by the sound
+    const Int16*        m_samples;      ///< Samples of the buffer, if they are stored as integers
+    const float*        m_floatSamples; ///< Samples of the buffer, if they are stored as floats
+    std::size_t         m_frameCount;   ///< Number of frames in the buffer
+    unsigned int        m_channelCount; ///< Number of channels of the buffer
+    unsigned int        m_sampleRate;   ///< Sample rate of the buffer
+    double              m_position;     ///< Playing position, in frames of the buffer
+    SoundSource::Status m_status;       ///< Current status of the sound
+    bool                m_loop;         ///< Loop mode
+    float               m_pitch;        ///< Pitch of the sound
+    float               m_volume;       ///< Volume of the sound
+    float               m_pan;          ///< Stereo balance of the sound
+    std::vector<float>  m_block;        ///< Block of rendered samples
+};
+
+} // namespace sf
+
+
+#endif // SFML_BUSSOUND_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::BusSound
+/// \ingroup audio
+///
+/// sf::BusSound plays a sf::SoundBuffer through a sf::AudioMixer,
+/// instead of using an OpenAL source of its own like sf::Sound:
+/// the sound is resampled and mixed on the CPU into its bus.
+/// This makes it possible to play many more sounds at once than
+/// the audio device allows, and to apply the effects of the
+/// buses to them. 3D spatialization is replaced with a simple
+/// stereo balance (setPan).
+///
+/// Usage example:
+/// \code
+/// sf::AudioMixer mixer;
+/// mixer.play();
+///
+/// sf::BusSound sound(mixer.getMaster(), buffer);
+/// sound.setPan(-0.5f);
+/// sound.play();
+/// \endcode
+///
+/// \see sf::AudioMixer, sf::AudioBus, sf::Sound
+///
+////////////////////////////////////////////////////////////
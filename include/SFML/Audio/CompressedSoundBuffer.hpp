@@ -0,0 +1,200 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_COMPRESSEDSOUNDBUFFER_HPP
+#define SFML_COMPRESSEDSOUNDBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/System/Time.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class InputStream;
+
+////////////////////////////////////////////////////////////
+/// \brief Storage for an encoded sound, decoded when played
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API CompressedSoundBuffer
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    CompressedSoundBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the sound buffer from a file
+    ///
+    /// The whole file is kept in memory, in its encoded form.
+    /// See the documentation of sf::InputSoundFile for the list
+    /// of supported formats.
+    ///
+    /// \param filename Path of the sound file to load
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see loadFromMemory, loadFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the sound buffer from a file in memory
+    ///
+    /// The data is copied, it can be destroyed after this call.
+    /// See the documentation of sf::InputSoundFile for the list
+    /// of supported formats.
+    ///
+    /// \param data        Pointer to the file data in memory
+    /// \param sizeInBytes Size of the data to load, in bytes
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see loadFromFile, loadFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromMemory(const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the sound buffer from a custom stream
+    ///
+    /// The whole stream is read and kept in memory.
+    /// See the documentation of sf::InputSoundFile for the list
+    /// of supported formats.
+    ///
+    /// \param stream Source stream to read from
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see loadFromFile, loadFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromStream(InputStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the encoded data of the sound
+    ///
+    /// \return Pointer to the encoded data, or NULL if the buffer is empty
+    ///
+    /// \see getDataSize
+    ///
+    ////////////////////////////////////////////////////////////
+    const void* getData() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the encoded data of the sound
+    ///
+    /// \return Size of the encoded data, in bytes
+    ///
+    /// \see getData
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getDataSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of channels of the sound
+    ///
+    /// \return Number of channels
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getChannelCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sample rate of the sound
+    ///
+    /// \return Sample rate, in number of samples per second
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getSampleRate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the total duration of the sound
+    ///
+    /// \return Sound duration
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getDuration() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check the loaded data and read the sound properties
+    ///
+    /// \return True if the data is a valid sound file
+    ///
+    ////////////////////////////////////////////////////////////
+    bool initialize();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<char> m_data;         ///< Encoded sound file
+    unsigned int      m_channelCount; ///< Number of channels
+    unsigned int      m_sampleRate;   ///< Sample rate
+    Time              m_duration;     ///< Sound duration
+};
+
+} // namespace sf
+
+
+#endif // SFML_COMPRESSEDSOUNDBUFFER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::CompressedSoundBuffer
+/// \ingroup audio
+///
+/// sf::SoundBuffer decodes the whole sound when it is loaded,
+/// which takes a lot of memory for long or numerous sounds
+/// (one minute of stereo audio is about 10 MB). A
+/// sf::CompressedSoundBuffer keeps the sound file in its
+/// encoded form (OGG, FLAC, ...) instead, and the sound is
+/// decoded while it is played by a sf::VoicePool.
+///
+/// This is a good fit for sounds that are numerous and played
+/// rarely, like dialogs; short sounds played very often are
+/// better decoded once in a sf::SoundBuffer.
+///
+/// Usage example:
+/// \code
+/// sf::CompressedSoundBuffer line;
+/// if (!line.loadFromFile("dialog_042.ogg"))
+///     return -1;
+///
+/// sf::VoicePool voices(4);
+/// voices.play(line);
+/// \endcode
+///
+/// \see sf::VoicePool, sf::SoundBuffer
+///
+////////////////////////////////////////////////////////////
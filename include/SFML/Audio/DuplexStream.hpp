@@ -0,0 +1,285 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_DUPLEXSTREAM_HPP
+#define SFML_DUPLEXSTREAM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Time.hpp>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+    class DuplexRecorder;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Low-latency audio input and output working with small frames
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API DuplexStream : public SoundStream
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining a timestamped frame of mono audio
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Frame
+    {
+        Uint64             timestamp; ///< Index of the first sample of the frame since the start of its stream
+        std::vector<Int16> samples;   ///< Samples of the frame
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Both the capture and the playback use mono audio at
+    /// the given sample rate, grouped in frames of the given
+    /// duration. Small frames keep the latency low, at the cost
+    /// of more frequent processing; 5 to 20 ms are typical
+    /// values for voice communication.
+    ///
+    /// \param sampleRate    Sample rate of the capture and the playback
+    /// \param frameDuration Duration of a frame
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit DuplexStream(unsigned int sampleRate = 44100, Time frameDuration = milliseconds(10));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~DuplexStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start capturing audio from the current capture device
+    ///
+    /// The captured audio is cut into frames that can be
+    /// retrieved with popCapturedFrame. Their timestamps
+    /// start again from zero.
+    ///
+    /// \return True if the capture was successfully started
+    ///
+    /// \see stopCapture, setCaptureDevice
+    ///
+    ////////////////////////////////////////////////////////////
+    bool startCapture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop capturing audio
+    ///
+    /// \see startCapture
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopCapture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the audio capture device
+    ///
+    /// \param name Name of the capture device, or an empty string for the default one
+    ///
+    /// \return True if the device was successfully selected
+    ///
+    /// \see SoundRecorder::getAvailableDevices
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setCaptureDevice(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve the oldest captured frame
+    ///
+    /// This function can be called from any thread. Frames
+    /// that are not retrieved within a second are dropped.
+    ///
+    /// \param frame Frame to fill
+    ///
+    /// \return True if a frame was available
+    ///
+    ////////////////////////////////////////////////////////////
+    bool popCapturedFrame(Frame& frame);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Feed a frame to play
+    ///
+    /// This function can be called from any thread, typically
+    /// the one receiving the audio from the network. Frames
+    /// are reordered by timestamp in the jitter buffer, and
+    /// frames that arrive after their playback time are
+    /// discarded. Missing audio is replaced by silence.
+    ///
+    /// \param frame Frame to play
+    ///
+    ////////////////////////////////////////////////////////////
+    void pushFrame(const Frame& frame);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the delay of the jitter buffer
+    ///
+    /// The playback starts once this duration of audio has
+    /// been received, which absorbs the variations of the
+    /// network delay. If the received audio gets ahead of the
+    /// playback by twice this delay, the playback skips forward
+    /// to catch up. The default delay is 40 ms.
+    ///
+    /// \param delay Delay of the jitter buffer
+    ///
+    /// \see getJitterDelay
+    ///
+    ////////////////////////////////////////////////////////////
+    void setJitterDelay(Time delay);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the delay of the jitter buffer
+    ///
+    /// \return Delay of the jitter buffer
+    ///
+    /// \see setJitterDelay
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getJitterDelay() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of frames discarded because they arrived too late
+    ///
+    /// \return Number of late frames
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getLateFrameCount() const;
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request a new chunk of audio samples from the stream source
+    ///
+    /// \param data Chunk of data to fill
+    ///
+    /// \return True to continue playback, false to stop
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onGetData(Chunk& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current playing position in the stream source
+    ///
+    /// This resets the jitter buffer.
+    ///
+    /// \param timeOffset New playing position (ignored)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onSeek(Time timeOffset);
+
+private:
+
+    friend class priv::DuplexRecorder;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cut newly captured samples into frames
+    ///
+    /// This function is called by the capture thread.
+    ///
+    /// \param samples     Pointer to the captured samples
+    /// \param sampleCount Number of samples pointed by \a samples
+    ///
+    ////////////////////////////////////////////////////////////
+    void capture(const Int16* samples, std::size_t sampleCount);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::size_t                           m_frameSize;      ///< Number of samples in a frame
+    priv::DuplexRecorder*                 m_recorder;       ///< Capture device
+    Mutex                                 m_captureMutex;   ///< Mutex protecting the captured frames
+    std::deque<Frame>                     m_captured;       ///< Captured frames, waiting to be retrieved
+    std::vector<Int16>                    m_pending;        ///< Captured samples that don't fill a frame yet
+    Uint64                                m_captureTime;    ///< Timestamp of the next captured frame
+    mutable Mutex                         m_playbackMutex;  ///< Mutex protecting the jitter buffer
+    std::map<Uint64, std::vector<Int16> > m_jitterBuffer;   ///< Received frames, sorted by timestamp
+    Uint64                                m_playbackTime;   ///< Timestamp of the next sample to play
+    bool                                  m_buffering;      ///< Are we waiting for the jitter buffer to fill?
+    Time                                  m_jitterDelay;    ///< Delay of the jitter buffer
+    Uint64                                m_lateFrameCount; ///< Number of frames received too late
+    std::vector<Int16>                    m_samples;        ///< Temporary buffer of samples to play
+};
+
+} // namespace sf
+
+
+#endif // SFML_DUPLEXSTREAM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::DuplexStream
+/// \ingroup audio
+///
+/// sf::DuplexStream gathers what a voice communication needs:
+/// a capture that delivers the microphone input as small
+/// timestamped frames, and a playback of the frames received
+/// from the other side through a jitter buffer.
+///
+/// Contrary to chaining a sf::SoundRecorder and a sf::SoundStream
+/// with their default settings, both sides work with frames of
+/// a few milliseconds: the capture is processed at the frame
+/// rate, and the playback queues three frames only. The jitter
+/// buffer reorders the frames by timestamp, replaces missing
+/// ones with silence, and drops the ones arriving too late, so
+/// that the latency stays bounded.
+///
+/// The playback is controlled by the functions inherited from
+/// sf::SoundStream (play, stop, setVolume, ...), the capture
+/// by startCapture and stopCapture.
+///
+/// Usage example:
+/// \code
+/// sf::DuplexStream voice(44100, sf::milliseconds(10));
+/// voice.startCapture();
+/// voice.play();
+///
+/// sf::DuplexStream::Frame frame;
+/// while (connected)
+/// {
+///     // Send the captured frames
+///     while (voice.popCapturedFrame(frame))
+///         send(frame);
+///
+///     // Play the received ones
+///     while (receive(frame))
+///         voice.pushFrame(frame);
+/// }
+/// \endcode
+///
+/// \see sf::SoundRecorder, sf::SoundStream
+///
+////////////////////////////////////////////////////////////
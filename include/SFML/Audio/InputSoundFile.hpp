@@ -32,6 +32,7 @@
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/Time.hpp>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -39,6 +40,11 @@ namespace sf
 class InputStream;
 class SoundFileReader;
 
+namespace priv
+{
+    class Resampler;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Provide read access to sound files
 ///
@@ -111,6 +117,9 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Get the total number of audio samples in the file
     ///
+    /// If the samples are converted to another sample rate,
+    /// this is the number of converted samples.
+    ///
     /// \return Number of samples
     ///
     ////////////////////////////////////////////////////////////
@@ -127,11 +136,34 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Get the sample rate of the sound
     ///
+    /// If the samples are converted to another sample rate,
+    /// this is the rate of the converted samples.
+    ///
     /// \return Sample rate, in samples per second
     ///
+    /// \see setOutputSampleRate
+    ///
     ////////////////////////////////////////////////////////////
     unsigned int getSampleRate() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert the samples to another sample rate
+    ///
+    /// The samples are resampled while they are read, with a
+    /// high quality filter, so that a sound can be loaded or
+    /// streamed directly at the rate of the audio device
+    /// instead of being resampled each time it is played.
+    /// Passing 0 or the rate of the file disables the conversion.
+    /// The conversion applies to the currently open file, and
+    /// the reading position is moved back to the beginning.
+    ///
+    /// \param sampleRate Sample rate of the samples to read
+    ///
+    /// \see getSampleRate
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOutputSampleRate(unsigned int sampleRate);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the total duration of the sound file
     ///
@@ -183,6 +215,54 @@ public:
     ////////////////////////////////////////////////////////////
     Uint64 read(Int16* samples, Uint64 maxCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as floats
+    ///
+    /// The samples are normalized to the [-1, 1] range, with
+    /// the full precision of the file format.
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 read(float* samples, Uint64 maxCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the seek index of the file to the disk
+    ///
+    /// Readers of compressed formats (OGG/Vorbis and FLAC)
+    /// record positions of the stream while decoding, so that
+    /// seeking back to an already decoded part of the file
+    /// only costs a single jump instead of a search. Saving this
+    /// index next to the file, and loading it the next time the
+    /// file is opened, makes every seek fast from the start.
+    ///
+    /// \param filename Path of the index file to write
+    ///
+    /// \return True if the index was successfully saved
+    ///
+    /// \see loadSeekIndex
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveSeekIndex(const std::string& filename) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a seek index previously saved for this file
+    ///
+    /// The index is rejected if it doesn't match the open
+    /// file, or if its format doesn't support seek indices.
+    ///
+    /// \param filename Path of the index file to read
+    ///
+    /// \return True if the index was successfully loaded
+    ///
+    /// \see saveSeekIndex
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadSeekIndex(const std::string& filename);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -191,15 +271,30 @@ private:
     ////////////////////////////////////////////////////////////
     void close();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read and convert samples to the output sample rate
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 readResampled(float* samples, Uint64 maxCount);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    SoundFileReader* m_reader;       ///< Reader that handles I/O on the file's format
-    InputStream*     m_stream;       ///< Input stream used to access the file's data
-    bool             m_streamOwned;  ///< Is the stream internal or external?
-    Uint64           m_sampleCount;  ///< Total number of samples in the file
-    unsigned int     m_channelCount; ///< Number of channels of the sound
-    unsigned int     m_sampleRate;   ///< Number of samples per second
+    SoundFileReader*   m_reader;       ///< Reader that handles I/O on the file's format
+    InputStream*       m_stream;       ///< Input stream used to access the file's data
+    bool               m_streamOwned;  ///< Is the stream internal or external?
+    Uint64             m_sampleCount;  ///< Total number of samples in the file
+    unsigned int       m_channelCount; ///< Number of channels of the sound
+    unsigned int       m_sampleRate;   ///< Number of samples per second
+    priv::Resampler*   m_resampler;    ///< Converter to the output sample rate, if any
+    unsigned int       m_outputRate;   ///< Sample rate of the converted samples
+    std::vector<float> m_buffer;       ///< Samples read from the file, before conversion
+    std::vector<float> m_converted;    ///< Converted samples, before they are turned into 16 bits
 };
 
 } // namespace sf
@@ -194,6 +194,33 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     static Vector3f getUpVector();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start deferring the changes of audio properties
+    ///
+    /// Until processUpdates() is called, the changes made to the
+    /// listener and to the sound sources (position, volume,
+    /// pitch, ...) are recorded but not applied, so that they
+    /// all take effect at once. This is much cheaper than
+    /// applying them one by one when many sources are updated
+    /// every frame.
+    /// Calls can be nested: the changes are applied by the
+    /// processUpdates() call matching the first deferUpdates().
+    /// Deferring uses AL_SOFT_deferred_updates if available,
+    /// and suspends the OpenAL context otherwise.
+    ///
+    /// \see processUpdates
+    ///
+    ////////////////////////////////////////////////////////////
+    static void deferUpdates();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply all the changes deferred since deferUpdates()
+    ///
+    /// \see deferUpdates
+    ///
+    ////////////////////////////////////////////////////////////
+    static void processUpdates();
 };
 
 } // namespace sf
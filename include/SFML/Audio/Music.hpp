@@ -31,7 +31,8 @@
 #include <SFML/Audio/Export.hpp>
 #include <SFML/Audio/SoundStream.hpp>
 #include <SFML/Audio/InputSoundFile.hpp>
-#include <SFML/System/Mutex.hpp>
+#include <SFML/System/FastMutex.hpp>
+#include <SFML/System/Thread.hpp>
 #include <SFML/System/Time.hpp>
 #include <string>
 #include <vector>
@@ -129,6 +130,89 @@ public:
     ////////////////////////////////////////////////////////////
     Time getDuration() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the duration of audio decoded in advance
+    ///
+    /// The music is decoded by a separate thread into a
+    /// look-ahead buffer, from which the streaming thread
+    /// copies the samples to play. A longer look-ahead
+    /// protects the playback against slow decoding or
+    /// disk access, at the cost of memory.
+    /// The new duration is used the next time a music is
+    /// opened. The default look-ahead is 2 seconds.
+    ///
+    /// \param duration Duration of audio to decode in advance
+    ///
+    /// \see getLookAhead
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLookAhead(Time duration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the duration of audio decoded in advance
+    ///
+    /// \return Duration of audio decoded in advance
+    ///
+    /// \see setLookAhead
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getLookAhead() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the sample rate at which the music is decoded
+    ///
+    /// The samples are converted from the rate of the file
+    /// while they are decoded, so that they can be played at
+    /// the rate of the audio device without further work.
+    /// The new rate is used the next time a music is opened.
+    /// The default value, 0, keeps the rate of the file.
+    ///
+    /// \param sampleRate Output sample rate, or 0 to keep the rate of the file
+    ///
+    /// \see getOutputSampleRate, InputSoundFile::setOutputSampleRate
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOutputSampleRate(unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sample rate at which the music is decoded
+    ///
+    /// \return Output sample rate, or 0 if the rate of the file is kept
+    ///
+    /// \see setOutputSampleRate
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getOutputSampleRate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the seek index of the music to the disk
+    ///
+    /// The index records positions of the compressed stream
+    /// decoded so far, so that seeking to them is immediate.
+    /// Loading it the next time the music is opened avoids
+    /// the search that seeking in OGG or FLAC files needs.
+    ///
+    /// \param filename Path of the index file to write
+    ///
+    /// \return True if the index was successfully saved
+    ///
+    /// \see loadSeekIndex, InputSoundFile::saveSeekIndex
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveSeekIndex(const std::string& filename) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a seek index previously saved for the music
+    ///
+    /// \param filename Path of the index file to read
+    ///
+    /// \return True if the index was successfully loaded
+    ///
+    /// \see saveSeekIndex, InputSoundFile::loadSeekIndex
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadSeekIndex(const std::string& filename);
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -160,13 +244,37 @@ private:
     ////////////////////////////////////////////////////////////
     void initialize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called as the entry point of the decoding thread
+    ///
+    /// This function keeps the look-ahead buffer full until
+    /// the end of the file is reached or the thread is stopped.
+    ///
+    ////////////////////////////////////////////////////////////
+    void decode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop the decoding thread and wait for it to finish
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopDecoding();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    InputSoundFile     m_file;     ///< The streamed music file
-    Time               m_duration; ///< Music duration
-    std::vector<Int16> m_samples;  ///< Temporary buffer of samples
-    Mutex              m_mutex;    ///< Mutex protecting the data
+    InputSoundFile     m_file;       ///< The streamed music file
+    Time               m_duration;   ///< Music duration
+    std::vector<Int16> m_samples;    ///< Temporary buffer of samples
+    mutable FastMutex  m_mutex;      ///< Mutex protecting the file
+    Thread             m_decoder;    ///< Thread decoding the file into the look-ahead buffer
+    FastMutex          m_ringMutex;  ///< Mutex protecting the state of the look-ahead buffer
+    std::vector<Int16> m_ring;       ///< Look-ahead buffer of decoded samples (circular)
+    std::size_t        m_ringRead;   ///< Position of the first decoded sample in the look-ahead buffer
+    std::size_t        m_ringSize;   ///< Number of decoded samples in the look-ahead buffer
+    bool               m_endOfFile;  ///< Has the decoder reached the end of the file?
+    bool               m_decoding;   ///< Is the decoding thread running?
+    Time               m_lookAhead;  ///< Duration of audio decoded in advance
+    unsigned int       m_outputRate; ///< Sample rate at which the music is decoded (0 for the rate of the file)
 };
 
 } // namespace sf
@@ -195,6 +303,10 @@ private:
 /// leave the music alone after calling play(), it will manage itself
 /// very well.
 ///
+/// The file itself is decoded ahead of the playback by
+/// another thread (see setLookAhead), so that a slow decoder
+/// or disk doesn't interrupt the sound.
+///
 /// Usage example:
 /// \code
 /// // Declare a new music
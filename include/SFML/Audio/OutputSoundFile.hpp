@@ -29,8 +29,13 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Time.hpp>
+#include <deque>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -76,12 +81,97 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Write audio samples to the file
     ///
+    /// In asynchronous mode, the samples are copied to the
+    /// queue of the encoding thread and this function returns
+    /// immediately, unless the queue is full.
+    ///
     /// \param samples     Pointer to the sample array to write
     /// \param count       Number of samples to write
     ///
     ////////////////////////////////////////////////////////////
     void write(const Int16* samples, Uint64 count);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable asynchronous encoding
+    ///
+    /// In asynchronous mode, the samples are encoded by a
+    /// separate thread, so that write doesn't block the caller
+    /// (typically an audio capture thread) while a block of
+    /// compressed data is produced. The queue of the encoding
+    /// thread holds up to \a queueDuration of audio; when it is
+    /// full, write waits until there is room again.
+    /// The new mode is used the next time a file is opened.
+    /// The file is always completely written when it is closed.
+    /// Asynchronous encoding is disabled by default.
+    ///
+    /// \param asynchronous  True to encode in a separate thread, false to encode in write
+    /// \param queueDuration Maximum duration of audio waiting to be encoded
+    ///
+    /// \see isAsynchronous
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAsynchronous(bool asynchronous, Time queueDuration = seconds(1));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether asynchronous encoding is enabled
+    ///
+    /// \return True if the samples are encoded in a separate thread
+    ///
+    /// \see setAsynchronous
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isAsynchronous() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the quality of lossy formats (OGG/Vorbis)
+    ///
+    /// A higher quality gives a better sound and a bigger file.
+    /// The new quality is used the next time a file is opened.
+    /// The default quality is 0.4, about 128 kbps for a 44.1 KHz
+    /// stereo sound.
+    ///
+    /// \param quality Encoding quality, in range [0 .. 1]
+    ///
+    /// \see getQuality
+    ///
+    ////////////////////////////////////////////////////////////
+    void setQuality(float quality);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the quality of lossy formats
+    ///
+    /// \return Encoding quality, in range [0 .. 1]
+    ///
+    /// \see setQuality
+    ///
+    ////////////////////////////////////////////////////////////
+    float getQuality() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the compression level of lossless formats (FLAC)
+    ///
+    /// A higher level gives a smaller file and costs more CPU
+    /// time; the decoded sound is the same.
+    /// The new level is used the next time a file is opened.
+    /// The default level is 5.
+    ///
+    /// \param level Compression level, in range [0 .. 8]
+    ///
+    /// \see getCompressionLevel
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCompressionLevel(unsigned int level);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the compression level of lossless formats
+    ///
+    /// \return Compression level, in range [0 .. 8]
+    ///
+    /// \see setCompressionLevel
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getCompressionLevel() const;
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -90,10 +180,27 @@ private:
     ////////////////////////////////////////////////////////////
     void close();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function run by the encoding thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void encode();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    SoundFileWriter* m_writer; ///< Writer that handles I/O on the file's format
+    SoundFileWriter*                 m_writer;           ///< Writer that handles I/O on the file's format
+    float                            m_quality;          ///< Quality of lossy formats
+    unsigned int                     m_compressionLevel; ///< Compression level of lossless formats
+    bool                             m_asynchronous;     ///< Are the samples encoded in a separate thread?
+    Time                             m_queueDuration;    ///< Maximum duration of audio waiting to be encoded
+    Thread                           m_encoder;          ///< Thread encoding the queued samples
+    Mutex                            m_mutex;            ///< Mutex protecting the queue
+    std::deque<std::vector<Int16> >  m_blocks;           ///< Blocks of samples waiting to be encoded
+    std::vector<std::vector<Int16> > m_freeBlocks;       ///< Blocks already encoded, kept to be reused
+    Uint64                           m_queuedSamples;    ///< Number of samples waiting to be encoded
+    Uint64                           m_queueCapacity;    ///< Maximum number of samples waiting to be encoded
+    bool                             m_encoding;         ///< Is the encoding thread running?
 };
 
 } // namespace sf
@@ -0,0 +1,321 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PLAYLIST_HPP
+#define SFML_PLAYLIST_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/Audio/InputSoundFile.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Time.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Streamed sequence of audio files played without gaps
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API Playlist : public SoundStream
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    Playlist();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Playlist();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append an audio file to the playlist
+    ///
+    /// The first track is opened immediately, and defines the
+    /// channel count and sample rate of the playlist: the
+    /// following tracks must have the same ones, or they are
+    /// skipped. The other tracks are opened in the background
+    /// while the previous one plays.
+    ///
+    /// \param filename Path of the sound file to append
+    ///
+    /// \return Index of the new track
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of tracks in the playlist
+    ///
+    /// \return Number of tracks
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getTrackCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the index of the track currently played
+    ///
+    /// \return Index of the current track
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCurrentTrack() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Define a loop inside a track
+    ///
+    /// When the playback reaches \a end, it jumps back to
+    /// \a begin with sample accuracy, until next() is called.
+    /// Both offsets are sample indices, like in
+    /// InputSoundFile::seek. Passing the same value for both
+    /// removes the loop.
+    ///
+    /// \param track Index of the track
+    /// \param begin Sample where the loop starts
+    /// \param end   Sample where the loop ends
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLoopPoints(std::size_t track, Uint64 begin, Uint64 end);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the duration of the transition between two tracks
+    ///
+    /// During a crossfade, the end of a track is mixed with
+    /// the beginning of the next one. The default duration is
+    /// zero: tracks are simply chained.
+    ///
+    /// \param duration Duration of the crossfade
+    ///
+    /// \see getCrossfade
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCrossfade(Time duration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the duration of the transition between two tracks
+    ///
+    /// \return Duration of the crossfade
+    ///
+    /// \see setCrossfade
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getCrossfade() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Leave the current track
+    ///
+    /// The transition to the next track starts with the
+    /// samples that haven't been queued yet, using the
+    /// crossfade duration. The loop of the current track,
+    /// if any, is left as well.
+    ///
+    ////////////////////////////////////////////////////////////
+    void next();
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request a new chunk of audio samples from the stream source
+    ///
+    /// \param data Chunk of data to fill
+    ///
+    /// \return True to continue playback, false to stop
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onGetData(Chunk& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current playing position in the stream source
+    ///
+    /// The position is relative to the beginning of the current
+    /// track. If the playlist is over, it restarts from its
+    /// first track.
+    ///
+    /// \param timeOffset New playing position, from the beginning of the track
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onSeek(Time timeOffset);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining a track of the playlist
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Track
+    {
+        std::string filename;  ///< Path of the sound file
+        Uint64      loopBegin; ///< Sample where the loop starts
+        Uint64      loopEnd;   ///< Sample where the loop ends
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the duration of the crossfade in samples
+    ///
+    /// \return Number of samples of a crossfade
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getCrossfadeSampleCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open the first track that can be played, starting from the given one
+    ///
+    /// \param track Index of the first track to try
+    ///
+    ////////////////////////////////////////////////////////////
+    void restart(std::size_t track);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a track and check its format
+    ///
+    /// \param filename Path of the sound file
+    ///
+    /// \return New file, or NULL on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    InputSoundFile* open(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called as the entry point of the loading thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void load();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading the track that follows the current one
+    ///
+    ////////////////////////////////////////////////////////////
+    void prepareNext();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the next track opened by the loading thread
+    ///
+    /// \param wait Wait for the loading thread if it's not done yet?
+    ///
+    /// \return Next track, or NULL if not available
+    ///
+    ////////////////////////////////////////////////////////////
+    InputSoundFile* getNext(bool wait);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Replace the current track with the next one
+    ///
+    ////////////////////////////////////////////////////////////
+    void switchTrack();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mix the beginning of the next track into samples of the current one
+    ///
+    /// \param samples Samples of the current track
+    /// \param count   Number of samples
+    /// \param length  Total duration of the crossfade, in samples
+    ///
+    ////////////////////////////////////////////////////////////
+    void crossfade(Int16* samples, std::size_t count, Uint64 length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close the open tracks
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Track> m_tracks;       ///< Tracks of the playlist
+    mutable Mutex      m_mutex;        ///< Mutex protecting the tracks and the playback state
+    InputSoundFile*    m_current;      ///< File of the track currently played
+    std::size_t        m_currentTrack; ///< Index of the track currently played
+    Uint64             m_position;     ///< Position in the current track, in samples
+    Uint64             m_end;          ///< Sample where the current track stops
+    bool               m_leaving;      ///< Has next() been called for the current track?
+    bool               m_restart;      ///< Must the playlist restart from its first track?
+    Thread             m_loader;       ///< Thread opening the next track in the background
+    Mutex              m_loaderMutex;  ///< Mutex protecting the result of the loading thread
+    std::string        m_nextFilename; ///< Path of the track being loaded
+    std::size_t        m_nextTrack;    ///< Index of the track being loaded
+    bool               m_loading;      ///< Has the loading thread been launched for the next track?
+    bool               m_nextReady;    ///< Is the loading thread done?
+    InputSoundFile*    m_next;         ///< File of the next track, once opened
+    Uint64             m_nextPosition; ///< Position in the next track, in samples (advanced by crossfades)
+    Time               m_crossfade;    ///< Duration of the transitions
+    std::vector<Int16> m_samples;      ///< Temporary buffer of samples
+    std::vector<Int16> m_mixSamples;   ///< Temporary buffer for the samples of the next track
+};
+
+} // namespace sf
+
+
+#endif // SFML_PLAYLIST_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Playlist
+/// \ingroup audio
+///
+/// sf::Playlist streams a sequence of audio files through a
+/// single source. Each track is opened by a background thread
+/// while the previous one plays, and its samples are queued
+/// right after the last ones of the previous track: there's
+/// no gap, and no file is opened in the thread of the caller
+/// after the first one.
+///
+/// Transitions can be smoothed with a crossfade (setCrossfade),
+/// and each track can loop between two sample-accurate points
+/// (setLoopPoints) until next() is called, which is handy for
+/// game music made of an intro and a looping part. Calling
+/// setLoop(true) plays the whole playlist in a loop.
+///
+/// All the tracks must share the channel count and sample
+/// rate of the first one.
+///
+/// Usage example:
+/// \code
+/// sf::Playlist playlist;
+/// playlist.add("intro.ogg");
+/// std::size_t battle = playlist.add("battle.ogg");
+/// playlist.add("victory.ogg");
+///
+/// // Loop the battle theme between two samples until the fight is over
+/// playlist.setLoopPoints(battle, 441000, 2646000);
+/// playlist.setCrossfade(sf::seconds(2));
+/// playlist.play();
+///
+/// // Later, when the fight is won
+/// playlist.next();
+/// \endcode
+///
+/// \see sf::Music, sf::SoundStream
+///
+////////////////////////////////////////////////////////////
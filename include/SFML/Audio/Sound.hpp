@@ -130,7 +130,8 @@ public:
     ///
     /// If set, the sound will restart from beginning after
     /// reaching the end and so on, until it is stopped or
-    /// setLoop(false) is called.
+    /// setLoop(false) is called. When a range is set, the
+    /// sound loops inside the range.
     /// The default looping state for sound is false.
     ///
     /// \param loop True to play in loop, false to play once
@@ -155,6 +156,60 @@ public:
     ////////////////////////////////////////////////////////////
     void setPlayingOffset(Time timeOffset);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Restrict the playback to a range of the buffer
+    ///
+    /// This allows to pack many short sounds into a single
+    /// buffer (see sf::SoundAtlas) and to play them with
+    /// the same sf::Sound. Once a range is set, play() starts
+    /// at the beginning of the range, the sound stops (or
+    /// loops) at its end, and the playing offset is relative
+    /// to its beginning.
+    ///
+    /// The end of the range is detected by a background thread
+    /// that checks the playing position every few milliseconds,
+    /// so a few more samples than requested may be heard; keep
+    /// some silence after the range if this is a problem.
+    ///
+    /// The range is kept when the buffer changes. A duration of
+    /// zero removes the range.
+    ///
+    /// \param offset   Beginning of the range, from the beginning of the buffer
+    /// \param duration Duration of the range
+    ///
+    /// \see resetRange, getRangeOffset, getRangeDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRange(Time offset, Time duration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Play the whole buffer again
+    ///
+    /// \see setRange
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetRange();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the beginning of the playback range
+    ///
+    /// \return Beginning of the range, or Time::Zero if there is no range
+    ///
+    /// \see setRange, getRangeDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getRangeOffset() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the duration of the playback range
+    ///
+    /// \return Duration of the range, or Time::Zero if there is no range
+    ///
+    /// \see setRange, getRangeOffset
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getRangeDuration() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the audio buffer attached to the sound
     ///
@@ -214,10 +269,24 @@ public:
 
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the boundaries of the range in sample frames
+    ///
+    /// \param begin Filled with the first frame of the range
+    /// \param end   Filled with the frame following the range
+    ///
+    /// \return True if a range is set and a buffer is attached
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getRangeFrames(Uint64& begin, Uint64& end) const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    const SoundBuffer* m_buffer; ///< Sound buffer bound to the source
+    const SoundBuffer* m_buffer;        ///< Sound buffer bound to the source
+    Time               m_rangeOffset;   ///< Beginning of the playback range
+    Time               m_rangeDuration; ///< Duration of the playback range (zero if the whole buffer is played)
+    bool               m_loop;          ///< Loop state, kept here because OpenAL must not loop the whole buffer while a range is set
 };
 
 } // namespace sf
@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SOUNDATLAS_HPP
+#define SFML_SOUNDATLAS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class Sound;
+
+////////////////////////////////////////////////////////////
+/// \brief Many short sounds packed into a single sound buffer
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API SoundAtlas : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Location of a sound in the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Clip
+    {
+        Time offset;   ///< Beginning of the clip in the buffer
+        Time duration; ///< Duration of the clip
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty atlas.
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundAtlas();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load and pack a list of sound files
+    ///
+    /// All the files must have the same number of channels.
+    /// They are converted to the sample rate of the first one,
+    /// and separated by a short silence so that the end of a
+    /// clip is never followed by the beginning of the next one.
+    /// The clips are numbered in the order of \a filenames.
+    ///
+    /// \param filenames Paths of the sound files to load
+    ///
+    /// \return True if all the files were loaded successfully
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFiles(const std::vector<std::string>& filenames);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sound buffer containing all the clips
+    ///
+    /// \return Read-only access to the sound buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    const SoundBuffer& getBuffer() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of clips in the atlas
+    ///
+    /// \return Number of clips
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getClipCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the location of a clip in the buffer
+    ///
+    /// \param index Index of the clip, in the order of the loaded files
+    ///
+    /// \return Location of the clip
+    ///
+    ////////////////////////////////////////////////////////////
+    const Clip& getClip(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Prepare a sound to play a clip of the atlas
+    ///
+    /// This is a shortcut for setting the buffer of \a sound
+    /// and restricting it to the range of the clip.
+    ///
+    /// \param sound Sound to set up
+    /// \param index Index of the clip to play
+    ///
+    ////////////////////////////////////////////////////////////
+    void setClip(Sound& sound, std::size_t index) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    SoundBuffer       m_buffer; ///< Buffer containing all the clips
+    std::vector<Clip> m_clips;  ///< Location of the clips in the buffer
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDATLAS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoundAtlas
+/// \ingroup audio
+///
+/// Games often play a lot of short sounds (footsteps, hits,
+/// UI clicks). Loading each of them into its own
+/// sf::SoundBuffer creates as many OpenAL buffers, and
+/// switching a sf::Sound from one of them to another detaches
+/// and reattaches buffers. sf::SoundAtlas packs them all into
+/// a single buffer instead, and a sf::Sound plays one of them
+/// by restricting its playback to the range of the clip
+/// (see sf::Sound::setRange).
+///
+/// Usage example:
+/// \code
+/// std::vector<std::string> filenames;
+/// filenames.push_back("click.wav");
+/// filenames.push_back("hit.ogg");
+///
+/// sf::SoundAtlas atlas;
+/// if (!atlas.loadFromFiles(filenames))
+///     /* error */;
+///
+/// sf::Sound sound;
+/// atlas.setClip(sound, 1);
+/// sound.play();
+/// \endcode
+///
+/// \see sf::Sound, sf::SoundBuffer
+///
+////////////////////////////////////////////////////////////
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
 #include <SFML/Audio/AlResource.hpp>
+#include <SFML/System/MemoryTracker.hpp>
 #include <SFML/System/Time.hpp>
 #include <string>
 #include <vector>
@@ -134,6 +135,26 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromSamples(const Int16* samples, Uint64 sampleCount, unsigned int channelCount, unsigned int sampleRate);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the sound buffer from an array of float audio samples
+    ///
+    /// The samples are normalized to the [-1, 1] range. They
+    /// are kept as floats in the buffer, and played without
+    /// conversion if the OpenAL implementation supports
+    /// float samples (AL_EXT_FLOAT32).
+    ///
+    /// \param samples      Pointer to the array of samples in memory
+    /// \param sampleCount  Number of samples in the array
+    /// \param channelCount Number of channels (1 = mono, 2 = stereo, ...)
+    /// \param sampleRate   Sample rate (number of samples to play per second)
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see getFloatSamples
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromSamples(const float* samples, Uint64 sampleCount, unsigned int channelCount, unsigned int sampleRate);
+
     ////////////////////////////////////////////////////////////
     /// \brief Save the sound buffer to an audio file
     ///
@@ -156,13 +177,46 @@ public:
     /// (sf::Int16). The total number of samples in this array
     /// is given by the getSampleCount() function.
     ///
-    /// \return Read-only pointer to the array of sound samples
+    /// \return Read-only pointer to the array of sound samples,
+    ///         or NULL if the buffer holds float samples
     ///
-    /// \see getSampleCount
+    /// \see getSampleCount, getFloatSamples
     ///
     ////////////////////////////////////////////////////////////
     const Int16* getSamples() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the array of float audio samples stored in the buffer
+    ///
+    /// Float samples are only available if the buffer was
+    /// loaded from an array of floats. The total number of
+    /// samples in this array is given by the getSampleCount()
+    /// function.
+    ///
+    /// \return Read-only pointer to the array of sound samples,
+    ///         or NULL if the buffer holds 16 bits samples
+    ///
+    /// \see getSampleCount, getSamples
+    ///
+    ////////////////////////////////////////////////////////////
+    const float* getFloatSamples() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Free the copy of the samples kept in system memory
+    ///
+    /// The samples are uploaded to the audio device when the
+    /// buffer is loaded; SFML also keeps them in system memory,
+    /// so that they can be accessed with getSamples(), saved
+    /// or copied. If you don't need that, this function frees
+    /// the system memory copy: the buffer can still be played,
+    /// but getSamples() and getFloatSamples() return NULL,
+    /// saveToFile fails and copies of the buffer are empty.
+    ///
+    /// \see getSamples
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseSamples();
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the number of samples stored in the buffer
     ///
@@ -264,6 +318,12 @@ private:
     ////////////////////////////////////////////////////////////
     void detachSound(Sound* sound) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Report the memory of the samples to the memory tracker
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateMemoryUsage();
+
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
@@ -272,10 +332,12 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int       m_buffer;   ///< OpenAL buffer identifier
-    std::vector<Int16> m_samples;  ///< Samples buffer
-    Time               m_duration; ///< Sound duration
-    mutable SoundList  m_sounds;   ///< List of sounds that are using this buffer
+    unsigned int           m_buffer;       ///< OpenAL buffer identifier
+    std::vector<Int16>     m_samples;      ///< Samples buffer
+    std::vector<float>     m_floatSamples; ///< Samples buffer, if the buffer was loaded from floats
+    MemoryTracker::Counter m_memory;       ///< Reports the memory of the samples
+    Time                   m_duration;     ///< Sound duration
+    mutable SoundList      m_sounds;       ///< List of sounds that are using this buffer
 };
 
 } // namespace sf
@@ -0,0 +1,298 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SOUNDBUFFERLOADQUEUE_HPP
+#define SFML_SOUNDBUFFERLOADQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Config.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class InputStream;
+class SoundBuffer;
+class Thread;
+
+////////////////////////////////////////////////////////////
+/// \brief Decode sound files on a pool of worker threads
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API SoundBufferLoadQueue : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decoded sound file
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Result
+    {
+        std::size_t        id;           ///< Identifier returned by push
+        bool               success;      ///< Was the file loaded successfully?
+        std::vector<Int16> samples;      ///< Decoded samples, empty if loading failed
+        unsigned int       channelCount; ///< Number of channels of the sound
+        unsigned int       sampleRate;   ///< Sample rate of the sound
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the queue and start its worker threads
+    ///
+    /// \param threadCount Number of files decoded in parallel
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SoundBufferLoadQueue(unsigned int threadCount = 4);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Discards the files that were not decoded yet and waits
+    /// for the ones being decoded.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SoundBufferLoadQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue the loading of a sound file on disk
+    ///
+    /// The supported audio formats are the same as for
+    /// SoundBuffer::loadFromFile.
+    ///
+    /// \param filename Path of the sound file to load
+    ///
+    /// \return Identifier of the job, found in the result
+    ///
+    /// \see pop
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t push(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue the loading of a sound file in memory
+    ///
+    /// The data is not copied, it must remain valid until the
+    /// result of the job is popped.
+    ///
+    /// \param data Pointer to the file data in memory
+    /// \param size Size of the data to load, in bytes
+    ///
+    /// \return Identifier of the job, found in the result
+    ///
+    /// \see pop
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t push(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue the loading of a sound file from a custom stream
+    ///
+    /// The stream is read by a worker thread, it must remain
+    /// valid and must not be used by another thread until the
+    /// result of the job is popped.
+    ///
+    /// \param stream Source stream to read from
+    ///
+    /// \return Identifier of the job, found in the result
+    ///
+    /// \see pop
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t push(InputStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve a decoded sound file, if any
+    ///
+    /// This function doesn't block. The results are returned
+    /// in the order the jobs finish, which is not necessarily
+    /// the order they were pushed; use the identifier to match
+    /// them.
+    ///
+    /// \param result Structure that receives the decoded samples
+    ///
+    /// \return True if a result was retrieved
+    ///
+    /// \see push, isReady
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pop(Result& result);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve a decoded sound file and load it into a buffer
+    ///
+    /// The audio buffer is created by the calling thread.
+    /// This function doesn't block, see pop(Result&).
+    ///
+    /// \param buffer Sound buffer to load with the decoded samples
+    /// \param id     Receives the identifier of the job
+    ///
+    /// \return True if a result was retrieved and successfully loaded
+    ///
+    /// \see push, isReady
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pop(SoundBuffer& buffer, std::size_t& id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a decoded sound file is available
+    ///
+    /// \return True if pop would succeed
+    ///
+    /// \see pop
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Block until all the queued files are decoded
+    ///
+    /// \see pop
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of queued files
+    ///
+    /// \return Number of jobs that were pushed but not popped yet
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPendingCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a list of sound files in parallel
+    ///
+    /// The files are decoded by \a threadCount worker threads,
+    /// then the audio buffers are created by the calling
+    /// thread. \a buffers is resized to the number of files;
+    /// the buffers of the files that failed to load are left
+    /// empty.
+    ///
+    /// \param filenames   Paths of the sound files to load
+    /// \param buffers     Sound buffers to load, in the same order as \a filenames
+    /// \param threadCount Number of files decoded in parallel
+    ///
+    /// \return True if all the files were successfully loaded
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool loadFromFiles(const std::vector<std::string>& filenames, std::vector<SoundBuffer>& buffers, unsigned int threadCount = 4);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sound file waiting to be decoded
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Job
+    {
+        std::size_t  id;       ///< Identifier returned by push
+        std::string  filename; ///< Path of the file, if loading from a file
+        const void*  data;     ///< File data, if loading from memory
+        std::size_t  size;     ///< Size of the file data, in bytes
+        InputStream* stream;   ///< Source stream, if loading from a stream
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a job to the queue
+    ///
+    /// \param job Job to add, its identifier is assigned here
+    ///
+    /// \return Identifier of the job
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t addJob(Job& job);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function run by the worker threads
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Thread*>      m_threads;  ///< Worker threads
+    std::deque<Job>           m_jobs;     ///< Files waiting to be decoded
+    std::deque<Result>        m_results;  ///< Decoded files waiting to be popped
+    std::size_t               m_nextId;   ///< Identifier of the next job
+    std::size_t               m_pending;  ///< Number of jobs pushed but not popped yet
+    std::size_t               m_decoding; ///< Number of jobs being decoded
+    bool                      m_running;  ///< Are the worker threads running?
+    mutable Mutex             m_mutex;    ///< Mutex protecting the queues
+    ConditionVariable         m_newJob;   ///< Wakes up the workers when a job is pushed
+    mutable ConditionVariable m_jobDone;  ///< Wakes up wait() when a job is finished
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDBUFFERLOADQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoundBufferLoadQueue
+/// \ingroup audio
+///
+/// Decoding compressed sound files (OGG/Vorbis, FLAC) takes
+/// time, and loading many of them one after the other with
+/// sf::SoundBuffer::loadFromFile keeps a single core busy.
+/// sf::SoundBufferLoadQueue decodes them on a pool of worker
+/// threads, each one with its own sound file reader: push
+/// queues a file, a buffer in memory or a stream and returns
+/// immediately, and pop retrieves the decoded samples as they
+/// are ready.
+///
+/// The audio buffers are always created by the thread that
+/// pops the results. For the common case of loading a list of
+/// files at once, loadFromFiles does all of this and blocks
+/// until the buffers are ready.
+///
+/// The error messages of the sound file readers are not
+/// thread specific, the reason printed for a failure may
+/// belong to another file decoded at the same time.
+///
+/// Usage example:
+/// \code
+/// std::vector<std::string> filenames;
+/// filenames.push_back("explosion.ogg");
+/// filenames.push_back("footstep.flac");
+/// filenames.push_back("ambience.ogg");
+///
+/// std::vector<sf::SoundBuffer> buffers;
+/// if (!sf::SoundBufferLoadQueue::loadFromFiles(filenames, buffers, 8))
+///     /* error */;
+/// \endcode
+///
+/// \see sf::SoundBuffer, sf::InputSoundFile
+///
+////////////////////////////////////////////////////////////
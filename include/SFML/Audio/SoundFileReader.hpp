@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -97,6 +98,56 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as floats
+    ///
+    /// The samples are normalized to the [-1, 1] range.
+    /// The default implementation reads 16-bits samples and
+    /// converts them: readers that decode to a more precise
+    /// representation should override it.
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 read(float* samples, Uint64 maxCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the seek index built by the reader
+    ///
+    /// Readers of compressed formats can record positions of
+    /// the stream while decoding, so that later seeks jump
+    /// directly to the right place instead of searching for it.
+    /// The content of the index is specific to each reader.
+    /// The default implementation doesn't provide any index.
+    ///
+    /// \param index Array to fill with the index
+    ///
+    /// \return True if the reader supports seek indices
+    ///
+    /// \see setSeekIndex
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getSeekIndex(std::vector<Uint64>& index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Replace the seek index of the reader
+    ///
+    /// The index must have been produced by getSeekIndex, with
+    /// the same reader and the same file. The default
+    /// implementation doesn't support indices.
+    ///
+    /// \param index Index to use
+    ///
+    /// \return True if the index was accepted
+    ///
+    /// \see getSeekIndex
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool setSeekIndex(const std::vector<Uint64>& index);
 };
 
 } // namespace sf
@@ -113,9 +164,13 @@ public:
 /// supported by SFML, and thus extend the set of supported readable
 /// audio formats.
 ///
-/// A valid sound file reader must override the open, seek and write functions,
+/// A valid sound file reader must override the open, seek and read functions,
 /// as well as providing a static check function; the latter is used by
-/// SFML to find a suitable writer for a given input file.
+/// SFML to find a suitable writer for a given input file. Readers
+/// decoding to floats or more than 16 bits can also override the
+/// float version of read, to preserve the precision of the file,
+/// and the getSeekIndex/setSeekIndex pair if they can speed up
+/// seeking by recording positions of the stream.
 ///
 /// To register a new reader, use the sf::SoundFileFactory::registerReader
 /// template function.
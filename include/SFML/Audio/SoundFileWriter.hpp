@@ -68,6 +68,19 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     virtual void write(const Int16* samples, Uint64 count) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the encoding options of the next file to open
+    ///
+    /// This function is called before open. Writers whose format
+    /// doesn't support these options can ignore them, which is
+    /// what the default implementation does.
+    ///
+    /// \param quality          Quality of lossy formats, in range [0 .. 1]
+    /// \param compressionLevel Compression level of lossless formats, in range [0 .. 8]
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setEncodingOptions(float quality, unsigned int compressionLevel) {(void)quality; (void)compressionLevel;}
 };
 
 } // namespace sf
@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SOUNDQUEUERECORDER_HPP
+#define SFML_SOUNDQUEUERECORDER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundRecorder.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Time.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Specialized SoundRecorder which stores the captured
+///        audio data into a queue read by other threads
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API SoundQueueRecorder : public SoundRecorder
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param capacity Duration of audio that the queue can hold
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SoundQueueRecorder(Time capacity = seconds(1));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SoundQueueRecorder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pull captured samples out of the queue
+    ///
+    /// This function can be called from any thread, while
+    /// the capture runs or after it has stopped. It never
+    /// waits for new samples: it returns what is available.
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t read(Int16* samples, std::size_t maxCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples waiting in the queue
+    ///
+    /// \return Number of samples that can be read
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getAvailableSampleCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples lost since the capture started
+    ///
+    /// When the queue is full, the oldest samples are
+    /// overwritten by the new ones. A growing count means
+    /// that the samples are not read fast enough, or that
+    /// the capacity of the queue is too small.
+    ///
+    /// \return Number of overwritten samples
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getDroppedSampleCount() const;
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start capturing audio data
+    ///
+    /// \return True to start the capture, or false to abort it
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onStart();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process a new chunk of recorded samples
+    ///
+    /// \param samples     Pointer to the new chunk of recorded samples
+    /// \param sampleCount Number of samples pointed by \a samples
+    ///
+    /// \return True to continue the capture, or false to stop it
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onProcessSamples(const Int16* samples, std::size_t sampleCount);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Time               m_capacity;     ///< Duration of audio that the queue can hold
+    mutable Mutex      m_mutex;        ///< Mutex protecting the queue
+    std::vector<Int16> m_queue;        ///< Captured samples (circular buffer, allocated when the capture starts)
+    std::size_t        m_read;         ///< Position of the first sample to read in the queue
+    std::size_t        m_size;         ///< Number of samples waiting in the queue
+    Uint64             m_droppedCount; ///< Number of samples overwritten before being read
+};
+
+} // namespace sf
+
+#endif // SFML_SOUNDQUEUERECORDER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoundQueueRecorder
+/// \ingroup audio
+///
+/// sf::SoundQueueRecorder decouples the capture from the
+/// processing of the recorded samples: the capture thread
+/// only appends them to a queue allocated when the capture
+/// starts, and the application pulls them with read() from
+/// whatever thread processes them (the main loop, a network
+/// thread, an encoder, ...), at its own pace. A slow consumer
+/// never delays the capture; if it falls too far behind, the
+/// oldest samples are overwritten (see getDroppedSampleCount).
+///
+/// Usage example:
+/// \code
+/// sf::SoundQueueRecorder recorder(sf::seconds(2));
+/// recorder.start();
+///
+/// std::vector<sf::Int16> samples(4096);
+/// while (running)
+/// {
+///     std::size_t count = recorder.read(&samples[0], samples.size());
+///     process(&samples[0], count);
+///     ...
+/// }
+///
+/// recorder.stop();
+/// \endcode
+///
+/// \see sf::SoundRecorder, sf::SoundBufferRecorder
+///
+////////////////////////////////////////////////////////////
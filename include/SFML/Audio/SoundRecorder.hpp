@@ -281,7 +281,8 @@ private:
 /// about capturing sound samples, the task of making something
 /// useful with them is left to the derived class. Note that
 /// SFML provides a built-in specialization for saving the
-/// captured data to a sound buffer (see sf::SoundBufferRecorder).
+/// captured data to a sound buffer (see sf::SoundBufferRecorder),
+/// and one for pulling it from any thread (see sf::SoundQueueRecorder).
 ///
 /// A derived class has only one virtual function to override:
 /// \li onProcessSamples provides the new chunks of audio samples while the capture happens
@@ -30,14 +30,20 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
 #include <SFML/Audio/SoundSource.hpp>
-#include <SFML/System/Thread.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Time.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <cstdlib>
+#include <vector>
 
 
 namespace sf
 {
+namespace priv
+{
+    class SoundStreamScheduler;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Abstract base class for streamed audio sources
 ///
@@ -52,8 +58,9 @@ public:
     ////////////////////////////////////////////////////////////
     struct Chunk
     {
-        const Int16* samples;     ///< Pointer to the audio samples
-        std::size_t  sampleCount; ///< Number of samples pointed by Samples
+        const Int16* samples;      ///< Pointer to the audio samples
+        std::size_t  sampleCount;  ///< Number of samples pointed by Samples
+        const float* floatSamples; ///< Pointer to normalized float samples, used instead of \a samples if not NULL
     };
 
     ////////////////////////////////////////////////////////////
@@ -178,6 +185,127 @@ public:
     ////////////////////////////////////////////////////////////
     bool getLoop() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of audio buffers in the playing queue
+    ///
+    /// More buffers make the stream more robust to a busy
+    /// system, at the cost of memory and of a longer delay
+    /// between the decoding and the playback of the samples.
+    /// The count is clamped to [2, 16], and takes effect the
+    /// next time the stream is started.
+    /// The default buffer count is 3.
+    ///
+    /// \param count Number of buffers
+    ///
+    /// \see getBufferCount, setAdaptiveBuffering
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBufferCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of audio buffers in the playing queue
+    ///
+    /// \return Number of buffers
+    ///
+    /// \see setBufferCount
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getBufferCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the duration of audio that each buffer should hold
+    ///
+    /// This is a hint for the derived class, which decides
+    /// how many samples it returns in onGetData. sf::Music
+    /// reads exactly this duration for each buffer.
+    /// Shorter buffers reduce the latency of the stream,
+    /// but have to be refilled more often.
+    /// The default buffer duration is 1 second.
+    ///
+    /// \param duration Duration of a buffer
+    ///
+    /// \see getBufferDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBufferDuration(Time duration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the duration of audio that each buffer should hold
+    ///
+    /// \return Duration of a buffer
+    ///
+    /// \see setBufferDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getBufferDuration() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the adaptive buffer count
+    ///
+    /// In adaptive mode, a buffer is added to the playing
+    /// queue (up to 16) each time the stream runs out of
+    /// data, and one is removed (down to the count given to
+    /// setBufferCount) after each 10 seconds of playback
+    /// without interruption.
+    /// Adaptive buffering is disabled by default.
+    ///
+    /// \param adaptive True to enable, false to disable
+    ///
+    /// \see isAdaptiveBuffering
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAdaptiveBuffering(bool adaptive);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the adaptive buffer count is enabled
+    ///
+    /// \return True if adaptive buffering is enabled, false otherwise
+    ///
+    /// \see setAdaptiveBuffering
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isAdaptiveBuffering() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Counters of the streaming health
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        Uint32       underruns;     ///< Number of times the stream ran out of data and had to restart
+        Uint64       chunks;        ///< Number of chunks requested with onGetData
+        Time         decodeTime;    ///< Total time spent in onGetData
+        Time         maxDecodeTime; ///< Longest time spent in a single call to onGetData
+        unsigned int queuedBuffers; ///< Number of buffers waiting to be played
+        unsigned int bufferCount;   ///< Number of buffers of the playing queue
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the counters of the streaming health
+    ///
+    /// The counters accumulate until resetStatistics is called,
+    /// except the queue depth (queued buffers and buffer count)
+    /// which is the state at the last update of the stream.
+    /// Frequent underruns mean that the buffers are too short
+    /// or that onGetData is too slow.
+    ///
+    /// \return Current statistics of the stream
+    ///
+    /// \see resetStatistics, AudioStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    Statistics getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the accumulated counters to zero
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -215,6 +343,9 @@ protected:
     /// If you return true (i.e. continue streaming) it is important that
     /// the returned array of samples is not empty; this would stop the stream
     /// due to an internal limitation.
+    /// The samples can be given either as 16 bits integers, or as
+    /// normalized floats (\a floatSamples), which are played without
+    /// conversion when OpenAL supports it.
     ///
     /// \param data Chunk of data to fill
     ///
@@ -236,14 +367,31 @@ protected:
 
 private:
 
+    friend class priv::SoundStreamScheduler;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run one step of the streaming loop
+    ///
+    /// This function is called by the streaming thread. The
+    /// first call creates and fills the buffers and starts
+    /// the playback, the following ones refill the buffers
+    /// that have been consumed in the meantime.
+    ///
+    /// \param wait Receives the time after which the stream
+    ///             needs to be serviced again
+    ///
+    /// \return True to keep streaming, false if the sound is stopped
+    ///
+    ////////////////////////////////////////////////////////////
+    bool streamData(Time& wait);
+
     ////////////////////////////////////////////////////////////
-    /// \brief Function called as the entry point of the thread
+    /// \brief Stop the playback and release the audio buffers
     ///
-    /// This function starts the streaming loop, and returns
-    /// only when the sound is stopped.
+    /// This function is called when streaming ends.
     ///
     ////////////////////////////////////////////////////////////
-    void streamData();
+    void releaseBuffers();
 
     ////////////////////////////////////////////////////////////
     /// \brief Fill a new buffer with audio samples, and append
@@ -253,7 +401,7 @@ private:
     /// consumed; it fills it again and inserts it back into the
     /// playing queue.
     ///
-    /// \param bufferNum Number of the buffer to fill (in [0, BufferCount])
+    /// \param bufferNum Number of the buffer to fill (in [0, m_buffers.size()])
     ///
     /// \return True if the stream source has requested to stop, false otherwise
     ///
@@ -279,25 +427,44 @@ private:
     ////////////////////////////////////////////////////////////
     void clearQueue();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a new buffer and append it to the playing queue
+    ///
+    /// This function is called in adaptive mode when the
+    /// stream runs out of data.
+    ///
+    ////////////////////////////////////////////////////////////
+    void growQueue();
+
     enum
     {
-        BufferCount = 3 ///< Number of audio buffers used by the streaming loop
+        MinBufferCount = 2, ///< Minimum number of audio buffers used by the streaming loop
+        MaxBufferCount = 16 ///< Maximum number of audio buffers used by the streaming loop
     };
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Thread        m_thread;                  ///< Thread running the background tasks
-    mutable Mutex m_threadMutex;             ///< Thread mutex
-    Status        m_threadStartState;        ///< State the thread starts in (Playing, Paused, Stopped)
-    bool          m_isStreaming;             ///< Streaming state (true = playing, false = stopped)
-    unsigned int  m_buffers[BufferCount];    ///< Sound buffers used to store temporary audio data
-    unsigned int  m_channelCount;            ///< Number of channels (1 = mono, 2 = stereo, ...)
-    unsigned int  m_sampleRate;              ///< Frequency (samples / second)
-    Uint32        m_format;                  ///< Format of the internal sound buffers
-    bool          m_loop;                    ///< Loop flag (true to loop, false to play once)
-    Uint64        m_samplesProcessed;        ///< Number of buffers processed since beginning of the stream
-    bool          m_endBuffers[BufferCount]; ///< Each buffer is marked as "end buffer" or not, for proper duration calculation
+    mutable Mutex             m_threadMutex;      ///< Thread mutex
+    Status                    m_threadStartState; ///< State the thread starts in (Playing, Paused, Stopped)
+    bool                      m_isStreaming;      ///< Streaming state (true = playing, false = stopped)
+    bool                      m_hasBuffers;       ///< Have the audio buffers been created by the streaming thread?
+    bool                      m_requestStop;      ///< Has the derived class requested to stop?
+    std::vector<unsigned int> m_buffers;          ///< Sound buffers used to store temporary audio data
+    unsigned int              m_bufferCount;      ///< Number of buffers used when the stream starts
+    Time                      m_bufferDuration;   ///< Duration of audio that derived classes should put in each buffer
+    bool                      m_adaptive;         ///< Is the number of buffers adapted to underruns?
+    Clock                     m_stableClock;      ///< Time since the last underrun, for adaptive buffering
+    unsigned int              m_channelCount;     ///< Number of channels (1 = mono, 2 = stereo, ...)
+    unsigned int              m_sampleRate;       ///< Frequency (samples / second)
+    Uint32                    m_format;           ///< Format of the internal sound buffers
+    Uint32                    m_floatFormat;      ///< Format of the internal sound buffers for float chunks (0 if not supported)
+    std::vector<Int16>        m_convertedSamples; ///< Float chunks converted to 16 bits, if float buffers are not supported
+    bool                      m_loop;             ///< Loop flag (true to loop, false to play once)
+    Uint64                    m_samplesProcessed; ///< Number of buffers processed since beginning of the stream
+    Uint64                    m_queuedSamples;    ///< Number of samples in the buffers of the playing queue
+    std::vector<bool>         m_endBuffers;       ///< Each buffer is marked as "end buffer" or not, for proper duration calculation
+    Statistics                m_statistics;       ///< Counters of the streaming health
 };
 
 } // namespace sf
@@ -331,10 +498,13 @@ private:
 /// \li onGetData fills a new chunk of audio data to be played
 /// \li onSeek changes the current playing position in the source
 ///
-/// It is important to note that each SoundStream is played in its
-/// own separate thread, so that the streaming loop doesn't block the
-/// rest of the program. In particular, the OnGetData and OnSeek
-/// virtual functions may sometimes be called from this separate thread.
+/// It is important to note that the audio data is streamed in a
+/// separate thread, so that the streaming loop doesn't block the
+/// rest of the program. This thread is shared by all the playing
+/// streams, and each of them is serviced only when its buffers are
+/// about to run out. In particular, the OnGetData and OnSeek
+/// virtual functions may sometimes be called from this separate thread,
+/// and a slow implementation delays the other streams.
 /// It is important to keep this in mind, because you may have to take
 /// care of synchronization issues if you share data between threads.
 ///
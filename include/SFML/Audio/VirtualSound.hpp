@@ -0,0 +1,401 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_VIRTUALSOUND_HPP
+#define SFML_VIRTUALSOUND_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundSource.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector3.hpp>
+
+
+namespace sf
+{
+class Sound;
+class SoundBuffer;
+class VoiceManager;
+
+////////////////////////////////////////////////////////////
+/// \brief Sound that only uses an audio source while it is audible
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API VirtualSound : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the sound and register it to a manager
+    ///
+    /// \param manager Voice manager providing the audio sources
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit VirtualSound(VoiceManager& manager);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the sound with a buffer
+    ///
+    /// \param manager Voice manager providing the audio sources
+    /// \param buffer  Sound buffer containing the audio data to play
+    ///
+    ////////////////////////////////////////////////////////////
+    VirtualSound(VoiceManager& manager, const SoundBuffer& buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~VirtualSound();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start or resume playing the sound
+    ///
+    /// The sound gets an audio source right away if one is
+    /// free and the sound is audible; otherwise it plays
+    /// virtually (its playing offset advances silently) until
+    /// the manager finds it audible enough to take a source.
+    ///
+    /// \see pause, stop
+    ///
+    ////////////////////////////////////////////////////////////
+    void play();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pause the sound
+    ///
+    /// \see play, stop
+    ///
+    ////////////////////////////////////////////////////////////
+    void pause();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop playing the sound
+    ///
+    /// \see play, pause
+    ///
+    ////////////////////////////////////////////////////////////
+    void stop();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the source buffer containing the audio data to play
+    ///
+    /// The sound is stopped. The buffer must remain alive as
+    /// long as the sound uses it.
+    ///
+    /// \param buffer Sound buffer to attach to the sound
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBuffer(const SoundBuffer& buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the audio buffer attached to the sound
+    ///
+    /// \return Sound buffer attached to the sound (can be NULL)
+    ///
+    ////////////////////////////////////////////////////////////
+    const SoundBuffer* getBuffer() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set whether or not the sound should loop after reaching the end
+    ///
+    /// \param loop True to play in loop, false to play once
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLoop(bool loop);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the sound is in loop mode
+    ///
+    /// \return True if the sound is looping, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getLoop() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current playing position of the sound
+    ///
+    /// \param timeOffset New playing position, from the beginning of the sound
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPlayingOffset(Time timeOffset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current playing position of the sound
+    ///
+    /// \return Current playing position, from the beginning of the sound
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getPlayingOffset() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current status of the sound
+    ///
+    /// \return Current status of the sound
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundSource::Status getStatus() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the priority of the sound
+    ///
+    /// When there are not enough audio sources for all the
+    /// playing sounds, sounds with a higher priority always
+    /// win over the others; among sounds of equal priority,
+    /// the loudest ones (according to their volume and their
+    /// distance to the listener) win.
+    /// The default priority is 0.
+    ///
+    /// \param priority Priority of the sound
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPriority(int priority);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the priority of the sound
+    ///
+    /// \return Priority of the sound
+    ///
+    ////////////////////////////////////////////////////////////
+    int getPriority() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the sound is currently without audio source
+    ///
+    /// \return True if the sound doesn't use an audio source
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isVirtual() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the pitch of the sound
+    ///
+    /// \param pitch New pitch to apply to the sound
+    ///
+    /// \see SoundSource::setPitch
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPitch(float pitch);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the volume of the sound
+    ///
+    /// \param volume Volume of the sound, in the range [0, 100]
+    ///
+    /// \see SoundSource::setVolume
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVolume(float volume);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the 3D position of the sound in the audio scene
+    ///
+    /// \param position Position of the sound in the scene
+    ///
+    /// \see SoundSource::setPosition
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPosition(const Vector3f& position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the sound's position relative to the listener or absolute
+    ///
+    /// \param relative True to set the position relative, false to set it absolute
+    ///
+    /// \see SoundSource::setRelativeToListener
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRelativeToListener(bool relative);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the minimum distance of the sound
+    ///
+    /// \param distance New minimum distance of the sound
+    ///
+    /// \see SoundSource::setMinDistance
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMinDistance(float distance);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the attenuation factor of the sound
+    ///
+    /// \param attenuation New attenuation factor of the sound
+    ///
+    /// \see SoundSource::setAttenuation
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAttenuation(float attenuation);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum distance of the sound
+    ///
+    /// Beyond this distance to the listener, the sound is
+    /// considered inaudible: it continues virtually, without
+    /// audio source, whatever its volume and priority. This
+    /// only affects the allocation of the audio sources, the
+    /// attenuation of the sound is not changed.
+    /// The default maximum distance is infinite.
+    ///
+    /// \param distance New maximum distance of the sound
+    ///
+    /// \see getMaxDistance, VoiceManager::setAudibilityThreshold
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMaxDistance(float distance);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the pitch of the sound
+    ///
+    /// \return Pitch of the sound
+    ///
+    ////////////////////////////////////////////////////////////
+    float getPitch() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the volume of the sound
+    ///
+    /// \return Volume of the sound, in the range [0, 100]
+    ///
+    ////////////////////////////////////////////////////////////
+    float getVolume() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the 3D position of the sound in the audio scene
+    ///
+    /// \return Position of the sound
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector3f getPosition() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the sound's position is relative to the listener
+    ///
+    /// \return True if the position is relative, false if it's absolute
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isRelativeToListener() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the minimum distance of the sound
+    ///
+    /// \return Minimum distance of the sound
+    ///
+    ////////////////////////////////////////////////////////////
+    float getMinDistance() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the attenuation factor of the sound
+    ///
+    /// \return Attenuation factor of the sound
+    ///
+    ////////////////////////////////////////////////////////////
+    float getAttenuation() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum distance of the sound
+    ///
+    /// \return Maximum distance of the sound
+    ///
+    /// \see setMaxDistance
+    ///
+    ////////////////////////////////////////////////////////////
+    float getMaxDistance() const;
+
+private:
+
+    friend class VoiceManager;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the gain of the sound as heard by the listener
+    ///
+    /// \return Volume attenuated by the distance to the listener, in [0, 1];
+    ///         0 beyond the maximum distance
+    ///
+    ////////////////////////////////////////////////////////////
+    float getAudibility() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start playing the sound on an audio source
+    ///
+    /// \param voice Sound owning the audio source
+    ///
+    ////////////////////////////////////////////////////////////
+    void attachVoice(Sound& voice);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give the audio source back, and continue virtually
+    ///
+    ////////////////////////////////////////////////////////////
+    void detachVoice();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    VoiceManager&       m_manager;      ///< Manager providing the audio sources
+    const SoundBuffer*  m_buffer;       ///< Sound buffer bound to the sound
+    Sound*              m_voice;        ///< Audio source currently used, if any
+    SoundSource::Status m_status;       ///< Requested status
+    Time                m_offset;       ///< Playing position when the clock was restarted
+    Clock               m_clock;        ///< Time elapsed since m_offset, while playing virtually
+    bool                m_loop;         ///< Loop flag
+    int                 m_priority;     ///< Priority of the sound
+    float               m_pitch;        ///< Pitch of the sound
+    float               m_volume;       ///< Volume of the sound
+    Vector3f            m_position;     ///< Position of the sound
+    bool                m_relative;     ///< Is the position relative to the listener?
+    float               m_minDistance;  ///< Minimum distance of the sound
+    float               m_attenuation;  ///< Attenuation factor of the sound
+    float               m_maxDistance;  ///< Distance beyond which the sound is inaudible
+};
+
+} // namespace sf
+
+
+#endif // SFML_VIRTUALSOUND_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::VirtualSound
+/// \ingroup audio
+///
+/// sf::VirtualSound has the same interface as sf::Sound, but
+/// it doesn't own an audio source: it borrows one from a
+/// sf::VoiceManager while it is playing and audible enough.
+/// When it loses its source, its playing position keeps
+/// advancing so that it resumes at the right place if it
+/// becomes audible again.
+///
+/// Since the volume, pitch and position parameters of the
+/// sound are stored by the sound itself rather than by an
+/// OpenAL source, you can create many more virtual sounds
+/// than the audio device supports.
+///
+/// \see sf::VoiceManager, sf::Sound
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,249 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_VOICEMANAGER_HPP
+#define SFML_VOICEMANAGER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Sound;
+class VirtualSound;
+
+////////////////////////////////////////////////////////////
+/// \brief Share a fixed set of audio sources between virtual sounds
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API VoiceManager : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the manager and its audio sources
+    ///
+    /// Audio devices usually support between 32 and 256
+    /// sources in total, remember to leave some to the other
+    /// sounds and musics of the program.
+    ///
+    /// \param voiceCount Number of audio sources to create
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit VoiceManager(std::size_t voiceCount = 32);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// All the virtual sounds registered to the manager must
+    /// be destroyed before it.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~VoiceManager();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Assign the audio sources to the most audible sounds
+    ///
+    /// This function must be called regularly, typically once
+    /// per frame after the sounds and the listener have moved.
+    /// It ranks the playing sounds by priority, then by volume
+    /// attenuated by the distance to the listener, and gives
+    /// the audio sources to the first ones; the others continue
+    /// virtually. Sounds below the audibility threshold continue
+    /// virtually too, even if there are free audio sources.
+    ///
+    ////////////////////////////////////////////////////////////
+    void update();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the audibility below which sounds are culled
+    ///
+    /// The audibility of a sound is its volume, in [0, 1],
+    /// attenuated by its distance to the listener with the
+    /// same model as OpenAL; it is 0 beyond the maximum
+    /// distance of the sound (see VirtualSound::setMaxDistance).
+    /// Sounds less audible than the threshold release their
+    /// audio source and continue virtually, whatever their
+    /// priority, and get a source again at the right playing
+    /// offset when they become audible. This keeps the cost of
+    /// the audio scene proportional to the sounds that can
+    /// actually be heard.
+    ///
+    /// Silent sounds (muted, or beyond their maximum distance)
+    /// are always culled. A threshold of 0.01 (-40 dB) is a
+    /// good start for most scenes; the default threshold is 0,
+    /// which only culls the silent sounds.
+    ///
+    /// \param threshold Minimum audibility to use an audio source, in [0, 1]
+    ///
+    /// \see getAudibilityThreshold, getCulledSoundCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAudibilityThreshold(float threshold);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the audibility below which sounds are culled
+    ///
+    /// \return Minimum audibility to use an audio source
+    ///
+    /// \see setAudibilityThreshold
+    ///
+    ////////////////////////////////////////////////////////////
+    float getAudibilityThreshold() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of audio sources of the manager
+    ///
+    /// \return Number of audio sources
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getVoiceCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of audio sources currently used
+    ///
+    /// \return Number of sounds that are not virtual
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getActiveVoiceCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of playing sounds culled by the last update
+    ///
+    /// Culled sounds are the ones below the audibility
+    /// threshold, or beyond their maximum distance.
+    ///
+    /// \return Number of playing sounds too quiet to use an audio source
+    ///
+    /// \see setAudibilityThreshold
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCulledSoundCount() const;
+
+private:
+
+    friend class VirtualSound;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Register a virtual sound
+    ///
+    /// \param sound Sound to register
+    ///
+    ////////////////////////////////////////////////////////////
+    void addSound(VirtualSound* sound);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unregister a virtual sound
+    ///
+    /// \param sound Sound to unregister
+    ///
+    ////////////////////////////////////////////////////////////
+    void removeSound(VirtualSound* sound);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take a free audio source
+    ///
+    /// \return Free audio source, or NULL if they are all used
+    ///
+    ////////////////////////////////////////////////////////////
+    Sound* acquireVoice();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give an audio source back
+    ///
+    /// \param voice Audio source to release
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseVoice(Sound* voice);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a sound is audible enough to use an audio source
+    ///
+    /// \param audibility Audibility of the sound
+    ///
+    /// \return True if the sound passes the audibility threshold
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isAudible(float audibility) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Sound*>        m_voices;     ///< All the audio sources
+    std::vector<Sound*>        m_freeVoices; ///< Audio sources not used by any sound
+    std::vector<VirtualSound*> m_sounds;     ///< Registered sounds
+    float                      m_threshold;  ///< Audibility below which sounds are culled
+    std::size_t                m_culled;     ///< Number of sounds culled by the last update
+};
+
+} // namespace sf
+
+
+#endif // SFML_VOICEMANAGER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::VoiceManager
+/// \ingroup audio
+///
+/// Every sf::Sound owns an OpenAL source, and the number of
+/// sources is limited by the audio device: past this limit,
+/// new sounds silently fail to play. sf::VoiceManager creates
+/// a fixed number of sources and lends them to sf::VirtualSound
+/// instances, so that only the most important sounds actually
+/// use one.
+///
+/// Usage example:
+/// \code
+/// sf::VoiceManager voices(16);
+///
+/// // Don't waste sources on sounds quieter than -40 dB
+/// voices.setAudibilityThreshold(0.01f);
+///
+/// std::vector<sf::VirtualSound*> explosions;
+/// for (int i = 0; i < 100; ++i)
+/// {
+///     sf::VirtualSound* explosion = new sf::VirtualSound(voices, buffer);
+///     explosion->setPosition(sf::Vector3f(i * 10.f, 0.f, 0.f));
+///     explosion->setMaxDistance(300.f);
+///     explosion->play();
+///     explosions.push_back(explosion);
+/// }
+///
+/// while (window.isOpen())
+/// {
+///     ...
+///     sf::Listener::setPosition(playerPosition);
+///     voices.update();
+/// }
+/// \endcode
+///
+/// \see sf::VirtualSound
+///
+////////////////////////////////////////////////////////////
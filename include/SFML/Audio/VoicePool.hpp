@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_VOICEPOOL_HPP
+#define SFML_VOICEPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/Config.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+    class CompressedVoice;
+}
+
+class CompressedSoundBuffer;
+class SoundSource;
+
+////////////////////////////////////////////////////////////
+/// \brief Fixed set of streaming voices playing compressed sounds
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API VoicePool : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the pool
+    ///
+    /// \param voiceCount Maximum number of sounds played simultaneously
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit VoicePool(std::size_t voiceCount = 8);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// All the voices are stopped.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~VoicePool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Play a compressed sound on a free voice
+    ///
+    /// The sound is decoded while it is played. If all the
+    /// voices are busy, the one that was started first is
+    /// interrupted and reused.
+    /// The returned source can be used to change the volume,
+    /// pitch or position of the sound; they are reset to their
+    /// default values every time a voice is reused. It remains
+    /// valid as long as the pool is alive, but it may be reused
+    /// for another sound as soon as this one is finished.
+    /// The buffer must remain alive as long as it is played.
+    ///
+    /// \param buffer Sound to play
+    ///
+    /// \return Voice playing the sound (stopped if the buffer is empty)
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundSource& play(const CompressedSoundBuffer& buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop all the voices
+    ///
+    ////////////////////////////////////////////////////////////
+    void stop();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop the voices that play a given sound
+    ///
+    /// This function must be called before destroying a buffer
+    /// that may still be playing.
+    ///
+    /// \param buffer Sound to stop
+    ///
+    ////////////////////////////////////////////////////////////
+    void stop(const CompressedSoundBuffer& buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of voices of the pool
+    ///
+    /// \return Maximum number of sounds played simultaneously
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getVoiceCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of voices currently playing
+    ///
+    /// \return Number of playing or paused voices
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPlayingCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<priv::CompressedVoice*> m_voices;    ///< Streaming voices
+    Uint64                              m_playCount; ///< Number of sounds started, used to find the oldest voice
+};
+
+} // namespace sf
+
+
+#endif // SFML_VOICEPOOL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::VoicePool
+/// \ingroup audio
+///
+/// sf::VoicePool plays sf::CompressedSoundBuffer instances:
+/// each of its voices is a small sound stream that decodes
+/// the sound file from memory while it is played, so that the
+/// decoded samples never need to be stored entirely.
+///
+/// The number of voices bounds both the number of sounds that
+/// can be heard at the same time and the decoding work.
+///
+/// Usage example:
+/// \code
+/// sf::VoicePool voices(4);
+///
+/// sf::SoundSource& voice = voices.play(dialogLine);
+/// voice.setVolume(80);
+/// \endcode
+///
+/// \see sf::CompressedSoundBuffer
+///
+////////////////////////////////////////////////////////////
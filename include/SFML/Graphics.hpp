@@ -31,29 +31,59 @@
 
 #include <SFML/Window.hpp>
 #include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/CacheLayer.hpp>
+#include <SFML/Graphics/ChunkedVertexArray.hpp>
 #include <SFML/Graphics/CircleShape.hpp>
 #include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/CommandBuffer.hpp>
+#include <SFML/Graphics/CompactVertex.hpp>
 #include <SFML/Graphics/ConvexShape.hpp>
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/FramePipeline.hpp>
+#include <SFML/Graphics/FrameRecorder.hpp>
 #include <SFML/Graphics/Glyph.hpp>
+#include <SFML/Graphics/GpuMemory.hpp>
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageLoadQueue.hpp>
+#include <SFML/Graphics/ImageView.hpp>
+#include <SFML/Graphics/Instance.hpp>
+#include <SFML/Graphics/Node.hpp>
+#include <SFML/Graphics/ParticleSystem.hpp>
+#include <SFML/Graphics/PostProcessChain.hpp>
 #include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/ReadbackQueue.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/RenderQueue.hpp>
 #include <SFML/Graphics/RenderStates.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/Shape.hpp>
+#include <SFML/Graphics/ShapeBatch.hpp>
+#include <SFML/Graphics/SharedTexture.hpp>
 #include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/SpriteBatch.hpp>
+#include <SFML/Graphics/StencilMode.hpp>
 #include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/TextCache.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/TextureArray.hpp>
+#include <SFML/Graphics/TextureAtlas.hpp>
+#include <SFML/Graphics/TextureCache.hpp>
+#include <SFML/Graphics/TextureLoadQueue.hpp>
+#include <SFML/Graphics/TextureManager.hpp>
+#include <SFML/Graphics/TextureUpload.hpp>
+#include <SFML/Graphics/TiledTexture.hpp>
 #include <SFML/Graphics/Transform.hpp>
 #include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/UniformBuffer.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/VideoTexture.hpp>
 #include <SFML/Graphics/View.hpp>
 
 
@@ -146,10 +146,11 @@ SFML_GRAPHICS_API bool operator !=(const BlendMode& left, const BlendMode& right
 ////////////////////////////////////////////////////////////
 // Commonly used blending modes
 ////////////////////////////////////////////////////////////
-SFML_GRAPHICS_API extern const BlendMode BlendAlpha;    ///< Blend source and dest according to dest alpha
-SFML_GRAPHICS_API extern const BlendMode BlendAdd;      ///< Add source to dest
-SFML_GRAPHICS_API extern const BlendMode BlendMultiply; ///< Multiply source and dest
-SFML_GRAPHICS_API extern const BlendMode BlendNone;     ///< Overwrite dest with source
+SFML_GRAPHICS_API extern const BlendMode BlendAlpha;              ///< Blend source and dest according to dest alpha
+SFML_GRAPHICS_API extern const BlendMode BlendPremultipliedAlpha; ///< Blend premultiplied source and dest according to source alpha
+SFML_GRAPHICS_API extern const BlendMode BlendAdd;                ///< Add source to dest
+SFML_GRAPHICS_API extern const BlendMode BlendMultiply;           ///< Multiply source and dest
+SFML_GRAPHICS_API extern const BlendMode BlendNone;               ///< Overwrite dest with source
 
 } // namespace sf
 
@@ -200,11 +201,19 @@ SFML_GRAPHICS_API extern const BlendMode BlendNone;     ///< Overwrite dest with
 ///
 /// \code
 /// sf::BlendMode alphaBlending          = sf::BlendAlpha;
+/// sf::BlendMode premultipliedBlending  = sf::BlendPremultipliedAlpha;
 /// sf::BlendMode additiveBlending       = sf::BlendAdd;
 /// sf::BlendMode multiplicativeBlending = sf::BlendMultipy;
 /// sf::BlendMode noBlending             = sf::BlendNone;
 /// \endcode
 ///
+/// sf::BlendPremultipliedAlpha is the alpha blending of colors
+/// that are already multiplied by their alpha (see
+/// sf::Image::premultiplyAlpha). Textures flagged as premultiplied
+/// are drawn with it instead of sf::BlendAlpha automatically;
+/// their vertex colors must be premultiplied too, for example
+/// sf::Color(128, 128, 128, 128) to draw at half opacity.
+///
 /// In SFML, a blend mode can be specified every time you draw a sf::Drawable
 /// object to a render target. It is part of the sf::RenderStates compound
 /// that is passed to the member function sf::RenderTarget::draw().
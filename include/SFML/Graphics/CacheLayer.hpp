@@ -0,0 +1,240 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_CACHELAYER_HPP
+#define SFML_CACHELAYER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Text;
+
+////////////////////////////////////////////////////////////
+/// \brief Drawable that renders a group of drawables once and reuses the result
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API CacheLayer : public Drawable, public Transformable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty layer, create must be called before
+    /// it can be drawn.
+    ///
+    ////////////////////////////////////////////////////////////
+    CacheLayer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the internal render texture of the layer
+    ///
+    /// The drawables of the layer are rendered to the area
+    /// (0, 0, width, height) of their own coordinate system:
+    /// anything outside it is clipped.
+    ///
+    /// \param width  Width of the layer, in pixels
+    /// \param height Height of the layer, in pixels
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a drawable to the layer
+    ///
+    /// The drawable is drawn after the ones previously
+    /// added. The layer doesn't copy it, it must stay alive
+    /// as long as it belongs to the layer.
+    ///
+    /// \param drawable Drawable to add
+    ///
+    /// \see remove, clear
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const Drawable& drawable);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a drawable from the layer
+    ///
+    /// This function does nothing if \a drawable doesn't
+    /// belong to the layer.
+    ///
+    /// \param drawable Drawable to remove
+    ///
+    /// \see add, clear
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(const Drawable& drawable);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the drawables from the layer
+    ///
+    /// \see add, remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Force the layer to render its drawables again
+    ///
+    /// Changes of the transform of transformable drawables
+    /// and changes of the properties of sf::Text drawables
+    /// are detected automatically. Any other change, such as
+    /// the color of a shape or the texture of a sprite, must
+    /// be notified by calling this function.
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture holding the rendered drawables
+    ///
+    /// The texture is only updated when the layer is drawn.
+    ///
+    /// \return Texture of the layer
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the layer
+    ///
+    /// \return Local bounding rectangle of the layer
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the layer
+    ///
+    /// \return Global bounding rectangle of the layer
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the layer to a render target
+    ///
+    /// The drawables are rendered again first if they changed.
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether a drawable changed since the last rendering
+    ///
+    /// The revisions of the changed drawables are updated.
+    ///
+    /// \return True if at least one drawable changed
+    ///
+    ////////////////////////////////////////////////////////////
+    bool checkChanges() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Drawable of the layer, with what is needed to detect its changes
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        const Drawable*      drawable;          ///< Drawable to render
+        const Transformable* transformable;     ///< Same object seen as a transformable, if it is one
+        const Text*          text;              ///< Same object seen as a text, if it is one
+        Uint32               transformRevision; ///< Revision of the transform at the last rendering
+        Uint32               textRevision;      ///< Revision of the text at the last rendering
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    mutable std::vector<Entry> m_entries;       ///< Drawables of the layer, in drawing order
+    mutable RenderTexture      m_renderTexture; ///< Render texture holding the rendered drawables
+    Vertex                     m_vertices[4];   ///< Quad displaying the render texture
+    mutable bool               m_needUpdate;    ///< Must the drawables be rendered again?
+};
+
+} // namespace sf
+
+
+#endif // SFML_CACHELAYER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::CacheLayer
+/// \ingroup graphics
+///
+/// sf::CacheLayer renders a group of drawables into an
+/// internal render texture, and then draws this texture as a
+/// single quad for as long as the drawables don't change. It
+/// is meant for parts of a scene which rarely change but are
+/// expensive to draw, such as user interface panels made of
+/// many texts and shapes.
+///
+/// The layer detects by itself when one of its transformable
+/// drawables is moved, rotated or scaled, and when one of
+/// its texts changes; other modifications must be notified
+/// with invalidate(). Comparing these revisions is very
+/// cheap, so a layer whose contents didn't change costs a
+/// single textured quad per frame.
+///
+/// The drawables are rendered in the local coordinate system
+/// of the layer, and the layer itself is a sf::Transformable.
+/// Alpha-blended contents are composed with premultiplied
+/// alpha, so that translucent edges look the same as if
+/// the drawables were drawn directly.
+///
+/// Usage example:
+/// \code
+/// sf::CacheLayer panel;
+/// panel.create(300, 200);
+/// panel.add(background);
+/// panel.add(title);
+/// panel.add(score);
+/// panel.setPosition(10, 10);
+/// ...
+/// score.setString("1200"); // detected automatically
+/// ...
+/// window.draw(panel);
+/// \endcode
+///
+/// \see sf::RenderTexture
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,241 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_CHUNKEDVERTEXARRAY_HPP
+#define SFML_CHUNKEDVERTEXARRAY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class VertexArray;
+class View;
+
+////////////////////////////////////////////////////////////
+/// \brief Large static set of primitives split into a grid
+///        of chunks, of which only the visible ones are drawn
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ChunkedVertexArray : public Drawable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty array.
+    ///
+    ////////////////////////////////////////////////////////////
+    ChunkedVertexArray();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the array from a set of vertices
+    ///
+    /// The primitives are sorted into square chunks of
+    /// \a chunkSize units, according to the center of their
+    /// bounding rectangle, and uploaded to the graphics card
+    /// once. The order of the primitives is preserved inside
+    /// each chunk, but not across chunks.
+    ///
+    /// Only independent primitives (sf::Points, sf::Lines,
+    /// sf::Triangles and sf::Quads) can be split, strips and
+    /// fans are rejected. Incomplete primitives at the end of
+    /// the array are ignored.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives drawn by the vertices
+    /// \param chunkSize   Size of the chunks, in local units
+    ///
+    /// \return True if the array was successfully created
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, float chunkSize = 512.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the array from a vertex array
+    ///
+    /// \param vertices  Vertex array to split
+    /// \param chunkSize Size of the chunks, in local units
+    ///
+    /// \return True if the array was successfully created
+    ///
+    /// \see create
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(const VertexArray& vertices, float chunkSize = 512.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the vertices and the chunks
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the total number of vertices
+    ///
+    /// \return Number of vertices in all the chunks
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getVertexCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the type of primitives drawn by the array
+    ///
+    /// \return Primitive type
+    ///
+    ////////////////////////////////////////////////////////////
+    PrimitiveType getPrimitiveType() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of chunks in each direction
+    ///
+    /// \return Number of columns and rows of chunks
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getChunkCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the bounding rectangle of the array
+    ///
+    /// Unlike VertexArray::getBounds, the bounds are computed
+    /// once when the array is created.
+    ///
+    /// \return Bounding rectangle of all the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Range of vertices covering a cell of the grid
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Chunk
+    {
+        std::size_t first;  ///< Index of the first vertex of the chunk
+        std::size_t count;  ///< Number of vertices in the chunk
+        FloatRect   bounds; ///< Bounding rectangle of the vertices of the chunk
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the visible chunks to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw a range of sorted vertices
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    /// \param first  Index of the first vertex to draw
+    /// \param count  Number of vertices to draw
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawVertices(RenderTarget& target, const RenderStates& states, std::size_t first, std::size_t count) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the area covered by a view, in local coordinates
+    ///
+    /// \param view      View to check
+    /// \param transform Transform applied to the array
+    ///
+    /// \return Visible area in local coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    static FloatRect getVisibleArea(const View& view, const Transform& transform);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    PrimitiveType       m_primitiveType; ///< Type of primitives to draw
+    float               m_chunkSize;     ///< Size of the cells of the grid
+    Vector2u            m_chunkCount;    ///< Number of columns and rows of the grid
+    Vector2f            m_overflow;      ///< Largest distance by which a chunk exceeds its cell
+    FloatRect           m_bounds;        ///< Bounding rectangle of all the vertices
+    std::vector<Chunk>  m_chunks;        ///< Chunks of the grid, row by row
+    std::vector<Vertex> m_vertices;      ///< Vertices sorted by chunk, when vertex buffers are not available
+    VertexBuffer        m_buffer;        ///< Vertices sorted by chunk, on the graphics card
+};
+
+} // namespace sf
+
+
+#endif // SFML_CHUNKEDVERTEXARRAY_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ChunkedVertexArray
+/// \ingroup graphics
+///
+/// A big static map (tiles, terrain, decals) is commonly
+/// built as a single sf::VertexArray, which is entirely
+/// transformed and sent to the graphics card every frame
+/// even though only a small part of it is visible.
+///
+/// sf::ChunkedVertexArray sorts the primitives of such a map
+/// into a uniform grid of chunks, stores them in a static
+/// vertex buffer, and computes the bounds of every chunk once.
+/// When it is drawn, only the chunks that intersect the
+/// current view are rendered, and neighbour chunks of the same
+/// row are merged into a single draw call: the cost depends
+/// on the visible part of the map, not on its total size.
+///
+/// The content can't be modified after creation; to change
+/// it, call create again.
+///
+/// Usage example:
+/// \code
+/// sf::VertexArray map(sf::Quads);
+/// for (unsigned int y = 0; y < 2000; ++y)
+///     for (unsigned int x = 0; x < 2000; ++x)
+///         appendTile(map, x, y);
+///
+/// sf::ChunkedVertexArray chunked;
+/// chunked.create(map, 16 * 32); // chunks of 16x16 tiles of 32 pixels
+///
+/// sf::RenderStates states;
+/// states.texture = &tileset;
+/// window.draw(chunked, states);
+/// \endcode
+///
+/// \see sf::VertexArray, sf::VertexBuffer
+///
+////////////////////////////////////////////////////////////
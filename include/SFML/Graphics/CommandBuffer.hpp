@@ -0,0 +1,262 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_COMMANDBUFFER_HPP
+#define SFML_COMMANDBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/ThreadLocalPtr.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Drawable;
+class RenderQueue;
+class RenderTarget;
+class VertexBuffer;
+
+////////////////////////////////////////////////////////////
+/// \brief Thread-safe recorder of draw commands, filled by
+///        worker threads and rendered by the render thread
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API CommandBuffer : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty command buffer.
+    ///
+    ////////////////////////////////////////////////////////////
+    CommandBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~CommandBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the group of the commands that the calling thread records next
+    ///
+    /// Groups are submitted in increasing order, which makes the
+    /// final drawing order independent of the scheduling of the
+    /// worker threads. The commands of a group are submitted in
+    /// the order they were recorded. If several threads record
+    /// commands in the same group, the order between threads is
+    /// unspecified: give each task its own group.
+    ///
+    /// The group is a property of each thread; it is 0 for a
+    /// thread that never called this function.
+    ///
+    /// \param group New group of the calling thread
+    ///
+    /// \see getGroup
+    ///
+    ////////////////////////////////////////////////////////////
+    void setGroup(Uint32 group);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the group of the commands that the calling thread records next
+    ///
+    /// \return Current group of the calling thread
+    ///
+    /// \see setGroup
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getGroup() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record the draw commands of a drawable object
+    ///
+    /// This function can be called from any thread, concurrently.
+    /// The geometry of the drawable is copied into the arena of
+    /// the calling thread. The textures and shaders that it uses
+    /// must stay alive until the buffer is submitted.
+    ///
+    /// \param drawable Object to record
+    /// \param states   Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Drawable& drawable, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives defined by an array of vertices
+    ///
+    /// This function can be called from any thread, concurrently.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives defined by a vertex buffer
+    ///
+    /// This function can be called from any thread, concurrently.
+    /// The vertex buffer is not copied, it must stay alive and
+    /// unchanged until the buffer is submitted.
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render the recorded commands to a target
+    ///
+    /// This function must be called from the thread where the
+    /// target is used, once the worker threads have finished
+    /// recording. The commands are rendered group after group.
+    /// The buffer is left unchanged, so that the same commands
+    /// can be submitted again; call clear() to start a new frame.
+    ///
+    /// \param target Render target to draw to
+    ///
+    ////////////////////////////////////////////////////////////
+    void submit(RenderTarget& target);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the recorded commands
+    ///
+    /// The arenas of the threads keep their memory, so that the
+    /// next frame doesn't allocate again. The groups of the threads
+    /// are preserved. This function must not be called while
+    /// other threads are recording.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of recorded commands
+    ///
+    /// \return Number of commands, all threads included
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCommandCount() const;
+
+private:
+
+    struct Arena;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the arena of the calling thread, creating it if needed
+    ///
+    /// \return Arena of the calling thread
+    ///
+    ////////////////////////////////////////////////////////////
+    Arena& getArena();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Range of commands to submit
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Range
+    {
+        Uint32      group;        ///< Group of the commands
+        std::size_t arena;        ///< Index of the arena holding the commands
+        std::size_t firstCommand; ///< Index of the first command in the arena
+        std::size_t commandCount; ///< Number of commands
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Order the ranges by group
+        ///
+        ////////////////////////////////////////////////////////////
+        bool operator <(const Range& right) const {return group < right.group;}
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Arena*>   m_arenas; ///< Arenas of all the threads that recorded commands
+    ThreadLocalPtr<Arena> m_arena;  ///< Arena of the calling thread
+    mutable Mutex         m_mutex;  ///< Mutex protecting the list of arenas
+    std::vector<Range>    m_ranges; ///< Ranges of commands being submitted, kept to avoid reallocations
+};
+
+} // namespace sf
+
+
+#endif // SFML_COMMANDBUFFER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::CommandBuffer
+/// \ingroup graphics
+///
+/// OpenGL commands can only be issued from the thread where the
+/// context of the render target is active, which usually prevents
+/// the traversal of a scene from being spread over several threads.
+/// sf::CommandBuffer separates the two steps: worker threads record
+/// draw commands into the buffer concurrently, and the render thread
+/// then submits all of them to a render target with a single call.
+///
+/// Each thread that records commands gets its own arena inside the
+/// buffer, where the vertices and render states of its commands are
+/// copied; threads never wait for each other while recording. To
+/// make the final drawing order deterministic, each thread assigns
+/// its commands to a group with setGroup: groups are rendered in
+/// increasing order, and the commands of a group in the order they
+/// were recorded.
+///
+/// The buffer only keeps pointers to the textures, shaders and
+/// vertex buffers: they must stay alive until the commands are
+/// submitted. Recording must be finished (e.g. the worker
+/// tasks joined) before submit or clear is called.
+///
+/// Usage example:
+/// \code
+/// sf::CommandBuffer commands;
+///
+/// // In each worker task, for chunk i of the scene
+/// commands.setGroup(i);
+/// for (std::size_t j = 0; j < chunks[i].objects.size(); ++j)
+///     commands.draw(chunks[i].objects[j]);
+///
+/// // In the render thread, once the tasks are done
+/// window.clear();
+/// commands.submit(window);
+/// window.display();
+/// commands.clear();
+/// \endcode
+///
+/// \see sf::RenderQueue, sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
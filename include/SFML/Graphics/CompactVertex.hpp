@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_COMPACTVERTEX_HPP
+#define SFML_COMPACTVERTEX_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Vector2.hpp>
+
+
+namespace sf
+{
+class Vertex;
+
+////////////////////////////////////////////////////////////
+/// \brief Vertex with integer position and texture coordinates
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API CompactVertex
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    CompactVertex();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the vertex from its position
+    ///
+    /// The vertex color is white and texture coordinates are (0, 0).
+    ///
+    /// \param thePosition Vertex position
+    ///
+    ////////////////////////////////////////////////////////////
+    CompactVertex(const Vector2<Int16>& thePosition);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the vertex from its position and color
+    ///
+    /// The texture coordinates are (0, 0).
+    ///
+    /// \param thePosition Vertex position
+    /// \param theColor    Vertex color
+    ///
+    ////////////////////////////////////////////////////////////
+    CompactVertex(const Vector2<Int16>& thePosition, const Color& theColor);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the vertex from its position and texture coordinates
+    ///
+    /// The vertex color is white.
+    ///
+    /// \param thePosition  Vertex position
+    /// \param theTexCoords Vertex texture coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    CompactVertex(const Vector2<Int16>& thePosition, const Vector2<Int16>& theTexCoords);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the vertex from its position, color and texture coordinates
+    ///
+    /// \param thePosition  Vertex position
+    /// \param theColor     Vertex color
+    /// \param theTexCoords Vertex texture coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    CompactVertex(const Vector2<Int16>& thePosition, const Color& theColor, const Vector2<Int16>& theTexCoords);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the vertex from a regular vertex
+    ///
+    /// The position and texture coordinates are rounded to
+    /// the nearest integers, they must fit in 16 bits.
+    ///
+    /// \param vertex Vertex to convert
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit CompactVertex(const Vertex& vertex);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2<Int16> position;  ///< 2D position of the vertex
+    Color          color;     ///< Color of the vertex
+    Vector2<Int16> texCoords; ///< Coordinates of the texture's pixel to map to the vertex
+};
+
+} // namespace sf
+
+
+#endif // SFML_COMPACTVERTEX_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::CompactVertex
+/// \ingroup graphics
+///
+/// sf::CompactVertex holds the same attributes as sf::Vertex,
+/// but stores the position and the texture coordinates as
+/// 16-bit integers: it takes 12 bytes instead of 20. It is
+/// meant for geometry that is aligned on whole pixels, such
+/// as tile maps built from a texture atlas, where it reduces
+/// the amount of memory read by the graphics card for each
+/// vertex by 40%.
+///
+/// Compact vertices are stored in a sf::VertexBuffer whose
+/// layout is sf::VertexBuffer::Compact. The position is local
+/// to the buffer: the transform of the render states is applied
+/// as usual, therefore the geometry can still be moved, rotated
+/// and scaled freely.
+///
+/// Example:
+/// \code
+/// sf::CompactVertex vertices[] =
+/// {
+///     sf::CompactVertex(sf::Vector2<sf::Int16>( 0,  0), sf::Vector2<sf::Int16>( 0,  0)),
+///     sf::CompactVertex(sf::Vector2<sf::Int16>( 0, 32), sf::Vector2<sf::Int16>( 0, 32)),
+///     sf::CompactVertex(sf::Vector2<sf::Int16>(32, 32), sf::Vector2<sf::Int16>(32, 32)),
+///     sf::CompactVertex(sf::Vector2<sf::Int16>(32,  0), sf::Vector2<sf::Int16>(32,  0))
+/// };
+///
+/// sf::VertexBuffer tile(sf::Quads, sf::VertexBuffer::Static, sf::VertexBuffer::Compact);
+/// tile.create(4);
+/// tile.update(vertices);
+/// ...
+/// window.draw(tile, &atlas);
+/// \endcode
+///
+/// \see sf::Vertex, sf::VertexBuffer
+///
+////////////////////////////////////////////////////////////
@@ -31,17 +31,26 @@
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Glyph.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/TextureAtlas.hpp>
 #include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/MemoryTracker.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/String.hpp>
-#include <map>
+#include <deque>
 #include <string>
 #include <vector>
 
 
 namespace sf
 {
+class FileInputStream;
 class InputStream;
+class Shader;
+
+namespace priv
+{
+    class GlyphRasterizer;
+}
 
 ////////////////////////////////////////////////////////////
 /// \brief Class for loading and manipulating character fonts
@@ -60,6 +69,18 @@ public:
         std::string family; ///< The font family
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Hinting modes used to rasterize the glyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Hinting
+    {
+        NoHinting,     ///< Outlines are rasterized as they are, the fastest mode
+        LightHinting,  ///< Outlines are only adjusted vertically, which preserves their shape
+        NativeHinting, ///< Outlines are adjusted by the hinting instructions of the font
+        AutoHinting    ///< Outlines are adjusted by the FreeType auto-hinter, the slowest mode
+    };
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -94,6 +115,9 @@ public:
     /// Note that this function know nothing about the standard
     /// fonts installed on the user's system, thus you can't
     /// load them directly.
+    /// On desktop platforms, the file is mapped in memory: the
+    /// system reads its pages only when glyphs need them, and
+    /// shares them with the other processes using the same font.
     ///
     /// \param filename Path of the font file to load
     ///
@@ -156,6 +180,11 @@ public:
     /// might be available. If the glyph is not available at the
     /// requested size, an empty glyph is returned.
     ///
+    /// Retrieving a glyph that is already loaded doesn't modify
+    /// the font, so several threads can do it at the same time,
+    /// as long as none of them loads new glyphs. The same goes
+    /// for the kerning and the line metrics once they are cached.
+    ///
     /// \param codePoint     Unicode code point of the character to get
     /// \param characterSize Reference character size
     /// \param bold          Retrieve the bold version or the regular one?
@@ -165,6 +194,167 @@ public:
     ////////////////////////////////////////////////////////////
     const Glyph& getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a set of glyphs in advance
+    ///
+    /// Glyphs are normally loaded the first time they are
+    /// requested, and each one is uploaded to the texture
+    /// separately. This function rasterizes all the missing
+    /// glyphs of \a characters first, and then uploads them
+    /// with a few texture updates (one per modified region of
+    /// the texture). It is much faster than letting getGlyph
+    /// load the glyphs one by one when many new characters
+    /// appear at once, for example with CJK text.
+    ///
+    /// Characters that are already loaded are ignored.
+    ///
+    /// \param characters    Characters to load
+    /// \param characterSize Reference character size
+    /// \param bold          Load the bold version or the regular one?
+    ///
+    /// \see getGlyph
+    ///
+    ////////////////////////////////////////////////////////////
+    void preloadGlyphs(const String& characters, unsigned int characterSize, bool bold) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the loading of glyphs in a background thread
+    ///
+    /// When enabled, the glyphs that are not loaded yet are
+    /// rasterized by a worker thread, so that the rendering
+    /// thread isn't blocked by FreeType. Until a glyph is
+    /// ready, getGlyph returns an empty glyph, which sf::Text
+    /// skips; texts using the font update their geometry
+    /// automatically when the glyph becomes available (the
+    /// glyphs are uploaded to the texture when a text using
+    /// the font is drawn). preloadGlyphs is not affected.
+    ///
+    /// The worker opens the font a second time, it is only
+    /// supported for fonts loaded with loadFromFile or
+    /// loadFromMemory; with other fonts, glyphs are still
+    /// loaded synchronously.
+    ///
+    /// Asynchronous loading is disabled by default.
+    ///
+    /// \param enabled True to load glyphs in the background
+    ///
+    /// \see isAsyncLoadingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAsyncLoadingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether glyphs are loaded in a background thread
+    ///
+    /// \return True if asynchronous loading is enabled
+    ///
+    /// \see setAsyncLoadingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isAsyncLoadingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the signed distance field mode
+    ///
+    /// By default, glyphs are rasterized separately for every
+    /// character size, each size having its own texture. In
+    /// distance field mode, glyphs are rasterized once at a
+    /// reference size of 48 pixels, and stored as a distance to
+    /// their outline in a single texture shared by all the
+    /// sizes; sf::Text renders them at any size with a small
+    /// built-in shader (unless you provide your own shader in
+    /// the render states). This saves a lot of memory and
+    /// loading time when text is displayed at many different
+    /// sizes, for example in zoomable user interfaces, at the
+    /// cost of slightly rounded corners at very big sizes and
+    /// less crisp small text.
+    ///
+    /// The distance field mode requires shaders, it can't be
+    /// enabled if they are not supported. Glyphs are always
+    /// loaded synchronously in this mode.
+    ///
+    /// \param enabled True to enable the distance field mode
+    ///
+    /// \see isDistanceFieldEnabled, sf::Shader::isAvailable
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDistanceFieldEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the signed distance field mode is enabled
+    ///
+    /// \return True if glyphs are rendered from distance fields
+    ///
+    /// \see setDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDistanceFieldEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the hinting mode used to rasterize the glyphs
+    ///
+    /// Hinting adjusts the outlines of the glyphs to the pixel
+    /// grid, so that small text looks sharper. It is also the
+    /// most expensive part of the rasterization, especially
+    /// with the auto-hinter, and it slightly distorts the shapes.
+    ///
+    /// The glyphs already loaded are discarded, they will be
+    /// rasterized again with the new mode.
+    /// The hinting mode is sf::Font::AutoHinting by default.
+    ///
+    /// \param hinting New hinting mode
+    ///
+    /// \see getHinting
+    ///
+    ////////////////////////////////////////////////////////////
+    void setHinting(Hinting hinting);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the hinting mode used to rasterize the glyphs
+    ///
+    /// \return Current hinting mode
+    ///
+    /// \see setHinting
+    ///
+    ////////////////////////////////////////////////////////////
+    Hinting getHinting() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store the glyphs in a texture atlas
+    ///
+    /// By default, the glyphs of each character size are stored
+    /// in a separate texture owned by the font, so texts of
+    /// different sizes or fonts can't be drawn with the same
+    /// texture. When an atlas is set, the glyphs of all the
+    /// sizes are packed in its pages instead; fonts sharing
+    /// the same atlas share its textures, and the texts using
+    /// them can be batched together. The page of each glyph
+    /// is available in its sf::Glyph::texture member.
+    ///
+    /// The glyphs already loaded are discarded, they will be
+    /// loaded again into the new atlas.
+    /// The atlas must exist as long as the font uses it, and must
+    /// not be cleared while it contains glyphs of the font. Enable
+    /// its smooth filter, like the textures of the font.
+    /// Glyphs of the distance field mode are never put in the atlas.
+    ///
+    /// \param atlas Atlas receiving the glyphs, or NULL to use the textures of the font
+    ///
+    /// \see getTextureAtlas
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTextureAtlas(TextureAtlas* atlas);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture atlas storing the glyphs
+    ///
+    /// \return Pointer to the atlas, or NULL if the glyphs are in the textures of the font
+    ///
+    /// \see setTextureAtlas
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureAtlas* getTextureAtlas() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the kerning offset of two glyphs
     ///
@@ -231,6 +421,10 @@ public:
     /// The contents of the returned texture changes as more glyphs
     /// are requested, thus it is not very relevant. It is mainly
     /// used internally by sf::Text.
+    /// When the font uses a texture atlas, the glyphs are spread
+    /// across its pages (see sf::Glyph::texture) and this function
+    /// returns the page containing the white square of the font,
+    /// used to draw underlines.
     ///
     /// \param characterSize Reference character size
     ///
@@ -239,6 +433,21 @@ public:
     ////////////////////////////////////////////////////////////
     const Texture& getTexture(unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shader that renders the glyphs of the distance field mode
+    ///
+    /// The shader turns the distance stored in the alpha
+    /// channel of the texture into antialiased coverage. If
+    /// you draw glyphs yourself in distance field mode, use it
+    /// with the texture returned by getTexture.
+    ///
+    /// \return Pointer to the shader, or NULL if the distance field mode is disabled
+    ///
+    /// \see setDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    const Shader* getDistanceFieldShader() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -251,6 +460,8 @@ public:
 
 private:
 
+    friend class Text;
+
     ////////////////////////////////////////////////////////////
     /// \brief Structure defining a row of glyphs
     ///
@@ -265,9 +476,65 @@ private:
     };
 
     ////////////////////////////////////////////////////////////
-    // Types
+    /// \brief Open-addressing hash table mapping keys to indices
+    ///
+    ////////////////////////////////////////////////////////////
+    class IndexTable
+    {
+    public:
+
+        IndexTable();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Find the index stored for a key
+        ///
+        /// \param key   Key to search
+        /// \param index Receives the index if the key is found
+        ///
+        /// \return True if the key was found
+        ///
+        ////////////////////////////////////////////////////////////
+        bool find(Uint64 key, std::size_t& index) const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Store the index of a key that is not in the table yet
+        ///
+        /// \param key   Key to insert
+        /// \param index Index to associate to the key
+        ///
+        ////////////////////////////////////////////////////////////
+        void insert(Uint64 key, std::size_t index);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Remove all the keys
+        ///
+        ////////////////////////////////////////////////////////////
+        void clear();
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the slot where the probing of a key starts
+        ///
+        ////////////////////////////////////////////////////////////
+        std::size_t getSlot(Uint64 key) const;
+
+        std::vector<Uint64> m_keys;    ///< Key of each slot
+        std::vector<Uint32> m_indices; ///< Index of each slot plus one, 0 for empty slots
+        std::size_t         m_count;   ///< Number of keys in the table
+        unsigned int        m_bits;    ///< Base 2 logarithm of the number of slots
+    };
+
     ////////////////////////////////////////////////////////////
-    typedef std::map<Uint32, Glyph> GlyphTable; ///< Table mapping a codepoint to its glyph
+    /// \brief Glyphs rasterized but not uploaded to their texture yet
+    ///
+    ////////////////////////////////////////////////////////////
+    struct GlyphBatch
+    {
+        std::vector<IntRect>     rects;   ///< Rectangle of each glyph in the texture
+        std::vector<std::size_t> offsets; ///< Offset of the pixels of each glyph
+        std::vector<Uint8>       pixels;  ///< Coverage of the pixels of all the glyphs, one byte per pixel
+    };
 
     ////////////////////////////////////////////////////////////
     /// \brief Structure defining a page of glyphs
@@ -275,12 +542,22 @@ private:
     ////////////////////////////////////////////////////////////
     struct Page
     {
-        Page();
-
-        GlyphTable       glyphs;  ///< Table mapping code points to their corresponding glyph
-        sf::Texture      texture; ///< Texture containing the pixels of the glyphs
-        unsigned int     nextRow; ///< Y position of the next new row in the texture
-        std::vector<Row> rows;    ///< List containing the position of all the existing rows
+        Page(bool textured = true);
+
+        enum {Latin1Size = 256};
+
+        std::deque<Glyph>  glyphs;                 ///< Loaded glyphs, a deque keeps the references valid when it grows
+        IndexTable         glyphTable;             ///< Table mapping code points combined with the bold flag to their glyph
+        Uint32             latin1[2 * Latin1Size]; ///< Index plus one of the Latin-1 glyphs (regular then bold), 0 if not loaded
+        sf::Texture        texture;                ///< Texture containing the pixels of the glyphs
+        unsigned int       nextRow;                ///< Y position of the next new row in the texture
+        std::vector<Row>   rows;                   ///< List containing the position of all the existing rows
+        IndexTable         kerningTable;           ///< Table mapping pairs of code points to their kerning
+        std::vector<float> kernings;               ///< Kerning of the pairs stored in the kerning table
+        bool               metricsLoaded;          ///< Are the line metrics below loaded yet?
+        float              lineSpacing;            ///< Cached line spacing
+        float              underlinePosition;      ///< Cached underline position
+        float              underlineThickness;     ///< Cached underline thickness
     };
 
     ////////////////////////////////////////////////////////////
@@ -289,17 +566,202 @@ private:
     ////////////////////////////////////////////////////////////
     void cleanup();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Report the memory of the glyph pages to the memory tracker
+    ///
+    /// The textures live in video memory and are not counted.
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateMemoryUsage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the index of a glyph in a page
+    ///
+    /// \param page      Page of the character size
+    /// \param codePoint Unicode code point of the character
+    /// \param bold      Find the bold version or the regular one?
+    /// \param index     Receives the index of the glyph, if found
+    ///
+    /// \return True if the glyph is in the page
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool findGlyphIndex(const Page& page, Uint32 codePoint, bool bold, std::size_t& index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find a glyph in a page, load it if needed
+    ///
+    /// \param page          Page of the character size
+    /// \param codePoint     Unicode code point of the character
+    /// \param characterSize Reference character size
+    /// \param bold          Retrieve the bold version or the regular one?
+    /// \param batch         Batch receiving the pixels of a new glyph, or NULL to upload them directly
+    ///
+    /// \return The glyph corresponding to \a codePoint and \a characterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    const Glyph& findGlyph(Page& page, Uint32 codePoint, unsigned int characterSize, bool bold, GlyphBatch* batch) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Load a new glyph and store it in the cache
     ///
     /// \param codePoint     Unicode code point of the character to load
     /// \param characterSize Reference character size
     /// \param bold          Retrieve the bold version or the regular one?
+    /// \param batch         Batch receiving the pixels, or NULL to upload them directly
     ///
     /// \return The glyph corresponding to \a codePoint and \a characterSize
     ///
     ////////////////////////////////////////////////////////////
-    Glyph loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const;
+    Glyph loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, GlyphBatch* batch = NULL) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Place a rasterized glyph in its page and write its pixels
+    ///
+    /// \param page   Page of glyphs of the character size
+    /// \param glyph  Glyph whose texture rectangle is set
+    /// \param pixels Coverage of each pixel of the glyph, one byte per pixel
+    /// \param width  Width of the glyph bitmap
+    /// \param height Height of the glyph bitmap
+    /// \param batch  Batch receiving the pixels, or NULL to upload them directly
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeGlyph(Page& page, Glyph& glyph, const Uint8* pixels, unsigned int width, unsigned int height, GlyphBatch* batch) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start the worker that loads glyphs in the background
+    ///
+    /// If the worker can't be started, glyphs are loaded
+    /// synchronously.
+    ///
+    ////////////////////////////////////////////////////////////
+    void startRasterizer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the glyphs rasterized in the background
+    ///
+    /// The revision of the font is incremented if new glyphs
+    /// are available.
+    ///
+    ////////////////////////////////////////////////////////////
+    void collectGlyphs() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load everything that the layout of a string needs
+    ///
+    /// After this call, laying out \a string only reads the
+    /// caches of the font: the glyphs, the kerning of the pairs
+    /// of consecutive characters, the line metrics and the
+    /// texture of the underlines are loaded.
+    ///
+    /// \param string        String to lay out
+    /// \param characterSize Reference character size
+    /// \param bold          Load the bold version or the regular one?
+    ///
+    ////////////////////////////////////////////////////////////
+    void prepareLayout(const String& string, unsigned int characterSize, bool bold) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload a region of a page filled with batched glyphs
+    ///
+    /// The parts of the region not covered by a glyph of the
+    /// batch must be unused, since they are cleared.
+    ///
+    /// \param page   Page of glyphs to update
+    /// \param region Region of the texture to update
+    /// \param batch  Batch containing the pixels of the glyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    void uploadRegion(Page& page, const IntRect& region, const GlyphBatch& batch) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the page of a character size, create it if needed
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Page of glyphs of the character size
+    ///
+    ////////////////////////////////////////////////////////////
+    Page& getPage(unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the page storing the metrics of a size
+    ///
+    /// The page caches the line metrics and kerning of the size,
+    /// and the scaled glyphs of the distance field mode.
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Page of glyphs of the character size, without texture
+    ///
+    ////////////////////////////////////////////////////////////
+    Page& getMetricsPage(unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the page holding the line metrics of a size, load them if needed
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Page whose line metrics are loaded
+    ///
+    ////////////////////////////////////////////////////////////
+    Page& getLineMetrics(unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a glyph of the distance field mode, load it if needed
+    ///
+    /// \param codePoint     Unicode code point of the character
+    /// \param characterSize Reference character size
+    /// \param bold          Retrieve the bold version or the regular one?
+    ///
+    /// \return The glyph, scaled to \a characterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    const Glyph& getDistanceFieldGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize a glyph at the reference size and store its distance field
+    ///
+    /// \param codePoint Unicode code point of the character
+    /// \param bold      Load the bold version or the regular one?
+    ///
+    /// \return The glyph, at the reference size
+    ///
+    ////////////////////////////////////////////////////////////
+    Glyph loadDistanceFieldGlyph(Uint32 codePoint, bool bold) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a glyph to a page
+    ///
+    /// \param page      Page to add the glyph to
+    /// \param codePoint Unicode code point of the character
+    /// \param bold      Is it the bold version?
+    /// \param glyph     Glyph to add
+    ///
+    /// \return Index of the glyph in the page
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t insertGlyph(Page& page, Uint32 codePoint, bool bold, const Glyph& glyph);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture to draw underlines with
+    ///
+    /// \param texCoords Receives the texture coordinates of a white pixel
+    ///
+    /// \return Texture containing the white pixel, or NULL if it's the texture of the character size
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getLineTexture(Vector2f& texCoords) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Place a glyph in the texture atlas
+    ///
+    /// \param glyph  Glyph whose texture and texture rectangle are set
+    /// \param pixels Coverage of each pixel of the glyph, one byte per pixel
+    /// \param width  Width of the glyph bitmap
+    /// \param height Height of the glyph bitmap
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeAtlasGlyph(Glyph& glyph, const Uint8* pixels, unsigned int width, unsigned int height) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Find a suitable rectangle within the texture for a glyph
@@ -326,20 +788,35 @@ private:
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef std::map<unsigned int, Page> PageTable; ///< Table mapping a character size to its page (texture)
+    typedef std::deque<Page> PageTable; ///< Glyph pages (textures), a deque keeps the references valid when it grows
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    void*                      m_library;     ///< Pointer to the internal library interface (it is typeless to avoid exposing implementation details)
-    void*                      m_face;        ///< Pointer to the internal font face (it is typeless to avoid exposing implementation details)
-    void*                      m_streamRec;   ///< Pointer to the stream rec instance (it is typeless to avoid exposing implementation details)
-    int*                       m_refCount;    ///< Reference counter used by implicit sharing
-    Info                       m_info;        ///< Information about the font
-    mutable PageTable          m_pages;       ///< Table containing the glyphs pages by character size
-    mutable std::vector<Uint8> m_pixelBuffer; ///< Pixel buffer holding a glyph's pixels before being written to the texture
+    void*                          m_library;             ///< Pointer to the internal library interface (it is typeless to avoid exposing implementation details)
+    void*                          m_face;                ///< Pointer to the internal font face (it is typeless to avoid exposing implementation details)
+    void*                          m_streamRec;           ///< Pointer to the stream rec instance (it is typeless to avoid exposing implementation details)
+    FileInputStream*               m_mappedFile;          ///< Font file mapped in memory, if loaded from a file that could be mapped
+    int*                           m_refCount;            ///< Reference counter used by implicit sharing
+    Info                           m_info;                ///< Information about the font
+    mutable PageTable              m_pages;               ///< Glyph pages of all the character sizes in use
+    mutable IndexTable             m_pageTable;           ///< Table mapping a character size to its page
+    mutable std::vector<Uint8>     m_pixelBuffer;         ///< Pixel buffer holding a glyph's coverage before being written to the texture
+    mutable std::vector<Uint8>     m_uploadBuffer;        ///< RGBA pixels of the glyph being written to the texture
+    std::string                    m_fileName;            ///< Path of the font file, if loaded from a file
+    const void*                    m_memoryData;          ///< Font data, if loaded from memory or from a mapped file
+    std::size_t                    m_memorySize;          ///< Size of the font data, if loaded from memory
+    bool                           m_asyncLoading;        ///< Are glyphs loaded in a background thread?
+    priv::GlyphRasterizer*         m_rasterizer;          ///< Worker loading the glyphs in the background, created on first use
+    mutable Uint64                 m_revision;            ///< Incremented every time the glyphs returned by getGlyph change
+    bool                           m_distanceField;       ///< Is the distance field mode enabled?
+    mutable Shader*                m_distanceFieldShader; ///< Shader rendering the distance field glyphs, created on first use
+    TextureAtlas*                  m_atlas;               ///< Atlas storing the glyphs, NULL to use the textures of the pages
+    mutable TextureAtlas::Region   m_atlasLine;           ///< White square of the atlas used to draw underlines, added on first use
+    Hinting                        m_hinting;             ///< Hinting mode used to rasterize the glyphs
+    mutable MemoryTracker::Counter m_memory;              ///< Reports the memory of the glyph pages
     #ifdef SFML_SYSTEM_ANDROID
-    void*                      m_stream; ///< Asset file streamer (if loaded from file)
+    void*                          m_stream;              ///< Asset file streamer (if loaded from file)
     #endif
 };
 
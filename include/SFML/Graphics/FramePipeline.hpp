@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_FRAMEPIPELINE_HPP
+#define SFML_FRAMEPIPELINE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/CommandBuffer.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/ThreadPool.hpp>
+
+
+namespace sf
+{
+class RenderTarget;
+
+////////////////////////////////////////////////////////////
+/// \brief Overlap the update of the next frame with the
+///        rendering of the current one
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API FramePipeline : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the pipeline
+    ///
+    /// \param pool Thread pool running the updates
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit FramePipeline(ThreadPool& pool = ThreadPool::getDefault());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits for the running update to finish.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~FramePipeline();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start the update of the next frame
+    ///
+    /// This function first waits for the previous update; the
+    /// commands that it recorded become the ones drawn by
+    /// render(). Then it clears the other command buffer and
+    /// runs \a function(commands) on a worker of the pool, so
+    /// that it records the next frame while the calling thread
+    /// renders the current one.
+    ///
+    /// The function can record commands from several threads,
+    /// for example with ThreadPool::parallelFor, as explained
+    /// in the documentation of sf::CommandBuffer.
+    ///
+    /// \param function Functor called as function(CommandBuffer&)
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    void update(F function);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the frame recorded by the last finished update
+    ///
+    /// This function must be called from the thread where the
+    /// target is used. It draws nothing until a first update
+    /// has finished. The frame can be rendered several times;
+    /// it is replaced on the next call to update().
+    ///
+    /// \param target Render target to draw to
+    ///
+    ////////////////////////////////////////////////////////////
+    void render(RenderTarget& target);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the running update has finished
+    ///
+    /// Call it before modifying, from the calling thread, the
+    /// objects that the update uses. The finished commands are
+    /// still only rendered after the next call to update().
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether an update is running
+    ///
+    /// \return True if an update was started and hasn't finished yet
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isUpdating() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the last recorded frame the one to render
+    ///
+    /// \return Cleared command buffer to record the next frame into
+    ///
+    ////////////////////////////////////////////////////////////
+    CommandBuffer& swapBuffers();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    ThreadPool&      m_pool;       ///< Thread pool running the updates
+    ThreadPool::Task m_task;       ///< Running update
+    CommandBuffer    m_buffers[2]; ///< Frame being rendered and frame being recorded
+    std::size_t      m_back;       ///< Index of the buffer being recorded
+};
+
+#include <SFML/Graphics/FramePipeline.inl>
+
+} // namespace sf
+
+
+#endif // SFML_FRAMEPIPELINE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::FramePipeline
+/// \ingroup graphics
+///
+/// Rendering must happen in the thread where the render target
+/// is active, so a simple game loop runs the update of the world
+/// and its rendering one after the other, and a frame takes the
+/// sum of both. sf::FramePipeline splits the loop in two stages:
+/// while the render thread draws frame N, a worker of a thread
+/// pool updates the world and records frame N + 1 into a
+/// sf::CommandBuffer. With two cores or more, a frame then takes
+/// the longest of the two stages instead of their sum, at the
+/// cost of one frame of latency.
+///
+/// The pipeline owns two command buffers, which are swapped
+/// by update(): one is filled by the running update, the other
+/// holds the last complete frame and is drawn by render().
+/// sf::CommandBuffer copies the geometry of the objects it
+/// records, so the update is free to modify them while the
+/// previous frame is rendered. It only keeps pointers to the
+/// textures, shaders and vertex buffers, which must live until
+/// the frame has been replaced.
+///
+/// The update runs concurrently with the render thread: it must
+/// not use the window, and the events (or rather the input state
+/// that they produce) should be passed to it by copy, inside the
+/// functor.
+///
+/// Usage example:
+/// \code
+/// struct WorldUpdate
+/// {
+///     WorldUpdate(World& world, const Input& input) : world(world), input(input) {}
+///
+///     void operator ()(sf::CommandBuffer& commands)
+///     {
+///         world.update(input);
+///         world.record(commands);
+///     }
+///
+///     World& world;
+///     Input  input;
+/// };
+///
+/// sf::FramePipeline pipeline;
+/// while (window.isOpen())
+/// {
+///     sf::Event event;
+///     while (window.pollEvent(event))
+///         input.handle(event);
+///
+///     // Update the next frame in the background...
+///     pipeline.update(WorldUpdate(world, input));
+///
+///     // ...while this one is rendered
+///     window.clear();
+///     pipeline.render(window);
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::CommandBuffer, sf::ThreadPool
+///
+////////////////////////////////////////////////////////////
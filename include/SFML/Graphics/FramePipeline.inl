@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+namespace priv
+{
+// Functor recording a frame with a user function
+template <typename F>
+struct FrameUpdate
+{
+    FrameUpdate(F function, CommandBuffer* commands) : m_function(function), m_commands(commands) {}
+    void operator()() {m_function(*m_commands);}
+    F              m_function;
+    CommandBuffer* m_commands;
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+void FramePipeline::update(F function)
+{
+    CommandBuffer& commands = swapBuffers();
+    m_task = m_pool.push(priv::FrameUpdate<F>(function, &commands));
+}
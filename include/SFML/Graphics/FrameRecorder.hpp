@@ -0,0 +1,317 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_FRAMERECORDER_HPP
+#define SFML_FRAMERECORDER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ReadbackQueue.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <deque>
+#include <vector>
+
+
+namespace sf
+{
+class RenderWindow;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Abstract base class for recording the frames of
+///        render targets, e.g. to encode a video
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API FrameRecorder : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Derived classes must call stop() in their destructor,
+    /// since stopping may still call their virtual functions.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~FrameRecorder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start recording
+    ///
+    /// \a maxQueuedFrames is the number of frames that may wait
+    /// for onProcessFrame: when the encoder falls behind and
+    /// all of them are in use, new frames are dropped instead
+    /// of stalling the render thread.
+    ///
+    /// \param maxQueuedFrames Maximum number of frames waiting to be processed
+    ///
+    /// \return True if recording started, false if onStart failed
+    ///
+    /// \see stop, capture
+    ///
+    ////////////////////////////////////////////////////////////
+    bool start(unsigned int maxQueuedFrames = 4);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop recording
+    ///
+    /// This function waits until the frames already captured
+    /// are processed, then calls onStop.
+    ///
+    /// \see start
+    ///
+    ////////////////////////////////////////////////////////////
+    void stop();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the recorder is recording
+    ///
+    /// \return True between start and stop, unless onProcessFrame
+    ///         asked to stop
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isRecording() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Capture the contents of a window as the next frame
+    ///
+    /// The pixels are read back asynchronously, see
+    /// sf::ReadbackQueue: call this function after drawing
+    /// the frame, before displaying the window. This function
+    /// doesn't wait for the graphics card nor for the encoder.
+    ///
+    /// \param window Window to capture
+    ///
+    /// \return True if the frame was queued, false if it was dropped
+    ///
+    ////////////////////////////////////////////////////////////
+    bool capture(RenderWindow& window);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Capture the contents of a texture as the next frame
+    ///
+    /// To record a render texture, pass its texture after
+    /// calling its display function.
+    ///
+    /// \param texture Texture to capture
+    ///
+    /// \return True if the frame was queued, false if it was dropped
+    ///
+    ////////////////////////////////////////////////////////////
+    bool capture(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of frames dropped since the recording started
+    ///
+    /// Frames are dropped when the readbacks or the encoder
+    /// can't keep up with the frame rate.
+    ///
+    /// \return Number of dropped frames
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getDroppedFrameCount() const;
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// This constructor is only meant to be called by derived classes.
+    ///
+    ////////////////////////////////////////////////////////////
+    FrameRecorder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start recording frames
+    ///
+    /// This virtual function may be overridden by a derived class
+    /// if something has to be done every time a new recording
+    /// starts, such as opening the encoder. It is called by start.
+    ///
+    /// \return True to start the recording, or false to abort it
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onStart();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process a new frame
+    ///
+    /// This virtual function is called, on the thread of the
+    /// recorder, every time a captured frame is available,
+    /// in the order they were captured. It is typically where
+    /// the frame is handed to a video encoder.
+    ///
+    /// \param frame     Pixels of the frame, valid until the function returns
+    /// \param timestamp Time of the capture, since the recording started
+    ///
+    /// \return True to continue recording, or false to stop
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onProcessFrame(const Image& frame, Time timestamp) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop recording frames
+    ///
+    /// This virtual function may be overridden by a derived class
+    /// if something has to be done every time the recording
+    /// ends, such as flushing the encoder. It is called on the
+    /// thread of the recorder, after the last frame.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onStop();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Captured frame
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Frame
+    {
+        Image image;     ///< Pixels of the frame
+        Time  timestamp; ///< Time of the capture
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Hand the finished readbacks to the thread of the recorder
+    ///
+    /// \param wait True to wait for free frames, false to drop the readbacks when there are none
+    ///
+    ////////////////////////////////////////////////////////////
+    void collectReadbacks(bool wait);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process the queued frames until the recording stops
+    ///
+    /// Runs in the thread of the recorder.
+    ///
+    ////////////////////////////////////////////////////////////
+    void process();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Thread              m_thread;     ///< Thread calling onProcessFrame
+    mutable Mutex       m_mutex;      ///< Mutex protecting the frame queues and the flags
+    ConditionVariable   m_queued;     ///< Notified when a frame is queued or the recording stops
+    ConditionVariable   m_recycled;   ///< Notified when a frame is free again
+    ReadbackQueue       m_readbacks;  ///< Pending readbacks of the captured frames
+    std::deque<Time>    m_timestamps; ///< Capture times of the pending readbacks
+    std::vector<Frame*> m_frames;     ///< All the frames, allocated by start
+    std::vector<Frame*> m_free;       ///< Frames that can receive a readback
+    std::deque<Frame*>  m_queue;      ///< Frames waiting to be processed
+    Image               m_discarded;  ///< Receives the readbacks that are dropped
+    Clock               m_clock;      ///< Clock giving the timestamps
+    unsigned int        m_dropped;    ///< Number of dropped frames
+    bool                m_started;    ///< Is the thread running?
+    bool                m_processing; ///< Does onProcessFrame still accept frames?
+    bool                m_stop;       ///< Must the thread stop?
+};
+
+} // namespace sf
+
+
+#endif // SFML_FRAMERECORDER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::FrameRecorder
+/// \ingroup graphics
+///
+/// sf::FrameRecorder provides a simple interface to record
+/// the frames of a window or of a render texture, for replays
+/// or streaming. Like sf::SoundRecorder, it is an abstract
+/// class: derived classes receive the frames in onProcessFrame
+/// and typically feed them to a video encoder, whether in
+/// software or through a hardware encoder API (NVENC, VAAPI,
+/// VideoToolbox, ...).
+///
+/// The render thread never waits for the recording: the
+/// pixels are copied by the graphics card into pixel buffer
+/// objects (see sf::ReadbackQueue), and onProcessFrame runs
+/// in a separate thread. When the encoder can't keep up, the
+/// frames are dropped and counted (see getDroppedFrameCount),
+/// use the timestamps to keep the video in sync. The images
+/// are recycled from one frame to the next, so recording
+/// doesn't allocate memory once it runs.
+///
+/// onProcessFrame is called without an active OpenGL context
+/// and must not use graphics resources.
+///
+/// Usage example:
+/// \code
+/// class VideoRecorder : public sf::FrameRecorder
+/// {
+/// public:
+///
+///     ~VideoRecorder()
+///     {
+///         stop();
+///     }
+///
+/// private:
+///
+///     virtual bool onStart() // optional
+///     {
+///         // Open the encoder...
+///         return true;
+///     }
+///
+///     virtual bool onProcessFrame(const sf::Image& frame, sf::Time timestamp)
+///     {
+///         // Encode the frame...
+///         return true;
+///     }
+///
+///     virtual void onStop() // optional
+///     {
+///         // Flush and close the encoder...
+///     }
+/// };
+///
+/// VideoRecorder recorder;
+/// recorder.start();
+///
+/// while (window.isOpen())
+/// {
+///     ...
+///     window.clear();
+///     window.draw(scene);
+///     recorder.capture(window);
+///     window.display();
+/// }
+///
+/// recorder.stop();
+/// \endcode
+///
+/// \see sf::ReadbackQueue, sf::RenderWindow, sf::RenderTexture
+///
+////////////////////////////////////////////////////////////
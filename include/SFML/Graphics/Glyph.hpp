@@ -34,6 +34,8 @@
 
 namespace sf
 {
+class Texture;
+
 ////////////////////////////////////////////////////////////
 /// \brief Structure describing a glyph
 ///
@@ -46,14 +48,15 @@ public:
     /// \brief Default constructor
     ///
     ////////////////////////////////////////////////////////////
-    Glyph() : advance(0) {}
+    Glyph() : advance(0), texture(NULL) {}
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    float     advance;     ///< Offset to move horizontally to the next character
-    FloatRect bounds;      ///< Bounding rectangle of the glyph, in coordinates relative to the baseline
-    IntRect   textureRect; ///< Texture coordinates of the glyph inside the font's texture
+    float          advance;     ///< Offset to move horizontally to the next character
+    FloatRect      bounds;      ///< Bounding rectangle of the glyph, in coordinates relative to the baseline
+    IntRect        textureRect; ///< Texture coordinates of the glyph inside the font's texture
+    const Texture* texture;     ///< Atlas page containing the glyph, or NULL if it is in the font's texture
 };
 
 } // namespace sf
@@ -0,0 +1,231 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_GPUMEMORY_HPP
+#define SFML_GPUMEMORY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Estimates the video memory used by the graphics resources
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API GpuMemory
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Types of OpenGL objects whose memory is tracked
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Type
+    {
+        Textures,      ///< Textures, including the padding of non power of two sizes and the mipmaps
+        RenderBuffers, ///< Depth and multisampled color buffers of render textures
+        Buffers,       ///< Vertex and uniform buffers
+
+        TypeCount      ///< Keep last -- the total number of types
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Description of a resource that holds video memory
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API Resource
+    {
+        Resource();
+
+        Type        type;  ///< Type of the resource
+        std::string name;  ///< Debug name given to the resource, empty if none
+        Uint64      bytes; ///< Estimated size of the resource in video memory
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reports the video memory held by a resource
+    ///
+    /// Resources have a counter and update it every time they
+    /// allocate their OpenGL storage. Counters can't be copied,
+    /// a copied resource creates its own storage and reports it.
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_GRAPHICS_API Counter
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Construct a counter that reports no memory
+        ///
+        /// \param type Type of the resource
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit Counter(Type type);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Destructor, the reported memory is released
+        ///
+        ////////////////////////////////////////////////////////////
+        ~Counter();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Change the amount of memory held by the resource
+        ///
+        /// \param bytes New estimated size of the resource
+        ///
+        ////////////////////////////////////////////////////////////
+        void setBytes(Uint64 bytes);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the amount of memory held by the resource
+        ///
+        /// \return Estimated size of the resource
+        ///
+        ////////////////////////////////////////////////////////////
+        Uint64 getBytes() const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Change the debug name of the resource
+        ///
+        /// \param name New name
+        ///
+        ////////////////////////////////////////////////////////////
+        void setName(const std::string& name);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the debug name of the resource
+        ///
+        /// \return Name of the resource, empty if none
+        ///
+        ////////////////////////////////////////////////////////////
+        std::string getName() const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Exchange the memory of two counters of the same type
+        ///
+        /// The names stay with their counter.
+        ///
+        /// \param right Counter to swap with
+        ///
+        ////////////////////////////////////////////////////////////
+        void swapBytes(Counter& right);
+
+    private:
+
+        friend class GpuMemory;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Disabled copy constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        Counter(const Counter&);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Disabled assignment operator
+        ///
+        ////////////////////////////////////////////////////////////
+        Counter& operator =(const Counter&);
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        Type        m_type;  ///< Type of the resource
+        std::string m_name;  ///< Debug name of the resource
+        Uint64      m_bytes; ///< Number of bytes currently reported
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the video memory currently used by a type of resources
+    ///
+    /// \param type Type to query
+    ///
+    /// \return Estimated number of bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getUsage(Type type);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the video memory currently used by all the resources
+    ///
+    /// \return Estimated number of bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getTotalUsage();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief List the resources that currently hold video memory
+    ///
+    /// The resources are sorted from the biggest to the smallest.
+    ///
+    /// \param resources Vector to fill, its previous content is replaced
+    ///
+    ////////////////////////////////////////////////////////////
+    static void getResources(std::vector<Resource>& resources);
+};
+
+} // namespace sf
+
+
+#endif // SFML_GPUMEMORY_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::GpuMemory
+/// \ingroup graphics
+///
+/// sf::GpuMemory estimates how much video memory the textures,
+/// render textures and buffers of SFML hold, to find which
+/// resources are responsible when a graphics card runs out
+/// of memory.
+///
+/// OpenGL doesn't tell how much memory an object really
+/// takes, so the size is computed from what was allocated:
+/// the internal size of textures (which can be bigger than
+/// their public size when the graphics card requires power
+/// of two dimensions) times the size of their pixels, plus
+/// a third for the mipmaps; the samples of render buffers;
+/// the bytes of vertex and uniform buffers. The driver may
+/// add its own alignment and bookkeeping on top of that.
+///
+/// Resources can be given a debug name (see
+/// sf::Texture::setDebugName), textures loaded from a file
+/// are named after the file by default.
+///
+/// Usage example:
+/// \code
+/// std::vector<sf::GpuMemory::Resource> resources;
+/// sf::GpuMemory::getResources(resources);
+///
+/// std::cout << "Video memory: " << sf::GpuMemory::getTotalUsage() / 1024 << " KB" << std::endl;
+/// for (std::size_t i = 0; (i < resources.size()) && (i < 10); ++i)
+///     std::cout << resources[i].name << ": " << resources[i].bytes / 1024 << " KB" << std::endl;
+/// \endcode
+///
+////////////////////////////////////////////////////////////
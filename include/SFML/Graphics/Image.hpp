@@ -31,12 +31,14 @@
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Color.hpp>
 #include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/MemoryTracker.hpp>
 #include <string>
 #include <vector>
 
 
 namespace sf
 {
+class ImageView;
 class InputStream;
 
 ////////////////////////////////////////////////////////////
@@ -47,6 +49,88 @@ class SFML_GRAPHICS_API Image
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Filters applied to the rows of PNG files before compression
+    ///
+    ////////////////////////////////////////////////////////////
+    enum PngFilter
+    {
+        NoFilter,      ///< Store the pixels as they are
+        SubFilter,     ///< Store the difference with the pixel on the left
+        UpFilter,      ///< Store the difference with the pixel above
+        AverageFilter, ///< Store the difference with the average of the left and above pixels
+        PaethFilter,   ///< Store the difference with the nearest of the left, above and above-left pixels
+        AdaptiveFilter ///< Choose the best filter for each row (slower, but usually smaller)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Layouts of pixel arrays that can be imported and exported
+    ///
+    ////////////////////////////////////////////////////////////
+    enum PixelFormat
+    {
+        Rgba,             ///< 4 bytes per pixel: red, green, blue, alpha (the format of the image)
+        Bgra,             ///< 4 bytes per pixel: blue, green, red, alpha
+        Rgb,              ///< 3 bytes per pixel: red, green, blue; imported pixels are opaque
+        Alpha,            ///< 1 byte per pixel: alpha; imported pixels are white
+        PremultipliedRgba ///< 4 bytes per pixel: red, green and blue multiplied by alpha, then alpha
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Options of the image encoders
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SaveSettings
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// \param compression PNG compression level, from 0 (fastest) to 9 (smallest)
+        /// \param filter      PNG row filter
+        /// \param quality     JPEG quality, from 1 (smallest) to 100 (best)
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit SaveSettings(unsigned int compression = 6, PngFilter filter = AdaptiveFilter, unsigned int quality = 90) :
+        compressionLevel(compression),
+        pngFilter       (filter),
+        jpegQuality     (quality)
+        {
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        unsigned int compressionLevel; ///< PNG compression level, 0 stores the pixels uncompressed
+        PngFilter    pngFilter;        ///< PNG row filter
+        unsigned int jpegQuality;      ///< JPEG quality
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Options of the image decoders
+    ///
+    ////////////////////////////////////////////////////////////
+    struct LoadSettings
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// \param divisor       Reduction factor of the decoded image: 1, 2, 4 or 8
+        /// \param multiplyAlpha Multiply the colors by alpha after decoding?
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit LoadSettings(unsigned int divisor = 1, bool multiplyAlpha = false) :
+        scale      (divisor),
+        premultiply(multiplyAlpha)
+        {
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        unsigned int scale;       ///< Reduction factor, each side of the image is divided by it and rounded up
+        bool         premultiply; ///< Multiply the colors by alpha after decoding?
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -86,6 +170,26 @@ public:
     ////////////////////////////////////////////////////////////
     void create(unsigned int width, unsigned int height, const Uint8* pixels);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the image from an array of pixels in another format
+    ///
+    /// The pixels are converted to RGBA, except premultiplied
+    /// pixels which are kept as they are and mark the image as
+    /// premultiplied. The \a pixels array is assumed to have the
+    /// given \a width and \a height, with tightly packed rows in
+    /// the given \a format. If not, this is an undefined behavior.
+    /// If \a pixels is null, an empty image is created.
+    ///
+    /// \param width  Width of the image
+    /// \param height Height of the image
+    /// \param pixels Array of pixels to convert to the image
+    /// \param format Format of the pixels in the array
+    ///
+    /// \see exportPixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void create(unsigned int width, unsigned int height, const Uint8* pixels, PixelFormat format);
+
     ////////////////////////////////////////////////////////////
     /// \brief Load the image from a file on disk
     ///
@@ -94,14 +198,15 @@ public:
     /// like progressive jpeg.
     /// If this function fails, the image is left unchanged.
     ///
-    /// \param filename Path of the image file to load
+    /// \param filename    Path of the image file to load
+    /// \param premultiply Multiply the colors by alpha after decoding?
     ///
     /// \return True if loading was successful
     ///
-    /// \see loadFromMemory, loadFromStream, saveToFile
+    /// \see loadFromMemory, loadFromStream, saveToFile, premultiplyAlpha
     ///
     ////////////////////////////////////////////////////////////
-    bool loadFromFile(const std::string& filename);
+    bool loadFromFile(const std::string& filename, bool premultiply = false);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load the image from a file in memory
@@ -111,15 +216,16 @@ public:
     /// like progressive jpeg.
     /// If this function fails, the image is left unchanged.
     ///
-    /// \param data Pointer to the file data in memory
-    /// \param size Size of the data to load, in bytes
+    /// \param data        Pointer to the file data in memory
+    /// \param size        Size of the data to load, in bytes
+    /// \param premultiply Multiply the colors by alpha after decoding?
     ///
     /// \return True if loading was successful
     ///
-    /// \see loadFromFile, loadFromStream
+    /// \see loadFromFile, loadFromStream, premultiplyAlpha
     ///
     ////////////////////////////////////////////////////////////
-    bool loadFromMemory(const void* data, std::size_t size);
+    bool loadFromMemory(const void* data, std::size_t size, bool premultiply = false);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load the image from a custom stream
@@ -129,14 +235,110 @@ public:
     /// like progressive jpeg.
     /// If this function fails, the image is left unchanged.
     ///
-    /// \param stream Source stream to read from
+    /// \param stream      Source stream to read from
+    /// \param premultiply Multiply the colors by alpha after decoding?
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromFile, loadFromMemory, premultiplyAlpha
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromStream(InputStream& stream, bool premultiply = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the image from a file on disk, with decoding options
+    ///
+    /// JPEG files are reduced by the decoder itself, which skips
+    /// most of the work for the discarded pixels: loading a large
+    /// photo at 1/8 of its size is several times faster than
+    /// loading it fully. Other formats are decoded fully, then
+    /// reduced by averaging the pixels.
+    /// If this function fails, the image is left unchanged.
+    ///
+    /// \param filename Path of the image file to load
+    /// \param settings Options of the decoder
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromMemory, loadFromStream, readSize
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFile(const std::string& filename, const LoadSettings& settings);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the image from a file in memory, with decoding options
+    ///
+    /// See the file overload for the details of the options.
+    /// If this function fails, the image is left unchanged.
+    ///
+    /// \param data     Pointer to the file data in memory
+    /// \param size     Size of the data to load, in bytes
+    /// \param settings Options of the decoder
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromFile, loadFromStream, readSize
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromMemory(const void* data, std::size_t size, const LoadSettings& settings);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the image from a custom stream, with decoding options
+    ///
+    /// See the file overload for the details of the options.
+    /// If this function fails, the image is left unchanged.
+    ///
+    /// \param stream   Source stream to read from
+    /// \param settings Options of the decoder
     ///
     /// \return True if loading was successful
     ///
-    /// \see loadFromFile, loadFromMemory
+    /// \see loadFromFile, loadFromMemory, readSize
     ///
     ////////////////////////////////////////////////////////////
-    bool loadFromStream(InputStream& stream);
+    bool loadFromStream(InputStream& stream, const LoadSettings& settings);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the size of an image file without decoding it
+    ///
+    /// Only the header of the file is parsed. The size takes the
+    /// scale of \a settings into account, so it is the size of
+    /// the pixels that decode produces with the same settings.
+    ///
+    /// \param stream   Source stream to read from
+    /// \param size     Filled with the size of the decoded image, in pixels
+    /// \param settings Options of the decoder
+    ///
+    /// \return True if the size could be read
+    ///
+    /// \see decode
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool readSize(InputStream& stream, Vector2u& size, const LoadSettings& settings = LoadSettings());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode an image file into a buffer of the caller
+    ///
+    /// The RGBA pixels are written to \a pixels without any
+    /// intermediate allocation for JPEG files, so that the same
+    /// buffer (or a staging buffer mapped from a texture) can be
+    /// reused for many images. The buffer must hold at least
+    /// 4 * width * height bytes, with the size given by readSize;
+    /// if it is too small, nothing is decoded and \a size is
+    /// still filled.
+    ///
+    /// \param stream   Source stream to read from
+    /// \param pixels   Buffer to fill with the decoded pixels
+    /// \param capacity Size of the buffer, in bytes
+    /// \param size     Filled with the size of the decoded image, in pixels
+    /// \param settings Options of the decoder
+    ///
+    /// \return True if decoding was successful
+    ///
+    /// \see readSize, loadFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool decode(InputStream& stream, Uint8* pixels, std::size_t capacity, Vector2u& size, const LoadSettings& settings = LoadSettings());
 
     ////////////////////////////////////////////////////////////
     /// \brief Save the image to a file on disk
@@ -145,15 +347,42 @@ public:
     /// the extension. The supported image formats are bmp, png,
     /// tga and jpg. The destination file is overwritten
     /// if it already exists. This function fails if the image is empty.
+    /// Premultiplied images are saved with straight alpha, like
+    /// image files expect.
+    ///
+    /// The image is only read, so it can be saved from another
+    /// thread as long as it is not modified in the meantime.
     ///
     /// \param filename Path of the file to save
+    /// \param settings Options of the encoder
     ///
     /// \return True if saving was successful
     ///
-    /// \see create, loadFromFile, loadFromMemory
+    /// \see create, loadFromFile, loadFromMemory, saveToMemory
     ///
     ////////////////////////////////////////////////////////////
-    bool saveToFile(const std::string& filename) const;
+    bool saveToFile(const std::string& filename, const SaveSettings& settings = SaveSettings()) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the image to a buffer in memory
+    ///
+    /// The supported image formats are bmp, png, tga and jpg.
+    /// The previous contents of \a output are replaced. This
+    /// function fails if the image is empty.
+    ///
+    /// The image is only read, so it can be saved from another
+    /// thread as long as it is not modified in the meantime.
+    ///
+    /// \param output   Buffer to fill with the encoded file
+    /// \param format   Format of the file, as a file extension ("png", "jpg", ...)
+    /// \param settings Options of the encoder
+    ///
+    /// \return True if saving was successful
+    ///
+    /// \see saveToFile, loadFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveToMemory(std::vector<Uint8>& output, const std::string& format, const SaveSettings& settings = SaveSettings()) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Return the size (width and height) of the image
@@ -187,7 +416,9 @@ public:
     /// If \a sourceRect is empty, the whole image is copied.
     /// If \a applyAlpha is set to true, the transparency of
     /// source pixels is applied. If it is false, the pixels are
-    /// copied unchanged with their alpha value.
+    /// copied unchanged with their alpha value. If this image
+    /// is premultiplied, the source pixels are blended as
+    /// premultiplied pixels too.
     ///
     /// \param source     Source image to copy
     /// \param destX      X coordinate of the destination position
@@ -198,6 +429,20 @@ public:
     ////////////////////////////////////////////////////////////
     void copy(const Image& source, unsigned int destX, unsigned int destY, const IntRect& sourceRect = IntRect(0, 0, 0, 0), bool applyAlpha = false);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy pixels from a view onto this image
+    ///
+    /// This is the same as the other overload, with the source
+    /// area given by the view.
+    ///
+    /// \param source     View of the pixels to copy
+    /// \param destX      X coordinate of the destination position
+    /// \param destY      Y coordinate of the destination position
+    /// \param applyAlpha Should the copy take into account the source transparency?
+    ///
+    ////////////////////////////////////////////////////////////
+    void copy(const ImageView& source, unsigned int destX, unsigned int destY, bool applyAlpha = false);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the color of a pixel
     ///
@@ -246,6 +491,84 @@ public:
     ////////////////////////////////////////////////////////////
     const Uint8* getPixelsPtr() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the pixels of the image to an array, in another format
+    ///
+    /// The \a pixels array must be large enough to hold
+    /// width * height pixels of the given \a format (see
+    /// getPixelSize), its rows are tightly packed. The alpha of
+    /// premultiplied images is divided out for the Rgba format.
+    ///
+    /// \param pixels Array to fill with the converted pixels
+    /// \param format Format of the pixels to write
+    ///
+    /// \see create
+    ///
+    ////////////////////////////////////////////////////////////
+    void exportPixels(Uint8* pixels, PixelFormat format) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bytes of a pixel in a given format
+    ///
+    /// \param format Pixel format
+    ///
+    /// \return Size of a pixel, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t getPixelSize(PixelFormat format);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Multiply the colors of the pixels by their alpha
+    ///
+    /// Premultiplied pixels can be filtered and blended without
+    /// dark fringes around transparent areas. Draw textures made
+    /// from premultiplied images with sf::BlendPremultipliedAlpha.
+    /// This function does nothing if the image is already
+    /// premultiplied.
+    ///
+    /// \see unpremultiplyAlpha, isPremultiplied
+    ///
+    ////////////////////////////////////////////////////////////
+    void premultiplyAlpha();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Divide the colors of the pixels by their alpha
+    ///
+    /// This function reverts premultiplyAlpha, the colors of
+    /// transparent pixels are lost. It does nothing if the
+    /// image is not premultiplied.
+    ///
+    /// \see premultiplyAlpha, isPremultiplied
+    ///
+    ////////////////////////////////////////////////////////////
+    void unpremultiplyAlpha();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the pixels are premultiplied, without converting them
+    ///
+    /// Use this function when the pixels given to create() or
+    /// decoded from a file are already premultiplied.
+    ///
+    /// \param premultiplied True if the colors are multiplied by alpha
+    ///
+    /// \see isPremultiplied, premultiplyAlpha
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPremultiplied(bool premultiplied);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the colors of the pixels are multiplied by their alpha
+    ///
+    /// getPixel, setPixel and getPixelsPtr give the pixels as
+    /// they are stored, premultiplied or not.
+    ///
+    /// \return True if the image is premultiplied
+    ///
+    /// \see premultiplyAlpha, setPremultiplied
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isPremultiplied() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Flip the image horizontally (left <-> right)
     ///
@@ -260,13 +583,17 @@ public:
 
 private:
 
+    friend class RenderWindow;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Vector2u           m_size;   ///< Image size
-    std::vector<Uint8> m_pixels; ///< Pixels of the image
+    Vector2u               m_size;          ///< Image size
+    std::vector<Uint8>     m_pixels;        ///< Pixels of the image
+    MemoryTracker::Counter m_memory;        ///< Reports the memory of the pixels
+    bool                   m_premultiplied; ///< Are the colors multiplied by alpha?
     #ifdef SFML_SYSTEM_ANDROID
-    void*              m_stream; ///< Asset file streamer (if loaded from file)
+    void*                  m_stream;        ///< Asset file streamer (if loaded from file)
     #endif
 };
 
@@ -320,6 +647,24 @@ private:
 /// // Save the image to a file
 /// if (!image.saveToFile("result.png"))
 ///     return -1;
+///
+/// // Encode a screenshot quickly, with light compression
+/// std::vector<sf::Uint8> file;
+/// image.saveToMemory(file, "png", sf::Image::SaveSettings(1, sf::Image::UpFilter));
+///
+/// // Load a thumbnail of a large photo, at 1/4 of its size
+/// sf::Image thumbnail;
+/// thumbnail.loadFromFile("photo.jpg", sf::Image::LoadSettings(4));
+///
+/// // Decode many photos into the same buffer
+/// std::vector<sf::Uint8> pixels;
+/// sf::FileInputStream stream;
+/// sf::Vector2u size;
+/// if (stream.open("photo.jpg") && sf::Image::readSize(stream, size))
+/// {
+///     pixels.resize(size.x * size.y * 4);
+///     sf::Image::decode(stream, &pixels[0], pixels.size(), size);
+/// }
 /// \endcode
 ///
 /// \see sf::Texture
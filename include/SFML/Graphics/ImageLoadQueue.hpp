@@ -0,0 +1,273 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_IMAGELOADQUEUE_HPP
+#define SFML_IMAGELOADQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/FastMutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/ThreadPool.hpp>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class InputStream;
+
+////////////////////////////////////////////////////////////
+/// \brief Decode images in the background
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ImageLoadQueue : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decoded image
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Result
+    {
+        std::size_t id;      ///< Identifier returned by push
+        bool        success; ///< Was the image loaded successfully?
+        Image       image;   ///< Decoded pixels, empty if loading failed
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the queue
+    ///
+    /// The images are decoded by the tasks of the default
+    /// thread pool, see sf::ThreadPool::getDefault.
+    ///
+    /// \param threadCount Maximum number of images decoded in parallel
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ImageLoadQueue(unsigned int threadCount = 4);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Discards the images that were not decoded yet and waits
+    /// for the ones being decoded.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ImageLoadQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue the loading of an image from a file on disk
+    ///
+    /// The supported image formats are the same as for
+    /// Image::loadFromFile.
+    ///
+    /// \param filename Path of the image file to load
+    ///
+    /// \return Identifier of the job, found in the result
+    ///
+    /// \see pop
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t push(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue the loading of an image from a file in memory
+    ///
+    /// The data is not copied, it must remain valid until the
+    /// result of the job is popped.
+    ///
+    /// \param data Pointer to the file data in memory
+    /// \param size Size of the data to load, in bytes
+    ///
+    /// \return Identifier of the job, found in the result
+    ///
+    /// \see pop
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t push(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue the loading of an image from a custom stream
+    ///
+    /// The stream is read by a worker thread, it must remain
+    /// valid and must not be used by another thread until the
+    /// result of the job is popped.
+    ///
+    /// \param stream Source stream to read from
+    ///
+    /// \return Identifier of the job, found in the result
+    ///
+    /// \see pop
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t push(InputStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve a decoded image, if any
+    ///
+    /// This function doesn't block. The results are returned
+    /// in the order the jobs finish, which is not necessarily
+    /// the order they were pushed; use the identifier to match
+    /// them.
+    ///
+    /// \param result Structure that receives the decoded image
+    ///
+    /// \return True if a result was retrieved
+    ///
+    /// \see push, isReady
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pop(Result& result);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a decoded image is available
+    ///
+    /// \return True if pop would succeed
+    ///
+    /// \see pop
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Block until all the queued images are decoded
+    ///
+    /// \see pop
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of queued images
+    ///
+    /// \return Number of jobs that were pushed but not popped yet
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPendingCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Image waiting to be decoded
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Job
+    {
+        std::size_t  id;       ///< Identifier returned by push
+        std::string  filename; ///< Path of the file, if loading from a file
+        const void*  data;     ///< File data, if loading from memory
+        std::size_t  size;     ///< Size of the file data, in bytes
+        InputStream* stream;   ///< Source stream, if loading from a stream
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a job to the queue
+    ///
+    /// \param job Job to add, its identifier is assigned here
+    ///
+    /// \return Identifier of the job
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t addJob(Job& job);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode the queued jobs until there are none left
+    ///
+    /// Runs as a task of the default thread pool.
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::deque<Job>               m_jobs;      ///< Images waiting to be decoded
+    std::deque<Result>            m_results;   ///< Decoded images waiting to be popped
+    std::size_t                   m_nextId;    ///< Identifier of the next job
+    std::size_t                   m_pending;   ///< Number of jobs pushed but not popped yet
+    std::size_t                   m_decoding;  ///< Number of jobs being decoded
+    std::vector<ThreadPool::Task> m_tasks;     ///< Pool tasks started to run run()
+    std::size_t                   m_taskCount; ///< Number of tasks still running run()
+    std::size_t                   m_maxTasks;  ///< Maximum number of tasks running run()
+    mutable FastMutex             m_mutex;     ///< Mutex protecting the queues
+};
+
+} // namespace sf
+
+
+#endif // SFML_IMAGELOADQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ImageLoadQueue
+/// \ingroup graphics
+///
+/// Decoding a large PNG or JPEG takes time, and loading
+/// many of them with sf::Image::loadFromFile blocks the
+/// main thread for as long. sf::ImageLoadQueue decodes
+/// them on the default sf::ThreadPool instead: push queues a
+/// file, a buffer in memory or a stream and returns
+/// immediately, and pop retrieves the decoded images as
+/// they are ready.
+///
+/// The results are sf::Image objects, the textures must
+/// still be created or updated from the thread that owns
+/// the OpenGL context. To avoid blocking there too, the
+/// pixels can be staged in a sf::TextureUpload and copied
+/// with sf::Texture::updateAsync.
+///
+/// The error messages of the image loader are not thread
+/// specific, the reason printed for a failure may belong to
+/// another image decoded at the same time.
+///
+/// Usage example:
+/// \code
+/// sf::ImageLoadQueue loader;
+///
+/// std::size_t background = loader.push("background.png");
+/// std::size_t tileset = loader.push("tileset.png");
+///
+/// while (window.isOpen())
+/// {
+///     // Retrieve the images that are ready
+///     sf::ImageLoadQueue::Result result;
+///     while (loader.pop(result))
+///     {
+///         if (result.success && (result.id == background))
+///             backgroundTexture.loadFromImage(result.image);
+///         ...
+///     }
+///     ...
+/// }
+/// \endcode
+///
+/// \see sf::Image, sf::TextureUpload
+///
+////////////////////////////////////////////////////////////
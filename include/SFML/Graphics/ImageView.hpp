@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_IMAGEVIEW_HPP
+#define SFML_IMAGEVIEW_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+
+namespace sf
+{
+class Image;
+
+////////////////////////////////////////////////////////////
+/// \brief Read-only view of a rectangle of pixels, without copying them
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ImageView
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty view.
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a view of a whole image
+    ///
+    /// \param image Image to view
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView(const Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a view of a part of an image
+    ///
+    /// If \a area is empty, the whole image is viewed. If it
+    /// crosses the bounds of the image, it is adjusted to fit
+    /// the image size.
+    ///
+    /// \param image Image to view
+    /// \param area  Area of the image to view
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView(const Image& image, const IntRect& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a view of an array of pixels
+    ///
+    /// The pixels must be RGBA 32 bits, like in sf::Image.
+    ///
+    /// \param pixels Pointer to the top-left pixel
+    /// \param width  Width of the view, in pixels
+    /// \param height Height of the view, in pixels
+    /// \param stride Number of pixels between the start of two consecutive rows, 0 means \a width
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int stride = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a view of a part of this view
+    ///
+    /// If \a area is empty, the whole view is returned. If it
+    /// crosses the bounds of the view, it is adjusted to fit
+    /// its size.
+    ///
+    /// \param area Area to view, relative to the top-left corner of this view
+    ///
+    /// \return View of the area
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView getSubView(const IntRect& area) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the view
+    ///
+    /// \return Size of the view, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the distance between the start of two consecutive rows
+    ///
+    /// \return Stride of the rows, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getStride() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the color of a pixel
+    ///
+    /// This function doesn't check the validity of the pixel
+    /// coordinates, using out-of-range values will result in
+    /// an undefined behavior.
+    ///
+    /// \param x X coordinate of pixel to get
+    /// \param y Y coordinate of pixel to get
+    ///
+    /// \return Color of the pixel at coordinates (x, y)
+    ///
+    ////////////////////////////////////////////////////////////
+    Color getPixel(unsigned int x, unsigned int y) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-only pointer to the top-left pixel
+    ///
+    /// The rows are getStride() pixels apart. The returned
+    /// value is NULL if the view is empty.
+    ///
+    /// \return Read-only pointer to the pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    const Uint8* getPixelsPtr() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Uint8* m_pixels; ///< Pointer to the top-left pixel
+    Vector2u     m_size;   ///< Size of the view, in pixels
+    unsigned int m_stride; ///< Distance between two consecutive rows, in pixels
+};
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEVIEW_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ImageView
+/// \ingroup graphics
+///
+/// sf::ImageView refers to a rectangle of pixels owned by
+/// someone else, usually a sf::Image: it stores a pointer,
+/// a size and a row stride, and never copies the pixels.
+/// It is cheap to construct and to pass by value, which
+/// makes it suited to slicing sprite sheets into thousands
+/// of tiles without creating an image for each of them.
+///
+/// sf::Image::copy, sf::Texture::loadFromImage and
+/// sf::Texture::update accept views directly; uploads to
+/// textures read the rows in place.
+///
+/// A view doesn't keep its source alive: it becomes invalid
+/// as soon as the source image is destroyed, resized or
+/// reloaded.
+///
+/// Usage example:
+/// \code
+/// sf::Image sheet;
+/// sheet.loadFromFile("tiles.png");
+///
+/// // Upload the tiles of a 32x32 grid to individual textures
+/// std::vector<sf::Texture> tiles(64);
+/// for (int i = 0; i < 64; ++i)
+/// {
+///     sf::ImageView tile(sheet, sf::IntRect((i % 8) * 32, (i / 8) * 32, 32, 32));
+///     tiles[i].loadFromImage(tile);
+/// }
+/// \endcode
+///
+/// \see sf::Image, sf::Texture
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_INSTANCE_HPP
+#define SFML_INSTANCE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Define the per-instance attributes of an instanced draw
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API Instance
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The instance is located at (0, 0), not rotated nor scaled,
+    /// white, and maps an empty texture rectangle.
+    ///
+    ////////////////////////////////////////////////////////////
+    Instance();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the instance from its attributes
+    ///
+    /// \param thePosition    Position of the instance
+    /// \param theRotation    Rotation of the instance, in degrees
+    /// \param theScale       Scale factors of the instance
+    /// \param theTextureRect Sub-rectangle of the texture mapped on the instance, in pixels
+    /// \param theColor       Color of the instance
+    ///
+    ////////////////////////////////////////////////////////////
+    Instance(const Vector2f& thePosition, float theRotation = 0.f, const Vector2f& theScale = Vector2f(1.f, 1.f),
+             const FloatRect& theTextureRect = FloatRect(), const Color& theColor = Color::White);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2f  position;    ///< 2D position of the instance
+    float     rotation;    ///< Rotation of the instance, in degrees
+    Vector2f  scale;       ///< Scale factors of the instance
+    FloatRect textureRect; ///< Sub-rectangle of the texture mapped on the instance, in pixels
+    Color     color;       ///< Color of the instance
+};
+
+} // namespace sf
+
+
+#endif // SFML_INSTANCE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Instance
+/// \ingroup graphics
+///
+/// sf::Instance holds what differs between the copies of a
+/// same quad drawn with RenderTarget::drawInstanced: each
+/// instance has its own position, rotation, scale, texture
+/// rectangle and color, while the geometry of the quad itself
+/// and the render states are shared by all the instances.
+///
+/// This is typically used to draw large amounts of identical
+/// objects, such as particles or bullets, without having to
+/// build their vertices on the CPU every frame.
+///
+/// Example:
+/// \code
+/// std::vector<sf::Instance> bullets;
+/// ...
+/// bullets.push_back(sf::Instance(position, angle, sf::Vector2f(1, 1), sf::FloatRect(0, 0, 8, 8)));
+/// ...
+///
+/// // each bullet is an 8x8 quad centered on its position
+/// window.drawInstanced(sf::FloatRect(-4, -4, 8, 8), &bullets[0], bullets.size(), &texture);
+/// \endcode
+///
+/// \see sf::RenderTarget::drawInstanced, sf::Vertex
+///
+////////////////////////////////////////////////////////////
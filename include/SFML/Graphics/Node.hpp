@@ -0,0 +1,250 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_NODE_HPP
+#define SFML_NODE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Transformable object that belongs to a hierarchy of nodes
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API Node : public Drawable, public Transformable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a node without parent nor children.
+    ///
+    ////////////////////////////////////////////////////////////
+    Node();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The node is detached from its parent, and its children
+    /// become roots of their own hierarchy.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~Node();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Attach a child to the node
+    ///
+    /// The child is detached from its previous parent first,
+    /// and it is drawn after the children that are already
+    /// attached. A node can't be attached to one of its own
+    /// descendants.
+    ///
+    /// The node doesn't take ownership of the child, which
+    /// must stay alive as long as it is attached.
+    ///
+    /// \param child Node to attach
+    ///
+    /// \see detachChild
+    ///
+    ////////////////////////////////////////////////////////////
+    void attachChild(Node& child);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Detach a child from the node
+    ///
+    /// This function does nothing if \a child is not a child
+    /// of this node.
+    ///
+    /// \param child Node to detach
+    ///
+    /// \see attachChild
+    ///
+    ////////////////////////////////////////////////////////////
+    void detachChild(Node& child);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the parent of the node
+    ///
+    /// \return Pointer to the parent, or NULL if the node is a root
+    ///
+    ////////////////////////////////////////////////////////////
+    Node* getParent() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of children of the node
+    ///
+    /// \return Number of children
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getChildCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a child of the node
+    ///
+    /// \param index Index of the child, in drawing order
+    ///
+    /// \return Reference to the child
+    ///
+    ////////////////////////////////////////////////////////////
+    Node& getChild(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the transform of the node in the hierarchy's space
+    ///
+    /// The world transform combines the transforms of all the
+    /// ancestors of the node with its own one. It is cached,
+    /// and only recomputed when the node or one of its
+    /// ancestors has changed.
+    ///
+    /// \return World transform of the node
+    ///
+    /// \see getTransform
+    ///
+    ////////////////////////////////////////////////////////////
+    const Transform& getWorldTransform() const;
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the contents of the node itself
+    ///
+    /// This function is called for each node of the drawn
+    /// hierarchy, parents before children. \a states already
+    /// contains the world transform of the node. The default
+    /// implementation draws nothing.
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void drawCurrent(RenderTarget& target, RenderStates states) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the node and all its descendants
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recompute the world transform if it is outdated
+    ///
+    /// The world transform of the parent must be up-to-date.
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateWorldTransform() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell the node and its ancestors that the hierarchy changed
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateHierarchy();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Node*                            m_parent;                   ///< Parent of the node, NULL for roots
+    std::vector<Node*>               m_children;                 ///< Children of the node, in drawing order
+    mutable Transform                m_worldTransform;           ///< Cached combination of the ancestors' transforms with the node's one
+    mutable bool                     m_worldTransformNeedUpdate; ///< Must the world transform be recomputed regardless of the revisions?
+    mutable Uint32                   m_localRevision;            ///< Revision of the local transform used by the world transform
+    mutable Uint32                   m_parentRevision;           ///< Revision of the parent's world transform used by the world transform
+    mutable Uint32                   m_worldRevision;            ///< Number of changes of the world transform
+    mutable std::vector<const Node*> m_descendants;              ///< The node and its descendants in depth-first order
+    mutable bool                     m_descendantsNeedUpdate;    ///< Has the hierarchy changed since the descendants were listed?
+};
+
+} // namespace sf
+
+
+#endif // SFML_NODE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Node
+/// \ingroup graphics
+///
+/// sf::Node is a sf::Transformable that can have a parent
+/// and children: the transform of a node is relative to its
+/// parent, so that moving, rotating or scaling a node affects
+/// all its descendants.
+///
+/// Each node caches its world transform, which is only
+/// recomputed when its own transform or the world transform
+/// of its parent has changed. Static parts of a hierarchy
+/// therefore cost nothing but a comparison per frame.
+///
+/// Drawing a node draws its whole subtree. The descendants
+/// are listed once in depth-first order, until the hierarchy
+/// changes, and the list is traversed without recursion.
+/// Each node draws its contents in the drawCurrent function,
+/// which receives the world transform in its render states:
+/// when batching is enabled on the target, consecutive nodes
+/// that use the same texture are merged into a single draw
+/// call.
+///
+/// Nodes don't own their children, they only reference them.
+///
+/// Usage example:
+/// \code
+/// class SpriteNode : public sf::Node
+/// {
+/// public:
+///
+///     sf::Sprite sprite;
+///
+/// private:
+///
+///     virtual void drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const
+///     {
+///         target.draw(sprite, states);
+///     }
+/// };
+///
+/// SpriteNode body, arm;
+/// body.attachChild(arm);
+/// arm.setPosition(20, 0);
+/// ...
+/// body.rotate(10); // the arm follows
+/// window.setBatchingEnabled(true);
+/// window.draw(body);
+/// \endcode
+///
+/// \see sf::Transformable
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,271 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PARTICLESYSTEM_HPP
+#define SFML_PARTICLESYSTEM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Instance.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Set of short-lived textured quads animated together
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ParticleSystem : public Drawable, public Transformable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty system, without texture nor gravity,
+    /// whose particles are 4x4 quads that fade out.
+    ///
+    ////////////////////////////////////////////////////////////
+    ParticleSystem();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Emit a new particle
+    ///
+    /// The position and the velocity are in the local
+    /// coordinate system of the particle system.
+    ///
+    /// \param position        Initial position of the particle
+    /// \param velocity        Initial velocity, in units per second
+    /// \param lifetime        Duration after which the particle dies
+    /// \param color           Color of the particle
+    /// \param rotation        Initial rotation, in degrees
+    /// \param angularVelocity Rotation speed, in degrees per second
+    ///
+    ////////////////////////////////////////////////////////////
+    void emit(const Vector2f& position, const Vector2f& velocity, Time lifetime, const Color& color = Color::White,
+              float rotation = 0.f, float angularVelocity = 0.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Advance the simulation
+    ///
+    /// The particles move, accelerate and rotate, and those
+    /// whose lifetime is over are removed.
+    ///
+    /// \param elapsed Time elapsed since the last update
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(Time elapsed);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the particles
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of living particles
+    ///
+    /// \return Number of particles
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getParticleCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the acceleration applied to all the particles
+    ///
+    /// \param gravity Acceleration, in units per second squared
+    ///
+    ////////////////////////////////////////////////////////////
+    void setGravity(const Vector2f& gravity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the acceleration applied to all the particles
+    ///
+    /// \return Acceleration, in units per second squared
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getGravity() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the size of the particles
+    ///
+    /// The quad of each particle is centered on its position.
+    ///
+    /// \param size Width and height of the particles
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParticleSize(const Vector2f& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the particles
+    ///
+    /// \return Width and height of the particles
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getParticleSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the texture of the particles
+    ///
+    /// The texture must stay alive as long as the particle
+    /// system uses it.
+    ///
+    /// \param texture   Texture mapped on every particle
+    /// \param resetRect Should the texture rect be reset to the size of the new texture?
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture& texture, bool resetRect = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture of the particles
+    ///
+    /// \return Pointer to the texture, or NULL if there's none
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the sub-rectangle of the texture mapped on the particles
+    ///
+    /// \param rectangle Rectangle defining the region of the texture to display
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTextureRect(const IntRect& rectangle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sub-rectangle of the texture mapped on the particles
+    ///
+    /// \return Texture rectangle of the particles
+    ///
+    ////////////////////////////////////////////////////////////
+    const IntRect& getTextureRect() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the fading of the particles
+    ///
+    /// When fading is enabled, the opacity of each particle
+    /// decreases linearly until it dies. It is enabled by
+    /// default.
+    ///
+    /// \param enabled True to enable fading, false to disable it
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFadingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the particles fade out
+    ///
+    /// \return True if fading is enabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isFadingEnabled() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the particles to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<float>            m_positionsX;        ///< Horizontal position of each particle
+    std::vector<float>            m_positionsY;        ///< Vertical position of each particle
+    std::vector<float>            m_velocitiesX;       ///< Horizontal velocity of each particle
+    std::vector<float>            m_velocitiesY;       ///< Vertical velocity of each particle
+    std::vector<float>            m_rotations;         ///< Rotation of each particle, in degrees
+    std::vector<float>            m_angularVelocities; ///< Rotation speed of each particle, in degrees per second
+    std::vector<float>            m_remainingTimes;    ///< Remaining lifetime of each particle, in seconds
+    std::vector<float>            m_lifetimes;         ///< Total lifetime of each particle, in seconds
+    std::vector<Color>            m_colors;            ///< Color of each particle
+    mutable std::vector<Instance> m_instances;         ///< Instances submitted to the render target
+    Vector2f                      m_gravity;           ///< Acceleration applied to all the particles
+    Vector2f                      m_particleSize;      ///< Size of the quad of each particle
+    const Texture*                m_texture;           ///< Texture of the particles
+    IntRect                       m_textureRect;       ///< Rectangle defining the area of the source texture to display
+    bool                          m_fadingEnabled;     ///< Do particles fade out until they die?
+};
+
+} // namespace sf
+
+
+#endif // SFML_PARTICLESYSTEM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ParticleSystem
+/// \ingroup graphics
+///
+/// sf::ParticleSystem stores its particles as parallel arrays
+/// (one per attribute), so that the simulation performed by
+/// update() processes several particles per instruction on
+/// CPUs supporting SSE2 or NEON, and doesn't touch the
+/// attributes it doesn't need.
+///
+/// All the particles share the same size and texture area,
+/// and are drawn with a single call to
+/// sf::RenderTarget::drawInstanced, which uses hardware
+/// instancing when the system supports it.
+///
+/// Usage example:
+/// \code
+/// sf::ParticleSystem sparks;
+/// sparks.setTexture(sparkTexture, true);
+/// sparks.setParticleSize(sf::Vector2f(8, 8));
+/// sparks.setGravity(sf::Vector2f(0, 500));
+///
+/// while (window.isOpen())
+/// {
+///     ...
+///     for (int i = 0; i < 100; ++i)
+///         sparks.emit(emitterPosition, randomVelocity(), sf::seconds(1.5f), sf::Color::Yellow);
+///
+///     sparks.update(clock.restart());
+///
+///     window.clear();
+///     window.draw(sparks);
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::Instance, sf::SpriteBatch
+///
+////////////////////////////////////////////////////////////
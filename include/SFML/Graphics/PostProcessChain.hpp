@@ -0,0 +1,284 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_POSTPROCESSCHAIN_HPP
+#define SFML_POSTPROCESSCHAIN_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class RenderTarget;
+class RenderTexture;
+class Shader;
+
+////////////////////////////////////////////////////////////
+/// \brief Sequence of fullscreen shader passes sharing a pool of render textures
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API PostProcessChain : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    // Static member data
+    ////////////////////////////////////////////////////////////
+    static const std::size_t Source; ///< Identifier of the texture that the chain is applied to
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty chain, create must be called before
+    /// it can be applied.
+    ///
+    ////////////////////////////////////////////////////////////
+    PostProcessChain();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~PostProcessChain();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size and format of the intermediate textures
+    ///
+    /// The render textures of the chain are created the first
+    /// time they are needed, with these settings.
+    ///
+    /// \param width  Width of the intermediate textures
+    /// \param height Height of the intermediate textures
+    /// \param format Format of the intermediate textures
+    ///
+    /// \return True if the format is supported
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, Texture::Format format = Texture::Rgba8);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a pass that processes the result of the previous one
+    ///
+    /// The first pass processes the source texture.
+    ///
+    /// \param shader Shader run by the pass
+    ///
+    /// \return Identifier of the pass
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t addPass(Shader& shader);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a pass that processes the result of a given pass
+    ///
+    /// The input of the pass is its current texture: the
+    /// shader reads it through the parameter that was set to
+    /// sf::Shader::CurrentTexture.
+    ///
+    /// \param shader Shader run by the pass
+    /// \param input  Identifier of a pass added before, or Source
+    ///
+    /// \return Identifier of the pass
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t addPass(Shader& shader, std::size_t input);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give the result of a pass to the shader of another one
+    ///
+    /// Before \a pass runs, the texture produced by \a input is
+    /// assigned to the texture parameter \a name of its shader.
+    /// This is how passes combine several results, for example
+    /// a bloom pass adding a blurred image to the source.
+    ///
+    /// \param pass  Identifier of the pass that reads the texture
+    /// \param name  Name of the texture parameter in its shader
+    /// \param input Identifier of a pass added before \a pass, or Source
+    ///
+    ////////////////////////////////////////////////////////////
+    void addInput(std::size_t pass, const std::string& name, std::size_t input);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the passes
+    ///
+    /// The render textures are kept for the next passes.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run all the passes on a texture
+    ///
+    /// \param source Texture to process
+    ///
+    /// \return Texture holding the result of the last pass,
+    ///         which remains valid until the chain is applied
+    ///         again, or \a source if the chain has no pass
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& apply(const Texture& source);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run all the passes on a texture, the last one into a render target
+    ///
+    /// The last pass covers the whole \a target, whatever its
+    /// current view, and doesn't need an intermediate texture.
+    /// This function does nothing if the chain has no pass.
+    ///
+    /// \param source    Texture to process
+    /// \param target    Render target receiving the result of the last pass
+    /// \param blendMode Blending of the result with the contents of \a target
+    ///
+    ////////////////////////////////////////////////////////////
+    void apply(const Texture& source, RenderTarget& target, const BlendMode& blendMode = BlendNone);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of render textures allocated by the chain
+    ///
+    /// \return Number of intermediate textures
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getTargetCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Assign an intermediate texture to each pass
+    ///
+    /// A texture is reused as soon as the last pass reading
+    /// its previous contents is done.
+    ///
+    /// \param keepLast Does the result of the last pass need a texture?
+    ///
+    /// \return True if all the textures could be created
+    ///
+    ////////////////////////////////////////////////////////////
+    bool allocateTargets(bool keepLast);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture produced by a pass
+    ///
+    /// \param pass   Identifier of the pass, or Source
+    /// \param source Texture that the chain is applied to
+    ///
+    /// \return Texture holding the result of the pass
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getResult(std::size_t pass, const Texture& source) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run a pass into a render target
+    ///
+    /// \param pass      Identifier of the pass
+    /// \param source    Texture that the chain is applied to
+    /// \param target    Render target to draw to
+    /// \param blendMode Blending of the result with the contents of \a target
+    ///
+    ////////////////////////////////////////////////////////////
+    void runPass(std::size_t pass, const Texture& source, RenderTarget& target, const BlendMode& blendMode);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Texture parameter bound to the result of a pass
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Input
+    {
+        std::string name; ///< Name of the texture parameter
+        std::size_t pass; ///< Identifier of the pass producing the texture, or Source
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Shader pass of the chain
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Pass
+    {
+        Shader*            shader; ///< Shader run by the pass
+        std::size_t        input;  ///< Pass whose result is the current texture, or Source
+        std::vector<Input> inputs; ///< Other results read by the shader
+        std::size_t        target; ///< Index of the render texture receiving the result
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Pass>           m_passes;  ///< Passes of the chain, in execution order
+    std::vector<RenderTexture*> m_targets; ///< Pool of intermediate render textures
+    Vector2u                    m_size;    ///< Size of the intermediate textures
+    Texture::Format             m_format;  ///< Format of the intermediate textures
+};
+
+} // namespace sf
+
+
+#endif // SFML_POSTPROCESSCHAIN_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PostProcessChain
+/// \ingroup graphics
+///
+/// sf::PostProcessChain runs a sequence of shaders over a
+/// texture, each pass drawing a single triangle that covers
+/// its render texture. It takes care of the intermediate
+/// render textures: they all have the size given to create,
+/// and a texture is reused by a later pass as soon as no
+/// remaining pass reads what it holds. A linear chain of
+/// any length thus only needs two textures, which are used
+/// alternately (ping-pong), and branching chains need no
+/// more textures than the results alive at the same time.
+///
+/// By default a pass processes the result of the previous
+/// one, available as the current texture of its shader.
+/// Results of earlier passes, or the source itself, can be
+/// given to the other texture parameters of a shader with
+/// addInput.
+///
+/// Usage example:
+/// \code
+/// // Bloom: extract the bright parts, blur them, add them to the scene
+/// sf::PostProcessChain chain;
+/// chain.create(800, 600);
+/// chain.addPass(brightPass);                // reads the source
+/// chain.addPass(horizontalBlur);            // reads brightPass
+/// std::size_t blur = chain.addPass(verticalBlur);
+/// std::size_t combine = chain.addPass(combineShader, sf::PostProcessChain::Source);
+/// chain.addInput(combine, "bloom", blur);
+///
+/// // Draw the scene to a render texture, then process it into the window
+/// scene.display();
+/// chain.apply(scene.getTexture(), window);
+/// \endcode
+///
+/// \see sf::Shader, sf::RenderTexture
+///
+////////////////////////////////////////////////////////////
@@ -44,7 +44,7 @@ enum PrimitiveType
     Triangles,      ///< List of individual triangles
     TrianglesStrip, ///< List of connected triangles, a point uses the two previous points to form a triangle
     TrianglesFan,   ///< List of connected triangles, a point uses the common center and the previous point to form a triangle
-    Quads           ///< List of individual quads (deprecated, don't work with OpenGL ES)
+    Quads           ///< List of individual quads (drawn as indexed triangles where OpenGL doesn't support them)
 };
 
 } // namespace sf
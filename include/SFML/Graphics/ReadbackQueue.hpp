@@ -0,0 +1,255 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_READBACKQUEUE_HPP
+#define SFML_READBACKQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+class RenderWindow;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Read textures and windows back without blocking
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ReadbackQueue : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty queue.
+    ///
+    ////////////////////////////////////////////////////////////
+    ReadbackQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits for the pending readbacks, if any.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ReadbackQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue the readback of the pixels of a texture
+    ///
+    /// This function returns immediately, the pixels are
+    /// copied by the graphics card in the background and can
+    /// be retrieved later with pop.
+    ///
+    /// \param texture Texture to read
+    ///
+    /// \return True if the readback was queued, false if the
+    ///         texture is empty or the queue is full
+    ///
+    /// \see pop
+    ///
+    ////////////////////////////////////////////////////////////
+    bool push(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue the readback of the contents of a window
+    ///
+    /// This is the asynchronous equivalent of
+    /// RenderWindow::capture. It reads what was drawn since
+    /// the last call to display, so it must be called before
+    /// display. The batched geometry of the window is flushed
+    /// first.
+    ///
+    /// \param window Window to read
+    ///
+    /// \return True if the readback was queued, false if the
+    ///         window can't be activated or the queue is full
+    ///
+    /// \see pop
+    ///
+    ////////////////////////////////////////////////////////////
+    bool push(RenderWindow& window);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve the oldest readback, if it is over
+    ///
+    /// This function doesn't block: if the graphics card has
+    /// not finished copying the pixels of the oldest readback,
+    /// it returns false and leaves \a image unchanged. Readbacks
+    /// are usually ready one or two frames after they are queued.
+    ///
+    /// \param image Image that receives the pixels
+    ///
+    /// \return True if a readback was retrieved
+    ///
+    /// \see push, isReady
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pop(Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the oldest readback is over
+    ///
+    /// \return True if pop would succeed
+    ///
+    /// \see pop
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of queued readbacks
+    ///
+    /// \return Number of readbacks that were pushed but not popped yet
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPendingCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports asynchronous readbacks
+    ///
+    /// If this function returns false, the readbacks are
+    /// performed synchronously when they are queued.
+    ///
+    /// \return True if asynchronous readbacks are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pending readback
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Slot
+    {
+        unsigned int  buffer;  ///< Pixel buffer object receiving the pixels
+        std::size_t   bytes;   ///< Size of the storage of the pixel buffer object
+        mutable void* fence;   ///< Fence inserted after the copy, released once it is signaled
+        Vector2u      size;    ///< Size of the pixel area
+        bool          flipped; ///< Are the rows stored bottom to top?
+        Image         image;   ///< Pixels, when pixel buffer objects are unavailable
+    };
+
+    enum {SlotCount = 3};
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the slot of the next readback
+    ///
+    /// \return Pointer to the slot, or NULL if the queue is full
+    ///
+    ////////////////////////////////////////////////////////////
+    Slot* reserveSlot();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the pixels of the current read framebuffer to a slot
+    ///
+    /// \param slot    Slot receiving the pixels
+    /// \param size    Size of the area to read
+    /// \param flipped Are the rows stored bottom to top?
+    ///
+    ////////////////////////////////////////////////////////////
+    void readPixels(Slot& slot, const Vector2u& size, bool flipped);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the copy to a slot is over
+    ///
+    /// \param slot Slot to check
+    ///
+    /// \return True if the pixels are available
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isComplete(const Slot& slot) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Slot        m_slots[SlotCount]; ///< Ring of readbacks
+    std::size_t m_first;            ///< Index of the oldest readback
+    std::size_t m_count;            ///< Number of queued readbacks
+};
+
+} // namespace sf
+
+
+#endif // SFML_READBACKQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ReadbackQueue
+/// \ingroup graphics
+///
+/// sf::Texture::copyToImage and sf::RenderWindow::capture wait
+/// until the graphics card has rendered everything and copied
+/// the pixels, which stalls the whole pipeline. That's fine
+/// for an occasional screenshot, but too expensive to record
+/// a video or to take thumbnails regularly.
+///
+/// sf::ReadbackQueue copies the pixels into pixel buffer
+/// objects instead: push queues the copy and returns
+/// immediately, and pop retrieves the image once the graphics
+/// card is done, usually a frame or two later. The pixels are
+/// read directly from the useful area of the texture, so
+/// padded textures don't need an intermediate copy.
+///
+/// The queue can hold up to 3 pending readbacks; push fails
+/// when it is full, so pop the finished ones regularly.
+/// The pixel buffers are kept from one readback to the next,
+/// and pop reuses the memory of the image it fills if the size
+/// didn't change: recording frame after frame into the same
+/// image doesn't allocate anything.
+///
+/// Usage example:
+/// \code
+/// sf::ReadbackQueue recorder;
+///
+/// while (window.isOpen())
+/// {
+///     ...
+///     window.clear();
+///     window.draw(scene);
+///     recorder.push(window);
+///     window.display();
+///
+///     // Retrieve the frames that are ready
+///     sf::Image frame;
+///     while (recorder.pop(frame))
+///         encoder.addFrame(frame);
+/// }
+/// \endcode
+///
+/// \see sf::Texture, sf::RenderWindow
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,386 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RENDERQUEUE_HPP
+#define SFML_RENDERQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Drawable;
+class RenderTarget;
+class VertexBuffer;
+class View;
+
+////////////////////////////////////////////////////////////
+/// \brief Record draw commands and render them sorted by states
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API RenderQueue : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty queue, where all the layers are sorted
+    /// by render states.
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~RenderQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the layer of the next recorded commands
+    ///
+    /// Layers are always rendered in increasing order, layer 0
+    /// first. The default layer is 0.
+    ///
+    /// \param layer New current layer
+    ///
+    /// \see getLayer
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLayer(Uint8 layer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the layer of the next recorded commands
+    ///
+    /// \return Current layer
+    ///
+    /// \see setLayer
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint8 getLayer() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Choose whether a layer keeps its submission order
+    ///
+    /// The commands of an ordered layer are rendered in the order
+    /// they were recorded, which is required when they overlap and
+    /// use alpha blending. The commands of an unordered layer are
+    /// sorted by shader, texture, blend mode and depth. Layers are
+    /// unordered by default.
+    ///
+    /// \param layer   Index of the layer
+    /// \param ordered True to preserve the submission order
+    ///
+    /// \see isLayerOrdered
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLayerOrdered(Uint8 layer, bool ordered);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a layer keeps its submission order
+    ///
+    /// \param layer Index of the layer
+    ///
+    /// \return True if the layer is ordered, false otherwise
+    ///
+    /// \see setLayerOrdered
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isLayerOrdered(Uint8 layer) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record the draw commands of a drawable object
+    ///
+    /// The drawable is drawn immediately into the queue, which
+    /// keeps a copy of its geometry: it can be modified or
+    /// destroyed afterwards. The textures and shaders that it
+    /// uses must stay alive until the queue is rendered.
+    ///
+    /// \param drawable Object to record
+    /// \param states   Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Drawable& drawable, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives defined by an array of vertices
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives defined by a vertex buffer
+    ///
+    /// The vertex buffer is not copied, it must stay alive
+    /// and unchanged until the queue is rendered.
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render the recorded commands to a target
+    ///
+    /// The commands are sorted and drawn, layer after layer.
+    /// The queue is left unchanged, so that the same commands
+    /// can be rendered again; call clear() to start a new frame.
+    ///
+    /// Enabling batching on the target (see
+    /// RenderTarget::setBatchingEnabled) lets it merge the
+    /// consecutive commands that the sort brings together.
+    ///
+    /// \param target Render target to draw to
+    ///
+    ////////////////////////////////////////////////////////////
+    void render(RenderTarget& target);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render the recorded commands to a target, through several views
+    ///
+    /// This function is meant for split-screen and minimaps:
+    /// the scene is recorded once, and rendered in each view
+    /// one after the other. The commands are sorted once for all
+    /// the views, and if culling is enabled on the target (see
+    /// RenderTarget::setCullingEnabled), their bounds are also
+    /// computed once, so that each view only tests a rectangle
+    /// per command to skip the ones it can't see. Commands that
+    /// draw vertex buffers are never skipped.
+    ///
+    /// The view of the target is restored when the function returns.
+    ///
+    /// \param target    Render target to draw to
+    /// \param views     Array of the views to render the commands through
+    /// \param viewCount Number of views in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void render(RenderTarget& target, const View* views, std::size_t viewCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the recorded commands
+    ///
+    /// The current layer and the ordered layers are preserved.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of recorded commands
+    ///
+    /// \return Number of commands in the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCommandCount() const;
+
+private:
+
+    friend class RenderTarget;
+    friend class CommandBuffer;
+
+    class Recorder;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a draw call intercepted by the recorder
+    ///
+    /// \param vertices     Pointer to the vertices, or NULL for a vertex buffer
+    /// \param vertexCount  Number of vertices to render
+    /// \param type         Type of primitives to draw
+    /// \param states       Render states to use for drawing
+    /// \param vertexBuffer Vertex buffer to draw, or NULL for an array of vertices
+    /// \param firstVertex  Index of the first vertex of the vertex buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void record(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states,
+                const VertexBuffer* vertexBuffer, std::size_t firstVertex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Build the part of a sort key that depends on render states
+    ///
+    /// \param states Render states of the command
+    ///
+    /// \return State bits of the sort key
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 makeStateKey(const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sort the commands according to their keys
+    ///
+    ////////////////////////////////////////////////////////////
+    void sort();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render a range of commands in submission order
+    ///
+    /// \param target Render target to draw to
+    /// \param first  Index of the first command to render
+    /// \param count  Number of commands to render
+    ///
+    ////////////////////////////////////////////////////////////
+    void renderCommands(RenderTarget& target, std::size_t first, std::size_t count) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recorded draw call
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Command
+    {
+        Uint64              stateKey;     ///< Sort key of the render states, used in unordered layers
+        Uint8               layer;        ///< Layer of the command
+        RenderStates        states;       ///< Render states of the draw
+        PrimitiveType       type;         ///< Type of primitives
+        std::size_t         firstVertex;  ///< Index of the first vertex, in the queue or in the vertex buffer
+        std::size_t         vertexCount;  ///< Number of vertices
+        const VertexBuffer* vertexBuffer; ///< Vertex buffer to draw, if any
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry of the sorted list of commands
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SortEntry
+    {
+        Uint64       key;     ///< Sort key of the command
+        unsigned int command; ///< Index of the command
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render a single command
+    ///
+    /// \param target  Render target to draw to
+    /// \param command Command to render
+    ///
+    ////////////////////////////////////////////////////////////
+    void renderCommand(RenderTarget& target, const Command& command) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the bounds of the commands recorded since the last call
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateBounds();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Recorder*                  m_recorder;     ///< Render target capturing the geometry of drawables
+    Uint8                      m_layer;        ///< Layer of the next commands
+    bool                       m_ordered[256]; ///< Ordered flag of each layer
+    std::vector<Command>       m_commands;     ///< Recorded commands, in submission order
+    std::vector<Vertex>        m_vertices;     ///< Copies of the recorded vertices
+    std::vector<const Shader*> m_shaders;      ///< Shaders seen since the last clear, their index is part of the keys
+    std::vector<BlendMode>     m_blendModes;   ///< Blend modes seen since the last clear, their index is part of the keys
+    std::vector<SortEntry>     m_entries;      ///< Sorted commands
+    std::vector<SortEntry>     m_scratch;      ///< Temporary storage of the radix sort
+    std::vector<FloatRect>     m_bounds;       ///< Bounds of the commands in world coordinates, empty width for unknown bounds
+    bool                       m_sorted;       ///< Are the entries up to date?
+};
+
+} // namespace sf
+
+
+#endif // SFML_RENDERQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RenderQueue
+/// \ingroup graphics
+///
+/// sf::RenderQueue defers rendering so that draw calls can be
+/// reordered. Instead of being rendered immediately, drawables
+/// and vertices are recorded into the queue together with their
+/// render states. When the queue is rendered, the commands are
+/// sorted by layer first, and then by shader, texture and blend
+/// mode, so that the render target doesn't have to switch states
+/// back and forth.
+///
+/// Sorting by states changes the order in which the commands are
+/// drawn, which is visible when overlapping objects are blended.
+/// The layers whose submission order matters (e.g. transparent
+/// objects drawn back to front) can be marked as ordered with
+/// setLayerOrdered.
+///
+/// A recorded scene can also be rendered through several views,
+/// for split-screen or minimaps, without recording it again:
+/// \code
+/// sf::View views[] = {leftView, rightView};
+/// queue.render(window, views, 2);
+/// \endcode
+///
+/// Opaque objects drawn with sf::BlendNone to a target with
+/// depth testing enabled (see sf::RenderTarget::setDepthTestEnabled)
+/// are layered by their depth, and can stay in unordered layers:
+/// commands with the same states are then rendered front to back,
+/// so that the hidden pixels are rejected early.
+///
+/// The queue records its own copy of the vertices, but only
+/// keeps pointers to the textures, shaders and vertex buffers:
+/// they must stay alive until the commands are rendered.
+///
+/// Usage example:
+/// \code
+/// sf::RenderQueue queue;
+/// queue.setLayerOrdered(1, true);
+///
+/// window.setBatchingEnabled(true);
+///
+/// while (window.isOpen())
+/// {
+///     queue.clear();
+///
+///     // Background tiles: any order will do
+///     queue.setLayer(0);
+///     for (std::size_t i = 0; i < tiles.size(); ++i)
+///         queue.draw(tiles[i]);
+///
+///     // Characters: must be drawn back to front
+///     queue.setLayer(1);
+///     for (std::size_t i = 0; i < characters.size(); ++i)
+///         queue.draw(characters[i]);
+///
+///     window.clear();
+///     queue.render(window);
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
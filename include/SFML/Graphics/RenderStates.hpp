@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/StencilMode.hpp>
 #include <SFML/Graphics/Transform.hpp>
 
 
@@ -53,6 +54,8 @@ public:
     /// to using sf::RenderStates::Default.
     /// The default set defines:
     /// \li the BlendAlpha blend mode
+    /// \li a disabled stencil mode
+    /// \li a depth of 0
     /// \li the identity transform
     /// \li a null texture
     /// \li a null shader
@@ -68,6 +71,14 @@ public:
     ////////////////////////////////////////////////////////////
     RenderStates(const BlendMode& theBlendMode);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a default set of render states with a custom stencil mode
+    ///
+    /// \param theStencilMode Stencil mode to use
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderStates(const StencilMode& theStencilMode);
+
     ////////////////////////////////////////////////////////////
     /// \brief Construct a default set of render states with a custom transform
     ///
@@ -112,10 +123,12 @@ public:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    BlendMode      blendMode; ///< Blending mode
-    Transform      transform; ///< Transform
-    const Texture* texture;   ///< Texture
-    const Shader*  shader;    ///< Shader
+    BlendMode      blendMode;   ///< Blending mode
+    StencilMode    stencilMode; ///< Stencil mode
+    Transform      transform;   ///< Transform
+    const Texture* texture;     ///< Texture
+    const Shader*  shader;      ///< Shader
+    float          depth;       ///< Depth of the drawn geometry, between 0 (front) and 1 (back), used when depth testing is enabled
 };
 
 } // namespace sf
@@ -128,13 +141,19 @@ public:
 /// \class sf::RenderStates
 /// \ingroup graphics
 ///
-/// There are four global states that can be applied to
+/// There are five global states that can be applied to
 /// the drawn objects:
 /// \li the blend mode: how pixels of the object are blended with the background
+/// \li the stencil mode: which pixels of the object are drawn, using the stencil buffer
 /// \li the transform: how the object is positioned/rotated/scaled
 /// \li the texture: what image is mapped to the object
 /// \li the shader: what custom effect is applied to the object
 ///
+/// When depth testing is enabled on the target (see
+/// sf::RenderTarget::setDepthTestEnabled), the depth member
+/// also lets opaque objects be layered independently of the
+/// order in which they are drawn.
+///
 /// High-level objects such as sprites or text force some of
 /// these states when they are drawn. For example, a sprite
 /// will set its own texture, so that you don't have to care
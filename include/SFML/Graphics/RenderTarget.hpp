@@ -38,11 +38,25 @@
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <string>
+#include <vector>
 
 
 namespace sf
 {
 class Drawable;
+class Instance;
+class RenderQueue;
+class VertexBuffer;
+
+namespace priv
+{
+    class CorePipeline;
+    class GpuTimer;
+    class InstanceRenderer;
+    class VertexRingBuffer;
+}
 
 ////////////////////////////////////////////////////////////
 /// \brief Base class for all render targets (window, texture, ...)
@@ -69,6 +83,19 @@ public:
     ////////////////////////////////////////////////////////////
     void clear(const Color& color = Color(0, 0, 0, 255));
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Clear the stencil buffer of the target with a single value
+    ///
+    /// Like clear(), this function ignores the clipping rectangle.
+    /// It has no effect if the target has no stencil buffer.
+    ///
+    /// \param value Stencil value to clear the stencil buffer with
+    ///
+    /// \see StencilMode
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearStencil(Uint8 value);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the current active view
     ///
@@ -128,6 +155,50 @@ public:
     ////////////////////////////////////////////////////////////
     IntRect getViewport(const View& view) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Restrict the drawing to a rectangle
+    ///
+    /// The rectangle is expressed in the coordinates of the
+    /// current view, and converted to pixels when this function
+    /// is called: changing the view afterwards doesn't move it.
+    /// If the view is rotated, the pixels of the bounding box of
+    /// the rotated rectangle are kept. The new clipping rectangle
+    /// is the intersection of \a rect and the current one, so
+    /// that nested UI panels can't draw outside their parent.
+    ///
+    /// Clipping uses the scissor test of the graphics card: it
+    /// costs nothing per pixel, and the clipped geometry can be
+    /// batched with the rest of the target. clear() ignores
+    /// the clipping rectangle.
+    ///
+    /// Every call must be matched by a call to popClipRect.
+    ///
+    /// \param rect Rectangle to draw into, in view coordinates
+    ///
+    /// \see popClipRect, getClipRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void pushClipRect(const FloatRect& rect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restore the clipping rectangle active before the last pushClipRect
+    ///
+    /// \see pushClipRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void popClipRect();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current clipping rectangle
+    ///
+    /// \return Rectangle the drawing is restricted to, in pixels,
+    ///         the whole target if no clipping rectangle is pushed
+    ///
+    /// \see pushClipRect
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect getClipRect() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Convert a point from target coordinates to world
     ///        coordinates, using the current view
@@ -247,6 +318,440 @@ public:
     void draw(const Vertex* vertices, std::size_t vertexCount,
               PrimitiveType type, const RenderStates& states = RenderStates::Default);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives defined by an array of vertices
+    ///
+    /// The primitives are made of the vertices referenced by
+    /// \a indices, in that order, so that vertices shared by
+    /// several primitives only have to be stored and transformed
+    /// once. Every index must be lower than \a vertexCount.
+    ///
+    /// On OpenGL ES, indices are limited to 16 bits: arrays of
+    /// more than 65536 vertices can't be drawn this way.
+    ///
+    /// Indexed primitives can't be merged by batching nor
+    /// recorded by a render queue; in these cases the vertices
+    /// are expanded on the CPU and drawn like regular ones.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param indices     Pointer to the indices
+    /// \param indexCount  Number of indices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount, const Uint32* indices, std::size_t indexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by a vertex buffer
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by a range of a vertex buffer
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param firstVertex  Index of the first vertex to render
+    /// \param vertexCount  Number of vertices to render
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex, std::size_t vertexCount, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw many instances of the same textured quad
+    ///
+    /// Each instance places a copy of \a quad, which is defined
+    /// in local coordinates, at its own position with its own
+    /// rotation, scale, texture rectangle and color. The whole
+    /// array is rendered with a single draw call when the system
+    /// supports hardware instancing, otherwise the instances are
+    /// expanded to triangles on the CPU.
+    ///
+    /// Hardware instancing uses an internal shader, therefore
+    /// it is never used when \a states contains a shader.
+    ///
+    /// \param quad          Local rectangle of the quad
+    /// \param instances     Pointer to the instances
+    /// \param instanceCount Number of instances in the array
+    /// \param states        Render states to use for drawing
+    ///
+    /// \see Instance
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawInstanced(const FloatRect& quad, const Instance* instances, std::size_t instanceCount,
+                       const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the maximum vertex count of pre-transformed draws
+    ///
+    /// Arrays of vertices that are small enough are transformed
+    /// on the CPU, so that the transform matrix doesn't have to
+    /// be changed, which is usually more expensive than the
+    /// computation itself for a few vertices. Bigger arrays
+    /// are rendered with their transform loaded on the GPU.
+    ///
+    /// Draws that use the transform already loaded on the GPU
+    /// are never pre-transformed, whatever their size: they
+    /// need no matrix change at all. This is the case of
+    /// consecutive draws with the same transform, and of draws
+    /// with the identity transform while pre-transforming.
+    ///
+    /// The best value depends on the CPU, the graphics driver
+    /// and the content of the scene. The default value is 16.
+    ///
+    /// \param count Maximum number of vertices to pre-transform
+    ///
+    /// \see getPreTransformThreshold
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPreTransformThreshold(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum vertex count of pre-transformed draws
+    ///
+    /// \return Maximum number of vertices to pre-transform
+    ///
+    /// \see setPreTransformThreshold
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPreTransformThreshold() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable automatic batching of draw calls
+    ///
+    /// When batching is enabled, consecutive draws of independent
+    /// primitives (points, lines, triangles and quads) that use
+    /// the same primitive type, texture, blend mode and shader are
+    /// pre-transformed and accumulated in an internal vertex buffer,
+    /// instead of being sent to the graphics card one by one. The
+    /// accumulated geometry is rendered with a single draw call
+    /// as soon as the render states change, or when the target is
+    /// cleared, displayed or its view is changed.
+    ///
+    /// Since the rendering is deferred, the textures and shaders
+    /// used by the pending draws must stay alive and unmodified
+    /// until the batch is flushed. If you need to change them
+    /// (for example by updating a shader parameter between two
+    /// draws), call flushBatch() first.
+    ///
+    /// Batching is disabled by default.
+    ///
+    /// \param enabled True to enable batching, false to disable it
+    ///
+    /// \see isBatchingEnabled, flushBatch
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBatchingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether automatic batching of draw calls is enabled
+    ///
+    /// \return True if batching is enabled, false otherwise
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isBatchingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the normalization of batched texture coordinates
+    ///
+    /// Texture coordinates are given in pixels, which SFML
+    /// converts with a texture matrix that must be loaded every
+    /// time the texture changes. When this option is enabled, the
+    /// texture coordinates of batched vertices are normalized
+    /// while they are pre-transformed, and batches are rendered
+    /// with normalized coordinates: the texture matrix is left
+    /// untouched (as long as textures are not flipped, which only
+    /// happens with some render textures).
+    ///
+    /// This mostly benefits programs that switch between a few
+    /// large textures, such as atlases, with batching enabled.
+    /// Draws that are not batched are not affected.
+    ///
+    /// This option is disabled by default.
+    ///
+    /// \param enabled True to normalize batched texture coordinates
+    ///
+    /// \see isNormalizedTexCoordsEnabled, setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setNormalizedTexCoordsEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether batched texture coordinates are normalized
+    ///
+    /// \return True if batched texture coordinates are normalized
+    ///
+    /// \see setNormalizedTexCoordsEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isNormalizedTexCoordsEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render the geometry accumulated by the batching mode
+    ///
+    /// This function is called automatically whenever needed,
+    /// you only have to call it yourself if you modify a texture
+    /// or shader used by pending draws, or before issuing your
+    /// own OpenGL commands. It does nothing if batching is
+    /// disabled or if no geometry is pending.
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void flushBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the core pipeline
+    ///
+    /// The core pipeline replaces the fixed-function states
+    /// (matrix stacks, client-side vertex arrays) by a built-in
+    /// shader which receives the view, the transform and the
+    /// vertices through uniforms and generic vertex attributes.
+    /// It is always used in OpenGL core profile contexts (see
+    /// sf::ContextSettings) and with OpenGL ES 2 (SFML built with
+    /// SFML_OPENGL_ES2), where the fixed-function pipeline
+    /// doesn't exist; in compatibility contexts it can be enabled
+    /// to avoid the cost of the deprecated states.
+    ///
+    /// With the core pipeline, custom shaders receive the vertex
+    /// components through the \c sf_position, \c sf_color and
+    /// \c sf_texCoords attributes and the matrices through the
+    /// \c sf_viewProjection, \c sf_model and \c sf_textureMatrix
+    /// mat4 uniforms, instead of the gl_* built-in variables.
+    ///
+    /// The core pipeline requires shaders and vertex array
+    /// objects, it is disabled by default.
+    ///
+    /// \param enabled True to enable the core pipeline, false to disable it
+    ///
+    /// \see isCorePipelineEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCorePipelineEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the core pipeline is requested
+    ///
+    /// \return True if the core pipeline is enabled, false otherwise
+    ///
+    /// \see setCorePipelineEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isCorePipelineEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the culling of invisible drawables
+    ///
+    /// When culling is enabled, sf::Sprite, sf::Shape, sf::Text
+    /// and sf::VertexArray check their bounds against the area
+    /// covered by the current view before drawing, and skip
+    /// the draw entirely (no vertex transformation, no state
+    /// change and no OpenGL call) if they are outside of it.
+    /// Custom drawables can do the same with the cull function.
+    ///
+    /// The test is conservative: drawables may be drawn even
+    /// if they are slightly out of the view, but never skipped
+    /// if they are visible, unless a shader moves their vertices.
+    ///
+    /// Culling is disabled by default.
+    ///
+    /// \param enabled True to enable culling, false to disable it
+    ///
+    /// \see isCullingEnabled, cull
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCullingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the culling of invisible drawables is enabled
+    ///
+    /// \return True if culling is enabled, false otherwise
+    ///
+    /// \see setCullingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isCullingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether a drawable can be skipped because it is out of the view
+    ///
+    /// Drawables call this function at the beginning of their
+    /// draw function, with their local bounds and the final
+    /// transform of the draw. It always returns false if
+    /// culling is disabled.
+    ///
+    /// \param bounds    Local bounding rectangle of the drawable
+    /// \param transform Transform applied to the drawable
+    ///
+    /// \return True if the drawable is out of the current view and must not be drawn
+    ///
+    /// \see setCullingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool cull(const FloatRect& bounds, const Transform& transform = Transform::Identity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable depth testing
+    ///
+    /// By default, objects are layered in the order they are
+    /// drawn, which forces draws to be submitted back to front
+    /// and splits the batches whenever the textures alternate.
+    /// When depth testing is enabled, the depth member of
+    /// sf::RenderStates decides which object is in front:
+    /// opaque objects can then be drawn in any order, for
+    /// example sorted by texture (see sf::RenderQueue), and
+    /// the hidden pixels are rejected before being shaded.
+    ///
+    /// Only the draws that use sf::BlendNone write their depth,
+    /// since the pixels of blended objects don't hide what is
+    /// behind them. Blended objects are still hidden by the
+    /// opaque objects in front of them, but must be drawn after
+    /// the opaque ones, back to front.
+    ///
+    /// Objects that have the same depth are layered in the
+    /// order they are drawn. clear() also clears the depth
+    /// buffer while depth testing is enabled.
+    ///
+    /// The target needs a depth buffer: set the depthBits of
+    /// the sf::ContextSettings of a window, or pass true as the
+    /// depthBuffer argument of RenderTexture::create.
+    /// Depth testing is disabled by default.
+    ///
+    /// \param enabled True to enable depth testing, false to disable it
+    ///
+    /// \see isDepthTestEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDepthTestEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether depth testing is enabled
+    ///
+    /// \return True if depth testing is enabled, false otherwise
+    ///
+    /// \see setDepthTestEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDepthTestEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Counters of the work sent to the graphics card
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        Uint32 drawCalls;        ///< Number of OpenGL draw calls
+        Uint64 vertices;         ///< Number of vertices sent to the draw calls
+        Uint32 textureChanges;   ///< Number of texture switches
+        Uint32 shaderChanges;    ///< Number of program switches, including unbinding
+        Uint32 blendModeChanges; ///< Number of blend mode switches
+        Uint32 vertexCacheHits;  ///< Number of draws pre-transformed into the vertex cache
+        Uint32 culledDraws;      ///< Number of draws skipped by culling
+        Uint32 contextSwitches;  ///< Number of OpenGL contexts made current to draw to the target
+        Uint32 targetSwitches;   ///< Number of times the target took its context over from another target
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the collection of statistics
+    ///
+    /// When enabled, the target counts the draw calls, vertices
+    /// and state changes it sends to the graphics card, until
+    /// resetStatistics is called. A typical use is to read and
+    /// reset the statistics once per frame.
+    ///
+    /// Statistics are disabled by default.
+    ///
+    /// \param enabled True to collect statistics, false to stop
+    ///
+    /// \see isStatisticsEnabled, getStatistics, resetStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void setStatisticsEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether statistics are collected
+    ///
+    /// \return True if statistics are collected, false otherwise
+    ///
+    /// \see setStatisticsEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isStatisticsEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the statistics collected since the last reset
+    ///
+    /// Draws that are still pending in the batch (see
+    /// setBatchingEnabled) are not counted until it is flushed.
+    ///
+    /// \return Collected statistics
+    ///
+    /// \see resetStatistics, setStatisticsEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    const Statistics& getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset all the statistics counters to zero
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start measuring the GPU time of a named zone
+    ///
+    /// Everything drawn between beginTimingZone and
+    /// endTimingZone is timed by the graphics card. The result
+    /// is collected asynchronously, without waiting for the
+    /// GPU: it becomes available through getTimingZone a few
+    /// frames later, and is replaced by the newest measure of
+    /// the zone every time one is collected.
+    ///
+    /// Zones cannot be nested: calling beginTimingZone while
+    /// another zone is open does nothing. GPU timing requires
+    /// OpenGL 3.3 or the ARB_timer_query extension, these
+    /// functions do nothing if it is not supported.
+    ///
+    /// \param name Name of the zone
+    ///
+    /// \see endTimingZone, getTimingZone
+    ///
+    ////////////////////////////////////////////////////////////
+    void beginTimingZone(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop measuring the current timing zone
+    ///
+    /// \see beginTimingZone
+    ///
+    ////////////////////////////////////////////////////////////
+    void endTimingZone();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the last collected GPU time of a zone
+    ///
+    /// \param name Name of the zone
+    ///
+    /// \return GPU time of the zone, or Time::Zero if no measure was collected yet
+    ///
+    /// \see beginTimingZone
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getTimingZone(const std::string& name) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the rendering region of the target
     ///
@@ -342,20 +847,132 @@ protected:
 
 private:
 
+    friend class RenderQueue;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send primitives to the graphics card
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    /// \param normalized  Are the texture coordinates normalized?
+    /// \param indices     Pointer to the indices, or NULL to draw the vertices in order
+    /// \param indexCount  Number of indices in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawPrimitives(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states,
+                        bool normalized = false, const Uint32* indices = NULL, std::size_t indexCount = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate vertices in the vertex stream
+    ///
+    /// The target must be active.
+    ///
+    /// \param vertexCount Number of vertices to allocate
+    /// \param firstVertex Receives the index of the first vertex in the stream
+    ///
+    /// \return Pointer to the mapped vertices, or NULL if they can't be streamed
+    ///
+    ////////////////////////////////////////////////////////////
+    Vertex* streamVertices(std::size_t vertexCount, std::size_t& firstVertex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send primitives stored in the vertex stream to the graphics card
+    ///
+    /// \param firstVertex Index of the first vertex in the stream
+    /// \param vertexCount Number of vertices to render
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    /// \param normalized  Are the texture coordinates normalized?
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawStreamed(std::size_t firstVertex, std::size_t vertexCount,
+                      PrimitiveType type, const RenderStates& states, bool normalized = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set up the vertex pointers for the bound vertex buffer
+    ///
+    /// \param compact Does the buffer store compact vertices?
+    ///
+    ////////////////////////////////////////////////////////////
+    void setupBufferPointers(bool compact = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the view, blend mode, texture and shader of a draw
+    ///
+    /// \param states          Render states to apply
+    /// \param normalized      Are the texture coordinates normalized?
+    /// \param internalProgram Is the draw made with an internal program, which leaves the shader alone?
+    ///
+    ////////////////////////////////////////////////////////////
+    void setupDraw(const RenderStates& states, bool normalized = false, bool internalProgram = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Issue the draw call for the currently bound vertex data
+    ///
+    /// \param type        Type of primitives to draw
+    /// \param firstVertex Index of the first vertex to render
+    /// \param vertexCount Number of vertices to render
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawArrays(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Issue an indexed draw call for the currently bound vertex data
+    ///
+    /// \param type        Type of primitives to draw
+    /// \param indices     Pointer to the indices, relative to \a firstVertex
+    /// \param indexCount  Number of indices to render
+    /// \param firstVertex Index of the first vertex referenced by the indices
+    /// \param vertexCount Number of vertices referenced by the indices
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawElements(PrimitiveType type, const Uint32* indices, std::size_t indexCount,
+                      std::size_t firstVertex, std::size_t vertexCount);
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply the current view
     ///
     ////////////////////////////////////////////////////////////
     void applyCurrentView();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the current clipping rectangle
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyClipRect();
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply a new blending mode
     ///
+    /// Only the factors or the equations that differ from the
+    /// cached blending mode are sent to OpenGL.
+    ///
     /// \param mode Blending mode to apply
     ///
     ////////////////////////////////////////////////////////////
     void applyBlendMode(const BlendMode& mode);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply a new stencil mode
+    ///
+    /// Only the parts of the stencil state that differ from the
+    /// cached stencil mode are sent to OpenGL.
+    ///
+    /// \param mode Stencil mode to apply
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyStencilMode(const StencilMode& mode);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the depth test state of a draw
+    ///
+    /// \param states Render states of the draw
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyDepth(const RenderStates& states);
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply a new transform
     ///
@@ -367,10 +984,11 @@ private:
     ////////////////////////////////////////////////////////////
     /// \brief Apply a new texture
     ///
-    /// \param texture Texture to apply
+    /// \param texture    Texture to apply
+    /// \param normalized Are the texture coordinates normalized?
     ///
     ////////////////////////////////////////////////////////////
-    void applyTexture(const Texture* texture);
+    void applyTexture(const Texture* texture, bool normalized = false);
 
     ////////////////////////////////////////////////////////////
     /// \brief Apply a new shader
@@ -380,6 +998,14 @@ private:
     ////////////////////////////////////////////////////////////
     void applyShader(const Shader* shader);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the changes of the shader that is already bound
+    ///
+    /// \param shader Shader of the current draw
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateShader(const Shader& shader);
+
     ////////////////////////////////////////////////////////////
     /// \brief Activate the target for rendering
     ///
@@ -394,20 +1020,63 @@ private:
     ////////////////////////////////////////////////////////////
     virtual bool activate(bool active) = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Activate the target and check its states cache
+    ///
+    /// Calls activate(true) and, if another render target used
+    /// the same OpenGL context in the meantime, invalidates the
+    /// cached states so that they are set again before drawing.
+    ///
+    /// \return True if the target could be activated
+    ///
+    ////////////////////////////////////////////////////////////
+    bool activateTarget();
+
     ////////////////////////////////////////////////////////////
     /// \brief Render states cache
     ///
     ////////////////////////////////////////////////////////////
     struct StatesCache
     {
-        enum {VertexCacheSize = 4};
-
-        bool      glStatesSet;    ///< Are our internal GL states set yet?
-        bool      viewChanged;    ///< Has the current view changed since last draw?
-        BlendMode lastBlendMode;  ///< Cached blending mode
-        Uint64    lastTextureId;  ///< Cached texture
-        bool      useVertexCache; ///< Did we previously use the vertex cache?
-        Vertex    vertexCache[VertexCacheSize]; ///< Pre-transformed vertices cache
+        enum {DefaultVertexCacheSize = 16};
+
+        bool         glStatesSet;    ///< Are our internal GL states set yet?
+        bool         viewChanged;    ///< Has the current view changed since last draw?
+        bool         clipChanged;    ///< Has the clipping rectangle changed since last draw?
+        Uint32       lastBlendKey;   ///< Cached blending mode, packed (see packBlendMode in RenderTarget.cpp)
+        Uint32       lastStencilKey; ///< Cached stencil mode, packed (see packStencilMode in RenderTarget.cpp)
+        bool         depthTest;      ///< Is the depth test enabled?
+        bool         depthWrite;     ///< Are depth writes enabled?
+        float        lastDepth;      ///< Cached depth, applied as the depth range
+        Uint64       lastTextureId;  ///< Cached texture
+        bool         lastNormalized; ///< Was the cached texture applied for normalized coordinates?
+        unsigned int lastProgram;    ///< Cached shader program, 0 for no custom or internal shader
+        bool         useVertexCache; ///< Did we previously use the vertex cache?
+        bool         transformSet;   ///< Is lastTransform the transform loaded on the GPU?
+        Transform    lastTransform;  ///< Cached model-view transform
+        bool         corePipeline;   ///< Is the core pipeline in use?
+        std::vector<Vertex> vertexCache; ///< Pre-transformed vertices cache, its size is the pre-transform threshold
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Geometry accumulated by the batching mode
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Batch
+    {
+        bool                enabled;     ///< Is batching enabled?
+        bool                normalized;  ///< Are texture coordinates normalized at batch time?
+        PrimitiveType       type;        ///< Primitive type of the pending vertices
+        BlendMode           blendMode;   ///< Blend mode of the pending vertices
+        StencilMode         stencilMode; ///< Stencil mode of the pending vertices
+        const Texture*      texture;     ///< Texture of the pending vertices
+        Uint64              textureId;   ///< Unique identifier of the texture, to detect recycled instances
+        const Shader*       shader;      ///< Shader of the pending vertices
+        float               depth;       ///< Depth of the pending vertices
+        std::size_t         vertexCount; ///< Number of pending vertices
+        bool                streamed;    ///< Are the pending vertices stored in the vertex stream?
+        std::size_t         firstVertex; ///< Index of the first pending vertex in the vertex stream
+        std::vector<Vertex> vertices;    ///< Pending pre-transformed vertices, when not streamed
     };
 
     ////////////////////////////////////////////////////////////
@@ -416,6 +1085,26 @@ private:
     View        m_defaultView; ///< Default view
     View        m_view;        ///< Current view
     StatesCache m_cache;       ///< Render states cache
+    Batch       m_batch;       ///< Pending batched geometry
+
+    priv::InstanceRenderer* m_instanceRenderer;    ///< Hardware instancing back-end, created on first use
+    priv::VertexRingBuffer* m_vertexStream;        ///< Mapped buffer used to stream dynamic vertices, created on first use
+    RenderQueue*            m_queue;               ///< Queue recording the draws instead of rendering them, if any
+    priv::CorePipeline*     m_corePipeline;        ///< Shader-based pipeline, created on first use
+    bool                    m_corePipelineEnabled; ///< Is the core pipeline requested in compatibility contexts?
+    std::vector<Vertex>     m_instanceVertices;    ///< Scratch array for the CPU expansion of instances
+    std::vector<Vertex>     m_indexedVertices;     ///< Scratch array for the CPU expansion of indexed primitives
+    std::vector<Uint32>     m_quadIndices;         ///< Triangle indices used to draw quads where GL_QUADS is unavailable
+    std::vector<Uint32>     m_indices;             ///< Scratch array for the indices that must be made absolute before drawing
+    std::vector<Uint16>     m_shortIndices;        ///< Scratch array for the 16-bit indices required by OpenGL ES
+    priv::GpuTimer*         m_gpuTimer;            ///< Timer of the GPU timing zones, created on first use
+    bool                    m_statisticsEnabled;   ///< Are statistics collected?
+    Statistics              m_statistics;          ///< Statistics collected since the last reset
+    bool                    m_cullingEnabled;      ///< Are drawables out of the view skipped?
+    bool                    m_cullingRectUpdated;  ///< Does the culling rectangle match the current view?
+    FloatRect               m_cullingRect;         ///< Area covered by the current view, in world coordinates
+    std::vector<IntRect>    m_clipRects;           ///< Stack of the clipping rectangles, in pixels
+    bool                    m_depthTestEnabled;    ///< Are draws layered by their depth instead of their order?
 };
 
 } // namespace sf
@@ -446,6 +1135,41 @@ private:
 /// OpenGL states are not messed up by calling the
 /// pushGLStates/popGLStates functions.
 ///
+/// When drawing many small objects that share the same texture
+/// (sprites from a tileset, particles, ...), the per-draw-call
+/// overhead can be removed by enabling the batching mode with
+/// setBatchingEnabled: compatible consecutive draws are then
+/// merged and rendered together.
+///
+/// When the graphics driver supports persistently mapped buffers
+/// (OpenGL 4.4 or ARB_buffer_storage), batched vertices and large
+/// vertex arrays are written directly into a triple-buffered
+/// stream on the graphics card, instead of being copied by the
+/// driver on every draw.
+///
+/// To find out what a frame costs, statistics about the draw
+/// calls and state changes can be collected with
+/// setStatisticsEnabled, and the GPU time of parts of the
+/// frame can be measured with timing zones:
+/// \code
+/// window.setStatisticsEnabled(true);
+///
+/// while (window.isOpen())
+/// {
+///     window.clear();
+///
+///     window.beginTimingZone("world");
+///     // draw the world...
+///     window.endTimingZone();
+///
+///     window.display();
+///
+///     const sf::RenderTarget::Statistics& stats = window.getStatistics();
+///     // display stats.drawCalls, window.getTimingZone("world").asMicroseconds(), ...
+///     window.resetStatistics();
+/// }
+/// \endcode
+///
 /// \see sf::RenderWindow, sf::RenderTexture, sf::View
 ///
 ////////////////////////////////////////////////////////////
@@ -31,6 +31,8 @@
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Window/ContextSettings.hpp>
+#include <vector>
 
 
 namespace sf
@@ -85,10 +87,83 @@ public:
     ////////////////////////////////////////////////////////////
     bool create(unsigned int width, unsigned int height, bool depthBuffer = false);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the render-texture with custom settings
+    ///
+    /// This overload gives more control over the buffers of
+    /// the render-texture: a non-zero \a depthBits member
+    /// requests a depth buffer, and a non-zero
+    /// \a antialiasingLevel makes the render-texture render
+    /// to a multisampled buffer, which is resolved into the
+    /// target texture when display is called. The
+    /// antialiasing level is clamped to
+    /// getMaximumAntialiasingLevel(). The other members of
+    /// \a settings are ignored.
+    ///
+    /// \a attachmentCount is the number of textures rendered
+    /// to at once: fragment shaders write the attachment \a i
+    /// through gl_FragData[i], and each one is retrieved with
+    /// getTexture(i). This allows to fill several buffers, for
+    /// example for deferred lighting, in a single pass.
+    ///
+    /// \a format is the format of all the target textures, for
+    /// example Texture::Rgba16f to accumulate HDR lighting or
+    /// Texture::R8 for masks (see Texture::create).
+    ///
+    /// \param width           Width of the render-texture
+    /// \param height          Height of the render-texture
+    /// \param settings        Depth buffer and antialiasing settings
+    /// \param attachmentCount Number of color attachments, at most getMaximumAttachmentCount()
+    /// \param format          Format of the pixels of the target textures
+    ///
+    /// \return True if creation has been successful
+    ///
+    /// \see getMaximumAntialiasingLevel, getMaximumAttachmentCount
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, const ContextSettings& settings, unsigned int attachmentCount = 1, Texture::Format format = Texture::Rgba8);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the render-texture with a format per color attachment
+    ///
+    /// This overload is similar to the previous one, except that
+    /// each color attachment gets its own format; the number of
+    /// attachments is the number of formats.
+    ///
+    /// \param width    Width of the render-texture
+    /// \param height   Height of the render-texture
+    /// \param settings Depth buffer and antialiasing settings
+    /// \param formats  Format of the pixels of each target texture
+    ///
+    /// \return True if creation has been successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, const ContextSettings& settings, const std::vector<Texture::Format>& formats);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum antialiasing level supported by render-textures
+    ///
+    /// \return Maximum number of samples per pixel, 0 if
+    ///         antialiased render-textures are not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumAntialiasingLevel();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of color attachments of render-textures
+    ///
+    /// \return Maximum number of textures a render-texture can
+    ///         render to at once, 1 if multiple render targets
+    ///         are not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumAttachmentCount();
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable texture smoothing
     ///
-    /// This function is similar to Texture::setSmooth.
+    /// This function is similar to Texture::setSmooth, and
+    /// applies to all the color attachments.
     /// This parameter is disabled by default.
     ///
     /// \param smooth True to enable smoothing, false to disable it
@@ -111,7 +186,8 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable texture repeating
     ///
-    /// This function is similar to Texture::setRepeated.
+    /// This function is similar to Texture::setRepeated, and
+    /// applies to all the color attachments.
     /// This parameter is disabled by default.
     ///
     /// \param repeated True to enable repeating, false to disable it
@@ -131,6 +207,36 @@ public:
     ////////////////////////////////////////////////////////////
     bool isRepeated() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the automatic generation of the mipmap
+    ///
+    /// When enabled, the mipmap of the target texture is
+    /// regenerated every time display is called, so that
+    /// minified draws of the texture stay filtered (see
+    /// Texture::generateMipmap). Otherwise, display invalidates
+    /// any mipmap generated before, since its contents are
+    /// outdated.
+    ///
+    /// The automatic generation of the mipmap is disabled by
+    /// default.
+    ///
+    /// \param enabled True to regenerate the mipmap on display
+    ///
+    /// \see isMipmapEnabled, display
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMipmapEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the mipmap is generated automatically
+    ///
+    /// \return True if the mipmap is regenerated on display
+    ///
+    /// \see setMipmapEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isMipmapEnabled() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Activate of deactivate the render-texture for rendering
     ///
@@ -186,6 +292,28 @@ public:
     ////////////////////////////////////////////////////////////
     const Texture& getTexture() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-only reference to one of the target textures
+    ///
+    /// getTexture(0) is the same as getTexture().
+    ///
+    /// \param attachment Index of the color attachment, lower than getAttachmentCount()
+    ///
+    /// \return Const reference to the texture
+    ///
+    /// \see getAttachmentCount
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture(unsigned int attachment) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of color attachments
+    ///
+    /// \return Number of target textures rendered to at once
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getAttachmentCount() const;
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -204,8 +332,10 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    priv::RenderTextureImpl* m_impl;    ///< Platform/hardware specific implementation
-    Texture                  m_texture; ///< Target texture to draw on
+    priv::RenderTextureImpl* m_impl;           ///< Platform/hardware specific implementation
+    Texture                  m_texture;        ///< Target texture to draw on
+    std::vector<Texture*>    m_attachments;    ///< Additional target textures, for color attachments after the first one
+    bool                     m_mipmapEnabled;  ///< Is the mipmap regenerated on display?
 };
 
 } // namespace sf
@@ -275,6 +405,20 @@ private:
 /// and regular SFML drawing commands. If you need a depth buffer for
 /// 3D rendering, don't forget to request it when calling RenderTexture::create.
 ///
+/// Render-textures can also be antialiased, by passing a
+/// sf::ContextSettings with a non-zero antialiasing level to
+/// create. This is much cheaper than rendering at a higher
+/// resolution and downscaling the result:
+/// \code
+/// sf::RenderTexture texture;
+/// texture.create(500, 500, sf::ContextSettings(0, 0, 4));
+/// \endcode
+///
+/// A render-texture may as well render to several textures at
+/// once (multiple render targets), which shaders fill through
+/// gl_FragData; see RenderTexture::create and
+/// RenderTexture::getTexture(unsigned int).
+///
 /// \see sf::RenderTarget, sf::RenderWindow, sf::View, sf::Texture
 ///
 ////////////////////////////////////////////////////////////
@@ -33,6 +33,7 @@
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Window/Window.hpp>
 #include <string>
+#include <deque>
 
 
 namespace sf
@@ -112,6 +113,42 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Vector2u getSize() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Display on screen what has been rendered to the window so far
+    ///
+    /// This function renders the geometry left pending by the
+    /// batching mode (see RenderTarget::setBatchingEnabled),
+    /// then does the same as Window::display.
+    ///
+    /// If a maximum number of frames in flight is set, it then
+    /// waits until the GPU has finished the frames in excess.
+    ///
+    /// \see setMaxFramesInFlight
+    ///
+    ////////////////////////////////////////////////////////////
+    void display();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Limit the number of frames that the GPU may lag behind
+    ///
+    /// The driver can queue several frames ahead of the GPU,
+    /// especially with vertical synchronization: the frame shown
+    /// on screen then reflects the inputs of 2 or 3 frames ago.
+    /// With a limit of N, display() waits until at most N frames
+    /// are still pending on the GPU, so that the next frame
+    /// starts later but with fresher inputs. 1 gives the lowest
+    /// latency, at the cost of less overlap between the CPU and
+    /// the GPU work.
+    ///
+    /// The limit requires OpenGL sync objects (OpenGL 3.2 or the
+    /// GL_ARB_sync extension); it is ignored otherwise.
+    /// There is no limit by default.
+    ///
+    /// \param count Maximum number of frames in flight (0 to disable the limit)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMaxFramesInFlight(unsigned int count);
+
     ////////////////////////////////////////////////////////////
     /// \brief Copy the current contents of the window to an image
     ///
@@ -125,9 +162,27 @@ public:
     ///
     /// \return Image containing the captured contents
     ///
+    /// \see sf::ReadbackQueue
+    ///
     ////////////////////////////////////////////////////////////
     Image capture() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the current contents of the window to an existing image
+    ///
+    /// The pixels are read straight into the memory of \a image,
+    /// which is reused if its size matches the window: capturing
+    /// every frame into the same image doesn't allocate anything.
+    /// The readback still waits for the graphics card, use
+    /// sf::ReadbackQueue to record without stalling.
+    ///
+    /// \param image Image that receives the contents of the window
+    ///
+    /// \return True if the window could be read, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    bool capture(Image& image) const;
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -160,6 +215,18 @@ private:
     ///
     ////////////////////////////////////////////////////////////
     virtual bool activate(bool active);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Delete the fences of the frames in flight
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearFrameFences();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int      m_maxFramesInFlight; ///< Maximum number of frames that the GPU may lag behind (0 for no limit)
+    std::deque<void*> m_frameFences;       ///< Fences of the frames in flight, oldest first
 };
 
 } // namespace sf
@@ -37,12 +37,20 @@
 #include <SFML/System/Vector3.hpp>
 #include <map>
 #include <string>
+#include <vector>
 
 
 namespace sf
 {
 class InputStream;
 class Texture;
+class TextureArray;
+class UniformBuffer;
+
+namespace priv
+{
+    struct ShaderBuild;
+}
 
 ////////////////////////////////////////////////////////////
 /// \brief Shader class (vertex and fragment)
@@ -456,6 +464,163 @@ public:
     ////////////////////////////////////////////////////////////
     void setParameter(const std::string& name, CurrentTextureType);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a texture array parameter of the shader
+    ///
+    /// The corresponding parameter in the shader must be an
+    /// array of 2D textures (sampler2DArray GLSL type, which
+    /// requires the GL_EXT_texture_array extension in GLSL 1.10).
+    /// Texture arrays use the texture units that follow the
+    /// ones of the 2D textures.
+    ///
+    /// It is important to note that \a textures must remain alive
+    /// as long as the shader uses it, no copy is made internally.
+    ///
+    /// \param name     Name of the texture array in the shader
+    /// \param textures Texture array to assign
+    ///
+    /// \see sf::TextureArray
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParameter(const std::string& name, const TextureArray& textures);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a uniform block of the shader
+    ///
+    /// The block takes its values from \a buffer, which can be
+    /// given to several shaders to share the same values.
+    /// The block must be declared with the std140 layout.
+    ///
+    /// Example:
+    /// \code
+    /// layout(std140) uniform Frame // this is the block in the shader
+    /// {
+    ///     mat4  camera;
+    ///     float time;
+    /// };
+    /// \endcode
+    /// \code
+    /// shader.setParameter("Frame", buffer);
+    /// \endcode
+    ///
+    /// It is important to note that \a buffer must remain alive
+    /// as long as the shader uses it, no copy is made internally.
+    ///
+    /// \param name   Name of the uniform block in the shader
+    /// \param buffer Uniform buffer to assign
+    ///
+    /// \see UniformBuffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParameter(const std::string& name, const UniformBuffer& buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a handle to a parameter of the shader
+    ///
+    /// Looking up a parameter by name has a cost; when a
+    /// parameter is changed often, it is more efficient to
+    /// retrieve its handle once and to pass it to setUniform.
+    /// Handles are invalidated when the shader is reloaded.
+    ///
+    /// Example:
+    /// \code
+    /// int offset = shader.getUniformHandle("offset");
+    /// ...
+    /// shader.setUniform(offset, 2.f);
+    /// \endcode
+    ///
+    /// \param name Name of the parameter in the shader
+    ///
+    /// \return Handle of the parameter, or -1 if not found
+    ///
+    ////////////////////////////////////////////////////////////
+    int getUniformHandle(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a float parameter of the shader
+    ///
+    /// Like setParameter, the value is staged and only sent to
+    /// the graphics card the next time the shader is bound, and
+    /// only if it changed.
+    ///
+    /// \param handle Handle of the parameter, as returned by getUniformHandle
+    /// \param x      Value to assign
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(int handle, float x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a 2-components vector parameter of the shader
+    ///
+    /// \param handle Handle of the parameter, as returned by getUniformHandle
+    /// \param x      First component of the value to assign
+    /// \param y      Second component of the value to assign
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(int handle, float x, float y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a 3-components vector parameter of the shader
+    ///
+    /// \param handle Handle of the parameter, as returned by getUniformHandle
+    /// \param x      First component of the value to assign
+    /// \param y      Second component of the value to assign
+    /// \param z      Third component of the value to assign
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(int handle, float x, float y, float z);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a 4-components vector parameter of the shader
+    ///
+    /// \param handle Handle of the parameter, as returned by getUniformHandle
+    /// \param x      First component of the value to assign
+    /// \param y      Second component of the value to assign
+    /// \param z      Third component of the value to assign
+    /// \param w      Fourth component of the value to assign
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(int handle, float x, float y, float z, float w);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a 2-components vector parameter of the shader
+    ///
+    /// \param handle Handle of the parameter, as returned by getUniformHandle
+    /// \param vector Vector to assign
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(int handle, const Vector2f& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a 3-components vector parameter of the shader
+    ///
+    /// \param handle Handle of the parameter, as returned by getUniformHandle
+    /// \param vector Vector to assign
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(int handle, const Vector3f& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a color parameter of the shader
+    ///
+    /// The color is normalized and assigned to a vec4, like
+    /// with setParameter.
+    ///
+    /// \param handle Handle of the parameter, as returned by getUniformHandle
+    /// \param color  Color to assign
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(int handle, const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a matrix parameter of the shader
+    ///
+    /// \param handle    Handle of the parameter, as returned by getUniformHandle
+    /// \param transform Transform to assign
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(int handle, const sf::Transform& transform);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the underlying OpenGL handle of the shader.
     ///
@@ -468,6 +633,61 @@ public:
     ////////////////////////////////////////////////////////////
     unsigned int getNativeHandle() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable asynchronous compilation
+    ///
+    /// When asynchronous compilation is enabled, the load
+    /// functions return as soon as the compilation is started,
+    /// and the shader becomes usable later, when isReady returns
+    /// true. The driver compiles the shader in the background if
+    /// it supports the KHR_parallel_shader_compile extension,
+    /// otherwise it is compiled by a worker thread.
+    ///
+    /// Until the shader is ready, drawing with it is the same
+    /// as drawing without shader, and its parameters can't be
+    /// set. Compilation errors are reported when the shader
+    /// becomes ready, the load functions only report the
+    /// errors that happen before the compilation starts.
+    ///
+    /// Asynchronous compilation is disabled by default. This
+    /// setting applies to the next load.
+    ///
+    /// \param asynchronous True to enable asynchronous compilation, false to disable it
+    ///
+    /// \see isAsynchronous, isReady
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAsynchronous(bool asynchronous);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether asynchronous compilation is enabled
+    ///
+    /// \return True if asynchronous compilation is enabled
+    ///
+    /// \see setAsynchronous
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isAsynchronous() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the shader has finished compiling
+    ///
+    /// This function doesn't block. It must be called regularly,
+    /// once per frame for example, after an asynchronous load:
+    /// the shader becomes usable during the first call that
+    /// finds the compilation finished.
+    ///
+    /// A shader that was loaded synchronously, or not loaded at
+    /// all, is always ready. Once ready, the shader is usable if
+    /// its compilation succeeded, which getNativeHandle tells.
+    ///
+    /// \return True if no compilation is in progress
+    ///
+    /// \see setAsynchronous
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady();
+
     ////////////////////////////////////////////////////////////
     /// \brief Bind a shader for rendering
     ///
@@ -486,6 +706,11 @@ public:
     /// // draw OpenGL stuff that use no shader...
     /// \endcode
     ///
+    /// The textures of the shader are only bound again to their
+    /// units when they changed since the last bind, so if your
+    /// OpenGL code binds other textures to these units, call
+    /// sf::RenderTarget::resetGLStates before binding the shader.
+    ///
     /// \param shader Shader to bind, can be null to use no shader
     ///
     ////////////////////////////////////////////////////////////
@@ -506,8 +731,41 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isAvailable();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the directory of the program binary cache
+    ///
+    /// When a directory is set and the driver supports program
+    /// binaries, the programs linked by the load functions are
+    /// saved in this directory, and restored from it the next
+    /// time the same sources are loaded with the same driver,
+    /// instead of being compiled again. A binary rejected by the
+    /// driver (after an update, for example) is silently replaced
+    /// by a newly compiled program.
+    ///
+    /// The directory must already exist, it is not created. An
+    /// empty string, the default, disables the cache.
+    ///
+    /// \param directory Directory where the program binaries are stored
+    ///
+    /// \see getBinaryCacheDirectory
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setBinaryCacheDirectory(const std::string& directory);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the directory of the program binary cache
+    ///
+    /// \return Directory where the program binaries are stored
+    ///
+    /// \see setBinaryCacheDirectory
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::string getBinaryCacheDirectory();
+
 private:
 
+    friend class RenderTarget;
+
     ////////////////////////////////////////////////////////////
     /// \brief Compile the shader(s) and create the program
     ///
@@ -522,15 +780,53 @@ private:
     ////////////////////////////////////////////////////////////
     bool compile(const char* vertexShaderCode, const char* fragmentShaderCode);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Take a linked program as the program of the shader
+    ///
+    /// \param program OpenGL identifier of the program
+    ///
+    ////////////////////////////////////////////////////////////
+    void setProgram(unsigned int program);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop the asynchronous compilation in progress, if any
+    ///
+    /// Waits for the worker thread, if any, and destroys the
+    /// program being compiled.
+    ///
+    ////////////////////////////////////////////////////////////
+    void cancelBuild();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the parameters and textures to the bound program
+    ///
+    /// Only the parameters modified since the last call are
+    /// uploaded. The program must be bound.
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyParameters() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Bind all the textures used by the shader
     ///
-    /// This function each texture to a different unit, and
-    /// updates the corresponding variables in the shader accordingly.
+    /// This function binds each texture to a different unit,
+    /// skipping the units that already hold their texture in
+    /// the active context.
     ///
     ////////////////////////////////////////////////////////////
     void bindTextures() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the texture units cached for the active context
+    ///
+    /// Must be called when the textures bound to the units may
+    /// have been changed outside of bindTextures(), so that the
+    /// next bind binds them again. This function is for internal
+    /// use by RenderTarget.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void invalidateTextureUnits();
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the location ID of a shader parameter
     ///
@@ -541,19 +837,60 @@ private:
     ////////////////////////////////////////////////////////////
     int getParamLocation(const std::string& name);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage the value of a parameter in the shadow block
+    ///
+    /// \param handle Handle of the parameter
+    /// \param size   Number of floats in the value (1 to 4, or 16 for a matrix)
+    /// \param values Components of the value
+    ///
+    ////////////////////////////////////////////////////////////
+    void stageUniform(int handle, int size, const float* values);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the modified parameters to the bound program
+    ///
+    ////////////////////////////////////////////////////////////
+    void uploadUniforms() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Shadow copy of a parameter
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Uniform
+    {
+        int   location;   ///< Location of the parameter in the program
+        int   size;       ///< Number of floats in the value, 0 if never set
+        bool  dirty;      ///< Does the value have to be uploaded?
+        float values[16]; ///< Components of the value
+    };
+
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
     typedef std::map<int, const Texture*> TextureTable;
+    typedef std::map<int, const TextureArray*> TextureArrayTable;
+    typedef std::map<unsigned int, const UniformBuffer*> UniformBufferTable;
     typedef std::map<std::string, int> ParamTable;
+    typedef std::vector<Uniform> UniformTable;
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int m_shaderProgram;  ///< OpenGL identifier for the program
-    int          m_currentTexture; ///< Location of the current texture in the shader
-    TextureTable m_textures;       ///< Texture variables in the shader, mapped to their location
-    ParamTable   m_params;         ///< Parameters location cache
+    unsigned int       m_shaderProgram;  ///< OpenGL identifier for the program
+    int                m_currentTexture; ///< Location of the current texture in the shader
+    TextureTable       m_textures;       ///< Texture variables in the shader, mapped to their location
+    TextureArrayTable  m_textureArrays;  ///< Texture array variables in the shader, mapped to their location
+    UniformBufferTable m_uniformBuffers; ///< Uniform blocks of the shader, mapped to their index which is also their binding point
+    ParamTable         m_params;         ///< Parameters location cache
+    ParamTable         m_handles;        ///< Parameters handle cache
+    int                m_matrices[3];    ///< Locations of the matrices provided by the core pipeline of sf::RenderTarget
+
+    mutable UniformTable     m_uniforms;            ///< Shadow block of the parameters
+    mutable std::vector<int> m_dirtyUniforms;       ///< Handles of the parameters to upload on next bind
+    mutable bool             m_textureUnitsChanged; ///< Must the texture units be assigned to the sampler variables on next bind?
+    bool                     m_asynchronous;        ///< Is asynchronous compilation enabled?
+    priv::ShaderBuild*       m_build;               ///< Asynchronous compilation in progress, if any
 };
 
 } // namespace sf
@@ -603,6 +940,18 @@ private:
 /// shader.setParameter("texture", sf::Shader::CurrentTexture);
 /// \endcode
 ///
+/// Parameter values are not sent to the graphics card
+/// immediately: they are stored in the shader and uploaded
+/// when it is bound for drawing, only if they changed since
+/// the previous upload. Parameters that are updated very often
+/// can be assigned through integer handles, which saves the
+/// lookup by name:
+/// \code
+/// int offset = shader.getUniformHandle("offset");
+/// ...
+/// shader.setUniform(offset, 2.f);
+/// \endcode
+///
 /// The special Shader::CurrentTexture argument maps the
 /// given texture variable to the current texture of the
 /// object being drawn (which cannot be known in advance).
@@ -647,6 +996,11 @@ private:
 /// second one doesn't impact the rendering process and can be
 /// easily inserted anywhere without impacting all the code.
 ///
+/// Compiling many shaders can slow down the startup of an
+/// application noticeably. If the driver supports it, the
+/// linked programs can be kept in a binary cache on disk, see
+/// sf::Shader::setBinaryCacheDirectory.
+///
 /// Like sf::Texture that can be used as a raw OpenGL texture,
 /// sf::Shader can also be used directly as a raw shader for
 /// custom OpenGL geometry.
@@ -33,6 +33,7 @@
 #include <SFML/Graphics/Transformable.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/System/Vector2.hpp>
+#include <vector>
 
 
 namespace sf
@@ -267,6 +268,8 @@ protected:
 
 private:
 
+    friend class ShapeBatch;
+
     ////////////////////////////////////////////////////////////
     /// \brief Draw the shape to a render target
     ///
@@ -288,9 +291,21 @@ private:
     ////////////////////////////////////////////////////////////
     void updateTexCoords();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the extrusion direction of each outline point
+    ///
+    /// The directions only depend on the points, they are kept
+    /// until the points change.
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateOutlineNormals();
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the outline vertices' position
     ///
+    /// The outline vertices are placed along the cached
+    /// extrusion directions, scaled by the thickness.
+    ///
     ////////////////////////////////////////////////////////////
     void updateOutline();
 
@@ -305,15 +320,16 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    const Texture* m_texture;          ///< Texture of the shape
-    IntRect        m_textureRect;      ///< Rectangle defining the area of the source texture to display
-    Color          m_fillColor;        ///< Fill color
-    Color          m_outlineColor;     ///< Outline color
-    float          m_outlineThickness; ///< Thickness of the shape's outline
-    VertexArray    m_vertices;         ///< Vertex array containing the fill geometry
-    VertexArray    m_outlineVertices;  ///< Vertex array containing the outline geometry
-    FloatRect      m_insideBounds;     ///< Bounding rectangle of the inside (fill)
-    FloatRect      m_bounds;           ///< Bounding rectangle of the whole shape (outline + fill)
+    const Texture*        m_texture;          ///< Texture of the shape
+    IntRect               m_textureRect;      ///< Rectangle defining the area of the source texture to display
+    Color                 m_fillColor;        ///< Fill color
+    Color                 m_outlineColor;     ///< Outline color
+    float                 m_outlineThickness; ///< Thickness of the shape's outline
+    VertexArray           m_vertices;         ///< Vertex array containing the fill geometry
+    VertexArray           m_outlineVertices;  ///< Vertex array containing the outline geometry
+    FloatRect             m_insideBounds;     ///< Bounding rectangle of the inside (fill)
+    FloatRect             m_bounds;           ///< Bounding rectangle of the whole shape (outline + fill)
+    std::vector<Vector2f> m_outlineNormals;   ///< Extrusion direction of each outline point, for a thickness of 1
 };
 
 } // namespace sf
@@ -350,6 +366,12 @@ private:
 /// \li getPointCount must return the number of points of the shape
 /// \li getPoint must return the points of the shape
 ///
+/// The geometry of a shape is rebuilt by the functions that
+/// modify it, and it only depends on the shape itself: many
+/// shapes can be modified at once from the tasks of a
+/// sf::ThreadPool, as long as each shape is modified by a
+/// single task (see sf::Text::updateGeometry for texts).
+///
 /// \see sf::RectangleShape, sf::CircleShape, sf::ConvexShape, sf::Transformable
 ///
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,334 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SHAPEBATCH_HPP
+#define SFML_SHAPEBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Shape;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Drawable holding many copies of the same shape,
+///        stored and rendered together
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ShapeBatch : public Drawable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty batch, without geometry.
+    ///
+    ////////////////////////////////////////////////////////////
+    ShapeBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the batch from the geometry of a shape
+    ///
+    /// \param shape Shape whose geometry is shared by the copies
+    ///
+    /// \see setShape
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ShapeBatch(const Shape& shape);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the geometry shared by the copies
+    ///
+    /// The local geometry of \a shape (points, outline
+    /// thickness, texture and texture rect) is copied once;
+    /// its position, rotation, scale, origin and colors are
+    /// ignored, each copy has its own. The shape can be
+    /// destroyed afterwards, but its texture must stay alive
+    /// as long as the batch uses it.
+    ///
+    /// The copies already in the batch keep their properties
+    /// and use the new geometry.
+    ///
+    /// \param shape Shape whose geometry is shared by the copies
+    ///
+    ////////////////////////////////////////////////////////////
+    void setShape(const Shape& shape);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a copy of the shape
+    ///
+    /// The new copy is at position (0, 0), with no rotation,
+    /// a scale of (1, 1), an origin of (0, 0), and white
+    /// fill and outline colors. It is drawn on top of the
+    /// copies already in the batch.
+    ///
+    /// \return Index of the new copy
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a copy from the batch
+    ///
+    /// The copies that follow the removed one are shifted
+    /// down by one index, so that the drawing order is kept.
+    ///
+    /// \param index Index of the copy to remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the copies from the batch
+    ///
+    /// The geometry is kept.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of copies in the batch
+    ///
+    /// \return Number of copies
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getShapeCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the position of a copy
+    ///
+    /// \param index    Index of the copy
+    /// \param position New position
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPosition(std::size_t index, const Vector2f& position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the orientation of a copy
+    ///
+    /// \param index Index of the copy
+    /// \param angle New rotation, in degrees
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRotation(std::size_t index, float angle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the scale factors of a copy
+    ///
+    /// \param index   Index of the copy
+    /// \param factors New scale factors
+    ///
+    ////////////////////////////////////////////////////////////
+    void setScale(std::size_t index, const Vector2f& factors);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the local origin of a copy
+    ///
+    /// The origin is the center point for the position, rotation
+    /// and scale, in the local coordinates of the shape.
+    ///
+    /// \param index  Index of the copy
+    /// \param origin New origin
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOrigin(std::size_t index, const Vector2f& origin);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the fill color of a copy
+    ///
+    /// \param index Index of the copy
+    /// \param color New fill color, modulated with the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFillColor(std::size_t index, const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the outline color of a copy
+    ///
+    /// \param index Index of the copy
+    /// \param color New outline color
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOutlineColor(std::size_t index, const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of a copy
+    ///
+    /// \param index Index of the copy
+    ///
+    /// \return Current position
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getPosition(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the orientation of a copy
+    ///
+    /// \param index Index of the copy
+    ///
+    /// \return Current rotation, in degrees
+    ///
+    ////////////////////////////////////////////////////////////
+    float getRotation(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the scale factors of a copy
+    ///
+    /// \param index Index of the copy
+    ///
+    /// \return Current scale factors
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getScale(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local origin of a copy
+    ///
+    /// \param index Index of the copy
+    ///
+    /// \return Current origin
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getOrigin(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the fill color of a copy
+    ///
+    /// \param index Index of the copy
+    ///
+    /// \return Current fill color
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getFillColor(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the outline color of a copy
+    ///
+    /// \param index Index of the copy
+    ///
+    /// \return Current outline color
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getOutlineColor(std::size_t index) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the batch to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark a range of copies as needing new vertices
+    ///
+    /// \param begin Index of the first modified copy
+    /// \param end   Index following the last modified copy
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidate(std::size_t begin, std::size_t end);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Generate the vertices of the modified copies
+    ///
+    ////////////////////////////////////////////////////////////
+    void update() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Vertex>         m_fillGeometry;    ///< Local triangles of the fill, shared by all the copies
+    std::vector<Vertex>         m_outlineGeometry; ///< Local triangles of the outline, shared by all the copies
+    const Texture*              m_texture;         ///< Texture of the fill
+    std::vector<Vector2f>       m_positions;       ///< Position of each copy
+    std::vector<float>          m_rotations;       ///< Rotation of each copy, in degrees
+    std::vector<Vector2f>       m_scales;          ///< Scale factors of each copy
+    std::vector<Vector2f>       m_origins;         ///< Local origin of each copy
+    std::vector<Color>          m_fillColors;      ///< Fill color of each copy
+    std::vector<Color>          m_outlineColors;   ///< Outline color of each copy
+    mutable std::vector<Vertex> m_fillVertices;    ///< Generated fill triangles of all the copies
+    mutable std::vector<Vertex> m_outlineVertices; ///< Generated outline triangles of all the copies
+    mutable std::size_t         m_dirtyBegin;      ///< Index of the first copy whose vertices are outdated
+    mutable std::size_t         m_dirtyEnd;        ///< Index following the last copy whose vertices are outdated
+};
+
+} // namespace sf
+
+
+#endif // SFML_SHAPEBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ShapeBatch
+/// \ingroup graphics
+///
+/// Every sf::Shape computes and stores its own vertices, even
+/// when thousands of them have the same geometry and only
+/// differ by their position and color. sf::ShapeBatch keeps a
+/// single copy of the geometry of a shape, and a compact list
+/// of copies that each have their own position, rotation,
+/// scale, origin, fill color and outline color.
+///
+/// Like sf::SpriteBatch, the batch only regenerates the
+/// vertices of the copies that changed since the last draw,
+/// and renders all the fills with a single draw call, then
+/// all the outlines with another one. Because of that, the
+/// outline of a copy is drawn above the fill of all the
+/// other copies, which only matters when they overlap.
+///
+/// The render states passed to draw (transform, shader,
+/// blend mode) apply to the whole batch.
+///
+/// Usage example:
+/// \code
+/// sf::CircleShape model(4.f, 12);
+/// model.setOutlineThickness(1.f);
+///
+/// sf::ShapeBatch particles(model);
+/// for (int i = 0; i < 10000; ++i)
+/// {
+///     std::size_t index = particles.add();
+///     particles.setPosition(index, sf::Vector2f(std::rand() % 800, std::rand() % 600));
+///     particles.setOrigin(index, sf::Vector2f(4.f, 4.f));
+///     particles.setFillColor(index, sf::Color(std::rand() % 256, 128, 255));
+/// }
+///
+/// window.draw(particles);
+/// \endcode
+///
+/// \see sf::Shape, sf::SpriteBatch
+///
+////////////////////////////////////////////////////////////
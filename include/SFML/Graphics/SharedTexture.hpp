@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SHAREDTEXTURE_HPP
+#define SFML_SHAREDTEXTURE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Reference-counted handle to a texture shared by all its copies
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SharedTexture
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a handle to a new empty texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    SharedTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the handle by taking the content of a texture
+    ///
+    /// The content of \a texture is moved to the shared texture
+    /// with Texture::swap, \a texture is left empty.
+    ///
+    /// \param texture Texture to take the content of
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SharedTexture(Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// The new handle refers to the same texture, nothing is
+    /// copied on the graphics card.
+    ///
+    /// \param copy Handle to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    SharedTexture(const SharedTexture& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The texture is destroyed with its last handle.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SharedTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// The handle releases its texture and refers to the
+    /// texture of \a right.
+    ///
+    /// \param right Handle to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    SharedTexture& operator =(const SharedTexture& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shared texture
+    ///
+    /// \return Reference to the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    Texture& get() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of unary operator *
+    ///
+    /// \return Reference to the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    Texture& operator *() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of operator ->
+    ///
+    /// \return Pointer to the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    Texture* operator ->() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of handles sharing the texture
+    ///
+    /// \return Number of handles, including this one
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getUseCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Texture and reference count shared by the handles
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Shared;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Drop the reference to the shared texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void release();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Shared* m_shared; ///< Texture and reference count shared by the handles
+};
+
+} // namespace sf
+
+
+#endif // SFML_SHAREDTEXTURE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SharedTexture
+/// \ingroup graphics
+///
+/// Copying an sf::Texture duplicates it on the graphics card
+/// through a read back of its pixels, which is slow and
+/// easy to trigger by accident, for example when textures
+/// are stored in a standard container that grows.
+///
+/// sf::SharedTexture is a handle to a texture which is
+/// shared by all its copies: copying or assigning handles
+/// only updates a reference count, and the texture is
+/// destroyed with its last handle. Handles can be stored
+/// in containers and returned by value safely, which makes
+/// them a good fit for resource managers.
+///
+/// Copying and destroying handles which refer to the same
+/// texture from several threads at the same time is not
+/// safe.
+///
+/// Usage example:
+/// \code
+/// std::map<std::string, sf::SharedTexture> textures;
+///
+/// sf::SharedTexture texture;
+/// if (!texture->loadFromFile("player.png"))
+///     return -1;
+/// textures["player"] = texture; // no copy of the texture
+///
+/// sf::Sprite sprite(*textures["player"]);
+/// \endcode
+///
+/// \see sf::Texture
+///
+////////////////////////////////////////////////////////////
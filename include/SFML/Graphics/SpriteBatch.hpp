@@ -0,0 +1,343 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SPRITEBATCH_HPP
+#define SFML_SPRITEBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Drawable holding a large number of sprites, stored
+///        and rendered together
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SpriteBatch : public Drawable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty batch.
+    ///
+    ////////////////////////////////////////////////////////////
+    SpriteBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a sprite displaying a whole texture
+    ///
+    /// The new sprite is at position (0, 0), with no rotation,
+    /// a scale of (1, 1), an origin of (0, 0) and opaque white
+    /// color. It is drawn on top of the sprites already in the batch.
+    ///
+    /// \param texture Source texture of the sprite
+    ///
+    /// \return Index of the new sprite
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a sprite displaying a sub-rectangle of a texture
+    ///
+    /// \param texture   Source texture of the sprite
+    /// \param rectangle Sub-rectangle of the texture to display
+    ///
+    /// \return Index of the new sprite
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(const Texture& texture, const IntRect& rectangle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a sprite from the batch
+    ///
+    /// The sprites that follow the removed one are shifted
+    /// down by one index, so that the drawing order is kept.
+    ///
+    /// \param index Index of the sprite to remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the sprites from the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of sprites in the batch
+    ///
+    /// \return Number of sprites
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSpriteCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the position of a sprite
+    ///
+    /// \param index    Index of the sprite
+    /// \param position New position
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPosition(std::size_t index, const Vector2f& position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the orientation of a sprite
+    ///
+    /// \param index Index of the sprite
+    /// \param angle New rotation, in degrees
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRotation(std::size_t index, float angle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the scale factors of a sprite
+    ///
+    /// \param index   Index of the sprite
+    /// \param factors New scale factors
+    ///
+    ////////////////////////////////////////////////////////////
+    void setScale(std::size_t index, const Vector2f& factors);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the local origin of a sprite
+    ///
+    /// The origin is the center point for the position, rotation
+    /// and scale, relative to the top-left corner of the sprite.
+    ///
+    /// \param index  Index of the sprite
+    /// \param origin New origin
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOrigin(std::size_t index, const Vector2f& origin);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the source texture of a sprite
+    ///
+    /// The texture rect of the sprite is left unchanged.
+    ///
+    /// \param index   Index of the sprite
+    /// \param texture New texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(std::size_t index, const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the sub-rectangle of the texture that a sprite displays
+    ///
+    /// \param index     Index of the sprite
+    /// \param rectangle Rectangle defining the region of the texture to display
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTextureRect(std::size_t index, const IntRect& rectangle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the color of a sprite
+    ///
+    /// \param index Index of the sprite
+    /// \param color New color, modulated with the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setColor(std::size_t index, const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of a sprite
+    ///
+    /// \param index Index of the sprite
+    ///
+    /// \return Current position
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getPosition(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the orientation of a sprite
+    ///
+    /// \param index Index of the sprite
+    ///
+    /// \return Current rotation, in degrees
+    ///
+    ////////////////////////////////////////////////////////////
+    float getRotation(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the scale factors of a sprite
+    ///
+    /// \param index Index of the sprite
+    ///
+    /// \return Current scale factors
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getScale(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local origin of a sprite
+    ///
+    /// \param index Index of the sprite
+    ///
+    /// \return Current origin
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getOrigin(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the source texture of a sprite
+    ///
+    /// \param index Index of the sprite
+    ///
+    /// \return Pointer to the sprite's texture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sub-rectangle of the texture displayed by a sprite
+    ///
+    /// \param index Index of the sprite
+    ///
+    /// \return Texture rectangle of the sprite
+    ///
+    ////////////////////////////////////////////////////////////
+    const IntRect& getTextureRect(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the color of a sprite
+    ///
+    /// \param index Index of the sprite
+    ///
+    /// \return Current color
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getColor(std::size_t index) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the batch to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark a range of sprites as needing new vertices
+    ///
+    /// \param begin Index of the first modified sprite
+    /// \param end   Index following the last modified sprite
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidate(std::size_t begin, std::size_t end);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Generate the vertices of the modified sprites
+    ///
+    ////////////////////////////////////////////////////////////
+    void update() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Vector2f>       m_positions;    ///< Position of each sprite
+    std::vector<float>          m_rotations;    ///< Rotation of each sprite, in degrees
+    std::vector<Vector2f>       m_scales;       ///< Scale factors of each sprite
+    std::vector<Vector2f>       m_origins;      ///< Local origin of each sprite
+    std::vector<IntRect>        m_textureRects; ///< Texture rectangle of each sprite
+    std::vector<Color>          m_colors;       ///< Color of each sprite
+    std::vector<const Texture*> m_textures;     ///< Texture of each sprite
+    mutable std::vector<Vertex> m_vertices;     ///< Generated quads, 4 vertices per sprite
+    mutable std::size_t         m_dirtyBegin;   ///< Index of the first sprite whose vertices are outdated
+    mutable std::size_t         m_dirtyEnd;     ///< Index following the last sprite whose vertices are outdated
+};
+
+} // namespace sf
+
+
+#endif // SFML_SPRITEBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpriteBatch
+/// \ingroup graphics
+///
+/// sf::SpriteBatch stores many sprites in a compact form, and
+/// draws them with as few draw calls as possible. Unlike
+/// sf::Sprite, a sprite in the batch is not an object by itself
+/// but an index, and its properties (position, rotation, scale,
+/// origin, texture rect and color) are stored in parallel arrays.
+///
+/// When the batch is drawn, the vertices of the sprites that
+/// were modified since the last draw are generated in a single
+/// pass, and each run of consecutive sprites that use the same
+/// texture is rendered with a single draw call. The sprites that
+/// did not change are not processed at all. For best performances,
+/// sprites that share a texture (or use an atlas, see sf::TextureAtlas)
+/// should therefore be added next to each other.
+///
+/// As with sf::Sprite, the batch doesn't copy the textures that
+/// it uses, they must stay alive as long as the batch uses them.
+/// The render states passed to draw (transform, shader, blend mode)
+/// apply to the whole batch.
+///
+/// Usage example:
+/// \code
+/// sf::Texture texture;
+/// texture.loadFromFile("particle.png");
+///
+/// sf::SpriteBatch batch;
+/// for (int i = 0; i < 10000; ++i)
+/// {
+///     std::size_t index = batch.add(texture);
+///     batch.setPosition(index, sf::Vector2f(std::rand() % 800, std::rand() % 600));
+///     batch.setColor(index, sf::Color(255, 255, 255, 128));
+/// }
+///
+/// while (window.isOpen())
+/// {
+///     ...
+///     batch.setRotation(0, batch.getRotation(0) + 1.f);
+///
+///     window.clear();
+///     window.draw(batch);
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::Sprite, sf::Texture, sf::VertexArray
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_STENCILMODE_HPP
+#define SFML_STENCILMODE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Config.hpp>
+
+
+namespace sf
+{
+
+////////////////////////////////////////////////////////////
+/// \brief Stencil modes for drawing
+///
+////////////////////////////////////////////////////////////
+struct SFML_GRAPHICS_API StencilMode
+{
+    ////////////////////////////////////////////////////////
+    /// \brief Enumeration of the stencil test comparisons
+    ///
+    /// The comparisons are mapped directly to their OpenGL equivalents,
+    /// specified by glStencilFunc(). The pixel passes the test if
+    /// (reference & mask) compares successfully to (stencil & mask).
+    ////////////////////////////////////////////////////////
+    enum Comparison
+    {
+        Never,        ///< The test never passes
+        Less,         ///< Reference is less than the stencil value
+        LessEqual,    ///< Reference is less than or equal to the stencil value
+        Greater,      ///< Reference is greater than the stencil value
+        GreaterEqual, ///< Reference is greater than or equal to the stencil value
+        Equal,        ///< Reference is equal to the stencil value
+        NotEqual,     ///< Reference is not equal to the stencil value
+        Always        ///< The test always passes
+    };
+
+    ////////////////////////////////////////////////////////
+    /// \brief Enumeration of the stencil buffer updates
+    ///
+    /// The operations are mapped directly to their OpenGL equivalents,
+    /// specified by glStencilOp(). They are applied to the pixels
+    /// that pass the stencil test.
+    ////////////////////////////////////////////////////////
+    enum UpdateOperation
+    {
+        Keep,      ///< The stencil value is not changed
+        Zero,      ///< The stencil value is set to 0
+        Replace,   ///< The stencil value is replaced by the reference
+        Increment, ///< The stencil value is incremented, if not already at its maximum
+        Decrement, ///< The stencil value is decremented, if not already at 0
+        Invert     ///< The bits of the stencil value are inverted
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Constructs a stencil mode that disables the stencil test:
+    /// the pixels are always drawn and the stencil buffer is
+    /// left untouched.
+    ///
+    ////////////////////////////////////////////////////////////
+    StencilMode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the stencil mode given its components
+    ///
+    /// \param comparison      Test that decides whether a pixel is drawn
+    /// \param updateOperation Update of the stencil value of the drawn pixels
+    /// \param reference       Value the stencil buffer is compared with, and written by Replace
+    /// \param mask            Bits of the stencil buffer that are tested and written
+    /// \param only            True to update the stencil buffer without drawing the colors
+    ///
+    ////////////////////////////////////////////////////////////
+    StencilMode(Comparison comparison, UpdateOperation updateOperation,
+                Uint8 reference, Uint8 mask = 0xFF, bool only = false);
+
+    ////////////////////////////////////////////////////////////
+    // Member Data
+    ////////////////////////////////////////////////////////////
+    Comparison      stencilComparison;      ///< Test that decides whether a pixel is drawn
+    UpdateOperation stencilUpdateOperation; ///< Update of the stencil value of the drawn pixels
+    Uint8           stencilReference;       ///< Value the stencil buffer is compared with
+    Uint8           stencilMask;            ///< Bits of the stencil buffer that are tested and written
+    bool            stencilOnly;            ///< Update the stencil buffer without drawing the colors?
+};
+
+////////////////////////////////////////////////////////////
+/// \relates StencilMode
+/// \brief Overload of the == operator
+///
+/// \param left  Left operand
+/// \param right Right operand
+///
+/// \return True if stencil modes are equal, false if they are different
+///
+////////////////////////////////////////////////////////////
+SFML_GRAPHICS_API bool operator ==(const StencilMode& left, const StencilMode& right);
+
+////////////////////////////////////////////////////////////
+/// \relates StencilMode
+/// \brief Overload of the != operator
+///
+/// \param left  Left operand
+/// \param right Right operand
+///
+/// \return True if stencil modes are different, false if they are equal
+///
+////////////////////////////////////////////////////////////
+SFML_GRAPHICS_API bool operator !=(const StencilMode& left, const StencilMode& right);
+
+} // namespace sf
+
+
+#endif // SFML_STENCILMODE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::StencilMode
+/// \ingroup graphics
+///
+/// sf::StencilMode is a class that represents a stencil mode.
+/// The stencil buffer stores an integer value per pixel, and
+/// a stencil mode decides, from that value, which pixels of
+/// an object are drawn and how their value is updated.
+///
+/// This gives masks of arbitrary shapes for the cost of one
+/// extra draw, without shaders nor intermediate render
+/// textures: first draw the shape of the mask, writing only
+/// to the stencil buffer, then draw the masked objects so
+/// that they only appear where the stencil buffer was set.
+///
+/// \code
+/// // The window needs a stencil buffer
+/// sf::ContextSettings settings;
+/// settings.stencilBits = 8;
+/// sf::RenderWindow window(sf::VideoMode(800, 600), "SFML", sf::Style::Default, settings);
+///
+/// window.clear();
+/// window.clearStencil(0);
+///
+/// // Write 1 in the stencil buffer where the circle is drawn, the circle itself is not visible
+/// sf::RenderStates maskStates(sf::StencilMode(sf::StencilMode::Always, sf::StencilMode::Replace, 1, 0xFF, true));
+/// window.draw(circle, maskStates);
+///
+/// // Only draw the pixels of the map where the stencil buffer is 1
+/// sf::RenderStates mapStates(sf::StencilMode(sf::StencilMode::Equal, sf::StencilMode::Keep, 1));
+/// window.draw(map, mapStates);
+/// \endcode
+///
+/// The stencil buffer of the target is requested with the
+/// stencilBits member of sf::ContextSettings. Without it,
+/// the stencil test always passes. Render textures don't
+/// have a stencil buffer.
+///
+/// The draws of a mask and of the objects it clips must
+/// happen in that order: when they are recorded into an
+/// sf::RenderQueue, put them in an ordered layer.
+///
+/// In SFML, a stencil mode can be specified every time you draw
+/// a sf::Drawable object to a render target. It is part of the
+/// sf::RenderStates compound that is passed to the member function
+/// sf::RenderTarget::draw().
+///
+/// \see sf::RenderStates, sf::RenderTarget, sf::BlendMode
+///
+////////////////////////////////////////////////////////////
@@ -34,7 +34,10 @@
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/View.hpp>
 #include <SFML/System/String.hpp>
+#include <SFML/System/ThreadPool.hpp>
+#include <SFML/System/Utf8String.hpp>
 #include <string>
 #include <vector>
 
@@ -62,6 +65,17 @@ public:
         StrikeThrough = 1 << 3  ///< Strike through characters
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enumeration of the horizontal alignments of the rows
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Alignment
+    {
+        Left,   ///< Rows start at the left of the text
+        Center, ///< Rows are centered
+        Right   ///< Rows end at the right of the text
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -108,6 +122,37 @@ public:
     ////////////////////////////////////////////////////////////
     void setString(const String& string);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the text's string from a UTF-8 string
+    ///
+    /// The string is compared to the current one in place, so
+    /// setting the same string again, for example every frame,
+    /// doesn't decode it.
+    ///
+    /// \param string New string
+    ///
+    /// \see getString
+    ///
+    ////////////////////////////////////////////////////////////
+    void setString(const Utf8String& string);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a string at the end of the text
+    ///
+    /// Unlike calling setString with the concatenated string,
+    /// this function keeps the geometry of the current characters:
+    /// only the new ones are laid out on the next update, which
+    /// makes it cheap to grow a text such as a log or a chat box.
+    /// Note that setString also takes this path when the new
+    /// string starts with the current one.
+    ///
+    /// \param string String to append
+    ///
+    /// \see setString, getString
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(const String& string);
+
     ////////////////////////////////////////////////////////////
     /// \brief Set the text's font
     ///
@@ -170,6 +215,37 @@ public:
     ////////////////////////////////////////////////////////////
     void setColor(const Color& color);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum width of the rows
+    ///
+    /// When a row would become wider than \a width, it is wrapped
+    /// after its last whitespace (or before the overflowing
+    /// character if it contains a single word), and the text
+    /// continues on the next row. A width of 0 disables the
+    /// wrapping, only line breaks start new rows.
+    /// The maximum width is 0 by default.
+    ///
+    /// \param width New maximum width of the rows, in pixels
+    ///
+    /// \see getMaxWidth, setAlignment
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMaxWidth(float width);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the horizontal alignment of the rows
+    ///
+    /// Rows are aligned within the maximum width if there's
+    /// one, or else within the widest row.
+    /// The alignment is sf::Text::Left by default.
+    ///
+    /// \param alignment New alignment of the rows
+    ///
+    /// \see getAlignment, setMaxWidth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAlignment(Alignment alignment);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the text's string
     ///
@@ -233,6 +309,26 @@ public:
     ////////////////////////////////////////////////////////////
     const Color& getColor() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum width of the rows
+    ///
+    /// \return Maximum width of the rows, 0 if the text is not wrapped
+    ///
+    /// \see setMaxWidth
+    ///
+    ////////////////////////////////////////////////////////////
+    float getMaxWidth() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the horizontal alignment of the rows
+    ///
+    /// \return Alignment of the rows
+    ///
+    /// \see setAlignment
+    ///
+    ////////////////////////////////////////////////////////////
+    Alignment getAlignment() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the position of the \a index-th character
     ///
@@ -242,6 +338,8 @@ public:
     /// origin are applied).
     /// If \a index is out of range, the position of the end of
     /// the string is returned.
+    /// The positions are computed along with the geometry, so
+    /// this function doesn't depend on the length of the string.
     ///
     /// \param index Index of the character
     ///
@@ -250,6 +348,36 @@ public:
     ////////////////////////////////////////////////////////////
     Vector2f findCharacterPos(std::size_t index) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of rows of the text
+    ///
+    /// Rows are started by line breaks and, if a maximum width
+    /// is set, by wrapping. A text ending with a line break has
+    /// an empty last row.
+    ///
+    /// \return Number of rows
+    ///
+    /// \see getLineBounds
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getLineCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounding rectangle of a row
+    ///
+    /// The returned rectangle is in local coordinates, like
+    /// the one returned by getLocalBounds.
+    /// If \a index is out of range, an empty rectangle is returned.
+    ///
+    /// \param index Index of the row
+    ///
+    /// \return Local bounding rectangle of the row
+    ///
+    /// \see getLineCount
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLineBounds(std::size_t index) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the local bounding rectangle of the entity
     ///
@@ -278,8 +406,42 @@ public:
     ////////////////////////////////////////////////////////////
     FloatRect getGlobalBounds() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the geometry of several texts in parallel
+    ///
+    /// The geometry of a text is normally rebuilt on the
+    /// rendering thread when the text is drawn or measured.
+    /// When many texts change at once (a new language, a
+    /// resized user interface), calling this function before
+    /// drawing them spreads their layout over the threads
+    /// of \a pool.
+    ///
+    /// The glyphs that the texts need are loaded first, on
+    /// the calling thread, since this updates the textures
+    /// of the fonts; the layouts then only read the fonts.
+    /// Texts that are up to date are skipped.
+    ///
+    /// The texts must not be used by other threads during the
+    /// call, and each one must appear only once in the array.
+    ///
+    /// \param texts Array of pointers to the texts to update (NULL entries are ignored)
+    /// \param count Number of texts in the array
+    /// \param pool  Thread pool running the layouts
+    ///
+    ////////////////////////////////////////////////////////////
+    static void updateGeometry(const Text* const* texts, std::size_t count, ThreadPool& pool = ThreadPool::getDefault());
+
 private:
 
+    friend class CacheLayer;
+    friend class TextCache;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Functor laying out one text of an array, run by the thread pool
+    ///
+    ////////////////////////////////////////////////////////////
+    struct GeometryBuilder;
+
     ////////////////////////////////////////////////////////////
     /// \brief Draw the text to a render target
     ///
@@ -298,17 +460,133 @@ private:
     ////////////////////////////////////////////////////////////
     void ensureGeometryUpdate() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the geometry must be updated, and prepare it
+    ///
+    /// This uploads the glyphs that the font loaded in the
+    /// background and clears the geometry if it must be
+    /// rebuilt entirely. What remains to do is laying out the
+    /// characters with layoutLines and updateDecorations,
+    /// which only read the font.
+    ///
+    /// \return True if the characters must be laid out
+    ///
+    ////////////////////////////////////////////////////////////
+    bool beginGeometryUpdate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the rows that are inside a view
+    ///
+    /// \param view      View to test the rows against
+    /// \param transform Transform from the text to the view's coordinates
+    /// \param first     Receives the index of the first visible row
+    /// \param last      Receives the index after the last visible row
+    ///
+    ////////////////////////////////////////////////////////////
+    void findVisibleLines(const View& view, const Transform& transform, std::size_t& first, std::size_t& last) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Lay out the characters that were added since the last update
+    ///
+    /// The last row is rebuilt from its first character, the
+    /// previous rows remain untouched.
+    ///
+    ////////////////////////////////////////////////////////////
+    void layoutLines() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rebuild the underline and strike through lines and the bounds
+    ///
+    /// The lines are stored after the glyph quads, so that they
+    /// can be changed without touching the glyphs.
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateDecorations() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a horizontal line to the geometry
+    ///
+    /// \param left      Left of the line
+    /// \param width     Length of the line
+    /// \param offset    Vertical position of the center of the line
+    /// \param thickness Thickness of the line
+    /// \param texCoords Texture coordinates of a white pixel
+    ///
+    ////////////////////////////////////////////////////////////
+    void addLine(float left, float width, float offset, float thickness, const Vector2f& texCoords) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the next vertices use a texture
+    ///
+    /// \param texture Texture of the next vertices, NULL for
+    ///                the font's texture of the character size
+    ///
+    ////////////////////////////////////////////////////////////
+    void addTextureRange(const Texture* texture) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove the texture ranges of vertices that were removed
+    ///
+    /// \param vertexCount Number of vertices that are kept
+    ///
+    ////////////////////////////////////////////////////////////
+    void removeTextureRanges(std::size_t vertexCount) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw a range of the vertices, with the texture of each part
+    ///
+    /// \param target Render target to draw to
+    /// \param states Render states, without the texture
+    /// \param begin  Index of the first vertex to draw
+    /// \param end    Index after the last vertex to draw
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawVertices(RenderTarget& target, RenderStates states, std::size_t begin, std::size_t end) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Layout of a row of the text
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Line
+    {
+        std::size_t firstCharacter; ///< Index of the first character of the row
+        std::size_t characterCount; ///< Number of characters of the row, including its line break
+        std::size_t firstVertex;    ///< Index of the first vertex of the row's glyphs
+        std::size_t vertexCount;    ///< Number of vertices of the row's glyphs
+        float       left;           ///< Horizontal position of the row, after alignment
+        float       width;          ///< Width of the row, without the whitespace it was wrapped at
+        FloatRect   bounds;         ///< Bounding rectangle of the row
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Vertices drawn with the same texture
+    ///
+    ////////////////////////////////////////////////////////////
+    struct TextureRange
+    {
+        std::size_t    firstVertex; ///< Index of the first vertex using the texture
+        const Texture* texture;     ///< Texture of the vertices, NULL for the font's texture of the character size
+    };
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    String              m_string;             ///< String to display
-    const Font*         m_font;               ///< Font used to display the string
-    unsigned int        m_characterSize;      ///< Base size of characters, in pixels
-    Uint32              m_style;              ///< Text style (see Style enum)
-    Color               m_color;              ///< Text color
-    mutable VertexArray m_vertices;           ///< Vertex array containing the text's geometry
-    mutable FloatRect   m_bounds;             ///< Bounding rectangle of the text (in local coordinates)
-    mutable bool        m_geometryNeedUpdate; ///< Does the geometry need to be recomputed?
+    String                            m_string;             ///< String to display
+    const Font*                       m_font;               ///< Font used to display the string
+    unsigned int                      m_characterSize;      ///< Base size of characters, in pixels
+    Uint32                            m_style;              ///< Text style (see Style enum)
+    Color                             m_color;              ///< Text color
+    float                             m_maxWidth;           ///< Maximum width of the rows, 0 for no wrapping
+    Alignment                         m_alignment;          ///< Horizontal alignment of the rows
+    mutable VertexArray               m_vertices;           ///< Vertex array containing the text's geometry
+    mutable FloatRect                 m_bounds;             ///< Bounding rectangle of the text (in local coordinates)
+    mutable bool                      m_geometryNeedUpdate; ///< Does the geometry need to be recomputed?
+    mutable Uint64                    m_fontRevision;       ///< Revision of the font when the geometry was computed
+    mutable std::vector<Line>         m_lines;              ///< Layout of the rows
+    mutable std::vector<Vector2f>     m_characterPositions; ///< Position of every character, and of the end of the string
+    mutable std::vector<TextureRange> m_textureRanges;      ///< Texture of each range of vertices, sorted by vertex
+    mutable std::size_t               m_glyphVertexCount;   ///< Number of vertices of the glyphs, the lines follow
+    Uint32                            m_revision;           ///< Number of changes of the properties, used by sf::CacheLayer and sf::TextCache to detect them
 };
 
 } // namespace sf
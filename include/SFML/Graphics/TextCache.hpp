@@ -0,0 +1,280 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TEXTCACHE_HPP
+#define SFML_TEXTCACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class RenderTarget;
+class Text;
+
+////////////////////////////////////////////////////////////
+/// \brief Draw texts from snapshots rendered once into
+///        shared textures
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextCache : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an empty cache
+    ///
+    /// The pages are created when the first snapshots are
+    /// rendered; their size is reduced if the graphics card
+    /// doesn't support it.
+    ///
+    /// \param pageSize Size of the page textures, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit TextCache(const Vector2u& pageSize = Vector2u(1024, 1024));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextCache();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw a text from its snapshot
+    ///
+    /// The text is rendered into a page of the cache the first
+    /// time it is drawn, and again only when one of its properties
+    /// changes; it is then drawn as a single textured quad, with
+    /// the texture of the page. Consecutive texts of the same
+    /// page are batched with each other, if batching is enabled
+    /// on the target.
+    ///
+    /// Texts which are bigger than a page are drawn directly.
+    ///
+    /// \param target Render target to draw to
+    /// \param text   Text to draw
+    /// \param states Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(RenderTarget& target, const Text& text, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the snapshot of a text
+    ///
+    /// This function must be called before a text drawn
+    /// through the cache is destroyed. It does nothing if
+    /// the cache has no snapshot of \a text.
+    ///
+    /// \param text Text to remove
+    ///
+    /// \see clear
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(const Text& text);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the snapshots and free the pages
+    ///
+    /// The space of the snapshots that are removed, or that
+    /// grow and move to another place, is only reclaimed by
+    /// this function.
+    ///
+    /// \see remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of texts that have a snapshot
+    ///
+    /// \return Number of snapshots
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSnapshotCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of pages of the cache
+    ///
+    /// \return Number of page textures
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getPageCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture of a page
+    ///
+    /// \param page Index of the page, in [0, getPageCount() - 1]
+    ///
+    /// \return Texture of the page
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture(unsigned int page) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Row of snapshots of similar heights
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Shelf
+    {
+        Shelf(unsigned int shelfTop, unsigned int shelfHeight) : top(shelfTop), height(shelfHeight), width(0) {}
+
+        unsigned int top;    ///< Top of the shelf in the page
+        unsigned int height; ///< Height of the shelf
+        unsigned int width;  ///< Used width, from the left of the page
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Page texture and its shelves
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Page
+    {
+        RenderTexture      texture; ///< Texture containing the snapshots
+        std::vector<Shelf> shelves; ///< Shelves of the page, from top to bottom
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Snapshot of a text
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Snapshot
+    {
+        unsigned int page;         ///< Page containing the snapshot
+        IntRect      region;       ///< Area reserved for the snapshot in the page
+        IntRect      bounds;       ///< Pixels of the text covered by the snapshot, in local coordinates
+        Uint32       revision;     ///< Revision of the text when it was rendered
+        Uint64       fontRevision; ///< Revision of the font when the text was rendered
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the up-to-date snapshot of a text, rendering it if needed
+    ///
+    /// \param target Target that the snapshot will be drawn to
+    /// \param text   Text to get the snapshot of
+    ///
+    /// \return Pointer to the snapshot, or NULL if the text can't have one
+    ///
+    ////////////////////////////////////////////////////////////
+    const Snapshot* getSnapshot(RenderTarget& target, const Text& text);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve an area in a page
+    ///
+    /// \param width  Width of the area
+    /// \param height Height of the area
+    /// \param page   Filled with the index of the page
+    /// \param region Filled with the area in the page
+    ///
+    /// \return True if the area was reserved
+    ///
+    ////////////////////////////////////////////////////////////
+    bool allocate(unsigned int width, unsigned int height, unsigned int& page, IntRect& region);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find room in a page
+    ///
+    /// \param page   Page to search
+    /// \param width  Width of the area
+    /// \param height Height of the area
+    /// \param region Filled with the area in the page
+    ///
+    /// \return True if the page had room for the area
+    ///
+    ////////////////////////////////////////////////////////////
+    bool allocate(Page& page, unsigned int width, unsigned int height, IntRect& region);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    typedef std::map<const Text*, Snapshot> SnapshotTable;
+
+    std::vector<Page*> m_pages;     ///< Pages of the cache, allocated separately so that their textures never move
+    Vector2u           m_pageSize;  ///< Size of the page textures
+    SnapshotTable      m_snapshots; ///< Snapshot of each text drawn through the cache
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTCACHE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextCache
+/// \ingroup graphics
+///
+/// The geometry of a sf::Text is made of two triangles per
+/// character, which all have to be transformed and sent to the
+/// graphics card every frame. For interfaces that display many
+/// labels which rarely change, such as names or scores,
+/// sf::TextCache renders each text once into a region of a
+/// shared page texture, and then draws it as a single quad until
+/// one of its properties changes. The labels of a page share
+/// the same texture, so they are batched together when batching
+/// is enabled on the render target.
+///
+/// Changes of the string, font, character size, style, color or
+/// layout of a text are detected automatically, as well as the
+/// glyphs that its font loads in the background; the transform
+/// of the text is applied when the quad is drawn and never
+/// requires a new snapshot. Snapshots are rendered at the
+/// resolution of the local coordinates of the text, so they look
+/// the same as the text only when it is not scaled.
+///
+/// The cache identifies the texts by their address: remove()
+/// must be called before a text is destroyed. When a snapshot
+/// grows beyond its region, it moves to a new one and the old
+/// region is lost until clear() is called.
+///
+/// Usage example:
+/// \code
+/// sf::TextCache cache;
+/// window.setBatchingEnabled(true);
+///
+/// std::vector<sf::Text> labels = ...;
+/// while (window.isOpen())
+/// {
+///     ...
+///     window.clear();
+///     for (std::size_t i = 0; i < labels.size(); ++i)
+///         cache.draw(window, labels[i]);
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::Text, sf::CacheLayer
+///
+////////////////////////////////////////////////////////////
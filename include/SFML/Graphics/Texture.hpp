@@ -29,12 +29,16 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/GpuMemory.hpp>
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageView.hpp>
 #include <SFML/Window/GlResource.hpp>
 
 
 namespace sf
 {
+class TextureManager;
+class TextureUpload;
 class Window;
 class RenderTarget;
 class RenderTexture;
@@ -58,6 +62,34 @@ public:
         Pixels      ///< Texture coordinates in range [0 .. size]
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Block compression formats of pre-compressed textures
+    ///
+    ////////////////////////////////////////////////////////////
+    enum CompressedFormat
+    {
+        Dxt1,     ///< S3TC / BC1: RGB with 1-bit alpha, 4 bits per pixel
+        Dxt3,     ///< S3TC / BC2: RGBA with explicit alpha, 8 bits per pixel
+        Dxt5,     ///< S3TC / BC3: RGBA with interpolated alpha, 8 bits per pixel
+        Etc2Rgb,  ///< ETC2 RGB (also loads ETC1), 4 bits per pixel
+        Etc2Rgba, ///< ETC2 RGBA with EAC alpha, 8 bits per pixel
+        Astc4x4,  ///< ASTC with 4x4 blocks, 8 bits per pixel
+        Astc6x6,  ///< ASTC with 6x6 blocks, 3.56 bits per pixel
+        Astc8x8   ///< ASTC with 8x8 blocks, 2 bits per pixel
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Formats in which a texture stores its pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Format
+    {
+        Rgba8,   ///< 8-bit RGBA, 4 bytes per pixel (default)
+        R8,      ///< 8-bit single red channel, 1 byte per pixel
+        Rgba16f, ///< 16-bit floating point RGBA, 8 bytes per pixel
+        Rgba32f  ///< 32-bit floating point RGBA, 16 bytes per pixel
+    };
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -71,8 +103,15 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Copy constructor
     ///
+    /// Copying a texture reads its pixels back from the graphics
+    /// card and uploads them to a new texture, which is slow.
+    /// Use swap to move a texture, or sf::SharedTexture to share
+    /// it without copying.
+    ///
     /// \param copy instance to copy
     ///
+    /// \see swap
+    ///
     ////////////////////////////////////////////////////////////
     Texture(const Texture& copy);
 
@@ -87,13 +126,47 @@ public:
     ///
     /// If this function fails, the texture is left unchanged.
     ///
+    /// The format defines how the pixels are stored by the
+    /// graphics card. Pixels are always given to and read back
+    /// from the texture as 8-bit RGBA: single-channel textures
+    /// only keep the red component, and floating point textures
+    /// convert it to the [0 .. 1] range. Floating point and
+    /// single-channel textures are mostly useful as targets of
+    /// a sf::RenderTexture, see isFormatSupported.
+    ///
     /// \param width  Width of the texture
     /// \param height Height of the texture
+    /// \param format Format of the pixels
     ///
     /// \return True if creation was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool create(unsigned int width, unsigned int height);
+    bool create(unsigned int width, unsigned int height, Format format = Rgba8);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the size of the texture, keeping its pixels
+    ///
+    /// The existing pixels keep their position relative to the
+    /// top-left corner; the ones that don't fit in the new size
+    /// are lost, and the new area is filled with \a fill. If
+    /// framebuffer objects are supported, the pixels are copied
+    /// on the graphics card, without reading them back, which
+    /// makes this function much faster than a round-trip through
+    /// copyToImage and loadFromImage.
+    ///
+    /// If the texture is empty, this is equivalent to create.
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param width  New width of the texture
+    /// \param height New height of the texture
+    /// \param fill   Color of the pixels outside the previous area
+    ///
+    /// \return True if resizing was successful
+    ///
+    /// \see create
+    ///
+    ////////////////////////////////////////////////////////////
+    bool resize(unsigned int width, unsigned int height, const Color& fill = Color(0, 0, 0, 0));
 
     ////////////////////////////////////////////////////////////
     /// \brief Load the texture from a file on disk
@@ -213,6 +286,84 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromImage(const Image& image, const IntRect& area = IntRect());
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a view of an image
+    ///
+    /// The pixels are read in place, even when the view is only
+    /// a part of a larger image.
+    ///
+    /// The maximum size for a texture depends on the graphics
+    /// driver and can be retrieved with the getMaximumSize function.
+    ///
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param view View of the pixels to load into the texture
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromFile, loadFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromImage(const ImageView& view);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a pre-compressed texture from a file on disk
+    ///
+    /// The file must be a KTX or DDS container. Its compressed
+    /// blocks are uploaded as they are, without being decoded,
+    /// so the texture uses the memory saved by its compression
+    /// format on the graphics card too. Only the first mipmap
+    /// level and 2D textures are supported.
+    ///
+    /// The format must be supported by the graphics card, see
+    /// isCompressedFormatSupported. Compressed textures can't
+    /// be updated nor resized, and their size must be a power
+    /// of two if the graphics card requires it.
+    ///
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param filename Path of the KTX or DDS file to load
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromCompressedMemory, loadFromCompressedStream, isCompressedFormatSupported
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromCompressedFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a pre-compressed texture from a file in memory
+    ///
+    /// See loadFromCompressedFile for the supported files.
+    ///
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param data Pointer to the file data in memory
+    /// \param size Size of the data to load, in bytes
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromCompressedFile, loadFromCompressedStream, isCompressedFormatSupported
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromCompressedMemory(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a pre-compressed texture from a custom stream
+    ///
+    /// See loadFromCompressedFile for the supported files.
+    ///
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param stream Source stream to read from
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromCompressedFile, loadFromCompressedMemory, isCompressedFormatSupported
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromCompressedStream(InputStream& stream);
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the texture
     ///
@@ -221,6 +372,15 @@ public:
     ////////////////////////////////////////////////////////////
     Vector2u getSize() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the format of the pixels of the texture
+    ///
+    /// \return Format passed to create, Rgba8 for textures loaded
+    ///         from images
+    ///
+    ////////////////////////////////////////////////////////////
+    Format getFormat() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Copy the texture pixels to an image
     ///
@@ -228,6 +388,8 @@ public:
     /// the texture's pixels from the graphics card and copies
     /// them to a new image, potentially applying transformations
     /// to pixels if necessary (texture may be padded or flipped).
+    /// Single-channel textures are read as gray opaque pixels,
+    /// floating point textures are clamped to [0 .. 1].
     ///
     /// \return Image containing the texture's pixels
     ///
@@ -276,6 +438,35 @@ public:
     ////////////////////////////////////////////////////////////
     void update(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the texture from an array of pixels in another format
+    ///
+    /// The size of the \a pixel array must match the \a width and
+    /// \a height arguments, with tightly packed rows in the
+    /// given \a format.
+    ///
+    /// BGRA pixels are given as they are to OpenGL, which
+    /// swizzles them during the transfer; the other formats are
+    /// converted to RGBA first (see sf::Image::create). On
+    /// OpenGL ES, BGRA pixels are converted too.
+    ///
+    /// No additional check is performed on the size of the pixel
+    /// array or the bounds of the area to update, passing invalid
+    /// arguments will lead to an undefined behavior.
+    ///
+    /// This function does nothing if \a pixels is null or if the
+    /// texture was not previously created.
+    ///
+    /// \param pixels Array of pixels to copy to the texture
+    /// \param width  Width of the pixel region contained in \a pixels
+    /// \param height Height of the pixel region contained in \a pixels
+    /// \param x      X offset in the texture where to copy the source pixels
+    /// \param y      Y offset in the texture where to copy the source pixels
+    /// \param format Format of the pixels in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y, Image::PixelFormat format);
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the texture from an image
     ///
@@ -313,6 +504,26 @@ public:
     ////////////////////////////////////////////////////////////
     void update(const Image& image, unsigned int x, unsigned int y);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the texture from a view of an image
+    ///
+    /// The pixels are read in place, even when the view is only
+    /// a part of a larger image.
+    ///
+    /// No additional check is performed on the size of the view,
+    /// passing an invalid combination of view size and offset
+    /// will lead to an undefined behavior.
+    ///
+    /// This function does nothing if the view is empty or if
+    /// the texture was not previously created.
+    ///
+    /// \param view View of the pixels to copy to the texture
+    /// \param x    X offset in the texture where to copy the source pixels
+    /// \param y    Y offset in the texture where to copy the source pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const ImageView& view, unsigned int x, unsigned int y);
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the texture from the contents of a window
     ///
@@ -350,6 +561,34 @@ public:
     ////////////////////////////////////////////////////////////
     void update(const Window& window, unsigned int x, unsigned int y);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the texture from staged pixels, without blocking
+    ///
+    /// The pixels of \a upload are copied to the texture by the
+    /// graphics card, this function returns immediately and the
+    /// upload can be used to know when the transfer is over.
+    /// It is unlocked first if needed. The copy is ordered
+    /// before the following draw calls, there's no need to wait
+    /// for its completion before drawing with the texture.
+    ///
+    /// If asynchronous uploads are not supported, the copy is
+    /// done synchronously like with the other update functions.
+    ///
+    /// No additional check is performed on the size of the pixel area,
+    /// passing invalid arguments will lead to an undefined behavior.
+    ///
+    /// This function does nothing if the upload is empty or if
+    /// the texture was not previously created.
+    ///
+    /// \param upload Staged pixels to copy to the texture
+    /// \param x      X offset in the texture where to copy the source pixels
+    /// \param y      Y offset in the texture where to copy the source pixels
+    ///
+    /// \see TextureUpload::isComplete
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateAsync(TextureUpload& upload, unsigned int x, unsigned int y);
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable the smooth filter
     ///
@@ -376,6 +615,36 @@ public:
     ////////////////////////////////////////////////////////////
     bool isSmooth() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the colors of the texture as multiplied by their alpha, or not
+    ///
+    /// Premultiplied textures are drawn with
+    /// sf::BlendPremultipliedAlpha where sf::BlendAlpha is
+    /// requested, which makes the smooth filter blend transparent
+    /// pixels without dark fringes. The pixels are not converted,
+    /// this only tells how to draw them.
+    ///
+    /// The flag is reset when the texture is created, and taken
+    /// from the image in loadFromImage (see sf::Image::premultiplyAlpha).
+    /// It is not premultiplied by default.
+    ///
+    /// \param premultiplied True if the colors are multiplied by alpha
+    ///
+    /// \see isPremultiplied
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPremultiplied(bool premultiplied);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the colors of the texture are multiplied by their alpha
+    ///
+    /// \return True if the texture is premultiplied
+    ///
+    /// \see setPremultiplied
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isPremultiplied() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable repeating
     ///
@@ -391,6 +660,11 @@ public:
     /// when the texture is repeated. With such cards, repeat mode
     /// can be used reliably only if the texture has power-of-two
     /// dimensions (such as 256x128).
+    /// Graphics cards that support non power of two sizes only
+    /// without repeat (OpenGL ES 2) store the texture with its
+    /// exact size until repeat mode is enabled; the texture is
+    /// then moved to a texture padded to a power of two, so it
+    /// is cheaper to enable repeat mode before loading it.
     /// Repeating is disabled by default.
     ///
     /// \param repeated True to repeat the texture, false to disable repeating
@@ -410,6 +684,65 @@ public:
     ////////////////////////////////////////////////////////////
     bool isRepeated() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Generate a mipmap using the current texture data
+    ///
+    /// Mipmaps are pre-computed chains of optimized textures. Each
+    /// level of texture in a mipmap is generated by halving each of
+    /// the previous level's dimensions. This is done until the final
+    /// level has the size of 1x1. The textures generated in this
+    /// process may make use of more advanced filters which might
+    /// improve the visual quality of textures when they are applied
+    /// to objects much smaller than they are. This is known as
+    /// minification. Because fewer texels (texture elements) have
+    /// to be sampled from when heavily minified, usage of mipmaps
+    /// can also improve rendering performance in certain scenarios.
+    ///
+    /// Mipmap generation relies on the necessary OpenGL extension
+    /// being available. If it is unavailable or generation fails
+    /// due to another reason, this function will return false.
+    /// Mipmap data is only valid from the time it is generated
+    /// until the next time the base level image is modified, at
+    /// which point this function will have to be called again to
+    /// regenerate it. Compressed textures don't support mipmap
+    /// generation, nor do non power of two textures on graphics
+    /// cards that support such sizes only without repeat.
+    ///
+    /// While a mipmap is valid, the smooth filter blends the two
+    /// closest levels (trilinear filtering), and the nearest
+    /// filter picks the closest level.
+    ///
+    /// \return True if mipmap generation was successful, false if unsuccessful
+    ///
+    /// \see setSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    bool generateMipmap();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the name of the texture in the video memory statistics
+    ///
+    /// The name identifies the texture in the list returned by
+    /// sf::GpuMemory::getResources. Textures loaded from a file
+    /// are named after the file, unless they already have a name.
+    ///
+    /// \param name New name of the texture
+    ///
+    /// \see getDebugName
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDebugName(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the name of the texture in the video memory statistics
+    ///
+    /// \return Name of the texture, empty if none
+    ///
+    /// \see setDebugName
+    ///
+    ////////////////////////////////////////////////////////////
+    std::string getDebugName() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -420,6 +753,21 @@ public:
     ////////////////////////////////////////////////////////////
     Texture& operator =(const Texture& right);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this texture with those of another
+    ///
+    /// Only the OpenGL handles and the settings of the textures
+    /// are exchanged, nothing is copied on the graphics card.
+    /// This is the cheap way to move a texture, for example
+    /// out of a temporary. The textures managed by an
+    /// sf::TextureManager stay managed, the manager follows
+    /// their content.
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(Texture& right);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the underlying OpenGL handle of the texture.
     ///
@@ -459,6 +807,11 @@ public:
     /// coordinates more intuitive for the high-level API, users don't need
     /// to compute normalized values.
     ///
+    /// The texture matrix is cached for each context, and only
+    /// loaded when it changes. If you modify it with your own
+    /// OpenGL calls, restore it (or call resetGLStates() on the
+    /// render target) before binding a texture again.
+    ///
     /// \param texture Pointer to the texture to bind, can be null to use no texture
     /// \param coordinateType Type of texture coordinates to use
     ///
@@ -480,36 +833,130 @@ public:
     ////////////////////////////////////////////////////////////
     static unsigned int getMaximumSize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a compression format is supported
+    ///
+    /// The supported formats depend on the graphics card: DXT is
+    /// common on desktop, ETC2 and ASTC on mobile devices.
+    ///
+    /// \param format Compression format to check
+    ///
+    /// \return True if textures in this format can be loaded
+    ///
+    /// \see loadFromCompressedFile
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isCompressedFormatSupported(CompressedFormat format);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a format is supported
+    ///
+    /// Rgba8 is always supported, R8 requires OpenGL 3.0 or
+    /// ARB_texture_rg, and the floating point formats require
+    /// OpenGL 3.0 or ARB_texture_float.
+    ///
+    /// \param format Format to check
+    ///
+    /// \return True if textures can be created in this format
+    ///
+    /// \see create
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isFormatSupported(Format format);
+
 private:
 
     friend class RenderTexture;
     friend class RenderTarget;
+    friend class Shader;
+    friend class RenderQueue;
+    friend class ReadbackQueue;
+    friend class TextureManager;
+    friend class TextureAtlas;
+    friend class VideoTexture;
 
     ////////////////////////////////////////////////////////////
     /// \brief Get a valid image size according to hardware support
     ///
     /// This function checks whether the graphics driver supports
     /// non power of two sizes or not, and adjusts the size
-    /// accordingly.
+    /// accordingly. Some drivers support them only for textures
+    /// that are not repeated and have no mipmap.
     /// The returned size is greater than or equal to the original size.
     ///
-    /// \param size size to convert
+    /// \param size     size to convert
+    /// \param repeated Must the texture support repeat mode and mipmaps?
     ///
     /// \return Valid nearest size (greater than or equal to specified size)
     ///
     ////////////////////////////////////////////////////////////
-    static unsigned int getValidSize(unsigned int size);
+    static unsigned int getValidSize(unsigned int size, bool repeated);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Invalidate the mipmap if one exists
+    ///
+    /// This also resets the texture's minifying function.
+    /// This function is mainly for internal use by RenderTexture.
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateMipmap();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the texture matrix cached for the active context
+    ///
+    /// Must be called when the texture matrix may have been
+    /// changed outside of bind(), so that the next call loads
+    /// it again. This function is for internal use by RenderTarget.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void invalidateTextureMatrix();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload pre-compressed blocks to the texture
+    ///
+    /// \param format Compression format of the blocks
+    /// \param width  Width of the texture
+    /// \param height Height of the texture
+    /// \param blocks Pointer to the compressed blocks
+    /// \param size   Size of the compressed blocks, in bytes
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadCompressed(CompressedFormat format, unsigned int width, unsigned int height, const void* blocks, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Notify the texture manager that the texture is used
+    ///
+    /// If the texture was evicted by its manager, it is loaded
+    /// again. This function is for internal use by RenderTarget.
+    ///
+    ////////////////////////////////////////////////////////////
+    void use() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the OpenGL texture, keeping its settings
+    ///
+    /// This function is for internal use by TextureManager.
+    ///
+    ////////////////////////////////////////////////////////////
+    void evict();
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Vector2u     m_size;          ///< Public texture size
-    Vector2u     m_actualSize;    ///< Actual texture size (can be greater than public size because of padding)
-    unsigned int m_texture;       ///< Internal texture identifier
-    bool         m_isSmooth;      ///< Status of the smooth filter
-    bool         m_isRepeated;    ///< Is the texture in repeat mode?
-    mutable bool m_pixelsFlipped; ///< To work around the inconsistency in Y orientation
-    Uint64       m_cacheId;       ///< Unique number that identifies the texture to the render target's cache
+    Vector2u           m_size;          ///< Public texture size
+    Vector2u           m_actualSize;    ///< Actual texture size (can be greater than public size because of padding)
+    unsigned int       m_texture;       ///< Internal texture identifier
+    Format             m_format;        ///< Format of the pixels
+    bool               m_isSmooth;      ///< Status of the smooth filter
+    bool               m_isRepeated;    ///< Is the texture in repeat mode?
+    bool               m_hasMipmap;     ///< Has the mipmap been generated?
+    bool               m_premultiplied; ///< Are the colors multiplied by alpha?
+    mutable bool       m_pixelsFlipped; ///< To work around the inconsistency in Y orientation
+    Uint64             m_cacheId;       ///< Unique number that identifies the texture to the render target's cache
+    TextureManager*    m_manager;       ///< Manager that can evict the texture, if any
+    GpuMemory::Counter m_gpuMemory;     ///< Reports the estimated video memory of the texture
 };
 
 } // namespace sf
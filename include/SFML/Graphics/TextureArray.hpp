@@ -0,0 +1,291 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TEXTUREARRAY_HPP
+#define SFML_TEXTUREARRAY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Array of 2D textures of the same size, which can
+///        all be drawn in a single batch
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureArray : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty texture array.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureArray();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureArray();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the texture array
+    ///
+    /// The layers are created with undefined pixels, fill
+    /// them with update(). If this function fails, the
+    /// texture array is left unchanged.
+    ///
+    /// \param width      Width of every layer
+    /// \param height     Height of every layer
+    /// \param layerCount Number of layers
+    ///
+    /// \return True if creation was successful
+    ///
+    /// \see getMaximumLayerCount
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, unsigned int layerCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a whole layer from an array of pixels
+    ///
+    /// The \a pixels array is assumed to have the size of
+    /// a layer, and to contain 32-bits RGBA pixels.
+    ///
+    /// \param pixels Array of pixels to copy to the layer
+    /// \param layer  Index of the layer to update
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const Uint8* pixels, unsigned int layer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of a layer from an array of pixels
+    ///
+    /// The size of the \a pixels array must match the \a width
+    /// and \a height arguments, and it must contain 32-bits
+    /// RGBA pixels. The area must fit in the layer.
+    ///
+    /// \param pixels Array of pixels to copy to the layer
+    /// \param width  Width of the pixel region contained in \a pixels
+    /// \param height Height of the pixel region contained in \a pixels
+    /// \param x      X offset in the layer where to copy the source pixels
+    /// \param y      Y offset in the layer where to copy the source pixels
+    /// \param layer  Index of the layer to update
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y, unsigned int layer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a layer from an image
+    ///
+    /// The image is copied to the top-left corner of the
+    /// layer, it must not be larger than the layer.
+    ///
+    /// \param image Image to copy to the layer
+    /// \param layer Index of the layer to update
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const Image& image, unsigned int layer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the layers
+    ///
+    /// \return Size in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the number of layers
+    ///
+    /// \return Number of layers
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getLayerCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter
+    ///
+    /// Filtering never blends pixels of different layers.
+    /// The smooth filter is disabled by default.
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    /// \see isSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the smooth filter is enabled or not
+    ///
+    /// \return True if smoothing is enabled, false if it is disabled
+    ///
+    /// \see setSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSmooth() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the offset that selects a layer in texture coordinates
+    ///
+    /// The layer of a vertex is carried by its texture
+    /// coordinates: add this offset to coordinates given in
+    /// pixels of the layer. The layers are stacked vertically
+    /// with a gap of one layer between them, so that the
+    /// interpolated coordinates of a primitive never reach a
+    /// neighbour layer.
+    ///
+    /// \param layer Index of the layer
+    ///
+    /// \return Offset to add to the texture coordinates of the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2f getLayerOffset(unsigned int layer) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shader that draws from the texture array
+    ///
+    /// The shader samples the layer selected by the texture
+    /// coordinates of each vertex (see getLayerOffset) and
+    /// modulates it by the vertex color. Use it with no
+    /// texture in the render states, so that the texture
+    /// coordinates reach it unchanged.
+    ///
+    /// \return Shader to put in the render states
+    ///
+    ////////////////////////////////////////////////////////////
+    const Shader& getShader() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the underlying OpenGL handle of the texture array
+    ///
+    /// You shouldn't need to use this function, unless you have
+    /// very specific stuff to implement that SFML doesn't support,
+    /// or implement a temporary workaround until a bug is fixed.
+    ///
+    /// \return OpenGL handle of the texture array, or 0 if not yet created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getNativeHandle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the system supports texture arrays
+    ///
+    /// Texture arrays are drawn with a shader, they also
+    /// require shaders to be available.
+    ///
+    /// \return True if texture arrays are supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of layers of a texture array
+    ///
+    /// OpenGL 3 guarantees at least 256 layers.
+    ///
+    /// \return Maximum number of layers allowed, 0 if texture
+    ///         arrays are not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumLayerCount();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int m_texture;    ///< Internal texture identifier
+    Vector2u     m_size;       ///< Size of every layer
+    unsigned int m_layerCount; ///< Number of layers
+    bool         m_isSmooth;   ///< Status of the smooth filter
+    Shader       m_shader;     ///< Shader sampling the layer selected by the vertices
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREARRAY_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureArray
+/// \ingroup graphics
+///
+/// sf::TextureArray holds several textures of the same size,
+/// called layers, in a single OpenGL object. Since the layer
+/// is chosen per vertex rather than per draw call, sprites
+/// from many different sheets can be put in the same vertex
+/// array and drawn at once, where separate sf::Texture
+/// objects would break the batch at every texture change.
+///
+/// The layer of a vertex is encoded in its texture
+/// coordinates, which keeps the sf::Vertex format unchanged:
+/// add getLayerOffset() to coordinates given in pixels of the
+/// layer, and draw with the shader returned by getShader()
+/// and no texture.
+///
+/// Texture arrays require OpenGL 3 or the EXT_texture_array
+/// extension, and shaders; check isAvailable() before using
+/// them.
+///
+/// Usage example:
+/// \code
+/// sf::TextureArray sheets;
+/// if (!sheets.create(512, 512, 3))
+///     return -1;
+///
+/// sheets.update(heroes, 0);
+/// sheets.update(monsters, 1);
+/// sheets.update(items, 2);
+///
+/// // Add a quad showing the area (16, 32, 32, 32) of the monsters sheet
+/// sf::Vector2f offset = sheets.getLayerOffset(1);
+/// sf::VertexArray vertices(sf::Quads);
+/// vertices.append(sf::Vertex(sf::Vector2f(100, 100), sf::Vector2f(16, 32) + offset));
+/// vertices.append(sf::Vertex(sf::Vector2f(132, 100), sf::Vector2f(48, 32) + offset));
+/// vertices.append(sf::Vertex(sf::Vector2f(132, 132), sf::Vector2f(48, 64) + offset));
+/// vertices.append(sf::Vertex(sf::Vector2f(100, 132), sf::Vector2f(16, 64) + offset));
+/// ...
+///
+/// // Draw the quads of all the sheets at once
+/// window.draw(vertices, &sheets.getShader());
+/// \endcode
+///
+/// \see sf::Texture, sf::Shader, sf::VertexArray
+///
+////////////////////////////////////////////////////////////
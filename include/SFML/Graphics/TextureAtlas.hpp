@@ -0,0 +1,275 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TEXTUREATLAS_HPP
+#define SFML_TEXTUREATLAS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+
+////////////////////////////////////////////////////////////
+/// \brief Pack many images into a few shared textures
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureAtlas : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Location of an image inside the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Region
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        Region();
+
+        const Texture* texture; ///< Page texture containing the image
+        unsigned int   page;    ///< Index of the page containing the image
+        IntRect        rect;    ///< Rectangle of the image in the page texture
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an empty atlas
+    ///
+    /// The pages are allocated on demand. Their size is clamped
+    /// to the maximum texture size supported by the graphics card,
+    /// and rounded up to a power of two if the graphics card would
+    /// pad the textures anyway, so that no memory is wasted.
+    ///
+    /// \param pageSize Size of the page textures, in pixels
+    /// \param padding  Empty space left around each image, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit TextureAtlas(const Vector2u& pageSize = Vector2u(1024, 1024), unsigned int padding = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureAtlas();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an image to the atlas
+    ///
+    /// The image is copied into the first page that has enough
+    /// space left for it. If none does, a new page is allocated;
+    /// the existing pages are never resized nor moved, so the
+    /// regions returned previously stay valid.
+    ///
+    /// \param image  Image to add
+    /// \param region Receives the location of the image
+    ///
+    /// \return True if the image was added, false if it is bigger
+    ///         than a page or if a page texture could not be created
+    ///
+    ////////////////////////////////////////////////////////////
+    bool add(const Image& image, Region& region);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the images and release the pages
+    ///
+    /// The textures returned by the previous calls to add and
+    /// getTexture are destroyed.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of allocated pages
+    ///
+    /// \return Number of pages
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getPageCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture of a page
+    ///
+    /// \param page Index of the page, must be lower than getPageCount()
+    ///
+    /// \return Texture of the page
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture(unsigned int page) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the pages
+    ///
+    /// \return Size of the page textures, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getPageSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter on all the pages
+    ///
+    /// This applies to the existing pages and to the ones
+    /// allocated later. The smooth filter is disabled by default.
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    /// \see isSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the smooth filter is enabled or not
+    ///
+    /// \return True if smoothing is enabled, false if it is disabled
+    ///
+    /// \see setSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSmooth() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Horizontal segment of the top outline of a page
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Segment
+    {
+        Segment(unsigned int segmentX, unsigned int segmentY, unsigned int segmentWidth) : x(segmentX), y(segmentY), width(segmentWidth) {}
+
+        unsigned int x;     ///< Left position of the segment
+        unsigned int y;     ///< Top of the used space below the segment
+        unsigned int width; ///< Width of the segment
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Page texture and its skyline
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Page
+    {
+        Texture              texture; ///< Texture containing the pixels of the images
+        std::vector<Segment> skyline; ///< Outline of the used space, sorted from left to right
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate a new empty page
+    ///
+    /// \return Pointer to the new page, or NULL on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    Page* createPage();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the best position for a rectangle in a page
+    ///
+    /// \param page   Page to search
+    /// \param width  Width of the rectangle
+    /// \param height Height of the rectangle
+    /// \param index  Receives the index of the skyline segment where the rectangle starts
+    /// \param top    Receives the top position of the rectangle
+    ///
+    /// \return True if the rectangle fits in the page
+    ///
+    ////////////////////////////////////////////////////////////
+    bool findPosition(const Page& page, unsigned int width, unsigned int height, std::size_t& index, unsigned int& top) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark a rectangle of a page as used
+    ///
+    /// \param page   Page to update
+    /// \param index  Index of the skyline segment where the rectangle starts
+    /// \param top    Top position of the rectangle
+    /// \param width  Width of the rectangle
+    /// \param height Height of the rectangle
+    ///
+    ////////////////////////////////////////////////////////////
+    void insert(Page& page, std::size_t index, unsigned int top, unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Page*> m_pages;    ///< Pages of the atlas, allocated separately so that their textures never move
+    Vector2u           m_pageSize; ///< Size of the page textures
+    unsigned int       m_padding;  ///< Empty space left around each image
+    bool               m_isSmooth; ///< Status of the smooth filter
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREATLAS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureAtlas
+/// \ingroup graphics
+///
+/// Every sf::Texture is a separate texture on the graphics card,
+/// and switching between them breaks the batching of draw calls.
+/// sf::TextureAtlas copies many small images into a few big
+/// textures, called pages, so that the sprites using them can
+/// be rendered together.
+///
+/// Images are packed as they are added, with a skyline
+/// bottom-left heuristic: each page keeps the outline of its
+/// used space, and a new image is placed where its bottom edge
+/// ends up the highest. When no page has room left, a new page
+/// is allocated instead of growing an existing one, so the
+/// texture and rectangle returned for an image never change.
+///
+/// A few pixels of padding are left around each image, so that
+/// texture filtering doesn't bleed the neighbouring images
+/// into each other.
+///
+/// Usage example:
+/// \code
+/// sf::TextureAtlas atlas;
+///
+/// sf::Image image;
+/// image.loadFromFile("hero.png");
+///
+/// sf::TextureAtlas::Region region;
+/// if (!atlas.add(image, region))
+///     return -1;
+///
+/// sf::Sprite sprite(*region.texture, region.rect);
+/// window.draw(sprite);
+/// \endcode
+///
+/// \see sf::Texture, sf::Sprite
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,166 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TEXTURECACHE_HPP
+#define SFML_TEXTURECACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Persistent cache of decoded textures on disk
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureCache : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a cache without directory, which loads the
+    /// textures directly.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureCache();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the cache with its directory
+    ///
+    /// \param directory Directory where the decoded textures are stored
+    ///
+    /// \see setDirectory
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit TextureCache(const std::string& directory);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the directory of the cache
+    ///
+    /// The directory must already exist, it is not created. An
+    /// empty string disables the cache.
+    ///
+    /// \param directory Directory where the decoded textures are stored
+    ///
+    /// \see getDirectory
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDirectory(const std::string& directory);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the directory of the cache
+    ///
+    /// \return Directory where the decoded textures are stored
+    ///
+    /// \see setDirectory
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::string& getDirectory() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a texture from an image file, through the cache
+    ///
+    /// If the cache holds an entry for \a filename that matches
+    /// its current modification time and size, the pixels are
+    /// mapped from the cache and uploaded directly, without
+    /// decoding the image. Otherwise the image is decoded like
+    /// in Texture::loadFromFile and its pixels are stored in
+    /// the cache for the next time.
+    ///
+    /// Failing to write the cache entry is not an error, the
+    /// texture is still loaded.
+    ///
+    /// \param texture  Texture to load
+    /// \param filename Path of the image file to load
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see Texture::loadFromFile
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadTexture(Texture& texture, const std::string& filename);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the path of the cache entry of a file
+    ///
+    /// \param filename Path of the source image file
+    ///
+    /// \return Path of the cache entry
+    ///
+    ////////////////////////////////////////////////////////////
+    std::string getEntryPath(const std::string& filename) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::string m_directory; ///< Directory where the decoded textures are stored
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTURECACHE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureCache
+/// \ingroup graphics
+///
+/// Decoding PNG and JPEG files takes most of the time spent
+/// loading textures, and it is repeated every time the
+/// application starts. sf::TextureCache stores the decoded
+/// pixels of the images it loads in a directory, next to
+/// the source modification time and size. The next loads of
+/// an unchanged image map the stored pixels in memory and
+/// upload them straight to the texture.
+///
+/// Entries become stale automatically when the source image
+/// changes; the cache directory can be deleted at any time.
+/// Entries written by a different version of SFML or on a
+/// machine with a different byte order are ignored and
+/// rewritten.
+///
+/// Usage example:
+/// \code
+/// sf::TextureCache cache("cache");
+///
+/// sf::Texture background;
+/// if (!cache.loadTexture(background, "background.png"))
+///     return -1;
+/// \endcode
+///
+/// \see sf::Texture
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,281 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TEXTURELOADQUEUE_HPP
+#define SFML_TEXTURELOADQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/FastMutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+class Thread;
+
+////////////////////////////////////////////////////////////
+/// \brief Load textures on a pool of worker threads,
+///        each with its own shared OpenGL context
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureLoadQueue : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Loaded texture
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Result
+    {
+        std::size_t id;      ///< Identifier returned by push
+        bool        success; ///< Was the texture loaded successfully?
+        Texture*    texture; ///< Texture that was given to push
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the queue and start its worker threads
+    ///
+    /// \param threadCount Number of textures loaded in parallel
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit TextureLoadQueue(unsigned int threadCount = 2);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Discards the textures that were not loaded yet and waits
+    /// for the ones being loaded.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureLoadQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue the loading of a texture from a file on disk
+    ///
+    /// The texture is loaded by a worker thread, it must remain
+    /// valid and must not be used until the result of the job
+    /// is popped.
+    ///
+    /// \param texture  Texture to load
+    /// \param filename Path of the image file to load
+    /// \param area     Area of the image to load
+    ///
+    /// \return Identifier of the job, found in the result
+    ///
+    /// \see Texture::loadFromFile, pop
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t push(Texture& texture, const std::string& filename, const IntRect& area = IntRect());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue the loading of a texture from a file in memory
+    ///
+    /// Neither the data nor the texture are copied, they must
+    /// remain valid and the texture must not be used until the
+    /// result of the job is popped.
+    ///
+    /// \param texture Texture to load
+    /// \param data    Pointer to the file data in memory
+    /// \param size    Size of the data to load, in bytes
+    /// \param area    Area of the image to load
+    ///
+    /// \return Identifier of the job, found in the result
+    ///
+    /// \see Texture::loadFromMemory, pop
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t push(Texture& texture, const void* data, std::size_t size, const IntRect& area = IntRect());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue the upload of an image to a texture
+    ///
+    /// The image is copied, but the texture must remain valid
+    /// and must not be used until the result of the job is popped.
+    ///
+    /// \param texture Texture to load
+    /// \param image   Image to upload to the texture
+    /// \param area    Area of the image to load
+    ///
+    /// \return Identifier of the job, found in the result
+    ///
+    /// \see Texture::loadFromImage, pop
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t push(Texture& texture, const Image& image, const IntRect& area = IntRect());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve a loaded texture, if any
+    ///
+    /// This function doesn't block. The results are returned
+    /// in the order the jobs finish, which is not necessarily
+    /// the order they were pushed; use the identifier to match
+    /// them. Once popped, the texture can be used by any thread.
+    ///
+    /// \param result Structure that receives the loaded texture
+    ///
+    /// \return True if a result was retrieved
+    ///
+    /// \see push, isReady
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pop(Result& result);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a loaded texture is available
+    ///
+    /// \return True if pop would succeed
+    ///
+    /// \see pop
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Block until all the queued textures are loaded
+    ///
+    /// \see pop
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of queued textures
+    ///
+    /// \return Number of jobs that were pushed but not popped yet
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPendingCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Texture waiting to be loaded
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Job
+    {
+        std::size_t id;       ///< Identifier returned by push
+        Texture*    texture;  ///< Texture to load
+        std::string filename; ///< Path of the file, if loading from a file
+        const void* data;     ///< File data, if loading from memory
+        std::size_t size;     ///< Size of the file data, in bytes
+        Image       image;    ///< Source pixels, if loading from an image
+        IntRect     area;     ///< Area of the image to load
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a job to the queue
+    ///
+    /// \param job Job to add, its identifier is assigned here
+    ///
+    /// \return Identifier of the job
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t addJob(Job& job);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function run by the worker threads
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Thread*>      m_threads; ///< Worker threads
+    std::deque<Job>           m_jobs;    ///< Textures waiting to be loaded
+    std::deque<Result>        m_results; ///< Loaded textures waiting to be popped
+    std::size_t               m_nextId;  ///< Identifier of the next job
+    std::size_t               m_pending; ///< Number of jobs pushed but not popped yet
+    std::size_t               m_loading; ///< Number of jobs being loaded
+    bool                      m_running; ///< Are the worker threads running?
+    mutable FastMutex         m_mutex;   ///< Mutex protecting the queues
+    ConditionVariable         m_newJob;  ///< Wakes up the workers when a job is pushed
+    mutable ConditionVariable m_jobDone; ///< Wakes up wait() when a job is finished
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTURELOADQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureLoadQueue
+/// \ingroup graphics
+///
+/// sf::TextureLoadQueue decodes images and uploads them to
+/// textures without blocking the main thread. Each of its
+/// worker threads owns an OpenGL context, shared with all
+/// the other contexts of the program, so the textures it
+/// creates are directly usable by the windows.
+///
+/// Textures written by a context only become safely visible
+/// to the others once the commands that wrote them are
+/// complete. Instead of relying on glFlush, each worker
+/// places a fence after its upload and waits for it (or for
+/// glFinish, when fences are not supported) before handing
+/// the texture out: a popped texture is ready to be drawn.
+///
+/// The error messages of the image loader are not thread
+/// specific, the reason printed for a failure may belong to
+/// another texture loaded at the same time.
+///
+/// Usage example:
+/// \code
+/// sf::TextureLoadQueue loader;
+/// sf::Texture background;
+/// sf::Texture tileset;
+///
+/// loader.push(background, "background.png");
+/// loader.push(tileset, "tileset.png");
+///
+/// while (window.isOpen())
+/// {
+///     // Draw the textures that are ready
+///     sf::TextureLoadQueue::Result result;
+///     while (loader.pop(result))
+///     {
+///         if (result.success)
+///             sprites.push_back(sf::Sprite(*result.texture));
+///     }
+///     ...
+/// }
+/// \endcode
+///
+/// \see sf::Texture, sf::ImageLoadQueue
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,310 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TEXTUREMANAGER_HPP
+#define SFML_TEXTUREMANAGER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <map>
+#include <string>
+
+
+namespace sf
+{
+class Image;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Keeps the memory used by a set of textures under a budget
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureManager : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a manager without budget, which never evicts
+    /// its textures.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureManager();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the manager with a budget
+    ///
+    /// \param budget Maximum memory used by the managed textures, in bytes
+    ///
+    /// \see setBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit TextureManager(Uint64 budget);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The textures stop being managed; those which are evicted
+    /// at this time are left empty.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureManager();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the memory budget of the managed textures
+    ///
+    /// When the textures use more memory than \a budget, the
+    /// least recently used ones are evicted until the usage
+    /// fits again. A budget of 0 disables eviction.
+    ///
+    /// \param budget Maximum memory used by the managed textures, in bytes
+    ///
+    /// \see getBudget, getMemoryUsage
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBudget(Uint64 budget);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the memory budget of the managed textures
+    ///
+    /// \return Maximum memory used by the managed textures, in bytes
+    ///
+    /// \see setBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getBudget() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the memory currently used by the managed textures
+    ///
+    /// Only textures which are not evicted are counted. The
+    /// usage is estimated from the size of the textures, with
+    /// 4 bytes per pixel and a third more for the mipmap.
+    ///
+    /// \return Memory used by the managed textures, in bytes
+    ///
+    /// \see getBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getMemoryUsage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a managed texture from an image file
+    ///
+    /// The texture is loaded like in Texture::loadFromFile, and
+    /// it is loaded again from \a filename the next time it is
+    /// used after having been evicted.
+    ///
+    /// \param texture  Texture to load
+    /// \param filename Path of the image file to load
+    /// \param area     Area of the image to load
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see release
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadTexture(Texture& texture, const std::string& filename, const IntRect& area = IntRect());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a managed texture from an image
+    ///
+    /// The texture is loaded like in Texture::loadFromImage,
+    /// and it is loaded again from \a image the next time it
+    /// is used after having been evicted. The image is not
+    /// copied, it must stay alive and unchanged as long as
+    /// the texture is managed.
+    ///
+    /// \param texture Texture to load
+    /// \param image   Image to load into the texture
+    /// \param area    Area of the image to load
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see release
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadTexture(Texture& texture, const Image& image, const IntRect& area = IntRect());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop managing a texture
+    ///
+    /// If the texture is evicted, it is loaded again first so
+    /// that it is left usable.
+    ///
+    /// \param texture Texture to release
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(Texture& texture);
+
+private:
+
+    friend class Texture;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Source and usage of a managed texture
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        Texture*     texture;   ///< Managed texture
+        std::string  filename;  ///< Source file, if the texture was loaded from a file
+        const Image* image;     ///< Source image, if the texture was loaded from an image
+        IntRect      area;      ///< Area of the source to load
+        Uint64       lastUse;   ///< Use counter value of the last use of the texture
+        bool         hasMipmap; ///< Must the mipmap be generated again after restoring?
+    };
+
+    typedef std::map<const Texture*, Entry> EntryMap;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Register a texture which was just loaded
+    ///
+    /// \param entry Source of the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const Entry& entry);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Notify that a texture is used, restoring it if needed
+    ///
+    /// This function is called by Texture when it is bound or drawn.
+    ///
+    /// \param texture Texture which is used
+    ///
+    ////////////////////////////////////////////////////////////
+    void use(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget a texture, without restoring it
+    ///
+    /// This function is called by Texture when it is destroyed.
+    ///
+    /// \param texture Texture to forget
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Exchange the entries of two textures being swapped
+    ///
+    /// This function is called by Texture::swap, before the
+    /// contents of the textures are swapped.
+    ///
+    /// \param left  First texture
+    /// \param right Second texture
+    ///
+    ////////////////////////////////////////////////////////////
+    static void swapTextures(Texture& left, Texture& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a texture again from its source
+    ///
+    /// \param entry Source of the texture
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool restore(Entry& entry);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Evict the least recently used textures until the budget is met
+    ///
+    /// \param keep Texture which must not be evicted, can be NULL
+    ///
+    ////////////////////////////////////////////////////////////
+    void enforceBudget(const Texture* keep);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the memory used by a texture
+    ///
+    /// \param texture Texture to measure
+    ///
+    /// \return Estimated memory used by the texture, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getMemoryUsage(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    EntryMap      m_entries;  ///< Managed textures
+    Uint64        m_budget;   ///< Maximum memory used by the managed textures, in bytes
+    Uint64        m_useCount; ///< Counter incremented on each texture use
+    mutable Mutex m_mutex;    ///< Mutex protecting the entries
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREMANAGER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureManager
+/// \ingroup graphics
+///
+/// sf::TextureManager loads textures and remembers where
+/// they come from, a file or an sf::Image. When the managed
+/// textures use more memory than the budget, the least
+/// recently used ones are evicted: their OpenGL texture is
+/// destroyed, but they keep their size, smooth and repeat
+/// settings. An evicted texture is loaded again from its
+/// source automatically the next time it is drawn or bound,
+/// so the code that uses it doesn't have to know about it.
+///
+/// Textures are considered used each time they are drawn by
+/// a render target or bound with sf::Texture::bind. A budget
+/// smaller than the textures used in a single frame makes
+/// them being evicted and loaded again every frame, so it
+/// should include some headroom.
+///
+/// The content of a managed texture must come from its
+/// source only: updates made directly to the texture (with
+/// sf::Texture::update, for example) are lost when it is
+/// evicted.
+///
+/// Usage example:
+/// \code
+/// // Keep the level textures under 64 MB
+/// sf::TextureManager manager(64 * 1024 * 1024);
+///
+/// std::vector<sf::Texture> textures(filenames.size());
+/// for (std::size_t i = 0; i < filenames.size(); ++i)
+///     manager.loadTexture(textures[i], filenames[i]);
+///
+/// // Draw as usual, evicted textures are restored when needed
+/// sf::Sprite sprite(textures[42]);
+/// window.draw(sprite);
+/// \endcode
+///
+/// \see sf::Texture, sf::TextureCache
+///
+////////////////////////////////////////////////////////////
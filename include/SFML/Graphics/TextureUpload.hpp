@@ -0,0 +1,235 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TEXTUREUPLOAD_HPP
+#define SFML_TEXTUREUPLOAD_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Staging memory for asynchronous texture updates
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureUpload : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty upload.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureUpload();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits for the pending transfer, if any.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureUpload();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate the staging memory
+    ///
+    /// If this function fails, the upload is left unchanged.
+    ///
+    /// \param width  Width of the pixel area, in pixels
+    /// \param height Height of the pixel area, in pixels
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage the pixels of an image
+    ///
+    /// The upload is resized to the size of the image if
+    /// needed, then the pixels are copied to the staging
+    /// memory. If this function fails, the upload is left
+    /// unchanged.
+    ///
+    /// \param image Image to stage
+    ///
+    /// \return True if the pixels were staged successfully
+    ///
+    /// \see create, Texture::updateAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromImage(const Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get direct write access to the staging memory
+    ///
+    /// The returned array contains width * height * 4 bytes of
+    /// uninitialized RGBA pixels, which must all be written.
+    /// This function can be called from any thread, and the
+    /// pointer stays valid until unlock is called or until
+    /// the upload is passed to Texture::updateAsync.
+    ///
+    /// Locking an upload whose previous transfer is still
+    /// running doesn't wait for it, the memory is renewed.
+    ///
+    /// \return Pointer to the pixels, or NULL on failure
+    ///
+    /// \see unlock
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint8* lock();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the write access to the staging memory
+    ///
+    /// Call this function on the thread that filled the pixels
+    /// to make sure that they are visible to the other threads.
+    ///
+    /// \see lock
+    ///
+    ////////////////////////////////////////////////////////////
+    void unlock();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the pixel area
+    ///
+    /// \return Size in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the last transfer is over
+    ///
+    /// This function doesn't block. It returns true if no
+    /// transfer was started.
+    ///
+    /// \return True if the texture was updated
+    ///
+    /// \see wait
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isComplete() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Block until the last transfer is over
+    ///
+    /// \see isComplete
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports asynchronous uploads
+    ///
+    /// This function should always be called before using
+    /// the asynchronous features. If it returns false, the
+    /// pixels are staged in system memory and the texture
+    /// updates are synchronous.
+    ///
+    /// \return True if asynchronous uploads are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    friend class Texture;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the fence of the last transfer
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseFence() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int       m_buffer; ///< Internal pixel buffer object identifier, 0 when staging in system memory
+    Vector2u           m_size;   ///< Size of the pixel area
+    std::vector<Uint8> m_pixels; ///< Staging memory, when pixel buffer objects are unavailable
+    Uint8*             m_mapped; ///< Pointer to the mapped buffer, while locked
+    mutable void*      m_fence;  ///< Fence inserted after the last transfer, if any
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREUPLOAD_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureUpload
+/// \ingroup graphics
+///
+/// sf::Texture::update copies the pixels synchronously: the
+/// calling thread waits until the driver has taken them, which
+/// stalls the render loop for big or frequent updates (video
+/// frames, streamed map tiles, ...).
+///
+/// sf::TextureUpload holds the pixels in a pixel buffer object,
+/// memory that the graphics card can read on its own. A loader
+/// thread fills it through lock and unlock, and the render
+/// thread only issues the final copy with
+/// sf::Texture::updateAsync, which returns immediately. The
+/// upload then acts as the completion handle of the transfer:
+/// isComplete and wait tell when the texture is up to date.
+///
+/// Like all the OpenGL resources of SFML, the pixel buffer is
+/// shared between all the contexts, so the loader thread only
+/// needs to have one active (sf::Context, or the one that SFML
+/// creates automatically).
+///
+/// Usage example:
+/// \code
+/// // Loader thread
+/// sf::Context context;
+/// upload.create(256, 256);
+/// sf::Uint8* pixels = upload.lock();
+/// decodeTile(pixels);
+/// upload.unlock();
+///
+/// // Render thread
+/// texture.updateAsync(upload, 0, 0);
+/// ...
+/// if (upload.isComplete())
+///     reuseForNextTile(upload);
+/// \endcode
+///
+/// \see sf::Texture
+///
+////////////////////////////////////////////////////////////
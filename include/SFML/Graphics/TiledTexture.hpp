@@ -0,0 +1,387 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TILEDTEXTURE_HPP
+#define SFML_TILEDTEXTURE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/ImageView.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class InputStream;
+class View;
+
+////////////////////////////////////////////////////////////
+/// \brief Image too large for a single texture, stored and
+///        drawn as a grid of textures
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TiledTexture : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty tiled texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    TiledTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the tiles from a file on disk
+    ///
+    /// JPEG files are decoded a few rows at a time, directly
+    /// into the tiles: the memory used on the CPU side is
+    /// bounded by a strip of rows, whatever the height of the
+    /// image. The other formats supported by sf::Image are
+    /// decoded entirely first, then split into tiles.
+    ///
+    /// If this function fails, the tiled texture is left empty.
+    ///
+    /// \param filename Path of the image file to load
+    /// \param tileSize Maximum width and height of the tiles, 0 means Texture::getMaximumSize()
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromMemory, loadFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFile(const std::string& filename, unsigned int tileSize = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the tiles from a file in memory
+    ///
+    /// See loadFromFile for details.
+    ///
+    /// \param data     Pointer to the file data in memory
+    /// \param size     Size of the data to load, in bytes
+    /// \param tileSize Maximum width and height of the tiles, 0 means Texture::getMaximumSize()
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromFile, loadFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromMemory(const void* data, std::size_t size, unsigned int tileSize = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the tiles from a custom stream
+    ///
+    /// See loadFromFile for details.
+    ///
+    /// \param stream   Source stream to read from
+    /// \param tileSize Maximum width and height of the tiles, 0 means Texture::getMaximumSize()
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromFile, loadFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromStream(InputStream& stream, unsigned int tileSize = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the tiles from an image
+    ///
+    /// If \a lazy is false, all the tiles are uploaded now and
+    /// the image can be destroyed afterwards.
+    ///
+    /// If \a lazy is true, no tile is created yet: each one is
+    /// uploaded the first time it is drawn, and the ones that
+    /// were not drawn recently are released when there are more
+    /// than getResidentTileLimit() of them. The pixels viewed by
+    /// \a image must then remain valid as long as the tiled
+    /// texture is used, like a texture used by a sprite.
+    ///
+    /// If this function fails, the tiled texture is left empty.
+    ///
+    /// \param image    View of the pixels to load
+    /// \param tileSize Maximum width and height of the tiles, 0 means Texture::getMaximumSize()
+    /// \param lazy     Upload the tiles only when they become visible?
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see setResidentTileLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromImage(const ImageView& image, unsigned int tileSize = 0, bool lazy = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the whole image
+    ///
+    /// \return Size in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of tiles in each direction
+    ///
+    /// \return Number of columns and rows of tiles
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getTileCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture of a tile
+    ///
+    /// If the tiles are loaded lazily, the tile is uploaded
+    /// first if needed.
+    ///
+    /// This function doesn't check the validity of the tile
+    /// coordinates, using out-of-range values will result in
+    /// an undefined behavior.
+    ///
+    /// \param x Column of the tile
+    /// \param y Row of the tile
+    ///
+    /// \return Texture of the tile
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTile(unsigned int x, unsigned int y) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the area of the image covered by a tile
+    ///
+    /// \param x Column of the tile
+    /// \param y Row of the tile
+    ///
+    /// \return Area of the tile, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect getTileRect(unsigned int x, unsigned int y) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter of all the tiles
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    /// \see Texture::setSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum number of lazily loaded tiles kept on the graphics card
+    ///
+    /// When more tiles are resident, the ones that were drawn
+    /// the longest time ago are released after each draw; the
+    /// tiles visible in the current draw are always kept, even
+    /// above the limit. 0 means no limit. The default is 0.
+    ///
+    /// This limit only affects tiles loaded lazily with
+    /// loadFromImage.
+    ///
+    /// \param limit Maximum number of resident tiles
+    ///
+    /// \see getResidentTileLimit, getResidentTileCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setResidentTileLimit(std::size_t limit);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of lazily loaded tiles kept on the graphics card
+    ///
+    /// \return Maximum number of resident tiles, 0 if there's no limit
+    ///
+    /// \see setResidentTileLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getResidentTileLimit() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of tiles currently stored on the graphics card
+    ///
+    /// \return Number of resident tiles
+    ///
+    /// \see setResidentTileLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getResidentTileCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the tiles to a render target
+    ///
+    /// Only the tiles that intersect the view of the target
+    /// are drawn.
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the (empty) tiles covering an image
+    ///
+    /// \param size     Size of the image, in pixels
+    /// \param tileSize Requested size of the tiles, 0 for the maximum
+    /// \param allocate Create the textures now, or leave them empty?
+    ///
+    /// \return True if all the tiles were created
+    ///
+    ////////////////////////////////////////////////////////////
+    bool createTiles(const Vector2u& size, unsigned int tileSize, bool allocate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload a lazily loaded tile if it's not resident
+    ///
+    /// \param index Index of the tile
+    ///
+    /// \return True if the tile is resident
+    ///
+    ////////////////////////////////////////////////////////////
+    bool makeResident(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the least recently drawn tiles above the residency limit
+    ///
+    ////////////////////////////////////////////////////////////
+    void evictTiles() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the range of tiles that intersect a view
+    ///
+    /// \param view      View of the render target
+    /// \param transform Transform of the tiled texture
+    ///
+    /// \return Range of columns and rows of visible tiles, empty if none is visible
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect findVisibleTiles(const View& view, const Transform& transform) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy full-width rows of the image to the tiles
+    ///
+    /// The rows must not span two rows of tiles.
+    ///
+    /// \param strip Rows to copy, as wide as the image
+    /// \param top   Index of the first row in the image
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateTiles(const ImageView& strip, unsigned int top);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode a JPEG stream into the tiles, a few rows at a time
+    ///
+    /// \param stream   Source stream, positioned at the start of the file
+    /// \param tileSize Requested size of the tiles, 0 for the maximum
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadJpeg(InputStream& stream, unsigned int tileSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the tiles
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    mutable std::vector<Texture>      m_tiles;         ///< Tiles, row by row
+    Vector2u                          m_size;          ///< Size of the whole image
+    Vector2u                          m_tileCount;     ///< Number of tiles in each direction
+    unsigned int                      m_tileSize;      ///< Width and height of the tiles, except the last column and row
+    bool                              m_smooth;        ///< Smooth filter of the tiles
+    ImageView                         m_source;        ///< Pixels of the lazily loaded tiles, empty if all are resident
+    mutable std::vector<unsigned int> m_lastUse;       ///< Draw in which each lazily loaded tile was last used
+    mutable unsigned int              m_drawCount;     ///< Number of draws so far, used to order the tiles by last use
+    mutable std::size_t               m_residentCount; ///< Number of lazily loaded tiles currently resident
+    std::size_t                       m_residentLimit; ///< Maximum number of resident lazily loaded tiles, 0 for no limit
+};
+
+} // namespace sf
+
+
+#endif // SFML_TILEDTEXTURE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TiledTexture
+/// \ingroup graphics
+///
+/// The size of a sf::Texture is limited by the graphics
+/// driver, usually to 4096 or 8192 pixels, and loading a
+/// huge image through sf::Image keeps all its pixels in
+/// memory at once. sf::TiledTexture splits the image into a
+/// grid of textures no larger than Texture::getMaximumSize
+/// (or a smaller requested tile size) and draws them as a
+/// single object.
+///
+/// JPEG files are streamed: they are decoded a strip of
+/// rows at a time and each strip is uploaded to the tiles
+/// it covers, so the peak memory on the CPU side doesn't
+/// depend on the height of the image. The other formats
+/// are decoded with sf::Image's loader first.
+///
+/// sf::TiledTexture is also a transformable drawable, like
+/// sf::Sprite. Only the tiles that intersect the view of the
+/// target are drawn.
+///
+/// Images already in memory can be loaded lazily: the tiles
+/// are uploaded when they first become visible and released
+/// when they haven't been drawn for a while, so the memory
+/// used on the graphics card follows what is on screen
+/// rather than the size of the image (see
+/// setResidentTileLimit).
+///
+/// Usage example:
+/// \code
+/// sf::TiledTexture map;
+/// if (!map.loadFromFile("world.jpg"))
+///     return -1;
+///
+/// map.setSmooth(true);
+/// map.setScale(0.1f, 0.1f);
+///
+/// window.draw(map);
+///
+/// // Keep a huge image in memory, but at most 16 tiles on the graphics card
+/// sf::Image background;
+/// background.loadFromFile("background.png");
+///
+/// sf::TiledTexture lazyBackground;
+/// lazyBackground.loadFromImage(background, 1024, true);
+/// lazyBackground.setResidentTileLimit(16);
+/// \endcode
+///
+/// \see sf::Texture, sf::Sprite
+///
+////////////////////////////////////////////////////////////
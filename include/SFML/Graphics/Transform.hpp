@@ -31,10 +31,13 @@
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/System/Vector2.hpp>
+#include <cstddef>
 
 
 namespace sf
 {
+class Vertex;
+
 ////////////////////////////////////////////////////////////
 /// \brief Define a 3x3 transform matrix
 ///
@@ -118,6 +121,25 @@ public:
     ////////////////////////////////////////////////////////////
     Vector2f transformPoint(const Vector2f& point) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Transform the positions of an array of vertices
+    ///
+    /// The position of each input vertex is transformed and
+    /// written to the corresponding output vertex, along with
+    /// its unchanged color and texture coordinates. This is
+    /// equivalent to calling transformPoint on every vertex,
+    /// but the points are processed several at a time with
+    /// SIMD instructions when the CPU supports them.
+    ///
+    /// \a input and \a output can point to the same array.
+    ///
+    /// \param input  Pointer to the vertices to transform
+    /// \param output Pointer to the destination vertices
+    /// \param count  Number of vertices in the arrays
+    ///
+    ////////////////////////////////////////////////////////////
+    void transformPoints(const Vertex* input, Vertex* output, std::size_t count) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Transform a rectangle
     ///
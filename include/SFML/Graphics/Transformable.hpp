@@ -313,6 +313,9 @@ public:
 
 private:
 
+    friend class CacheLayer;
+    friend class Node;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -324,6 +327,7 @@ private:
     mutable bool      m_transformNeedUpdate;        ///< Does the transform need to be recomputed?
     mutable Transform m_inverseTransform;           ///< Combined transformation of the object
     mutable bool      m_inverseTransformNeedUpdate; ///< Does the transform need to be recomputed?
+    Uint32            m_revision;                   ///< Number of changes of the components, used by sf::Node and sf::CacheLayer to detect them
 };
 
 } // namespace sf
@@ -0,0 +1,320 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_UNIFORMBUFFER_HPP
+#define SFML_UNIFORMBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/GpuMemory.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/System/Vector3.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Buffer of shader parameters shared by several shaders
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API UniformBuffer : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Helper computing the offsets of a std140 uniform block
+    ///
+    /// The members must be added in the order of their
+    /// declaration in the block.
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_GRAPHICS_API Layout
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Types of the block members
+        ///
+        ////////////////////////////////////////////////////////////
+        enum Type
+        {
+            Float, ///< float
+            Vec2,  ///< vec2
+            Vec3,  ///< vec3
+            Vec4,  ///< vec4
+            Mat4   ///< mat4
+        };
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Creates an empty layout.
+        ///
+        ////////////////////////////////////////////////////////////
+        Layout();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Add a member to the layout
+        ///
+        /// \param type  Type of the member
+        /// \param count Number of elements, if the member is an array
+        ///
+        /// \return Offset of the member in the buffer, in bytes
+        ///
+        ////////////////////////////////////////////////////////////
+        std::size_t add(Type type, std::size_t count = 1);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the size of the block
+        ///
+        /// \return Size of the members added so far, in bytes
+        ///
+        ////////////////////////////////////////////////////////////
+        std::size_t getSize() const;
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        std::size_t m_size; ///< Size of the members added so far, in bytes
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty uniform buffer.
+    ///
+    ////////////////////////////////////////////////////////////
+    UniformBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~UniformBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the buffer
+    ///
+    /// The contents of the buffer are undefined until they
+    /// are updated. If this function fails, the buffer is
+    /// left unchanged.
+    ///
+    /// \param size Size of the buffer, in bytes
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the buffer
+    ///
+    /// \return Size of the buffer, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer from raw data
+    ///
+    /// The data must follow the layout of the block in the
+    /// shaders, see sf::UniformBuffer::Layout.
+    ///
+    /// \param offset Offset of the updated part, in bytes
+    /// \param data   Pointer to the new contents
+    /// \param size   Size of the updated part, in bytes
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(std::size_t offset, const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a float member of the buffer
+    ///
+    /// \param offset Offset of the member, in bytes
+    /// \param x      New value of the member
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(std::size_t offset, float x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a vec2 member of the buffer
+    ///
+    /// \param offset Offset of the member, in bytes
+    /// \param vector New value of the member
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(std::size_t offset, const Vector2f& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a vec3 member of the buffer
+    ///
+    /// \param offset Offset of the member, in bytes
+    /// \param vector New value of the member
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(std::size_t offset, const Vector3f& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a vec4 member of the buffer with a color
+    ///
+    /// The components are normalized to the range [0, 1],
+    /// like in Shader::setParameter.
+    ///
+    /// \param offset Offset of the member, in bytes
+    /// \param color  New value of the member
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(std::size_t offset, const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a mat4 member of the buffer
+    ///
+    /// \param offset    Offset of the member, in bytes
+    /// \param transform New value of the member
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(std::size_t offset, const Transform& transform);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the name of the uniform buffer in the video memory statistics
+    ///
+    /// \param name New name of the uniform buffer
+    ///
+    /// \see getDebugName, sf::GpuMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDebugName(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the name of the uniform buffer in the video memory statistics
+    ///
+    /// \return Name of the uniform buffer, empty if none
+    ///
+    /// \see setDebugName
+    ///
+    ////////////////////////////////////////////////////////////
+    std::string getDebugName() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the underlying OpenGL handle of the buffer
+    ///
+    /// \return OpenGL handle of the buffer or 0 if not yet created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getNativeHandle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports uniform buffers
+    ///
+    /// \return True if uniform buffers are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int       m_buffer;    ///< Internal buffer identifier
+    std::size_t        m_size;      ///< Size of the buffer, in bytes
+    GpuMemory::Counter m_gpuMemory; ///< Reports the video memory of the buffer
+};
+
+} // namespace sf
+
+
+#endif // SFML_UNIFORMBUFFER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::UniformBuffer
+/// \ingroup graphics
+///
+/// sf::UniformBuffer stores the values of a uniform block
+/// in graphics memory. Once a buffer is given to several
+/// shaders with sf::Shader::setParameter, its values are
+/// shared by all of them: data that is common to many
+/// shaders, like the camera or the lights, is then uploaded
+/// once instead of once per shader.
+///
+/// The buffer follows the std140 layout, declared in the
+/// shaders like this:
+/// \code
+/// layout(std140) uniform Frame
+/// {
+///     mat4  camera;
+///     vec3  light;
+///     float time;
+/// };
+/// \endcode
+///
+/// sf::UniformBuffer::Layout computes the offsets of the
+/// members according to the std140 rules:
+/// \code
+/// sf::UniformBuffer::Layout layout;
+/// std::size_t camera = layout.add(sf::UniformBuffer::Layout::Mat4);
+/// std::size_t light  = layout.add(sf::UniformBuffer::Layout::Vec3);
+/// std::size_t time   = layout.add(sf::UniformBuffer::Layout::Float);
+///
+/// sf::UniformBuffer frame;
+/// frame.create(layout.getSize());
+///
+/// shader1.setParameter("Frame", frame);
+/// shader2.setParameter("Frame", frame);
+///
+/// // Every frame
+/// frame.update(camera, view.getTransform());
+/// frame.update(light, lightPosition);
+/// frame.update(time, clock.getElapsedTime().asSeconds());
+/// \endcode
+///
+/// Uniform buffers require OpenGL 3.1 or the
+/// ARB_uniform_buffer_object extension, you should check
+/// sf::UniformBuffer::isAvailable before using them.
+///
+/// \see sf::Shader
+///
+////////////////////////////////////////////////////////////
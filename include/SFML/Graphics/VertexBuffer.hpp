@@ -0,0 +1,447 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_VERTEXBUFFER_HPP
+#define SFML_VERTEXBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/GpuMemory.hpp>
+#include <SFML/Graphics/CompactVertex.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+class RenderTarget;
+
+////////////////////////////////////////////////////////////
+/// \brief Vertex buffer storage for one or more 2D primitives
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API VertexBuffer : public Drawable, GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Usage specifiers
+    ///
+    /// If data is going to be updated once or more every frame,
+    /// set the usage to Stream. If data is going to be set once
+    /// and used for a long time without being modified, set the
+    /// usage to Static. For everything else Dynamic should be a
+    /// good compromise.
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Usage
+    {
+        Stream,  ///< Constantly changing data
+        Dynamic, ///< Occasionally changing data
+        Static   ///< Rarely changing data
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Vertex layouts
+    ///
+    /// The layout defines how each vertex is stored in graphics
+    /// memory, and therefore which type of vertices the buffer
+    /// is updated from.
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Layout
+    {
+        Standard, ///< sf::Vertex: floating point position and texture coordinates, 20 bytes per vertex
+        Compact   ///< sf::CompactVertex: 16-bit integer position and texture coordinates, 12 bytes per vertex
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty vertex buffer.
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a VertexBuffer with a specific PrimitiveType, usage specifier and layout
+    ///
+    /// Creates an empty vertex buffer and sets its primitive type,
+    /// usage and layout to \p type, \p usage and \p layout.
+    ///
+    /// \param type   Type of primitive
+    /// \param usage  Usage specifier
+    /// \param layout Layout of the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit VertexBuffer(PrimitiveType type, Usage usage = Stream, Layout layout = Standard);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~VertexBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the vertex buffer
+    ///
+    /// Creates the vertex buffer and allocates enough graphics
+    /// memory to hold \p vertexCount vertices. Any previously
+    /// allocated memory is freed in the process.
+    ///
+    /// In order to deallocate previously allocated memory pass 0
+    /// as \p vertexCount. Don't forget to recreate with a non-zero
+    /// value when graphics memory should be allocated again.
+    ///
+    /// \param vertexCount Number of vertices worth of memory to allocate
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the vertex count
+    ///
+    /// \return Number of vertices in the vertex buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getVertexCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the whole buffer from an array of vertices
+    ///
+    /// The \a vertices array is assumed to have the same size as
+    /// the \a created buffer.
+    ///
+    /// No additional check is performed on the size of the vertex
+    /// array, passing invalid arguments will lead to undefined
+    /// behavior.
+    ///
+    /// This function does nothing if \a vertices is null or if the
+    /// buffer was not previously created.
+    ///
+    /// \param vertices Array of vertices to copy to the buffer
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const Vertex* vertices);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the whole buffer from an array of compact vertices
+    ///
+    /// This overload must be used when the layout of the buffer
+    /// is sf::VertexBuffer::Compact, it fails otherwise.
+    ///
+    /// \param vertices Array of vertices to copy to the buffer
+    ///
+    /// \return True if the update was successful
+    ///
+    /// \see update(const Vertex*)
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const CompactVertex* vertices);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer from an array of vertices
+    ///
+    /// \p offset is specified as the number of vertices to skip
+    /// from the beginning of the buffer.
+    ///
+    /// If \p offset is 0 and \p vertexCount is equal to the size of
+    /// the currently created buffer, its whole contents are replaced.
+    ///
+    /// If \p offset is 0 and \p vertexCount is greater than the
+    /// size of the currently created buffer, a new buffer is created
+    /// containing the vertex data.
+    ///
+    /// If \p offset is 0 and \p vertexCount is less than the size of
+    /// the currently created buffer, only the corresponding region
+    /// is updated.
+    ///
+    /// If \p offset is not 0 and \p offset + \p vertexCount is greater
+    /// than the size of the currently created buffer, the update fails.
+    ///
+    /// No additional check is performed on the size of the vertex
+    /// array, passing invalid arguments will lead to undefined
+    /// behavior.
+    ///
+    /// \param vertices    Array of vertices to copy to the buffer
+    /// \param vertexCount Number of vertices to copy
+    /// \param offset      Offset in the buffer to copy to
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const Vertex* vertices, std::size_t vertexCount, unsigned int offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer from an array of compact vertices
+    ///
+    /// This overload must be used when the layout of the buffer
+    /// is sf::VertexBuffer::Compact, it fails otherwise.
+    ///
+    /// \param vertices    Array of vertices to copy to the buffer
+    /// \param vertexCount Number of vertices to copy
+    /// \param offset      Offset in the buffer to copy to
+    ///
+    /// \return True if the update was successful
+    ///
+    /// \see update(const Vertex*, std::size_t, unsigned int)
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const CompactVertex* vertices, std::size_t vertexCount, unsigned int offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the name of the vertex buffer in the video memory statistics
+    ///
+    /// \param name New name of the vertex buffer
+    ///
+    /// \see getDebugName, sf::GpuMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDebugName(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the name of the vertex buffer in the video memory statistics
+    ///
+    /// \return Name of the vertex buffer, empty if none
+    ///
+    /// \see setDebugName
+    ///
+    ////////////////////////////////////////////////////////////
+    std::string getDebugName() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the underlying OpenGL handle of the vertex buffer.
+    ///
+    /// You shouldn't need to use this function, unless you have
+    /// very specific stuff to implement that SFML doesn't support,
+    /// or implement a temporary workaround until a bug is fixed.
+    ///
+    /// \return OpenGL handle of the vertex buffer or 0 if not yet created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getNativeHandle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the type of primitives to draw
+    ///
+    /// This function defines how the vertices must be interpreted
+    /// when it's time to draw them.
+    ///
+    /// The default primitive type is sf::Points.
+    ///
+    /// \param type Type of primitive
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPrimitiveType(PrimitiveType type);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the type of primitives drawn by the vertex buffer
+    ///
+    /// \return Primitive type
+    ///
+    ////////////////////////////////////////////////////////////
+    PrimitiveType getPrimitiveType() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the usage specifier of this vertex buffer
+    ///
+    /// This function provides a hint about how this vertex buffer
+    /// is going to be used in terms of data update frequency.
+    ///
+    /// After changing the usage specifier, the vertex buffer has
+    /// to be updated with new data for the usage specifier to
+    /// take effect.
+    ///
+    /// The default usage is sf::VertexBuffer::Stream.
+    ///
+    /// \param usage Usage specifier
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUsage(Usage usage);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the usage specifier of this vertex buffer
+    ///
+    /// \return Usage specifier
+    ///
+    ////////////////////////////////////////////////////////////
+    Usage getUsage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the layout of the vertices of this vertex buffer
+    ///
+    /// The layout defines the format of the vertices in graphics
+    /// memory. The previous contents can't be interpreted with
+    /// the new layout, therefore the buffer must be created again
+    /// after changing it.
+    ///
+    /// The default layout is sf::VertexBuffer::Standard.
+    ///
+    /// \param layout Layout of the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLayout(Layout layout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the layout of the vertices of this vertex buffer
+    ///
+    /// \return Layout of the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    Layout getLayout() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a vertex buffer for rendering
+    ///
+    /// This function is not part of the graphics API, it mustn't be
+    /// used when drawing SFML entities. It must be used only if you
+    /// mix sf::VertexBuffer with OpenGL code.
+    ///
+    /// \code
+    /// sf::VertexBuffer vb1, vb2;
+    /// ...
+    /// sf::VertexBuffer::bind(&vb1);
+    /// // draw OpenGL stuff that use vb1...
+    /// sf::VertexBuffer::bind(&vb2);
+    /// // draw OpenGL stuff that use vb2...
+    /// sf::VertexBuffer::bind(NULL);
+    /// // draw OpenGL stuff that use no vertex buffer...
+    /// \endcode
+    ///
+    /// \param vertexBuffer Pointer to the vertex buffer to bind, can be null to use no vertex buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    static void bind(const VertexBuffer* vertexBuffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports vertex buffers
+    ///
+    /// This function should always be called before using
+    /// the vertex buffer features. If it returns false, then
+    /// any attempt to use sf::VertexBuffer will fail.
+    ///
+    /// \return True if vertex buffers are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the vertex buffer to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy vertices of the given layout to the buffer
+    ///
+    /// \param vertices    Pointer to the vertices to copy
+    /// \param vertexCount Number of vertices to copy
+    /// \param offset      Offset in the buffer to copy to
+    /// \param layout      Layout of the vertices to copy
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool updateData(const void* vertices, std::size_t vertexCount, unsigned int offset, Layout layout);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int       m_buffer;        ///< Internal buffer identifier
+    std::size_t        m_size;          ///< Size in Vertexes of the currently allocated buffer
+    PrimitiveType      m_primitiveType; ///< Type of primitives to draw
+    Usage              m_usage;         ///< How this vertex buffer is to be used
+    Layout             m_layout;        ///< Format of the vertices in graphics memory
+    GpuMemory::Counter m_gpuMemory;     ///< Reports the video memory of the buffer
+};
+
+} // namespace sf
+
+
+#endif // SFML_VERTEXBUFFER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::VertexBuffer
+/// \ingroup graphics
+///
+/// sf::VertexBuffer is a simple wrapper around a dynamic
+/// buffer of vertices and a primitives type.
+///
+/// Unlike sf::VertexArray, the vertex data is stored in
+/// graphics memory. In situations where a large amount of
+/// vertex data would have to be transferred from system
+/// memory to graphics memory every frame, using
+/// sf::VertexBuffer can help. By using a sf::VertexBuffer,
+/// data that has not been changed between frames does not
+/// have to be re-transferred from system to graphics memory
+/// as would be the case with sf::VertexArray. If data transfer
+/// is a bottleneck, this can lead to performance gains.
+///
+/// Using sf::VertexBuffer, the user also has the ability to
+/// only modify a portion of the buffer in graphics memory.
+/// This way, a large buffer can be allocated at the start
+/// of the application and only the applicable portions of it
+/// need to be updated during the course of the application.
+/// This allows the user to take full control of data transfers
+/// between system and graphics memory if they need to.
+///
+/// The usage specifier is a hint given to the graphics driver
+/// about how the data is going to be updated (see setUsage).
+///
+/// The layout defines the format of the vertices (see setLayout).
+/// Geometry aligned on whole pixels can use the Compact layout,
+/// which stores sf::CompactVertex structures and reduces the
+/// memory read for each vertex by 40%.
+///
+/// Example:
+/// \code
+/// sf::Vertex vertices[15];
+/// ...
+/// sf::VertexBuffer triangles(sf::Triangles, sf::VertexBuffer::Static);
+/// triangles.create(15);
+/// triangles.update(vertices);
+/// ...
+/// window.draw(triangles);
+/// \endcode
+///
+/// \see sf::Vertex, sf::CompactVertex, sf::VertexArray
+///
+////////////////////////////////////////////////////////////
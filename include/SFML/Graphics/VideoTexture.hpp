@@ -0,0 +1,298 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_VIDEOTEXTURE_HPP
+#define SFML_VIDEOTEXTURE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/TextureUpload.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Time.hpp>
+#include <deque>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Abstract base class for textures showing a video
+///        decoded in the background
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API VideoTexture : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decoded frame, in the YUV 4:2:0 planar format
+    ///
+    /// The chroma planes have half the width and half the
+    /// height of the luma plane, rounded up. Every plane is
+    /// tightly packed: its rows have no padding.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Frame
+    {
+        Uint8* y;         ///< Luma plane, width * height bytes
+        Uint8* u;         ///< Blue-difference chroma plane
+        Uint8* v;         ///< Red-difference chroma plane
+        Time   timestamp; ///< Time at which the frame must be shown
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Derived classes must call stop() in their destructor,
+    /// since the decoding thread calls their virtual functions.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~VideoTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the textures of the video
+    ///
+    /// Stops the decoding first, if it was started.
+    ///
+    /// \param width          Width of the video, in pixels
+    /// \param height         Height of the video, in pixels
+    /// \param bufferedFrames Number of frames that can be decoded ahead
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, unsigned int bufferedFrames = 3);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start decoding the video in the background
+    ///
+    /// \see stop, update
+    ///
+    ////////////////////////////////////////////////////////////
+    void play();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop decoding the video
+    ///
+    /// The frames decoded ahead are discarded, the texture
+    /// keeps showing the last frame.
+    ///
+    /// \see play
+    ///
+    ////////////////////////////////////////////////////////////
+    void stop();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Show the frame that matches a playing offset
+    ///
+    /// Call this function once per frame, with the time
+    /// elapsed since the beginning of the video. To keep the
+    /// video in sync with its sound, pass the playing offset
+    /// of the sf::SoundStream playing the sound track.
+    ///
+    /// The latest frame whose timestamp is not after \a offset
+    /// is uploaded, the older ones are skipped. This function
+    /// never waits for the decoder: if the frame is not decoded
+    /// yet, the texture keeps showing the previous one.
+    ///
+    /// \param offset Current playing position of the video
+    ///
+    /// \return True if a new frame is shown
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(Time offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the decoder reached the end of the video
+    ///
+    /// \return True if onGetFrame returned false and all the
+    ///         decoded frames were shown
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isFinished() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture showing the current frame
+    ///
+    /// \return RGBA texture, with the size of the video
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the system supports video textures
+    ///
+    /// The color conversion is done by a shader, video textures
+    /// are available when shaders are.
+    ///
+    /// \return True if video textures are supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// This constructor is only meant to be called by derived classes.
+    ///
+    ////////////////////////////////////////////////////////////
+    VideoTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode the next frame
+    ///
+    /// This function is called by the decoding thread every
+    /// time a frame is free. It must fill the planes of
+    /// \a frame and its timestamp, in presentation order.
+    ///
+    /// \param frame Frame to fill
+    ///
+    /// \return True to continue decoding, false at the end of the video
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onGetFrame(Frame& frame) = 0;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Frame and the memory of its planes
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Buffer
+    {
+        Frame              frame;  ///< Frame given to the decoder
+        std::vector<Uint8> pixels; ///< Memory of the three planes
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode frames until stopped or finished
+    ///
+    /// Runs in the decoding thread.
+    ///
+    ////////////////////////////////////////////////////////////
+    void decode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the planes of a frame and convert them to RGBA
+    ///
+    /// \param frame Frame to show
+    ///
+    ////////////////////////////////////////////////////////////
+    void show(const Frame& frame);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Thread               m_thread;       ///< Thread calling onGetFrame
+    mutable Mutex        m_mutex;        ///< Mutex protecting the frame queues and the flags
+    ConditionVariable    m_freed;        ///< Notified when a frame is free or decoding stops
+    Vector2u             m_size;         ///< Size of the video, in pixels
+    Vector2u             m_chromaSize;   ///< Size of the chroma planes, in pixels
+    std::vector<Buffer*> m_buffers;      ///< All the frames
+    std::deque<Buffer*>  m_free;         ///< Frames that can be decoded into
+    std::deque<Buffer*>  m_decoded;      ///< Decoded frames, in presentation order
+    Texture              m_planes[3];    ///< Y, U and V planes, four samples per RGBA texel
+    TextureUpload        m_uploads[3];   ///< Staging memory of the planes
+    Shader               m_shader;       ///< Conversion of the planes to RGBA
+    RenderTexture        m_target;       ///< Converted frame
+    bool                 m_playing;      ///< Is the decoding thread running?
+    bool                 m_stop;         ///< Must the decoding thread stop?
+    bool                 m_finished;     ///< Did the decoder reach the end of the video?
+};
+
+} // namespace sf
+
+
+#endif // SFML_VIDEOTEXTURE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::VideoTexture
+/// \ingroup graphics
+///
+/// sf::VideoTexture shows a video that is decoded in the
+/// background. Like sf::SoundStream, it is an abstract class:
+/// SFML doesn't decode any video format itself, derived
+/// classes wrap a decoder and return its frames in onGetFrame,
+/// which is called by a separate thread.
+///
+/// Decoders produce YUV 4:2:0 frames, which take 1.5 bytes
+/// per pixel instead of 4 in RGBA. The planes are uploaded as
+/// they are, through asynchronous transfers (see
+/// sf::TextureUpload), and converted to RGBA by a shader on
+/// the graphics card; the conversion uses the BT.601 coefficients with
+/// limited range. The result is a regular texture, that can
+/// be drawn with a sprite.
+///
+/// Usage example:
+/// \code
+/// class Movie : public sf::VideoTexture
+/// {
+/// public:
+///
+///     ~Movie()
+///     {
+///         stop();
+///     }
+///
+/// private:
+///
+///     virtual bool onGetFrame(Frame& frame)
+///     {
+///         // Decode the next frame into frame.y, frame.u and frame.v...
+///         frame.timestamp = ...;
+///         return !endOfVideo;
+///     }
+/// };
+///
+/// Movie movie;
+/// movie.create(1920, 1080);
+/// movie.play();
+/// music.play();
+///
+/// sf::Sprite screen(movie.getTexture());
+/// while (window.isOpen())
+/// {
+///     // Follow the sound track
+///     movie.update(music.getPlayingOffset());
+///
+///     window.clear();
+///     window.draw(screen);
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::Texture, sf::TextureUpload, sf::SoundStream
+///
+////////////////////////////////////////////////////////////
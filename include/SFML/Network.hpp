@@ -30,15 +30,22 @@
 ////////////////////////////////////////////////////////////
 
 #include <SFML/System.hpp>
+#include <SFML/Network/DeltaPacket.hpp>
 #include <SFML/Network/Ftp.hpp>
 #include <SFML/Network/Http.hpp>
+#include <SFML/Network/HttpClient.hpp>
 #include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/NetworkService.hpp>
 #include <SFML/Network/Packet.hpp>
+#include <SFML/Network/PacketPool.hpp>
+#include <SFML/Network/PacketSchema.hpp>
 #include <SFML/Network/Socket.hpp>
 #include <SFML/Network/SocketHandle.hpp>
+#include <SFML/Network/SocketMonitor.hpp>
 #include <SFML/Network/SocketSelector.hpp>
 #include <SFML/Network/TcpListener.hpp>
 #include <SFML/Network/TcpSocket.hpp>
+#include <SFML/Network/UdpConnection.hpp>
 #include <SFML/Network/UdpSocket.hpp>
 
 
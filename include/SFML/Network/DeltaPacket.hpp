@@ -0,0 +1,247 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_DELTAPACKET_HPP
+#define SFML_DELTAPACKET_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Packet sent as the difference with a previous snapshot
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API DeltaPacket : public Packet
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param maxBaselines Maximum number of snapshots kept as baselines
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit DeltaPacket(std::size_t maxBaselines = 32);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the identifier of the snapshot contained in the packet
+    ///
+    /// Each snapshot sent must have a greater identifier than the
+    /// previous one. When the packet is sent, its data is kept
+    /// as a baseline under this identifier, so that the next
+    /// snapshots can be encoded against it once the peer
+    /// acknowledges it. 0 means that the packet is not a
+    /// snapshot and is never kept.
+    ///
+    /// \param id Identifier of the snapshot
+    ///
+    /// \see getSnapshotId, setBaseline
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSnapshotId(Uint32 id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the identifier of the snapshot contained in the packet
+    ///
+    /// After a receive, this is the identifier given by the sender.
+    ///
+    /// \return Identifier of the snapshot
+    ///
+    /// \see setSnapshotId
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getSnapshotId() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Choose the snapshot the next send is encoded against
+    ///
+    /// This should be the last snapshot acknowledged by the
+    /// peer: only the bytes that changed since then are sent.
+    /// If the baseline is not known (anymore), the packet is
+    /// sent in full. 0 disables delta encoding.
+    ///
+    /// \param id Identifier of the baseline snapshot
+    ///
+    /// \see getBaseline
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBaseline(Uint32 id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the snapshot the packet is encoded against
+    ///
+    /// After a receive, this is the baseline chosen by the
+    /// sender (0 if the packet was sent in full).
+    ///
+    /// \return Identifier of the baseline snapshot
+    ///
+    /// \see setBaseline
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getBaseline() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the last received packet could be decoded
+    ///
+    /// Decoding fails if the data is corrupted, or if the
+    /// baseline chosen by the sender is not known here; the
+    /// packet is then empty, and the sender should be asked
+    /// for a full snapshot.
+    ///
+    /// \return True if the received data was decoded successfully
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDecoded() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the baselines older than a snapshot
+    ///
+    /// Once a snapshot is acknowledged, the older ones will
+    /// never be used as baselines again.
+    ///
+    /// \param id Identifier of the oldest snapshot to keep
+    ///
+    ////////////////////////////////////////////////////////////
+    void forgetBaselines(Uint32 id);
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode the data against the baseline before it is sent
+    ///
+    /// \param size Variable to fill with the size of data to send
+    ///
+    /// \return Pointer to the array of bytes to send
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual const void* onSend(std::size_t& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode the received data against its baseline
+    ///
+    /// \param data Pointer to the received bytes
+    /// \param size Number of bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onReceive(const void* data, std::size_t size);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Keep the data of the packet as a baseline
+    ///
+    ////////////////////////////////////////////////////////////
+    void storeBaseline();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode a received packet
+    ///
+    /// \param data Pointer to the received bytes
+    /// \param size Number of bytes
+    ///
+    /// \return True if the data was decoded successfully
+    ///
+    ////////////////////////////////////////////////////////////
+    bool decode(const Uint8* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<Uint32, std::vector<char> > BaselineMap;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    BaselineMap       m_baselines;    ///< Snapshots that can be used as baselines, by identifier
+    std::vector<char> m_encoded;      ///< Data of the packet encoded against its baseline
+    std::size_t       m_maxBaselines; ///< Maximum number of baselines kept
+    Uint32            m_snapshotId;   ///< Identifier of the snapshot contained in the packet
+    Uint32            m_baselineId;   ///< Identifier of the baseline the packet is encoded against
+    bool              m_isDecoded;    ///< Was the last received packet decoded successfully?
+};
+
+} // namespace sf
+
+
+#endif // SFML_DELTAPACKET_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::DeltaPacket
+/// \ingroup network
+///
+/// Games that synchronize their state over UDP usually send a
+/// full snapshot of the entities every tick, although most of
+/// it doesn't change from one tick to the next. sf::DeltaPacket
+/// sends a snapshot as the difference with a previous one that
+/// the peer is known to have received (the baseline): the two
+/// snapshots are XORed and the runs of unchanged bytes are
+/// replaced by their length, so the size of the packet depends
+/// on what changed rather than on the size of the snapshot.
+///
+/// Snapshots must have the same layout from one tick to the
+/// next for the deltas to be small: prefer fixed-size fields,
+/// and keep entities at the same position in the packet.
+///
+/// A delta packet keeps the baselines of one stream of
+/// snapshots: use one instance per connection to send, and
+/// another one per connection to receive. The acknowledgement
+/// of snapshots is left to the application.
+///
+/// Usage example:
+/// \code
+/// // Sender, every tick
+/// sf::DeltaPacket& packet = connection.packet;
+/// packet.clear();
+/// packet << entities;
+/// packet.setSnapshotId(tick);
+/// packet.setBaseline(connection.lastAcknowledgedTick);
+/// socket.send(packet, connection.address, connection.port);
+///
+/// // When the peer acknowledges a snapshot
+/// connection.lastAcknowledgedTick = tick;
+/// connection.packet.forgetBaselines(tick);
+///
+/// -----------------------------------------------------------------
+///
+/// // Receiver
+/// socket.receive(packet, address, port);
+/// if (packet.isDecoded())
+/// {
+///     packet >> entities;
+///     acknowledge(packet.getSnapshotId());
+/// }
+/// \endcode
+///
+/// \see sf::Packet
+///
+////////////////////////////////////////////////////////////
@@ -454,18 +454,22 @@ public:
     /// of your application.
     /// If a file with the same filename as the distant file
     /// already exists in the local destination path, it will
-    /// be overwritten.
+    /// be overwritten, unless \a resume is true: in this case
+    /// the transfer restarts from the end of the local file
+    /// (if the server supports it), and the part already
+    /// received is kept if the transfer fails again.
     ///
     /// \param remoteFile Filename of the distant file to download
     /// \param localPath  The directory in which to put the file on the local computer
     /// \param mode       Transfer mode
+    /// \param resume     Resume a previous, interrupted download of the file?
     ///
     /// \return Server response to the request
     ///
     /// \see upload
     ///
     ////////////////////////////////////////////////////////////
-    Response download(const std::string& remoteFile, const std::string& localPath, TransferMode mode = Binary);
+    Response download(const std::string& remoteFile, const std::string& localPath, TransferMode mode = Binary, bool resume = false);
 
     ////////////////////////////////////////////////////////////
     /// \brief Upload a file to the server
@@ -474,17 +478,21 @@ public:
     /// working directory of your application, and the
     /// remote path is relative to the current directory of the
     /// FTP server.
+    /// If \a resume is true and the file already exists on the
+    /// server, only the part of the local file past the size
+    /// of the remote one is sent (if the server supports it).
     ///
     /// \param localFile  Path of the local file to upload
     /// \param remotePath The directory in which to put the file on the server
     /// \param mode       Transfer mode
+    /// \param resume     Resume a previous, interrupted upload of the file?
     ///
     /// \return Server response to the request
     ///
     /// \see download
     ///
     ////////////////////////////////////////////////////////////
-    Response upload(const std::string& localFile, const std::string& remotePath, TransferMode mode = Binary);
+    Response upload(const std::string& localFile, const std::string& remotePath, TransferMode mode = Binary, bool resume = false);
 
     ////////////////////////////////////////////////////////////
     /// \brief Send a command to the FTP server
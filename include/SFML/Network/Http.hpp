@@ -146,6 +146,7 @@ public:
     private:
 
         friend class Http;
+        friend class HttpClient;
 
         ////////////////////////////////////////////////////////////
         /// \brief Prepare the final request to send to the server
@@ -306,6 +307,7 @@ public:
     private:
 
         friend class Http;
+        friend class HttpClient;
 
         ////////////////////////////////////////////////////////////
         /// \brief Construct the header from a response string
@@ -345,6 +347,49 @@ public:
         std::string  m_body;         ///< Body of the response
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Abstract class receiving a response as it arrives
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_NETWORK_API ResponseHandler
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Virtual destructor
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ~ResponseHandler() {}
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called when the header of the response is received
+        ///
+        /// The response contains the status code, the HTTP version
+        /// and the header fields, but no body. The default
+        /// implementation accepts all the responses.
+        ///
+        /// \param response Header of the response
+        ///
+        /// \return True to receive the body, false to abort the request
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool onHeader(const Response& response);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called when a part of the body is received
+        ///
+        /// The body is given decoded (without the chunked
+        /// transfer encoding), in parts of arbitrary sizes.
+        ///
+        /// \param data Pointer to the received part of the body
+        /// \param size Size of the received part, in bytes
+        ///
+        /// \return True to continue, false to abort the request
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool onBodyData(const char* data, std::size_t size) = 0;
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -404,8 +449,135 @@ public:
     ////////////////////////////////////////////////////////////
     Response sendRequest(const Request& request, Time timeout = Time::Zero);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a HTTP request and stream the server's response
+    ///
+    /// This function works like the other overload, except that
+    /// the body of the response is given to \a handler as it is
+    /// received instead of being stored in the returned response.
+    /// Memory usage then doesn't depend on the size of the body,
+    /// which is useful to download big files.
+    ///
+    /// \param request Request to send
+    /// \param handler Handler receiving the header and the body of the response
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return Server's response, without its body
+    ///
+    ////////////////////////////////////////////////////////////
+    Response sendRequest(const Request& request, ResponseHandler& handler, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable persistent connections
+    ///
+    /// When persistent connections are enabled, requests are
+    /// sent with "Connection: keep-alive" (unless the request
+    /// already defines this field), and the connection is kept
+    /// open after the response if the server agrees, so that
+    /// the next requests to the same host don't have to connect
+    /// again. Idle connections are shared by all the sf::Http
+    /// instances, up to 4 per host.
+    ///
+    /// Persistent connections are disabled by default.
+    ///
+    /// \param keepAlive True to enable persistent connections, false to disable them
+    ///
+    /// \see isKeepAlive, closeIdleConnections
+    ///
+    ////////////////////////////////////////////////////////////
+    void setKeepAlive(bool keepAlive);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether persistent connections are enabled
+    ///
+    /// \return True if persistent connections are enabled
+    ///
+    /// \see setKeepAlive
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isKeepAlive() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close all the idle persistent connections
+    ///
+    /// \see setKeepAlive
+    ///
+    ////////////////////////////////////////////////////////////
+    static void closeIdleConnections();
+
 private:
 
+    friend class HttpClient;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Extract the host name and the port from a host string
+    ///
+    /// \param host     Host string, with an optional "http://" prefix
+    /// \param port     Port given along with the host (0 for the default one)
+    /// \param hostName String to fill with the host name
+    /// \param hostPort Variable to fill with the port
+    ///
+    /// \return False if the protocol is not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool parseHost(const std::string& host, unsigned short port, std::string& hostName, unsigned short& hostPort);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the missing mandatory fields to a request
+    ///
+    /// \param request   Request to complete
+    /// \param hostName  Name of the host the request is sent to
+    /// \param keepAlive Must the connection be kept open after the response?
+    ///
+    /// \return Completed request
+    ///
+    ////////////////////////////////////////////////////////////
+    static Request completeRequest(const Request& request, const std::string& hostName, bool keepAlive);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the server keeps the connection open after a response
+    ///
+    /// \param response Header of the response
+    ///
+    /// \return True if the connection is persistent
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isPersistent(const Response& response);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a response is followed by a body
+    ///
+    /// \param response Header of the response
+    /// \param isHead   Is the response the answer to a HEAD request?
+    ///
+    /// \return True if the response has a body
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool hasBody(const Response& response, bool isHead);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive a response, using its header to find where it ends
+    ///
+    /// \param connection Connection to receive the response from
+    /// \param isHead     Is the response the answer to a HEAD request (which has no body)?
+    /// \param header     String to fill with the header of the response
+    /// \param handler    Handler receiving the header and the body of the response
+    /// \param canReuse   Variable to fill with whether the connection can be used for another request
+    ///
+    /// \return True if some data was received, false if the connection was closed before
+    ///
+    ////////////////////////////////////////////////////////////
+    bool receiveResponse(TcpSocket& connection, bool isHead, std::string& header, ResponseHandler& handler, bool& canReuse);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close a connection, or keep it for a later request
+    ///
+    /// \param connection Connection to release
+    /// \param canReuse   Can the connection be used for another request?
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseConnection(TcpSocket* connection, bool canReuse);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -413,6 +585,7 @@ private:
     IpAddress      m_host;       ///< Web host address
     std::string    m_hostName;   ///< Web host name
     unsigned short m_port;       ///< Port used for connection with host
+    bool           m_keepAlive;  ///< Are persistent connections enabled?
 };
 
 } // namespace sf
@@ -451,7 +624,10 @@ private:
 ///
 /// sf::Http provides a simple function, SendRequest, to send a
 /// sf::Http::Request and return the corresponding sf::Http::Response
-/// from the server.
+/// from the server. To download big resources without keeping
+/// them in memory, derive a class from sf::Http::ResponseHandler
+/// and pass it to sendRequest: the body of the response is then
+/// given to the handler as it is received.
 ///
 /// Usage example:
 /// \code
@@ -0,0 +1,356 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_HTTPCLIENT_HPP
+#define SFML_HTTPCLIENT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/Http.hpp>
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/SocketSelector.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Non-blocking HTTP client running many requests
+///        concurrently on a single thread
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API HttpClient : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of a request (0 is never used)
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef Uint32 RequestId;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    HttpClient();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The requests in progress are cancelled.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~HttpClient();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum number of connections to a host
+    ///
+    /// Requests to a host that already has this number of
+    /// connections wait until one of them is free. The default
+    /// is 6 connections per host.
+    ///
+    /// \param count Maximum number of connections per host
+    ///
+    /// \see getMaxConnections
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMaxConnections(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of connections to a host
+    ///
+    /// \return Maximum number of connections per host
+    ///
+    /// \see setMaxConnections
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getMaxConnections() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start a request
+    ///
+    /// This function returns immediately; the request (including
+    /// the resolution of the host name) progresses in the calls
+    /// to update.
+    /// The host is given as in sf::Http::setHost. Missing
+    /// mandatory fields are added to the request, and
+    /// connections are kept alive to be reused by the next
+    /// requests to the same host.
+    ///
+    /// If a handler is given, the header and the body of the
+    /// response are given to it as they are received, from
+    /// within update; otherwise the body is stored in the
+    /// response. The handler must remain alive until the
+    /// request is finished or cancelled.
+    ///
+    /// \param request Request to send
+    /// \param host    Web server to send the request to
+    /// \param port    Port to use for the connection (0 for the default one)
+    /// \param handler Handler receiving the response as it arrives (can be NULL)
+    ///
+    /// \return Identifier of the request
+    ///
+    /// \see update, getResponse, cancel
+    ///
+    ////////////////////////////////////////////////////////////
+    RequestId sendRequest(const Http::Request& request, const std::string& host, unsigned short port = 0, Http::ResponseHandler* handler = NULL);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the requests progress
+    ///
+    /// This function waits until one of the connections is ready
+    /// or the timeout expires, and then sends and receives what
+    /// it can without blocking. Call it regularly, for example
+    /// once per frame with no timeout, or in a loop with a
+    /// timeout on a dedicated thread.
+    ///
+    /// \param timeout Maximum time to wait (Time::Zero to return immediately)
+    ///
+    /// \return True if at least one request finished during the call
+    ///
+    /// \see sendRequest, isDone
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a request is finished
+    ///
+    /// \param id Identifier of the request
+    ///
+    /// \return True if the response of the request is available
+    ///
+    /// \see getResponse
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDone(RequestId id) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the response of a finished request
+    ///
+    /// Once its response is retrieved, the request is forgotten
+    /// and its identifier becomes invalid. If the connection
+    /// failed, the status of the response is
+    /// sf::Http::Response::ConnectionFailed.
+    ///
+    /// \param id       Identifier of the request
+    /// \param response Response to fill
+    ///
+    /// \return True if the request was finished, false if it is still in progress (or unknown)
+    ///
+    /// \see isDone
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getResponse(RequestId id, Http::Response& response);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cancel a request
+    ///
+    /// If the request was in progress, its connection is
+    /// closed. The identifier becomes invalid.
+    ///
+    /// \param id Identifier of the request
+    ///
+    ////////////////////////////////////////////////////////////
+    void cancel(RequestId id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of requests not finished yet
+    ///
+    /// \return Number of requests waiting or in progress
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPendingCount() const;
+
+private:
+
+    struct Connection;
+    struct Transaction;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give the waiting requests to free connections
+    ///
+    ////////////////////////////////////////////////////////////
+    void startRequests();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a new connection to a host
+    ///
+    /// \param address Address of the host
+    /// \param port    Port of the host
+    ///
+    /// \return New connection, or NULL if it failed
+    ///
+    ////////////////////////////////////////////////////////////
+    Connection* openConnection(const IpAddress& address, unsigned short port);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process the events of a connection
+    ///
+    /// \param connection Connection to process
+    /// \param events     Events that happened on the connection
+    ///
+    ////////////////////////////////////////////////////////////
+    void processConnection(Connection& connection, Uint32 events);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send what remains of the request of a connection
+    ///
+    /// \param connection Connection sending a request
+    ///
+    ////////////////////////////////////////////////////////////
+    void sendData(Connection& connection);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process data received on a connection
+    ///
+    /// \param connection Connection that received the data
+    /// \param data       Pointer to the received data
+    /// \param size       Size of the received data, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void receiveData(Connection& connection, const char* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process data of the body of a response
+    ///
+    /// \param connection Connection that received the data
+    /// \param data       Pointer to the received data
+    /// \param size       Size of the received data, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void receiveBody(Connection& connection, const char* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle the closing of a connection by the server
+    ///
+    /// \param connection Connection that was closed
+    ///
+    ////////////////////////////////////////////////////////////
+    void handleDisconnection(Connection& connection);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Finish the request of a connection
+    ///
+    /// \param connection Connection of the request
+    /// \param canReuse   Can the connection be used for another request?
+    ///
+    ////////////////////////////////////////////////////////////
+    void finishRequest(Connection& connection, bool canReuse);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close and destroy a connection
+    ///
+    /// \param connection Connection to close
+    ///
+    ////////////////////////////////////////////////////////////
+    void closeConnection(Connection& connection);
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<RequestId, Transaction*> TransactionTable;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    SocketSelector            m_selector;       ///< Selector watching all the connections
+    std::vector<Connection*>  m_connections;    ///< Open connections
+    TransactionTable          m_transactions;   ///< Requests not retrieved yet, by identifier
+    std::deque<Transaction*>  m_waiting;        ///< Requests waiting for a connection
+    RequestId                 m_nextId;         ///< Identifier of the next request
+    std::size_t               m_maxConnections; ///< Maximum number of connections per host
+    std::size_t               m_pendingCount;   ///< Number of requests not finished yet
+    bool                      m_hasFinished;    ///< Did a request finish during the current update?
+};
+
+} // namespace sf
+
+
+#endif // SFML_HTTPCLIENT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::HttpClient
+/// \ingroup network
+///
+/// sf::Http::sendRequest blocks until the response is
+/// received, so running several requests at the same time
+/// with it requires one thread per request. sf::HttpClient
+/// runs all its requests on non-blocking sockets watched by
+/// a single sf::SocketSelector: many requests can be in
+/// flight at once, all driven by the calls to update.
+///
+/// Each request gets an identifier, which works like a
+/// future: poll it with isDone, then retrieve the response
+/// with getResponse. Alternatively, give a
+/// sf::Http::ResponseHandler to sendRequest to process the
+/// response as it is received.
+///
+/// Connections are persistent: after a response, the
+/// connection stays open and is reused by the next request
+/// to the same host. Responses are delimited by their
+/// header (Content-Length or chunked transfer encoding),
+/// and decoded as the data arrives.
+///
+/// Usage example:
+/// \code
+/// sf::HttpClient client;
+///
+/// // Start downloading several files at once
+/// std::vector<sf::HttpClient::RequestId> requests;
+/// for (int i = 0; i < 10; ++i)
+/// {
+///     sf::Http::Request request("/assets/level" + toString(i) + ".dat");
+///     requests.push_back(client.sendRequest(request, "http://www.example.com"));
+/// }
+///
+/// // Make them progress, while the application does something else
+/// while (client.getPendingCount() > 0)
+/// {
+///     client.update(sf::milliseconds(10));
+///     ...
+/// }
+///
+/// // Retrieve the responses
+/// for (std::size_t i = 0; i < requests.size(); ++i)
+/// {
+///     sf::Http::Response response;
+///     client.getResponse(requests[i], response);
+///     if (response.getStatus() == sf::Http::Response::Ok)
+///         loadLevel(i, response.getBody());
+/// }
+/// \endcode
+///
+/// \see sf::Http, sf::SocketSelector
+///
+////////////////////////////////////////////////////////////
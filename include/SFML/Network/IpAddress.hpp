@@ -33,12 +33,13 @@
 #include <istream>
 #include <ostream>
 #include <string>
+#include <vector>
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
-/// \brief Encapsulate an IPv4 network address
+/// \brief Encapsulate an IPv4 or IPv6 network address
 ///
 ////////////////////////////////////////////////////////////
 class SFML_NETWORK_API IpAddress
@@ -57,7 +58,10 @@ public:
     /// \brief Construct the address from a string
     ///
     /// Here \a address can be either a decimal address
-    /// (ex: "192.168.1.56") or a network name (ex: "localhost").
+    /// (ex: "192.168.1.56"), an IPv6 address (ex: "2001:db8::1")
+    /// or a network name (ex: "localhost"). When a network name
+    /// has both IPv4 and IPv6 addresses, the first IPv4 one is
+    /// chosen; use resolveAll to get all of them.
     ///
     /// \param address IP address or network name
     ///
@@ -108,12 +112,27 @@ public:
     ////////////////////////////////////////////////////////////
     explicit IpAddress(Uint32 address);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an IPv6 address from its 16 bytes
+    ///
+    /// The bytes are in network order, the most significant
+    /// first. IPv4-mapped addresses (::ffff:a.b.c.d) give the
+    /// IPv4 address a.b.c.d.
+    ///
+    /// \param bytes Array of 16 bytes
+    ///
+    /// \see toBytes
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit IpAddress(const Uint8* bytes);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get a string representation of the address
     ///
     /// The returned string is the decimal representation of the
-    /// IP address (like "192.168.1.56"), even if it was constructed
-    /// from a host name.
+    /// IP address (like "192.168.1.56"), or the hexadecimal one
+    /// of an IPv6 address (like "2001:db8::1"), even if it was
+    /// constructed from a host name.
     ///
     /// \return String representation of the address
     ///
@@ -131,13 +150,37 @@ public:
     /// The integer produced by this function can then be converted
     /// back to a sf::IpAddress with the proper constructor.
     ///
+    /// IPv6 addresses can't be represented by an integer: they
+    /// give 0.
+    ///
     /// \return 32-bits unsigned integer representation of the address
     ///
-    /// \see toString
+    /// \see toString, toBytes
     ///
     ////////////////////////////////////////////////////////////
     Uint32 toInteger() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the 16 bytes of the address
+    ///
+    /// The bytes are written in network order. IPv4 addresses
+    /// give their IPv4-mapped form (::ffff:a.b.c.d).
+    ///
+    /// \param bytes Array of 16 bytes to fill
+    ///
+    /// \see isIpv6
+    ///
+    ////////////////////////////////////////////////////////////
+    void toBytes(Uint8* bytes) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the address is an IPv6 one
+    ///
+    /// \return True for an IPv6 address, false for an IPv4 one
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isIpv6() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the computer's local address
     ///
@@ -178,19 +221,75 @@ public:
     ////////////////////////////////////////////////////////////
     static IpAddress getPublicAddress(Time timeout = Time::Zero);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Resolve an address without blocking
+    ///
+    /// The first call for a network name starts resolving it on
+    /// a background thread and returns false; call the function
+    /// again later (for example once per frame) until it
+    /// returns true with the result. Decimal addresses, and
+    /// network names found in the resolution cache, are
+    /// available immediately.
+    ///
+    /// \param address Decimal address or network name to resolve
+    /// \param result  Resolved address (IpAddress::None if the name can't be resolved)
+    ///
+    /// \return True if the result is available, false if the resolution is still in progress
+    ///
+    /// \see setResolutionCacheDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool resolveAsync(const std::string& address, IpAddress& result);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get all the addresses of a network name
+    ///
+    /// The addresses are in the order of preference given by
+    /// the system. They can be given to the sf::TcpSocket::connect
+    /// overload that tries several addresses, to use the fastest
+    /// route to a host that has both IPv4 and IPv6 addresses.
+    /// Like the constructors, this function blocks unless the
+    /// name is in the resolution cache.
+    ///
+    /// \param address Decimal address or network name to resolve
+    ///
+    /// \return Addresses of the host (empty if it can't be resolved)
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::vector<IpAddress> resolveAll(const std::string& address);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set how long the resolved network names are cached
+    ///
+    /// The addresses resolved from network names, whether by
+    /// the constructors or by resolveAsync, are kept in a cache
+    /// and reused for this duration, so that connecting several
+    /// times to the same host doesn't query the name server
+    /// each time. Names that failed to resolve are cached too.
+    /// The default duration is 60 seconds; Time::Zero disables
+    /// the cache.
+    ///
+    /// \param duration Time during which a resolved name is reused
+    ///
+    /// \see resolveAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setResolutionCacheDuration(Time duration);
+
     ////////////////////////////////////////////////////////////
     // Static member data
     ////////////////////////////////////////////////////////////
     static const IpAddress None;      ///< Value representing an empty/invalid address
     static const IpAddress LocalHost; ///< The "localhost" address (for connecting a computer to itself locally)
     static const IpAddress Broadcast; ///< The "broadcast" address (for sending UDP messages to everyone on a local network)
+    static const IpAddress Any;       ///< The IPv6 unspecified address "::", for binding sockets to all the IPv4 and IPv6 interfaces
 
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Uint32 m_address; ///< Address stored as an unsigned 32 bits integer
+    Uint8 m_bytes[16]; ///< Address in network order, IPv4 addresses being mapped to ::ffff:a.b.c.d
 };
 
 ////////////////////////////////////////////////////////////
@@ -310,7 +409,21 @@ SFML_NETWORK_API std::ostream& operator <<(std::ostream& stream, const IpAddress
 /// sf::IpAddress a9 = sf::IpAddress::getPublicAddress(); // my address on the internet
 /// \endcode
 ///
-/// Note that sf::IpAddress currently doesn't support IPv6
-/// nor other types of network addresses.
+/// Resolving a network name can take a long time, during
+/// which the constructors block. resolveAsync does the same
+/// job on a background thread:
+/// \code
+/// sf::IpAddress server;
+/// while (!sf::IpAddress::resolveAsync("www.google.com", server))
+/// {
+///     // do something else, e.g. update and draw the current frame
+///     ...
+/// }
+/// \endcode
+///
+/// sf::IpAddress holds IPv6 addresses too, and the sockets
+/// create IPv6 (dual-stack) sockets when they need to. IPv4
+/// addresses are stored in their IPv4-mapped form, which lets
+/// dual-stack sockets reach them.
 ///
 ////////////////////////////////////////////////////////////
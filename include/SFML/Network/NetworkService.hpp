@@ -0,0 +1,416 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_NETWORKSERVICE_HPP
+#define SFML_NETWORKSERVICE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/PacketPool.hpp>
+#include <SFML/Network/SocketSelector.hpp>
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <deque>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+    template <typename T> class MpscQueue;
+    template <typename T> class SpscQueue;
+}
+
+class Packet;
+
+////////////////////////////////////////////////////////////
+/// \brief TCP connections handled by a dedicated network
+///        thread, exchanging packets through lock-free queues
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API NetworkService : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of a connection (0 is never used)
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef Uint32 ConnectionId;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Event reported by the network thread
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Event
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Types of events
+        ///
+        ////////////////////////////////////////////////////////////
+        enum Type
+        {
+            Connected,    ///< A connection was established (connect) or accepted (listen)
+            Disconnected, ///< A connection was closed, lost, or could not be established
+            Received      ///< A packet was received on a connection
+        };
+
+        Type         type;       ///< Type of the event
+        ConnectionId connection; ///< Connection concerned by the event
+        Packet*      packet;     ///< Received packet (Received only), to give back to getPacketPool() once processed
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Starts the network thread.
+    ///
+    /// \param queueSize Maximum number of requests, and of events, waiting in the queues
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit NetworkService(std::size_t queueSize = 4096);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Stops the network thread, and closes all the listeners
+    /// and connections. Packets waiting in the queues are
+    /// released.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~NetworkService();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Accept the connections made to a port
+    ///
+    /// The port is bound immediately, so that errors can be
+    /// reported; the connections are then accepted by the
+    /// network thread, and reported with Connected events.
+    ///
+    /// \param port    Port to listen for new connections
+    /// \param address Local address to listen on
+    ///
+    /// \return Status code (NotReady if the request queue is full)
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status listen(unsigned short port, const IpAddress& address = IpAddress::Any);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start a connection to a remote peer
+    ///
+    /// This function returns immediately; a Connected event is
+    /// reported once the connection is established, or a
+    /// Disconnected event if it fails. Packets can be sent
+    /// right away, they are kept until the connection is
+    /// established.
+    ///
+    /// \param remoteAddress Address of the remote peer
+    /// \param remotePort    Port of the remote peer
+    ///
+    /// \return Identifier of the connection, 0 if the request queue is full
+    ///
+    ////////////////////////////////////////////////////////////
+    ConnectionId connect(const IpAddress& remoteAddress, unsigned short remotePort);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a packet on a connection
+    ///
+    /// The packet must come from getPacketPool(); on success
+    /// it belongs to the service, which gives it back to the
+    /// pool once it is sent. The packets sent to a connection
+    /// are sent in order, and the ones sent to a connection
+    /// that is closed are dropped.
+    ///
+    /// \param connection Connection to send the packet to
+    /// \param packet     Packet to send
+    ///
+    /// \return True if the packet was queued, false if the request queue is full (the packet then still belongs to the caller)
+    ///
+    ////////////////////////////////////////////////////////////
+    bool send(ConnectionId connection, Packet* packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close a connection
+    ///
+    /// The packets already sent to the connection are sent
+    /// before it is closed, and a Disconnected event is
+    /// reported.
+    ///
+    /// \param connection Connection to close
+    ///
+    /// \return True if the request was queued, false if the request queue is full
+    ///
+    ////////////////////////////////////////////////////////////
+    bool disconnect(ConnectionId connection);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the next event reported by the network thread
+    ///
+    /// This function never blocks. It must always be called
+    /// from the same thread.
+    ///
+    /// \param event Event to fill, if any
+    ///
+    /// \return True if an event was returned, false if there is no pending event
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pollEvent(Event& event);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the pool of the packets exchanged with the service
+    ///
+    /// \return Packet pool of the service
+    ///
+    ////////////////////////////////////////////////////////////
+    PacketPool& getPacketPool();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request sent by the application to the network thread
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Command
+    {
+        enum Type
+        {
+            Listen,     ///< Start accepting the connections of a listener
+            Connect,    ///< Start a connection
+            Send,       ///< Send a packet on a connection
+            Disconnect  ///< Close a connection
+        };
+
+        Type           type;       ///< Type of the request
+        ConnectionId   connection; ///< Connection concerned by the request
+        Packet*        packet;     ///< Packet to send (Send only)
+        TcpListener*   listener;   ///< Listener to take (Listen only)
+        IpAddress      address;    ///< Address of the remote peer (Connect only)
+        unsigned short port;       ///< Port of the remote peer (Connect only)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Connection handled by the network thread
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Connection
+    {
+        ConnectionId         id;         ///< Identifier of the connection
+        TcpSocket            socket;     ///< Socket of the connection
+        bool                 connecting; ///< Is the connection still being established?
+        bool                 closing;    ///< Must the connection be closed once its data is sent?
+        bool                 dirty;      ///< Has data been written since the last flush?
+        std::deque<Packet*>  waiting;    ///< Packets sent while the connection is being established
+
+        explicit Connection(ConnectionId identifier);
+    };
+
+    typedef std::map<ConnectionId, Connection*> ConnectionTable;
+    typedef std::vector<SocketSelector::ReadyEvent> ReadyEventArray;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a request and wake the network thread up
+    ///
+    /// \param command Request to queue
+    ///
+    /// \return False if the request queue is full
+    ///
+    ////////////////////////////////////////////////////////////
+    bool post(const Command& command);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Main loop of the network thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Execute the requests queued by the application
+    ///
+    ////////////////////////////////////////////////////////////
+    void processCommands();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle the events reported by the selector
+    ///
+    ////////////////////////////////////////////////////////////
+    void processSockets();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the data written to the connections
+    ///
+    ////////////////////////////////////////////////////////////
+    void flushConnections();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Accept the connections waiting on a listener
+    ///
+    /// \param listener Listener that is ready
+    ///
+    ////////////////////////////////////////////////////////////
+    void acceptConnections(TcpListener& listener);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Generate a new connection identifier (any thread)
+    ///
+    /// \return Unique identifier, never 0
+    ///
+    ////////////////////////////////////////////////////////////
+    ConnectionId generateId();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a connected (or connecting) socket to the selector
+    ///
+    /// \param connection Connection to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void addConnection(Connection* connection);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write a packet to a connection
+    ///
+    /// \param connection Connection to write to
+    /// \param packet     Packet to write, released afterwards
+    ///
+    ////////////////////////////////////////////////////////////
+    void sendPacket(Connection& connection, Packet* packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive the packets waiting on a connection
+    ///
+    /// \param connection Connection to read
+    ///
+    /// \return False if the connection was lost
+    ///
+    ////////////////////////////////////////////////////////////
+    bool receivePackets(Connection& connection);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close and destroy a connection, and report it
+    ///
+    /// \param connection Connection to close
+    ///
+    ////////////////////////////////////////////////////////////
+    void closeConnection(Connection* connection);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Report an event to the application
+    ///
+    /// \param type       Type of the event
+    /// \param connection Connection concerned by the event
+    /// \param packet     Received packet, if any
+    ///
+    ////////////////////////////////////////////////////////////
+    void postEvent(Event::Type type, ConnectionId connection, Packet* packet = NULL);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move the overflowing events to the event queue, as room allows
+    ///
+    ////////////////////////////////////////////////////////////
+    void deliverEvents();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    PacketPool                 m_pool;          ///< Packets exchanged with the application
+    priv::MpscQueue<Command>*  m_commands;      ///< Requests of the application, consumed by the network thread
+    priv::SpscQueue<Event>*    m_events;        ///< Events of the network thread, consumed by the application
+    std::deque<Event>          m_overflow;      ///< Events waiting for room in the event queue (network thread)
+    UdpSocket                  m_wakeReceiver;  ///< Socket watched by the network thread to be woken up
+    UdpSocket                  m_wakeSender;    ///< Socket sending the wake-up datagrams
+    unsigned short             m_wakePort;      ///< Port of the wake-up receiver
+    volatile unsigned long     m_wakePending;   ///< Has a wake-up datagram been sent since the last wake-up?
+    volatile unsigned long     m_running;       ///< Is the network thread running?
+    volatile unsigned long     m_nextId;        ///< Identifier of the next connection
+    SocketSelector             m_selector;      ///< Selector of the network thread
+    ReadyEventArray            m_ready;         ///< Copy of the ready events, not invalidated when sockets are removed (network thread)
+    std::vector<TcpListener*>  m_listeners;     ///< Listeners accepting connections (network thread)
+    ConnectionTable            m_connections;   ///< Connections, by identifier (network thread)
+    std::vector<Connection*>   m_dirty;         ///< Connections written since the last flush (network thread)
+    Thread                     m_thread;        ///< Network thread
+};
+
+} // namespace sf
+
+
+#endif // SFML_NETWORKSERVICE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::NetworkService
+/// \ingroup network
+///
+/// sf::NetworkService runs TCP connections on its own thread,
+/// so that the thread of the application never waits on the
+/// network. The application only posts requests (connect,
+/// send, disconnect) and polls events (Connected, Received,
+/// Disconnected); both go through bounded lock-free queues.
+///
+/// The requests can be posted from any thread; the events must
+/// always be polled from the same thread. The network thread
+/// is only woken up when it is idle and a first request
+/// arrives: a burst of requests costs a single wake-up.
+///
+/// Packets are exchanged as pointers to pooled sf::Packet
+/// instances: packets to send are acquired from
+/// getPacketPool(), and the received packets must be given
+/// back to it once processed.
+///
+/// When the application doesn't poll the events fast enough
+/// and the event queue is full, the network thread stops
+/// receiving until there is room again, so the memory used by
+/// the service stays bounded.
+///
+/// Usage example:
+/// \code
+/// sf::NetworkService network;
+/// network.listen(55001);
+///
+/// // In the game loop
+/// sf::NetworkService::Event event;
+/// while (network.pollEvent(event))
+/// {
+///     if (event.type == sf::NetworkService::Event::Received)
+///     {
+///         process(event.connection, *event.packet);
+///         network.getPacketPool().release(event.packet);
+///     }
+/// }
+///
+/// sf::Packet* packet = network.getPacketPool().acquire();
+/// *packet << state;
+/// if (!network.send(client, packet))
+///     network.getPacketPool().release(packet);
+/// \endcode
+///
+/// \see sf::TcpSocket, sf::PacketPool, sf::SocketSelector
+///
+////////////////////////////////////////////////////////////
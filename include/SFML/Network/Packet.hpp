@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
+#include <SFML/System/MemoryTracker.hpp>
 #include <string>
 #include <vector>
 
@@ -38,6 +39,7 @@ namespace sf
 class String;
 class TcpSocket;
 class UdpSocket;
+template <typename T> class PacketSchema;
 
 ////////////////////////////////////////////////////////////
 /// \brief Utility class to build blocks of data to transfer
@@ -79,13 +81,39 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Clear the packet
     ///
-    /// After calling Clear, the packet is empty.
+    /// After calling Clear, the packet is empty. The memory
+    /// allocated for its data is kept, so that a packet reused
+    /// for data of a similar size doesn't allocate again.
     ///
-    /// \see append
+    /// \see append, reserve
     ///
     ////////////////////////////////////////////////////////////
     void clear();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate memory for the data of the packet
+    ///
+    /// Reserving the final size before appending data to the
+    /// packet avoids the reallocations while it grows. This
+    /// function doesn't change the contents of the packet.
+    ///
+    /// \param sizeInBytes Number of bytes that the packet can hold without reallocating
+    ///
+    /// \see getCapacity
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bytes the packet can hold without reallocating
+    ///
+    /// \return Capacity of the packet, in bytes
+    ///
+    /// \see reserve
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get a pointer to the data contained in the packet
     ///
@@ -212,10 +240,96 @@ public:
     Packet& operator <<(const std::wstring& data);
     Packet& operator <<(const String&       data);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Write an integer with a variable-length encoding
+    ///
+    /// The value is written 7 bits per byte, so small values
+    /// take less space (1 byte below 128, 2 bytes below 16384,
+    /// up to 10 bytes). appendVarInt uses the zigzag encoding,
+    /// so that small negative values are small too.
+    ///
+    /// \param data Value to write
+    ///
+    /// \return Reference to self
+    ///
+    /// \see readVarUint, readVarInt
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& appendVarUint(Uint64 data);
+    Packet& appendVarInt(Int64 data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an integer written with appendVarUint or appendVarInt
+    ///
+    /// \param data Variable to fill with the value
+    ///
+    /// \return Reference to self
+    ///
+    /// \see appendVarUint, appendVarInt
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& readVarUint(Uint64& data);
+    Packet& readVarInt(Int64& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write an array of values into the packet
+    ///
+    /// The values are encoded the same way as with operator <<,
+    /// but the packet grows only once for the whole array and
+    /// the byte order of all the values is converted in a
+    /// single pass. The number of values is not written, use
+    /// operator << before if the receiver doesn't know it.
+    ///
+    /// \param data  Pointer to the values to write
+    /// \param count Number of values
+    ///
+    /// \return Reference to self
+    ///
+    /// \see readArray
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& appendArray(const Int8*   data, std::size_t count);
+    Packet& appendArray(const Uint8*  data, std::size_t count);
+    Packet& appendArray(const Int16*  data, std::size_t count);
+    Packet& appendArray(const Uint16* data, std::size_t count);
+    Packet& appendArray(const Int32*  data, std::size_t count);
+    Packet& appendArray(const Uint32* data, std::size_t count);
+    Packet& appendArray(const Int64*  data, std::size_t count);
+    Packet& appendArray(const Uint64* data, std::size_t count);
+    Packet& appendArray(const float*  data, std::size_t count);
+    Packet& appendArray(const double* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an array of values from the packet
+    ///
+    /// If the packet doesn't contain \a count values, nothing
+    /// is read and the packet becomes invalid.
+    ///
+    /// \param data  Pointer to the array to fill
+    /// \param count Number of values to read
+    ///
+    /// \return Reference to self
+    ///
+    /// \see appendArray
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(Int8*   data, std::size_t count);
+    Packet& readArray(Uint8*  data, std::size_t count);
+    Packet& readArray(Int16*  data, std::size_t count);
+    Packet& readArray(Uint16* data, std::size_t count);
+    Packet& readArray(Int32*  data, std::size_t count);
+    Packet& readArray(Uint32* data, std::size_t count);
+    Packet& readArray(Int64*  data, std::size_t count);
+    Packet& readArray(Uint64* data, std::size_t count);
+    Packet& readArray(float*  data, std::size_t count);
+    Packet& readArray(double* data, std::size_t count);
+
 protected:
 
     friend class TcpSocket;
+    friend class UdpConnection;
     friend class UdpSocket;
+    template <typename T> friend class PacketSchema;
 
     ////////////////////////////////////////////////////////////
     /// \brief Called before the packet is sent over the network
@@ -277,13 +391,37 @@ private:
     ////////////////////////////////////////////////////////////
     bool checkSize(std::size_t size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Check if the packet can extract an array of values
+    ///
+    /// This function updates accordingly the state of the packet.
+    ///
+    /// \param count       Number of values to check
+    /// \param elementSize Size of a value, in bytes
+    ///
+    /// \return True if \a count values can be read from the packet
+    ///
+    ////////////////////////////////////////////////////////////
+    bool checkArraySize(std::size_t count, std::size_t elementSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Grow the packet's data, to fill it in place
+    ///
+    /// \param sizeInBytes Number of bytes to add (must not be 0)
+    ///
+    /// \return Pointer to the new, uninitialized bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    char* extend(std::size_t sizeInBytes);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::vector<char> m_data;    ///< Data stored in the packet
-    std::size_t       m_readPos; ///< Current reading position in the packet
-    std::size_t       m_sendPos; ///< Current send position in the packet (for handling partial sends)
-    bool              m_isValid; ///< Reading state of the packet
+    std::vector<char>      m_data;    ///< Data stored in the packet
+    std::size_t            m_readPos; ///< Current reading position in the packet
+    std::size_t            m_sendPos; ///< Current send position in the packet (for handling partial sends)
+    bool                   m_isValid; ///< Reading state of the packet
+    MemoryTracker::Counter m_memory;  ///< Reports the memory of the data
 };
 
 } // namespace sf
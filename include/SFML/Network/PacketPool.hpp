@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PACKETPOOL_HPP
+#define SFML_PACKETPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/System/FastMutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+class Packet;
+
+////////////////////////////////////////////////////////////
+/// \brief Thread-safe pool of reusable packets
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API PacketPool : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param maxFreePackets Maximum number of released packets kept for reuse
+    /// \param maxCapacity    Packets whose capacity exceeds this number of bytes are destroyed on release instead of being kept (0 for no limit)
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit PacketPool(std::size_t maxFreePackets = 256, std::size_t maxCapacity = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Destroys the packets kept for reuse. Packets that were
+    /// acquired and not released are not affected.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~PacketPool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get an empty packet
+    ///
+    /// A released packet is reused if there is one, its memory
+    /// is kept so that filling it again usually doesn't allocate.
+    /// Otherwise a new packet is created. The packet belongs to
+    /// the caller until it is given back with release.
+    ///
+    /// \return Empty packet
+    ///
+    /// \see release
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet* acquire();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give a packet back to the pool
+    ///
+    /// The packet must have been returned by acquire (of any
+    /// pool), and must not be used after this call.
+    ///
+    /// \param packet Packet to release (can be NULL)
+    ///
+    /// \see acquire
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(Packet* packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create packets in advance
+    ///
+    /// \param count    Number of packets to keep ready for reuse
+    /// \param capacity Memory to reserve in each of them, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t count, std::size_t capacity = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of packets kept for reuse
+    ///
+    /// \return Number of released packets waiting in the pool
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getFreeCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Packet*> m_free;           ///< Packets kept for reuse
+    std::size_t          m_maxFreePackets; ///< Maximum number of packets kept for reuse
+    std::size_t          m_maxCapacity;    ///< Maximum capacity of the packets kept for reuse
+    mutable FastMutex    m_mutex;          ///< Mutex protecting the free packets
+};
+
+} // namespace sf
+
+
+#endif // SFML_PACKETPOOL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PacketPool
+/// \ingroup network
+///
+/// A server that builds or receives a lot of packets spends
+/// a noticeable part of its time allocating and freeing their
+/// data. sf::PacketPool keeps the packets once they are used,
+/// with their memory, and hands them out again: once the pool
+/// has warmed up, building and receiving packets no longer
+/// allocates.
+///
+/// All the functions can be called from different threads,
+/// for example a network thread that receives into pooled
+/// packets and a game thread that releases them once they are
+/// processed.
+///
+/// Only sf::Packet instances are pooled; packets of derived
+/// classes must be managed separately.
+///
+/// Usage example:
+/// \code
+/// sf::PacketPool pool;
+///
+/// sf::Packet* packet = pool.acquire();
+/// if (socket.receive(*packet) == sf::Socket::Done)
+///     process(*packet);
+/// pool.release(packet);
+/// \endcode
+///
+/// \see sf::Packet
+///
+////////////////////////////////////////////////////////////
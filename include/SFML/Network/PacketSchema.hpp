@@ -0,0 +1,287 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PACKETSCHEMA_HPP
+#define SFML_PACKETSCHEMA_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Config.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Description of the fields of a message, to
+///        serialize it to packets in a single pass
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class PacketSchema
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Version selecting all the fields of the schema
+    ///
+    ////////////////////////////////////////////////////////////
+    static const Uint32 Latest = 0xFFFFFFFF;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a schema without fields.
+    ///
+    ////////////////////////////////////////////////////////////
+    PacketSchema();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a field to the schema
+    ///
+    /// Fields are serialized in the order they are added,
+    /// with the same encoding as the Packet::operator <<
+    /// and Packet::operator >> overloads, so that packets
+    /// written with a schema can be read field by field and
+    /// conversely.
+    ///
+    /// A field only exists in the messages whose version is
+    /// greater than or equal to \a version: fields added by
+    /// newer versions of the protocol are skipped when older
+    /// messages are written or read, and keep their current
+    /// value in the latter case.
+    ///
+    /// \param member  Pointer to the member to serialize
+    /// \param version Version of the message that introduced the field
+    ///
+    /// \return Reference to the schema, to chain the calls
+    ///
+    ////////////////////////////////////////////////////////////
+    PacketSchema& add(bool        T::* member, Uint32 version = 0);
+    PacketSchema& add(Int8        T::* member, Uint32 version = 0);
+    PacketSchema& add(Uint8       T::* member, Uint32 version = 0);
+    PacketSchema& add(Int16       T::* member, Uint32 version = 0);
+    PacketSchema& add(Uint16      T::* member, Uint32 version = 0);
+    PacketSchema& add(Int32       T::* member, Uint32 version = 0);
+    PacketSchema& add(Uint32      T::* member, Uint32 version = 0);
+    PacketSchema& add(Int64       T::* member, Uint32 version = 0);
+    PacketSchema& add(Uint64      T::* member, Uint32 version = 0);
+    PacketSchema& add(float       T::* member, Uint32 version = 0);
+    PacketSchema& add(double      T::* member, Uint32 version = 0);
+    PacketSchema& add(std::string T::* member, Uint32 version = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of fields of the schema
+    ///
+    /// \return Number of fields, of all versions
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getFieldCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bytes taken by a message
+    ///
+    /// \param value   Message to measure
+    /// \param version Version of the message
+    ///
+    /// \return Size of the serialized message, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize(const T& value, Uint32 version = Latest) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a message to a packet
+    ///
+    /// The size of the message is computed first, so that
+    /// the packet grows only once; the fields are then
+    /// written directly into the packet's data.
+    ///
+    /// \param packet  Packet to append the message to
+    /// \param value   Message to write
+    /// \param version Version of the message to write
+    ///
+    /// \see read
+    ///
+    ////////////////////////////////////////////////////////////
+    void write(Packet& packet, const T& value, Uint32 version = Latest) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Extract a message from a packet
+    ///
+    /// The fixed-size part of the message is checked against
+    /// the remaining data of the packet at once; only the
+    /// characters of the strings need another check each.
+    /// If the packet is too short, it becomes invalid like
+    /// with the extraction operators, and the fields read so
+    /// far keep their new value.
+    ///
+    /// \param packet  Packet to read the message from
+    /// \param value   Message to fill
+    /// \param version Version of the message to read
+    ///
+    /// \return True if the message was read successfully
+    ///
+    /// \see write
+    ///
+    ////////////////////////////////////////////////////////////
+    bool read(Packet& packet, T& value, Uint32 version = Latest) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Types of the fields
+    ///
+    ////////////////////////////////////////////////////////////
+    enum FieldType
+    {
+        BoolField,
+        Int8Field,
+        Uint8Field,
+        Int16Field,
+        Uint16Field,
+        Int32Field,
+        Uint32Field,
+        Int64Field,
+        Uint64Field,
+        FloatField,
+        DoubleField,
+        StringField
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Description of a field
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Field
+    {
+        FieldType type;    ///< Type of the member, selects the valid pointer below
+        Uint32    version; ///< First version of the message containing the field
+        union
+        {
+            bool        T::* boolean;
+            Int8        T::* int8;
+            Uint8       T::* uint8;
+            Int16       T::* int16;
+            Uint16      T::* uint16;
+            Int32       T::* int32;
+            Uint32      T::* uint32;
+            Int64       T::* int64;
+            Uint64      T::* uint64;
+            float       T::* real;
+            double      T::* doubleReal;
+            std::string T::* string;
+        } member;          ///< Pointer to the member
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a field, whose member pointer is set by the caller
+    ///
+    /// \param type    Type of the field
+    /// \param version First version of the message containing the field
+    ///
+    /// \return Reference to the new field
+    ///
+    ////////////////////////////////////////////////////////////
+    Field& addField(FieldType type, Uint32 version);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the fixed-size part of a field
+    ///
+    /// \param type Type of the field
+    ///
+    /// \return Size of the field, or of the length prefix of strings
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t getFixedSize(FieldType type);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Field> m_fields; ///< Fields, in serialization order
+};
+
+} // namespace sf
+
+#include <SFML/Network/PacketSchema.inl>
+
+#endif // SFML_PACKETSCHEMA_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PacketSchema
+/// \ingroup network
+///
+/// Writing a message with the Packet operators appends and
+/// checks each field separately. sf::PacketSchema describes
+/// the fields of a message once, as pointers to the members
+/// of a structure, then serializes whole messages: the packet
+/// grows once per message, and reading checks the size of
+/// all the fixed-size fields at once. The encoding is the
+/// same as the Packet operators, so the two can be mixed.
+///
+/// Fields can be tagged with the version of the protocol that
+/// introduced them. Old peers keep reading and writing the
+/// fields they know, the others are skipped without touching
+/// the packet. The schema doesn't store the version in the
+/// messages; it is usually negotiated once per connection,
+/// or sent in a header before the messages.
+///
+/// Usage example:
+/// \code
+/// struct PlayerState
+/// {
+///     sf::Uint32  id;
+///     float       x;
+///     float       y;
+///     sf::Uint16  health;
+///     std::string name;
+///     sf::Uint8   team; // added by version 2 of the protocol
+/// };
+///
+/// sf::PacketSchema<PlayerState> schema;
+/// schema.add(&PlayerState::id)
+///       .add(&PlayerState::x)
+///       .add(&PlayerState::y)
+///       .add(&PlayerState::health)
+///       .add(&PlayerState::name)
+///       .add(&PlayerState::team, 2);
+///
+/// // Sending side
+/// sf::Packet packet;
+/// for (std::size_t i = 0; i < players.size(); ++i)
+///     schema.write(packet, players[i], peerVersion);
+/// socket.send(packet);
+///
+/// // Receiving side
+/// PlayerState state;
+/// while (!packet.endOfPacket() && schema.read(packet, state, peerVersion))
+///     updatePlayer(state);
+/// \endcode
+///
+/// \see sf::Packet
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,405 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstring>
+
+
+namespace sf
+{
+namespace priv
+{
+    // Write an unsigned integer in network byte order (big endian), like sf::Packet
+    template <typename U>
+    char* writeSchemaInteger(char* data, U value)
+    {
+        for (std::size_t i = 0; i < sizeof(U); ++i)
+            data[i] = static_cast<char>(static_cast<Uint8>(value >> ((sizeof(U) - 1 - i) * 8)));
+
+        return data + sizeof(U);
+    }
+
+    // Read an unsigned integer stored in network byte order (big endian)
+    template <typename U>
+    const char* readSchemaInteger(const char* data, U& value)
+    {
+        value = 0;
+        for (std::size_t i = 0; i < sizeof(U); ++i)
+            value = static_cast<U>((value << 8) | static_cast<Uint8>(data[i]));
+
+        return data + sizeof(U);
+    }
+
+    // Copy a value as is (sf::Packet doesn't convert floating point numbers)
+    template <typename U>
+    char* writeSchemaRaw(char* data, const U& value)
+    {
+        std::memcpy(data, &value, sizeof(U));
+        return data + sizeof(U);
+    }
+
+    // Read a value stored as is
+    template <typename U>
+    const char* readSchemaRaw(const char* data, U& value)
+    {
+        std::memcpy(&value, data, sizeof(U));
+        return data + sizeof(U);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+const Uint32 PacketSchema<T>::Latest;
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+PacketSchema<T>::PacketSchema() :
+m_fields()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+PacketSchema<T>& PacketSchema<T>::add(bool T::* member, Uint32 version)
+{
+    addField(BoolField, version).member.boolean = member;
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+PacketSchema<T>& PacketSchema<T>::add(Int8 T::* member, Uint32 version)
+{
+    addField(Int8Field, version).member.int8 = member;
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+PacketSchema<T>& PacketSchema<T>::add(Uint8 T::* member, Uint32 version)
+{
+    addField(Uint8Field, version).member.uint8 = member;
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+PacketSchema<T>& PacketSchema<T>::add(Int16 T::* member, Uint32 version)
+{
+    addField(Int16Field, version).member.int16 = member;
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+PacketSchema<T>& PacketSchema<T>::add(Uint16 T::* member, Uint32 version)
+{
+    addField(Uint16Field, version).member.uint16 = member;
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+PacketSchema<T>& PacketSchema<T>::add(Int32 T::* member, Uint32 version)
+{
+    addField(Int32Field, version).member.int32 = member;
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+PacketSchema<T>& PacketSchema<T>::add(Uint32 T::* member, Uint32 version)
+{
+    addField(Uint32Field, version).member.uint32 = member;
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+PacketSchema<T>& PacketSchema<T>::add(Int64 T::* member, Uint32 version)
+{
+    addField(Int64Field, version).member.int64 = member;
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+PacketSchema<T>& PacketSchema<T>::add(Uint64 T::* member, Uint32 version)
+{
+    addField(Uint64Field, version).member.uint64 = member;
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+PacketSchema<T>& PacketSchema<T>::add(float T::* member, Uint32 version)
+{
+    addField(FloatField, version).member.real = member;
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+PacketSchema<T>& PacketSchema<T>::add(double T::* member, Uint32 version)
+{
+    addField(DoubleField, version).member.doubleReal = member;
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+PacketSchema<T>& PacketSchema<T>::add(std::string T::* member, Uint32 version)
+{
+    addField(StringField, version).member.string = member;
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t PacketSchema<T>::getFieldCount() const
+{
+    return m_fields.size();
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t PacketSchema<T>::getSize(const T& value, Uint32 version) const
+{
+    std::size_t size = 0;
+    for (typename std::vector<Field>::const_iterator it = m_fields.begin(); it != m_fields.end(); ++it)
+    {
+        if (it->version > version)
+            continue;
+
+        size += getFixedSize(it->type);
+        if (it->type == StringField)
+            size += (value.*it->member.string).size();
+    }
+
+    return size;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void PacketSchema<T>::write(Packet& packet, const T& value, Uint32 version) const
+{
+    std::size_t size = getSize(value, version);
+    if (size == 0)
+        return;
+
+    // Grow the packet once, then fill the new bytes without any check
+    char* data = packet.extend(size);
+
+    for (typename std::vector<Field>::const_iterator it = m_fields.begin(); it != m_fields.end(); ++it)
+    {
+        const Field& field = *it;
+        if (field.version > version)
+            continue;
+
+        switch (field.type)
+        {
+            case BoolField:   data = priv::writeSchemaInteger(data, static_cast<Uint8>((value.*field.member.boolean) ? 1 : 0)); break;
+            case Int8Field:   data = priv::writeSchemaInteger(data, static_cast<Uint8>(value.*field.member.int8));               break;
+            case Uint8Field:  data = priv::writeSchemaInteger(data, value.*field.member.uint8);                                  break;
+            case Int16Field:  data = priv::writeSchemaInteger(data, static_cast<Uint16>(value.*field.member.int16));             break;
+            case Uint16Field: data = priv::writeSchemaInteger(data, value.*field.member.uint16);                                 break;
+            case Int32Field:  data = priv::writeSchemaInteger(data, static_cast<Uint32>(value.*field.member.int32));             break;
+            case Uint32Field: data = priv::writeSchemaInteger(data, value.*field.member.uint32);                                 break;
+            case Int64Field:  data = priv::writeSchemaInteger(data, static_cast<Uint64>(value.*field.member.int64));             break;
+            case Uint64Field: data = priv::writeSchemaInteger(data, value.*field.member.uint64);                                 break;
+            case FloatField:  data = priv::writeSchemaRaw(data, value.*field.member.real);                                       break;
+            case DoubleField: data = priv::writeSchemaRaw(data, value.*field.member.doubleReal);                                 break;
+
+            case StringField:
+            {
+                const std::string& string = value.*field.member.string;
+                data = priv::writeSchemaInteger(data, static_cast<Uint32>(string.size()));
+                if (!string.empty())
+                    std::memcpy(data, string.data(), string.size());
+                data += string.size();
+                break;
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool PacketSchema<T>::read(Packet& packet, T& value, Uint32 version) const
+{
+    // Check the fixed-size part of all the fields at once
+    std::size_t remaining = 0;
+    for (typename std::vector<Field>::const_iterator it = m_fields.begin(); it != m_fields.end(); ++it)
+    {
+        if (it->version <= version)
+            remaining += getFixedSize(it->type);
+    }
+
+    if (!packet.checkSize(remaining))
+        return false;
+
+    if (remaining == 0)
+        return true;
+
+    const char* begin = &packet.m_data[0];
+    const char* data = begin + packet.m_readPos;
+
+    for (typename std::vector<Field>::const_iterator it = m_fields.begin(); it != m_fields.end(); ++it)
+    {
+        const Field& field = *it;
+        if (field.version > version)
+            continue;
+
+        remaining -= getFixedSize(field.type);
+
+        switch (field.type)
+        {
+            case BoolField:
+            {
+                Uint8 boolean = 0;
+                data = priv::readSchemaInteger(data, boolean);
+                value.*field.member.boolean = (boolean != 0);
+                break;
+            }
+
+            case Int8Field:
+            {
+                Uint8 integer = 0;
+                data = priv::readSchemaInteger(data, integer);
+                value.*field.member.int8 = static_cast<Int8>(integer);
+                break;
+            }
+
+            case Int16Field:
+            {
+                Uint16 integer = 0;
+                data = priv::readSchemaInteger(data, integer);
+                value.*field.member.int16 = static_cast<Int16>(integer);
+                break;
+            }
+
+            case Int32Field:
+            {
+                Uint32 integer = 0;
+                data = priv::readSchemaInteger(data, integer);
+                value.*field.member.int32 = static_cast<Int32>(integer);
+                break;
+            }
+
+            case Int64Field:
+            {
+                Uint64 integer = 0;
+                data = priv::readSchemaInteger(data, integer);
+                value.*field.member.int64 = static_cast<Int64>(integer);
+                break;
+            }
+
+            case Uint8Field:  data = priv::readSchemaInteger(data, value.*field.member.uint8);  break;
+            case Uint16Field: data = priv::readSchemaInteger(data, value.*field.member.uint16); break;
+            case Uint32Field: data = priv::readSchemaInteger(data, value.*field.member.uint32); break;
+            case Uint64Field: data = priv::readSchemaInteger(data, value.*field.member.uint64); break;
+            case FloatField:  data = priv::readSchemaRaw(data, value.*field.member.real);       break;
+            case DoubleField: data = priv::readSchemaRaw(data, value.*field.member.doubleReal); break;
+
+            case StringField:
+            {
+                Uint32 length = 0;
+                data = priv::readSchemaInteger(data, length);
+
+                // The characters must fit before the fixed-size fields that follow
+                std::string& string = value.*field.member.string;
+                packet.m_readPos = static_cast<std::size_t>(data - begin);
+                if (!packet.checkSize(static_cast<std::size_t>(length) + remaining))
+                    return false;
+
+                string.assign(data, length);
+                data += length;
+                break;
+            }
+        }
+    }
+
+    packet.m_readPos = static_cast<std::size_t>(data - begin);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+typename PacketSchema<T>::Field& PacketSchema<T>::addField(FieldType type, Uint32 version)
+{
+    Field field;
+    field.type    = type;
+    field.version = version;
+    m_fields.push_back(field);
+
+    return m_fields.back();
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t PacketSchema<T>::getFixedSize(FieldType type)
+{
+    switch (type)
+    {
+        case BoolField:
+        case Int8Field:
+        case Uint8Field:  return 1;
+        case Int16Field:
+        case Uint16Field: return 2;
+        case Int32Field:
+        case Uint32Field: return 4;
+        case Int64Field:
+        case Uint64Field: return 8;
+        case FloatField:  return sizeof(float);
+        case DoubleField: return sizeof(double);
+        case StringField: return 4;
+    }
+
+    return 0;
+}
+
+} // namespace sf
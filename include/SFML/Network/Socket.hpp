@@ -31,11 +31,14 @@
 #include <SFML/Network/Export.hpp>
 #include <SFML/Network/SocketHandle.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <map>
 #include <vector>
 
 
 namespace sf
 {
+class IpAddress;
+
 class SocketSelector;
 
 ////////////////////////////////////////////////////////////
@@ -68,6 +71,36 @@ public:
         AnyPort = 0 ///< Special value that tells the system to pick any available port
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Options that tune the behaviour of the socket
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Option
+    {
+        SendBufferSize,      ///< Size of the system send buffer, in bytes (SO_SNDBUF)
+        ReceiveBufferSize,   ///< Size of the system receive buffer, in bytes (SO_RCVBUF)
+        TypeOfService,       ///< Type of service / traffic class byte of the outgoing packets, i.e. DSCP << 2 (IP_TOS, IPV6_TCLASS)
+        BusyPoll,            ///< Time to busy-poll the device when receiving, in microseconds (SO_BUSY_POLL, Linux only)
+        NoDelay,             ///< TCP only, non-zero to send small packets immediately (TCP_NODELAY, enabled by default)
+        QuickAck,            ///< TCP only, non-zero to acknowledge received data immediately (TCP_QUICKACK, Linux only)
+        SegmentationOffload, ///< UDP only, size of the datagrams that sent data is split into, 0 to disable (UDP_SEGMENT, Linux only)
+        ReceiveOffload       ///< UDP only, non-zero to let the system coalesce received datagrams (UDP_GRO, Linux only)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Traffic counters of a socket
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        Uint64 bytesSent;       ///< Number of bytes given to the system
+        Uint64 bytesReceived;   ///< Number of bytes read from the system
+        Uint64 packetsSent;     ///< Number of sf::Packet (or datagrams) completely sent
+        Uint64 packetsReceived; ///< Number of sf::Packet (or datagrams) completely received
+        Uint64 partialSends;    ///< Number of sends that the system only accepted partially
+        Uint64 notReady;        ///< Number of operations that returned NotReady
+    };
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -105,6 +138,69 @@ public:
     ////////////////////////////////////////////////////////////
     bool isBlocking() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the value of a socket option
+    ///
+    /// The options can be set at any time: if the socket is not
+    /// created yet, they are stored and applied when it is.
+    /// They are kept if the socket is closed and created again.
+    ///
+    /// Options that are not available on the system make this
+    /// function return false. Note that on Linux, QuickAck is
+    /// not permanent: the system can go back to delayed
+    /// acknowledgements, so it must be set again after each
+    /// receive call if needed.
+    ///
+    /// \param option Option to set
+    /// \param value  New value of the option
+    ///
+    /// \return True if the option was set, false if it is not supported or was refused
+    ///
+    /// \see getOption
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setOption(Option option, int value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the value of a socket option
+    ///
+    /// This function returns the value given to setOption, or
+    /// the current value of the system if the option was never
+    /// set. It returns 0 if the option is not supported or
+    /// the socket is not created yet.
+    ///
+    /// \param option Option to get
+    ///
+    /// \return Value of the option
+    ///
+    /// \see setOption
+    ///
+    ////////////////////////////////////////////////////////////
+    int getOption(Option option) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the traffic counters of the socket
+    ///
+    /// The counters are updated by the send and receive
+    /// functions, and can be read from any thread.
+    /// They are kept if the socket is closed and created
+    /// again, until resetStatistics is called.
+    ///
+    /// \return Current value of the counters
+    ///
+    /// \see resetStatistics, SocketMonitor
+    ///
+    ////////////////////////////////////////////////////////////
+    Statistics getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set all the traffic counters of the socket to zero
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -117,6 +213,22 @@ protected:
         Udp  ///< UDP protocol
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Traffic counters updated by the derived classes
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Counter
+    {
+        BytesSent,       ///< Bytes given to the system
+        BytesReceived,   ///< Bytes read from the system
+        PacketsSent,     ///< Packets or datagrams completely sent
+        PacketsReceived, ///< Packets or datagrams completely received
+        PartialSends,    ///< Sends that returned Partial
+        NotReadyReturns, ///< Operations that returned NotReady
+
+        CounterCount     ///< Keep last -- the total number of counters
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -142,11 +254,27 @@ protected:
     ////////////////////////////////////////////////////////////
     /// \brief Create the internal representation of the socket
     ///
+    /// The socket is a dual-stack IPv6 socket, which can reach
+    /// both IPv4 and IPv6 addresses, if the system supports it;
+    /// otherwise it is an IPv4 socket.
     /// This function can only be accessed by derived classes.
     ///
     ////////////////////////////////////////////////////////////
     void create();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the internal representation of the socket
+    ///        for a given address
+    ///
+    /// IPv4 addresses get an IPv4 socket, IPv6 addresses get a
+    /// (dual-stack if possible) IPv6 socket.
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param address Address that the socket will bind or connect to
+    ///
+    ////////////////////////////////////////////////////////////
+    void create(const IpAddress& address);
+
     ////////////////////////////////////////////////////////////
     /// \brief Create the internal representation of the socket
     ///        from a socket handle
@@ -158,6 +286,18 @@ protected:
     ////////////////////////////////////////////////////////////
     void create(SocketHandle handle);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the internal representation of the socket
+    ///        from a socket handle of a known family
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param handle OS-specific handle of the socket to wrap
+    /// \param ipv6   Is the socket an IPv6 one?
+    ///
+    ////////////////////////////////////////////////////////////
+    void create(SocketHandle handle, bool ipv6);
+
     ////////////////////////////////////////////////////////////
     /// \brief Close the socket gracefully
     ///
@@ -166,16 +306,87 @@ protected:
     ////////////////////////////////////////////////////////////
     void close();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the socket is an IPv6 one
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \return True if the socket uses IPv6, false if it uses IPv4 (or is not created)
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isIpv6() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a value to one of the traffic counters
+    ///
+    /// The cost is a single relaxed atomic addition.
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param counter Counter to update
+    /// \param amount  Value to add to the counter
+    ///
+    ////////////////////////////////////////////////////////////
+    void record(Counter counter, Uint64 amount = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the traffic counters from a status code
+    ///
+    /// Partial and NotReady are counted, other codes are ignored.
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param status Status returned by a system call
+    ///
+    /// \return \a status, so that it can be returned directly
+    ///
+    ////////////////////////////////////////////////////////////
+    Status recordStatus(Status status);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a capture handler is installed
+    ///
+    /// Derived classes can use this function to skip the
+    /// preparation of data that would only be captured.
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \return True if packets are being captured
+    ///
+    /// \see SocketMonitor::setCaptureHandler
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isCaptureEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forward a packet to the capture handler, if any
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param sent    True for an outgoing packet, false for an incoming one
+    /// \param data    Payload of the packet, as it is on the wire
+    /// \param size    Size of the payload, in bytes
+    /// \param address Address of the peer
+    /// \param port    Port of the peer
+    ///
+    ////////////////////////////////////////////////////////////
+    void capture(bool sent, const void* data, std::size_t size, const IpAddress& address, unsigned short port) const;
+
 private:
 
     friend class SocketSelector;
 
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<Option, int> OptionTable;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Type         m_type;       ///< Type of the socket (TCP or UDP)
-    SocketHandle m_socket;     ///< Socket descriptor
-    bool         m_isBlocking; ///< Current blocking mode of the socket
+    Type         m_type;                   ///< Type of the socket (TCP or UDP)
+    SocketHandle m_socket;                 ///< Socket descriptor
+    bool         m_isBlocking;             ///< Current blocking mode of the socket
+    bool         m_isIpv6;                 ///< Does the socket use IPv6?
+    OptionTable  m_options;                ///< Options set by the user, applied whenever the socket is created
+    Uint64       m_counters[CounterCount]; ///< Traffic counters
 };
 
 } // namespace sf
@@ -214,6 +425,11 @@ private:
 /// the socket often enough, and cannot afford blocking
 /// this loop.
 ///
-/// \see sf::TcpListener, sf::TcpSocket, sf::UdpSocket
+/// All sockets also count the traffic that goes through
+/// them (see getStatistics). The counters of all the
+/// sockets of the program, and a hook to capture the
+/// packets, are available through sf::SocketMonitor.
+///
+/// \see sf::TcpListener, sf::TcpSocket, sf::UdpSocket, sf::SocketMonitor
 ///
 ////////////////////////////////////////////////////////////
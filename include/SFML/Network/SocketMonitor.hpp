@@ -0,0 +1,219 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SOCKETMONITOR_HPP
+#define SFML_SOCKETMONITOR_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/Socket.hpp>
+#include <SFML/System/Time.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class IpAddress;
+
+////////////////////////////////////////////////////////////
+/// \brief Give access to the traffic counters of all the
+///        sockets, and capture the packets that they exchange
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API SocketMonitor
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Interface of the objects that receive the captured packets
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_NETWORK_API CaptureHandler
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Virtual destructor
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ~CaptureHandler();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Handle a packet sent or received by a socket
+        ///
+        /// This function is called from the thread that sends or
+        /// receives the packet; calls are never concurrent.
+        /// The data is only valid during the call.
+        ///
+        /// \param socket    Socket that sent or received the packet
+        /// \param sent      True for an outgoing packet, false for an incoming one
+        /// \param timestamp Time of the capture, since the first use of the monitor
+        /// \param data      Payload of the packet, as it is on the wire
+        /// \param size      Size of the payload, in bytes
+        /// \param address   Address of the peer
+        /// \param port      Port of the peer
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void onPacket(const Socket& socket, bool sent, Time timestamp, const void* data, std::size_t size, const IpAddress& address, unsigned short port) = 0;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Traffic counters of a single socket
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SocketStatistics
+    {
+        const Socket*      socket;     ///< Socket that the counters belong to
+        Socket::Statistics statistics; ///< Counters of the socket
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Install the object that receives the captured packets
+    ///
+    /// The packets are captured as long as a handler is
+    /// installed. When this function returns, the previous
+    /// handler is no longer in use and can be destroyed.
+    ///
+    /// \param handler New capture handler, or NULL to stop capturing
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setCaptureHandler(CaptureHandler* handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the traffic counters of all the existing sockets
+    ///
+    /// The socket pointers are only meant to identify the
+    /// sockets: they may be destroyed right after this
+    /// function returns.
+    ///
+    /// \param sockets Array to fill with the counters (previous content is cleared)
+    ///
+    ////////////////////////////////////////////////////////////
+    static void getSockets(std::vector<SocketStatistics>& sockets);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sum of the counters of all the sockets
+    ///
+    /// The sum includes the sockets that were destroyed.
+    ///
+    /// \return Total traffic of the program
+    ///
+    ////////////////////////////////////////////////////////////
+    static Socket::Statistics getTotalStatistics();
+
+private:
+
+    friend class Socket;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Register a new socket
+    ///
+    /// \param socket Socket to register
+    ///
+    ////////////////////////////////////////////////////////////
+    static void add(const Socket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unregister a socket that is being destroyed
+    ///
+    /// \param socket Socket to unregister
+    ///
+    ////////////////////////////////////////////////////////////
+    static void remove(const Socket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a capture handler is installed
+    ///
+    /// \return True if packets are being captured
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isCapturing();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forward a packet to the capture handler
+    ///
+    /// \param socket  Socket that sent or received the packet
+    /// \param sent    True for an outgoing packet
+    /// \param data    Payload of the packet
+    /// \param size    Size of the payload, in bytes
+    /// \param address Address of the peer
+    /// \param port    Port of the peer
+    ///
+    ////////////////////////////////////////////////////////////
+    static void capture(const Socket& socket, bool sent, const void* data, std::size_t size, const IpAddress& address, unsigned short port);
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOCKETMONITOR_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SocketMonitor
+/// \ingroup network
+///
+/// sf::SocketMonitor gives a global view of the network
+/// traffic of the program: every socket registers itself
+/// when it is constructed, and its counters (see
+/// sf::Socket::getStatistics) can be listed from any thread.
+///
+/// The counters are updated with relaxed atomic additions,
+/// so they cost almost nothing on the send and receive paths;
+/// the registry itself is only locked when a socket is
+/// constructed or destroyed, and when it is listed.
+///
+/// A capture handler can also be installed to log the
+/// sf::Packet instances exchanged by sf::TcpSocket and
+/// sf::UdpSocket: each packet is reported once it is
+/// completely sent or received, as the bytes that travel
+/// on the wire (i.e. after sf::Packet::onSend and before
+/// sf::Packet::onReceive). Raw data, sent or received
+/// without sf::Packet, is only counted. Capturing is meant
+/// for debugging: it makes all the sockets share a lock.
+///
+/// Usage example:
+/// \code
+/// class Logger : public sf::SocketMonitor::CaptureHandler
+/// {
+///     virtual void onPacket(const sf::Socket& socket, bool sent, sf::Time timestamp, const void* data, std::size_t size, const sf::IpAddress& address, unsigned short port)
+///     {
+///         std::cout << timestamp.asSeconds() << (sent ? " to " : " from ") << address << ":" << port << ", " << size << " bytes" << std::endl;
+///     }
+/// };
+///
+/// Logger logger;
+/// sf::SocketMonitor::setCaptureHandler(&logger);
+/// ...
+/// sf::SocketMonitor::setCaptureHandler(NULL);
+///
+/// sf::Socket::Statistics total = sf::SocketMonitor::getTotalStatistics();
+/// std::cout << total.bytesSent << " bytes sent" << std::endl;
+/// \endcode
+///
+/// \see sf::Socket
+///
+////////////////////////////////////////////////////////////
@@ -30,6 +30,8 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
 #include <SFML/System/Time.hpp>
+#include <cstddef>
+#include <vector>
 
 
 namespace sf
@@ -44,6 +46,31 @@ class SFML_NETWORK_API SocketSelector
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Events that a socket can be watched for
+    ///
+    /// The values can be combined with a bitwise OR.
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Event
+    {
+        Receive       = 1 << 0, ///< The socket has data to receive, or a pending connection for a listener
+        Send          = 1 << 1, ///< The socket can send more data
+        Error         = 1 << 2, ///< An error happened on the socket, or the peer closed the connection
+        EdgeTriggered = 1 << 3  ///< Only report the events when they happen, not while their condition lasts (ignored on Windows)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Events that happened on a socket
+    ///
+    ////////////////////////////////////////////////////////////
+    struct ReadyEvent
+    {
+        Socket* socket;   ///< Socket that is ready
+        Uint32  events;   ///< Combination of the events that happened (Receive, Send, Error)
+        void*   userData; ///< User data attached to the socket when it was added
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -71,13 +98,41 @@ public:
     /// so you have to make sure that the socket is not destroyed
     /// while it is stored in the selector.
     /// This function does nothing if the socket is not valid.
+    /// Adding a socket that is already in the selector replaces
+    /// its events and user data.
+    ///
+    /// Watching the Send event is mostly useful after a send
+    /// returned Partial or NotReady on a non-blocking socket;
+    /// since a connected socket can almost always send, it is
+    /// best to only enable it while data is pending (see
+    /// setEvents).
+    ///
+    /// With EdgeTriggered, an event is reported once when it
+    /// happens, so a non-blocking socket must then be read (or
+    /// written) until it returns NotReady.
     ///
-    /// \param socket Reference to the socket to add
+    /// \param socket   Reference to the socket to add
+    /// \param events   Combination of the events to watch
+    /// \param userData Pointer returned with the events of the socket in getReadyEvents
     ///
-    /// \see remove, clear
+    /// \see remove, clear, setEvents
     ///
     ////////////////////////////////////////////////////////////
-    void add(Socket& socket);
+    void add(Socket& socket, Uint32 events = Receive, void* userData = NULL);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the events watched on a socket
+    ///
+    /// This function does nothing if the socket is not in
+    /// the selector. Its user data is kept.
+    ///
+    /// \param socket Socket to modify
+    /// \param events Combination of the events to watch
+    ///
+    /// \see add
+    ///
+    ////////////////////////////////////////////////////////////
+    void setEvents(Socket& socket, Uint32 events);
 
     ////////////////////////////////////////////////////////////
     /// \brief Remove a socket from the selector
@@ -105,11 +160,12 @@ public:
     void clear();
 
     ////////////////////////////////////////////////////////////
-    /// \brief Wait until one or more sockets are ready to receive
+    /// \brief Wait until one or more sockets are ready
     ///
-    /// This function returns as soon as at least one socket has
-    /// some data available to be received. To know which sockets are
-    /// ready, use the isReady function.
+    /// This function returns as soon as one of the watched events
+    /// happens on at least one socket (by default, some data is
+    /// available to be received). To know which sockets are ready,
+    /// use the isReady, getReadySockets or getReadyEvents functions.
     /// If you use a timeout and no socket is ready before the timeout
     /// is over, the function returns false.
     ///
@@ -117,7 +173,7 @@ public:
     ///
     /// \return True if there are sockets ready, false otherwise
     ///
-    /// \see isReady
+    /// \see isReady, getReadySockets, getReadyEvents
     ///
     ////////////////////////////////////////////////////////////
     bool wait(Time timeout = Time::Zero);
@@ -133,13 +189,47 @@ public:
     /// this means that it is ready to accept a new connection.
     ///
     /// \param socket Socket to test
+    /// \param events Combination of the events to test
     ///
-    /// \return True if the socket is ready to read, false otherwise
+    /// \return True if one of \a events happened on the socket, false otherwise
     ///
-    /// \see isReady
+    /// \see wait
     ///
     ////////////////////////////////////////////////////////////
-    bool isReady(Socket& socket) const;
+    bool isReady(Socket& socket, Uint32 events = Receive) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sockets that are ready
+    ///
+    /// This function must be used after a call to wait. Unlike
+    /// calling isReady on every socket, its cost only depends
+    /// on the number of sockets that are actually ready, which
+    /// matters when the selector contains many sockets.
+    ///
+    /// The pointers are the ones of the sockets passed to add;
+    /// the list is valid until the next call to wait, remove
+    /// or clear.
+    ///
+    /// \return Sockets that were ready after the last call to wait
+    ///
+    /// \see wait, isReady
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::vector<Socket*>& getReadySockets() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the events that happened on the ready sockets
+    ///
+    /// This is the same list as getReadySockets, with the
+    /// events of each socket and the user data given to add,
+    /// so that the sockets can be dispatched without lookup.
+    ///
+    /// \return Events of the sockets that were ready after the last call to wait
+    ///
+    /// \see wait, getReadySockets
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::vector<ReadyEvent>& getReadyEvents() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
@@ -194,7 +284,19 @@ private:
 /// Using a selector is simple:
 /// \li populate the selector with all the sockets that you want to observe
 /// \li make it wait until there is data available on any of the sockets
-/// \li test each socket to find out which ones are ready
+/// \li test each socket to find out which ones are ready, or iterate
+///     directly over the ready ones with getReadySockets
+///
+/// Besides incoming data, a selector can watch when a socket is
+/// able to send more data (useful after a partial send on a
+/// non-blocking socket) and when an error happens. Each socket
+/// can carry a user data pointer, returned with its events by
+/// getReadyEvents.
+///
+/// Selectors use epoll on Linux and Android and kqueue on Mac OS X,
+/// iOS and FreeBSD, so they handle thousands of sockets efficiently
+/// and don't limit the value of the socket handles. On Windows, they
+/// are based on select and can't contain more than FD_SETSIZE sockets.
 ///
 /// Usage example:
 /// \code
@@ -258,6 +360,22 @@ private:
 /// }
 /// \endcode
 ///
+/// With many clients, iterating over the ready sockets is faster
+/// than testing every socket:
+/// \code
+/// if (selector.wait())
+/// {
+///     const std::vector<sf::Socket*>& ready = selector.getReadySockets();
+///     for (std::size_t i = 0; i < ready.size(); ++i)
+///     {
+///         if (ready[i] == &listener)
+///             ... // accept a new connection
+///         else
+///             ... // receive from static_cast<sf::TcpSocket*>(ready[i])
+///     }
+/// }
+/// \endcode
+///
 /// \see sf::Socket
 ///
 ////////////////////////////////////////////////////////////
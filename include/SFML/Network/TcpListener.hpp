@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
+#include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/Socket.hpp>
 
 
@@ -63,6 +64,37 @@ public:
     ////////////////////////////////////////////////////////////
     unsigned short getLocalPort() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the sharing of the listening port
+    ///
+    /// When port sharing is enabled, several listeners (usually
+    /// one per thread or per process) can listen to the same
+    /// port at the same time. On Linux, the system then spreads
+    /// the incoming connections evenly among them (SO_REUSEPORT),
+    /// so that each thread can accept its own connections
+    /// without contention.
+    /// All the listeners sharing a port must enable it, and it
+    /// must be enabled before calling listen. Port sharing is
+    /// not supported on Windows.
+    /// Port sharing is disabled by default.
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    /// \see isPortSharingEnabled, listen
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPortSharingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the sharing of the listening port is enabled
+    ///
+    /// \return True if port sharing is enabled, false otherwise
+    ///
+    /// \see setPortSharingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isPortSharingEnabled() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Start listening for connections
     ///
@@ -70,15 +102,20 @@ public:
     /// port, waiting for new connections.
     /// If the socket was previously listening to another port,
     /// it will be stopped first and bound to the new port.
+    /// By default the listener accepts IPv4 and IPv6 connections
+    /// on all the interfaces (if the system supports dual-stack
+    /// sockets, IPv4 only otherwise); give a local address to
+    /// listen on a single interface.
     ///
-    /// \param port Port to listen for new connections
+    /// \param port    Port to listen for new connections
+    /// \param address Local address to listen on
     ///
     /// \return Status code
     ///
     /// \see accept, close
     ///
     ////////////////////////////////////////////////////////////
-    Status listen(unsigned short port);
+    Status listen(unsigned short port, const IpAddress& address = IpAddress::Any);
 
     ////////////////////////////////////////////////////////////
     /// \brief Stop listening and close the socket
@@ -105,6 +142,38 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     Status accept(TcpSocket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Accept all the pending connections at once
+    ///
+    /// The pending connections are accepted into the given
+    /// sockets, in order, until there is no more waiting
+    /// connection or all the sockets are used.
+    ///
+    /// In blocking mode, this function waits until at least one
+    /// connection is received; it then accepts the ones that
+    /// are already waiting without blocking. This is typically
+    /// called once the listener is reported ready by a
+    /// sf::SocketSelector, to serve a burst of connections in a
+    /// single wake-up.
+    ///
+    /// \param sockets  Array of sockets that will hold the new connections
+    /// \param count    Number of sockets in the array
+    /// \param accepted The number of accepted connections will be written here
+    ///
+    /// \return Status code (Done if at least one connection was accepted)
+    ///
+    /// \see listen
+    ///
+    ////////////////////////////////////////////////////////////
+    Status accept(TcpSocket* const* sockets, std::size_t count, std::size_t& accepted);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    bool m_portSharing; ///< Is the listening port shared with other listeners?
 };
 
 
@@ -157,6 +226,25 @@ public:
 /// }
 /// \endcode
 ///
+/// To spread a heavy load of connections across several
+/// threads, each thread can run its own listener on the same
+/// port, with port sharing enabled:
+/// \code
+/// // In each thread
+/// sf::TcpListener listener;
+/// listener.setPortSharingEnabled(true);
+/// listener.listen(55001);
+///
+/// sf::TcpSocket* clients[64] = ...; // sockets ready to be used
+/// std::size_t accepted;
+/// while (listener.accept(clients, 64, accepted) == sf::Socket::Done)
+/// {
+///     for (std::size_t i = 0; i < accepted; ++i)
+///         doSomethingWith(*clients[i]);
+///     ...
+/// }
+/// \endcode
+///
 /// \see sf::TcpSocket, sf::Socket
 ///
 ////////////////////////////////////////////////////////////
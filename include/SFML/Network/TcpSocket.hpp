@@ -30,7 +30,10 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
 #include <SFML/Network/Socket.hpp>
+#include <SFML/System/MemoryTracker.hpp>
 #include <SFML/System/Time.hpp>
+#include <string>
+#include <vector>
 
 
 namespace sf
@@ -110,6 +113,31 @@ public:
     ////////////////////////////////////////////////////////////
     Status connect(const IpAddress& remoteAddress, unsigned short remotePort, Time timeout = Time::Zero);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Connect the socket to the fastest of several addresses of a peer
+    ///
+    /// The addresses, typically given by IpAddress::resolveAll,
+    /// are tried alternately between their IPv6 and IPv4 ones,
+    /// starting a new attempt every 250 ms while the previous
+    /// ones are still in progress; the first connection
+    /// established is kept and the others are abandoned
+    /// ("happy eyeballs", RFC 8305). A broken route, usually an
+    /// IPv6 one, thus only delays the connection by 250 ms.
+    /// This function waits for the result even in non-blocking
+    /// mode. If the socket was previously connected, it is
+    /// first disconnected.
+    ///
+    /// \param remoteAddresses Addresses of the remote peer, in order of preference
+    /// \param remotePort      Port of the remote peer
+    /// \param timeout         Optional maximum time to wait
+    ///
+    /// \return Status code
+    ///
+    /// \see disconnect
+    ///
+    ////////////////////////////////////////////////////////////
+    Status connect(const std::vector<IpAddress>& remoteAddresses, unsigned short remotePort, Time timeout = Time::Zero);
+
     ////////////////////////////////////////////////////////////
     /// \brief Disconnect the socket from its remote peer
     ///
@@ -155,6 +183,32 @@ public:
     ////////////////////////////////////////////////////////////
     Status send(const void* data, std::size_t size, std::size_t& sent);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the contents of a file to the remote peer
+    ///
+    /// The file is sent from \a offset to its end. Where the
+    /// system supports it (sendfile on Linux, TransmitFile on
+    /// Windows), the data goes from the file to the network
+    /// without being copied by the application; otherwise the
+    /// file is read by large blocks. Data waiting in the write
+    /// buffer is flushed first.
+    ///
+    /// In non-blocking mode, this function may return
+    /// sf::Socket::Partial: call it again later with
+    /// \a offset + \a sent to send the rest of the file.
+    /// This function will fail if the socket is not connected.
+    ///
+    /// \param filename Path of the file to send
+    /// \param offset   Position of the first byte to send in the file
+    /// \param sent     The number of bytes sent will be written here
+    ///
+    /// \return Status code
+    ///
+    /// \see send
+    ///
+    ////////////////////////////////////////////////////////////
+    Status sendFile(const std::string& filename, Uint64 offset, Uint64& sent);
+
     ////////////////////////////////////////////////////////////
     /// \brief Receive raw data from the remote peer
     ///
@@ -207,10 +261,160 @@ public:
     ////////////////////////////////////////////////////////////
     Status receive(Packet& packet);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size of the read-ahead buffer
+    ///
+    /// When read-ahead is enabled, small receives (and the
+    /// receive of small packets) ask the system for as many
+    /// bytes as the buffer can hold, and the following
+    /// receives are served from the buffer; many small packets
+    /// can then be received with a single system call.
+    ///
+    /// Received data that sits in the buffer no longer makes the
+    /// socket ready in a sf::SocketSelector: after the selector
+    /// reports the socket, keep receiving until getBufferedSize
+    /// returns 0 (or, in non-blocking mode, until receive returns
+    /// NotReady).
+    ///
+    /// Read-ahead is disabled by default.
+    ///
+    /// \param size Size of the buffer in bytes, 0 to disable read-ahead
+    ///
+    /// \see getReadAhead, getBufferedSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setReadAhead(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the read-ahead buffer
+    ///
+    /// \return Size of the buffer in bytes, 0 if read-ahead is disabled
+    ///
+    /// \see setReadAhead
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getReadAhead() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bytes received in advance
+    ///
+    /// \return Number of bytes waiting in the read-ahead buffer
+    ///
+    /// \see setReadAhead
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getBufferedSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the flush threshold of the write buffer
+    ///
+    /// When the write buffer is enabled, the data and packets
+    /// sent are appended to the buffer instead of being sent
+    /// right away, and the buffer is sent with a single system
+    /// call when flush is called or when it holds at least
+    /// \a threshold bytes. Many small writes made within one
+    /// frame can then be coalesced, without the delay that
+    /// Nagle's algorithm would add.
+    ///
+    /// While the write buffer is enabled, send never returns
+    /// sf::Socket::Partial or sf::Socket::NotReady: the data
+    /// that can't be sent yet stays in the buffer until the
+    /// next flush. Data still in the buffer is discarded when
+    /// the socket is disconnected.
+    ///
+    /// The write buffer is disabled by default. Disabling it
+    /// flushes the buffered data.
+    ///
+    /// \param threshold Number of buffered bytes that triggers a flush, 0 to disable the write buffer
+    ///
+    /// \see getWriteBuffer, flush
+    ///
+    ////////////////////////////////////////////////////////////
+    void setWriteBuffer(std::size_t threshold);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the flush threshold of the write buffer
+    ///
+    /// \return Number of buffered bytes that triggers a flush, 0 if the write buffer is disabled
+    ///
+    /// \see setWriteBuffer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getWriteBuffer() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bytes waiting in the write buffer
+    ///
+    /// \return Number of bytes not flushed yet
+    ///
+    /// \see flush
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getUnflushedSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the data waiting in the write buffer
+    ///
+    /// In non-blocking mode, the data that can't be sent
+    /// right away stays in the buffer, and this function
+    /// returns sf::Socket::Partial (or sf::Socket::NotReady
+    /// if nothing was sent): call it again later.
+    ///
+    /// \return Status code
+    ///
+    /// \see setWriteBuffer
+    ///
+    ////////////////////////////////////////////////////////////
+    Status flush();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the round-trip time of the connection
+    ///
+    /// The value is the smoothed estimate that the system
+    /// computes from the acknowledgements it receives, so
+    /// it costs no traffic. It is only available on Linux,
+    /// FreeBSD and OS X; other systems return Time::Zero,
+    /// as do sockets that are not connected.
+    ///
+    /// \return Round-trip time of the connection
+    ///
+    /// \see Socket::getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getRoundTripTime() const;
+
 private:
 
     friend class TcpListener;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Append data to the write buffer, and flush it if needed
+    ///
+    /// \param first      First block of data
+    /// \param firstSize  Size of the first block, in bytes
+    /// \param second     Second block of data, written after the first one
+    /// \param secondSize Size of the second block, in bytes
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status bufferData(const char* first, std::size_t firstSize, const char* second, std::size_t secondSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Count a packet that was completely sent, and capture it
+    ///
+    /// \param data Data of the packet, as returned by onSend
+    /// \param size Size of the data, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordPacketSent(const char* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Report the memory of the internal buffers to the memory tracker
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateMemoryUsage();
+
     ////////////////////////////////////////////////////////////
     /// \brief Structure holding the data of a pending packet
     ///
@@ -222,12 +426,19 @@ private:
         Uint32            Size;         ///< Data of packet size
         std::size_t       SizeReceived; ///< Number of size bytes received so far
         std::vector<char> Data;         ///< Data of the packet
+        std::size_t       DataReceived; ///< Number of data bytes received so far
     };
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    PendingPacket m_pendingPacket; ///< Temporary data of the packet currently being received
+    PendingPacket          m_pendingPacket;  ///< Temporary data of the packet currently being received
+    std::vector<char>      m_readBuffer;     ///< Data received in advance (empty if read-ahead is disabled)
+    std::size_t            m_readBegin;      ///< Position of the first byte not returned yet in the read-ahead buffer
+    std::size_t            m_readEnd;        ///< End of the received data in the read-ahead buffer
+    std::vector<char>      m_writeBuffer;    ///< Data sent but not flushed yet
+    std::size_t            m_writeThreshold; ///< Number of buffered bytes that triggers a flush (0 if the write buffer is disabled)
+    MemoryTracker::Counter m_memory;         ///< Reports the memory of the buffers
 };
 
 } // namespace sf
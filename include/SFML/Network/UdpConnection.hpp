@@ -0,0 +1,463 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_UDPCONNECTION_HPP
+#define SFML_UDPCONNECTION_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Socket.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <deque>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class Packet;
+class UdpSocket;
+
+////////////////////////////////////////////////////////////
+/// \brief Connection with a remote peer over a UDP socket,
+///        with reliable and unreliable channels
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API UdpConnection : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Delivery guarantees of a channel
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Reliability
+    {
+        Unreliable, ///< Messages may be lost, duplicated or reordered
+        Sequenced,  ///< Messages may be lost, but older messages are dropped when a newer one was already received
+        Reliable    ///< Messages are always received, in the order they were sent
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the connection
+    ///
+    /// The socket is not owned by the connection, and can be
+    /// shared by the connections to several peers. It must
+    /// remain alive as long as the connection uses it.
+    ///
+    /// \param socket        Socket used to send the datagrams
+    /// \param remoteAddress Address of the remote peer
+    /// \param remotePort    Port of the remote peer
+    ///
+    ////////////////////////////////////////////////////////////
+    UdpConnection(UdpSocket& socket, const IpAddress& remoteAddress, unsigned short remotePort);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the address of the remote peer
+    ///
+    /// \return Address of the remote peer
+    ///
+    /// \see getRemotePort
+    ///
+    ////////////////////////////////////////////////////////////
+    IpAddress getRemoteAddress() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the port of the remote peer
+    ///
+    /// \return Port of the remote peer
+    ///
+    /// \see getRemoteAddress
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned short getRemotePort() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the delivery guarantees of a channel
+    ///
+    /// This only affects the messages sent after the call;
+    /// the delivery guarantees are transmitted with each
+    /// message, so the remote peer doesn't need to configure
+    /// its channels. A channel should not change its
+    /// reliability while messages are in transit.
+    /// By default, all the channels are reliable.
+    ///
+    /// \param channel     Index of the channel
+    /// \param reliability Delivery guarantees of the channel
+    ///
+    /// \see getChannel
+    ///
+    ////////////////////////////////////////////////////////////
+    void setChannel(Uint8 channel, Reliability reliability);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the delivery guarantees of a channel
+    ///
+    /// \param channel Index of the channel
+    ///
+    /// \return Delivery guarantees of the channel
+    ///
+    /// \see setChannel
+    ///
+    ////////////////////////////////////////////////////////////
+    Reliability getChannel(Uint8 channel) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a packet to be sent to the remote peer
+    ///
+    /// Packets bigger than a datagram are split into fragments
+    /// and recomposed by the remote peer. The data is copied,
+    /// so the packet can be reused right after the call.
+    /// Nothing is sent until the next call to update.
+    ///
+    /// \param packet  Packet to send
+    /// \param channel Channel to send the packet on
+    ///
+    /// \return True if the packet was queued, false if it is too big
+    ///
+    /// \see receive, update
+    ///
+    ////////////////////////////////////////////////////////////
+    bool send(Packet& packet, Uint8 channel = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the next packet received from the remote peer
+    ///
+    /// This function never blocks: it returns the packets
+    /// already extracted by handleDatagram.
+    ///
+    /// \param packet  Packet to fill with the received data
+    /// \param channel Variable to fill with the channel of the packet
+    ///
+    /// \return True if a packet was received, false if none is available
+    ///
+    /// \see send, handleDatagram
+    ///
+    ////////////////////////////////////////////////////////////
+    bool receive(Packet& packet, Uint8& channel);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process a datagram received from the remote peer
+    ///
+    /// The application reads the datagrams from the socket itself,
+    /// and gives to each connection the ones coming from its peer.
+    ///
+    /// \param data Data of the datagram
+    /// \param size Size of the datagram, in bytes
+    ///
+    /// \return True if the datagram was valid
+    ///
+    /// \see receive
+    ///
+    ////////////////////////////////////////////////////////////
+    bool handleDatagram(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the queued packets, acknowledgements and retransmissions
+    ///
+    /// This function must be called regularly, for example once
+    /// per frame. Unreliable packets are sent right away, whereas
+    /// reliable ones are limited by the congestion window.
+    ///
+    /// \return Status code of the last send operation
+    ///
+    /// \see send
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status update();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the estimated round trip time
+    ///
+    /// \return Smoothed time between sending a datagram and receiving its acknowledgement
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getRoundTripTime() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the estimated packet loss
+    ///
+    /// \return Smoothed ratio of lost datagrams, between 0 and 1
+    ///
+    ////////////////////////////////////////////////////////////
+    float getPacketLoss() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the congestion window
+    ///
+    /// \return Maximum number of datagrams carrying reliable packets that can wait for an acknowledgement
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCongestionWindow() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the time elapsed since the last datagram was received
+    ///
+    /// This can be used to detect that the peer is gone.
+    ///
+    /// \return Time elapsed since the last datagram was received (or since the construction)
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getTimeSinceLastReceive() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Fragment of a packet waiting to be sent
+    ///
+    ////////////////////////////////////////////////////////////
+    struct OutgoingFragment
+    {
+        Uint8             channel;     ///< Channel of the packet
+        Uint8             reliability; ///< Delivery guarantees of the packet
+        Uint16            sequence;    ///< Sequence number of the packet in its channel
+        Uint16            index;       ///< Index of the fragment in the packet
+        Uint16            count;       ///< Number of fragments of the packet
+        std::vector<char> data;        ///< Data of the fragment
+        bool              isSent;      ///< Is the fragment waiting for an acknowledgement?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Datagram sent, waiting for an acknowledgement
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SentDatagram
+    {
+        SentDatagram();
+
+        Uint16              sequence;  ///< Sequence number of the datagram
+        Time                sendTime;  ///< Time when the datagram was sent
+        std::vector<Uint64> fragments; ///< Identifiers of the reliable fragments of the datagram
+        bool                isAcked;   ///< Was the datagram acknowledged?
+        bool                isPending; ///< Is the datagram waiting for an acknowledgement (neither acknowledged nor lost)?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Packet being recomposed or waiting for its turn
+    ///
+    ////////////////////////////////////////////////////////////
+    struct IncomingPacket
+    {
+        std::vector<std::vector<char> > fragments; ///< Data of the fragments
+        std::vector<bool>               received;  ///< Which fragments were received
+        std::size_t                     missing;   ///< Number of fragments not received yet
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief State of a channel on the receiving side
+    ///
+    ////////////////////////////////////////////////////////////
+    struct IncomingChannel
+    {
+        IncomingChannel();
+
+        Uint16                           nextSequence; ///< Sequence number of the next packet expected
+        std::map<Uint16, IncomingPacket> packets;      ///< Packets being recomposed
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process an acknowledgement of a sent datagram
+    ///
+    /// \param sequence Sequence number of the acknowledged datagram
+    /// \param now      Current time
+    ///
+    ////////////////////////////////////////////////////////////
+    void acknowledge(Uint16 sequence, Time now);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Consider a sent datagram as lost
+    ///
+    /// Its reliable fragments are sent again by the next update.
+    ///
+    /// \param datagram Datagram to consider as lost
+    ///
+    ////////////////////////////////////////////////////////////
+    void markLost(SentDatagram& datagram);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write a fragment to the datagram being built
+    ///
+    /// \param fragment Fragment to write
+    ///
+    /// \return True if the fragment was written, false if there is not enough room left
+    ///
+    ////////////////////////////////////////////////////////////
+    bool writeFragment(const OutgoingFragment& fragment);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store a fragment received from the remote peer
+    ///
+    /// \param channel     Channel of the packet
+    /// \param reliability Delivery guarantees of the packet
+    /// \param sequence    Sequence number of the packet in its channel
+    /// \param index       Index of the fragment in the packet
+    /// \param count       Number of fragments of the packet
+    /// \param data        Data of the fragment
+    /// \param size        Size of the fragment, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void receiveFragment(Uint8 channel, Uint8 reliability, Uint16 sequence, Uint16 index, Uint16 count, const char* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make a recomposed packet available to receive
+    ///
+    /// \param channel Channel of the packet
+    /// \param packet  Packet to deliver
+    ///
+    ////////////////////////////////////////////////////////////
+    void deliver(Uint8 channel, const IncomingPacket& packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the time after which a datagram is considered lost
+    ///
+    /// \return Retransmission timeout
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getRetransmissionTimeout() const;
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<Uint64, OutgoingFragment>   FragmentMap;
+    typedef std::map<Uint8, IncomingChannel>     ChannelMap;
+    typedef std::pair<Uint8, std::vector<char> > ReceivedPacket;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    UdpSocket&                   m_socket;              ///< Socket used to send the datagrams
+    IpAddress                    m_remoteAddress;       ///< Address of the remote peer
+    unsigned short               m_remotePort;          ///< Port of the remote peer
+    std::vector<Uint8>           m_channels;            ///< Delivery guarantees of each channel
+    std::vector<Uint16>          m_sendSequences;       ///< Sequence number of the next packet sent on each channel
+    FragmentMap                  m_reliableFragments;   ///< Reliable fragments not acknowledged yet, by identifier
+    std::deque<OutgoingFragment> m_unreliableFragments; ///< Unreliable fragments not sent yet
+    Uint64                       m_nextFragmentId;      ///< Identifier of the next reliable fragment
+    std::vector<SentDatagram>    m_sentDatagrams;       ///< Last datagrams sent, indexed by sequence number
+    Uint16                       m_localSequence;       ///< Sequence number of the next datagram sent
+    Uint16                       m_lastAckedSequence;   ///< Sequence number of the most recent datagram acknowledged
+    Uint16                       m_remoteSequence;      ///< Sequence number of the most recent datagram received
+    Uint32                       m_receivedBits;        ///< Which of the 32 datagrams before the most recent one were received
+    bool                         m_hasReceived;         ///< Was any datagram received yet?
+    unsigned int                 m_ackRepeats;          ///< Number of datagrams that must still be sent to acknowledge the received ones
+    ChannelMap                   m_incomingChannels;    ///< State of the channels on the receiving side
+    std::deque<ReceivedPacket>   m_receivedPackets;     ///< Recomposed packets waiting to be received
+    std::vector<char>            m_datagram;            ///< Datagram being built
+    Clock                        m_clock;               ///< Clock measuring the times of the connection
+    Time                         m_lastSendTime;        ///< Time when the last datagram was sent
+    Time                         m_lastReceiveTime;     ///< Time when the last datagram was received
+    Time                         m_lastCongestionTime;  ///< Time when the congestion window was last reduced
+    float                        m_smoothedRtt;         ///< Smoothed round trip time, in seconds
+    float                        m_rttVariation;        ///< Variation of the round trip time, in seconds
+    bool                         m_hasRttSample;        ///< Was the round trip time measured yet?
+    float                        m_packetLoss;          ///< Smoothed ratio of lost datagrams
+    float                        m_congestionWindow;    ///< Maximum number of reliable datagrams in flight
+    float                        m_slowStartThreshold;  ///< Congestion window above which it grows linearly
+};
+
+} // namespace sf
+
+
+#endif // SFML_UDPCONNECTION_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::UdpConnection
+/// \ingroup network
+///
+/// sf::UdpConnection adds to sf::UdpSocket what is needed
+/// to exchange packets with a remote peer in real time
+/// without the head-of-line blocking of TCP: every datagram
+/// carries a sequence number and an acknowledgement of the
+/// last datagrams received, so that lost reliable packets
+/// are sent again and delivered in order, while unreliable
+/// packets never wait for anything.
+///
+/// Packets are sent on channels (up to 256), each one with
+/// its own delivery guarantees and ordering: a lost packet
+/// on a reliable channel doesn't delay the other channels.
+/// Packets bigger than a datagram are split into fragments
+/// and recomposed on the other side, so there is no limit
+/// other than memory on the size of the packets (up to 4 MB).
+///
+/// The connection estimates the round trip time to decide
+/// when a datagram is lost, and limits the number of reliable
+/// datagrams in flight with a congestion window that grows
+/// as long as datagrams are acknowledged, and is halved
+/// when they are lost.
+///
+/// The connection doesn't read from the socket: since a single
+/// socket can serve many peers, the application receives the
+/// datagrams and gives them to the connection of their sender
+/// with handleDatagram. Likewise, establishing and closing
+/// the connection (handshake, timeout) is left to the
+/// application; getTimeSinceLastReceive helps with the latter.
+/// Both peers must use sf::UdpConnection.
+///
+/// Usage example:
+/// \code
+/// sf::UdpSocket socket;
+/// socket.bind(55001);
+/// socket.setBlocking(false);
+///
+/// sf::UdpConnection connection(socket, "192.168.1.50", 55002);
+/// connection.setChannel(1, sf::UdpConnection::Sequenced);
+///
+/// while (running)
+/// {
+///     // Give the received datagrams to the connection
+///     char buffer[sf::UdpSocket::MaxDatagramSize];
+///     std::size_t size;
+///     sf::IpAddress sender;
+///     unsigned short port;
+///     while (socket.receive(buffer, sizeof(buffer), size, sender, port) == sf::Socket::Done)
+///     {
+///         if ((sender == connection.getRemoteAddress()) && (port == connection.getRemotePort()))
+///             connection.handleDatagram(buffer, size);
+///     }
+///
+///     // Handle the received packets
+///     sf::Packet packet;
+///     sf::Uint8 channel;
+///     while (connection.receive(packet, channel))
+///         handle(packet, channel);
+///
+///     // Send the state of the player on the sequenced channel
+///     packet.clear();
+///     packet << position.x << position.y;
+///     connection.send(packet, 1);
+///
+///     // Send the packets, acknowledgements and retransmissions
+///     connection.update();
+/// }
+/// \endcode
+///
+/// \see sf::UdpSocket, sf::Packet
+///
+////////////////////////////////////////////////////////////
@@ -29,13 +29,13 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
+#include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/Socket.hpp>
 #include <vector>
 
 
 namespace sf
 {
-class IpAddress;
 class Packet;
 
 ////////////////////////////////////////////////////////////
@@ -54,6 +54,20 @@ public:
         MaxDatagramSize = 65507 ///< The maximum number of bytes that can be sent in a single UDP datagram
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Datagram sent or received by the batch functions
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Datagram
+    {
+        void*          data;        ///< Data to send, or buffer receiving the data
+        std::size_t    size;        ///< Number of bytes to send, or number of bytes received
+        std::size_t    capacity;    ///< Size of the buffer receiving the data (ignored when sending)
+        IpAddress      address;     ///< Address of the receiver, or of the peer that sent the data
+        unsigned short port;        ///< Port of the receiver, or of the peer that sent the data
+        std::size_t    segmentSize; ///< Size of the datagrams coalesced into the received data (see Socket::ReceiveOffload), 0 if it holds a single datagram (ignored when sending)
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -81,15 +95,21 @@ public:
     /// You can use the special value Socket::AnyPort to tell the
     /// system to automatically pick an available port, and then
     /// call getLocalPort to retrieve the chosen port.
+    /// By default the socket is bound to all the interfaces,
+    /// and can exchange datagrams with both IPv4 and IPv6
+    /// addresses (if the system supports dual-stack sockets,
+    /// IPv4 only otherwise); give a local address to bind it
+    /// to a single interface.
     ///
-    /// \param port Port to bind the socket to
+    /// \param port    Port to bind the socket to
+    /// \param address Local address to bind the socket to
     ///
     /// \return Status code
     ///
     /// \see unbind, getLocalPort
     ///
     ////////////////////////////////////////////////////////////
-    Status bind(unsigned short port);
+    Status bind(unsigned short port, const IpAddress& address = IpAddress::Any);
 
     ////////////////////////////////////////////////////////////
     /// \brief Unbind the socket from the local port to which it is bound
@@ -180,6 +200,59 @@ public:
     ////////////////////////////////////////////////////////////
     Status receive(Packet& packet, IpAddress& remoteAddress, unsigned short& remotePort);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several datagrams at once
+    ///
+    /// Each datagram is sent to its own address and port. On
+    /// Linux, the datagrams are sent with as few system calls
+    /// as possible (sendmmsg); elsewhere they are sent one by
+    /// one.
+    ///
+    /// In non-blocking mode, this function returns Partial if
+    /// only the first \a sent datagrams could be sent.
+    ///
+    /// \param datagrams Array of datagrams to send
+    /// \param count     Number of datagrams in the array
+    /// \param sent      The number of datagrams sent will be written here
+    ///
+    /// \return Status code
+    ///
+    /// \see receive
+    ///
+    ////////////////////////////////////////////////////////////
+    Status send(const Datagram* datagrams, std::size_t count, std::size_t& sent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive several datagrams at once
+    ///
+    /// The data of each datagram is written directly into its
+    /// buffer (\a data, \a capacity bytes); the size, address
+    /// and port of the datagrams that are received are filled.
+    /// Data that doesn't fit into the buffer is lost.
+    ///
+    /// In blocking mode, this function waits until at least one
+    /// datagram is received; it then receives the ones that
+    /// are already waiting, up to \a count, without blocking.
+    /// On Linux, they are received with as few system calls as
+    /// possible (recvmmsg).
+    ///
+    /// When the ReceiveOffload option is enabled, the system can
+    /// coalesce several datagrams of the same sender into one
+    /// buffer: they all have \a segmentSize bytes, except the
+    /// last one which can be shorter. Use a buffer of
+    /// MaxDatagramSize bytes to receive them.
+    ///
+    /// \param datagrams Array of datagrams to fill
+    /// \param count     Number of datagrams in the array
+    /// \param received  The number of datagrams received will be written here
+    ///
+    /// \return Status code (Done if at least one datagram was received)
+    ///
+    /// \see send
+    ///
+    ////////////////////////////////////////////////////////////
+    Status receive(Datagram* datagrams, std::size_t count, std::size_t& received);
+
 private:
 
     ////////////////////////////////////////////////////////////
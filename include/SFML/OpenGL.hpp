@@ -47,7 +47,10 @@
 
 #elif defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_FREEBSD)
 
-    #if defined(SFML_OPENGL_ES)
+    #if defined(SFML_OPENGL_ES2)
+        #include <GLES2/gl2.h>
+        #include <GLES2/gl2ext.h>
+    #elif defined(SFML_OPENGL_ES)
         #include <GLES/gl.h>
         #include <GLES/glext.h>
     #else
@@ -60,13 +63,23 @@
 
 #elif defined (SFML_SYSTEM_IOS)
 
-    #include <OpenGLES/ES1/gl.h>
-    #include <OpenGLES/ES1/glext.h>
+    #if defined(SFML_OPENGL_ES2)
+        #include <OpenGLES/ES2/gl.h>
+        #include <OpenGLES/ES2/glext.h>
+    #else
+        #include <OpenGLES/ES1/gl.h>
+        #include <OpenGLES/ES1/glext.h>
+    #endif
 
 #elif defined (SFML_SYSTEM_ANDROID)
 
-    #include <GLES/gl.h>
-    #include <GLES/glext.h>
+    #if defined(SFML_OPENGL_ES2)
+        #include <GLES2/gl2.h>
+        #include <GLES2/gl2ext.h>
+    #else
+        #include <GLES/gl.h>
+        #include <GLES/glext.h>
+    #endif
 
 #endif
 
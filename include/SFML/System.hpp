@@ -30,23 +30,36 @@
 ////////////////////////////////////////////////////////////
 
 #include <SFML/Config.hpp>
+#include <SFML/System/Archive.hpp>
+#include <SFML/System/ArchiveInputStream.hpp>
+#include <SFML/System/AsyncInputStream.hpp>
 #include <SFML/System/Clock.hpp>
+#include <SFML/System/ConditionVariable.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/FastMutex.hpp>
 #include <SFML/System/FileInputStream.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/MemoryInputStream.hpp>
+#include <SFML/System/MemoryTracker.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Profiler.hpp>
+#include <SFML/System/ReadLock.hpp>
+#include <SFML/System/ReadWriteMutex.hpp>
+#include <SFML/System/Signal.hpp>
 #include <SFML/System/Sleep.hpp>
 #include <SFML/System/String.hpp>
 #include <SFML/System/Thread.hpp>
 #include <SFML/System/ThreadLocal.hpp>
 #include <SFML/System/ThreadLocalPtr.hpp>
+#include <SFML/System/ThreadPool.hpp>
 #include <SFML/System/Time.hpp>
 #include <SFML/System/Utf.hpp>
+#include <SFML/System/Utf8String.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/Vector3.hpp>
+#include <SFML/System/WriteLock.hpp>
 
 #endif // SFML_SYSTEM_HPP
 
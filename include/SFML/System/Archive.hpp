@@ -0,0 +1,203 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_ARCHIVE_HPP
+#define SFML_ARCHIVE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class ArchiveInputStream;
+
+////////////////////////////////////////////////////////////
+/// \brief Read-only pack of files with an indexed table of contents
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Archive : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    Archive();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open an archive file
+    ///
+    /// The archive is mapped in memory when possible, otherwise
+    /// its whole contents are read at once. The table of contents
+    /// is validated when the archive is opened, so that entries
+    /// can be accessed without further checks.
+    ///
+    /// \param filename Path of the archive to open
+    ///
+    /// \return True if the archive was successfully opened
+    ///
+    ////////////////////////////////////////////////////////////
+    bool openFromFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of entries in the archive
+    ///
+    /// \return Number of entries
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getEntryCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the name of an entry
+    ///
+    /// Entries are sorted by name.
+    ///
+    /// \param index Index of the entry, in range [0, getEntryCount() - 1]
+    ///
+    /// \return Name of the entry
+    ///
+    ////////////////////////////////////////////////////////////
+    std::string getEntryName(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the archive contains an entry
+    ///
+    /// \param name Name of the entry
+    ///
+    /// \return True if the entry exists
+    ///
+    ////////////////////////////////////////////////////////////
+    bool contains(const std::string& name) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pack a list of files into a new archive
+    ///
+    /// Each file is stored under the name it's given with, with
+    /// backslashes replaced by slashes. When \a compress is true,
+    /// entries are compressed with LZ4 if it makes them smaller.
+    ///
+    /// \param filename Path of the archive to write
+    /// \param files    Paths of the files to pack
+    /// \param compress True to compress the entries
+    ///
+    /// \return True if the archive was successfully written
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool create(const std::string& filename, const std::vector<std::string>& files, bool compress = false);
+
+private:
+
+    friend class ArchiveInputStream;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the table of contents record of an entry
+    ///
+    /// \param name Name of the entry
+    ///
+    /// \return Pointer to the record, or NULL if not found
+    ///
+    ////////////////////////////////////////////////////////////
+    const Uint8* findEntry(const std::string& name) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the contents of an entry
+    ///
+    /// Uncompressed entries point directly into the archive,
+    /// compressed ones are decompressed into \a buffer.
+    ///
+    /// \param name   Name of the entry
+    /// \param buffer Buffer receiving the decompressed contents
+    /// \param data   Receives the address of the contents
+    /// \param size   Receives the size of the contents, in bytes
+    ///
+    /// \return True on success, false if the entry can't be read
+    ///
+    ////////////////////////////////////////////////////////////
+    bool readEntry(const std::string& name, std::vector<char>& buffer, const void*& data, std::size_t& size) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    FileInputStream   m_file;       ///< Stream of the archive file
+    std::vector<char> m_contents;   ///< Contents of the archive, when it can't be mapped
+    const Uint8*      m_data;       ///< Contents of the archive
+    std::size_t       m_size;       ///< Size of the archive, in bytes
+    std::size_t       m_entryCount; ///< Number of entries in the table of contents
+};
+
+} // namespace sf
+
+
+#endif // SFML_ARCHIVE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Archive
+/// \ingroup system
+///
+/// sf::Archive packs many files into a single one, so that
+/// loading them doesn't cost a system call to open each file.
+/// The archive is mapped in memory and its table of contents
+/// is sorted by name, so finding an entry is a binary search
+/// and reading an uncompressed entry doesn't copy anything.
+///
+/// Entries are read with sf::ArchiveInputStream, which can be
+/// passed to all the loadFromStream functions of SFML.
+///
+/// Archives are written with the static create function, for
+/// example by a small tool run when building the game's data.
+/// Small entries are best left uncompressed, as they can then
+/// be decoded in place, directly from the mapped archive.
+///
+/// Usage example:
+/// \code
+/// // Pack the files once
+/// std::vector<std::string> files;
+/// files.push_back("images/hero.png");
+/// files.push_back("fonts/title.ttf");
+/// sf::Archive::create("data.pak", files, true);
+///
+/// // Then load them from the archive
+/// sf::Archive archive;
+/// if (!archive.openFromFile("data.pak"))
+///     return -1;
+///
+/// sf::ArchiveInputStream stream;
+/// sf::Texture texture;
+/// if (stream.open(archive, "images/hero.png"))
+///     texture.loadFromStream(stream);
+/// \endcode
+///
+/// \see sf::ArchiveInputStream
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_ARCHIVEINPUTSTREAM_HPP
+#define SFML_ARCHIVEINPUTSTREAM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
+#include <SFML/System/MemoryInputStream.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class Archive;
+
+////////////////////////////////////////////////////////////
+/// \brief Implementation of input stream based on an archive entry
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API ArchiveInputStream : public MemoryInputStream
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ArchiveInputStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open an entry of an archive
+    ///
+    /// Uncompressed entries are read directly from the archive,
+    /// which must therefore remain alive as long as the stream
+    /// is used. Compressed entries are decompressed in a buffer
+    /// owned by the stream.
+    ///
+    /// \param archive Archive containing the entry
+    /// \param name    Name of the entry
+    ///
+    /// \return True if the entry was successfully opened
+    ///
+    ////////////////////////////////////////////////////////////
+    bool open(const Archive& archive, const std::string& name);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<char> m_buffer; ///< Decompressed contents of the entry
+};
+
+} // namespace sf
+
+
+#endif // SFML_ARCHIVEINPUTSTREAM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ArchiveInputStream
+/// \ingroup system
+///
+/// This class is a specialization of InputStream that
+/// reads an entry of a sf::Archive.
+///
+/// Since it is a MemoryInputStream, loaders that can decode
+/// a block of memory do it directly from the archive.
+///
+/// \see sf::Archive
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,237 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_ASYNCINPUTSTREAM_HPP
+#define SFML_ASYNCINPUTSTREAM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/Export.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Input stream that reads another stream ahead on a thread
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API AsyncInputStream : public InputStream, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    AsyncInputStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits until the pending read of the source stream,
+    /// if any, is finished.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~AsyncInputStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start reading a source stream ahead
+    ///
+    /// The source stream is read by blocks, in the background,
+    /// so that up to \a blockCount blocks following the reading
+    /// position are already in memory when they are needed.
+    /// From now on, the source stream must only be accessed
+    /// through this stream, and it must remain alive as long
+    /// as this stream uses it.
+    ///
+    /// \param source     Stream to read ahead
+    /// \param blockSize  Size of the blocks read at once, in bytes
+    /// \param blockCount Number of blocks kept in memory
+    ///
+    /// \return True on success, false if the parameters are invalid
+    ///
+    ////////////////////////////////////////////////////////////
+    bool open(InputStream& source, std::size_t blockSize = 65536, std::size_t blockCount = 4);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop reading the source stream
+    ///
+    /// The source stream can be used directly again after
+    /// this function returns.
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read data from the stream
+    ///
+    /// The function only blocks if the requested data has not
+    /// been read from the source stream yet.
+    ///
+    /// \param data Buffer where to copy the read data
+    /// \param size Desired number of bytes to read
+    ///
+    /// \return The number of bytes actually read, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 read(void* data, Int64 size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current reading position
+    ///
+    /// Seeking out of the blocks in memory discards them, and
+    /// the source stream is then read ahead from the new position.
+    ///
+    /// \param position The position to seek to, from the beginning
+    ///
+    /// \return The position actually sought to, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 seek(Int64 position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current reading position in the stream
+    ///
+    /// \return The current position, or -1 on error.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 tell();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the stream
+    ///
+    /// \return The total number of bytes available in the stream, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 getSize();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Block of the source stream
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Block
+    {
+        Int64             position; ///< Position of the block in the source stream
+        Int64             size;     ///< Number of bytes read, or -1 on error
+        Uint64            id;       ///< Identifier of the current assignment, to detect outdated reads
+        bool              loaded;   ///< Has the block been read?
+        bool              loading;  ///< Is the block being read?
+        std::vector<char> data;     ///< Contents of the block
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function run by the thread that reads the source stream
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make a block cover another part of the source stream
+    ///
+    /// The mutex must be locked.
+    ///
+    /// \param block    Block to reassign
+    /// \param position New position of the block
+    ///
+    ////////////////////////////////////////////////////////////
+    void assign(Block& block, Int64 position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move the window of blocks so that it starts at a position
+    ///
+    /// The mutex must be locked.
+    ///
+    /// \param position Position that the first block must contain
+    ///
+    /// \return First block of the window
+    ///
+    ////////////////////////////////////////////////////////////
+    Block& moveWindow(Int64 position);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Thread             m_thread;      ///< Thread reading the source stream
+    Mutex              m_mutex;       ///< Mutex protecting the blocks
+    ConditionVariable  m_request;     ///< Notified when blocks need to be read
+    ConditionVariable  m_loaded;      ///< Notified when a block has been read
+    InputStream*       m_source;      ///< Stream read ahead
+    Int64              m_size;        ///< Size of the source stream
+    Int64              m_position;    ///< Current reading position
+    std::size_t        m_blockSize;   ///< Size of the blocks, in bytes
+    std::vector<Block> m_blocks;      ///< Blocks in memory, forming a ring
+    std::size_t        m_first;       ///< Index of the first block of the window
+    Int64              m_windowStart; ///< Position of the first block of the window
+    Uint64             m_nextId;      ///< Identifier of the next block assignment
+    bool               m_stop;        ///< Must the thread stop?
+};
+
+} // namespace sf
+
+
+#endif // SFML_ASYNCINPUTSTREAM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::AsyncInputStream
+/// \ingroup system
+///
+/// sf::AsyncInputStream wraps another stream and reads it
+/// ahead, on a dedicated thread, in blocks of fixed size.
+/// Sequential reads are then served from memory, and the
+/// latency of the storage is hidden from the code that
+/// consumes the stream: an audio stream doesn't stall while
+/// its file is read from a slow disk, for example.
+///
+/// Random seeks are supported, but seeking out of the blocks
+/// in memory has to wait for the source stream to be read at
+/// the new position.
+///
+/// Usage example:
+/// \code
+/// sf::FileInputStream file;
+/// if (!file.open("music.ogg"))
+///     return -1;
+///
+/// sf::AsyncInputStream stream;
+/// stream.open(file, 64 * 1024, 8);
+///
+/// sf::Music music;
+/// if (music.openFromStream(stream))
+///     music.play();
+/// \endcode
+///
+/// \see sf::InputStream, sf::FileInputStream
+///
+////////////////////////////////////////////////////////////
@@ -78,7 +78,7 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Time m_startTime; ///< Time of last reset, in microseconds
+    Time m_startTime; ///< Time of last reset
 };
 
 } // namespace sf
@@ -109,8 +109,8 @@ private:
 /// \endcode
 ///
 /// The sf::Time value returned by the clock can then be
-/// converted to a number of seconds, milliseconds or even
-/// microseconds.
+/// converted to a number of seconds, milliseconds, microseconds
+/// or even nanoseconds.
 ///
 /// \see sf::Time
 ///
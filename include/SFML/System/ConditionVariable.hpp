@@ -0,0 +1,176 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_CONDITIONVARIABLE_HPP
+#define SFML_CONDITIONVARIABLE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+    class ConditionVariableImpl;
+}
+
+class Mutex;
+
+////////////////////////////////////////////////////////////
+/// \brief Lets threads sleep until another thread wakes them up
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API ConditionVariable : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ConditionVariable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// No thread must be waiting on the condition variable
+    /// when it is destroyed.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ConditionVariable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the condition variable is notified
+    ///
+    /// The mutex must be locked exactly once by the calling
+    /// thread. It is atomically released while waiting, and
+    /// locked again before the function returns.
+    ///
+    /// The function may return without a notification
+    /// (spurious wake-up), so it must always be called in a
+    /// loop that checks the awaited condition.
+    ///
+    /// \param mutex Mutex protecting the awaited condition
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait(Mutex& mutex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the condition variable is notified, or a timeout expires
+    ///
+    /// \param mutex   Mutex protecting the awaited condition
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return False if the timeout expired, true otherwise
+    ///
+    /// \see wait(Mutex&)
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait(Mutex& mutex, Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wake up one of the threads waiting on the condition variable
+    ///
+    /// Does nothing if no thread is waiting.
+    ///
+    ////////////////////////////////////////////////////////////
+    void notifyOne();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wake up all the threads waiting on the condition variable
+    ///
+    ////////////////////////////////////////////////////////////
+    void notifyAll();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::ConditionVariableImpl* m_conditionImpl; ///< OS-specific implementation
+};
+
+} // namespace sf
+
+
+#endif // SFML_CONDITIONVARIABLE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ConditionVariable
+/// \ingroup system
+///
+/// A condition variable lets a thread sleep until some
+/// condition, protected by a mutex, becomes true: instead
+/// of checking it periodically with sf::sleep, the thread
+/// calls wait(), and the thread that changes the condition
+/// calls notifyOne() or notifyAll() to wake it up.
+///
+/// The awaited condition must always be checked in a loop,
+/// with the mutex locked: the waiting thread can be woken up
+/// before the condition is true, and the condition may have
+/// become true before it started waiting.
+///
+/// The mutex passed to wait() must be locked exactly once by
+/// the calling thread; sf::FastMutex is the natural choice.
+///
+/// Usage example:
+/// \code
+/// sf::FastMutex mutex;
+/// sf::ConditionVariable condition;
+/// std::deque<Job> jobs;
+///
+/// void worker()
+/// {
+///     for (;;)
+///     {
+///         Job job;
+///         {
+///             sf::Lock lock(mutex);
+///             while (jobs.empty())
+///                 condition.wait(mutex);
+///
+///             job = jobs.front();
+///             jobs.pop_front();
+///         }
+///         job.run();
+///     }
+/// }
+///
+/// void push(const Job& job)
+/// {
+///     sf::Lock lock(mutex);
+///     jobs.push_back(job);
+///     condition.notifyOne();
+/// }
+/// \endcode
+///
+/// \see sf::Mutex, sf::Signal
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_FASTMUTEX_HPP
+#define SFML_FASTMUTEX_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/Mutex.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Non-recursive mutex, cheaper than sf::Mutex
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API FastMutex : public Mutex
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    FastMutex();
+};
+
+} // namespace sf
+
+
+#endif // SFML_FASTMUTEX_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::FastMutex
+/// \ingroup system
+///
+/// sf::FastMutex works like sf::Mutex and is locked with
+/// sf::Lock as well, but it is not recursive: locking it
+/// again from the thread that already holds it is a deadlock.
+/// In exchange, locking and unlocking it is cheaper.
+///
+/// It is also adaptive: when it is already locked, a thread
+/// trying to lock it spins for a short while before going to
+/// sleep, which is faster for the sections that are only held
+/// for a few instructions.
+///
+/// Usage example:
+/// \code
+/// sf::FastMutex mutex;
+/// std::vector<int> values;
+///
+/// void add(int value)
+/// {
+///     sf::Lock lock(mutex);
+///     values.push_back(value);
+/// }
+/// \endcode
+///
+/// \see sf::Mutex, sf::Lock, sf::ReadWriteMutex
+///
+////////////////////////////////////////////////////////////
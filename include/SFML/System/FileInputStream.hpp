@@ -43,6 +43,14 @@ namespace priv
 class SFML_SYSTEM_API ResourceStream;
 }
 }
+#else
+namespace sf
+{
+namespace priv
+{
+class FileMappingImpl;
+}
+}
 #endif
 
 
@@ -70,6 +78,11 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Open the stream from a file path
     ///
+    /// On desktop platforms, regular files are mapped in memory:
+    /// their contents are read lazily by the system as they are
+    /// accessed, and are shared with the other processes that
+    /// map the same file. Other files are read with stdio.
+    ///
     /// \param filename Name of the file to open
     ///
     /// \return True on success, false on error
@@ -117,6 +130,21 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Int64 getSize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the contents of the file, if it is mapped in memory
+    ///
+    /// The returned pointer remains valid until the stream is
+    /// destroyed or opens another file. Functions that accept
+    /// a block of memory can use it directly instead of copying
+    /// the contents with read.
+    ///
+    /// \return Pointer to the mapped contents, or NULL if the file is not mapped
+    ///
+    /// \see getSize
+    ///
+    ////////////////////////////////////////////////////////////
+    const void* getData() const;
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -125,7 +153,9 @@ private:
 #ifdef ANDROID
     sf::priv::ResourceStream *m_file;
 #else
-    std::FILE* m_file; ///< stdio file stream
+    std::FILE*             m_file;     ///< stdio file stream, if the file is not mapped
+    priv::FileMappingImpl* m_mapping;  ///< Mapping of the file in memory
+    Int64                  m_position; ///< Current reading position in the mapping
 #endif
 };
 
@@ -149,7 +179,8 @@ private:
 ///
 /// In addition to the virtual functions inherited from
 /// InputStream, FileInputStream adds a function to
-/// specify the file to open.
+/// specify the file to open, and a function to access the
+/// contents directly when the file is mapped in memory.
 ///
 /// SFML resource classes can usually be loaded directly from
 /// a filename, so this class shouldn't be useful to you unless
@@ -99,6 +99,19 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Int64 getSize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the data the stream reads from
+    ///
+    /// Functions that accept a block of memory can use it
+    /// directly instead of copying the contents with read.
+    ///
+    /// \return Pointer to the data, or NULL if the stream is not open
+    ///
+    /// \see getSize
+    ///
+    ////////////////////////////////////////////////////////////
+    const void* getData() const;
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_MEMORYTRACKER_HPP
+#define SFML_MEMORYTRACKER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Tracks the heap memory used by SFML resources
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API MemoryTracker
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Types of resources whose memory is tracked
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Category
+    {
+        Images,       ///< Pixels of sf::Image (graphics module)
+        Glyphs,       ///< Glyph pages and rasterization buffers of sf::Font (graphics module)
+        SoundBuffers, ///< Samples of sf::SoundBuffer (audio module)
+        Packets,      ///< Data of sf::Packet (network module)
+        Sockets,      ///< Pending packets and buffers of sf::TcpSocket (network module)
+
+        CategoryCount ///< Keep last -- the total number of categories
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Memory used by a category of resources
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Usage
+    {
+        Usage();
+
+        Uint64 bytes;   ///< Number of bytes currently allocated
+        Uint64 buffers; ///< Number of resources that currently hold memory
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reports the memory held by a resource
+    ///
+    /// Resources have a counter and update it when the size of
+    /// their memory changes. Copying a counter reports the same
+    /// amount again, like copying the resource duplicates its
+    /// memory.
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_SYSTEM_API Counter
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Construct a counter that reports no memory
+        ///
+        /// \param category Category of the resource
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit Counter(Category category);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Copy constructor
+        ///
+        /// \param copy Counter to copy
+        ///
+        ////////////////////////////////////////////////////////////
+        Counter(const Counter& copy);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Destructor, the reported memory is released
+        ///
+        ////////////////////////////////////////////////////////////
+        ~Counter();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Report the amount of another counter
+        ///
+        /// The category of this counter is kept.
+        ///
+        /// \param right Counter to copy
+        ///
+        /// \return Reference to self
+        ///
+        ////////////////////////////////////////////////////////////
+        Counter& operator =(const Counter& right);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Change the amount of memory held by the resource
+        ///
+        /// Does nothing if the amount doesn't change, so it can be
+        /// called after every operation that may reallocate.
+        ///
+        /// \param bytes New number of bytes held by the resource
+        ///
+        ////////////////////////////////////////////////////////////
+        void setBytes(Uint64 bytes);
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        Category m_category; ///< Category of the resource
+        Uint64   m_bytes;    ///< Number of bytes currently reported
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the memory currently used by a category of resources
+    ///
+    /// \param category Category to query
+    ///
+    /// \return Memory used by the category
+    ///
+    ////////////////////////////////////////////////////////////
+    static Usage getUsage(Category category);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the memory currently used by all the resources
+    ///
+    /// \return Sum of the memory used by all the categories
+    ///
+    ////////////////////////////////////////////////////////////
+    static Usage getTotalUsage();
+};
+
+} // namespace sf
+
+
+#endif // SFML_MEMORYTRACKER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::MemoryTracker
+/// \ingroup system
+///
+/// sf::MemoryTracker tells how much heap memory the resources
+/// of SFML hold, by category: image pixels, glyph pages,
+/// sound samples, packets and socket buffers. Big buffers are
+/// what matters for the memory budget of an application, so
+/// they are tracked precisely, while the small bookkeeping
+/// allocations of each object are left out.
+///
+/// The counters are updated with atomic operations, only when
+/// the capacity of a buffer changes, so tracking has no
+/// measurable cost and is always enabled.
+///
+/// Usage example:
+/// \code
+/// sf::MemoryTracker::Usage images = sf::MemoryTracker::getUsage(sf::MemoryTracker::Images);
+/// std::cout << images.buffers << " images use " << images.bytes / 1024 << " KB" << std::endl;
+/// \endcode
+///
+////////////////////////////////////////////////////////////
@@ -80,8 +80,22 @@ public:
     ////////////////////////////////////////////////////////////
     void unlock();
 
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a mutex that may not be recursive
+    ///
+    /// \param recursive False to create a faster, non-recursive mutex
+    ///
+    /// \see FastMutex
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit Mutex(bool recursive);
+
 private:
 
+    friend class ConditionVariable;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -142,7 +156,8 @@ private:
 /// as usual, and the following ones have no effect.
 /// However, you must call unlock() exactly as many times as you
 /// called lock(). If you don't, the mutex won't be released.
+/// When recursion is not needed, sf::FastMutex is cheaper.
 ///
-/// \see sf::Lock
+/// \see sf::Lock, sf::FastMutex
 ///
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PROFILER_HPP
+#define SFML_PROFILER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Records the time spent in scoped zones of code
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Profiler
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Scoped zone, measured from its construction to its destruction
+    ///
+    /// Use the SFML_PROFILE_ZONE macro rather than this class
+    /// directly, so that zones are compiled out when profiling
+    /// is disabled.
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_SYSTEM_API Zone : NonCopyable
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Enter a zone
+        ///
+        /// \param name Name of the zone, must have a static storage
+        ///             duration (usually a string literal)
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit Zone(const char* name);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Leave the zone and record it
+        ///
+        ////////////////////////////////////////////////////////////
+        ~Zone();
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        const char* m_name;  ///< Name of the zone, NULL if not recorded
+        Uint64      m_start; ///< Ticks of the profiling clock when the zone was entered
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the recording of zones
+    ///
+    /// Recording is enabled by default. Disabling it makes
+    /// zones almost free, so that only interesting frames
+    /// can be recorded.
+    ///
+    /// \param enabled True to record zones, false to ignore them
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether zones are recorded
+    ///
+    /// \return True if zones are recorded
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isEnabled();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the zones recorded so far to a trace file
+    ///
+    /// The file uses the JSON trace event format, which can be
+    /// opened in Chrome (chrome://tracing) or Perfetto. The
+    /// written zones are discarded, so that calling this function
+    /// periodically produces successive traces.
+    ///
+    /// \param filename Path of the file to write
+    ///
+    /// \return True if the file was successfully written
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool saveToFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Discard the zones recorded so far
+    ///
+    ////////////////////////////////////////////////////////////
+    static void clear();
+};
+
+} // namespace sf
+
+
+////////////////////////////////////////////////////////////
+/// \brief Measure the rest of the enclosing scope as a profiling zone
+///
+/// Expands to nothing unless SFML_ENABLE_PROFILING is defined.
+///
+////////////////////////////////////////////////////////////
+#if defined(SFML_ENABLE_PROFILING)
+    #define SFML_PROFILE_CONCAT_(a, b) a##b
+    #define SFML_PROFILE_CONCAT(a, b) SFML_PROFILE_CONCAT_(a, b)
+    #define SFML_PROFILE_ZONE(name) sf::Profiler::Zone SFML_PROFILE_CONCAT(sfProfileZone, __LINE__)(name)
+#else
+    #define SFML_PROFILE_ZONE(name)
+#endif
+
+
+#endif // SFML_PROFILER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Profiler
+/// \ingroup system
+///
+/// sf::Profiler measures how long scoped zones of code take,
+/// on every thread, and writes them to a trace that shows
+/// where the time of each frame goes.
+///
+/// When SFML is built with the SFML_ENABLE_PROFILING option,
+/// its hot paths (drawing, texture updates, glyph loading,
+/// event processing, display and audio streaming) are already
+/// instrumented. Applications can add their own zones with the
+/// SFML_PROFILE_ZONE macro, if they define SFML_ENABLE_PROFILING
+/// too; otherwise the macro expands to nothing.
+///
+/// Each thread records its zones in its own buffer, without
+/// locking, so that profiling disturbs the measured code as
+/// little as possible.
+///
+/// Usage example:
+/// \code
+/// void update()
+/// {
+///     SFML_PROFILE_ZONE("update");
+///     ...
+/// }
+///
+/// while (window.isOpen())
+/// {
+///     update();
+///     draw();
+///
+///     if (sf::Keyboard::isKeyPressed(sf::Keyboard::F12))
+///         sf::Profiler::saveToFile("trace.json");
+/// }
+/// \endcode
+///
+////////////////////////////////////////////////////////////
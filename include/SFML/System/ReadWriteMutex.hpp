@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_READWRITEMUTEX_HPP
+#define SFML_READWRITEMUTEX_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+    class ReadWriteMutexImpl;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Mutex that lets several threads read a shared
+///        resource at the same time
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API ReadWriteMutex : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ReadWriteMutex();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ReadWriteMutex();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Lock the mutex for reading
+    ///
+    /// Several threads can hold the read lock at the same time.
+    /// If the mutex is locked for writing in another thread,
+    /// this call will block the execution until it is released.
+    ///
+    /// \see unlockRead
+    ///
+    ////////////////////////////////////////////////////////////
+    void lockRead();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release a read lock of the mutex
+    ///
+    /// \see lockRead
+    ///
+    ////////////////////////////////////////////////////////////
+    void unlockRead();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Lock the mutex for writing
+    ///
+    /// Only one thread can hold the write lock, and no thread
+    /// can hold a read lock at the same time. This call will
+    /// block the execution until the mutex is released by all
+    /// the other threads.
+    ///
+    /// \see unlockWrite
+    ///
+    ////////////////////////////////////////////////////////////
+    void lockWrite();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the write lock of the mutex
+    ///
+    /// \see lockWrite
+    ///
+    ////////////////////////////////////////////////////////////
+    void unlockWrite();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::ReadWriteMutexImpl* m_mutexImpl; ///< OS-specific implementation
+};
+
+} // namespace sf
+
+
+#endif // SFML_READWRITEMUTEX_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ReadWriteMutex
+/// \ingroup system
+///
+/// sf::ReadWriteMutex protects a resource that is read
+/// much more often than it is modified, such as a cache:
+/// readers don't block each other, only writers get an
+/// exclusive access.
+///
+/// This mutex is not recursive: a thread must not lock it
+/// again, for reading or for writing, while it holds it.
+///
+/// Like with sf::Mutex, the helper classes sf::ReadLock and
+/// sf::WriteLock should be preferred to locking it manually.
+///
+/// Usage example:
+/// \code
+/// std::map<std::string, int> cache;
+/// sf::ReadWriteMutex mutex;
+///
+/// int find(const std::string& key)
+/// {
+///     sf::ReadLock lock(mutex); // other readers can run in parallel
+///     std::map<std::string, int>::const_iterator it = cache.find(key);
+///     return it != cache.end() ? it->second : -1;
+/// }
+///
+/// void insert(const std::string& key, int value)
+/// {
+///     sf::WriteLock lock(mutex); // waits for the readers to finish
+///     cache[key] = value;
+/// }
+/// \endcode
+///
+/// \see sf::ReadLock, sf::WriteLock, sf::Mutex
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SIGNAL_HPP
+#define SFML_SIGNAL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/FastMutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Auto-reset event to wake up a waiting thread
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Signal : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The signal is initially not set.
+    ///
+    ////////////////////////////////////////////////////////////
+    Signal();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the signal
+    ///
+    /// Wakes up one waiting thread, or the next thread that
+    /// calls wait() if none is waiting. Setting a signal that
+    /// is already set does nothing.
+    ///
+    ////////////////////////////////////////////////////////////
+    void notify();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the signal is set, then reset it
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the signal is set or a timeout expires
+    ///
+    /// If the signal is set, it is reset before returning.
+    ///
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return True if the signal was set, false if the timeout expired
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait(Time timeout);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    FastMutex         m_mutex;     ///< Protects the state of the signal
+    ConditionVariable m_condition; ///< Wakes up the waiting threads
+    bool              m_set;       ///< Is the signal set?
+};
+
+} // namespace sf
+
+
+#endif // SFML_SIGNAL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Signal
+/// \ingroup system
+///
+/// sf::Signal is the simplest way to make a thread sleep
+/// until another one tells it there is something to do:
+/// the sleeping thread calls wait(), the other one calls
+/// notify(). A notification is never lost, if no thread is
+/// waiting it is kept until the next call to wait().
+///
+/// The signal resets itself when it wakes up a thread, so
+/// each notification wakes up exactly one thread, and
+/// several notifications sent before the thread wakes up
+/// count as one. When more state than "something happened"
+/// must be shared, use sf::ConditionVariable instead.
+///
+/// Usage example:
+/// \code
+/// sf::Signal dataReady;
+///
+/// void consumer()
+/// {
+///     while (running)
+///     {
+///         // Sleep until the producer has something, but
+///         // wake up regularly to check the running flag
+///         if (dataReady.wait(sf::milliseconds(100)))
+///             processData();
+///     }
+/// }
+///
+/// void producer()
+/// {
+///     produceData();
+///     dataReady.notify();
+/// }
+/// \endcode
+///
+/// \see sf::ConditionVariable
+///
+////////////////////////////////////////////////////////////
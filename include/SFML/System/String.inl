@@ -23,12 +23,40 @@
 ////////////////////////////////////////////////////////////
 
 
+namespace priv
+{
+// Append UTF-8 characters from any kind of iterator, one at a time
+template <typename T>
+void appendUtf8(std::basic_string<Uint32>& output, T begin, T end)
+{
+    Utf8::toUtf32(begin, end, std::back_inserter(output));
+}
+
+// Append UTF-8 characters from a contiguous buffer, with the bulk converter
+template <typename T>
+void appendUtf8(std::basic_string<Uint32>& output, T* begin, T* end)
+{
+    if (begin == end)
+        return;
+
+    // Room for the worst case, one character per byte, then shrink to the actual size
+    std::size_t size = output.size();
+    output.resize(size + (end - begin));
+
+    Uint32* first = &output[0] + size;
+    Uint32* last = Utf8::toUtf32(static_cast<const T*>(begin), static_cast<const T*>(end), first);
+    output.resize(size + (last - first));
+}
+
+} // namespace priv
+
+
 ////////////////////////////////////////////////////////////
 template <typename T>
 String String::fromUtf8(T begin, T end)
 {
     String string;
-    Utf8::toUtf32(begin, end, std::back_inserter(string.m_string));
+    priv::appendUtf8(string.m_string, begin, end);
     return string;
 }
 
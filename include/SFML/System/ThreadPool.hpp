@@ -0,0 +1,437 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_THREADPOOL_HPP
+#define SFML_THREADPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/FastMutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+    struct TaskState;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Fixed set of worker threads executing small tasks
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API ThreadPool : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle to a task pushed to a thread pool
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_SYSTEM_API Task
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Builds an invalid handle, which refers to no task.
+        ///
+        ////////////////////////////////////////////////////////////
+        Task();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Copy constructor
+        ///
+        /// \param copy Handle to copy
+        ///
+        ////////////////////////////////////////////////////////////
+        Task(const Task& copy);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Destructor
+        ///
+        /// Destroying a handle doesn't cancel its task.
+        ///
+        ////////////////////////////////////////////////////////////
+        ~Task();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Overload of assignment operator
+        ///
+        /// \param right Handle to assign
+        ///
+        /// \return Reference to self
+        ///
+        ////////////////////////////////////////////////////////////
+        Task& operator =(const Task& right);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Tell whether the handle refers to a task
+        ///
+        /// \return True if the handle refers to a task
+        ///
+        ////////////////////////////////////////////////////////////
+        bool isValid() const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Tell whether the task has finished running
+        ///
+        /// An invalid handle is always done.
+        ///
+        /// \return True if the task has finished
+        ///
+        ////////////////////////////////////////////////////////////
+        bool isDone() const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Wait until the task has finished running
+        ///
+        /// While waiting, the calling thread executes other
+        /// pending tasks of the pool, so it is safe to call
+        /// this function from inside a task.
+        ///
+        ////////////////////////////////////////////////////////////
+        void wait() const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Schedule a functor to run after this task
+        ///
+        /// The continuation is pushed to the pool as soon as
+        /// this task finishes, or immediately if it already
+        /// has. Continuations of an invalid handle are ignored.
+        ///
+        /// \param function Functor or free function to run
+        ///
+        /// \return Handle to the continuation
+        ///
+        ////////////////////////////////////////////////////////////
+        template <typename F>
+        Task then(F function) const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Schedule a function with one argument to run after this task
+        ///
+        /// \param function Functor or free function to run
+        /// \param argument Argument to pass to the function
+        ///
+        /// \return Handle to the continuation
+        ///
+        ////////////////////////////////////////////////////////////
+        template <typename F, typename A>
+        Task then(F function, A argument) const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Schedule a member function to run after this task
+        ///
+        /// \param function Member function to run
+        /// \param object   Object to call the function on
+        ///
+        /// \return Handle to the continuation
+        ///
+        ////////////////////////////////////////////////////////////
+        template <typename C>
+        Task then(void(C::*function)(), C* object) const;
+
+    private:
+
+        friend class ThreadPool;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Construct the handle from a task state
+        ///
+        /// The handle adopts one reference of the state.
+        ///
+        /// \param state State of the task
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit Task(priv::TaskState* state);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Schedule a type-erased continuation
+        ///
+        /// \param function Continuation to run, owned by the pool
+        ///
+        /// \return Handle to the continuation
+        ///
+        ////////////////////////////////////////////////////////////
+        Task thenFunction(priv::ThreadFunc* function) const;
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        priv::TaskState* m_state; ///< Shared state of the task
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the pool and start its worker threads
+    ///
+    /// \param threadCount Number of worker threads, 0 to use
+    ///                    one thread per processor core
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ThreadPool(unsigned int threadCount = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits for all the pushed tasks to finish, then stops
+    /// the worker threads.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ThreadPool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Push a functor to be run by the pool
+    ///
+    /// \param function Functor or free function to run
+    ///
+    /// \return Handle to the task
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    Task push(F function);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Push a function with one argument to be run by the pool
+    ///
+    /// \param function Functor or free function to run
+    /// \param argument Argument to pass to the function
+    ///
+    /// \return Handle to the task
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F, typename A>
+    Task push(F function, A argument);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Push a member function to be run by the pool
+    ///
+    /// \param function Member function to run
+    /// \param object   Object to call the function on
+    ///
+    /// \return Handle to the task
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename C>
+    Task push(void(C::*function)(), C* object);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Call a function for every index of a range, in parallel
+    ///
+    /// The range is split in chunks that are distributed among
+    /// the workers; the calling thread processes a chunk too,
+    /// then helps with the others until all are done.
+    ///
+    /// \param begin    First index of the range
+    /// \param end      One past the last index of the range
+    /// \param function Functor called as function(index)
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    void parallelFor(std::size_t begin, std::size_t end, F function);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until all the pushed tasks have finished
+    ///
+    /// The calling thread executes pending tasks while waiting.
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of worker threads of the pool
+    ///
+    /// \return Number of worker threads
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getThreadCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the pool shared by the whole library
+    ///
+    /// It is created on first use, with one worker per core,
+    /// and lives until the program ends.
+    ///
+    /// \return Reference to the default pool
+    ///
+    ////////////////////////////////////////////////////////////
+    static ThreadPool& getDefault();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of processor cores of the system
+    ///
+    /// \return Number of logical cores, at least 1
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getCoreCount();
+
+private:
+
+    friend class Task;
+    struct Worker;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Push a type-erased function to the pool
+    ///
+    /// \param function Function to run, owned by the pool
+    ///
+    /// \return Handle to the task
+    ///
+    ////////////////////////////////////////////////////////////
+    Task pushFunction(priv::ThreadFunc* function);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Put a task in the queue of one of the workers
+    ///
+    /// \param state Task to schedule
+    ///
+    ////////////////////////////////////////////////////////////
+    void schedule(priv::TaskState* state);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run one pending task, if any
+    ///
+    /// The worker's own queue is tried first, then tasks are
+    /// stolen from the other workers.
+    ///
+    /// \param self Worker looking for work, or NULL for a
+    ///             thread that is not part of the pool
+    ///
+    /// \return True if a task was run
+    ///
+    ////////////////////////////////////////////////////////////
+    bool runPendingTask(Worker* self);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark a task as done and schedule its continuations
+    ///
+    /// \param state Task that has just finished running
+    ///
+    ////////////////////////////////////////////////////////////
+    void complete(priv::TaskState* state);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current value of the activity counter
+    ///
+    /// \return Counter incremented whenever a task is scheduled or finishes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getEpoch() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sleep until a task is scheduled or finishes
+    ///
+    /// Returns immediately if it already happened since the
+    /// activity counter had the given value.
+    ///
+    /// \param epoch Value of the activity counter before looking for work
+    ///
+    ////////////////////////////////////////////////////////////
+    void waitForActivity(std::size_t epoch);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the worker threads
+    ///
+    /// \param worker Worker running on the thread
+    ///
+    ////////////////////////////////////////////////////////////
+    static void runWorker(Worker* worker);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Worker*> m_workers;    ///< Worker threads and their queues
+    std::size_t          m_nextWorker; ///< Worker that receives the next pushed task
+    std::size_t          m_pending;    ///< Number of tasks scheduled but not finished yet
+    std::size_t          m_epoch;      ///< Incremented whenever a task is scheduled or finishes
+    std::size_t          m_waiters;    ///< Number of threads waiting for tasks to finish
+    bool                 m_running;    ///< Tell the workers they must keep running
+    mutable FastMutex    m_mutex;      ///< Protects the counters above
+    ConditionVariable    m_activity;   ///< Notified when a task is scheduled or finishes
+};
+
+#include <SFML/System/ThreadPool.inl>
+
+} // namespace sf
+
+
+#endif // SFML_THREADPOOL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ThreadPool
+/// \ingroup system
+///
+/// sf::ThreadPool owns a fixed number of worker threads that
+/// run short tasks, which is much cheaper than creating an
+/// sf::Thread for every job. Tasks are pushed the same way
+/// an sf::Thread is constructed: from a functor, a function
+/// and its argument, or a member function and its object.
+///
+/// Each worker has its own queue; it takes its newest tasks
+/// first, and when it runs out of work it steals the oldest
+/// tasks of the other workers, so that busy threads are
+/// relieved by idle ones.
+///
+/// push() returns a sf::ThreadPool::Task handle, which can be
+/// used to wait for the task or to chain continuations that
+/// run once it has finished. Waiting is never idle: the
+/// waiting thread runs pending tasks in the meantime.
+///
+/// Most of the time there's no need to create a pool:
+/// sf::ThreadPool::getDefault() returns the one shared by
+/// SFML's own background work, such as image loading and
+/// glyph rasterization.
+///
+/// Usage example:
+/// \code
+/// void load(const std::string* filename);
+///
+/// sf::ThreadPool& pool = sf::ThreadPool::getDefault();
+///
+/// sf::ThreadPool::Task task = pool.push(&load, &filename);
+/// task.then(&notifyLoaded);
+///
+/// struct Blur
+/// {
+///     explicit Blur(Row* rows) : rows(rows) {}
+///     void operator()(std::size_t i) const {blurRow(rows[i]);}
+///     Row* rows;
+/// };
+///
+/// pool.parallelFor(0, rowCount, Blur(rows));
+/// \endcode
+///
+/// \see sf::Thread
+///
+////////////////////////////////////////////////////////////
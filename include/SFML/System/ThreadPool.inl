@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+namespace priv
+{
+// Functor running a function over a sub-range of indices
+template <typename F>
+struct ParallelForRange
+{
+    ParallelForRange(F function, std::size_t begin, std::size_t end) : m_function(function), m_begin(begin), m_end(end) {}
+    void operator()() {for (std::size_t i = m_begin; i < m_end; ++i) m_function(i);}
+    F           m_function;
+    std::size_t m_begin;
+    std::size_t m_end;
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+ThreadPool::Task ThreadPool::Task::then(F function) const
+{
+    return thenFunction(new priv::ThreadFunctor<F>(function));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename F, typename A>
+ThreadPool::Task ThreadPool::Task::then(F function, A argument) const
+{
+    return thenFunction(new priv::ThreadFunctorWithArg<F, A>(function, argument));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename C>
+ThreadPool::Task ThreadPool::Task::then(void(C::*function)(), C* object) const
+{
+    return thenFunction(new priv::ThreadMemberFunc<C>(function, object));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+ThreadPool::Task ThreadPool::push(F function)
+{
+    return pushFunction(new priv::ThreadFunctor<F>(function));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename F, typename A>
+ThreadPool::Task ThreadPool::push(F function, A argument)
+{
+    return pushFunction(new priv::ThreadFunctorWithArg<F, A>(function, argument));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename C>
+ThreadPool::Task ThreadPool::push(void(C::*function)(), C* object)
+{
+    return pushFunction(new priv::ThreadMemberFunc<C>(function, object));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+void ThreadPool::parallelFor(std::size_t begin, std::size_t end, F function)
+{
+    if (begin >= end)
+        return;
+
+    // A few chunks per worker keeps them balanced without flooding the queues
+    std::size_t count = end - begin;
+    std::size_t chunkCount = std::min<std::size_t>(count, std::max<std::size_t>(getThreadCount(), 1) * 4);
+    std::size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+    // Push all the chunks but the first one, which the calling thread processes itself
+    std::vector<Task> tasks;
+    tasks.reserve(chunkCount);
+    for (std::size_t first = begin + chunkSize; first < end; first += chunkSize)
+        tasks.push_back(push(priv::ParallelForRange<F>(function, first, std::min(first + chunkSize, end))));
+
+    priv::ParallelForRange<F> range(function, begin, std::min(begin + chunkSize, end));
+    range();
+
+    for (std::vector<Task>::const_iterator it = tasks.begin(); it != tasks.end(); ++it)
+        it->wait();
+}
@@ -64,7 +64,7 @@ public:
     ///
     /// \return Time in milliseconds
     ///
-    /// \see asSeconds, asMicroseconds
+    /// \see asSeconds, asMicroseconds, asNanoseconds
     ///
     ////////////////////////////////////////////////////////////
     Int32 asMilliseconds() const;
@@ -74,11 +74,21 @@ public:
     ///
     /// \return Time in microseconds
     ///
-    /// \see asSeconds, asMilliseconds
+    /// \see asSeconds, asMilliseconds, asNanoseconds
     ///
     ////////////////////////////////////////////////////////////
     Int64 asMicroseconds() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the time value as a number of nanoseconds
+    ///
+    /// \return Time in nanoseconds
+    ///
+    /// \see asSeconds, asMilliseconds, asMicroseconds
+    ///
+    ////////////////////////////////////////////////////////////
+    Int64 asNanoseconds() const;
+
     ////////////////////////////////////////////////////////////
     // Static member data
     ////////////////////////////////////////////////////////////
@@ -89,24 +99,26 @@ private:
     friend SFML_SYSTEM_API Time seconds(float);
     friend SFML_SYSTEM_API Time milliseconds(Int32);
     friend SFML_SYSTEM_API Time microseconds(Int64);
+    friend SFML_SYSTEM_API Time nanoseconds(Int64);
 
     ////////////////////////////////////////////////////////////
-    /// \brief Construct from a number of microseconds
+    /// \brief Construct from a number of nanoseconds
     ///
     /// This function is internal. To construct time values,
-    /// use sf::seconds, sf::milliseconds or sf::microseconds instead.
+    /// use sf::seconds, sf::milliseconds, sf::microseconds
+    /// or sf::nanoseconds instead.
     ///
-    /// \param microseconds Number of microseconds
+    /// \param nanoseconds Number of nanoseconds
     ///
     ////////////////////////////////////////////////////////////
-    explicit Time(Int64 microseconds);
+    explicit Time(Int64 nanoseconds);
 
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Int64 m_microseconds; ///< Time value stored as microseconds
+    Int64 m_nanoseconds; ///< Time value stored as nanoseconds
 };
 
 ////////////////////////////////////////////////////////////
@@ -117,7 +129,7 @@ private:
 ///
 /// \return Time value constructed from the amount of seconds
 ///
-/// \see milliseconds, microseconds
+/// \see milliseconds, microseconds, nanoseconds
 ///
 ////////////////////////////////////////////////////////////
 SFML_SYSTEM_API Time seconds(float amount);
@@ -130,7 +142,7 @@ SFML_SYSTEM_API Time seconds(float amount);
 ///
 /// \return Time value constructed from the amount of milliseconds
 ///
-/// \see seconds, microseconds
+/// \see seconds, microseconds, nanoseconds
 ///
 ////////////////////////////////////////////////////////////
 SFML_SYSTEM_API Time milliseconds(Int32 amount);
@@ -143,11 +155,24 @@ SFML_SYSTEM_API Time milliseconds(Int32 amount);
 ///
 /// \return Time value constructed from the amount of microseconds
 ///
-/// \see seconds, milliseconds
+/// \see seconds, milliseconds, nanoseconds
 ///
 ////////////////////////////////////////////////////////////
 SFML_SYSTEM_API Time microseconds(Int64 amount);
 
+////////////////////////////////////////////////////////////
+/// \relates Time
+/// \brief Construct a time value from a number of nanoseconds
+///
+/// \param amount Number of nanoseconds
+///
+/// \return Time value constructed from the amount of nanoseconds
+///
+/// \see seconds, milliseconds, microseconds
+///
+////////////////////////////////////////////////////////////
+SFML_SYSTEM_API Time nanoseconds(Int64 amount);
+
 ////////////////////////////////////////////////////////////
 /// \relates Time
 /// \brief Overload of == operator to compare two time values
@@ -447,9 +472,13 @@ SFML_SYSTEM_API Time& operator %=(Time& left, Time right);
 ///
 /// sf::Time encapsulates a time value in a flexible way.
 /// It allows to define a time value either as a number of
-/// seconds, milliseconds or microseconds. It also works the
-/// other way round: you can read a time value as either
-/// a number of seconds, milliseconds or microseconds.
+/// seconds, milliseconds, microseconds or nanoseconds. It also
+/// works the other way round: you can read a time value as
+/// either a number of seconds, milliseconds, microseconds or
+/// nanoseconds.
+///
+/// Time values are stored as a 64-bit number of nanoseconds,
+/// which covers about 292 years in both directions.
 ///
 /// By using such a flexible interface, the API doesn't
 /// impose any fixed type or resolution for time values,
@@ -472,6 +501,9 @@ SFML_SYSTEM_API Time& operator %=(Time& left, Time right);
 ///
 /// sf::Time t3 = sf::microseconds(-800000);
 /// float sec = t3.asSeconds(); // -0.8
+///
+/// sf::Time t4 = sf::nanoseconds(1500);
+/// Int64 nano = t4.asNanoseconds(); // 1500
 /// \endcode
 ///
 /// \code
@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
 #include <algorithm>
 #include <locale>
 #include <string>
@@ -245,6 +246,32 @@ public:
     ////////////////////////////////////////////////////////////
     template <typename In, typename Out>
     static Out toUtf32(In begin, In end, Out output);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert a contiguous buffer of UTF-8 characters to UTF-32
+    ///
+    /// This overload is selected for raw pointers, and gives
+    /// the same result as the generic version. Runs of ASCII
+    /// characters are converted 16 at a time with SIMD
+    /// instructions when they are available.
+    ///
+    /// The output buffer must have room for (end - begin)
+    /// characters, the worst case of a pure ASCII input.
+    ///
+    /// \param begin  Pointer to the beginning of the input sequence
+    /// \param end    Pointer to the end of the input sequence
+    /// \param output Pointer to the beginning of the output buffer
+    ///
+    /// \return Pointer to the end of the output sequence which has been written
+    ///
+    ////////////////////////////////////////////////////////////
+    static SFML_SYSTEM_API Uint32* toUtf32(const Uint8* begin, const Uint8* end, Uint32* output);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ///
+    ////////////////////////////////////////////////////////////
+    static SFML_SYSTEM_API Uint32* toUtf32(const char* begin, const char* end, Uint32* output);
 };
 
 ////////////////////////////////////////////////////////////
@@ -630,6 +657,27 @@ public:
     template <typename In, typename Out>
     static Out toUtf8(In begin, In end, Out output);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert a contiguous buffer of UTF-32 characters to UTF-8
+    ///
+    /// This overload is selected for raw pointers, and gives
+    /// the same result as the generic version. Runs of ASCII
+    /// characters are converted 16 at a time with SIMD
+    /// instructions when they are available.
+    ///
+    /// The output buffer must have room for 4 * (end - begin)
+    /// bytes, the worst case of an input made only of
+    /// characters outside the basic multilingual plane.
+    ///
+    /// \param begin  Pointer to the beginning of the input sequence
+    /// \param end    Pointer to the end of the input sequence
+    /// \param output Pointer to the beginning of the output buffer
+    ///
+    /// \return Pointer to the end of the output sequence which has been written
+    ///
+    ////////////////////////////////////////////////////////////
+    static SFML_SYSTEM_API Uint8* toUtf8(const Uint32* begin, const Uint32* end, Uint8* output);
+
     ////////////////////////////////////////////////////////////
     /// \brief Convert a UTF-32 characters range to UTF-16
     ///
@@ -0,0 +1,340 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_UTF8STRING_HPP
+#define SFML_UTF8STRING_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/String.hpp>
+#include <cstddef>
+#include <string>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Compact string storing its characters as UTF-8
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Utf8String
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty string.
+    ///
+    ////////////////////////////////////////////////////////////
+    Utf8String();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct from a null-terminated UTF-8 string
+    ///
+    /// Unlike sf::String, the bytes are interpreted as UTF-8,
+    /// not as ANSI characters of the current locale.
+    ///
+    /// \param utf8String UTF-8 string to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit Utf8String(const char* utf8String);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct from a std::string holding UTF-8
+    ///
+    /// \param utf8String UTF-8 string to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit Utf8String(const std::string& utf8String);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct from a buffer of UTF-8 bytes
+    ///
+    /// \param data Pointer to the first byte
+    /// \param size Number of bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    Utf8String(const char* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct from a sf::String
+    ///
+    /// \param string String to encode
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit Utf8String(const String& string);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    Utf8String(const Utf8String& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Utf8String();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Utf8String& operator =(const Utf8String& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of += operator to append a string
+    ///
+    /// \param right String to append
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Utf8String& operator +=(const Utf8String& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert the string to a sf::String
+    ///
+    /// \return UTF-32 copy of the string
+    ///
+    ////////////////////////////////////////////////////////////
+    String toString() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the UTF-8 bytes of the string to a std::string
+    ///
+    /// \return UTF-8 bytes of the string
+    ///
+    ////////////////////////////////////////////////////////////
+    std::string toStdString() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the code point at a given position
+    ///
+    /// Finding a position in UTF-8 requires walking the string,
+    /// so the last position accessed is cached: reading the
+    /// characters in order costs as much as with a sf::String.
+    /// Strings made only of ASCII characters are indexed
+    /// directly. No bounds checking is performed.
+    ///
+    /// Because of the cache, a string must not be indexed by
+    /// several threads at the same time.
+    ///
+    /// \param index Index of the character
+    ///
+    /// \return Code point of the character
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 operator [](std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clear the string
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of characters of the string
+    ///
+    /// \return Number of code points
+    ///
+    /// \see getByteSize
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bytes of the UTF-8 encoding
+    ///
+    /// \return Size of the encoded string, in bytes
+    ///
+    /// \see getSize
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getByteSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the string is empty or not
+    ///
+    /// \return True if the string is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isEmpty() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a pointer to the UTF-8 bytes of the string
+    ///
+    /// The returned pointer is null-terminated and remains
+    /// valid until the string is modified or destroyed.
+    ///
+    /// \return Read-only pointer to the UTF-8 bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    const char* getData() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Replace the contents of the string
+    ///
+    /// \param data Pointer to the UTF-8 bytes
+    /// \param size Number of bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void assign(const char* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure the buffer can hold a number of bytes
+    ///
+    /// The current contents are preserved.
+    ///
+    /// \param size Number of bytes, without the terminating zero
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the bytes are stored inside the object
+    ///
+    /// \return True if the string uses the local buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isLocal() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    enum {LocalCapacity = 23}; ///< Number of bytes stored without allocating
+
+    union
+    {
+        char  m_local[LocalCapacity + 1]; ///< Bytes of short strings, null-terminated
+        char* m_heap;                     ///< Bytes of long strings, null-terminated
+    };
+    Uint32         m_size;        ///< Number of bytes
+    Uint32         m_length;      ///< Number of code points
+    Uint32         m_capacity;    ///< Number of bytes the buffer can hold
+    mutable Uint32 m_cacheIndex;  ///< Index of the last character accessed
+    mutable Uint32 m_cacheOffset; ///< Byte offset of the last character accessed
+};
+
+////////////////////////////////////////////////////////////
+/// \relates Utf8String
+/// \brief Overload of == operator to compare two UTF-8 strings
+///
+/// \param left  Left operand (a string)
+/// \param right Right operand (a string)
+///
+/// \return True if both strings are equal
+///
+////////////////////////////////////////////////////////////
+SFML_SYSTEM_API bool operator ==(const Utf8String& left, const Utf8String& right);
+
+////////////////////////////////////////////////////////////
+/// \relates Utf8String
+/// \brief Overload of != operator to compare two UTF-8 strings
+///
+/// \param left  Left operand (a string)
+/// \param right Right operand (a string)
+///
+/// \return True if both strings are different
+///
+////////////////////////////////////////////////////////////
+SFML_SYSTEM_API bool operator !=(const Utf8String& left, const Utf8String& right);
+
+////////////////////////////////////////////////////////////
+/// \relates Utf8String
+/// \brief Overload of < operator to compare two UTF-8 strings
+///
+/// UTF-8 preserves the order of the code points, so the
+/// result is the same as with the UTF-32 sf::String.
+///
+/// \param left  Left operand (a string)
+/// \param right Right operand (a string)
+///
+/// \return True if \a left is lexicographically before \a right
+///
+////////////////////////////////////////////////////////////
+SFML_SYSTEM_API bool operator <(const Utf8String& left, const Utf8String& right);
+
+////////////////////////////////////////////////////////////
+/// \relates Utf8String
+/// \brief Overload of binary + operator to concatenate two strings
+///
+/// \param left  Left operand (a string)
+/// \param right Right operand (a string)
+///
+/// \return Concatenated string
+///
+////////////////////////////////////////////////////////////
+SFML_SYSTEM_API Utf8String operator +(const Utf8String& left, const Utf8String& right);
+
+} // namespace sf
+
+
+#endif // SFML_UTF8STRING_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Utf8String
+/// \ingroup system
+///
+/// sf::String stores every character on 4 bytes, which is
+/// convenient to manipulate but wasteful to keep around:
+/// large tables of translated texts can take several times
+/// the memory of their UTF-8 source. sf::Utf8String keeps
+/// the UTF-8 bytes instead, and strings of up to 23 bytes
+/// are stored inside the object, without any allocation.
+///
+/// It only provides what's needed to store and display
+/// strings: characters can be read by index, strings can
+/// be compared and concatenated, and converted from and to
+/// sf::String. sf::Text accepts them directly.
+///
+/// Note that, unlike sf::String, a char* or std::string
+/// given to sf::Utf8String is interpreted as UTF-8, not as
+/// ANSI characters of the current locale.
+///
+/// Usage example:
+/// \code
+/// std::vector<sf::Utf8String> translations;
+/// for (std::string line; std::getline(file, line); )
+///     translations.push_back(sf::Utf8String(line));
+///
+/// sf::Text text;
+/// text.setString(translations[greetingId]);
+/// \endcode
+///
+/// \see sf::String, sf::Utf
+///
+////////////////////////////////////////////////////////////
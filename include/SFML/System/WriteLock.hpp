@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_WRITELOCK_HPP
+#define SFML_WRITELOCK_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+class ReadWriteMutex;
+
+////////////////////////////////////////////////////////////
+/// \brief Automatic wrapper for locking and unlocking
+///        read-write mutexes for writeing
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API WriteLock : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the lock with a target mutex
+    ///
+    /// The mutex passed to sf::WriteLock is automatically locked
+    /// for writeing.
+    ///
+    /// \param mutex Mutex to lock
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit WriteLock(ReadWriteMutex& mutex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The destructor of sf::WriteLock automatically unlocks its mutex.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~WriteLock();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    ReadWriteMutex& m_mutex; ///< Mutex to lock / unlock
+};
+
+} // namespace sf
+
+
+#endif // SFML_WRITELOCK_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::WriteLock
+/// \ingroup system
+///
+/// sf::WriteLock is the RAII wrapper that locks a
+/// sf::ReadWriteMutex for writeing, and releases it when the
+/// current scope ends. It is used exactly like sf::Lock.
+///
+/// \see sf::ReadWriteMutex, sf::Lock
+///
+////////////////////////////////////////////////////////////
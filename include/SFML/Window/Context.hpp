@@ -88,6 +88,36 @@ public:
     ////////////////////////////////////////////////////////////
     static GlFunctionPointer getFunction(const char* name);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the unique identifier of the context active on the current thread
+    ///
+    /// Every OpenGL context (including the ones owned by windows)
+    /// is given a number that is never reused during the lifetime
+    /// of the program. It can be used to keep track of objects
+    /// that are not shared between contexts, such as frame
+    /// buffer objects or vertex array objects.
+    ///
+    /// \return Identifier of the active context, or 0 if no context is active
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getActiveContextId();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of context switches performed so far
+    ///
+    /// Making a context current is an expensive operation for
+    /// the driver. SFML skips the activation of a context that
+    /// is already current, this counter only grows when a
+    /// different context is actually made current, on any
+    /// thread. Reading it once per frame and comparing with
+    /// the previous value tells how many switches the frame
+    /// required.
+    ///
+    /// \return Number of context switches since the program started
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getSwitchCount();
+
     ////////////////////////////////////////////////////////////
     /// \brief Construct a in-memory context
     ///
@@ -33,6 +33,7 @@
 #include <SFML/Window/Keyboard.hpp>
 #include <SFML/Window/Mouse.hpp>
 #include <SFML/Window/Sensor.hpp>
+#include <SFML/System/Time.hpp>
 
 
 namespace sf
@@ -87,6 +88,20 @@ public:
         int y; ///< Y position of the mouse pointer, relative to the top of the owner window
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Raw mouse move event parameters (MouseMovedRaw)
+    ///
+    /// The motion is the one reported by the device, before
+    /// the system applies the pointer acceleration, and it
+    /// is not stopped by the borders of the window or the screen.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct MouseMoveRawEvent
+    {
+        int deltaX; ///< Horizontal motion of the mouse, in device units (positive is right)
+        int deltaY; ///< Vertical motion of the mouse, in device units (positive is down)
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Mouse buttons events parameters
     ///        (MouseButtonPressed, MouseButtonReleased)
@@ -209,6 +224,7 @@ public:
         TouchMoved,             ///< A touch moved (data in event.touch)
         TouchEnded,             ///< A touch event ended (data in event.touch)
         SensorChanged,          ///< A sensor value changed (data in event.sensor)
+        MouseMovedRaw,          ///< The mouse moved, in raw input mode (data in event.mouseMoveRaw)
 
         Count                   ///< Keep last -- the total number of event types
     };
@@ -224,6 +240,7 @@ public:
         KeyEvent              key;               ///< Key event parameters (Event::KeyPressed, Event::KeyReleased)
         TextEvent             text;              ///< Text event parameters (Event::TextEntered)
         MouseMoveEvent        mouseMove;         ///< Mouse move event parameters (Event::MouseMoved)
+        MouseMoveRawEvent     mouseMoveRaw;      ///< Raw mouse move event parameters (Event::MouseMovedRaw)
         MouseButtonEvent      mouseButton;       ///< Mouse button event parameters (Event::MouseButtonPressed, Event::MouseButtonReleased)
         MouseWheelEvent       mouseWheel;        ///< Mouse wheel event parameters (Event::MouseWheelMoved) (deprecated)
         MouseWheelScrollEvent mouseWheelScroll;  ///< Mouse wheel event parameters (Event::MouseWheelScrolled)
@@ -233,6 +250,8 @@ public:
         TouchEvent            touch;             ///< Touch events parameters (Event::TouchBegan, Event::TouchMoved, Event::TouchEnded)
         SensorEvent           sensor;            ///< Sensor event parameters (Event::SensorChanged)
     };
+
+    Time timestamp; ///< Time at which the event happened, on the clock of sf::Window::getEventTime
 };
 
 } // namespace sf
@@ -260,6 +279,13 @@ public:
 /// event.key member, all other members such as event.MouseMove
 /// or event.text will have undefined values.
 ///
+/// Every event also carries the time at which it happened.
+/// When the system provides it (keyboard and mouse events
+/// on Linux), it is the time of the input itself; otherwise,
+/// it is the time at which the event was read from the
+/// system. sf::Window::getEventTime returns the current
+/// time on the same clock, to measure the input latency.
+///
 /// Usage example:
 /// \code
 /// sf::Event event;
@@ -153,6 +153,33 @@ public:
         KeyCount      ///< Keep last -- the total number of keyboard keys
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Snapshot of the state of the whole keyboard
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_WINDOW_API State
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// All the keys are released.
+        ///
+        ////////////////////////////////////////////////////////////
+        State();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Check if a key was pressed when the snapshot was taken
+        ///
+        /// \param key Key to check
+        ///
+        /// \return True if the key is pressed, false otherwise
+        ///
+        ////////////////////////////////////////////////////////////
+        bool isKeyPressed(Key key) const;
+
+        bool keys[KeyCount]; ///< Pressed state of each key
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Check if a key is pressed
     ///
@@ -163,6 +190,20 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isKeyPressed(Key key);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the state of all the keys at once
+    ///
+    /// Querying the keyboard can be expensive on some systems
+    /// (on Linux, it is a round-trip to the X server). This
+    /// function reads all the keys with a single query, so
+    /// checking several keys every frame should be done on a
+    /// snapshot rather than with multiple calls to isKeyPressed.
+    ///
+    /// \return State of the keyboard
+    ///
+    ////////////////////////////////////////////////////////////
+    static State getState();
+
     ////////////////////////////////////////////////////////////
     /// \brief Show or hide the virtual keyboard
     ///
@@ -217,6 +258,13 @@ public:
 /// {
 ///     // quit...
 /// }
+///
+/// // check several keys with a single query
+/// sf::Keyboard::State keyboard = sf::Keyboard::getState();
+/// if (keyboard.isKeyPressed(sf::Keyboard::LControl) && keyboard.isKeyPressed(sf::Keyboard::S))
+/// {
+///     // save...
+/// }
 /// \endcode
 ///
 /// \see sf::Joystick, sf::Mouse, sf::Touch
@@ -69,6 +69,34 @@ public:
         HorizontalWheel ///< The horizontal mouse wheel
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Snapshot of the state of the mouse
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_WINDOW_API State
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// All the buttons are released and the position is (0, 0).
+        ///
+        ////////////////////////////////////////////////////////////
+        State();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Check if a button was pressed when the snapshot was taken
+        ///
+        /// \param button Button to check
+        ///
+        /// \return True if the button is pressed, false otherwise
+        ///
+        ////////////////////////////////////////////////////////////
+        bool isButtonPressed(Button button) const;
+
+        bool     buttons[ButtonCount]; ///< Pressed state of each button
+        Vector2i position;             ///< Position of the cursor
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Check if a mouse button is pressed
     ///
@@ -103,6 +131,29 @@ public:
     ////////////////////////////////////////////////////////////
     static Vector2i getPosition(const Window& relativeTo);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the buttons and the position of the mouse in desktop coordinates
+    ///
+    /// This function reads the whole state of the mouse with a
+    /// single query, which is cheaper than calling isButtonPressed
+    /// and getPosition separately on systems where each of them
+    /// is a round-trip to a server (Linux).
+    ///
+    /// \return State of the mouse, with the position relative to the desktop
+    ///
+    ////////////////////////////////////////////////////////////
+    static State getState();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the buttons and the position of the mouse in window coordinates
+    ///
+    /// \param relativeTo Reference window
+    ///
+    /// \return State of the mouse, with the position relative to \a relativeTo
+    ///
+    ////////////////////////////////////////////////////////////
+    static State getState(const Window& relativeTo);
+
     ////////////////////////////////////////////////////////////
     /// \brief Set the current position of the mouse in desktop coordinates
     ///
@@ -170,6 +221,11 @@ public:
 ///
 /// // set mouse position relative to a window
 /// sf::Mouse::setPosition(sf::Vector2i(100, 200), window);
+///
+/// // get the buttons and the position with a single query
+/// sf::Mouse::State mouse = sf::Mouse::getState(window);
+/// if (mouse.isButtonPressed(sf::Mouse::Left))
+///     drag(mouse.position);
 /// \endcode
 ///
 /// \see sf::Joystick, sf::Keyboard, sf::Touch
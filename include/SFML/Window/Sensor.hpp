@@ -84,6 +84,31 @@ public:
     ////////////////////////////////////////////////////////////
     static void setEnabled(Type sensor, bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable a sensor with a custom sampling rate
+    ///
+    /// \a interval is the requested delay between two samples;
+    /// Time::Zero selects the fastest rate supported by the sensor.
+    /// The device is free to deliver samples faster or slower.
+    ///
+    /// \a maxReportLatency lets the hardware batch samples for up
+    /// to that duration before waking the application, which saves
+    /// a lot of power when the values are only read once per frame.
+    /// It is ignored on devices that cannot batch sensor events.
+    ///
+    /// Whatever the rate, sf::Event::SensorChanged is sent at most
+    /// once per sensor and per event poll, with the latest value.
+    ///
+    /// This function does nothing if the sensor is unavailable.
+    ///
+    /// \param sensor           Sensor to enable
+    /// \param enabled          True to enable, false to disable
+    /// \param interval         Requested delay between two samples
+    /// \param maxReportLatency Maximum delay before batched samples are reported
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setEnabled(Type sensor, bool enabled, Time interval, Time maxReportLatency = Time::Zero);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the current sensor value
     ///
@@ -143,6 +168,9 @@ public:
 /// // enable the gravity sensor
 /// sf::Sensor::setEnabled(sf::Sensor::Gravity, true);
 ///
+/// // or sample it at 50 Hz, letting the hardware batch a frame worth of samples
+/// sf::Sensor::setEnabled(sf::Sensor::Gravity, true, sf::milliseconds(20), sf::milliseconds(16));
+///
 /// // get the current value of gravity
 /// sf::Vector3f gravity = sf::Sensor::getValue(sf::Sensor::Gravity);
 /// \endcode
@@ -38,6 +38,7 @@
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/String.hpp>
+#include <vector>
 
 
 namespace sf
@@ -239,6 +240,43 @@ public:
     ////////////////////////////////////////////////////////////
     bool waitEvent(Event& event);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Pop all the events of the event queue
+    ///
+    /// This function is not blocking. It returns all the pending
+    /// events at once, in the order they were received, which
+    /// is cheaper than calling pollEvent in a loop.
+    /// \code
+    /// std::vector<sf::Event> events;
+    /// window.pollEvents(events);
+    /// for (std::size_t i = 0; i < events.size(); ++i)
+    /// {
+    ///    // process events[i]...
+    /// }
+    /// \endcode
+    ///
+    /// \param events Array to fill with the events (previous content is cleared)
+    ///
+    /// \return True if at least one event was returned, or false if the event queue was empty
+    ///
+    /// \see pollEvent
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pollEvents(std::vector<Event>& events);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current time on the clock of the event timestamps
+    ///
+    /// The timestamps of the events (sf::Event::timestamp) are
+    /// measured on a clock shared by all the windows; this
+    /// function returns its current time, so that the age of
+    /// an event is getEventTime() - event.timestamp.
+    ///
+    /// \return Current time of the event clock
+    ///
+    ////////////////////////////////////////////////////////////
+    static Time getEventTime();
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the position of the window
     ///
@@ -337,9 +375,56 @@ public:
     ///
     /// \param enabled True to enable v-sync, false to deactivate it
     ///
+    /// \see setSwapInterval
+    ///
     ////////////////////////////////////////////////////////////
     void setVerticalSyncEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of vertical blanks to wait for between two frames
+    ///
+    /// An interval of 0 disables the vertical synchronization
+    /// and 1 is the same as setVerticalSyncEnabled(true). A
+    /// greater interval divides the framerate, for example 2
+    /// gives 30 frames per second on a 60 Hz monitor.
+    ///
+    /// A negative interval enables the adaptive vertical
+    /// synchronization with an interval of -interval: a frame
+    /// that comes late is displayed immediately, with some
+    /// tearing, instead of waiting for the next vertical blank.
+    /// This avoids halving the framerate when a frame
+    /// occasionally takes a bit longer than the refresh period.
+    ///
+    /// Not every system supports every interval; when the
+    /// interval is not supported, nothing is changed and false
+    /// is returned. Use isSwapIntervalSupported to choose a
+    /// fallback beforehand.
+    ///
+    /// \param interval Swap interval
+    ///
+    /// \return True if the interval was applied, false otherwise
+    ///
+    /// \see isSwapIntervalSupported, setVerticalSyncEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setSwapInterval(int interval);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether a swap interval can be used with this window
+    ///
+    /// Negative intervals (adaptive vertical synchronization)
+    /// require the GLX_EXT_swap_control_tear or
+    /// WGL_EXT_swap_control_tear extension.
+    ///
+    /// \param interval Swap interval to check
+    ///
+    /// \return True if setSwapInterval supports \a interval
+    ///
+    /// \see setSwapInterval
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSwapIntervalSupported(int interval) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Show or hide the mouse cursor
     ///
@@ -364,23 +449,105 @@ public:
     ////////////////////////////////////////////////////////////
     void setKeyRepeatEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the raw mouse input
+    ///
+    /// When raw input is enabled, the window receives
+    /// MouseMovedRaw events with the relative motion of the
+    /// mouse, as reported by the device, while it has the focus.
+    /// This is what a camera controlled by the mouse needs:
+    /// the motion is not accelerated and doesn't stop at the
+    /// borders of the screen, so there's no need to move the
+    /// cursor back to the center of the window every frame.
+    /// MouseMoved events are still generated.
+    ///
+    /// Raw input is supported on Windows, Linux (it requires the
+    /// XInput 2 extension) and Mac OS X. It is disabled by default.
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    /// \see setMouseMoveCoalescingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMouseRawInputEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the coalescing of mouse moves
+    ///
+    /// A mouse with a high polling rate can generate several
+    /// MouseMoved (or MouseMovedRaw) events per frame. When
+    /// coalescing is enabled, a mouse move that is queued
+    /// right after another one of the same type is merged into
+    /// it: MouseMoved keeps the last position and MouseMovedRaw
+    /// sums the deltas. The order of the other events is kept,
+    /// so a move never crosses a click.
+    ///
+    /// Coalescing is disabled by default.
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMouseMoveCoalescingEnabled(bool enabled);
+
     ////////////////////////////////////////////////////////////
     /// \brief Limit the framerate to a maximum fixed frequency
     ///
     /// If a limit is set, the window will use a small delay after
     /// each call to display() to ensure that the current frame
     /// lasted long enough to match the framerate limit.
-    /// SFML will try to match the given limit as much as it can,
-    /// but since it internally uses sf::sleep, whose precision
-    /// depends on the underlying OS, the results may be a little
-    /// unprecise as well (for example, you can get 65 FPS when
-    /// requesting 60).
+    /// The delay is made of a coarse sf::sleep, whose precision
+    /// depends on the underlying OS, followed by a short busy
+    /// wait for the remaining time. Frame deadlines are computed
+    /// from the previous deadline rather than from the end of
+    /// the previous frame, so that the timing errors don't
+    /// accumulate and the average framerate matches the limit.
     ///
     /// \param limit Framerate limit, in frames per seconds (use 0 to disable limit)
     ///
+    /// \see getFrameStatistics
+    ///
     ////////////////////////////////////////////////////////////
     void setFramerateLimit(unsigned int limit);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Timing of the frames presented by display()
+    ///
+    /// \see getFrameStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    struct FrameStatistics
+    {
+        Time   lastFrameTime;    ///< Duration of the last frame
+        Time   averageFrameTime; ///< Average duration of the frames since the last reset
+        Time   minFrameTime;     ///< Shortest frame since the last reset
+        Time   maxFrameTime;     ///< Longest frame since the last reset
+        Uint32 frameCount;       ///< Number of frames since the last reset
+        Uint32 missedFrames;     ///< Number of frames that exceeded the framerate limit by more than half a frame
+        Uint32 contextSwitches;  ///< Number of OpenGL context switches during the last frame, on all threads
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the timing of the frames since the last reset
+    ///
+    /// The duration of a frame is the time between two
+    /// consecutive calls to display(), including the delay
+    /// added by the framerate limit.
+    ///
+    /// \return Frame statistics
+    ///
+    /// \see resetFrameStatistics, setFramerateLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    const FrameStatistics& getFrameStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the frame statistics
+    ///
+    /// \see getFrameStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetFrameStatistics();
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the joystick threshold
     ///
@@ -510,14 +677,26 @@ private:
     ////////////////////////////////////////////////////////////
     void initialize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the deadline of the current frame
+    ///
+    ////////////////////////////////////////////////////////////
+    void waitFrameDeadline();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    priv::WindowImpl* m_impl;           ///< Platform-specific implementation of the window
-    priv::GlContext*  m_context;        ///< Platform-specific implementation of the OpenGL context
-    Clock             m_clock;          ///< Clock for measuring the elapsed time between frames
-    Time              m_frameTimeLimit; ///< Current framerate limit
-    Vector2u          m_size;           ///< Current size of the window
+    priv::WindowImpl* m_impl;            ///< Platform-specific implementation of the window
+    priv::GlContext*  m_context;         ///< Platform-specific implementation of the OpenGL context
+    Clock             m_clock;           ///< Clock for measuring the elapsed time between frames
+    Time              m_frameTimeLimit;  ///< Current framerate limit
+    Time              m_frameDeadline;   ///< Time at which the current frame should end
+    Time              m_frameEnd;        ///< Time at which the previous frame ended
+    Time              m_sleepMargin;     ///< Part of the delay that is busy-waited, to absorb the imprecision of sleep
+    Time              m_frameTimeTotal;  ///< Total duration of the frames since the statistics reset
+    FrameStatistics   m_frameStatistics; ///< Frame statistics
+    Uint64            m_switchCount;     ///< Context switch counter at the end of the previous frame
+    Vector2u          m_size;            ///< Current size of the window
 };
 
 } // namespace sf
@@ -37,6 +37,9 @@ namespace priv
 ////////////////////////////////////////////////////////////
 void alCheckError(const std::string& file, unsigned int line)
 {
+    // Count the checked call for sf::AudioStatistics
+    AudioCounters::countAlCall();
+
     // Get the last error
     ALenum errorCode = alGetError();
 
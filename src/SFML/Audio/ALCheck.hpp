@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Config.hpp>
+#include <SFML/Audio/AudioCounters.hpp>
 #include <iostream>
 #include <string>
 #ifdef SFML_SYSTEM_IOS
@@ -49,13 +50,13 @@ namespace priv
 ////////////////////////////////////////////////////////////
 #ifdef SFML_DEBUG
 
-    // If in debug mode, perform a test on every call
+    // If in debug mode, perform a test on every call (the test also counts the call)
     #define alCheck(x) x; sf::priv::alCheckError(__FILE__, __LINE__);
 
 #else
 
-    // Else, we don't add any overhead
-    #define alCheck(Func) (Func)
+    // Else, we only count the call for sf::AudioStatistics (when it is enabled)
+    #define alCheck(Func) (sf::priv::AudioCounters::countAlCall(), (Func))
 
 #endif
 
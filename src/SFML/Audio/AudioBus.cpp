@@ -0,0 +1,264 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/AudioBus.hpp>
+#include <SFML/Audio/AudioMixer.hpp>
+#include <SFML/Audio/BusSound.hpp>
+#include <SFML/Audio/MixKernels.hpp>
+#include <SFML/Audio/Reverb.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+AudioBus::AudioBus(AudioMixer& mixer) :
+m_mixer    (mixer),
+m_output   (NULL),
+m_buses    (),
+m_sounds   (),
+m_volume   (100.f),
+m_cutoff   (0.f),
+m_lowPass  (),
+m_reverbWet(0.f),
+m_roomSize (0.5f),
+m_reverb   (NULL),
+m_block    ()
+{
+    // The master bus itself is constructed with this constructor, it has no output
+    if (this != &mixer.m_master)
+    {
+        Lock lock(m_mixer.m_mutex);
+
+        m_output = &mixer.m_master;
+        m_output->m_buses.push_back(this);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+AudioBus::~AudioBus()
+{
+    {
+        Lock lock(m_mixer.m_mutex);
+
+        if (m_output)
+        {
+            // Disconnect from the output bus, and connect the inputs to it instead
+            m_output->m_buses.erase(std::find(m_output->m_buses.begin(), m_output->m_buses.end(), this));
+
+            for (std::vector<AudioBus*>::iterator it = m_buses.begin(); it != m_buses.end(); ++it)
+            {
+                (*it)->m_output = m_output;
+                m_output->m_buses.push_back(*it);
+            }
+
+            for (std::vector<BusSound*>::iterator it = m_sounds.begin(); it != m_sounds.end(); ++it)
+            {
+                (*it)->m_bus = m_output;
+                m_output->m_sounds.push_back(*it);
+            }
+        }
+    }
+
+    delete m_reverb;
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioBus::setOutput(AudioBus& output)
+{
+    Lock lock(m_mixer.m_mutex);
+
+    if (!m_output)
+    {
+        err() << "Failed to change the output of the master bus" << std::endl;
+        return;
+    }
+
+    if (&output.m_mixer != &m_mixer)
+    {
+        err() << "Failed to change the output of a bus (the new output belongs to another mixer)" << std::endl;
+        return;
+    }
+
+    if ((&output == this) || output.feeds(*this))
+    {
+        err() << "Failed to change the output of a bus (it would create a cycle)" << std::endl;
+        return;
+    }
+
+    m_output->m_buses.erase(std::find(m_output->m_buses.begin(), m_output->m_buses.end(), this));
+    m_output = &output;
+    m_output->m_buses.push_back(this);
+}
+
+
+////////////////////////////////////////////////////////////
+AudioBus* AudioBus::getOutput() const
+{
+    Lock lock(m_mixer.m_mutex);
+
+    return m_output;
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioBus::setVolume(float volume)
+{
+    Lock lock(m_mixer.m_mutex);
+
+    m_volume = volume;
+}
+
+
+////////////////////////////////////////////////////////////
+float AudioBus::getVolume() const
+{
+    Lock lock(m_mixer.m_mutex);
+
+    return m_volume;
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioBus::setLowPass(float frequency)
+{
+    Lock lock(m_mixer.m_mutex);
+
+    m_cutoff = frequency;
+}
+
+
+////////////////////////////////////////////////////////////
+float AudioBus::getLowPass() const
+{
+    Lock lock(m_mixer.m_mutex);
+
+    return m_cutoff;
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioBus::setReverb(float wet, float roomSize)
+{
+    Lock lock(m_mixer.m_mutex);
+
+    m_reverbWet = std::min(std::max(wet, 0.f), 1.f);
+    m_roomSize = std::min(std::max(roomSize, 0.f), 1.f);
+
+    // Allocate the delay lines the first time the reverb is enabled
+    if ((m_reverbWet > 0.f) && !m_reverb)
+    {
+        m_reverb = new priv::Reverb;
+        m_reverb->setup(m_mixer.getChannelCount(), m_mixer.getSampleRate());
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+float AudioBus::getReverbWet() const
+{
+    Lock lock(m_mixer.m_mutex);
+
+    return m_reverbWet;
+}
+
+
+////////////////////////////////////////////////////////////
+float AudioBus::getReverbRoomSize() const
+{
+    Lock lock(m_mixer.m_mutex);
+
+    return m_roomSize;
+}
+
+
+////////////////////////////////////////////////////////////
+AudioMixer& AudioBus::getMixer() const
+{
+    return m_mixer;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AudioBus::feeds(const AudioBus& bus) const
+{
+    for (const AudioBus* output = m_output; output; output = output->m_output)
+    {
+        if (output == &bus)
+            return true;
+    }
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioBus::process(float* output, std::size_t frameCount)
+{
+    unsigned int channelCount = m_mixer.getChannelCount();
+    unsigned int sampleRate = m_mixer.getSampleRate();
+    std::size_t count = frameCount * channelCount;
+
+    // Mix the inputs
+    m_block.assign(count, 0.f);
+
+    for (std::vector<BusSound*>::iterator it = m_sounds.begin(); it != m_sounds.end(); ++it)
+        (*it)->process(&m_block[0], frameCount, channelCount, sampleRate);
+
+    for (std::vector<AudioBus*>::iterator it = m_buses.begin(); it != m_buses.end(); ++it)
+        (*it)->process(&m_block[0], frameCount);
+
+    // Apply the one-pole low-pass filter
+    if (m_cutoff > 0.f)
+    {
+        m_lowPass.resize(channelCount, 0.f);
+        float factor = 1.f - std::exp(-2.f * 3.141592654f * m_cutoff / sampleRate);
+        for (std::size_t f = 0; f < frameCount; ++f)
+        {
+            for (unsigned int c = 0; c < channelCount; ++c)
+            {
+                float& sample = m_block[f * channelCount + c];
+                m_lowPass[c] += factor * (sample - m_lowPass[c]);
+                sample = m_lowPass[c];
+            }
+        }
+    }
+
+    // Apply the reverb
+    if (m_reverb && (m_reverbWet > 0.f))
+        m_reverb->process(&m_block[0], frameCount, m_reverbWet, m_roomSize);
+
+    // Add the result to the output
+    priv::mixSamples(output, &m_block[0], count, m_volume / 100.f);
+}
+
+} // namespace sf
@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_AUDIOCOUNTERS_HPP
+#define SFML_AUDIOCOUNTERS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Update the global counters of sf::AudioStatistics
+///
+////////////////////////////////////////////////////////////
+class AudioCounters
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Count an OpenAL call, if enabled
+    ///
+    ////////////////////////////////////////////////////////////
+    static void countAlCall();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Register a new sound source
+    ///
+    /// \param source OpenAL identifier of the source
+    ///
+    ////////////////////////////////////////////////////////////
+    static void addSource(unsigned int source);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unregister a sound source that is destroyed
+    ///
+    /// \param source OpenAL identifier of the source
+    ///
+    ////////////////////////////////////////////////////////////
+    static void removeSource(unsigned int source);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the number of streaming sound streams
+    ///
+    /// \param started True if a stream started, false if it stopped
+    ///
+    ////////////////////////////////////////////////////////////
+    static void countStream(bool started);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Count an underrun of a sound stream
+    ///
+    ////////////////////////////////////////////////////////////
+    static void countUnderrun();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Count a chunk produced by a sound stream
+    ///
+    /// \param decodeTime Time taken to produce the chunk
+    ///
+    ////////////////////////////////////////////////////////////
+    static void countChunk(Time decodeTime);
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_AUDIOCOUNTERS_HPP
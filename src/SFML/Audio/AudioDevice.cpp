@@ -37,6 +37,12 @@ namespace
     ALCdevice*  audioDevice  = NULL;
     ALCcontext* audioContext = NULL;
 
+    // AL_SOFT_deferred_updates functions, loaded when the context is created
+    typedef void (AL_APIENTRY *DeferUpdatesFunc)();
+    DeferUpdatesFunc alDeferUpdates  = NULL;
+    DeferUpdatesFunc alProcessUpdates = NULL;
+    unsigned int     deferDepth       = 0;
+
     float        listenerVolume = 100.f;
     sf::Vector3f listenerPosition (0.f, 0.f, 0.f);
     sf::Vector3f listenerDirection(0.f, 0.f, -1.f);
@@ -73,6 +79,20 @@ AudioDevice::AudioDevice()
             alCheck(alListenerf(AL_GAIN, listenerVolume * 0.01f));
             alCheck(alListener3f(AL_POSITION, listenerPosition.x, listenerPosition.y, listenerPosition.z));
             alCheck(alListenerfv(AL_ORIENTATION, orientation));
+
+            // Prefer the OpenAL Soft extension to suspend/process, that many implementations ignore
+            if (alIsExtensionPresent("AL_SOFT_deferred_updates"))
+            {
+                alDeferUpdates   = reinterpret_cast<DeferUpdatesFunc>(alGetProcAddress("alDeferUpdatesSOFT"));
+                alProcessUpdates = reinterpret_cast<DeferUpdatesFunc>(alGetProcAddress("alProcessUpdatesSOFT"));
+            }
+
+            // Apply the deferral requested before the context existed
+            if (deferDepth > 0)
+            {
+                deferDepth--;
+                deferUpdates();
+            }
         }
         else
         {
@@ -93,6 +113,9 @@ AudioDevice::~AudioDevice()
     alcMakeContextCurrent(NULL);
     if (audioContext)
         alcDestroyContext(audioContext);
+    audioContext = NULL;
+    alDeferUpdates = NULL;
+    alProcessUpdates = NULL;
 
     // Destroy the device
     if (audioDevice)
@@ -150,6 +173,38 @@ int AudioDevice::getFormatFromChannelCount(unsigned int channelCount)
 }
 
 
+////////////////////////////////////////////////////////////
+int AudioDevice::getFloatFormatFromChannelCount(unsigned int channelCount)
+{
+    // Create a temporary audio device in case none exists yet
+    std::auto_ptr<AudioDevice> device;
+    if (!audioDevice)
+        device.reset(new AudioDevice);
+
+    if (!isExtensionSupported("AL_EXT_FLOAT32"))
+        return 0;
+
+    // Find the good format according to the number of channels
+    int format = 0;
+    switch (channelCount)
+    {
+        case 1:  format = alGetEnumValue("AL_FORMAT_MONO_FLOAT32");   break;
+        case 2:  format = alGetEnumValue("AL_FORMAT_STEREO_FLOAT32"); break;
+        case 4:  format = alGetEnumValue("AL_FORMAT_QUAD32");         break;
+        case 6:  format = alGetEnumValue("AL_FORMAT_51CHN32");        break;
+        case 7:  format = alGetEnumValue("AL_FORMAT_61CHN32");        break;
+        case 8:  format = alGetEnumValue("AL_FORMAT_71CHN32");        break;
+        default: format = 0;                                          break;
+    }
+
+    // Fixes a bug on OS X
+    if (format == -1)
+        format = 0;
+
+    return format;
+}
+
+
 ////////////////////////////////////////////////////////////
 void AudioDevice::setGlobalVolume(float volume)
 {
@@ -223,6 +278,40 @@ Vector3f AudioDevice::getUpVector()
     return listenerUpVector;
 }
 
+
+////////////////////////////////////////////////////////////
+void AudioDevice::deferUpdates()
+{
+    // Only the outermost call defers
+    if (deferDepth++ > 0)
+        return;
+
+    if (!audioContext)
+        return;
+
+    if (alDeferUpdates)
+        alDeferUpdates();
+    else
+        alcSuspendContext(audioContext);
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioDevice::processUpdates()
+{
+    // Only the outermost call applies the changes
+    if ((deferDepth == 0) || (--deferDepth > 0))
+        return;
+
+    if (!audioContext)
+        return;
+
+    if (alProcessUpdates)
+        alProcessUpdates();
+    else
+        alcProcessContext(audioContext);
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -83,6 +83,18 @@ public:
     ////////////////////////////////////////////////////////////
     static int getFormatFromChannelCount(unsigned int channelCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the OpenAL 32-bits float format that matches
+    ///        the given number of channels
+    ///
+    /// \param channelCount Number of channels
+    ///
+    /// \return Corresponding format, or 0 if the implementation
+    ///         doesn't support float samples (AL_EXT_FLOAT32)
+    ///
+    ////////////////////////////////////////////////////////////
+    static int getFloatFormatFromChannelCount(unsigned int channelCount);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the global volume of all the sounds and musics
     ///
@@ -182,6 +194,18 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     static Vector3f getUpVector();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start deferring the changes of audio properties
+    ///
+    ////////////////////////////////////////////////////////////
+    static void deferUpdates();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the changes deferred since deferUpdates()
+    ///
+    ////////////////////////////////////////////////////////////
+    static void processUpdates();
 };
 
 } // namespace priv
@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/AudioMixer.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+
+#ifdef _MSC_VER
+    #pragma warning(disable: 4355) // 'this' used in base member initializer list
+#endif
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+AudioMixer::AudioMixer(unsigned int channelCount, unsigned int sampleRate) :
+m_mutex  (),
+m_master (*this),
+m_samples()
+{
+    initialize(channelCount, sampleRate);
+
+    // Keep the latency low, so that the changes of the graph are heard quickly
+    setBufferDuration(milliseconds(20));
+    setBufferCount(3);
+}
+
+
+////////////////////////////////////////////////////////////
+AudioMixer::~AudioMixer()
+{
+    // The streaming thread must not use the graph anymore
+    stop();
+}
+
+
+////////////////////////////////////////////////////////////
+AudioBus& AudioMixer::getMaster()
+{
+    return m_master;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AudioMixer::onGetData(SoundStream::Chunk& data)
+{
+    Lock lock(m_mutex);
+
+    // Mix the whole graph for the duration of a buffer
+    std::size_t frameCount = static_cast<std::size_t>(getBufferDuration().asMicroseconds() * getSampleRate() / 1000000);
+    frameCount = std::max(frameCount, static_cast<std::size_t>(1));
+    m_samples.assign(frameCount * getChannelCount(), 0.f);
+
+    m_master.process(&m_samples[0], frameCount);
+
+    // Fill the chunk parameters
+    data.samples      = NULL;
+    data.floatSamples = &m_samples[0];
+    data.sampleCount  = m_samples.size();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioMixer::onSeek(Time)
+{
+    // Nothing to do
+}
+
+} // namespace sf
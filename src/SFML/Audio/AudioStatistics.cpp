@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/AudioStatistics.hpp>
+#include <SFML/Audio/AudioCounters.hpp>
+#include <SFML/Audio/ALCheck.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/FastMutex.hpp>
+#include <set>
+
+
+namespace
+{
+    sf::FastMutex          mutex;
+    bool                   enabled = false;
+    sf::Uint64             alCalls = 0;
+    std::set<unsigned int> sources;
+    unsigned int           streams = 0;
+    sf::Uint32             underruns = 0;
+    sf::Uint64             chunks = 0;
+    sf::Int64              decodeTime = 0;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+void AudioStatistics::setEnabled(bool enable)
+{
+    Lock lock(mutex);
+
+    enabled = enable;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AudioStatistics::isEnabled()
+{
+    Lock lock(mutex);
+
+    return enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+AudioStatistics::Counters AudioStatistics::getCounters()
+{
+    Lock lock(mutex);
+
+    Counters counters;
+    counters.alCalls        = alCalls;
+    counters.sources        = static_cast<unsigned int>(sources.size());
+    counters.playingSources = 0;
+    counters.streams        = streams;
+    counters.underruns      = underruns;
+    counters.chunks         = chunks;
+    counters.decodeTime     = microseconds(decodeTime);
+
+    // Query the state of the sources (not counted as OpenAL calls)
+    for (std::set<unsigned int>::const_iterator it = sources.begin(); it != sources.end(); ++it)
+    {
+        ALint state = AL_STOPPED;
+        alGetSourcei(*it, AL_SOURCE_STATE, &state);
+        if (state == AL_PLAYING)
+            counters.playingSources++;
+    }
+
+    return counters;
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioStatistics::resetCounters()
+{
+    Lock lock(mutex);
+
+    alCalls = 0;
+    underruns = 0;
+    chunks = 0;
+    decodeTime = 0;
+}
+
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void AudioCounters::countAlCall()
+{
+    // The flag is read without locking, so that disabled counting costs almost nothing
+    if (enabled)
+    {
+        Lock lock(mutex);
+        alCalls++;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioCounters::addSource(unsigned int source)
+{
+    Lock lock(mutex);
+
+    sources.insert(source);
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioCounters::removeSource(unsigned int source)
+{
+    Lock lock(mutex);
+
+    sources.erase(source);
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioCounters::countStream(bool started)
+{
+    Lock lock(mutex);
+
+    if (started)
+        streams++;
+    else if (streams > 0)
+        streams--;
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioCounters::countUnderrun()
+{
+    Lock lock(mutex);
+
+    underruns++;
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioCounters::countChunk(Time time)
+{
+    Lock lock(mutex);
+
+    chunks++;
+    decodeTime += time.asMicroseconds();
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,367 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/BusSound.hpp>
+#include <SFML/Audio/AudioBus.hpp>
+#include <SFML/Audio/AudioMixer.hpp>
+#include <SFML/Audio/MixKernels.hpp>
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+BusSound::BusSound(AudioBus& bus) :
+m_bus         (&bus),
+m_buffer      (NULL),
+m_samples     (NULL),
+m_floatSamples(NULL),
+m_frameCount  (0),
+m_channelCount(0),
+m_sampleRate  (0),
+m_position    (0),
+m_status      (SoundSource::Stopped),
+m_loop        (false),
+m_pitch       (1.f),
+m_volume      (100.f),
+m_pan         (0.f),
+m_block       ()
+{
+    Lock lock(bus.m_mixer.m_mutex);
+
+    bus.m_sounds.push_back(this);
+}
+
+
+////////////////////////////////////////////////////////////
+BusSound::BusSound(AudioBus& bus, const SoundBuffer& buffer) :
+m_bus         (&bus),
+m_buffer      (NULL),
+m_samples     (NULL),
+m_floatSamples(NULL),
+m_frameCount  (0),
+m_channelCount(0),
+m_sampleRate  (0),
+m_position    (0),
+m_status      (SoundSource::Stopped),
+m_loop        (false),
+m_pitch       (1.f),
+m_volume      (100.f),
+m_pan         (0.f),
+m_block       ()
+{
+    {
+        Lock lock(bus.m_mixer.m_mutex);
+
+        bus.m_sounds.push_back(this);
+    }
+
+    setBuffer(buffer);
+}
+
+
+////////////////////////////////////////////////////////////
+BusSound::~BusSound()
+{
+    Lock lock(m_bus->m_mixer.m_mutex);
+
+    m_bus->m_sounds.erase(std::find(m_bus->m_sounds.begin(), m_bus->m_sounds.end(), this));
+}
+
+
+////////////////////////////////////////////////////////////
+void BusSound::play()
+{
+    Lock lock(m_bus->m_mixer.m_mutex);
+
+    if (m_frameCount > 0)
+        m_status = SoundSource::Playing;
+}
+
+
+////////////////////////////////////////////////////////////
+void BusSound::pause()
+{
+    Lock lock(m_bus->m_mixer.m_mutex);
+
+    if (m_status == SoundSource::Playing)
+        m_status = SoundSource::Paused;
+}
+
+
+////////////////////////////////////////////////////////////
+void BusSound::stop()
+{
+    Lock lock(m_bus->m_mixer.m_mutex);
+
+    m_status = SoundSource::Stopped;
+    m_position = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void BusSound::setBuffer(const SoundBuffer& buffer)
+{
+    Lock lock(m_bus->m_mixer.m_mutex);
+
+    m_buffer = &buffer;
+    m_samples = buffer.getSamples();
+    m_floatSamples = buffer.getFloatSamples();
+    m_channelCount = buffer.getChannelCount();
+    m_sampleRate = buffer.getSampleRate();
+    m_frameCount = 0;
+    m_position = 0;
+    m_status = SoundSource::Stopped;
+
+    if (!m_samples && !m_floatSamples)
+    {
+        err() << "Failed to set the buffer of a bus sound (the buffer has no samples in memory)" << std::endl;
+        return;
+    }
+
+    if (m_channelCount > 0)
+        m_frameCount = static_cast<std::size_t>(buffer.getSampleCount() / m_channelCount);
+}
+
+
+////////////////////////////////////////////////////////////
+const SoundBuffer* BusSound::getBuffer() const
+{
+    Lock lock(m_bus->m_mixer.m_mutex);
+
+    return m_buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void BusSound::setBus(AudioBus& bus)
+{
+    Lock lock(m_bus->m_mixer.m_mutex);
+
+    if (&bus.m_mixer != &m_bus->m_mixer)
+    {
+        err() << "Failed to change the bus of a bus sound (the new bus belongs to another mixer)" << std::endl;
+        return;
+    }
+
+    m_bus->m_sounds.erase(std::find(m_bus->m_sounds.begin(), m_bus->m_sounds.end(), this));
+    m_bus = &bus;
+    m_bus->m_sounds.push_back(this);
+}
+
+
+////////////////////////////////////////////////////////////
+AudioBus& BusSound::getBus() const
+{
+    return *m_bus;
+}
+
+
+////////////////////////////////////////////////////////////
+void BusSound::setLoop(bool loop)
+{
+    Lock lock(m_bus->m_mixer.m_mutex);
+
+    m_loop = loop;
+}
+
+
+////////////////////////////////////////////////////////////
+bool BusSound::getLoop() const
+{
+    Lock lock(m_bus->m_mixer.m_mutex);
+
+    return m_loop;
+}
+
+
+////////////////////////////////////////////////////////////
+void BusSound::setPitch(float pitch)
+{
+    Lock lock(m_bus->m_mixer.m_mutex);
+
+    m_pitch = pitch;
+}
+
+
+////////////////////////////////////////////////////////////
+float BusSound::getPitch() const
+{
+    Lock lock(m_bus->m_mixer.m_mutex);
+
+    return m_pitch;
+}
+
+
+////////////////////////////////////////////////////////////
+void BusSound::setVolume(float volume)
+{
+    Lock lock(m_bus->m_mixer.m_mutex);
+
+    m_volume = volume;
+}
+
+
+////////////////////////////////////////////////////////////
+float BusSound::getVolume() const
+{
+    Lock lock(m_bus->m_mixer.m_mutex);
+
+    return m_volume;
+}
+
+
+////////////////////////////////////////////////////////////
+void BusSound::setPan(float pan)
+{
+    Lock lock(m_bus->m_mixer.m_mutex);
+
+    m_pan = std::min(std::max(pan, -1.f), 1.f);
+}
+
+
+////////////////////////////////////////////////////////////
+float BusSound::getPan() const
+{
+    Lock lock(m_bus->m_mixer.m_mutex);
+
+    return m_pan;
+}
+
+
+////////////////////////////////////////////////////////////
+void BusSound::setPlayingOffset(Time timeOffset)
+{
+    Lock lock(m_bus->m_mixer.m_mutex);
+
+    double position = timeOffset.asMicroseconds() * static_cast<double>(m_sampleRate) / 1000000;
+    m_position = std::min(std::max(position, 0.), static_cast<double>(m_frameCount));
+}
+
+
+////////////////////////////////////////////////////////////
+Time BusSound::getPlayingOffset() const
+{
+    Lock lock(m_bus->m_mixer.m_mutex);
+
+    if (m_sampleRate == 0)
+        return Time::Zero;
+
+    return microseconds(static_cast<Int64>(m_position * 1000000 / m_sampleRate));
+}
+
+
+////////////////////////////////////////////////////////////
+SoundSource::Status BusSound::getStatus() const
+{
+    Lock lock(m_bus->m_mixer.m_mutex);
+
+    return m_status;
+}
+
+
+////////////////////////////////////////////////////////////
+void BusSound::process(float* output, std::size_t frameCount, unsigned int channelCount, unsigned int sampleRate)
+{
+    if ((m_status != SoundSource::Playing) || (m_frameCount == 0))
+        return;
+
+    // Resample the buffer to the rate of the mixer, with linear interpolation
+    double step = static_cast<double>(m_sampleRate) / sampleRate * m_pitch;
+    m_block.assign(frameCount * channelCount, 0.f);
+
+    std::size_t rendered = 0;
+    for (; rendered < frameCount; ++rendered)
+    {
+        if (m_position >= m_frameCount)
+        {
+            if (!m_loop)
+            {
+                m_status = SoundSource::Stopped;
+                m_position = 0;
+                break;
+            }
+
+            m_position = std::fmod(m_position, static_cast<double>(m_frameCount));
+        }
+
+        std::size_t index = static_cast<std::size_t>(m_position);
+        std::size_t next = (index + 1 < m_frameCount) ? index + 1 : (m_loop ? 0 : index);
+        float factor = static_cast<float>(m_position - index);
+
+        float* frame = &m_block[rendered * channelCount];
+        for (unsigned int c = 0; c < channelCount; ++c)
+        {
+            // Duplicate the channels of the buffer if the output has more of them, or average them if it has less
+            unsigned int first = c % m_channelCount;
+            unsigned int sourceCount = 0;
+            for (unsigned int source = first; source < m_channelCount; source += channelCount)
+            {
+                float current = getSample(index, source);
+                frame[c] += current + (getSample(next, source) - current) * factor;
+                sourceCount++;
+            }
+
+            if (sourceCount > 1)
+                frame[c] /= sourceCount;
+        }
+
+        m_position += step;
+    }
+
+    // Add the rendered samples to the output, applying the volume and the stereo balance
+    float volume = m_volume / 100.f;
+    if ((channelCount == 2) && (m_pan != 0.f))
+    {
+        float left = volume * std::min(1.f - m_pan, 1.f);
+        float right = volume * std::min(1.f + m_pan, 1.f);
+        for (std::size_t f = 0; f < rendered; ++f)
+        {
+            output[f * 2]     += m_block[f * 2] * left;
+            output[f * 2 + 1] += m_block[f * 2 + 1] * right;
+        }
+    }
+    else
+    {
+        priv::mixSamples(output, &m_block[0], rendered * channelCount, volume);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+float BusSound::getSample(std::size_t frame, unsigned int channel) const
+{
+    std::size_t index = frame * m_channelCount + channel;
+
+    return m_floatSamples ? m_floatSamples[index] : m_samples[index] / 32768.f;
+}
+
+} // namespace sf
@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/CompressedSoundBuffer.hpp>
+#include <SFML/Audio/InputSoundFile.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+CompressedSoundBuffer::CompressedSoundBuffer() :
+m_data        (),
+m_channelCount(0),
+m_sampleRate  (0),
+m_duration    ()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedSoundBuffer::loadFromFile(const std::string& filename)
+{
+    FileInputStream file;
+    if (!file.open(filename))
+    {
+        err() << "Failed to open sound file \"" << filename << "\"" << std::endl;
+        return false;
+    }
+
+    return loadFromStream(file);
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedSoundBuffer::loadFromMemory(const void* data, std::size_t sizeInBytes)
+{
+    if (!data || !sizeInBytes)
+    {
+        err() << "Failed to load compressed sound buffer from memory (no data provided)" << std::endl;
+        return false;
+    }
+
+    const char* begin = static_cast<const char*>(data);
+    m_data.assign(begin, begin + sizeInBytes);
+
+    return initialize();
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedSoundBuffer::loadFromStream(InputStream& stream)
+{
+    // Read the whole stream
+    Int64 size = stream.getSize();
+    if ((size <= 0) || (stream.seek(0) == -1))
+    {
+        err() << "Failed to load compressed sound buffer from stream (empty or unseekable stream)" << std::endl;
+        return false;
+    }
+
+    m_data.resize(static_cast<std::size_t>(size));
+    if (stream.read(&m_data[0], size) != size)
+    {
+        err() << "Failed to load compressed sound buffer from stream (read error)" << std::endl;
+        m_data.clear();
+        return false;
+    }
+
+    return initialize();
+}
+
+
+////////////////////////////////////////////////////////////
+const void* CompressedSoundBuffer::getData() const
+{
+    return m_data.empty() ? NULL : &m_data[0];
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CompressedSoundBuffer::getDataSize() const
+{
+    return m_data.size();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int CompressedSoundBuffer::getChannelCount() const
+{
+    return m_channelCount;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int CompressedSoundBuffer::getSampleRate() const
+{
+    return m_sampleRate;
+}
+
+
+////////////////////////////////////////////////////////////
+Time CompressedSoundBuffer::getDuration() const
+{
+    return m_duration;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedSoundBuffer::initialize()
+{
+    // Open the data once to check it and retrieve the sound properties
+    InputSoundFile file;
+    if (!file.openFromMemory(&m_data[0], m_data.size()))
+    {
+        m_data.clear();
+        m_channelCount = 0;
+        m_sampleRate = 0;
+        m_duration = Time::Zero;
+        return false;
+    }
+
+    m_channelCount = file.getChannelCount();
+    m_sampleRate = file.getSampleRate();
+    m_duration = file.getDuration();
+
+    return true;
+}
+
+} // namespace sf
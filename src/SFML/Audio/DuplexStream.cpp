@@ -0,0 +1,321 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/DuplexStream.hpp>
+#include <SFML/Audio/SoundRecorder.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Recorder forwarding the captured samples to a duplex stream
+///
+////////////////////////////////////////////////////////////
+class DuplexRecorder : public SoundRecorder
+{
+public:
+
+    DuplexRecorder(DuplexStream& stream, Time interval) :
+    m_stream   (stream),
+    m_capturing(false)
+    {
+        // Process the captured samples at the frame rate
+        setProcessingInterval(interval);
+    }
+
+    ~DuplexRecorder()
+    {
+        stop();
+    }
+
+    bool isCapturing() const
+    {
+        return m_capturing;
+    }
+
+protected:
+
+    virtual bool onStart()
+    {
+        m_capturing = true;
+        return true;
+    }
+
+    virtual bool onProcessSamples(const Int16* samples, std::size_t sampleCount)
+    {
+        m_stream.capture(samples, sampleCount);
+        return true;
+    }
+
+    virtual void onStop()
+    {
+        m_capturing = false;
+    }
+
+private:
+
+    DuplexStream& m_stream;    ///< Stream receiving the captured samples
+    bool          m_capturing; ///< Is the capture running?
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+DuplexStream::DuplexStream(unsigned int sampleRate, Time frameDuration) :
+m_frameSize     (std::max(static_cast<std::size_t>(frameDuration.asMicroseconds() * sampleRate / 1000000), static_cast<std::size_t>(1))),
+m_recorder      (NULL),
+m_captured      (),
+m_pending       (),
+m_captureTime   (0),
+m_jitterBuffer  (),
+m_playbackTime  (0),
+m_buffering     (true),
+m_jitterDelay   (milliseconds(40)),
+m_lateFrameCount(0),
+m_samples       ()
+{
+    // Play frames as they come: each buffer of the stream holds a single frame
+    initialize(1, sampleRate);
+    setBufferDuration(frameDuration);
+    setBufferCount(3);
+
+    m_recorder = new priv::DuplexRecorder(*this, frameDuration);
+}
+
+
+////////////////////////////////////////////////////////////
+DuplexStream::~DuplexStream()
+{
+    // Stop both sides before destroying the buffers
+    delete m_recorder;
+    stop();
+}
+
+
+////////////////////////////////////////////////////////////
+bool DuplexStream::startCapture()
+{
+    if (m_recorder->isCapturing())
+        stopCapture();
+
+    {
+        Lock lock(m_captureMutex);
+
+        m_captured.clear();
+        m_pending.clear();
+        m_captureTime = 0;
+    }
+
+    return m_recorder->start(getSampleRate());
+}
+
+
+////////////////////////////////////////////////////////////
+void DuplexStream::stopCapture()
+{
+    m_recorder->stop();
+}
+
+
+////////////////////////////////////////////////////////////
+bool DuplexStream::setCaptureDevice(const std::string& name)
+{
+    return m_recorder->setDevice(name);
+}
+
+
+////////////////////////////////////////////////////////////
+bool DuplexStream::popCapturedFrame(Frame& frame)
+{
+    Lock lock(m_captureMutex);
+
+    if (m_captured.empty())
+        return false;
+
+    frame.timestamp = m_captured.front().timestamp;
+    frame.samples.swap(m_captured.front().samples);
+    m_captured.pop_front();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void DuplexStream::pushFrame(const Frame& frame)
+{
+    if (frame.samples.empty())
+        return;
+
+    Lock lock(m_playbackMutex);
+
+    // Discard the frames whose playback time has passed
+    if (!m_buffering && (frame.timestamp + frame.samples.size() <= m_playbackTime))
+    {
+        m_lateFrameCount++;
+        return;
+    }
+
+    m_jitterBuffer[frame.timestamp] = frame.samples;
+}
+
+
+////////////////////////////////////////////////////////////
+void DuplexStream::setJitterDelay(Time delay)
+{
+    Lock lock(m_playbackMutex);
+
+    m_jitterDelay = delay;
+}
+
+
+////////////////////////////////////////////////////////////
+Time DuplexStream::getJitterDelay() const
+{
+    Lock lock(m_playbackMutex);
+
+    return m_jitterDelay;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 DuplexStream::getLateFrameCount() const
+{
+    Lock lock(m_playbackMutex);
+
+    return m_lateFrameCount;
+}
+
+
+////////////////////////////////////////////////////////////
+bool DuplexStream::onGetData(SoundStream::Chunk& data)
+{
+    Lock lock(m_playbackMutex);
+
+    // Play silence unless received audio covers the frame
+    m_samples.assign(m_frameSize, 0);
+    data.samples     = &m_samples[0];
+    data.sampleCount = m_samples.size();
+
+    if (m_jitterBuffer.empty())
+    {
+        // Underrun: wait for the jitter buffer to fill again before resuming
+        m_buffering = true;
+        return true;
+    }
+
+    Uint64 delay = static_cast<Uint64>(m_jitterDelay.asMicroseconds()) * getSampleRate() / 1000000;
+    Uint64 first = m_jitterBuffer.begin()->first;
+    Uint64 last = m_jitterBuffer.rbegin()->first + m_jitterBuffer.rbegin()->second.size();
+
+    if (m_buffering)
+    {
+        // Start when enough audio has been received to absorb the jitter
+        if (last - first < delay)
+            return true;
+
+        m_buffering = false;
+        m_playbackTime = first;
+    }
+    else if (last > m_playbackTime + delay * 2)
+    {
+        // Too much audio is waiting (burst or clock drift): skip forward to keep the latency bounded
+        m_playbackTime = last - delay;
+    }
+
+    // Copy the parts of the received frames that overlap the samples to play
+    Uint64 end = m_playbackTime + m_frameSize;
+    std::map<Uint64, std::vector<Int16> >::iterator it = m_jitterBuffer.begin();
+    while ((it != m_jitterBuffer.end()) && (it->first < end))
+    {
+        Uint64 frameBegin = it->first;
+        Uint64 frameEnd = frameBegin + it->second.size();
+
+        if (frameEnd > m_playbackTime)
+        {
+            Uint64 copyBegin = std::max(frameBegin, m_playbackTime);
+            Uint64 copyEnd = std::min(frameEnd, end);
+            std::copy(it->second.begin() + static_cast<std::size_t>(copyBegin - frameBegin),
+                      it->second.begin() + static_cast<std::size_t>(copyEnd - frameBegin),
+                      m_samples.begin() + static_cast<std::size_t>(copyBegin - m_playbackTime));
+        }
+
+        // Remove the frames that have been entirely played
+        if (frameEnd <= end)
+            m_jitterBuffer.erase(it++);
+        else
+            ++it;
+    }
+
+    m_playbackTime = end;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void DuplexStream::onSeek(Time)
+{
+    Lock lock(m_playbackMutex);
+
+    m_jitterBuffer.clear();
+    m_buffering = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void DuplexStream::capture(const Int16* samples, std::size_t sampleCount)
+{
+    Lock lock(m_captureMutex);
+
+    m_pending.insert(m_pending.end(), samples, samples + sampleCount);
+
+    // Cut as many frames as possible
+    std::size_t offset = 0;
+    while (m_pending.size() - offset >= m_frameSize)
+    {
+        Frame frame;
+        frame.timestamp = m_captureTime;
+        frame.samples.assign(m_pending.begin() + offset, m_pending.begin() + offset + m_frameSize);
+        m_captured.push_back(frame);
+
+        m_captureTime += m_frameSize;
+        offset += m_frameSize;
+    }
+    m_pending.erase(m_pending.begin(), m_pending.begin() + offset);
+
+    // Drop the frames that nobody retrieved for a second
+    std::size_t maxFrameCount = std::max(getSampleRate() / m_frameSize, static_cast<std::size_t>(1));
+    while (m_captured.size() > maxFrameCount)
+        m_captured.pop_front();
+}
+
+} // namespace sf
@@ -28,10 +28,45 @@
 #include <SFML/Audio/InputSoundFile.hpp>
 #include <SFML/Audio/SoundFileReader.hpp>
 #include <SFML/Audio/SoundFileFactory.hpp>
+#include <SFML/Audio/Resampler.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/FileInputStream.hpp>
 #include <SFML/System/MemoryInputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+
+namespace
+{
+    // Seek index files start with this signature and a version number
+    const char indexSignature[4] = {'S', 'F', 'S', 'I'};
+    const sf::Uint32 indexVersion = 1;
+
+    // Number of frames read from the file at once when converting the sample rate
+    const std::size_t resampleFrameCount = 1024;
+
+    void encode(std::ostream& stream, sf::Uint64 value)
+    {
+        char bytes[8];
+        for (int i = 0; i < 8; ++i)
+            bytes[i] = static_cast<char>((value >> (i * 8)) & 0xFF);
+        stream.write(bytes, sizeof(bytes));
+    }
+
+    bool decode(std::istream& stream, sf::Uint64& value)
+    {
+        unsigned char bytes[8];
+        if (!stream.read(reinterpret_cast<char*>(bytes), sizeof(bytes)))
+            return false;
+
+        value = 0;
+        for (int i = 0; i < 8; ++i)
+            value |= static_cast<sf::Uint64>(bytes[i]) << (i * 8);
+        return true;
+    }
+}
 
 
 namespace sf
@@ -43,7 +78,11 @@ m_stream      (NULL),
 m_streamOwned (false),
 m_sampleCount (0),
 m_channelCount(0),
-m_sampleRate  (0)
+m_sampleRate  (0),
+m_resampler   (NULL),
+m_outputRate  (0),
+m_buffer      (),
+m_converted   ()
 {
 }
 
@@ -62,14 +101,6 @@ bool InputSoundFile::openFromFile(const std::string& filename)
     // If the file is already open, first close it
     close();
 
-    // Find a suitable reader for the file type
-    m_reader = SoundFileFactory::createReaderFromFilename(filename);
-    if (!m_reader)
-    {
-        err() << "Failed to open sound file \"" << filename << "\" (format not supported)" << std::endl;
-        return false;
-    }
-
     // Wrap the file into a stream
     FileInputStream* file = new FileInputStream;
     m_stream = file;
@@ -77,6 +108,24 @@ bool InputSoundFile::openFromFile(const std::string& filename)
 
     // Open it
     if (!file->open(filename))
+    {
+        err() << "Failed to open sound file \"" << filename << "\" (cannot open file)" << std::endl;
+        close();
+        return false;
+    }
+
+    // Find a suitable reader for the file type, probing the stream that
+    // was just opened instead of opening the file a second time
+    m_reader = SoundFileFactory::createReaderFromStream(*file);
+    if (!m_reader)
+    {
+        err() << "Failed to open sound file \"" << filename << "\" (format not supported)" << std::endl;
+        close();
+        return false;
+    }
+
+    // Rewind the stream before passing it to the reader
+    if (file->seek(0) != 0)
     {
         close();
         return false;
@@ -183,7 +232,12 @@ bool InputSoundFile::openFromStream(InputStream& stream)
 ////////////////////////////////////////////////////////////
 Uint64 InputSoundFile::getSampleCount() const
 {
-    return m_sampleCount;
+    if (!m_resampler)
+        return m_sampleCount;
+
+    // Every input position produces the output frames that fall before the next one
+    Uint64 frameCount = m_sampleCount / m_channelCount;
+    return (frameCount * m_outputRate + m_sampleRate - 1) / m_sampleRate * m_channelCount;
 }
 
 
@@ -197,39 +251,184 @@ unsigned int InputSoundFile::getChannelCount() const
 ////////////////////////////////////////////////////////////
 unsigned int InputSoundFile::getSampleRate() const
 {
-    return m_sampleRate;
+    return m_resampler ? m_outputRate : m_sampleRate;
+}
+
+
+////////////////////////////////////////////////////////////
+void InputSoundFile::setOutputSampleRate(unsigned int sampleRate)
+{
+    delete m_resampler;
+    m_resampler = NULL;
+    m_outputRate = 0;
+
+    if (m_reader && m_channelCount && sampleRate && (sampleRate != m_sampleRate))
+    {
+        m_resampler = new priv::Resampler;
+        m_resampler->setup(m_channelCount, m_sampleRate, sampleRate);
+        m_outputRate = sampleRate;
+    }
+
+    seek(static_cast<Uint64>(0));
 }
 
 
 ////////////////////////////////////////////////////////////
 Time InputSoundFile::getDuration() const
 {
-    return seconds(static_cast<float>(m_sampleCount) / m_channelCount / m_sampleRate);
+    return seconds(static_cast<float>(getSampleCount()) / m_channelCount / getSampleRate());
 }
 
 
 ////////////////////////////////////////////////////////////
 void InputSoundFile::seek(Uint64 sampleOffset)
 {
-    if (m_reader)
+    if (!m_reader)
+        return;
+
+    if (m_resampler)
+    {
+        // Find the input position of the output frame
+        Uint64 position = sampleOffset / m_channelCount * m_sampleRate;
+        Uint64 frame = position / m_outputRate;
+
+        // Start reading a bit before, so that the filter gets the preceding samples
+        Uint64 context = std::min<Uint64>(frame, m_resampler->getContextSize());
+        m_reader->seek((frame - context) * m_channelCount);
+        m_resampler->reset(static_cast<std::size_t>(context), position % m_outputRate);
+    }
+    else
+    {
         m_reader->seek(sampleOffset);
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 void InputSoundFile::seek(Time timeOffset)
 {
-    seek(static_cast<Uint64>(timeOffset.asSeconds() * m_sampleRate * m_channelCount));
+    seek(static_cast<Uint64>(timeOffset.asSeconds() * getSampleRate() * m_channelCount));
 }
 
 
 ////////////////////////////////////////////////////////////
 Uint64 InputSoundFile::read(Int16* samples, Uint64 maxCount)
 {
-    if (m_reader && samples && maxCount)
+    if (!m_reader || !samples || !maxCount)
+        return 0;
+
+    if (!m_resampler)
         return m_reader->read(samples, maxCount);
-    else
+
+    // Convert the samples as floats, then back to 16 bits
+    m_converted.resize(static_cast<std::size_t>(maxCount));
+    Uint64 count = readResampled(&m_converted[0], maxCount);
+    for (Uint64 i = 0; i < count; ++i)
+    {
+        float sample = m_converted[static_cast<std::size_t>(i)] * 32767.f;
+        samples[i] = static_cast<Int16>(std::max(-32768.f, std::min(sample, 32767.f)));
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 InputSoundFile::read(float* samples, Uint64 maxCount)
+{
+    if (!m_reader || !samples || !maxCount)
         return 0;
+
+    if (!m_resampler)
+        return m_reader->read(samples, maxCount);
+
+    return readResampled(samples, maxCount);
+}
+
+
+////////////////////////////////////////////////////////////
+bool InputSoundFile::saveSeekIndex(const std::string& filename) const
+{
+    std::vector<Uint64> index;
+    if (!m_reader || !m_reader->getSeekIndex(index))
+    {
+        err() << "Failed to save seek index \"" << filename << "\" (format doesn't support seek indices)" << std::endl;
+        return false;
+    }
+
+    std::ofstream file(filename.c_str(), std::ios::binary);
+    if (!file)
+    {
+        err() << "Failed to save seek index \"" << filename << "\" (cannot open file)" << std::endl;
+        return false;
+    }
+
+    // Write the header, with the sample count to identify the sound file
+    file.write(indexSignature, sizeof(indexSignature));
+    encode(file, indexVersion);
+    encode(file, m_sampleCount);
+    encode(file, index.size());
+
+    // Write the content of the index
+    for (std::size_t i = 0; i < index.size(); ++i)
+        encode(file, index[i]);
+
+    return file.good();
+}
+
+
+////////////////////////////////////////////////////////////
+bool InputSoundFile::loadSeekIndex(const std::string& filename)
+{
+    if (!m_reader)
+        return false;
+
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    if (!file)
+    {
+        err() << "Failed to load seek index \"" << filename << "\" (cannot open file)" << std::endl;
+        return false;
+    }
+
+    // Check the header
+    char signature[sizeof(indexSignature)];
+    Uint64 version = 0;
+    Uint64 sampleCount = 0;
+    Uint64 count = 0;
+    if (!file.read(signature, sizeof(signature)) || !std::equal(signature, signature + sizeof(signature), indexSignature) ||
+        !decode(file, version) || (version != indexVersion) ||
+        !decode(file, sampleCount) || !decode(file, count))
+    {
+        err() << "Failed to load seek index \"" << filename << "\" (invalid header)" << std::endl;
+        return false;
+    }
+
+    if (sampleCount != m_sampleCount)
+    {
+        err() << "Failed to load seek index \"" << filename << "\" (it doesn't belong to this sound file)" << std::endl;
+        return false;
+    }
+
+    // Read the content of the index
+    std::vector<Uint64> index;
+    for (Uint64 i = 0; i < count; ++i)
+    {
+        Uint64 value;
+        if (!decode(file, value))
+        {
+            err() << "Failed to load seek index \"" << filename << "\" (unexpected end of file)" << std::endl;
+            return false;
+        }
+        index.push_back(value);
+    }
+
+    if (!m_reader->setSeekIndex(index))
+    {
+        err() << "Failed to load seek index \"" << filename << "\" (index rejected by the reader)" << std::endl;
+        return false;
+    }
+
+    return true;
 }
 
 
@@ -248,10 +447,40 @@ void InputSoundFile::close()
     }
     m_stream = NULL;
 
+    // Destroy the sample rate converter
+    delete m_resampler;
+    m_resampler = NULL;
+    m_outputRate = 0;
+
     // Reset the sound file attributes
     m_sampleCount = 0;
     m_channelCount = 0;
     m_sampleRate = 0;
 }
 
+
+////////////////////////////////////////////////////////////
+Uint64 InputSoundFile::readResampled(float* samples, Uint64 maxCount)
+{
+    std::size_t frameCount = static_cast<std::size_t>(maxCount / m_channelCount);
+    std::size_t produced = 0;
+    for (;;)
+    {
+        // Convert the input that is already available
+        produced += m_resampler->pull(samples + produced * m_channelCount, frameCount - produced);
+        if ((produced == frameCount) || m_resampler->isFinished())
+            break;
+
+        // Feed the converter with more samples from the file
+        m_buffer.resize(resampleFrameCount * m_channelCount);
+        std::size_t count = static_cast<std::size_t>(m_reader->read(&m_buffer[0], m_buffer.size()));
+        if (count > 0)
+            m_resampler->push(&m_buffer[0], count / m_channelCount);
+        else
+            m_resampler->finish();
+    }
+
+    return static_cast<Uint64>(produced) * m_channelCount;
+}
+
 } // namespace sf
@@ -107,4 +107,18 @@ Vector3f Listener::getUpVector()
     return priv::AudioDevice::getUpVector();
 }
 
+
+////////////////////////////////////////////////////////////
+void Listener::deferUpdates()
+{
+    priv::AudioDevice::deferUpdates();
+}
+
+
+////////////////////////////////////////////////////////////
+void Listener::processUpdates()
+{
+    priv::AudioDevice::processUpdates();
+}
+
 } // namespace sf
@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/MixKernels.hpp>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1))
+    #define SFML_MIX_SSE
+    #include <xmmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    #define SFML_MIX_NEON
+    #include <arm_neon.h>
+#endif
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void mixSamples(float* output, const float* input, std::size_t count, float gain)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_MIX_SSE)
+
+    // Process 4 samples at once, the blocks are not necessarily aligned
+    __m128 factor = _mm_set1_ps(gain);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 mixed = _mm_add_ps(_mm_loadu_ps(output + i), _mm_mul_ps(_mm_loadu_ps(input + i), factor));
+        _mm_storeu_ps(output + i, mixed);
+    }
+
+#elif defined(SFML_MIX_NEON)
+
+    // Process 4 samples at once
+    for (; i + 4 <= count; i += 4)
+        vst1q_f32(output + i, vmlaq_n_f32(vld1q_f32(output + i), vld1q_f32(input + i), gain));
+
+#endif
+
+    // Process the remaining samples (or all of them without SIMD support)
+    for (; i < count; ++i)
+        output[i] += input[i] * gain;
+}
+
+
+////////////////////////////////////////////////////////////
+void scaleSamples(float* samples, std::size_t count, float gain)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_MIX_SSE)
+
+    __m128 factor = _mm_set1_ps(gain);
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(samples + i, _mm_mul_ps(_mm_loadu_ps(samples + i), factor));
+
+#elif defined(SFML_MIX_NEON)
+
+    for (; i + 4 <= count; i += 4)
+        vst1q_f32(samples + i, vmulq_n_f32(vld1q_f32(samples + i), gain));
+
+#endif
+
+    for (; i < count; ++i)
+        samples[i] *= gain;
+}
+
+
+////////////////////////////////////////////////////////////
+float dotProduct(const float* left, const float* right, std::size_t count)
+{
+    std::size_t i = 0;
+    float result = 0.f;
+
+#if defined(SFML_MIX_SSE)
+
+    // Accumulate 4 partial sums, then add them together
+    __m128 sums = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4)
+        sums = _mm_add_ps(sums, _mm_mul_ps(_mm_loadu_ps(left + i), _mm_loadu_ps(right + i)));
+
+    float partial[4];
+    _mm_storeu_ps(partial, sums);
+    result = (partial[0] + partial[1]) + (partial[2] + partial[3]);
+
+#elif defined(SFML_MIX_NEON)
+
+    float32x4_t sums = vdupq_n_f32(0.f);
+    for (; i + 4 <= count; i += 4)
+        sums = vmlaq_f32(sums, vld1q_f32(left + i), vld1q_f32(right + i));
+
+    float partial[4];
+    vst1q_f32(partial, sums);
+    result = (partial[0] + partial[1]) + (partial[2] + partial[3]);
+
+#endif
+
+    for (; i < count; ++i)
+        result += left[i] * right[i];
+
+    return result;
+}
+
+} // namespace priv
+
+} // namespace sf
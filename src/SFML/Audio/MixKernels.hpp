@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_MIXKERNELS_HPP
+#define SFML_MIXKERNELS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Add a block of samples, scaled by a gain, to another one
+///
+/// This is the inner loop of the software mixer: it is
+/// vectorized with SSE or NEON when they are available.
+///
+/// \param output Samples to mix into
+/// \param input  Samples to add
+/// \param count  Number of samples
+/// \param gain   Gain applied to the input samples
+///
+////////////////////////////////////////////////////////////
+void mixSamples(float* output, const float* input, std::size_t count, float gain);
+
+////////////////////////////////////////////////////////////
+/// \brief Multiply a block of samples by a gain
+///
+/// \param samples Samples to scale
+/// \param count   Number of samples
+/// \param gain    Gain to apply
+///
+////////////////////////////////////////////////////////////
+void scaleSamples(float* samples, std::size_t count, float gain);
+
+////////////////////////////////////////////////////////////
+/// \brief Compute the dot product of two blocks of samples
+///
+/// This is the inner loop of the resampling filter.
+///
+/// \param left  First block of samples
+/// \param right Second block of samples
+/// \param count Number of samples in each block
+///
+/// \return Sum of the products of the samples
+///
+////////////////////////////////////////////////////////////
+float dotProduct(const float* left, const float* right, std::size_t count);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_MIXKERNELS_HPP
@@ -29,15 +29,35 @@
 #include <SFML/Audio/ALCheck.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <algorithm>
 #include <fstream>
 
+#ifdef _MSC_VER
+    #pragma warning(disable: 4355) // 'this' used in base member initializer list
+#endif
+
+
+namespace
+{
+    // Maximum number of frames decoded at once, so that seeking doesn't wait for too long
+    const std::size_t decodeFrameCount = 4096;
+}
+
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Music::Music() :
-m_file    (),
-m_duration()
+m_file      (),
+m_duration  (),
+m_decoder   (&Music::decode, this),
+m_ringRead  (0),
+m_ringSize  (0),
+m_endOfFile (false),
+m_decoding  (false),
+m_lookAhead (seconds(2)),
+m_outputRate(0)
 {
 
 }
@@ -48,6 +68,7 @@ Music::~Music()
 {
     // We must stop before destroying the file
     stop();
+    stopDecoding();
 }
 
 
@@ -56,6 +77,7 @@ bool Music::openFromFile(const std::string& filename)
 {
     // First stop the music if it was already running
     stop();
+    stopDecoding();
 
     // Open the underlying sound file
     if (!m_file.openFromFile(filename))
@@ -73,6 +95,7 @@ bool Music::openFromMemory(const void* data, std::size_t sizeInBytes)
 {
     // First stop the music if it was already running
     stop();
+    stopDecoding();
 
     // Open the underlying sound file
     if (!m_file.openFromMemory(data, sizeInBytes))
@@ -90,6 +113,7 @@ bool Music::openFromStream(InputStream& stream)
 {
     // First stop the music if it was already running
     stop();
+    stopDecoding();
 
     // Open the underlying sound file
     if (!m_file.openFromStream(stream))
@@ -110,13 +134,92 @@ Time Music::getDuration() const
 
 
 ////////////////////////////////////////////////////////////
-bool Music::onGetData(SoundStream::Chunk& data)
+void Music::setLookAhead(Time duration)
+{
+    m_lookAhead = duration;
+}
+
+
+////////////////////////////////////////////////////////////
+Time Music::getLookAhead() const
+{
+    return m_lookAhead;
+}
+
+
+////////////////////////////////////////////////////////////
+void Music::setOutputSampleRate(unsigned int sampleRate)
+{
+    m_outputRate = sampleRate;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Music::getOutputSampleRate() const
+{
+    return m_outputRate;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Music::saveSeekIndex(const std::string& filename) const
 {
     Lock lock(m_mutex);
 
+    return m_file.saveSeekIndex(filename);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Music::loadSeekIndex(const std::string& filename)
+{
+    Lock lock(m_mutex);
+
+    return m_file.loadSeekIndex(filename);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Music::onGetData(SoundStream::Chunk& data)
+{
+    // Copy as many samples as requested for a buffer
+    std::size_t frameCount = static_cast<std::size_t>(getBufferDuration().asMicroseconds() * m_file.getSampleRate() / 1000000);
+    m_samples.resize(std::max(frameCount, static_cast<std::size_t>(1)) * m_file.getChannelCount());
+
+    std::size_t count = 0;
+    for (;;)
+    {
+        bool endOfFile = false;
+
+        {
+            Lock lock(m_ringMutex);
+
+            // Copy the decoded samples, in two parts if they wrap around the end of the buffer
+            std::size_t available = std::min(m_ringSize, m_samples.size() - count);
+            while (available > 0)
+            {
+                std::size_t part = std::min(available, m_ring.size() - m_ringRead);
+                std::copy(m_ring.begin() + m_ringRead, m_ring.begin() + m_ringRead + part, m_samples.begin() + count);
+
+                m_ringRead = (m_ringRead + part) % m_ring.size();
+                m_ringSize -= part;
+                count += part;
+                available -= part;
+            }
+
+            endOfFile = m_endOfFile && (m_ringSize == 0);
+        }
+
+        if ((count == m_samples.size()) || endOfFile)
+            break;
+
+        // The decoder is late: wait for it
+        sleep(milliseconds(1));
+    }
+
     // Fill the chunk parameters
     data.samples     = &m_samples[0];
-    data.sampleCount = static_cast<std::size_t>(m_file.read(&m_samples[0], m_samples.size()));
+    data.sampleCount = count;
 
     // Check if we have reached the end of the audio file
     return data.sampleCount == m_samples.size();
@@ -126,23 +229,101 @@ bool Music::onGetData(SoundStream::Chunk& data)
 ////////////////////////////////////////////////////////////
 void Music::onSeek(Time timeOffset)
 {
+    // Wait for the decoder to finish its current read
     Lock lock(m_mutex);
 
     m_file.seek(timeOffset);
+
+    // Drop the samples decoded from the previous position
+    Lock ringLock(m_ringMutex);
+    m_ringRead  = 0;
+    m_ringSize  = 0;
+    m_endOfFile = false;
 }
 
 
 ////////////////////////////////////////////////////////////
 void Music::initialize()
 {
+    // Convert the samples to the requested sample rate, if any
+    m_file.setOutputSampleRate(m_outputRate);
+
     // Compute the music duration
     m_duration = m_file.getDuration();
 
-    // Resize the internal buffer so that it can contain 1 second of audio samples
-    m_samples.resize(m_file.getSampleRate() * m_file.getChannelCount());
+    // Allocate the look-ahead buffer, with room for at least one frame
+    std::size_t frameCount = static_cast<std::size_t>(m_lookAhead.asMicroseconds() * m_file.getSampleRate() / 1000000);
+    m_ring.resize(std::max(frameCount, static_cast<std::size_t>(1)) * m_file.getChannelCount());
+    m_ringRead  = 0;
+    m_ringSize  = 0;
+    m_endOfFile = false;
 
     // Initialize the stream
     SoundStream::initialize(m_file.getChannelCount(), m_file.getSampleRate());
+
+    // Start decoding ahead of the playback
+    m_decoding = true;
+    m_decoder.launch();
+}
+
+
+////////////////////////////////////////////////////////////
+void Music::decode()
+{
+    std::size_t channelCount = m_file.getChannelCount();
+
+    for (;;)
+    {
+        {
+            Lock lock(m_mutex);
+
+            // Find the free space after the decoded samples
+            std::size_t position = 0;
+            std::size_t count = 0;
+            {
+                Lock ringLock(m_ringMutex);
+
+                if (!m_decoding)
+                    return;
+
+                if (!m_endOfFile)
+                {
+                    position = (m_ringRead + m_ringSize) % m_ring.size();
+                    count = std::min(m_ring.size() - m_ringSize, m_ring.size() - position);
+                    count = std::min(count, decodeFrameCount * channelCount);
+                    count -= count % channelCount;
+                }
+            }
+
+            if (count > 0)
+            {
+                // The reader never touches the free space, so the file can be decoded into it without locking
+                std::size_t read = static_cast<std::size_t>(m_file.read(&m_ring[position], count));
+
+                Lock ringLock(m_ringMutex);
+                m_ringSize += read;
+                if (read < count)
+                    m_endOfFile = true;
+
+                continue;
+            }
+        }
+
+        // The buffer is full, or the whole file is decoded: wait for the reader
+        sleep(milliseconds(10));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Music::stopDecoding()
+{
+    {
+        Lock lock(m_ringMutex);
+        m_decoding = false;
+    }
+
+    m_decoder.wait();
 }
 
 } // namespace sf
@@ -29,13 +29,30 @@
 #include <SFML/Audio/SoundFileWriter.hpp>
 #include <SFML/Audio/SoundFileFactory.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Sleep.hpp>
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    #pragma warning(disable: 4355) // 'this' used in base member initializer list
+#endif
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 OutputSoundFile::OutputSoundFile() :
-m_writer(NULL)
+m_writer          (NULL),
+m_quality         (0.4f),
+m_compressionLevel(5),
+m_asynchronous    (false),
+m_queueDuration   (seconds(1)),
+m_encoder         (&OutputSoundFile::encode, this),
+m_mutex           (),
+m_blocks          (),
+m_freeBlocks      (),
+m_queuedSamples   (0),
+m_queueCapacity   (0),
+m_encoding        (false)
 {
 }
 
@@ -63,12 +80,22 @@ bool OutputSoundFile::openFromFile(const std::string& filename, unsigned int sam
     }
 
     // Pass the stream to the reader
+    m_writer->setEncodingOptions(m_quality, m_compressionLevel);
     if (!m_writer->open(filename, sampleRate, channelCount))
     {
         close();
         return false;
     }
 
+    // Start the encoding thread
+    if (m_asynchronous)
+    {
+        m_queuedSamples = 0;
+        m_queueCapacity = static_cast<Uint64>(m_queueDuration.asSeconds() * sampleRate * channelCount);
+        m_encoding = true;
+        m_encoder.launch();
+    }
+
     return true;
 }
 
@@ -76,17 +103,151 @@ bool OutputSoundFile::openFromFile(const std::string& filename, unsigned int sam
 ////////////////////////////////////////////////////////////
 void OutputSoundFile::write(const Int16* samples, Uint64 count)
 {
-    if (m_writer && samples && count)
+    if (!m_writer || !samples || !count)
+        return;
+
+    if (!m_encoding)
+    {
         m_writer->write(samples, count);
+        return;
+    }
+
+    // Wait until there is room in the queue (a block bigger than the queue is accepted when it is empty)
+    std::vector<Int16> block;
+    for (;;)
+    {
+        {
+            Lock lock(m_mutex);
+
+            if ((m_queuedSamples == 0) || (m_queuedSamples + count <= m_queueCapacity))
+            {
+                // Reuse the memory of an encoded block
+                if (!m_freeBlocks.empty())
+                {
+                    block.swap(m_freeBlocks.back());
+                    m_freeBlocks.pop_back();
+                }
+                m_queuedSamples += count;
+                break;
+            }
+        }
+
+        sleep(milliseconds(1));
+    }
+
+    // Copy the samples outside the lock, the encoding thread doesn't wait for them
+    block.assign(samples, samples + count);
+
+    Lock lock(m_mutex);
+    m_blocks.push_back(std::vector<Int16>());
+    m_blocks.back().swap(block);
+}
+
+
+////////////////////////////////////////////////////////////
+void OutputSoundFile::setAsynchronous(bool asynchronous, Time queueDuration)
+{
+    m_asynchronous = asynchronous;
+    m_queueDuration = queueDuration;
+}
+
+
+////////////////////////////////////////////////////////////
+bool OutputSoundFile::isAsynchronous() const
+{
+    return m_asynchronous;
+}
+
+
+////////////////////////////////////////////////////////////
+void OutputSoundFile::setQuality(float quality)
+{
+    m_quality = quality;
+}
+
+
+////////////////////////////////////////////////////////////
+float OutputSoundFile::getQuality() const
+{
+    return m_quality;
+}
+
+
+////////////////////////////////////////////////////////////
+void OutputSoundFile::setCompressionLevel(unsigned int level)
+{
+    m_compressionLevel = level;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int OutputSoundFile::getCompressionLevel() const
+{
+    return m_compressionLevel;
 }
 
 
 ////////////////////////////////////////////////////////////
 void OutputSoundFile::close()
 {
+    // Let the encoding thread write the remaining samples, and stop it
+    if (m_encoding)
+    {
+        {
+            Lock lock(m_mutex);
+            m_encoding = false;
+        }
+        m_encoder.wait();
+
+        m_freeBlocks.clear();
+    }
+
     // Destroy the reader
     delete m_writer;
     m_writer = NULL;
 }
 
+
+////////////////////////////////////////////////////////////
+void OutputSoundFile::encode()
+{
+    std::vector<Int16> block;
+    for (;;)
+    {
+        // Take the next block
+        bool found = false;
+        {
+            Lock lock(m_mutex);
+
+            if (!m_blocks.empty())
+            {
+                block.swap(m_blocks.front());
+                m_blocks.pop_front();
+                found = true;
+            }
+            else if (!m_encoding)
+            {
+                // Everything was written and the file is being closed
+                return;
+            }
+        }
+
+        // Nothing to do: wait a bit for new samples
+        if (!found)
+        {
+            sleep(milliseconds(1));
+            continue;
+        }
+
+        // Encode the samples outside the lock, so that write doesn't wait
+        m_writer->write(&block[0], block.size());
+
+        // Give the block back to be reused
+        Lock lock(m_mutex);
+        m_queuedSamples -= block.size();
+        m_freeBlocks.push_back(std::vector<Int16>());
+        m_freeBlocks.back().swap(block);
+    }
+}
+
 } // namespace sf
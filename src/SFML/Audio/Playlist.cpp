@@ -0,0 +1,461 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Playlist.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+#ifdef _MSC_VER
+    #pragma warning(disable: 4355) // 'this' used in base member initializer list
+#endif
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Playlist::Playlist() :
+m_tracks      (),
+m_current     (NULL),
+m_currentTrack(0),
+m_position    (0),
+m_end         (0),
+m_leaving     (false),
+m_restart     (false),
+m_loader      (&Playlist::load, this),
+m_nextFilename(),
+m_nextTrack   (0),
+m_loading     (false),
+m_nextReady   (false),
+m_next        (NULL),
+m_nextPosition(0),
+m_crossfade   (Time::Zero)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+Playlist::~Playlist()
+{
+    // We must stop before destroying the files
+    stop();
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Playlist::add(const std::string& filename)
+{
+    Lock lock(m_mutex);
+
+    Track track = {filename, 0, 0};
+    m_tracks.push_back(track);
+    std::size_t index = m_tracks.size() - 1;
+
+    if (getChannelCount() == 0)
+    {
+        // No track could be opened yet: this one defines the format of the playlist
+        m_current = open(filename);
+        if (m_current)
+        {
+            initialize(m_current->getChannelCount(), m_current->getSampleRate());
+            m_currentTrack = index;
+            m_position = 0;
+            m_end = m_current->getSampleCount();
+            m_leaving = false;
+            prepareNext();
+        }
+    }
+    else if (m_current)
+    {
+        // The current track may have been the last one, start loading the new one
+        prepareNext();
+    }
+
+    return index;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Playlist::getTrackCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_tracks.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Playlist::getCurrentTrack() const
+{
+    Lock lock(m_mutex);
+
+    return m_currentTrack;
+}
+
+
+////////////////////////////////////////////////////////////
+void Playlist::setLoopPoints(std::size_t track, Uint64 begin, Uint64 end)
+{
+    Lock lock(m_mutex);
+
+    if (track < m_tracks.size())
+    {
+        m_tracks[track].loopBegin = begin;
+        m_tracks[track].loopEnd = end;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Playlist::setCrossfade(Time duration)
+{
+    Lock lock(m_mutex);
+
+    m_crossfade = duration;
+}
+
+
+////////////////////////////////////////////////////////////
+Time Playlist::getCrossfade() const
+{
+    Lock lock(m_mutex);
+
+    return m_crossfade;
+}
+
+
+////////////////////////////////////////////////////////////
+void Playlist::next()
+{
+    Lock lock(m_mutex);
+
+    if (!m_current)
+        return;
+
+    // Stop looping, and end the track once the crossfade is over
+    m_leaving = true;
+    m_end = std::min(m_end, m_position + getCrossfadeSampleCount());
+}
+
+
+////////////////////////////////////////////////////////////
+bool Playlist::onGetData(SoundStream::Chunk& data)
+{
+    Lock lock(m_mutex);
+
+    // Open the first track if the playlist was over
+    if (m_restart)
+    {
+        Uint64 offset = m_position;
+        restart(0);
+        m_restart = false;
+
+        if (m_current)
+        {
+            m_current->seek(offset);
+            m_position = std::min(offset, m_end);
+        }
+    }
+
+    // Fill as many samples as requested for a buffer
+    std::size_t frameCount = static_cast<std::size_t>(getBufferDuration().asMicroseconds() * getSampleRate() / 1000000);
+    m_samples.resize(std::max(frameCount, static_cast<std::size_t>(1)) * getChannelCount());
+
+    std::size_t count = 0;
+    while ((count < m_samples.size()) && m_current)
+    {
+        const Track& track = m_tracks[m_currentTrack];
+
+        // Find where the next event of the track happens: the end of its loop, the start of the crossfade or its end
+        Uint64 end = m_end;
+        bool looping = false;
+        if (!m_leaving && (track.loopBegin < std::min(track.loopEnd, m_end)))
+        {
+            end = std::min(track.loopEnd, m_end);
+            looping = true;
+        }
+
+        Uint64 fadeLength = looping ? 0 : getCrossfadeSampleCount();
+        Uint64 fadeStart = (end > fadeLength) ? end - fadeLength : 0;
+        Uint64 limit = (m_position < fadeStart) ? fadeStart : end;
+
+        if (m_position < limit)
+        {
+            // Read the samples up to the event
+            std::size_t toRead = static_cast<std::size_t>(std::min<Uint64>(m_samples.size() - count, limit - m_position));
+            std::size_t read = static_cast<std::size_t>(m_current->read(&m_samples[count], toRead));
+
+            if (m_position >= fadeStart)
+                crossfade(&m_samples[count], read, fadeLength);
+
+            m_position += read;
+            count += read;
+
+            // The file may be shorter than announced
+            if (read < toRead)
+                m_end = m_position;
+        }
+        else if (looping)
+        {
+            // Jump back to the beginning of the loop
+            m_current->seek(track.loopBegin);
+            m_position = track.loopBegin;
+        }
+        else
+        {
+            // Continue with the next track, right after the current one in the same buffer
+            switchTrack();
+        }
+    }
+
+    // Fill the chunk parameters
+    data.samples     = &m_samples[0];
+    data.sampleCount = count;
+
+    // Check if we have reached the end of the playlist
+    return m_current != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void Playlist::onSeek(Time timeOffset)
+{
+    Lock lock(m_mutex);
+
+    Uint64 frame = static_cast<Uint64>(timeOffset.asMicroseconds()) * getSampleRate() / 1000000;
+    Uint64 offset = frame * getChannelCount();
+
+    if (!m_current)
+    {
+        // The playlist is over: restart it from the first track when the stream needs it,
+        // so that the file is not opened in the thread of the caller
+        close();
+        m_position = offset;
+        m_restart = !m_tracks.empty();
+        return;
+    }
+
+    // Cancel the transition to the next track
+    m_leaving = false;
+    m_end = m_current->getSampleCount();
+
+    m_current->seek(offset);
+    m_position = std::min(offset, m_end);
+
+    // A crossfade may have started reading the next track already
+    if (m_nextPosition > 0)
+    {
+        InputSoundFile* next = getNext(true);
+        if (next)
+            next->seek(static_cast<Uint64>(0));
+        m_nextPosition = 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Playlist::getCrossfadeSampleCount() const
+{
+    Uint64 frameCount = static_cast<Uint64>(m_crossfade.asMicroseconds()) * getSampleRate() / 1000000;
+    return frameCount * getChannelCount();
+}
+
+
+////////////////////////////////////////////////////////////
+void Playlist::restart(std::size_t track)
+{
+    close();
+
+    for (std::size_t i = track; (i < m_tracks.size()) && !m_current; ++i)
+    {
+        m_current = open(m_tracks[i].filename);
+        m_currentTrack = i;
+    }
+
+    if (m_current)
+    {
+        m_position = 0;
+        m_end = m_current->getSampleCount();
+        m_leaving = false;
+        prepareNext();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+InputSoundFile* Playlist::open(const std::string& filename)
+{
+    InputSoundFile* file = new InputSoundFile;
+    if (!file->openFromFile(filename))
+    {
+        delete file;
+        return NULL;
+    }
+
+    // All the tracks are queued in the same source, they must share its format
+    if ((getChannelCount() != 0) && ((file->getChannelCount() != getChannelCount()) || (file->getSampleRate() != getSampleRate())))
+    {
+        err() << "Failed to add \"" << filename << "\" to the playlist (its channel count and sample rate must match the first track)" << std::endl;
+        delete file;
+        return NULL;
+    }
+
+    return file;
+}
+
+
+////////////////////////////////////////////////////////////
+void Playlist::load()
+{
+    InputSoundFile* file = open(m_nextFilename);
+
+    Lock lock(m_loaderMutex);
+    m_next = file;
+    m_nextReady = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Playlist::prepareNext()
+{
+    if (m_loading || m_tracks.empty())
+        return;
+
+    // Find the track that follows the current one
+    std::size_t track = m_currentTrack + 1;
+    if (track >= m_tracks.size())
+    {
+        if (!getLoop())
+            return;
+
+        track = 0;
+    }
+
+    // Open it in the background
+    m_nextTrack = track;
+    m_nextFilename = m_tracks[track].filename;
+    m_nextReady = false;
+    m_next = NULL;
+    m_nextPosition = 0;
+    m_loading = true;
+    m_loader.launch();
+}
+
+
+////////////////////////////////////////////////////////////
+InputSoundFile* Playlist::getNext(bool wait)
+{
+    if (!m_loading)
+        return NULL;
+
+    if (wait)
+        m_loader.wait();
+
+    Lock lock(m_loaderMutex);
+    return m_nextReady ? m_next : NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void Playlist::switchTrack()
+{
+    delete m_current;
+    m_current = NULL;
+
+    // Skip the tracks that fail to open
+    for (std::size_t i = 0; i < m_tracks.size(); ++i)
+    {
+        // The loading thread may not have been launched if the playlist was over when it started
+        prepareNext();
+        if (!m_loading)
+            return;
+
+        // This only blocks if the loading thread is late
+        InputSoundFile* file = getNext(true);
+        m_loading = false;
+        m_next = NULL;
+        m_currentTrack = m_nextTrack;
+
+        if (file)
+        {
+            m_current = file;
+            m_position = m_nextPosition;
+            m_end = m_current->getSampleCount();
+            m_leaving = false;
+            prepareNext();
+            return;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Playlist::crossfade(Int16* samples, std::size_t count, Uint64 length)
+{
+    InputSoundFile* next = getNext(false);
+    if (!next || (length == 0))
+        return;
+
+    // Read the beginning of the next track
+    m_mixSamples.resize(count);
+    std::size_t read = static_cast<std::size_t>(next->read(&m_mixSamples[0], count));
+    m_nextPosition += read;
+
+    // Mix both tracks, the gain of each one depending on the distance to the end of the current one
+    unsigned int channelCount = getChannelCount();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Uint64 remaining = m_end - (m_position + i - i % channelCount);
+        float gain = std::min(static_cast<float>(remaining) / length, 1.f);
+
+        float sample = samples[i] * gain;
+        if (i < read)
+            sample += m_mixSamples[i] * (1.f - gain);
+
+        samples[i] = static_cast<Int16>(std::max(-32768.f, std::min(sample, 32767.f)));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Playlist::close()
+{
+    if (m_loading)
+    {
+        delete getNext(true);
+        m_loading = false;
+    }
+
+    delete m_current;
+    m_current = NULL;
+    m_next = NULL;
+    m_nextPosition = 0;
+}
+
+} // namespace sf
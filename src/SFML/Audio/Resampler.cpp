@@ -0,0 +1,243 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Resampler.hpp>
+#include <SFML/Audio/MixKernels.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Number of zero crossings of the sinc on each side of a position
+    const std::size_t zeroCrossings = 24;
+
+    // Bounds of the filter size and of the number of precomputed positions
+    const std::size_t maxHalfLength = 128;
+    const std::size_t maxPhaseCount = 512;
+
+    // Attenuation of the Kaiser window (about 90 dB)
+    const double kaiserBeta = 8.6;
+
+    // Number of consumed frames after which the history is trimmed
+    const std::size_t trimThreshold = 4096;
+
+    const double pi = 3.141592653589793;
+
+    // Modified Bessel function of the first kind, order 0
+    double bessel(double x)
+    {
+        double sum = 1.0;
+        double term = 1.0;
+        for (int k = 1; k < 32; ++k)
+        {
+            term *= (x / (2 * k)) * (x / (2 * k));
+            sum += term;
+        }
+        return sum;
+    }
+
+    sf::Uint64 gcd(sf::Uint64 a, sf::Uint64 b)
+    {
+        while (b)
+        {
+            sf::Uint64 r = a % b;
+            a = b;
+            b = r;
+        }
+        return a;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+Resampler::Resampler() :
+m_channelCount(0),
+m_inputRate   (1),
+m_outputRate  (1),
+m_phaseCount  (1),
+m_halfLength  (1),
+m_filter      (),
+m_history     (),
+m_position    (0),
+m_phase       (0),
+m_end         (0),
+m_finished    (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Resampler::setup(unsigned int channelCount, unsigned int inputRate, unsigned int outputRate)
+{
+    m_channelCount = channelCount;
+    m_inputRate = std::max(inputRate, 1u);
+    m_outputRate = std::max(outputRate, 1u);
+
+    // A simple ratio needs only a few positions, which then are exact
+    m_phaseCount = static_cast<std::size_t>(std::min<Uint64>(m_outputRate / gcd(m_inputRate, m_outputRate), maxPhaseCount));
+
+    // When downsampling, the cutoff frequency is lowered to avoid aliasing,
+    // and the filter is widened accordingly
+    double ratio = std::min(static_cast<double>(m_outputRate) / m_inputRate, 1.0);
+    m_halfLength = std::min(static_cast<std::size_t>(std::ceil(zeroCrossings / ratio)), maxHalfLength);
+    double cutoff = 0.45 * ratio;
+
+    // Compute the taps of a Kaiser-windowed sinc, for each position
+    std::size_t length = m_halfLength * 2;
+    m_filter.resize(m_phaseCount * length);
+    for (std::size_t phase = 0; phase < m_phaseCount; ++phase)
+    {
+        float* taps = &m_filter[phase * length];
+        double sum = 0;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            // Distance between the input frame and the output position
+            double t = static_cast<double>(i) - (m_halfLength - 1) - static_cast<double>(phase) / m_phaseCount;
+            double x = 2 * cutoff * t;
+            double sinc = (std::fabs(x) < 1e-9) ? 1.0 : std::sin(pi * x) / (pi * x);
+            double w = t / m_halfLength;
+            double window = (std::fabs(w) < 1.0) ? bessel(kaiserBeta * std::sqrt(1.0 - w * w)) / bessel(kaiserBeta) : 0.0;
+            taps[i] = static_cast<float>(sinc * window);
+            sum += taps[i];
+        }
+
+        // Normalize the gain of each position, so that they all pass DC unchanged
+        for (std::size_t i = 0; i < length; ++i)
+            taps[i] = static_cast<float>(taps[i] / sum);
+    }
+
+    m_history.resize(m_channelCount);
+    reset();
+}
+
+
+////////////////////////////////////////////////////////////
+void Resampler::reset(std::size_t context, Uint64 phase)
+{
+    // Missing context is replaced with silence
+    std::size_t silence = getContextSize() - std::min(context, getContextSize());
+    for (std::size_t c = 0; c < m_history.size(); ++c)
+        m_history[c].assign(silence, 0.f);
+
+    m_position = getContextSize();
+    m_phase = phase % m_outputRate;
+    m_end = 0;
+    m_finished = false;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Resampler::getContextSize() const
+{
+    return m_halfLength - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+void Resampler::push(const float* samples, std::size_t frameCount)
+{
+    // The history is stored per channel, so that the filter works on contiguous samples
+    for (std::size_t c = 0; c < m_history.size(); ++c)
+    {
+        std::vector<float>& history = m_history[c];
+        std::size_t size = history.size();
+        history.resize(size + frameCount);
+        for (std::size_t i = 0; i < frameCount; ++i)
+            history[size + i] = samples[i * m_channelCount + c];
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Resampler::finish()
+{
+    if (m_finished || m_history.empty())
+        return;
+
+    // Feed the last positions with silence
+    m_end = m_history[0].size();
+    for (std::size_t c = 0; c < m_history.size(); ++c)
+        m_history[c].resize(m_end + m_halfLength, 0.f);
+
+    m_finished = true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Resampler::pull(float* samples, std::size_t maxFrameCount)
+{
+    if (m_history.empty())
+        return 0;
+
+    std::size_t length = m_halfLength * 2;
+    std::size_t count = 0;
+    while (count < maxFrameCount)
+    {
+        // Check that all the input frames needed by the filter are available
+        if (m_finished ? (m_position >= m_end) : (m_position + m_halfLength >= m_history[0].size()))
+            break;
+
+        // Compute the output frame
+        const float* taps = &m_filter[static_cast<std::size_t>(m_phase * m_phaseCount / m_outputRate) * length];
+        for (std::size_t c = 0; c < m_channelCount; ++c)
+            samples[count * m_channelCount + c] = dotProduct(&m_history[c][m_position - getContextSize()], taps, length);
+
+        // Advance to the next position
+        m_phase += m_inputRate;
+        m_position += static_cast<std::size_t>(m_phase / m_outputRate);
+        m_phase %= m_outputRate;
+        ++count;
+    }
+
+    // Drop the input frames that are no longer needed
+    if (m_position > getContextSize() + trimThreshold)
+    {
+        std::size_t consumed = std::min(m_position - getContextSize(), m_history[0].size());
+        for (std::size_t c = 0; c < m_history.size(); ++c)
+            m_history[c].erase(m_history[c].begin(), m_history[c].begin() + consumed);
+        m_position -= consumed;
+        m_end -= std::min(m_end, consumed);
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Resampler::isFinished() const
+{
+    return m_finished && (m_position >= m_end);
+}
+
+} // namespace priv
+
+} // namespace sf
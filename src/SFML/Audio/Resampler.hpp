@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RESAMPLER_HPP
+#define SFML_RESAMPLER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Sample rate converter for interleaved float samples
+///
+/// This is a polyphase windowed-sinc filter: the filter is
+/// precomputed for a fixed set of fractional positions
+/// (exactly the ones needed when the ratio between the
+/// two rates is simple enough) so that each output sample
+/// is a single dot product, which is vectorized.
+///
+////////////////////////////////////////////////////////////
+class Resampler
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    Resampler();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the filter for the given conversion
+    ///
+    /// This also resets the converter to the beginning
+    /// of the input.
+    ///
+    /// \param channelCount Number of channels of the samples
+    /// \param inputRate    Sample rate of the input samples
+    /// \param outputRate   Sample rate of the output samples
+    ///
+    ////////////////////////////////////////////////////////////
+    void setup(unsigned int channelCount, unsigned int inputRate, unsigned int outputRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restart the conversion at a new input position
+    ///
+    /// The input frames that are pushed next start \a context
+    /// frames before the new position, so that the filter
+    /// is properly fed with the preceding samples. Use
+    /// getContextSize() to know how many frames are useful.
+    ///
+    /// \param context Number of frames preceding the new position
+    /// \param phase   Fractional part of the new position, in units of 1 / outputRate
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset(std::size_t context = 0, Uint64 phase = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of input frames needed before a position
+    ///
+    /// \return Number of frames of context
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getContextSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append input frames to the converter
+    ///
+    /// \param samples    Interleaved input samples
+    /// \param frameCount Number of frames (a sample per channel)
+    ///
+    ////////////////////////////////////////////////////////////
+    void push(const float* samples, std::size_t frameCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Signal that the input has ended
+    ///
+    /// The last output frames, which depend on input frames
+    /// beyond the end, can then be produced.
+    ///
+    ////////////////////////////////////////////////////////////
+    void finish();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Produce as many output frames as possible
+    ///
+    /// \param samples       Interleaved output samples to fill
+    /// \param maxFrameCount Maximum number of frames to produce
+    ///
+    /// \return Number of frames produced, less than \a maxFrameCount if more input is needed
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t pull(float* samples, std::size_t maxFrameCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether all the output frames were produced
+    ///
+    /// \return True if the input has ended and was fully converted
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isFinished() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int                     m_channelCount; ///< Number of channels of the samples
+    Uint64                           m_inputRate;    ///< Sample rate of the input samples
+    Uint64                           m_outputRate;   ///< Sample rate of the output samples
+    std::size_t                      m_phaseCount;   ///< Number of precomputed fractional positions
+    std::size_t                      m_halfLength;   ///< Number of filter taps on each side of a position
+    std::vector<float>               m_filter;       ///< Filter taps, for each fractional position
+    std::vector<std::vector<float> > m_history;      ///< Input frames still needed by the filter, per channel
+    std::size_t                      m_position;     ///< Position of the next output frame in the history
+    Uint64                           m_phase;        ///< Fractional part of the position, in units of 1 / outputRate
+    std::size_t                      m_end;          ///< End of the input in the history
+    bool                             m_finished;     ///< Has the input ended?
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_RESAMPLER_HPP
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Reverb.hpp>
+
+
+namespace
+{
+    // Freeverb tunings, in samples at 44100 Hz
+    const std::size_t combCount = 4;
+    const std::size_t combLengths[combCount] = {1116, 1188, 1277, 1356};
+    const std::size_t allpassCount = 2;
+    const std::size_t allpassLengths[allpassCount] = {556, 441};
+    const std::size_t stereoSpread = 23;
+
+    const float inputGain = 0.015f;
+    const float wetGain = 3.f;
+    const float damping = 0.2f;
+    const float allpassFeedback = 0.5f;
+
+    std::size_t scaleLength(std::size_t length, unsigned int sampleRate)
+    {
+        std::size_t scaled = length * sampleRate / 44100;
+        return scaled > 0 ? scaled : 1;
+    }
+}
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+Reverb::Reverb() :
+m_channelCount(0),
+m_combs       (),
+m_allpasses   ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Reverb::setup(unsigned int channelCount, unsigned int sampleRate)
+{
+    m_channelCount = channelCount;
+    m_combs.resize(channelCount * combCount);
+    m_allpasses.resize(channelCount * allpassCount);
+
+    // Offset the delays of odd channels, to decorrelate them
+    for (unsigned int c = 0; c < channelCount; ++c)
+    {
+        std::size_t spread = (c % 2) * stereoSpread;
+
+        for (std::size_t i = 0; i < combCount; ++i)
+        {
+            DelayLine& comb = m_combs[c * combCount + i];
+            comb.buffer.assign(scaleLength(combLengths[i] + spread, sampleRate), 0.f);
+            comb.position = 0;
+            comb.filter = 0.f;
+        }
+
+        for (std::size_t i = 0; i < allpassCount; ++i)
+        {
+            DelayLine& allpass = m_allpasses[c * allpassCount + i];
+            allpass.buffer.assign(scaleLength(allpassLengths[i] + spread, sampleRate), 0.f);
+            allpass.position = 0;
+            allpass.filter = 0.f;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Reverb::process(float* samples, std::size_t frameCount, float wet, float roomSize)
+{
+    float feedback = roomSize * 0.28f + 0.7f;
+
+    for (unsigned int c = 0; c < m_channelCount; ++c)
+    {
+        DelayLine* combs = &m_combs[c * combCount];
+        DelayLine* allpasses = &m_allpasses[c * allpassCount];
+
+        for (std::size_t f = 0; f < frameCount; ++f)
+        {
+            float& sample = samples[f * m_channelCount + c];
+            float input = sample * inputGain;
+
+            // Accumulate the parallel comb filters
+            float output = 0.f;
+            for (std::size_t i = 0; i < combCount; ++i)
+            {
+                DelayLine& comb = combs[i];
+                float delayed = comb.buffer[comb.position];
+                comb.filter = delayed * (1.f - damping) + comb.filter * damping;
+                comb.buffer[comb.position] = input + comb.filter * feedback;
+                comb.position = (comb.position + 1) % comb.buffer.size();
+                output += delayed;
+            }
+
+            // Diffuse the result through the allpass filters in series
+            for (std::size_t i = 0; i < allpassCount; ++i)
+            {
+                DelayLine& allpass = allpasses[i];
+                float delayed = allpass.buffer[allpass.position];
+                allpass.buffer[allpass.position] = output + delayed * allpassFeedback;
+                allpass.position = (allpass.position + 1) % allpass.buffer.size();
+                output = delayed - output;
+            }
+
+            sample = sample * (1.f - wet) + output * wet * wetGain;
+        }
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_REVERB_HPP
+#define SFML_REVERB_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Simple reverberation effect for the software mixer
+///
+/// This is a Schroeder reverb (parallel comb filters followed
+/// by allpass filters, with the Freeverb tunings), applied
+/// to each channel of interleaved float samples.
+///
+////////////////////////////////////////////////////////////
+class Reverb
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    Reverb();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate the delay lines for the given format
+    ///
+    /// This clears the current reverberation tail.
+    ///
+    /// \param channelCount Number of channels of the samples
+    /// \param sampleRate   Sample rate of the samples
+    ///
+    ////////////////////////////////////////////////////////////
+    void setup(unsigned int channelCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the reverb to a block of samples
+    ///
+    /// \param samples    Interleaved samples to process in place
+    /// \param frameCount Number of frames (a sample per channel)
+    /// \param wet        Proportion of reverberated signal, in [0, 1]
+    /// \param roomSize   Size of the simulated room, in [0, 1]
+    ///
+    ////////////////////////////////////////////////////////////
+    void process(float* samples, std::size_t frameCount, float wet, float roomSize);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Delay line of a filter
+    ///
+    ////////////////////////////////////////////////////////////
+    struct DelayLine
+    {
+        std::vector<float> buffer;   ///< Delayed samples
+        std::size_t        position; ///< Current position in the buffer
+        float              filter;   ///< State of the damping filter (comb filters only)
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int           m_channelCount; ///< Number of channels of the processed samples
+    std::vector<DelayLine> m_combs;        ///< Comb filters, grouped by channel
+    std::vector<DelayLine> m_allpasses;    ///< Allpass filters, grouped by channel
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_REVERB_HPP
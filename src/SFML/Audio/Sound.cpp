@@ -27,21 +27,29 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Sound.hpp>
 #include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/Audio/SoundRangeWatcher.hpp>
 #include <SFML/Audio/ALCheck.hpp>
+#include <algorithm>
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Sound::Sound() :
-m_buffer(NULL)
+m_buffer       (NULL),
+m_rangeOffset  (Time::Zero),
+m_rangeDuration(Time::Zero),
+m_loop         (false)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 Sound::Sound(const SoundBuffer& buffer) :
-m_buffer(NULL)
+m_buffer       (NULL),
+m_rangeOffset  (Time::Zero),
+m_rangeDuration(Time::Zero),
+m_loop         (false)
 {
     setBuffer(buffer);
 }
@@ -49,8 +57,11 @@ m_buffer(NULL)
 
 ////////////////////////////////////////////////////////////
 Sound::Sound(const Sound& copy) :
-SoundSource(copy),
-m_buffer   (NULL)
+SoundSource    (copy),
+m_buffer       (NULL),
+m_rangeOffset  (copy.m_rangeOffset),
+m_rangeDuration(copy.m_rangeDuration),
+m_loop         (false)
 {
     if (copy.m_buffer)
         setBuffer(*copy.m_buffer);
@@ -70,7 +81,23 @@ Sound::~Sound()
 ////////////////////////////////////////////////////////////
 void Sound::play()
 {
-    alCheck(alSourcePlay(m_source));
+    Uint64 begin, end;
+    if (getRangeFrames(begin, end))
+    {
+        // A paused sound resumes where it was, otherwise it restarts at the beginning of the range
+        if (getStatus() != Paused)
+        {
+            alCheck(alSourceStop(m_source));
+            alCheck(alSourcei(m_source, AL_SAMPLE_OFFSET, static_cast<ALint>(begin)));
+        }
+
+        alCheck(alSourcePlay(m_source));
+        priv::SoundRangeWatcher::add(m_source, begin, end, m_loop);
+    }
+    else
+    {
+        alCheck(alSourcePlay(m_source));
+    }
 }
 
 
@@ -84,6 +111,7 @@ void Sound::pause()
 ////////////////////////////////////////////////////////////
 void Sound::stop()
 {
+    priv::SoundRangeWatcher::remove(m_source);
     alCheck(alSourceStop(m_source));
 }
 
@@ -108,14 +136,75 @@ void Sound::setBuffer(const SoundBuffer& buffer)
 ////////////////////////////////////////////////////////////
 void Sound::setLoop(bool loop)
 {
-    alCheck(alSourcei(m_source, AL_LOOPING, loop));
+    m_loop = loop;
+
+    // While a range is set, looping is handled by the range watcher
+    Uint64 begin, end;
+    bool range = getRangeFrames(begin, end);
+    alCheck(alSourcei(m_source, AL_LOOPING, m_loop && !range));
+
+    if (range && (getStatus() != Stopped))
+        priv::SoundRangeWatcher::add(m_source, begin, end, m_loop);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Sound::setPlayingOffset(Time timeOffset)
 {
-    alCheck(alSourcef(m_source, AL_SEC_OFFSET, timeOffset.asSeconds()));
+    Uint64 begin, end;
+    if (getRangeFrames(begin, end))
+    {
+        Int64 offset = timeOffset.asMicroseconds() * m_buffer->getSampleRate() / 1000000;
+        Uint64 frame = begin + static_cast<Uint64>(std::max(offset, static_cast<Int64>(0)));
+        alCheck(alSourcei(m_source, AL_SAMPLE_OFFSET, static_cast<ALint>(std::min(frame, end))));
+    }
+    else
+    {
+        alCheck(alSourcef(m_source, AL_SEC_OFFSET, timeOffset.asSeconds()));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Sound::setRange(Time offset, Time duration)
+{
+    m_rangeOffset   = duration > Time::Zero ? std::max(offset, Time::Zero) : Time::Zero;
+    m_rangeDuration = std::max(duration, Time::Zero);
+
+    // Update the looping state and the watched range of the source
+    Uint64 begin, end;
+    if (getRangeFrames(begin, end))
+    {
+        alCheck(alSourcei(m_source, AL_LOOPING, false));
+        if (getStatus() != Stopped)
+            priv::SoundRangeWatcher::add(m_source, begin, end, m_loop);
+    }
+    else
+    {
+        priv::SoundRangeWatcher::remove(m_source);
+        alCheck(alSourcei(m_source, AL_LOOPING, m_loop));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Sound::resetRange()
+{
+    setRange(Time::Zero, Time::Zero);
+}
+
+
+////////////////////////////////////////////////////////////
+Time Sound::getRangeOffset() const
+{
+    return m_rangeOffset;
+}
+
+
+////////////////////////////////////////////////////////////
+Time Sound::getRangeDuration() const
+{
+    return m_rangeDuration;
 }
 
 
@@ -129,16 +218,23 @@ const SoundBuffer* Sound::getBuffer() const
 ////////////////////////////////////////////////////////////
 bool Sound::getLoop() const
 {
-    ALint loop;
-    alCheck(alGetSourcei(m_source, AL_LOOPING, &loop));
-
-    return loop != 0;
+    return m_loop;
 }
 
 
 ////////////////////////////////////////////////////////////
 Time Sound::getPlayingOffset() const
 {
+    Uint64 begin, end;
+    if (getRangeFrames(begin, end))
+    {
+        ALint frame = 0;
+        alCheck(alGetSourcei(m_source, AL_SAMPLE_OFFSET, &frame));
+
+        Uint64 offset = std::min(std::max(static_cast<Uint64>(frame), begin), end) - begin;
+        return microseconds(static_cast<Int64>(offset * 1000000 / m_buffer->getSampleRate()));
+    }
+
     ALfloat secs = 0.f;
     alCheck(alGetSourcef(m_source, AL_SEC_OFFSET, &secs));
 
@@ -170,6 +266,7 @@ Sound& Sound::operator =(const Sound& right)
     // Copy the sound attributes
     if (right.m_buffer)
         setBuffer(*right.m_buffer);
+    setRange(right.m_rangeOffset, right.m_rangeDuration);
     setLoop(right.getLoop());
     setPitch(right.getPitch());
     setVolume(right.getVolume());
@@ -197,4 +294,20 @@ void Sound::resetBuffer()
     }
 }
 
+
+////////////////////////////////////////////////////////////
+bool Sound::getRangeFrames(Uint64& begin, Uint64& end) const
+{
+    if (!m_buffer || (m_rangeDuration <= Time::Zero) || !m_buffer->getChannelCount() || !m_buffer->getSampleRate())
+        return false;
+
+    Uint64 rate   = m_buffer->getSampleRate();
+    Uint64 frames = m_buffer->getSampleCount() / m_buffer->getChannelCount();
+
+    begin = std::min(static_cast<Uint64>(m_rangeOffset.asMicroseconds()) * rate / 1000000, frames);
+    end   = std::min(begin + static_cast<Uint64>(m_rangeDuration.asMicroseconds()) * rate / 1000000, frames);
+
+    return true;
+}
+
 } // namespace sf
@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundAtlas.hpp>
+#include <SFML/Audio/InputSoundFile.hpp>
+#include <SFML/Audio/Sound.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace
+{
+    // Silence inserted after each clip, longer than the delay of the
+    // sound range watcher so that a late stop is never audible
+    const sf::Time clipGap = sf::milliseconds(100);
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SoundAtlas::SoundAtlas()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundAtlas::loadFromFiles(const std::vector<std::string>& filenames)
+{
+    m_clips.clear();
+
+    std::vector<Int16> samples;
+    unsigned int channelCount = 0;
+    unsigned int sampleRate = 0;
+
+    for (std::size_t i = 0; i < filenames.size(); ++i)
+    {
+        InputSoundFile file;
+        if (!file.openFromFile(filenames[i]))
+            return false;
+
+        // The first file decides the format of the atlas
+        if (i == 0)
+        {
+            channelCount = file.getChannelCount();
+            sampleRate = file.getSampleRate();
+        }
+        else if (file.getChannelCount() != channelCount)
+        {
+            err() << "Failed to add \"" << filenames[i] << "\" to the sound atlas (it has " << file.getChannelCount()
+                  << " channels, the atlas has " << channelCount << ")" << std::endl;
+            return false;
+        }
+        else
+        {
+            file.setOutputSampleRate(sampleRate);
+        }
+
+        // Append the samples of the clip followed by the silence
+        std::size_t begin = samples.size();
+        std::size_t count = static_cast<std::size_t>(file.getSampleCount());
+        samples.resize(begin + count);
+        if (count > 0)
+            samples.resize(begin + static_cast<std::size_t>(file.read(&samples[begin], count)));
+
+        Uint64 frames = (samples.size() - begin) / channelCount;
+        Clip clip;
+        clip.offset   = microseconds(static_cast<Int64>(static_cast<Uint64>(begin / channelCount) * 1000000 / sampleRate));
+        clip.duration = microseconds(static_cast<Int64>(frames * 1000000 / sampleRate));
+        m_clips.push_back(clip);
+
+        std::size_t gap = static_cast<std::size_t>(clipGap.asMicroseconds() * sampleRate / 1000000) * channelCount;
+        samples.resize(samples.size() + gap, 0);
+    }
+
+    if (samples.empty())
+    {
+        m_clips.clear();
+        return false;
+    }
+
+    if (!m_buffer.loadFromSamples(&samples[0], samples.size(), channelCount, sampleRate))
+    {
+        m_clips.clear();
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+const SoundBuffer& SoundAtlas::getBuffer() const
+{
+    return m_buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundAtlas::getClipCount() const
+{
+    return m_clips.size();
+}
+
+
+////////////////////////////////////////////////////////////
+const SoundAtlas::Clip& SoundAtlas::getClip(std::size_t index) const
+{
+    return m_clips[index];
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundAtlas::setClip(Sound& sound, std::size_t index) const
+{
+    if (sound.getBuffer() != &m_buffer)
+        sound.setBuffer(m_buffer);
+
+    sound.setRange(m_clips[index].offset, m_clips[index].duration);
+}
+
+} // namespace sf
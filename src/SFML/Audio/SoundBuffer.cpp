@@ -32,14 +32,28 @@
 #include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <memory>
 
 
+namespace
+{
+    // Convert normalized float samples to 16 bits integers
+    void convertSamples(const std::vector<float>& samples, std::vector<sf::Int16>& converted)
+    {
+        converted.resize(samples.size());
+        for (std::size_t i = 0; i < samples.size(); ++i)
+            converted[i] = static_cast<sf::Int16>(std::min(std::max(samples[i], -1.f), 1.f) * 32767.f);
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 SoundBuffer::SoundBuffer() :
 m_buffer  (0),
+m_memory  (MemoryTracker::SoundBuffers),
 m_duration()
 {
     // Create the buffer
@@ -49,10 +63,12 @@ m_duration()
 
 ////////////////////////////////////////////////////////////
 SoundBuffer::SoundBuffer(const SoundBuffer& copy) :
-m_buffer  (0),
-m_samples (copy.m_samples),
-m_duration(copy.m_duration),
-m_sounds  () // don't copy the attached sounds
+m_buffer      (0),
+m_samples     (copy.m_samples),
+m_floatSamples(copy.m_floatSamples),
+m_memory      (copy.m_memory),
+m_duration    (copy.m_duration),
+m_sounds      () // don't copy the attached sounds
 {
     // Create the buffer
     alCheck(alGenBuffers(1, &m_buffer));
@@ -121,6 +137,7 @@ bool SoundBuffer::loadFromSamples(const Int16* samples, Uint64 sampleCount, unsi
     {
         // Copy the new audio samples
         m_samples.assign(samples, samples + sampleCount);
+        m_floatSamples.clear();
 
         // Update the internal buffer with the new samples
         return update(channelCount, sampleRate);
@@ -140,15 +157,57 @@ bool SoundBuffer::loadFromSamples(const Int16* samples, Uint64 sampleCount, unsi
 }
 
 
+////////////////////////////////////////////////////////////
+bool SoundBuffer::loadFromSamples(const float* samples, Uint64 sampleCount, unsigned int channelCount, unsigned int sampleRate)
+{
+    if (samples && sampleCount && channelCount && sampleRate)
+    {
+        // Copy the new audio samples
+        m_floatSamples.assign(samples, samples + sampleCount);
+        m_samples.clear();
+
+        // Update the internal buffer with the new samples
+        return update(channelCount, sampleRate);
+    }
+    else
+    {
+        // Error...
+        err() << "Failed to load sound buffer from float samples ("
+              << "array: "      << samples      << ", "
+              << "count: "      << sampleCount  << ", "
+              << "channels: "   << channelCount << ", "
+              << "samplerate: " << sampleRate   << ")"
+              << std::endl;
+
+        return false;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::saveToFile(const std::string& filename) const
 {
+    if (m_samples.empty() && m_floatSamples.empty())
+    {
+        err() << "Failed to save sound buffer to \"" << filename << "\" (no samples in system memory)" << std::endl;
+        return false;
+    }
+
     // Create the sound file in write mode
     OutputSoundFile file;
     if (file.openFromFile(filename, getSampleRate(), getChannelCount()))
     {
-        // Write the samples to the opened file
-        file.write(&m_samples[0], m_samples.size());
+        // Write the samples to the opened file (sound files are written as 16 bits samples)
+        if (!m_floatSamples.empty())
+        {
+            std::vector<Int16> samples;
+            convertSamples(m_floatSamples, samples);
+            file.write(&samples[0], samples.size());
+        }
+        else
+        {
+            file.write(&m_samples[0], m_samples.size());
+        }
 
         return true;
     }
@@ -166,10 +225,39 @@ const Int16* SoundBuffer::getSamples() const
 }
 
 
+////////////////////////////////////////////////////////////
+const float* SoundBuffer::getFloatSamples() const
+{
+    return m_floatSamples.empty() ? NULL : &m_floatSamples[0];
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::releaseSamples()
+{
+    // Swap with empty vectors to really free the memory
+    std::vector<Int16>().swap(m_samples);
+    std::vector<float>().swap(m_floatSamples);
+    updateMemoryUsage();
+}
+
+
 ////////////////////////////////////////////////////////////
 Uint64 SoundBuffer::getSampleCount() const
 {
-    return m_samples.size();
+    if (!m_floatSamples.empty())
+        return m_floatSamples.size();
+
+    if (!m_samples.empty())
+        return m_samples.size();
+
+    // The samples were released: ask the audio device
+    ALint size = 0;
+    ALint bits = 0;
+    alCheck(alGetBufferi(m_buffer, AL_SIZE, &size));
+    alCheck(alGetBufferi(m_buffer, AL_BITS, &bits));
+
+    return (bits > 0) ? static_cast<Uint64>(size / (bits / 8)) : 0;
 }
 
 
@@ -205,10 +293,12 @@ SoundBuffer& SoundBuffer::operator =(const SoundBuffer& right)
 {
     SoundBuffer temp(right);
 
-    std::swap(m_samples,  temp.m_samples);
-    std::swap(m_buffer,   temp.m_buffer);
-    std::swap(m_duration, temp.m_duration);
-    std::swap(m_sounds,   temp.m_sounds); // swap sounds too, so that they are detached when temp is destroyed
+    std::swap(m_samples,      temp.m_samples);
+    std::swap(m_floatSamples, temp.m_floatSamples);
+    std::swap(m_buffer,       temp.m_buffer);
+    std::swap(m_duration,     temp.m_duration);
+    std::swap(m_sounds,       temp.m_sounds); // swap sounds too, so that they are detached when temp is destroyed
+    updateMemoryUsage();
 
     return *this;
 }
@@ -223,6 +313,7 @@ bool SoundBuffer::initialize(InputSoundFile& file)
     unsigned int sampleRate   = file.getSampleRate();
 
     // Read the samples from the provided file
+    m_floatSamples.clear();
     m_samples.resize(static_cast<std::size_t>(sampleCount));
     if (file.read(&m_samples[0], sampleCount) == sampleCount)
     {
@@ -239,12 +330,18 @@ bool SoundBuffer::initialize(InputSoundFile& file)
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::update(unsigned int channelCount, unsigned int sampleRate)
 {
+    updateMemoryUsage();
+
     // Check parameters
-    if (!channelCount || !sampleRate || m_samples.empty())
+    if (!channelCount || !sampleRate || (m_samples.empty() && m_floatSamples.empty()))
         return false;
 
+    // Float samples are uploaded as is if the implementation supports them, and converted otherwise
+    bool isFloat = !m_floatSamples.empty();
+    ALenum floatFormat = isFloat ? priv::AudioDevice::getFloatFormatFromChannelCount(channelCount) : 0;
+
     // Find the good format according to the number of channels
-    ALenum format = priv::AudioDevice::getFormatFromChannelCount(channelCount);
+    ALenum format = floatFormat ? floatFormat : priv::AudioDevice::getFormatFromChannelCount(channelCount);
 
     // Check if the format is valid
     if (format == 0)
@@ -261,11 +358,27 @@ bool SoundBuffer::update(unsigned int channelCount, unsigned int sampleRate)
         (*it)->resetBuffer();
 
     // Fill the buffer
-    ALsizei size = static_cast<ALsizei>(m_samples.size()) * sizeof(Int16);
-    alCheck(alBufferData(m_buffer, format, &m_samples[0], size, sampleRate));
+    if (floatFormat)
+    {
+        ALsizei size = static_cast<ALsizei>(m_floatSamples.size()) * sizeof(float);
+        alCheck(alBufferData(m_buffer, format, &m_floatSamples[0], size, sampleRate));
+    }
+    else if (isFloat)
+    {
+        std::vector<Int16> samples;
+        convertSamples(m_floatSamples, samples);
+
+        ALsizei size = static_cast<ALsizei>(samples.size()) * sizeof(Int16);
+        alCheck(alBufferData(m_buffer, format, &samples[0], size, sampleRate));
+    }
+    else
+    {
+        ALsizei size = static_cast<ALsizei>(m_samples.size()) * sizeof(Int16);
+        alCheck(alBufferData(m_buffer, format, &m_samples[0], size, sampleRate));
+    }
 
     // Compute the duration
-    m_duration = seconds(static_cast<float>(m_samples.size()) / sampleRate / channelCount);
+    m_duration = seconds(static_cast<float>(getSampleCount()) / sampleRate / channelCount);
 
     // Now reattach the buffer to the sounds that use it
     for (SoundList::const_iterator it = sounds.begin(); it != sounds.end(); ++it)
@@ -288,4 +401,11 @@ void SoundBuffer::detachSound(Sound* sound) const
     m_sounds.erase(sound);
 }
 
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::updateMemoryUsage()
+{
+    m_memory.setBytes(m_samples.capacity() * sizeof(Int16) + m_floatSamples.capacity() * sizeof(float));
+}
+
 } // namespace sf
@@ -0,0 +1,278 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundBufferLoadQueue.hpp>
+#include <SFML/Audio/InputSoundFile.hpp>
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/Audio/SoundFileFactory.hpp>
+#include <SFML/Audio/SoundFileReader.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SoundBufferLoadQueue::SoundBufferLoadQueue(unsigned int threadCount) :
+m_threads (),
+m_jobs    (),
+m_results (),
+m_nextId  (0),
+m_pending (0),
+m_decoding(0),
+m_running (true),
+m_mutex   (),
+m_newJob  (),
+m_jobDone ()
+{
+    // Register the built-in readers now, their lazy registration is not thread-safe
+    delete SoundFileFactory::createReaderFromMemory(NULL, 0);
+
+    if (threadCount == 0)
+        threadCount = 1;
+
+    for (unsigned int i = 0; i < threadCount; ++i)
+    {
+        Thread* thread = new Thread(&SoundBufferLoadQueue::run, this);
+        m_threads.push_back(thread);
+        thread->launch();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+SoundBufferLoadQueue::~SoundBufferLoadQueue()
+{
+    // Stop the workers, the jobs being decoded are finished first
+    {
+        Lock lock(m_mutex);
+        m_running = false;
+        m_jobs.clear();
+        m_newJob.notifyAll();
+    }
+
+    for (std::vector<Thread*>::iterator it = m_threads.begin(); it != m_threads.end(); ++it)
+    {
+        (*it)->wait();
+        delete *it;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundBufferLoadQueue::push(const std::string& filename)
+{
+    Job job;
+    job.filename = filename;
+    job.data = NULL;
+    job.size = 0;
+    job.stream = NULL;
+
+    return addJob(job);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundBufferLoadQueue::push(const void* data, std::size_t size)
+{
+    Job job;
+    job.data = data;
+    job.size = size;
+    job.stream = NULL;
+
+    return addJob(job);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundBufferLoadQueue::push(InputStream& stream)
+{
+    Job job;
+    job.data = NULL;
+    job.size = 0;
+    job.stream = &stream;
+
+    return addJob(job);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBufferLoadQueue::pop(Result& result)
+{
+    Lock lock(m_mutex);
+
+    if (m_results.empty())
+        return false;
+
+    result = m_results.front();
+    m_results.pop_front();
+    m_pending--;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBufferLoadQueue::pop(SoundBuffer& buffer, std::size_t& id)
+{
+    Result result;
+    if (!pop(result))
+        return false;
+
+    // Create the audio buffer in the calling thread
+    id = result.id;
+    return result.success && buffer.loadFromSamples(&result.samples[0], result.samples.size(), result.channelCount, result.sampleRate);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBufferLoadQueue::isReady() const
+{
+    Lock lock(m_mutex);
+
+    return !m_results.empty();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferLoadQueue::wait() const
+{
+    Lock lock(m_mutex);
+
+    while (!m_jobs.empty() || (m_decoding > 0))
+        m_jobDone.wait(m_mutex);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundBufferLoadQueue::getPendingCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_pending;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBufferLoadQueue::loadFromFiles(const std::vector<std::string>& filenames, std::vector<SoundBuffer>& buffers, unsigned int threadCount)
+{
+    buffers.resize(filenames.size());
+
+    // Don't start more threads than there are files
+    threadCount = static_cast<unsigned int>(std::min<std::size_t>(threadCount, filenames.size()));
+    if (threadCount == 0)
+        return true;
+
+    SoundBufferLoadQueue queue(threadCount);
+    for (std::size_t i = 0; i < filenames.size(); ++i)
+        queue.push(filenames[i]);
+
+    queue.wait();
+
+    // The identifiers are the indices of the files, since they start from 0
+    bool success = true;
+    Result result;
+    while (queue.pop(result))
+    {
+        if (!result.success || !buffers[result.id].loadFromSamples(&result.samples[0], result.samples.size(), result.channelCount, result.sampleRate))
+            success = false;
+    }
+
+    return success;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundBufferLoadQueue::addJob(Job& job)
+{
+    Lock lock(m_mutex);
+
+    job.id = m_nextId++;
+    m_jobs.push_back(job);
+    m_pending++;
+    m_newJob.notifyOne();
+
+    return job.id;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferLoadQueue::run()
+{
+    for (;;)
+    {
+        // Take the next job, sleeping until there is one
+        Job job;
+        {
+            Lock lock(m_mutex);
+
+            while (m_running && m_jobs.empty())
+                m_newJob.wait(m_mutex);
+
+            if (!m_running)
+                return;
+
+            job = m_jobs.front();
+            m_jobs.pop_front();
+            m_decoding++;
+        }
+
+        // Decode the file outside the lock, so that the workers run in parallel
+        Result result;
+        result.id = job.id;
+        result.success = false;
+        result.channelCount = 0;
+        result.sampleRate = 0;
+
+        InputSoundFile file;
+        bool opened = false;
+        if (job.stream)
+            opened = file.openFromStream(*job.stream);
+        else if (job.data)
+            opened = file.openFromMemory(job.data, job.size);
+        else
+            opened = file.openFromFile(job.filename);
+
+        if (opened)
+        {
+            result.samples.resize(static_cast<std::size_t>(file.getSampleCount()));
+            result.channelCount = file.getChannelCount();
+            result.sampleRate = file.getSampleRate();
+            result.success = !result.samples.empty() && (file.read(&result.samples[0], result.samples.size()) == result.samples.size());
+            if (!result.success)
+                result.samples.clear();
+        }
+
+        Lock lock(m_mutex);
+        m_results.push_back(result);
+        m_decoding--;
+        m_jobDone.notifyAll();
+    }
+}
+
+} // namespace sf
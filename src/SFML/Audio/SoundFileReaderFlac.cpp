@@ -28,6 +28,7 @@
 #include <SFML/Audio/SoundFileReaderFlac.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cassert>
 
 
@@ -103,55 +104,81 @@ namespace
         return data->stream->tell() == data->stream->getSize();
     }
 
+    // Convert a raw sample to the type of the output buffer and append it
+    void output(sf::priv::SoundFileReaderFlac::ClientData* data, FLAC__int32 sample, unsigned int bitsPerSample)
+    {
+        if (data->buffer)
+        {
+            switch (bitsPerSample)
+            {
+                case 8:
+                    *data->buffer++ = static_cast<sf::Int16>(sample << 8);
+                    break;
+                case 16:
+                    *data->buffer++ = static_cast<sf::Int16>(sample);
+                    break;
+                case 24:
+                    *data->buffer++ = static_cast<sf::Int16>(sample >> 8);
+                    break;
+                case 32:
+                    *data->buffer++ = static_cast<sf::Int16>(sample >> 16);
+                    break;
+                default:
+                    assert(false);
+                    break;
+            }
+        }
+        else
+        {
+            // Keep the full precision of the file
+            *data->floatBuffer++ = static_cast<float>(sample / static_cast<double>(sf::Int64(1) << (bitsPerSample - 1)));
+        }
+    }
+
     FLAC__StreamDecoderWriteStatus streamWrite(const FLAC__StreamDecoder*, const FLAC__Frame* frame, const FLAC__int32* const buffer[], void* clientData)
     {
         sf::priv::SoundFileReaderFlac::ClientData* data = static_cast<sf::priv::SoundFileReaderFlac::ClientData*>(clientData);
 
-        // If there's no output buffer, it means that we are seeking
-        if (!data->buffer)
+        // The decoder always reports the position of the frame as a sample number
+        sf::Uint64 position = frame->header.number.sample_number;
+        data->nextFrame = position + frame->header.blocksize;
+
+        // When seeking, drop the frames that precede the target; the remaining ones
+        // will go to the leftovers buffer since there's no output buffer
+        unsigned int first = 0;
+        if (data->seeking)
+        {
+            if (data->target >= data->nextFrame)
+                return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+            if (data->target > position)
+                first = static_cast<unsigned int>(data->target - position);
+        }
+        else if (!data->buffer && !data->floatBuffer)
+        {
             return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+        }
 
         // Reserve memory if we're going to use the leftovers buffer
-        unsigned int frameSamples = frame->header.blocksize * frame->header.channels;
+        unsigned int frameSamples = (frame->header.blocksize - first) * frame->header.channels;
         if (data->remaining < frameSamples)
             data->leftovers.reserve(static_cast<std::size_t>(frameSamples - data->remaining));
 
         // Decode the samples
-        for (unsigned i = 0; i < frame->header.blocksize; ++i)
+        data->bitsPerSample = frame->header.bits_per_sample;
+        for (unsigned i = first; i < frame->header.blocksize; ++i)
         {
             for (unsigned int j = 0; j < frame->header.channels; ++j)
             {
-                // Decode the current sample
-                sf::Int16 sample = 0;
-                switch (frame->header.bits_per_sample)
-                {
-                    case 8:
-                        sample = buffer[j][i] << 8;
-                        break;
-                    case 16:
-                        sample = buffer[j][i];
-                        break;
-                    case 24:
-                        sample = buffer[j][i] >> 8;
-                        break;
-                    case 32:
-                        sample = buffer[j][i] >> 16;
-                        break;
-                    default:
-                        assert(false);
-                        break;
-                }
-
                 if (data->remaining > 0)
                 {
                     // There's room in the output buffer, copy the sample there
-                    *data->buffer++ = sample;
+                    output(data, buffer[j][i], data->bitsPerSample);
                     data->remaining--;
                 }
                 else
                 {
                     // We have decoded all the requested samples, put the sample in a temporary buffer until next call
-                    data->leftovers.push_back(sample);
+                    data->leftovers.push_back(buffer[j][i]);
                 }
             }
         }
@@ -185,31 +212,33 @@ namespace priv
 ////////////////////////////////////////////////////////////
 bool SoundFileReaderFlac::check(InputStream& stream)
 {
-    // Create a decoder
-    FLAC__StreamDecoder* decoder = FLAC__stream_decoder_new();
-    if (!decoder)
+    // Only look at the signature of the stream, the metadata is decoded when opening the file
+    unsigned char header[10];
+    if (stream.read(header, 4) != 4)
         return false;
 
-    // Initialize the decoder with our callbacks
-    ClientData data;
-    data.stream = &stream;
-    data.error = false;
-    FLAC__stream_decoder_init_stream(decoder, &streamRead, &streamSeek, &streamTell, &streamLength, &streamEof, &streamWrite, NULL, &streamError, &data);
-
-    // Read the header
-    bool valid = FLAC__stream_decoder_process_until_end_of_metadata(decoder) != 0;
-
-    // Destroy the decoder
-    FLAC__stream_decoder_finish(decoder);
-    FLAC__stream_decoder_delete(decoder);
+    // Skip an ID3v2 tag, which is allowed before the FLAC signature
+    if ((header[0] == 'I') && (header[1] == 'D') && (header[2] == '3'))
+    {
+        if (stream.read(header + 4, 6) != 6)
+            return false;
+
+        // The size is stored as 4 bytes of 7 bits, and doesn't include the header and the footer
+        Int64 size = (header[6] << 21) | (header[7] << 14) | (header[8] << 7) | header[9];
+        size += (header[5] & 0x10) ? 20 : 10;
+        if ((stream.seek(stream.tell() - 10 + size) == -1) || (stream.read(header, 4) != 4))
+            return false;
+    }
 
-    return valid && !data.error;
+    return (header[0] == 'f') && (header[1] == 'L') && (header[2] == 'a') && (header[3] == 'C');
 }
 
 
 ////////////////////////////////////////////////////////////
 SoundFileReaderFlac::SoundFileReaderFlac() :
-m_decoder(NULL)
+m_decoder   (NULL),
+m_clientData(),
+m_index     ()
 {
 }
 
@@ -233,7 +262,15 @@ bool SoundFileReaderFlac::open(InputStream& stream, Info& info)
     }
 
     // Initialize the decoder with our callbacks
-    m_clientData.stream = &stream;
+    m_clientData.stream        = &stream;
+    m_clientData.buffer        = NULL;
+    m_clientData.floatBuffer   = NULL;
+    m_clientData.remaining     = 0;
+    m_clientData.bitsPerSample = 16;
+    m_clientData.nextFrame     = 0;
+    m_clientData.seeking       = false;
+    m_clientData.target        = 0;
+    m_clientData.error         = false;
     FLAC__stream_decoder_init_stream(m_decoder, &streamRead, &streamSeek, &streamTell, &streamLength, &streamEof, &streamWrite, &streamMetadata, &streamError, &m_clientData);
 
     // Read the header
@@ -247,6 +284,13 @@ bool SoundFileReaderFlac::open(InputStream& stream, Info& info)
     // Retrieve the sound properties
     info = m_clientData.info; // was filled in the "metadata" callback
 
+    // Index the stream every tenth of a second, starting with the first frame
+    m_index.clear();
+    m_index.setSpacing(info.sampleRate / 10);
+    FLAC__uint64 position;
+    if (FLAC__stream_decoder_get_decode_position(m_decoder, &position))
+        m_index.add(0, position);
+
     return true;
 }
 
@@ -258,10 +302,25 @@ void SoundFileReaderFlac::seek(Uint64 sampleOffset)
 
     // Reset the callback data (the "write" callback will be called)
     m_clientData.buffer = NULL;
+    m_clientData.floatBuffer = NULL;
     m_clientData.remaining = 0;
     m_clientData.leftovers.clear();
 
-    FLAC__stream_decoder_seek_absolute(m_decoder, sampleOffset);
+    // The decoder works with frames (a sample per channel)
+    Uint64 frame = sampleOffset / m_clientData.info.channelCount;
+
+    // Keep the samples of the target frame: they are stored as leftovers for the next read
+    m_clientData.seeking = true;
+    m_clientData.target = frame;
+
+    // Jump directly to a recorded frame if possible, or let the decoder search for the target
+    if (!seekIndexed(frame))
+    {
+        m_clientData.leftovers.clear();
+        FLAC__stream_decoder_seek_absolute(m_decoder, frame);
+    }
+
+    m_clientData.seeking = false;
 }
 
 
@@ -270,29 +329,67 @@ Uint64 SoundFileReaderFlac::read(Int16* samples, Uint64 maxCount)
 {
     assert(m_decoder);
 
-    // If there are leftovers from previous call, use it first
-    Uint64 left = m_clientData.leftovers.size();
-    if (left > 0)
+    m_clientData.buffer = samples;
+    m_clientData.floatBuffer = NULL;
+
+    return decode(maxCount);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderFlac::read(float* samples, Uint64 maxCount)
+{
+    assert(m_decoder);
+
+    m_clientData.buffer = NULL;
+    m_clientData.floatBuffer = samples;
+
+    return decode(maxCount);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileReaderFlac::getSeekIndex(std::vector<Uint64>& index) const
+{
+    m_index.save(index);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileReaderFlac::setSeekIndex(const std::vector<Uint64>& index)
+{
+    return m_index.load(index);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileReaderFlac::close()
+{
+    if (m_decoder)
     {
-        if (left > maxCount)
-        {
-            // There are more leftovers than needed
-            std::copy(m_clientData.leftovers.begin(), m_clientData.leftovers.end(), samples);
-            std::vector<Int16> leftovers(m_clientData.leftovers.begin() + maxCount, m_clientData.leftovers.end());
-            m_clientData.leftovers.swap(leftovers);
-            return maxCount;
-        }
-        else
-        {
-            // We can use all the leftovers and decode new frames
-            std::copy(m_clientData.leftovers.begin(), m_clientData.leftovers.end(), samples);
-        }
+        FLAC__stream_decoder_finish(m_decoder);
+        FLAC__stream_decoder_delete(m_decoder);
+        m_decoder = NULL;
     }
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderFlac::decode(Uint64 maxCount)
+{
+    // If there are leftovers from previous call, use them first
+    Uint64 left = std::min<Uint64>(m_clientData.leftovers.size(), maxCount);
+    for (Uint64 i = 0; i < left; ++i)
+        output(&m_clientData, m_clientData.leftovers[static_cast<std::size_t>(i)], m_clientData.bitsPerSample);
+    m_clientData.leftovers.erase(m_clientData.leftovers.begin(), m_clientData.leftovers.begin() + static_cast<std::size_t>(left));
+
+    // There may be more leftovers than needed
+    if (left == maxCount)
+        return maxCount;
 
     // Reset the data that will be used in the callback
-    m_clientData.buffer = samples + left;
     m_clientData.remaining = maxCount - left;
-    m_clientData.leftovers.clear();
 
     // Decode frames one by one until we reach the requested sample count, the end of file or an error
     while (m_clientData.remaining > 0)
@@ -305,6 +402,11 @@ Uint64 SoundFileReaderFlac::read(Int16* samples, Uint64 maxCount)
         // Break on EOF
         if (FLAC__stream_decoder_get_state(m_decoder) == FLAC__STREAM_DECODER_END_OF_STREAM)
             break;
+
+        // Remember where the next frame starts, so that seeking back here is immediate
+        FLAC__uint64 position;
+        if (FLAC__stream_decoder_get_decode_position(m_decoder, &position))
+            m_index.add(m_clientData.nextFrame, position);
     }
 
     return maxCount - m_clientData.remaining;
@@ -312,14 +414,28 @@ Uint64 SoundFileReaderFlac::read(Int16* samples, Uint64 maxCount)
 
 
 ////////////////////////////////////////////////////////////
-void SoundFileReaderFlac::close()
+bool SoundFileReaderFlac::seekIndexed(Uint64 frame)
 {
-    if (m_decoder)
+    const SoundFileSeekIndex::Point* point = m_index.find(frame);
+    if (!point)
+        return false;
+
+    // Move the stream to the start of the recorded frame, and resynchronize the decoder there
+    if ((m_clientData.stream->seek(static_cast<Int64>(point->offset)) < 0) || !FLAC__stream_decoder_flush(m_decoder))
+        return false;
+
+    // Decode frames up to the one that contains the target, the "write" callback drops the samples before it
+    m_clientData.nextFrame = point->frame;
+    while (m_clientData.nextFrame <= frame)
     {
-        FLAC__stream_decoder_finish(m_decoder);
-        FLAC__stream_decoder_delete(m_decoder);
-        m_decoder = NULL;
+        if (!FLAC__stream_decoder_process_single(m_decoder))
+            return false;
+
+        if (FLAC__stream_decoder_get_state(m_decoder) == FLAC__STREAM_DECODER_END_OF_STREAM)
+            break;
     }
+
+    return true;
 }
 
 } // namespace priv
@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundFileReader.hpp>
+#include <SFML/Audio/SoundFileSeekIndex.hpp>
 #include <FLAC/stream_decoder.h>
 #include <string>
 #include <vector>
@@ -101,6 +102,37 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as floats
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 read(float* samples, Uint64 maxCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the seek index built by the reader
+    ///
+    /// \param index Array to fill with the index
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getSeekIndex(std::vector<Uint64>& index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Replace the seek index of the reader
+    ///
+    /// \param index Index to use
+    ///
+    /// \return True if the index was accepted
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool setSeekIndex(const std::vector<Uint64>& index);
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -109,12 +141,17 @@ public:
     ////////////////////////////////////////////////////////////
     struct ClientData
     {
-        InputStream*          stream;
-        SoundFileReader::Info info;
-        Int16*                buffer;
-        Uint64                remaining;
-        std::vector<Int16>    leftovers;
-        bool                  error;
+        InputStream*              stream;
+        SoundFileReader::Info     info;
+        Int16*                    buffer;        // 16-bits output, or NULL
+        float*                    floatBuffer;   // float output, or NULL
+        Uint64                    remaining;
+        std::vector<FLAC__int32>  leftovers;     // raw samples decoded beyond the requested count
+        unsigned int              bitsPerSample; // precision of the raw samples
+        Uint64                    nextFrame;     // index of the frame following the last decoded one
+        bool                      seeking;       // are we decoding up to a seek target?
+        Uint64                    target;        // first frame to keep when seeking
+        bool                      error;
     };
 
 private:
@@ -125,11 +162,32 @@ private:
     ////////////////////////////////////////////////////////////
     void close();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode samples into the output buffer set in the client data
+    ///
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 decode(Uint64 maxCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Seek using a point of the index
+    ///
+    /// \param frame Index of the frame to jump to
+    ///
+    /// \return True on success, false if the index couldn't be used
+    ///
+    ////////////////////////////////////////////////////////////
+    bool seekIndexed(Uint64 frame);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
     FLAC__StreamDecoder* m_decoder;    ///< FLAC decoder
     ClientData           m_clientData; ///< Structure passed to the decoder callbacks
+    SoundFileSeekIndex   m_index;      ///< Positions of the frames recorded while decoding
 };
 
 } // namespace priv
@@ -73,23 +73,33 @@ namespace priv
 ////////////////////////////////////////////////////////////
 bool SoundFileReaderOgg::check(InputStream& stream)
 {
-    OggVorbis_File file;
-    if (ov_test_callbacks(&stream, &file, NULL, 0, callbacks) == 0)
-    {
-        ov_clear(&file);
-        return true;
-    }
-    else
-    {
+    // Only look at the first page of the stream, which must start with the
+    // Vorbis identification header; the full setup is done when opening the file
+    unsigned char page[27];
+    if (stream.read(page, sizeof(page)) != sizeof(page))
         return false;
-    }
+    if ((page[0] != 'O') || (page[1] != 'g') || (page[2] != 'g') || (page[3] != 'S'))
+        return false;
+
+    // Skip the segment table
+    unsigned char segments[255];
+    if (stream.read(segments, page[26]) != page[26])
+        return false;
+
+    unsigned char packet[7];
+    if (stream.read(packet, sizeof(packet)) != sizeof(packet))
+        return false;
+
+    return (packet[0] == 1) && (packet[1] == 'v') && (packet[2] == 'o') && (packet[3] == 'r')
+        && (packet[4] == 'b') && (packet[5] == 'i') && (packet[6] == 's');
 }
 
 
 ////////////////////////////////////////////////////////////
 SoundFileReaderOgg::SoundFileReaderOgg() :
 m_vorbis      (),
-m_channelCount(0)
+m_channelCount(0),
+m_index       ()
 {
     m_vorbis.datasource = NULL;
 }
@@ -122,6 +132,10 @@ bool SoundFileReaderOgg::open(InputStream& stream, Info& info)
     // We must keep the channel count for the seek function
     m_channelCount = info.channelCount;
 
+    // Index the stream every tenth of a second
+    m_index.clear();
+    m_index.setSpacing(info.sampleRate / 10);
+
     return true;
 }
 
@@ -131,7 +145,29 @@ void SoundFileReaderOgg::seek(Uint64 sampleOffset)
 {
     assert(m_vorbis.datasource);
 
-    ov_pcm_seek(&m_vorbis, sampleOffset / m_channelCount);
+    Uint64 frame = sampleOffset / m_channelCount;
+
+    // Jump directly to a recorded position before the target if possible, then decode up to it;
+    // a point may overshoot the target by a few frames, in which case the previous ones are tried
+    for (std::size_t distance = 0; distance < 3; ++distance)
+    {
+        const SoundFileSeekIndex::Point* point = m_index.find(frame, distance);
+        if (!point)
+            break;
+
+        if (ov_raw_seek(&m_vorbis, static_cast<ogg_int64_t>(point->offset)) == 0)
+        {
+            ogg_int64_t position = ov_pcm_tell(&m_vorbis);
+            if ((position >= 0) && (static_cast<Uint64>(position) <= frame))
+            {
+                skip(frame - static_cast<Uint64>(position));
+                return;
+            }
+        }
+    }
+
+    // Position not indexed: let libvorbisfile search for it
+    ov_pcm_seek(&m_vorbis, static_cast<ogg_int64_t>(frame));
 }
 
 
@@ -144,6 +180,8 @@ Uint64 SoundFileReaderOgg::read(Int16* samples, Uint64 maxCount)
     Uint64 count = 0;
     while (count < maxCount)
     {
+        indexPosition();
+
         int bytesToRead = static_cast<int>(maxCount - count) * sizeof(Int16);
         long bytesRead = ov_read(&m_vorbis, reinterpret_cast<char*>(samples), bytesToRead, 0, 2, 1, NULL);
         if (bytesRead > 0)
@@ -163,6 +201,87 @@ Uint64 SoundFileReaderOgg::read(Int16* samples, Uint64 maxCount)
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderOgg::read(float* samples, Uint64 maxCount)
+{
+    assert(m_vorbis.datasource);
+
+    // Try to read the requested number of frames, stop only on error or end of file
+    Uint64 count = 0;
+    while (count + m_channelCount <= maxCount)
+    {
+        indexPosition();
+
+        // Vorbis decodes to planar floats: interleave them
+        float** channels = NULL;
+        int framesToRead = static_cast<int>((maxCount - count) / m_channelCount);
+        long framesRead = ov_read_float(&m_vorbis, &channels, framesToRead, NULL);
+        if (framesRead > 0)
+        {
+            for (long i = 0; i < framesRead; ++i)
+                for (unsigned int j = 0; j < m_channelCount; ++j)
+                    *samples++ = channels[j][i];
+
+            count += static_cast<Uint64>(framesRead) * m_channelCount;
+        }
+        else
+        {
+            // error or end of file
+            break;
+        }
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileReaderOgg::getSeekIndex(std::vector<Uint64>& index) const
+{
+    m_index.save(index);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileReaderOgg::setSeekIndex(const std::vector<Uint64>& index)
+{
+    return m_index.load(index);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileReaderOgg::indexPosition()
+{
+    // Positions are meaningless if the stream can't be seeked
+    if (!ov_seekable(&m_vorbis))
+        return;
+
+    // Samples already decoded from the current page are not part of the raw position,
+    // so the recorded frame may be slightly before the one decoded after a jump
+    ogg_int64_t frame = ov_pcm_tell(&m_vorbis);
+    ogg_int64_t offset = ov_raw_tell(&m_vorbis);
+    if ((frame >= 0) && (offset >= 0))
+        m_index.add(static_cast<Uint64>(frame), static_cast<Uint64>(offset));
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileReaderOgg::skip(Uint64 frameCount)
+{
+    while (frameCount > 0)
+    {
+        float** channels = NULL;
+        int framesToRead = static_cast<int>(std::min<Uint64>(frameCount, 4096));
+        long framesRead = ov_read_float(&m_vorbis, &channels, framesToRead, NULL);
+        if (framesRead <= 0)
+            break;
+
+        frameCount -= static_cast<Uint64>(framesRead);
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundFileReaderOgg::close()
 {
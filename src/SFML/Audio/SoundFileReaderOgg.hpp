@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundFileReader.hpp>
+#include <SFML/Audio/SoundFileSeekIndex.hpp>
 #include <vorbis/vorbisfile.h>
 
 
@@ -101,8 +102,53 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as floats
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 read(float* samples, Uint64 maxCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the seek index built by the reader
+    ///
+    /// \param index Array to fill with the index
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getSeekIndex(std::vector<Uint64>& index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Replace the seek index of the reader
+    ///
+    /// \param index Index to use
+    ///
+    /// \return True if the index was accepted
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool setSeekIndex(const std::vector<Uint64>& index);
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Record the current decoding position in the seek index
+    ///
+    ////////////////////////////////////////////////////////////
+    void indexPosition();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode and discard frames
+    ///
+    /// \param frameCount Number of frames to skip
+    ///
+    ////////////////////////////////////////////////////////////
+    void skip(Uint64 frameCount);
+
     ////////////////////////////////////////////////////////////
     /// \brief Close the open Vorbis file
     ///
@@ -112,8 +158,9 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    OggVorbis_File m_vorbis;       // ogg/vorbis file handle
-    unsigned int   m_channelCount; // number of channels of the open sound file
+    OggVorbis_File     m_vorbis;       // ogg/vorbis file handle
+    unsigned int       m_channelCount; // number of channels of the open sound file
+    SoundFileSeekIndex m_index;        // positions of the stream recorded while decoding
 };
 
 } // namespace priv
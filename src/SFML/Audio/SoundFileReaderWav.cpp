@@ -27,6 +27,8 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundFileReaderWav.hpp>
 #include <SFML/System/InputStream.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/MemoryInputStream.hpp>
 #include <SFML/System/Err.hpp>
 #include <algorithm>
 #include <cctype>
@@ -43,17 +45,6 @@ namespace
          return stream.read(&value, sizeof(value)) == sizeof(value);
     }
 
-    bool decode(sf::InputStream& stream, sf::Int16& value)
-    {
-        unsigned char bytes[sizeof(value)];
-        if (stream.read(bytes, sizeof(bytes)) != sizeof(bytes))
-            return false;
-
-        value = bytes[0] | (bytes[1] << 8);
-
-        return true;
-    }
-
     bool decode(sf::InputStream& stream, sf::Uint16& value)
     {
         unsigned char bytes[sizeof(value)];
@@ -65,17 +56,6 @@ namespace
         return true;
     }
 
-    bool decode(sf::InputStream& stream, sf::Int32& value)
-    {
-        unsigned char bytes[sizeof(value)];
-        if (stream.read(bytes, sizeof(bytes)) != sizeof(bytes))
-            return false;
-
-        value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (bytes[3] << 24);
-
-        return true;
-    }
-
     bool decode(sf::InputStream& stream, sf::Uint32& value)
     {
         unsigned char bytes[sizeof(value)];
@@ -88,6 +68,9 @@ namespace
     }
 
     const sf::Uint64 mainChunkSize = 12;
+
+    // Number of bytes read at once from streams that are not in memory
+    const sf::Uint64 blockSize = 16384;
 }
 
 namespace sf
@@ -110,7 +93,11 @@ bool SoundFileReaderWav::check(InputStream& stream)
 SoundFileReaderWav::SoundFileReaderWav() :
 m_stream        (NULL),
 m_bytesPerSample(0),
-m_dataStart     (0)
+m_dataStart     (0),
+m_dataEnd       (0),
+m_position      (0),
+m_memory        (NULL),
+m_buffer        ()
 {
 }
 
@@ -126,6 +113,20 @@ bool SoundFileReaderWav::open(InputStream& stream, Info& info)
         return false;
     }
 
+    // If the whole file is accessible in memory (mapped file or memory
+    // stream), the samples are decoded directly from there
+    m_memory = NULL;
+    if (FileInputStream* file = dynamic_cast<FileInputStream*>(&stream))
+        m_memory = static_cast<const Uint8*>(file->getData());
+    else if (MemoryInputStream* memory = dynamic_cast<MemoryInputStream*>(&stream))
+        m_memory = static_cast<const Uint8*>(memory->getData());
+
+    // The data chunk may be followed by other chunks, or be truncated
+    Int64 size = stream.getSize();
+    if ((size >= 0) && (m_dataEnd > static_cast<Uint64>(size)))
+        m_dataEnd = static_cast<Uint64>(size);
+    m_position = m_dataStart;
+
     return true;
 }
 
@@ -135,7 +136,9 @@ void SoundFileReaderWav::seek(Uint64 sampleOffset)
 {
     assert(m_stream);
 
-    m_stream->seek(m_dataStart + sampleOffset * m_bytesPerSample);
+    m_position = std::min(m_dataStart + sampleOffset * m_bytesPerSample, m_dataEnd);
+    if (!m_memory)
+        m_stream->seek(m_position);
 }
 
 
@@ -145,42 +148,67 @@ Uint64 SoundFileReaderWav::read(Int16* samples, Uint64 maxCount)
     assert(m_stream);
 
     Uint64 count = 0;
-    while (count < maxCount)
+    const Uint8* bytes = NULL;
+    while (std::size_t available = fetch(maxCount - count, bytes))
     {
         switch (m_bytesPerSample)
         {
             case 1:
-            {
-                Uint8 sample = 0;
-                if (decode(*m_stream, sample))
-                    *samples++ = (static_cast<Int16>(sample) - 128) << 8;
-                else
-                    return count;
+                for (std::size_t i = 0; i < available; ++i)
+                    samples[i] = (static_cast<Int16>(bytes[i]) - 128) << 8;
                 break;
-            }
 
             case 2:
-            {
-                Int16 sample = 0;
-                if (decode(*m_stream, sample))
-                    *samples++ = sample;
-                else
-                    return count;
+                for (std::size_t i = 0; i < available; ++i, bytes += 2)
+                    samples[i] = static_cast<Int16>(bytes[0] | (bytes[1] << 8));
                 break;
-            }
 
             case 4:
-            {
-                Int32 sample = 0;
-                if (decode(*m_stream, sample))
-                    *samples++ = sample >> 16;
-                else
-                    return count;
+                for (std::size_t i = 0; i < available; ++i, bytes += 4)
+                    samples[i] = static_cast<Int16>(bytes[2] | (bytes[3] << 8));
+                break;
+        }
+
+        samples += available;
+        count += available;
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderWav::read(float* samples, Uint64 maxCount)
+{
+    assert(m_stream);
+
+    Uint64 count = 0;
+    const Uint8* bytes = NULL;
+    while (std::size_t available = fetch(maxCount - count, bytes))
+    {
+        switch (m_bytesPerSample)
+        {
+            case 1:
+                for (std::size_t i = 0; i < available; ++i)
+                    samples[i] = (static_cast<int>(bytes[i]) - 128) / 128.f;
+                break;
+
+            case 2:
+                for (std::size_t i = 0; i < available; ++i, bytes += 2)
+                    samples[i] = static_cast<Int16>(bytes[0] | (bytes[1] << 8)) / 32768.f;
+                break;
+
+            case 4:
+                for (std::size_t i = 0; i < available; ++i, bytes += 4)
+                {
+                    Int32 sample = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (bytes[3] << 24);
+                    samples[i] = static_cast<float>(sample / 2147483648.0);
+                }
                 break;
-            }
         }
 
-        ++count;
+        samples += available;
+        count += available;
     }
 
     return count;
@@ -264,8 +292,9 @@ bool SoundFileReaderWav::parseHeader(Info& info)
             // Compute the total number of samples
             info.sampleCount = subChunkSize / m_bytesPerSample;
 
-            // Store the starting position of samples in the file
+            // Store the starting and ending positions of samples in the file
             m_dataStart = m_stream->tell();
+            m_dataEnd = m_dataStart + info.sampleCount * m_bytesPerSample;
 
             dataChunkFound = true;
         }
@@ -280,6 +309,34 @@ bool SoundFileReaderWav::parseHeader(Info& info)
     return true;
 }
 
+
+////////////////////////////////////////////////////////////
+std::size_t SoundFileReaderWav::fetch(Uint64 maxCount, const Uint8*& bytes)
+{
+    // Never read past the end of the data chunk
+    Uint64 count = std::min(maxCount, (m_dataEnd - m_position) / m_bytesPerSample);
+
+    if (m_memory)
+    {
+        bytes = m_memory + m_position;
+    }
+    else
+    {
+        // Read a block of bytes, instead of decoding the samples one by one from the stream
+        count = std::min<Uint64>(count, blockSize / m_bytesPerSample);
+        m_buffer.resize(static_cast<std::size_t>(count * m_bytesPerSample));
+        if (count == 0)
+            return 0;
+
+        Int64 read = m_stream->read(&m_buffer[0], static_cast<Int64>(m_buffer.size()));
+        count = (read > 0) ? static_cast<Uint64>(read) / m_bytesPerSample : 0;
+        bytes = &m_buffer[0];
+    }
+
+    m_position += count * m_bytesPerSample;
+    return static_cast<std::size_t>(count);
+}
+
 } // namespace priv
 
 } // namespace sf
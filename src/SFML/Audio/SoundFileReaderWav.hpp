@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundFileReader.hpp>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -93,6 +94,17 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as floats
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 read(float* samples, Uint64 maxCount);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -105,12 +117,30 @@ private:
     ////////////////////////////////////////////////////////////
     bool parseHeader(Info& info);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bytes of the next samples to decode
+    ///
+    /// If the file is in memory, they are accessed directly,
+    /// otherwise they are read as a block from the stream.
+    ///
+    /// \param maxCount Maximum number of samples to get
+    /// \param bytes    Filled with a pointer to the bytes of the samples
+    ///
+    /// \return Number of samples available (0 at the end of the data)
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t fetch(Uint64 maxCount, const Uint8*& bytes);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    InputStream* m_stream;         ///< Source stream to read from
-    unsigned int m_bytesPerSample; ///< Size of a sample, in bytes
-    Uint64       m_dataStart;      ///< Starting position of the audio data in the open file
+    InputStream*       m_stream;         ///< Source stream to read from
+    unsigned int       m_bytesPerSample; ///< Size of a sample, in bytes
+    Uint64             m_dataStart;      ///< Starting position of the audio data in the open file
+    Uint64             m_dataEnd;        ///< End position of the audio data in the open file
+    Uint64             m_position;       ///< Current reading position in the open file
+    const Uint8*       m_memory;         ///< Contents of the file, if it is mapped or loaded in memory
+    std::vector<Uint8> m_buffer;         ///< Block of bytes read from the stream, if it is not in memory
 };
 
 } // namespace priv
@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundFileSeekIndex.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    bool compareFrames(const sf::priv::SoundFileSeekIndex::Point& point, sf::Uint64 frame)
+    {
+        return point.frame < frame;
+    }
+}
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+SoundFileSeekIndex::SoundFileSeekIndex() :
+m_points (),
+m_spacing(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileSeekIndex::setSpacing(Uint64 frameCount)
+{
+    m_spacing = frameCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileSeekIndex::clear()
+{
+    m_points.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileSeekIndex::add(Uint64 frame, Uint64 offset)
+{
+    // Find where the point would be inserted
+    std::vector<Point>::iterator next = std::lower_bound(m_points.begin(), m_points.end(), frame, &compareFrames);
+
+    // Keep the index sparse: reject points too close to their neighbours
+    if ((next != m_points.end()) && ((next->frame == frame) || (next->frame - frame < m_spacing)))
+        return;
+    if ((next != m_points.begin()) && (frame - (next - 1)->frame < m_spacing))
+        return;
+
+    Point point = {frame, offset};
+    m_points.insert(next, point);
+}
+
+
+////////////////////////////////////////////////////////////
+const SoundFileSeekIndex::Point* SoundFileSeekIndex::find(Uint64 frame, std::size_t distance) const
+{
+    // Find the first point after the frame, the one before is the closest
+    std::vector<Point>::const_iterator next = std::lower_bound(m_points.begin(), m_points.end(), frame + 1, &compareFrames);
+    std::size_t available = static_cast<std::size_t>(next - m_points.begin());
+    if (available <= distance)
+        return NULL;
+
+    const Point& point = *(next - distance - 1);
+    if (frame - point.frame > m_spacing * 4)
+        return NULL;
+
+    return &point;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileSeekIndex::save(std::vector<Uint64>& values) const
+{
+    values.resize(m_points.size() * 2);
+    for (std::size_t i = 0; i < m_points.size(); ++i)
+    {
+        values[i * 2]     = m_points[i].frame;
+        values[i * 2 + 1] = m_points[i].offset;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileSeekIndex::load(const std::vector<Uint64>& values)
+{
+    if (values.size() % 2 != 0)
+        return false;
+
+    // Check that the points are sorted before replacing the current ones
+    std::vector<Point> points(values.size() / 2);
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        points[i].frame  = values[i * 2];
+        points[i].offset = values[i * 2 + 1];
+
+        if ((i > 0) && (points[i].frame <= points[i - 1].frame))
+            return false;
+    }
+
+    m_points.swap(points);
+    return true;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SOUNDFILESEEKINDEX_HPP
+#define SFML_SOUNDFILESEEKINDEX_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Table of seek points shared by the compressed readers
+///
+/// A seek point associates the index of a frame (a sample
+/// per channel) with the byte offset in the stream where
+/// decoding can restart and produce this frame, or one
+/// slightly before it. Readers record points as they decode,
+/// so that seeking to an already visited position only
+/// requires a single jump in the stream.
+///
+////////////////////////////////////////////////////////////
+class SoundFileSeekIndex
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief A single entry of the index
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Point
+    {
+        Uint64 frame;  ///< Index of the first frame decoded from this position
+        Uint64 offset; ///< Byte offset of the position in the stream
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundFileSeekIndex();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the minimum distance between two points
+    ///
+    /// \param frameCount Spacing of the points, in frames
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSpacing(Uint64 frameCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the points
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a new point
+    ///
+    /// The point is ignored if another one already exists
+    /// closer than the spacing of the index.
+    ///
+    /// \param frame  Index of the first frame decoded from \a offset
+    /// \param offset Byte offset in the stream
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(Uint64 frame, Uint64 offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find a point located before the given frame
+    ///
+    /// Points further than four times the spacing from the frame
+    /// are ignored: decoding from them would be slower than letting
+    /// the decoder search the stream.
+    ///
+    /// \param frame    Frame to reach
+    /// \param distance Number of points to go back from the closest one,
+    ///                 used to retry when a point overshoots the frame
+    ///
+    /// \return Pointer to the point, or NULL if there's none
+    ///
+    ////////////////////////////////////////////////////////////
+    const Point* find(Uint64 frame, std::size_t distance = 0) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Export the points as a flat array
+    ///
+    /// \param values Array to fill with (frame, offset) pairs
+    ///
+    ////////////////////////////////////////////////////////////
+    void save(std::vector<Uint64>& values) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Replace the points with a flat array
+    ///
+    /// \param values Array of (frame, offset) pairs, sorted by frame
+    ///
+    /// \return True if the array was valid
+    ///
+    ////////////////////////////////////////////////////////////
+    bool load(const std::vector<Uint64>& values);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Point> m_points;  ///< Points of the index, sorted by frame
+    Uint64             m_spacing; ///< Minimum distance between two points, in frames
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDFILESEEKINDEX_HPP
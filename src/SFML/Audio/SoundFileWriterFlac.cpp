@@ -48,9 +48,10 @@ bool SoundFileWriterFlac::check(const std::string& filename)
 
 ////////////////////////////////////////////////////////////
 SoundFileWriterFlac::SoundFileWriterFlac() :
-m_encoder     (NULL),
-m_channelCount(0),
-m_samples32   ()
+m_encoder         (NULL),
+m_channelCount    (0),
+m_samples32       (),
+m_compressionLevel(5)
 {
 }
 
@@ -77,6 +78,7 @@ bool SoundFileWriterFlac::open(const std::string& filename, unsigned int sampleR
     FLAC__stream_encoder_set_channels(m_encoder, channelCount);
     FLAC__stream_encoder_set_bits_per_sample(m_encoder, 16);
     FLAC__stream_encoder_set_sample_rate(m_encoder, sampleRate);
+    FLAC__stream_encoder_set_compression_level(m_encoder, m_compressionLevel);
 
     // Initialize the output stream
     if (FLAC__stream_encoder_init_file(m_encoder, filename.c_str(), NULL, NULL) != FLAC__STREAM_ENCODER_INIT_STATUS_OK)
@@ -114,6 +116,13 @@ void SoundFileWriterFlac::write(const Int16* samples, Uint64 count)
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundFileWriterFlac::setEncodingOptions(float, unsigned int compressionLevel)
+{
+    m_compressionLevel = std::min(compressionLevel, 8u);
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundFileWriterFlac::close()
 {
@@ -90,6 +90,15 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void write(const Int16* samples, Uint64 count);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the encoding options of the next file to open
+    ///
+    /// \param quality          Quality of lossy formats, in range [0 .. 1]
+    /// \param compressionLevel Compression level of lossless formats, in range [0 .. 8]
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setEncodingOptions(float quality, unsigned int compressionLevel);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -101,9 +110,10 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    FLAC__StreamEncoder* m_encoder;      ///< FLAC stream encoder
-    unsigned int         m_channelCount; ///< Number of channels
-    std::vector<Int32>   m_samples32;    ///< Conversion buffer
+    FLAC__StreamEncoder* m_encoder;          ///< FLAC stream encoder
+    unsigned int         m_channelCount;     ///< Number of channels
+    std::vector<Int32>   m_samples32;        ///< Conversion buffer
+    unsigned int         m_compressionLevel; ///< Compression level of the next file to open
 };
 
 } // namespace priv
@@ -53,7 +53,8 @@ m_channelCount(0),
 m_file        (),
 m_ogg         (),
 m_vorbis      (),
-m_state       ()
+m_state       (),
+m_quality     (0.4f)
 {
 }
 
@@ -76,8 +77,8 @@ bool SoundFileWriterOgg::open(const std::string& filename, unsigned int sampleRa
     vorbis_info_init(&m_vorbis);
 
     // Setup the encoder: VBR, automatic bitrate management
-    // Quality is in range [-1 .. 1], 0.4 gives ~128 kbps for a 44 KHz stereo sound
-    int status = vorbis_encode_init_vbr(&m_vorbis, channelCount, sampleRate, 0.4f);
+    // Quality is in range [-0.1 .. 1], 0.4 (the default) gives ~128 kbps for a 44 KHz stereo sound
+    int status = vorbis_encode_init_vbr(&m_vorbis, channelCount, sampleRate, m_quality);
     if (status < 0)
     {
         err() << "Failed to write ogg/vorbis file \"" << filename << "\" (unsupported bitrate)" << std::endl;
@@ -182,6 +183,13 @@ void SoundFileWriterOgg::flushBlocks()
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundFileWriterOgg::setEncodingOptions(float quality, unsigned int)
+{
+    m_quality = std::min(std::max(quality, 0.f), 1.f);
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundFileWriterOgg::close()
 {
@@ -90,6 +90,15 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void write(const Int16* samples, Uint64 count);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the encoding options of the next file to open
+    ///
+    /// \param quality          Quality of lossy formats, in range [0 .. 1]
+    /// \param compressionLevel Compression level of lossless formats, in range [0 .. 8]
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setEncodingOptions(float quality, unsigned int compressionLevel);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -112,6 +121,7 @@ private:
     ogg_stream_state m_ogg;          // ogg stream
     vorbis_info      m_vorbis;       // vorbis handle
     vorbis_dsp_state m_state;        // current encoding state
+    float            m_quality;      // quality of the next file to open
 };
 
 } // namespace priv
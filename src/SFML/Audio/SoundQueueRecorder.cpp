@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundQueueRecorder.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SoundQueueRecorder::SoundQueueRecorder(Time capacity) :
+m_capacity    (capacity),
+m_queue       (),
+m_read        (0),
+m_size        (0),
+m_droppedCount(0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+SoundQueueRecorder::~SoundQueueRecorder()
+{
+    // Make sure the capture thread is done with the queue
+    stop();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundQueueRecorder::read(Int16* samples, std::size_t maxCount)
+{
+    Lock lock(m_mutex);
+
+    // Copy the samples, in two parts if they wrap around the end of the queue
+    std::size_t count = std::min(maxCount, m_size);
+    for (std::size_t left = count; left > 0;)
+    {
+        std::size_t part = std::min(left, m_queue.size() - m_read);
+        std::copy(m_queue.begin() + m_read, m_queue.begin() + m_read + part, samples);
+
+        m_read = (m_read + part) % m_queue.size();
+        samples += part;
+        left -= part;
+    }
+
+    m_size -= count;
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundQueueRecorder::getAvailableSampleCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundQueueRecorder::getDroppedSampleCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_droppedCount;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundQueueRecorder::onStart()
+{
+    Lock lock(m_mutex);
+
+    // Allocate the queue once for the whole capture
+    std::size_t capacity = static_cast<std::size_t>(m_capacity.asMicroseconds() * getSampleRate() / 1000000);
+    m_queue.resize(std::max(capacity, static_cast<std::size_t>(1)));
+    m_read = 0;
+    m_size = 0;
+    m_droppedCount = 0;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundQueueRecorder::onProcessSamples(const Int16* samples, std::size_t sampleCount)
+{
+    Lock lock(m_mutex);
+
+    // Only the most recent samples fit if the chunk is bigger than the queue
+    if (sampleCount > m_queue.size())
+    {
+        m_droppedCount += sampleCount - m_queue.size();
+        samples += sampleCount - m_queue.size();
+        sampleCount = m_queue.size();
+    }
+
+    // Overwrite the oldest samples if there's not enough room
+    std::size_t overflow = std::max(m_size + sampleCount, m_queue.size()) - m_queue.size();
+    m_read = (m_read + overflow) % m_queue.size();
+    m_size -= overflow;
+    m_droppedCount += overflow;
+
+    // Append the samples, in two parts if they wrap around the end of the queue
+    std::size_t write = (m_read + m_size) % m_queue.size();
+    for (std::size_t left = sampleCount; left > 0;)
+    {
+        std::size_t part = std::min(left, m_queue.size() - write);
+        std::copy(samples, samples + part, m_queue.begin() + write);
+
+        write = (write + part) % m_queue.size();
+        samples += part;
+        left -= part;
+    }
+
+    m_size += sampleCount;
+
+    return true;
+}
+
+} // namespace sf
@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundRangeWatcher.hpp>
+#include <SFML/Audio/ALCheck.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <SFML/System/Thread.hpp>
+#include <vector>
+
+
+namespace
+{
+    // Source playing a range, and the range in sample frames
+    struct Entry
+    {
+        ALuint     source;
+        sf::Uint64 begin;
+        sf::Uint64 end;
+        bool       loop;
+    };
+
+    // Interval between two checks of the positions; the sounds of an
+    // atlas are separated by more silence than this, so stopping a bit
+    // late is not audible
+    const sf::Time pollInterval = sf::milliseconds(2);
+
+    std::vector<Entry> entries;
+    bool               running = false;
+    sf::Mutex          mutex; // protects entries and running, held while the sources are checked
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void SoundRangeWatcher::add(unsigned int source, Uint64 begin, Uint64 end, bool loop)
+{
+    Lock lock(mutex);
+
+    Entry entry;
+    entry.source = source;
+    entry.begin  = begin;
+    entry.end    = end;
+    entry.loop   = loop;
+
+    std::vector<Entry>::iterator it = entries.begin();
+    while ((it != entries.end()) && (it->source != source))
+        ++it;
+
+    if (it != entries.end())
+        *it = entry;
+    else
+        entries.push_back(entry);
+
+    // The thread ends when it has nothing left to do
+    // (the lock makes the construction of the thread safe)
+    static Thread thread(&SoundRangeWatcher::run);
+    if (!running)
+    {
+        // Make sure that the previous run is over before launching a new one
+        thread.wait();
+        running = true;
+        thread.launch();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundRangeWatcher::remove(unsigned int source)
+{
+    Lock lock(mutex);
+
+    for (std::vector<Entry>::iterator it = entries.begin(); it != entries.end(); ++it)
+    {
+        if (it->source == source)
+        {
+            entries.erase(it);
+            break;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundRangeWatcher::run()
+{
+    for (;;)
+    {
+        {
+            Lock lock(mutex);
+
+            if (entries.empty())
+            {
+                running = false;
+                return;
+            }
+
+            for (std::size_t i = 0; i < entries.size(); )
+            {
+                Entry& entry = entries[i];
+
+                ALint state = AL_STOPPED;
+                alCheck(alGetSourcei(entry.source, AL_SOURCE_STATE, &state));
+
+                // A stopped source no longer needs to be watched
+                if ((state != AL_PLAYING) && (state != AL_PAUSED))
+                {
+                    entries.erase(entries.begin() + i);
+                    continue;
+                }
+
+                ALint offset = 0;
+                alCheck(alGetSourcei(entry.source, AL_SAMPLE_OFFSET, &offset));
+
+                if (static_cast<Uint64>(offset) >= entry.end)
+                {
+                    if (entry.loop)
+                    {
+                        alCheck(alSourcei(entry.source, AL_SAMPLE_OFFSET, static_cast<ALint>(entry.begin)));
+                    }
+                    else
+                    {
+                        alCheck(alSourceStop(entry.source));
+                        entries.erase(entries.begin() + i);
+                        continue;
+                    }
+                }
+
+                ++i;
+            }
+        }
+
+        sleep(pollInterval);
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
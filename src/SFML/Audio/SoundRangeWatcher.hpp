@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SOUNDRANGEWATCHER_HPP
+#define SFML_SOUNDRANGEWATCHER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Single thread that stops (or loops) the sounds
+///        playing a range of their buffer
+///
+/// OpenAL plays a buffer until its end, so the end of a
+/// range is detected by polling the position of the sources.
+///
+////////////////////////////////////////////////////////////
+class SoundRangeWatcher
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start watching a playing source
+    ///
+    /// The thread is launched if it isn't running. If the
+    /// source is already watched, its range is updated.
+    ///
+    /// \param source OpenAL identifier of the source
+    /// \param begin  First sample frame of the range
+    /// \param end    Sample frame following the range
+    /// \param loop   Must the source go back to the beginning of the range at its end?
+    ///
+    ////////////////////////////////////////////////////////////
+    static void add(unsigned int source, Uint64 begin, Uint64 end, bool loop);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop watching a source
+    ///
+    /// When this function returns, the thread no longer
+    /// accesses \a source.
+    ///
+    /// \param source OpenAL identifier of the source
+    ///
+    ////////////////////////////////////////////////////////////
+    static void remove(unsigned int source);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the thread
+    ///
+    /// The thread ends when no source is left.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void run();
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDRANGEWATCHER_HPP
@@ -28,6 +28,7 @@
 #include <SFML/Audio/SoundRecorder.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Sleep.hpp>
 #include <SFML/System/Err.hpp>
 #include <cstring>
@@ -88,8 +89,10 @@ bool SoundRecorder::start(unsigned int sampleRate)
         return false;
     }
 
-    // Clear the array of samples
+    // Clear the array of samples, and make room for the whole capture buffer of the device
+    // so that processing the captured samples never allocates memory
     m_samples.clear();
+    m_samples.reserve(sampleRate);
 
     // Store the sample rate
     m_sampleRate = sampleRate;
@@ -234,13 +237,18 @@ void SoundRecorder::onStop()
 ////////////////////////////////////////////////////////////
 void SoundRecorder::record()
 {
+    Clock clock;
     while (m_isCapturing)
     {
         // Process available samples
+        clock.restart();
         processCapturedSamples();
 
-        // Don't bother the CPU while waiting for more captured data
-        sleep(m_processingInterval);
+        // Don't bother the CPU while waiting for more captured data: sleep until a
+        // full interval has been captured, the samples arrived during processing count too
+        Time elapsed = clock.getElapsedTime();
+        if (elapsed < m_processingInterval)
+            sleep(m_processingInterval - elapsed);
     }
 
     // Capture is finished: clean up everything
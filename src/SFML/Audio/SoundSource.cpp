@@ -36,6 +36,7 @@ SoundSource::SoundSource()
 {
     alCheck(alGenSources(1, &m_source));
     alCheck(alSourcei(m_source, AL_BUFFER, 0));
+    priv::AudioCounters::addSource(m_source);
 }
 
 
@@ -44,6 +45,7 @@ SoundSource::SoundSource(const SoundSource& copy)
 {
     alCheck(alGenSources(1, &m_source));
     alCheck(alSourcei(m_source, AL_BUFFER, 0));
+    priv::AudioCounters::addSource(m_source);
 
     setPitch(copy.getPitch());
     setVolume(copy.getVolume());
@@ -57,6 +59,7 @@ SoundSource::SoundSource(const SoundSource& copy)
 ////////////////////////////////////////////////////////////
 SoundSource::~SoundSource()
 {
+    priv::AudioCounters::removeSource(m_source);
     alCheck(alSourcei(m_source, AL_BUFFER, 0));
     alCheck(alDeleteSources(1, &m_source));
 }
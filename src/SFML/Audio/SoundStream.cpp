@@ -27,30 +27,48 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundStream.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
+#include <SFML/Audio/SoundStreamScheduler.hpp>
 #include <SFML/Audio/ALCheck.hpp>
-#include <SFML/System/Sleep.hpp>
+#include <SFML/Audio/AudioCounters.hpp>
 #include <SFML/System/Err.hpp>
 #include <SFML/System/Lock.hpp>
+#include <SFML/System/Profiler.hpp>
+#include <algorithm>
 
-#ifdef _MSC_VER
-    #pragma warning(disable: 4355) // 'this' used in base member initializer list
-#endif
+
+namespace
+{
+    // Time without underrun after which an adaptive stream releases a buffer
+    const sf::Time stableDuration = sf::seconds(10);
+}
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 SoundStream::SoundStream() :
-m_thread          (&SoundStream::streamData, this),
 m_threadMutex     (),
 m_threadStartState(Stopped),
 m_isStreaming     (false),
+m_hasBuffers      (false),
+m_requestStop     (false),
+m_buffers         (),
+m_bufferCount     (3),
+m_bufferDuration  (seconds(1)),
+m_adaptive        (false),
+m_stableClock     (),
 m_channelCount    (0),
 m_sampleRate      (0),
 m_format          (0),
+m_floatFormat     (0),
+m_convertedSamples(),
 m_loop            (false),
-m_samplesProcessed(0)
+m_samplesProcessed(0),
+m_queuedSamples   (0),
+m_endBuffers      (),
+m_statistics      ()
 {
+    resetStatistics();
 
 }
 
@@ -66,8 +84,12 @@ SoundStream::~SoundStream()
         m_isStreaming = false;
     }
 
-    // Wait for the thread to terminate
-    m_thread.wait();
+    // Wait for the thread to be done with the stream
+    priv::SoundStreamScheduler::remove(*this);
+
+    // Release the buffers if the thread didn't get a chance to do it
+    if (m_hasBuffers)
+        releaseBuffers();
 }
 
 
@@ -79,6 +101,7 @@ void SoundStream::initialize(unsigned int channelCount, unsigned int sampleRate)
 
     // Deduce the format from the number of channels
     m_format = priv::AudioDevice::getFormatFromChannelCount(channelCount);
+    m_floatFormat = priv::AudioDevice::getFloatFormatFromChannelCount(channelCount);
 
     // Check if the format is valid
     if (m_format == 0)
@@ -117,6 +140,7 @@ void SoundStream::play()
         Lock lock(m_threadMutex);
         m_threadStartState = Playing;
         alCheck(alSourcePlay(m_source));
+        priv::SoundStreamScheduler::notify(*this);
         return;
     }
     else if (isStreaming && (threadStartState == Playing))
@@ -132,7 +156,7 @@ void SoundStream::play()
     m_samplesProcessed = 0;
     m_isStreaming = true;
     m_threadStartState = Playing;
-    m_thread.launch();
+    priv::SoundStreamScheduler::add(*this);
 }
 
 
@@ -162,8 +186,12 @@ void SoundStream::stop()
         m_isStreaming = false;
     }
 
-    // Wait for the thread to terminate
-    m_thread.wait();
+    // Wait for the thread to be done with the stream
+    priv::SoundStreamScheduler::remove(*this);
+
+    // Release the buffers if the thread didn't get a chance to do it
+    if (m_hasBuffers)
+        releaseBuffers();
 
     // Move to the beginning
     onSeek(Time::Zero);
@@ -225,7 +253,7 @@ void SoundStream::setPlayingOffset(Time timeOffset)
 
     m_isStreaming = true;
     m_threadStartState = oldStatus;
-    m_thread.launch();
+    priv::SoundStreamScheduler::add(*this);
 }
 
 
@@ -261,127 +289,277 @@ bool SoundStream::getLoop() const
 
 
 ////////////////////////////////////////////////////////////
-void SoundStream::streamData()
+void SoundStream::setBufferCount(unsigned int count)
 {
-    bool requestStop = false;
+    Lock lock(m_threadMutex);
+    m_bufferCount = std::min(std::max(count, static_cast<unsigned int>(MinBufferCount)), static_cast<unsigned int>(MaxBufferCount));
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundStream::getBufferCount() const
+{
+    Lock lock(m_threadMutex);
+    return m_bufferCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::setBufferDuration(Time duration)
+{
+    Lock lock(m_threadMutex);
+    m_bufferDuration = std::max(duration, milliseconds(1));
+}
+
+
+////////////////////////////////////////////////////////////
+Time SoundStream::getBufferDuration() const
+{
+    Lock lock(m_threadMutex);
+    return m_bufferDuration;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::setAdaptiveBuffering(bool adaptive)
+{
+    Lock lock(m_threadMutex);
+    m_adaptive = adaptive;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundStream::isAdaptiveBuffering() const
+{
+    Lock lock(m_threadMutex);
+    return m_adaptive;
+}
+
+
+////////////////////////////////////////////////////////////
+SoundStream::Statistics SoundStream::getStatistics() const
+{
+    Lock lock(m_threadMutex);
+    return m_statistics;
+}
 
+
+////////////////////////////////////////////////////////////
+void SoundStream::resetStatistics()
+{
+    Lock lock(m_threadMutex);
+    m_statistics.underruns = 0;
+    m_statistics.chunks = 0;
+    m_statistics.decodeTime = Time::Zero;
+    m_statistics.maxDecodeTime = Time::Zero;
+    m_statistics.queuedBuffers = 0;
+    m_statistics.bufferCount = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundStream::streamData(Time& wait)
+{
+    // A paused stream consumes nothing, play() wakes the thread when it resumes
+    wait = seconds(1);
+
+    if (!m_hasBuffers)
     {
-        Lock lock(m_threadMutex);
+        unsigned int bufferCount = 0;
 
-        // Check if the thread was launched Stopped
-        if (m_threadStartState == Stopped)
         {
-            m_isStreaming = false;
-            return;
+            Lock lock(m_threadMutex);
+
+            // Check if the thread was launched Stopped
+            if ((m_threadStartState == Stopped) || !m_isStreaming)
+            {
+                m_isStreaming = false;
+                return false;
+            }
+
+            bufferCount = m_bufferCount;
         }
-    }
 
-    // Create the buffers
-    alCheck(alGenBuffers(BufferCount, m_buffers));
-    for (int i = 0; i < BufferCount; ++i)
-        m_endBuffers[i] = false;
+        // Create the buffers
+        m_buffers.resize(bufferCount);
+        m_endBuffers.assign(bufferCount, false);
+        alCheck(alGenBuffers(static_cast<ALsizei>(bufferCount), &m_buffers[0]));
+        m_hasBuffers = true;
+        priv::AudioCounters::countStream(true);
+        m_queuedSamples = 0;
+        m_stableClock.restart();
 
-    // Fill the queue
-    requestStop = fillQueue();
+        // Fill the queue
+        m_requestStop = fillQueue();
 
-    // Play the sound
-    alCheck(alSourcePlay(m_source));
+        // Play the sound
+        alCheck(alSourcePlay(m_source));
 
-    {
-        Lock lock(m_threadMutex);
+        {
+            Lock lock(m_threadMutex);
 
-        // Check if the thread was launched Paused
-        if (m_threadStartState == Paused)
-            alCheck(alSourcePause(m_source));
+            // Check if the thread was launched Paused
+            if (m_threadStartState == Paused)
+                alCheck(alSourcePause(m_source));
+        }
     }
 
-    for (;;)
+    bool adaptive = false;
+    unsigned int bufferCount = 0;
+
     {
+        Lock lock(m_threadMutex);
+        if (!m_isStreaming)
         {
-            Lock lock(m_threadMutex);
-            if (!m_isStreaming)
-                break;
+            releaseBuffers();
+            return false;
         }
 
-        // The stream has been interrupted!
-        if (SoundSource::getStatus() == Stopped)
+        adaptive = m_adaptive;
+        bufferCount = m_bufferCount;
+    }
+
+    // Release a buffer if the stream has been stable for a while
+    bool shrink = adaptive && (m_buffers.size() > bufferCount) && (m_stableClock.getElapsedTime() >= stableDuration);
+
+    // The stream has been interrupted!
+    if (SoundSource::getStatus() == Stopped)
+    {
+        if (!m_requestStop)
         {
-            if (!requestStop)
+            // Count the underrun
             {
-                // Just continue
-                alCheck(alSourcePlay(m_source));
+                Lock lock(m_threadMutex);
+                m_statistics.underruns++;
             }
-            else
+            priv::AudioCounters::countUnderrun();
+
+            // The queue ran dry: make it longer if allowed
+            if (adaptive && (m_buffers.size() < MaxBufferCount))
+                growQueue();
+
+            m_stableClock.restart();
+            shrink = false;
+
+            // Just continue
+            alCheck(alSourcePlay(m_source));
+        }
+        else
+        {
+            // End streaming
             {
-                // End streaming
                 Lock lock(m_threadMutex);
                 m_isStreaming = false;
             }
+
+            releaseBuffers();
+            return false;
         }
+    }
 
-        // Get the number of buffers that have been processed (i.e. ready for reuse)
-        ALint nbProcessed = 0;
-        alCheck(alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &nbProcessed));
+    // Get the number of buffers that have been processed (i.e. ready for reuse)
+    ALint nbProcessed = 0;
+    alCheck(alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &nbProcessed));
 
-        while (nbProcessed--)
-        {
-            // Pop the first unused buffer from the queue
-            ALuint buffer;
-            alCheck(alSourceUnqueueBuffers(m_source, 1, &buffer));
-
-            // Find its number
-            unsigned int bufferNum = 0;
-            for (int i = 0; i < BufferCount; ++i)
-                if (m_buffers[i] == buffer)
-                {
-                    bufferNum = i;
-                    break;
-                }
-
-            // Retrieve its size and add it to the samples count
-            if (m_endBuffers[bufferNum])
-            {
-                // This was the last buffer: reset the sample count
-                m_samplesProcessed = 0;
-                m_endBuffers[bufferNum] = false;
-            }
-            else
+    while (nbProcessed--)
+    {
+        // Pop the first unused buffer from the queue
+        ALuint buffer;
+        alCheck(alSourceUnqueueBuffers(m_source, 1, &buffer));
+
+        // Find its number
+        unsigned int bufferNum = 0;
+        for (std::size_t i = 0; i < m_buffers.size(); ++i)
+            if (m_buffers[i] == buffer)
             {
-                ALint size, bits;
-                alCheck(alGetBufferi(buffer, AL_SIZE, &size));
-                alCheck(alGetBufferi(buffer, AL_BITS, &bits));
-
-                // Bits can be 0 if the format or parameters are corrupt, avoid division by zero
-                if (bits == 0)
-                {
-                    err() << "Bits in sound stream are 0: make sure that the audio format is not corrupt "
-                          << "and initialize() has been called correctly" << std::endl;
-
-                    // Abort streaming (exit main loop)
-                    Lock lock(m_threadMutex);
-                    m_isStreaming = false;
-                    requestStop = true;
-                    break;
-                }
-                else
-                {
-                    m_samplesProcessed += size / (bits / 8);
-                }
+                bufferNum = i;
+                break;
             }
 
-            // Fill it and push it back into the playing queue
-            if (!requestStop)
+        ALint size, bits;
+        alCheck(alGetBufferi(buffer, AL_SIZE, &size));
+        alCheck(alGetBufferi(buffer, AL_BITS, &bits));
+
+        // Bits can be 0 if the format or parameters are corrupt, avoid division by zero
+        if (bits == 0)
+        {
+            err() << "Bits in sound stream are 0: make sure that the audio format is not corrupt "
+                  << "and initialize() has been called correctly" << std::endl;
+
+            // Abort streaming
             {
-                if (fillAndPushBuffer(bufferNum))
-                    requestStop = true;
+                Lock lock(m_threadMutex);
+                m_isStreaming = false;
             }
+
+            releaseBuffers();
+            return false;
         }
 
-        // Leave some time for the other threads if the stream is still playing
-        if (SoundSource::getStatus() != Stopped)
-            sleep(milliseconds(10));
+        Uint64 sampleCount = size / (bits / 8);
+        m_queuedSamples -= std::min(m_queuedSamples, sampleCount);
+
+        // Retrieve its size and add it to the samples count
+        if (m_endBuffers[bufferNum])
+        {
+            // This was the last buffer: reset the sample count
+            m_samplesProcessed = 0;
+            m_endBuffers[bufferNum] = false;
+        }
+        else
+        {
+            m_samplesProcessed += sampleCount;
+        }
+
+        if (shrink)
+        {
+            // Delete the buffer instead of pushing it back
+            alCheck(alDeleteBuffers(1, &buffer));
+            m_buffers.erase(m_buffers.begin() + bufferNum);
+            m_endBuffers.erase(m_endBuffers.begin() + bufferNum);
+            m_stableClock.restart();
+            shrink = false;
+            continue;
+        }
+
+        // Fill it and push it back into the playing queue
+        if (!m_requestStop)
+        {
+            if (fillAndPushBuffer(bufferNum))
+                m_requestStop = true;
+        }
+    }
+
+    // If the stream is playing, it doesn't need data before the first queued buffer is consumed
+    // (OpenAL implementations supporting AL_SOFT_events also notify the thread when it happens)
+    ALint nbQueued = 0;
+    alCheck(alGetSourcei(m_source, AL_BUFFERS_QUEUED, &nbQueued));
+
+    {
+        Lock lock(m_threadMutex);
+        m_statistics.queuedBuffers = static_cast<unsigned int>(nbQueued);
+        m_statistics.bufferCount = static_cast<unsigned int>(m_buffers.size());
     }
 
+    if ((nbQueued > 0) && (SoundSource::getStatus() == Playing))
+    {
+        ALint offset = 0;
+        alCheck(alGetSourcei(m_source, AL_SAMPLE_OFFSET, &offset));
+
+        Int64 frames = static_cast<Int64>(m_queuedSamples / m_channelCount / nbQueued) - offset;
+        if (frames > 0)
+            wait = std::min(wait, microseconds(frames * 1000000 / m_sampleRate));
+        else
+            wait = Time::Zero;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::releaseBuffers()
+{
     // Stop the playback
     alCheck(alSourceStop(m_source));
 
@@ -390,18 +568,58 @@ void SoundStream::streamData()
 
     // Delete the buffers
     alCheck(alSourcei(m_source, AL_BUFFER, 0));
-    alCheck(alDeleteBuffers(BufferCount, m_buffers));
+    alCheck(alDeleteBuffers(static_cast<ALsizei>(m_buffers.size()), &m_buffers[0]));
+    m_buffers.clear();
+    m_endBuffers.clear();
+
+    m_hasBuffers = false;
+    m_queuedSamples = 0;
+    priv::AudioCounters::countStream(false);
+
+    {
+        Lock lock(m_threadMutex);
+        m_statistics.queuedBuffers = 0;
+        m_statistics.bufferCount = 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::growQueue()
+{
+    ALuint buffer = 0;
+    alCheck(alGenBuffers(1, &buffer));
+
+    m_buffers.push_back(buffer);
+    m_endBuffers.push_back(false);
+
+    if (fillAndPushBuffer(static_cast<unsigned int>(m_buffers.size() - 1)))
+        m_requestStop = true;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool SoundStream::fillAndPushBuffer(unsigned int bufferNum)
 {
+    SFML_PROFILE_ZONE("SoundStream::fillAndPushBuffer");
+
     bool requestStop = false;
 
-    // Acquire audio data
-    Chunk data = {NULL, 0};
-    if (!onGetData(data))
+    // Acquire audio data, measuring how long the derived class takes to produce it
+    Chunk data = {NULL, 0, NULL};
+    Clock clock;
+    bool hasMoreData = onGetData(data);
+    Time decodeTime = clock.getElapsedTime();
+
+    {
+        Lock lock(m_threadMutex);
+        m_statistics.chunks++;
+        m_statistics.decodeTime += decodeTime;
+        m_statistics.maxDecodeTime = std::max(m_statistics.maxDecodeTime, decodeTime);
+    }
+    priv::AudioCounters::countChunk(decodeTime);
+
+    if (!hasMoreData)
     {
         // Mark the buffer as the last one (so that we know when to reset the playing position)
         m_endBuffers[bufferNum] = true;
@@ -413,7 +631,7 @@ bool SoundStream::fillAndPushBuffer(unsigned int bufferNum)
             onSeek(Time::Zero);
 
             // If we previously had no data, try to fill the buffer once again
-            if (!data.samples || (data.sampleCount == 0))
+            if ((!data.samples && !data.floatSamples) || (data.sampleCount == 0))
             {
                 return fillAndPushBuffer(bufferNum);
             }
@@ -426,16 +644,35 @@ bool SoundStream::fillAndPushBuffer(unsigned int bufferNum)
     }
 
     // Fill the buffer if some data was returned
-    if (data.samples && data.sampleCount)
+    if ((data.samples || data.floatSamples) && data.sampleCount)
     {
         unsigned int buffer = m_buffers[bufferNum];
 
         // Fill the buffer
-        ALsizei size = static_cast<ALsizei>(data.sampleCount) * sizeof(Int16);
-        alCheck(alBufferData(buffer, m_format, data.samples, size, m_sampleRate));
+        if (data.floatSamples && m_floatFormat)
+        {
+            ALsizei size = static_cast<ALsizei>(data.sampleCount) * sizeof(float);
+            alCheck(alBufferData(buffer, m_floatFormat, data.floatSamples, size, m_sampleRate));
+        }
+        else if (data.floatSamples)
+        {
+            // The implementation can't play floats: convert them
+            m_convertedSamples.resize(data.sampleCount);
+            for (std::size_t i = 0; i < data.sampleCount; ++i)
+                m_convertedSamples[i] = static_cast<Int16>(std::min(std::max(data.floatSamples[i], -1.f), 1.f) * 32767.f);
+
+            ALsizei size = static_cast<ALsizei>(data.sampleCount) * sizeof(Int16);
+            alCheck(alBufferData(buffer, m_format, &m_convertedSamples[0], size, m_sampleRate));
+        }
+        else
+        {
+            ALsizei size = static_cast<ALsizei>(data.sampleCount) * sizeof(Int16);
+            alCheck(alBufferData(buffer, m_format, data.samples, size, m_sampleRate));
+        }
 
         // Push it into the sound queue
         alCheck(alSourceQueueBuffers(m_source, 1, &buffer));
+        m_queuedSamples += data.sampleCount;
     }
 
     return requestStop;
@@ -447,9 +684,9 @@ bool SoundStream::fillQueue()
 {
     // Fill and enqueue all the available buffers
     bool requestStop = false;
-    for (int i = 0; (i < BufferCount) && !requestStop; ++i)
+    for (std::size_t i = 0; (i < m_buffers.size()) && !requestStop; ++i)
     {
-        if (fillAndPushBuffer(i))
+        if (fillAndPushBuffer(static_cast<unsigned int>(i)))
             requestStop = true;
     }
 
@@ -0,0 +1,274 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundStreamScheduler.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/Audio/ALCheck.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Signal.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+#include <vector>
+
+// AL_SOFT_events is not declared by all the OpenAL headers, its functions are loaded at runtime
+#ifndef AL_SOFT_events
+    #define AL_EVENT_TYPE_BUFFER_COMPLETED_SOFT     0x19A4
+    #define AL_EVENT_TYPE_SOURCE_STATE_CHANGED_SOFT 0x19A5
+    typedef void (AL_APIENTRY *ALEVENTPROCSOFT)(ALenum, ALuint, ALuint, ALsizei, const ALchar*, void*);
+    typedef void (AL_APIENTRY *LPALEVENTCONTROLSOFT)(ALsizei, const ALenum*, ALboolean);
+    typedef void (AL_APIENTRY *LPALEVENTCALLBACKSOFT)(ALEVENTPROCSOFT, void*);
+#endif
+
+
+namespace
+{
+    // Stream serviced by the thread, with the time at which it needs data again
+    struct Entry
+    {
+        sf::SoundStream* stream;
+        sf::Time         deadline;
+    };
+
+    bool compareDeadlines(const Entry& left, const Entry& right)
+    {
+        return left.deadline < right.deadline;
+    }
+
+    // Without any notification, the streams are still checked this often
+    const sf::Time maxWait = sf::seconds(1);
+
+    std::vector<Entry> entries;
+    sf::Clock          schedulerClock;
+    bool               running = false;
+    sf::Mutex          entriesMutex; // protects entries and running
+    sf::Mutex          serviceMutex; // held while the thread services streams
+    sf::Signal         wakeup;       // wakes the thread up before its next deadline
+
+    // Service the stream owning a source as soon as possible
+    void scheduleSource(ALuint source)
+    {
+        sf::Lock lock(entriesMutex);
+
+        for (std::vector<Entry>::iterator it = entries.begin(); it != entries.end(); ++it)
+        {
+            if (sf::priv::SoundStreamScheduler::getSource(*it->stream) == source)
+            {
+                it->deadline = sf::Time::Zero;
+                wakeup.notify();
+                break;
+            }
+        }
+    }
+
+    // Called by OpenAL Soft from its own thread when a buffer is consumed or a source stops
+    void AL_APIENTRY eventCallback(ALenum eventType, ALuint object, ALuint, ALsizei, const ALchar*, void*)
+    {
+        if ((eventType == AL_EVENT_TYPE_BUFFER_COMPLETED_SOFT) || (eventType == AL_EVENT_TYPE_SOURCE_STATE_CHANGED_SOFT))
+            scheduleSource(object);
+    }
+
+    // Ask the implementation to notify us of buffer completions, if it can
+    void enableEvents()
+    {
+        if (!alIsExtensionPresent("AL_SOFT_events"))
+            return;
+
+        LPALEVENTCONTROLSOFT  eventControl  = reinterpret_cast<LPALEVENTCONTROLSOFT>(alGetProcAddress("alEventControlSOFT"));
+        LPALEVENTCALLBACKSOFT eventCallback = reinterpret_cast<LPALEVENTCALLBACKSOFT>(alGetProcAddress("alEventCallbackSOFT"));
+        if (!eventControl || !eventCallback)
+            return;
+
+        const ALenum types[] = {AL_EVENT_TYPE_BUFFER_COMPLETED_SOFT, AL_EVENT_TYPE_SOURCE_STATE_CHANGED_SOFT};
+        alCheck(eventCallback(&::eventCallback, NULL));
+        alCheck(eventControl(2, types, AL_TRUE));
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::add(SoundStream& stream)
+{
+    Lock lock(entriesMutex);
+
+    // Service the stream as soon as possible
+    Entry entry;
+    entry.stream   = &stream;
+    entry.deadline = Time::Zero;
+    entries.push_back(entry);
+
+    // The thread ends when it has nothing left to do
+    // (the lock makes the construction of the thread safe)
+    static Thread thread(&SoundStreamScheduler::run);
+    if (!running)
+    {
+        running = true;
+        thread.launch();
+    }
+    else
+    {
+        wakeup.notify();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::notify(SoundStream& stream)
+{
+    Lock lock(entriesMutex);
+
+    for (std::vector<Entry>::iterator it = entries.begin(); it != entries.end(); ++it)
+    {
+        if (it->stream == &stream)
+        {
+            it->deadline = Time::Zero;
+            wakeup.notify();
+            break;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::remove(SoundStream& stream)
+{
+    {
+        Lock lock(entriesMutex);
+
+        for (std::vector<Entry>::iterator it = entries.begin(); it != entries.end(); ++it)
+        {
+            if (it->stream == &stream)
+            {
+                entries.erase(it);
+                break;
+            }
+        }
+    }
+
+    // Wait until the thread is done with the stream, if it is servicing it
+    Lock lock(serviceMutex);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundStreamScheduler::getSource(const SoundStream& stream)
+{
+    return stream.m_source;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::run()
+{
+    // Don't hold any lock here: the callback locks the list of entries
+    enableEvents();
+
+    for (;;)
+    {
+        Time wait = maxWait;
+
+        {
+            Lock serviceLock(serviceMutex);
+
+            // Take the streams whose deadline is reached, the most urgent first
+            std::vector<Entry> due;
+            {
+                Lock lock(entriesMutex);
+
+                if (entries.empty())
+                {
+                    running = false;
+                    return;
+                }
+
+                Time now = schedulerClock.getElapsedTime();
+                for (std::vector<Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+                {
+                    if (it->deadline <= now)
+                        due.push_back(*it);
+                    else
+                        wait = std::min(wait, it->deadline - now);
+                }
+            }
+            std::sort(due.begin(), due.end(), compareDeadlines);
+
+            for (std::vector<Entry>::const_iterator it = due.begin(); it != due.end(); ++it)
+            {
+                // Streams removed in the meantime are waiting for the service lock,
+                // they must not be touched anymore
+                std::vector<Entry>::iterator entry;
+                {
+                    Lock lock(entriesMutex);
+
+                    entry = entries.begin();
+                    while ((entry != entries.end()) && (entry->stream != it->stream))
+                        ++entry;
+
+                    if (entry == entries.end())
+                        continue;
+                }
+
+                Time next;
+                bool streaming = it->stream->streamData(next);
+
+                Lock lock(entriesMutex);
+
+                // Only the thread removes entries while holding the service lock, so
+                // the search can't be invalidated... but additions can reallocate
+                entry = entries.begin();
+                while ((entry != entries.end()) && (entry->stream != it->stream))
+                    ++entry;
+
+                if (entry == entries.end())
+                    continue;
+
+                if (streaming)
+                {
+                    entry->deadline = schedulerClock.getElapsedTime() + next;
+                    wait = std::min(wait, next);
+                }
+                else
+                {
+                    entries.erase(entry);
+                }
+            }
+        }
+
+        // Sleep until the next deadline, unless a stream needs attention before
+        if (wait > Time::Zero)
+            wakeup.wait(wait);
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SOUNDSTREAMSCHEDULER_HPP
+#define SFML_SOUNDSTREAMSCHEDULER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+class SoundStream;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Single thread that streams the data of all the
+///        playing sound streams
+///
+////////////////////////////////////////////////////////////
+class SoundStreamScheduler
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start streaming the data of a sound stream
+    ///
+    /// The streaming thread is launched if it isn't running.
+    /// The stream is serviced until it is removed, or until
+    /// it reports that streaming is over.
+    ///
+    /// \param stream Stream to service
+    ///
+    ////////////////////////////////////////////////////////////
+    static void add(SoundStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop streaming the data of a sound stream
+    ///
+    /// When this function returns, the streaming thread no
+    /// longer accesses \a stream.
+    ///
+    /// \param stream Stream to stop servicing
+    ///
+    ////////////////////////////////////////////////////////////
+    static void remove(SoundStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Service a sound stream as soon as possible
+    ///
+    /// This function wakes the streaming thread, so that a
+    /// stream that changed state doesn't wait for its deadline.
+    ///
+    /// \param stream Stream to service
+    ///
+    ////////////////////////////////////////////////////////////
+    static void notify(SoundStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the OpenAL source of a sound stream
+    ///
+    /// \param stream Stream to query
+    ///
+    /// \return OpenAL identifier of the source of the stream
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getSource(const SoundStream& stream);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the streaming thread
+    ///
+    /// The thread services the streams in the order of their
+    /// deadlines, and ends when no stream is left.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void run();
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDSTREAMSCHEDULER_HPP
@@ -0,0 +1,428 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/VirtualSound.hpp>
+#include <SFML/Audio/VoiceManager.hpp>
+#include <SFML/Audio/Listener.hpp>
+#include <SFML/Audio/Sound.hpp>
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+VirtualSound::VirtualSound(VoiceManager& manager) :
+m_manager    (manager),
+m_buffer     (NULL),
+m_voice      (NULL),
+m_status     (SoundSource::Stopped),
+m_offset     (),
+m_clock      (),
+m_loop       (false),
+m_priority   (0),
+m_pitch      (1.f),
+m_volume     (100.f),
+m_position   (0.f, 0.f, 0.f),
+m_relative   (false),
+m_minDistance(1.f),
+m_attenuation(1.f),
+m_maxDistance(std::numeric_limits<float>::max())
+{
+    m_manager.addSound(this);
+}
+
+
+////////////////////////////////////////////////////////////
+VirtualSound::VirtualSound(VoiceManager& manager, const SoundBuffer& buffer) :
+m_manager    (manager),
+m_buffer     (&buffer),
+m_voice      (NULL),
+m_status     (SoundSource::Stopped),
+m_offset     (),
+m_clock      (),
+m_loop       (false),
+m_priority   (0),
+m_pitch      (1.f),
+m_volume     (100.f),
+m_position   (0.f, 0.f, 0.f),
+m_relative   (false),
+m_minDistance(1.f),
+m_attenuation(1.f),
+m_maxDistance(std::numeric_limits<float>::max())
+{
+    m_manager.addSound(this);
+}
+
+
+////////////////////////////////////////////////////////////
+VirtualSound::~VirtualSound()
+{
+    stop();
+    m_manager.removeSound(this);
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualSound::play()
+{
+    if (!m_buffer)
+        return;
+
+    // Like sf::Sound, playing a sound that is already playing restarts it
+    if (getStatus() != SoundSource::Paused)
+        stop();
+
+    m_status = SoundSource::Playing;
+    m_clock.restart();
+
+    if (m_voice)
+    {
+        m_voice->play();
+    }
+    else
+    {
+        // Start right away if a source is free and the sound is audible, otherwise wait for the next update
+        Sound* voice = m_manager.isAudible(getAudibility()) ? m_manager.acquireVoice() : NULL;
+        if (voice)
+            attachVoice(*voice);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualSound::pause()
+{
+    if (getStatus() != SoundSource::Playing)
+        return;
+
+    m_offset = getPlayingOffset();
+    m_status = SoundSource::Paused;
+
+    if (m_voice)
+        m_voice->pause();
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualSound::stop()
+{
+    m_status = SoundSource::Stopped;
+    m_offset = Time::Zero;
+
+    if (m_voice)
+    {
+        m_voice->stop();
+        m_voice->resetBuffer();
+        m_manager.releaseVoice(m_voice);
+        m_voice = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualSound::setBuffer(const SoundBuffer& buffer)
+{
+    stop();
+    m_buffer = &buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+const SoundBuffer* VirtualSound::getBuffer() const
+{
+    return m_buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualSound::setLoop(bool loop)
+{
+    m_loop = loop;
+    if (m_voice)
+        m_voice->setLoop(loop);
+}
+
+
+////////////////////////////////////////////////////////////
+bool VirtualSound::getLoop() const
+{
+    return m_loop;
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualSound::setPlayingOffset(Time timeOffset)
+{
+    m_offset = timeOffset;
+    m_clock.restart();
+
+    if (m_voice)
+        m_voice->setPlayingOffset(timeOffset);
+}
+
+
+////////////////////////////////////////////////////////////
+Time VirtualSound::getPlayingOffset() const
+{
+    if (m_voice)
+        return m_voice->getPlayingOffset();
+
+    if ((m_status != SoundSource::Playing) || !m_buffer)
+        return m_offset;
+
+    // Advance the position as if the sound was really playing
+    Time offset = m_offset + m_clock.getElapsedTime() * m_pitch;
+    Time duration = m_buffer->getDuration();
+
+    if (duration == Time::Zero)
+        return Time::Zero;
+    else if (m_loop)
+        return microseconds(offset.asMicroseconds() % duration.asMicroseconds());
+    else
+        return std::min(offset, duration);
+}
+
+
+////////////////////////////////////////////////////////////
+SoundSource::Status VirtualSound::getStatus() const
+{
+    if (m_status == SoundSource::Playing)
+    {
+        // Check whether the sound reached its end
+        if (m_voice)
+        {
+            if (m_voice->getStatus() == SoundSource::Stopped)
+                return SoundSource::Stopped;
+        }
+        else if (!m_loop && m_buffer && (getPlayingOffset() >= m_buffer->getDuration()))
+        {
+            return SoundSource::Stopped;
+        }
+    }
+
+    return m_status;
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualSound::setPriority(int priority)
+{
+    m_priority = priority;
+}
+
+
+////////////////////////////////////////////////////////////
+int VirtualSound::getPriority() const
+{
+    return m_priority;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VirtualSound::isVirtual() const
+{
+    return m_voice == NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualSound::setPitch(float pitch)
+{
+    // The virtual position advances with the pitch: restart its computation from now
+    if ((m_status == SoundSource::Playing) && !m_voice)
+    {
+        m_offset = getPlayingOffset();
+        m_clock.restart();
+    }
+
+    m_pitch = pitch;
+    if (m_voice)
+        m_voice->setPitch(pitch);
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualSound::setVolume(float volume)
+{
+    m_volume = volume;
+    if (m_voice)
+        m_voice->setVolume(volume);
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualSound::setPosition(const Vector3f& position)
+{
+    m_position = position;
+    if (m_voice)
+        m_voice->setPosition(position);
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualSound::setRelativeToListener(bool relative)
+{
+    m_relative = relative;
+    if (m_voice)
+        m_voice->setRelativeToListener(relative);
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualSound::setMinDistance(float distance)
+{
+    m_minDistance = distance;
+    if (m_voice)
+        m_voice->setMinDistance(distance);
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualSound::setAttenuation(float attenuation)
+{
+    m_attenuation = attenuation;
+    if (m_voice)
+        m_voice->setAttenuation(attenuation);
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualSound::setMaxDistance(float distance)
+{
+    m_maxDistance = distance;
+}
+
+
+////////////////////////////////////////////////////////////
+float VirtualSound::getPitch() const
+{
+    return m_pitch;
+}
+
+
+////////////////////////////////////////////////////////////
+float VirtualSound::getVolume() const
+{
+    return m_volume;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector3f VirtualSound::getPosition() const
+{
+    return m_position;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VirtualSound::isRelativeToListener() const
+{
+    return m_relative;
+}
+
+
+////////////////////////////////////////////////////////////
+float VirtualSound::getMinDistance() const
+{
+    return m_minDistance;
+}
+
+
+////////////////////////////////////////////////////////////
+float VirtualSound::getAttenuation() const
+{
+    return m_attenuation;
+}
+
+
+////////////////////////////////////////////////////////////
+float VirtualSound::getMaxDistance() const
+{
+    return m_maxDistance;
+}
+
+
+////////////////////////////////////////////////////////////
+float VirtualSound::getAudibility() const
+{
+    Vector3f delta = m_relative ? m_position : m_position - Listener::getPosition();
+    float distanceSquared = delta.x * delta.x + delta.y * delta.y + delta.z * delta.z;
+
+    // Culled by distance; the square of an infinite maximum distance is infinite too
+    if (distanceSquared > m_maxDistance * m_maxDistance)
+        return 0.f;
+
+    float distance = std::sqrt(distanceSquared);
+
+    // Same model as OpenAL's default distance model (inverse distance, clamped)
+    distance = std::max(distance, m_minDistance);
+    float denominator = m_minDistance + m_attenuation * (distance - m_minDistance);
+    float gain = (denominator > 0.f) ? m_minDistance / denominator : 1.f;
+
+    return m_volume / 100.f * gain;
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualSound::attachVoice(Sound& voice)
+{
+    Time offset = getPlayingOffset();
+
+    voice.setBuffer(*m_buffer);
+    voice.setLoop(m_loop);
+    voice.setPitch(m_pitch);
+    voice.setVolume(m_volume);
+    voice.setPosition(m_position);
+    voice.setRelativeToListener(m_relative);
+    voice.setMinDistance(m_minDistance);
+    voice.setAttenuation(m_attenuation);
+
+    voice.play();
+    voice.setPlayingOffset(offset);
+    if (m_status == SoundSource::Paused)
+        voice.pause();
+
+    m_voice = &voice;
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualSound::detachVoice()
+{
+    m_offset = m_voice->getPlayingOffset();
+    m_clock.restart();
+
+    m_voice->stop();
+    m_voice->resetBuffer();
+    m_manager.releaseVoice(m_voice);
+    m_voice = NULL;
+}
+
+} // namespace sf
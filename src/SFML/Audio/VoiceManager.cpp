@@ -0,0 +1,225 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/VoiceManager.hpp>
+#include <SFML/Audio/VirtualSound.hpp>
+#include <SFML/Audio/Sound.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Playing sound competing for an audio source
+    struct Candidate
+    {
+        sf::VirtualSound* sound;
+        int               priority;
+        float             audibility;
+    };
+
+    bool compareCandidates(const Candidate& left, const Candidate& right)
+    {
+        if (left.priority != right.priority)
+            return left.priority > right.priority;
+
+        return left.audibility > right.audibility;
+    }
+
+    // Advantage given to the sounds that already have a source, so that sounds
+    // of similar loudness don't exchange their sources on every update
+    const float hysteresis = 1.1f;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+VoiceManager::VoiceManager(std::size_t voiceCount) :
+m_voices    (),
+m_freeVoices(),
+m_sounds    (),
+m_threshold (0.f),
+m_culled    (0)
+{
+    m_voices.resize(voiceCount);
+    for (std::size_t i = 0; i < voiceCount; ++i)
+        m_voices[i] = new Sound;
+
+    m_freeVoices = m_voices;
+}
+
+
+////////////////////////////////////////////////////////////
+VoiceManager::~VoiceManager()
+{
+    for (std::size_t i = 0; i < m_voices.size(); ++i)
+        delete m_voices[i];
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::update()
+{
+    std::vector<Candidate> candidates;
+    candidates.reserve(m_sounds.size());
+    m_culled = 0;
+
+    for (std::vector<VirtualSound*>::iterator it = m_sounds.begin(); it != m_sounds.end(); ++it)
+    {
+        VirtualSound* sound = *it;
+        SoundSource::Status status = sound->getStatus();
+
+        // Sounds that reached their end are stopped for good
+        if ((status == SoundSource::Stopped) && (sound->m_status != SoundSource::Stopped))
+            sound->stop();
+
+        if (status == SoundSource::Playing)
+        {
+            Candidate candidate;
+            candidate.sound      = sound;
+            candidate.priority   = sound->getPriority();
+            candidate.audibility = sound->getAudibility() * (sound->m_voice ? hysteresis : 1.f);
+
+            if (isAudible(candidate.audibility))
+            {
+                candidates.push_back(candidate);
+            }
+            else
+            {
+                // Inaudible sounds don't compete for a source, even a free one
+                if (sound->m_voice)
+                    sound->detachVoice();
+                ++m_culled;
+            }
+        }
+        else if ((status == SoundSource::Paused) && sound->m_voice)
+        {
+            // Paused sounds don't need their source
+            sound->detachVoice();
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), compareCandidates);
+
+    // Take the sources of the sounds that are not audible enough...
+    std::size_t count = std::min(candidates.size(), m_voices.size());
+    for (std::size_t i = count; i < candidates.size(); ++i)
+    {
+        if (candidates[i].sound->m_voice)
+            candidates[i].sound->detachVoice();
+    }
+
+    // ... and give them to the most audible ones
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (!candidates[i].sound->m_voice)
+        {
+            Sound* voice = acquireVoice();
+            if (voice)
+                candidates[i].sound->attachVoice(*voice);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::setAudibilityThreshold(float threshold)
+{
+    m_threshold = threshold;
+}
+
+
+////////////////////////////////////////////////////////////
+float VoiceManager::getAudibilityThreshold() const
+{
+    return m_threshold;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VoiceManager::getVoiceCount() const
+{
+    return m_voices.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VoiceManager::getActiveVoiceCount() const
+{
+    return m_voices.size() - m_freeVoices.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VoiceManager::getCulledSoundCount() const
+{
+    return m_culled;
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::addSound(VirtualSound* sound)
+{
+    m_sounds.push_back(sound);
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::removeSound(VirtualSound* sound)
+{
+    m_sounds.erase(std::remove(m_sounds.begin(), m_sounds.end(), sound), m_sounds.end());
+}
+
+
+////////////////////////////////////////////////////////////
+Sound* VoiceManager::acquireVoice()
+{
+    if (m_freeVoices.empty())
+        return NULL;
+
+    Sound* voice = m_freeVoices.back();
+    m_freeVoices.pop_back();
+
+    return voice;
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::releaseVoice(Sound* voice)
+{
+    m_freeVoices.push_back(voice);
+}
+
+
+////////////////////////////////////////////////////////////
+bool VoiceManager::isAudible(float audibility) const
+{
+    // Silent sounds (muted, or beyond their maximum distance) are never audible
+    return (audibility > 0.f) && (audibility >= m_threshold);
+}
+
+} // namespace sf
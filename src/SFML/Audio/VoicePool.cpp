@@ -0,0 +1,213 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/VoicePool.hpp>
+#include <SFML/Audio/CompressedSoundBuffer.hpp>
+#include <SFML/Audio/InputSoundFile.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Sound stream decoding a compressed sound from memory
+///
+////////////////////////////////////////////////////////////
+class CompressedVoice : public SoundStream
+{
+public:
+
+    CompressedVoice() :
+    m_buffer   (NULL),
+    m_playIndex(0)
+    {
+        // Voices are mostly used for short sounds: keep the latency low
+        setBufferDuration(milliseconds(250));
+    }
+
+    ~CompressedVoice()
+    {
+        // We must stop before destroying the file
+        stop();
+    }
+
+    bool open(const CompressedSoundBuffer& buffer, Uint64 playIndex)
+    {
+        stop();
+
+        m_buffer = &buffer;
+        m_playIndex = playIndex;
+
+        // Reset the properties changed by the previous user of the voice
+        setPitch(1.f);
+        setVolume(100.f);
+        setPosition(0.f, 0.f, 0.f);
+        setRelativeToListener(false);
+        setMinDistance(1.f);
+        setAttenuation(1.f);
+        setLoop(false);
+
+        if (!m_file.openFromMemory(buffer.getData(), buffer.getDataSize()))
+            return false;
+
+        initialize(m_file.getChannelCount(), m_file.getSampleRate());
+        return true;
+    }
+
+    const CompressedSoundBuffer* getBuffer() const
+    {
+        return m_buffer;
+    }
+
+    Uint64 getPlayIndex() const
+    {
+        return m_playIndex;
+    }
+
+protected:
+
+    virtual bool onGetData(Chunk& data)
+    {
+        Lock lock(m_mutex);
+
+        // Decode a buffer duration of samples
+        std::size_t frameCount = static_cast<std::size_t>(getBufferDuration().asMicroseconds() * m_file.getSampleRate() / 1000000);
+        m_samples.resize(std::max(frameCount, static_cast<std::size_t>(1)) * m_file.getChannelCount());
+
+        data.samples     = &m_samples[0];
+        data.sampleCount = static_cast<std::size_t>(m_file.read(&m_samples[0], m_samples.size()));
+
+        return data.sampleCount == m_samples.size();
+    }
+
+    virtual void onSeek(Time timeOffset)
+    {
+        Lock lock(m_mutex);
+
+        m_file.seek(timeOffset);
+    }
+
+private:
+
+    InputSoundFile               m_file;      ///< Decoder reading the compressed sound
+    std::vector<Int16>           m_samples;   ///< Temporary buffer of samples
+    Mutex                        m_mutex;     ///< Mutex protecting the decoder
+    const CompressedSoundBuffer* m_buffer;    ///< Sound being played
+    Uint64                       m_playIndex; ///< Order in which the voice was started
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+VoicePool::VoicePool(std::size_t voiceCount) :
+m_voices   (),
+m_playCount(0)
+{
+    m_voices.resize(std::max(voiceCount, static_cast<std::size_t>(1)));
+    for (std::size_t i = 0; i < m_voices.size(); ++i)
+        m_voices[i] = new priv::CompressedVoice;
+}
+
+
+////////////////////////////////////////////////////////////
+VoicePool::~VoicePool()
+{
+    for (std::size_t i = 0; i < m_voices.size(); ++i)
+        delete m_voices[i];
+}
+
+
+////////////////////////////////////////////////////////////
+SoundSource& VoicePool::play(const CompressedSoundBuffer& buffer)
+{
+    // Take a free voice, or the oldest one if they are all busy
+    priv::CompressedVoice* voice = NULL;
+    for (std::size_t i = 0; i < m_voices.size(); ++i)
+    {
+        if (m_voices[i]->getStatus() == SoundSource::Stopped)
+        {
+            voice = m_voices[i];
+            break;
+        }
+
+        if (!voice || (m_voices[i]->getPlayIndex() < voice->getPlayIndex()))
+            voice = m_voices[i];
+    }
+
+    if (voice->open(buffer, m_playCount++))
+        voice->play();
+
+    return *voice;
+}
+
+
+////////////////////////////////////////////////////////////
+void VoicePool::stop()
+{
+    for (std::size_t i = 0; i < m_voices.size(); ++i)
+        m_voices[i]->stop();
+}
+
+
+////////////////////////////////////////////////////////////
+void VoicePool::stop(const CompressedSoundBuffer& buffer)
+{
+    for (std::size_t i = 0; i < m_voices.size(); ++i)
+    {
+        if (m_voices[i]->getBuffer() == &buffer)
+            m_voices[i]->stop();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VoicePool::getVoiceCount() const
+{
+    return m_voices.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VoicePool::getPlayingCount() const
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < m_voices.size(); ++i)
+    {
+        if (m_voices[i]->getStatus() != SoundSource::Stopped)
+            ++count;
+    }
+
+    return count;
+}
+
+} // namespace sf
@@ -35,6 +35,7 @@ namespace sf
 ////////////////////////////////////////////////////////////
 const BlendMode BlendAlpha(BlendMode::SrcAlpha, BlendMode::OneMinusSrcAlpha, BlendMode::Add,
                            BlendMode::One, BlendMode::OneMinusSrcAlpha, BlendMode::Add);
+const BlendMode BlendPremultipliedAlpha(BlendMode::One, BlendMode::OneMinusSrcAlpha, BlendMode::Add);
 const BlendMode BlendAdd(BlendMode::SrcAlpha, BlendMode::One, BlendMode::Add,
                          BlendMode::One, BlendMode::One, BlendMode::Add);
 const BlendMode BlendMultiply(BlendMode::DstColor, BlendMode::Zero);
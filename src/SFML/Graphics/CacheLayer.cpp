@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CacheLayer.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Text.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+CacheLayer::CacheLayer() :
+m_entries      (),
+m_renderTexture(),
+m_needUpdate   (true)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool CacheLayer::create(unsigned int width, unsigned int height)
+{
+    if (!m_renderTexture.create(width, height))
+        return false;
+
+    float right  = static_cast<float>(width);
+    float bottom = static_cast<float>(height);
+
+    m_vertices[0] = Vertex(Vector2f(0, 0),          Vector2f(0, 0));
+    m_vertices[1] = Vertex(Vector2f(0, bottom),     Vector2f(0, bottom));
+    m_vertices[2] = Vertex(Vector2f(right, 0),      Vector2f(right, 0));
+    m_vertices[3] = Vertex(Vector2f(right, bottom), Vector2f(right, bottom));
+
+    m_needUpdate = true;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void CacheLayer::add(const Drawable& drawable)
+{
+    Entry entry;
+    entry.drawable          = &drawable;
+    entry.transformable     = dynamic_cast<const Transformable*>(&drawable);
+    entry.text              = dynamic_cast<const Text*>(&drawable);
+    entry.transformRevision = entry.transformable ? entry.transformable->m_revision : 0;
+    entry.textRevision      = entry.text ? entry.text->m_revision : 0;
+
+    m_entries.push_back(entry);
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void CacheLayer::remove(const Drawable& drawable)
+{
+    for (std::vector<Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if (it->drawable == &drawable)
+        {
+            m_entries.erase(it);
+            m_needUpdate = true;
+            return;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void CacheLayer::clear()
+{
+    m_entries.clear();
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void CacheLayer::invalidate()
+{
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& CacheLayer::getTexture() const
+{
+    return m_renderTexture.getTexture();
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect CacheLayer::getLocalBounds() const
+{
+    Vector2u size = m_renderTexture.getSize();
+
+    return FloatRect(0.f, 0.f, static_cast<float>(size.x), static_cast<float>(size.y));
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect CacheLayer::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void CacheLayer::draw(RenderTarget& target, RenderStates states) const
+{
+    Vector2u size = m_renderTexture.getSize();
+    if (!size.x || !size.y)
+        return;
+
+    states.transform *= getTransform();
+
+    if (target.cull(getLocalBounds(), states.transform))
+        return;
+
+    // Render the drawables again if something changed
+    if (checkChanges() || m_needUpdate)
+    {
+        m_renderTexture.clear(Color::Transparent);
+        for (std::vector<Entry>::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+            m_renderTexture.draw(*it->drawable);
+        m_renderTexture.display();
+
+        m_needUpdate = false;
+    }
+
+    // The render texture holds colors multiplied by their alpha, they must not be multiplied again
+    if (states.blendMode == BlendAlpha)
+        states.blendMode = BlendMode(BlendMode::One, BlendMode::OneMinusSrcAlpha);
+
+    states.texture = &m_renderTexture.getTexture();
+    target.draw(m_vertices, 4, TrianglesStrip, states);
+}
+
+
+////////////////////////////////////////////////////////////
+bool CacheLayer::checkChanges() const
+{
+    bool changed = false;
+
+    for (std::vector<Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if (it->transformable && (it->transformRevision != it->transformable->m_revision))
+        {
+            it->transformRevision = it->transformable->m_revision;
+            changed = true;
+        }
+
+        if (it->text && (it->textRevision != it->text->m_revision))
+        {
+            it->textRevision = it->text->m_revision;
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+} // namespace sf
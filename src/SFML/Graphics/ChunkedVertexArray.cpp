@@ -0,0 +1,358 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ChunkedVertexArray.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Get the number of vertices of an independent primitive, 0 for strips and fans
+    std::size_t getPrimitiveSize(sf::PrimitiveType type)
+    {
+        switch (type)
+        {
+            case sf::Points:    return 1;
+            case sf::Lines:     return 2;
+            case sf::Triangles: return 3;
+            case sf::Quads:     return 4;
+            default:            return 0;
+        }
+    }
+
+    // Compute the bounding rectangle of a range of vertices
+    sf::FloatRect getVerticesBounds(const sf::Vertex* vertices, std::size_t count)
+    {
+        float left   = vertices[0].position.x;
+        float top    = vertices[0].position.y;
+        float right  = vertices[0].position.x;
+        float bottom = vertices[0].position.y;
+
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            sf::Vector2f position = vertices[i].position;
+
+            if (position.x < left)
+                left = position.x;
+            else if (position.x > right)
+                right = position.x;
+
+            if (position.y < top)
+                top = position.y;
+            else if (position.y > bottom)
+                bottom = position.y;
+        }
+
+        return sf::FloatRect(left, top, right - left, bottom - top);
+    }
+
+    // Grow a rectangle so that it contains another one
+    void mergeBounds(sf::FloatRect& bounds, const sf::FloatRect& rect)
+    {
+        float left   = std::min(bounds.left, rect.left);
+        float top    = std::min(bounds.top, rect.top);
+        float right  = std::max(bounds.left + bounds.width, rect.left + rect.width);
+        float bottom = std::max(bounds.top + bounds.height, rect.top + rect.height);
+
+        bounds = sf::FloatRect(left, top, right - left, bottom - top);
+    }
+
+    // Check whether two rectangles overlap, empty ones included
+    bool overlaps(const sf::FloatRect& a, const sf::FloatRect& b)
+    {
+        return (a.left <= b.left + b.width) && (a.left + a.width >= b.left) &&
+               (a.top <= b.top + b.height) && (a.top + a.height >= b.top);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ChunkedVertexArray::ChunkedVertexArray() :
+m_primitiveType(Points),
+m_chunkSize    (0.f),
+m_chunkCount   (0, 0),
+m_overflow     (0.f, 0.f),
+m_bounds       (),
+m_chunks       (),
+m_vertices     (),
+m_buffer       (Points, VertexBuffer::Static)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool ChunkedVertexArray::create(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, float chunkSize)
+{
+    clear();
+
+    std::size_t primitiveSize = getPrimitiveSize(type);
+    if (primitiveSize == 0)
+    {
+        err() << "Failed to create chunked vertex array, only independent primitives can be split into chunks" << std::endl;
+        return false;
+    }
+
+    if (!(chunkSize > 0.f))
+    {
+        err() << "Failed to create chunked vertex array, invalid chunk size (" << chunkSize << ")" << std::endl;
+        return false;
+    }
+
+    std::size_t primitiveCount = vertexCount / primitiveSize;
+    vertexCount = primitiveCount * primitiveSize;
+    if (!vertices || (primitiveCount == 0))
+        return false;
+
+    m_primitiveType = type;
+    m_chunkSize     = chunkSize;
+    m_bounds        = getVerticesBounds(vertices, vertexCount);
+
+    // Build the grid, clamped in float before the conversion to avoid overflows
+    float maxChunks = 65536.f;
+    m_chunkCount.x = static_cast<unsigned int>(std::min(std::max(std::ceil(m_bounds.width / chunkSize), 1.f), maxChunks));
+    m_chunkCount.y = static_cast<unsigned int>(std::min(std::max(std::ceil(m_bounds.height / chunkSize), 1.f), maxChunks));
+    Chunk empty;
+    empty.first = 0;
+    empty.count = 0;
+    m_chunks.resize(static_cast<std::size_t>(m_chunkCount.x) * m_chunkCount.y, empty);
+
+    // Find the chunk of each primitive, from the center of its bounds
+    std::vector<std::size_t> primitiveChunks(primitiveCount);
+    std::vector<FloatRect> primitiveBounds(primitiveCount);
+    for (std::size_t i = 0; i < primitiveCount; ++i)
+    {
+        FloatRect bounds = getVerticesBounds(vertices + i * primitiveSize, primitiveSize);
+        float centerX = bounds.left + bounds.width / 2.f - m_bounds.left;
+        float centerY = bounds.top + bounds.height / 2.f - m_bounds.top;
+
+        unsigned int column = static_cast<unsigned int>(std::min(std::max(centerX / chunkSize, 0.f), static_cast<float>(m_chunkCount.x - 1)));
+        unsigned int row    = static_cast<unsigned int>(std::min(std::max(centerY / chunkSize, 0.f), static_cast<float>(m_chunkCount.y - 1)));
+
+        std::size_t index = column + static_cast<std::size_t>(row) * m_chunkCount.x;
+        primitiveChunks[i] = index;
+        primitiveBounds[i] = bounds;
+
+        Chunk& chunk = m_chunks[index];
+        if (chunk.count == 0)
+            chunk.bounds = bounds;
+        else
+            mergeBounds(chunk.bounds, bounds);
+        chunk.count += primitiveSize;
+    }
+
+    // Assign a contiguous range of vertices to each chunk, row by row
+    std::size_t first = 0;
+    for (std::size_t i = 0; i < m_chunks.size(); ++i)
+    {
+        m_chunks[i].first = first;
+        first += m_chunks[i].count;
+    }
+
+    // Sort the primitives by chunk, keeping their relative order
+    std::vector<Vertex> sorted(vertexCount);
+    std::vector<std::size_t> offsets(m_chunks.size());
+    for (std::size_t i = 0; i < m_chunks.size(); ++i)
+        offsets[i] = m_chunks[i].first;
+
+    for (std::size_t i = 0; i < primitiveCount; ++i)
+    {
+        std::size_t& offset = offsets[primitiveChunks[i]];
+        std::copy(vertices + i * primitiveSize, vertices + (i + 1) * primitiveSize, sorted.begin() + offset);
+        offset += primitiveSize;
+    }
+
+    // Measure how far the chunks exceed their cell, the visible area of the grid is enlarged as much
+    for (unsigned int y = 0; y < m_chunkCount.y; ++y)
+    {
+        for (unsigned int x = 0; x < m_chunkCount.x; ++x)
+        {
+            const Chunk& chunk = m_chunks[x + static_cast<std::size_t>(y) * m_chunkCount.x];
+            if (chunk.count == 0)
+                continue;
+
+            float cellLeft = m_bounds.left + x * chunkSize;
+            float cellTop  = m_bounds.top + y * chunkSize;
+            m_overflow.x = std::max(m_overflow.x, std::max(cellLeft - chunk.bounds.left, chunk.bounds.left + chunk.bounds.width - cellLeft - chunkSize));
+            m_overflow.y = std::max(m_overflow.y, std::max(cellTop - chunk.bounds.top, chunk.bounds.top + chunk.bounds.height - cellTop - chunkSize));
+        }
+    }
+
+    // Upload the vertices once, or keep them in memory if vertex buffers are not supported
+    if (VertexBuffer::isAvailable())
+    {
+        m_buffer.setPrimitiveType(type);
+        if (m_buffer.create(vertexCount) && m_buffer.update(&sorted[0]))
+            return true;
+
+        err() << "Failed to upload chunked vertex array, falling back to client-side vertices" << std::endl;
+        m_buffer.create(0);
+    }
+
+    m_vertices.swap(sorted);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ChunkedVertexArray::create(const VertexArray& vertices, float chunkSize)
+{
+    if (vertices.getVertexCount() == 0)
+    {
+        clear();
+        return false;
+    }
+
+    return create(&vertices[0], vertices.getVertexCount(), vertices.getPrimitiveType(), chunkSize);
+}
+
+
+////////////////////////////////////////////////////////////
+void ChunkedVertexArray::clear()
+{
+    m_chunkSize  = 0.f;
+    m_chunkCount = Vector2u(0, 0);
+    m_overflow   = Vector2f(0.f, 0.f);
+    m_bounds     = FloatRect();
+    std::vector<Chunk>().swap(m_chunks);
+    std::vector<Vertex>().swap(m_vertices);
+
+    if (m_buffer.getVertexCount() > 0)
+        m_buffer.create(0);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ChunkedVertexArray::getVertexCount() const
+{
+    return m_chunks.empty() ? 0 : m_chunks.back().first + m_chunks.back().count;
+}
+
+
+////////////////////////////////////////////////////////////
+PrimitiveType ChunkedVertexArray::getPrimitiveType() const
+{
+    return m_primitiveType;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u ChunkedVertexArray::getChunkCount() const
+{
+    return m_chunkCount;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect ChunkedVertexArray::getBounds() const
+{
+    return m_bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+void ChunkedVertexArray::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_chunks.empty())
+        return;
+
+    FloatRect area = getVisibleArea(target.getView(), states.transform);
+
+    // Convert the area to a range of cells, enlarged by the overflow of the chunks
+    float columns = static_cast<float>(m_chunkCount.x);
+    float rows    = static_cast<float>(m_chunkCount.y);
+    float left    = (area.left - m_overflow.x - m_bounds.left) / m_chunkSize;
+    float top     = (area.top - m_overflow.y - m_bounds.top) / m_chunkSize;
+    float right   = (area.left + area.width + m_overflow.x - m_bounds.left) / m_chunkSize;
+    float bottom  = (area.top + area.height + m_overflow.y - m_bounds.top) / m_chunkSize;
+
+    unsigned int firstColumn = static_cast<unsigned int>(std::min(std::max(std::floor(left), 0.f), columns));
+    unsigned int firstRow    = static_cast<unsigned int>(std::min(std::max(std::floor(top), 0.f), rows));
+    unsigned int lastColumn  = static_cast<unsigned int>(std::min(std::max(std::ceil(right), 0.f), columns));
+    unsigned int lastRow     = static_cast<unsigned int>(std::min(std::max(std::ceil(bottom), 0.f), rows));
+
+    // Draw the visible chunks, merging those which are contiguous in the buffer into a single draw
+    std::size_t runFirst = 0;
+    std::size_t runCount = 0;
+    for (unsigned int y = firstRow; y < lastRow; ++y)
+    {
+        for (unsigned int x = firstColumn; x < lastColumn; ++x)
+        {
+            const Chunk& chunk = m_chunks[x + static_cast<std::size_t>(y) * m_chunkCount.x];
+            if ((chunk.count == 0) || !overlaps(chunk.bounds, area))
+                continue;
+
+            if (runFirst + runCount != chunk.first)
+            {
+                if (runCount > 0)
+                    drawVertices(target, states, runFirst, runCount);
+                runFirst = chunk.first;
+                runCount = 0;
+            }
+
+            runCount += chunk.count;
+        }
+    }
+
+    if (runCount > 0)
+        drawVertices(target, states, runFirst, runCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void ChunkedVertexArray::drawVertices(RenderTarget& target, const RenderStates& states, std::size_t first, std::size_t count) const
+{
+    if (m_vertices.empty())
+        target.draw(m_buffer, first, count, states);
+    else
+        target.draw(&m_vertices[first], count, m_primitiveType, states);
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect ChunkedVertexArray::getVisibleArea(const View& view, const Transform& transform)
+{
+    // Compute the area covered by the view, a rotated view is enlarged to its enclosing square
+    Vector2f size(std::fabs(view.getSize().x), std::fabs(view.getSize().y));
+    if (view.getRotation() != 0.f)
+    {
+        float diagonal = std::sqrt(size.x * size.x + size.y * size.y);
+        size = Vector2f(diagonal, diagonal);
+    }
+
+    // Bring it to the local coordinates of the vertices
+    return transform.getInverse().transformRect(FloatRect(view.getCenter() - size / 2.f, size));
+}
+
+} // namespace sf
@@ -26,7 +26,42 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/CircleShape.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
 #include <cmath>
+#include <map>
+
+
+namespace
+{
+    // Points of the unit circles already computed, by point count; the elements
+    // of a map are never moved, so the circles can keep pointers to them
+    typedef std::map<std::size_t, std::vector<sf::Vector2f> > UnitCircleTable;
+    UnitCircleTable unitCircles;
+    sf::Mutex unitCirclesMutex;
+
+    // Get the points of the unit circle with the given point count, starting at the top
+    const std::vector<sf::Vector2f>* getUnitCircle(std::size_t pointCount)
+    {
+        sf::Lock lock(unitCirclesMutex);
+
+        UnitCircleTable::iterator it = unitCircles.find(pointCount);
+        if (it != unitCircles.end())
+            return &it->second;
+
+        static const float pi = 3.141592654f;
+
+        std::vector<sf::Vector2f>& points = unitCircles[pointCount];
+        points.resize(pointCount);
+        for (std::size_t i = 0; i < pointCount; ++i)
+        {
+            float angle = i * 2 * pi / pointCount - pi / 2;
+            points[i] = sf::Vector2f(std::cos(angle), std::sin(angle));
+        }
+
+        return &points;
+    }
+}
 
 
 namespace sf
@@ -34,7 +69,8 @@ namespace sf
 ////////////////////////////////////////////////////////////
 CircleShape::CircleShape(float radius, std::size_t pointCount) :
 m_radius    (radius),
-m_pointCount(pointCount)
+m_pointCount(pointCount),
+m_unitPoints(getUnitCircle(pointCount))
 {
     update();
 }
@@ -59,6 +95,7 @@ float CircleShape::getRadius() const
 void CircleShape::setPointCount(std::size_t count)
 {
     m_pointCount = count;
+    m_unitPoints = getUnitCircle(count);
     update();
 }
 
@@ -72,11 +109,10 @@ std::size_t CircleShape::getPointCount() const
 ////////////////////////////////////////////////////////////
 Vector2f CircleShape::getPoint(std::size_t index) const
 {
-    static const float pi = 3.141592654f;
-
-    float angle = index * 2 * pi / m_pointCount - pi / 2;
-    float x = std::cos(angle) * m_radius;
-    float y = std::sin(angle) * m_radius;
+    // The cos/sin of the angles are shared by all the circles with the same point count
+    const Vector2f& point = (*m_unitPoints)[index];
+    float x = point.x * m_radius;
+    float y = point.y * m_radius;
 
     return Vector2f(m_radius + x, m_radius + y);
 }
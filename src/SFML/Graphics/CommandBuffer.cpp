@@ -0,0 +1,215 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CommandBuffer.hpp>
+#include <SFML/Graphics/RenderQueue.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Commands recorded by one thread
+///
+////////////////////////////////////////////////////////////
+struct CommandBuffer::Arena
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Consecutive commands recorded in the same group
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Run
+    {
+        Run(Uint32 runGroup, std::size_t runFirstCommand) : group(runGroup), firstCommand(runFirstCommand) {}
+
+        Uint32      group;        ///< Group of the commands
+        std::size_t firstCommand; ///< Index of the first command of the run
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    Arena() :
+    queue(),
+    runs (1, Run(0, 0)),
+    group(0)
+    {
+    }
+
+    RenderQueue      queue; ///< Copies of the commands and vertices, in recording order
+    std::vector<Run> runs;  ///< Runs of commands, the last one is open
+    Uint32           group; ///< Current group of the thread
+};
+
+
+////////////////////////////////////////////////////////////
+CommandBuffer::CommandBuffer() :
+m_arenas(),
+m_arena (NULL),
+m_mutex (),
+m_ranges()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+CommandBuffer::~CommandBuffer()
+{
+    for (std::vector<Arena*>::iterator it = m_arenas.begin(); it != m_arenas.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+void CommandBuffer::setGroup(Uint32 group)
+{
+    Arena& arena = getArena();
+    arena.group = group;
+
+    // Start a new run, unless the open one is still empty
+    std::size_t commandCount = arena.queue.getCommandCount();
+    if (arena.runs.back().firstCommand == commandCount)
+        arena.runs.back().group = group;
+    else
+        arena.runs.push_back(Arena::Run(group, commandCount));
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 CommandBuffer::getGroup() const
+{
+    const Arena* arena = m_arena;
+
+    return arena ? arena->group : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void CommandBuffer::draw(const Drawable& drawable, const RenderStates& states)
+{
+    getArena().queue.draw(drawable, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void CommandBuffer::draw(const Vertex* vertices, std::size_t vertexCount,
+                         PrimitiveType type, const RenderStates& states)
+{
+    getArena().queue.draw(vertices, vertexCount, type, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void CommandBuffer::draw(const VertexBuffer& vertexBuffer, const RenderStates& states)
+{
+    getArena().queue.draw(vertexBuffer, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void CommandBuffer::submit(RenderTarget& target)
+{
+    Lock lock(m_mutex);
+
+    // Gather the non-empty runs of all the arenas
+    m_ranges.clear();
+    for (std::size_t i = 0; i < m_arenas.size(); ++i)
+    {
+        const Arena& arena = *m_arenas[i];
+        for (std::size_t j = 0; j < arena.runs.size(); ++j)
+        {
+            std::size_t first = arena.runs[j].firstCommand;
+            std::size_t end = (j + 1 < arena.runs.size()) ? arena.runs[j + 1].firstCommand : arena.queue.getCommandCount();
+            if (end > first)
+            {
+                Range range;
+                range.group        = arena.runs[j].group;
+                range.arena        = i;
+                range.firstCommand = first;
+                range.commandCount = end - first;
+                m_ranges.push_back(range);
+            }
+        }
+    }
+
+    // Order them by group; the sort is stable, so the runs of a
+    // group recorded by a single thread keep their recording order
+    std::stable_sort(m_ranges.begin(), m_ranges.end());
+
+    for (std::vector<Range>::const_iterator it = m_ranges.begin(); it != m_ranges.end(); ++it)
+        m_arenas[it->arena]->queue.renderCommands(target, it->firstCommand, it->commandCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void CommandBuffer::clear()
+{
+    Lock lock(m_mutex);
+
+    for (std::vector<Arena*>::iterator it = m_arenas.begin(); it != m_arenas.end(); ++it)
+    {
+        Arena& arena = **it;
+        arena.queue.clear();
+        arena.runs.clear();
+        arena.runs.push_back(Arena::Run(arena.group, 0));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CommandBuffer::getCommandCount() const
+{
+    Lock lock(m_mutex);
+
+    std::size_t count = 0;
+    for (std::vector<Arena*>::const_iterator it = m_arenas.begin(); it != m_arenas.end(); ++it)
+        count += (*it)->queue.getCommandCount();
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+CommandBuffer::Arena& CommandBuffer::getArena()
+{
+    Arena* arena = m_arena;
+    if (!arena)
+    {
+        // First command of this thread: give it its own arena
+        arena = new Arena;
+        m_arena = arena;
+
+        Lock lock(m_mutex);
+        m_arenas.push_back(arena);
+    }
+
+    return *arena;
+}
+
+} // namespace sf
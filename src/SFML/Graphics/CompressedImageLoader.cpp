@@ -0,0 +1,322 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CompressedImageLoader.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/Err.hpp>
+#include <fstream>
+#include <cstring>
+
+
+namespace
+{
+    // Little-endian 32 bits value at the given byte offset
+    sf::Uint32 readUint32(const sf::Uint8* data, std::size_t offset, bool swap = false)
+    {
+        const sf::Uint8* bytes = data + offset;
+        if (swap)
+            return (bytes[0] << 24) | (bytes[1] << 16) | (bytes[2] << 8) | bytes[3];
+        else
+            return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (bytes[3] << 24);
+    }
+
+    // Build a FourCC code, as stored in DDS files
+    sf::Uint32 fourCC(const char* code)
+    {
+        return readUint32(reinterpret_cast<const sf::Uint8*>(code), 0);
+    }
+
+    // Convert the OpenGL internal format of a KTX file
+    bool formatFromGlInternalFormat(sf::Uint32 internalFormat, sf::Texture::CompressedFormat& format)
+    {
+        switch (internalFormat)
+        {
+            case 0x83F0: // GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+            case 0x83F1: format = sf::Texture::Dxt1;     return true; // GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+            case 0x83F2: format = sf::Texture::Dxt3;     return true; // GL_COMPRESSED_RGBA_S3TC_DXT3_EXT
+            case 0x83F3: format = sf::Texture::Dxt5;     return true; // GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+            case 0x8D64: // GL_ETC1_RGB8_OES, ETC2 decoders are backward compatible
+            case 0x9274: format = sf::Texture::Etc2Rgb;  return true; // GL_COMPRESSED_RGB8_ETC2
+            case 0x9278: format = sf::Texture::Etc2Rgba; return true; // GL_COMPRESSED_RGBA8_ETC2_EAC
+            case 0x93B0: format = sf::Texture::Astc4x4;  return true; // GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+            case 0x93B4: format = sf::Texture::Astc6x6;  return true; // GL_COMPRESSED_RGBA_ASTC_6x6_KHR
+            case 0x93B7: format = sf::Texture::Astc8x8;  return true; // GL_COMPRESSED_RGBA_ASTC_8x8_KHR
+            default:     return false;
+        }
+    }
+
+    // Copy the first mipmap level of a container, after checking that it is complete
+    bool extractBlocks(const sf::Uint8* data, std::size_t size, std::size_t offset, sf::priv::CompressedImage& image)
+    {
+        std::size_t blocksSize = sf::priv::getCompressedImageSize(image.format, image.size);
+        if ((offset > size) || (size - offset < blocksSize))
+        {
+            sf::err() << "Failed to load compressed image. Reason: The data is truncated" << std::endl;
+            return false;
+        }
+
+        image.blocks.assign(data + offset, data + offset + blocksSize);
+        return true;
+    }
+
+    // Parse a Khronos KTX (version 1) container
+    bool parseKtx(const sf::Uint8* data, std::size_t size, sf::priv::CompressedImage& image)
+    {
+        // The header is 64 bytes long including the identifier, the size of the first level follows
+        if (size < 68)
+        {
+            sf::err() << "Failed to load KTX image. Reason: The header is truncated" << std::endl;
+            return false;
+        }
+
+        // The endianness field tells whether the values must be swapped
+        bool swap = (readUint32(data, 12) == 0x01020304);
+
+        sf::Uint32 glType           = readUint32(data, 16, swap);
+        sf::Uint32 glInternalFormat = readUint32(data, 28, swap);
+        sf::Uint32 pixelWidth       = readUint32(data, 36, swap);
+        sf::Uint32 pixelHeight      = readUint32(data, 40, swap);
+        sf::Uint32 pixelDepth       = readUint32(data, 44, swap);
+        sf::Uint32 arrayElements    = readUint32(data, 48, swap);
+        sf::Uint32 faces            = readUint32(data, 52, swap);
+        sf::Uint32 keyValueBytes    = readUint32(data, 60, swap);
+
+        if ((glType != 0) || !formatFromGlInternalFormat(glInternalFormat, image.format))
+        {
+            sf::err() << "Failed to load KTX image. Reason: Unsupported format 0x" << std::hex << glInternalFormat << std::dec << std::endl;
+            return false;
+        }
+
+        if ((pixelWidth == 0) || (pixelHeight == 0) || (pixelDepth > 1) || (arrayElements > 0) || (faces != 1))
+        {
+            sf::err() << "Failed to load KTX image. Reason: Only 2D textures are supported" << std::endl;
+            return false;
+        }
+
+        image.size.x = pixelWidth;
+        image.size.y = pixelHeight;
+
+        // The first level follows the key/value data and its size
+        std::size_t offset = 64 + keyValueBytes;
+        if (offset + 4 > size)
+        {
+            sf::err() << "Failed to load KTX image. Reason: The data is truncated" << std::endl;
+            return false;
+        }
+
+        return extractBlocks(data, size, offset + 4, image);
+    }
+
+    // Parse a Microsoft DDS container
+    bool parseDds(const sf::Uint8* data, std::size_t size, sf::priv::CompressedImage& image)
+    {
+        // The header is 124 bytes long, after the 4 bytes of the magic number
+        if ((size < 128) || (readUint32(data, 4) != 124))
+        {
+            sf::err() << "Failed to load DDS image. Reason: The header is truncated" << std::endl;
+            return false;
+        }
+
+        sf::Uint32 height     = readUint32(data, 12);
+        sf::Uint32 width      = readUint32(data, 16);
+        sf::Uint32 pixelFlags = readUint32(data, 80);
+        sf::Uint32 code       = readUint32(data, 84);
+        sf::Uint32 caps2      = readUint32(data, 112);
+
+        // Cubemaps and volumes have flags in the second caps field
+        if ((width == 0) || (height == 0) || (caps2 != 0))
+        {
+            sf::err() << "Failed to load DDS image. Reason: Only 2D textures are supported" << std::endl;
+            return false;
+        }
+
+        // Only compressed formats are supported (DDPF_FOURCC)
+        std::size_t offset = 128;
+        bool supported = false;
+        if (pixelFlags & 0x4)
+        {
+            if (code == fourCC("DXT1"))
+            {
+                image.format = sf::Texture::Dxt1;
+                supported = true;
+            }
+            else if (code == fourCC("DXT3"))
+            {
+                image.format = sf::Texture::Dxt3;
+                supported = true;
+            }
+            else if (code == fourCC("DXT5"))
+            {
+                image.format = sf::Texture::Dxt5;
+                supported = true;
+            }
+            else if ((code == fourCC("DX10")) && (size >= 148))
+            {
+                // Extended header: the format is a DXGI_FORMAT value
+                sf::Uint32 dxgiFormat = readUint32(data, 128);
+                sf::Uint32 dimension  = readUint32(data, 132);
+                sf::Uint32 arraySize  = readUint32(data, 140);
+                offset += 20;
+
+                if ((dimension == 3) && (arraySize <= 1)) // D3D10_RESOURCE_DIMENSION_TEXTURE2D
+                {
+                    switch (dxgiFormat)
+                    {
+                        case 71: image.format = sf::Texture::Dxt1; supported = true; break; // DXGI_FORMAT_BC1_UNORM
+                        case 74: image.format = sf::Texture::Dxt3; supported = true; break; // DXGI_FORMAT_BC2_UNORM
+                        case 77: image.format = sf::Texture::Dxt5; supported = true; break; // DXGI_FORMAT_BC3_UNORM
+                        default: break;
+                    }
+                }
+            }
+        }
+
+        if (!supported)
+        {
+            sf::err() << "Failed to load DDS image. Reason: Unsupported format" << std::endl;
+            return false;
+        }
+
+        image.size.x = width;
+        image.size.y = height;
+
+        return extractBlocks(data, size, offset, image);
+    }
+
+    // Detect the container and parse it
+    bool parseContainer(const sf::Uint8* data, std::size_t size, sf::priv::CompressedImage& image)
+    {
+        static const sf::Uint8 ktxIdentifier[12] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+        if ((size >= 12) && (std::memcmp(data, ktxIdentifier, 12) == 0))
+            return parseKtx(data, size, image);
+
+        if ((size >= 4) && (std::memcmp(data, "DDS ", 4) == 0))
+            return parseDds(data, size, image);
+
+        sf::err() << "Failed to load compressed image. Reason: Unknown container, only KTX and DDS files are supported" << std::endl;
+        return false;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool loadCompressedImageFromMemory(const void* data, std::size_t size, CompressedImage& image)
+{
+    if (!data || (size == 0))
+    {
+        err() << "Failed to load compressed image from memory, no data provided" << std::endl;
+        return false;
+    }
+
+    return parseContainer(static_cast<const Uint8*>(data), size, image);
+}
+
+
+////////////////////////////////////////////////////////////
+bool loadCompressedImageFromFile(const std::string& filename, CompressedImage& image)
+{
+    std::ifstream file(filename.c_str(), std::ios_base::binary);
+    if (!file)
+    {
+        err() << "Failed to load compressed image \"" << filename << "\". Reason: Unable to open file" << std::endl;
+        return false;
+    }
+
+    // Read the whole file, the containers are parsed in memory
+    std::vector<Uint8> buffer;
+    file.seekg(0, std::ios_base::end);
+    std::streamsize size = file.tellg();
+    if (size > 0)
+    {
+        file.seekg(0, std::ios_base::beg);
+        buffer.resize(static_cast<std::size_t>(size));
+        file.read(reinterpret_cast<char*>(&buffer[0]), size);
+    }
+
+    if (buffer.empty() || !parseContainer(&buffer[0], buffer.size(), image))
+    {
+        err() << "Failed to load compressed image \"" << filename << "\"" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool loadCompressedImageFromStream(InputStream& stream, CompressedImage& image)
+{
+    // Read the whole stream, the containers are parsed in memory
+    std::vector<Uint8> buffer;
+    Int64 size = stream.getSize();
+    if ((size > 0) && (stream.seek(0) != -1))
+    {
+        buffer.resize(static_cast<std::size_t>(size));
+        if (stream.read(&buffer[0], size) != size)
+            buffer.clear();
+    }
+
+    if (buffer.empty())
+    {
+        err() << "Failed to load compressed image from stream. Reason: Unable to read the stream" << std::endl;
+        return false;
+    }
+
+    return parseContainer(&buffer[0], buffer.size(), image);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t getCompressedImageSize(Texture::CompressedFormat format, const Vector2u& size)
+{
+    unsigned int blockWidth  = 4;
+    unsigned int blockHeight = 4;
+    std::size_t  blockBytes  = 16;
+
+    switch (format)
+    {
+        case Texture::Dxt1:    blockBytes = 8;  break;
+        case Texture::Etc2Rgb: blockBytes = 8;  break;
+        case Texture::Astc6x6: blockWidth = 6; blockHeight = 6; break;
+        case Texture::Astc8x8: blockWidth = 8; blockHeight = 8; break;
+        default:               break;
+    }
+
+    std::size_t columns = (size.x + blockWidth - 1) / blockWidth;
+    std::size_t rows    = (size.y + blockHeight - 1) / blockHeight;
+
+    return columns * rows * blockBytes;
+}
+
+} // namespace priv
+
+} // namespace sf
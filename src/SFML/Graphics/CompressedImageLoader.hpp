@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_COMPRESSEDIMAGELOADER_HPP
+#define SFML_COMPRESSEDIMAGELOADER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class InputStream;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief First mipmap level of a pre-compressed image
+///
+////////////////////////////////////////////////////////////
+struct CompressedImage
+{
+    Texture::CompressedFormat format; ///< Compression format of the blocks
+    Vector2u                  size;   ///< Size of the image, in pixels
+    std::vector<Uint8>        blocks; ///< Compressed blocks, as expected by glCompressedTexImage2D
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Parse a KTX or DDS container in memory
+///
+/// \param data   Pointer to the file data in memory
+/// \param size   Size of the data, in bytes
+/// \param image  Receives the first mipmap level of the image
+///
+/// \return True if the container was parsed successfully
+///
+////////////////////////////////////////////////////////////
+bool loadCompressedImageFromMemory(const void* data, std::size_t size, CompressedImage& image);
+
+////////////////////////////////////////////////////////////
+/// \brief Parse a KTX or DDS container from a file on disk
+///
+/// \param filename Path of the file to load
+/// \param image    Receives the first mipmap level of the image
+///
+/// \return True if the file was loaded successfully
+///
+////////////////////////////////////////////////////////////
+bool loadCompressedImageFromFile(const std::string& filename, CompressedImage& image);
+
+////////////////////////////////////////////////////////////
+/// \brief Parse a KTX or DDS container from a custom stream
+///
+/// \param stream Source stream to read from
+/// \param image  Receives the first mipmap level of the image
+///
+/// \return True if the stream was loaded successfully
+///
+////////////////////////////////////////////////////////////
+bool loadCompressedImageFromStream(InputStream& stream, CompressedImage& image);
+
+////////////////////////////////////////////////////////////
+/// \brief Compute the size of a compressed image
+///
+/// \param format Compression format of the blocks
+/// \param size   Size of the image, in pixels
+///
+/// \return Size of the compressed data, in bytes
+///
+////////////////////////////////////////////////////////////
+std::size_t getCompressedImageSize(Texture::CompressedFormat format, const Vector2u& size);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_COMPRESSEDIMAGELOADER_HPP
@@ -0,0 +1,695 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CorePipeline.hpp>
+#include <SFML/Graphics/CompactVertex.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+#if !defined(SFML_OPENGL_ES) || defined(SFML_OPENGL_ES2)
+
+#if !defined(GL_CONTEXT_PROFILE_MASK)
+    #define GL_CONTEXT_PROFILE_MASK 0x9126
+#endif
+
+#if !defined(GL_CONTEXT_CORE_PROFILE_BIT)
+    #define GL_CONTEXT_CORE_PROFILE_BIT 0x00000001
+#endif
+
+#if defined(SFML_SYSTEM_MACOS)
+
+    #define castToGlHandle(x) reinterpret_cast<GLEXT_GLhandle>(static_cast<ptrdiff_t>(x))
+    #define castFromGlHandle(x) static_cast<unsigned int>(reinterpret_cast<ptrdiff_t>(x))
+
+#else
+
+    #define castToGlHandle(x) (x)
+    #define castFromGlHandle(x) (x)
+
+#endif
+
+namespace
+{
+    sf::Mutex mutex;
+
+    bool checkCorePipelineAvailable()
+    {
+        if (!sf::Shader::isAvailable() || !sf::VertexBuffer::isAvailable())
+            return false;
+
+        // Create a temporary context in case the user checks
+        // before a GlResource is created, thus initializing
+        // the shared context
+        sf::Context context;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+#ifdef SFML_OPENGL_ES
+        // OpenGL ES 2 enables the attributes on the context instead
+        return true;
+#else
+        return GLEXT_vertex_array_object;
+#endif
+    }
+
+    const char* const matrixNames[] = {"sf_viewProjection", "sf_model", "sf_textureMatrix"};
+
+    // The shader sources are shared by GLSL 1.10 (compatibility contexts),
+    // GLSL 1.50 (core contexts) and GLSL ES 1.00, the preambles hide the differences
+    const char* vertexPreambleCompatibility =
+        "#version 110\n"
+        "#define IN attribute\n"
+        "#define OUT varying\n";
+
+    const char* vertexPreambleCore =
+        "#version 150\n"
+        "#define IN in\n"
+        "#define OUT out\n";
+
+    const char* fragmentPreambleCompatibility =
+        "#version 110\n"
+        "#define IN varying\n"
+        "#define FRAGCOLOR gl_FragColor\n"
+        "#define TEXTURE texture2D\n";
+
+    const char* fragmentPreambleCore =
+        "#version 150\n"
+        "#define IN in\n"
+        "out vec4 sf_fragColor;\n"
+        "#define FRAGCOLOR sf_fragColor\n"
+        "#define TEXTURE texture\n";
+
+    // GLSL ES 1.00 (OpenGL ES 2) is GLSL 1.10 with precision qualifiers
+    const char* vertexPreambleEs =
+        "#version 100\n"
+        "#define IN attribute\n"
+        "#define OUT varying\n";
+
+    const char* fragmentPreambleEs =
+        "#version 100\n"
+        "precision mediump float;\n"
+        "#define IN varying\n"
+        "#define FRAGCOLOR gl_FragColor\n"
+        "#define TEXTURE texture2D\n";
+
+    const char* vertexSource =
+        "uniform mat4 sf_viewProjection;\n"
+        "uniform mat4 sf_model;\n"
+        "uniform mat4 sf_textureMatrix;\n"
+        "IN vec2 sf_position;\n"
+        "IN vec4 sf_color;\n"
+        "IN vec2 sf_texCoords;\n"
+        "OUT vec4 color;\n"
+        "OUT vec2 texCoords;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_Position = sf_viewProjection * sf_model * vec4(sf_position, 0.0, 1.0);\n"
+        "    color = sf_color;\n"
+        "    texCoords = (sf_textureMatrix * vec4(sf_texCoords, 0.0, 1.0)).xy;\n"
+        "}\n";
+
+    const char* fragmentSource =
+        "uniform sampler2D sf_texture;\n"
+        "uniform float sf_textured;\n"
+        "IN vec4 color;\n"
+        "IN vec2 texCoords;\n"
+        "void main()\n"
+        "{\n"
+        "    FRAGCOLOR = color * mix(vec4(1.0), TEXTURE(sf_texture, texCoords), sf_textured);\n"
+        "}\n";
+
+    // Compile a shader object, return 0 on failure
+    GLEXT_GLhandle compileShader(GLenum type, const char* preamble, const char* source)
+    {
+        const char* sources[] = {preamble, source};
+
+        GLEXT_GLhandle shader = glCheck(GLEXT_glCreateShaderObject(type));
+        glCheck(GLEXT_glShaderSource(shader, 2, sources, NULL));
+        glCheck(GLEXT_glCompileShader(shader));
+
+        GLint success;
+        glCheck(GLEXT_glGetObjectParameteriv(shader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
+        if (success == GL_FALSE)
+        {
+            char log[1024];
+            glCheck(GLEXT_glGetInfoLog(shader, sizeof(log), 0, log));
+            sf::err() << "Failed to compile built-in shader:" << std::endl
+                      << log << std::endl;
+            glCheck(GLEXT_glDeleteObject(shader));
+            return 0;
+        }
+
+        return shader;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+CorePipeline::CorePipeline() :
+m_program           (0),
+m_vertexArray       (0),
+m_vertexArrayContext(0),
+m_streamBuffer      (0),
+m_streamCapacity    (0),
+m_indexBuffer       (0),
+m_indexCapacity     (0),
+m_texturedLocation  (-1),
+m_textured          (false),
+m_programBound      (false),
+m_uniformsChanged   (false),
+m_failed            (false)
+{
+    for (int i = 0; i < MatrixCount; ++i)
+        m_matrixLocations[i] = -1;
+}
+
+
+////////////////////////////////////////////////////////////
+CorePipeline::~CorePipeline()
+{
+    if (!m_program)
+        return;
+
+    ensureGlContext();
+
+    glCheck(GLEXT_glDeleteObject(castToGlHandle(m_program)));
+
+#ifndef SFML_OPENGL_ES
+    // The vertex array object can only be destroyed in its own context
+    if (m_vertexArray && (m_vertexArrayContext == Context::getActiveContextId()))
+    {
+        GLuint vertexArray = static_cast<GLuint>(m_vertexArray);
+        glCheck(GLEXT_glDeleteVertexArrays(1, &vertexArray));
+    }
+#endif
+
+    GLuint buffers[] = {static_cast<GLuint>(m_streamBuffer), static_cast<GLuint>(m_indexBuffer)};
+    glCheck(GLEXT_glDeleteBuffers(2, buffers));
+}
+
+
+////////////////////////////////////////////////////////////
+bool CorePipeline::isAvailable()
+{
+    // TODO: Remove this lock when it becomes unnecessary in C++11
+    Lock lock(mutex);
+
+    static bool available = checkCorePipelineAvailable();
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CorePipeline::isCoreContext()
+{
+#ifdef SFML_OPENGL_ES
+    // OpenGL ES 2 has no fixed-function pipeline either
+    return true;
+#else
+    if (!sfogl_IsVersionGEQ(3, 2))
+        return false;
+
+    GLint profile = 0;
+    glCheck(glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &profile));
+
+    return (profile & GL_CONTEXT_CORE_PROFILE_BIT) != 0;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+const char* const* CorePipeline::getMatrixNames()
+{
+    return matrixNames;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CorePipeline::bind()
+{
+    if (!m_program && !create())
+        return false;
+
+#ifdef SFML_OPENGL_ES
+
+    // Without vertex array objects, the vertex components are
+    // enabled on the context, where they stay until unbind
+    glCheck(GLEXT_glEnableVertexAttribArray(Position));
+    glCheck(GLEXT_glEnableVertexAttribArray(Color));
+    glCheck(GLEXT_glEnableVertexAttribArray(TexCoords));
+
+#else
+
+    // Vertex array objects are not shared between contexts: if the target now
+    // renders in another context (render textures use the one of their thread),
+    // a new one is needed. The old one is released along with its context.
+    if (m_vertexArrayContext != Context::getActiveContextId())
+    {
+        if (!createVertexArray())
+            return false;
+    }
+
+    glCheck(GLEXT_glBindVertexArray(m_vertexArray));
+
+#endif
+
+    bindProgram();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::unbind()
+{
+    glCheck(GLEXT_glUseProgramObject(0));
+#ifdef SFML_OPENGL_ES
+    glCheck(GLEXT_glDisableVertexAttribArray(Position));
+    glCheck(GLEXT_glDisableVertexAttribArray(Color));
+    glCheck(GLEXT_glDisableVertexAttribArray(TexCoords));
+#else
+    glCheck(GLEXT_glBindVertexArray(0));
+#endif
+    m_programBound = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::bindProgram()
+{
+    glCheck(GLEXT_glUseProgramObject(castToGlHandle(m_program)));
+    m_programBound = true;
+
+    // Catch up with the changes made while a custom shader was bound
+    if (m_uniformsChanged)
+    {
+        for (int i = 0; i < MatrixCount; ++i)
+        {
+            glCheck(GLEXT_glUniformMatrix4fv(m_matrixLocations[i], 1, GL_FALSE, m_matrices[i].getMatrix()));
+        }
+
+        glCheck(GLEXT_glUniform1f(m_texturedLocation, m_textured ? 1.f : 0.f));
+
+        m_uniformsChanged = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::releaseProgram()
+{
+    m_programBound = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::setMatrix(Matrix matrix, const Transform& transform)
+{
+    m_matrices[matrix] = transform;
+
+    if (m_programBound)
+    {
+        glCheck(GLEXT_glUniformMatrix4fv(m_matrixLocations[matrix], 1, GL_FALSE, transform.getMatrix()));
+    }
+    else
+    {
+        m_uniformsChanged = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::setTextured(bool textured)
+{
+    m_textured = textured;
+
+    if (m_programBound)
+    {
+        glCheck(GLEXT_glUniform1f(m_texturedLocation, textured ? 1.f : 0.f));
+    }
+    else
+    {
+        m_uniformsChanged = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::uploadMatrices(const int* locations) const
+{
+    for (int i = 0; i < MatrixCount; ++i)
+    {
+        if (locations[i] != -1)
+        {
+            glCheck(GLEXT_glUniformMatrix4fv(locations[i], 1, GL_FALSE, m_matrices[i].getMatrix()));
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CorePipeline::stream(const Vertex* vertices, std::size_t vertexCount)
+{
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_streamBuffer));
+
+    // Orphan the previous storage so that we don't wait for the GPU to release it
+    m_streamCapacity = std::max(m_streamCapacity, vertexCount);
+    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * m_streamCapacity, NULL, GLEXT_GL_STREAM_DRAW));
+    glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, 0, sizeof(Vertex) * vertexCount, vertices));
+
+    setAttributePointers();
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::streamIndices(const Uint32* indices, std::size_t indexCount)
+{
+    // The binding is recorded by the vertex array object (or the context
+    // with OpenGL ES), it must not be reset
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer));
+
+    // Orphan the previous storage so that we don't wait for the GPU to release it
+    m_indexCapacity = std::max(m_indexCapacity, indexCount);
+    glCheck(GLEXT_glBufferData(GLEXT_GL_ELEMENT_ARRAY_BUFFER, sizeof(Uint32) * m_indexCapacity, NULL, GLEXT_GL_STREAM_DRAW));
+    glCheck(GLEXT_glBufferSubData(GLEXT_GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(Uint32) * indexCount, indices));
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::setAttributePointers(bool compact)
+{
+    const char* data = NULL;
+    if (compact)
+    {
+        glCheck(GLEXT_glVertexAttribPointer(Position,  2, GL_SHORT,         GL_FALSE, sizeof(CompactVertex), data + 0));
+        glCheck(GLEXT_glVertexAttribPointer(Color,     4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(CompactVertex), data + 4));
+        glCheck(GLEXT_glVertexAttribPointer(TexCoords, 2, GL_SHORT,         GL_FALSE, sizeof(CompactVertex), data + 8));
+    }
+    else
+    {
+        glCheck(GLEXT_glVertexAttribPointer(Position,  2, GL_FLOAT,         GL_FALSE, sizeof(Vertex), data + 0));
+        glCheck(GLEXT_glVertexAttribPointer(Color,     4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(Vertex), data + 8));
+        glCheck(GLEXT_glVertexAttribPointer(TexCoords, 2, GL_FLOAT,         GL_FALSE, sizeof(Vertex), data + 12));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool CorePipeline::create()
+{
+    // Don't retry every time the states are reset if something went wrong once
+    if (m_failed)
+        return false;
+
+    m_failed = true;
+
+    ensureGlContext();
+
+    // Compile and link the program
+#ifdef SFML_OPENGL_ES
+    const char* vertexPreamble   = vertexPreambleEs;
+    const char* fragmentPreamble = fragmentPreambleEs;
+#else
+    bool core = isCoreContext();
+    const char* vertexPreamble   = core ? vertexPreambleCore : vertexPreambleCompatibility;
+    const char* fragmentPreamble = core ? fragmentPreambleCore : fragmentPreambleCompatibility;
+#endif
+
+    GLEXT_GLhandle vertexShader = compileShader(GLEXT_GL_VERTEX_SHADER, vertexPreamble, vertexSource);
+    if (!vertexShader)
+        return false;
+
+    GLEXT_GLhandle fragmentShader = compileShader(GLEXT_GL_FRAGMENT_SHADER, fragmentPreamble, fragmentSource);
+    if (!fragmentShader)
+    {
+        glCheck(GLEXT_glDeleteObject(vertexShader));
+        return false;
+    }
+
+    GLEXT_GLhandle program = glCheck(GLEXT_glCreateProgramObject());
+    glCheck(GLEXT_glAttachObject(program, vertexShader));
+    glCheck(GLEXT_glAttachObject(program, fragmentShader));
+    glCheck(GLEXT_glDeleteObject(vertexShader));
+    glCheck(GLEXT_glDeleteObject(fragmentShader));
+
+    // The attribute locations must be fixed before linking
+    glCheck(GLEXT_glBindAttribLocation(program, Position,  "sf_position"));
+    glCheck(GLEXT_glBindAttribLocation(program, Color,     "sf_color"));
+    glCheck(GLEXT_glBindAttribLocation(program, TexCoords, "sf_texCoords"));
+    glCheck(GLEXT_glLinkProgram(program));
+
+    GLint success;
+    glCheck(GLEXT_glGetObjectParameteriv(program, GLEXT_GL_OBJECT_LINK_STATUS, &success));
+    if (success == GL_FALSE)
+    {
+        char log[1024];
+        glCheck(GLEXT_glGetInfoLog(program, sizeof(log), 0, log));
+        err() << "Failed to link built-in shader:" << std::endl
+              << log << std::endl;
+        glCheck(GLEXT_glDeleteObject(program));
+        return false;
+    }
+
+    for (int i = 0; i < MatrixCount; ++i)
+    {
+        m_matrixLocations[i] = glCheck(GLEXT_glGetUniformLocation(program, matrixNames[i]));
+    }
+    m_texturedLocation = glCheck(GLEXT_glGetUniformLocation(program, "sf_textured"));
+
+    // The sampler always reads the texture unit 0
+    GLint textureLocation = glCheck(GLEXT_glGetUniformLocation(program, "sf_texture"));
+    glCheck(GLEXT_glUseProgramObject(program));
+    glCheck(GLEXT_glUniform1i(textureLocation, 0));
+    glCheck(GLEXT_glUseProgramObject(0));
+
+    // Create the stream buffers
+    GLuint buffers[] = {0, 0};
+    glCheck(GLEXT_glGenBuffers(2, buffers));
+
+    if (!buffers[0] || !buffers[1])
+    {
+        err() << "Failed to create the objects of the core pipeline" << std::endl;
+        glCheck(GLEXT_glDeleteBuffers(2, buffers));
+        glCheck(GLEXT_glDeleteObject(program));
+        return false;
+    }
+
+    m_program        = castFromGlHandle(program);
+    m_streamBuffer   = static_cast<unsigned int>(buffers[0]);
+    m_streamCapacity = 0;
+    m_indexBuffer    = static_cast<unsigned int>(buffers[1]);
+    m_indexCapacity  = 0;
+    m_failed         = false;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CorePipeline::createVertexArray()
+{
+#ifdef SFML_OPENGL_ES
+
+    // Never called, bind doesn't use vertex array objects
+    return true;
+
+#else
+
+    // Create the vertex array object, the vertex components are always enabled
+    GLuint vertexArray = 0;
+    glCheck(GLEXT_glGenVertexArrays(1, &vertexArray));
+
+    if (!vertexArray)
+    {
+        err() << "Failed to create the vertex array object of the core pipeline" << std::endl;
+        return false;
+    }
+
+    glCheck(GLEXT_glBindVertexArray(vertexArray));
+    glCheck(GLEXT_glEnableVertexAttribArray(Position));
+    glCheck(GLEXT_glEnableVertexAttribArray(Color));
+    glCheck(GLEXT_glEnableVertexAttribArray(TexCoords));
+    glCheck(GLEXT_glBindVertexArray(0));
+
+    m_vertexArray        = static_cast<unsigned int>(vertexArray);
+    m_vertexArrayContext = Context::getActiveContextId();
+
+    return true;
+
+#endif
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#else // SFML_OPENGL_ES && !SFML_OPENGL_ES2
+
+// OpenGL ES 1 doesn't support GLSL shaders at all, the fixed-function pipeline is always used
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+CorePipeline::CorePipeline() :
+m_program           (0),
+m_vertexArray       (0),
+m_vertexArrayContext(0),
+m_streamBuffer      (0),
+m_streamCapacity    (0),
+m_indexBuffer       (0),
+m_indexCapacity     (0),
+m_texturedLocation  (-1),
+m_textured          (false),
+m_programBound      (false),
+m_uniformsChanged   (false),
+m_failed            (true)
+{
+    for (int i = 0; i < MatrixCount; ++i)
+        m_matrixLocations[i] = -1;
+}
+
+
+////////////////////////////////////////////////////////////
+CorePipeline::~CorePipeline()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool CorePipeline::isAvailable()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CorePipeline::isCoreContext()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+const char* const* CorePipeline::getMatrixNames()
+{
+    static const char* const matrixNames[] = {"sf_viewProjection", "sf_model", "sf_textureMatrix"};
+    return matrixNames;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CorePipeline::bind()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::unbind()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::bindProgram()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::releaseProgram()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::setMatrix(Matrix, const Transform&)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::setTextured(bool)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::uploadMatrices(const int*) const
+{
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CorePipeline::stream(const Vertex*, std::size_t)
+{
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::streamIndices(const Uint32*, std::size_t)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::setAttributePointers(bool)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool CorePipeline::create()
+{
+    return false;
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#endif // SFML_OPENGL_ES && !SFML_OPENGL_ES2
@@ -0,0 +1,271 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_COREPIPELINE_HPP
+#define SFML_COREPIPELINE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Shader-based replacement of the fixed-function
+///        pipeline used by RenderTarget
+///
+/// The pipeline owns a built-in program which reads the
+/// vertices from generic attributes and takes the matrices
+/// from uniforms, and a vertex array object. It only uses
+/// functionality available in core profile contexts.
+///
+/// Since a vertex array object can't be shared between
+/// contexts, a pipeline must always be used with the same
+/// context.
+///
+/// With OpenGL ES 2 (SFML_OPENGL_ES2), the pipeline is the
+/// only way to render: the program is written in GLSL ES,
+/// and the vertex components are enabled on the context
+/// instead of a vertex array object.
+///
+////////////////////////////////////////////////////////////
+class CorePipeline : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Generic attribute locations of the vertex components
+    ///
+    /// Custom shaders get the same locations, for the
+    /// sf_position, sf_color and sf_texCoords attributes.
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Attribute
+    {
+        Position,  ///< Location of sf_position
+        Color,     ///< Location of sf_color
+        TexCoords  ///< Location of sf_texCoords
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Matrices provided to the shaders
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Matrix
+    {
+        ViewProjection, ///< Projection of the current view, sf_viewProjection uniform
+        Model,          ///< Transform of the entity, sf_model uniform
+        TextureMatrix,  ///< Conversion to normalized texture coordinates, sf_textureMatrix uniform
+        MatrixCount     ///< Keep last, number of matrices
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The OpenGL objects are created on first bind.
+    ///
+    ////////////////////////////////////////////////////////////
+    CorePipeline();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~CorePipeline();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the system supports the core pipeline
+    ///
+    /// \return True if shaders, vertex buffers and vertex array
+    ///         objects are available
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the active context uses a core profile
+    ///
+    /// \return True if the fixed-function pipeline is unavailable
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isCoreContext();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the names of the uniforms holding the matrices
+    ///
+    /// \return Array of MatrixCount names, indexed by Matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    static const char* const* getMatrixNames();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind the vertex array object and the built-in program
+    ///
+    /// The objects are created on first call.
+    ///
+    /// \return True on success, false if the objects couldn't be created
+    ///
+    ////////////////////////////////////////////////////////////
+    bool bind();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unbind the vertex array object and the program
+    ///
+    ////////////////////////////////////////////////////////////
+    void unbind();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind the built-in program again after a custom shader
+    ///
+    /// The uniforms changed while another program was bound
+    /// are uploaded.
+    ///
+    ////////////////////////////////////////////////////////////
+    void bindProgram();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell that a custom shader replaced the built-in program
+    ///
+    /// Until the next call to bindProgram, the uniforms of the
+    /// built-in program are kept aside instead of being uploaded.
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseProgram();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a matrix of the built-in program
+    ///
+    /// \param matrix    Matrix to change
+    /// \param transform New value of the matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMatrix(Matrix matrix, const Transform& transform);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the current texture must be sampled
+    ///
+    /// \param textured True if a texture is bound
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTextured(bool textured);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the current matrices to the bound custom shader
+    ///
+    /// \param locations Locations of the matrix uniforms in the
+    ///                  custom shader, -1 for the unused ones
+    ///
+    ////////////////////////////////////////////////////////////
+    void uploadMatrices(const int* locations) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload vertices to the internal stream buffer
+    ///
+    /// The attribute pointers are set up to source the
+    /// uploaded vertices.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    ///
+    /// \return Index of the first uploaded vertex in the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t stream(const Vertex* vertices, std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload indices to the internal index buffer
+    ///
+    /// The vertex array object must be bound, the index buffer
+    /// stays bound to it so that the next indexed draw call
+    /// sources the uploaded indices, starting at offset 0.
+    ///
+    /// \param indices    Pointer to the indices
+    /// \param indexCount Number of indices in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void streamIndices(const Uint32* indices, std::size_t indexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set up the attribute pointers for the bound vertex buffer
+    ///
+    /// The vertices are assumed to be tightly packed sf::Vertex
+    /// structures, or sf::CompactVertex structures if \a compact
+    /// is true, starting at offset 0 of the buffer.
+    ///
+    /// \param compact Does the buffer store compact vertices?
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setAttributePointers(bool compact = false);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the program and stream buffers
+    ///
+    /// \return True on success
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the vertex array object of the active context
+    ///
+    /// \return True on success
+    ///
+    ////////////////////////////////////////////////////////////
+    bool createVertexArray();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int m_program;                      ///< Built-in program
+    unsigned int m_vertexArray;                  ///< Vertex array object holding the attribute states
+    Uint64       m_vertexArrayContext;           ///< Context the vertex array object belongs to
+    unsigned int m_streamBuffer;                 ///< Buffer receiving the vertices drawn from client memory
+    std::size_t  m_streamCapacity;               ///< Number of vertices that fit in the stream buffer
+    unsigned int m_indexBuffer;                  ///< Buffer receiving the indices drawn from client memory
+    std::size_t  m_indexCapacity;                ///< Number of indices that fit in the index buffer
+    int          m_matrixLocations[MatrixCount]; ///< Locations of the matrices in the built-in program
+    int          m_texturedLocation;             ///< Location of the textured flag in the built-in program
+    Transform    m_matrices[MatrixCount];        ///< Current value of the matrices
+    bool         m_textured;                     ///< Current value of the textured flag
+    bool         m_programBound;                 ///< Is the built-in program the current one?
+    bool         m_uniformsChanged;              ///< Were uniforms changed while the program wasn't bound?
+    bool         m_failed;                       ///< Did the creation of the objects fail?
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_COREPIPELINE_HPP
@@ -27,16 +27,20 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GlyphRasterizer.hpp>
+#include <SFML/Graphics/Shader.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/ResourceStream.hpp>
 #endif
+#include <SFML/System/FileInputStream.hpp>
 #include <SFML/System/InputStream.hpp>
+#include <SFML/System/MemoryInputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Profiler.hpp>
 #include <ft2build.h>
 #include FT_FREETYPE_H
-#include FT_GLYPH_H
-#include FT_OUTLINE_H
-#include FT_BITMAP_H
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <cstring>
 
@@ -60,6 +64,71 @@ namespace
     void close(FT_Stream)
     {
     }
+
+    // Reference size and outline distance range of the distance field glyphs
+    const unsigned int distanceFieldSize = 48;
+    const int distanceFieldSpread = 6;
+
+    // Keys of the distance field pages in the page table
+    const sf::Uint32 distanceFieldPageKey = 0xFFFFFFFF;
+    const sf::Uint32 metricsPageFlag = 0x80000000;
+
+    // Antialiasing of the distance field glyphs, the outline is at 0.5
+    const char* distanceFieldSource =
+        "uniform sampler2D texture;\n"
+        "void main()\n"
+        "{\n"
+        "    float distance = texture2D(texture, gl_TexCoord[0].xy).a;\n"
+        "    float width = fwidth(distance);\n"
+        "    float alpha = smoothstep(0.5 - width, 0.5 + width, distance);\n"
+        "    gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * alpha);\n"
+        "}\n";
+
+    // Compute the signed distance field of a glyph bitmap (one coverage byte per pixel),
+    // the field has a border of the spread size around the bitmap
+    void computeDistanceField(const sf::Uint8* pixels, int width, int height, std::vector<sf::Uint8>& field)
+    {
+        const int spread = distanceFieldSpread;
+        int fieldWidth = width + 2 * spread;
+        int fieldHeight = height + 2 * spread;
+        field.assign(fieldWidth * fieldHeight, 0);
+
+        for (int y = 0; y < fieldHeight; ++y)
+        {
+            for (int x = 0; x < fieldWidth; ++x)
+            {
+                int sourceX = x - spread;
+                int sourceY = y - spread;
+                bool inside = (sourceX >= 0) && (sourceY >= 0) && (sourceX < width) && (sourceY < height) &&
+                              (pixels[sourceX + sourceY * width] >= 128);
+
+                // Find the closest pixel on the other side of the outline, within the spread
+                int best = (spread + 1) * (spread + 1);
+                for (int dy = -spread; dy <= spread; ++dy)
+                {
+                    int otherY = sourceY + dy;
+                    for (int dx = -spread; dx <= spread; ++dx)
+                    {
+                        int distance = dx * dx + dy * dy;
+                        if (distance >= best)
+                            continue;
+
+                        int otherX = sourceX + dx;
+                        bool otherInside = (otherX >= 0) && (otherY >= 0) && (otherX < width) && (otherY < height) &&
+                                           (pixels[otherX + otherY * width] >= 128);
+                        if (otherInside != inside)
+                            best = distance;
+                    }
+                }
+
+                // The outline lies between the two pixel centers
+                float distance = std::sqrt(static_cast<float>(best)) - 0.5f;
+                float value = 0.5f + (inside ? distance : -distance) / (2.f * spread);
+                value = std::max(0.f, std::min(value, 1.f));
+                field[x + y * fieldWidth] = static_cast<sf::Uint8>(value * 255.f + 0.5f);
+            }
+        }
+    }
 }
 
 
@@ -67,11 +136,23 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Font::Font() :
-m_library  (NULL),
-m_face     (NULL),
-m_streamRec(NULL),
-m_refCount (NULL),
-m_info     ()
+m_library            (NULL),
+m_face               (NULL),
+m_streamRec          (NULL),
+m_mappedFile         (NULL),
+m_refCount           (NULL),
+m_info               (),
+m_memoryData         (NULL),
+m_memorySize         (0),
+m_asyncLoading       (false),
+m_rasterizer         (NULL),
+m_revision           (0),
+m_distanceField      (false),
+m_distanceFieldShader(NULL),
+m_atlas              (NULL),
+m_atlasLine          (),
+m_hinting            (AutoHinting),
+m_memory             (MemoryTracker::Glyphs)
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -81,13 +162,28 @@ m_info     ()
 
 ////////////////////////////////////////////////////////////
 Font::Font(const Font& copy) :
-m_library    (copy.m_library),
-m_face       (copy.m_face),
-m_streamRec  (copy.m_streamRec),
-m_refCount   (copy.m_refCount),
-m_info       (copy.m_info),
-m_pages      (copy.m_pages),
-m_pixelBuffer(copy.m_pixelBuffer)
+m_library            (copy.m_library),
+m_face               (copy.m_face),
+m_streamRec          (copy.m_streamRec),
+m_mappedFile         (copy.m_mappedFile),
+m_refCount           (copy.m_refCount),
+m_info               (copy.m_info),
+m_pages              (copy.m_pages),
+m_pageTable          (copy.m_pageTable),
+m_pixelBuffer        (copy.m_pixelBuffer),
+m_uploadBuffer       (),
+m_fileName           (copy.m_fileName),
+m_memoryData         (copy.m_memoryData),
+m_memorySize         (copy.m_memorySize),
+m_asyncLoading       (copy.m_asyncLoading),
+m_rasterizer         (NULL),
+m_revision           (copy.m_revision),
+m_distanceField      (copy.m_distanceField),
+m_distanceFieldShader(NULL),
+m_atlas              (copy.m_atlas),
+m_atlasLine          (copy.m_atlasLine),
+m_hinting            (copy.m_hinting),
+m_memory             (MemoryTracker::Glyphs)
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -98,6 +194,23 @@ m_pixelBuffer(copy.m_pixelBuffer)
 
     if (m_refCount)
         (*m_refCount)++;
+
+    updateMemoryUsage();
+
+    // The copied pages may contain glyphs that the worker of the
+    // original font is still loading, our own worker must load them too
+    if (copy.m_rasterizer)
+    {
+        startRasterizer();
+
+        if (m_rasterizer)
+        {
+            std::vector<priv::GlyphRasterizer::Request> requests;
+            copy.m_rasterizer->getOutstanding(requests);
+            for (std::vector<priv::GlyphRasterizer::Request>::const_iterator it = requests.begin(); it != requests.end(); ++it)
+                m_rasterizer->request(*it);
+        }
+    }
 }
 
 
@@ -106,6 +219,8 @@ Font::~Font()
 {
     cleanup();
 
+    delete m_distanceFieldShader;
+
     #ifdef SFML_SYSTEM_ANDROID
 
     if (m_stream)
@@ -135,9 +250,26 @@ bool Font::loadFromFile(const std::string& filename)
     }
     m_library = library;
 
-    // Load the new font face from the specified file
+    // Map the file in memory if possible: its pages are then read lazily by the system,
+    // and shared with the other processes using the same font
+    FileInputStream* file = new FileInputStream;
+    FT_Error error;
     FT_Face face;
-    if (FT_New_Face(static_cast<FT_Library>(m_library), filename.c_str(), 0, &face) != 0)
+    if (file->open(filename) && file->getData())
+    {
+        m_mappedFile = file;
+        m_memoryData = file->getData();
+        m_memorySize = static_cast<std::size_t>(file->getSize());
+        error = FT_New_Memory_Face(static_cast<FT_Library>(m_library), reinterpret_cast<const FT_Byte*>(m_memoryData), static_cast<FT_Long>(m_memorySize), 0, &face);
+    }
+    else
+    {
+        // Load the new font face from the specified file
+        delete file;
+        error = FT_New_Face(static_cast<FT_Library>(m_library), filename.c_str(), 0, &face);
+    }
+
+    if (error != 0)
     {
         err() << "Failed to load font \"" << filename << "\" (failed to create the font face)" << std::endl;
         return false;
@@ -157,6 +289,11 @@ bool Font::loadFromFile(const std::string& filename)
     // Store the font information
     m_info.family = face->family_name ? face->family_name : std::string();
 
+    // Remember the source, so that the glyph loading thread can open it too
+    m_fileName = filename;
+    if (m_asyncLoading)
+        startRasterizer();
+
     return true;
 
     #else
@@ -211,6 +348,12 @@ bool Font::loadFromMemory(const void* data, std::size_t sizeInBytes)
     // Store the font information
     m_info.family = face->family_name ? face->family_name : std::string();
 
+    // Remember the source, so that the glyph loading thread can open it too
+    m_memoryData = data;
+    m_memorySize = sizeInBytes;
+    if (m_asyncLoading)
+        startRasterizer();
+
     return true;
 }
 
@@ -236,14 +379,22 @@ bool Font::loadFromStream(InputStream& stream)
     // Make sure that the stream's reading position is at the beginning
     stream.seek(0);
 
+    // If the whole stream is accessible in memory (mapped file or memory
+    // stream), FreeType reads it in place instead of going through callbacks
+    const void* data = NULL;
+    if (FileInputStream* file = dynamic_cast<FileInputStream*>(&stream))
+        data = file->getData();
+    else if (MemoryInputStream* memory = dynamic_cast<MemoryInputStream*>(&stream))
+        data = memory->getData();
+
     // Prepare a wrapper for our stream, that we'll pass to FreeType callbacks
     FT_StreamRec* rec = new FT_StreamRec;
     std::memset(rec, 0, sizeof(*rec));
-    rec->base               = NULL;
+    rec->base               = static_cast<unsigned char*>(const_cast<void*>(data));
     rec->size               = static_cast<unsigned long>(stream.getSize());
     rec->pos                = 0;
     rec->descriptor.pointer = &stream;
-    rec->read               = &read;
+    rec->read               = data ? NULL : &read;
     rec->close              = &close;
 
     // Setup the FreeType callbacks that will read our stream
@@ -291,122 +442,461 @@ const Font::Info& Font::getInfo() const
 ////////////////////////////////////////////////////////////
 const Glyph& Font::getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const
 {
+    if (m_distanceField)
+        return getDistanceFieldGlyph(codePoint, characterSize, bold);
+
     // Get the page corresponding to the character size
-    GlyphTable& glyphs = m_pages[characterSize].glyphs;
+    return findGlyph(getPage(characterSize), codePoint, characterSize, bold, NULL);
+}
 
-    // Build the key by combining the code point and the bold flag
-    Uint32 key = ((bold ? 1 : 0) << 31) | codePoint;
 
-    // Search the glyph into the cache
-    GlyphTable::const_iterator it = glyphs.find(key);
-    if (it != glyphs.end())
+////////////////////////////////////////////////////////////
+void Font::preloadGlyphs(const String& characters, unsigned int characterSize, bool bold) const
+{
+    // Distance field glyphs are loaded once for all the sizes, and the atlas
+    // packs glyphs one by one: there's not much to gain
+    if (m_distanceField || m_atlas)
     {
-        // Found: just return it
-        return it->second;
+        for (String::ConstIterator it = characters.begin(); it != characters.end(); ++it)
+            getGlyph(*it, characterSize, bold);
+
+        return;
     }
-    else
+
+    Page& page = getPage(characterSize);
+
+    // Remember where the rows ended, new glyphs are placed after
+    std::size_t rowCount = page.rows.size();
+    std::vector<unsigned int> rowWidths(rowCount);
+    for (std::size_t i = 0; i < rowCount; ++i)
+        rowWidths[i] = page.rows[i].width;
+    unsigned int nextRow = page.nextRow;
+
+    // Rasterize all the missing glyphs
+    GlyphBatch batch;
+    for (String::ConstIterator it = characters.begin(); it != characters.end(); ++it)
+        findGlyph(page, *it, characterSize, bold, &batch);
+
+    if (batch.rects.empty())
+        return;
+
+    // Upload the end of the existing rows that received glyphs...
+    for (std::size_t i = 0; i < rowCount; ++i)
     {
-        // Not found: we have to load it
-        Glyph glyph = loadGlyph(codePoint, characterSize, bold);
-        return glyphs.insert(std::make_pair(key, glyph)).first->second;
+        const Row& row = page.rows[i];
+        if (row.width != rowWidths[i])
+            uploadRegion(page, IntRect(rowWidths[i], row.top, row.width - rowWidths[i], row.height), batch);
+    }
+
+    // ... and the new rows, all at once
+    if (page.nextRow != nextRow)
+    {
+        unsigned int width = 0;
+        for (std::size_t i = rowCount; i < page.rows.size(); ++i)
+            width = std::max(width, page.rows[i].width);
+
+        uploadRegion(page, IntRect(0, nextRow, width, page.nextRow - nextRow), batch);
     }
+
+    // Force an OpenGL flush, so that the font's texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
 }
 
 
 ////////////////////////////////////////////////////////////
-float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize) const
+void Font::setAsyncLoadingEnabled(bool enabled)
 {
-    // Special case where first or second is 0 (null character)
-    if (first == 0 || second == 0)
-        return 0.f;
+    if (enabled == m_asyncLoading)
+        return;
 
-    FT_Face face = static_cast<FT_Face>(m_face);
+    m_asyncLoading = enabled;
 
-    if (face && FT_HAS_KERNING(face) && setCurrentSize(characterSize))
+    if (enabled)
     {
-        // Convert the characters to indices
-        FT_UInt index1 = FT_Get_Char_Index(face, first);
-        FT_UInt index2 = FT_Get_Char_Index(face, second);
+        startRasterizer();
+    }
+    else if (m_rasterizer)
+    {
+        // Take the glyphs that are ready, and load the others here
+        collectGlyphs();
+
+        std::vector<priv::GlyphRasterizer::Request> requests;
+        m_rasterizer->getOutstanding(requests);
+
+        delete m_rasterizer;
+        m_rasterizer = NULL;
+
+        for (std::vector<priv::GlyphRasterizer::Request>::const_iterator it = requests.begin(); it != requests.end(); ++it)
+        {
+            Page& page = getPage(it->characterSize);
+
+            std::size_t index;
+            if (findGlyphIndex(page, it->codePoint, it->bold, index))
+                page.glyphs[index] = loadGlyph(it->codePoint, it->characterSize, it->bold);
+        }
+
+        if (!requests.empty())
+            m_revision++;
+    }
+}
 
-        // Get the kerning vector
-        FT_Vector kerning;
-        FT_Get_Kerning(face, index1, index2, FT_KERNING_DEFAULT, &kerning);
 
-        // X advance is already in pixels for bitmap fonts
-        if (!FT_IS_SCALABLE(face))
-            return static_cast<float>(kerning.x);
+////////////////////////////////////////////////////////////
+bool Font::isAsyncLoadingEnabled() const
+{
+    return m_asyncLoading;
+}
+
+
+////////////////////////////////////////////////////////////
+const Glyph& Font::findGlyph(Page& page, Uint32 codePoint, unsigned int characterSize, bool bold, GlyphBatch* batch) const
+{
+    std::size_t index;
+    if (!findGlyphIndex(page, codePoint, bold, index))
+    {
+        // Not found: we have to load it, or to let the worker load it
+        // (preloading is always synchronous, it is requested explicitly)
+        Glyph glyph;
+        if (m_rasterizer && !batch)
+        {
+            priv::GlyphRasterizer::Request request = {codePoint, characterSize, bold, m_hinting};
+            m_rasterizer->request(request);
+        }
+        else
+        {
+            glyph = loadGlyph(codePoint, characterSize, bold, batch);
+        }
 
-        // Return the X advance
-        return static_cast<float>(kerning.x) / static_cast<float>(1 << 6);
+        index = insertGlyph(page, codePoint, bold, glyph);
+        updateMemoryUsage();
     }
+
+    return page.glyphs[index];
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Font::insertGlyph(Page& page, Uint32 codePoint, bool bold, const Glyph& glyph)
+{
+    page.glyphs.push_back(glyph);
+    std::size_t index = page.glyphs.size() - 1;
+
+    // Latin-1 characters are indexed directly, the others through the hash table
+    if (codePoint < Page::Latin1Size)
+        page.latin1[(bold ? Page::Latin1Size : 0) + codePoint] = static_cast<Uint32>(index + 1);
     else
+        page.glyphTable.insert(((bold ? 1 : 0) << 31) | codePoint, index);
+
+    return index;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setDistanceFieldEnabled(bool enabled)
+{
+    if (enabled == m_distanceField)
+        return;
+
+    if (enabled && !Shader::isAvailable())
     {
-        // Invalid font, or no kerning
-        return 0.f;
+        err() << "Failed to enable the distance field mode of the font: shaders are not supported" << std::endl;
+        return;
     }
+
+    // The glyphs returned by getGlyph change, the texts must update their geometry
+    m_distanceField = enabled;
+    m_revision++;
 }
 
 
 ////////////////////////////////////////////////////////////
-float Font::getLineSpacing(unsigned int characterSize) const
+bool Font::isDistanceFieldEnabled() const
 {
+    return m_distanceField;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setHinting(Hinting hinting)
+{
+    if (hinting == m_hinting)
+        return;
+
+    // The loaded glyphs were rasterized with the previous hinting, they must be loaded again
+    m_hinting = hinting;
+    m_pages.clear();
+    m_pageTable.clear();
+    updateMemoryUsage();
+
+    // The glyphs returned by getGlyph change, the texts must update their geometry
+    m_revision++;
+}
+
+
+////////////////////////////////////////////////////////////
+Font::Hinting Font::getHinting() const
+{
+    return m_hinting;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setTextureAtlas(TextureAtlas* atlas)
+{
+    if (atlas == m_atlas)
+        return;
+
+    // The loaded glyphs are in the previous storage, they must be loaded again
+    m_atlas = atlas;
+    m_atlasLine = TextureAtlas::Region();
+    m_pages.clear();
+    m_pageTable.clear();
+    updateMemoryUsage();
+
+    // The glyphs returned by getGlyph change, the texts must update their geometry
+    m_revision++;
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas* Font::getTextureAtlas() const
+{
+    return m_atlas;
+}
+
+
+////////////////////////////////////////////////////////////
+const Shader* Font::getDistanceFieldShader() const
+{
+    if (!m_distanceField)
+        return NULL;
+
+    if (!m_distanceFieldShader)
+    {
+        m_distanceFieldShader = new Shader;
+        if (m_distanceFieldShader->loadFromMemory(distanceFieldSource, Shader::Fragment))
+        {
+            m_distanceFieldShader->setParameter("texture", Shader::CurrentTexture);
+        }
+        else
+        {
+            err() << "Failed to create the distance field shader of the font" << std::endl;
+        }
+    }
+
+    return m_distanceFieldShader;
+}
+
+
+////////////////////////////////////////////////////////////
+Font::Page& Font::getLineMetrics(unsigned int characterSize) const
+{
+    Page& page = getMetricsPage(characterSize);
+    if (page.metricsLoaded)
+        return page;
+
     FT_Face face = static_cast<FT_Face>(m_face);
 
     if (face && setCurrentSize(characterSize))
     {
-        return static_cast<float>(face->size->metrics.height) / static_cast<float>(1 << 6);
+        page.lineSpacing = static_cast<float>(face->size->metrics.height) / static_cast<float>(1 << 6);
+
+        if (FT_IS_SCALABLE(face))
+        {
+            page.underlinePosition = -static_cast<float>(FT_MulFix(face->underline_position, face->size->metrics.y_scale)) / static_cast<float>(1 << 6);
+            page.underlineThickness = static_cast<float>(FT_MulFix(face->underline_thickness, face->size->metrics.y_scale)) / static_cast<float>(1 << 6);
+        }
+        else
+        {
+            // Return a fixed position and thickness if font is a bitmap font
+            page.underlinePosition = characterSize / 10.f;
+            page.underlineThickness = characterSize / 14.f;
+        }
+
+        page.metricsLoaded = true;
     }
-    else
+
+    return page;
+}
+
+
+////////////////////////////////////////////////////////////
+const Glyph& Font::getDistanceFieldGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const
+{
+    // The glyphs scaled to the character size are cached, so that references to them stay valid
+    Page& metrics = getMetricsPage(characterSize);
+
+    std::size_t index;
+    if (!findGlyphIndex(metrics, codePoint, bold, index))
     {
-        return 0.f;
+        // Get the glyph at the reference size
+        Page& page = getPage(distanceFieldPageKey);
+
+        std::size_t fieldIndex;
+        if (!findGlyphIndex(page, codePoint, bold, fieldIndex))
+            fieldIndex = insertGlyph(page, codePoint, bold, loadDistanceFieldGlyph(codePoint, bold));
+
+        // Scale its metrics, the texture rectangle stays in the distance field texture
+        Glyph glyph = page.glyphs[fieldIndex];
+        float scale = static_cast<float>(characterSize) / distanceFieldSize;
+        glyph.advance *= scale;
+        glyph.bounds.left *= scale;
+        glyph.bounds.top *= scale;
+        glyph.bounds.width *= scale;
+        glyph.bounds.height *= scale;
+
+        index = insertGlyph(metrics, codePoint, bold, glyph);
+        updateMemoryUsage();
     }
+
+    return metrics.glyphs[index];
 }
 
 
 ////////////////////////////////////////////////////////////
-float Font::getUnderlinePosition(unsigned int characterSize) const
+Glyph Font::loadDistanceFieldGlyph(Uint32 codePoint, bool bold) const
 {
-    FT_Face face = static_cast<FT_Face>(m_face);
+    Glyph glyph;
 
-    if (face && setCurrentSize(characterSize))
+    // Rasterize the glyph at the reference size
+    if (!m_face || !setCurrentSize(distanceFieldSize))
+        return glyph;
+
+    unsigned int width;
+    unsigned int height;
+    if (!priv::GlyphRasterizer::rasterize(m_library, m_face, codePoint, bold, m_hinting, glyph, m_pixelBuffer, width, height))
+        return glyph;
+
+    if ((width > 0) && (height > 0))
     {
-        // Return a fixed position if font is a bitmap font
-        if (!FT_IS_SCALABLE(face))
-            return characterSize / 10.f;
+        // Convert the coverage to a distance field, which extends around the bitmap
+        std::vector<Uint8> field;
+        computeDistanceField(&m_pixelBuffer[0], width, height, field);
 
-        return -static_cast<float>(FT_MulFix(face->underline_position, face->size->metrics.y_scale)) / static_cast<float>(1 << 6);
+        glyph.bounds.left -= distanceFieldSpread;
+        glyph.bounds.top -= distanceFieldSpread;
+        glyph.bounds.width += 2 * distanceFieldSpread;
+        glyph.bounds.height += 2 * distanceFieldSpread;
+
+        writeGlyph(getPage(distanceFieldPageKey), glyph, &field[0], width + 2 * distanceFieldSpread, height + 2 * distanceFieldSpread, NULL);
+
+        // Force an OpenGL flush, so that the font's texture will appear updated
+        // in all contexts immediately (solves problems in multi-threaded apps)
+        glCheck(glFlush());
     }
-    else
+
+    return glyph;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::findGlyphIndex(const Page& page, Uint32 codePoint, bool bold, std::size_t& index)
+{
+    // Latin-1 characters are indexed directly
+    if (codePoint < Page::Latin1Size)
     {
-        return 0.f;
+        Uint32 slot = page.latin1[(bold ? Page::Latin1Size : 0) + codePoint];
+        if (!slot)
+            return false;
+
+        index = slot - 1;
+        return true;
     }
+
+    // Build the key by combining the code point and the bold flag
+    Uint32 key = ((bold ? 1 : 0) << 31) | codePoint;
+
+    return page.glyphTable.find(key, index);
 }
 
 
 ////////////////////////////////////////////////////////////
-float Font::getUnderlineThickness(unsigned int characterSize) const
+float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize) const
 {
+    // Special case where first or second is 0 (null character)
+    if (first == 0 || second == 0)
+        return 0.f;
+
     FT_Face face = static_cast<FT_Face>(m_face);
 
-    if (face && setCurrentSize(characterSize))
+    if (face && FT_HAS_KERNING(face))
     {
-        // Return a fixed thickness if font is a bitmap font
-        if (!FT_IS_SCALABLE(face))
-            return characterSize / 14.f;
+        // Search the pair in the cache of the character size
+        Page& page = getMetricsPage(characterSize);
+        Uint64 key = (static_cast<Uint64>(first) << 32) | second;
 
-        return static_cast<float>(FT_MulFix(face->underline_thickness, face->size->metrics.y_scale)) / static_cast<float>(1 << 6);
+        std::size_t index;
+        if (!page.kerningTable.find(key, index))
+        {
+            float kerning = 0.f;
+            if (setCurrentSize(characterSize))
+            {
+                // Convert the characters to indices
+                FT_UInt index1 = FT_Get_Char_Index(face, first);
+                FT_UInt index2 = FT_Get_Char_Index(face, second);
+
+                // Get the kerning vector
+                FT_Vector vector;
+                FT_Get_Kerning(face, index1, index2, FT_KERNING_DEFAULT, &vector);
+
+                // X advance is already in pixels for bitmap fonts
+                if (!FT_IS_SCALABLE(face))
+                    kerning = static_cast<float>(vector.x);
+                else
+                    kerning = static_cast<float>(vector.x) / static_cast<float>(1 << 6);
+            }
+
+            page.kernings.push_back(kerning);
+            index = page.kernings.size() - 1;
+            page.kerningTable.insert(key, index);
+            updateMemoryUsage();
+        }
+
+        return page.kernings[index];
     }
     else
     {
+        // Invalid font, or no kerning
         return 0.f;
     }
 }
 
 
+////////////////////////////////////////////////////////////
+float Font::getLineSpacing(unsigned int characterSize) const
+{
+    return getLineMetrics(characterSize).lineSpacing;
+}
+
+
+////////////////////////////////////////////////////////////
+float Font::getUnderlinePosition(unsigned int characterSize) const
+{
+    return getLineMetrics(characterSize).underlinePosition;
+}
+
+
+////////////////////////////////////////////////////////////
+float Font::getUnderlineThickness(unsigned int characterSize) const
+{
+    return getLineMetrics(characterSize).underlineThickness;
+}
+
+
 ////////////////////////////////////////////////////////////
 const Texture& Font::getTexture(unsigned int characterSize) const
 {
-    return m_pages[characterSize].texture;
+    // The atlas has no texture per size, give the page used for underlines
+    if (m_atlas && !m_distanceField)
+    {
+        Vector2f texCoords;
+        const Texture* texture = getLineTexture(texCoords);
+        if (texture)
+            return *texture;
+    }
+
+    return getPage(m_distanceField ? distanceFieldPageKey : characterSize).texture;
 }
 
 
@@ -415,13 +905,28 @@ Font& Font::operator =(const Font& right)
 {
     Font temp(right);
 
-    std::swap(m_library,     temp.m_library);
-    std::swap(m_face,        temp.m_face);
-    std::swap(m_streamRec,   temp.m_streamRec);
-    std::swap(m_refCount,    temp.m_refCount);
-    std::swap(m_info,        temp.m_info);
-    std::swap(m_pages,       temp.m_pages);
-    std::swap(m_pixelBuffer, temp.m_pixelBuffer);
+    std::swap(m_library,             temp.m_library);
+    std::swap(m_face,                temp.m_face);
+    std::swap(m_streamRec,           temp.m_streamRec);
+    std::swap(m_mappedFile,          temp.m_mappedFile);
+    std::swap(m_refCount,            temp.m_refCount);
+    std::swap(m_info,                temp.m_info);
+    std::swap(m_pages,               temp.m_pages);
+    std::swap(m_pageTable,           temp.m_pageTable);
+    std::swap(m_pixelBuffer,         temp.m_pixelBuffer);
+    std::swap(m_uploadBuffer,        temp.m_uploadBuffer);
+    std::swap(m_fileName,            temp.m_fileName);
+    std::swap(m_memoryData,          temp.m_memoryData);
+    std::swap(m_memorySize,          temp.m_memorySize);
+    std::swap(m_asyncLoading,        temp.m_asyncLoading);
+    std::swap(m_rasterizer,          temp.m_rasterizer);
+    std::swap(m_revision,            temp.m_revision);
+    std::swap(m_distanceField,       temp.m_distanceField);
+    std::swap(m_distanceFieldShader, temp.m_distanceFieldShader);
+    std::swap(m_atlas,               temp.m_atlas);
+    std::swap(m_atlasLine,           temp.m_atlasLine);
+    std::swap(m_hinting,             temp.m_hinting);
+    updateMemoryUsage();
 
     return *this;
 }
@@ -430,6 +935,10 @@ Font& Font::operator =(const Font& right)
 ////////////////////////////////////////////////////////////
 void Font::cleanup()
 {
+    // Stop the glyph loading thread first, it uses the font source
+    delete m_rasterizer;
+    m_rasterizer = NULL;
+
     // Check if we must destroy the FreeType pointers
     if (m_refCount)
     {
@@ -450,6 +959,9 @@ void Font::cleanup()
             if (m_streamRec)
                 delete static_cast<FT_StreamRec*>(m_streamRec);
 
+            // Unmap the font file, if any (must be done after FT_Done_Face too)
+            delete m_mappedFile;
+
             // Close the library
             if (m_library)
                 FT_Done_FreeType(static_cast<FT_Library>(m_library));
@@ -457,140 +969,349 @@ void Font::cleanup()
     }
 
     // Reset members
-    m_library   = NULL;
-    m_face      = NULL;
-    m_streamRec = NULL;
-    m_refCount  = NULL;
+    m_library    = NULL;
+    m_face       = NULL;
+    m_streamRec  = NULL;
+    m_mappedFile = NULL;
+    m_refCount   = NULL;
     m_pages.clear();
+    m_pageTable.clear();
     m_pixelBuffer.clear();
+    m_uploadBuffer.clear();
+    m_fileName.clear();
+    m_memoryData = NULL;
+    m_memorySize = 0;
+    updateMemoryUsage();
 }
 
 
 ////////////////////////////////////////////////////////////
-Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const
+void Font::updateMemoryUsage() const
 {
+    Uint64 bytes = m_pixelBuffer.capacity() + m_uploadBuffer.capacity();
+    for (PageTable::const_iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+    {
+        bytes += it->glyphs.size() * sizeof(Glyph);
+        bytes += it->rows.capacity() * sizeof(Row);
+        bytes += it->kernings.capacity() * sizeof(float);
+    }
+
+    m_memory.setBytes(bytes);
+}
+
+
+////////////////////////////////////////////////////////////
+Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, GlyphBatch* batch) const
+{
+    SFML_PROFILE_ZONE("Font::loadGlyph");
+
     // The glyph to return
     Glyph glyph;
 
-    // First, transform our ugly void* to a FT_Face
-    FT_Face face = static_cast<FT_Face>(m_face);
-    if (!face)
+    // First, make sure that we have a face
+    if (!m_face)
         return glyph;
 
     // Set the character size
     if (!setCurrentSize(characterSize))
         return glyph;
 
-    // Load the glyph corresponding to the code point
-    if (FT_Load_Char(face, codePoint, FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT) != 0)
+    // Rasterize the glyph
+    unsigned int width;
+    unsigned int height;
+    if (!priv::GlyphRasterizer::rasterize(m_library, m_face, codePoint, bold, m_hinting, glyph, m_pixelBuffer, width, height))
         return glyph;
 
-    // Retrieve the glyph
-    FT_Glyph glyphDesc;
-    if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
-        return glyph;
+    // Write it to the texture of its page
+    if ((width > 0) && (height > 0))
+        writeGlyph(getPage(characterSize), glyph, &m_pixelBuffer[0], width, height, batch);
 
-    // Apply bold if necessary -- first technique using outline (highest quality)
-    FT_Pos weight = 1 << 6;
-    bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
-    if (bold && outline)
+    // Force an OpenGL flush, so that the font's texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    if (!batch)
     {
-        FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
-        FT_Outline_Embolden(&outlineGlyph->outline, weight);
+        glCheck(glFlush());
     }
 
-    // Convert the glyph to a bitmap (i.e. rasterize it)
-    FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
-    FT_Bitmap& bitmap = reinterpret_cast<FT_BitmapGlyph>(glyphDesc)->bitmap;
+    // Done :)
+    return glyph;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::writeGlyph(Page& page, Glyph& glyph, const Uint8* pixels, unsigned int width, unsigned int height, GlyphBatch* batch) const
+{
+    // Pages without texture store their glyphs in the atlas
+    if (m_atlas && (page.texture.getSize().x == 0))
+    {
+        writeAtlasGlyph(glyph, pixels, width, height);
+        return;
+    }
 
-    // Apply bold if necessary -- fallback technique using bitmap (lower quality)
-    if (bold && !outline)
+    // Leave a small padding around characters, so that filtering doesn't
+    // pollute them with pixels from neighbors
+    const unsigned int padding = 1;
+
+    // Find a good position for the new glyph into the texture
+    glyph.textureRect = findGlyphRect(page, width + 2 * padding, height + 2 * padding);
+
+    // Make sure the texture data is positioned in the center
+    // of the allocated texture rectangle
+    glyph.textureRect.left += padding;
+    glyph.textureRect.top += padding;
+    glyph.textureRect.width -= 2 * padding;
+    glyph.textureRect.height -= 2 * padding;
+
+    // Write the pixels to the texture, or keep them for the batch upload
+    unsigned int x = glyph.textureRect.left;
+    unsigned int y = glyph.textureRect.top;
+    unsigned int w = glyph.textureRect.width;
+    unsigned int h = glyph.textureRect.height;
+    if (batch)
     {
-        FT_Bitmap_Embolden(static_cast<FT_Library>(m_library), &bitmap, weight, weight);
+        batch->rects.push_back(glyph.textureRect);
+        batch->offsets.push_back(batch->pixels.size());
+        batch->pixels.insert(batch->pixels.end(), pixels, pixels + w * h);
     }
+    else
+    {
+        // The texture is RGBA, the coverage goes to the alpha channel of white pixels
+        m_uploadBuffer.assign(w * h * 4, 255);
+        for (std::size_t i = 0; i < w * h; ++i)
+            m_uploadBuffer[i * 4 + 3] = pixels[i];
 
-    // Compute the glyph's advance offset
-    glyph.advance = static_cast<float>(face->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6);
-    if (bold)
-        glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6);
+        page.texture.update(&m_uploadBuffer[0], w, h, x, y);
+        updateMemoryUsage();
+    }
+}
 
-    int width  = bitmap.width;
-    int height = bitmap.rows;
 
-    if ((width > 0) && (height > 0))
+////////////////////////////////////////////////////////////
+void Font::writeAtlasGlyph(Glyph& glyph, const Uint8* pixels, unsigned int width, unsigned int height) const
+{
+    // Leave a small padding around characters, so that filtering doesn't
+    // pollute them with pixels from neighbors
+    const unsigned int padding = 1;
+
+    // Surround the pixels with transparent white, like the unused parts of the texture
+    unsigned int paddedWidth  = width + 2 * padding;
+    unsigned int paddedHeight = height + 2 * padding;
+    std::vector<Uint8> padded(paddedWidth * paddedHeight * 4, 255);
+    for (std::size_t i = 3; i < padded.size(); i += 4)
+        padded[i] = 0;
+    for (unsigned int y = 0; y < height; ++y)
     {
-        // Leave a small padding around characters, so that filtering doesn't
-        // pollute them with pixels from neighbors
-        const unsigned int padding = 1;
-
-        // Get the glyphs page corresponding to the character size
-        Page& page = m_pages[characterSize];
-
-        // Find a good position for the new glyph into the texture
-        glyph.textureRect = findGlyphRect(page, width + 2 * padding, height + 2 * padding);
-
-        // Make sure the texture data is positioned in the center
-        // of the allocated texture rectangle
-        glyph.textureRect.left += padding;
-        glyph.textureRect.top += padding;
-        glyph.textureRect.width -= 2 * padding;
-        glyph.textureRect.height -= 2 * padding;
-
-        // Compute the glyph's bounding box
-        glyph.bounds.left   = static_cast<float>(face->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
-        glyph.bounds.top    = -static_cast<float>(face->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
-        glyph.bounds.width  = static_cast<float>(face->glyph->metrics.width) / static_cast<float>(1 << 6);
-        glyph.bounds.height = static_cast<float>(face->glyph->metrics.height) / static_cast<float>(1 << 6);
-
-        // Extract the glyph's pixels from the bitmap
-        m_pixelBuffer.resize(width * height * 4, 255);
-        const Uint8* pixels = bitmap.buffer;
-        if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
-        {
-            // Pixels are 1 bit monochrome values
-            for (int y = 0; y < height; ++y)
-            {
-                for (int x = 0; x < width; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = (x + y * width) * 4 + 3;
-                    m_pixelBuffer[index] = ((pixels[x / 8]) & (1 << (7 - (x % 8)))) ? 255 : 0;
-                }
-                pixels += bitmap.pitch;
-            }
-        }
-        else
-        {
-            // Pixels are 8 bits gray levels
-            for (int y = 0; y < height; ++y)
-            {
-                for (int x = 0; x < width; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = (x + y * width) * 4 + 3;
-                    m_pixelBuffer[index] = pixels[x];
-                }
-                pixels += bitmap.pitch;
-            }
-        }
+        Uint8* destination = &padded[((y + padding) * paddedWidth + padding) * 4];
+        for (unsigned int x = 0; x < width; ++x)
+            destination[x * 4 + 3] = pixels[y * width + x];
+    }
+
+    Image image;
+    image.create(paddedWidth, paddedHeight, &padded[0]);
+
+    TextureAtlas::Region region;
+    if (!m_atlas->add(image, region))
+    {
+        err() << "Failed to add a new character to the font: no room left in the texture atlas" << std::endl;
+        return;
+    }
+
+    // Make sure the texture data is positioned in the center
+    // of the allocated texture rectangle
+    glyph.texture = region.texture;
+    glyph.textureRect = IntRect(region.rect.left + padding, region.rect.top + padding, width, height);
+}
+
 
-        // Write the pixels to the texture
-        unsigned int x = glyph.textureRect.left;
-        unsigned int y = glyph.textureRect.top;
-        unsigned int w = glyph.textureRect.width;
-        unsigned int h = glyph.textureRect.height;
-        page.texture.update(&m_pixelBuffer[0], w, h, x, y);
+////////////////////////////////////////////////////////////
+void Font::startRasterizer()
+{
+    if (!m_face)
+        return;
+
+    priv::GlyphRasterizer* rasterizer = new priv::GlyphRasterizer;
+
+    bool opened = false;
+    if (m_memoryData)
+        opened = rasterizer->openFromMemory(m_memoryData, m_memorySize);
+    else if (!m_fileName.empty())
+        opened = rasterizer->openFromFile(m_fileName);
+    else
+        err() << "Failed to load glyphs in the background: only fonts loaded from a file or from memory are supported" << std::endl;
+
+    if (opened)
+    {
+        m_rasterizer = rasterizer;
+    }
+    else
+    {
+        delete rasterizer;
     }
+}
 
-    // Delete the FT glyph
-    FT_Done_Glyph(glyphDesc);
+
+////////////////////////////////////////////////////////////
+void Font::collectGlyphs() const
+{
+    if (!m_rasterizer)
+        return;
+
+    std::vector<priv::GlyphRasterizer::Result> results;
+    m_rasterizer->collect(results);
+    if (results.empty())
+        return;
+
+    // Replace the empty glyphs by the loaded ones
+    for (std::vector<priv::GlyphRasterizer::Result>::iterator it = results.begin(); it != results.end(); ++it)
+    {
+        // Glyphs requested before the hinting changed are outdated
+        const priv::GlyphRasterizer::Request& request = it->request;
+        if (request.hinting != m_hinting)
+            continue;
+
+        Page& page = getPage(request.characterSize);
+
+        std::size_t index;
+        if (!findGlyphIndex(page, request.codePoint, request.bold, index))
+            continue;
+
+        Glyph& glyph = page.glyphs[index];
+        glyph = it->glyph;
+        if ((it->width > 0) && (it->height > 0))
+            writeGlyph(page, glyph, &it->pixels[0], it->width, it->height, NULL);
+    }
 
     // Force an OpenGL flush, so that the font's texture will appear updated
     // in all contexts immediately (solves problems in multi-threaded apps)
     glCheck(glFlush());
 
-    // Done :)
-    return glyph;
+    // Let the texts know that they must update their geometry
+    m_revision++;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::prepareLayout(const String& string, unsigned int characterSize, bool bold) const
+{
+    // Glyphs loaded in the background are only requested, the others are uploaded at once
+    if (m_rasterizer)
+    {
+        for (String::ConstIterator it = string.begin(); it != string.end(); ++it)
+            getGlyph(*it, characterSize, bold);
+    }
+    else
+    {
+        preloadGlyphs(string, characterSize, bold);
+    }
+
+    // The space gives the width of whitespace, the 'x' the position of the strike through
+    getGlyph(L' ', characterSize, bold);
+    getGlyph(L'x', characterSize, bold);
+
+    // The layout only queries the kerning of consecutive characters
+    for (std::size_t i = 1; i < string.getSize(); ++i)
+        getKerning(string[i - 1], string[i], characterSize);
+
+    getLineMetrics(characterSize);
+
+    Vector2f texCoords;
+    getLineTexture(texCoords);
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::uploadRegion(Page& page, const IntRect& region, const GlyphBatch& batch) const
+{
+    if ((region.width <= 0) || (region.height <= 0))
+        return;
+
+    // Start from transparent white, like the unused parts of the texture
+    std::vector<Uint8> pixels(region.width * region.height * 4, 255);
+    for (std::size_t i = 3; i < pixels.size(); i += 4)
+        pixels[i] = 0;
+
+    // Copy the glyphs that lie in the region
+    for (std::size_t i = 0; i < batch.rects.size(); ++i)
+    {
+        const IntRect& rect = batch.rects[i];
+        if ((rect.width <= 0) || (rect.height <= 0) ||
+            (rect.left < region.left) || (rect.top < region.top) ||
+            (rect.left + rect.width > region.left + region.width) ||
+            (rect.top + rect.height > region.top + region.height))
+            continue;
+
+        const Uint8* source = &batch.pixels[batch.offsets[i]];
+        for (int y = 0; y < rect.height; ++y)
+        {
+            Uint8* destination = &pixels[((rect.top - region.top + y) * region.width + rect.left - region.left) * 4];
+            for (int x = 0; x < rect.width; ++x)
+                destination[x * 4 + 3] = source[y * rect.width + x];
+        }
+    }
+
+    page.texture.update(&pixels[0], region.width, region.height, region.left, region.top);
+}
+
+
+////////////////////////////////////////////////////////////
+Font::Page& Font::getPage(unsigned int characterSize) const
+{
+    std::size_t index;
+    if (!m_pageTable.find(characterSize, index))
+    {
+        // With an atlas, only the distance field glyphs need a texture of their own
+        m_pages.push_back(Page(!m_atlas || (characterSize == distanceFieldPageKey)));
+        index = m_pages.size() - 1;
+        m_pageTable.insert(characterSize, index);
+    }
+
+    return m_pages[index];
+}
+
+
+////////////////////////////////////////////////////////////
+Font::Page& Font::getMetricsPage(unsigned int characterSize) const
+{
+    Uint32 key = metricsPageFlag | characterSize;
+
+    std::size_t index;
+    if (!m_pageTable.find(key, index))
+    {
+        m_pages.push_back(Page(false));
+        index = m_pages.size() - 1;
+        m_pageTable.insert(key, index);
+    }
+
+    return m_pages[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* Font::getLineTexture(Vector2f& texCoords) const
+{
+    // The pages of the font have a white square in their corner
+    if (!m_atlas || m_distanceField)
+    {
+        texCoords = Vector2f(1, 1);
+        return NULL;
+    }
+
+    // Reserve a 4x4 white square in the atlas, its center is away from the transparent padding
+    if (!m_atlasLine.texture)
+    {
+        Image image;
+        image.create(4, 4, Color(255, 255, 255, 255));
+        if (!m_atlas->add(image, m_atlasLine))
+        {
+            err() << "Failed to add the underline texture of the font to the texture atlas" << std::endl;
+            m_atlasLine = TextureAtlas::Region();
+            texCoords = Vector2f(1, 1);
+            return NULL;
+        }
+    }
+
+    texCoords = Vector2f(static_cast<float>(m_atlasLine.rect.left + 2), static_cast<float>(m_atlasLine.rect.top + 2));
+    return m_atlasLine.texture;
 }
 
 
@@ -632,11 +1353,8 @@ IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height)
             unsigned int textureHeight = page.texture.getSize().y;
             if ((textureWidth * 2 <= Texture::getMaximumSize()) && (textureHeight * 2 <= Texture::getMaximumSize()))
             {
-                // Make the texture 2 times bigger
-                Image newImage;
-                newImage.create(textureWidth * 2, textureHeight * 2, Color(255, 255, 255, 0));
-                newImage.copy(page.texture.copyToImage(), 0, 0);
-                page.texture.loadFromImage(newImage);
+                // Make the texture 2 times bigger, the glyphs are copied on the graphics card
+                page.texture.resize(textureWidth * 2, textureHeight * 2, Color(255, 255, 255, 0));
             }
             else
             {
@@ -665,43 +1383,24 @@ IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height)
 ////////////////////////////////////////////////////////////
 bool Font::setCurrentSize(unsigned int characterSize) const
 {
-    // FT_Set_Pixel_Sizes is an expensive function, so we must call it
-    // only when necessary to avoid killing performances
-
-    FT_Face face = static_cast<FT_Face>(m_face);
-    FT_UShort currentSize = face->size->metrics.x_ppem;
-
-    if (currentSize != characterSize)
-    {
-        FT_Error result = FT_Set_Pixel_Sizes(face, 0, characterSize);
-
-        if (result == FT_Err_Invalid_Pixel_Size)
-        {
-            // In the case of bitmap fonts, resizing can
-            // fail if the requested size is not available
-            if (!FT_IS_SCALABLE(face))
-            {
-                err() << "Failed to set bitmap font size to " << characterSize << std::endl;
-                err() << "Available sizes are: ";
-                for (int i = 0; i < face->num_fixed_sizes; ++i)
-                    err() << face->available_sizes[i].height << " ";
-                err() << std::endl;
-            }
-        }
-
-        return result == FT_Err_Ok;
-    }
-    else
-    {
-        return true;
-    }
+    return priv::GlyphRasterizer::setSize(m_face, characterSize);
 }
 
 
 ////////////////////////////////////////////////////////////
-Font::Page::Page() :
-nextRow(3)
+Font::Page::Page(bool textured) :
+nextRow           (3),
+metricsLoaded     (false),
+lineSpacing       (0.f),
+underlinePosition (0.f),
+underlineThickness(0.f)
 {
+    std::fill(latin1, latin1 + 2 * Latin1Size, 0);
+
+    // Pages storing only metrics don't need a texture
+    if (!textured)
+        return;
+
     // Make sure that the texture is initialized by default
     sf::Image image;
     image.create(128, 128, Color(255, 255, 255, 0));
@@ -716,4 +1415,88 @@ nextRow(3)
     texture.setSmooth(true);
 }
 
+
+////////////////////////////////////////////////////////////
+Font::IndexTable::IndexTable() :
+m_keys   (),
+m_indices(),
+m_count  (0),
+m_bits   (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::IndexTable::find(Uint64 key, std::size_t& index) const
+{
+    if (!m_count)
+        return false;
+
+    // Linear probing, the table is never full so an empty slot ends the search
+    std::size_t mask = m_keys.size() - 1;
+    for (std::size_t slot = getSlot(key); m_indices[slot]; slot = (slot + 1) & mask)
+    {
+        if (m_keys[slot] == key)
+        {
+            index = m_indices[slot] - 1;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::IndexTable::insert(Uint64 key, std::size_t index)
+{
+    // Keep the load factor below one half, so that probe sequences stay short
+    if (2 * (m_count + 1) > m_keys.size())
+    {
+        std::vector<Uint64> keys;
+        std::vector<Uint32> indices;
+        keys.swap(m_keys);
+        indices.swap(m_indices);
+
+        m_bits = m_bits ? m_bits + 1 : 4;
+        m_keys.resize(static_cast<std::size_t>(1) << m_bits, 0);
+        m_indices.resize(m_keys.size(), 0);
+        m_count = 0;
+
+        for (std::size_t i = 0; i < keys.size(); ++i)
+        {
+            if (indices[i])
+                insert(keys[i], indices[i] - 1);
+        }
+    }
+
+    std::size_t mask = m_keys.size() - 1;
+    std::size_t slot = getSlot(key);
+    while (m_indices[slot])
+        slot = (slot + 1) & mask;
+
+    m_keys[slot] = key;
+    m_indices[slot] = static_cast<Uint32>(index + 1);
+    m_count++;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::IndexTable::clear()
+{
+    m_keys.clear();
+    m_indices.clear();
+    m_count = 0;
+    m_bits = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Font::IndexTable::getSlot(Uint64 key) const
+{
+    // Fibonacci hashing of the folded key: the high bits of the product are the best mixed
+    Uint32 folded = static_cast<Uint32>(key ^ (key >> 32));
+    return static_cast<std::size_t>((folded * 2654435769u) >> (32 - m_bits));
+}
+
 } // namespace sf
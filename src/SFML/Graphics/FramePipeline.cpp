@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/FramePipeline.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+FramePipeline::FramePipeline(ThreadPool& pool) :
+m_pool(pool),
+m_task(),
+m_back(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+FramePipeline::~FramePipeline()
+{
+    wait();
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePipeline::render(RenderTarget& target)
+{
+    m_buffers[1 - m_back].submit(target);
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePipeline::wait()
+{
+    m_task.wait();
+}
+
+
+////////////////////////////////////////////////////////////
+bool FramePipeline::isUpdating() const
+{
+    return !m_task.isDone();
+}
+
+
+////////////////////////////////////////////////////////////
+CommandBuffer& FramePipeline::swapBuffers()
+{
+    wait();
+
+    // The recorded frame becomes the one to render, the rendered one is recycled;
+    // clearing keeps the memory of the arenas, so recording doesn't allocate again
+    m_back = 1 - m_back;
+    m_buffers[m_back].clear();
+
+    return m_buffers[m_back];
+}
+
+} // namespace sf
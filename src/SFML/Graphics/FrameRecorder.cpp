@@ -0,0 +1,276 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/FrameRecorder.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Sleep.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+FrameRecorder::FrameRecorder() :
+m_thread    (&FrameRecorder::process, this),
+m_mutex     (),
+m_queued    (),
+m_recycled  (),
+m_readbacks (),
+m_timestamps(),
+m_frames    (),
+m_free      (),
+m_queue     (),
+m_discarded (),
+m_clock     (),
+m_dropped   (0),
+m_started   (false),
+m_processing(false),
+m_stop      (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+FrameRecorder::~FrameRecorder()
+{
+    // Nothing to do, derived classes must call stop() themselves
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameRecorder::start(unsigned int maxQueuedFrames)
+{
+    stop();
+
+    if (!onStart())
+        return false;
+
+    // Allocate the frames once, they are recycled while recording
+    for (unsigned int i = 0; i < (maxQueuedFrames > 0 ? maxQueuedFrames : 1); ++i)
+        m_frames.push_back(new Frame);
+    m_free = m_frames;
+
+    m_dropped    = 0;
+    m_processing = true;
+    m_stop       = false;
+    m_started    = true;
+    m_clock.restart();
+
+    m_thread.launch();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameRecorder::stop()
+{
+    if (!m_started)
+        return;
+
+    // Hand over the frames whose pixels are still on their way
+    while (m_readbacks.getPendingCount() > 0)
+    {
+        collectReadbacks(true);
+        if (m_readbacks.getPendingCount() > 0)
+            sleep(milliseconds(1));
+    }
+
+    {
+        Lock lock(m_mutex);
+        m_stop = true;
+        m_queued.notifyAll();
+    }
+    m_thread.wait();
+
+    for (std::vector<Frame*>::iterator it = m_frames.begin(); it != m_frames.end(); ++it)
+        delete *it;
+    m_frames.clear();
+    m_free.clear();
+    m_queue.clear();
+    m_timestamps.clear();
+    m_started = false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameRecorder::isRecording() const
+{
+    Lock lock(m_mutex);
+
+    return m_started && m_processing;
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameRecorder::capture(RenderWindow& window)
+{
+    if (!isRecording())
+        return false;
+
+    collectReadbacks(false);
+
+    Time timestamp = m_clock.getElapsedTime();
+    if (!m_readbacks.push(window))
+    {
+        Lock lock(m_mutex);
+        m_dropped++;
+        return false;
+    }
+
+    m_timestamps.push_back(timestamp);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameRecorder::capture(const Texture& texture)
+{
+    if (!isRecording())
+        return false;
+
+    collectReadbacks(false);
+
+    Time timestamp = m_clock.getElapsedTime();
+    if (!m_readbacks.push(texture))
+    {
+        Lock lock(m_mutex);
+        m_dropped++;
+        return false;
+    }
+
+    m_timestamps.push_back(timestamp);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int FrameRecorder::getDroppedFrameCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_dropped;
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameRecorder::onStart()
+{
+    // Nothing to do by default
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameRecorder::onStop()
+{
+    // Nothing to do by default
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameRecorder::collectReadbacks(bool wait)
+{
+    while (m_readbacks.isReady())
+    {
+        // Take a free frame, or drop the readback if the thread is late
+        Frame* frame = NULL;
+        {
+            Lock lock(m_mutex);
+
+            while (wait && m_free.empty())
+                m_recycled.wait(m_mutex);
+
+            if (!m_free.empty())
+            {
+                frame = m_free.back();
+                m_free.pop_back();
+            }
+            else
+            {
+                m_dropped++;
+            }
+        }
+
+        // The readback must be popped anyway, to release its slot
+        Time timestamp = m_timestamps.front();
+        m_timestamps.pop_front();
+
+        if (!frame)
+        {
+            m_readbacks.pop(m_discarded);
+            continue;
+        }
+
+        // The image of the frame keeps its memory from one readback to the next
+        m_readbacks.pop(frame->image);
+        frame->timestamp = timestamp;
+
+        Lock lock(m_mutex);
+        m_queue.push_back(frame);
+        m_queued.notifyOne();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameRecorder::process()
+{
+    for (;;)
+    {
+        Frame* frame = NULL;
+        bool processing = false;
+        {
+            Lock lock(m_mutex);
+
+            while (m_queue.empty() && !m_stop)
+                m_queued.wait(m_mutex);
+
+            // The queue is drained before stopping
+            if (m_queue.empty())
+                break;
+
+            frame = m_queue.front();
+            m_queue.pop_front();
+            processing = m_processing;
+        }
+
+        // Process the frame outside the lock, so that new frames can be queued meanwhile
+        if (processing)
+            processing = onProcessFrame(frame->image, frame->timestamp);
+
+        Lock lock(m_mutex);
+        m_free.push_back(frame);
+        m_processing = m_processing && processing;
+        m_recycled.notifyAll();
+    }
+
+    onStop();
+}
+
+} // namespace sf
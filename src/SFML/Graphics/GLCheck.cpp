@@ -69,6 +69,8 @@ void glCheckError(const char* file, unsigned int line)
                 break;
             }
 
+            // OpenGL ES 2 has no matrix or attribute stacks
+            #ifndef SFML_OPENGL_ES2
             case GL_STACK_OVERFLOW:
             {
                 error = "GL_STACK_OVERFLOW";
@@ -82,6 +84,7 @@ void glCheckError(const char* file, unsigned int line)
                 description = "this command would cause a stack underflow";
                 break;
             }
+            #endif
 
             case GL_OUT_OF_MEMORY:
             {
@@ -27,6 +27,18 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/GLExtensions.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/FastMutex.hpp>
+
+
+namespace
+{
+    // The function table is loaded once, by the first thread that needs it;
+    // the flag is checked before taking the lock so that the calls made
+    // by every state reset and resource creation stay cheap
+    volatile bool initialized = false;
+    sf::FastMutex initMutex;
+}
 
 
 namespace sf
@@ -37,22 +49,60 @@ namespace priv
 void ensureExtensionsInit()
 {
 #if !defined(SFML_OPENGL_ES)
-    static bool initialized = false;
-    if (!initialized)
-    {
-        sfogl_LoadFunctions();
+    if (initialized)
+        return;
+
+    Lock lock(initMutex);
+
+    // Another thread may have loaded the functions while we were waiting
+    if (initialized)
+        return;
 
-        if (!sfogl_IsVersionGEQ(1, 1))
-        {
-            err() << "sfml-graphics requires support for OpenGL 1.1 or greater" << std::endl;
-            err() << "Ensure that hardware acceleration is enabled if available" << std::endl;
-        }
+    sfogl_LoadFunctions();
 
-        initialized = true;
+    if (!sfogl_IsVersionGEQ(1, 1))
+    {
+        err() << "sfml-graphics requires support for OpenGL 1.1 or greater" << std::endl;
+        err() << "Ensure that hardware acceleration is enabled if available" << std::endl;
     }
+
+    initialized = true;
 #endif
 }
 
+#ifdef SFML_OPENGL_ES2
+
+////////////////////////////////////////////////////////////
+void deleteGlObject(GLuint object)
+{
+    if (glIsProgram(object))
+        glDeleteProgram(object);
+    else
+        glDeleteShader(object);
+}
+
+
+////////////////////////////////////////////////////////////
+void getGlObjectParameteriv(GLuint object, GLenum name, GLint* value)
+{
+    if (glIsProgram(object))
+        glGetProgramiv(object, name, value);
+    else
+        glGetShaderiv(object, name, value);
+}
+
+
+////////////////////////////////////////////////////////////
+void getGlInfoLog(GLuint object, GLsizei maxLength, GLsizei* length, GLchar* log)
+{
+    if (glIsProgram(object))
+        glGetProgramInfoLog(object, maxLength, length, log);
+    else
+        glGetShaderInfoLog(object, maxLength, length, log);
+}
+
+#endif
+
 } // namespace priv
 
 } // namespace sf
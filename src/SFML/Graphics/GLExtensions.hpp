@@ -41,6 +41,8 @@
     // OpenGL ES 2.0 is defined relative to OpenGL 2.0
     // All functionality beyond that is optional
     // and has to be checked for prior to use
+    // With SFML_OPENGL_ES2, OpenGL ES 2.0 is required
+    // and its core functionality replaces the OES extensions
 
     // Core since 1.0
     #define GLEXT_multitexture                        true
@@ -52,20 +54,115 @@
     #define GLEXT_GL_CLAMP                            GL_CLAMP_TO_EDGE
     #define GLEXT_GL_CLAMP_TO_EDGE                    GL_CLAMP_TO_EDGE
 
+    // Core since 1.1
+    // OpenGL ES 1.1 doesn't provide a stream usage hint, dynamic is the closest
+    #define GLEXT_vertex_buffer_object                true
+    #define GLEXT_glBindBuffer                        glBindBuffer
+    #define GLEXT_glBufferData                        glBufferData
+    #define GLEXT_glBufferSubData                     glBufferSubData
+    #define GLEXT_glDeleteBuffers                     glDeleteBuffers
+    #define GLEXT_glGenBuffers                        glGenBuffers
+    #define GLEXT_GL_ARRAY_BUFFER                     GL_ARRAY_BUFFER
+    #define GLEXT_GL_ELEMENT_ARRAY_BUFFER             GL_ELEMENT_ARRAY_BUFFER
+    #define GLEXT_GL_ARRAY_BUFFER_BINDING             GL_ARRAY_BUFFER_BINDING
+    #define GLEXT_GL_STATIC_DRAW                      GL_STATIC_DRAW
+    #define GLEXT_GL_DYNAMIC_DRAW                     GL_DYNAMIC_DRAW
+    #define GLEXT_GL_STREAM_DRAW                      GL_DYNAMIC_DRAW
+
+    // Core since 1.0
+    #define GLEXT_texture_compression                 true
+    #define GLEXT_glCompressedTexImage2D              glCompressedTexImage2D
+    #define GLEXT_GL_NUM_COMPRESSED_TEXTURE_FORMATS   GL_NUM_COMPRESSED_TEXTURE_FORMATS
+    #define GLEXT_GL_COMPRESSED_TEXTURE_FORMATS       GL_COMPRESSED_TEXTURE_FORMATS
+
+    // The compressed formats are queried from the context,
+    // the OpenGL ES 1 headers don't define most of their tokens
+    #define GLEXT_ES3_compatibility                   false
+    #define GLEXT_texture_compression_s3tc            false
+    #define GLEXT_texture_compression_astc_ldr        false
+    #define GLEXT_GL_COMPRESSED_RGB8_ETC2             0x9274
+    #define GLEXT_GL_COMPRESSED_RGBA8_ETC2_EAC        0x9278
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT1        0x83F1
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT3        0x83F2
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT5        0x83F3
+    #define GLEXT_GL_COMPRESSED_RGBA_ASTC_4x4         0x93B0
+    #define GLEXT_GL_COMPRESSED_RGBA_ASTC_6x6         0x93B4
+    #define GLEXT_GL_COMPRESSED_RGBA_ASTC_8x8         0x93B7
+
     // The following extensions are listed chronologically
     // Extension macro first, followed by tokens then
     // functions according to the corresponding specification
 
     // The following extensions are required.
 
+#ifdef SFML_OPENGL_ES2
+
+    // Core since 2.0 - OES_blend_subtract
+    #define GLEXT_blend_subtract                      true
+    #define GLEXT_glBlendEquation                     glBlendEquation
+    #define GLEXT_GL_FUNC_ADD                         GL_FUNC_ADD
+    #define GLEXT_GL_FUNC_SUBTRACT                    GL_FUNC_SUBTRACT
+
+    // Core since 2.0 - the programmable pipeline replaces the ARB shader
+    // objects, programs and shaders have separate functions though
+    #define GLEXT_shading_language_100                true
+    #define GLEXT_shader_objects                      true
+    #define GLEXT_glDeleteObject                      sf::priv::deleteGlObject
+    #define GLEXT_glCreateShaderObject                glCreateShader
+    #define GLEXT_glShaderSource                      glShaderSource
+    #define GLEXT_glCompileShader                     glCompileShader
+    #define GLEXT_glCreateProgramObject               glCreateProgram
+    #define GLEXT_glAttachObject                      glAttachShader
+    #define GLEXT_glLinkProgram                       glLinkProgram
+    #define GLEXT_glUseProgramObject                  glUseProgram
+    #define GLEXT_glUniform1f                         glUniform1f
+    #define GLEXT_glUniform2f                         glUniform2f
+    #define GLEXT_glUniform3f                         glUniform3f
+    #define GLEXT_glUniform4f                         glUniform4f
+    #define GLEXT_glUniform1i                         glUniform1i
+    #define GLEXT_glUniformMatrix4fv                  glUniformMatrix4fv
+    #define GLEXT_glGetObjectParameteriv              sf::priv::getGlObjectParameteriv
+    #define GLEXT_glGetInfoLog                        sf::priv::getGlInfoLog
+    #define GLEXT_glGetUniformLocation                glGetUniformLocation
+    #define GLEXT_GL_OBJECT_COMPILE_STATUS            GL_COMPILE_STATUS
+    #define GLEXT_GL_OBJECT_LINK_STATUS               GL_LINK_STATUS
+    #define GLEXT_GLhandle                            GLuint
+
+    #define GLEXT_vertex_shader                       true
+    #define GLEXT_glBindAttribLocation                glBindAttribLocation
+    #define GLEXT_glEnableVertexAttribArray           glEnableVertexAttribArray
+    #define GLEXT_glDisableVertexAttribArray          glDisableVertexAttribArray
+    #define GLEXT_glVertexAttribPointer               glVertexAttribPointer
+    #define GLEXT_GL_VERTEX_SHADER                    GL_VERTEX_SHADER
+
+    #define GLEXT_fragment_shader                     true
+    #define GLEXT_GL_FRAGMENT_SHADER                  GL_FRAGMENT_SHADER
+    #define GLEXT_GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS
+
+#else
+
     // Core since 2.0 - OES_blend_subtract
     #define GLEXT_blend_subtract                      GL_OES_blend_subtract
     #define GLEXT_glBlendEquation                     glBlendEquationOES
     #define GLEXT_GL_FUNC_ADD                         GL_FUNC_ADD_OES
     #define GLEXT_GL_FUNC_SUBTRACT                    GL_FUNC_SUBTRACT_OES
 
+#endif
+
     // The following extensions are optional.
 
+#ifdef SFML_OPENGL_ES2
+
+    // Core since 2.0 - OES_blend_func_separate
+    #define GLEXT_blend_func_separate                 true
+    #define GLEXT_glBlendFuncSeparate                 glBlendFuncSeparate
+
+    // Core since 2.0 - OES_blend_equation_separate
+    #define GLEXT_blend_equation_separate             true
+    #define GLEXT_glBlendEquationSeparate             glBlendEquationSeparate
+
+#else
+
     // Core since 2.0 - OES_blend_func_separate
     #ifdef SFML_SYSTEM_ANDROID
         // Hack to make transparency working on some Android devices
@@ -84,9 +181,37 @@
     #endif
     #define GLEXT_glBlendEquationSeparate             glBlendEquationSeparateOES
 
+#endif
+
     // Core since 2.0 - OES_texture_npot
     #define GLEXT_texture_non_power_of_two            false
 
+#ifdef SFML_OPENGL_ES2
+
+    // Core since 2.0 - OES_framebuffer_object
+    #define GLEXT_framebuffer_object                  true
+    #define GLEXT_glBindRenderbuffer                  glBindRenderbuffer
+    #define GLEXT_glDeleteRenderbuffers               glDeleteRenderbuffers
+    #define GLEXT_glGenRenderbuffers                  glGenRenderbuffers
+    #define GLEXT_glRenderbufferStorage               glRenderbufferStorage
+    #define GLEXT_glBindFramebuffer                   glBindFramebuffer
+    #define GLEXT_glDeleteFramebuffers                glDeleteFramebuffers
+    #define GLEXT_glGenFramebuffers                   glGenFramebuffers
+    #define GLEXT_glCheckFramebufferStatus            glCheckFramebufferStatus
+    #define GLEXT_glFramebufferTexture2D              glFramebufferTexture2D
+    #define GLEXT_glFramebufferRenderbuffer           glFramebufferRenderbuffer
+    #define GLEXT_glGenerateMipmap                    glGenerateMipmap
+    #define GLEXT_GL_FRAMEBUFFER                      GL_FRAMEBUFFER
+    #define GLEXT_GL_RENDERBUFFER                     GL_RENDERBUFFER
+    #define GLEXT_GL_DEPTH_COMPONENT                  GL_DEPTH_COMPONENT16
+    #define GLEXT_GL_COLOR_ATTACHMENT0                GL_COLOR_ATTACHMENT0
+    #define GLEXT_GL_DEPTH_ATTACHMENT                 GL_DEPTH_ATTACHMENT
+    #define GLEXT_GL_FRAMEBUFFER_COMPLETE             GL_FRAMEBUFFER_COMPLETE
+    #define GLEXT_GL_FRAMEBUFFER_BINDING              GL_FRAMEBUFFER_BINDING
+    #define GLEXT_GL_INVALID_FRAMEBUFFER_OPERATION    GL_INVALID_FRAMEBUFFER_OPERATION
+
+#else
+
     // Core since 2.0 - OES_framebuffer_object
     #define GLEXT_framebuffer_object                  GL_OES_framebuffer_object
     #define GLEXT_glBindRenderbuffer                  glBindRenderbufferOES
@@ -99,6 +224,7 @@
     #define GLEXT_glCheckFramebufferStatus            glCheckFramebufferStatusOES
     #define GLEXT_glFramebufferTexture2D              glFramebufferTexture2DOES
     #define GLEXT_glFramebufferRenderbuffer           glFramebufferRenderbufferOES
+    #define GLEXT_glGenerateMipmap                    glGenerateMipmapOES
     #define GLEXT_GL_FRAMEBUFFER                      GL_FRAMEBUFFER_OES
     #define GLEXT_GL_RENDERBUFFER                     GL_RENDERBUFFER_OES
     #define GLEXT_GL_DEPTH_COMPONENT                  GL_DEPTH_COMPONENT16_OES
@@ -108,6 +234,68 @@
     #define GLEXT_GL_FRAMEBUFFER_BINDING              GL_FRAMEBUFFER_BINDING_OES
     #define GLEXT_GL_INVALID_FRAMEBUFFER_OPERATION    GL_INVALID_FRAMEBUFFER_OPERATION_OES
 
+#endif
+
+    // The following extensions are unavailable.
+
+    // EXT_bgra, OpenGL ES only uploads BGRA pixels to BGRA textures
+    #define GLEXT_bgra                                false
+
+    // Core since 1.5 - ARB_occlusion_query
+    #define GLEXT_occlusion_query                     false
+
+    // Core since 2.0 - ARB_draw_buffers
+    #define GLEXT_draw_buffers                        false
+
+    // Core since 2.1 - ARB_pixel_buffer_object
+    #define GLEXT_pixel_buffer_object                 false
+
+    // Core since 3.0 - EXT_framebuffer_blit
+    #define GLEXT_framebuffer_blit                    false
+
+    // Core since 3.0 - EXT_framebuffer_multisample
+    #define GLEXT_framebuffer_multisample             false
+
+    // Core since 3.0 - ARB_texture_float
+    #define GLEXT_texture_float                       false
+
+    // Core since 3.0 - ARB_texture_rg
+    #define GLEXT_texture_rg                          false
+
+    // Core since 3.0 - EXT_texture_array
+    #define GLEXT_texture_array                       false
+
+    // Core since 3.0 - ARB_map_buffer_range
+    #define GLEXT_map_buffer_range                    false
+
+    // Core since 3.0 - ARB_vertex_array_object
+    #define GLEXT_vertex_array_object                 false
+
+    // Core since 3.1 - ARB_draw_instanced
+    #define GLEXT_draw_instanced                      false
+
+    // Core since 3.1 - ARB_uniform_buffer_object
+    #define GLEXT_uniform_buffer_object               false
+
+    // Core since 3.2 - ARB_sync
+    #define GLEXT_sync                                false
+
+    // Core since 3.3 - ARB_instanced_arrays
+    #define GLEXT_instanced_arrays                    false
+
+    // Core since 3.3 - ARB_timer_query
+    #define GLEXT_timer_query                         false
+
+    // Core since 4.1 - ARB_get_program_binary
+    #define GLEXT_get_program_binary                  false
+
+    // Core since 4.4 - ARB_buffer_storage
+    #define GLEXT_buffer_storage                      false
+
+    // Not core - KHR_parallel_shader_compile
+    #define GLEXT_parallel_shader_compile             false
+    #define GLEXT_GL_COMPLETION_STATUS                0x91B1
+
 #else
 
     #include <SFML/Graphics/GLLoader.hpp>
@@ -130,6 +318,10 @@
     #define GLEXT_texture_edge_clamp                  sfogl_ext_SGIS_texture_edge_clamp
     #define GLEXT_GL_CLAMP_TO_EDGE                    GL_CLAMP_TO_EDGE_SGIS
 
+    // Core since 1.2 - EXT_bgra
+    #define GLEXT_bgra                                sfogl_ext_EXT_bgra
+    #define GLEXT_GL_BGRA                             GL_BGRA_EXT
+
     // Core since 1.2 - EXT_blend_minmax
     #define GLEXT_blend_minmax                        sfogl_ext_EXT_blend_minmax
     #define GLEXT_glBlendEquation                     glBlendEquationEXT
@@ -145,10 +337,45 @@
     #define GLEXT_glActiveTexture                     glActiveTextureARB
     #define GLEXT_GL_TEXTURE0                         GL_TEXTURE0_ARB
 
+    // Core since 1.3 - ARB_texture_compression
+    #define GLEXT_texture_compression                 sfogl_ext_ARB_texture_compression
+    #define GLEXT_glCompressedTexImage2D              glCompressedTexImage2DARB
+    #define GLEXT_GL_NUM_COMPRESSED_TEXTURE_FORMATS   GL_NUM_COMPRESSED_TEXTURE_FORMATS_ARB
+    #define GLEXT_GL_COMPRESSED_TEXTURE_FORMATS       GL_COMPRESSED_TEXTURE_FORMATS_ARB
+
     // Core since 1.4 - EXT_blend_func_separate
     #define GLEXT_blend_func_separate                 sfogl_ext_EXT_blend_func_separate
     #define GLEXT_glBlendFuncSeparate                 glBlendFuncSeparateEXT
 
+    // Core since 1.5 - ARB_vertex_buffer_object
+    #define GLEXT_vertex_buffer_object                sfogl_ext_ARB_vertex_buffer_object
+    #define GLEXT_glBindBuffer                        glBindBufferARB
+    #define GLEXT_glBufferData                        glBufferDataARB
+    #define GLEXT_glBufferSubData                     glBufferSubDataARB
+    #define GLEXT_glDeleteBuffers                     glDeleteBuffersARB
+    #define GLEXT_glGenBuffers                        glGenBuffersARB
+    #define GLEXT_glMapBuffer                         glMapBufferARB
+    #define GLEXT_glUnmapBuffer                       glUnmapBufferARB
+    #define GLEXT_GL_ARRAY_BUFFER                     GL_ARRAY_BUFFER_ARB
+    #define GLEXT_GL_ELEMENT_ARRAY_BUFFER             GL_ELEMENT_ARRAY_BUFFER_ARB
+    #define GLEXT_GL_ARRAY_BUFFER_BINDING             GL_ARRAY_BUFFER_BINDING_ARB
+    #define GLEXT_GL_STATIC_DRAW                      GL_STATIC_DRAW_ARB
+    #define GLEXT_GL_DYNAMIC_DRAW                     GL_DYNAMIC_DRAW_ARB
+    #define GLEXT_GL_STREAM_DRAW                      GL_STREAM_DRAW_ARB
+    #define GLEXT_GL_STREAM_READ                      GL_STREAM_READ_ARB
+    #define GLEXT_GL_READ_ONLY                        GL_READ_ONLY_ARB
+    #define GLEXT_GL_WRITE_ONLY                       GL_WRITE_ONLY_ARB
+
+    // Core since 1.5 - ARB_occlusion_query
+    #define GLEXT_occlusion_query                     sfogl_ext_ARB_occlusion_query
+    #define GLEXT_glGenQueries                        glGenQueriesARB
+    #define GLEXT_glDeleteQueries                     glDeleteQueriesARB
+    #define GLEXT_glBeginQuery                        glBeginQueryARB
+    #define GLEXT_glEndQuery                          glEndQueryARB
+    #define GLEXT_glGetQueryObjectuiv                 glGetQueryObjectuivARB
+    #define GLEXT_GL_QUERY_RESULT                     GL_QUERY_RESULT_ARB
+    #define GLEXT_GL_QUERY_RESULT_AVAILABLE           GL_QUERY_RESULT_AVAILABLE_ARB
+
     // Core since 2.0 - ARB_shading_language_100
     #define GLEXT_shading_language_100                sfogl_ext_ARB_shading_language_100
 
@@ -179,6 +406,10 @@
 
     // Core since 2.0 - ARB_vertex_shader
     #define GLEXT_vertex_shader                       sfogl_ext_ARB_vertex_shader
+    #define GLEXT_glBindAttribLocation                glBindAttribLocationARB
+    #define GLEXT_glEnableVertexAttribArray           glEnableVertexAttribArrayARB
+    #define GLEXT_glDisableVertexAttribArray          glDisableVertexAttribArrayARB
+    #define GLEXT_glVertexAttribPointer               glVertexAttribPointerARB
     #define GLEXT_GL_VERTEX_SHADER                    GL_VERTEX_SHADER_ARB
     #define GLEXT_GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS_ARB
 
@@ -193,6 +424,17 @@
     #define GLEXT_blend_equation_separate             sfogl_ext_EXT_blend_equation_separate
     #define GLEXT_glBlendEquationSeparate             glBlendEquationSeparateEXT
 
+    // Core since 2.0 - ARB_draw_buffers
+    #define GLEXT_draw_buffers                        sfogl_ext_ARB_draw_buffers
+    #define GLEXT_glDrawBuffers                       glDrawBuffersARB
+    #define GLEXT_GL_MAX_DRAW_BUFFERS                 GL_MAX_DRAW_BUFFERS_ARB
+
+    // Core since 2.1 - ARB_pixel_buffer_object
+    #define GLEXT_pixel_buffer_object                 sfogl_ext_ARB_pixel_buffer_object
+    #define GLEXT_GL_PIXEL_PACK_BUFFER                GL_PIXEL_PACK_BUFFER_ARB
+    #define GLEXT_GL_PIXEL_UNPACK_BUFFER              GL_PIXEL_UNPACK_BUFFER_ARB
+    #define GLEXT_GL_PIXEL_UNPACK_BUFFER_BINDING      GL_PIXEL_UNPACK_BUFFER_BINDING_ARB
+
     // Core since 3.0 - EXT_framebuffer_object
     #define GLEXT_framebuffer_object                  sfogl_ext_EXT_framebuffer_object
     #define GLEXT_glBindRenderbuffer                  glBindRenderbufferEXT
@@ -205,14 +447,138 @@
     #define GLEXT_glCheckFramebufferStatus            glCheckFramebufferStatusEXT
     #define GLEXT_glFramebufferTexture2D              glFramebufferTexture2DEXT
     #define GLEXT_glFramebufferRenderbuffer           glFramebufferRenderbufferEXT
+    #define GLEXT_glGenerateMipmap                    glGenerateMipmapEXT
     #define GLEXT_GL_FRAMEBUFFER                      GL_FRAMEBUFFER_EXT
     #define GLEXT_GL_RENDERBUFFER                     GL_RENDERBUFFER_EXT
     #define GLEXT_GL_COLOR_ATTACHMENT0                GL_COLOR_ATTACHMENT0_EXT
+    #define GLEXT_GL_MAX_COLOR_ATTACHMENTS            GL_MAX_COLOR_ATTACHMENTS_EXT
     #define GLEXT_GL_DEPTH_ATTACHMENT                 GL_DEPTH_ATTACHMENT_EXT
     #define GLEXT_GL_FRAMEBUFFER_COMPLETE             GL_FRAMEBUFFER_COMPLETE_EXT
     #define GLEXT_GL_FRAMEBUFFER_BINDING              GL_FRAMEBUFFER_BINDING_EXT
     #define GLEXT_GL_INVALID_FRAMEBUFFER_OPERATION    GL_INVALID_FRAMEBUFFER_OPERATION_EXT
 
+    // Core since 3.0 - EXT_framebuffer_blit
+    #define GLEXT_framebuffer_blit                    sfogl_ext_EXT_framebuffer_blit
+    #define GLEXT_glBlitFramebuffer                   glBlitFramebufferEXT
+    #define GLEXT_GL_READ_FRAMEBUFFER                 GL_READ_FRAMEBUFFER_EXT
+    #define GLEXT_GL_DRAW_FRAMEBUFFER                 GL_DRAW_FRAMEBUFFER_EXT
+
+    // Core since 3.0 - EXT_framebuffer_multisample
+    #define GLEXT_framebuffer_multisample             sfogl_ext_EXT_framebuffer_multisample
+    #define GLEXT_glRenderbufferStorageMultisample    glRenderbufferStorageMultisampleEXT
+    #define GLEXT_GL_MAX_SAMPLES                      GL_MAX_SAMPLES_EXT
+
+    // Core since 3.0 - ARB_texture_float
+    #define GLEXT_texture_float                       sfogl_ext_ARB_texture_float
+    #define GLEXT_GL_RGBA32F                          GL_RGBA32F_ARB
+    #define GLEXT_GL_RGBA16F                          GL_RGBA16F_ARB
+
+    // Core since 3.0 - ARB_texture_rg
+    #define GLEXT_texture_rg                          sfogl_ext_ARB_texture_rg
+    #define GLEXT_GL_R8                               GL_R8
+
+    // Core since 3.0 - EXT_texture_array (requires EXT_texture3D)
+    #define GLEXT_texture_array                       (sfogl_ext_EXT_texture_array && sfogl_ext_EXT_texture3D)
+    #define GLEXT_glTexImage3D                        glTexImage3DEXT
+    #define GLEXT_glTexSubImage3D                     glTexSubImage3DEXT
+    #define GLEXT_GL_TEXTURE_2D_ARRAY                 GL_TEXTURE_2D_ARRAY_EXT
+    #define GLEXT_GL_TEXTURE_BINDING_2D_ARRAY         GL_TEXTURE_BINDING_2D_ARRAY_EXT
+    #define GLEXT_GL_MAX_ARRAY_TEXTURE_LAYERS         GL_MAX_ARRAY_TEXTURE_LAYERS_EXT
+
+    // Core since 3.0 - ARB_map_buffer_range
+    #define GLEXT_map_buffer_range                    sfogl_ext_ARB_map_buffer_range
+    #define GLEXT_glMapBufferRange                    glMapBufferRange
+    #define GLEXT_glFlushMappedBufferRange            glFlushMappedBufferRange
+    #define GLEXT_GL_MAP_READ_BIT                     GL_MAP_READ_BIT
+    #define GLEXT_GL_MAP_WRITE_BIT                    GL_MAP_WRITE_BIT
+    #define GLEXT_GL_MAP_INVALIDATE_RANGE_BIT         GL_MAP_INVALIDATE_RANGE_BIT
+    #define GLEXT_GL_MAP_INVALIDATE_BUFFER_BIT        GL_MAP_INVALIDATE_BUFFER_BIT
+    #define GLEXT_GL_MAP_FLUSH_EXPLICIT_BIT           GL_MAP_FLUSH_EXPLICIT_BIT
+    #define GLEXT_GL_MAP_UNSYNCHRONIZED_BIT           GL_MAP_UNSYNCHRONIZED_BIT
+
+    // Core since 3.0 - ARB_vertex_array_object
+    #define GLEXT_vertex_array_object                 sfogl_ext_ARB_vertex_array_object
+    #define GLEXT_glBindVertexArray                   glBindVertexArray
+    #define GLEXT_glDeleteVertexArrays                glDeleteVertexArrays
+    #define GLEXT_glGenVertexArrays                   glGenVertexArrays
+
+    // Core since 3.1 - ARB_draw_instanced
+    #define GLEXT_draw_instanced                      sfogl_ext_ARB_draw_instanced
+    #define GLEXT_glDrawArraysInstanced               glDrawArraysInstancedARB
+    #define GLEXT_glDrawElementsInstanced             glDrawElementsInstancedARB
+
+    // Core since 3.1 - ARB_uniform_buffer_object
+    #define GLEXT_uniform_buffer_object               sfogl_ext_ARB_uniform_buffer_object
+    #define GLEXT_glGetUniformBlockIndex              glGetUniformBlockIndex
+    #define GLEXT_glUniformBlockBinding               glUniformBlockBinding
+    #define GLEXT_glBindBufferBase                    glBindBufferBase
+    #define GLEXT_GL_UNIFORM_BUFFER                   GL_UNIFORM_BUFFER
+    #define GLEXT_GL_INVALID_INDEX                    GL_INVALID_INDEX
+    #define GLEXT_GL_MAX_UNIFORM_BUFFER_BINDINGS      GL_MAX_UNIFORM_BUFFER_BINDINGS
+
+    // Core since 3.2 - ARB_sync
+    #define GLEXT_sync                                sfogl_ext_ARB_sync
+    #define GLEXT_glFenceSync                         glFenceSync
+    #define GLEXT_glDeleteSync                        glDeleteSync
+    #define GLEXT_glClientWaitSync                    glClientWaitSync
+    #define GLEXT_glWaitSync                          glWaitSync
+    #define GLEXT_GLsync                              GLsync
+    #define GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE       GL_SYNC_GPU_COMMANDS_COMPLETE
+    #define GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT          GL_SYNC_FLUSH_COMMANDS_BIT
+    #define GLEXT_GL_ALREADY_SIGNALED                 GL_ALREADY_SIGNALED
+    #define GLEXT_GL_CONDITION_SATISFIED              GL_CONDITION_SATISFIED
+    #define GLEXT_GL_TIMEOUT_EXPIRED                  GL_TIMEOUT_EXPIRED
+    #define GLEXT_GL_WAIT_FAILED                      GL_WAIT_FAILED
+    #define GLEXT_GL_TIMEOUT_IGNORED                  GL_TIMEOUT_IGNORED
+
+    // Core since 3.3 - ARB_instanced_arrays
+    #define GLEXT_instanced_arrays                    sfogl_ext_ARB_instanced_arrays
+    #define GLEXT_glVertexAttribDivisor               glVertexAttribDivisorARB
+
+    // Core since 3.3 - ARB_timer_query
+    #define GLEXT_timer_query                         sfogl_ext_ARB_timer_query
+    #define GLEXT_glGetQueryObjectui64v               glGetQueryObjectui64v
+    #define GLEXT_GL_TIME_ELAPSED                     GL_TIME_ELAPSED
+
+    // Core since 4.1 - ARB_get_program_binary
+    #define GLEXT_get_program_binary                  sfogl_ext_ARB_get_program_binary
+    #define GLEXT_glGetProgramBinary                  glGetProgramBinary
+    #define GLEXT_glProgramBinary                     glProgramBinary
+    #define GLEXT_glProgramParameteri                 glProgramParameteri
+    #define GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT  GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+    #define GLEXT_GL_PROGRAM_BINARY_LENGTH            GL_PROGRAM_BINARY_LENGTH
+    #define GLEXT_GL_NUM_PROGRAM_BINARY_FORMATS       GL_NUM_PROGRAM_BINARY_FORMATS
+
+    // Core since 4.4 - ARB_buffer_storage
+    #define GLEXT_buffer_storage                      sfogl_ext_ARB_buffer_storage
+    #define GLEXT_glBufferStorage                     glBufferStorage
+    #define GLEXT_GL_MAP_PERSISTENT_BIT               GL_MAP_PERSISTENT_BIT
+    #define GLEXT_GL_MAP_COHERENT_BIT                 GL_MAP_COHERENT_BIT
+    #define GLEXT_GL_DYNAMIC_STORAGE_BIT              GL_DYNAMIC_STORAGE_BIT
+    #define GLEXT_GL_CLIENT_STORAGE_BIT               GL_CLIENT_STORAGE_BIT
+
+    // Core since 4.3 - ARB_ES3_compatibility
+    #define GLEXT_ES3_compatibility                   sfogl_ext_ARB_ES3_compatibility
+    #define GLEXT_GL_COMPRESSED_RGB8_ETC2             GL_COMPRESSED_RGB8_ETC2
+    #define GLEXT_GL_COMPRESSED_RGBA8_ETC2_EAC        GL_COMPRESSED_RGBA8_ETC2_EAC
+
+    // Not core - EXT_texture_compression_s3tc
+    #define GLEXT_texture_compression_s3tc            sfogl_ext_EXT_texture_compression_s3tc
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT1        GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT3        GL_COMPRESSED_RGBA_S3TC_DXT3_EXT
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT5        GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+
+    // Not core - KHR_texture_compression_astc_ldr
+    #define GLEXT_texture_compression_astc_ldr        sfogl_ext_KHR_texture_compression_astc_ldr
+    #define GLEXT_GL_COMPRESSED_RGBA_ASTC_4x4         GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+    #define GLEXT_GL_COMPRESSED_RGBA_ASTC_6x6         GL_COMPRESSED_RGBA_ASTC_6x6_KHR
+    #define GLEXT_GL_COMPRESSED_RGBA_ASTC_8x8         GL_COMPRESSED_RGBA_ASTC_8x8_KHR
+
+    // Not core - KHR_parallel_shader_compile
+    #define GLEXT_parallel_shader_compile             sfogl_ext_KHR_parallel_shader_compile
+    #define GLEXT_glMaxShaderCompilerThreads          glMaxShaderCompilerThreadsKHR
+    #define GLEXT_GL_COMPLETION_STATUS                GL_COMPLETION_STATUS_KHR
+
 #endif
 
 namespace sf
@@ -223,9 +589,51 @@ namespace priv
 ////////////////////////////////////////////////////////////
 /// \brief Make sure that extensions are initialized
 ///
+/// The functions are loaded from the context active on the
+/// first call. All the contexts created by SFML share their
+/// objects and come from the same driver, so one function
+/// table serves them all. This function is thread-safe, and
+/// returns immediately once the table is loaded.
+///
 ////////////////////////////////////////////////////////////
 void ensureExtensionsInit();
 
+#ifdef SFML_OPENGL_ES2
+
+////////////////////////////////////////////////////////////
+/// \brief Delete a shader or a program object
+///
+/// OpenGL ES 2 has no generic object deletion, the right
+/// function is chosen from the type of the object.
+///
+/// \param object Shader or program object to delete
+///
+////////////////////////////////////////////////////////////
+void deleteGlObject(GLuint object);
+
+////////////////////////////////////////////////////////////
+/// \brief Query a parameter of a shader or a program object
+///
+/// \param object Shader or program object to query
+/// \param name   Parameter to query
+/// \param value  Receives the value of the parameter
+///
+////////////////////////////////////////////////////////////
+void getGlObjectParameteriv(GLuint object, GLenum name, GLint* value);
+
+////////////////////////////////////////////////////////////
+/// \brief Read the info log of a shader or a program object
+///
+/// \param object    Shader or program object to query
+/// \param maxLength Size of the \a log buffer
+/// \param length    Receives the length of the log (can be null)
+/// \param log       Receives the log
+///
+////////////////////////////////////////////////////////////
+void getGlInfoLog(GLuint object, GLsizei maxLength, GLsizei* length, GLchar* log);
+
+#endif
+
 } // namespace priv
 
 } // namespace sf
@@ -61,6 +61,31 @@ int sfogl_ext_ARB_fragment_shader = sfogl_LOAD_FAILED;
 int sfogl_ext_ARB_texture_non_power_of_two = sfogl_LOAD_FAILED;
 int sfogl_ext_EXT_blend_equation_separate = sfogl_LOAD_FAILED;
 int sfogl_ext_EXT_framebuffer_object = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_vertex_buffer_object = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_draw_instanced = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_instanced_arrays = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_map_buffer_range = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_sync = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_buffer_storage = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_vertex_array_object = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_pixel_buffer_object = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_texture_compression = sfogl_LOAD_FAILED;
+int sfogl_ext_EXT_texture_compression_s3tc = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_ES3_compatibility = sfogl_LOAD_FAILED;
+int sfogl_ext_KHR_texture_compression_astc_ldr = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_occlusion_query = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_timer_query = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_get_program_binary = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_uniform_buffer_object = sfogl_LOAD_FAILED;
+int sfogl_ext_KHR_parallel_shader_compile = sfogl_LOAD_FAILED;
+int sfogl_ext_EXT_framebuffer_blit = sfogl_LOAD_FAILED;
+int sfogl_ext_EXT_framebuffer_multisample = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_draw_buffers = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_texture_float = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_texture_rg = sfogl_LOAD_FAILED;
+int sfogl_ext_EXT_texture3D = sfogl_LOAD_FAILED;
+int sfogl_ext_EXT_texture_array = sfogl_LOAD_FAILED;
+int sfogl_ext_EXT_bgra = sfogl_LOAD_FAILED;
 
 void (CODEGEN_FUNCPTR *sf_ptrc_glBlendEquationEXT)(GLenum) = NULL;
 
@@ -220,18 +245,27 @@ static int Load_ARB_shader_objects()
 }
 
 void (CODEGEN_FUNCPTR *sf_ptrc_glBindAttribLocationARB)(GLhandleARB, GLuint, const GLcharARB *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glDisableVertexAttribArrayARB)(GLuint) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glEnableVertexAttribArrayARB)(GLuint) = NULL;
 void (CODEGEN_FUNCPTR *sf_ptrc_glGetActiveAttribARB)(GLhandleARB, GLuint, GLsizei, GLsizei *, GLint *, GLenum *, GLcharARB *) = NULL;
 GLint (CODEGEN_FUNCPTR *sf_ptrc_glGetAttribLocationARB)(GLhandleARB, const GLcharARB *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glVertexAttribPointerARB)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void *) = NULL;
 
 static int Load_ARB_vertex_shader()
 {
     int numFailed = 0;
     sf_ptrc_glBindAttribLocationARB = (void (CODEGEN_FUNCPTR *)(GLhandleARB, GLuint, const GLcharARB *))IntGetProcAddress("glBindAttribLocationARB");
     if(!sf_ptrc_glBindAttribLocationARB) numFailed++;
+    sf_ptrc_glDisableVertexAttribArrayARB = (void (CODEGEN_FUNCPTR *)(GLuint))IntGetProcAddress("glDisableVertexAttribArrayARB");
+    if(!sf_ptrc_glDisableVertexAttribArrayARB) numFailed++;
+    sf_ptrc_glEnableVertexAttribArrayARB = (void (CODEGEN_FUNCPTR *)(GLuint))IntGetProcAddress("glEnableVertexAttribArrayARB");
+    if(!sf_ptrc_glEnableVertexAttribArrayARB) numFailed++;
     sf_ptrc_glGetActiveAttribARB = (void (CODEGEN_FUNCPTR *)(GLhandleARB, GLuint, GLsizei, GLsizei *, GLint *, GLenum *, GLcharARB *))IntGetProcAddress("glGetActiveAttribARB");
     if(!sf_ptrc_glGetActiveAttribARB) numFailed++;
     sf_ptrc_glGetAttribLocationARB = (GLint (CODEGEN_FUNCPTR *)(GLhandleARB, const GLcharARB *))IntGetProcAddress("glGetAttribLocationARB");
     if(!sf_ptrc_glGetAttribLocationARB) numFailed++;
+    sf_ptrc_glVertexAttribPointerARB = (void (CODEGEN_FUNCPTR *)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void *))IntGetProcAddress("glVertexAttribPointerARB");
+    if(!sf_ptrc_glVertexAttribPointerARB) numFailed++;
     return numFailed;
 }
 
@@ -303,6 +337,299 @@ static int Load_EXT_framebuffer_object()
     return numFailed;
 }
 
+void (CODEGEN_FUNCPTR *sf_ptrc_glBindBufferARB)(GLenum, GLuint) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glBufferDataARB)(GLenum, GLsizeiptrARB, const void *, GLenum) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glBufferSubDataARB)(GLenum, GLintptrARB, GLsizeiptrARB, const void *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glDeleteBuffersARB)(GLsizei, const GLuint *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glGenBuffersARB)(GLsizei, GLuint *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glGetBufferParameterivARB)(GLenum, GLenum, GLint *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glGetBufferPointervARB)(GLenum, GLenum, void **) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glGetBufferSubDataARB)(GLenum, GLintptrARB, GLsizeiptrARB, void *) = NULL;
+GLboolean (CODEGEN_FUNCPTR *sf_ptrc_glIsBufferARB)(GLuint) = NULL;
+void * (CODEGEN_FUNCPTR *sf_ptrc_glMapBufferARB)(GLenum, GLenum) = NULL;
+GLboolean (CODEGEN_FUNCPTR *sf_ptrc_glUnmapBufferARB)(GLenum) = NULL;
+
+static int Load_ARB_vertex_buffer_object()
+{
+    int numFailed = 0;
+    sf_ptrc_glBindBufferARB = (void (CODEGEN_FUNCPTR *)(GLenum, GLuint))IntGetProcAddress("glBindBufferARB");
+    if(!sf_ptrc_glBindBufferARB) numFailed++;
+    sf_ptrc_glBufferDataARB = (void (CODEGEN_FUNCPTR *)(GLenum, GLsizeiptrARB, const void *, GLenum))IntGetProcAddress("glBufferDataARB");
+    if(!sf_ptrc_glBufferDataARB) numFailed++;
+    sf_ptrc_glBufferSubDataARB = (void (CODEGEN_FUNCPTR *)(GLenum, GLintptrARB, GLsizeiptrARB, const void *))IntGetProcAddress("glBufferSubDataARB");
+    if(!sf_ptrc_glBufferSubDataARB) numFailed++;
+    sf_ptrc_glDeleteBuffersARB = (void (CODEGEN_FUNCPTR *)(GLsizei, const GLuint *))IntGetProcAddress("glDeleteBuffersARB");
+    if(!sf_ptrc_glDeleteBuffersARB) numFailed++;
+    sf_ptrc_glGenBuffersARB = (void (CODEGEN_FUNCPTR *)(GLsizei, GLuint *))IntGetProcAddress("glGenBuffersARB");
+    if(!sf_ptrc_glGenBuffersARB) numFailed++;
+    sf_ptrc_glGetBufferParameterivARB = (void (CODEGEN_FUNCPTR *)(GLenum, GLenum, GLint *))IntGetProcAddress("glGetBufferParameterivARB");
+    if(!sf_ptrc_glGetBufferParameterivARB) numFailed++;
+    sf_ptrc_glGetBufferPointervARB = (void (CODEGEN_FUNCPTR *)(GLenum, GLenum, void **))IntGetProcAddress("glGetBufferPointervARB");
+    if(!sf_ptrc_glGetBufferPointervARB) numFailed++;
+    sf_ptrc_glGetBufferSubDataARB = (void (CODEGEN_FUNCPTR *)(GLenum, GLintptrARB, GLsizeiptrARB, void *))IntGetProcAddress("glGetBufferSubDataARB");
+    if(!sf_ptrc_glGetBufferSubDataARB) numFailed++;
+    sf_ptrc_glIsBufferARB = (GLboolean (CODEGEN_FUNCPTR *)(GLuint))IntGetProcAddress("glIsBufferARB");
+    if(!sf_ptrc_glIsBufferARB) numFailed++;
+    sf_ptrc_glMapBufferARB = (void * (CODEGEN_FUNCPTR *)(GLenum, GLenum))IntGetProcAddress("glMapBufferARB");
+    if(!sf_ptrc_glMapBufferARB) numFailed++;
+    sf_ptrc_glUnmapBufferARB = (GLboolean (CODEGEN_FUNCPTR *)(GLenum))IntGetProcAddress("glUnmapBufferARB");
+    if(!sf_ptrc_glUnmapBufferARB) numFailed++;
+    return numFailed;
+}
+
+void (CODEGEN_FUNCPTR *sf_ptrc_glDrawArraysInstancedARB)(GLenum, GLint, GLsizei, GLsizei) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glDrawElementsInstancedARB)(GLenum, GLsizei, GLenum, const void *, GLsizei) = NULL;
+
+static int Load_ARB_draw_instanced()
+{
+    int numFailed = 0;
+    sf_ptrc_glDrawArraysInstancedARB = (void (CODEGEN_FUNCPTR *)(GLenum, GLint, GLsizei, GLsizei))IntGetProcAddress("glDrawArraysInstancedARB");
+    if(!sf_ptrc_glDrawArraysInstancedARB) numFailed++;
+    sf_ptrc_glDrawElementsInstancedARB = (void (CODEGEN_FUNCPTR *)(GLenum, GLsizei, GLenum, const void *, GLsizei))IntGetProcAddress("glDrawElementsInstancedARB");
+    if(!sf_ptrc_glDrawElementsInstancedARB) numFailed++;
+    return numFailed;
+}
+
+void (CODEGEN_FUNCPTR *sf_ptrc_glVertexAttribDivisorARB)(GLuint, GLuint) = NULL;
+
+static int Load_ARB_instanced_arrays()
+{
+    int numFailed = 0;
+    sf_ptrc_glVertexAttribDivisorARB = (void (CODEGEN_FUNCPTR *)(GLuint, GLuint))IntGetProcAddress("glVertexAttribDivisorARB");
+    if(!sf_ptrc_glVertexAttribDivisorARB) numFailed++;
+    return numFailed;
+}
+
+void (CODEGEN_FUNCPTR *sf_ptrc_glFlushMappedBufferRange)(GLenum, GLintptr, GLsizeiptr) = NULL;
+void * (CODEGEN_FUNCPTR *sf_ptrc_glMapBufferRange)(GLenum, GLintptr, GLsizeiptr, GLbitfield) = NULL;
+
+static int Load_ARB_map_buffer_range()
+{
+    int numFailed = 0;
+    sf_ptrc_glFlushMappedBufferRange = (void (CODEGEN_FUNCPTR *)(GLenum, GLintptr, GLsizeiptr))IntGetProcAddress("glFlushMappedBufferRange");
+    if(!sf_ptrc_glFlushMappedBufferRange) numFailed++;
+    sf_ptrc_glMapBufferRange = (void * (CODEGEN_FUNCPTR *)(GLenum, GLintptr, GLsizeiptr, GLbitfield))IntGetProcAddress("glMapBufferRange");
+    if(!sf_ptrc_glMapBufferRange) numFailed++;
+    return numFailed;
+}
+
+GLenum (CODEGEN_FUNCPTR *sf_ptrc_glClientWaitSync)(GLsync, GLbitfield, GLuint64) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glDeleteSync)(GLsync) = NULL;
+GLsync (CODEGEN_FUNCPTR *sf_ptrc_glFenceSync)(GLenum, GLbitfield) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glGetInteger64v)(GLenum, GLint64 *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glGetSynciv)(GLsync, GLenum, GLsizei, GLsizei *, GLint *) = NULL;
+GLboolean (CODEGEN_FUNCPTR *sf_ptrc_glIsSync)(GLsync) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glWaitSync)(GLsync, GLbitfield, GLuint64) = NULL;
+
+static int Load_ARB_sync()
+{
+    int numFailed = 0;
+    sf_ptrc_glClientWaitSync = (GLenum (CODEGEN_FUNCPTR *)(GLsync, GLbitfield, GLuint64))IntGetProcAddress("glClientWaitSync");
+    if(!sf_ptrc_glClientWaitSync) numFailed++;
+    sf_ptrc_glDeleteSync = (void (CODEGEN_FUNCPTR *)(GLsync))IntGetProcAddress("glDeleteSync");
+    if(!sf_ptrc_glDeleteSync) numFailed++;
+    sf_ptrc_glFenceSync = (GLsync (CODEGEN_FUNCPTR *)(GLenum, GLbitfield))IntGetProcAddress("glFenceSync");
+    if(!sf_ptrc_glFenceSync) numFailed++;
+    sf_ptrc_glGetInteger64v = (void (CODEGEN_FUNCPTR *)(GLenum, GLint64 *))IntGetProcAddress("glGetInteger64v");
+    if(!sf_ptrc_glGetInteger64v) numFailed++;
+    sf_ptrc_glGetSynciv = (void (CODEGEN_FUNCPTR *)(GLsync, GLenum, GLsizei, GLsizei *, GLint *))IntGetProcAddress("glGetSynciv");
+    if(!sf_ptrc_glGetSynciv) numFailed++;
+    sf_ptrc_glIsSync = (GLboolean (CODEGEN_FUNCPTR *)(GLsync))IntGetProcAddress("glIsSync");
+    if(!sf_ptrc_glIsSync) numFailed++;
+    sf_ptrc_glWaitSync = (void (CODEGEN_FUNCPTR *)(GLsync, GLbitfield, GLuint64))IntGetProcAddress("glWaitSync");
+    if(!sf_ptrc_glWaitSync) numFailed++;
+    return numFailed;
+}
+
+void (CODEGEN_FUNCPTR *sf_ptrc_glBufferStorage)(GLenum, GLsizeiptr, const void *, GLbitfield) = NULL;
+
+static int Load_ARB_buffer_storage()
+{
+    int numFailed = 0;
+    sf_ptrc_glBufferStorage = (void (CODEGEN_FUNCPTR *)(GLenum, GLsizeiptr, const void *, GLbitfield))IntGetProcAddress("glBufferStorage");
+    if(!sf_ptrc_glBufferStorage) numFailed++;
+    return numFailed;
+}
+
+void (CODEGEN_FUNCPTR *sf_ptrc_glBindVertexArray)(GLuint) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glDeleteVertexArrays)(GLsizei, const GLuint *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glGenVertexArrays)(GLsizei, GLuint *) = NULL;
+GLboolean (CODEGEN_FUNCPTR *sf_ptrc_glIsVertexArray)(GLuint) = NULL;
+
+static int Load_ARB_vertex_array_object()
+{
+    int numFailed = 0;
+    sf_ptrc_glBindVertexArray = (void (CODEGEN_FUNCPTR *)(GLuint))IntGetProcAddress("glBindVertexArray");
+    if(!sf_ptrc_glBindVertexArray) numFailed++;
+    sf_ptrc_glDeleteVertexArrays = (void (CODEGEN_FUNCPTR *)(GLsizei, const GLuint *))IntGetProcAddress("glDeleteVertexArrays");
+    if(!sf_ptrc_glDeleteVertexArrays) numFailed++;
+    sf_ptrc_glGenVertexArrays = (void (CODEGEN_FUNCPTR *)(GLsizei, GLuint *))IntGetProcAddress("glGenVertexArrays");
+    if(!sf_ptrc_glGenVertexArrays) numFailed++;
+    sf_ptrc_glIsVertexArray = (GLboolean (CODEGEN_FUNCPTR *)(GLuint))IntGetProcAddress("glIsVertexArray");
+    if(!sf_ptrc_glIsVertexArray) numFailed++;
+    return numFailed;
+}
+
+void (CODEGEN_FUNCPTR *sf_ptrc_glCompressedTexImage1DARB)(GLenum, GLint, GLenum, GLsizei, GLint, GLsizei, const void *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glCompressedTexImage2DARB)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, const void *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glCompressedTexImage3DARB)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLsizei, GLint, GLsizei, const void *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glCompressedTexSubImage1DARB)(GLenum, GLint, GLint, GLsizei, GLenum, GLsizei, const void *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glCompressedTexSubImage2DARB)(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLsizei, const void *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glCompressedTexSubImage3DARB)(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLsizei, const void *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glGetCompressedTexImageARB)(GLenum, GLint, void *) = NULL;
+
+static int Load_ARB_texture_compression()
+{
+    int numFailed = 0;
+    sf_ptrc_glCompressedTexImage1DARB = (void (CODEGEN_FUNCPTR *)(GLenum, GLint, GLenum, GLsizei, GLint, GLsizei, const void *))IntGetProcAddress("glCompressedTexImage1DARB");
+    if(!sf_ptrc_glCompressedTexImage1DARB) numFailed++;
+    sf_ptrc_glCompressedTexImage2DARB = (void (CODEGEN_FUNCPTR *)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, const void *))IntGetProcAddress("glCompressedTexImage2DARB");
+    if(!sf_ptrc_glCompressedTexImage2DARB) numFailed++;
+    sf_ptrc_glCompressedTexImage3DARB = (void (CODEGEN_FUNCPTR *)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLsizei, GLint, GLsizei, const void *))IntGetProcAddress("glCompressedTexImage3DARB");
+    if(!sf_ptrc_glCompressedTexImage3DARB) numFailed++;
+    sf_ptrc_glCompressedTexSubImage1DARB = (void (CODEGEN_FUNCPTR *)(GLenum, GLint, GLint, GLsizei, GLenum, GLsizei, const void *))IntGetProcAddress("glCompressedTexSubImage1DARB");
+    if(!sf_ptrc_glCompressedTexSubImage1DARB) numFailed++;
+    sf_ptrc_glCompressedTexSubImage2DARB = (void (CODEGEN_FUNCPTR *)(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLsizei, const void *))IntGetProcAddress("glCompressedTexSubImage2DARB");
+    if(!sf_ptrc_glCompressedTexSubImage2DARB) numFailed++;
+    sf_ptrc_glCompressedTexSubImage3DARB = (void (CODEGEN_FUNCPTR *)(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLsizei, const void *))IntGetProcAddress("glCompressedTexSubImage3DARB");
+    if(!sf_ptrc_glCompressedTexSubImage3DARB) numFailed++;
+    sf_ptrc_glGetCompressedTexImageARB = (void (CODEGEN_FUNCPTR *)(GLenum, GLint, void *))IntGetProcAddress("glGetCompressedTexImageARB");
+    if(!sf_ptrc_glGetCompressedTexImageARB) numFailed++;
+    return numFailed;
+}
+
+void (CODEGEN_FUNCPTR *sf_ptrc_glBeginQueryARB)(GLenum, GLuint) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glDeleteQueriesARB)(GLsizei, const GLuint *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glEndQueryARB)(GLenum) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glGenQueriesARB)(GLsizei, GLuint *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glGetQueryObjectivARB)(GLuint, GLenum, GLint *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glGetQueryObjectuivARB)(GLuint, GLenum, GLuint *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glGetQueryivARB)(GLenum, GLenum, GLint *) = NULL;
+GLboolean (CODEGEN_FUNCPTR *sf_ptrc_glIsQueryARB)(GLuint) = NULL;
+
+static int Load_ARB_occlusion_query()
+{
+    int numFailed = 0;
+    sf_ptrc_glBeginQueryARB = (void (CODEGEN_FUNCPTR *)(GLenum, GLuint))IntGetProcAddress("glBeginQueryARB");
+    if(!sf_ptrc_glBeginQueryARB) numFailed++;
+    sf_ptrc_glDeleteQueriesARB = (void (CODEGEN_FUNCPTR *)(GLsizei, const GLuint *))IntGetProcAddress("glDeleteQueriesARB");
+    if(!sf_ptrc_glDeleteQueriesARB) numFailed++;
+    sf_ptrc_glEndQueryARB = (void (CODEGEN_FUNCPTR *)(GLenum))IntGetProcAddress("glEndQueryARB");
+    if(!sf_ptrc_glEndQueryARB) numFailed++;
+    sf_ptrc_glGenQueriesARB = (void (CODEGEN_FUNCPTR *)(GLsizei, GLuint *))IntGetProcAddress("glGenQueriesARB");
+    if(!sf_ptrc_glGenQueriesARB) numFailed++;
+    sf_ptrc_glGetQueryObjectivARB = (void (CODEGEN_FUNCPTR *)(GLuint, GLenum, GLint *))IntGetProcAddress("glGetQueryObjectivARB");
+    if(!sf_ptrc_glGetQueryObjectivARB) numFailed++;
+    sf_ptrc_glGetQueryObjectuivARB = (void (CODEGEN_FUNCPTR *)(GLuint, GLenum, GLuint *))IntGetProcAddress("glGetQueryObjectuivARB");
+    if(!sf_ptrc_glGetQueryObjectuivARB) numFailed++;
+    sf_ptrc_glGetQueryivARB = (void (CODEGEN_FUNCPTR *)(GLenum, GLenum, GLint *))IntGetProcAddress("glGetQueryivARB");
+    if(!sf_ptrc_glGetQueryivARB) numFailed++;
+    sf_ptrc_glIsQueryARB = (GLboolean (CODEGEN_FUNCPTR *)(GLuint))IntGetProcAddress("glIsQueryARB");
+    if(!sf_ptrc_glIsQueryARB) numFailed++;
+    return numFailed;
+}
+
+void (CODEGEN_FUNCPTR *sf_ptrc_glGetQueryObjecti64v)(GLuint, GLenum, GLint64 *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glGetQueryObjectui64v)(GLuint, GLenum, GLuint64 *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glQueryCounter)(GLuint, GLenum) = NULL;
+
+static int Load_ARB_timer_query()
+{
+    int numFailed = 0;
+    sf_ptrc_glGetQueryObjecti64v = (void (CODEGEN_FUNCPTR *)(GLuint, GLenum, GLint64 *))IntGetProcAddress("glGetQueryObjecti64v");
+    if(!sf_ptrc_glGetQueryObjecti64v) numFailed++;
+    sf_ptrc_glGetQueryObjectui64v = (void (CODEGEN_FUNCPTR *)(GLuint, GLenum, GLuint64 *))IntGetProcAddress("glGetQueryObjectui64v");
+    if(!sf_ptrc_glGetQueryObjectui64v) numFailed++;
+    sf_ptrc_glQueryCounter = (void (CODEGEN_FUNCPTR *)(GLuint, GLenum))IntGetProcAddress("glQueryCounter");
+    if(!sf_ptrc_glQueryCounter) numFailed++;
+    return numFailed;
+}
+
+void (CODEGEN_FUNCPTR *sf_ptrc_glGetProgramBinary)(GLuint, GLsizei, GLsizei *, GLenum *, void *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glProgramBinary)(GLuint, GLenum, const void *, GLsizei) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glProgramParameteri)(GLuint, GLenum, GLint) = NULL;
+
+static int Load_ARB_get_program_binary()
+{
+    int numFailed = 0;
+    sf_ptrc_glGetProgramBinary = (void (CODEGEN_FUNCPTR *)(GLuint, GLsizei, GLsizei *, GLenum *, void *))IntGetProcAddress("glGetProgramBinary");
+    if(!sf_ptrc_glGetProgramBinary) numFailed++;
+    sf_ptrc_glProgramBinary = (void (CODEGEN_FUNCPTR *)(GLuint, GLenum, const void *, GLsizei))IntGetProcAddress("glProgramBinary");
+    if(!sf_ptrc_glProgramBinary) numFailed++;
+    sf_ptrc_glProgramParameteri = (void (CODEGEN_FUNCPTR *)(GLuint, GLenum, GLint))IntGetProcAddress("glProgramParameteri");
+    if(!sf_ptrc_glProgramParameteri) numFailed++;
+    return numFailed;
+}
+
+void (CODEGEN_FUNCPTR *sf_ptrc_glBindBufferBase)(GLenum, GLuint, GLuint) = NULL;
+GLuint (CODEGEN_FUNCPTR *sf_ptrc_glGetUniformBlockIndex)(GLuint, const GLchar *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glUniformBlockBinding)(GLuint, GLuint, GLuint) = NULL;
+
+static int Load_ARB_uniform_buffer_object()
+{
+    int numFailed = 0;
+    sf_ptrc_glBindBufferBase = (void (CODEGEN_FUNCPTR *)(GLenum, GLuint, GLuint))IntGetProcAddress("glBindBufferBase");
+    if(!sf_ptrc_glBindBufferBase) numFailed++;
+    sf_ptrc_glGetUniformBlockIndex = (GLuint (CODEGEN_FUNCPTR *)(GLuint, const GLchar *))IntGetProcAddress("glGetUniformBlockIndex");
+    if(!sf_ptrc_glGetUniformBlockIndex) numFailed++;
+    sf_ptrc_glUniformBlockBinding = (void (CODEGEN_FUNCPTR *)(GLuint, GLuint, GLuint))IntGetProcAddress("glUniformBlockBinding");
+    if(!sf_ptrc_glUniformBlockBinding) numFailed++;
+    return numFailed;
+}
+
+void (CODEGEN_FUNCPTR *sf_ptrc_glMaxShaderCompilerThreadsKHR)(GLuint) = NULL;
+
+static int Load_KHR_parallel_shader_compile()
+{
+    int numFailed = 0;
+    sf_ptrc_glMaxShaderCompilerThreadsKHR = (void (CODEGEN_FUNCPTR *)(GLuint))IntGetProcAddress("glMaxShaderCompilerThreadsKHR");
+    if(!sf_ptrc_glMaxShaderCompilerThreadsKHR) numFailed++;
+    return numFailed;
+}
+
+void (CODEGEN_FUNCPTR *sf_ptrc_glBlitFramebufferEXT)(GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLbitfield, GLenum) = NULL;
+
+static int Load_EXT_framebuffer_blit()
+{
+    int numFailed = 0;
+    sf_ptrc_glBlitFramebufferEXT = (void (CODEGEN_FUNCPTR *)(GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLbitfield, GLenum))IntGetProcAddress("glBlitFramebufferEXT");
+    if(!sf_ptrc_glBlitFramebufferEXT) numFailed++;
+    return numFailed;
+}
+
+void (CODEGEN_FUNCPTR *sf_ptrc_glRenderbufferStorageMultisampleEXT)(GLenum, GLsizei, GLenum, GLsizei, GLsizei) = NULL;
+
+static int Load_EXT_framebuffer_multisample()
+{
+    int numFailed = 0;
+    sf_ptrc_glRenderbufferStorageMultisampleEXT = (void (CODEGEN_FUNCPTR *)(GLenum, GLsizei, GLenum, GLsizei, GLsizei))IntGetProcAddress("glRenderbufferStorageMultisampleEXT");
+    if(!sf_ptrc_glRenderbufferStorageMultisampleEXT) numFailed++;
+    return numFailed;
+}
+
+void (CODEGEN_FUNCPTR *sf_ptrc_glDrawBuffersARB)(GLsizei, const GLenum *) = NULL;
+
+static int Load_ARB_draw_buffers()
+{
+    int numFailed = 0;
+    sf_ptrc_glDrawBuffersARB = (void (CODEGEN_FUNCPTR *)(GLsizei, const GLenum *))IntGetProcAddress("glDrawBuffersARB");
+    if(!sf_ptrc_glDrawBuffersARB) numFailed++;
+    return numFailed;
+}
+
+void (CODEGEN_FUNCPTR *sf_ptrc_glTexImage3DEXT)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLsizei, GLint, GLenum, GLenum, const GLvoid *) = NULL;
+void (CODEGEN_FUNCPTR *sf_ptrc_glTexSubImage3DEXT)(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLenum, const GLvoid *) = NULL;
+
+static int Load_EXT_texture3D()
+{
+    int numFailed = 0;
+    sf_ptrc_glTexImage3DEXT = (void (CODEGEN_FUNCPTR *)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLsizei, GLint, GLenum, GLenum, const GLvoid *))IntGetProcAddress("glTexImage3DEXT");
+    if(!sf_ptrc_glTexImage3DEXT) numFailed++;
+    sf_ptrc_glTexSubImage3DEXT = (void (CODEGEN_FUNCPTR *)(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLenum, const GLvoid *))IntGetProcAddress("glTexSubImage3DEXT");
+    if(!sf_ptrc_glTexSubImage3DEXT) numFailed++;
+    return numFailed;
+}
+
 static int Load_Version_1_1()
 {
     int numFailed = 0;
@@ -317,7 +644,7 @@ typedef struct sfogl_StrToExtMap_s
     PFN_LOADFUNCPOINTERS LoadExtension;
 } sfogl_StrToExtMap;
 
-static sfogl_StrToExtMap ExtensionMap[12] = {
+static sfogl_StrToExtMap ExtensionMap[37] = {
     {"GL_SGIS_texture_edge_clamp", &sfogl_ext_SGIS_texture_edge_clamp, NULL},
     {"GL_EXT_blend_minmax", &sfogl_ext_EXT_blend_minmax, Load_EXT_blend_minmax},
     {"GL_EXT_blend_subtract", &sfogl_ext_EXT_blend_subtract, NULL},
@@ -329,10 +656,35 @@ static sfogl_StrToExtMap ExtensionMap[12] = {
     {"GL_ARB_fragment_shader", &sfogl_ext_ARB_fragment_shader, NULL},
     {"GL_ARB_texture_non_power_of_two", &sfogl_ext_ARB_texture_non_power_of_two, NULL},
     {"GL_EXT_blend_equation_separate", &sfogl_ext_EXT_blend_equation_separate, Load_EXT_blend_equation_separate},
-    {"GL_EXT_framebuffer_object", &sfogl_ext_EXT_framebuffer_object, Load_EXT_framebuffer_object}
+    {"GL_EXT_framebuffer_object", &sfogl_ext_EXT_framebuffer_object, Load_EXT_framebuffer_object},
+    {"GL_ARB_vertex_buffer_object", &sfogl_ext_ARB_vertex_buffer_object, Load_ARB_vertex_buffer_object},
+    {"GL_ARB_draw_instanced", &sfogl_ext_ARB_draw_instanced, Load_ARB_draw_instanced},
+    {"GL_ARB_instanced_arrays", &sfogl_ext_ARB_instanced_arrays, Load_ARB_instanced_arrays},
+    {"GL_ARB_map_buffer_range", &sfogl_ext_ARB_map_buffer_range, Load_ARB_map_buffer_range},
+    {"GL_ARB_sync", &sfogl_ext_ARB_sync, Load_ARB_sync},
+    {"GL_ARB_buffer_storage", &sfogl_ext_ARB_buffer_storage, Load_ARB_buffer_storage},
+    {"GL_ARB_vertex_array_object", &sfogl_ext_ARB_vertex_array_object, Load_ARB_vertex_array_object},
+    {"GL_ARB_pixel_buffer_object", &sfogl_ext_ARB_pixel_buffer_object, NULL},
+    {"GL_ARB_texture_compression", &sfogl_ext_ARB_texture_compression, Load_ARB_texture_compression},
+    {"GL_EXT_texture_compression_s3tc", &sfogl_ext_EXT_texture_compression_s3tc, NULL},
+    {"GL_ARB_ES3_compatibility", &sfogl_ext_ARB_ES3_compatibility, NULL},
+    {"GL_KHR_texture_compression_astc_ldr", &sfogl_ext_KHR_texture_compression_astc_ldr, NULL},
+    {"GL_ARB_occlusion_query", &sfogl_ext_ARB_occlusion_query, Load_ARB_occlusion_query},
+    {"GL_ARB_timer_query", &sfogl_ext_ARB_timer_query, Load_ARB_timer_query},
+    {"GL_ARB_get_program_binary", &sfogl_ext_ARB_get_program_binary, Load_ARB_get_program_binary},
+    {"GL_ARB_uniform_buffer_object", &sfogl_ext_ARB_uniform_buffer_object, Load_ARB_uniform_buffer_object},
+    {"GL_KHR_parallel_shader_compile", &sfogl_ext_KHR_parallel_shader_compile, Load_KHR_parallel_shader_compile},
+    {"GL_EXT_framebuffer_blit", &sfogl_ext_EXT_framebuffer_blit, Load_EXT_framebuffer_blit},
+    {"GL_EXT_framebuffer_multisample", &sfogl_ext_EXT_framebuffer_multisample, Load_EXT_framebuffer_multisample},
+    {"GL_ARB_draw_buffers", &sfogl_ext_ARB_draw_buffers, Load_ARB_draw_buffers},
+    {"GL_ARB_texture_float", &sfogl_ext_ARB_texture_float, NULL},
+    {"GL_ARB_texture_rg", &sfogl_ext_ARB_texture_rg, NULL},
+    {"GL_EXT_texture3D", &sfogl_ext_EXT_texture3D, Load_EXT_texture3D},
+    {"GL_EXT_texture_array", &sfogl_ext_EXT_texture_array, NULL},
+    {"GL_EXT_bgra", &sfogl_ext_EXT_bgra, NULL}
 };
 
-static int g_extensionMapSize = 12;
+static int g_extensionMapSize = 37;
 
 static sfogl_StrToExtMap *FindExtEntry(const char *extensionName)
 {
@@ -361,6 +713,31 @@ static void ClearExtensionVars()
     sfogl_ext_ARB_texture_non_power_of_two = sfogl_LOAD_FAILED;
     sfogl_ext_EXT_blend_equation_separate = sfogl_LOAD_FAILED;
     sfogl_ext_EXT_framebuffer_object = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_vertex_buffer_object = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_draw_instanced = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_instanced_arrays = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_map_buffer_range = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_sync = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_buffer_storage = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_vertex_array_object = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_pixel_buffer_object = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_texture_compression = sfogl_LOAD_FAILED;
+    sfogl_ext_EXT_texture_compression_s3tc = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_ES3_compatibility = sfogl_LOAD_FAILED;
+    sfogl_ext_KHR_texture_compression_astc_ldr = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_occlusion_query = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_timer_query = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_get_program_binary = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_uniform_buffer_object = sfogl_LOAD_FAILED;
+    sfogl_ext_KHR_parallel_shader_compile = sfogl_LOAD_FAILED;
+    sfogl_ext_EXT_framebuffer_blit = sfogl_LOAD_FAILED;
+    sfogl_ext_EXT_framebuffer_multisample = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_draw_buffers = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_texture_float = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_texture_rg = sfogl_LOAD_FAILED;
+    sfogl_ext_EXT_texture3D = sfogl_LOAD_FAILED;
+    sfogl_ext_EXT_texture_array = sfogl_LOAD_FAILED;
+    sfogl_ext_EXT_bgra = sfogl_LOAD_FAILED;
 }
 
 
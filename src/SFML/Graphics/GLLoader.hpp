@@ -185,6 +185,31 @@ extern int sfogl_ext_ARB_fragment_shader;
 extern int sfogl_ext_ARB_texture_non_power_of_two;
 extern int sfogl_ext_EXT_blend_equation_separate;
 extern int sfogl_ext_EXT_framebuffer_object;
+extern int sfogl_ext_ARB_vertex_buffer_object;
+extern int sfogl_ext_ARB_draw_instanced;
+extern int sfogl_ext_ARB_instanced_arrays;
+extern int sfogl_ext_ARB_map_buffer_range;
+extern int sfogl_ext_ARB_sync;
+extern int sfogl_ext_ARB_buffer_storage;
+extern int sfogl_ext_ARB_vertex_array_object;
+extern int sfogl_ext_ARB_pixel_buffer_object;
+extern int sfogl_ext_ARB_texture_compression;
+extern int sfogl_ext_EXT_texture_compression_s3tc;
+extern int sfogl_ext_ARB_ES3_compatibility;
+extern int sfogl_ext_KHR_texture_compression_astc_ldr;
+extern int sfogl_ext_ARB_occlusion_query;
+extern int sfogl_ext_ARB_timer_query;
+extern int sfogl_ext_ARB_get_program_binary;
+extern int sfogl_ext_ARB_uniform_buffer_object;
+extern int sfogl_ext_KHR_parallel_shader_compile;
+extern int sfogl_ext_EXT_framebuffer_blit;
+extern int sfogl_ext_EXT_framebuffer_multisample;
+extern int sfogl_ext_ARB_draw_buffers;
+extern int sfogl_ext_ARB_texture_float;
+extern int sfogl_ext_ARB_texture_rg;
+extern int sfogl_ext_EXT_texture3D;
+extern int sfogl_ext_EXT_texture_array;
+extern int sfogl_ext_EXT_bgra;
 
 #define GL_CLAMP_TO_EDGE_SGIS 0x812F
 
@@ -341,6 +366,172 @@ extern int sfogl_ext_EXT_framebuffer_object;
 #define GL_STENCIL_INDEX4_EXT 0x8D47
 #define GL_STENCIL_INDEX8_EXT 0x8D48
 
+#define GL_ARRAY_BUFFER_ARB 0x8892
+#define GL_ARRAY_BUFFER_BINDING_ARB 0x8894
+#define GL_BUFFER_ACCESS_ARB 0x88BB
+#define GL_BUFFER_MAPPED_ARB 0x88BC
+#define GL_BUFFER_MAP_POINTER_ARB 0x88BD
+#define GL_BUFFER_SIZE_ARB 0x8764
+#define GL_BUFFER_USAGE_ARB 0x8765
+#define GL_DYNAMIC_COPY_ARB 0x88EA
+#define GL_DYNAMIC_DRAW_ARB 0x88E8
+#define GL_DYNAMIC_READ_ARB 0x88E9
+#define GL_ELEMENT_ARRAY_BUFFER_ARB 0x8893
+#define GL_ELEMENT_ARRAY_BUFFER_BINDING_ARB 0x8895
+#define GL_READ_ONLY_ARB 0x88B8
+#define GL_READ_WRITE_ARB 0x88BA
+#define GL_STATIC_COPY_ARB 0x88E6
+#define GL_STATIC_DRAW_ARB 0x88E4
+#define GL_STATIC_READ_ARB 0x88E5
+#define GL_STREAM_COPY_ARB 0x88E2
+#define GL_STREAM_DRAW_ARB 0x88E0
+#define GL_STREAM_READ_ARB 0x88E1
+#define GL_VERTEX_ARRAY_BUFFER_BINDING_ARB 0x8896
+#define GL_WRITE_ONLY_ARB 0x88B9
+
+#define GL_VERTEX_ATTRIB_ARRAY_DIVISOR_ARB 0x88FE
+
+#define GL_MAP_FLUSH_EXPLICIT_BIT 0x0010
+#define GL_MAP_INVALIDATE_BUFFER_BIT 0x0008
+#define GL_MAP_INVALIDATE_RANGE_BIT 0x0004
+#define GL_MAP_READ_BIT 0x0001
+#define GL_MAP_UNSYNCHRONIZED_BIT 0x0020
+#define GL_MAP_WRITE_BIT 0x0002
+
+#define GL_ALREADY_SIGNALED 0x911A
+#define GL_CONDITION_SATISFIED 0x911C
+#define GL_MAX_SERVER_WAIT_TIMEOUT 0x9111
+#define GL_OBJECT_TYPE 0x9112
+#define GL_SIGNALED 0x9119
+#define GL_SYNC_CONDITION 0x9113
+#define GL_SYNC_FENCE 0x9116
+#define GL_SYNC_FLAGS 0x9115
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_SYNC_STATUS 0x9114
+#define GL_TIMEOUT_EXPIRED 0x911B
+#define GL_TIMEOUT_IGNORED 0xFFFFFFFFFFFFFFFFull
+#define GL_UNSIGNALED 0x9118
+#define GL_WAIT_FAILED 0x911D
+
+#define GL_BUFFER_IMMUTABLE_STORAGE 0x821F
+#define GL_BUFFER_STORAGE_FLAGS 0x8220
+#define GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT 0x00004000
+#define GL_CLIENT_STORAGE_BIT 0x0200
+#define GL_DYNAMIC_STORAGE_BIT 0x0100
+#define GL_MAP_COHERENT_BIT 0x0080
+#define GL_MAP_PERSISTENT_BIT 0x0040
+
+#define GL_VERTEX_ARRAY_BINDING 0x85B5
+
+#define GL_PIXEL_PACK_BUFFER_ARB 0x88EB
+#define GL_PIXEL_PACK_BUFFER_BINDING_ARB 0x88ED
+#define GL_PIXEL_UNPACK_BUFFER_ARB 0x88EC
+#define GL_PIXEL_UNPACK_BUFFER_BINDING_ARB 0x88EF
+
+#define GL_COMPRESSED_ALPHA_ARB 0x84E9
+#define GL_COMPRESSED_INTENSITY_ARB 0x84EC
+#define GL_COMPRESSED_LUMINANCE_ALPHA_ARB 0x84EB
+#define GL_COMPRESSED_LUMINANCE_ARB 0x84EA
+#define GL_COMPRESSED_RGBA_ARB 0x84EE
+#define GL_COMPRESSED_RGB_ARB 0x84ED
+#define GL_COMPRESSED_TEXTURE_FORMATS_ARB 0x86A3
+#define GL_NUM_COMPRESSED_TEXTURE_FORMATS_ARB 0x86A2
+#define GL_TEXTURE_COMPRESSED_ARB 0x86A1
+#define GL_TEXTURE_COMPRESSED_IMAGE_SIZE_ARB 0x86A0
+#define GL_TEXTURE_COMPRESSION_HINT_ARB 0x84EF
+
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT3_EXT 0x83F2
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+
+#define GL_ANY_SAMPLES_PASSED_CONSERVATIVE 0x8D6A
+#define GL_COMPRESSED_R11_EAC 0x9270
+#define GL_COMPRESSED_RG11_EAC 0x9272
+#define GL_COMPRESSED_RGB8_ETC2 0x9274
+#define GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2 0x9276
+#define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#define GL_COMPRESSED_SIGNED_R11_EAC 0x9271
+#define GL_COMPRESSED_SIGNED_RG11_EAC 0x9273
+#define GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC 0x9279
+#define GL_COMPRESSED_SRGB8_ETC2 0x9275
+#define GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2 0x9277
+#define GL_MAX_ELEMENT_INDEX 0x8D6B
+#define GL_PRIMITIVE_RESTART_FIXED_INDEX 0x8D69
+
+#define GL_COMPRESSED_RGBA_ASTC_10x10_KHR 0x93BB
+#define GL_COMPRESSED_RGBA_ASTC_10x5_KHR 0x93B8
+#define GL_COMPRESSED_RGBA_ASTC_10x6_KHR 0x93B9
+#define GL_COMPRESSED_RGBA_ASTC_10x8_KHR 0x93BA
+#define GL_COMPRESSED_RGBA_ASTC_12x10_KHR 0x93BC
+#define GL_COMPRESSED_RGBA_ASTC_12x12_KHR 0x93BD
+#define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
+#define GL_COMPRESSED_RGBA_ASTC_5x4_KHR 0x93B1
+#define GL_COMPRESSED_RGBA_ASTC_5x5_KHR 0x93B2
+#define GL_COMPRESSED_RGBA_ASTC_6x5_KHR 0x93B3
+#define GL_COMPRESSED_RGBA_ASTC_6x6_KHR 0x93B4
+#define GL_COMPRESSED_RGBA_ASTC_8x5_KHR 0x93B5
+#define GL_COMPRESSED_RGBA_ASTC_8x6_KHR 0x93B6
+#define GL_COMPRESSED_RGBA_ASTC_8x8_KHR 0x93B7
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x10_KHR 0x93DB
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x5_KHR 0x93D8
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x6_KHR 0x93D9
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x8_KHR 0x93DA
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x10_KHR 0x93DC
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12_KHR 0x93DD
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR 0x93D0
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x4_KHR 0x93D1
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x5_KHR 0x93D2
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x5_KHR 0x93D3
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x6_KHR 0x93D4
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x5_KHR 0x93D5
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x6_KHR 0x93D6
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x8_KHR 0x93D7
+
+#define GL_CURRENT_QUERY_ARB 0x8865
+#define GL_QUERY_COUNTER_BITS_ARB 0x8864
+#define GL_QUERY_RESULT_ARB 0x8866
+#define GL_QUERY_RESULT_AVAILABLE_ARB 0x8867
+#define GL_SAMPLES_PASSED_ARB 0x8914
+
+#define GL_TIMESTAMP 0x8E28
+#define GL_TIME_ELAPSED 0x88BF
+
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#define GL_PROGRAM_BINARY_FORMATS 0x87FF
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+
+#define GL_INVALID_INDEX 0xFFFFFFFFu
+#define GL_MAX_UNIFORM_BUFFER_BINDINGS 0x8A2F
+#define GL_UNIFORM_BUFFER 0x8A11
+
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+
+#define GL_DRAW_FRAMEBUFFER_BINDING_EXT 0x8CA6
+#define GL_DRAW_FRAMEBUFFER_EXT 0x8CA9
+#define GL_READ_FRAMEBUFFER_BINDING_EXT 0x8CAA
+#define GL_READ_FRAMEBUFFER_EXT 0x8CA8
+
+#define GL_FRAMEBUFFER_INCOMPLETE_MULTISAMPLE_EXT 0x8D56
+#define GL_MAX_SAMPLES_EXT 0x8D57
+#define GL_RENDERBUFFER_SAMPLES_EXT 0x8CAB
+
+#define GL_MAX_DRAW_BUFFERS_ARB 0x8824
+
+#define GL_RGBA16F_ARB 0x881A
+#define GL_RGBA32F_ARB 0x8814
+
+#define GL_R8 0x8229
+
+#define GL_MAX_ARRAY_TEXTURE_LAYERS_EXT 0x88FF
+#define GL_TEXTURE_2D_ARRAY_EXT 0x8C1A
+#define GL_TEXTURE_BINDING_2D_ARRAY_EXT 0x8C1D
+
+#define GL_BGRA_EXT 0x80E1
+
 #define GL_2D 0x0600
 #define GL_2_BYTES 0x1407
 #define GL_3D 0x0601
@@ -891,10 +1082,16 @@ extern void (CODEGEN_FUNCPTR *sf_ptrc_glValidateProgramARB)(GLhandleARB);
 #define GL_ARB_vertex_shader 1
 extern void (CODEGEN_FUNCPTR *sf_ptrc_glBindAttribLocationARB)(GLhandleARB, GLuint, const GLcharARB *);
 #define glBindAttribLocationARB sf_ptrc_glBindAttribLocationARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glDisableVertexAttribArrayARB)(GLuint);
+#define glDisableVertexAttribArrayARB sf_ptrc_glDisableVertexAttribArrayARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glEnableVertexAttribArrayARB)(GLuint);
+#define glEnableVertexAttribArrayARB sf_ptrc_glEnableVertexAttribArrayARB
 extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetActiveAttribARB)(GLhandleARB, GLuint, GLsizei, GLsizei *, GLint *, GLenum *, GLcharARB *);
 #define glGetActiveAttribARB sf_ptrc_glGetActiveAttribARB
 extern GLint (CODEGEN_FUNCPTR *sf_ptrc_glGetAttribLocationARB)(GLhandleARB, const GLcharARB *);
 #define glGetAttribLocationARB sf_ptrc_glGetAttribLocationARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glVertexAttribPointerARB)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void *);
+#define glVertexAttribPointerARB sf_ptrc_glVertexAttribPointerARB
 #endif /*GL_ARB_vertex_shader*/
 
 
@@ -943,6 +1140,190 @@ extern void (CODEGEN_FUNCPTR *sf_ptrc_glRenderbufferStorageEXT)(GLenum, GLenum,
 #define glRenderbufferStorageEXT sf_ptrc_glRenderbufferStorageEXT
 #endif /*GL_EXT_framebuffer_object*/
 
+#ifndef GL_ARB_vertex_buffer_object
+#define GL_ARB_vertex_buffer_object 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glBindBufferARB)(GLenum, GLuint);
+#define glBindBufferARB sf_ptrc_glBindBufferARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glBufferDataARB)(GLenum, GLsizeiptrARB, const void *, GLenum);
+#define glBufferDataARB sf_ptrc_glBufferDataARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glBufferSubDataARB)(GLenum, GLintptrARB, GLsizeiptrARB, const void *);
+#define glBufferSubDataARB sf_ptrc_glBufferSubDataARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glDeleteBuffersARB)(GLsizei, const GLuint *);
+#define glDeleteBuffersARB sf_ptrc_glDeleteBuffersARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGenBuffersARB)(GLsizei, GLuint *);
+#define glGenBuffersARB sf_ptrc_glGenBuffersARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetBufferParameterivARB)(GLenum, GLenum, GLint *);
+#define glGetBufferParameterivARB sf_ptrc_glGetBufferParameterivARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetBufferPointervARB)(GLenum, GLenum, void **);
+#define glGetBufferPointervARB sf_ptrc_glGetBufferPointervARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetBufferSubDataARB)(GLenum, GLintptrARB, GLsizeiptrARB, void *);
+#define glGetBufferSubDataARB sf_ptrc_glGetBufferSubDataARB
+extern GLboolean (CODEGEN_FUNCPTR *sf_ptrc_glIsBufferARB)(GLuint);
+#define glIsBufferARB sf_ptrc_glIsBufferARB
+extern void * (CODEGEN_FUNCPTR *sf_ptrc_glMapBufferARB)(GLenum, GLenum);
+#define glMapBufferARB sf_ptrc_glMapBufferARB
+extern GLboolean (CODEGEN_FUNCPTR *sf_ptrc_glUnmapBufferARB)(GLenum);
+#define glUnmapBufferARB sf_ptrc_glUnmapBufferARB
+#endif /*GL_ARB_vertex_buffer_object*/
+
+#ifndef GL_ARB_draw_instanced
+#define GL_ARB_draw_instanced 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glDrawArraysInstancedARB)(GLenum, GLint, GLsizei, GLsizei);
+#define glDrawArraysInstancedARB sf_ptrc_glDrawArraysInstancedARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glDrawElementsInstancedARB)(GLenum, GLsizei, GLenum, const void *, GLsizei);
+#define glDrawElementsInstancedARB sf_ptrc_glDrawElementsInstancedARB
+#endif /*GL_ARB_draw_instanced*/
+
+#ifndef GL_ARB_instanced_arrays
+#define GL_ARB_instanced_arrays 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glVertexAttribDivisorARB)(GLuint, GLuint);
+#define glVertexAttribDivisorARB sf_ptrc_glVertexAttribDivisorARB
+#endif /*GL_ARB_instanced_arrays*/
+
+#ifndef GL_ARB_map_buffer_range
+#define GL_ARB_map_buffer_range 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glFlushMappedBufferRange)(GLenum, GLintptr, GLsizeiptr);
+#define glFlushMappedBufferRange sf_ptrc_glFlushMappedBufferRange
+extern void * (CODEGEN_FUNCPTR *sf_ptrc_glMapBufferRange)(GLenum, GLintptr, GLsizeiptr, GLbitfield);
+#define glMapBufferRange sf_ptrc_glMapBufferRange
+#endif /*GL_ARB_map_buffer_range*/
+
+#ifndef GL_ARB_sync
+#define GL_ARB_sync 1
+extern GLenum (CODEGEN_FUNCPTR *sf_ptrc_glClientWaitSync)(GLsync, GLbitfield, GLuint64);
+#define glClientWaitSync sf_ptrc_glClientWaitSync
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glDeleteSync)(GLsync);
+#define glDeleteSync sf_ptrc_glDeleteSync
+extern GLsync (CODEGEN_FUNCPTR *sf_ptrc_glFenceSync)(GLenum, GLbitfield);
+#define glFenceSync sf_ptrc_glFenceSync
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetInteger64v)(GLenum, GLint64 *);
+#define glGetInteger64v sf_ptrc_glGetInteger64v
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetSynciv)(GLsync, GLenum, GLsizei, GLsizei *, GLint *);
+#define glGetSynciv sf_ptrc_glGetSynciv
+extern GLboolean (CODEGEN_FUNCPTR *sf_ptrc_glIsSync)(GLsync);
+#define glIsSync sf_ptrc_glIsSync
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glWaitSync)(GLsync, GLbitfield, GLuint64);
+#define glWaitSync sf_ptrc_glWaitSync
+#endif /*GL_ARB_sync*/
+
+#ifndef GL_ARB_buffer_storage
+#define GL_ARB_buffer_storage 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glBufferStorage)(GLenum, GLsizeiptr, const void *, GLbitfield);
+#define glBufferStorage sf_ptrc_glBufferStorage
+#endif /*GL_ARB_buffer_storage*/
+
+#ifndef GL_ARB_vertex_array_object
+#define GL_ARB_vertex_array_object 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glBindVertexArray)(GLuint);
+#define glBindVertexArray sf_ptrc_glBindVertexArray
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glDeleteVertexArrays)(GLsizei, const GLuint *);
+#define glDeleteVertexArrays sf_ptrc_glDeleteVertexArrays
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGenVertexArrays)(GLsizei, GLuint *);
+#define glGenVertexArrays sf_ptrc_glGenVertexArrays
+extern GLboolean (CODEGEN_FUNCPTR *sf_ptrc_glIsVertexArray)(GLuint);
+#define glIsVertexArray sf_ptrc_glIsVertexArray
+#endif /*GL_ARB_vertex_array_object*/
+
+#ifndef GL_ARB_texture_compression
+#define GL_ARB_texture_compression 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glCompressedTexImage1DARB)(GLenum, GLint, GLenum, GLsizei, GLint, GLsizei, const void *);
+#define glCompressedTexImage1DARB sf_ptrc_glCompressedTexImage1DARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glCompressedTexImage2DARB)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, const void *);
+#define glCompressedTexImage2DARB sf_ptrc_glCompressedTexImage2DARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glCompressedTexImage3DARB)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLsizei, GLint, GLsizei, const void *);
+#define glCompressedTexImage3DARB sf_ptrc_glCompressedTexImage3DARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glCompressedTexSubImage1DARB)(GLenum, GLint, GLint, GLsizei, GLenum, GLsizei, const void *);
+#define glCompressedTexSubImage1DARB sf_ptrc_glCompressedTexSubImage1DARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glCompressedTexSubImage2DARB)(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLsizei, const void *);
+#define glCompressedTexSubImage2DARB sf_ptrc_glCompressedTexSubImage2DARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glCompressedTexSubImage3DARB)(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLsizei, const void *);
+#define glCompressedTexSubImage3DARB sf_ptrc_glCompressedTexSubImage3DARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetCompressedTexImageARB)(GLenum, GLint, void *);
+#define glGetCompressedTexImageARB sf_ptrc_glGetCompressedTexImageARB
+#endif /*GL_ARB_texture_compression*/
+
+#ifndef GL_ARB_occlusion_query
+#define GL_ARB_occlusion_query 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glBeginQueryARB)(GLenum, GLuint);
+#define glBeginQueryARB sf_ptrc_glBeginQueryARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glDeleteQueriesARB)(GLsizei, const GLuint *);
+#define glDeleteQueriesARB sf_ptrc_glDeleteQueriesARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glEndQueryARB)(GLenum);
+#define glEndQueryARB sf_ptrc_glEndQueryARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGenQueriesARB)(GLsizei, GLuint *);
+#define glGenQueriesARB sf_ptrc_glGenQueriesARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetQueryObjectivARB)(GLuint, GLenum, GLint *);
+#define glGetQueryObjectivARB sf_ptrc_glGetQueryObjectivARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetQueryObjectuivARB)(GLuint, GLenum, GLuint *);
+#define glGetQueryObjectuivARB sf_ptrc_glGetQueryObjectuivARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetQueryivARB)(GLenum, GLenum, GLint *);
+#define glGetQueryivARB sf_ptrc_glGetQueryivARB
+extern GLboolean (CODEGEN_FUNCPTR *sf_ptrc_glIsQueryARB)(GLuint);
+#define glIsQueryARB sf_ptrc_glIsQueryARB
+#endif /*GL_ARB_occlusion_query*/
+
+#ifndef GL_ARB_timer_query
+#define GL_ARB_timer_query 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetQueryObjecti64v)(GLuint, GLenum, GLint64 *);
+#define glGetQueryObjecti64v sf_ptrc_glGetQueryObjecti64v
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetQueryObjectui64v)(GLuint, GLenum, GLuint64 *);
+#define glGetQueryObjectui64v sf_ptrc_glGetQueryObjectui64v
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glQueryCounter)(GLuint, GLenum);
+#define glQueryCounter sf_ptrc_glQueryCounter
+#endif /*GL_ARB_timer_query*/
+
+#ifndef GL_ARB_get_program_binary
+#define GL_ARB_get_program_binary 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetProgramBinary)(GLuint, GLsizei, GLsizei *, GLenum *, void *);
+#define glGetProgramBinary sf_ptrc_glGetProgramBinary
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glProgramBinary)(GLuint, GLenum, const void *, GLsizei);
+#define glProgramBinary sf_ptrc_glProgramBinary
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glProgramParameteri)(GLuint, GLenum, GLint);
+#define glProgramParameteri sf_ptrc_glProgramParameteri
+#endif /*GL_ARB_get_program_binary*/
+
+#ifndef GL_ARB_uniform_buffer_object
+#define GL_ARB_uniform_buffer_object 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glBindBufferBase)(GLenum, GLuint, GLuint);
+#define glBindBufferBase sf_ptrc_glBindBufferBase
+extern GLuint (CODEGEN_FUNCPTR *sf_ptrc_glGetUniformBlockIndex)(GLuint, const GLchar *);
+#define glGetUniformBlockIndex sf_ptrc_glGetUniformBlockIndex
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glUniformBlockBinding)(GLuint, GLuint, GLuint);
+#define glUniformBlockBinding sf_ptrc_glUniformBlockBinding
+#endif /*GL_ARB_uniform_buffer_object*/
+
+#ifndef GL_KHR_parallel_shader_compile
+#define GL_KHR_parallel_shader_compile 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glMaxShaderCompilerThreadsKHR)(GLuint);
+#define glMaxShaderCompilerThreadsKHR sf_ptrc_glMaxShaderCompilerThreadsKHR
+#endif /*GL_KHR_parallel_shader_compile*/
+
+#ifndef GL_EXT_framebuffer_blit
+#define GL_EXT_framebuffer_blit 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glBlitFramebufferEXT)(GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLbitfield, GLenum);
+#define glBlitFramebufferEXT sf_ptrc_glBlitFramebufferEXT
+#endif /*GL_EXT_framebuffer_blit*/
+
+#ifndef GL_EXT_framebuffer_multisample
+#define GL_EXT_framebuffer_multisample 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glRenderbufferStorageMultisampleEXT)(GLenum, GLsizei, GLenum, GLsizei, GLsizei);
+#define glRenderbufferStorageMultisampleEXT sf_ptrc_glRenderbufferStorageMultisampleEXT
+#endif /*GL_EXT_framebuffer_multisample*/
+
+#ifndef GL_ARB_draw_buffers
+#define GL_ARB_draw_buffers 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glDrawBuffersARB)(GLsizei, const GLenum *);
+#define glDrawBuffersARB sf_ptrc_glDrawBuffersARB
+#endif /*GL_ARB_draw_buffers*/
+
+#ifndef GL_EXT_texture3D
+#define GL_EXT_texture3D 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glTexImage3DEXT)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLsizei, GLint, GLenum, GLenum, const GLvoid *);
+#define glTexImage3DEXT sf_ptrc_glTexImage3DEXT
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glTexSubImage3DEXT)(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLenum, const GLvoid *);
+#define glTexSubImage3DEXT sf_ptrc_glTexSubImage3DEXT
+#endif /*GL_EXT_texture3D*/
+
 GLAPI void APIENTRY glBlendFunc(GLenum, GLenum);
 GLAPI void APIENTRY glClear(GLbitfield);
 GLAPI void APIENTRY glClearColor(GLfloat, GLfloat, GLfloat, GLfloat);
@@ -989,6 +1370,7 @@ GLAPI void APIENTRY glMatrixMode(GLenum);
 GLAPI void APIENTRY glMultMatrixd(const GLdouble *);
 GLAPI void APIENTRY glMultMatrixf(const GLfloat *);
 GLAPI void APIENTRY glOrtho(GLdouble, GLdouble, GLdouble, GLdouble, GLdouble, GLdouble);
+GLAPI void APIENTRY glPixelStorei(GLenum, GLint);
 GLAPI void APIENTRY glPointSize(GLfloat);
 GLAPI void APIENTRY glPopAttrib();
 GLAPI void APIENTRY glPopMatrix();
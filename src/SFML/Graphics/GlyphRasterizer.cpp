@@ -0,0 +1,347 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GlyphRasterizer.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <cstring>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_GLYPH_H
+#include FT_OUTLINE_H
+#include FT_BITMAP_H
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+GlyphRasterizer::GlyphRasterizer() :
+m_library (NULL),
+m_face    (NULL),
+m_mutex   (),
+m_requests(),
+m_results (),
+m_current (),
+m_busy    (false),
+m_stop    (false),
+m_active  (false),
+m_task    ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+GlyphRasterizer::~GlyphRasterizer()
+{
+    // Stop the worker, it finishes the glyph being rasterized first
+    ThreadPool::Task task;
+    {
+        Lock lock(m_mutex);
+        m_stop = true;
+        task = m_task;
+    }
+    task.wait();
+
+    // Destroy the face, then the library
+    if (m_face)
+        FT_Done_Face(static_cast<FT_Face>(m_face));
+
+    if (m_library)
+        FT_Done_FreeType(static_cast<FT_Library>(m_library));
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlyphRasterizer::openFromFile(const std::string& filename)
+{
+    FT_Library library;
+    if (FT_Init_FreeType(&library) != 0)
+    {
+        err() << "Failed to start the glyph loading thread of \"" << filename << "\" (failed to initialize FreeType)" << std::endl;
+        return false;
+    }
+    m_library = library;
+
+    FT_Face face;
+    if (FT_New_Face(library, filename.c_str(), 0, &face) != 0)
+    {
+        err() << "Failed to start the glyph loading thread of \"" << filename << "\" (failed to create the font face)" << std::endl;
+        return false;
+    }
+
+    if (FT_Select_Charmap(face, FT_ENCODING_UNICODE) != 0)
+    {
+        err() << "Failed to start the glyph loading thread of \"" << filename << "\" (failed to set the Unicode character set)" << std::endl;
+        FT_Done_Face(face);
+        return false;
+    }
+    m_face = face;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlyphRasterizer::openFromMemory(const void* data, std::size_t sizeInBytes)
+{
+    FT_Library library;
+    if (FT_Init_FreeType(&library) != 0)
+    {
+        err() << "Failed to start the glyph loading thread (failed to initialize FreeType)" << std::endl;
+        return false;
+    }
+    m_library = library;
+
+    FT_Face face;
+    if (FT_New_Memory_Face(library, reinterpret_cast<const FT_Byte*>(data), static_cast<FT_Long>(sizeInBytes), 0, &face) != 0)
+    {
+        err() << "Failed to start the glyph loading thread (failed to create the font face)" << std::endl;
+        return false;
+    }
+
+    if (FT_Select_Charmap(face, FT_ENCODING_UNICODE) != 0)
+    {
+        err() << "Failed to start the glyph loading thread (failed to set the Unicode character set)" << std::endl;
+        FT_Done_Face(face);
+        return false;
+    }
+    m_face = face;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphRasterizer::request(const Request& request)
+{
+    Lock lock(m_mutex);
+    m_requests.push_back(request);
+
+    // A single task at a time, the face can't be shared
+    if (m_face && !m_active)
+    {
+        m_active = true;
+        m_task = ThreadPool::getDefault().push(&GlyphRasterizer::run, this);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphRasterizer::collect(std::vector<Result>& results)
+{
+    results.clear();
+
+    Lock lock(m_mutex);
+    results.swap(m_results);
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphRasterizer::getOutstanding(std::vector<Request>& requests) const
+{
+    Lock lock(m_mutex);
+
+    requests.assign(m_requests.begin(), m_requests.end());
+
+    if (m_busy)
+        requests.push_back(m_current);
+
+    for (std::vector<Result>::const_iterator it = m_results.begin(); it != m_results.end(); ++it)
+        requests.push_back(it->request);
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlyphRasterizer::setSize(void* face, unsigned int characterSize)
+{
+    // FT_Set_Pixel_Sizes is an expensive function, so we must call it
+    // only when necessary to avoid killing performances
+
+    FT_Face ftFace = static_cast<FT_Face>(face);
+    FT_UShort currentSize = ftFace->size->metrics.x_ppem;
+
+    if (currentSize != characterSize)
+    {
+        FT_Error result = FT_Set_Pixel_Sizes(ftFace, 0, characterSize);
+
+        if (result == FT_Err_Invalid_Pixel_Size)
+        {
+            // In the case of bitmap fonts, resizing can
+            // fail if the requested size is not available
+            if (!FT_IS_SCALABLE(ftFace))
+            {
+                err() << "Failed to set bitmap font size to " << characterSize << std::endl;
+                err() << "Available sizes are: ";
+                for (int i = 0; i < ftFace->num_fixed_sizes; ++i)
+                    err() << ftFace->available_sizes[i].height << " ";
+                err() << std::endl;
+            }
+        }
+
+        return result == FT_Err_Ok;
+    }
+    else
+    {
+        return true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlyphRasterizer::rasterize(void* library, void* face, Uint32 codePoint, bool bold, Font::Hinting hinting, Glyph& glyph,
+                                std::vector<Uint8>& pixels, unsigned int& width, unsigned int& height)
+{
+    width = 0;
+    height = 0;
+
+    // Select the hinter, the auto-hinter is the most expensive one
+    FT_Int32 flags;
+    switch (hinting)
+    {
+        case Font::NoHinting:     flags = FT_LOAD_NO_HINTING;                              break;
+        case Font::LightHinting:  flags = FT_LOAD_TARGET_LIGHT;                            break;
+        case Font::NativeHinting: flags = FT_LOAD_TARGET_NORMAL;                           break;
+        default:                  flags = FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT; break;
+    }
+
+    // Load the glyph corresponding to the code point
+    FT_Face ftFace = static_cast<FT_Face>(face);
+    if (FT_Load_Char(ftFace, codePoint, flags) != 0)
+        return false;
+
+    // Retrieve the glyph
+    FT_Glyph glyphDesc;
+    if (FT_Get_Glyph(ftFace->glyph, &glyphDesc) != 0)
+        return false;
+
+    // Apply bold if necessary -- first technique using outline (highest quality)
+    FT_Pos weight = 1 << 6;
+    bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
+    if (bold && outline)
+    {
+        FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
+        FT_Outline_Embolden(&outlineGlyph->outline, weight);
+    }
+
+    // Convert the glyph to a bitmap (i.e. rasterize it)
+    FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
+    FT_Bitmap& bitmap = reinterpret_cast<FT_BitmapGlyph>(glyphDesc)->bitmap;
+
+    // Apply bold if necessary -- fallback technique using bitmap (lower quality)
+    if (bold && !outline)
+    {
+        FT_Bitmap_Embolden(static_cast<FT_Library>(library), &bitmap, weight, weight);
+    }
+
+    // Compute the glyph's advance offset
+    glyph.advance = static_cast<float>(ftFace->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6);
+    if (bold)
+        glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6);
+
+    if ((bitmap.width > 0) && (bitmap.rows > 0))
+    {
+        width  = bitmap.width;
+        height = bitmap.rows;
+
+        // Compute the glyph's bounding box
+        glyph.bounds.left   = static_cast<float>(ftFace->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
+        glyph.bounds.top    = -static_cast<float>(ftFace->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
+        glyph.bounds.width  = static_cast<float>(ftFace->glyph->metrics.width) / static_cast<float>(1 << 6);
+        glyph.bounds.height = static_cast<float>(ftFace->glyph->metrics.height) / static_cast<float>(1 << 6);
+
+        // Extract the glyph's coverage from the bitmap, it becomes the alpha channel of the texture
+        pixels.resize(width * height);
+        const Uint8* source = bitmap.buffer;
+        if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+        {
+            // Pixels are 1 bit monochrome values
+            for (unsigned int y = 0; y < height; ++y)
+            {
+                for (unsigned int x = 0; x < width; ++x)
+                    pixels[x + y * width] = ((source[x / 8]) & (1 << (7 - (x % 8)))) ? 255 : 0;
+
+                source += bitmap.pitch;
+            }
+        }
+        else
+        {
+            // Pixels are 8 bits gray levels
+            for (unsigned int y = 0; y < height; ++y)
+            {
+                std::memcpy(&pixels[y * width], source, width);
+                source += bitmap.pitch;
+            }
+        }
+    }
+
+    // Delete the FT glyph
+    FT_Done_Glyph(glyphDesc);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphRasterizer::run()
+{
+    for (;;)
+    {
+        // Take the next request, or give the pool thread back when there are none left
+        Request request;
+        {
+            Lock lock(m_mutex);
+
+            if (m_stop || m_requests.empty())
+            {
+                m_active = false;
+                return;
+            }
+
+            request = m_requests.front();
+            m_requests.pop_front();
+            m_current = request;
+            m_busy = true;
+        }
+
+        Result result;
+        result.request = request;
+        result.width = 0;
+        result.height = 0;
+        if (setSize(m_face, request.characterSize))
+            rasterize(m_library, m_face, request.codePoint, request.bold, request.hinting, result.glyph, result.pixels, result.width, result.height);
+
+        Lock lock(m_mutex);
+        m_results.push_back(result);
+        m_busy = false;
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
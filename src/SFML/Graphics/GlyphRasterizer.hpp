@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_GLYPHRASTERIZER_HPP
+#define SFML_GLYPHRASTERIZER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Glyph.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/ThreadPool.hpp>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief FreeType rasterization of glyphs, optionally in a worker thread
+///
+/// The static functions perform the rasterization with the
+/// face of a font. An instance owns a second face opened from
+/// the same source, and rasterizes the requested glyphs with
+/// it in a task of the default thread pool. Only one task
+/// runs at a time for a given instance, since FreeType faces
+/// can't be used by several threads at the same time.
+///
+////////////////////////////////////////////////////////////
+class GlyphRasterizer : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Glyph to rasterize
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Request
+    {
+        Uint32        codePoint;     ///< Unicode code point of the character
+        unsigned int  characterSize; ///< Reference character size
+        bool          bold;          ///< Rasterize the bold version?
+        Font::Hinting hinting;       ///< Hinting applied to the outline
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterized glyph, waiting to be uploaded to a texture
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Result
+    {
+        Request            request; ///< Request that produced the glyph
+        Glyph              glyph;   ///< Metrics of the glyph, without texture rectangle
+        unsigned int       width;   ///< Width of the bitmap
+        unsigned int       height;  ///< Height of the bitmap
+        std::vector<Uint8> pixels;  ///< Coverage of each pixel of the bitmap, one byte per pixel
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    GlyphRasterizer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits for the worker task, the pending requests are dropped.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~GlyphRasterizer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open the face of the worker from a file and start it
+    ///
+    /// \param filename Path of the font file
+    ///
+    /// \return True if the face could be opened
+    ///
+    ////////////////////////////////////////////////////////////
+    bool openFromFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open the face of the worker from memory and start it
+    ///
+    /// \param data        Pointer to the file data in memory
+    /// \param sizeInBytes Size of the data to load, in bytes
+    ///
+    /// \return True if the face could be opened
+    ///
+    ////////////////////////////////////////////////////////////
+    bool openFromMemory(const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Ask the worker to rasterize a glyph
+    ///
+    /// \param request Glyph to rasterize
+    ///
+    ////////////////////////////////////////////////////////////
+    void request(const Request& request);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take the glyphs rasterized so far
+    ///
+    /// \param results Array receiving the rasterized glyphs, its previous content is replaced
+    ///
+    ////////////////////////////////////////////////////////////
+    void collect(std::vector<Result>& results);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the requests whose result wasn't collected yet
+    ///
+    /// \param requests Array receiving the requests, its previous content is replaced
+    ///
+    ////////////////////////////////////////////////////////////
+    void getOutstanding(std::vector<Request>& requests) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure that a size is the current size of a face
+    ///
+    /// \param face          FreeType face (FT_Face)
+    /// \param characterSize Reference character size
+    ///
+    /// \return True on success, false if the size is not available
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool setSize(void* face, unsigned int characterSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize a glyph with the current size of a face
+    ///
+    /// The bounds are only set if the bitmap is not empty.
+    ///
+    /// \param library   FreeType library (FT_Library) of the face
+    /// \param face      FreeType face (FT_Face)
+    /// \param codePoint Unicode code point of the character
+    /// \param bold      Rasterize the bold version?
+    /// \param hinting   Hinting applied to the outline
+    /// \param glyph     Receives the advance and bounds of the glyph
+    /// \param pixels    Receives the coverage of each pixel of the bitmap, one byte per pixel
+    /// \param width     Receives the width of the bitmap
+    /// \param height    Receives the height of the bitmap
+    ///
+    /// \return True on success, false if the glyph couldn't be loaded
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool rasterize(void* library, void* face, Uint32 codePoint, bool bold, Font::Hinting hinting, Glyph& glyph,
+                          std::vector<Uint8>& pixels, unsigned int& width, unsigned int& height);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize the requested glyphs until there are none left
+    ///
+    /// Runs as a task of the default thread pool.
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    void*               m_library;  ///< FreeType library of the worker (FT_Library)
+    void*               m_face;     ///< Face of the worker (FT_Face)
+    mutable Mutex       m_mutex;    ///< Mutex protecting the queues
+    std::deque<Request> m_requests; ///< Glyphs waiting to be rasterized
+    std::vector<Result> m_results;  ///< Rasterized glyphs waiting to be collected
+    Request             m_current;  ///< Glyph being rasterized by the worker
+    bool                m_busy;     ///< Is the worker rasterizing m_current?
+    bool                m_stop;     ///< Must the worker stop?
+    bool                m_active;   ///< Is a worker task scheduled or running?
+    ThreadPool::Task    m_task;     ///< Last worker task that was started
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_GLYPHRASTERIZER_HPP
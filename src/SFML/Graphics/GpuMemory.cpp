@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GpuMemory.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <algorithm>
+#include <set>
+
+
+namespace
+{
+    // Counters that currently report memory, and the totals of each type
+    sf::Mutex mutex;
+    std::set<const sf::GpuMemory::Counter*> counters;
+    sf::Uint64 totals[sf::GpuMemory::TypeCount];
+
+    // Order the resources from the biggest to the smallest
+    bool isBigger(const sf::GpuMemory::Resource& left, const sf::GpuMemory::Resource& right)
+    {
+        return left.bytes > right.bytes;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+GpuMemory::Resource::Resource() :
+type (Textures),
+name (),
+bytes(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+GpuMemory::Counter::Counter(Type type) :
+m_type (type),
+m_name (),
+m_bytes(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+GpuMemory::Counter::~Counter()
+{
+    setBytes(0);
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuMemory::Counter::setBytes(Uint64 bytes)
+{
+    if (bytes == m_bytes)
+        return;
+
+    Lock lock(mutex);
+
+    // Only the counters that report memory are registered
+    totals[m_type] += bytes - m_bytes;
+    if (bytes == 0)
+        counters.erase(this);
+    else if (m_bytes == 0)
+        counters.insert(this);
+
+    m_bytes = bytes;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 GpuMemory::Counter::getBytes() const
+{
+    return m_bytes;
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuMemory::Counter::setName(const std::string& name)
+{
+    Lock lock(mutex);
+    m_name = name;
+}
+
+
+////////////////////////////////////////////////////////////
+std::string GpuMemory::Counter::getName() const
+{
+    Lock lock(mutex);
+    return m_name;
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuMemory::Counter::swapBytes(Counter& right)
+{
+    Uint64 bytes = m_bytes;
+    setBytes(right.m_bytes);
+    right.setBytes(bytes);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 GpuMemory::getUsage(Type type)
+{
+    Lock lock(mutex);
+    return totals[type];
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 GpuMemory::getTotalUsage()
+{
+    Lock lock(mutex);
+
+    Uint64 total = 0;
+    for (int i = 0; i < TypeCount; ++i)
+        total += totals[i];
+
+    return total;
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuMemory::getResources(std::vector<Resource>& resources)
+{
+    resources.clear();
+
+    {
+        Lock lock(mutex);
+
+        resources.reserve(counters.size());
+        for (std::set<const Counter*>::const_iterator it = counters.begin(); it != counters.end(); ++it)
+        {
+            Resource resource;
+            resource.type  = (*it)->m_type;
+            resource.name  = (*it)->m_name;
+            resource.bytes = (*it)->m_bytes;
+            resources.push_back(resource);
+        }
+    }
+
+    std::sort(resources.begin(), resources.end(), isBigger);
+}
+
+} // namespace sf
@@ -0,0 +1,251 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GpuTimer.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <cstddef>
+
+
+#ifndef SFML_OPENGL_ES
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+GpuTimer::GpuTimer() :
+m_pending  (),
+m_free     (),
+m_results  (),
+m_open     (false),
+m_contextId(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+GpuTimer::~GpuTimer()
+{
+    if (m_pending.empty() && m_free.empty())
+        return;
+
+    ensureGlContext();
+
+    // The queries can only be deleted by the context that created them
+    if (Context::getActiveContextId() != m_contextId)
+        return;
+
+    for (std::deque<Query>::const_iterator it = m_pending.begin(); it != m_pending.end(); ++it)
+    {
+        GLuint query = static_cast<GLuint>(it->id);
+        glCheck(GLEXT_glDeleteQueries(1, &query));
+    }
+
+    for (std::vector<unsigned int>::const_iterator it = m_free.begin(); it != m_free.end(); ++it)
+    {
+        GLuint query = static_cast<GLuint>(*it);
+        glCheck(GLEXT_glDeleteQueries(1, &query));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool GpuTimer::isAvailable()
+{
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    return GLEXT_occlusion_query && GLEXT_timer_query;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GpuTimer::begin(const std::string& name)
+{
+    if (m_open)
+        return false;
+
+    checkContext();
+
+    // Reuse a collected query if possible
+    GLuint query = 0;
+    if (!m_free.empty())
+    {
+        query = static_cast<GLuint>(m_free.back());
+        m_free.pop_back();
+    }
+    else
+    {
+        glCheck(GLEXT_glGenQueries(1, &query));
+    }
+
+    glCheck(GLEXT_glBeginQuery(GLEXT_GL_TIME_ELAPSED, query));
+
+    Query pending;
+    pending.id = static_cast<unsigned int>(query);
+    pending.name = name;
+    m_pending.push_back(pending);
+
+    m_open = true;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuTimer::end()
+{
+    if (!m_open)
+        return;
+
+    glCheck(GLEXT_glEndQuery(GLEXT_GL_TIME_ELAPSED));
+
+    m_open = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuTimer::poll()
+{
+    checkContext();
+
+    // Queries complete in submission order, stop at the first one that is not ready
+    // (the open query, if any, is always the last one and is never ready)
+    std::size_t open = m_open ? 1 : 0;
+    while (m_pending.size() > open)
+    {
+        GLuint query = static_cast<GLuint>(m_pending.front().id);
+
+        GLuint available = GL_FALSE;
+        glCheck(GLEXT_glGetQueryObjectuiv(query, GLEXT_GL_QUERY_RESULT_AVAILABLE, &available));
+        if (available == GL_FALSE)
+            break;
+
+        GLuint64 elapsed = 0;
+        glCheck(GLEXT_glGetQueryObjectui64v(query, GLEXT_GL_QUERY_RESULT, &elapsed));
+        m_results[m_pending.front().name] = nanoseconds(static_cast<Int64>(elapsed));
+
+        m_free.push_back(m_pending.front().id);
+        m_pending.pop_front();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Time GpuTimer::getResult(const std::string& name) const
+{
+    std::map<std::string, Time>::const_iterator it = m_results.find(name);
+
+    return (it != m_results.end()) ? it->second : Time::Zero;
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuTimer::checkContext()
+{
+    Uint64 contextId = Context::getActiveContextId();
+
+    if (contextId != m_contextId)
+    {
+        m_pending.clear();
+        m_free.clear();
+        m_open = false;
+        m_contextId = contextId;
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#else // SFML_OPENGL_ES
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+GpuTimer::GpuTimer() :
+m_pending  (),
+m_free     (),
+m_results  (),
+m_open     (false),
+m_contextId(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+GpuTimer::~GpuTimer()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool GpuTimer::isAvailable()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GpuTimer::begin(const std::string&)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuTimer::end()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuTimer::poll()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Time GpuTimer::getResult(const std::string&) const
+{
+    return Time::Zero;
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuTimer::checkContext()
+{
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#endif // SFML_OPENGL_ES
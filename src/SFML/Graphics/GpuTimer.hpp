@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_GPUTIMER_HPP
+#define SFML_GPUTIMER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Asynchronous GPU timer behind the timing zones of RenderTarget
+///
+/// Each zone is measured with a GL_TIME_ELAPSED query. The
+/// results are collected by poll() only once the GPU has
+/// made them available, so measuring never stalls the
+/// pipeline; a zone result is thus a few frames old.
+///
+////////////////////////////////////////////////////////////
+class GpuTimer : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The queries are created on first use.
+    ///
+    ////////////////////////////////////////////////////////////
+    GpuTimer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~GpuTimer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the system supports timer queries
+    ///
+    /// Timer queries require the ARB_occlusion_query and
+    /// ARB_timer_query extensions (core since OpenGL 3.3).
+    /// A context must be active.
+    ///
+    /// \return True if timer queries are supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start measuring a zone in the active context
+    ///
+    /// Zones cannot be nested, since only one time elapsed
+    /// query can be active at a time.
+    ///
+    /// \param name Name of the zone
+    ///
+    /// \return True if the measure started, false if another zone is open
+    ///
+    ////////////////////////////////////////////////////////////
+    bool begin(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop measuring the current zone
+    ///
+    ////////////////////////////////////////////////////////////
+    void end();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Collect the results that are available, without waiting
+    ///
+    ////////////////////////////////////////////////////////////
+    void poll();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the last collected duration of a zone
+    ///
+    /// \param name Name of the zone
+    ///
+    /// \return GPU time of the zone, or Time::Zero if not known yet
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getResult(const std::string& name) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the queries if they belong to another context
+    ///
+    /// Query objects are not shared between contexts, the ones
+    /// of the previous context can't be used nor deleted here.
+    ///
+    ////////////////////////////////////////////////////////////
+    void checkContext();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Measure of a zone that is not collected yet
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Query
+    {
+        unsigned int id;   ///< OpenGL identifier of the query
+        std::string  name; ///< Name of the measured zone
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::deque<Query>           m_pending;   ///< Queries issued and not collected yet, in submission order
+    std::vector<unsigned int>   m_free;      ///< Collected queries, ready to be reused
+    std::map<std::string, Time> m_results;   ///< Last collected duration of each zone
+    bool                        m_open;      ///< Is a zone being measured?
+    Uint64                      m_contextId; ///< Identifier of the context that owns the queries
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_GPUTIMER_HPP
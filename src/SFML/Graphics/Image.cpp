@@ -27,19 +27,593 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/ImageView.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/MemoryInputStream.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/ResourceStream.hpp>
 #endif
 #include <algorithm>
 #include <cstring>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_IMAGE_SSE2
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define SFML_IMAGE_NEON
+#endif
+
+
+namespace
+{
+    // Blend a row of source pixels over a row of destination pixels, using the source alpha
+    void blendPixels(const sf::Uint8* src, sf::Uint8* dst, std::size_t count)
+    {
+        std::size_t i = 0;
+
+    #if defined(SFML_IMAGE_SSE2)
+
+        // Four pixels per iteration, two per 16-bit register; x / 255 is computed exactly as (x + 1 + (x >> 8)) >> 8
+        const __m128i zero      = _mm_setzero_si128();
+        const __m128i one       = _mm_set1_epi16(1);
+        const __m128i full      = _mm_set1_epi16(255);
+        const __m128i alphaMask = _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i source      = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+            __m128i destination = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i * 4));
+            __m128i result[2];
+
+            for (int half = 0; half < 2; ++half)
+            {
+                __m128i s = half ? _mm_unpackhi_epi8(source, zero) : _mm_unpacklo_epi8(source, zero);
+                __m128i d = half ? _mm_unpackhi_epi8(destination, zero) : _mm_unpacklo_epi8(destination, zero);
+                __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+                // RGB: (s * a + d * (255 - a)) / 255, alpha: a + d * (255 - a) / 255
+                __m128i n = _mm_add_epi16(_mm_mullo_epi16(_mm_andnot_si128(alphaMask, s), a), _mm_mullo_epi16(d, _mm_sub_epi16(full, a)));
+                n = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(n, one), _mm_srli_epi16(n, 8)), 8);
+                result[half] = _mm_add_epi16(n, _mm_and_si128(alphaMask, a));
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(result[0], result[1]));
+        }
+
+    #elif defined(SFML_IMAGE_NEON)
+
+        // Eight pixels per iteration, deinterleaved; x / 255 is computed exactly as (x + 1 + (x >> 8)) >> 8
+        const uint16x8_t one = vdupq_n_u16(1);
+
+        for (; i + 8 <= count; i += 8)
+        {
+            uint8x8x4_t source      = vld4_u8(src + i * 4);
+            uint8x8x4_t destination = vld4_u8(dst + i * 4);
+            uint8x8_t   alpha       = source.val[3];
+            uint8x8_t   inverse     = vmvn_u8(alpha);
+
+            for (int c = 0; c < 4; ++c)
+            {
+                uint16x8_t n = vmull_u8(destination.val[c], inverse);
+                if (c < 3)
+                    n = vmlal_u8(n, source.val[c], alpha);
+                n = vaddq_u16(vaddq_u16(n, one), vshrq_n_u16(n, 8));
+                destination.val[c] = vshrn_n_u16(n, 8);
+            }
+            destination.val[3] = vadd_u8(destination.val[3], alpha);
+
+            vst4_u8(dst + i * 4, destination);
+        }
+
+    #endif
+
+        // Remaining pixels, or all of them without SIMD support
+        for (; i < count; ++i)
+        {
+            const sf::Uint8* s = src + i * 4;
+            sf::Uint8*       d = dst + i * 4;
+
+            sf::Uint8 alpha = s[3];
+            d[0] = (s[0] * alpha + d[0] * (255 - alpha)) / 255;
+            d[1] = (s[1] * alpha + d[1] * (255 - alpha)) / 255;
+            d[2] = (s[2] * alpha + d[2] * (255 - alpha)) / 255;
+            d[3] = alpha + d[3] * (255 - alpha) / 255;
+        }
+    }
+
+    // Blend a row of premultiplied source pixels over a row of premultiplied destination pixels
+    void blendPremultipliedPixels(const sf::Uint8* src, sf::Uint8* dst, std::size_t count)
+    {
+        std::size_t i = 0;
+
+    #if defined(SFML_IMAGE_SSE2)
+
+        // Four pixels per iteration, two per 16-bit register; x / 255 is computed exactly as (x + 1 + (x >> 8)) >> 8
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i one  = _mm_set1_epi16(1);
+        const __m128i full = _mm_set1_epi16(255);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i source      = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+            __m128i destination = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i * 4));
+            __m128i result[2];
+
+            for (int half = 0; half < 2; ++half)
+            {
+                __m128i s = half ? _mm_unpackhi_epi8(source, zero) : _mm_unpacklo_epi8(source, zero);
+                __m128i d = half ? _mm_unpackhi_epi8(destination, zero) : _mm_unpacklo_epi8(destination, zero);
+                __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+                // All channels: d * (255 - a) / 255
+                __m128i n = _mm_mullo_epi16(d, _mm_sub_epi16(full, a));
+                result[half] = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(n, one), _mm_srli_epi16(n, 8)), 8);
+            }
+
+            // ... plus s, saturated in case the source is not properly premultiplied
+            __m128i blended = _mm_adds_epu8(source, _mm_packus_epi16(result[0], result[1]));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), blended);
+        }
+
+    #elif defined(SFML_IMAGE_NEON)
+
+        // Eight pixels per iteration, deinterleaved; x / 255 is computed exactly as (x + 1 + (x >> 8)) >> 8
+        const uint16x8_t one = vdupq_n_u16(1);
+
+        for (; i + 8 <= count; i += 8)
+        {
+            uint8x8x4_t source      = vld4_u8(src + i * 4);
+            uint8x8x4_t destination = vld4_u8(dst + i * 4);
+            uint8x8_t   inverse     = vmvn_u8(source.val[3]);
+
+            for (int c = 0; c < 4; ++c)
+            {
+                uint16x8_t n = vmull_u8(destination.val[c], inverse);
+                n = vaddq_u16(vaddq_u16(n, one), vshrq_n_u16(n, 8));
+                destination.val[c] = vqadd_u8(source.val[c], vshrn_n_u16(n, 8));
+            }
+
+            vst4_u8(dst + i * 4, destination);
+        }
+
+    #endif
+
+        // Remaining pixels, or all of them without SIMD support
+        for (; i < count; ++i)
+        {
+            const sf::Uint8* s = src + i * 4;
+            sf::Uint8*       d = dst + i * 4;
+
+            unsigned int inverse = 255 - s[3];
+            for (int c = 0; c < 4; ++c)
+                d[c] = static_cast<sf::Uint8>(std::min(s[c] + d[c] * inverse / 255, 255u));
+        }
+    }
+
+    // Replace the alpha of the pixels that match a color
+    void maskPixels(sf::Uint8* pixels, std::size_t count, const sf::Color& color, sf::Uint8 alpha)
+    {
+        std::size_t i = 0;
+
+    #if defined(SFML_IMAGE_SSE2) || defined(SFML_IMAGE_NEON)
+
+        // Compare whole pixels as 32-bit words, built in memory order so that endianness doesn't matter
+        const sf::Uint8 keyBytes[4]   = {color.r, color.g, color.b, color.a};
+        const sf::Uint8 maskBytes[4]  = {0, 0, 0, 255};
+        const sf::Uint8 alphaBytes[4] = {0, 0, 0, alpha};
+        sf::Uint32 key, mask, value;
+        std::memcpy(&key, keyBytes, 4);
+        std::memcpy(&mask, maskBytes, 4);
+        std::memcpy(&value, alphaBytes, 4);
+
+    #endif
+
+    #if defined(SFML_IMAGE_SSE2)
+
+        const __m128i keys   = _mm_set1_epi32(static_cast<int>(key));
+        const __m128i masks  = _mm_set1_epi32(static_cast<int>(mask));
+        const __m128i values = _mm_set1_epi32(static_cast<int>(value));
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i* ptr = reinterpret_cast<__m128i*>(pixels + i * 4);
+            __m128i block = _mm_loadu_si128(ptr);
+            __m128i match = _mm_and_si128(_mm_cmpeq_epi32(block, keys), masks);
+            block = _mm_or_si128(_mm_andnot_si128(match, block), _mm_and_si128(match, values));
+            _mm_storeu_si128(ptr, block);
+        }
+
+    #elif defined(SFML_IMAGE_NEON)
+
+        const uint32x4_t keys   = vdupq_n_u32(key);
+        const uint32x4_t masks  = vdupq_n_u32(mask);
+        const uint32x4_t values = vdupq_n_u32(value);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            uint8x16_t bytes = vld1q_u8(pixels + i * 4);
+            uint32x4_t block = vreinterpretq_u32_u8(bytes);
+            uint32x4_t match = vandq_u32(vceqq_u32(block, keys), masks);
+            block = vbslq_u32(match, values, block);
+            vst1q_u8(pixels + i * 4, vreinterpretq_u8_u32(block));
+        }
+
+    #endif
+
+        // Remaining pixels, or all of them without SIMD support
+        for (; i < count; ++i)
+        {
+            sf::Uint8* ptr = pixels + i * 4;
+            if ((ptr[0] == color.r) && (ptr[1] == color.g) && (ptr[2] == color.b) && (ptr[3] == color.a))
+                ptr[3] = alpha;
+        }
+    }
+
+    // Reverse the order of the pixels of a row
+    void reversePixels(sf::Uint8* row, std::size_t count)
+    {
+        if (count < 2)
+            return;
+
+        std::size_t left = 0;
+        std::size_t right = count - 1;
+
+    #if defined(SFML_IMAGE_SSE2)
+
+        // Swap and reverse blocks of four pixels from both ends, as long as they don't overlap
+        for (; left + 7 <= right; left += 4, right -= 4)
+        {
+            __m128i* first = reinterpret_cast<__m128i*>(row + left * 4);
+            __m128i* last  = reinterpret_cast<__m128i*>(row + (right - 3) * 4);
+            __m128i a = _mm_shuffle_epi32(_mm_loadu_si128(first), _MM_SHUFFLE(0, 1, 2, 3));
+            __m128i b = _mm_shuffle_epi32(_mm_loadu_si128(last), _MM_SHUFFLE(0, 1, 2, 3));
+            _mm_storeu_si128(first, b);
+            _mm_storeu_si128(last, a);
+        }
+
+    #elif defined(SFML_IMAGE_NEON)
+
+        for (; left + 7 <= right; left += 4, right -= 4)
+        {
+            uint32x4_t a = vreinterpretq_u32_u8(vld1q_u8(row + left * 4));
+            uint32x4_t b = vreinterpretq_u32_u8(vld1q_u8(row + (right - 3) * 4));
+            a = vrev64q_u32(a);
+            b = vrev64q_u32(b);
+            vst1q_u8(row + left * 4, vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(b), vget_low_u32(b))));
+            vst1q_u8(row + (right - 3) * 4, vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(a), vget_low_u32(a))));
+        }
+
+    #endif
+
+        // Remaining pixels in the middle, or all of them without SIMD support
+        for (; left < right; ++left, --right)
+            std::swap_ranges(row + left * 4, row + left * 4 + 4, row + right * 4);
+    }
+
+    // Exchange the contents of two non-overlapping rows
+    void swapRows(sf::Uint8* first, sf::Uint8* second, std::size_t size)
+    {
+        std::size_t i = 0;
+
+    #if defined(SFML_IMAGE_SSE2)
+
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(first + i), b);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(second + i), a);
+        }
+
+    #elif defined(SFML_IMAGE_NEON)
+
+        for (; i + 16 <= size; i += 16)
+        {
+            uint8x16_t a = vld1q_u8(first + i);
+            uint8x16_t b = vld1q_u8(second + i);
+            vst1q_u8(first + i, b);
+            vst1q_u8(second + i, a);
+        }
+
+    #endif
+
+        // Remaining bytes, or all of them without SIMD support
+        std::swap_ranges(first + i, first + size, second + i);
+    }
+
+    // Swap the red and blue channels, which converts between RGBA and BGRA in both directions
+    void swapRedBlue(const sf::Uint8* src, sf::Uint8* dst, std::size_t count)
+    {
+        std::size_t i = 0;
+
+    #if defined(SFML_IMAGE_SSE2)
+
+        // Four pixels per iteration, as little-endian 32-bit words 0xAABBGGRR
+        const __m128i keepMask = _mm_set1_epi32(static_cast<int>(0xFF00FF00));
+        const __m128i byteMask = _mm_set1_epi32(0x000000FF);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+            __m128i red   = _mm_slli_epi32(_mm_and_si128(block, byteMask), 16);
+            __m128i blue  = _mm_and_si128(_mm_srli_epi32(block, 16), byteMask);
+            block = _mm_or_si128(_mm_and_si128(block, keepMask), _mm_or_si128(red, blue));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), block);
+        }
+
+    #elif defined(SFML_IMAGE_NEON)
+
+        // Eight pixels per iteration, deinterleaved
+        for (; i + 8 <= count; i += 8)
+        {
+            uint8x8x4_t pixels = vld4_u8(src + i * 4);
+            uint8x8_t   red    = pixels.val[0];
+            pixels.val[0] = pixels.val[2];
+            pixels.val[2] = red;
+            vst4_u8(dst + i * 4, pixels);
+        }
+
+    #endif
+
+        // Remaining pixels, or all of them without SIMD support
+        for (; i < count; ++i)
+        {
+            const sf::Uint8* s = src + i * 4;
+            sf::Uint8*       d = dst + i * 4;
+
+            sf::Uint8 red = s[0];
+            d[0] = s[2];
+            d[1] = s[1];
+            d[2] = red;
+            d[3] = s[3];
+        }
+    }
+
+    // Convert RGB pixels to opaque RGBA pixels
+    void expandRgb(const sf::Uint8* src, sf::Uint8* dst, std::size_t count)
+    {
+        std::size_t i = 0;
+
+    #if defined(SFML_IMAGE_NEON)
+
+        // Eight pixels per iteration; SSE2 has no byte shuffle, the scalar loop handles it
+        for (; i + 8 <= count; i += 8)
+        {
+            uint8x8x3_t source = vld3_u8(src + i * 3);
+            uint8x8x4_t pixels;
+            pixels.val[0] = source.val[0];
+            pixels.val[1] = source.val[1];
+            pixels.val[2] = source.val[2];
+            pixels.val[3] = vdup_n_u8(255);
+            vst4_u8(dst + i * 4, pixels);
+        }
+
+    #endif
+
+        // Remaining pixels, or all of them without SIMD support
+        for (; i < count; ++i)
+        {
+            const sf::Uint8* s = src + i * 3;
+            sf::Uint8*       d = dst + i * 4;
+
+            d[0] = s[0];
+            d[1] = s[1];
+            d[2] = s[2];
+            d[3] = 255;
+        }
+    }
+
+    // Convert RGBA pixels to RGB pixels, dropping the alpha channel
+    void packRgb(const sf::Uint8* src, sf::Uint8* dst, std::size_t count)
+    {
+        std::size_t i = 0;
+
+    #if defined(SFML_IMAGE_NEON)
+
+        // Eight pixels per iteration; SSE2 has no byte shuffle, the scalar loop handles it
+        for (; i + 8 <= count; i += 8)
+        {
+            uint8x8x4_t source = vld4_u8(src + i * 4);
+            uint8x8x3_t pixels;
+            pixels.val[0] = source.val[0];
+            pixels.val[1] = source.val[1];
+            pixels.val[2] = source.val[2];
+            vst3_u8(dst + i * 3, pixels);
+        }
+
+    #endif
+
+        // Remaining pixels, or all of them without SIMD support
+        for (; i < count; ++i)
+        {
+            const sf::Uint8* s = src + i * 4;
+            sf::Uint8*       d = dst + i * 3;
+
+            d[0] = s[0];
+            d[1] = s[1];
+            d[2] = s[2];
+        }
+    }
+
+    // Convert alpha values to white RGBA pixels
+    void expandAlpha(const sf::Uint8* src, sf::Uint8* dst, std::size_t count)
+    {
+        std::size_t i = 0;
+
+    #if defined(SFML_IMAGE_SSE2)
+
+        // Sixteen pixels per iteration, interleaving the alpha values with 0xFF bytes twice
+        const __m128i full = _mm_set1_epi8(-1);
+
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i alpha = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i low   = _mm_unpacklo_epi8(full, alpha);
+            __m128i high  = _mm_unpackhi_epi8(full, alpha);
+            __m128i* ptr  = reinterpret_cast<__m128i*>(dst + i * 4);
+            _mm_storeu_si128(ptr,     _mm_unpacklo_epi16(full, low));
+            _mm_storeu_si128(ptr + 1, _mm_unpackhi_epi16(full, low));
+            _mm_storeu_si128(ptr + 2, _mm_unpacklo_epi16(full, high));
+            _mm_storeu_si128(ptr + 3, _mm_unpackhi_epi16(full, high));
+        }
+
+    #elif defined(SFML_IMAGE_NEON)
+
+        // Eight pixels per iteration, interleaved on store
+        for (; i + 8 <= count; i += 8)
+        {
+            uint8x8x4_t pixels;
+            pixels.val[0] = vdup_n_u8(255);
+            pixels.val[1] = pixels.val[0];
+            pixels.val[2] = pixels.val[0];
+            pixels.val[3] = vld1_u8(src + i);
+            vst4_u8(dst + i * 4, pixels);
+        }
+
+    #endif
+
+        // Remaining pixels, or all of them without SIMD support
+        for (; i < count; ++i)
+        {
+            sf::Uint8* d = dst + i * 4;
+
+            d[0] = 255;
+            d[1] = 255;
+            d[2] = 255;
+            d[3] = src[i];
+        }
+    }
+
+    // Extract the alpha channel of RGBA pixels
+    void extractAlpha(const sf::Uint8* src, sf::Uint8* dst, std::size_t count)
+    {
+        std::size_t i = 0;
+
+    #if defined(SFML_IMAGE_SSE2)
+
+        // Sixteen pixels per iteration, the alpha values are the high bytes of the 32-bit words
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m128i* ptr = reinterpret_cast<const __m128i*>(src + i * 4);
+            __m128i low  = _mm_packs_epi32(_mm_srli_epi32(_mm_loadu_si128(ptr), 24), _mm_srli_epi32(_mm_loadu_si128(ptr + 1), 24));
+            __m128i high = _mm_packs_epi32(_mm_srli_epi32(_mm_loadu_si128(ptr + 2), 24), _mm_srli_epi32(_mm_loadu_si128(ptr + 3), 24));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(low, high));
+        }
+
+    #elif defined(SFML_IMAGE_NEON)
+
+        // Eight pixels per iteration, deinterleaved
+        for (; i + 8 <= count; i += 8)
+            vst1_u8(dst + i, vld4_u8(src + i * 4).val[3]);
+
+    #endif
+
+        // Remaining pixels, or all of them without SIMD support
+        for (; i < count; ++i)
+            dst[i] = src[i * 4 + 3];
+    }
+
+    // Multiply the color channels of RGBA pixels by their alpha
+    void premultiplyPixels(const sf::Uint8* src, sf::Uint8* dst, std::size_t count)
+    {
+        std::size_t i = 0;
+
+    #if defined(SFML_IMAGE_SSE2)
+
+        // Four pixels per iteration, two per 16-bit register; x / 255 is computed exactly as (x + 1 + (x >> 8)) >> 8
+        const __m128i zero      = _mm_setzero_si128();
+        const __m128i one       = _mm_set1_epi16(1);
+        const __m128i alphaMask = _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+        const __m128i alphaFull = _mm_and_si128(alphaMask, _mm_set1_epi16(255));
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+            __m128i result[2];
+
+            for (int half = 0; half < 2; ++half)
+            {
+                __m128i s = half ? _mm_unpackhi_epi8(source, zero) : _mm_unpacklo_epi8(source, zero);
+                __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+                // RGB: s * a / 255, alpha: s * 255 / 255
+                __m128i n = _mm_mullo_epi16(s, _mm_or_si128(_mm_andnot_si128(alphaMask, a), alphaFull));
+                result[half] = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(n, one), _mm_srli_epi16(n, 8)), 8);
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(result[0], result[1]));
+        }
+
+    #elif defined(SFML_IMAGE_NEON)
+
+        // Eight pixels per iteration, deinterleaved; x / 255 is computed exactly as (x + 1 + (x >> 8)) >> 8
+        const uint16x8_t one = vdupq_n_u16(1);
+
+        for (; i + 8 <= count; i += 8)
+        {
+            uint8x8x4_t pixels = vld4_u8(src + i * 4);
+
+            for (int c = 0; c < 3; ++c)
+            {
+                uint16x8_t n = vmull_u8(pixels.val[c], pixels.val[3]);
+                n = vaddq_u16(vaddq_u16(n, one), vshrq_n_u16(n, 8));
+                pixels.val[c] = vshrn_n_u16(n, 8);
+            }
+
+            vst4_u8(dst + i * 4, pixels);
+        }
+
+    #endif
+
+        // Remaining pixels, or all of them without SIMD support
+        for (; i < count; ++i)
+        {
+            const sf::Uint8* s = src + i * 4;
+            sf::Uint8*       d = dst + i * 4;
+
+            sf::Uint8 alpha = s[3];
+            d[0] = s[0] * alpha / 255;
+            d[1] = s[1] * alpha / 255;
+            d[2] = s[2] * alpha / 255;
+            d[3] = alpha;
+        }
+    }
+
+    // Divide the color channels of premultiplied pixels by their alpha
+    void unpremultiplyPixels(const sf::Uint8* src, sf::Uint8* dst, std::size_t count)
+    {
+        // There's no integer division in SSE2 or NEON, and this direction
+        // is only used for importing, so it stays scalar
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const sf::Uint8* s = src + i * 4;
+            sf::Uint8*       d = dst + i * 4;
+
+            unsigned int alpha = s[3];
+            if (alpha == 0)
+            {
+                d[0] = d[1] = d[2] = d[3] = 0;
+                continue;
+            }
+
+            d[0] = static_cast<sf::Uint8>(std::min((s[0] * 255u + alpha / 2) / alpha, 255u));
+            d[1] = static_cast<sf::Uint8>(std::min((s[1] * 255u + alpha / 2) / alpha, 255u));
+            d[2] = static_cast<sf::Uint8>(std::min((s[2] * 255u + alpha / 2) / alpha, 255u));
+            d[3] = static_cast<sf::Uint8>(alpha);
+        }
+    }
+}
+
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Image::Image() :
-m_size(0, 0)
+m_size         (0, 0),
+m_memory       (MemoryTracker::Images),
+m_premultiplied(false)
 {
     #ifdef SFML_SYSTEM_ANDROID
 
@@ -91,6 +665,8 @@ void Image::create(unsigned int width, unsigned int height, const Color& color)
         m_size.y = 0;
         m_pixels.clear();
     }
+
+    m_memory.setBytes(m_pixels.capacity());
 }
 
 
@@ -115,15 +691,68 @@ void Image::create(unsigned int width, unsigned int height, const Uint8* pixels)
         m_size.y = 0;
         m_pixels.clear();
     }
+
+    m_memory.setBytes(m_pixels.capacity());
+    m_premultiplied = false;
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Image::loadFromFile(const std::string& filename)
+void Image::create(unsigned int width, unsigned int height, const Uint8* pixels, PixelFormat format)
+{
+    // Premultiplied pixels are kept as they are
+    if ((format == Rgba) || (format == PremultipliedRgba))
+    {
+        create(width, height, pixels);
+        m_premultiplied = (format == PremultipliedRgba);
+        return;
+    }
+
+    if (pixels && width && height)
+    {
+        // Assign the new size
+        m_size.x = width;
+        m_size.y = height;
+
+        // Convert the pixels
+        std::size_t count = static_cast<std::size_t>(width) * height;
+        m_pixels.resize(count * 4);
+        switch (format)
+        {
+            case Bgra:              swapRedBlue(pixels, &m_pixels[0], count);         break;
+            case Rgb:               expandRgb(pixels, &m_pixels[0], count);           break;
+            case Alpha:             expandAlpha(pixels, &m_pixels[0], count);         break;
+            default:                std::memcpy(&m_pixels[0], pixels, count * 4);     break;
+        }
+    }
+    else
+    {
+        // Create an empty image
+        m_size.x = 0;
+        m_size.y = 0;
+        m_pixels.clear();
+    }
+
+    m_memory.setBytes(m_pixels.capacity());
+    m_premultiplied = false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::loadFromFile(const std::string& filename, bool premultiply)
 {
     #ifndef SFML_SYSTEM_ANDROID
 
-        return priv::ImageLoader::getInstance().loadImageFromFile(filename, m_pixels, m_size);
+        bool result = priv::ImageLoader::getInstance().loadImageFromFile(filename, m_pixels, m_size);
+        m_memory.setBytes(m_pixels.capacity());
+        if (result)
+        {
+            // Decoded files have straight alpha
+            m_premultiplied = false;
+            if (premultiply)
+                premultiplyAlpha();
+        }
+        return result;
 
     #else
 
@@ -131,30 +760,143 @@ bool Image::loadFromFile(const std::string& filename)
             delete (priv::ResourceStream*)m_stream;
 
         m_stream = new priv::ResourceStream(filename);
-        return loadFromStream(*(priv::ResourceStream*)m_stream);
+        return loadFromStream(*(priv::ResourceStream*)m_stream, premultiply);
 
     #endif
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Image::loadFromMemory(const void* data, std::size_t size)
+bool Image::loadFromMemory(const void* data, std::size_t size, bool premultiply)
 {
-    return priv::ImageLoader::getInstance().loadImageFromMemory(data, size, m_pixels, m_size);
+    bool result = priv::ImageLoader::getInstance().loadImageFromMemory(data, size, m_pixels, m_size);
+    m_memory.setBytes(m_pixels.capacity());
+    if (result)
+    {
+        // Decoded files have straight alpha
+        m_premultiplied = false;
+        if (premultiply)
+            premultiplyAlpha();
+    }
+    return result;
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Image::loadFromStream(InputStream& stream)
+bool Image::loadFromStream(InputStream& stream, bool premultiply)
 {
-    return priv::ImageLoader::getInstance().loadImageFromStream(stream, m_pixels, m_size);
+    bool result = priv::ImageLoader::getInstance().loadImageFromStream(stream, m_pixels, m_size);
+    m_memory.setBytes(m_pixels.capacity());
+    if (result)
+    {
+        // Decoded files have straight alpha
+        m_premultiplied = false;
+        if (premultiply)
+            premultiplyAlpha();
+    }
+    return result;
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Image::saveToFile(const std::string& filename) const
+bool Image::loadFromFile(const std::string& filename, const LoadSettings& settings)
 {
-    return priv::ImageLoader::getInstance().saveImageToFile(filename, m_pixels, m_size);
+    FileInputStream stream;
+    if (!stream.open(filename))
+    {
+        err() << "Failed to load image \"" << filename << "\". Reason: Unable to open file" << std::endl;
+        return false;
+    }
+
+    return loadFromStream(stream, settings);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::loadFromMemory(const void* data, std::size_t size, const LoadSettings& settings)
+{
+    if (!data || !size)
+    {
+        err() << "Failed to load image from memory, no data provided" << std::endl;
+        return false;
+    }
+
+    MemoryInputStream stream;
+    stream.open(data, size);
+
+    return loadFromStream(stream, settings);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::loadFromStream(InputStream& stream, const LoadSettings& settings)
+{
+    // Decode to a separate array, so that the image is kept if decoding fails
+    std::vector<Uint8> pixels;
+    Vector2u size;
+    if (!priv::ImageLoader::getInstance().loadImageFromStream(stream, settings.scale, pixels, size))
+        return false;
+
+    m_pixels.swap(pixels);
+    m_size = size;
+    m_memory.setBytes(m_pixels.capacity());
+
+    // Decoded files have straight alpha
+    m_premultiplied = false;
+    if (settings.premultiply)
+        premultiplyAlpha();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::readSize(InputStream& stream, Vector2u& size, const LoadSettings& settings)
+{
+    return priv::ImageLoader::getInstance().readImageSize(stream, settings.scale, size);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::decode(InputStream& stream, Uint8* pixels, std::size_t capacity, Vector2u& size, const LoadSettings& settings)
+{
+    if (!priv::ImageLoader::getInstance().decodeImage(stream, settings.scale, pixels, capacity, size))
+        return false;
+
+    if (settings.premultiply)
+        premultiplyPixels(pixels, pixels, static_cast<std::size_t>(size.x) * size.y);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::saveToFile(const std::string& filename, const SaveSettings& settings) const
+{
+    // Image files store straight alpha
+    if (m_premultiplied && !m_pixels.empty())
+    {
+        std::vector<Uint8> pixels(m_pixels.size());
+        unpremultiplyPixels(&m_pixels[0], &pixels[0], pixels.size() / 4);
+        return priv::ImageLoader::getInstance().saveImageToFile(filename, pixels, m_size, settings);
+    }
+
+    return priv::ImageLoader::getInstance().saveImageToFile(filename, m_pixels, m_size, settings);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::saveToMemory(std::vector<Uint8>& output, const std::string& format, const SaveSettings& settings) const
+{
+    // Image files store straight alpha
+    if (m_premultiplied && !m_pixels.empty())
+    {
+        std::vector<Uint8> pixels(m_pixels.size());
+        unpremultiplyPixels(&m_pixels[0], &pixels[0], pixels.size() / 4);
+        return priv::ImageLoader::getInstance().saveImageToMemory(format, output, pixels, m_size, settings);
+    }
+
+    return priv::ImageLoader::getInstance().saveImageToMemory(format, output, m_pixels, m_size, settings);
 }
 
 
@@ -172,45 +914,28 @@ void Image::createMaskFromColor(const Color& color, Uint8 alpha)
     if (!m_pixels.empty())
     {
         // Replace the alpha of the pixels that match the transparent color
-        Uint8* ptr = &m_pixels[0];
-        Uint8* end = ptr + m_pixels.size();
-        while (ptr < end)
-        {
-            if ((ptr[0] == color.r) && (ptr[1] == color.g) && (ptr[2] == color.b) && (ptr[3] == color.a))
-                ptr[3] = alpha;
-            ptr += 4;
-        }
+        maskPixels(&m_pixels[0], m_pixels.size() / 4, color, alpha);
     }
 }
 
 
 ////////////////////////////////////////////////////////////
 void Image::copy(const Image& source, unsigned int destX, unsigned int destY, const IntRect& sourceRect, bool applyAlpha)
+{
+    copy(ImageView(source, sourceRect), destX, destY, applyAlpha);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::copy(const ImageView& source, unsigned int destX, unsigned int destY, bool applyAlpha)
 {
     // Make sure that both images are valid
-    if ((source.m_size.x == 0) || (source.m_size.y == 0) || (m_size.x == 0) || (m_size.y == 0))
+    if ((source.getSize().x == 0) || (source.getSize().y == 0) || (m_size.x == 0) || (m_size.y == 0))
         return;
 
-    // Adjust the source rectangle
-    IntRect srcRect = sourceRect;
-    if (srcRect.width == 0 || (srcRect.height == 0))
-    {
-        srcRect.left   = 0;
-        srcRect.top    = 0;
-        srcRect.width  = source.m_size.x;
-        srcRect.height = source.m_size.y;
-    }
-    else
-    {
-        if (srcRect.left   < 0) srcRect.left = 0;
-        if (srcRect.top    < 0) srcRect.top  = 0;
-        if (srcRect.width  > static_cast<int>(source.m_size.x)) srcRect.width  = source.m_size.x;
-        if (srcRect.height > static_cast<int>(source.m_size.y)) srcRect.height = source.m_size.y;
-    }
-
-    // Then find the valid bounds of the destination rectangle
-    int width  = srcRect.width;
-    int height = srcRect.height;
+    // Find the valid bounds of the destination rectangle
+    int width  = source.getSize().x;
+    int height = source.getSize().y;
     if (destX + width  > m_size.x) width  = m_size.x - destX;
     if (destY + height > m_size.y) height = m_size.y - destY;
 
@@ -221,30 +946,21 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
     // Precompute as much as possible
     int          pitch     = width * 4;
     int          rows      = height;
-    int          srcStride = source.m_size.x * 4;
+    int          srcStride = source.getStride() * 4;
     int          dstStride = m_size.x * 4;
-    const Uint8* srcPixels = &source.m_pixels[0] + (srcRect.left + srcRect.top * source.m_size.x) * 4;
+    const Uint8* srcPixels = source.getPixelsPtr();
     Uint8*       dstPixels = &m_pixels[0] + (destX + destY * m_size.x) * 4;
 
     // Copy the pixels
     if (applyAlpha)
     {
-        // Interpolation using alpha values, pixel by pixel (slower)
+        // Interpolation using alpha values, row by row (slower)
         for (int i = 0; i < rows; ++i)
         {
-            for (int j = 0; j < width; ++j)
-            {
-                // Get a direct pointer to the components of the current pixel
-                const Uint8* src = srcPixels + j * 4;
-                Uint8*       dst = dstPixels + j * 4;
-
-                // Interpolate RGBA components using the alpha value of the source pixel
-                Uint8 alpha = src[3];
-                dst[0] = (src[0] * alpha + dst[0] * (255 - alpha)) / 255;
-                dst[1] = (src[1] * alpha + dst[1] * (255 - alpha)) / 255;
-                dst[2] = (src[2] * alpha + dst[2] * (255 - alpha)) / 255;
-                dst[3] = alpha + dst[3] * (255 - alpha) / 255;
-            }
+            if (m_premultiplied)
+                blendPremultipliedPixels(srcPixels, dstPixels, width);
+            else
+                blendPixels(srcPixels, dstPixels, width);
 
             srcPixels += srcStride;
             dstPixels += dstStride;
@@ -297,6 +1013,85 @@ const Uint8* Image::getPixelsPtr() const
 }
 
 
+////////////////////////////////////////////////////////////
+void Image::exportPixels(Uint8* pixels, PixelFormat format) const
+{
+    if (m_pixels.empty() || !pixels)
+        return;
+
+    std::size_t count = static_cast<std::size_t>(m_size.x) * m_size.y;
+
+    // The pixels are already in one of the RGBA formats, the other one needs a conversion
+    if ((format == Rgba) && m_premultiplied)
+    {
+        unpremultiplyPixels(&m_pixels[0], pixels, count);
+        return;
+    }
+    else if (format == PremultipliedRgba)
+    {
+        if (m_premultiplied)
+            std::memcpy(pixels, &m_pixels[0], count * 4);
+        else
+            premultiplyPixels(&m_pixels[0], pixels, count);
+        return;
+    }
+
+    switch (format)
+    {
+        case Bgra:  swapRedBlue(&m_pixels[0], pixels, count);     break;
+        case Rgb:   packRgb(&m_pixels[0], pixels, count);         break;
+        case Alpha: extractAlpha(&m_pixels[0], pixels, count);    break;
+        default:    std::memcpy(pixels, &m_pixels[0], count * 4); break;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::premultiplyAlpha()
+{
+    if (!m_premultiplied && !m_pixels.empty())
+        premultiplyPixels(&m_pixels[0], &m_pixels[0], m_pixels.size() / 4);
+
+    m_premultiplied = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::unpremultiplyAlpha()
+{
+    if (m_premultiplied && !m_pixels.empty())
+        unpremultiplyPixels(&m_pixels[0], &m_pixels[0], m_pixels.size() / 4);
+
+    m_premultiplied = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::setPremultiplied(bool premultiplied)
+{
+    m_premultiplied = premultiplied;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::isPremultiplied() const
+{
+    return m_premultiplied;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Image::getPixelSize(PixelFormat format)
+{
+    switch (format)
+    {
+        case Rgb:   return 3;
+        case Alpha: return 1;
+        default:    return 4;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void Image::flipHorizontally()
 {
@@ -305,18 +1100,7 @@ void Image::flipHorizontally()
         std::size_t rowSize = m_size.x * 4;
 
         for (std::size_t y = 0; y < m_size.y; ++y)
-        {
-            std::vector<Uint8>::iterator left = m_pixels.begin() + y * rowSize;
-            std::vector<Uint8>::iterator right = m_pixels.begin() + (y + 1) * rowSize - 4;
-
-            for (std::size_t x = 0; x < m_size.x / 2; ++x)
-            {
-                std::swap_ranges(left, left + 4, right);
-
-                left += 4;
-                right -= 4;
-            }
-        }
+            reversePixels(&m_pixels[y * rowSize], m_size.x);
     }
 }
 
@@ -328,12 +1112,12 @@ void Image::flipVertically()
     {
         std::size_t rowSize = m_size.x * 4;
 
-        std::vector<Uint8>::iterator top = m_pixels.begin();
-        std::vector<Uint8>::iterator bottom = m_pixels.end() - rowSize;
+        Uint8* top = &m_pixels[0];
+        Uint8* bottom = &m_pixels[0] + m_pixels.size() - rowSize;
 
         for (std::size_t y = 0; y < m_size.y / 2; ++y)
         {
-            std::swap_ranges(top, top + rowSize, bottom);
+            swapRows(top, bottom, rowSize);
 
             top += rowSize;
             bottom -= rowSize;
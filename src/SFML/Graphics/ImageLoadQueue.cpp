@@ -0,0 +1,227 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageLoadQueue.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/System/Lock.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ImageLoadQueue::ImageLoadQueue(unsigned int threadCount) :
+m_jobs     (),
+m_results  (),
+m_nextId   (0),
+m_pending  (0),
+m_decoding (0),
+m_tasks    (),
+m_taskCount(0),
+m_maxTasks (threadCount > 0 ? threadCount : 1),
+m_mutex    ()
+{
+    // Create the image loader now, its lazy construction is not thread-safe
+    priv::ImageLoader::getInstance();
+}
+
+
+////////////////////////////////////////////////////////////
+ImageLoadQueue::~ImageLoadQueue()
+{
+    // Drop the queued jobs, the tasks finish the ones being decoded and return
+    std::vector<ThreadPool::Task> tasks;
+    {
+        Lock lock(m_mutex);
+        m_jobs.clear();
+        tasks.swap(m_tasks);
+    }
+
+    for (std::vector<ThreadPool::Task>::const_iterator it = tasks.begin(); it != tasks.end(); ++it)
+        it->wait();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageLoadQueue::push(const std::string& filename)
+{
+    Job job;
+    job.filename = filename;
+    job.data = NULL;
+    job.size = 0;
+    job.stream = NULL;
+
+    return addJob(job);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageLoadQueue::push(const void* data, std::size_t size)
+{
+    Job job;
+    job.data = data;
+    job.size = size;
+    job.stream = NULL;
+
+    return addJob(job);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageLoadQueue::push(InputStream& stream)
+{
+    Job job;
+    job.data = NULL;
+    job.size = 0;
+    job.stream = &stream;
+
+    return addJob(job);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoadQueue::pop(Result& result)
+{
+    Lock lock(m_mutex);
+
+    if (m_results.empty())
+        return false;
+
+    result = m_results.front();
+    m_results.pop_front();
+    m_pending--;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoadQueue::isReady() const
+{
+    Lock lock(m_mutex);
+
+    return !m_results.empty();
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageLoadQueue::wait() const
+{
+    for (;;)
+    {
+        std::vector<ThreadPool::Task> tasks;
+        {
+            Lock lock(m_mutex);
+
+            if (m_jobs.empty() && (m_decoding == 0))
+                return;
+
+            tasks = m_tasks;
+        }
+
+        // Waiting for the tasks runs pending pool work, instead of just sleeping
+        for (std::vector<ThreadPool::Task>::const_iterator it = tasks.begin(); it != tasks.end(); ++it)
+            it->wait();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageLoadQueue::getPendingCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_pending;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageLoadQueue::addJob(Job& job)
+{
+    Lock lock(m_mutex);
+
+    job.id = m_nextId++;
+    m_jobs.push_back(job);
+    m_pending++;
+
+    // Start another decoding task unless enough of them are already running
+    if (m_taskCount < m_maxTasks)
+    {
+        std::vector<ThreadPool::Task>::iterator it = m_tasks.begin();
+        while (it != m_tasks.end())
+        {
+            if (it->isDone())
+                it = m_tasks.erase(it);
+            else
+                ++it;
+        }
+
+        m_taskCount++;
+        m_tasks.push_back(ThreadPool::getDefault().push(&ImageLoadQueue::run, this));
+    }
+
+    return job.id;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageLoadQueue::run()
+{
+    for (;;)
+    {
+        // Take the next job, or give the pool thread back when there are none left
+        Job job;
+        {
+            Lock lock(m_mutex);
+
+            if (m_jobs.empty())
+            {
+                m_taskCount--;
+                return;
+            }
+
+            job = m_jobs.front();
+            m_jobs.pop_front();
+            m_decoding++;
+        }
+
+        // Decode the image outside the lock, so that the workers run in parallel
+        Result result;
+        result.id = job.id;
+        if (job.stream)
+            result.success = result.image.loadFromStream(*job.stream);
+        else if (job.data)
+            result.success = result.image.loadFromMemory(job.data, job.size);
+        else
+            result.success = result.image.loadFromFile(job.filename);
+
+        Lock lock(m_mutex);
+        m_results.push_back(result);
+        m_decoding--;
+    }
+}
+
+} // namespace sf
@@ -27,6 +27,8 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/ImageLoader.hpp>
 #include <SFML/System/InputStream.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/MemoryInputStream.hpp>
 #include <SFML/System/Err.hpp>
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -37,7 +39,12 @@ extern "C"
     #include <jpeglib.h>
     #include <jerror.h>
 }
+#include <algorithm>
 #include <cctype>
+#include <csetjmp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 
 namespace
@@ -66,6 +73,393 @@ namespace
         sf::InputStream* stream = static_cast<sf::InputStream*>(user);
         return stream->tell() >= stream->getSize();
     }
+
+    // Get the contents of a stream if they are accessible in memory
+    // (mapped file or memory stream), NULL otherwise
+    const void* getStreamData(sf::InputStream& stream)
+    {
+        if (sf::FileInputStream* file = dynamic_cast<sf::FileInputStream*>(&stream))
+            return file->getData();
+        else if (sf::MemoryInputStream* memory = dynamic_cast<sf::MemoryInputStream*>(&stream))
+            return memory->getData();
+        else
+            return NULL;
+    }
+
+    // Append integers to an encoded file
+    void writeLittleEndian16(std::vector<sf::Uint8>& output, sf::Uint32 value)
+    {
+        output.push_back(static_cast<sf::Uint8>(value & 0xFF));
+        output.push_back(static_cast<sf::Uint8>((value >> 8) & 0xFF));
+    }
+    void writeLittleEndian32(std::vector<sf::Uint8>& output, sf::Uint32 value)
+    {
+        writeLittleEndian16(output, value & 0xFFFF);
+        writeLittleEndian16(output, value >> 16);
+    }
+    void writeBigEndian32(std::vector<sf::Uint8>& output, sf::Uint32 value)
+    {
+        output.push_back(static_cast<sf::Uint8>(value >> 24));
+        output.push_back(static_cast<sf::Uint8>((value >> 16) & 0xFF));
+        output.push_back(static_cast<sf::Uint8>((value >> 8) & 0xFF));
+        output.push_back(static_cast<sf::Uint8>(value & 0xFF));
+    }
+
+    // CRC of the PNG chunks; the table is built before main, so that encoders can run on any thread
+    struct CrcTable
+    {
+        CrcTable()
+        {
+            for (sf::Uint32 i = 0; i < 256; ++i)
+            {
+                sf::Uint32 crc = i;
+                for (int j = 0; j < 8; ++j)
+                    crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+                values[i] = crc;
+            }
+        }
+
+        sf::Uint32 values[256];
+    };
+    const CrcTable crcTable;
+
+    sf::Uint32 crc32(const sf::Uint8* data, std::size_t size)
+    {
+        sf::Uint32 crc = 0xFFFFFFFF;
+        for (std::size_t i = 0; i < size; ++i)
+            crc = (crc >> 8) ^ crcTable.values[(crc ^ data[i]) & 0xFF];
+        return ~crc;
+    }
+
+    // Checksum of the uncompressed zlib data
+    sf::Uint32 adler32(const sf::Uint8* data, std::size_t size)
+    {
+        sf::Uint32 a = 1;
+        sf::Uint32 b = 0;
+        while (size > 0)
+        {
+            // 5552 is the largest block that can't overflow the sums before the modulo
+            std::size_t block = std::min<std::size_t>(size, 5552);
+            for (std::size_t i = 0; i < block; ++i)
+            {
+                a += data[i];
+                b += a;
+            }
+            a %= 65521;
+            b %= 65521;
+            data += block;
+            size -= block;
+        }
+        return (b << 16) | a;
+    }
+
+    // Append a PNG chunk
+    void writePngChunk(std::vector<sf::Uint8>& output, const char* type, const sf::Uint8* data, std::size_t size)
+    {
+        writeBigEndian32(output, static_cast<sf::Uint32>(size));
+        std::size_t start = output.size();
+        output.insert(output.end(), type, type + 4);
+        if (size > 0)
+            output.insert(output.end(), data, data + size);
+        writeBigEndian32(output, crc32(&output[start], output.size() - start));
+    }
+
+    // PNG Paeth predictor
+    sf::Uint8 paeth(int a, int b, int c)
+    {
+        int p  = a + b - c;
+        int pa = std::abs(p - a);
+        int pb = std::abs(p - b);
+        int pc = std::abs(p - c);
+        if ((pa <= pb) && (pa <= pc))
+            return static_cast<sf::Uint8>(a);
+        else if (pb <= pc)
+            return static_cast<sf::Uint8>(b);
+        else
+            return static_cast<sf::Uint8>(c);
+    }
+
+    // Apply a PNG filter to a row of RGBA pixels; previous is NULL for the first row
+    void filterRow(sf::Image::PngFilter filter, const sf::Uint8* row, const sf::Uint8* previous, std::size_t size, sf::Uint8* output)
+    {
+        // The first row behaves as if the previous one was black
+        if (!previous)
+        {
+            if ((filter == sf::Image::UpFilter) || (filter == sf::Image::NoFilter))
+            {
+                std::memcpy(output, row, size);
+                return;
+            }
+
+            if (filter == sf::Image::PaethFilter)
+                filter = sf::Image::SubFilter;
+        }
+
+        // The first pixel has no left neighbour
+        std::size_t first = std::min<std::size_t>(size, 4);
+
+        switch (filter)
+        {
+            default:
+            case sf::Image::NoFilter:
+                std::memcpy(output, row, size);
+                break;
+
+            case sf::Image::SubFilter:
+                std::memcpy(output, row, first);
+                for (std::size_t i = first; i < size; ++i)
+                    output[i] = static_cast<sf::Uint8>(row[i] - row[i - 4]);
+                break;
+
+            case sf::Image::UpFilter:
+                for (std::size_t i = 0; i < size; ++i)
+                    output[i] = static_cast<sf::Uint8>(row[i] - previous[i]);
+                break;
+
+            case sf::Image::AverageFilter:
+                for (std::size_t i = 0; i < first; ++i)
+                    output[i] = static_cast<sf::Uint8>(row[i] - (previous ? previous[i] >> 1 : 0));
+                for (std::size_t i = first; i < size; ++i)
+                    output[i] = static_cast<sf::Uint8>(row[i] - ((row[i - 4] + (previous ? previous[i] : 0)) >> 1));
+                break;
+
+            case sf::Image::PaethFilter:
+                for (std::size_t i = 0; i < first; ++i)
+                    output[i] = static_cast<sf::Uint8>(row[i] - previous[i]);
+                for (std::size_t i = first; i < size; ++i)
+                    output[i] = static_cast<sf::Uint8>(row[i] - paeth(row[i - 4], previous[i], previous[i - 4]));
+                break;
+        }
+    }
+
+    // Wrap data in uncompressed deflate blocks, for the fastest PNG encoding
+    void storeZlib(const std::vector<sf::Uint8>& data, std::vector<sf::Uint8>& output)
+    {
+        std::size_t blockCount = (data.size() + 65534) / 65535;
+        output.clear();
+        output.reserve(data.size() + blockCount * 5 + 6);
+
+        // Header: deflate with a 32K window, fastest compression
+        output.push_back(0x78);
+        output.push_back(0x01);
+
+        std::size_t offset = 0;
+        do
+        {
+            std::size_t size = std::min<std::size_t>(data.size() - offset, 65535);
+            bool last = offset + size == data.size();
+            output.push_back(last ? 1 : 0);
+            writeLittleEndian16(output, static_cast<sf::Uint32>(size));
+            writeLittleEndian16(output, static_cast<sf::Uint32>(~size & 0xFFFF));
+            if (size > 0)
+                output.insert(output.end(), data.begin() + offset, data.begin() + offset + size);
+            offset += size;
+        }
+        while (offset < data.size());
+
+        writeBigEndian32(output, adler32(data.empty() ? NULL : &data[0], data.size()));
+    }
+
+    // libjpeg destination that writes to a sf::Uint8 vector
+    struct JpegDestination
+    {
+        jpeg_destination_mgr     manager;
+        std::vector<sf::Uint8>*  output;
+        JOCTET                   buffer[4096];
+    };
+    void initDestination(j_compress_ptr compressInfos)
+    {
+        JpegDestination* destination = reinterpret_cast<JpegDestination*>(compressInfos->dest);
+        destination->manager.next_output_byte = destination->buffer;
+        destination->manager.free_in_buffer   = sizeof(destination->buffer);
+    }
+    boolean emptyOutputBuffer(j_compress_ptr compressInfos)
+    {
+        JpegDestination* destination = reinterpret_cast<JpegDestination*>(compressInfos->dest);
+        destination->output->insert(destination->output->end(), destination->buffer, destination->buffer + sizeof(destination->buffer));
+        destination->manager.next_output_byte = destination->buffer;
+        destination->manager.free_in_buffer   = sizeof(destination->buffer);
+        return TRUE;
+    }
+    void termDestination(j_compress_ptr compressInfos)
+    {
+        JpegDestination* destination = reinterpret_cast<JpegDestination*>(compressInfos->dest);
+        std::size_t size = sizeof(destination->buffer) - destination->manager.free_in_buffer;
+        destination->output->insert(destination->output->end(), destination->buffer, destination->buffer + size);
+    }
+
+    // libjpeg source that reads from a sf::InputStream, or directly
+    // from memory when the stream is NULL
+    struct JpegSource
+    {
+        jpeg_source_mgr  manager;
+        sf::InputStream* stream;
+        JOCTET           buffer[4096];
+    };
+    void initSource(j_decompress_ptr)
+    {
+        // Nothing to do
+    }
+    boolean fillInputBuffer(j_decompress_ptr decompressInfos)
+    {
+        JpegSource* source = reinterpret_cast<JpegSource*>(decompressInfos->src);
+        sf::Int64 count = source->stream ? source->stream->read(source->buffer, sizeof(source->buffer)) : 0;
+        if (count <= 0)
+        {
+            // Truncated file: insert a fake end marker, libjpeg keeps what it already decoded
+            WARNMS(decompressInfos, JWRN_JPEG_EOF);
+            source->buffer[0] = 0xFF;
+            source->buffer[1] = JPEG_EOI;
+            count = 2;
+        }
+        source->manager.next_input_byte = source->buffer;
+        source->manager.bytes_in_buffer = static_cast<std::size_t>(count);
+        return TRUE;
+    }
+    void skipInputData(j_decompress_ptr decompressInfos, long count)
+    {
+        JpegSource* source = reinterpret_cast<JpegSource*>(decompressInfos->src);
+        if (count <= 0)
+            return;
+
+        if (static_cast<std::size_t>(count) <= source->manager.bytes_in_buffer)
+        {
+            source->manager.next_input_byte += count;
+            source->manager.bytes_in_buffer -= count;
+        }
+        else
+        {
+            // Skip the rest directly in the stream, without reading it
+            sf::Int64 remaining = count - static_cast<long>(source->manager.bytes_in_buffer);
+            source->manager.bytes_in_buffer = 0;
+            if (source->stream)
+                source->stream->seek(source->stream->tell() + remaining);
+        }
+    }
+    void termSource(j_decompress_ptr)
+    {
+        // Nothing to do
+    }
+
+    // libjpeg error handler that jumps back to the decoder instead of exiting
+    struct JpegError
+    {
+        jpeg_error_mgr manager;
+        std::jmp_buf   jump;
+        char           message[JMSG_LENGTH_MAX];
+    };
+    void errorExit(j_common_ptr infos)
+    {
+        JpegError* error = reinterpret_cast<JpegError*>(infos->err);
+        error->manager.format_message(infos, error->message);
+        std::longjmp(error->jump, 1);
+    }
+    void outputMessage(j_common_ptr)
+    {
+        // Ignore the warnings, libjpeg recovers from them
+    }
+
+    // Check whether a stream starts with the JPEG signature
+    bool isJpeg(sf::InputStream& stream)
+    {
+        unsigned char signature[3] = {0, 0, 0};
+        stream.seek(0);
+        bool jpeg = (stream.read(signature, sizeof(signature)) == sizeof(signature)) &&
+                    (signature[0] == 0xFF) && (signature[1] == 0xD8) && (signature[2] == 0xFF);
+        stream.seek(0);
+        return jpeg;
+    }
+
+    // Expand a row of decoded JPEG samples to RGBA in place; the samples
+    // are stored at the end of the row, so each pixel is read before
+    // its bytes can be overwritten
+    void expandJpegRow(sf::Uint8* row, unsigned int width, int components)
+    {
+        const sf::Uint8* samples = row + width * (4 - components);
+        for (unsigned int i = 0; i < width; ++i)
+        {
+            sf::Uint8 r, g, b;
+            if (components == 1)
+            {
+                r = g = b = samples[i];
+            }
+            else if (components == 3)
+            {
+                r = samples[i * 3 + 0];
+                g = samples[i * 3 + 1];
+                b = samples[i * 3 + 2];
+            }
+            else
+            {
+                // Adobe CMYK, stored inverted
+                unsigned int k = samples[i * 4 + 3];
+                r = static_cast<sf::Uint8>(samples[i * 4 + 0] * k / 255);
+                g = static_cast<sf::Uint8>(samples[i * 4 + 1] * k / 255);
+                b = static_cast<sf::Uint8>(samples[i * 4 + 2] * k / 255);
+            }
+
+            row[i * 4 + 0] = r;
+            row[i * 4 + 1] = g;
+            row[i * 4 + 2] = b;
+            row[i * 4 + 3] = 255;
+        }
+    }
+
+    // Check the reduction factor of a decoder
+    bool checkScale(unsigned int scale)
+    {
+        if ((scale == 1) || (scale == 2) || (scale == 4) || (scale == 8))
+            return true;
+
+        sf::err() << "Failed to load image, the scale must be 1, 2, 4 or 8 (got " << scale << ")" << std::endl;
+        return false;
+    }
+
+    // Get the size of an image reduced by a scale factor, rounded up
+    sf::Vector2u scaleSize(const sf::Vector2u& size, unsigned int scale)
+    {
+        return sf::Vector2u((size.x + scale - 1) / scale, (size.y + scale - 1) / scale);
+    }
+
+    // Reduce an image by averaging blocks of scale x scale pixels; colors
+    // are weighted by alpha so that transparent pixels don't darken the edges
+    void downscale(const sf::Uint8* source, const sf::Vector2u& sourceSize, unsigned int scale, sf::Uint8* destination)
+    {
+        sf::Vector2u size = scaleSize(sourceSize, scale);
+        for (unsigned int y = 0; y < size.y; ++y)
+        {
+            for (unsigned int x = 0; x < size.x; ++x)
+            {
+                unsigned int left   = x * scale;
+                unsigned int top    = y * scale;
+                unsigned int right  = std::min(left + scale, sourceSize.x);
+                unsigned int bottom = std::min(top + scale, sourceSize.y);
+
+                sf::Uint32 color[3]    = {0, 0, 0};
+                sf::Uint32 weighted[3] = {0, 0, 0};
+                sf::Uint32 alpha       = 0;
+                for (unsigned int j = top; j < bottom; ++j)
+                {
+                    const sf::Uint8* pixel = source + (static_cast<std::size_t>(j) * sourceSize.x + left) * 4;
+                    for (unsigned int i = left; i < right; ++i, pixel += 4)
+                    {
+                        for (int c = 0; c < 3; ++c)
+                        {
+                            color[c]    += pixel[c];
+                            weighted[c] += pixel[c] * pixel[3];
+                        }
+                        alpha += pixel[3];
+                    }
+                }
+
+                sf::Uint32 count = (right - left) * (bottom - top);
+                sf::Uint8* output = destination + (static_cast<std::size_t>(y) * size.x + x) * 4;
+                for (int c = 0; c < 3; ++c)
+                    output[c] = static_cast<sf::Uint8>(alpha ? weighted[c] / alpha : color[c] / count);
+                output[3] = static_cast<sf::Uint8>(alpha / count);
+            }
+        }
+    }
 }
 
 
@@ -99,9 +493,27 @@ ImageLoader::~ImageLoader()
 ////////////////////////////////////////////////////////////
 bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size)
 {
-    // Clear the array (just in case)
-    pixels.clear();
+    return adoptPixels(decodeImageFromFile(filename, size), size, pixels);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size)
+{
+    return adoptPixels(decodeImageFromMemory(data, dataSize, size), size, pixels);
+}
 
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size)
+{
+    return adoptPixels(decodeImageFromStream(stream, size), size, pixels);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint8* ImageLoader::decodeImageFromFile(const std::string& filename, Vector2u& size)
+{
     // Load the image and get a pointer to the pixels in memory
     int width, height, channels;
     unsigned char* ptr = stbi_load(filename.c_str(), &width, &height, &channels, STBI_rgb_alpha);
@@ -112,34 +524,25 @@ bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uin
         size.x = width;
         size.y = height;
 
-        // Copy the loaded pixels to the pixel buffer
-        pixels.resize(width * height * 4);
-        memcpy(&pixels[0], ptr, pixels.size());
-
-        // Free the loaded pixels (they are now in our own pixel buffer)
-        stbi_image_free(ptr);
-
-        return true;
+        return ptr;
     }
     else
     {
         // Error, failed to load the image
         err() << "Failed to load image \"" << filename << "\". Reason: " << stbi_failure_reason() << std::endl;
 
-        return false;
+        stbi_image_free(ptr);
+        return NULL;
     }
 }
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size)
+Uint8* ImageLoader::decodeImageFromMemory(const void* data, std::size_t dataSize, Vector2u& size)
 {
     // Check input parameters
     if (data && dataSize)
     {
-        // Clear the array (just in case)
-        pixels.clear();
-
         // Load the image and get a pointer to the pixels in memory
         int width, height, channels;
         const unsigned char* buffer = static_cast<const unsigned char*>(data);
@@ -151,36 +554,31 @@ bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, st
             size.x = width;
             size.y = height;
 
-            // Copy the loaded pixels to the pixel buffer
-            pixels.resize(width * height * 4);
-            memcpy(&pixels[0], ptr, pixels.size());
-
-            // Free the loaded pixels (they are now in our own pixel buffer)
-            stbi_image_free(ptr);
-
-            return true;
+            return ptr;
         }
         else
         {
             // Error, failed to load the image
             err() << "Failed to load image from memory. Reason: " << stbi_failure_reason() << std::endl;
 
-            return false;
+            stbi_image_free(ptr);
+            return NULL;
         }
     }
     else
     {
         err() << "Failed to load image from memory, no data provided" << std::endl;
-        return false;
+        return NULL;
     }
 }
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size)
+Uint8* ImageLoader::decodeImageFromStream(InputStream& stream, Vector2u& size)
 {
-    // Clear the array (just in case)
-    pixels.clear();
+    // If the whole stream is accessible in memory, decode it in place
+    if (const void* data = getStreamData(stream))
+        return decodeImageFromMemory(data, static_cast<std::size_t>(stream.getSize()), size);
 
     // Make sure that the stream's reading position is at the beginning
     stream.seek(0);
@@ -201,59 +599,133 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
         size.x = width;
         size.y = height;
 
-        // Copy the loaded pixels to the pixel buffer
-        pixels.resize(width * height * 4);
-        memcpy(&pixels[0], ptr, pixels.size());
+        return ptr;
+    }
+    else
+    {
+        // Error, failed to load the image
+        err() << "Failed to load image from stream. Reason: " << stbi_failure_reason() << std::endl;
 
-        // Free the loaded pixels (they are now in our own pixel buffer)
         stbi_image_free(ptr);
+        return NULL;
+    }
+}
 
-        return true;
+
+////////////////////////////////////////////////////////////
+void ImageLoader::releaseImage(Uint8* pixels)
+{
+    stbi_image_free(pixels);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::loadImageFromStream(InputStream& stream, unsigned int scale, std::vector<Uint8>& pixels, Vector2u& size)
+{
+    if (readImageSize(stream, scale, size))
+    {
+        pixels.resize(static_cast<std::size_t>(size.x) * size.y * 4);
+        if (decodeImage(stream, scale, &pixels[0], pixels.size(), size))
+            return true;
+    }
+
+    pixels.clear();
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::readImageSize(InputStream& stream, unsigned int scale, Vector2u& size)
+{
+    if (!checkScale(scale))
+        return false;
+
+    // JPEG files are read by libjpeg, which knows the size of its scaled output
+    if (isJpeg(stream))
+        return readJpg(stream, scale, NULL, 0, size);
+
+    // Other formats only need their header to be parsed
+    int width = 0, height = 0, channels = 0;
+    bool found = false;
+    if (const void* data = getStreamData(stream))
+    {
+        const unsigned char* buffer = static_cast<const unsigned char*>(data);
+        found = stbi_info_from_memory(buffer, static_cast<int>(stream.getSize()), &width, &height, &channels) != 0;
     }
     else
     {
-        // Error, failed to load the image
-        err() << "Failed to load image from stream. Reason: " << stbi_failure_reason() << std::endl;
+        stbi_io_callbacks callbacks;
+        callbacks.read = &read;
+        callbacks.skip = &skip;
+        callbacks.eof  = &eof;
 
+        stream.seek(0);
+        found = stbi_info_from_callbacks(&callbacks, &stream, &width, &height, &channels) != 0;
+    }
+
+    if (!found || !width || !height)
+    {
+        err() << "Failed to read image size from stream. Reason: " << stbi_failure_reason() << std::endl;
         return false;
     }
+
+    size = scaleSize(Vector2u(width, height), scale);
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size)
+bool ImageLoader::decodeImage(InputStream& stream, unsigned int scale, Uint8* pixels, std::size_t capacity, Vector2u& size)
 {
-    // Make sure the image is not empty
-    if (!pixels.empty() && (size.x > 0) && (size.y > 0))
+    if (!checkScale(scale))
+        return false;
+
+    // JPEG files are decoded by libjpeg, which scales them during the IDCT
+    if (isJpeg(stream))
+        return readJpg(stream, scale, pixels, capacity, size);
+
+    // Other formats are decoded at full size, then reduced to the destination
+    Vector2u fullSize;
+    Uint8* decoded = decodeImageFromStream(stream, fullSize);
+    if (!decoded)
+        return false;
+
+    size = scaleSize(fullSize, scale);
+    std::size_t needed = static_cast<std::size_t>(size.x) * size.y * 4;
+    if (capacity < needed)
     {
-        // Deduce the image type from its extension
-        if (filename.size() > 3)
-        {
-            // Extract the extension
-            std::string extension = toLower(filename.substr(filename.size() - 3));
+        err() << "Failed to load image from stream, the destination holds " << capacity << " bytes but " << needed << " are needed" << std::endl;
+        releaseImage(decoded);
+        return false;
+    }
 
-            if (extension == "bmp")
-            {
-                // BMP format
-                if (stbi_write_bmp(filename.c_str(), size.x, size.y, 4, &pixels[0]))
-                    return true;
-            }
-            else if (extension == "tga")
-            {
-                // TGA format
-                if (stbi_write_tga(filename.c_str(), size.x, size.y, 4, &pixels[0]))
-                    return true;
-            }
-            else if (extension == "png")
-            {
-                // PNG format
-                if (stbi_write_png(filename.c_str(), size.x, size.y, 4, &pixels[0], 0))
-                    return true;
-            }
-            else if (extension == "jpg")
+    if (scale == 1)
+        std::memcpy(pixels, decoded, needed);
+    else
+        downscale(decoded, fullSize, scale, pixels);
+
+    releaseImage(decoded);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size, const Image::SaveSettings& settings)
+{
+    // Deduce the image type from its extension
+    if (filename.size() > 3)
+    {
+        // Encode the image in memory
+        std::vector<Uint8> output;
+        if (encodeImage(toLower(filename.substr(filename.size() - 3)), output, pixels, size, settings))
+        {
+            // Write it to the file in one go
+            FILE* file = std::fopen(filename.c_str(), "wb");
+            if (file)
             {
-                // JPG format
-                if (writeJpg(filename, pixels, size.x, size.y))
+                bool written = std::fwrite(&output[0], 1, output.size(), file) == output.size();
+                written = (std::fclose(file) == 0) && written;
+                if (written)
                     return true;
             }
         }
@@ -265,13 +737,156 @@ bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::writeJpg(const std::string& filename, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height)
+bool ImageLoader::saveImageToMemory(const std::string& format, std::vector<Uint8>& output, const std::vector<Uint8>& pixels, const Vector2u& size, const Image::SaveSettings& settings)
+{
+    if (encodeImage(toLower(format), output, pixels, size, settings))
+        return true;
+
+    err() << "Failed to save image to memory in format \"" << format << "\"" << std::endl;
+    output.clear();
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::adoptPixels(Uint8* decoded, const Vector2u& size, std::vector<Uint8>& pixels)
+{
+    if (!decoded)
+    {
+        pixels.clear();
+        return false;
+    }
+
+    // Copy the decoded pixels in a single pass, resizing first would also clear them
+    pixels.assign(decoded, decoded + size.x * size.y * 4);
+
+    // Free the decoded pixels (they are now in our own pixel buffer)
+    stbi_image_free(decoded);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::encodeImage(const std::string& format, std::vector<Uint8>& output, const std::vector<Uint8>& pixels, const Vector2u& size, const Image::SaveSettings& settings)
 {
-    // Open the file to write in
-    FILE* file = fopen(filename.c_str(), "wb");
-    if (!file)
+    output.clear();
+
+    // Make sure the image is not empty
+    if (pixels.empty() || (size.x == 0) || (size.y == 0))
         return false;
 
+    if (format == "bmp")
+    {
+        // BMP format
+        writeBmp(output, pixels, size.x, size.y);
+        return true;
+    }
+    else if (format == "tga")
+    {
+        // TGA format
+        writeTga(output, pixels, size.x, size.y);
+        return true;
+    }
+    else if (format == "png")
+    {
+        // PNG format
+        return writePng(output, pixels, size.x, size.y, settings);
+    }
+    else if ((format == "jpg") || (format == "jpeg"))
+    {
+        // JPG format
+        return writeJpg(output, pixels, size.x, size.y, settings.jpegQuality);
+    }
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::writePng(std::vector<Uint8>& output, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height, const Image::SaveSettings& settings)
+{
+    // Filter the rows, each one is prefixed with the type of its filter
+    std::size_t rowSize = width * 4;
+    std::vector<Uint8> filtered((rowSize + 1) * height);
+    std::vector<Uint8> candidate(settings.pngFilter == Image::AdaptiveFilter ? rowSize : 0);
+    for (unsigned int y = 0; y < height; ++y)
+    {
+        const Uint8* row = &pixels[y * rowSize];
+        const Uint8* previous = y > 0 ? row - rowSize : NULL;
+        Uint8* destination = &filtered[y * (rowSize + 1)];
+
+        if (settings.pngFilter != Image::AdaptiveFilter)
+        {
+            destination[0] = static_cast<Uint8>(settings.pngFilter);
+            filterRow(settings.pngFilter, row, previous, rowSize, destination + 1);
+        }
+        else
+        {
+            // Keep the filter that produces the smallest values, they compress best
+            unsigned long bestScore = 0;
+            for (int filter = Image::NoFilter; filter <= Image::PaethFilter; ++filter)
+            {
+                Uint8* target = filter == Image::NoFilter ? destination + 1 : &candidate[0];
+                filterRow(static_cast<Image::PngFilter>(filter), row, previous, rowSize, target);
+
+                unsigned long score = 0;
+                for (std::size_t i = 0; i < rowSize; ++i)
+                    score += std::abs(static_cast<int>(static_cast<signed char>(target[i])));
+
+                if ((filter == Image::NoFilter) || (score < bestScore))
+                {
+                    bestScore = score;
+                    destination[0] = static_cast<Uint8>(filter);
+                    if (target != destination + 1)
+                        std::memcpy(destination + 1, target, rowSize);
+                }
+            }
+        }
+    }
+
+    // Compress them
+    std::vector<Uint8> compressed;
+    if (settings.compressionLevel == 0)
+    {
+        storeZlib(filtered, compressed);
+    }
+    else
+    {
+        int quality = static_cast<int>(std::min(settings.compressionLevel, 9u)) + 2;
+        int compressedSize = 0;
+        unsigned char* zlib = stbi_zlib_compress(&filtered[0], static_cast<int>(filtered.size()), &compressedSize, quality);
+        if (!zlib)
+            return false;
+
+        compressed.assign(zlib, zlib + compressedSize);
+        std::free(zlib);
+    }
+
+    // Write the file: signature, header, data and end marker
+    const Uint8 signature[] = {137, 80, 78, 71, 13, 10, 26, 10};
+    output.reserve(sizeof(signature) + 25 + compressed.size() + 12 + 12);
+    output.insert(output.end(), signature, signature + sizeof(signature));
+
+    std::vector<Uint8> header;
+    writeBigEndian32(header, width);
+    writeBigEndian32(header, height);
+    header.push_back(8); // bits per channel
+    header.push_back(6); // RGBA
+    header.push_back(0); // deflate compression
+    header.push_back(0); // adaptive filtering
+    header.push_back(0); // no interlacing
+    writePngChunk(output, "IHDR", &header[0], header.size());
+    writePngChunk(output, "IDAT", &compressed[0], compressed.size());
+    writePngChunk(output, "IEND", NULL, 0);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::writeJpg(std::vector<Uint8>& output, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height, unsigned int quality)
+{
     // Initialize the error handler
     jpeg_compress_struct compressInfos;
     jpeg_error_mgr errorManager;
@@ -283,27 +898,33 @@ bool ImageLoader::writeJpg(const std::string& filename, const std::vector<Uint8>
     compressInfos.image_height     = height;
     compressInfos.input_components = 3;
     compressInfos.in_color_space   = JCS_RGB;
-    jpeg_stdio_dest(&compressInfos, file);
     jpeg_set_defaults(&compressInfos);
-    jpeg_set_quality(&compressInfos, 90, TRUE);
+    jpeg_set_quality(&compressInfos, static_cast<int>(std::max(1u, std::min(quality, 100u))), TRUE);
 
-    // Get rid of the alpha channel
-    std::vector<Uint8> buffer(width * height * 3);
-    for (std::size_t i = 0; i < width * height; ++i)
-    {
-        buffer[i * 3 + 0] = pixels[i * 4 + 0];
-        buffer[i * 3 + 1] = pixels[i * 4 + 1];
-        buffer[i * 3 + 2] = pixels[i * 4 + 2];
-    }
-    Uint8* ptr = &buffer[0];
+    // Write to the output buffer
+    JpegDestination destination;
+    destination.manager.init_destination    = &initDestination;
+    destination.manager.empty_output_buffer = &emptyOutputBuffer;
+    destination.manager.term_destination    = &termDestination;
+    destination.output                      = &output;
+    compressInfos.dest = &destination.manager;
 
     // Start compression
     jpeg_start_compress(&compressInfos, TRUE);
 
-    // Write each row of the image
+    // Write each row of the image, getting rid of the alpha channel
+    std::vector<Uint8> buffer(width * 3);
     while (compressInfos.next_scanline < compressInfos.image_height)
     {
-        JSAMPROW rawPointer = ptr + (compressInfos.next_scanline * width * 3);
+        const Uint8* row = &pixels[compressInfos.next_scanline * width * 4];
+        for (std::size_t i = 0; i < width; ++i)
+        {
+            buffer[i * 3 + 0] = row[i * 4 + 0];
+            buffer[i * 3 + 1] = row[i * 4 + 1];
+            buffer[i * 3 + 2] = row[i * 4 + 2];
+        }
+
+        JSAMPROW rawPointer = &buffer[0];
         jpeg_write_scanlines(&compressInfos, &rawPointer, 1);
     }
 
@@ -311,12 +932,164 @@ bool ImageLoader::writeJpg(const std::string& filename, const std::vector<Uint8>
     jpeg_finish_compress(&compressInfos);
     jpeg_destroy_compress(&compressInfos);
 
-    // Close the file
-    fclose(file);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::readJpg(InputStream& stream, unsigned int scale, Uint8* pixels, std::size_t capacity, Vector2u& size)
+{
+    // Install an error handler that returns here instead of exiting
+    jpeg_decompress_struct decompressInfos;
+    JpegError error;
+    JpegSource source;
+    decompressInfos.err = jpeg_std_error(&error.manager);
+    error.manager.error_exit     = &errorExit;
+    error.manager.output_message = &outputMessage;
+    if (setjmp(error.jump))
+    {
+        err() << "Failed to load image from stream. Reason: " << error.message << std::endl;
+        jpeg_destroy_decompress(&decompressInfos);
+        return false;
+    }
+
+    // Read from memory if the whole stream is accessible, from the stream otherwise
+    jpeg_create_decompress(&decompressInfos);
+    source.manager.init_source       = &initSource;
+    source.manager.fill_input_buffer = &fillInputBuffer;
+    source.manager.skip_input_data   = &skipInputData;
+    source.manager.resync_to_restart = &jpeg_resync_to_restart;
+    source.manager.term_source       = &termSource;
+    if (const void* data = getStreamData(stream))
+    {
+        source.stream                  = NULL;
+        source.manager.next_input_byte = static_cast<const JOCTET*>(data);
+        source.manager.bytes_in_buffer = static_cast<std::size_t>(stream.getSize());
+    }
+    else
+    {
+        stream.seek(0);
+        source.stream                  = &stream;
+        source.manager.next_input_byte = NULL;
+        source.manager.bytes_in_buffer = 0;
+    }
+    decompressInfos.src = &source.manager;
+
+    // Read the header and compute the size of the scaled output
+    jpeg_read_header(&decompressInfos, TRUE);
+    switch (decompressInfos.jpeg_color_space)
+    {
+        case JCS_GRAYSCALE: decompressInfos.out_color_space = JCS_GRAYSCALE; break;
+        case JCS_CMYK:
+        case JCS_YCCK:      decompressInfos.out_color_space = JCS_CMYK;      break;
+        default:            decompressInfos.out_color_space = JCS_RGB;       break;
+    }
+    decompressInfos.scale_num   = 1;
+    decompressInfos.scale_denom = scale;
+    jpeg_calc_output_dimensions(&decompressInfos);
+    size.x = decompressInfos.output_width;
+    size.y = decompressInfos.output_height;
+
+    // Stop here if only the size was requested
+    if (!pixels)
+    {
+        jpeg_destroy_decompress(&decompressInfos);
+        return true;
+    }
+
+    std::size_t needed = static_cast<std::size_t>(size.x) * size.y * 4;
+    if (capacity < needed)
+    {
+        err() << "Failed to load image from stream, the destination holds " << capacity << " bytes but " << needed << " are needed" << std::endl;
+        jpeg_destroy_decompress(&decompressInfos);
+        return false;
+    }
+
+    // Decode each row directly into the destination, then expand it to RGBA
+    jpeg_start_decompress(&decompressInfos);
+    while (decompressInfos.output_scanline < decompressInfos.output_height)
+    {
+        Uint8* row = pixels + static_cast<std::size_t>(decompressInfos.output_scanline) * size.x * 4;
+        JSAMPROW samples = row + size.x * (4 - decompressInfos.output_components);
+        jpeg_read_scanlines(&decompressInfos, &samples, 1);
+        expandJpegRow(row, size.x, decompressInfos.output_components);
+    }
+
+    jpeg_finish_decompress(&decompressInfos);
+    jpeg_destroy_decompress(&decompressInfos);
 
     return true;
 }
 
+
+////////////////////////////////////////////////////////////
+void ImageLoader::writeBmp(std::vector<Uint8>& output, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height)
+{
+    // 24 bits per pixel, rows stored bottom to top and padded to 4 bytes
+    std::size_t rowSize = (width * 3 + 3) & ~3u;
+    Uint32 fileSize = static_cast<Uint32>(54 + rowSize * height);
+    output.reserve(fileSize);
+
+    // File header
+    output.push_back('B');
+    output.push_back('M');
+    writeLittleEndian32(output, fileSize);
+    writeLittleEndian32(output, 0);
+    writeLittleEndian32(output, 54); // offset of the pixels
+
+    // Info header
+    writeLittleEndian32(output, 40);
+    writeLittleEndian32(output, width);
+    writeLittleEndian32(output, height);
+    writeLittleEndian16(output, 1);  // planes
+    writeLittleEndian16(output, 24); // bits per pixel
+    writeLittleEndian32(output, 0);  // no compression
+    writeLittleEndian32(output, static_cast<Uint32>(rowSize * height));
+    writeLittleEndian32(output, 0);
+    writeLittleEndian32(output, 0);
+    writeLittleEndian32(output, 0);
+    writeLittleEndian32(output, 0);
+
+    // Pixels, in BGR order
+    for (unsigned int y = height; y > 0; --y)
+    {
+        const Uint8* row = &pixels[(y - 1) * width * 4];
+        for (unsigned int x = 0; x < width; ++x)
+        {
+            output.push_back(row[x * 4 + 2]);
+            output.push_back(row[x * 4 + 1]);
+            output.push_back(row[x * 4 + 0]);
+        }
+        output.insert(output.end(), rowSize - width * 3, 0);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageLoader::writeTga(std::vector<Uint8>& output, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height)
+{
+    output.reserve(18 + pixels.size());
+
+    // Header: uncompressed true color image, 32 bits per pixel, rows stored top to bottom
+    output.push_back(0);
+    output.push_back(0);
+    output.push_back(2);
+    output.insert(output.end(), 9, 0);
+    writeLittleEndian16(output, width);
+    writeLittleEndian16(output, height);
+    output.push_back(32);
+    output.push_back(0x28);
+
+    // Pixels, in BGRA order
+    for (std::size_t i = 0; i < pixels.size(); i += 4)
+    {
+        output.push_back(pixels[i + 2]);
+        output.push_back(pixels[i + 1]);
+        output.push_back(pixels[i + 0]);
+        output.push_back(pixels[i + 3]);
+    }
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -28,6 +28,7 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Image.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <string>
@@ -93,17 +94,128 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode an image from a file on disk, without copying it
+    ///
+    /// The returned pixels are owned by the decoder and must be
+    /// freed with releaseImage.
+    ///
+    /// \param filename Path of image file to load
+    /// \param size     Size of loaded image, in pixels
+    ///
+    /// \return Pointer to the RGBA pixels, or NULL if loading failed
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint8* decodeImageFromFile(const std::string& filename, Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode an image from a file in memory, without copying it
+    ///
+    /// The returned pixels are owned by the decoder and must be
+    /// freed with releaseImage.
+    ///
+    /// \param data     Pointer to the file data in memory
+    /// \param dataSize Size of the data to load, in bytes
+    /// \param size     Size of loaded image, in pixels
+    ///
+    /// \return Pointer to the RGBA pixels, or NULL if loading failed
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint8* decodeImageFromMemory(const void* data, std::size_t dataSize, Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode an image from a custom stream, without copying it
+    ///
+    /// The returned pixels are owned by the decoder and must be
+    /// freed with releaseImage.
+    ///
+    /// \param stream Source stream to read from
+    /// \param size   Size of loaded image, in pixels
+    ///
+    /// \return Pointer to the RGBA pixels, or NULL if loading failed
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint8* decodeImageFromStream(InputStream& stream, Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Free pixels returned by one of the decode functions
+    ///
+    /// \param pixels Pixels to free, can be NULL
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseImage(Uint8* pixels);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load an image from a custom stream, reduced by a scale factor
+    ///
+    /// \param stream Source stream to read from
+    /// \param scale  Reduction factor, 1, 2, 4 or 8
+    /// \param pixels Array of pixels to fill with loaded image
+    /// \param size   Size of loaded image, in pixels
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadImageFromStream(InputStream& stream, unsigned int scale, std::vector<Uint8>& pixels, Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the size of an image without decoding its pixels
+    ///
+    /// \param stream Source stream to read from
+    /// \param scale  Reduction factor, 1, 2, 4 or 8
+    /// \param size   Size of the reduced image, in pixels
+    ///
+    /// \return True if the size could be read
+    ///
+    ////////////////////////////////////////////////////////////
+    bool readImageSize(InputStream& stream, unsigned int scale, Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode an image from a custom stream into a caller buffer
+    ///
+    /// \param stream   Source stream to read from
+    /// \param scale    Reduction factor, 1, 2, 4 or 8
+    /// \param pixels   Buffer to fill with the RGBA pixels
+    /// \param capacity Size of the buffer, in bytes
+    /// \param size     Size of the reduced image, in pixels
+    ///
+    /// \return True if decoding was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool decodeImage(InputStream& stream, unsigned int scale, Uint8* pixels, std::size_t capacity, Vector2u& size);
+
     ////////////////////////////////////////////////////////////
     /// \brief Save an array of pixels as an image file
     ///
+    /// This function only reads its arguments and can be called
+    /// from several threads at the same time.
+    ///
     /// \param filename Path of image file to save
     /// \param pixels   Array of pixels to save to image
     /// \param size     Size of image to save, in pixels
+    /// \param settings Options of the encoder
+    ///
+    /// \return True if saving was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size, const Image::SaveSettings& settings);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save an array of pixels as an image file in memory
+    ///
+    /// This function only reads its arguments and can be called
+    /// from several threads at the same time.
+    ///
+    /// \param format   Format of the file, as a file extension
+    /// \param output   Buffer to fill with the encoded file
+    /// \param pixels   Array of pixels to save to image
+    /// \param size     Size of image to save, in pixels
+    /// \param settings Options of the encoder
     ///
     /// \return True if saving was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size);
+    bool saveImageToMemory(const std::string& format, std::vector<Uint8>& output, const std::vector<Uint8>& pixels, const Vector2u& size, const Image::SaveSettings& settings);
 
 private:
 
@@ -120,17 +232,94 @@ private:
     ~ImageLoader();
 
     ////////////////////////////////////////////////////////////
-    /// \brief Save an image file in JPEG format
+    /// \brief Move decoded pixels to an array and free them
     ///
-    /// \param filename Path of image file to save
-    /// \param pixels   Array of pixels to save to image
-    /// \param width    Width of image to save, in pixels
-    /// \param height   Height of image to save, in pixels
+    /// \param decoded Pixels returned by a decode function, can be NULL
+    /// \param size    Size of the decoded image, in pixels
+    /// \param pixels  Array of pixels to fill
     ///
-    /// \return True if saving was successful
+    /// \return True if \a decoded was not NULL
+    ///
+    ////////////////////////////////////////////////////////////
+    bool adoptPixels(Uint8* decoded, const Vector2u& size, std::vector<Uint8>& pixels);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the size of a JPEG image, and decode it with libjpeg
+    ///
+    /// \param stream   Source stream to read from
+    /// \param scale    Reduction factor applied by the IDCT, 1, 2, 4 or 8
+    /// \param pixels   Buffer to fill with the RGBA pixels, NULL to only read the size
+    /// \param capacity Size of the buffer, in bytes
+    /// \param size     Size of the reduced image, in pixels
+    ///
+    /// \return True if reading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool readJpg(InputStream& stream, unsigned int scale, Uint8* pixels, std::size_t capacity, Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode an array of pixels
+    ///
+    /// \param format   Format of the file, as a lower case file extension
+    /// \param output   Buffer to fill with the encoded file
+    /// \param pixels   Array of pixels to encode
+    /// \param size     Size of the image, in pixels
+    /// \param settings Options of the encoder
+    ///
+    /// \return True if encoding was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool encodeImage(const std::string& format, std::vector<Uint8>& output, const std::vector<Uint8>& pixels, const Vector2u& size, const Image::SaveSettings& settings);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode an image in PNG format
+    ///
+    /// \param output   Buffer to fill with the encoded file
+    /// \param pixels   Array of pixels to encode
+    /// \param width    Width of the image, in pixels
+    /// \param height   Height of the image, in pixels
+    /// \param settings Options of the encoder
+    ///
+    /// \return True if encoding was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool writePng(std::vector<Uint8>& output, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height, const Image::SaveSettings& settings);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode an image in JPEG format
+    ///
+    /// \param output  Buffer to fill with the encoded file
+    /// \param pixels  Array of pixels to encode
+    /// \param width   Width of the image, in pixels
+    /// \param height  Height of the image, in pixels
+    /// \param quality JPEG quality, from 1 to 100
+    ///
+    /// \return True if encoding was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool writeJpg(std::vector<Uint8>& output, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height, unsigned int quality);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode an image in BMP format
+    ///
+    /// \param output Buffer to fill with the encoded file
+    /// \param pixels Array of pixels to encode
+    /// \param width  Width of the image, in pixels
+    /// \param height Height of the image, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeBmp(std::vector<Uint8>& output, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode an image in TGA format
+    ///
+    /// \param output Buffer to fill with the encoded file
+    /// \param pixels Array of pixels to encode
+    /// \param width  Width of the image, in pixels
+    /// \param height Height of the image, in pixels
     ///
     ////////////////////////////////////////////////////////////
-    bool writeJpg(const std::string& filename, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height);
+    void writeTga(std::vector<Uint8>& output, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height);
 };
 
 } // namespace priv
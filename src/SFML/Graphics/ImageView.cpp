@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageView.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ImageView::ImageView() :
+m_pixels(NULL),
+m_size  (0, 0),
+m_stride(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ImageView::ImageView(const Image& image) :
+m_pixels(NULL),
+m_size  (0, 0),
+m_stride(0)
+{
+    // Don't ask an empty image for its pixels, it would complain
+    if ((image.getSize().x > 0) && (image.getSize().y > 0))
+        *this = ImageView(image.getPixelsPtr(), image.getSize().x, image.getSize().y);
+}
+
+
+////////////////////////////////////////////////////////////
+ImageView::ImageView(const Image& image, const IntRect& area) :
+m_pixels(NULL),
+m_size  (0, 0),
+m_stride(0)
+{
+    *this = ImageView(image).getSubView(area);
+}
+
+
+////////////////////////////////////////////////////////////
+ImageView::ImageView(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int stride) :
+m_pixels(pixels),
+m_size  (width, height),
+m_stride(stride ? stride : width)
+{
+    if (!m_pixels || (width == 0) || (height == 0))
+        *this = ImageView();
+}
+
+
+////////////////////////////////////////////////////////////
+ImageView ImageView::getSubView(const IntRect& area) const
+{
+    // An empty area means the whole view
+    if ((area.width == 0) || (area.height == 0))
+        return *this;
+
+    // Adjust the rectangle to the size of the view
+    int width  = static_cast<int>(m_size.x);
+    int height = static_cast<int>(m_size.y);
+    int left   = std::max(area.left, 0);
+    int top    = std::max(area.top, 0);
+    int right  = std::min(area.left + area.width, width);
+    int bottom = std::min(area.top + area.height, height);
+
+    if ((left >= right) || (top >= bottom))
+        return ImageView();
+
+    return ImageView(m_pixels + (left + top * m_stride) * 4, right - left, bottom - top, m_stride);
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u ImageView::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int ImageView::getStride() const
+{
+    return m_stride;
+}
+
+
+////////////////////////////////////////////////////////////
+Color ImageView::getPixel(unsigned int x, unsigned int y) const
+{
+    const Uint8* pixel = m_pixels + (x + y * m_stride) * 4;
+    return Color(pixel[0], pixel[1], pixel[2], pixel[3]);
+}
+
+
+////////////////////////////////////////////////////////////
+const Uint8* ImageView::getPixelsPtr() const
+{
+    return m_pixels;
+}
+
+} // namespace sf
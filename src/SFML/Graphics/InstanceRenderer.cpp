@@ -0,0 +1,404 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/InstanceRenderer.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstddef>
+
+
+#ifndef SFML_OPENGL_ES
+
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+
+    #define castToGlHandle(x) reinterpret_cast<GLEXT_GLhandle>(static_cast<ptrdiff_t>(x))
+    #define castFromGlHandle(x) static_cast<unsigned int>(reinterpret_cast<ptrdiff_t>(x))
+
+#else
+
+    #define castToGlHandle(x) (x)
+    #define castFromGlHandle(x) (x)
+
+#endif
+
+namespace
+{
+    // Generic attribute locations, the corner must be attribute 0
+    // since it provides the vertices of the base quad
+    enum Attribute
+    {
+        Corner,
+        Position,
+        Rotation,
+        Scale,
+        TextureRect,
+        InstanceColor,
+        AttributeCount
+    };
+
+    const char* vertexSource =
+        "uniform vec4 quad;\n"
+        "attribute vec2 corner;\n"
+        "attribute vec2 position;\n"
+        "attribute float rotation;\n"
+        "attribute vec2 scale;\n"
+        "attribute vec4 textureRect;\n"
+        "attribute vec4 color;\n"
+        "void main()\n"
+        "{\n"
+        "    vec2 local = (quad.xy + corner * quad.zw) * scale;\n"
+        "    float angle = radians(rotation);\n"
+        "    float c = cos(angle);\n"
+        "    float s = sin(angle);\n"
+        "    vec2 world = position + vec2(c * local.x - s * local.y, s * local.x + c * local.y);\n"
+        "    gl_Position = gl_ModelViewProjectionMatrix * vec4(world, 0.0, 1.0);\n"
+        "    gl_TexCoord[0] = gl_TextureMatrix[0] * vec4(textureRect.xy + corner * textureRect.zw, 0.0, 1.0);\n"
+        "    gl_FrontColor = color;\n"
+        "}\n";
+
+    const char* fragmentSource =
+        "uniform sampler2D texture;\n"
+        "uniform float textured;\n"
+        "void main()\n"
+        "{\n"
+        "    vec4 texel = texture2D(texture, gl_TexCoord[0].xy);\n"
+        "    gl_FragColor = gl_Color * mix(vec4(1.0), texel, textured);\n"
+        "}\n";
+
+    // Compile a shader object, return 0 on failure
+    GLEXT_GLhandle compileShader(GLenum type, const char* source)
+    {
+        GLEXT_GLhandle shader = glCheck(GLEXT_glCreateShaderObject(type));
+        glCheck(GLEXT_glShaderSource(shader, 1, &source, NULL));
+        glCheck(GLEXT_glCompileShader(shader));
+
+        GLint success;
+        glCheck(GLEXT_glGetObjectParameteriv(shader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
+        if (success == GL_FALSE)
+        {
+            char log[1024];
+            glCheck(GLEXT_glGetInfoLog(shader, sizeof(log), 0, log));
+            sf::err() << "Failed to compile instancing shader:" << std::endl
+                      << log << std::endl;
+            glCheck(GLEXT_glDeleteObject(shader));
+            return 0;
+        }
+
+        return shader;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+InstanceRenderer::InstanceRenderer() :
+m_program         (0),
+m_cornerBuffer    (0),
+m_instanceBuffer  (0),
+m_instanceCapacity(0),
+m_quadLocation    (-1),
+m_texturedLocation(-1),
+m_textureLocation (-1),
+m_failed          (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+InstanceRenderer::~InstanceRenderer()
+{
+    if (!m_program && !m_cornerBuffer && !m_instanceBuffer)
+        return;
+
+    ensureGlContext();
+
+    if (m_program)
+    {
+        glCheck(GLEXT_glDeleteObject(castToGlHandle(m_program)));
+    }
+
+    if (m_cornerBuffer)
+    {
+        GLuint buffer = static_cast<GLuint>(m_cornerBuffer);
+        glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+    }
+
+    if (m_instanceBuffer)
+    {
+        GLuint buffer = static_cast<GLuint>(m_instanceBuffer);
+        glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool InstanceRenderer::isAvailable()
+{
+    if (!Shader::isAvailable() || !VertexBuffer::isAvailable())
+        return false;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    return GLEXT_draw_instanced && GLEXT_instanced_arrays;
+}
+
+
+////////////////////////////////////////////////////////////
+bool InstanceRenderer::draw(const FloatRect& quad, const Instance* instances, std::size_t instanceCount, bool textured, bool bindProgram)
+{
+    if (!ensureCreated())
+        return false;
+
+    // Upload the instances, growing the buffer if needed
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_instanceBuffer));
+    if (instanceCount > m_instanceCapacity)
+    {
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(Instance) * instanceCount, instances, GLEXT_GL_STREAM_DRAW));
+        m_instanceCapacity = instanceCount;
+    }
+    else
+    {
+        // Orphan the previous storage so that we don't wait for the GPU to release it
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(Instance) * m_instanceCapacity, NULL, GLEXT_GL_STREAM_DRAW));
+        glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, 0, sizeof(Instance) * instanceCount, instances));
+    }
+
+    // Setup the per-instance attributes
+    const char* data = NULL;
+    GLsizei stride = sizeof(Instance);
+    glCheck(GLEXT_glVertexAttribPointer(Position,      2, GL_FLOAT,         GL_FALSE, stride, data + offsetof(Instance, position)));
+    glCheck(GLEXT_glVertexAttribPointer(Rotation,      1, GL_FLOAT,         GL_FALSE, stride, data + offsetof(Instance, rotation)));
+    glCheck(GLEXT_glVertexAttribPointer(Scale,         2, GL_FLOAT,         GL_FALSE, stride, data + offsetof(Instance, scale)));
+    glCheck(GLEXT_glVertexAttribPointer(TextureRect,   4, GL_FLOAT,         GL_FALSE, stride, data + offsetof(Instance, textureRect)));
+    glCheck(GLEXT_glVertexAttribPointer(InstanceColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  stride, data + offsetof(Instance, color)));
+
+    // Setup the per-vertex attribute
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_cornerBuffer));
+    glCheck(GLEXT_glVertexAttribPointer(Corner, 2, GL_FLOAT, GL_FALSE, 0, NULL));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+    for (int i = 0; i < AttributeCount; ++i)
+    {
+        glCheck(GLEXT_glEnableVertexAttribArray(i));
+        if (i != Corner)
+        {
+            glCheck(GLEXT_glVertexAttribDivisor(i, 1));
+        }
+    }
+
+    // The fixed-function arrays would alias the generic attribute 0
+    glCheck(glDisableClientState(GL_VERTEX_ARRAY));
+    glCheck(glDisableClientState(GL_COLOR_ARRAY));
+    glCheck(glDisableClientState(GL_TEXTURE_COORD_ARRAY));
+
+    // Bind the program and its parameters
+    if (bindProgram)
+    {
+        glCheck(GLEXT_glUseProgramObject(castToGlHandle(m_program)));
+    }
+    glCheck(GLEXT_glUniform4f(m_quadLocation, quad.left, quad.top, quad.width, quad.height));
+    glCheck(GLEXT_glUniform1f(m_texturedLocation, textured ? 1.f : 0.f));
+    glCheck(GLEXT_glUniform1i(m_textureLocation, 0));
+
+    glCheck(GLEXT_glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(instanceCount)));
+
+    // Restore the vertex states expected by RenderTarget
+    for (int i = 0; i < AttributeCount; ++i)
+    {
+        if (i != Corner)
+        {
+            glCheck(GLEXT_glVertexAttribDivisor(i, 0));
+        }
+        glCheck(GLEXT_glDisableVertexAttribArray(i));
+    }
+
+    glCheck(glEnableClientState(GL_VERTEX_ARRAY));
+    glCheck(glEnableClientState(GL_COLOR_ARRAY));
+    glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int InstanceRenderer::getProgram() const
+{
+    return m_program;
+}
+
+////////////////////////////////////////////////////////////
+bool InstanceRenderer::ensureCreated()
+{
+    if (m_program)
+        return true;
+
+    // Don't retry every frame if something went wrong once
+    if (m_failed)
+        return false;
+
+    m_failed = true;
+
+    ensureGlContext();
+
+    // Compile and link the program
+    GLEXT_GLhandle vertexShader = compileShader(GLEXT_GL_VERTEX_SHADER, vertexSource);
+    if (!vertexShader)
+        return false;
+
+    GLEXT_GLhandle fragmentShader = compileShader(GLEXT_GL_FRAGMENT_SHADER, fragmentSource);
+    if (!fragmentShader)
+    {
+        glCheck(GLEXT_glDeleteObject(vertexShader));
+        return false;
+    }
+
+    GLEXT_GLhandle program = glCheck(GLEXT_glCreateProgramObject());
+    glCheck(GLEXT_glAttachObject(program, vertexShader));
+    glCheck(GLEXT_glAttachObject(program, fragmentShader));
+    glCheck(GLEXT_glDeleteObject(vertexShader));
+    glCheck(GLEXT_glDeleteObject(fragmentShader));
+
+    // The attribute locations must be fixed before linking
+    glCheck(GLEXT_glBindAttribLocation(program, Corner,        "corner"));
+    glCheck(GLEXT_glBindAttribLocation(program, Position,      "position"));
+    glCheck(GLEXT_glBindAttribLocation(program, Rotation,      "rotation"));
+    glCheck(GLEXT_glBindAttribLocation(program, Scale,         "scale"));
+    glCheck(GLEXT_glBindAttribLocation(program, TextureRect,   "textureRect"));
+    glCheck(GLEXT_glBindAttribLocation(program, InstanceColor, "color"));
+    glCheck(GLEXT_glLinkProgram(program));
+
+    GLint success;
+    glCheck(GLEXT_glGetObjectParameteriv(program, GLEXT_GL_OBJECT_LINK_STATUS, &success));
+    if (success == GL_FALSE)
+    {
+        char log[1024];
+        glCheck(GLEXT_glGetInfoLog(program, sizeof(log), 0, log));
+        err() << "Failed to link instancing shader:" << std::endl
+              << log << std::endl;
+        glCheck(GLEXT_glDeleteObject(program));
+        return false;
+    }
+
+    m_quadLocation     = glCheck(GLEXT_glGetUniformLocation(program, "quad"));
+    m_texturedLocation = glCheck(GLEXT_glGetUniformLocation(program, "textured"));
+    m_textureLocation  = glCheck(GLEXT_glGetUniformLocation(program, "texture"));
+
+    // Create the buffers, the corners are laid out as a triangle strip
+    static const float corners[] = {0.f, 0.f, 1.f, 0.f, 0.f, 1.f, 1.f, 1.f};
+
+    GLuint buffers[2] = {0, 0};
+    glCheck(GLEXT_glGenBuffers(2, buffers));
+    if (!buffers[0] || !buffers[1])
+    {
+        err() << "Failed to create instancing buffers" << std::endl;
+        glCheck(GLEXT_glDeleteBuffers(2, buffers));
+        glCheck(GLEXT_glDeleteObject(program));
+        return false;
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, buffers[0]));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(corners), corners, GLEXT_GL_STATIC_DRAW));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+    m_program        = castFromGlHandle(program);
+    m_cornerBuffer   = static_cast<unsigned int>(buffers[0]);
+    m_instanceBuffer = static_cast<unsigned int>(buffers[1]);
+    m_failed         = false;
+
+    return true;
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#else // SFML_OPENGL_ES
+
+// OpenGL ES 1 doesn't support GLSL shaders at all, instances are always expanded on the CPU
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+InstanceRenderer::InstanceRenderer() :
+m_program         (0),
+m_cornerBuffer    (0),
+m_instanceBuffer  (0),
+m_instanceCapacity(0),
+m_quadLocation    (-1),
+m_texturedLocation(-1),
+m_textureLocation (-1),
+m_failed          (true)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+InstanceRenderer::~InstanceRenderer()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool InstanceRenderer::isAvailable()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool InstanceRenderer::draw(const FloatRect&, const Instance*, std::size_t, bool, bool)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int InstanceRenderer::getProgram() const
+{
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool InstanceRenderer::ensureCreated()
+{
+    return false;
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#endif // SFML_OPENGL_ES
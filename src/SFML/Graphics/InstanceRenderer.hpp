@@ -0,0 +1,129 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_INSTANCERENDERER_HPP
+#define SFML_INSTANCERENDERER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Instance.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Hardware instancing back-end of RenderTarget::drawInstanced
+///
+////////////////////////////////////////////////////////////
+class InstanceRenderer : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The OpenGL objects are created on first use.
+    ///
+    ////////////////////////////////////////////////////////////
+    InstanceRenderer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~InstanceRenderer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the system supports hardware instancing
+    ///
+    /// Instancing requires shaders, vertex buffers and the
+    /// ARB_draw_instanced and ARB_instanced_arrays extensions.
+    ///
+    /// \return True if hardware instancing is supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw instances of a quad
+    ///
+    /// The caller must have activated the target and applied the
+    /// view, transform, blend mode and texture. The internal
+    /// program is left bound, see getProgram.
+    ///
+    /// \param quad          Local rectangle of the base quad
+    /// \param instances     Pointer to the instances
+    /// \param instanceCount Number of instances in the array
+    /// \param textured      Does the current texture have to be sampled?
+    /// \param bindProgram   Must the program be bound? False if it is still bound from the previous draw
+    ///
+    /// \return True on success, false if the internal objects couldn't be created
+    ///
+    ////////////////////////////////////////////////////////////
+    bool draw(const FloatRect& quad, const Instance* instances, std::size_t instanceCount, bool textured, bool bindProgram);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the internal program
+    ///
+    /// \return OpenGL identifier of the program left bound by draw
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getProgram() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the program and buffers if not done yet
+    ///
+    /// \return True if the objects are ready to be used
+    ///
+    ////////////////////////////////////////////////////////////
+    bool ensureCreated();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int m_program;          ///< Program that expands the instances
+    unsigned int m_cornerBuffer;     ///< Static buffer holding the corners of the base quad
+    unsigned int m_instanceBuffer;   ///< Stream buffer holding the instance attributes
+    std::size_t  m_instanceCapacity; ///< Number of instances that fit in the instance buffer
+    int          m_quadLocation;     ///< Location of the quad uniform
+    int          m_texturedLocation; ///< Location of the textured uniform
+    int          m_textureLocation;  ///< Location of the texture sampler uniform
+    bool         m_failed;           ///< Did the creation of the objects fail?
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_INSTANCERENDERER_HPP
@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Node.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Node::Node() :
+m_parent                  (NULL),
+m_children                (),
+m_worldTransform          (),
+m_worldTransformNeedUpdate(true),
+m_localRevision           (0),
+m_parentRevision          (0),
+m_worldRevision           (0),
+m_descendants             (),
+m_descendantsNeedUpdate   (true)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Node::~Node()
+{
+    if (m_parent)
+        m_parent->detachChild(*this);
+
+    // The children become roots
+    for (std::vector<Node*>::iterator it = m_children.begin(); it != m_children.end(); ++it)
+    {
+        (*it)->m_parent = NULL;
+        (*it)->m_worldTransformNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Node::attachChild(Node& child)
+{
+    // A node can't be its own ancestor
+    for (const Node* node = this; node; node = node->m_parent)
+    {
+        if (node == &child)
+        {
+            err() << "Failed to attach node, it is an ancestor of its new parent" << std::endl;
+            return;
+        }
+    }
+
+    if (child.m_parent)
+        child.m_parent->detachChild(child);
+
+    child.m_parent = this;
+    child.m_worldTransformNeedUpdate = true;
+    m_children.push_back(&child);
+
+    invalidateHierarchy();
+}
+
+
+////////////////////////////////////////////////////////////
+void Node::detachChild(Node& child)
+{
+    std::vector<Node*>::iterator it = std::find(m_children.begin(), m_children.end(), &child);
+    if (it == m_children.end())
+        return;
+
+    m_children.erase(it);
+    child.m_parent = NULL;
+    child.m_worldTransformNeedUpdate = true;
+
+    invalidateHierarchy();
+}
+
+
+////////////////////////////////////////////////////////////
+Node* Node::getParent() const
+{
+    return m_parent;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Node::getChildCount() const
+{
+    return m_children.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Node& Node::getChild(std::size_t index) const
+{
+    return *m_children[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Transform& Node::getWorldTransform() const
+{
+    // The ancestors must be up-to-date first
+    if (m_parent)
+        m_parent->getWorldTransform();
+
+    updateWorldTransform();
+
+    return m_worldTransform;
+}
+
+
+////////////////////////////////////////////////////////////
+void Node::drawCurrent(RenderTarget&, RenderStates) const
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Node::draw(RenderTarget& target, RenderStates states) const
+{
+    // List the subtree again if it changed, parents before children
+    if (m_descendantsNeedUpdate)
+    {
+        m_descendants.clear();
+
+        std::vector<const Node*> stack(1, this);
+        while (!stack.empty())
+        {
+            const Node* node = stack.back();
+            stack.pop_back();
+            m_descendants.push_back(node);
+
+            for (std::vector<Node*>::const_reverse_iterator it = node->m_children.rbegin(); it != node->m_children.rend(); ++it)
+                stack.push_back(*it);
+        }
+
+        m_descendantsNeedUpdate = false;
+    }
+
+    // Make sure that the ancestors of the subtree are up-to-date
+    getWorldTransform();
+
+    // Each node follows its parent in the list, so its parent is always up-to-date
+    Transform transform = states.transform;
+    for (std::vector<const Node*>::const_iterator it = m_descendants.begin(); it != m_descendants.end(); ++it)
+    {
+        const Node* node = *it;
+        node->updateWorldTransform();
+
+        states.transform = transform * node->m_worldTransform;
+        node->drawCurrent(target, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Node::updateWorldTransform() const
+{
+    bool parentChanged = m_parent && (m_parentRevision != m_parent->m_worldRevision);
+
+    if (m_worldTransformNeedUpdate || parentChanged || (m_localRevision != m_revision))
+    {
+        if (m_parent)
+        {
+            m_worldTransform = m_parent->m_worldTransform * getTransform();
+            m_parentRevision = m_parent->m_worldRevision;
+        }
+        else
+        {
+            m_worldTransform = getTransform();
+        }
+
+        m_localRevision = m_revision;
+        m_worldTransformNeedUpdate = false;
+        ++m_worldRevision;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Node::invalidateHierarchy()
+{
+    for (Node* node = this; node; node = node->m_parent)
+        node->m_descendantsNeedUpdate = true;
+}
+
+} // namespace sf
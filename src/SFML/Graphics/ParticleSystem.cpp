@@ -0,0 +1,312 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ParticleSystem.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_PARTICLESYSTEM_SSE2
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define SFML_PARTICLESYSTEM_NEON
+#endif
+
+
+namespace
+{
+    // Compute values[i] += factors[i] * scale
+    void multiplyAdd(float* values, const float* factors, float scale, std::size_t count)
+    {
+        std::size_t i = 0;
+
+    #if defined(SFML_PARTICLESYSTEM_SSE2)
+
+        const __m128 scales = _mm_set1_ps(scale);
+        for (; i + 4 <= count; i += 4)
+            _mm_storeu_ps(values + i, _mm_add_ps(_mm_loadu_ps(values + i), _mm_mul_ps(_mm_loadu_ps(factors + i), scales)));
+
+    #elif defined(SFML_PARTICLESYSTEM_NEON)
+
+        for (; i + 4 <= count; i += 4)
+            vst1q_f32(values + i, vmlaq_n_f32(vld1q_f32(values + i), vld1q_f32(factors + i), scale));
+
+    #endif
+
+        // Remaining values, or all of them without SIMD support
+        for (; i < count; ++i)
+            values[i] += factors[i] * scale;
+    }
+
+    // Compute values[i] += offset
+    void add(float* values, float offset, std::size_t count)
+    {
+        std::size_t i = 0;
+
+    #if defined(SFML_PARTICLESYSTEM_SSE2)
+
+        const __m128 offsets = _mm_set1_ps(offset);
+        for (; i + 4 <= count; i += 4)
+            _mm_storeu_ps(values + i, _mm_add_ps(_mm_loadu_ps(values + i), offsets));
+
+    #elif defined(SFML_PARTICLESYSTEM_NEON)
+
+        const float32x4_t offsets = vdupq_n_f32(offset);
+        for (; i + 4 <= count; i += 4)
+            vst1q_f32(values + i, vaddq_f32(vld1q_f32(values + i), offsets));
+
+    #endif
+
+        // Remaining values, or all of them without SIMD support
+        for (; i < count; ++i)
+            values[i] += offset;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ParticleSystem::ParticleSystem() :
+m_positionsX       (),
+m_positionsY       (),
+m_velocitiesX      (),
+m_velocitiesY      (),
+m_rotations        (),
+m_angularVelocities(),
+m_remainingTimes   (),
+m_lifetimes        (),
+m_colors           (),
+m_instances        (),
+m_gravity          (0.f, 0.f),
+m_particleSize     (4.f, 4.f),
+m_texture          (NULL),
+m_textureRect      (),
+m_fadingEnabled    (true)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::emit(const Vector2f& position, const Vector2f& velocity, Time lifetime, const Color& color,
+                          float rotation, float angularVelocity)
+{
+    if (lifetime <= Time::Zero)
+        return;
+
+    m_positionsX.push_back(position.x);
+    m_positionsY.push_back(position.y);
+    m_velocitiesX.push_back(velocity.x);
+    m_velocitiesY.push_back(velocity.y);
+    m_rotations.push_back(rotation);
+    m_angularVelocities.push_back(angularVelocity);
+    m_remainingTimes.push_back(lifetime.asSeconds());
+    m_lifetimes.push_back(lifetime.asSeconds());
+    m_colors.push_back(color);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::update(Time elapsed)
+{
+    std::size_t count = m_positionsX.size();
+    if (!count)
+        return;
+
+    float seconds = elapsed.asSeconds();
+
+    // Integrate the motion of all the particles, velocity first so that gravity applies immediately
+    if (m_gravity.x != 0.f)
+        add(&m_velocitiesX[0], m_gravity.x * seconds, count);
+    if (m_gravity.y != 0.f)
+        add(&m_velocitiesY[0], m_gravity.y * seconds, count);
+
+    multiplyAdd(&m_positionsX[0], &m_velocitiesX[0], seconds, count);
+    multiplyAdd(&m_positionsY[0], &m_velocitiesY[0], seconds, count);
+    multiplyAdd(&m_rotations[0], &m_angularVelocities[0], seconds, count);
+    add(&m_remainingTimes[0], -seconds, count);
+
+    // Remove the dead particles, replacing each one with the last particle
+    std::size_t i = 0;
+    while (i < count)
+    {
+        if (m_remainingTimes[i] > 0.f)
+        {
+            ++i;
+            continue;
+        }
+
+        --count;
+        m_positionsX[i]        = m_positionsX[count];
+        m_positionsY[i]        = m_positionsY[count];
+        m_velocitiesX[i]       = m_velocitiesX[count];
+        m_velocitiesY[i]       = m_velocitiesY[count];
+        m_rotations[i]         = m_rotations[count];
+        m_angularVelocities[i] = m_angularVelocities[count];
+        m_remainingTimes[i]    = m_remainingTimes[count];
+        m_lifetimes[i]         = m_lifetimes[count];
+        m_colors[i]            = m_colors[count];
+    }
+
+    m_positionsX.resize(count);
+    m_positionsY.resize(count);
+    m_velocitiesX.resize(count);
+    m_velocitiesY.resize(count);
+    m_rotations.resize(count);
+    m_angularVelocities.resize(count);
+    m_remainingTimes.resize(count);
+    m_lifetimes.resize(count);
+    m_colors.resize(count);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::clear()
+{
+    m_positionsX.clear();
+    m_positionsY.clear();
+    m_velocitiesX.clear();
+    m_velocitiesY.clear();
+    m_rotations.clear();
+    m_angularVelocities.clear();
+    m_remainingTimes.clear();
+    m_lifetimes.clear();
+    m_colors.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ParticleSystem::getParticleCount() const
+{
+    return m_positionsX.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setGravity(const Vector2f& gravity)
+{
+    m_gravity = gravity;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& ParticleSystem::getGravity() const
+{
+    return m_gravity;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setParticleSize(const Vector2f& size)
+{
+    m_particleSize = size;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& ParticleSystem::getParticleSize() const
+{
+    return m_particleSize;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setTexture(const Texture& texture, bool resetRect)
+{
+    if (resetRect || (!m_texture && (m_textureRect == IntRect())))
+        m_textureRect = IntRect(0, 0, texture.getSize().x, texture.getSize().y);
+
+    m_texture = &texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* ParticleSystem::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setTextureRect(const IntRect& rectangle)
+{
+    m_textureRect = rectangle;
+}
+
+
+////////////////////////////////////////////////////////////
+const IntRect& ParticleSystem::getTextureRect() const
+{
+    return m_textureRect;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setFadingEnabled(bool enabled)
+{
+    m_fadingEnabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ParticleSystem::isFadingEnabled() const
+{
+    return m_fadingEnabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::draw(RenderTarget& target, RenderStates states) const
+{
+    std::size_t count = m_positionsX.size();
+    if (!count)
+        return;
+
+    // Gather the attributes that the instances need
+    FloatRect textureRect(m_textureRect);
+    m_instances.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Instance& instance = m_instances[i];
+        instance.position    = Vector2f(m_positionsX[i], m_positionsY[i]);
+        instance.rotation    = m_rotations[i];
+        instance.textureRect = textureRect;
+        instance.color       = m_colors[i];
+
+        if (m_fadingEnabled)
+            instance.color.a = static_cast<Uint8>(instance.color.a * m_remainingTimes[i] / m_lifetimes[i]);
+    }
+
+    states.transform *= getTransform();
+    states.texture = m_texture;
+
+    FloatRect quad(-m_particleSize.x / 2.f, -m_particleSize.y / 2.f, m_particleSize.x, m_particleSize.y);
+    target.drawInstanced(quad, &m_instances[0], count, states);
+}
+
+} // namespace sf
@@ -0,0 +1,285 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PostProcessChain.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Target of a pass that draws directly to the final render target
+    const std::size_t NoTarget = static_cast<std::size_t>(-1);
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+const std::size_t PostProcessChain::Source = static_cast<std::size_t>(-1);
+
+
+////////////////////////////////////////////////////////////
+PostProcessChain::PostProcessChain() :
+m_passes (),
+m_targets(),
+m_size   (0, 0),
+m_format (Texture::Rgba8)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+PostProcessChain::~PostProcessChain()
+{
+    for (std::vector<RenderTexture*>::iterator it = m_targets.begin(); it != m_targets.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+bool PostProcessChain::create(unsigned int width, unsigned int height, Texture::Format format)
+{
+    if (!Texture::isFormatSupported(format))
+    {
+        err() << "Failed to create post-processing chain, its format is not supported by the graphics card" << std::endl;
+        return false;
+    }
+
+    // The textures of the previous settings can't be reused
+    for (std::vector<RenderTexture*>::iterator it = m_targets.begin(); it != m_targets.end(); ++it)
+        delete *it;
+    m_targets.clear();
+
+    m_size   = Vector2u(width, height);
+    m_format = format;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PostProcessChain::addPass(Shader& shader)
+{
+    return addPass(shader, m_passes.empty() ? Source : m_passes.size() - 1);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PostProcessChain::addPass(Shader& shader, std::size_t input)
+{
+    if ((input != Source) && (input >= m_passes.size()))
+    {
+        err() << "Invalid input for post-processing pass (pass " << input << " doesn't exist), using the source instead" << std::endl;
+        input = Source;
+    }
+
+    Pass pass;
+    pass.shader = &shader;
+    pass.input  = input;
+    pass.target = NoTarget;
+    m_passes.push_back(pass);
+
+    return m_passes.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::addInput(std::size_t pass, const std::string& name, std::size_t input)
+{
+    if ((pass >= m_passes.size()) || ((input != Source) && (input >= pass)))
+    {
+        err() << "Invalid input for post-processing pass (a pass can only read the source "
+              << "and the results of the passes added before it)" << std::endl;
+        return;
+    }
+
+    Input entry;
+    entry.name = name;
+    entry.pass = input;
+    m_passes[pass].inputs.push_back(entry);
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::clear()
+{
+    m_passes.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& PostProcessChain::apply(const Texture& source)
+{
+    if (m_passes.empty() || !allocateTargets(true))
+        return source;
+
+    for (std::size_t i = 0; i < m_passes.size(); ++i)
+    {
+        RenderTexture& target = *m_targets[m_passes[i].target];
+        runPass(i, source, target, BlendNone);
+        target.display();
+    }
+
+    return getResult(m_passes.size() - 1, source);
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::apply(const Texture& source, RenderTarget& target, const BlendMode& blendMode)
+{
+    if (m_passes.empty() || !allocateTargets(false))
+        return;
+
+    for (std::size_t i = 0; i + 1 < m_passes.size(); ++i)
+    {
+        RenderTexture& intermediate = *m_targets[m_passes[i].target];
+        runPass(i, source, intermediate, BlendNone);
+        intermediate.display();
+    }
+
+    runPass(m_passes.size() - 1, source, target, blendMode);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PostProcessChain::getTargetCount() const
+{
+    return m_targets.size();
+}
+
+
+////////////////////////////////////////////////////////////
+bool PostProcessChain::allocateTargets(bool keepLast)
+{
+    // Find the last pass that reads the result of each pass
+    std::vector<std::size_t> lastUse(m_passes.size());
+    for (std::size_t i = 0; i < m_passes.size(); ++i)
+    {
+        lastUse[i] = i;
+
+        const Pass& pass = m_passes[i];
+        if (pass.input != Source)
+            lastUse[pass.input] = std::max(lastUse[pass.input], i);
+
+        for (std::vector<Input>::const_iterator it = pass.inputs.begin(); it != pass.inputs.end(); ++it)
+        {
+            if (it->pass != Source)
+                lastUse[it->pass] = std::max(lastUse[it->pass], i);
+        }
+    }
+
+    // The result of the last pass must survive the chain
+    if (keepLast)
+        lastUse.back() = m_passes.size();
+
+    // Give each pass a texture whose contents are no longer needed, the
+    // texture then stays busy until the last pass reading it
+    std::vector<std::size_t> busyUntil;
+    for (std::size_t i = 0; i < m_passes.size(); ++i)
+    {
+        if (!keepLast && (i + 1 == m_passes.size()))
+        {
+            m_passes[i].target = NoTarget;
+            break;
+        }
+
+        std::size_t target = 0;
+        while ((target < busyUntil.size()) && (busyUntil[target] >= i))
+            ++target;
+
+        if (target == busyUntil.size())
+            busyUntil.push_back(0);
+
+        busyUntil[target] = lastUse[i];
+        m_passes[i].target = target;
+    }
+
+    // Create the textures that the pool lacks
+    while (m_targets.size() < busyUntil.size())
+    {
+        RenderTexture* texture = new RenderTexture;
+        if (!texture->create(m_size.x, m_size.y, ContextSettings(), 1, m_format))
+        {
+            err() << "Failed to create the intermediate textures of the post-processing chain" << std::endl;
+            delete texture;
+            return false;
+        }
+
+        m_targets.push_back(texture);
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& PostProcessChain::getResult(std::size_t pass, const Texture& source) const
+{
+    if (pass == Source)
+        return source;
+
+    return m_targets[m_passes[pass].target]->getTexture();
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::runPass(std::size_t pass, const Texture& source, RenderTarget& target, const BlendMode& blendMode)
+{
+    const Pass& current = m_passes[pass];
+    const Texture& input = getResult(current.input, source);
+
+    // Bind the other results read by the shader
+    for (std::vector<Input>::const_iterator it = current.inputs.begin(); it != current.inputs.end(); ++it)
+        current.shader->setParameter(it->name, getResult(it->pass, source));
+
+    // A single triangle covers the whole target, with no diagonal seam to rasterize
+    // twice; its texture coordinates stretch the input over the target
+    Vector2f size(target.getSize());
+    Vector2f inputSize(input.getSize());
+    Vertex vertices[3] =
+    {
+        Vertex(Vector2f(0.f, 0.f),          Vector2f(0.f, 0.f)),
+        Vertex(Vector2f(2.f * size.x, 0.f), Vector2f(2.f * inputSize.x, 0.f)),
+        Vertex(Vector2f(0.f, 2.f * size.y), Vector2f(0.f, 2.f * inputSize.y))
+    };
+
+    RenderStates states(blendMode);
+    states.shader  = current.shader;
+    states.texture = &input;
+
+    // Draw regardless of the current view of the target
+    View view = target.getView();
+    target.setView(target.getDefaultView());
+    target.draw(vertices, 3, Triangles, states);
+    target.setView(view);
+}
+
+} // namespace sf
@@ -0,0 +1,342 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ReadbackQueue.hpp>
+#include <SFML/Graphics/RenderTextureImplFBO.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace
+{
+    sf::Mutex mutex;
+
+    bool checkReadbacksAvailable()
+    {
+        // Create a temporary context in case the user checks
+        // before a GlResource is created, thus initializing
+        // the shared context
+        sf::Context context;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        #ifndef SFML_OPENGL_ES
+
+            return GLEXT_vertex_buffer_object && GLEXT_pixel_buffer_object && GLEXT_sync && GLEXT_framebuffer_object;
+
+        #else
+
+            return false;
+
+        #endif
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ReadbackQueue::ReadbackQueue() :
+m_first(0),
+m_count(0)
+{
+    for (std::size_t i = 0; i < SlotCount; ++i)
+    {
+        m_slots[i].buffer  = 0;
+        m_slots[i].bytes   = 0;
+        m_slots[i].fence   = NULL;
+        m_slots[i].flipped = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+ReadbackQueue::~ReadbackQueue()
+{
+#ifndef SFML_OPENGL_ES
+
+    ensureGlContext();
+
+    for (std::size_t i = 0; i < SlotCount; ++i)
+    {
+        // Deleting a fence or a buffer doesn't wait for the pending commands
+        if (m_slots[i].fence)
+        {
+            glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(m_slots[i].fence)));
+        }
+
+        if (m_slots[i].buffer)
+        {
+            GLuint buffer = static_cast<GLuint>(m_slots[i].buffer);
+            glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+        }
+    }
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool ReadbackQueue::push(const Texture& texture)
+{
+    if (!texture.m_texture)
+        return false;
+
+    Slot* slot = reserveSlot();
+    if (!slot)
+        return false;
+
+    if (!isAvailable())
+    {
+        slot->image = texture.copyToImage();
+        return true;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    ensureGlContext();
+
+    // Attach the texture to a framebuffer, to read only its useful area
+    GLint previousFrameBuffer;
+    glCheck(glGetIntegerv(GLEXT_GL_FRAMEBUFFER_BINDING, &previousFrameBuffer));
+
+    GLuint frameBuffer = 0;
+    glCheck(GLEXT_glGenFramebuffers(1, &frameBuffer));
+    if (!frameBuffer)
+    {
+        err() << "Failed to queue texture readback, framebuffer generation failed" << std::endl;
+        --m_count;
+        return false;
+    }
+
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, frameBuffer));
+    glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture.m_texture, 0));
+
+    GLenum status;
+    glCheck(status = GLEXT_glCheckFramebufferStatus(GLEXT_GL_FRAMEBUFFER));
+    bool complete = (status == GLEXT_GL_FRAMEBUFFER_COMPLETE);
+    if (complete)
+        readPixels(*slot, texture.m_size, texture.m_pixelsFlipped);
+
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, previousFrameBuffer));
+    glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
+
+    if (!complete)
+    {
+        err() << "Failed to queue texture readback, the texture can't be attached to a framebuffer" << std::endl;
+        --m_count;
+        return false;
+    }
+
+#endif
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ReadbackQueue::push(RenderWindow& window)
+{
+    // Render the pending geometry first
+    window.flushBatch();
+
+    if (!window.setActive())
+        return false;
+
+    // Read the window itself, not a render texture bound in its context
+    if (priv::RenderTextureImplFBO::isAvailable())
+        priv::RenderTextureImplFBO::unbind();
+
+    Slot* slot = reserveSlot();
+    if (!slot)
+        return false;
+
+    if (isAvailable())
+    {
+        // The origin of the window is its bottom-left corner
+        readPixels(*slot, window.getSize(), true);
+    }
+    else
+    {
+        window.capture(slot->image);
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ReadbackQueue::pop(Image& image)
+{
+    if (!isReady())
+        return false;
+
+    Slot& slot = m_slots[m_first];
+
+#ifndef SFML_OPENGL_ES
+
+    if (slot.buffer)
+    {
+        ensureGlContext();
+
+        // The mapped memory is the only copy left, the image is created straight from it
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, slot.buffer));
+        void* pointer = glCheck(GLEXT_glMapBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, GLEXT_GL_READ_ONLY));
+        if (pointer)
+        {
+            image.create(slot.size.x, slot.size.y, static_cast<const Uint8*>(pointer));
+            glCheck(GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_PACK_BUFFER));
+        }
+        else
+        {
+            err() << "Failed to retrieve readback, the buffer could not be mapped" << std::endl;
+        }
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+
+        if (pointer && slot.flipped)
+            image.flipVertically();
+    }
+    else
+
+#endif
+
+    {
+        // The image of the slot is kept, the next capture reuses its memory
+        image = slot.image;
+    }
+
+    m_first = (m_first + 1) % SlotCount;
+    --m_count;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ReadbackQueue::isReady() const
+{
+    return (m_count > 0) && isComplete(m_slots[m_first]);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ReadbackQueue::getPendingCount() const
+{
+    return m_count;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ReadbackQueue::isAvailable()
+{
+    // TODO: Remove this lock when it becomes unnecessary in C++11
+    Lock lock(mutex);
+
+    static bool available = checkReadbacksAvailable();
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+ReadbackQueue::Slot* ReadbackQueue::reserveSlot()
+{
+    if (m_count == SlotCount)
+        return NULL;
+
+    Slot* slot = &m_slots[(m_first + m_count) % SlotCount];
+    ++m_count;
+
+    return slot;
+}
+
+
+////////////////////////////////////////////////////////////
+void ReadbackQueue::readPixels(Slot& slot, const Vector2u& size, bool flipped)
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!slot.buffer)
+    {
+        GLuint buffer = 0;
+        glCheck(GLEXT_glGenBuffers(1, &buffer));
+        slot.buffer = static_cast<unsigned int>(buffer);
+    }
+
+    slot.size = size;
+    slot.flipped = flipped;
+
+    // Copy into the buffer, the data pointer is an offset into it;
+    // the storage is only reallocated when the size changes
+    std::size_t bytes = size.x * size.y * 4;
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, slot.buffer));
+    if (bytes != slot.bytes)
+    {
+        glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_PACK_BUFFER, bytes, NULL, GLEXT_GL_STREAM_READ));
+        slot.bytes = bytes;
+    }
+    glCheck(glReadPixels(0, 0, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+
+    // Signal the end of the copy, and make sure that it is submitted
+    slot.fence = glCheck(GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    glCheck(glFlush());
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool ReadbackQueue::isComplete(const Slot& slot) const
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!slot.fence)
+        return true;
+
+    ensureGlContext();
+
+    GLEXT_GLsync fence = static_cast<GLEXT_GLsync>(slot.fence);
+    GLenum status = glCheck(GLEXT_glClientWaitSync(fence, 0, 0));
+    if (status == GLEXT_GL_TIMEOUT_EXPIRED)
+        return false;
+
+    glCheck(GLEXT_glDeleteSync(fence));
+    slot.fence = NULL;
+
+#endif
+
+    return true;
+}
+
+} // namespace sf
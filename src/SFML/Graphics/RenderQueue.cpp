@@ -0,0 +1,420 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderQueue.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Layout of the sort keys, from the most significant bits:
+    // - layer   (8 bits)
+    // - shader  (12 bits), index of the shader in the queue
+    // - texture (24 bits), low bits of its unique identifier
+    // - blend   (8 bits), index of the blend mode in the queue
+    // - depth   (12 bits), quantized, so that equal states are rendered front to back
+    // In ordered layers, the 56 low bits hold the submission index instead.
+    // The radix sort is stable, so commands with identical states keep
+    // their submission order.
+    const unsigned int layerShift   = 56;
+    const unsigned int shaderShift  = 44;
+    const unsigned int textureShift = 20;
+    const unsigned int blendShift   = 12;
+
+    const sf::Uint64 shaderMask  = 0xFFF;
+    const sf::Uint64 textureMask = 0xFFFFFF;
+    const sf::Uint64 blendMask   = 0xFF;
+    const sf::Uint64 depthMask   = 0xFFF;
+
+    // Find an element in a small table, and append it if missing
+    template <typename T>
+    sf::Uint64 findOrInsert(std::vector<T>& table, const T& value)
+    {
+        typename std::vector<T>::iterator it = std::find(table.begin(), table.end(), value);
+        if (it != table.end())
+            return static_cast<sf::Uint64>(it - table.begin());
+
+        table.push_back(value);
+        return table.size() - 1;
+    }
+
+    // Check whether two rectangles overlap, flat rectangles included
+    bool overlaps(const sf::FloatRect& left, const sf::FloatRect& right)
+    {
+        return (left.left <= right.left + right.width) && (right.left <= left.left + left.width) &&
+               (left.top <= right.top + right.height) && (right.top <= left.top + left.height);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Render target that records the draws of drawables
+///        into a queue instead of rendering them
+///
+////////////////////////////////////////////////////////////
+class RenderQueue::Recorder : public RenderTarget
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the rendering region
+    ///
+    /// A recorder has no pixels, its size is 0.
+    ///
+    /// \return Size in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Vector2u getSize() const
+    {
+        return Vector2u(0, 0);
+    }
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Activate the target for rendering
+    ///
+    /// A recorder never renders anything, it can't be activated.
+    ///
+    /// \return Always false
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool activate(bool)
+    {
+        return false;
+    }
+};
+
+
+////////////////////////////////////////////////////////////
+RenderQueue::RenderQueue() :
+m_recorder  (new Recorder),
+m_layer     (0),
+m_commands  (),
+m_vertices  (),
+m_shaders   (),
+m_blendModes(),
+m_entries   (),
+m_scratch   (),
+m_bounds    (),
+m_sorted    (true)
+{
+    std::fill(m_ordered, m_ordered + 256, false);
+
+    // Route the draws of the recorder to this queue
+    RenderTarget& recorder = *m_recorder;
+    recorder.m_queue = this;
+}
+
+
+////////////////////////////////////////////////////////////
+RenderQueue::~RenderQueue()
+{
+    delete m_recorder;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::setLayer(Uint8 layer)
+{
+    m_layer = layer;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint8 RenderQueue::getLayer() const
+{
+    return m_layer;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::setLayerOrdered(Uint8 layer, bool ordered)
+{
+    if (ordered != m_ordered[layer])
+    {
+        m_ordered[layer] = ordered;
+        m_sorted = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderQueue::isLayerOrdered(Uint8 layer) const
+{
+    return m_ordered[layer];
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::draw(const Drawable& drawable, const RenderStates& states)
+{
+    m_recorder->draw(drawable, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::draw(const Vertex* vertices, std::size_t vertexCount,
+                       PrimitiveType type, const RenderStates& states)
+{
+    m_recorder->draw(vertices, vertexCount, type, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::draw(const VertexBuffer& vertexBuffer, const RenderStates& states)
+{
+    m_recorder->draw(vertexBuffer, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::render(RenderTarget& target)
+{
+    if (!m_sorted)
+        sort();
+
+    for (std::vector<SortEntry>::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        renderCommand(target, m_commands[it->command]);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::render(RenderTarget& target, const View* views, std::size_t viewCount)
+{
+    // The sort and the bounds are shared by all the views
+    if (!m_sorted)
+        sort();
+
+    bool culling = target.isCullingEnabled();
+    if (culling)
+        updateBounds();
+
+    View previousView = target.getView();
+
+    for (std::size_t i = 0; i < viewCount; ++i)
+    {
+        target.setView(views[i]);
+
+        // Area seen by the view, its rotation is taken into account
+        FloatRect area = views[i].getInverseTransform().transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f));
+
+        for (std::vector<SortEntry>::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            if (culling)
+            {
+                const FloatRect& bounds = m_bounds[it->command];
+                if ((bounds.width >= 0.f) && !overlaps(bounds, area))
+                    continue;
+            }
+
+            renderCommand(target, m_commands[it->command]);
+        }
+    }
+
+    target.setView(previousView);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::clear()
+{
+    m_commands.clear();
+    m_vertices.clear();
+    m_shaders.clear();
+    m_blendModes.clear();
+    m_entries.clear();
+    m_bounds.clear();
+    m_sorted = true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderQueue::getCommandCount() const
+{
+    return m_commands.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::record(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                         const RenderStates& states, const VertexBuffer* vertexBuffer, std::size_t firstVertex)
+{
+    Command command;
+    command.stateKey     = makeStateKey(states);
+    command.layer        = m_layer;
+    command.states       = states;
+    command.type         = type;
+    command.vertexCount  = vertexCount;
+    command.vertexBuffer = vertexBuffer;
+
+    if (vertexBuffer)
+    {
+        command.firstVertex = firstVertex;
+    }
+    else
+    {
+        // Keep a copy of the vertices, the caller's array may not outlive the queue
+        command.firstVertex = m_vertices.size();
+        m_vertices.insert(m_vertices.end(), vertices, vertices + vertexCount);
+    }
+
+    m_commands.push_back(command);
+    m_sorted = false;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 RenderQueue::makeStateKey(const RenderStates& states)
+{
+    Uint64 shader  = std::min(findOrInsert(m_shaders, states.shader), shaderMask);
+    Uint64 texture = states.texture ? (states.texture->m_cacheId & textureMask) : 0;
+    Uint64 blend   = std::min(findOrInsert(m_blendModes, states.blendMode), blendMask);
+    Uint64 depth   = static_cast<Uint64>(std::min(std::max(states.depth, 0.f), 1.f) * depthMask);
+
+    return (shader << shaderShift) | (texture << textureShift) | (blend << blendShift) | depth;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::sort()
+{
+    std::size_t count = m_commands.size();
+
+    // Build the final keys, the ordered layers may have changed since recording
+    m_entries.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Command& command = m_commands[i];
+
+        Uint64 key = static_cast<Uint64>(command.layer) << layerShift;
+        key |= m_ordered[command.layer] ? static_cast<Uint64>(i) : command.stateKey;
+
+        m_entries[i].key = key;
+        m_entries[i].command = static_cast<unsigned int>(i);
+    }
+
+    // Least significant digit radix sort, one byte per pass
+    std::size_t histograms[8][256];
+    std::fill(&histograms[0][0], &histograms[0][0] + 8 * 256, 0);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Uint64 key = m_entries[i].key;
+        for (unsigned int pass = 0; pass < 8; ++pass)
+            ++histograms[pass][(key >> (pass * 8)) & 0xFF];
+    }
+
+    m_scratch.resize(count);
+    for (unsigned int pass = 0; pass < 8; ++pass)
+    {
+        std::size_t* histogram = histograms[pass];
+
+        // Skip the passes where all the keys share the same byte, which
+        // is frequent since only a few layers, shaders and blend modes are used
+        Uint64 firstByte = count ? (m_entries[0].key >> (pass * 8)) & 0xFF : 0;
+        if (histogram[firstByte] == count)
+            continue;
+
+        // Turn the histogram into starting offsets
+        std::size_t offset = 0;
+        for (unsigned int i = 0; i < 256; ++i)
+        {
+            std::size_t size = histogram[i];
+            histogram[i] = offset;
+            offset += size;
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+            m_scratch[histogram[(m_entries[i].key >> (pass * 8)) & 0xFF]++] = m_entries[i];
+
+        m_entries.swap(m_scratch);
+    }
+
+    m_sorted = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::renderCommands(RenderTarget& target, std::size_t first, std::size_t count) const
+{
+    for (std::size_t i = first; i < first + count; ++i)
+        renderCommand(target, m_commands[i]);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::updateBounds()
+{
+    // Commands are only appended, the bounds of the previous ones are still valid
+    for (std::size_t i = m_bounds.size(); i < m_commands.size(); ++i)
+    {
+        const Command& command = m_commands[i];
+
+        if (command.vertexBuffer || !command.vertexCount)
+        {
+            m_bounds.push_back(FloatRect(0.f, 0.f, -1.f, -1.f));
+            continue;
+        }
+
+        const Vertex* vertices = &m_vertices[command.firstVertex];
+        float left   = vertices[0].position.x;
+        float top    = vertices[0].position.y;
+        float right  = left;
+        float bottom = top;
+
+        for (std::size_t j = 1; j < command.vertexCount; ++j)
+        {
+            const Vector2f& position = vertices[j].position;
+            left   = std::min(left, position.x);
+            right  = std::max(right, position.x);
+            top    = std::min(top, position.y);
+            bottom = std::max(bottom, position.y);
+        }
+
+        m_bounds.push_back(command.states.transform.transformRect(FloatRect(left, top, right - left, bottom - top)));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::renderCommand(RenderTarget& target, const Command& command) const
+{
+    if (command.vertexBuffer)
+        target.draw(*command.vertexBuffer, command.firstVertex, command.vertexCount, command.states);
+    else
+        target.draw(&m_vertices[command.firstVertex], command.vertexCount, command.type, command.states);
+}
+
+} // namespace sf
@@ -41,50 +41,72 @@ const RenderStates RenderStates::Default(BlendMode(
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates() :
-blendMode(BlendAlpha),
-transform(),
-texture  (NULL),
-shader   (NULL)
+blendMode  (BlendAlpha),
+stencilMode(),
+transform  (),
+texture    (NULL),
+shader     (NULL),
+depth      (0.f)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const Transform& theTransform) :
-blendMode(BlendAlpha),
-transform(theTransform),
-texture  (NULL),
-shader   (NULL)
+blendMode  (BlendAlpha),
+stencilMode(),
+transform  (theTransform),
+texture    (NULL),
+shader     (NULL),
+depth      (0.f)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const BlendMode& theBlendMode) :
-blendMode(theBlendMode),
-transform(),
-texture  (NULL),
-shader   (NULL)
+blendMode  (theBlendMode),
+stencilMode(),
+transform  (),
+texture    (NULL),
+shader     (NULL),
+depth      (0.f)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+RenderStates::RenderStates(const StencilMode& theStencilMode) :
+blendMode  (BlendAlpha),
+stencilMode(theStencilMode),
+transform  (),
+texture    (NULL),
+shader     (NULL),
+depth      (0.f)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const Texture* theTexture) :
-blendMode(BlendAlpha),
-transform(),
-texture  (theTexture),
-shader   (NULL)
+blendMode  (BlendAlpha),
+stencilMode(),
+transform  (),
+texture    (theTexture),
+shader     (NULL),
+depth      (0.f)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const Shader* theShader) :
-blendMode(BlendAlpha),
-transform(),
-texture  (NULL),
-shader   (theShader)
+blendMode  (BlendAlpha),
+stencilMode(),
+transform  (),
+texture    (NULL),
+shader     (theShader),
+depth      (0.f)
 {
 }
 
@@ -92,10 +114,12 @@ shader   (theShader)
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const BlendMode& theBlendMode, const Transform& theTransform,
                            const Texture* theTexture, const Shader* theShader) :
-blendMode(theBlendMode),
-transform(theTransform),
-texture  (theTexture),
-shader   (theShader)
+blendMode  (theBlendMode),
+stencilMode(),
+transform  (theTransform),
+texture    (theTexture),
+shader     (theShader),
+depth      (0.f)
 {
 }
 
@@ -26,45 +26,119 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/CompactVertex.hpp>
+#include <SFML/Graphics/CorePipeline.hpp>
 #include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/GpuTimer.hpp>
+#include <SFML/Graphics/Instance.hpp>
+#include <SFML/Graphics/InstanceRenderer.hpp>
+#include <SFML/Graphics/RenderQueue.hpp>
 #include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/VertexRingBuffer.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/FastMutex.hpp>
+#include <SFML/System/Profiler.hpp>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <map>
 
 
 namespace
 {
-    // Convert an sf::BlendMode::Factor constant to the corresponding OpenGL constant.
-    sf::Uint32 factorToGlConstant(sf::BlendMode::Factor blendFactor)
+    // OpenGL constants of the blend factors and equations, indexed by their sf::BlendMode value
+    const GLenum blendFactors[] = {GL_ZERO, GL_ONE, GL_SRC_COLOR, GL_ONE_MINUS_SRC_COLOR,
+                                   GL_DST_COLOR, GL_ONE_MINUS_DST_COLOR, GL_SRC_ALPHA,
+                                   GL_ONE_MINUS_SRC_ALPHA, GL_DST_ALPHA, GL_ONE_MINUS_DST_ALPHA};
+    const GLenum blendEquations[] = {GLEXT_GL_FUNC_ADD, GLEXT_GL_FUNC_SUBTRACT};
+
+    // Layout of the packed blend modes: the four factors take the low 16 bits, the two equations the next 8
+    const sf::Uint32 blendFunctionMask = 0x0000FFFF;
+    const sf::Uint32 blendEquationMask = 0x00FF0000;
+    const sf::Uint32 invalidBlendKey   = 0xFFFFFFFF;
+
+    // Pack a blend mode into 32 bits, so that it can be compared and diffed cheaply
+    sf::Uint32 packBlendMode(const sf::BlendMode& mode)
     {
-        switch (blendFactor)
-        {
-            case sf::BlendMode::Zero:             return GL_ZERO;
-            case sf::BlendMode::One:              return GL_ONE;
-            case sf::BlendMode::SrcColor:         return GL_SRC_COLOR;
-            case sf::BlendMode::OneMinusSrcColor: return GL_ONE_MINUS_SRC_COLOR;
-            case sf::BlendMode::DstColor:         return GL_DST_COLOR;
-            case sf::BlendMode::OneMinusDstColor: return GL_ONE_MINUS_DST_COLOR;
-            case sf::BlendMode::SrcAlpha:         return GL_SRC_ALPHA;
-            case sf::BlendMode::OneMinusSrcAlpha: return GL_ONE_MINUS_SRC_ALPHA;
-            case sf::BlendMode::DstAlpha:         return GL_DST_ALPHA;
-            case sf::BlendMode::OneMinusDstAlpha: return GL_ONE_MINUS_DST_ALPHA;
-        }
+        return  static_cast<sf::Uint32>(mode.colorSrcFactor)        |
+               (static_cast<sf::Uint32>(mode.colorDstFactor) << 4)  |
+               (static_cast<sf::Uint32>(mode.alphaSrcFactor) << 8)  |
+               (static_cast<sf::Uint32>(mode.alphaDstFactor) << 12) |
+               (static_cast<sf::Uint32>(mode.colorEquation)  << 16) |
+               (static_cast<sf::Uint32>(mode.alphaEquation)  << 20);
     }
 
+    // OpenGL constants of the stencil comparisons and operations, indexed by their sf::StencilMode value
+    const GLenum stencilComparisons[] = {GL_NEVER, GL_LESS, GL_LEQUAL, GL_GREATER,
+                                         GL_GEQUAL, GL_EQUAL, GL_NOTEQUAL, GL_ALWAYS};
+    const GLenum stencilOperations[] = {GL_KEEP, GL_ZERO, GL_REPLACE, GL_INCR, GL_DECR, GL_INVERT};
+
+    // Layout of the packed stencil modes: reference, mask, comparison and operation take the
+    // low 22 bits, followed by the stencil-only flag; bit 31 is set when the stencil test is enabled
+    const sf::Uint32 stencilFunctionMask  = 0x0007FFFF;
+    const sf::Uint32 stencilWriteMaskMask = 0x0000FF00;
+    const sf::Uint32 stencilOperationMask = 0x00380000;
+    const sf::Uint32 stencilOnlyFlag      = 0x00400000;
+    const sf::Uint32 stencilEnabledFlag   = 0x80000000;
+    const sf::Uint32 disabledStencilKey   = 0;
+    const sf::Uint32 invalidStencilKey    = 0xFFFFFFFF;
+
+    // Pack a stencil mode into 32 bits, all the modes that let every pixel through
+    // untouched share the same key since they all disable the stencil test
+    sf::Uint32 packStencilMode(const sf::StencilMode& mode)
+    {
+        if ((mode.stencilComparison == sf::StencilMode::Always) &&
+            (mode.stencilUpdateOperation == sf::StencilMode::Keep) &&
+            !mode.stencilOnly)
+            return disabledStencilKey;
+
+        return  static_cast<sf::Uint32>(mode.stencilReference)              |
+               (static_cast<sf::Uint32>(mode.stencilMask)            << 8)  |
+               (static_cast<sf::Uint32>(mode.stencilComparison)      << 16) |
+               (static_cast<sf::Uint32>(mode.stencilUpdateOperation) << 19) |
+               (mode.stencilOnly ? stencilOnlyFlag : 0)                     |
+               stencilEnabledFlag;
+    }
 
-    // Convert an sf::BlendMode::BlendEquation constant to the corresponding OpenGL constant.
-    sf::Uint32 equationToGlConstant(sf::BlendMode::Equation blendEquation)
+
+    // Convert an sf::PrimitiveType constant to the corresponding OpenGL constant.
+    GLenum primitiveTypeToGlConstant(sf::PrimitiveType type)
     {
-        switch (blendEquation)
-        {
-            case sf::BlendMode::Add:             return GLEXT_GL_FUNC_ADD;
-            case sf::BlendMode::Subtract:        return GLEXT_GL_FUNC_SUBTRACT;
-        }
+        #ifdef SFML_OPENGL_ES
+            #define GL_QUADS 0
+        #endif
+
+        static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
+                                       GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
+        return modes[type];
     }
+
+
+    // Check whether consecutive primitives of the given type can be merged into a single draw call
+    bool isSameTransform(const sf::Transform& left, const sf::Transform& right)
+    {
+        return std::equal(left.getMatrix(), left.getMatrix() + 16, right.getMatrix());
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool isBatchable(sf::PrimitiveType type)
+    {
+        return (type == sf::Points) || (type == sf::Lines) || (type == sf::Triangles) || (type == sf::Quads);
+    }
+
+
+    // Render textures draw in the context of their thread, so several targets
+    // may share the same OpenGL context; this table remembers which target
+    // last used each context, i.e. whose states the context currently holds
+    typedef std::map<sf::Uint64, const sf::RenderTarget*> ContextTargetTable;
+    ContextTargetTable contextTargets;
+    sf::FastMutex contextTargetsMutex;
 }
 
 
@@ -72,30 +146,136 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 RenderTarget::RenderTarget() :
-m_defaultView(),
-m_view       (),
-m_cache      ()
+m_defaultView        (),
+m_view               (),
+m_cache              (),
+m_batch              (),
+m_instanceRenderer   (NULL),
+m_vertexStream       (NULL),
+m_queue              (NULL),
+m_corePipeline       (NULL),
+m_corePipelineEnabled(false),
+m_instanceVertices   (),
+m_indexedVertices    (),
+m_quadIndices        (),
+m_indices            (),
+m_shortIndices       (),
+m_gpuTimer           (NULL),
+m_statisticsEnabled  (false),
+m_statistics         (),
+m_cullingEnabled     (false),
+m_cullingRectUpdated (false),
+m_cullingRect        (),
+m_clipRects          (),
+m_depthTestEnabled   (false)
 {
     m_cache.glStatesSet = false;
+    m_cache.clipChanged = false;
+    m_cache.lastBlendKey = invalidBlendKey;
+    m_cache.lastStencilKey = invalidStencilKey;
+    m_cache.depthTest = false;
+    m_cache.depthWrite = true;
+    m_cache.lastDepth = -1.f;
+    m_cache.corePipeline = false;
+    m_cache.lastNormalized = false;
+    m_cache.lastProgram = 0;
+    m_cache.transformSet = false;
+    m_cache.vertexCache.resize(StatesCache::DefaultVertexCacheSize);
+    m_batch.enabled = false;
+    m_batch.normalized = false;
+    m_batch.texture = NULL;
+    m_batch.shader = NULL;
+    m_batch.vertexCount = 0;
+    m_batch.streamed = false;
+    m_batch.firstVertex = 0;
+    resetStatistics();
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderTarget::~RenderTarget()
 {
+    delete m_instanceRenderer;
+    delete m_vertexStream;
+    delete m_corePipeline;
+    delete m_gpuTimer;
+
+    // Forget the contexts we were the last target of, so that a
+    // newly created target at the same address isn't confused with us
+    Lock lock(contextTargetsMutex);
+    for (ContextTargetTable::iterator it = contextTargets.begin(); it != contextTargets.end(); )
+    {
+        if (it->second == this)
+            contextTargets.erase(it++);
+        else
+            ++it;
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::clear(const Color& color)
 {
-    if (activate(true))
+    // Pending geometry belongs to the previous contents
+    flushBatch();
+
+    if (activateTarget())
     {
         // Unbind texture to fix RenderTexture preventing clear
         applyTexture(NULL);
 
+        // The whole target is cleared, the scissor test is enabled again by the next draw
+        if (!m_clipRects.empty())
+        {
+            glCheck(glDisable(GL_SCISSOR_TEST));
+            m_cache.clipChanged = true;
+        }
+
+        // A stencil-only mode disables the color writes, which also applies to glClear
+        if (m_cache.lastStencilKey & stencilOnlyFlag)
+            applyStencilMode(StencilMode());
+
         glCheck(glClearColor(color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f));
-        glCheck(glClear(GL_COLOR_BUFFER_BIT));
+
+        if (m_depthTestEnabled)
+        {
+            // The depth mask also applies to glClear
+            if (!m_cache.depthWrite)
+            {
+                glCheck(glDepthMask(GL_TRUE));
+                m_cache.depthWrite = true;
+            }
+
+            glCheck(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+        }
+        else
+        {
+            glCheck(glClear(GL_COLOR_BUFFER_BIT));
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::clearStencil(Uint8 value)
+{
+    // Pending geometry may use the previous stencil values
+    flushBatch();
+
+    if (activateTarget())
+    {
+        if (!m_clipRects.empty())
+        {
+            glCheck(glDisable(GL_SCISSOR_TEST));
+            m_cache.clipChanged = true;
+        }
+
+        // The write mask of the stencil mode also applies to glClear, the next draw sets it again
+        glCheck(glStencilMask(0xFF));
+        m_cache.lastStencilKey = invalidStencilKey;
+
+        glCheck(glClearStencil(value));
+        glCheck(glClear(GL_STENCIL_BUFFER_BIT));
     }
 }
 
@@ -103,8 +283,12 @@ void RenderTarget::clear(const Color& color)
 ////////////////////////////////////////////////////////////
 void RenderTarget::setView(const View& view)
 {
+    // Pending geometry must be rendered with the previous view
+    flushBatch();
+
     m_view = view;
     m_cache.viewChanged = true;
+    m_cullingRectUpdated = false;
 }
 
 
@@ -158,131 +342,925 @@ Vector2f RenderTarget::mapPixelToCoords(const Vector2i& point, const View& view)
 
 
 ////////////////////////////////////////////////////////////
-Vector2i RenderTarget::mapCoordsToPixel(const Vector2f& point) const
+Vector2i RenderTarget::mapCoordsToPixel(const Vector2f& point) const
+{
+    return mapCoordsToPixel(point, getView());
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2i RenderTarget::mapCoordsToPixel(const Vector2f& point, const View& view) const
+{
+    // First, transform the point by the view matrix
+    Vector2f normalized = view.getTransform().transformPoint(point);
+
+    // Then convert to viewport coordinates
+    Vector2i pixel;
+    IntRect viewport = getViewport(view);
+    pixel.x = static_cast<int>(( normalized.x + 1.f) / 2.f * viewport.width  + viewport.left);
+    pixel.y = static_cast<int>((-normalized.y + 1.f) / 2.f * viewport.height + viewport.top);
+
+    return pixel;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::pushClipRect(const FloatRect& rect)
+{
+    // Pending geometry must be rendered with the previous clipping rectangle
+    flushBatch();
+
+    // Convert the corners to pixels, the view may be rotated
+    const Transform& transform = m_view.getTransform();
+    IntRect viewport = getViewport(m_view);
+    Vector2f corners[4] = {Vector2f(rect.left, rect.top), Vector2f(rect.left + rect.width, rect.top),
+                           Vector2f(rect.left, rect.top + rect.height), Vector2f(rect.left + rect.width, rect.top + rect.height)};
+
+    float left = 0.f, top = 0.f, right = 0.f, bottom = 0.f;
+    for (int i = 0; i < 4; ++i)
+    {
+        Vector2f normalized = transform.transformPoint(corners[i]);
+        float x = ( normalized.x + 1.f) / 2.f * viewport.width  + viewport.left;
+        float y = (-normalized.y + 1.f) / 2.f * viewport.height + viewport.top;
+
+        left   = (i == 0) ? x : std::min(left, x);
+        top    = (i == 0) ? y : std::min(top, y);
+        right  = (i == 0) ? x : std::max(right, x);
+        bottom = (i == 0) ? y : std::max(bottom, y);
+    }
+
+    // Keep the pixels whose center is inside the rectangle
+    IntRect pixels(static_cast<int>(std::floor(left + 0.5f)),
+                   static_cast<int>(std::floor(top + 0.5f)), 0, 0);
+    pixels.width  = static_cast<int>(std::floor(right + 0.5f)) - pixels.left;
+    pixels.height = static_cast<int>(std::floor(bottom + 0.5f)) - pixels.top;
+
+    // Nested rectangles can't draw outside their parent
+    IntRect clip;
+    if (!getClipRect().intersects(pixels, clip))
+        clip = IntRect(0, 0, 0, 0);
+
+    m_clipRects.push_back(clip);
+    m_cache.clipChanged = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::popClipRect()
+{
+    if (m_clipRects.empty())
+    {
+        err() << "Failed to pop the clipping rectangle of the render target, none was pushed" << std::endl;
+        return;
+    }
+
+    // Pending geometry must be rendered with the current clipping rectangle
+    flushBatch();
+
+    m_clipRects.pop_back();
+    m_cache.clipChanged = true;
+}
+
+
+////////////////////////////////////////////////////////////
+IntRect RenderTarget::getClipRect() const
+{
+    if (m_clipRects.empty())
+        return IntRect(0, 0, getSize().x, getSize().y);
+
+    return m_clipRects.back();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const Drawable& drawable, const RenderStates& states)
+{
+    drawable.draw(*this, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
+                        PrimitiveType type, const RenderStates& states)
+{
+    SFML_PROFILE_ZONE("RenderTarget::draw");
+
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0))
+        return;
+
+    // Record the draw instead of rendering it if this target feeds a queue
+    if (m_queue)
+    {
+        m_queue->record(vertices, vertexCount, type, states, NULL, 0);
+        return;
+    }
+
+    // Restore the texture if it was evicted
+    if (states.texture)
+        states.texture->use();
+
+    if (m_batch.enabled && isBatchable(type))
+    {
+        Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+
+        // Render the pending geometry if it can't be merged with the new one;
+        // streamed vertices must also stay contiguous in the stream
+        if (m_batch.vertexCount && ((type != m_batch.type) ||
+                                    (textureId != m_batch.textureId) ||
+                                    (states.shader != m_batch.shader) ||
+                                    (states.blendMode != m_batch.blendMode) ||
+                                    (states.stencilMode != m_batch.stencilMode) ||
+                                    (states.depth != m_batch.depth) ||
+                                    (m_batch.streamed && (vertexCount > m_vertexStream->getRemaining()))))
+            flushBatch();
+
+        Vertex* destination = NULL;
+
+        // Start a new batch if needed
+        if (!m_batch.vertexCount)
+        {
+            m_batch.type      = type;
+            m_batch.blendMode   = states.blendMode;
+            m_batch.stencilMode = states.stencilMode;
+            m_batch.texture   = states.texture;
+            m_batch.textureId = textureId;
+            m_batch.shader    = states.shader;
+            m_batch.depth     = states.depth;
+
+            // Write the vertices directly into the stream if possible
+            if (activateTarget())
+                destination = streamVertices(vertexCount, m_batch.firstVertex);
+            m_batch.streamed = (destination != NULL);
+        }
+        else if (m_batch.streamed)
+        {
+            // The remaining space was checked above, this never waits for the GPU
+            std::size_t firstVertex;
+            destination = streamVertices(vertexCount, firstVertex);
+        }
+
+        // Otherwise accumulate them in memory
+        if (!m_batch.streamed)
+        {
+            m_batch.vertices.resize(m_batch.vertexCount + vertexCount);
+            destination = &m_batch.vertices[m_batch.vertexCount];
+        }
+
+        // Pre-transform the vertices and append them to the batch
+        states.transform.transformPoints(vertices, destination, vertexCount);
+
+        // Normalize their texture coordinates, so that no texture matrix is needed;
+        // the source is read rather than the destination, which may be mapped memory
+        if (m_batch.normalized && states.texture && states.texture->m_texture)
+        {
+            float scaleX = 1.f / states.texture->m_actualSize.x;
+            float scaleY = 1.f / states.texture->m_actualSize.y;
+            for (std::size_t i = 0; i < vertexCount; ++i)
+            {
+                destination[i].texCoords.x = vertices[i].texCoords.x * scaleX;
+                destination[i].texCoords.y = vertices[i].texCoords.y * scaleY;
+            }
+        }
+
+        m_batch.vertexCount += vertexCount;
+
+        return;
+    }
+
+    // Preserve the drawing order
+    flushBatch();
+
+    // Stream the vertices that are too many to be pre-transformed
+    if ((vertexCount > m_cache.vertexCache.size()) && activateTarget())
+    {
+        std::size_t firstVertex;
+        Vertex* destination = streamVertices(vertexCount, firstVertex);
+        if (destination)
+        {
+            std::copy(vertices, vertices + vertexCount, destination);
+            drawStreamed(firstVertex, vertexCount, type, states);
+            return;
+        }
+    }
+
+    drawPrimitives(vertices, vertexCount, type, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount, const Uint32* indices,
+                        std::size_t indexCount, PrimitiveType type, const RenderStates& states)
+{
+    SFML_PROFILE_ZONE("RenderTarget::draw");
+
+    // Nothing to draw?
+    if (!vertices || !vertexCount || !indices || !indexCount)
+        return;
+
+    // Queues and batches only store plain vertices, expand the indexed ones
+    if (m_queue || (m_batch.enabled && isBatchable(type)))
+    {
+        m_indexedVertices.resize(indexCount);
+        for (std::size_t i = 0; i < indexCount; ++i)
+            m_indexedVertices[i] = vertices[indices[i]];
+
+        draw(&m_indexedVertices[0], indexCount, type, states);
+        return;
+    }
+
+    // Preserve the drawing order
+    flushBatch();
+
+    drawPrimitives(vertices, vertexCount, type, states, false, indices, indexCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setPreTransformThreshold(std::size_t count)
+{
+    // The cache may be reallocated, the vertex pointers must be set again
+    m_cache.vertexCache.resize(count);
+    m_cache.useVertexCache = false;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTarget::getPreTransformThreshold() const
+{
+    return m_cache.vertexCache.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setBatchingEnabled(bool enabled)
+{
+    if (!enabled)
+        flushBatch();
+
+    m_batch.enabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isBatchingEnabled() const
+{
+    return m_batch.enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setNormalizedTexCoordsEnabled(bool enabled)
+{
+    // The pending vertices were converted with the previous setting
+    if (enabled != m_batch.normalized)
+        flushBatch();
+
+    m_batch.normalized = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isNormalizedTexCoordsEnabled() const
+{
+    return m_batch.normalized;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::flushBatch()
+{
+    if (!m_batch.vertexCount)
+        return;
+
+    // Detach the pending vertices first, since drawing may reset
+    // the GL states, which would in turn flush the batch again
+    std::size_t vertexCount = m_batch.vertexCount;
+    m_batch.vertexCount = 0;
+
+    // The vertices are already transformed, only the other states are needed
+    RenderStates states(m_batch.blendMode, Transform::Identity, m_batch.texture, m_batch.shader);
+    states.stencilMode = m_batch.stencilMode;
+    states.depth = m_batch.depth;
+
+    if (m_batch.streamed)
+    {
+        drawStreamed(m_batch.firstVertex, vertexCount, m_batch.type, states, m_batch.normalized);
+    }
+    else
+    {
+        drawPrimitives(&m_batch.vertices[0], vertexCount, m_batch.type, states, m_batch.normalized);
+
+        // Keep the memory so that it can be reused
+        m_batch.vertices.clear();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setCorePipelineEnabled(bool enabled)
+{
+    if (enabled != m_corePipelineEnabled)
+    {
+        flushBatch();
+
+        // The pipeline is selected when the states are reset
+        m_corePipelineEnabled = enabled;
+        m_cache.glStatesSet = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isCorePipelineEnabled() const
+{
+    return m_corePipelineEnabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setCullingEnabled(bool enabled)
+{
+    m_cullingEnabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isCullingEnabled() const
+{
+    return m_cullingEnabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setDepthTestEnabled(bool enabled)
+{
+    // Pending geometry must be rendered with the previous depth state
+    if (enabled != m_depthTestEnabled)
+        flushBatch();
+
+    m_depthTestEnabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isDepthTestEnabled() const
+{
+    return m_depthTestEnabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::cull(const FloatRect& bounds, const Transform& transform)
+{
+    if (!m_cullingEnabled)
+        return false;
+
+    // The view may be rotated: take the bounding rectangle of the area it covers
+    if (!m_cullingRectUpdated)
+    {
+        m_cullingRect = m_view.getInverseTransform().transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f));
+        m_cullingRectUpdated = true;
+    }
+
+    FloatRect rect = transform.transformRect(bounds);
+
+    // FloatRect::intersects rejects empty rectangles, which lines and points may have
+    bool visible = (rect.left <= m_cullingRect.left + m_cullingRect.width) &&
+                   (rect.left + rect.width >= m_cullingRect.left) &&
+                   (rect.top <= m_cullingRect.top + m_cullingRect.height) &&
+                   (rect.top + rect.height >= m_cullingRect.top);
+
+    if (!visible && m_statisticsEnabled)
+        m_statistics.culledDraws++;
+
+    return !visible;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setStatisticsEnabled(bool enabled)
+{
+    m_statisticsEnabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isStatisticsEnabled() const
+{
+    return m_statisticsEnabled;
+}
+
+
+////////////////////////////////////////////////////////////
+const RenderTarget::Statistics& RenderTarget::getStatistics() const
+{
+    return m_statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::resetStatistics()
+{
+    m_statistics.drawCalls = 0;
+    m_statistics.vertices = 0;
+    m_statistics.textureChanges = 0;
+    m_statistics.shaderChanges = 0;
+    m_statistics.blendModeChanges = 0;
+    m_statistics.vertexCacheHits = 0;
+    m_statistics.culledDraws = 0;
+    m_statistics.contextSwitches = 0;
+    m_statistics.targetSwitches = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::beginTimingZone(const std::string& name)
+{
+    // Pending batched draws belong to what was drawn before the zone
+    flushBatch();
+
+    if (activateTarget() && priv::GpuTimer::isAvailable())
+    {
+        if (!m_gpuTimer)
+            m_gpuTimer = new priv::GpuTimer;
+
+        // Collect the measures of the previous frames, then start the new one
+        m_gpuTimer->poll();
+        m_gpuTimer->begin(name);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::endTimingZone()
+{
+    if (!m_gpuTimer)
+        return;
+
+    flushBatch();
+
+    if (activateTarget())
+    {
+        m_gpuTimer->end();
+        m_gpuTimer->poll();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Time RenderTarget::getTimingZone(const std::string& name) const
+{
+    return m_gpuTimer ? m_gpuTimer->getResult(name) : Time::Zero;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, const RenderStates& states)
+{
+    draw(vertexBuffer, 0, vertexBuffer.getVertexCount(), states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex,
+                        std::size_t vertexCount, const RenderStates& states)
+{
+    // Record the draw instead of rendering it if this target feeds a queue
+    if (m_queue)
+    {
+        m_queue->record(NULL, vertexCount, vertexBuffer.getPrimitiveType(), states, &vertexBuffer, firstVertex);
+        return;
+    }
+
+    // VertexBuffer not supported?
+    if (!VertexBuffer::isAvailable())
+    {
+        err() << "sf::VertexBuffer is not available, drawing skipped" << std::endl;
+        return;
+    }
+
+    // Sanity check
+    if (firstVertex > vertexBuffer.getVertexCount())
+        return;
+
+    // Clamp vertexCount to something that makes sense
+    vertexCount = std::min(vertexCount, vertexBuffer.getVertexCount() - firstVertex);
+
+    // Nothing to draw?
+    if (!vertexCount || !vertexBuffer.getNativeHandle())
+        return;
+
+    // Preserve the drawing order
+    flushBatch();
+
+    if (activateTarget())
+    {
+        // First set the persistent OpenGL states if it's the very first call
+        if (!m_cache.glStatesSet)
+            resetGLStates();
+
+        // The vertices live on the graphics card, they can't be pre-transformed
+        applyTransform(states.transform);
+        setupDraw(states);
+
+        // Bind the vertex buffer, the pointers are now offsets into it
+        VertexBuffer::bind(&vertexBuffer);
+        setupBufferPointers(vertexBuffer.getLayout() == VertexBuffer::Compact);
+
+        drawArrays(vertexBuffer.getPrimitiveType(), firstVertex, vertexCount);
+
+        // Unbind the vertex buffer so that client-side arrays work again
+        VertexBuffer::bind(NULL);
+
+        // The pointers no longer refer to the vertex cache
+        m_cache.useVertexCache = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawInstanced(const FloatRect& quad, const Instance* instances,
+                                 std::size_t instanceCount, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!instances || !instanceCount)
+        return;
+
+    // Use hardware instancing if possible, custom shaders must see regular vertices
+    if (!m_queue && !states.shader && priv::InstanceRenderer::isAvailable())
+    {
+        // Preserve the drawing order
+        flushBatch();
+
+        if (activateTarget())
+        {
+            // First set the persistent OpenGL states if it's the very first call
+            if (!m_cache.glStatesSet)
+                resetGLStates();
+
+            // The instancing program relies on the fixed-function states
+            if (!m_cache.corePipeline)
+            {
+                if (!m_instanceRenderer)
+                    m_instanceRenderer = new priv::InstanceRenderer;
+
+                applyTransform(states.transform);
+                setupDraw(states, false, true);
+
+                bool bindProgram = (m_cache.lastProgram != m_instanceRenderer->getProgram()) || !m_instanceRenderer->getProgram();
+                bool drawn = m_instanceRenderer->draw(quad, instances, instanceCount, states.texture != NULL, bindProgram);
+
+                if (drawn && m_statisticsEnabled)
+                {
+                    m_statistics.drawCalls++;
+                    m_statistics.vertices += instanceCount * 4;
+                    if (bindProgram)
+                        m_statistics.shaderChanges++;
+                }
+
+                // The internal program stays bound like custom shaders, the
+                // next draw switches programs only if it needs another one
+                if (drawn)
+                    m_cache.lastProgram = m_instanceRenderer->getProgram();
+
+                // The pointers no longer refer to the vertex cache
+                m_cache.useVertexCache = false;
+
+                if (drawn)
+                    return;
+            }
+        }
+    }
+
+    // Expand the instances to two triangles each
+    m_instanceVertices.resize(instanceCount * 6);
+
+    for (std::size_t i = 0; i < instanceCount; ++i)
+    {
+        const Instance& instance = instances[i];
+
+        Transform transform;
+        transform.translate(instance.position);
+        transform.rotate(instance.rotation);
+        transform.scale(instance.scale);
+
+        const FloatRect& rect = instance.textureRect;
+        Vertex corners[4] =
+        {
+            Vertex(transform.transformPoint(quad.left, quad.top), instance.color,
+                   Vector2f(rect.left, rect.top)),
+            Vertex(transform.transformPoint(quad.left + quad.width, quad.top), instance.color,
+                   Vector2f(rect.left + rect.width, rect.top)),
+            Vertex(transform.transformPoint(quad.left, quad.top + quad.height), instance.color,
+                   Vector2f(rect.left, rect.top + rect.height)),
+            Vertex(transform.transformPoint(quad.left + quad.width, quad.top + quad.height), instance.color,
+                   Vector2f(rect.left + rect.width, rect.top + rect.height))
+        };
+
+        Vertex* vertices = &m_instanceVertices[i * 6];
+        vertices[0] = corners[0];
+        vertices[1] = corners[1];
+        vertices[2] = corners[2];
+        vertices[3] = corners[2];
+        vertices[4] = corners[1];
+        vertices[5] = corners[3];
+    }
+
+    draw(&m_instanceVertices[0], m_instanceVertices.size(), Triangles, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawPrimitives(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                                  const RenderStates& states, bool normalized, const Uint32* indices, std::size_t indexCount)
+{
+    if (activateTarget())
+    {
+        // First set the persistent OpenGL states if it's the very first call
+        if (!m_cache.glStatesSet)
+            resetGLStates();
+
+        // Check if the vertex count is low enough so that we can pre-transform them;
+        // it's pointless if the transform is already loaded, no matrix change is saved
+        bool transformLoaded = m_cache.transformSet && isSameTransform(states.transform, m_cache.lastTransform);
+        bool useVertexCache = !transformLoaded && (vertexCount <= m_cache.vertexCache.size());
+        if (useVertexCache)
+        {
+            if (m_statisticsEnabled)
+                m_statistics.vertexCacheHits++;
+
+            // Pre-transform the vertices and store them into the vertex cache
+            states.transform.transformPoints(vertices, &m_cache.vertexCache[0], vertexCount);
+
+            // Since vertices are transformed, we must use an identity transform to render them
+            if (!m_cache.useVertexCache)
+                applyTransform(Transform::Identity);
+        }
+        else
+        {
+            applyTransform(states.transform);
+        }
+
+        setupDraw(states, normalized);
+
+        // Client-side arrays don't exist in core contexts, the vertices must be uploaded
+        if (m_cache.corePipeline)
+        {
+            std::size_t firstVertex = m_corePipeline->stream(useVertexCache ? &m_cache.vertexCache[0] : vertices, vertexCount);
+            if (indices)
+                drawElements(type, indices, indexCount, firstVertex, vertexCount);
+            else
+                drawArrays(type, firstVertex, vertexCount);
+
+            m_cache.useVertexCache = useVertexCache;
+            return;
+        }
+
+        // If we pre-transform the vertices, we must use our internal vertex cache
+        if (useVertexCache)
+        {
+            // ... and if we already used it previously, we don't need to set the pointers again
+            if (!m_cache.useVertexCache)
+                vertices = &m_cache.vertexCache[0];
+            else
+                vertices = NULL;
+        }
+
+        // Setup the pointers to the vertices' components
+        #ifndef SFML_OPENGL_ES2
+            if (vertices)
+            {
+                const char* data = reinterpret_cast<const char*>(vertices);
+                glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
+                glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
+                glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+            }
+        #endif
+
+        if (indices)
+            drawElements(type, indices, indexCount, 0, vertexCount);
+        else
+            drawArrays(type, 0, vertexCount);
+
+        // Update the cache
+        m_cache.useVertexCache = useVertexCache;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Vertex* RenderTarget::streamVertices(std::size_t vertexCount, std::size_t& firstVertex)
 {
-    return mapCoordsToPixel(point, getView());
+    if (!m_vertexStream)
+        m_vertexStream = new priv::VertexRingBuffer;
+
+    return m_vertexStream->allocate(vertexCount, firstVertex);
 }
 
 
 ////////////////////////////////////////////////////////////
-Vector2i RenderTarget::mapCoordsToPixel(const Vector2f& point, const View& view) const
+void RenderTarget::drawStreamed(std::size_t firstVertex, std::size_t vertexCount,
+                                PrimitiveType type, const RenderStates& states, bool normalized)
 {
-    // First, transform the point by the view matrix
-    Vector2f normalized = view.getTransform().transformPoint(point);
+    if (activateTarget())
+    {
+        // First set the persistent OpenGL states if it's the very first call
+        if (!m_cache.glStatesSet)
+            resetGLStates();
 
-    // Then convert to viewport coordinates
-    Vector2i pixel;
-    IntRect viewport = getViewport(view);
-    pixel.x = static_cast<int>(( normalized.x + 1.f) / 2.f * viewport.width  + viewport.left);
-    pixel.y = static_cast<int>((-normalized.y + 1.f) / 2.f * viewport.height + viewport.top);
+        applyTransform(states.transform);
+        setupDraw(states, normalized);
 
-    return pixel;
+        // Bind the stream, the pointers are now offsets into it
+        priv::VertexRingBuffer::bind(m_vertexStream);
+        setupBufferPointers();
+
+        drawArrays(type, firstVertex, vertexCount);
+
+        // Unbind the stream so that client-side arrays work again
+        priv::VertexRingBuffer::bind(NULL);
+
+        // The pointers no longer refer to the vertex cache
+        m_cache.useVertexCache = false;
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::draw(const Drawable& drawable, const RenderStates& states)
+void RenderTarget::setupBufferPointers(bool compact)
 {
-    drawable.draw(*this, states);
+    if (m_cache.corePipeline)
+    {
+        priv::CorePipeline::setAttributePointers(compact);
+    }
+#ifndef SFML_OPENGL_ES2
+    else if (compact)
+    {
+        const char* data = NULL;
+        glCheck(glVertexPointer(2, GL_SHORT, sizeof(CompactVertex), data + 0));
+        glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(CompactVertex), data + 4));
+        glCheck(glTexCoordPointer(2, GL_SHORT, sizeof(CompactVertex), data + 8));
+    }
+    else
+    {
+        const char* data = NULL;
+        glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
+        glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
+        glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+    }
+#endif
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
-                        PrimitiveType type, const RenderStates& states)
+void RenderTarget::setupDraw(const RenderStates& states, bool normalized, bool internalProgram)
 {
-    // Nothing to draw?
-    if (!vertices || (vertexCount == 0))
+    // Apply the view
+    if (m_cache.viewChanged)
+        applyCurrentView();
+
+    // Apply the clipping rectangle
+    if (m_cache.clipChanged)
+        applyClipRect();
+
+    // Apply the blend mode, premultiplied textures replace alpha blending by its premultiplied variant
+    const BlendMode& blendMode = (states.texture && states.texture->isPremultiplied() && (states.blendMode == BlendAlpha)) ?
+                                 BlendPremultipliedAlpha : states.blendMode;
+    if (packBlendMode(blendMode) != m_cache.lastBlendKey)
+        applyBlendMode(blendMode);
+
+    // Apply the stencil mode
+    if (packStencilMode(states.stencilMode) != m_cache.lastStencilKey)
+        applyStencilMode(states.stencilMode);
+
+    // Apply the depth test
+    if ((m_depthTestEnabled != m_cache.depthTest) ||
+        (m_depthTestEnabled && ((states.depth != m_cache.lastDepth) ||
+                                ((states.blendMode == BlendNone) != m_cache.depthWrite))))
+        applyDepth(states);
+
+    // Apply the texture, restoring it if it was evicted
+    if (states.texture)
+        states.texture->use();
+
+    Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+    if ((textureId != m_cache.lastTextureId) || (normalized != m_cache.lastNormalized))
+        applyTexture(states.texture, normalized);
+
+    // The internal programs are bound by their own renderer
+    if (internalProgram)
         return;
 
-    // GL_QUADS is unavailable on OpenGL ES
+    // Apply the shader, the program stays bound between draws so it
+    // is only switched when it differs from the one of the last draw
+    unsigned int program = states.shader ? states.shader->m_shaderProgram : 0;
+    if (program != m_cache.lastProgram)
+        applyShader(states.shader);
+    else if (program)
+        updateShader(*states.shader);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawArrays(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount)
+{
+    // GL_QUADS is unavailable on OpenGL ES and in core contexts
     #ifdef SFML_OPENGL_ES
-        if (type == Quads)
-        {
-            err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
-            return;
-        }
-        #define GL_QUADS 0
+        bool quadsSupported = false;
+    #else
+        bool quadsSupported = !m_cache.corePipeline;
     #endif
 
-    if (activate(true))
+    // If needed, draw each quad as two indexed triangles
+    if ((type == Quads) && !quadsSupported)
     {
-        // First set the persistent OpenGL states if it's the very first call
-        if (!m_cache.glStatesSet)
-            resetGLStates();
+        std::size_t quadCount = vertexCount / 4;
+        if (!quadCount)
+            return;
 
-        // Check if the vertex count is low enough so that we can pre-transform them
-        bool useVertexCache = (vertexCount <= StatesCache::VertexCacheSize);
-        if (useVertexCache)
+        // Extend the shared index pattern if it is too short
+        if (m_quadIndices.size() < quadCount * 6)
         {
-            // Pre-transform the vertices and store them into the vertex cache
-            for (std::size_t i = 0; i < vertexCount; ++i)
+            std::size_t first = m_quadIndices.size() / 6;
+            m_quadIndices.resize(quadCount * 6);
+            for (std::size_t i = first; i < quadCount; ++i)
             {
-                Vertex& vertex = m_cache.vertexCache[i];
-                vertex.position = states.transform * vertices[i].position;
-                vertex.color = vertices[i].color;
-                vertex.texCoords = vertices[i].texCoords;
+                Uint32 corner = static_cast<Uint32>(i * 4);
+                Uint32* indices = &m_quadIndices[i * 6];
+                indices[0] = corner;
+                indices[1] = corner + 1;
+                indices[2] = corner + 2;
+                indices[3] = corner;
+                indices[4] = corner + 2;
+                indices[5] = corner + 3;
             }
-
-            // Since vertices are transformed, we must use an identity transform to render them
-            if (!m_cache.useVertexCache)
-                applyTransform(Transform::Identity);
-        }
-        else
-        {
-            applyTransform(states.transform);
         }
 
-        // Apply the view
-        if (m_cache.viewChanged)
-            applyCurrentView();
+        drawElements(Triangles, &m_quadIndices[0], quadCount * 6, firstVertex, quadCount * 4);
+        return;
+    }
 
-        // Apply the blend mode
-        if (states.blendMode != m_cache.lastBlendMode)
-            applyBlendMode(states.blendMode);
+    // Draw the primitives
+    glCheck(glDrawArrays(primitiveTypeToGlConstant(type), static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount)));
 
-        // Apply the texture
-        Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
-        if (textureId != m_cache.lastTextureId)
-            applyTexture(states.texture);
+    if (m_statisticsEnabled)
+    {
+        m_statistics.drawCalls++;
+        m_statistics.vertices += vertexCount;
+    }
+}
 
-        // Apply the shader
-        if (states.shader)
-            applyShader(states.shader);
 
-        // If we pre-transform the vertices, we must use our internal vertex cache
-        if (useVertexCache)
+////////////////////////////////////////////////////////////
+void RenderTarget::drawElements(PrimitiveType type, const Uint32* indices, std::size_t indexCount,
+                                std::size_t firstVertex, std::size_t vertexCount)
+{
+    GLenum mode = primitiveTypeToGlConstant(type);
+
+    #ifdef SFML_OPENGL_ES
+
+        // OpenGL ES only supports 16-bit indices
+        if (firstVertex + vertexCount > 65536)
         {
-            // ... and if we already used it previously, we don't need to set the pointers again
-            if (!m_cache.useVertexCache)
-                vertices = m_cache.vertexCache;
-            else
-                vertices = NULL;
+            err() << "Indexed primitives can't reference more than 65536 vertices on OpenGL ES, drawing skipped" << std::endl;
+            return;
         }
 
-        // Setup the pointers to the vertices' components
-        if (vertices)
+        // Convert the indices, making them absolute at the same time
+        m_shortIndices.resize(indexCount);
+        for (std::size_t i = 0; i < indexCount; ++i)
+            m_shortIndices[i] = static_cast<Uint16>(firstVertex + indices[i]);
+
+        glCheck(glDrawElements(mode, static_cast<GLsizei>(indexCount), GL_UNSIGNED_SHORT, &m_shortIndices[0]));
+
+    #else
+
+        // OpenGL expects absolute indices
+        if (firstVertex)
         {
-            const char* data = reinterpret_cast<const char*>(vertices);
-            glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
-            glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
-            glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+            m_indices.resize(indexCount);
+            for (std::size_t i = 0; i < indexCount; ++i)
+                m_indices[i] = static_cast<Uint32>(firstVertex) + indices[i];
+            indices = &m_indices[0];
         }
 
-        // Find the OpenGL primitive type
-        static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
-                                       GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
-        GLenum mode = modes[type];
+        // Client-side indices don't exist in core contexts, they must be uploaded
+        const GLvoid* data = indices;
+        if (m_cache.corePipeline)
+        {
+            m_corePipeline->streamIndices(indices, indexCount);
+            data = NULL;
+        }
 
-        // Draw the primitives
-        glCheck(glDrawArrays(mode, 0, vertexCount));
+        glCheck(glDrawElements(mode, static_cast<GLsizei>(indexCount), GL_UNSIGNED_INT, data));
 
-        // Unbind the shader, if any
-        if (states.shader)
-            applyShader(NULL);
+    #endif
 
-        // Update the cache
-        m_cache.useVertexCache = useVertexCache;
+    if (m_statisticsEnabled)
+    {
+        m_statistics.drawCalls++;
+        m_statistics.vertices += vertexCount;
     }
 }
 
@@ -290,7 +1268,9 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
 ////////////////////////////////////////////////////////////
 void RenderTarget::pushGLStates()
 {
-    if (activate(true))
+    flushBatch();
+
+    if (activateTarget())
     {
         #ifdef SFML_DEBUG
             // make sure that the user didn't leave an unchecked OpenGL error
@@ -303,16 +1283,22 @@ void RenderTarget::pushGLStates()
             }
         #endif
 
-        #ifndef SFML_OPENGL_ES
-            glCheck(glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS));
-            glCheck(glPushAttrib(GL_ALL_ATTRIB_BITS));
+        // The attribute and matrix stacks don't exist in core contexts
+        #ifndef SFML_OPENGL_ES2
+            if (!priv::CorePipeline::isCoreContext())
+            {
+                #ifndef SFML_OPENGL_ES
+                    glCheck(glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS));
+                    glCheck(glPushAttrib(GL_ALL_ATTRIB_BITS));
+                #endif
+                glCheck(glMatrixMode(GL_MODELVIEW));
+                glCheck(glPushMatrix());
+                glCheck(glMatrixMode(GL_PROJECTION));
+                glCheck(glPushMatrix());
+                glCheck(glMatrixMode(GL_TEXTURE));
+                glCheck(glPushMatrix());
+            }
         #endif
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_PROJECTION));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glPushMatrix());
     }
 
     resetGLStates();
@@ -322,18 +1308,40 @@ void RenderTarget::pushGLStates()
 ////////////////////////////////////////////////////////////
 void RenderTarget::popGLStates()
 {
-    if (activate(true))
+    flushBatch();
+
+    if (activateTarget())
     {
-        glCheck(glMatrixMode(GL_PROJECTION));
-        glCheck(glPopMatrix());
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glPopMatrix());
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glPopMatrix());
-        #ifndef SFML_OPENGL_ES
-            glCheck(glPopClientAttrib());
-            glCheck(glPopAttrib());
+        // Release the objects of the core pipeline, they are not covered by the stacks
+        if (m_cache.corePipeline)
+        {
+            m_corePipeline->unbind();
+            m_cache.glStatesSet = false;
+        }
+        else if (m_cache.lastProgram)
+        {
+            // Neither is the program, that we leave bound after drawing
+            applyShader(NULL);
+        }
+
+        #ifndef SFML_OPENGL_ES2
+            if (!priv::CorePipeline::isCoreContext())
+            {
+                glCheck(glMatrixMode(GL_PROJECTION));
+                glCheck(glPopMatrix());
+                glCheck(glMatrixMode(GL_MODELVIEW));
+                glCheck(glPopMatrix());
+                glCheck(glMatrixMode(GL_TEXTURE));
+                glCheck(glPopMatrix());
+                #ifndef SFML_OPENGL_ES
+                    glCheck(glPopClientAttrib());
+                    glCheck(glPopAttrib());
+                #endif
+            }
         #endif
+
+        // The model-view matrix is the user's one again
+        m_cache.transformSet = false;
     }
 }
 
@@ -341,36 +1349,85 @@ void RenderTarget::popGLStates()
 ////////////////////////////////////////////////////////////
 void RenderTarget::resetGLStates()
 {
+    flushBatch();
+
     // Check here to make sure a context change does not happen after activate(true)
     bool shaderAvailable = Shader::isAvailable();
 
-    if (activate(true))
+    if (activateTarget())
     {
         // Make sure that extensions are initialized
         priv::ensureExtensionsInit();
 
+        // Select the pipeline, core contexts can't use the fixed-function one
+        bool coreContext = priv::CorePipeline::isCoreContext();
+        bool corePipeline = (m_corePipelineEnabled || coreContext) && priv::CorePipeline::isAvailable();
+        if (corePipeline)
+        {
+            if (!m_corePipeline)
+                m_corePipeline = new priv::CorePipeline;
+
+            corePipeline = m_corePipeline->bind();
+        }
+        else if (m_cache.corePipeline)
+        {
+            // Leaving the core pipeline, restore the default vertex array object
+            m_corePipeline->unbind();
+        }
+
+        if (coreContext && !corePipeline)
+            err() << "The core pipeline is unavailable, drawing to a core profile context will fail" << std::endl;
+
+        m_cache.corePipeline = corePipeline;
+
         // Make sure that the texture unit which is active is the number 0
         if (GLEXT_multitexture)
         {
-            glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
+            #ifndef SFML_OPENGL_ES2
+                if (!coreContext)
+                {
+                    glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
+                }
+            #endif
             glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
         }
 
         // Define the default OpenGL states
         glCheck(glDisable(GL_CULL_FACE));
-        glCheck(glDisable(GL_LIGHTING));
         glCheck(glDisable(GL_DEPTH_TEST));
-        glCheck(glDisable(GL_ALPHA_TEST));
-        glCheck(glEnable(GL_TEXTURE_2D));
+        glCheck(glDepthMask(GL_TRUE));
         glCheck(glEnable(GL_BLEND));
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glEnableClientState(GL_VERTEX_ARRAY));
-        glCheck(glEnableClientState(GL_COLOR_ARRAY));
-        glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+        #ifndef SFML_OPENGL_ES2
+            if (!coreContext)
+            {
+                glCheck(glDisable(GL_LIGHTING));
+                glCheck(glDisable(GL_ALPHA_TEST));
+                glCheck(glEnable(GL_TEXTURE_2D));
+                glCheck(glMatrixMode(GL_MODELVIEW));
+                glCheck(glEnableClientState(GL_VERTEX_ARRAY));
+                glCheck(glEnableClientState(GL_COLOR_ARRAY));
+                glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+            }
+        #endif
         m_cache.glStatesSet = true;
 
-        // Apply the default SFML states
+        // The texture matrix may have been changed by user code
+        if (!m_cache.corePipeline)
+            Texture::invalidateTextureMatrix();
+
+        // So may have the textures bound to the units used by shaders
+        if (shaderAvailable)
+            Shader::invalidateTextureUnits();
+
+        // Apply the default SFML states, the blend state must be sent entirely
+        m_cache.lastBlendKey = invalidBlendKey;
         applyBlendMode(BlendAlpha);
+        m_cache.lastStencilKey = invalidStencilKey;
+        applyStencilMode(StencilMode());
+        m_cache.depthTest = false;
+        m_cache.depthWrite = true;
+        m_cache.lastDepth = -1.f;
+        m_cache.transformSet = false;
         applyTransform(Transform::Identity);
         applyTexture(NULL);
         if (shaderAvailable)
@@ -378,6 +1435,9 @@ void RenderTarget::resetGLStates()
 
         m_cache.useVertexCache = false;
 
+        // User code may have changed the scissor test
+        m_cache.clipChanged = true;
+
         // Set the default view
         setView(getView());
     }
@@ -390,9 +1450,43 @@ void RenderTarget::initialize()
     // Setup the default and current views
     m_defaultView.reset(FloatRect(0, 0, static_cast<float>(getSize().x), static_cast<float>(getSize().y)));
     m_view = m_defaultView;
+    m_cullingRectUpdated = false;
 
     // Set GL states only on first draw, so that we don't pollute user's states
     m_cache.glStatesSet = false;
+
+    // Geometry pending from a previous incarnation of the target is obsolete
+    m_batch.vertexCount = 0;
+    m_batch.vertices.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::activateTarget()
+{
+    // Only query the switch counter when it's needed, it is shared by all threads
+    Uint64 switchCount = m_statisticsEnabled ? Context::getSwitchCount() : 0;
+
+    if (!activate(true))
+        return false;
+
+    if (m_statisticsEnabled)
+        m_statistics.contextSwitches += static_cast<Uint32>(Context::getSwitchCount() - switchCount);
+
+    // If another target used the context since our last draw, the states
+    // it holds are no longer the ones we cached and must be set again
+    Lock lock(contextTargetsMutex);
+    const RenderTarget*& lastTarget = contextTargets[Context::getActiveContextId()];
+    if (lastTarget != this)
+    {
+        lastTarget = this;
+        m_cache.glStatesSet = false;
+
+        if (m_statisticsEnabled)
+            m_statistics.targetSwitches++;
+    }
+
+    return true;
 }
 
 
@@ -405,86 +1499,298 @@ void RenderTarget::applyCurrentView()
     glCheck(glViewport(viewport.left, top, viewport.width, viewport.height));
 
     // Set the projection matrix
-    glCheck(glMatrixMode(GL_PROJECTION));
-    glCheck(glLoadMatrixf(m_view.getTransform().getMatrix()));
+    if (m_cache.corePipeline)
+    {
+        m_corePipeline->setMatrix(priv::CorePipeline::ViewProjection, m_view.getTransform());
+    }
+#ifndef SFML_OPENGL_ES2
+    else
+    {
+        glCheck(glMatrixMode(GL_PROJECTION));
+        glCheck(glLoadMatrixf(m_view.getTransform().getMatrix()));
 
-    // Go back to model-view mode
-    glCheck(glMatrixMode(GL_MODELVIEW));
+        // Go back to model-view mode
+        glCheck(glMatrixMode(GL_MODELVIEW));
+    }
+#endif
 
     m_cache.viewChanged = false;
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::applyBlendMode(const BlendMode& mode)
+void RenderTarget::applyClipRect()
 {
-    // Apply the blend mode, falling back to the non-separate versions if necessary
-    if (GLEXT_blend_func_separate)
+    if (m_clipRects.empty())
     {
-        glCheck(GLEXT_glBlendFuncSeparate(
-            factorToGlConstant(mode.colorSrcFactor), factorToGlConstant(mode.colorDstFactor),
-            factorToGlConstant(mode.alphaSrcFactor), factorToGlConstant(mode.alphaDstFactor)));
+        glCheck(glDisable(GL_SCISSOR_TEST));
     }
     else
     {
-        glCheck(glBlendFunc(
-            factorToGlConstant(mode.colorSrcFactor),
-            factorToGlConstant(mode.colorDstFactor)));
+        // OpenGL counts the rows from the bottom of the target
+        const IntRect& clip = m_clipRects.back();
+        int top = getSize().y - (clip.top + clip.height);
+        glCheck(glScissor(clip.left, top, clip.width, clip.height));
+        glCheck(glEnable(GL_SCISSOR_TEST));
     }
 
-    if (GLEXT_blend_minmax && GLEXT_blend_subtract)
+    m_cache.clipChanged = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyBlendMode(const BlendMode& mode)
+{
+    // Only reissue the parts of the state that changed
+    Uint32 key = packBlendMode(mode);
+    Uint32 changes = key ^ m_cache.lastBlendKey;
+
+    // Apply the blend factors, falling back to the non-separate version if necessary
+    if (changes & blendFunctionMask)
     {
-        if (GLEXT_blend_equation_separate)
+        if (GLEXT_blend_func_separate)
         {
-            glCheck(GLEXT_glBlendEquationSeparate(
-                equationToGlConstant(mode.colorEquation),
-                equationToGlConstant(mode.alphaEquation)));
+            glCheck(GLEXT_glBlendFuncSeparate(
+                blendFactors[mode.colorSrcFactor], blendFactors[mode.colorDstFactor],
+                blendFactors[mode.alphaSrcFactor], blendFactors[mode.alphaDstFactor]));
         }
         else
         {
-            glCheck(GLEXT_glBlendEquation(equationToGlConstant(mode.colorEquation)));
+            glCheck(glBlendFunc(blendFactors[mode.colorSrcFactor], blendFactors[mode.colorDstFactor]));
+        }
+    }
+
+    // Apply the blend equations, likewise
+    if (changes & blendEquationMask)
+    {
+        if (GLEXT_blend_minmax && GLEXT_blend_subtract)
+        {
+            if (GLEXT_blend_equation_separate)
+            {
+                glCheck(GLEXT_glBlendEquationSeparate(blendEquations[mode.colorEquation], blendEquations[mode.alphaEquation]));
+            }
+            else
+            {
+                glCheck(GLEXT_glBlendEquation(blendEquations[mode.colorEquation]));
+            }
+        }
+        else if ((mode.colorEquation != BlendMode::Add) || (mode.alphaEquation != BlendMode::Add))
+        {
+            static bool warned = false;
+
+            if (!warned)
+            {
+                err() << "OpenGL extension EXT_blend_minmax and/or EXT_blend_subtract unavailable" << std::endl;
+                err() << "Selecting a blend equation not possible" << std::endl;
+                err() << "Ensure that hardware acceleration is enabled if available" << std::endl;
+
+                warned = true;
+            }
+        }
+    }
+
+    m_cache.lastBlendKey = key;
+
+    if (m_statisticsEnabled)
+        m_statistics.blendModeChanges++;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyStencilMode(const StencilMode& mode)
+{
+    // Only reissue the parts of the state that changed, everything
+    // must be sent when the test was disabled or the cache invalid
+    Uint32 key = packStencilMode(mode);
+    Uint32 last = m_cache.lastStencilKey;
+    Uint32 changes = (last & stencilEnabledFlag) && (last != invalidStencilKey) ? key ^ last : invalidStencilKey;
+
+    // Color writes are disabled while only updating the stencil buffer
+    if ((key ^ last) & stencilOnlyFlag)
+    {
+        GLboolean write = (key & stencilOnlyFlag) ? GL_FALSE : GL_TRUE;
+        glCheck(glColorMask(write, write, write, write));
+    }
+
+    if (key == disabledStencilKey)
+    {
+        if (last != disabledStencilKey)
+        {
+            glCheck(glDisable(GL_STENCIL_TEST));
         }
     }
-    else if ((mode.colorEquation != BlendMode::Add) || (mode.alphaEquation != BlendMode::Add))
+    else
     {
-        static bool warned = false;
+        if (!(last & stencilEnabledFlag) || (last == invalidStencilKey))
+        {
+            glCheck(glEnable(GL_STENCIL_TEST));
+        }
+
+        if (changes & stencilFunctionMask)
+        {
+            glCheck(glStencilFunc(stencilComparisons[mode.stencilComparison], mode.stencilReference, mode.stencilMask));
+        }
 
-        if (!warned)
+        if (changes & stencilWriteMaskMask)
         {
-            err() << "OpenGL extension EXT_blend_minmax and/or EXT_blend_subtract unavailable" << std::endl;
-            err() << "Selecting a blend equation not possible" << std::endl;
-            err() << "Ensure that hardware acceleration is enabled if available" << std::endl;
+            glCheck(glStencilMask(mode.stencilMask));
+        }
+
+        if (changes & stencilOperationMask)
+        {
+            glCheck(glStencilOp(GL_KEEP, GL_KEEP, stencilOperations[mode.stencilUpdateOperation]));
+        }
+    }
+
+    m_cache.lastStencilKey = key;
+}
+
 
-            warned = true;
+////////////////////////////////////////////////////////////
+void RenderTarget::applyDepth(const RenderStates& states)
+{
+    if (m_depthTestEnabled != m_cache.depthTest)
+    {
+        if (m_depthTestEnabled)
+        {
+            // Equal depths keep the painter's order
+            glCheck(glEnable(GL_DEPTH_TEST));
+            glCheck(glDepthFunc(GL_LEQUAL));
         }
+        else
+        {
+            glCheck(glDisable(GL_DEPTH_TEST));
+        }
+
+        m_cache.depthTest = m_depthTestEnabled;
+    }
+
+    if (!m_depthTestEnabled)
+        return;
+
+    // SFML geometry is flat, a depth range reduced to a single value gives
+    // the same depth to all the fragments whatever the pipeline used
+    if (states.depth != m_cache.lastDepth)
+    {
+    #ifdef SFML_OPENGL_ES
+        glCheck(glDepthRangef(states.depth, states.depth));
+    #else
+        glCheck(glDepthRange(states.depth, states.depth));
+    #endif
+        m_cache.lastDepth = states.depth;
     }
 
-    m_cache.lastBlendMode = mode;
+    // Blended pixels don't hide what is behind them
+    bool write = (states.blendMode == BlendNone);
+    if (write != m_cache.depthWrite)
+    {
+        glCheck(glDepthMask(write ? GL_TRUE : GL_FALSE));
+        m_cache.depthWrite = write;
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyTransform(const Transform& transform)
 {
+    // Skip the matrix change if the transform is already loaded
+    if (m_cache.transformSet && isSameTransform(transform, m_cache.lastTransform))
+        return;
+
+    m_cache.lastTransform = transform;
+    m_cache.transformSet = true;
+
+    if (m_cache.corePipeline)
+    {
+        m_corePipeline->setMatrix(priv::CorePipeline::Model, transform);
+        return;
+    }
+
+#ifndef SFML_OPENGL_ES2
     // No need to call glMatrixMode(GL_MODELVIEW), it is always the
     // current mode (for optimization purpose, since it's the most used)
     glCheck(glLoadMatrixf(transform.getMatrix()));
+#endif
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::applyTexture(const Texture* texture)
+void RenderTarget::applyTexture(const Texture* texture, bool normalized)
 {
-    Texture::bind(texture, Texture::Pixels);
+    if (m_cache.corePipeline)
+    {
+        // Same conversion as the texture matrix set by Texture::bind, as a uniform
+        Transform matrix;
+        if (texture && texture->m_texture)
+        {
+            float height = static_cast<float>(texture->m_actualSize.y);
+            float scaleX = normalized ? 1.f : 1.f / texture->m_actualSize.x;
+            float scaleY = normalized ? 1.f : 1.f / height;
+
+            if (texture->m_pixelsFlipped)
+                matrix = Transform(scaleX, 0.f, 0.f, 0.f, -scaleY, texture->m_size.y / height, 0.f, 0.f, 1.f);
+            else
+                matrix = Transform(scaleX, 0.f, 0.f, 0.f, scaleY, 0.f, 0.f, 0.f, 1.f);
+
+            glCheck(glBindTexture(GL_TEXTURE_2D, texture->m_texture));
+        }
+        else
+        {
+            glCheck(glBindTexture(GL_TEXTURE_2D, 0));
+        }
+
+        m_corePipeline->setMatrix(priv::CorePipeline::TextureMatrix, matrix);
+        m_corePipeline->setTextured(texture && texture->m_texture);
+    }
+    else
+    {
+        Texture::bind(texture, normalized ? Texture::Normalized : Texture::Pixels);
+    }
 
     m_cache.lastTextureId = texture ? texture->m_cacheId : 0;
+    m_cache.lastNormalized = normalized;
+
+    if (m_statisticsEnabled)
+        m_statistics.textureChanges++;
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyShader(const Shader* shader)
 {
-    Shader::bind(shader);
+    if (m_statisticsEnabled)
+        m_statistics.shaderChanges++;
+
+    if (m_cache.corePipeline)
+    {
+        // A program is always needed, the built-in one stands for "no shader"
+        if (shader && shader->m_shaderProgram)
+        {
+            Shader::bind(shader);
+            m_corePipeline->releaseProgram();
+            m_corePipeline->uploadMatrices(shader->m_matrices);
+        }
+        else
+        {
+            m_corePipeline->bindProgram();
+        }
+    }
+    else
+    {
+        Shader::bind(shader);
+    }
+
+    m_cache.lastProgram = shader ? shader->m_shaderProgram : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::updateShader(const Shader& shader)
+{
+    shader.applyParameters();
+
+    if (m_cache.corePipeline)
+        m_corePipeline->uploadMatrices(shader.m_matrices);
 }
 
 } // namespace sf
@@ -504,7 +1810,9 @@ void RenderTarget::applyShader(const Shader* shader)
 //   lead, in worst case, to changing it every 4 vertices.
 //   To avoid that, when the vertex count is low enough, we
 //   pre-transform them and therefore use an identity transform
-//   to render them.
+//   to render them. The points are transformed several at a
+//   time with SIMD instructions, and the maximum vertex count
+//   can be tuned with setPreTransformThreshold.
 //
 // * Blending mode
 //   Since it overloads the == operator, we can easily check
@@ -525,4 +1833,27 @@ void RenderTarget::applyShader(const Shader* shader)
 //   do is that we avoid setting a null shader if there was
 //   already none for the previous draw.
 //
+// * Batching
+//   When enabled, consecutive draws of independent primitives
+//   sharing the same states are pre-transformed on the CPU and
+//   accumulated, so that a single glDrawArrays is issued per
+//   state change instead of one per drawable.
+//
+// * Core pipeline
+//   Instead of the fixed-function matrices and client-side
+//   arrays, a built-in program reads the view-projection,
+//   model and texture matrices from uniforms, and the vertices
+//   from generic attributes sourced from buffer objects. This
+//   is the only option in core profile contexts. The same
+//   caching rules apply, a uniform is only updated when the
+//   corresponding matrix would have been loaded.
+//
+// * Streaming
+//   Batched vertices and arrays too big for the vertex cache
+//   are written into a persistently mapped ring buffer when
+//   available. It is split in three segments protected by
+//   fences, so that the CPU fills one segment while the GPU
+//   reads the others, and never waits unless it runs ahead
+//   by more than two segments.
+//
 ////////////////////////////////////////////////////////////
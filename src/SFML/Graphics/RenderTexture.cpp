@@ -35,7 +35,9 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 RenderTexture::RenderTexture() :
-m_impl(NULL)
+m_impl         (NULL),
+m_attachments  (),
+m_mipmapEnabled(false)
 {
 
 }
@@ -45,19 +47,60 @@ m_impl(NULL)
 RenderTexture::~RenderTexture()
 {
     delete m_impl;
+
+    for (std::vector<Texture*>::iterator it = m_attachments.begin(); it != m_attachments.end(); ++it)
+        delete *it;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool RenderTexture::create(unsigned int width, unsigned int height, bool depthBuffer)
 {
-    // Create the texture
-    if (!m_texture.create(width, height))
+    return create(width, height, ContextSettings(depthBuffer ? 32 : 0));
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTexture::create(unsigned int width, unsigned int height, const ContextSettings& settings, unsigned int attachmentCount, Texture::Format format)
+{
+    return create(width, height, settings, std::vector<Texture::Format>(attachmentCount, format));
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTexture::create(unsigned int width, unsigned int height, const ContextSettings& settings, const std::vector<Texture::Format>& formats)
+{
+    unsigned int attachmentCount = static_cast<unsigned int>(formats.size());
+    if (attachmentCount == 0)
     {
-        err() << "Impossible to create render texture (failed to create the target texture)" << std::endl;
+        err() << "Impossible to create render texture (at least one color attachment is required)" << std::endl;
         return false;
     }
 
+    // Keep the textures of the attachments that still exist, so that
+    // references to them remain valid
+    while (m_attachments.size() > attachmentCount - 1)
+    {
+        delete m_attachments.back();
+        m_attachments.pop_back();
+    }
+    while (m_attachments.size() < attachmentCount - 1)
+        m_attachments.push_back(new Texture);
+
+    // Create the textures
+    std::vector<unsigned int> textureIds;
+    textureIds.reserve(attachmentCount);
+    for (unsigned int i = 0; i < attachmentCount; ++i)
+    {
+        Texture& texture = i == 0 ? m_texture : *m_attachments[i - 1];
+        if (!texture.create(width, height, formats[i]))
+        {
+            err() << "Impossible to create render texture (failed to create the target texture)" << std::endl;
+            return false;
+        }
+        textureIds.push_back(texture.m_texture);
+    }
+
     // We disable smoothing by default for render textures
     setSmooth(false);
 
@@ -75,7 +118,7 @@ bool RenderTexture::create(unsigned int width, unsigned int height, bool depthBu
     }
 
     // Initialize the render texture
-    if (!m_impl->create(width, height, m_texture.m_texture, depthBuffer))
+    if (!m_impl->create(width, height, textureIds, settings))
         return false;
 
     // We can now initialize the render target part
@@ -85,10 +128,33 @@ bool RenderTexture::create(unsigned int width, unsigned int height, bool depthBu
 }
 
 
+////////////////////////////////////////////////////////////
+unsigned int RenderTexture::getMaximumAntialiasingLevel()
+{
+    if (priv::RenderTextureImplFBO::isAvailable())
+        return priv::RenderTextureImplFBO::getMaximumAntialiasingLevel();
+
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTexture::getMaximumAttachmentCount()
+{
+    if (priv::RenderTextureImplFBO::isAvailable())
+        return priv::RenderTextureImplFBO::getMaximumAttachmentCount();
+
+    return 1;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTexture::setSmooth(bool smooth)
 {
     m_texture.setSmooth(smooth);
+
+    for (std::vector<Texture*>::iterator it = m_attachments.begin(); it != m_attachments.end(); ++it)
+        (*it)->setSmooth(smooth);
 }
 
 
@@ -103,6 +169,9 @@ bool RenderTexture::isSmooth() const
 void RenderTexture::setRepeated(bool repeated)
 {
     m_texture.setRepeated(repeated);
+
+    for (std::vector<Texture*>::iterator it = m_attachments.begin(); it != m_attachments.end(); ++it)
+        (*it)->setRepeated(repeated);
 }
 
 
@@ -113,6 +182,20 @@ bool RenderTexture::isRepeated() const
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTexture::setMipmapEnabled(bool enabled)
+{
+    m_mipmapEnabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTexture::isMipmapEnabled() const
+{
+    return m_mipmapEnabled;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool RenderTexture::setActive(bool active)
 {
@@ -123,11 +206,25 @@ bool RenderTexture::setActive(bool active)
 ////////////////////////////////////////////////////////////
 void RenderTexture::display()
 {
-    // Update the target texture
+    // Render the geometry that is still pending
+    flushBatch();
+
+    // Update the target textures
     if (setActive(true))
     {
         m_impl->updateTexture(m_texture.m_texture);
-        m_texture.m_pixelsFlipped = true;
+
+        for (unsigned int i = 0; i <= m_attachments.size(); ++i)
+        {
+            Texture& texture = i == 0 ? m_texture : *m_attachments[i - 1];
+            texture.m_pixelsFlipped = true;
+
+            // The levels of the mipmap are outdated
+            if (m_mipmapEnabled)
+                texture.generateMipmap();
+            else
+                texture.invalidateMipmap();
+        }
     }
 }
 
@@ -146,6 +243,23 @@ const Texture& RenderTexture::getTexture() const
 }
 
 
+////////////////////////////////////////////////////////////
+const Texture& RenderTexture::getTexture(unsigned int attachment) const
+{
+    if ((attachment > 0) && (attachment <= m_attachments.size()))
+        return *m_attachments[attachment - 1];
+
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTexture::getAttachmentCount() const
+{
+    return static_cast<unsigned int>(m_attachments.size()) + 1;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool RenderTexture::activate(bool active)
 {
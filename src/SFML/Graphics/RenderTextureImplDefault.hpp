@@ -63,15 +63,15 @@ private:
     ////////////////////////////////////////////////////////////
     /// \brief Create the render texture implementation
     ///
-    /// \param width       Width of the texture to render to
-    /// \param height      Height of the texture to render to
-    /// \param textureId   OpenGL identifier of the target texture
-    /// \param depthBuffer Is a depth buffer requested?
+    /// \param width      Width of the textures to render to
+    /// \param height     Height of the textures to render to
+    /// \param textureIds OpenGL identifiers of the target textures, one per color attachment
+    /// \param settings   Depth buffer and antialiasing requested
     ///
     /// \return True if creation has been successful
     ///
     ////////////////////////////////////////////////////////////
-    virtual bool create(unsigned int width, unsigned int height, unsigned int textureId, bool depthBuffer);
+    virtual bool create(unsigned int width, unsigned int height, const std::vector<unsigned int>& textureIds, const ContextSettings& settings);
 
     ////////////////////////////////////////////////////////////
     /// \brief Activate or deactivate the render texture for rendering
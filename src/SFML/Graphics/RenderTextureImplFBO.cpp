@@ -28,7 +28,37 @@
 #include <SFML/Graphics/RenderTextureImplFBO.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/TextureSaver.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Frame buffer objects are not shared between contexts, so they can only be
+    // destroyed in the context that created them. When a render texture dies
+    // while one of its contexts is not active, its frame buffer is queued here
+    // and destroyed the next time that context activates a render texture.
+    typedef std::multimap<sf::Uint64, unsigned int> StaleFrameBufferTable;
+    StaleFrameBufferTable staleFrameBuffers;
+    sf::Mutex staleFrameBuffersMutex;
+
+    // Destroy the stale frame buffers that belong to the given context
+    void destroyStaleFrameBuffers(sf::Uint64 contextId)
+    {
+        sf::Lock lock(staleFrameBuffersMutex);
+
+        std::pair<StaleFrameBufferTable::iterator, StaleFrameBufferTable::iterator> range = staleFrameBuffers.equal_range(contextId);
+        for (StaleFrameBufferTable::iterator it = range.first; it != range.second; ++it)
+        {
+            GLuint frameBuffer = static_cast<GLuint>(it->second);
+            glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
+        }
+        staleFrameBuffers.erase(range.first, range.second);
+    }
+}
 
 
 namespace sf
@@ -37,8 +67,14 @@ namespace priv
 {
 ////////////////////////////////////////////////////////////
 RenderTextureImplFBO::RenderTextureImplFBO() :
-m_frameBuffer(0),
-m_depthBuffer(0)
+m_frameBuffers       (),
+m_resolveFrameBuffers(),
+m_colorBuffers       (),
+m_depthBuffer        (0),
+m_textureIds         (),
+m_width              (0),
+m_height             (0),
+m_gpuMemory          (GpuMemory::RenderBuffers)
 {
 
 }
@@ -49,22 +85,38 @@ RenderTextureImplFBO::~RenderTextureImplFBO()
 {
     ensureGlContext();
 
-    // Destroy the depth buffer
+    // Destroy the color and depth buffers (render buffers are shared between contexts)
+    for (std::vector<unsigned int>::const_iterator it = m_colorBuffers.begin(); it != m_colorBuffers.end(); ++it)
+    {
+        GLuint colorBuffer = static_cast<GLuint>(*it);
+        glCheck(GLEXT_glDeleteRenderbuffers(1, &colorBuffer));
+    }
     if (m_depthBuffer)
     {
         GLuint depthBuffer = static_cast<GLuint>(m_depthBuffer);
         glCheck(GLEXT_glDeleteRenderbuffers(1, &depthBuffer));
     }
 
-    // Destroy the frame buffer
-    if (m_frameBuffer)
+    // Destroy the frame buffers of the active context right now, the other ones
+    // have to wait until their own context gets active again
+    Uint64 contextId = Context::getActiveContextId();
+    FrameBufferTable* tables[] = {&m_frameBuffers, &m_resolveFrameBuffers};
+    for (int i = 0; i < 2; ++i)
     {
-        GLuint frameBuffer = static_cast<GLuint>(m_frameBuffer);
-        glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
+        for (FrameBufferTable::iterator it = tables[i]->begin(); it != tables[i]->end(); ++it)
+        {
+            if (it->first == contextId)
+            {
+                GLuint frameBuffer = static_cast<GLuint>(it->second);
+                glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
+            }
+            else
+            {
+                Lock lock(staleFrameBuffersMutex);
+                staleFrameBuffers.insert(*it);
+            }
+        }
     }
-
-    // Delete the context
-    delete m_context;
 }
 
 
@@ -81,24 +133,141 @@ bool RenderTextureImplFBO::isAvailable()
 
 
 ////////////////////////////////////////////////////////////
-bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsigned int textureId, bool depthBuffer)
+unsigned int RenderTextureImplFBO::getMaximumAntialiasingLevel()
 {
-    // Create the context
-    m_context = new Context;
+    ensureGlContext();
 
-    // Create the framebuffer object
-    GLuint frameBuffer = 0;
-    glCheck(GLEXT_glGenFramebuffers(1, &frameBuffer));
-    m_frameBuffer = static_cast<unsigned int>(frameBuffer);
-    if (!m_frameBuffer)
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+#ifndef SFML_OPENGL_ES
+
+    // Multisampled frame buffers are useless if they can't be resolved
+    if (!GLEXT_framebuffer_object || !GLEXT_framebuffer_multisample || !GLEXT_framebuffer_blit)
+        return 0;
+
+    GLint samples = 0;
+    glCheck(glGetIntegerv(GLEXT_GL_MAX_SAMPLES, &samples));
+
+    return static_cast<unsigned int>(samples);
+
+#else
+
+    return 0;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTextureImplFBO::getMaximumAttachmentCount()
+{
+    ensureGlContext();
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+#ifndef SFML_OPENGL_ES
+
+    if (!GLEXT_framebuffer_object || !GLEXT_draw_buffers)
+        return 1;
+
+    // We need as many draw buffers as color attachments
+    GLint drawBuffers = 1;
+    GLint colorAttachments = 1;
+    glCheck(glGetIntegerv(GLEXT_GL_MAX_DRAW_BUFFERS, &drawBuffers));
+    glCheck(glGetIntegerv(GLEXT_GL_MAX_COLOR_ATTACHMENTS, &colorAttachments));
+
+    return static_cast<unsigned int>(std::max(std::min(drawBuffers, colorAttachments), 1));
+
+#else
+
+    return 1;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTextureImplFBO::unbind()
+{
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, 0));
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, const std::vector<unsigned int>& textureIds, const ContextSettings& settings)
+{
+    // We render in the context of the current thread, make sure there is one
+    ensureGlContext();
+
+    m_textureIds = textureIds;
+    m_width      = width;
+    m_height     = height;
+
+    // Check that all the color attachments can be rendered to at once
+    unsigned int maxAttachments = getMaximumAttachmentCount();
+    if (m_textureIds.size() > maxAttachments)
     {
-        err() << "Impossible to create render texture (failed to create the frame buffer object)" << std::endl;
+        err() << "Impossible to create render texture (" << m_textureIds.size() << " color attachments requested, "
+              << "maximum is " << maxAttachments << ")" << std::endl;
         return false;
     }
-    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, m_frameBuffer));
 
-    // Create the depth buffer if requested
-    if (depthBuffer)
+    // Clamp the antialiasing level to what the frame buffers support
+    unsigned int samples = 0;
+    if (settings.antialiasingLevel > 0)
+    {
+        samples = std::min(settings.antialiasingLevel, getMaximumAntialiasingLevel());
+        if (samples < settings.antialiasingLevel)
+        {
+            err() << "Warning: render texture antialiasing level " << settings.antialiasingLevel
+                  << " is not supported, using " << samples << " instead" << std::endl;
+        }
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    // With antialiasing, we render to multisampled color buffers which are
+    // resolved into the target textures on display
+    for (std::size_t i = 0; (samples > 0) && (i < m_textureIds.size()); ++i)
+    {
+        GLuint color = 0;
+        glCheck(GLEXT_glGenRenderbuffers(1, &color));
+        if (!color)
+        {
+            err() << "Impossible to create render texture (failed to create the multisampled color buffer)" << std::endl;
+            return false;
+        }
+        m_colorBuffers.push_back(static_cast<unsigned int>(color));
+
+        // The color buffer must have the same format as the texture it is resolved into
+        GLint format = GL_RGBA8;
+        {
+            TextureSaver save;
+            glCheck(glBindTexture(GL_TEXTURE_2D, m_textureIds[i]));
+            glCheck(glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &format));
+        }
+
+        glCheck(GLEXT_glBindRenderbuffer(GLEXT_GL_RENDERBUFFER, color));
+        glCheck(GLEXT_glRenderbufferStorageMultisample(GLEXT_GL_RENDERBUFFER, samples, format, width, height));
+
+        // Each sample takes the size of a pixel of the texture
+        Uint64 pixelSize = 4;
+        if (format == static_cast<GLint>(GLEXT_GL_R8))
+            pixelSize = 1;
+        else if (format == static_cast<GLint>(GLEXT_GL_RGBA16F))
+            pixelSize = 8;
+        else if (format == static_cast<GLint>(GLEXT_GL_RGBA32F))
+            pixelSize = 16;
+        m_gpuMemory.setBytes(m_gpuMemory.getBytes() + pixelSize * samples * width * height);
+    }
+
+#endif
+
+    // Create the depth buffer if requested; unlike frame buffers, render
+    // buffers are shared, so a single one serves all the contexts
+    if (settings.depthBits > 0)
     {
         GLuint depth = 0;
         glCheck(GLEXT_glGenRenderbuffers(1, &depth));
@@ -109,36 +278,202 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
             return false;
         }
         glCheck(GLEXT_glBindRenderbuffer(GLEXT_GL_RENDERBUFFER, m_depthBuffer));
-        glCheck(GLEXT_glRenderbufferStorage(GLEXT_GL_RENDERBUFFER, GLEXT_GL_DEPTH_COMPONENT, width, height));
-        glCheck(GLEXT_glFramebufferRenderbuffer(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_DEPTH_ATTACHMENT, GLEXT_GL_RENDERBUFFER, m_depthBuffer));
+
+#ifndef SFML_OPENGL_ES
+
+        // The depth buffer must have as many samples as the color buffers
+        if (samples > 0)
+        {
+            glCheck(GLEXT_glRenderbufferStorageMultisample(GLEXT_GL_RENDERBUFFER, samples, GLEXT_GL_DEPTH_COMPONENT, width, height));
+        }
+        else
+
+#endif
+
+        {
+            glCheck(GLEXT_glRenderbufferStorage(GLEXT_GL_RENDERBUFFER, GLEXT_GL_DEPTH_COMPONENT, width, height));
+        }
+
+        // Drivers store the depth in 32 bits (24 bits of depth, padded or combined with a stencil)
+        m_gpuMemory.setBytes(m_gpuMemory.getBytes() + static_cast<Uint64>(4) * std::max(samples, 1u) * width * height);
     }
 
-    // Link the texture to the frame buffer
-    glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textureId, 0));
+    // Create the frame buffer of the current context right away, so that
+    // errors are reported at creation rather than at the first draw
+    return createFrameBuffer(Context::getActiveContextId());
+}
 
-    // A final check, just to be sure...
-    GLenum status = glCheck(GLEXT_glCheckFramebufferStatus(GLEXT_GL_FRAMEBUFFER));
-    if (status != GLEXT_GL_FRAMEBUFFER_COMPLETE)
+
+////////////////////////////////////////////////////////////
+bool RenderTextureImplFBO::activate(bool active)
+{
+    // Rendering is done in whatever context is active on the current thread
+    ensureGlContext();
+
+    if (!active)
     {
-        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, 0));
-        err() << "Impossible to create render texture (failed to link the target texture to the frame buffer)" << std::endl;
+        unbind();
+        return true;
+    }
+
+    Uint64 contextId = Context::getActiveContextId();
+
+    // Take the opportunity to release what dead render textures left in this context
+    destroyStaleFrameBuffers(contextId);
+
+    // Reuse the frame buffer of this context if we already have one; switching
+    // between render textures is then a simple frame buffer binding
+    FrameBufferTable::const_iterator it = m_frameBuffers.find(contextId);
+    if (it != m_frameBuffers.end())
+    {
+        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, it->second));
+        return true;
+    }
+
+    return createFrameBuffer(contextId);
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTextureImplFBO::createFrameBuffer(Uint64 contextId)
+{
+    // Create the frame buffer that is rendered to
+    bool multisampled = !m_colorBuffers.empty();
+    unsigned int frameBuffer = createAttachedFrameBuffer(multisampled);
+    if (!frameBuffer)
         return false;
+
+    // With antialiasing, a second frame buffer holds the target textures that
+    // the multisampled one is resolved into
+    if (multisampled)
+    {
+        unsigned int resolveFrameBuffer = createAttachedFrameBuffer(false);
+        if (!resolveFrameBuffer)
+        {
+            GLuint multisampleFrameBuffer = static_cast<GLuint>(frameBuffer);
+            glCheck(GLEXT_glDeleteFramebuffers(1, &multisampleFrameBuffer));
+            return false;
+        }
+
+        m_resolveFrameBuffers[contextId] = resolveFrameBuffer;
+        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, frameBuffer));
     }
 
+    m_frameBuffers[contextId] = frameBuffer;
+
     return true;
 }
 
 
 ////////////////////////////////////////////////////////////
-bool RenderTextureImplFBO::activate(bool active)
+unsigned int RenderTextureImplFBO::createAttachedFrameBuffer(bool multisampled)
 {
-    return m_context->setActive(active);
+    // Create the framebuffer object
+    GLuint frameBuffer = 0;
+    glCheck(GLEXT_glGenFramebuffers(1, &frameBuffer));
+    if (!frameBuffer)
+    {
+        err() << "Impossible to create render texture (failed to create the frame buffer object)" << std::endl;
+        return 0;
+    }
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, frameBuffer));
+
+    // Attach the depth buffer, if any, to the frame buffer that is rendered to
+    if (m_depthBuffer && (multisampled || m_colorBuffers.empty()))
+    {
+        glCheck(GLEXT_glFramebufferRenderbuffer(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_DEPTH_ATTACHMENT, GLEXT_GL_RENDERBUFFER, m_depthBuffer));
+    }
+
+    // Link the color buffers, or the textures, to the frame buffer
+    for (std::size_t i = 0; i < m_textureIds.size(); ++i)
+    {
+        GLenum attachment = static_cast<GLenum>(GLEXT_GL_COLOR_ATTACHMENT0 + i);
+        if (multisampled)
+        {
+            glCheck(GLEXT_glFramebufferRenderbuffer(GLEXT_GL_FRAMEBUFFER, attachment, GLEXT_GL_RENDERBUFFER, m_colorBuffers[i]));
+        }
+        else
+        {
+            glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, m_textureIds[i], 0));
+        }
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    // Render to all the color attachments at once
+    if (m_textureIds.size() > 1)
+    {
+        std::vector<GLenum> drawBuffers(m_textureIds.size());
+        for (std::size_t i = 0; i < drawBuffers.size(); ++i)
+            drawBuffers[i] = static_cast<GLenum>(GLEXT_GL_COLOR_ATTACHMENT0 + i);
+
+        glCheck(GLEXT_glDrawBuffers(static_cast<GLsizei>(drawBuffers.size()), &drawBuffers[0]));
+    }
+
+#endif
+
+    // A final check, just to be sure...
+    GLenum status = glCheck(GLEXT_glCheckFramebufferStatus(GLEXT_GL_FRAMEBUFFER));
+    if (status != GLEXT_GL_FRAMEBUFFER_COMPLETE)
+    {
+        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, 0));
+        glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
+        if (multisampled)
+            err() << "Impossible to create render texture (failed to link the multisampled buffers to the frame buffer)" << std::endl;
+        else
+            err() << "Impossible to create render texture (failed to link the target texture to the frame buffer)" << std::endl;
+        return 0;
+    }
+
+    return static_cast<unsigned int>(frameBuffer);
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTextureImplFBO::updateTexture(unsigned int)
 {
+#ifndef SFML_OPENGL_ES
+
+    // Resolve the multisampled frame buffer of this context into the target textures
+    if (!m_colorBuffers.empty())
+    {
+        Uint64 contextId = Context::getActiveContextId();
+        FrameBufferTable::const_iterator source = m_frameBuffers.find(contextId);
+        FrameBufferTable::const_iterator destination = m_resolveFrameBuffers.find(contextId);
+        if ((source != m_frameBuffers.end()) && (destination != m_resolveFrameBuffers.end()))
+        {
+            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_READ_FRAMEBUFFER, source->second));
+            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, destination->second));
+
+            // The whole buffer must be resolved, whatever the clipping rectangle of the target
+            GLboolean scissorTest = GL_FALSE;
+            glCheck(scissorTest = glIsEnabled(GL_SCISSOR_TEST));
+            if (scissorTest)
+            {
+                glCheck(glDisable(GL_SCISSOR_TEST));
+            }
+
+            // A blit only copies a single color buffer, resolve the attachments one by one
+            for (std::size_t i = 0; i < m_colorBuffers.size(); ++i)
+            {
+                GLenum attachment = static_cast<GLenum>(GLEXT_GL_COLOR_ATTACHMENT0 + i);
+                glCheck(glReadBuffer(attachment));
+                glCheck(glDrawBuffer(attachment));
+                glCheck(GLEXT_glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height, GL_COLOR_BUFFER_BIT, GL_NEAREST));
+            }
+            glCheck(glReadBuffer(GLEXT_GL_COLOR_ATTACHMENT0));
+
+            if (scissorTest)
+            {
+                glCheck(glEnable(GL_SCISSOR_TEST));
+            }
+
+            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, source->second));
+        }
+    }
+
+#endif
+
     glCheck(glFlush());
 }
 
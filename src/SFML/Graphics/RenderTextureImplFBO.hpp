@@ -29,8 +29,10 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderTextureImpl.hpp>
+#include <SFML/Graphics/GpuMemory.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/GlResource.hpp>
+#include <map>
 
 
 namespace sf
@@ -66,20 +68,49 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isAvailable();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum antialiasing level supported by FBOs
+    ///
+    /// \return Maximum number of samples per pixel, 0 if
+    ///         multisampled frame buffers are not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumAntialiasingLevel();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of color attachments supported by FBOs
+    ///
+    /// \return Maximum number of textures rendered to at once
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumAttachmentCount();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unbind the currently bound frame buffer object
+    ///
+    /// Render textures no longer own a context, they bind their
+    /// frame buffer in the context of the current thread. Targets
+    /// that draw to the default frame buffer of their context
+    /// (i.e. windows) must therefore call this function when
+    /// they are activated.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void unbind();
+
 private:
 
     ////////////////////////////////////////////////////////////
     /// \brief Create the render texture implementation
     ///
-    /// \param width       Width of the texture to render to
-    /// \param height      Height of the texture to render to
-    /// \param textureId   OpenGL identifier of the target texture
-    /// \param depthBuffer Is a depth buffer requested?
+    /// \param width      Width of the textures to render to
+    /// \param height     Height of the textures to render to
+    /// \param textureIds OpenGL identifiers of the target textures, one per color attachment
+    /// \param settings   Depth buffer and antialiasing requested
     ///
     /// \return True if creation has been successful
     ///
     ////////////////////////////////////////////////////////////
-    virtual bool create(unsigned int width, unsigned int height, unsigned int textureId, bool depthBuffer);
+    virtual bool create(unsigned int width, unsigned int height, const std::vector<unsigned int>& textureIds, const ContextSettings& settings);
 
     ////////////////////////////////////////////////////////////
     /// \brief Activate or deactivate the render texture for rendering
@@ -99,12 +130,44 @@ private:
     ////////////////////////////////////////////////////////////
     virtual void updateTexture(unsigned textureId);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create and bind a frame buffer object for the active context
+    ///
+    /// \param contextId Identifier of the active context
+    ///
+    /// \return True if the frame buffer is complete
+    ///
+    ////////////////////////////////////////////////////////////
+    bool createFrameBuffer(Uint64 contextId);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a frame buffer object and attach buffers to it
+    ///
+    /// The new frame buffer is left bound on success.
+    ///
+    /// \param multisampled True to attach the multisampled buffers, false to attach the target textures
+    ///
+    /// \return OpenGL identifier of the frame buffer, 0 on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int createAttachedFrameBuffer(bool multisampled);
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<Uint64, unsigned int> FrameBufferTable;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Context*     m_context;     ///< Needs a separate OpenGL context for not messing up the other ones
-    unsigned int m_frameBuffer; ///< OpenGL frame buffer object
-    unsigned int m_depthBuffer; ///< Optional depth buffer attached to the frame buffer
+    FrameBufferTable          m_frameBuffers;        ///< OpenGL frame buffer objects, one per context they are used in
+    FrameBufferTable          m_resolveFrameBuffers; ///< Frame buffers that the multisampled ones are resolved into, one per context
+    std::vector<unsigned int> m_colorBuffers;        ///< Multisampled color buffers attached to the frame buffers, if antialiasing is enabled
+    unsigned int              m_depthBuffer;         ///< Optional depth buffer attached to the frame buffers
+    std::vector<unsigned int> m_textureIds;          ///< OpenGL identifiers of the target textures, one per color attachment
+    unsigned int              m_width;               ///< Width of the frame buffers
+    unsigned int              m_height;              ///< Height of the frame buffers
+    GpuMemory::Counter        m_gpuMemory;           ///< Reports the estimated video memory of the color and depth buffers
 };
 
 } // namespace priv
@@ -26,20 +26,50 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/RenderTextureImplFBO.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace
+{
+    // Wait until the GPU has executed the commands before a fence
+    void waitForFence(void* fence)
+    {
+        // Flush the pending commands on the first try only, otherwise the
+        // fence might never be signaled; wait by steps of one millisecond
+        GLbitfield flags = GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT;
+        for (;;)
+        {
+            GLenum status = glCheck(GLEXT_glClientWaitSync(static_cast<GLEXT_GLsync>(fence), flags, 1000000));
+            if ((status == GLEXT_GL_ALREADY_SIGNALED) || (status == GLEXT_GL_CONDITION_SATISFIED))
+                break;
+
+            if (status == GLEXT_GL_WAIT_FAILED)
+            {
+                sf::err() << "Failed to wait for the end of a frame" << std::endl;
+                break;
+            }
+
+            flags = 0;
+        }
+    }
+}
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
-RenderWindow::RenderWindow()
+RenderWindow::RenderWindow() :
+m_maxFramesInFlight(0)
 {
     // Nothing to do
 }
 
 
 ////////////////////////////////////////////////////////////
-RenderWindow::RenderWindow(VideoMode mode, const String& title, Uint32 style, const ContextSettings& settings)
+RenderWindow::RenderWindow(VideoMode mode, const String& title, Uint32 style, const ContextSettings& settings) :
+m_maxFramesInFlight(0)
 {
     // Don't call the base class constructor because it contains virtual function calls
     create(mode, title, style, settings);
@@ -47,7 +77,8 @@ RenderWindow::RenderWindow(VideoMode mode, const String& title, Uint32 style, co
 
 
 ////////////////////////////////////////////////////////////
-RenderWindow::RenderWindow(WindowHandle handle, const ContextSettings& settings)
+RenderWindow::RenderWindow(WindowHandle handle, const ContextSettings& settings) :
+m_maxFramesInFlight(0)
 {
     // Don't call the base class constructor because it contains virtual function calls
     create(handle, settings);
@@ -57,14 +88,22 @@ RenderWindow::RenderWindow(WindowHandle handle, const ContextSettings& settings)
 ////////////////////////////////////////////////////////////
 RenderWindow::~RenderWindow()
 {
-    // Nothing to do
+    if (!m_frameFences.empty() && setActive())
+        clearFrameFences();
 }
 
 
 ////////////////////////////////////////////////////////////
 bool RenderWindow::activate(bool active)
 {
-    return setActive(active);
+    bool result = setActive(active);
+
+    // Render textures bind their frame buffer in the context of their
+    // thread, which may be ours: make sure we draw to the window itself
+    if (active && result && priv::RenderTextureImplFBO::isAvailable())
+        priv::RenderTextureImplFBO::unbind();
+
+    return result;
 }
 
 
@@ -76,32 +115,86 @@ Vector2u RenderWindow::getSize() const
 
 
 ////////////////////////////////////////////////////////////
-Image RenderWindow::capture() const
+void RenderWindow::display()
 {
-    Image image;
-    if (setActive())
+    // Render the geometry that is still pending
+    flushBatch();
+
+    Window::display();
+
+    // Window::display left our context active
+    if (m_maxFramesInFlight > 0)
     {
-        int width = static_cast<int>(getSize().x);
-        int height = static_cast<int>(getSize().y);
+        priv::ensureExtensionsInit();
 
-        // copy rows one by one and flip them (OpenGL's origin is bottom while SFML's origin is top)
-        std::vector<Uint8> pixels(width * height * 4);
-        for (int i = 0; i < height; ++i)
+        if (GLEXT_sync)
         {
-            Uint8* ptr = &pixels[i * width * 4];
-            glCheck(glReadPixels(0, height - i - 1, width, 1, GL_RGBA, GL_UNSIGNED_BYTE, ptr));
+            GLEXT_GLsync fence = glCheck(GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+            m_frameFences.push_back(fence);
+
+            // Block until the GPU has caught up, keeping at most the allowed number of frames pending
+            while (m_frameFences.size() > m_maxFramesInFlight)
+            {
+                waitForFence(m_frameFences.front());
+                glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(m_frameFences.front())));
+                m_frameFences.pop_front();
+            }
         }
-
-        image.create(width, height, &pixels[0]);
     }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderWindow::setMaxFramesInFlight(unsigned int count)
+{
+    m_maxFramesInFlight = count;
+
+    // The fences of an unlimited window are useless
+    if ((count == 0) && !m_frameFences.empty() && setActive())
+        clearFrameFences();
+}
+
+
+////////////////////////////////////////////////////////////
+Image RenderWindow::capture() const
+{
+    Image image;
+    capture(image);
 
     return image;
 }
 
 
+////////////////////////////////////////////////////////////
+bool RenderWindow::capture(Image& image) const
+{
+    Vector2u size = getSize();
+    if (!size.x || !size.y || !setActive())
+        return false;
+
+    // Read the window itself, not a render texture bound in its context
+    if (priv::RenderTextureImplFBO::isAvailable())
+        priv::RenderTextureImplFBO::unbind();
+
+    // Keep the memory of the image, it has the right size when capturing frame after frame
+    image.m_size = size;
+    image.m_pixels.resize(size.x * size.y * 4);
+    image.m_memory.setBytes(image.m_pixels.capacity());
+
+    // Read all the rows at once, then flip them (OpenGL's origin is bottom while SFML's origin is top)
+    glCheck(glReadPixels(0, 0, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, &image.m_pixels[0]));
+    image.flipVertically();
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderWindow::onCreate()
 {
+    // The fences belonged to the previous context, which is gone
+    m_frameFences.clear();
+
     // Just initialize the render target part
     RenderTarget::initialize();
 }
@@ -114,4 +207,16 @@ void RenderWindow::onResize()
     setView(getView());
 }
 
+
+////////////////////////////////////////////////////////////
+void RenderWindow::clearFrameFences()
+{
+    for (std::deque<void*>::iterator i = m_frameFences.begin(); i != m_frameFences.end(); ++i)
+    {
+        glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(*i)));
+    }
+
+    m_frameFences.clear();
+}
+
 } // namespace sf
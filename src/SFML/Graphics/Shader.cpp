@@ -28,19 +28,26 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/TextureArray.hpp>
+#include <SFML/Graphics/UniformBuffer.hpp>
+#include <SFML/Graphics/CorePipeline.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
+#include <SFML/System/Thread.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <vector>
 
 
-#ifndef SFML_OPENGL_ES
+#if !defined(SFML_OPENGL_ES) || defined(SFML_OPENGL_ES2)
 
-#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+#if defined(SFML_SYSTEM_MACOS)
 
     #define castToGlHandle(x) reinterpret_cast<GLEXT_GLhandle>(static_cast<ptrdiff_t>(x))
     #define castFromGlHandle(x) static_cast<unsigned int>(reinterpret_cast<ptrdiff_t>(x))
@@ -52,10 +59,44 @@
 
 #endif
 
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief State of an asynchronous shader compilation
+///
+////////////////////////////////////////////////////////////
+struct ShaderBuild
+{
+    GLEXT_GLhandle program;            ///< Program being built
+    GLEXT_GLhandle shaders[2];         ///< Shaders compiled by the driver in the background, if any
+    Thread*        thread;             ///< Worker thread building the program, if the driver can't do it in the background
+    std::string    vertexShaderCode;   ///< Copy of the vertex shader source, for the worker thread
+    std::string    fragmentShaderCode; ///< Copy of the fragment shader source, for the worker thread
+    bool           hasVertexShader;    ///< Is there a vertex shader?
+    bool           hasFragmentShader;  ///< Is there a fragment shader?
+    std::string    entryPath;          ///< Path of the binary cache entry to write, empty if none
+    std::string    key;                ///< Key of the binary cache entry
+    Mutex          mutex;              ///< Mutex protecting the result written by the worker thread
+    bool           finished;           ///< Has the worker thread finished?
+    bool           success;            ///< Was the program built successfully by the worker thread?
+};
+
+} // namespace priv
+
+} // namespace sf
+
 namespace
 {
     sf::Mutex mutex;
 
+    // The texture bound to each unit is a state of each context, so is its cached
+    // value; units are indexed from 0 and hold the cache identifier of their texture
+    typedef std::map<sf::Uint64, std::vector<sf::Uint64> > TextureUnitTable;
+    TextureUnitTable boundTextures;
+    sf::Mutex boundTexturesMutex;
+
     GLint checkMaxTextureUnits()
     {
         GLint maxUnits = 0;
@@ -132,6 +173,305 @@ namespace
 
         return available;
     }
+
+    // Directory of the program binary cache, empty when it is disabled
+    std::string binaryCacheDirectory;
+
+    // Header of a program binary cache entry; it is followed
+    // by the key of the entry and by the program binary
+    struct BinaryEntryHeader
+    {
+        char       magic[4];
+        sf::Uint32 version;
+        sf::Uint32 keyLength;
+        sf::Uint32 format;
+        sf::Uint32 binaryLength;
+    };
+
+    const char       binaryEntryMagic[4] = {'S', 'F', 'P', 'B'};
+    const sf::Uint32 binaryEntryVersion  = 1;
+
+    // 64-bit FNV-1a hash, used to name the cache entries
+    std::string hashName(const std::string& str)
+    {
+        sf::Uint64 hash = 14695981039346656037ULL;
+        for (std::size_t i = 0; i < str.size(); ++i)
+        {
+            hash ^= static_cast<unsigned char>(str[i]);
+            hash *= 1099511628211ULL;
+        }
+
+        static const char digits[] = "0123456789abcdef";
+        std::string name(16, '0');
+        for (int i = 15; i >= 0; --i)
+        {
+            name[i] = digits[hash & 0xF];
+            hash >>= 4;
+        }
+
+        return name;
+    }
+
+    // Append an OpenGL string to a cache key
+    void appendGlString(std::string& key, GLenum name)
+    {
+        const GLubyte* value = glGetString(name);
+        if (value)
+            key += reinterpret_cast<const char*>(value);
+        key += '\n';
+    }
+
+    // Get the path of the cache entry of a program, and the key that identifies it;
+    // the path is empty if the cache is disabled or unsupported
+    std::string getBinaryEntryPath(const char* vertexShaderCode, const char* fragmentShaderCode, std::string& key)
+    {
+#ifdef SFML_OPENGL_ES
+
+        // OpenGL ES 2 has no standard program binaries
+        return "";
+
+#else
+
+        std::string directory;
+        {
+            sf::Lock lock(mutex);
+            directory = binaryCacheDirectory;
+        }
+
+        if (directory.empty() || !GLEXT_get_program_binary)
+            return "";
+
+        GLint formatCount = 0;
+        glCheck(glGetIntegerv(GLEXT_GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount));
+        if (formatCount <= 0)
+            return "";
+
+        // The binaries are only valid for the driver that produced them
+        key.clear();
+        appendGlString(key, GL_VENDOR);
+        appendGlString(key, GL_RENDERER);
+        appendGlString(key, GL_VERSION);
+        key += "vertex\n";
+        if (vertexShaderCode)
+            key += vertexShaderCode;
+        key += "\nfragment\n";
+        if (fragmentShaderCode)
+            key += fragmentShaderCode;
+
+        return directory + "/" + hashName(key) + ".sfprogram";
+
+#endif
+    }
+
+    // Restore a program from its cache entry
+    bool loadProgramBinary(GLEXT_GLhandle program, const std::string& entryPath, const std::string& key)
+    {
+#ifdef SFML_OPENGL_ES
+
+        // Never called, getBinaryEntryPath disables the cache
+        return false;
+
+#else
+
+        std::vector<char> entry;
+        if (!getFileContents(entryPath, entry))
+            return false;
+
+        // Ignore the null character appended by getFileContents
+        std::size_t entrySize = entry.size() - 1;
+
+        BinaryEntryHeader header;
+        if (entrySize < sizeof(header))
+            return false;
+
+        std::memcpy(&header, &entry[0], sizeof(header));
+
+        // The version also rejects entries written with a different byte order
+        if ((std::memcmp(header.magic, binaryEntryMagic, sizeof(binaryEntryMagic)) != 0) ||
+            (header.version != binaryEntryVersion) ||
+            (header.keyLength != key.size()) ||
+            (entrySize != sizeof(header) + static_cast<std::size_t>(header.keyLength) + header.binaryLength) ||
+            (std::memcmp(&entry[sizeof(header)], key.data(), key.size()) != 0))
+        {
+            return false;
+        }
+
+        const char* binary = &entry[sizeof(header) + key.size()];
+        glCheck(GLEXT_glProgramBinary(castFromGlHandle(program), header.format, binary, static_cast<GLsizei>(header.binaryLength)));
+
+        // The driver may reject a binary that it produced, after an update for example
+        GLint success;
+        glCheck(GLEXT_glGetObjectParameteriv(program, GLEXT_GL_OBJECT_LINK_STATUS, &success));
+
+        return success != GL_FALSE;
+
+#endif
+    }
+
+    // Store a linked program to its cache entry
+    void saveProgramBinary(GLEXT_GLhandle program, const std::string& entryPath, const std::string& key)
+    {
+#ifndef SFML_OPENGL_ES
+
+        GLint length = 0;
+        glCheck(GLEXT_glGetObjectParameteriv(program, GLEXT_GL_PROGRAM_BINARY_LENGTH, &length));
+        if (length <= 0)
+            return;
+
+        std::vector<char> binary(static_cast<std::size_t>(length));
+        GLsizei written = 0;
+        GLenum format = 0;
+        glCheck(GLEXT_glGetProgramBinary(castFromGlHandle(program), length, &written, &format, &binary[0]));
+        if (written <= 0)
+            return;
+
+        BinaryEntryHeader header;
+        std::memcpy(header.magic, binaryEntryMagic, sizeof(binaryEntryMagic));
+        header.version      = binaryEntryVersion;
+        header.keyLength    = static_cast<sf::Uint32>(key.size());
+        header.format       = static_cast<sf::Uint32>(format);
+        header.binaryLength = static_cast<sf::Uint32>(written);
+
+        // Write the entry to a temporary file first, so that an interrupted
+        // write never leaves a truncated entry behind
+        std::string temporaryPath = entryPath + ".tmp";
+        bool success = false;
+        {
+            std::ofstream file(temporaryPath.c_str(), std::ios_base::binary | std::ios_base::trunc);
+            if (file)
+            {
+                file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                file.write(key.data(), key.size());
+                file.write(&binary[0], written);
+                file.close();
+                success = !file.fail();
+            }
+        }
+
+        // rename doesn't replace existing files on Windows
+        std::remove(entryPath.c_str());
+        if (!success || (std::rename(temporaryPath.c_str(), entryPath.c_str()) != 0))
+        {
+            sf::err() << "Failed to write shader binary cache entry \"" << entryPath << "\"" << std::endl;
+            std::remove(temporaryPath.c_str());
+        }
+
+#endif
+    }
+
+    // Compile the shaders and start linking them into a program, without waiting for the
+    // driver; the shaders are returned so that their compile status can be checked later
+    void startBuild(GLEXT_GLhandle shaderProgram, const char* vertexShaderCode, const char* fragmentShaderCode,
+                    bool retrievable, GLEXT_GLhandle shaders[2])
+    {
+        const char* codes[2] = {vertexShaderCode, fragmentShaderCode};
+        GLenum      types[2] = {GLEXT_GL_VERTEX_SHADER, GLEXT_GL_FRAGMENT_SHADER};
+
+        for (int i = 0; i < 2; ++i)
+        {
+            shaders[i] = 0;
+
+            // Create the shader if needed
+            if (codes[i])
+            {
+                shaders[i] = glCheck(GLEXT_glCreateShaderObject(types[i]));
+                glCheck(GLEXT_glShaderSource(shaders[i], 1, &codes[i], NULL));
+                glCheck(GLEXT_glCompileShader(shaders[i]));
+                glCheck(GLEXT_glAttachObject(shaderProgram, shaders[i]));
+            }
+        }
+
+        // Give the vertex components the locations used by the core pipeline of sf::RenderTarget
+        glCheck(GLEXT_glBindAttribLocation(shaderProgram, sf::priv::CorePipeline::Position,  "sf_position"));
+        glCheck(GLEXT_glBindAttribLocation(shaderProgram, sf::priv::CorePipeline::Color,     "sf_color"));
+        glCheck(GLEXT_glBindAttribLocation(shaderProgram, sf::priv::CorePipeline::TexCoords, "sf_texCoords"));
+
+        // Ask the driver to keep the binary of the program retrievable, before it is linked
+#ifndef SFML_OPENGL_ES
+        if (retrievable)
+        {
+            glCheck(GLEXT_glProgramParameteri(castFromGlHandle(shaderProgram), GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+        }
+#endif
+
+        // Link the program; a failed compilation makes the link fail too
+        glCheck(GLEXT_glLinkProgram(shaderProgram));
+    }
+
+    // Check the result of a build started with startBuild, and release its shaders
+    bool finishBuild(GLEXT_GLhandle shaderProgram, GLEXT_GLhandle shaders[2])
+    {
+        static const char* const names[2] = {"vertex", "fragment"};
+
+        bool compiled = true;
+        for (int i = 0; i < 2; ++i)
+        {
+            if (!shaders[i])
+                continue;
+
+            // Check the compile log
+            GLint success;
+            glCheck(GLEXT_glGetObjectParameteriv(shaders[i], GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
+            if (success == GL_FALSE)
+            {
+                char log[1024];
+                glCheck(GLEXT_glGetInfoLog(shaders[i], sizeof(log), 0, log));
+                sf::err() << "Failed to compile " << names[i] << " shader:" << std::endl
+                          << log << std::endl;
+                compiled = false;
+            }
+
+            // The shader is not needed anymore, it is destroyed along with the program
+            glCheck(GLEXT_glDeleteObject(shaders[i]));
+            shaders[i] = 0;
+        }
+
+        if (!compiled)
+            return false;
+
+        // Check the link log
+        GLint success;
+        glCheck(GLEXT_glGetObjectParameteriv(shaderProgram, GLEXT_GL_OBJECT_LINK_STATUS, &success));
+        if (success == GL_FALSE)
+        {
+            char log[1024];
+            glCheck(GLEXT_glGetInfoLog(shaderProgram, sizeof(log), 0, log));
+            sf::err() << "Failed to link shader:" << std::endl
+                      << log << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    // Compile the shaders and link them into a program
+    bool buildProgram(GLEXT_GLhandle shaderProgram, const char* vertexShaderCode, const char* fragmentShaderCode, bool retrievable)
+    {
+        GLEXT_GLhandle shaders[2];
+        startBuild(shaderProgram, vertexShaderCode, fragmentShaderCode, retrievable, shaders);
+
+        return finishBuild(shaderProgram, shaders);
+    }
+
+    // Build a program on a worker thread, in its own context
+    void runShaderBuild(sf::priv::ShaderBuild* build)
+    {
+        sf::Context context;
+
+        const char* vertexShaderCode   = build->hasVertexShader   ? build->vertexShaderCode.c_str()   : NULL;
+        const char* fragmentShaderCode = build->hasFragmentShader ? build->fragmentShaderCode.c_str() : NULL;
+
+        bool success = buildProgram(build->program, vertexShaderCode, fragmentShaderCode, !build->entryPath.empty());
+        if (success && !build->entryPath.empty())
+            saveProgramBinary(build->program, build->entryPath, build->key);
+
+        // Make sure that the program is complete before other contexts use it
+        glCheck(glFinish());
+
+        sf::Lock lock(build->mutex);
+        build->finished = true;
+        build->success  = success;
+    }
 }
 
 
@@ -143,11 +483,20 @@ Shader::CurrentTextureType Shader::CurrentTexture;
 
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
-m_shaderProgram (0),
-m_currentTexture(-1),
-m_textures      (),
-m_params        ()
+m_shaderProgram      (0),
+m_currentTexture     (-1),
+m_textures           (),
+m_textureArrays      (),
+m_uniformBuffers     (),
+m_params             (),
+m_handles            (),
+m_uniforms           (),
+m_dirtyUniforms      (),
+m_textureUnitsChanged(false),
+m_asynchronous       (false),
+m_build              (NULL)
 {
+    std::fill(m_matrices, m_matrices + 3, -1);
 }
 
 
@@ -156,6 +505,9 @@ Shader::~Shader()
 {
     ensureGlContext();
 
+    // Stop the compilation in progress
+    cancelBuild();
+
     // Destroy effect program
     if (m_shaderProgram)
         glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaderProgram)));
@@ -270,96 +622,28 @@ bool Shader::loadFromStream(InputStream& vertexShaderStream, InputStream& fragme
 ////////////////////////////////////////////////////////////
 void Shader::setParameter(const std::string& name, float x)
 {
-    if (m_shaderProgram)
-    {
-        ensureGlContext();
-
-        // Enable program
-        GLEXT_GLhandle program = glCheck(GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
-        glCheck(GLEXT_glUseProgramObject(castToGlHandle(m_shaderProgram)));
-
-        // Get parameter location and assign it new values
-        GLint location = getParamLocation(name);
-        if (location != -1)
-        {
-            glCheck(GLEXT_glUniform1f(location, x));
-        }
-
-        // Disable program
-        glCheck(GLEXT_glUseProgramObject(program));
-    }
+    setUniform(getUniformHandle(name), x);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setParameter(const std::string& name, float x, float y)
 {
-    if (m_shaderProgram)
-    {
-        ensureGlContext();
-
-        // Enable program
-        GLEXT_GLhandle program = glCheck(GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
-        glCheck(GLEXT_glUseProgramObject(castToGlHandle(m_shaderProgram)));
-
-        // Get parameter location and assign it new values
-        GLint location = getParamLocation(name);
-        if (location != -1)
-        {
-            glCheck(GLEXT_glUniform2f(location, x, y));
-        }
-
-        // Disable program
-        glCheck(GLEXT_glUseProgramObject(program));
-    }
+    setUniform(getUniformHandle(name), x, y);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setParameter(const std::string& name, float x, float y, float z)
 {
-    if (m_shaderProgram)
-    {
-        ensureGlContext();
-
-        // Enable program
-        GLEXT_GLhandle program = glCheck(GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
-        glCheck(GLEXT_glUseProgramObject(castToGlHandle(m_shaderProgram)));
-
-        // Get parameter location and assign it new values
-        GLint location = getParamLocation(name);
-        if (location != -1)
-        {
-            glCheck(GLEXT_glUniform3f(location, x, y, z));
-        }
-
-        // Disable program
-        glCheck(GLEXT_glUseProgramObject(program));
-    }
+    setUniform(getUniformHandle(name), x, y, z);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setParameter(const std::string& name, float x, float y, float z, float w)
 {
-    if (m_shaderProgram)
-    {
-        ensureGlContext();
-
-        // Enable program
-        GLEXT_GLhandle program = glCheck(GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
-        glCheck(GLEXT_glUseProgramObject(castToGlHandle(m_shaderProgram)));
-
-        // Get parameter location and assign it new values
-        GLint location = getParamLocation(name);
-        if (location != -1)
-        {
-            glCheck(GLEXT_glUniform4f(location, x, y, z, w));
-        }
-
-        // Disable program
-        glCheck(GLEXT_glUseProgramObject(program));
-    }
+    setUniform(getUniformHandle(name), x, y, z, w);
 }
 
 
@@ -387,24 +671,7 @@ void Shader::setParameter(const std::string& name, const Color& color)
 ////////////////////////////////////////////////////////////
 void Shader::setParameter(const std::string& name, const sf::Transform& transform)
 {
-    if (m_shaderProgram)
-    {
-        ensureGlContext();
-
-        // Enable program
-        GLEXT_GLhandle program = glCheck(GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
-        glCheck(GLEXT_glUseProgramObject(castToGlHandle(m_shaderProgram)));
-
-        // Get parameter location and assign it new values
-        GLint location = getParamLocation(name);
-        if (location != -1)
-        {
-            glCheck(GLEXT_glUniformMatrix4fv(location, 1, GL_FALSE, transform.getMatrix()));
-        }
-
-        // Disable program
-        glCheck(GLEXT_glUseProgramObject(program));
-    }
+    setUniform(getUniformHandle(name), transform);
 }
 
 
@@ -425,13 +692,14 @@ void Shader::setParameter(const std::string& name, const Texture& texture)
             {
                 // New entry, make sure there are enough texture units
                 GLint maxUnits = getMaxTextureUnits();
-                if (m_textures.size() + 1 >= static_cast<std::size_t>(maxUnits))
+                if (m_textures.size() + m_textureArrays.size() + 1 >= static_cast<std::size_t>(maxUnits))
                 {
                     err() << "Impossible to use texture \"" << name << "\" for shader: all available texture units are used" << std::endl;
                     return;
                 }
 
                 m_textures[location] = &texture;
+                m_textureUnitsChanged = true;
             }
             else
             {
@@ -444,84 +712,340 @@ void Shader::setParameter(const std::string& name, const Texture& texture)
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, CurrentTextureType)
+void Shader::setParameter(const std::string& name, const TextureArray& textures)
 {
     if (m_shaderProgram)
     {
         ensureGlContext();
 
         // Find the location of the variable in the shader
-        m_currentTexture = getParamLocation(name);
+        int location = getParamLocation(name);
+        if (location != -1)
+        {
+            // Store the location -> texture array mapping
+            TextureArrayTable::iterator it = m_textureArrays.find(location);
+            if (it == m_textureArrays.end())
+            {
+                // New entry, make sure there are enough texture units
+                GLint maxUnits = getMaxTextureUnits();
+                if (m_textures.size() + m_textureArrays.size() + 1 >= static_cast<std::size_t>(maxUnits))
+                {
+                    err() << "Impossible to use texture array \"" << name << "\" for shader: all available texture units are used" << std::endl;
+                    return;
+                }
+
+                m_textureArrays[location] = &textures;
+                m_textureUnitsChanged = true;
+            }
+            else
+            {
+                // Location already used, just replace the texture array
+                it->second = &textures;
+            }
+        }
     }
 }
 
 
 ////////////////////////////////////////////////////////////
-unsigned int Shader::getNativeHandle() const
+void Shader::setParameter(const std::string& name, const UniformBuffer& buffer)
 {
-    return m_shaderProgram;
-}
+    if (m_shaderProgram)
+    {
+        if (!UniformBuffer::isAvailable())
+        {
+            err() << "Impossible to use uniform block \"" << name << "\" for shader: your system doesn't support uniform buffers" << std::endl;
+            return;
+        }
 
+#ifndef SFML_OPENGL_ES
 
-////////////////////////////////////////////////////////////
-void Shader::bind(const Shader* shader)
-{
-    ensureGlContext();
+        ensureGlContext();
 
-    // Make sure that we can use shaders
-    if (!isAvailable())
-    {
-        err() << "Failed to bind or unbind shader: your system doesn't support shaders "
-              << "(you should test Shader::isAvailable() before trying to use the Shader class)" << std::endl;
-        return;
-    }
+        // Find the index of the block in the shader
+        GLuint index = glCheck(GLEXT_glGetUniformBlockIndex(m_shaderProgram, name.c_str()));
+        if (index == GLEXT_GL_INVALID_INDEX)
+        {
+            err() << "Uniform block \"" << name << "\" not found in shader" << std::endl;
+            return;
+        }
 
-    if (shader && shader->m_shaderProgram)
-    {
-        // Enable the program
-        glCheck(GLEXT_glUseProgramObject(castToGlHandle(shader->m_shaderProgram)));
+        // New entry: the index of the block is its binding point, so
+        // that every block of the program gets a different one
+        UniformBufferTable::iterator it = m_uniformBuffers.find(index);
+        if (it == m_uniformBuffers.end())
+        {
+            GLint maxBindings = 0;
+            glCheck(glGetIntegerv(GLEXT_GL_MAX_UNIFORM_BUFFER_BINDINGS, &maxBindings));
+            if (index >= static_cast<GLuint>(maxBindings))
+            {
+                err() << "Impossible to use uniform block \"" << name << "\" for shader: all available binding points are used" << std::endl;
+                return;
+            }
 
-        // Bind the textures
-        shader->bindTextures();
+            glCheck(GLEXT_glUniformBlockBinding(m_shaderProgram, index, index));
+        }
 
-        // Bind the current texture
-        if (shader->m_currentTexture != -1)
-            glCheck(GLEXT_glUniform1i(shader->m_currentTexture, 0));
-    }
-    else
-    {
-        // Bind no shader
-        glCheck(GLEXT_glUseProgramObject(0));
+        m_uniformBuffers[index] = &buffer;
+
+#endif
     }
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Shader::isAvailable()
+void Shader::setParameter(const std::string& name, CurrentTextureType)
 {
-    // TODO: Remove this lock when it becomes unnecessary in C++11
-    Lock lock(mutex);
-
-    static bool available = checkShadersAvailable();
+    if (m_shaderProgram)
+    {
+        ensureGlContext();
 
-    return available;
+        // Find the location of the variable in the shader
+        m_currentTexture = getParamLocation(name);
+        m_textureUnitsChanged = true;
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Shader::compile(const char* vertexShaderCode, const char* fragmentShaderCode)
+int Shader::getUniformHandle(const std::string& name)
 {
+    if (!m_shaderProgram)
+        return -1;
+
+    // Check the cache
+    ParamTable::const_iterator it = m_handles.find(name);
+    if (it != m_handles.end())
+        return it->second;
+
     ensureGlContext();
 
-    // First make sure that we can use shaders
-    if (!isAvailable())
+    // Create a new entry in the shadow block, unless the parameter doesn't exist
+    int handle = -1;
+    int location = getParamLocation(name);
+    if (location != -1)
     {
-        err() << "Failed to create a shader: your system doesn't support shaders "
-              << "(you should test Shader::isAvailable() before trying to use the Shader class)" << std::endl;
-        return false;
+        Uniform uniform;
+        uniform.location = location;
+        uniform.size = 0;
+        uniform.dirty = false;
+
+        handle = static_cast<int>(m_uniforms.size());
+        m_uniforms.push_back(uniform);
     }
 
-    // Destroy the shader if it was already created
+    m_handles.insert(std::make_pair(name, handle));
+
+    return handle;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(int handle, float x)
+{
+    stageUniform(handle, 1, &x);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(int handle, float x, float y)
+{
+    float values[] = {x, y};
+    stageUniform(handle, 2, values);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(int handle, float x, float y, float z)
+{
+    float values[] = {x, y, z};
+    stageUniform(handle, 3, values);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(int handle, float x, float y, float z, float w)
+{
+    float values[] = {x, y, z, w};
+    stageUniform(handle, 4, values);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(int handle, const Vector2f& v)
+{
+    setUniform(handle, v.x, v.y);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(int handle, const Vector3f& v)
+{
+    setUniform(handle, v.x, v.y, v.z);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(int handle, const Color& color)
+{
+    setUniform(handle, color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(int handle, const sf::Transform& transform)
+{
+    stageUniform(handle, 16, transform.getMatrix());
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Shader::getNativeHandle() const
+{
+    return m_shaderProgram;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setAsynchronous(bool asynchronous)
+{
+    m_asynchronous = asynchronous;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isAsynchronous() const
+{
+    return m_asynchronous;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isReady()
+{
+    if (!m_build)
+        return true;
+
+    ensureGlContext();
+
+    bool success = false;
+    if (m_build->thread)
+    {
+        // Check whether the worker thread is done
+        {
+            Lock lock(m_build->mutex);
+            if (!m_build->finished)
+                return false;
+
+            success = m_build->success;
+        }
+
+        m_build->thread->wait();
+        delete m_build->thread;
+    }
+    else
+    {
+        // Ask the driver whether it is done, without waiting
+        GLint completed = GL_FALSE;
+        glCheck(GLEXT_glGetObjectParameteriv(m_build->program, GLEXT_GL_COMPLETION_STATUS, &completed));
+        if (completed == GL_FALSE)
+            return false;
+
+        success = finishBuild(m_build->program, m_build->shaders);
+        if (success && !m_build->entryPath.empty())
+            saveProgramBinary(m_build->program, m_build->entryPath, m_build->key);
+    }
+
+    if (success)
+        setProgram(castFromGlHandle(m_build->program));
+    else
+        glCheck(GLEXT_glDeleteObject(m_build->program));
+
+    delete m_build;
+    m_build = NULL;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::bind(const Shader* shader)
+{
+    ensureGlContext();
+
+    // Make sure that we can use shaders
+    if (!isAvailable())
+    {
+        err() << "Failed to bind or unbind shader: your system doesn't support shaders "
+              << "(you should test Shader::isAvailable() before trying to use the Shader class)" << std::endl;
+        return;
+    }
+
+    if (shader && shader->m_shaderProgram)
+    {
+        // Enable the program
+        glCheck(GLEXT_glUseProgramObject(castToGlHandle(shader->m_shaderProgram)));
+
+        // Send the parameters and bind the textures
+        shader->applyParameters();
+    }
+    else
+    {
+        // Bind no shader
+        glCheck(GLEXT_glUseProgramObject(0));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isAvailable()
+{
+    // TODO: Remove this lock when it becomes unnecessary in C++11
+    Lock lock(mutex);
+
+    static bool available = checkShadersAvailable();
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setBinaryCacheDirectory(const std::string& directory)
+{
+    Lock lock(mutex);
+
+    binaryCacheDirectory = directory;
+
+    // Remove the trailing separator, it is added back when building the entry paths
+    if ((binaryCacheDirectory.size() > 1) && ((binaryCacheDirectory[binaryCacheDirectory.size() - 1] == '/') || (binaryCacheDirectory[binaryCacheDirectory.size() - 1] == '\\')))
+        binaryCacheDirectory.erase(binaryCacheDirectory.size() - 1);
+}
+
+
+////////////////////////////////////////////////////////////
+std::string Shader::getBinaryCacheDirectory()
+{
+    Lock lock(mutex);
+
+    return binaryCacheDirectory;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::compile(const char* vertexShaderCode, const char* fragmentShaderCode)
+{
+    ensureGlContext();
+
+    // First make sure that we can use shaders
+    if (!isAvailable())
+    {
+        err() << "Failed to create a shader: your system doesn't support shaders "
+              << "(you should test Shader::isAvailable() before trying to use the Shader class)" << std::endl;
+        return false;
+    }
+
+    // Destroy the shader if it was already created, or is being created
+    cancelBuild();
     if (m_shaderProgram)
     {
         glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaderProgram)));
@@ -530,107 +1054,226 @@ bool Shader::compile(const char* vertexShaderCode, const char* fragmentShaderCod
 
     // Reset the internal state
     m_currentTexture = -1;
+    m_textureUnitsChanged = false;
     m_textures.clear();
+    m_textureArrays.clear();
+    m_uniformBuffers.clear();
     m_params.clear();
+    m_handles.clear();
+    m_uniforms.clear();
+    m_dirtyUniforms.clear();
+    std::fill(m_matrices, m_matrices + 3, -1);
 
     // Create the program
     GLEXT_GLhandle shaderProgram = glCheck(GLEXT_glCreateProgramObject());
 
-    // Create the vertex shader if needed
-    if (vertexShaderCode)
+    // Restore the program from the binary cache, or build it from the sources
+    std::string key;
+    std::string entryPath = getBinaryEntryPath(vertexShaderCode, fragmentShaderCode, key);
+    if (entryPath.empty() || !loadProgramBinary(shaderProgram, entryPath, key))
     {
-        // Create and compile the shader
-        GLEXT_GLhandle vertexShader = glCheck(GLEXT_glCreateShaderObject(GLEXT_GL_VERTEX_SHADER));
-        glCheck(GLEXT_glShaderSource(vertexShader, 1, &vertexShaderCode, NULL));
-        glCheck(GLEXT_glCompileShader(vertexShader));
+        if (m_asynchronous)
+        {
+            m_build = new priv::ShaderBuild;
+            m_build->program   = shaderProgram;
+            m_build->thread    = NULL;
+            m_build->entryPath = entryPath;
+            m_build->key       = key;
+            m_build->finished  = false;
+            m_build->success   = false;
+
+            if (GLEXT_parallel_shader_compile)
+            {
+                // Let the driver compile and link in the background
+#ifndef SFML_OPENGL_ES
+                glCheck(GLEXT_glMaxShaderCompilerThreads(0xFFFFFFFF));
+#endif
+                startBuild(shaderProgram, vertexShaderCode, fragmentShaderCode, !entryPath.empty(), m_build->shaders);
+            }
+            else
+            {
+                // Build the program on a worker thread, in a context that shares it
+                m_build->shaders[0]         = 0;
+                m_build->shaders[1]         = 0;
+                m_build->hasVertexShader    = vertexShaderCode != NULL;
+                m_build->hasFragmentShader  = fragmentShaderCode != NULL;
+                m_build->vertexShaderCode   = vertexShaderCode ? vertexShaderCode : "";
+                m_build->fragmentShaderCode = fragmentShaderCode ? fragmentShaderCode : "";
+
+                // Make sure that the program exists before the worker uses it
+                glCheck(glFlush());
+
+                m_build->thread = new Thread(&runShaderBuild, m_build);
+                m_build->thread->launch();
+            }
 
-        // Check the compile log
-        GLint success;
-        glCheck(GLEXT_glGetObjectParameteriv(vertexShader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
-        if (success == GL_FALSE)
+            return true;
+        }
+
+        if (!buildProgram(shaderProgram, vertexShaderCode, fragmentShaderCode, !entryPath.empty()))
         {
-            char log[1024];
-            glCheck(GLEXT_glGetInfoLog(vertexShader, sizeof(log), 0, log));
-            err() << "Failed to compile vertex shader:" << std::endl
-                  << log << std::endl;
-            glCheck(GLEXT_glDeleteObject(vertexShader));
             glCheck(GLEXT_glDeleteObject(shaderProgram));
             return false;
         }
 
-        // Attach the shader to the program, and delete it (not needed anymore)
-        glCheck(GLEXT_glAttachObject(shaderProgram, vertexShader));
-        glCheck(GLEXT_glDeleteObject(vertexShader));
+        if (!entryPath.empty())
+            saveProgramBinary(shaderProgram, entryPath, key);
     }
 
-    // Create the fragment shader if needed
-    if (fragmentShaderCode)
-    {
-        // Create and compile the shader
-        GLEXT_GLhandle fragmentShader = glCheck(GLEXT_glCreateShaderObject(GLEXT_GL_FRAGMENT_SHADER));
-        glCheck(GLEXT_glShaderSource(fragmentShader, 1, &fragmentShaderCode, NULL));
-        glCheck(GLEXT_glCompileShader(fragmentShader));
+    setProgram(castFromGlHandle(shaderProgram));
 
-        // Check the compile log
-        GLint success;
-        glCheck(GLEXT_glGetObjectParameteriv(fragmentShader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
-        if (success == GL_FALSE)
-        {
-            char log[1024];
-            glCheck(GLEXT_glGetInfoLog(fragmentShader, sizeof(log), 0, log));
-            err() << "Failed to compile fragment shader:" << std::endl
-                  << log << std::endl;
-            glCheck(GLEXT_glDeleteObject(fragmentShader));
-            glCheck(GLEXT_glDeleteObject(shaderProgram));
-            return false;
-        }
+    return true;
+}
 
-        // Attach the shader to the program, and delete it (not needed anymore)
-        glCheck(GLEXT_glAttachObject(shaderProgram, fragmentShader));
-        glCheck(GLEXT_glDeleteObject(fragmentShader));
-    }
 
-    // Link the program
-    glCheck(GLEXT_glLinkProgram(shaderProgram));
+////////////////////////////////////////////////////////////
+void Shader::setProgram(unsigned int program)
+{
+    m_shaderProgram = program;
 
-    // Check the link log
-    GLint success;
-    glCheck(GLEXT_glGetObjectParameteriv(shaderProgram, GLEXT_GL_OBJECT_LINK_STATUS, &success));
-    if (success == GL_FALSE)
+    // Look for the matrices provided by the core pipeline, most shaders don't use them
+    const char* const* matrixNames = priv::CorePipeline::getMatrixNames();
+    for (int i = 0; i < priv::CorePipeline::MatrixCount; ++i)
     {
-        char log[1024];
-        glCheck(GLEXT_glGetInfoLog(shaderProgram, sizeof(log), 0, log));
-        err() << "Failed to link shader:" << std::endl
-              << log << std::endl;
-        glCheck(GLEXT_glDeleteObject(shaderProgram));
-        return false;
+        m_matrices[i] = glCheck(GLEXT_glGetUniformLocation(castToGlHandle(program), matrixNames[i]));
     }
 
-    m_shaderProgram = castFromGlHandle(shaderProgram);
-
     // Force an OpenGL flush, so that the shader will appear updated
     // in all contexts immediately (solves problems in multi-threaded apps)
     glCheck(glFlush());
+}
 
-    return true;
+
+////////////////////////////////////////////////////////////
+void Shader::cancelBuild()
+{
+    if (!m_build)
+        return;
+
+    // The worker thread can't be interrupted, wait until it's done
+    if (m_build->thread)
+    {
+        m_build->thread->wait();
+        delete m_build->thread;
+    }
+
+    for (int i = 0; i < 2; ++i)
+    {
+        if (m_build->shaders[i])
+            glCheck(GLEXT_glDeleteObject(m_build->shaders[i]));
+    }
+
+    glCheck(GLEXT_glDeleteObject(m_build->program));
+
+    delete m_build;
+    m_build = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::applyParameters() const
+{
+    // Send the parameters that changed since the last bind
+    uploadUniforms();
+
+    // Assign the texture units to the sampler variables, they only
+    // change when a texture variable is added
+    if (m_textureUnitsChanged)
+    {
+        TextureTable::const_iterator it = m_textures.begin();
+        for (std::size_t i = 0; i < m_textures.size(); ++i)
+        {
+            glCheck(GLEXT_glUniform1i(it->first, static_cast<GLint>(i + 1)));
+            ++it;
+        }
+
+        // The texture arrays follow the 2D textures
+        TextureArrayTable::const_iterator array = m_textureArrays.begin();
+        for (std::size_t i = 0; i < m_textureArrays.size(); ++i)
+        {
+            glCheck(GLEXT_glUniform1i(array->first, static_cast<GLint>(m_textures.size() + i + 1)));
+            ++array;
+        }
+
+        // The current texture is always on unit 0
+        if (m_currentTexture != -1)
+            glCheck(GLEXT_glUniform1i(m_currentTexture, 0));
+
+        m_textureUnitsChanged = false;
+    }
+
+    // Bind the textures
+    bindTextures();
+
+#ifndef SFML_OPENGL_ES
+    // Bind the uniform buffers to the binding points of their blocks
+    for (UniformBufferTable::const_iterator it = m_uniformBuffers.begin(); it != m_uniformBuffers.end(); ++it)
+    {
+        glCheck(GLEXT_glBindBufferBase(GLEXT_GL_UNIFORM_BUFFER, it->first, it->second->getNativeHandle()));
+    }
+#endif
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::bindTextures() const
 {
+    Lock lock(boundTexturesMutex);
+
+    // Only the units whose texture changed since the last bind in this context are bound again;
+    // the texture matrix is left alone, it only applies to the current texture on unit 0
+    std::vector<Uint64>& boundUnits = boundTextures[Context::getActiveContextId()];
+    if (boundUnits.size() < m_textures.size() + 1)
+        boundUnits.resize(m_textures.size() + 1, 0);
+
+    bool unitChanged = false;
     TextureTable::const_iterator it = m_textures.begin();
     for (std::size_t i = 0; i < m_textures.size(); ++i)
     {
-        GLint index = static_cast<GLsizei>(i + 1);
-        glCheck(GLEXT_glUniform1i(it->first, index));
-        glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0 + index));
-        Texture::bind(it->second);
+        const Texture& texture = *it->second;
+        std::size_t unit = i + 1;
         ++it;
+
+        // Restore the texture if it was evicted
+        texture.use();
+
+        if (boundUnits[unit] == texture.m_cacheId)
+            continue;
+
+        glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0 + static_cast<GLenum>(unit)));
+        glCheck(glBindTexture(GL_TEXTURE_2D, texture.m_texture));
+        boundUnits[unit] = texture.m_cacheId;
+        unitChanged = true;
     }
 
+#ifndef SFML_OPENGL_ES
+    // Texture arrays are not tracked: binding one to a unit doesn't
+    // replace its 2D texture, so the cache above stays valid
+    TextureArrayTable::const_iterator array = m_textureArrays.begin();
+    for (std::size_t i = 0; i < m_textureArrays.size(); ++i)
+    {
+        std::size_t unit = m_textures.size() + i + 1;
+
+        glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0 + static_cast<GLenum>(unit)));
+        glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, array->second->getNativeHandle()));
+        unitChanged = true;
+        ++array;
+    }
+#endif
+
     // Make sure that the texture unit which is left active is the number 0
-    glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
+    if (unitChanged)
+        glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::invalidateTextureUnits()
+{
+    ensureGlContext();
+
+    Lock lock(boundTexturesMutex);
+    boundTextures.erase(Context::getActiveContextId());
 }
 
 
@@ -657,9 +1300,57 @@ int Shader::getParamLocation(const std::string& name)
     }
 }
 
+
+
+////////////////////////////////////////////////////////////
+void Shader::stageUniform(int handle, int size, const float* values)
+{
+    if ((handle < 0) || (handle >= static_cast<int>(m_uniforms.size())))
+        return;
+
+    Uniform& uniform = m_uniforms[handle];
+
+    // Skip the values that wouldn't change anything
+    if ((uniform.size == size) && std::equal(values, values + size, uniform.values))
+        return;
+
+    uniform.size = size;
+    std::copy(values, values + size, uniform.values);
+
+    if (!uniform.dirty)
+    {
+        uniform.dirty = true;
+        m_dirtyUniforms.push_back(handle);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::uploadUniforms() const
+{
+    for (std::vector<int>::const_iterator it = m_dirtyUniforms.begin(); it != m_dirtyUniforms.end(); ++it)
+    {
+        Uniform& uniform = m_uniforms[*it];
+
+        switch (uniform.size)
+        {
+            case 1:  glCheck(GLEXT_glUniform1f(uniform.location, uniform.values[0])); break;
+            case 2:  glCheck(GLEXT_glUniform2f(uniform.location, uniform.values[0], uniform.values[1])); break;
+            case 3:  glCheck(GLEXT_glUniform3f(uniform.location, uniform.values[0], uniform.values[1], uniform.values[2])); break;
+            case 4:  glCheck(GLEXT_glUniform4f(uniform.location, uniform.values[0], uniform.values[1], uniform.values[2], uniform.values[3])); break;
+            case 16: glCheck(GLEXT_glUniformMatrix4fv(uniform.location, 1, GL_FALSE, uniform.values)); break;
+            default: break;
+        }
+
+        uniform.dirty = false;
+    }
+
+    m_dirtyUniforms.clear();
+}
+
 } // namespace sf
 
-#else // SFML_OPENGL_ES
+#else // SFML_OPENGL_ES && !SFML_OPENGL_ES2
 
 // OpenGL ES 1 doesn't support GLSL shaders at all, we have to provide an empty implementation
 
@@ -672,8 +1363,11 @@ Shader::CurrentTextureType Shader::CurrentTexture;
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
 m_shaderProgram (0),
-m_currentTexture(-1)
+m_currentTexture(-1),
+m_asynchronous  (false),
+m_build         (NULL)
 {
+    std::fill(m_matrices, m_matrices + 3, -1);
 }
 
 
@@ -779,12 +1473,79 @@ void Shader::setParameter(const std::string& name, const Texture& texture)
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, const TextureArray& textures)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, const UniformBuffer& buffer)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setParameter(const std::string& name, CurrentTextureType)
 {
 }
 
 
+////////////////////////////////////////////////////////////
+int Shader::getUniformHandle(const std::string& name)
+{
+    return -1;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(int handle, float x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(int handle, float x, float y)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(int handle, float x, float y, float z)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(int handle, float x, float y, float z, float w)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(int handle, const Vector2f& vector)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(int handle, const Vector3f& vector)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(int handle, const Color& color)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(int handle, const sf::Transform& transform)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 unsigned int Shader::getNativeHandle() const
 {
@@ -792,6 +1553,27 @@ unsigned int Shader::getNativeHandle() const
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setAsynchronous(bool asynchronous)
+{
+    m_asynchronous = asynchronous;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isAsynchronous() const
+{
+    return m_asynchronous;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isReady()
+{
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::bind(const Shader* shader)
 {
@@ -805,6 +1587,19 @@ bool Shader::isAvailable()
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setBinaryCacheDirectory(const std::string&)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+std::string Shader::getBinaryCacheDirectory()
+{
+    return "";
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Shader::compile(const char* vertexShaderCode, const char* fragmentShaderCode)
 {
@@ -812,11 +1607,35 @@ bool Shader::compile(const char* vertexShaderCode, const char* fragmentShaderCod
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setProgram(unsigned int)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::cancelBuild()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::applyParameters() const
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::bindTextures() const
 {
 }
 
+
+////////////////////////////////////////////////////////////
+void Shader::invalidateTextureUnits()
+{
+}
+
 } // namespace sf
 
-#endif // SFML_OPENGL_ES
+#endif // SFML_OPENGL_ES && !SFML_OPENGL_ES2
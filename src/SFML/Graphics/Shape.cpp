@@ -131,7 +131,10 @@ const Color& Shape::getOutlineColor() const
 void Shape::setOutlineThickness(float thickness)
 {
     m_outlineThickness = thickness;
-    update(); // recompute everything because the whole shape must be offset
+
+    // The points didn't change: only move the outer outline vertices along their cached normals
+    if (!m_outlineNormals.empty())
+        updateOutline();
 }
 
 
@@ -166,7 +169,8 @@ m_outlineThickness(0),
 m_vertices        (TrianglesFan),
 m_outlineVertices (TrianglesStrip),
 m_insideBounds    (),
-m_bounds          ()
+m_bounds          (),
+m_outlineNormals  ()
 {
 }
 
@@ -180,6 +184,7 @@ void Shape::update()
     {
         m_vertices.resize(0);
         m_outlineVertices.resize(0);
+        m_outlineNormals.clear();
         return;
     }
 
@@ -205,7 +210,9 @@ void Shape::update()
     updateTexCoords();
 
     // Outline
+    updateOutlineNormals();
     updateOutline();
+    updateOutlineColors();
 }
 
 
@@ -214,6 +221,10 @@ void Shape::draw(RenderTarget& target, RenderStates states) const
 {
     states.transform *= getTransform();
 
+    // The bounds include the outline
+    if (target.cull(m_bounds, states.transform))
+        return;
+
     // Render the inside
     states.texture = m_texture;
     target.draw(m_vertices, states);
@@ -249,23 +260,23 @@ void Shape::updateTexCoords()
 
 
 ////////////////////////////////////////////////////////////
-void Shape::updateOutline()
+void Shape::updateOutlineNormals()
 {
     std::size_t count = m_vertices.getVertexCount() - 2;
-    m_outlineVertices.resize((count + 1) * 2);
+    m_outlineNormals.resize(count);
+
+    // Each segment normal is shared by its two points, start with the one closing the shape
+    Vector2f previous = computeNormal(m_vertices[count].position, m_vertices[1].position);
 
     for (std::size_t i = 0; i < count; ++i)
     {
         std::size_t index = i + 1;
 
-        // Get the two segments shared by the current point
-        Vector2f p0 = (i == 0) ? m_vertices[count].position : m_vertices[index - 1].position;
+        // Get the normals of the two segments shared by the current point
         Vector2f p1 = m_vertices[index].position;
-        Vector2f p2 = m_vertices[index + 1].position;
-
-        // Compute their normal
-        Vector2f n1 = computeNormal(p0, p1);
-        Vector2f n2 = computeNormal(p1, p2);
+        Vector2f n1 = previous;
+        Vector2f n2 = computeNormal(p1, m_vertices[index + 1].position);
+        previous = n2;
 
         // Make sure that the normals point towards the outside of the shape
         // (this depends on the order in which the points were defined)
@@ -276,20 +287,29 @@ void Shape::updateOutline()
 
         // Combine them to get the extrusion direction
         float factor = 1.f + (n1.x * n2.x + n1.y * n2.y);
-        Vector2f normal = (n1 + n2) / factor;
+        m_outlineNormals[i] = (n1 + n2) / factor;
+    }
+}
 
-        // Update the outline points
-        m_outlineVertices[i * 2 + 0].position = p1;
-        m_outlineVertices[i * 2 + 1].position = p1 + normal * m_outlineThickness;
+
+////////////////////////////////////////////////////////////
+void Shape::updateOutline()
+{
+    std::size_t count = m_outlineNormals.size();
+    m_outlineVertices.resize((count + 1) * 2);
+
+    // Update the outline points
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Vector2f point = m_vertices[i + 1].position;
+        m_outlineVertices[i * 2 + 0].position = point;
+        m_outlineVertices[i * 2 + 1].position = point + m_outlineNormals[i] * m_outlineThickness;
     }
 
     // Duplicate the first point at the end, to close the outline
     m_outlineVertices[count * 2 + 0].position = m_outlineVertices[0].position;
     m_outlineVertices[count * 2 + 1].position = m_outlineVertices[1].position;
 
-    // Update outline colors
-    updateOutlineColors();
-
     // Update the shape's bounds
     m_bounds = m_outlineVertices.getBounds();
 }
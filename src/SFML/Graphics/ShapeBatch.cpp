@@ -0,0 +1,362 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ShapeBatch.hpp>
+#include <SFML/Graphics/Shape.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ShapeBatch::ShapeBatch() :
+m_fillGeometry   (),
+m_outlineGeometry(),
+m_texture        (NULL),
+m_positions      (),
+m_rotations      (),
+m_scales         (),
+m_origins        (),
+m_fillColors     (),
+m_outlineColors  (),
+m_fillVertices   (),
+m_outlineVertices(),
+m_dirtyBegin     (0),
+m_dirtyEnd       (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ShapeBatch::ShapeBatch(const Shape& shape) :
+m_fillGeometry   (),
+m_outlineGeometry(),
+m_texture        (NULL),
+m_positions      (),
+m_rotations      (),
+m_scales         (),
+m_origins        (),
+m_fillColors     (),
+m_outlineColors  (),
+m_fillVertices   (),
+m_outlineVertices(),
+m_dirtyBegin     (0),
+m_dirtyEnd       (0)
+{
+    setShape(shape);
+}
+
+
+////////////////////////////////////////////////////////////
+void ShapeBatch::setShape(const Shape& shape)
+{
+    m_fillGeometry.clear();
+    m_outlineGeometry.clear();
+    m_texture = shape.m_texture;
+
+    // Convert the fan of the fill to independent triangles, so that the copies can be drawn together
+    const VertexArray& fill = shape.m_vertices;
+    for (std::size_t i = 2; i < fill.getVertexCount(); ++i)
+    {
+        m_fillGeometry.push_back(fill[0]);
+        m_fillGeometry.push_back(fill[i - 1]);
+        m_fillGeometry.push_back(fill[i]);
+    }
+
+    // Same for the strip of the outline
+    const VertexArray& outline = shape.m_outlineVertices;
+    if (shape.m_outlineThickness != 0)
+    {
+        for (std::size_t i = 2; i < outline.getVertexCount(); ++i)
+        {
+            m_outlineGeometry.push_back(outline[i - 2]);
+            m_outlineGeometry.push_back(outline[i - 1]);
+            m_outlineGeometry.push_back(outline[i]);
+        }
+    }
+
+    // All the copies must be generated again with the new geometry
+    m_fillVertices.clear();
+    m_outlineVertices.clear();
+    invalidate(0, m_positions.size());
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ShapeBatch::add()
+{
+    std::size_t index = m_positions.size();
+
+    m_positions.push_back(Vector2f(0.f, 0.f));
+    m_rotations.push_back(0.f);
+    m_scales.push_back(Vector2f(1.f, 1.f));
+    m_origins.push_back(Vector2f(0.f, 0.f));
+    m_fillColors.push_back(Color::White);
+    m_outlineColors.push_back(Color::White);
+
+    invalidate(index, index + 1);
+
+    return index;
+}
+
+
+////////////////////////////////////////////////////////////
+void ShapeBatch::remove(std::size_t index)
+{
+    m_positions.erase(m_positions.begin() + index);
+    m_rotations.erase(m_rotations.begin() + index);
+    m_scales.erase(m_scales.begin() + index);
+    m_origins.erase(m_origins.begin() + index);
+    m_fillColors.erase(m_fillColors.begin() + index);
+    m_outlineColors.erase(m_outlineColors.begin() + index);
+
+    // The vertices of the following copies remain valid, they just move
+    // down; copies added since the last draw don't have vertices yet
+    std::size_t fillSize = m_fillGeometry.size();
+    if ((index + 1) * fillSize <= m_fillVertices.size())
+        m_fillVertices.erase(m_fillVertices.begin() + index * fillSize, m_fillVertices.begin() + (index + 1) * fillSize);
+
+    std::size_t outlineSize = m_outlineGeometry.size();
+    if ((index + 1) * outlineSize <= m_outlineVertices.size())
+        m_outlineVertices.erase(m_outlineVertices.begin() + index * outlineSize, m_outlineVertices.begin() + (index + 1) * outlineSize);
+
+    // Shift the outdated range accordingly
+    if (m_dirtyBegin < m_dirtyEnd)
+    {
+        if (m_dirtyBegin > index)
+            --m_dirtyBegin;
+        if (m_dirtyEnd > index)
+            --m_dirtyEnd;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ShapeBatch::clear()
+{
+    m_positions.clear();
+    m_rotations.clear();
+    m_scales.clear();
+    m_origins.clear();
+    m_fillColors.clear();
+    m_outlineColors.clear();
+    m_fillVertices.clear();
+    m_outlineVertices.clear();
+
+    m_dirtyBegin = 0;
+    m_dirtyEnd = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ShapeBatch::getShapeCount() const
+{
+    return m_positions.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void ShapeBatch::setPosition(std::size_t index, const Vector2f& position)
+{
+    m_positions[index] = position;
+    invalidate(index, index + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void ShapeBatch::setRotation(std::size_t index, float angle)
+{
+    angle = static_cast<float>(std::fmod(angle, 360));
+    if (angle < 0)
+        angle += 360.f;
+
+    m_rotations[index] = angle;
+    invalidate(index, index + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void ShapeBatch::setScale(std::size_t index, const Vector2f& factors)
+{
+    m_scales[index] = factors;
+    invalidate(index, index + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void ShapeBatch::setOrigin(std::size_t index, const Vector2f& origin)
+{
+    m_origins[index] = origin;
+    invalidate(index, index + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void ShapeBatch::setFillColor(std::size_t index, const Color& color)
+{
+    m_fillColors[index] = color;
+    invalidate(index, index + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void ShapeBatch::setOutlineColor(std::size_t index, const Color& color)
+{
+    m_outlineColors[index] = color;
+    invalidate(index, index + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& ShapeBatch::getPosition(std::size_t index) const
+{
+    return m_positions[index];
+}
+
+
+////////////////////////////////////////////////////////////
+float ShapeBatch::getRotation(std::size_t index) const
+{
+    return m_rotations[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& ShapeBatch::getScale(std::size_t index) const
+{
+    return m_scales[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& ShapeBatch::getOrigin(std::size_t index) const
+{
+    return m_origins[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& ShapeBatch::getFillColor(std::size_t index) const
+{
+    return m_fillColors[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& ShapeBatch::getOutlineColor(std::size_t index) const
+{
+    return m_outlineColors[index];
+}
+
+
+////////////////////////////////////////////////////////////
+void ShapeBatch::draw(RenderTarget& target, RenderStates states) const
+{
+    update();
+
+    if (!m_fillVertices.empty())
+    {
+        states.texture = m_texture;
+        target.draw(&m_fillVertices[0], m_fillVertices.size(), Triangles, states);
+    }
+
+    if (!m_outlineVertices.empty())
+    {
+        states.texture = NULL;
+        target.draw(&m_outlineVertices[0], m_outlineVertices.size(), Triangles, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ShapeBatch::invalidate(std::size_t begin, std::size_t end)
+{
+    if (m_dirtyBegin < m_dirtyEnd)
+    {
+        m_dirtyBegin = std::min(m_dirtyBegin, begin);
+        m_dirtyEnd = std::max(m_dirtyEnd, end);
+    }
+    else
+    {
+        m_dirtyBegin = begin;
+        m_dirtyEnd = end;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ShapeBatch::update() const
+{
+    if (m_dirtyBegin >= m_dirtyEnd)
+        return;
+
+    std::size_t fillSize    = m_fillGeometry.size();
+    std::size_t outlineSize = m_outlineGeometry.size();
+    m_fillVertices.resize(m_positions.size() * fillSize);
+    m_outlineVertices.resize(m_positions.size() * outlineSize);
+
+    // Generate the outdated copies in a single pass over the arrays
+    for (std::size_t i = m_dirtyBegin; i < m_dirtyEnd; ++i)
+    {
+        // Same combination of the components as sf::Transformable
+        float angle  = -m_rotations[i] * 3.141592654f / 180.f;
+        float cosine = static_cast<float>(std::cos(angle));
+        float sine   = static_cast<float>(std::sin(angle));
+        float sxc    = m_scales[i].x * cosine;
+        float syc    = m_scales[i].y * cosine;
+        float sxs    = m_scales[i].x * sine;
+        float sys    = m_scales[i].y * sine;
+        float tx     = -m_origins[i].x * sxc - m_origins[i].y * sys + m_positions[i].x;
+        float ty     =  m_origins[i].x * sxs - m_origins[i].y * syc + m_positions[i].y;
+
+        Vertex* fill = fillSize ? &m_fillVertices[i * fillSize] : NULL;
+        for (std::size_t j = 0; j < fillSize; ++j)
+        {
+            const Vertex& source = m_fillGeometry[j];
+            fill[j].position.x = sxc * source.position.x + sys * source.position.y + tx;
+            fill[j].position.y = -sxs * source.position.x + syc * source.position.y + ty;
+            fill[j].color      = m_fillColors[i];
+            fill[j].texCoords  = source.texCoords;
+        }
+
+        Vertex* outline = outlineSize ? &m_outlineVertices[i * outlineSize] : NULL;
+        for (std::size_t j = 0; j < outlineSize; ++j)
+        {
+            const Vertex& source = m_outlineGeometry[j];
+            outline[j].position.x = sxc * source.position.x + sys * source.position.y + tx;
+            outline[j].position.y = -sxs * source.position.x + syc * source.position.y + ty;
+            outline[j].color      = m_outlineColors[i];
+        }
+    }
+
+    m_dirtyBegin = 0;
+    m_dirtyEnd = 0;
+}
+
+} // namespace sf
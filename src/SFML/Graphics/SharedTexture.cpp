@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SharedTexture.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct SharedTexture::Shared
+{
+    Shared() :
+    texture (),
+    useCount(1)
+    {
+    }
+
+    Texture      texture;  ///< Shared texture
+    unsigned int useCount; ///< Number of handles referring to the texture
+};
+
+
+////////////////////////////////////////////////////////////
+SharedTexture::SharedTexture() :
+m_shared(new Shared)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SharedTexture::SharedTexture(Texture& texture) :
+m_shared(new Shared)
+{
+    m_shared->texture.swap(texture);
+}
+
+
+////////////////////////////////////////////////////////////
+SharedTexture::SharedTexture(const SharedTexture& copy) :
+m_shared(copy.m_shared)
+{
+    ++m_shared->useCount;
+}
+
+
+////////////////////////////////////////////////////////////
+SharedTexture::~SharedTexture()
+{
+    release();
+}
+
+
+////////////////////////////////////////////////////////////
+SharedTexture& SharedTexture::operator =(const SharedTexture& right)
+{
+    // Take the new reference first, so that self-assignment is safe
+    ++right.m_shared->useCount;
+    release();
+    m_shared = right.m_shared;
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Texture& SharedTexture::get() const
+{
+    return m_shared->texture;
+}
+
+
+////////////////////////////////////////////////////////////
+Texture& SharedTexture::operator *() const
+{
+    return m_shared->texture;
+}
+
+
+////////////////////////////////////////////////////////////
+Texture* SharedTexture::operator ->() const
+{
+    return &m_shared->texture;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SharedTexture::getUseCount() const
+{
+    return m_shared->useCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SharedTexture::release()
+{
+    if (--m_shared->useCount == 0)
+        delete m_shared;
+}
+
+} // namespace sf
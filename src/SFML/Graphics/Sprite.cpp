@@ -139,6 +139,10 @@ void Sprite::draw(RenderTarget& target, RenderStates states) const
     if (m_texture)
     {
         states.transform *= getTransform();
+
+        if (target.cull(getLocalBounds(), states.transform))
+            return;
+
         states.texture = m_texture;
         target.draw(m_vertices, 4, TrianglesStrip, states);
     }
@@ -0,0 +1,328 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SpriteBatch.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch() :
+m_positions   (),
+m_rotations   (),
+m_scales      (),
+m_origins     (),
+m_textureRects(),
+m_colors      (),
+m_textures    (),
+m_vertices    (),
+m_dirtyBegin  (0),
+m_dirtyEnd    (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::add(const Texture& texture)
+{
+    return add(texture, IntRect(0, 0, texture.getSize().x, texture.getSize().y));
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::add(const Texture& texture, const IntRect& rectangle)
+{
+    std::size_t index = m_positions.size();
+
+    m_positions.push_back(Vector2f(0.f, 0.f));
+    m_rotations.push_back(0.f);
+    m_scales.push_back(Vector2f(1.f, 1.f));
+    m_origins.push_back(Vector2f(0.f, 0.f));
+    m_textureRects.push_back(rectangle);
+    m_colors.push_back(Color::White);
+    m_textures.push_back(&texture);
+
+    invalidate(index, index + 1);
+
+    return index;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::remove(std::size_t index)
+{
+    m_positions.erase(m_positions.begin() + index);
+    m_rotations.erase(m_rotations.begin() + index);
+    m_scales.erase(m_scales.begin() + index);
+    m_origins.erase(m_origins.begin() + index);
+    m_textureRects.erase(m_textureRects.begin() + index);
+    m_colors.erase(m_colors.begin() + index);
+    m_textures.erase(m_textures.begin() + index);
+
+    // The vertices of the following sprites remain valid, they just move
+    // down; sprites added since the last draw don't have vertices yet
+    if (index * 4 < m_vertices.size())
+        m_vertices.erase(m_vertices.begin() + index * 4, m_vertices.begin() + index * 4 + 4);
+
+    // Shift the outdated range accordingly
+    if (m_dirtyBegin < m_dirtyEnd)
+    {
+        if (m_dirtyBegin > index)
+            --m_dirtyBegin;
+        if (m_dirtyEnd > index)
+            --m_dirtyEnd;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::clear()
+{
+    m_positions.clear();
+    m_rotations.clear();
+    m_scales.clear();
+    m_origins.clear();
+    m_textureRects.clear();
+    m_colors.clear();
+    m_textures.clear();
+    m_vertices.clear();
+
+    m_dirtyBegin = 0;
+    m_dirtyEnd = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::getSpriteCount() const
+{
+    return m_positions.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setPosition(std::size_t index, const Vector2f& position)
+{
+    m_positions[index] = position;
+    invalidate(index, index + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setRotation(std::size_t index, float angle)
+{
+    angle = static_cast<float>(std::fmod(angle, 360));
+    if (angle < 0)
+        angle += 360.f;
+
+    m_rotations[index] = angle;
+    invalidate(index, index + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setScale(std::size_t index, const Vector2f& factors)
+{
+    m_scales[index] = factors;
+    invalidate(index, index + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setOrigin(std::size_t index, const Vector2f& origin)
+{
+    m_origins[index] = origin;
+    invalidate(index, index + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setTexture(std::size_t index, const Texture& texture)
+{
+    // The vertices don't depend on the texture, only the draw calls do
+    m_textures[index] = &texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setTextureRect(std::size_t index, const IntRect& rectangle)
+{
+    m_textureRects[index] = rectangle;
+    invalidate(index, index + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setColor(std::size_t index, const Color& color)
+{
+    m_colors[index] = color;
+    invalidate(index, index + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& SpriteBatch::getPosition(std::size_t index) const
+{
+    return m_positions[index];
+}
+
+
+////////////////////////////////////////////////////////////
+float SpriteBatch::getRotation(std::size_t index) const
+{
+    return m_rotations[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& SpriteBatch::getScale(std::size_t index) const
+{
+    return m_scales[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& SpriteBatch::getOrigin(std::size_t index) const
+{
+    return m_origins[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* SpriteBatch::getTexture(std::size_t index) const
+{
+    return m_textures[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const IntRect& SpriteBatch::getTextureRect(std::size_t index) const
+{
+    return m_textureRects[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& SpriteBatch::getColor(std::size_t index) const
+{
+    return m_colors[index];
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(RenderTarget& target, RenderStates states) const
+{
+    update();
+
+    // Draw each run of consecutive sprites that share a texture at once
+    std::size_t count = m_textures.size();
+    std::size_t first = 0;
+    while (first < count)
+    {
+        std::size_t last = first + 1;
+        while ((last < count) && (m_textures[last] == m_textures[first]))
+            ++last;
+
+        states.texture = m_textures[first];
+        target.draw(&m_vertices[first * 4], (last - first) * 4, Quads, states);
+
+        first = last;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::invalidate(std::size_t begin, std::size_t end)
+{
+    if (m_dirtyBegin < m_dirtyEnd)
+    {
+        m_dirtyBegin = std::min(m_dirtyBegin, begin);
+        m_dirtyEnd = std::max(m_dirtyEnd, end);
+    }
+    else
+    {
+        m_dirtyBegin = begin;
+        m_dirtyEnd = end;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::update() const
+{
+    if (m_dirtyBegin >= m_dirtyEnd)
+        return;
+
+    m_vertices.resize(m_positions.size() * 4);
+
+    // Generate the outdated sprites in a single pass over the arrays
+    for (std::size_t i = m_dirtyBegin; i < m_dirtyEnd; ++i)
+    {
+        // Same combination of the components as sf::Transformable
+        float angle  = -m_rotations[i] * 3.141592654f / 180.f;
+        float cosine = static_cast<float>(std::cos(angle));
+        float sine   = static_cast<float>(std::sin(angle));
+        float sxc    = m_scales[i].x * cosine;
+        float syc    = m_scales[i].y * cosine;
+        float sxs    = m_scales[i].x * sine;
+        float sys    = m_scales[i].y * sine;
+        float tx     = -m_origins[i].x * sxc - m_origins[i].y * sys + m_positions[i].x;
+        float ty     =  m_origins[i].x * sxs - m_origins[i].y * syc + m_positions[i].y;
+
+        // Transformed corners of the local rectangle (same geometry as sf::Sprite)
+        const IntRect& rect = m_textureRects[i];
+        float width  = static_cast<float>(std::abs(rect.width));
+        float height = static_cast<float>(std::abs(rect.height));
+
+        Vector2f topLeft(tx, ty);
+        Vector2f xAxis(sxc * width, -sxs * width);
+        Vector2f yAxis(sys * height, syc * height);
+
+        float left   = static_cast<float>(rect.left);
+        float right  = left + rect.width;
+        float top    = static_cast<float>(rect.top);
+        float bottom = top + rect.height;
+
+        const Color& color = m_colors[i];
+
+        // One quad per sprite, drawn as indexed triangles where quads are unsupported
+        Vertex* vertices = &m_vertices[i * 4];
+        vertices[0] = Vertex(topLeft,                 color, Vector2f(left, top));
+        vertices[1] = Vertex(topLeft + yAxis,         color, Vector2f(left, bottom));
+        vertices[2] = Vertex(topLeft + xAxis + yAxis, color, Vector2f(right, bottom));
+        vertices[3] = Vertex(topLeft + xAxis,         color, Vector2f(right, top));
+    }
+
+    m_dirtyBegin = 0;
+    m_dirtyEnd = 0;
+}
+
+} // namespace sf
@@ -28,7 +28,9 @@
 #include <SFML/Graphics/Text.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 
 namespace sf
@@ -40,9 +42,17 @@ m_font              (NULL),
 m_characterSize     (30),
 m_style             (Regular),
 m_color             (255, 255, 255),
+m_maxWidth          (0.f),
+m_alignment         (Left),
 m_vertices          (Triangles),
 m_bounds            (),
-m_geometryNeedUpdate(false)
+m_geometryNeedUpdate(false),
+m_fontRevision      (0),
+m_lines             (),
+m_characterPositions(),
+m_textureRanges     (),
+m_glyphVertexCount  (0),
+m_revision          (0)
 {
 
 }
@@ -55,9 +65,17 @@ m_font              (&font),
 m_characterSize     (characterSize),
 m_style             (Regular),
 m_color             (255, 255, 255),
+m_maxWidth          (0.f),
+m_alignment         (Left),
 m_vertices          (Triangles),
 m_bounds            (),
-m_geometryNeedUpdate(true)
+m_geometryNeedUpdate(true),
+m_fontRevision      (0),
+m_lines             (),
+m_characterPositions(),
+m_textureRanges     (),
+m_glyphVertexCount  (0),
+m_revision          (0)
 {
 
 }
@@ -68,12 +86,50 @@ void Text::setString(const String& string)
 {
     if (m_string != string)
     {
+        // If the new string only extends the current one, the existing geometry is kept
+        // and the new characters are laid out after it on the next update
+        bool extends = (string.getSize() > m_string.getSize()) &&
+                       std::equal(m_string.begin(), m_string.end(), string.begin());
+
         m_string = string;
-        m_geometryNeedUpdate = true;
+        if (!extends)
+            m_geometryNeedUpdate = true;
+
+        ++m_revision;
     }
 }
 
 
+////////////////////////////////////////////////////////////
+void Text::setString(const Utf8String& string)
+{
+    // Reading the characters in order is cheap, it avoids decoding the whole string for nothing
+    std::size_t size = string.getSize();
+    if (size == m_string.getSize())
+    {
+        std::size_t i = 0;
+        while ((i < size) && (string[i] == m_string[i]))
+            ++i;
+
+        if (i == size)
+            return;
+    }
+
+    setString(string.toString());
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::append(const String& string)
+{
+    // The geometry of the current characters remains valid, only the new ones will be laid out
+    m_string += string;
+
+    if (!string.isEmpty())
+        ++m_revision;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Text::setFont(const Font& font)
 {
@@ -81,6 +137,7 @@ void Text::setFont(const Font& font)
     {
         m_font = &font;
         m_geometryNeedUpdate = true;
+        ++m_revision;
     }
 }
 
@@ -92,6 +149,7 @@ void Text::setCharacterSize(unsigned int size)
     {
         m_characterSize = size;
         m_geometryNeedUpdate = true;
+        ++m_revision;
     }
 }
 
@@ -101,8 +159,18 @@ void Text::setStyle(Uint32 style)
 {
     if (m_style != style)
     {
+        // Underlined and strike through styles don't move the glyphs, only their lines are rebuilt
+        // (if geometry is updated anyway, we can skip this step)
+        Uint32 layoutStyles = Bold | Italic;
+        bool   layoutChange = ((m_style ^ style) & layoutStyles) != 0;
+
         m_style = style;
-        m_geometryNeedUpdate = true;
+        if (layoutChange)
+            m_geometryNeedUpdate = true;
+        else if (!m_geometryNeedUpdate)
+            updateDecorations();
+
+        ++m_revision;
     }
 }
 
@@ -121,6 +189,32 @@ void Text::setColor(const Color& color)
             for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
                 m_vertices[i].color = m_color;
         }
+
+        ++m_revision;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::setMaxWidth(float width)
+{
+    if (m_maxWidth != width)
+    {
+        m_maxWidth = width;
+        m_geometryNeedUpdate = true;
+        ++m_revision;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::setAlignment(Alignment alignment)
+{
+    if (m_alignment != alignment)
+    {
+        m_alignment = alignment;
+        m_geometryNeedUpdate = true;
+        ++m_revision;
     }
 }
 
@@ -160,6 +254,20 @@ const Color& Text::getColor() const
 }
 
 
+////////////////////////////////////////////////////////////
+float Text::getMaxWidth() const
+{
+    return m_maxWidth;
+}
+
+
+////////////////////////////////////////////////////////////
+Text::Alignment Text::getAlignment() const
+{
+    return m_alignment;
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2f Text::findCharacterPos(std::size_t index) const
 {
@@ -167,42 +275,35 @@ Vector2f Text::findCharacterPos(std::size_t index) const
     if (!m_font)
         return Vector2f();
 
+    // The positions of all the characters are computed with the geometry
+    ensureGeometryUpdate();
+    if (m_characterPositions.empty())
+        return Vector2f();
+
     // Adjust the index if it's out of range
     if (index > m_string.getSize())
         index = m_string.getSize();
 
-    // Precompute the variables needed by the algorithm
-    bool  bold   = (m_style & Bold) != 0;
-    float hspace = static_cast<float>(m_font->getGlyph(L' ', m_characterSize, bold).advance);
-    float vspace = static_cast<float>(m_font->getLineSpacing(m_characterSize));
+    // Transform the position to global coordinates
+    return getTransform().transformPoint(m_characterPositions[index]);
+}
 
-    // Compute the position
-    Vector2f position;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < index; ++i)
-    {
-        Uint32 curChar = m_string[i];
 
-        // Apply the kerning offset
-        position.x += static_cast<float>(m_font->getKerning(prevChar, curChar, m_characterSize));
-        prevChar = curChar;
+////////////////////////////////////////////////////////////
+std::size_t Text::getLineCount() const
+{
+    ensureGeometryUpdate();
 
-        // Handle special characters
-        switch (curChar)
-        {
-            case ' ':  position.x += hspace;                 continue;
-            case '\t': position.x += hspace * 4;             continue;
-            case '\n': position.y += vspace; position.x = 0; continue;
-        }
+    return m_lines.size();
+}
 
-        // For regular characters, add the advance offset of the glyph
-        position.x += static_cast<float>(m_font->getGlyph(curChar, m_characterSize, bold).advance);
-    }
 
-    // Transform the position to global coordinates
-    position = getTransform().transformPoint(position);
+////////////////////////////////////////////////////////////
+FloatRect Text::getLineBounds(std::size_t index) const
+{
+    ensureGeometryUpdate();
 
-    return position;
+    return index < m_lines.size() ? m_lines[index].bounds : FloatRect();
 }
 
 
@@ -230,182 +331,495 @@ void Text::draw(RenderTarget& target, RenderStates states) const
         ensureGeometryUpdate();
 
         states.transform *= getTransform();
-        states.texture = &m_font->getTexture(m_characterSize);
-        target.draw(m_vertices, states);
+
+        if (target.cull(m_bounds, states.transform))
+            return;
+
+        // Distance field glyphs need their shader, unless the user provides one
+        if (!states.shader)
+            states.shader = m_font->getDistanceFieldShader();
+
+        // Single row: no need to look for the visible part
+        if (m_lines.size() <= 1)
+        {
+            drawVertices(target, states, 0, m_vertices.getVertexCount());
+            return;
+        }
+
+        // Find the rows that are inside the view, the others are skipped
+        std::size_t first;
+        std::size_t last;
+        findVisibleLines(target.getView(), states.transform, first, last);
+        if (first >= last)
+            return;
+
+        // Everything is visible: draw the whole geometry at once
+        if ((first == 0) && (last == m_lines.size()))
+        {
+            drawVertices(target, states, 0, m_vertices.getVertexCount());
+            return;
+        }
+
+        // Draw the glyphs of the visible rows, they are contiguous in the vertex array
+        drawVertices(target, states, m_lines[first].firstVertex, m_lines[last - 1].firstVertex + m_lines[last - 1].vertexCount);
+
+        // Draw their underline and strike through lines, every row has the same number of them
+        std::size_t lineVertexCount = (m_vertices.getVertexCount() - m_glyphVertexCount) / m_lines.size();
+        if (lineVertexCount > 0)
+            drawVertices(target, states, m_glyphVertexCount + first * lineVertexCount, m_glyphVertexCount + last * lineVertexCount);
     }
 }
 
 
+////////////////////////////////////////////////////////////
+void Text::findVisibleLines(const View& view, const Transform& transform, std::size_t& first, std::size_t& last) const
+{
+    // Compute the area covered by the view, a rotated view is enlarged to its enclosing square
+    Vector2f size(std::fabs(view.getSize().x), std::fabs(view.getSize().y));
+    if (view.getRotation() != 0.f)
+    {
+        float diagonal = std::sqrt(size.x * size.x + size.y * size.y);
+        size = Vector2f(diagonal, diagonal);
+    }
+
+    // Bring it to the local coordinates of the text
+    FloatRect area = transform.getInverse().transformRect(FloatRect(view.getCenter() - size / 2.f, size));
+
+    // Rows are sorted vertically, keep the range that overlaps the area; the margin
+    // leaves room for the underline and strike through lines
+    float margin = static_cast<float>(m_characterSize);
+    first = m_lines.size();
+    last = 0;
+    for (std::size_t i = 0; i < m_lines.size(); ++i)
+    {
+        const Line& line = m_lines[i];
+        if (line.characterCount == 0)
+            continue;
+
+        if ((line.bounds.top - margin < area.top + area.height) && (line.bounds.top + line.bounds.height + margin > area.top))
+        {
+            first = std::min(first, i);
+            last = i + 1;
+        }
+    }
+
+    // No visible row
+    if (first > last)
+        first = last;
+}
+
+
+////////////////////////////////////////////////////////////
+struct Text::GeometryBuilder
+{
+    explicit GeometryBuilder(const Text* const* texts) :
+    m_texts(texts)
+    {
+    }
+
+    void operator ()(std::size_t index) const
+    {
+        m_texts[index]->layoutLines();
+        m_texts[index]->updateDecorations();
+    }
+
+    const Text* const* m_texts;
+};
+
+
+////////////////////////////////////////////////////////////
+void Text::updateGeometry(const Text* const* texts, std::size_t count, ThreadPool& pool)
+{
+    // Loading glyphs changes the caches and the textures of the fonts, so it's
+    // done here for all the texts; the layouts then only read the fonts
+    std::vector<const Text*> pending;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Text* text = texts[i];
+        if (text && text->beginGeometryUpdate())
+        {
+            text->m_font->prepareLayout(text->m_string, text->m_characterSize, (text->m_style & Bold) != 0);
+            pending.push_back(text);
+        }
+    }
+
+    if (!pending.empty())
+        pool.parallelFor(0, pending.size(), GeometryBuilder(&pending[0]));
+}
+
+
 ////////////////////////////////////////////////////////////
 void Text::ensureGeometryUpdate() const
 {
-    // Do nothing, if geometry has not changed
-    if (!m_geometryNeedUpdate)
+    if (!beginGeometryUpdate())
         return;
 
-    // Mark geometry as updated
-    m_geometryNeedUpdate = false;
+    // Lay out the characters that are not part of the geometry yet, then rebuild the lines
+    layoutLines();
+    updateDecorations();
+}
+
 
-    // Clear the previous geometry
-    m_vertices.clear();
-    m_bounds = FloatRect();
+////////////////////////////////////////////////////////////
+bool Text::beginGeometryUpdate() const
+{
+    // Upload the glyphs that the font loaded in the background, they must be part of the geometry
+    if (m_font)
+    {
+        m_font->collectGlyphs();
+        if (m_font->m_revision != m_fontRevision)
+            m_geometryNeedUpdate = true;
+    }
+
+    if (!m_geometryNeedUpdate)
+    {
+        // Do nothing, if geometry has not changed
+        std::size_t characterCount = m_characterPositions.empty() ? 0 : m_characterPositions.size() - 1;
+        if (characterCount == m_string.getSize())
+            return false;
+
+        // Appended characters can only change the last row, unless the
+        // rows are aligned on the widest one
+        if ((m_alignment != Left) && (m_maxWidth <= 0.f))
+            m_geometryNeedUpdate = true;
+    }
+
+    if (m_geometryNeedUpdate)
+    {
+        // Mark geometry as updated
+        m_geometryNeedUpdate = false;
+        m_fontRevision = m_font ? m_font->m_revision : 0;
+
+        // Clear the previous geometry
+        m_vertices.clear();
+        m_bounds = FloatRect();
+        m_lines.clear();
+        m_characterPositions.clear();
+        m_textureRanges.clear();
+        m_glyphVertexCount = 0;
+    }
 
     // No font: nothing to draw
-    if (!m_font)
-        return;
+    return m_font != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::layoutLines() const
+{
+    // Compute values related to the text style
+    bool  bold   = (m_style & Bold) != 0;
+    float italic = (m_style & Italic) ? 0.208f : 0.f; // 12 degrees
+
+    // Precompute the variables needed by the algorithm
+    float hspace = static_cast<float>(m_font->getGlyph(L' ', m_characterSize, bold).advance);
+    float vspace = static_cast<float>(m_font->getLineSpacing(m_characterSize));
+
+    // Resume from the start of the last row, the previous ones remain valid
+    std::size_t begin = 0;
+    if (!m_lines.empty())
+    {
+        begin = m_lines.back().firstCharacter;
+        m_vertices.resize(m_lines.back().firstVertex);
+        m_characterPositions.resize(begin);
+        m_lines.pop_back();
+    }
+    removeTextureRanges(m_vertices.getVertexCount());
+    std::size_t firstNewLine = m_lines.size();
+
+    // First pass: break the string into rows
+    for (;;)
+    {
+        Line line;
+        line.firstCharacter = begin;
+        line.width = 0.f;
+
+        // Find the end of the row: a line break, or the last whitespace before the maximum width
+        std::size_t end = begin;
+        std::size_t breakEnd = begin;
+        float breakWidth = 0.f;
+        float x = 0.f;
+        Uint32 prevChar = 0;
+        bool lineBreak = false;
+        bool wrapped = false;
+        for (; end < m_string.getSize(); ++end)
+        {
+            Uint32 curChar = m_string[end];
+            if (curChar == L'\n')
+            {
+                lineBreak = true;
+                break;
+            }
+
+            float advance = hspace * ((curChar == '\t') ? 4 : 1);
+            if ((curChar != ' ') && (curChar != '\t'))
+                advance = static_cast<float>(m_font->getGlyph(curChar, m_characterSize, bold).advance);
+
+            float kerning = static_cast<float>(m_font->getKerning(prevChar, curChar, m_characterSize));
+
+            if ((curChar == ' ') || (curChar == '\t'))
+            {
+                // Whitespace is a break opportunity and is allowed to overflow
+                breakEnd = end + 1;
+                breakWidth = x;
+            }
+            else if ((m_maxWidth > 0.f) && (end > begin) && (x + kerning + advance > m_maxWidth))
+            {
+                // Wrap after the last whitespace, or before this character if the word fills the whole row
+                if (breakEnd > begin)
+                {
+                    end = breakEnd;
+                    x = breakWidth;
+                }
+                wrapped = true;
+                break;
+            }
+
+            x += kerning + advance;
+            prevChar = curChar;
+        }
+
+        line.width = x;
+        line.characterCount = end - begin + (lineBreak ? 1 : 0);
+        m_lines.push_back(line);
+
+        // Stop at the end of the string; after a final line break there's still an empty row
+        if (!lineBreak && !wrapped)
+            break;
+        begin += line.characterCount;
+    }
+
+    // The alignment is relative to the maximum width, or to the widest row if there's none
+    float alignmentWidth = m_maxWidth;
+    if (alignmentWidth <= 0.f)
+    {
+        for (std::size_t i = 0; i < m_lines.size(); ++i)
+            alignmentWidth = std::max(alignmentWidth, m_lines[i].width);
+    }
+    float alignmentFactor = (m_alignment == Center) ? 0.5f : (m_alignment == Right) ? 1.f : 0.f;
+
+    // Second pass: create one quad for each character of the new rows
+    for (std::size_t i = firstNewLine; i < m_lines.size(); ++i)
+    {
+        Line& line = m_lines[i];
+        line.left = std::floor((alignmentWidth - line.width) * alignmentFactor + 0.5f);
+        line.firstVertex = m_vertices.getVertexCount();
+
+        float x = line.left;
+        float y = static_cast<float>(m_characterSize) + vspace * i;
+        float minX = std::numeric_limits<float>::max();
+        float minY = std::numeric_limits<float>::max();
+        float maxX = -std::numeric_limits<float>::max();
+        float maxY = -std::numeric_limits<float>::max();
+        Uint32 prevChar = 0;
+        for (std::size_t j = line.firstCharacter; j < line.firstCharacter + line.characterCount; ++j)
+        {
+            Uint32 curChar = m_string[j];
+
+            // Store the position of the character, for findCharacterPos
+            m_characterPositions.push_back(Vector2f(x, y - static_cast<float>(m_characterSize)));
+
+            // Apply the kerning offset
+            x += static_cast<float>(m_font->getKerning(prevChar, curChar, m_characterSize));
+            prevChar = curChar;
+
+            // Handle special characters
+            if ((curChar == ' ') || (curChar == '\t') || (curChar == '\n'))
+            {
+                // Update the current bounds (min coordinates)
+                minX = std::min(minX, x);
+                minY = std::min(minY, y);
+
+                switch (curChar)
+                {
+                    case ' ':  x += hspace;     break;
+                    case '\t': x += hspace * 4; break;
+                }
+
+                // Update the current bounds (max coordinates), a line break reaches the next row
+                maxX = std::max(maxX, (curChar == '\n') ? 0.f : x);
+                maxY = std::max(maxY, (curChar == '\n') ? y + vspace : y);
+
+                // Next glyph, no need to create a quad for whitespace
+                continue;
+            }
+
+            // Extract the current glyph's description
+            const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, bold);
+
+            float left   = glyph.bounds.left;
+            float top    = glyph.bounds.top;
+            float right  = glyph.bounds.left + glyph.bounds.width;
+            float bottom = glyph.bounds.top  + glyph.bounds.height;
+
+            float u1 = static_cast<float>(glyph.textureRect.left);
+            float v1 = static_cast<float>(glyph.textureRect.top);
+            float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width);
+            float v2 = static_cast<float>(glyph.textureRect.top  + glyph.textureRect.height);
+
+            // Start a new draw when the glyph is in another page of the texture atlas
+            addTextureRange(glyph.texture);
+
+            // Add a quad for the current character
+            m_vertices.append(Vertex(Vector2f(x + left  - italic * top,    y + top),    m_color, Vector2f(u1, v1)));
+            m_vertices.append(Vertex(Vector2f(x + right - italic * top,    y + top),    m_color, Vector2f(u2, v1)));
+            m_vertices.append(Vertex(Vector2f(x + left  - italic * bottom, y + bottom), m_color, Vector2f(u1, v2)));
+            m_vertices.append(Vertex(Vector2f(x + left  - italic * bottom, y + bottom), m_color, Vector2f(u1, v2)));
+            m_vertices.append(Vertex(Vector2f(x + right - italic * top,    y + top),    m_color, Vector2f(u2, v1)));
+            m_vertices.append(Vertex(Vector2f(x + right - italic * bottom, y + bottom), m_color, Vector2f(u2, v2)));
+
+            // Update the current bounds
+            minX = std::min(minX, x + left - italic * bottom);
+            maxX = std::max(maxX, x + right - italic * top);
+            minY = std::min(minY, y + top);
+            maxY = std::max(maxY, y + bottom);
+
+            // Advance to the next character
+            x += glyph.advance;
+        }
+
+        // The end of the last row is the position of the end of the string
+        if (i + 1 == m_lines.size())
+            m_characterPositions.push_back(Vector2f(x, y - static_cast<float>(m_characterSize)));
+
+        line.vertexCount = m_vertices.getVertexCount() - line.firstVertex;
+        if (line.characterCount > 0)
+            line.bounds = FloatRect(minX, minY, maxX - minX, maxY - minY);
+        else
+            line.bounds = FloatRect(x, y - static_cast<float>(m_characterSize), 0.f, 0.f);
+    }
+
+    m_glyphVertexCount = m_vertices.getVertexCount();
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::updateDecorations() const
+{
+    // Remove the previous lines, the glyphs are left untouched
+    m_vertices.resize(m_glyphVertexCount);
+    removeTextureRanges(m_glyphVertexCount);
 
     // No text: nothing to draw
-    if (m_string.isEmpty())
+    if (!m_font || m_string.isEmpty() || m_lines.empty())
+    {
+        m_bounds = FloatRect();
         return;
+    }
 
     // Compute values related to the text style
     bool  bold               = (m_style & Bold) != 0;
     bool  underlined         = (m_style & Underlined) != 0;
     bool  strikeThrough      = (m_style & StrikeThrough) != 0;
-    float italic             = (m_style & Italic) ? 0.208f : 0.f; // 12 degrees
     float underlineOffset    = m_font->getUnderlinePosition(m_characterSize);
     float underlineThickness = m_font->getUnderlineThickness(m_characterSize);
+    float vspace             = static_cast<float>(m_font->getLineSpacing(m_characterSize));
 
     // Compute the location of the strike through dynamically
     // We use the center point of the lowercase 'x' glyph as the reference
     // We reuse the underline thickness as the thickness of the strike through as well
-    FloatRect xBounds = m_font->getGlyph(L'x', m_characterSize, bold).bounds;
-    float strikeThroughOffset = xBounds.top + xBounds.height / 2.f;
+    float strikeThroughOffset = 0.f;
+    if (strikeThrough)
+    {
+        FloatRect xBounds = m_font->getGlyph(L'x', m_characterSize, bold).bounds;
+        strikeThroughOffset = xBounds.top + xBounds.height / 2.f;
+    }
 
-    // Precompute the variables needed by the algorithm
-    float hspace = static_cast<float>(m_font->getGlyph(L' ', m_characterSize, bold).advance);
-    float vspace = static_cast<float>(m_font->getLineSpacing(m_characterSize));
-    float x      = 0.f;
-    float y      = static_cast<float>(m_characterSize);
+    // Get the white pixel that the lines are textured with
+    Vector2f texCoords;
+    const Texture* texture = m_font->getLineTexture(texCoords);
+    if (underlined || strikeThrough)
+        addTextureRange(texture);
 
-    // Create one quad for each character
+    // Add the lines of every row, in the same order as the rows
     float minX = static_cast<float>(m_characterSize);
     float minY = static_cast<float>(m_characterSize);
     float maxX = 0.f;
     float maxY = 0.f;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < m_string.getSize(); ++i)
+    for (std::size_t i = 0; i < m_lines.size(); ++i)
     {
-        Uint32 curChar = m_string[i];
+        const Line& line = m_lines[i];
+        float y = static_cast<float>(m_characterSize) + vspace * i;
 
-        // Apply the kerning offset
-        x += static_cast<float>(m_font->getKerning(prevChar, curChar, m_characterSize));
-        prevChar = curChar;
+        // If we're using the underlined style, draw a line under the row
+        if (underlined)
+            addLine(line.left, line.width, y + underlineOffset, underlineThickness, texCoords);
 
-        // If we're using the underlined style and there's a new line, draw a line
-        if (underlined && (curChar == L'\n'))
-        {
-            float top = std::floor(y + underlineOffset - (underlineThickness / 2) + 0.5f);
-            float bottom = top + std::floor(underlineThickness + 0.5f);
-
-            m_vertices.append(Vertex(Vector2f(0, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, bottom), m_color, Vector2f(1, 1)));
-        }
+        // If we're using the strike through style, draw a line across all characters of the row
+        if (strikeThrough)
+            addLine(line.left, line.width, y + strikeThroughOffset, underlineThickness, texCoords);
 
-        // If we're using the strike through style and there's a new line, draw a line across all characters
-        if (strikeThrough && (curChar == L'\n'))
+        // Merge the bounds of the row
+        if (line.characterCount > 0)
         {
-            float top = std::floor(y + strikeThroughOffset - (underlineThickness / 2) + 0.5f);
-            float bottom = top + std::floor(underlineThickness + 0.5f);
-
-            m_vertices.append(Vertex(Vector2f(0, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, bottom), m_color, Vector2f(1, 1)));
+            minX = std::min(minX, line.bounds.left);
+            minY = std::min(minY, line.bounds.top);
+            maxX = std::max(maxX, line.bounds.left + line.bounds.width);
+            maxY = std::max(maxY, line.bounds.top + line.bounds.height);
         }
+    }
 
-        // Handle special characters
-        if ((curChar == ' ') || (curChar == '\t') || (curChar == '\n'))
-        {
-            // Update the current bounds (min coordinates)
-            minX = std::min(minX, x);
-            minY = std::min(minY, y);
-
-            switch (curChar)
-            {
-                case ' ':  x += hspace;        break;
-                case '\t': x += hspace * 4;    break;
-                case '\n': y += vspace; x = 0; break;
-            }
+    // Update the bounding rectangle
+    m_bounds.left = minX;
+    m_bounds.top = minY;
+    m_bounds.width = maxX - minX;
+    m_bounds.height = maxY - minY;
+}
 
-            // Update the current bounds (max coordinates)
-            maxX = std::max(maxX, x);
-            maxY = std::max(maxY, y);
 
-            // Next glyph, no need to create a quad for whitespace
-            continue;
-        }
+////////////////////////////////////////////////////////////
+void Text::addLine(float left, float width, float offset, float thickness, const Vector2f& texCoords) const
+{
+    float right = left + width;
+    float top = std::floor(offset - (thickness / 2) + 0.5f);
+    float bottom = top + std::floor(thickness + 0.5f);
+
+    m_vertices.append(Vertex(Vector2f(left, top),     m_color, texCoords));
+    m_vertices.append(Vertex(Vector2f(right, top),    m_color, texCoords));
+    m_vertices.append(Vertex(Vector2f(left, bottom),  m_color, texCoords));
+    m_vertices.append(Vertex(Vector2f(left, bottom),  m_color, texCoords));
+    m_vertices.append(Vertex(Vector2f(right, top),    m_color, texCoords));
+    m_vertices.append(Vertex(Vector2f(right, bottom), m_color, texCoords));
+}
 
-        // Extract the current glyph's description
-        const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, bold);
-
-        float left   = glyph.bounds.left;
-        float top    = glyph.bounds.top;
-        float right  = glyph.bounds.left + glyph.bounds.width;
-        float bottom = glyph.bounds.top  + glyph.bounds.height;
-
-        float u1 = static_cast<float>(glyph.textureRect.left);
-        float v1 = static_cast<float>(glyph.textureRect.top);
-        float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width);
-        float v2 = static_cast<float>(glyph.textureRect.top  + glyph.textureRect.height);
-
-        // Add a quad for the current character
-        m_vertices.append(Vertex(Vector2f(x + left  - italic * top,    y + top),    m_color, Vector2f(u1, v1)));
-        m_vertices.append(Vertex(Vector2f(x + right - italic * top,    y + top),    m_color, Vector2f(u2, v1)));
-        m_vertices.append(Vertex(Vector2f(x + left  - italic * bottom, y + bottom), m_color, Vector2f(u1, v2)));
-        m_vertices.append(Vertex(Vector2f(x + left  - italic * bottom, y + bottom), m_color, Vector2f(u1, v2)));
-        m_vertices.append(Vertex(Vector2f(x + right - italic * top,    y + top),    m_color, Vector2f(u2, v1)));
-        m_vertices.append(Vertex(Vector2f(x + right - italic * bottom, y + bottom), m_color, Vector2f(u2, v2)));
-
-        // Update the current bounds
-        minX = std::min(minX, x + left - italic * bottom);
-        maxX = std::max(maxX, x + right - italic * top);
-        minY = std::min(minY, y + top);
-        maxY = std::max(maxY, y + bottom);
-
-        // Advance to the next character
-        x += glyph.advance;
-    }
 
-    // If we're using the underlined style, add the last line
-    if (underlined)
+////////////////////////////////////////////////////////////
+void Text::addTextureRange(const Texture* texture) const
+{
+    if (m_textureRanges.empty() || (m_textureRanges.back().texture != texture))
     {
-        float top = std::floor(y + underlineOffset - (underlineThickness / 2) + 0.5f);
-        float bottom = top + std::floor(underlineThickness + 0.5f);
-
-        m_vertices.append(Vertex(Vector2f(0, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, bottom), m_color, Vector2f(1, 1)));
+        TextureRange range = {m_vertices.getVertexCount(), texture};
+        m_textureRanges.push_back(range);
     }
+}
 
-    // If we're using the strike through style, add the last line across all characters
-    if (strikeThrough)
+
+////////////////////////////////////////////////////////////
+void Text::removeTextureRanges(std::size_t vertexCount) const
+{
+    while (!m_textureRanges.empty() && (m_textureRanges.back().firstVertex >= vertexCount))
+        m_textureRanges.pop_back();
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::drawVertices(RenderTarget& target, RenderStates states, std::size_t begin, std::size_t end) const
+{
+    // Issue one draw per texture, the ranges are sorted by vertex
+    for (std::size_t i = 0; i < m_textureRanges.size(); ++i)
     {
-        float top = std::floor(y + strikeThroughOffset - (underlineThickness / 2) + 0.5f);
-        float bottom = top + std::floor(underlineThickness + 0.5f);
-
-        m_vertices.append(Vertex(Vector2f(0, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, bottom), m_color, Vector2f(1, 1)));
-    }
+        std::size_t rangeEnd = (i + 1 < m_textureRanges.size()) ? m_textureRanges[i + 1].firstVertex : m_vertices.getVertexCount();
+        std::size_t first    = std::max(begin, m_textureRanges[i].firstVertex);
+        std::size_t last     = std::min(end, rangeEnd);
+        if (first >= last)
+            continue;
 
-    // Update the bounding rectangle
-    m_bounds.left = minX;
-    m_bounds.top = minY;
-    m_bounds.width = maxX - minX;
-    m_bounds.height = maxY - minY;
+        // No texture means the texture of the character size in the font
+        const Texture* texture = m_textureRanges[i].texture;
+        states.texture = texture ? texture : &m_font->getTexture(m_characterSize);
+
+        target.draw(&m_vertices[first], last - first, Triangles, states);
+    }
 }
 
 } // namespace sf
@@ -0,0 +1,290 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextCache.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Fill the two triangles of a rectangle
+    void setQuad(sf::Vertex* vertices, const sf::IntRect& rect, const sf::IntRect& texRect)
+    {
+        float left      = static_cast<float>(rect.left);
+        float top       = static_cast<float>(rect.top);
+        float right     = static_cast<float>(rect.left + rect.width);
+        float bottom    = static_cast<float>(rect.top + rect.height);
+        float texLeft   = static_cast<float>(texRect.left);
+        float texTop    = static_cast<float>(texRect.top);
+        float texRight  = static_cast<float>(texRect.left + texRect.width);
+        float texBottom = static_cast<float>(texRect.top + texRect.height);
+
+        vertices[0].position = sf::Vector2f(left, top);     vertices[0].texCoords = sf::Vector2f(texLeft, texTop);
+        vertices[1].position = sf::Vector2f(right, top);    vertices[1].texCoords = sf::Vector2f(texRight, texTop);
+        vertices[2].position = sf::Vector2f(left, bottom);  vertices[2].texCoords = sf::Vector2f(texLeft, texBottom);
+        vertices[3].position = sf::Vector2f(left, bottom);  vertices[3].texCoords = sf::Vector2f(texLeft, texBottom);
+        vertices[4].position = sf::Vector2f(right, top);    vertices[4].texCoords = sf::Vector2f(texRight, texTop);
+        vertices[5].position = sf::Vector2f(right, bottom); vertices[5].texCoords = sf::Vector2f(texRight, texBottom);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextCache::TextCache(const Vector2u& pageSize) :
+m_pages    (),
+m_pageSize (pageSize),
+m_snapshots()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextCache::~TextCache()
+{
+    clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void TextCache::draw(RenderTarget& target, const Text& text, const RenderStates& states)
+{
+    if (!text.m_font)
+        return;
+
+    text.ensureGeometryUpdate();
+
+    RenderStates quadStates(states);
+    quadStates.transform *= text.getTransform();
+
+    if (target.cull(text.m_bounds, quadStates.transform))
+        return;
+
+    const Snapshot* snapshot = getSnapshot(target, text);
+    if (!snapshot)
+    {
+        target.draw(text, states);
+        return;
+    }
+
+    Vertex vertices[6];
+    setQuad(vertices, snapshot->bounds, IntRect(snapshot->region.left, snapshot->region.top, snapshot->bounds.width, snapshot->bounds.height));
+
+    // The snapshots hold colors multiplied by their alpha, they must not be multiplied again
+    if (quadStates.blendMode == BlendAlpha)
+        quadStates.blendMode = BlendMode(BlendMode::One, BlendMode::OneMinusSrcAlpha);
+
+    // Independent triangles, so that the quads of consecutive texts can be batched
+    quadStates.texture = &m_pages[snapshot->page]->texture.getTexture();
+    target.draw(vertices, 6, Triangles, quadStates);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextCache::remove(const Text& text)
+{
+    m_snapshots.erase(&text);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextCache::clear()
+{
+    for (std::vector<Page*>::iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+        delete *it;
+
+    m_pages.clear();
+    m_snapshots.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextCache::getSnapshotCount() const
+{
+    return m_snapshots.size();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextCache::getPageCount() const
+{
+    return static_cast<unsigned int>(m_pages.size());
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& TextCache::getTexture(unsigned int page) const
+{
+    return m_pages[page]->texture.getTexture();
+}
+
+
+////////////////////////////////////////////////////////////
+const TextCache::Snapshot* TextCache::getSnapshot(RenderTarget& target, const Text& text)
+{
+    SnapshotTable::iterator it = m_snapshots.find(&text);
+    if ((it != m_snapshots.end()) && (it->second.revision == text.m_revision) && (it->second.fontRevision == text.m_fontRevision))
+        return &it->second;
+
+    // Pixels covered by the text, rounded outwards
+    const FloatRect& textBounds = text.m_bounds;
+    int left   = static_cast<int>(std::floor(textBounds.left));
+    int top    = static_cast<int>(std::floor(textBounds.top));
+    int right  = static_cast<int>(std::ceil(textBounds.left + textBounds.width));
+    int bottom = static_cast<int>(std::ceil(textBounds.top + textBounds.height));
+    IntRect bounds(left, top, right - left, bottom - top);
+
+    if ((bounds.width <= 0) || (bounds.height <= 0))
+    {
+        if (it != m_snapshots.end())
+            m_snapshots.erase(it);
+        return NULL;
+    }
+
+    if (it == m_snapshots.end())
+    {
+        Snapshot snapshot;
+        snapshot.page         = 0;
+        snapshot.region       = IntRect();
+        snapshot.bounds       = IntRect();
+        snapshot.revision     = 0;
+        snapshot.fontRevision = 0;
+        it = m_snapshots.insert(std::make_pair(&text, snapshot)).first;
+    }
+
+    // Keep the region of the previous snapshot if the new one fits in it
+    Snapshot& snapshot = it->second;
+    if ((bounds.width > snapshot.region.width) || (bounds.height > snapshot.region.height))
+    {
+        if (!allocate(bounds.width, bounds.height, snapshot.page, snapshot.region))
+        {
+            m_snapshots.erase(it);
+            return NULL;
+        }
+    }
+
+    // Draws pending in the target may use the page that is about to change
+    target.flushBatch();
+
+    RenderTexture& texture = m_pages[snapshot.page]->texture;
+
+    // Erase the previous snapshot
+    Vertex eraser[6];
+    setQuad(eraser, snapshot.region, snapshot.region);
+    for (std::size_t i = 0; i < 6; ++i)
+        eraser[i].color = Color::Transparent;
+    texture.draw(eraser, 6, Triangles, RenderStates(BlendNone));
+
+    // Render the glyphs without the transform of the text, in the top-left corner of the region
+    RenderStates states;
+    states.transform.translate(static_cast<float>(snapshot.region.left - bounds.left), static_cast<float>(snapshot.region.top - bounds.top));
+    states.shader = text.m_font->getDistanceFieldShader();
+    text.drawVertices(texture, states, 0, text.m_vertices.getVertexCount());
+    texture.display();
+
+    snapshot.bounds       = bounds;
+    snapshot.revision     = text.m_revision;
+    snapshot.fontRevision = text.m_fontRevision;
+
+    return &snapshot;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextCache::allocate(unsigned int width, unsigned int height, unsigned int& page, IntRect& region)
+{
+    // One pixel of padding keeps the filtering from bleeding the neighbours into the snapshot
+    width  += 1;
+    height += 1;
+
+    // Try the existing pages first, the most recent ones are the least filled
+    for (std::size_t i = m_pages.size(); i > 0; --i)
+    {
+        if (allocate(*m_pages[i - 1], width, height, region))
+        {
+            page = static_cast<unsigned int>(i - 1);
+            return true;
+        }
+    }
+
+    // Make sure that the pages can be created on this graphics card
+    unsigned int maxSize = Texture::getMaximumSize();
+    m_pageSize.x = std::min(m_pageSize.x, maxSize);
+    m_pageSize.y = std::min(m_pageSize.y, maxSize);
+
+    // Texts bigger than a page are drawn directly
+    if ((width > m_pageSize.x) || (height > m_pageSize.y))
+        return false;
+
+    Page* newPage = new Page;
+    if (!newPage->texture.create(m_pageSize.x, m_pageSize.y))
+    {
+        delete newPage;
+        return false;
+    }
+    newPage->texture.clear(Color::Transparent);
+
+    m_pages.push_back(newPage);
+    page = static_cast<unsigned int>(m_pages.size() - 1);
+
+    return allocate(*newPage, width, height, region);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextCache::allocate(Page& page, unsigned int width, unsigned int height, IntRect& region)
+{
+    // Use the lowest shelf that has room for the area
+    Shelf* shelf = NULL;
+    for (std::vector<Shelf>::iterator it = page.shelves.begin(); it != page.shelves.end(); ++it)
+    {
+        if ((it->height >= height) && (it->width + width <= m_pageSize.x) && (!shelf || (it->height < shelf->height)))
+            shelf = &*it;
+    }
+
+    // A shelf much taller than the area would waste its space, open a new one if it fits
+    unsigned int bottom = page.shelves.empty() ? 0 : page.shelves.back().top + page.shelves.back().height;
+    if ((!shelf || (shelf->height > height * 2)) && (bottom + height <= m_pageSize.y))
+    {
+        page.shelves.push_back(Shelf(bottom, height));
+        shelf = &page.shelves.back();
+    }
+
+    if (!shelf)
+        return false;
+
+    region = IntRect(shelf->width, shelf->top, width - 1, height - 1);
+    shelf->width += width;
+
+    return true;
+}
+
+} // namespace sf
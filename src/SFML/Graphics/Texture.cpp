@@ -27,15 +27,23 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/ImageView.hpp>
+#include <SFML/Graphics/CompressedImageLoader.hpp>
+#include <SFML/Graphics/TextureManager.hpp>
+#include <SFML/Graphics/TextureUpload.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/Graphics/TextureSaver.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/Window.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
+#include <SFML/System/Profiler.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <map>
 
 
 namespace
@@ -65,6 +73,184 @@ namespace
 
         return static_cast<unsigned int>(size);
     }
+
+    // Texture matrix loaded in a context; Texture::bind only
+    // ever sets a scale and a vertical offset
+    struct TextureMatrix
+    {
+        bool  known;
+        float scaleX;
+        float scaleY;
+        float offsetY;
+    };
+
+    // The texture matrix is a state of each context, so is its cached value
+    typedef std::map<sf::Uint64, TextureMatrix> TextureMatrixTable;
+    TextureMatrixTable textureMatrices;
+    sf::Mutex textureMatricesMutex;
+
+    // Load the texture matrix of the active context, unless it already has the requested value
+    void loadTextureMatrix(float scaleX, float scaleY, float offsetY)
+    {
+        sf::Lock lock(textureMatricesMutex);
+
+        TextureMatrix& current = textureMatrices[sf::Context::getActiveContextId()];
+        if (current.known && (current.scaleX == scaleX) && (current.scaleY == scaleY) && (current.offsetY == offsetY))
+            return;
+
+        GLfloat matrix[16] = {scaleX, 0.f,     0.f, 0.f,
+                              0.f,    scaleY,  0.f, 0.f,
+                              0.f,    0.f,     1.f, 0.f,
+                              0.f,    offsetY, 0.f, 1.f};
+
+        // Load the matrix, OpenGL ES 2 has no fixed-function pipeline to load it to
+        #ifndef SFML_OPENGL_ES2
+            glCheck(glMatrixMode(GL_TEXTURE));
+            glCheck(glLoadMatrixf(matrix));
+
+            // Go back to model-view mode (sf::RenderTarget relies on it)
+            glCheck(glMatrixMode(GL_MODELVIEW));
+        #endif
+
+        current.known   = true;
+        current.scaleX  = scaleX;
+        current.scaleY  = scaleY;
+        current.offsetY = offsetY;
+    }
+
+    // Get the OpenGL internal format corresponding to a compression format
+    GLenum compressedFormatToGlEnum(sf::Texture::CompressedFormat format)
+    {
+        switch (format)
+        {
+            case sf::Texture::Dxt1:     return GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT1;
+            case sf::Texture::Dxt3:     return GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT3;
+            case sf::Texture::Dxt5:     return GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT5;
+            case sf::Texture::Etc2Rgb:  return GLEXT_GL_COMPRESSED_RGB8_ETC2;
+            case sf::Texture::Etc2Rgba: return GLEXT_GL_COMPRESSED_RGBA8_ETC2_EAC;
+            case sf::Texture::Astc4x4:  return GLEXT_GL_COMPRESSED_RGBA_ASTC_4x4;
+            case sf::Texture::Astc6x6:  return GLEXT_GL_COMPRESSED_RGBA_ASTC_6x6;
+            default:                    return GLEXT_GL_COMPRESSED_RGBA_ASTC_8x8;
+        }
+    }
+
+    // Get the size of a pixel in video memory
+    unsigned int bytesPerPixel(sf::Texture::Format format)
+    {
+        switch (format)
+        {
+            case sf::Texture::R8:      return 1;
+            case sf::Texture::Rgba16f: return 8;
+            case sf::Texture::Rgba32f: return 16;
+            default:                   return 4;
+        }
+    }
+
+    // Get the OpenGL internal format corresponding to a pixel format
+    GLint formatToGlEnum(sf::Texture::Format format)
+    {
+#ifndef SFML_OPENGL_ES
+
+        switch (format)
+        {
+            case sf::Texture::R8:      return GLEXT_GL_R8;
+            case sf::Texture::Rgba16f: return GLEXT_GL_RGBA16F;
+            case sf::Texture::Rgba32f: return GLEXT_GL_RGBA32F;
+            default:                   return GL_RGBA8;
+        }
+
+#else
+
+        // OpenGL ES requires the internal format to match the format of the pixels
+        return GL_RGBA;
+
+#endif
+    }
+
+    // Level of support of non power of two texture sizes
+    enum NpotSupport
+    {
+        NoNpot,      // Sizes must be powers of two
+        LimitedNpot, // Any size, but only without repeat and mipmaps
+        FullNpot     // Any size, without restriction
+    };
+
+    // Check how well the graphics card supports non power of two sizes
+    NpotSupport checkNpotSupport()
+    {
+        // Create a temporary context in case the user queries
+        // the support before a GlResource is created, thus
+        // initializing the shared context
+        sf::Context context;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        if (GLEXT_texture_non_power_of_two)
+            return FullNpot;
+
+#ifdef SFML_OPENGL_ES
+
+        // The OpenGL ES headers can't tell what the context supports, ask it
+        const char* version    = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+        const char* extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+
+        if (extensions && (std::strstr(extensions, "GL_OES_texture_npot") || std::strstr(extensions, "GL_ARB_texture_non_power_of_two")))
+            return FullNpot;
+
+        // OpenGL ES 3 supports any size, OpenGL ES 2 requires the clamp wrap mode and no mipmap
+        if (version && (std::strncmp(version, "OpenGL ES ", 10) == 0) && (version[10] >= '2') && (version[10] <= '9'))
+            return (version[10] >= '3') ? FullNpot : LimitedNpot;
+
+        if (extensions && std::strstr(extensions, "GL_APPLE_texture_2D_limited_npot"))
+            return LimitedNpot;
+
+#endif
+
+        return NoNpot;
+    }
+
+    // Build the mask of the compression formats supported by the graphics card
+    sf::Uint32 checkCompressedFormats()
+    {
+        // Create a temporary context in case the user queries
+        // the formats before a GlResource is created, thus
+        // initializing the shared context
+        sf::Context context;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        if (!GLEXT_texture_compression)
+            return 0;
+
+        // The formats that the context reports
+        GLint count = 0;
+        glCheck(glGetIntegerv(GLEXT_GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count));
+        std::vector<GLint> formats(count > 0 ? count : 1, 0);
+        if (count > 0)
+        {
+            glCheck(glGetIntegerv(GLEXT_GL_COMPRESSED_TEXTURE_FORMATS, &formats[0]));
+        }
+
+        sf::Uint32 mask = 0;
+        for (int i = sf::Texture::Dxt1; i <= sf::Texture::Astc8x8; ++i)
+        {
+            sf::Texture::CompressedFormat format = static_cast<sf::Texture::CompressedFormat>(i);
+            if (std::find(formats.begin(), formats.end(), static_cast<GLint>(compressedFormatToGlEnum(format))) != formats.end())
+                mask |= 1 << i;
+        }
+
+        // Some drivers don't list all the formats of their extensions
+        if (GLEXT_texture_compression_s3tc)
+            mask |= (1 << sf::Texture::Dxt1) | (1 << sf::Texture::Dxt3) | (1 << sf::Texture::Dxt5);
+        if (GLEXT_ES3_compatibility)
+            mask |= (1 << sf::Texture::Etc2Rgb) | (1 << sf::Texture::Etc2Rgba);
+        if (GLEXT_texture_compression_astc_ldr)
+            mask |= (1 << sf::Texture::Astc4x4) | (1 << sf::Texture::Astc6x6) | (1 << sf::Texture::Astc8x8);
+
+        return mask;
+    }
 }
 
 
@@ -75,10 +261,15 @@ Texture::Texture() :
 m_size         (0, 0),
 m_actualSize   (0, 0),
 m_texture      (0),
+m_format       (Rgba8),
 m_isSmooth     (false),
 m_isRepeated   (false),
+m_hasMipmap    (false),
+m_premultiplied(false),
 m_pixelsFlipped(false),
-m_cacheId      (getUniqueId())
+m_cacheId      (getUniqueId()),
+m_manager      (NULL),
+m_gpuMemory    (GpuMemory::Textures)
 {
 }
 
@@ -88,19 +279,35 @@ Texture::Texture(const Texture& copy) :
 m_size         (0, 0),
 m_actualSize   (0, 0),
 m_texture      (0),
+m_format       (Rgba8),
 m_isSmooth     (copy.m_isSmooth),
 m_isRepeated   (copy.m_isRepeated),
+m_hasMipmap    (false),
+m_premultiplied(false),
 m_pixelsFlipped(false),
-m_cacheId      (getUniqueId())
+m_cacheId      (getUniqueId()),
+m_manager      (NULL),
+m_gpuMemory    (GpuMemory::Textures)
 {
-    if (copy.m_texture)
-        loadFromImage(copy.copyToImage());
+    if (copy.m_texture && create(copy.m_size.x, copy.m_size.y, copy.m_format))
+    {
+        update(copy.copyToImage());
+        m_premultiplied = copy.m_premultiplied;
+
+        // Force an OpenGL flush, so that the texture will appear updated
+        // in all contexts immediately (solves problems in multi-threaded apps)
+        glCheck(glFlush());
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 Texture::~Texture()
 {
+    // Make sure that the manager doesn't keep a dangling pointer
+    if (m_manager)
+        m_manager->remove(*this);
+
     // Destroy the OpenGL texture
     if (m_texture)
     {
@@ -113,7 +320,7 @@ Texture::~Texture()
 
 
 ////////////////////////////////////////////////////////////
-bool Texture::create(unsigned int width, unsigned int height)
+bool Texture::create(unsigned int width, unsigned int height, Format format)
 {
     // Check if texture parameters are valid before creating it
     if ((width == 0) || (height == 0))
@@ -122,8 +329,14 @@ bool Texture::create(unsigned int width, unsigned int height)
         return false;
     }
 
+    if (!isFormatSupported(format))
+    {
+        err() << "Failed to create texture, its format is not supported by the graphics card" << std::endl;
+        return false;
+    }
+
     // Compute the internal texture dimensions depending on NPOT textures support
-    Vector2u actualSize(getValidSize(width), getValidSize(height));
+    Vector2u actualSize(getValidSize(width, m_isRepeated), getValidSize(height, m_isRepeated));
 
     // Check the maximum texture size
     unsigned int maxSize = getMaximumSize();
@@ -140,7 +353,10 @@ bool Texture::create(unsigned int width, unsigned int height)
     m_size.x        = width;
     m_size.y        = height;
     m_actualSize    = actualSize;
+    m_format        = format;
     m_pixelsFlipped = false;
+    m_hasMipmap     = false;
+    m_premultiplied = false;
 
     ensureGlContext();
 
@@ -174,13 +390,143 @@ bool Texture::create(unsigned int width, unsigned int height)
 
     // Initialize the texture
     glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-    glCheck(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_actualSize.x, m_actualSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    glCheck(glTexImage2D(GL_TEXTURE_2D, 0, formatToGlEnum(m_format), m_actualSize.x, m_actualSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_isRepeated ? GL_REPEAT : (GLEXT_texture_edge_clamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_isRepeated ? GL_REPEAT : (GLEXT_texture_edge_clamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
     m_cacheId = getUniqueId();
 
+    // The padding of the internal size takes memory too
+    m_gpuMemory.setBytes(static_cast<Uint64>(m_actualSize.x) * m_actualSize.y * bytesPerPixel(m_format));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::resize(unsigned int width, unsigned int height, const Color& fill)
+{
+    // Easy case: nothing to preserve
+    if (!m_texture)
+        return create(width, height);
+
+    if ((width == m_size.x) && (height == m_size.y))
+        return true;
+
+    // Check if texture parameters are valid before resizing it
+    if ((width == 0) || (height == 0))
+    {
+        err() << "Failed to resize texture, invalid size (" << width << "x" << height << ")" << std::endl;
+        return false;
+    }
+
+    // Compute the internal texture dimensions depending on NPOT textures support
+    Vector2u actualSize(getValidSize(width, m_isRepeated), getValidSize(height, m_isRepeated));
+
+    // Check the maximum texture size
+    unsigned int maxSize = getMaximumSize();
+    if ((actualSize.x > maxSize) || (actualSize.y > maxSize))
+    {
+        err() << "Failed to resize texture, its internal size is too high "
+              << "(" << actualSize.x << "x" << actualSize.y << ", "
+              << "maximum is " << maxSize << "x" << maxSize << ")"
+              << std::endl;
+        return false;
+    }
+
+    ensureGlContext();
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    unsigned int copyWidth  = std::min(width, m_size.x);
+    unsigned int copyHeight = std::min(height, m_size.y);
+
+    // Create the new texture, filled with the requested color
+    std::vector<Uint8> pixels(actualSize.x * actualSize.y * 4);
+    for (std::size_t i = 0; i < pixels.size(); i += 4)
+    {
+        pixels[i + 0] = fill.r;
+        pixels[i + 1] = fill.g;
+        pixels[i + 2] = fill.b;
+        pixels[i + 3] = fill.a;
+    }
+
+    GLuint texture;
+    glCheck(glGenTextures(1, &texture));
+    glCheck(glBindTexture(GL_TEXTURE_2D, texture));
+    glCheck(glTexImage2D(GL_TEXTURE_2D, 0, formatToGlEnum(m_format), actualSize.x, actualSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_isRepeated ? GL_REPEAT : (GLEXT_texture_edge_clamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_isRepeated ? GL_REPEAT : (GLEXT_texture_edge_clamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+
+    // Copy the old pixels on the graphics card: attach the old texture to a
+    // framebuffer and read it into the new one. Flipped textures go through
+    // the slow path, which puts their rows back in the regular order
+    bool copied = false;
+    if (GLEXT_framebuffer_object && !m_pixelsFlipped)
+    {
+        GLint previousFrameBuffer;
+        glCheck(glGetIntegerv(GLEXT_GL_FRAMEBUFFER_BINDING, &previousFrameBuffer));
+
+        GLuint frameBuffer = 0;
+        glCheck(GLEXT_glGenFramebuffers(1, &frameBuffer));
+        if (frameBuffer)
+        {
+            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, frameBuffer));
+            glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_texture, 0));
+
+            GLenum status;
+            glCheck(status = GLEXT_glCheckFramebufferStatus(GLEXT_GL_FRAMEBUFFER));
+            if (status == GLEXT_GL_FRAMEBUFFER_COMPLETE)
+            {
+                glCheck(glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, copyWidth, copyHeight));
+                copied = true;
+            }
+
+            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, previousFrameBuffer));
+            glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
+        }
+    }
+
+    if (!copied)
+    {
+        // Fallback: read the pixels back and upload them to the new texture
+        Image image = copyToImage();
+        if (copyWidth < m_size.x)
+        {
+            // The rows must be contiguous, crop them
+            Image cropped;
+            cropped.create(copyWidth, copyHeight);
+            cropped.copy(image, 0, 0, IntRect(0, 0, copyWidth, copyHeight));
+            image = cropped;
+        }
+
+        glCheck(glBindTexture(GL_TEXTURE_2D, texture));
+        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, copyWidth, copyHeight, GL_RGBA, GL_UNSIGNED_BYTE, image.getPixelsPtr()));
+    }
+
+    // Replace the old texture
+    GLuint oldTexture = static_cast<GLuint>(m_texture);
+    glCheck(glDeleteTextures(1, &oldTexture));
+
+    m_texture       = static_cast<unsigned int>(texture);
+    m_size.x        = width;
+    m_size.y        = height;
+    m_actualSize    = actualSize;
+    m_pixelsFlipped = false;
+    m_hasMipmap     = false;
+    m_cacheId       = getUniqueId();
+    m_gpuMemory.setBytes(static_cast<Uint64>(m_actualSize.x) * m_actualSize.y * bytesPerPixel(m_format));
+
+    // Force an OpenGL flush, so that the new texture will appear in all contexts immediately
+    glCheck(glFlush());
+
     return true;
 }
 
@@ -188,91 +534,112 @@ bool Texture::create(unsigned int width, unsigned int height)
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromFile(const std::string& filename, const IntRect& area)
 {
-    Image image;
-    return image.loadFromFile(filename) && loadFromImage(image, area);
+    #ifndef SFML_SYSTEM_ANDROID
+
+        // Upload straight from the decoder's memory, there's no need for an intermediate image
+        Vector2u size;
+        Uint8* pixels = priv::ImageLoader::getInstance().decodeImageFromFile(filename, size);
+        bool result = pixels && loadFromImage(ImageView(pixels, size.x, size.y).getSubView(area));
+        priv::ImageLoader::getInstance().releaseImage(pixels);
+
+    #else
+
+        Image image;
+        bool result = image.loadFromFile(filename) && loadFromImage(image, area);
+
+    #endif
+
+    if (result && m_gpuMemory.getName().empty())
+        m_gpuMemory.setName(filename);
+
+    return result;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromMemory(const void* data, std::size_t size, const IntRect& area)
 {
-    Image image;
-    return image.loadFromMemory(data, size) && loadFromImage(image, area);
+    Vector2u imageSize;
+    Uint8* pixels = priv::ImageLoader::getInstance().decodeImageFromMemory(data, size, imageSize);
+    bool result = pixels && loadFromImage(ImageView(pixels, imageSize.x, imageSize.y).getSubView(area));
+    priv::ImageLoader::getInstance().releaseImage(pixels);
+    return result;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromStream(InputStream& stream, const IntRect& area)
 {
-    Image image;
-    return image.loadFromStream(stream) && loadFromImage(image, area);
+    Vector2u size;
+    Uint8* pixels = priv::ImageLoader::getInstance().decodeImageFromStream(stream, size);
+    bool result = pixels && loadFromImage(ImageView(pixels, size.x, size.y).getSubView(area));
+    priv::ImageLoader::getInstance().releaseImage(pixels);
+    return result;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromImage(const Image& image, const IntRect& area)
 {
-    // Retrieve the image size
-    int width = static_cast<int>(image.getSize().x);
-    int height = static_cast<int>(image.getSize().y);
+    if (!loadFromImage(ImageView(image, area)))
+        return false;
+
+    m_premultiplied = image.isPremultiplied();
+
+    return true;
+}
 
-    // Load the entire image if the source area is either empty or contains the whole image
-    if (area.width == 0 || (area.height == 0) ||
-       ((area.left <= 0) && (area.top <= 0) && (area.width >= width) && (area.height >= height)))
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromImage(const ImageView& view)
+{
+    // Create the texture and upload the pixels
+    if (create(view.getSize().x, view.getSize().y))
     {
-        // Load the entire image
-        if (create(image.getSize().x, image.getSize().y))
-        {
-            update(image);
+        update(view, 0, 0);
 
-            // Force an OpenGL flush, so that the texture will appear updated
-            // in all contexts immediately (solves problems in multi-threaded apps)
-            glCheck(glFlush());
+        // Force an OpenGL flush, so that the texture will appear updated
+        // in all contexts immediately (solves problems in multi-threaded apps)
+        glCheck(glFlush());
 
-            return true;
-        }
-        else
-        {
-            return false;
-        }
+        return true;
     }
     else
     {
-        // Load a sub-area of the image
+        return false;
+    }
+}
 
-        // Adjust the rectangle to the size of the image
-        IntRect rectangle = area;
-        if (rectangle.left   < 0) rectangle.left = 0;
-        if (rectangle.top    < 0) rectangle.top  = 0;
-        if (rectangle.left + rectangle.width > width)  rectangle.width  = width - rectangle.left;
-        if (rectangle.top + rectangle.height > height) rectangle.height = height - rectangle.top;
 
-        // Create the texture and upload the pixels
-        if (create(rectangle.width, rectangle.height))
-        {
-            // Make sure that the current texture binding will be preserved
-            priv::TextureSaver save;
+////////////////////////////////////////////////////////////
+bool Texture::loadFromCompressedFile(const std::string& filename)
+{
+    priv::CompressedImage image;
+    bool result = priv::loadCompressedImageFromFile(filename, image) &&
+                  loadCompressed(image.format, image.size.x, image.size.y, &image.blocks[0], image.blocks.size());
 
-            // Copy the pixels to the texture, row by row
-            const Uint8* pixels = image.getPixelsPtr() + 4 * (rectangle.left + (width * rectangle.top));
-            glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-            for (int i = 0; i < rectangle.height; ++i)
-            {
-                glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, i, rectangle.width, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
-                pixels += 4 * width;
-            }
+    if (result && m_gpuMemory.getName().empty())
+        m_gpuMemory.setName(filename);
 
-            // Force an OpenGL flush, so that the texture will appear updated
-            // in all contexts immediately (solves problems in multi-threaded apps)
-            glCheck(glFlush());
+    return result;
+}
 
-            return true;
-        }
-        else
-        {
-            return false;
-        }
-    }
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromCompressedMemory(const void* data, std::size_t size)
+{
+    priv::CompressedImage image;
+    return priv::loadCompressedImageFromMemory(data, size, image) &&
+           loadCompressed(image.format, image.size.x, image.size.y, &image.blocks[0], image.blocks.size());
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromCompressedStream(InputStream& stream)
+{
+    priv::CompressedImage image;
+    return priv::loadCompressedImageFromStream(stream, image) &&
+           loadCompressed(image.format, image.size.x, image.size.y, &image.blocks[0], image.blocks.size());
 }
 
 
@@ -283,6 +650,13 @@ Vector2u Texture::getSize() const
 }
 
 
+////////////////////////////////////////////////////////////
+Texture::Format Texture::getFormat() const
+{
+    return m_format;
+}
+
+
 ////////////////////////////////////////////////////////////
 Image Texture::copyToImage() const
 {
@@ -319,7 +693,7 @@ Image Texture::copyToImage() const
 
 #else
 
-    if ((m_size == m_actualSize) && !m_pixelsFlipped)
+    if ((m_size == m_actualSize) && !m_pixelsFlipped && (m_format != R8))
     {
         // Texture is not padded nor flipped, we can use a direct copy
         glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
@@ -327,17 +701,21 @@ Image Texture::copyToImage() const
     }
     else
     {
-        // Texture is either padded or flipped, we have to use a slower algorithm
+        // Texture is either padded, flipped or single-channel, we have to use a slower algorithm
 
-        // All the pixels will first be copied to a temporary array
-        std::vector<Uint8> allPixels(m_actualSize.x * m_actualSize.y * 4);
+        // All the pixels will first be copied to a temporary array; single-channel
+        // textures only transfer their red channel, with tightly packed rows
+        unsigned int channels = (m_format == R8) ? 1 : 4;
+        std::vector<Uint8> allPixels(m_actualSize.x * m_actualSize.y * channels);
         glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, &allPixels[0]));
+        glCheck(glPixelStorei(GL_PACK_ALIGNMENT, 1));
+        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, (channels == 1) ? GL_RED : GL_RGBA, GL_UNSIGNED_BYTE, &allPixels[0]));
+        glCheck(glPixelStorei(GL_PACK_ALIGNMENT, 4));
 
         // Then we copy the useful pixels from the temporary array to the final one
         const Uint8* src = &allPixels[0];
         Uint8* dst = &pixels[0];
-        int srcPitch = m_actualSize.x * 4;
+        int srcPitch = m_actualSize.x * channels;
         int dstPitch = m_size.x * 4;
 
         // Handle the case where source pixels are flipped vertically
@@ -349,7 +727,21 @@ Image Texture::copyToImage() const
 
         for (unsigned int i = 0; i < m_size.y; ++i)
         {
-            std::memcpy(dst, src, dstPitch);
+            if (channels == 4)
+            {
+                std::memcpy(dst, src, dstPitch);
+            }
+            else
+            {
+                // Expand the red channel to gray opaque pixels
+                for (unsigned int j = 0; j < m_size.x; ++j)
+                {
+                    dst[j * 4 + 0] = src[j];
+                    dst[j * 4 + 1] = src[j];
+                    dst[j * 4 + 2] = src[j];
+                    dst[j * 4 + 3] = 255;
+                }
+            }
             src += srcPitch;
             dst += dstPitch;
         }
@@ -360,6 +752,7 @@ Image Texture::copyToImage() const
     // Create the image
     Image image;
     image.create(m_size.x, m_size.y, &pixels[0]);
+    image.setPremultiplied(m_premultiplied);
 
     return image;
 }
@@ -376,6 +769,64 @@ void Texture::update(const Uint8* pixels)
 ////////////////////////////////////////////////////////////
 void Texture::update(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y)
 {
+    update(ImageView(pixels, width, height), x, y);
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::update(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y, Image::PixelFormat format)
+{
+    if (format == Image::Rgba)
+    {
+        update(pixels, width, height, x, y);
+        return;
+    }
+
+    if (!pixels || !m_texture)
+        return;
+
+    SFML_PROFILE_ZONE("Texture::update");
+
+    assert(x + width <= m_size.x);
+    assert(y + height <= m_size.y);
+
+    ensureGlContext();
+
+#ifndef SFML_OPENGL_ES
+
+    // Let the driver swizzle BGRA pixels during the transfer
+    priv::ensureExtensionsInit();
+    if ((format == Image::Bgra) && GLEXT_bgra)
+    {
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save;
+
+        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GLEXT_GL_BGRA, GL_UNSIGNED_BYTE, pixels));
+        invalidateMipmap();
+        m_pixelsFlipped = false;
+        m_cacheId = getUniqueId();
+        return;
+    }
+
+#endif
+
+    // Other formats are converted on the CPU
+    Image image;
+    image.create(width, height, pixels, format);
+    update(image, x, y);
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::update(const ImageView& view, unsigned int x, unsigned int y)
+{
+    SFML_PROFILE_ZONE("Texture::update");
+
+    const Uint8* pixels = view.getPixelsPtr();
+    unsigned int width  = view.getSize().x;
+    unsigned int height = view.getSize().y;
+
     assert(x + width <= m_size.x);
     assert(y + height <= m_size.y);
 
@@ -388,7 +839,30 @@ void Texture::update(const Uint8* pixels, unsigned int width, unsigned int heigh
 
         // Copy pixels from the given array to the texture
         glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+        if (view.getStride() == width)
+        {
+            glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+        }
+        else
+        {
+
+#ifndef SFML_OPENGL_ES
+
+            // Let the driver skip the end of the rows, so that they don't need to be repacked
+            glCheck(glPixelStorei(GL_UNPACK_ROW_LENGTH, view.getStride()));
+            glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+            glCheck(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+
+#else
+
+            // OpenGL ES 2 has no unpack row length, copy the rows one by one
+            for (unsigned int i = 0; i < height; ++i)
+                glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y + i, width, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels + i * view.getStride() * 4));
+
+#endif
+
+        }
+        invalidateMipmap();
         m_pixelsFlipped = false;
         m_cacheId = getUniqueId();
     }
@@ -420,6 +894,8 @@ void Texture::update(const Window& window)
 ////////////////////////////////////////////////////////////
 void Texture::update(const Window& window, unsigned int x, unsigned int y)
 {
+    SFML_PROFILE_ZONE("Texture::update");
+
     assert(x + window.getSize().x <= m_size.x);
     assert(y + window.getSize().y <= m_size.y);
 
@@ -431,12 +907,58 @@ void Texture::update(const Window& window, unsigned int x, unsigned int y)
         // Copy pixels from the back-buffer to the texture
         glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
         glCheck(glCopyTexSubImage2D(GL_TEXTURE_2D, 0, x, y, 0, 0, window.getSize().x, window.getSize().y));
+        invalidateMipmap();
         m_pixelsFlipped = true;
         m_cacheId = getUniqueId();
     }
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::updateAsync(TextureUpload& upload, unsigned int x, unsigned int y)
+{
+    assert(x + upload.m_size.x <= m_size.x);
+    assert(y + upload.m_size.y <= m_size.y);
+
+    if (!m_texture || (upload.m_size.x == 0) || (upload.m_size.y == 0))
+        return;
+
+#ifndef SFML_OPENGL_ES
+
+    if (upload.m_buffer)
+    {
+        ensureGlContext();
+
+        // The buffer can't be read by the graphics card while it is mapped
+        upload.unlock();
+        upload.releaseFence();
+
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save;
+
+        // Copy pixels from the bound buffer, the data pointer is an offset into it
+        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, upload.m_buffer));
+        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, upload.m_size.x, upload.m_size.y, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+        invalidateMipmap();
+
+        // Signal the end of the transfer, and make sure that it is submitted
+        upload.m_fence = glCheck(GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        glCheck(glFlush());
+
+        m_pixelsFlipped = false;
+        m_cacheId = getUniqueId();
+        return;
+    }
+
+#endif
+
+    // The pixels are staged in system memory
+    update(upload.lock(), upload.m_size.x, upload.m_size.y, x, y);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::setSmooth(bool smooth)
 {
@@ -453,7 +975,15 @@ void Texture::setSmooth(bool smooth)
 
             glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
             glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
-            glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+
+            if (m_hasMipmap)
+            {
+                glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR));
+            }
+            else
+            {
+                glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+            }
         }
     }
 }
@@ -466,6 +996,20 @@ bool Texture::isSmooth() const
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::setPremultiplied(bool premultiplied)
+{
+    m_premultiplied = premultiplied;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::isPremultiplied() const
+{
+    return m_premultiplied;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::setRepeated(bool repeated)
 {
@@ -473,6 +1017,18 @@ void Texture::setRepeated(bool repeated)
     {
         m_isRepeated = repeated;
 
+        // Textures stored with their exact size can't be repeated on all graphics
+        // cards, move the pixels to a texture padded to a power of two if needed
+        if (m_texture && repeated && ((getValidSize(m_actualSize.x, true) != m_actualSize.x) ||
+                                      (getValidSize(m_actualSize.y, true) != m_actualSize.y)))
+        {
+            Image image = copyToImage();
+            if (create(m_size.x, m_size.y, m_format))
+                update(image);
+
+            return;
+        }
+
         if (m_texture)
         {
             ensureGlContext();
@@ -509,46 +1065,107 @@ bool Texture::isRepeated() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::generateMipmap()
+{
+    if (!m_texture)
+        return false;
+
+    ensureGlContext();
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    if (!GLEXT_framebuffer_object)
+        return false;
+
+    // Textures stored with their exact size may not support mipmaps
+    if ((getValidSize(m_actualSize.x, true) != m_actualSize.x) || (getValidSize(m_actualSize.y, true) != m_actualSize.y))
+        return false;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    glCheck(GLEXT_glGenerateMipmap(GL_TEXTURE_2D));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR));
+
+    // The mipmap levels add a third to the size of the base level
+    m_hasMipmap = true;
+    m_gpuMemory.setBytes(m_gpuMemory.getBytes() + m_gpuMemory.getBytes() / 3);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::invalidateMipmap()
+{
+    if (!m_hasMipmap)
+        return;
+
+    ensureGlContext();
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+
+    // The levels are released from the estimate (generateMipmap added a third)
+    m_hasMipmap = false;
+    m_gpuMemory.setBytes(m_gpuMemory.getBytes() - m_gpuMemory.getBytes() / 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::setDebugName(const std::string& name)
+{
+    m_gpuMemory.setName(name);
+}
+
+
+////////////////////////////////////////////////////////////
+std::string Texture::getDebugName() const
+{
+    return m_gpuMemory.getName();
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::bind(const Texture* texture, CoordinateType coordinateType)
 {
     ensureGlContext();
 
+    // Restore the texture if it was evicted
+    if (texture)
+        texture->use();
+
     if (texture && texture->m_texture)
     {
         // Bind the texture
         glCheck(glBindTexture(GL_TEXTURE_2D, texture->m_texture));
 
-        // Check if we need to define a special texture matrix
-        if ((coordinateType == Pixels) || texture->m_pixelsFlipped)
-        {
-            GLfloat matrix[16] = {1.f, 0.f, 0.f, 0.f,
-                                  0.f, 1.f, 0.f, 0.f,
-                                  0.f, 0.f, 1.f, 0.f,
-                                  0.f, 0.f, 0.f, 1.f};
-
-            // If non-normalized coordinates (= pixels) are requested, we need to
-            // setup scale factors that convert the range [0 .. size] to [0 .. 1]
-            if (coordinateType == Pixels)
-            {
-                matrix[0] = 1.f / texture->m_actualSize.x;
-                matrix[5] = 1.f / texture->m_actualSize.y;
-            }
+        float scaleX  = 1.f;
+        float scaleY  = 1.f;
+        float offsetY = 0.f;
 
-            // If pixels are flipped we must invert the Y axis
-            if (texture->m_pixelsFlipped)
-            {
-                matrix[5] = -matrix[5];
-                matrix[13] = static_cast<float>(texture->m_size.y) / texture->m_actualSize.y;
-            }
-
-            // Load the matrix
-            glCheck(glMatrixMode(GL_TEXTURE));
-            glCheck(glLoadMatrixf(matrix));
+        // If non-normalized coordinates (= pixels) are requested, we need to
+        // setup scale factors that convert the range [0 .. size] to [0 .. 1]
+        if (coordinateType == Pixels)
+        {
+            scaleX = 1.f / texture->m_actualSize.x;
+            scaleY = 1.f / texture->m_actualSize.y;
+        }
 
-            // Go back to model-view mode (sf::RenderTarget relies on it)
-            glCheck(glMatrixMode(GL_MODELVIEW));
+        // If pixels are flipped we must invert the Y axis
+        if (texture->m_pixelsFlipped)
+        {
+            scaleY  = -scaleY;
+            offsetY = static_cast<float>(texture->m_size.y) / texture->m_actualSize.y;
         }
+
+        loadTextureMatrix(scaleX, scaleY, offsetY);
     }
     else
     {
@@ -556,15 +1173,21 @@ void Texture::bind(const Texture* texture, CoordinateType coordinateType)
         glCheck(glBindTexture(GL_TEXTURE_2D, 0));
 
         // Reset the texture matrix
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glLoadIdentity());
-
-        // Go back to model-view mode (sf::RenderTarget relies on it)
-        glCheck(glMatrixMode(GL_MODELVIEW));
+        loadTextureMatrix(1.f, 1.f, 0.f);
     }
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::invalidateTextureMatrix()
+{
+    ensureGlContext();
+
+    Lock lock(textureMatricesMutex);
+    textureMatrices.erase(Context::getActiveContextId());
+}
+
+
 ////////////////////////////////////////////////////////////
 unsigned int Texture::getMaximumSize()
 {
@@ -577,6 +1200,36 @@ unsigned int Texture::getMaximumSize()
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::isCompressedFormatSupported(CompressedFormat format)
+{
+    // TODO: Remove this lock when it becomes unnecessary in C++11
+    Lock lock(mutex);
+
+    static Uint32 formats = checkCompressedFormats();
+
+    return (formats & (1 << format)) != 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::isFormatSupported(Format format)
+{
+    ensureGlContext();
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    switch (format)
+    {
+        case R8:      return GLEXT_texture_rg != 0;
+        case Rgba16f:
+        case Rgba32f: return GLEXT_texture_float != 0;
+        default:      return true;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 Texture& Texture::operator =(const Texture& right)
 {
@@ -585,15 +1238,40 @@ Texture& Texture::operator =(const Texture& right)
     std::swap(m_size,          temp.m_size);
     std::swap(m_actualSize,    temp.m_actualSize);
     std::swap(m_texture,       temp.m_texture);
+    std::swap(m_format,        temp.m_format);
     std::swap(m_isSmooth,      temp.m_isSmooth);
     std::swap(m_isRepeated,    temp.m_isRepeated);
+    std::swap(m_hasMipmap,     temp.m_hasMipmap);
+    std::swap(m_premultiplied, temp.m_premultiplied);
     std::swap(m_pixelsFlipped, temp.m_pixelsFlipped);
+    m_gpuMemory.swapBytes(temp.m_gpuMemory);
     m_cacheId = getUniqueId();
 
     return *this;
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::swap(Texture& right)
+{
+    // Let the managers follow the content they manage
+    TextureManager::swapTextures(*this, right);
+
+    std::swap(m_size,          right.m_size);
+    std::swap(m_actualSize,    right.m_actualSize);
+    std::swap(m_texture,       right.m_texture);
+    std::swap(m_format,        right.m_format);
+    std::swap(m_isSmooth,      right.m_isSmooth);
+    std::swap(m_isRepeated,    right.m_isRepeated);
+    std::swap(m_hasMipmap,     right.m_hasMipmap);
+    std::swap(m_premultiplied, right.m_premultiplied);
+    std::swap(m_pixelsFlipped, right.m_pixelsFlipped);
+    std::swap(m_cacheId,       right.m_cacheId);
+    std::swap(m_manager,       right.m_manager);
+    m_gpuMemory.swapBytes(right.m_gpuMemory);
+}
+
+
 ////////////////////////////////////////////////////////////
 unsigned int Texture::getNativeHandle() const
 {
@@ -602,14 +1280,89 @@ unsigned int Texture::getNativeHandle() const
 
 
 ////////////////////////////////////////////////////////////
-unsigned int Texture::getValidSize(unsigned int size)
+bool Texture::loadCompressed(CompressedFormat format, unsigned int width, unsigned int height, const void* blocks, std::size_t size)
 {
+    if ((width == 0) || (height == 0))
+    {
+        err() << "Failed to load compressed texture, invalid size (" << width << "x" << height << ")" << std::endl;
+        return false;
+    }
+
+    if (!isCompressedFormatSupported(format))
+    {
+        err() << "Failed to load compressed texture, its format is not supported by the graphics card" << std::endl;
+        return false;
+    }
+
+    // The blocks can't be padded, the size must be valid as it is (even if repeat mode is enabled later)
+    if ((getValidSize(width, true) != width) || (getValidSize(height, true) != height))
+    {
+        err() << "Failed to load compressed texture, its size (" << width << "x" << height << ") "
+              << "must be a power of two on this graphics card" << std::endl;
+        return false;
+    }
+
+    // Check the maximum texture size
+    unsigned int maxSize = getMaximumSize();
+    if ((width > maxSize) || (height > maxSize))
+    {
+        err() << "Failed to load compressed texture, its size is too high "
+              << "(" << width << "x" << height << ", "
+              << "maximum is " << maxSize << "x" << maxSize << ")"
+              << std::endl;
+        return false;
+    }
+
     ensureGlContext();
 
-    // Make sure that extensions are initialized
-    priv::ensureExtensionsInit();
+    // Create the OpenGL texture if it doesn't exist yet
+    if (!m_texture)
+    {
+        GLuint texture;
+        glCheck(glGenTextures(1, &texture));
+        m_texture = static_cast<unsigned int>(texture);
+    }
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    // Upload the blocks as they are
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    glCheck(GLEXT_glCompressedTexImage2D(GL_TEXTURE_2D, 0, compressedFormatToGlEnum(format), width, height, 0, static_cast<GLsizei>(size), blocks));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_isRepeated ? GL_REPEAT : (GLEXT_texture_edge_clamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_isRepeated ? GL_REPEAT : (GLEXT_texture_edge_clamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
 
-    if (GLEXT_texture_non_power_of_two)
+    m_size.x        = width;
+    m_size.y        = height;
+    m_actualSize    = m_size;
+    m_format        = Rgba8;
+    m_pixelsFlipped = false;
+    m_hasMipmap     = false;
+    m_cacheId       = getUniqueId();
+    m_gpuMemory.setBytes(size);
+
+    // Force an OpenGL flush, so that the texture will appear updated in all contexts immediately
+    glCheck(glFlush());
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Texture::getValidSize(unsigned int size, bool repeated)
+{
+    NpotSupport support;
+    {
+        // TODO: Remove this lock when it becomes unnecessary in C++11
+        Lock lock(mutex);
+
+        static NpotSupport npot = checkNpotSupport();
+        support = npot;
+    }
+
+    if ((support == FullNpot) || ((support == LimitedNpot) && !repeated))
     {
         // If hardware supports NPOT textures, then just return the unmodified size
         return size;
@@ -625,4 +1378,30 @@ unsigned int Texture::getValidSize(unsigned int size)
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void Texture::use() const
+{
+    if (m_manager)
+        m_manager->use(*this);
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::evict()
+{
+    if (!m_texture)
+        return;
+
+    ensureGlContext();
+
+    GLuint texture = static_cast<GLuint>(m_texture);
+    glCheck(glDeleteTextures(1, &texture));
+
+    m_texture   = 0;
+    m_hasMipmap = false;
+    m_cacheId   = getUniqueId();
+    m_gpuMemory.setBytes(0);
+}
+
 } // namespace sf
@@ -0,0 +1,417 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureArray.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Err.hpp>
+
+
+#ifndef SFML_OPENGL_ES
+
+namespace
+{
+    // Sample the layer selected by the texture coordinates, which are given
+    // in pixels with the layers stacked vertically every two layer heights
+    const char* layerShader =
+        "#extension GL_EXT_texture_array : enable\n"
+        "uniform sampler2DArray layers;\n"
+        "uniform vec2 layerSize;\n"
+        "\n"
+        "void main()\n"
+        "{\n"
+        "    vec2 pixel = gl_TexCoord[0].xy;\n"
+        "    float layer = floor(pixel.y / (2.0 * layerSize.y));\n"
+        "    pixel.y -= layer * 2.0 * layerSize.y;\n"
+        "    gl_FragColor = gl_Color * texture2DArray(layers, vec3(pixel / layerSize, layer));\n"
+        "}\n";
+
+    // Preserve the texture array binding, like priv::TextureSaver does for 2D textures
+    class TextureArraySaver
+    {
+    public:
+
+        TextureArraySaver() :
+        m_binding(0)
+        {
+            glCheck(glGetIntegerv(GLEXT_GL_TEXTURE_BINDING_2D_ARRAY, &m_binding));
+        }
+
+        ~TextureArraySaver()
+        {
+            glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, static_cast<GLuint>(m_binding)));
+        }
+
+    private:
+
+        GLint m_binding;
+    };
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureArray::TextureArray() :
+m_texture   (0),
+m_size      (0, 0),
+m_layerCount(0),
+m_isSmooth  (false),
+m_shader    ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureArray::~TextureArray()
+{
+    // Destroy the OpenGL texture
+    if (m_texture)
+    {
+        ensureGlContext();
+
+        GLuint texture = static_cast<GLuint>(m_texture);
+        glCheck(glDeleteTextures(1, &texture));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::create(unsigned int width, unsigned int height, unsigned int layerCount)
+{
+    if (!isAvailable())
+    {
+        err() << "Failed to create texture array, your system doesn't support texture arrays "
+              << "(you should test TextureArray::isAvailable() before trying to use the TextureArray class)" << std::endl;
+        return false;
+    }
+
+    // Check if texture array parameters are valid before creating it
+    if ((width == 0) || (height == 0) || (layerCount == 0))
+    {
+        err() << "Failed to create texture array, invalid size (" << width << "x" << height << "x" << layerCount << ")" << std::endl;
+        return false;
+    }
+
+    unsigned int maxSize = Texture::getMaximumSize();
+    if ((width > maxSize) || (height > maxSize))
+    {
+        err() << "Failed to create texture array, its layers are too big (" << width << "x" << height << ", "
+              << "maximum is " << maxSize << "x" << maxSize << ")" << std::endl;
+        return false;
+    }
+
+    unsigned int maxLayers = getMaximumLayerCount();
+    if (layerCount > maxLayers)
+    {
+        err() << "Failed to create texture array, too many layers (" << layerCount << ", maximum is " << maxLayers << ")" << std::endl;
+        return false;
+    }
+
+    ensureGlContext();
+
+    // Build the shader on first use, it refers to this texture array
+    if (!m_shader.getNativeHandle())
+    {
+        if (!m_shader.loadFromMemory(layerShader, Shader::Fragment))
+        {
+            err() << "Failed to create texture array, the layer shader failed to compile" << std::endl;
+            return false;
+        }
+
+        m_shader.setParameter("layers", *this);
+    }
+
+    // Create the OpenGL texture if it doesn't exist yet
+    if (!m_texture)
+    {
+        GLuint texture;
+        glCheck(glGenTextures(1, &texture));
+        m_texture = static_cast<unsigned int>(texture);
+    }
+
+    m_size.x     = width;
+    m_size.y     = height;
+    m_layerCount = layerCount;
+
+    m_shader.setParameter("layerSize", static_cast<float>(width), static_cast<float>(height));
+
+    // Make sure that the current texture array binding will be preserved
+    TextureArraySaver save;
+
+    // Allocate the layers, clamping keeps the filter from wrapping around the edges
+    glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, m_texture));
+    glCheck(GLEXT_glTexImage3D(GLEXT_GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, static_cast<GLsizei>(width), static_cast<GLsizei>(height),
+                               static_cast<GLsizei>(layerCount), 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GLEXT_GL_CLAMP_TO_EDGE));
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GLEXT_GL_CLAMP_TO_EDGE));
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::update(const Uint8* pixels, unsigned int layer)
+{
+    update(pixels, m_size.x, m_size.y, 0, 0, layer);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::update(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y, unsigned int layer)
+{
+    if (!m_texture || !pixels)
+        return;
+
+    if ((layer >= m_layerCount) || (x + width > m_size.x) || (y + height > m_size.y))
+    {
+        err() << "Failed to update texture array, the area doesn't fit in its layers" << std::endl;
+        return;
+    }
+
+    ensureGlContext();
+
+    // Make sure that the current texture array binding will be preserved
+    TextureArraySaver save;
+
+    // Copy pixels from the given array to the layer
+    glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, m_texture));
+    glCheck(GLEXT_glTexSubImage3D(GLEXT_GL_TEXTURE_2D_ARRAY, 0, static_cast<GLint>(x), static_cast<GLint>(y), static_cast<GLint>(layer),
+                                  static_cast<GLsizei>(width), static_cast<GLsizei>(height), 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::update(const Image& image, unsigned int layer)
+{
+    update(image.getPixelsPtr(), image.getSize().x, image.getSize().y, 0, 0, layer);
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TextureArray::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureArray::getLayerCount() const
+{
+    return m_layerCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::setSmooth(bool smooth)
+{
+    if (smooth != m_isSmooth)
+    {
+        m_isSmooth = smooth;
+
+        if (m_texture)
+        {
+            ensureGlContext();
+
+            // Make sure that the current texture array binding will be preserved
+            TextureArraySaver save;
+
+            glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, m_texture));
+            glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+            glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::isSmooth() const
+{
+    return m_isSmooth;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f TextureArray::getLayerOffset(unsigned int layer) const
+{
+    return Vector2f(0.f, static_cast<float>(layer) * 2.f * static_cast<float>(m_size.y));
+}
+
+
+////////////////////////////////////////////////////////////
+const Shader& TextureArray::getShader() const
+{
+    return m_shader;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureArray::getNativeHandle() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::isAvailable()
+{
+    ensureGlContext();
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    return GLEXT_texture_array && Shader::isAvailable();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureArray::getMaximumLayerCount()
+{
+    if (!isAvailable())
+        return 0;
+
+    GLint layers = 0;
+    glCheck(glGetIntegerv(GLEXT_GL_MAX_ARRAY_TEXTURE_LAYERS, &layers));
+
+    return static_cast<unsigned int>(layers);
+}
+
+} // namespace sf
+
+#else // SFML_OPENGL_ES
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureArray::TextureArray() :
+m_texture   (0),
+m_size      (0, 0),
+m_layerCount(0),
+m_isSmooth  (false),
+m_shader    ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureArray::~TextureArray()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::create(unsigned int, unsigned int, unsigned int)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::update(const Uint8*, unsigned int)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::update(const Uint8*, unsigned int, unsigned int, unsigned int, unsigned int, unsigned int)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::update(const Image&, unsigned int)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TextureArray::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureArray::getLayerCount() const
+{
+    return m_layerCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::setSmooth(bool smooth)
+{
+    m_isSmooth = smooth;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::isSmooth() const
+{
+    return m_isSmooth;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f TextureArray::getLayerOffset(unsigned int) const
+{
+    return Vector2f(0.f, 0.f);
+}
+
+
+////////////////////////////////////////////////////////////
+const Shader& TextureArray::getShader() const
+{
+    return m_shader;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureArray::getNativeHandle() const
+{
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::isAvailable()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureArray::getMaximumLayerCount()
+{
+    return 0;
+}
+
+} // namespace sf
+
+#endif // SFML_OPENGL_ES
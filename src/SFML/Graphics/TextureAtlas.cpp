@@ -0,0 +1,286 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureAtlas.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cassert>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureAtlas::Region::Region() :
+texture(NULL),
+page   (0),
+rect   ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::TextureAtlas(const Vector2u& pageSize, unsigned int padding) :
+m_pages   (),
+m_pageSize(pageSize),
+m_padding (padding),
+m_isSmooth(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::~TextureAtlas()
+{
+    clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::add(const Image& image, Region& region)
+{
+    // The padding is only needed between images, not along the borders of the page
+    unsigned int width  = image.getSize().x + m_padding;
+    unsigned int height = image.getSize().y + m_padding;
+
+    // Try the existing pages first, the most recent ones are the least filled
+    Page* page = NULL;
+    std::size_t index = 0;
+    unsigned int top = 0;
+    for (std::size_t i = m_pages.size(); (i > 0) && !page; --i)
+    {
+        if (findPosition(*m_pages[i - 1], width, height, index, top))
+        {
+            page = m_pages[i - 1];
+            region.page = static_cast<unsigned int>(i - 1);
+        }
+    }
+
+    // No room left: allocate a new page
+    if (!page)
+    {
+        page = createPage();
+        if (!page)
+            return false;
+
+        if (!findPosition(*page, width, height, index, top))
+        {
+            err() << "Failed to add an image to the texture atlas: the image (" << image.getSize().x << "x" << image.getSize().y
+                  << ") is bigger than a page (" << m_pageSize.x << "x" << m_pageSize.y << ")" << std::endl;
+
+            // Don't keep an empty page around
+            delete page;
+            m_pages.pop_back();
+            return false;
+        }
+
+        region.page = static_cast<unsigned int>(m_pages.size() - 1);
+    }
+
+    unsigned int left = page->skyline[index].x;
+    insert(*page, index, top, width, height);
+
+    // Copy the pixels
+    page->texture.update(image, left, top);
+
+    region.texture = &page->texture;
+    region.rect = IntRect(left, top, image.getSize().x, image.getSize().y);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::clear()
+{
+    for (std::vector<Page*>::iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+        delete *it;
+
+    m_pages.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureAtlas::getPageCount() const
+{
+    return static_cast<unsigned int>(m_pages.size());
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& TextureAtlas::getTexture(unsigned int page) const
+{
+    assert(page < m_pages.size());
+    return m_pages[page]->texture;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TextureAtlas::getPageSize() const
+{
+    return m_pageSize;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::setSmooth(bool smooth)
+{
+    m_isSmooth = smooth;
+
+    for (std::vector<Page*>::iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+        (*it)->texture.setSmooth(smooth);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::isSmooth() const
+{
+    return m_isSmooth;
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::Page* TextureAtlas::createPage()
+{
+    // Make sure that the pages can be created on this graphics card
+    unsigned int maxSize = Texture::getMaximumSize();
+    m_pageSize.x = std::min(m_pageSize.x, maxSize);
+    m_pageSize.y = std::min(m_pageSize.y, maxSize);
+
+    // If the graphics card pads the textures to a power of two, the padding becomes free space of the page
+    m_pageSize.x = Texture::getValidSize(m_pageSize.x, false);
+    m_pageSize.y = Texture::getValidSize(m_pageSize.y, false);
+
+    // Start with transparent pixels, so that the padding doesn't contain garbage
+    Image image;
+    image.create(m_pageSize.x, m_pageSize.y, Color(255, 255, 255, 0));
+
+    Page* page = new Page;
+    if (!page->texture.loadFromImage(image))
+    {
+        err() << "Failed to create a new page for the texture atlas" << std::endl;
+        delete page;
+        return NULL;
+    }
+
+    page->texture.setSmooth(m_isSmooth);
+    page->skyline.push_back(Segment(0, 0, m_pageSize.x));
+    m_pages.push_back(page);
+
+    return page;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::findPosition(const Page& page, unsigned int width, unsigned int height, std::size_t& index, unsigned int& top) const
+{
+    // The padding of the last column/row may fall outside the page
+    unsigned int pageWidth  = m_pageSize.x + m_padding;
+    unsigned int pageHeight = m_pageSize.y + m_padding;
+
+    bool found = false;
+    unsigned int bestBottom = 0;
+    unsigned int bestWidth = 0;
+
+    for (std::size_t i = 0; i < page.skyline.size(); ++i)
+    {
+        // Check that the rectangle doesn't overflow on the right
+        const Segment& segment = page.skyline[i];
+        if (segment.x + width > pageWidth)
+            break;
+
+        // It must sit on the highest segment that it covers
+        unsigned int y = 0;
+        unsigned int widthLeft = width;
+        for (std::size_t j = i; (j < page.skyline.size()) && (widthLeft > 0); ++j)
+        {
+            y = std::max(y, page.skyline[j].y);
+            widthLeft -= std::min(widthLeft, page.skyline[j].width);
+        }
+
+        if (y + height > pageHeight)
+            continue;
+
+        // Keep the position that leaves the lowest bottom edge, then the narrowest segment
+        unsigned int bottom = y + height;
+        if (!found || (bottom < bestBottom) || ((bottom == bestBottom) && (segment.width < bestWidth)))
+        {
+            found = true;
+            index = i;
+            top = y;
+            bestBottom = bottom;
+            bestWidth = segment.width;
+        }
+    }
+
+    return found;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::insert(Page& page, std::size_t index, unsigned int top, unsigned int width, unsigned int height)
+{
+    std::vector<Segment>& skyline = page.skyline;
+
+    // The new segment covers the top of the rectangle
+    unsigned int left = skyline[index].x;
+    skyline.insert(skyline.begin() + index, Segment(left, top + height, width));
+
+    // Shrink or remove the segments that it hides
+    unsigned int right = left + width;
+    std::size_t i = index + 1;
+    while ((i < skyline.size()) && (skyline[i].x < right))
+    {
+        unsigned int segmentRight = skyline[i].x + skyline[i].width;
+        if (segmentRight <= right)
+        {
+            skyline.erase(skyline.begin() + i);
+        }
+        else
+        {
+            skyline[i].width = segmentRight - right;
+            skyline[i].x = right;
+            break;
+        }
+    }
+
+    // Merge the neighbour segments which are at the same height
+    for (i = 0; i + 1 < skyline.size();)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+} // namespace sf
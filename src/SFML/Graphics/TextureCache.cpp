@@ -0,0 +1,230 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureCache.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/ImageView.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/Err.hpp>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+
+namespace
+{
+    // Header of a cache entry; it is followed by the path of
+    // the source file and by the RGBA pixels of the image
+    struct EntryHeader
+    {
+        char       magic[4];
+        sf::Uint32 version;
+        sf::Uint64 sourceTime;
+        sf::Uint64 sourceSize;
+        sf::Uint32 width;
+        sf::Uint32 height;
+        sf::Uint32 pathLength;
+        sf::Uint32 padding;
+    };
+
+    const char       entryMagic[4] = {'S', 'F', 'T', 'C'};
+    const sf::Uint32 entryVersion  = 1;
+
+    // Get the modification time and size of a file
+    bool getFileInfo(const std::string& filename, sf::Uint64& time, sf::Uint64& size)
+    {
+        struct stat info;
+        if (stat(filename.c_str(), &info) != 0)
+            return false;
+
+        time = static_cast<sf::Uint64>(info.st_mtime);
+        size = static_cast<sf::Uint64>(info.st_size);
+        return true;
+    }
+
+    // 64-bit FNV-1a hash, used to name the cache entries
+    std::string hashName(const std::string& str)
+    {
+        sf::Uint64 hash = 14695981039346656037ULL;
+        for (std::size_t i = 0; i < str.size(); ++i)
+        {
+            hash ^= static_cast<unsigned char>(str[i]);
+            hash *= 1099511628211ULL;
+        }
+
+        static const char digits[] = "0123456789abcdef";
+        std::string name(16, '0');
+        for (int i = 15; i >= 0; --i)
+        {
+            name[i] = digits[hash & 0xF];
+            hash >>= 4;
+        }
+
+        return name;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureCache::TextureCache() :
+m_directory()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureCache::TextureCache(const std::string& directory) :
+m_directory()
+{
+    setDirectory(directory);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureCache::setDirectory(const std::string& directory)
+{
+    m_directory = directory;
+
+    // Remove the trailing separator, it is added back when building the entry paths
+    if ((m_directory.size() > 1) && ((m_directory[m_directory.size() - 1] == '/') || (m_directory[m_directory.size() - 1] == '\\')))
+        m_directory.erase(m_directory.size() - 1);
+}
+
+
+////////////////////////////////////////////////////////////
+const std::string& TextureCache::getDirectory() const
+{
+    return m_directory;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureCache::loadTexture(Texture& texture, const std::string& filename)
+{
+    // Files that can't be inspected (no cache directory, Android assets, ...) bypass the cache
+    Uint64 sourceTime = 0;
+    Uint64 sourceSize = 0;
+    if (m_directory.empty() || !getFileInfo(filename, sourceTime, sourceSize))
+        return texture.loadFromFile(filename);
+
+    std::string entryPath = getEntryPath(filename);
+
+    // Try to use an existing entry
+    {
+        FileInputStream entry;
+        if (entry.open(entryPath) && entry.getData())
+        {
+            const Uint8* data     = static_cast<const Uint8*>(entry.getData());
+            Uint64       dataSize = static_cast<Uint64>(entry.getSize());
+
+            EntryHeader header;
+            if (dataSize >= sizeof(header))
+            {
+                std::memcpy(&header, data, sizeof(header));
+
+                Uint64 pixelsOffset = sizeof(header) + static_cast<Uint64>(header.pathLength);
+                Uint64 pixelsSize   = static_cast<Uint64>(header.width) * header.height * 4;
+
+                // The version also rejects entries written with a different byte order
+                if ((std::memcmp(header.magic, entryMagic, sizeof(entryMagic)) == 0) &&
+                    (header.version == entryVersion) &&
+                    (header.sourceTime == sourceTime) &&
+                    (header.sourceSize == sourceSize) &&
+                    (header.pathLength == filename.size()) &&
+                    (dataSize == pixelsOffset + pixelsSize) &&
+                    (std::memcmp(data + sizeof(header), filename.data(), filename.size()) == 0))
+                {
+                    return texture.loadFromImage(ImageView(data + pixelsOffset, header.width, header.height));
+                }
+            }
+        }
+    }
+
+    // No valid entry: decode the image
+    Vector2u size;
+    Uint8* pixels = priv::ImageLoader::getInstance().decodeImageFromFile(filename, size);
+    if (!pixels)
+        return false;
+
+    if (!texture.loadFromImage(ImageView(pixels, size.x, size.y)))
+    {
+        priv::ImageLoader::getInstance().releaseImage(pixels);
+        return false;
+    }
+
+    // Write the new entry to a temporary file first, so that an interrupted
+    // write never leaves a truncated entry behind
+    EntryHeader header;
+    std::memcpy(header.magic, entryMagic, sizeof(entryMagic));
+    header.version    = entryVersion;
+    header.sourceTime = sourceTime;
+    header.sourceSize = sourceSize;
+    header.width      = size.x;
+    header.height     = size.y;
+    header.pathLength = static_cast<Uint32>(filename.size());
+    header.padding    = 0;
+
+    std::string temporaryPath = entryPath + ".tmp";
+    bool written = false;
+    {
+        std::ofstream file(temporaryPath.c_str(), std::ios_base::binary | std::ios_base::trunc);
+        if (file)
+        {
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(filename.data(), filename.size());
+            file.write(reinterpret_cast<const char*>(pixels), static_cast<std::streamsize>(size.x) * size.y * 4);
+            file.close();
+            written = !file.fail();
+        }
+    }
+
+    priv::ImageLoader::getInstance().releaseImage(pixels);
+
+    // rename doesn't replace existing files on Windows
+    std::remove(entryPath.c_str());
+    if (!written || (std::rename(temporaryPath.c_str(), entryPath.c_str()) != 0))
+    {
+        err() << "Failed to write texture cache entry \"" << entryPath << "\" for \"" << filename << "\"" << std::endl;
+        std::remove(temporaryPath.c_str());
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::string TextureCache::getEntryPath(const std::string& filename) const
+{
+    return m_directory + "/" + hashName(filename) + ".sfcache";
+}
+
+} // namespace sf
@@ -0,0 +1,270 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureLoadQueue.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Thread.hpp>
+
+
+namespace
+{
+    // Wait until the commands sent by the calling thread are complete,
+    // so that their results are visible to all the shared contexts
+    void waitForUpload()
+    {
+        if (!GLEXT_sync)
+        {
+            glCheck(glFinish());
+            return;
+        }
+
+        GLEXT_GLsync fence = glCheck(GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+        // Flush the pending commands on the first try only, otherwise the
+        // fence might never be signaled; wait by steps of one millisecond
+        GLbitfield flags = GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT;
+        for (;;)
+        {
+            GLenum status = glCheck(GLEXT_glClientWaitSync(fence, flags, 1000000));
+            if ((status == GLEXT_GL_ALREADY_SIGNALED) || (status == GLEXT_GL_CONDITION_SATISFIED))
+                break;
+
+            if (status == GLEXT_GL_WAIT_FAILED)
+            {
+                sf::err() << "Failed to wait for the end of a texture upload" << std::endl;
+                break;
+            }
+
+            flags = 0;
+        }
+
+        glCheck(GLEXT_glDeleteSync(fence));
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureLoadQueue::TextureLoadQueue(unsigned int threadCount) :
+m_threads(),
+m_jobs   (),
+m_results(),
+m_nextId (0),
+m_pending(0),
+m_loading(0),
+m_running(true),
+m_mutex  (),
+m_newJob (),
+m_jobDone()
+{
+    // Create the image loader now, its lazy construction is not thread-safe
+    priv::ImageLoader::getInstance();
+
+    if (threadCount == 0)
+        threadCount = 1;
+
+    for (unsigned int i = 0; i < threadCount; ++i)
+    {
+        Thread* thread = new Thread(&TextureLoadQueue::run, this);
+        m_threads.push_back(thread);
+        thread->launch();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+TextureLoadQueue::~TextureLoadQueue()
+{
+    // Stop the workers, the textures being loaded are finished first
+    {
+        Lock lock(m_mutex);
+        m_running = false;
+        m_jobs.clear();
+        m_newJob.notifyAll();
+    }
+
+    for (std::vector<Thread*>::iterator it = m_threads.begin(); it != m_threads.end(); ++it)
+    {
+        (*it)->wait();
+        delete *it;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureLoadQueue::push(Texture& texture, const std::string& filename, const IntRect& area)
+{
+    Job job;
+    job.texture = &texture;
+    job.filename = filename;
+    job.data = NULL;
+    job.size = 0;
+    job.area = area;
+
+    return addJob(job);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureLoadQueue::push(Texture& texture, const void* data, std::size_t size, const IntRect& area)
+{
+    Job job;
+    job.texture = &texture;
+    job.data = data;
+    job.size = size;
+    job.area = area;
+
+    return addJob(job);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureLoadQueue::push(Texture& texture, const Image& image, const IntRect& area)
+{
+    Job job;
+    job.texture = &texture;
+    job.data = NULL;
+    job.size = 0;
+    job.image = image;
+    job.area = area;
+
+    return addJob(job);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureLoadQueue::pop(Result& result)
+{
+    Lock lock(m_mutex);
+
+    if (m_results.empty())
+        return false;
+
+    result = m_results.front();
+    m_results.pop_front();
+    m_pending--;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureLoadQueue::isReady() const
+{
+    Lock lock(m_mutex);
+
+    return !m_results.empty();
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureLoadQueue::wait() const
+{
+    Lock lock(m_mutex);
+
+    while (!m_jobs.empty() || (m_loading > 0))
+        m_jobDone.wait(m_mutex);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureLoadQueue::getPendingCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_pending;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureLoadQueue::addJob(Job& job)
+{
+    Lock lock(m_mutex);
+
+    job.id = m_nextId++;
+    m_jobs.push_back(job);
+    m_pending++;
+    m_newJob.notifyOne();
+
+    return job.id;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureLoadQueue::run()
+{
+    // The context of the worker is shared with all the other contexts,
+    // the textures it creates can be used by any of them
+    Context context;
+
+    for (;;)
+    {
+        // Take the next job, sleeping until there is one
+        Job job;
+        {
+            Lock lock(m_mutex);
+
+            while (m_running && m_jobs.empty())
+                m_newJob.wait(m_mutex);
+
+            if (!m_running)
+                return;
+
+            job = m_jobs.front();
+            m_jobs.pop_front();
+            m_loading++;
+        }
+
+        // Decode and upload the texture outside the lock, so that the workers run in parallel
+        Result result;
+        result.id = job.id;
+        result.texture = job.texture;
+        if (job.data)
+            result.success = job.texture->loadFromMemory(job.data, job.size, job.area);
+        else if (!job.filename.empty())
+            result.success = job.texture->loadFromFile(job.filename, job.area);
+        else
+            result.success = job.texture->loadFromImage(job.image, job.area);
+
+        // Don't hand the texture out before the GPU is done writing it
+        if (result.success)
+            waitForUpload();
+
+        Lock lock(m_mutex);
+        m_results.push_back(result);
+        m_loading--;
+        m_jobDone.notifyAll();
+    }
+}
+
+} // namespace sf
@@ -0,0 +1,313 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureManager.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureManager::TextureManager() :
+m_entries (),
+m_budget  (0),
+m_useCount(0),
+m_mutex   ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureManager::TextureManager(Uint64 budget) :
+m_entries (),
+m_budget  (budget),
+m_useCount(0),
+m_mutex   ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureManager::~TextureManager()
+{
+    Lock lock(m_mutex);
+
+    for (EntryMap::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        it->second.texture->m_manager = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureManager::setBudget(Uint64 budget)
+{
+    Lock lock(m_mutex);
+
+    m_budget = budget;
+    enforceBudget(NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 TextureManager::getBudget() const
+{
+    Lock lock(m_mutex);
+
+    return m_budget;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 TextureManager::getMemoryUsage() const
+{
+    Lock lock(m_mutex);
+
+    Uint64 usage = 0;
+    for (EntryMap::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        usage += getMemoryUsage(*it->second.texture);
+
+    return usage;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureManager::loadTexture(Texture& texture, const std::string& filename, const IntRect& area)
+{
+    // Stop managing the texture before changing its content
+    if (texture.m_manager)
+        texture.m_manager->remove(texture);
+
+    if (!texture.loadFromFile(filename, area))
+        return false;
+
+    Entry entry;
+    entry.texture   = &texture;
+    entry.filename  = filename;
+    entry.image     = NULL;
+    entry.area      = area;
+    entry.lastUse   = 0;
+    entry.hasMipmap = false;
+    add(entry);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureManager::loadTexture(Texture& texture, const Image& image, const IntRect& area)
+{
+    // Stop managing the texture before changing its content
+    if (texture.m_manager)
+        texture.m_manager->remove(texture);
+
+    if (!texture.loadFromImage(image, area))
+        return false;
+
+    Entry entry;
+    entry.texture   = &texture;
+    entry.image     = &image;
+    entry.area      = area;
+    entry.lastUse   = 0;
+    entry.hasMipmap = false;
+    add(entry);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureManager::release(Texture& texture)
+{
+    Lock lock(m_mutex);
+
+    EntryMap::iterator it = m_entries.find(&texture);
+    if (it == m_entries.end())
+        return;
+
+    if (!texture.m_texture)
+        restore(it->second);
+
+    texture.m_manager = NULL;
+    m_entries.erase(it);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureManager::add(const Entry& entry)
+{
+    Lock lock(m_mutex);
+
+    m_entries[entry.texture] = entry;
+    m_entries[entry.texture].lastUse = ++m_useCount;
+    entry.texture->m_manager = this;
+
+    enforceBudget(entry.texture);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureManager::use(const Texture& texture)
+{
+    Lock lock(m_mutex);
+
+    EntryMap::iterator it = m_entries.find(&texture);
+    if (it == m_entries.end())
+        return;
+
+    it->second.lastUse = ++m_useCount;
+
+    // Bring the texture back if it was evicted
+    if (!texture.m_texture && restore(it->second))
+        enforceBudget(&texture);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureManager::remove(const Texture& texture)
+{
+    Lock lock(m_mutex);
+
+    EntryMap::iterator it = m_entries.find(&texture);
+    if (it != m_entries.end())
+    {
+        it->second.texture->m_manager = NULL;
+        m_entries.erase(it);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureManager::swapTextures(Texture& left, Texture& right)
+{
+    if (&left == &right)
+        return;
+
+    TextureManager* leftManager  = left.m_manager;
+    TextureManager* rightManager = right.m_manager;
+
+    // Take the entries out first, both textures may belong to the same manager
+    Entry leftEntry;
+    Entry rightEntry;
+    if (leftManager)
+    {
+        Lock lock(leftManager->m_mutex);
+        EntryMap::iterator it = leftManager->m_entries.find(&left);
+        leftEntry = it->second;
+        leftManager->m_entries.erase(it);
+    }
+    if (rightManager)
+    {
+        Lock lock(rightManager->m_mutex);
+        EntryMap::iterator it = rightManager->m_entries.find(&right);
+        rightEntry = it->second;
+        rightManager->m_entries.erase(it);
+    }
+
+    // Put them back under the texture which receives their content
+    if (leftManager)
+    {
+        Lock lock(leftManager->m_mutex);
+        leftEntry.texture = &right;
+        leftManager->m_entries[&right] = leftEntry;
+    }
+    if (rightManager)
+    {
+        Lock lock(rightManager->m_mutex);
+        rightEntry.texture = &left;
+        rightManager->m_entries[&left] = rightEntry;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureManager::restore(Entry& entry)
+{
+    Texture& texture = *entry.texture;
+
+    // Loading the texture gives it a new cache identifier, so that render targets bind it again
+    bool loaded = entry.image ? texture.loadFromImage(*entry.image, entry.area)
+                              : texture.loadFromFile(entry.filename, entry.area);
+    if (!loaded)
+    {
+        err() << "Failed to restore evicted texture" << std::endl;
+        return false;
+    }
+
+    if (entry.hasMipmap)
+        texture.generateMipmap();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureManager::enforceBudget(const Texture* keep)
+{
+    if (m_budget == 0)
+        return;
+
+    Uint64 usage = 0;
+    for (EntryMap::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        usage += getMemoryUsage(*it->second.texture);
+
+    while (usage > m_budget)
+    {
+        // Find the least recently used texture which is still resident
+        Entry* oldest = NULL;
+        for (EntryMap::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            Entry& entry = it->second;
+            if ((entry.texture != keep) && entry.texture->m_texture && (!oldest || (entry.lastUse < oldest->lastUse)))
+                oldest = &entry;
+        }
+
+        // The texture being used is allowed to exceed the budget on its own
+        if (!oldest)
+            break;
+
+        usage -= getMemoryUsage(*oldest->texture);
+        oldest->hasMipmap = oldest->texture->m_hasMipmap;
+        oldest->texture->evict();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 TextureManager::getMemoryUsage(const Texture& texture)
+{
+    if (!texture.m_texture)
+        return 0;
+
+    Uint64 usage = static_cast<Uint64>(texture.m_actualSize.x) * texture.m_actualSize.y * 4;
+    if (texture.m_hasMipmap)
+        usage += usage / 3;
+
+    return usage;
+}
+
+} // namespace sf
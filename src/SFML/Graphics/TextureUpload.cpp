@@ -0,0 +1,303 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureUpload.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstring>
+
+
+namespace
+{
+    sf::Mutex mutex;
+
+    bool checkTextureUploadsAvailable()
+    {
+        // Create a temporary context in case the user checks
+        // before a GlResource is created, thus initializing
+        // the shared context
+        sf::Context context;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        #ifndef SFML_OPENGL_ES
+
+            return GLEXT_vertex_buffer_object && GLEXT_pixel_buffer_object && GLEXT_sync;
+
+        #else
+
+            return false;
+
+        #endif
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureUpload::TextureUpload() :
+m_buffer(0),
+m_size  (0, 0),
+m_pixels(),
+m_mapped(NULL),
+m_fence (NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureUpload::~TextureUpload()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (m_buffer)
+    {
+        ensureGlContext();
+
+        unlock();
+        releaseFence();
+
+        GLuint buffer = static_cast<GLuint>(m_buffer);
+        glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+    }
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureUpload::create(unsigned int width, unsigned int height)
+{
+    // Check if the parameters are valid
+    if ((width == 0) || (height == 0))
+    {
+        err() << "Failed to create texture upload, invalid size (" << width << "x" << height << ")" << std::endl;
+        return false;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    if (isAvailable())
+    {
+        ensureGlContext();
+
+        if (!m_buffer)
+        {
+            GLuint buffer = 0;
+            glCheck(GLEXT_glGenBuffers(1, &buffer));
+            m_buffer = static_cast<unsigned int>(buffer);
+        }
+
+        if (!m_buffer)
+        {
+            err() << "Failed to create texture upload, buffer generation failed" << std::endl;
+            return false;
+        }
+
+        unlock();
+        releaseFence();
+
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, m_buffer));
+        glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_UNPACK_BUFFER, width * height * 4, NULL, GLEXT_GL_STREAM_DRAW));
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+    }
+    else
+
+#endif
+
+    {
+        m_pixels.resize(width * height * 4);
+    }
+
+    m_size.x = width;
+    m_size.y = height;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureUpload::loadFromImage(const Image& image)
+{
+    Vector2u size = image.getSize();
+    if ((size != m_size) && !create(size.x, size.y))
+        return false;
+
+    Uint8* pixels = lock();
+    if (!pixels)
+        return false;
+
+    std::memcpy(pixels, image.getPixelsPtr(), size.x * size.y * 4);
+    unlock();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint8* TextureUpload::lock()
+{
+    if (!m_buffer)
+        return m_pixels.empty() ? NULL : &m_pixels[0];
+
+#ifndef SFML_OPENGL_ES
+
+    if (m_mapped)
+        return m_mapped;
+
+    ensureGlContext();
+
+    // Orphan the previous storage, the pending transfer keeps reading from it
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, m_buffer));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_UNPACK_BUFFER, m_size.x * m_size.y * 4, NULL, GLEXT_GL_STREAM_DRAW));
+    void* pointer = glCheck(GLEXT_glMapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, GLEXT_GL_WRITE_ONLY));
+    m_mapped = static_cast<Uint8*>(pointer);
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+    if (!m_mapped)
+        err() << "Failed to lock texture upload, the buffer could not be mapped" << std::endl;
+
+#endif
+
+    return m_mapped;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureUpload::unlock()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!m_mapped)
+        return;
+
+    ensureGlContext();
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, m_buffer));
+    GLboolean result = glCheck(GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+    if (result == GL_FALSE)
+        err() << "The content of a texture upload was lost while it was locked" << std::endl;
+
+    m_mapped = NULL;
+
+    // Force an OpenGL flush, so that the pixels are visible from all contexts
+    glCheck(glFlush());
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TextureUpload::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureUpload::isComplete() const
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!m_fence)
+        return true;
+
+    ensureGlContext();
+
+    GLEXT_GLsync fence = static_cast<GLEXT_GLsync>(m_fence);
+    GLenum status = glCheck(GLEXT_glClientWaitSync(fence, 0, 0));
+    if (status == GLEXT_GL_TIMEOUT_EXPIRED)
+        return false;
+
+    releaseFence();
+
+#endif
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureUpload::wait() const
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!m_fence)
+        return;
+
+    ensureGlContext();
+
+    // Wait by steps of one millisecond
+    GLEXT_GLsync fence = static_cast<GLEXT_GLsync>(m_fence);
+    for (;;)
+    {
+        GLenum status = glCheck(GLEXT_glClientWaitSync(fence, 0, 1000000));
+        if (status != GLEXT_GL_TIMEOUT_EXPIRED)
+            break;
+    }
+
+    releaseFence();
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureUpload::isAvailable()
+{
+    // TODO: Remove this lock when it becomes unnecessary in C++11
+    Lock lock(mutex);
+
+    static bool available = checkTextureUploadsAvailable();
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureUpload::releaseFence() const
+{
+#ifndef SFML_OPENGL_ES
+
+    if (m_fence)
+    {
+        glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(m_fence)));
+        m_fence = NULL;
+    }
+
+#endif
+}
+
+} // namespace sf
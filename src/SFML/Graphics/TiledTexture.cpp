@@ -0,0 +1,582 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TiledTexture.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/ImageView.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/MemoryInputStream.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cmath>
+#include <csetjmp>
+extern "C"
+{
+    #include <jpeglib.h>
+}
+
+
+namespace
+{
+    // Number of rows decoded before they are uploaded to the tiles
+    const unsigned int stripHeight = 64;
+
+    // libjpeg source that reads from a sf::InputStream
+    struct JpegSource
+    {
+        jpeg_source_mgr  manager;
+        sf::InputStream* stream;
+        JOCTET           buffer[4096];
+    };
+    void initSource(j_decompress_ptr)
+    {
+    }
+    boolean fillInputBuffer(j_decompress_ptr decompressInfos)
+    {
+        JpegSource* source = reinterpret_cast<JpegSource*>(decompressInfos->src);
+        sf::Int64 count = source->stream->read(source->buffer, sizeof(source->buffer));
+
+        // Insert a fake end of image marker on premature end of file, libjpeg then emits a warning
+        if (count <= 0)
+        {
+            source->buffer[0] = 0xFF;
+            source->buffer[1] = JPEG_EOI;
+            count = 2;
+        }
+
+        source->manager.next_input_byte = source->buffer;
+        source->manager.bytes_in_buffer = static_cast<std::size_t>(count);
+        return TRUE;
+    }
+    void skipInputData(j_decompress_ptr decompressInfos, long count)
+    {
+        JpegSource* source = reinterpret_cast<JpegSource*>(decompressInfos->src);
+        if (count <= 0)
+            return;
+
+        if (static_cast<std::size_t>(count) <= source->manager.bytes_in_buffer)
+        {
+            source->manager.next_input_byte += count;
+            source->manager.bytes_in_buffer -= count;
+        }
+        else
+        {
+            // Skip the rest directly in the stream
+            source->stream->seek(source->stream->tell() + count - static_cast<sf::Int64>(source->manager.bytes_in_buffer));
+            source->manager.bytes_in_buffer = 0;
+        }
+    }
+    void termSource(j_decompress_ptr)
+    {
+    }
+
+    // libjpeg error manager that reports to sf::err() and aborts the decoding instead of the program
+    struct JpegError
+    {
+        jpeg_error_mgr manager;
+        std::jmp_buf   jump;
+    };
+    void outputMessage(j_common_ptr infos)
+    {
+        char message[JMSG_LENGTH_MAX];
+        (*infos->err->format_message)(infos, message);
+        sf::err() << "Failed to load JPEG tiles. Reason: " << message << std::endl;
+    }
+    void errorExit(j_common_ptr infos)
+    {
+        outputMessage(infos);
+        std::longjmp(reinterpret_cast<JpegError*>(infos->err)->jump, 1);
+    }
+
+    // Tell whether a stream starts with a JPEG signature, and rewind it
+    bool isJpeg(sf::InputStream& stream)
+    {
+        unsigned char signature[3] = {0, 0, 0};
+        bool result = (stream.seek(0) == 0) && (stream.read(signature, 3) == 3) &&
+                      (signature[0] == 0xFF) && (signature[1] == 0xD8) && (signature[2] == 0xFF);
+        stream.seek(0);
+        return result;
+    }
+
+    // Order tiles by the draw in which they were last used
+    struct LastUseComparator
+    {
+        LastUseComparator(const std::vector<unsigned int>& use) : lastUse(use) {}
+
+        bool operator ()(std::size_t left, std::size_t right) const
+        {
+            return lastUse[left] < lastUse[right];
+        }
+
+        const std::vector<unsigned int>& lastUse;
+    };
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TiledTexture::TiledTexture() :
+m_tiles        (),
+m_size         (0, 0),
+m_tileCount    (0, 0),
+m_tileSize     (0),
+m_smooth       (false),
+m_source       (),
+m_lastUse      (),
+m_drawCount    (0),
+m_residentCount(0),
+m_residentLimit(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool TiledTexture::loadFromFile(const std::string& filename, unsigned int tileSize)
+{
+    FileInputStream stream;
+    if (!stream.open(filename))
+    {
+        clear();
+        err() << "Failed to load tiled texture \"" << filename << "\", the file could not be opened" << std::endl;
+        return false;
+    }
+
+    return loadFromStream(stream, tileSize);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TiledTexture::loadFromMemory(const void* data, std::size_t size, unsigned int tileSize)
+{
+    MemoryInputStream stream;
+    stream.open(data, size);
+
+    return loadFromStream(stream, tileSize);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TiledTexture::loadFromStream(InputStream& stream, unsigned int tileSize)
+{
+    clear();
+
+    // Stream JPEG files into the tiles
+    if (isJpeg(stream))
+        return loadJpeg(stream, tileSize);
+
+    // Decode the other formats entirely, then split them
+    Vector2u size;
+    Uint8* pixels = priv::ImageLoader::getInstance().decodeImageFromStream(stream, size);
+    if (!pixels)
+        return false;
+
+    bool result = createTiles(size, tileSize, true);
+    if (result)
+    {
+        ImageView image(pixels, size.x, size.y);
+        for (unsigned int y = 0; y < m_tileCount.y; ++y)
+            updateTiles(image.getSubView(IntRect(0, y * m_tileSize, size.x, m_tileSize)), y * m_tileSize);
+    }
+
+    priv::ImageLoader::getInstance().releaseImage(pixels);
+    return result;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TiledTexture::loadFromImage(const ImageView& image, unsigned int tileSize, bool lazy)
+{
+    clear();
+
+    if ((image.getSize().x == 0) || (image.getSize().y == 0))
+    {
+        err() << "Failed to load tiled texture from an empty image" << std::endl;
+        return false;
+    }
+
+    if (!createTiles(image.getSize(), tileSize, !lazy))
+        return false;
+
+    if (lazy)
+    {
+        // The tiles will be uploaded when they are drawn
+        m_source = image;
+        m_lastUse.resize(m_tiles.size(), 0);
+    }
+    else
+    {
+        for (unsigned int y = 0; y < m_tileCount.y; ++y)
+            updateTiles(image.getSubView(IntRect(0, y * m_tileSize, m_size.x, m_tileSize)), y * m_tileSize);
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TiledTexture::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TiledTexture::getTileCount() const
+{
+    return m_tileCount;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& TiledTexture::getTile(unsigned int x, unsigned int y) const
+{
+    std::size_t index = x + y * m_tileCount.x;
+    makeResident(index);
+
+    return m_tiles[index];
+}
+
+
+////////////////////////////////////////////////////////////
+IntRect TiledTexture::getTileRect(unsigned int x, unsigned int y) const
+{
+    int left = x * m_tileSize;
+    int top  = y * m_tileSize;
+
+    return IntRect(left, top, std::min<int>(m_tileSize, m_size.x - left), std::min<int>(m_tileSize, m_size.y - top));
+}
+
+
+////////////////////////////////////////////////////////////
+void TiledTexture::setSmooth(bool smooth)
+{
+    m_smooth = smooth;
+
+    for (std::vector<Texture>::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
+        it->setSmooth(smooth);
+}
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+void TiledTexture::setResidentTileLimit(std::size_t limit)
+{
+    m_residentLimit = limit;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TiledTexture::getResidentTileLimit() const
+{
+    return m_residentLimit;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TiledTexture::getResidentTileCount() const
+{
+    return m_residentCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void TiledTexture::draw(RenderTarget& target, RenderStates states) const
+{
+    states.transform *= getTransform();
+
+    // Draw only the tiles that intersect the view
+    IntRect visible = findVisibleTiles(target.getView(), states.transform);
+    m_drawCount++;
+
+    for (int y = visible.top; y < visible.top + visible.height; ++y)
+    {
+        for (int x = visible.left; x < visible.left + visible.width; ++x)
+        {
+            std::size_t index = x + y * m_tileCount.x;
+            if (!makeResident(index))
+                continue;
+
+            if (!m_lastUse.empty())
+                m_lastUse[index] = m_drawCount;
+
+            IntRect rect = getTileRect(x, y);
+            float left   = static_cast<float>(rect.left);
+            float top    = static_cast<float>(rect.top);
+            float width  = static_cast<float>(rect.width);
+            float height = static_cast<float>(rect.height);
+
+            Vertex vertices[4] =
+            {
+                Vertex(Vector2f(left, top), Vector2f(0, 0)),
+                Vertex(Vector2f(left, top + height), Vector2f(0, height)),
+                Vertex(Vector2f(left + width, top), Vector2f(width, 0)),
+                Vertex(Vector2f(left + width, top + height), Vector2f(width, height))
+            };
+
+            states.texture = &m_tiles[index];
+            target.draw(vertices, 4, TrianglesStrip, states);
+        }
+    }
+
+    evictTiles();
+}
+
+
+////////////////////////////////////////////////////////////
+bool TiledTexture::createTiles(const Vector2u& size, unsigned int tileSize, bool allocate)
+{
+    unsigned int maximumSize = Texture::getMaximumSize();
+    if ((tileSize == 0) || (tileSize > maximumSize))
+        tileSize = maximumSize;
+
+    m_size      = size;
+    m_tileSize  = tileSize;
+    m_tileCount = Vector2u((size.x + tileSize - 1) / tileSize, (size.y + tileSize - 1) / tileSize);
+    m_tiles.resize(m_tileCount.x * m_tileCount.y);
+
+    if (!allocate)
+        return true;
+
+    for (unsigned int y = 0; y < m_tileCount.y; ++y)
+    {
+        for (unsigned int x = 0; x < m_tileCount.x; ++x)
+        {
+            IntRect rect = getTileRect(x, y);
+            if (!m_tiles[x + y * m_tileCount.x].create(rect.width, rect.height))
+            {
+                err() << "Failed to create tiled texture, a tile could not be created" << std::endl;
+                clear();
+                return false;
+            }
+
+            m_tiles[x + y * m_tileCount.x].setSmooth(m_smooth);
+        }
+    }
+
+    m_residentCount = m_tiles.size();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TiledTexture::updateTiles(const ImageView& strip, unsigned int top)
+{
+    unsigned int row = top / m_tileSize;
+    unsigned int offset = top - row * m_tileSize;
+
+    for (unsigned int x = 0; x < m_tileCount.x; ++x)
+    {
+        ImageView part = strip.getSubView(IntRect(x * m_tileSize, 0, m_tileSize, strip.getSize().y));
+        m_tiles[x + row * m_tileCount.x].update(part, 0, offset);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TiledTexture::makeResident(std::size_t index) const
+{
+    Texture& tile = m_tiles[index];
+    if ((tile.getSize().x > 0) || !m_source.getPixelsPtr())
+        return tile.getSize().x > 0;
+
+    // Upload the tile from the source pixels
+    IntRect rect = getTileRect(static_cast<unsigned int>(index % m_tileCount.x), static_cast<unsigned int>(index / m_tileCount.x));
+    if (!tile.loadFromImage(m_source.getSubView(rect)))
+        return false;
+
+    tile.setSmooth(m_smooth);
+    m_residentCount++;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TiledTexture::evictTiles() const
+{
+    if (!m_source.getPixelsPtr() || (m_residentLimit == 0) || (m_residentCount <= m_residentLimit))
+        return;
+
+    // Collect the resident tiles that were not drawn just now, oldest first
+    std::vector<std::size_t> candidates;
+    for (std::size_t i = 0; i < m_tiles.size(); ++i)
+    {
+        if ((m_tiles[i].getSize().x > 0) && (m_lastUse[i] != m_drawCount))
+            candidates.push_back(i);
+    }
+    std::sort(candidates.begin(), candidates.end(), LastUseComparator(m_lastUse));
+
+    // Release them until the limit is respected
+    for (std::vector<std::size_t>::const_iterator it = candidates.begin(); (it != candidates.end()) && (m_residentCount > m_residentLimit); ++it)
+    {
+        m_tiles[*it] = Texture();
+        m_residentCount--;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+IntRect TiledTexture::findVisibleTiles(const View& view, const Transform& transform) const
+{
+    if (m_tiles.empty())
+        return IntRect();
+
+    // Compute the area covered by the view, a rotated view is enlarged to its enclosing square
+    Vector2f size(std::fabs(view.getSize().x), std::fabs(view.getSize().y));
+    if (view.getRotation() != 0.f)
+    {
+        float diagonal = std::sqrt(size.x * size.x + size.y * size.y);
+        size = Vector2f(diagonal, diagonal);
+    }
+
+    // Bring it to the local coordinates of the tiles
+    FloatRect area = transform.getInverse().transformRect(FloatRect(view.getCenter() - size / 2.f, size));
+
+    // Convert it to a range of tiles, clamped before the conversion to avoid overflows
+    float tileSize = static_cast<float>(m_tileSize);
+    float columns  = static_cast<float>(m_tileCount.x);
+    float rows     = static_cast<float>(m_tileCount.y);
+    int left   = static_cast<int>(std::min(std::max(std::floor(area.left / tileSize), 0.f), columns));
+    int top    = static_cast<int>(std::min(std::max(std::floor(area.top / tileSize), 0.f), rows));
+    int right  = static_cast<int>(std::min(std::max(std::ceil((area.left + area.width) / tileSize), 0.f), columns));
+    int bottom = static_cast<int>(std::min(std::max(std::ceil((area.top + area.height) / tileSize), 0.f), rows));
+
+    if ((left >= right) || (top >= bottom))
+        return IntRect();
+
+    return IntRect(left, top, right - left, bottom - top);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TiledTexture::loadJpeg(InputStream& stream, unsigned int tileSize)
+{
+    // Everything that must survive an error is declared before setjmp
+    jpeg_decompress_struct decompressInfos;
+    JpegError errorManager;
+    JpegSource source;
+    std::vector<Uint8> row;
+    std::vector<Uint8> strip;
+
+    decompressInfos.err = jpeg_std_error(&errorManager.manager);
+    errorManager.manager.error_exit = &errorExit;
+    errorManager.manager.output_message = &outputMessage;
+    if (setjmp(errorManager.jump))
+    {
+        // libjpeg reported a fatal error
+        jpeg_destroy_decompress(&decompressInfos);
+        clear();
+        return false;
+    }
+
+    jpeg_create_decompress(&decompressInfos);
+
+    source.stream                    = &stream;
+    source.manager.init_source       = &initSource;
+    source.manager.fill_input_buffer = &fillInputBuffer;
+    source.manager.skip_input_data   = &skipInputData;
+    source.manager.resync_to_restart = &jpeg_resync_to_restart;
+    source.manager.term_source       = &termSource;
+    source.manager.bytes_in_buffer   = 0;
+    source.manager.next_input_byte   = NULL;
+    decompressInfos.src = &source.manager;
+
+    jpeg_read_header(&decompressInfos, TRUE);
+
+    // Let libjpeg convert to RGB, except for grayscale images which are expanded below
+    if ((decompressInfos.jpeg_color_space == JCS_CMYK) || (decompressInfos.jpeg_color_space == JCS_YCCK))
+    {
+        err() << "Failed to load JPEG tiles, CMYK images are not supported" << std::endl;
+        jpeg_destroy_decompress(&decompressInfos);
+        return false;
+    }
+    decompressInfos.out_color_space = decompressInfos.jpeg_color_space == JCS_GRAYSCALE ? JCS_GRAYSCALE : JCS_RGB;
+
+    jpeg_start_decompress(&decompressInfos);
+
+    unsigned int width      = decompressInfos.output_width;
+    unsigned int height     = decompressInfos.output_height;
+    unsigned int components = decompressInfos.output_components;
+    if (!createTiles(Vector2u(width, height), tileSize, true))
+    {
+        jpeg_destroy_decompress(&decompressInfos);
+        return false;
+    }
+
+    // Decode strips of rows, which never span two rows of tiles
+    row.resize(width * components);
+    strip.resize(width * std::min(stripHeight, m_tileSize) * 4);
+    while (decompressInfos.output_scanline < height)
+    {
+        unsigned int top = decompressInfos.output_scanline;
+        unsigned int rows = std::min(std::min(stripHeight, height - top), m_tileSize - top % m_tileSize);
+
+        for (unsigned int i = 0; i < rows; ++i)
+        {
+            JSAMPROW rawPointer = &row[0];
+            jpeg_read_scanlines(&decompressInfos, &rawPointer, 1);
+
+            // Expand to RGBA
+            Uint8* pixels = &strip[i * width * 4];
+            for (unsigned int x = 0; x < width; ++x)
+            {
+                const Uint8* pixel = &row[x * components];
+                pixels[x * 4 + 0] = pixel[0];
+                pixels[x * 4 + 1] = pixel[components == 3 ? 1 : 0];
+                pixels[x * 4 + 2] = pixel[components == 3 ? 2 : 0];
+                pixels[x * 4 + 3] = 255;
+            }
+        }
+
+        updateTiles(ImageView(&strip[0], width, rows), top);
+    }
+
+    jpeg_finish_decompress(&decompressInfos);
+    jpeg_destroy_decompress(&decompressInfos);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TiledTexture::clear()
+{
+    m_tiles.clear();
+    m_lastUse.clear();
+    m_source        = ImageView();
+    m_size          = Vector2u(0, 0);
+    m_tileCount     = Vector2u(0, 0);
+    m_tileSize      = 0;
+    m_residentCount = 0;
+}
+
+} // namespace sf
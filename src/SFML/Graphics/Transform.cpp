@@ -26,8 +26,17 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
 #include <cmath>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_TRANSFORM_SSE2
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define SFML_TRANSFORM_NEON
+#endif
+
 
 namespace sf
 {
@@ -109,6 +118,65 @@ Vector2f Transform::transformPoint(const Vector2f& point) const
 }
 
 
+////////////////////////////////////////////////////////////
+void Transform::transformPoints(const Vertex* input, Vertex* output, std::size_t count) const
+{
+    std::size_t i = 0;
+
+#if defined(SFML_TRANSFORM_SSE2)
+
+    // Two points per iteration: (x0, y0, x1, y1) -> (x0, x0, x1, x1) * (a, b, a, b) + (y0, y0, y1, y1) * (c, d, c, d) + (tx, ty, tx, ty)
+    const __m128 column0 = _mm_setr_ps(m_matrix[0], m_matrix[1], m_matrix[0], m_matrix[1]);
+    const __m128 column1 = _mm_setr_ps(m_matrix[4], m_matrix[5], m_matrix[4], m_matrix[5]);
+    const __m128 column3 = _mm_setr_ps(m_matrix[12], m_matrix[13], m_matrix[12], m_matrix[13]);
+
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128 points = _mm_setzero_ps();
+        points = _mm_loadl_pi(points, reinterpret_cast<const __m64*>(&input[i].position));
+        points = _mm_loadh_pi(points, reinterpret_cast<const __m64*>(&input[i + 1].position));
+
+        __m128 x = _mm_shuffle_ps(points, points, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 y = _mm_shuffle_ps(points, points, _MM_SHUFFLE(3, 3, 1, 1));
+        __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, column0), _mm_mul_ps(y, column1)), column3);
+
+        output[i].color         = input[i].color;
+        output[i].texCoords     = input[i].texCoords;
+        output[i + 1].color     = input[i + 1].color;
+        output[i + 1].texCoords = input[i + 1].texCoords;
+        _mm_storel_pi(reinterpret_cast<__m64*>(&output[i].position), result);
+        _mm_storeh_pi(reinterpret_cast<__m64*>(&output[i + 1].position), result);
+    }
+
+#elif defined(SFML_TRANSFORM_NEON)
+
+    // (x, y) -> (tx, ty) + (a, b) * x + (c, d) * y
+    const float32x2_t column0 = {m_matrix[0], m_matrix[1]};
+    const float32x2_t column1 = {m_matrix[4], m_matrix[5]};
+    const float32x2_t column3 = {m_matrix[12], m_matrix[13]};
+
+    for (; i < count; ++i)
+    {
+        float32x2_t point = vld1_f32(&input[i].position.x);
+        float32x2_t result = vmla_lane_f32(vmla_lane_f32(column3, column0, point, 0), column1, point, 1);
+
+        output[i].color     = input[i].color;
+        output[i].texCoords = input[i].texCoords;
+        vst1_f32(&output[i].position.x, result);
+    }
+
+#endif
+
+    // Remaining points, or all of them without SIMD support
+    for (; i < count; ++i)
+    {
+        output[i].position  = transformPoint(input[i].position);
+        output[i].color     = input[i].color;
+        output[i].texCoords = input[i].texCoords;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 FloatRect Transform::transformRect(const FloatRect& rectangle) const
 {
@@ -144,15 +212,76 @@ Transform& Transform::combine(const Transform& transform)
     const float* a = m_matrix;
     const float* b = transform.m_matrix;
 
-    *this = Transform(a[0] * b[0]  + a[4] * b[1]  + a[12] * b[3],
-                      a[0] * b[4]  + a[4] * b[5]  + a[12] * b[7],
-                      a[0] * b[12] + a[4] * b[13] + a[12] * b[15],
-                      a[1] * b[0]  + a[5] * b[1]  + a[13] * b[3],
-                      a[1] * b[4]  + a[5] * b[5]  + a[13] * b[7],
-                      a[1] * b[12] + a[5] * b[13] + a[13] * b[15],
-                      a[3] * b[0]  + a[7] * b[1]  + a[15] * b[3],
-                      a[3] * b[4]  + a[7] * b[5]  + a[15] * b[7],
-                      a[3] * b[12] + a[7] * b[13] + a[15] * b[15]);
+    // Projective matrices (such as the ones built by the 3x3 constructor) need the full product
+    if ((a[3] != 0.f) || (a[7] != 0.f) || (a[15] != 1.f) ||
+        (b[3] != 0.f) || (b[7] != 0.f) || (b[15] != 1.f))
+    {
+        *this = Transform(a[0] * b[0]  + a[4] * b[1]  + a[12] * b[3],
+                          a[0] * b[4]  + a[4] * b[5]  + a[12] * b[7],
+                          a[0] * b[12] + a[4] * b[13] + a[12] * b[15],
+                          a[1] * b[0]  + a[5] * b[1]  + a[13] * b[3],
+                          a[1] * b[4]  + a[5] * b[5]  + a[13] * b[7],
+                          a[1] * b[12] + a[5] * b[13] + a[13] * b[15],
+                          a[3] * b[0]  + a[7] * b[1]  + a[15] * b[3],
+                          a[3] * b[4]  + a[7] * b[5]  + a[15] * b[7],
+                          a[3] * b[12] + a[7] * b[13] + a[15] * b[15]);
+
+        return *this;
+    }
+
+    // Both matrices are affine: only the 2x2 linear part and the translation change,
+    // everything is read before being written in case the transform is combined with itself
+    float* result = m_matrix;
+
+#if defined(SFML_TRANSFORM_SSE2)
+
+    // (a0, a1, a0, a1) * (b0, b0, b4, b4) + (a4, a5, a4, a5) * (b1, b1, b5, b5) -> (r0, r1, r4, r5)
+    __m128 column0     = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(&a[0]));
+    __m128 column1     = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(&a[4]));
+    __m128 translation = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(&a[12]));
+    column0 = _mm_movelh_ps(column0, column0);
+    column1 = _mm_movelh_ps(column1, column1);
+
+    __m128 linear = _mm_add_ps(_mm_mul_ps(column0, _mm_setr_ps(b[0], b[0], b[4], b[4])),
+                               _mm_mul_ps(column1, _mm_setr_ps(b[1], b[1], b[5], b[5])));
+    translation = _mm_add_ps(_mm_add_ps(_mm_mul_ps(column0, _mm_set1_ps(b[12])),
+                                        _mm_mul_ps(column1, _mm_set1_ps(b[13]))), translation);
+
+    _mm_storel_pi(reinterpret_cast<__m64*>(&result[0]), linear);
+    _mm_storeh_pi(reinterpret_cast<__m64*>(&result[4]), linear);
+    _mm_storel_pi(reinterpret_cast<__m64*>(&result[12]), translation);
+
+#elif defined(SFML_TRANSFORM_NEON)
+
+    float32x2_t column0     = vld1_f32(&a[0]);
+    float32x2_t column1     = vld1_f32(&a[4]);
+    float32x2_t translation = vld1_f32(&a[12]);
+
+    float32x2_t resultColumn0 = vmla_n_f32(vmul_n_f32(column0, b[0]), column1, b[1]);
+    float32x2_t resultColumn1 = vmla_n_f32(vmul_n_f32(column0, b[4]), column1, b[5]);
+    translation = vadd_f32(vmla_n_f32(vmul_n_f32(column0, b[12]), column1, b[13]), translation);
+
+    vst1_f32(&result[0], resultColumn0);
+    vst1_f32(&result[4], resultColumn1);
+    vst1_f32(&result[12], translation);
+
+#else
+
+    float r0  = a[0] * b[0]  + a[4] * b[1];
+    float r1  = a[1] * b[0]  + a[5] * b[1];
+    float r4  = a[0] * b[4]  + a[4] * b[5];
+    float r5  = a[1] * b[4]  + a[5] * b[5];
+    float r12 = a[0] * b[12] + a[4] * b[13] + a[12];
+    float r13 = a[1] * b[12] + a[5] * b[13] + a[13];
+
+    result[0]  = r0;
+    result[1]  = r1;
+    result[4]  = r4;
+    result[5]  = r5;
+    result[12] = r12;
+    result[13] = r13;
+
+#endif
 
     return *this;
 }
@@ -161,11 +290,12 @@ Transform& Transform::combine(const Transform& transform)
 ////////////////////////////////////////////////////////////
 Transform& Transform::translate(float x, float y)
 {
-    Transform translation(1, 0, x,
-                          0, 1, y,
-                          0, 0, 1);
+    // Same as combining with a translation matrix, without the multiplications by 0 and 1
+    m_matrix[12] += m_matrix[0] * x + m_matrix[4] * y;
+    m_matrix[13] += m_matrix[1] * x + m_matrix[5] * y;
+    m_matrix[15] += m_matrix[3] * x + m_matrix[7] * y;
 
-    return combine(translation);
+    return *this;
 }
 
 
@@ -216,11 +346,12 @@ Transform& Transform::rotate(float angle, const Vector2f& center)
 ////////////////////////////////////////////////////////////
 Transform& Transform::scale(float scaleX, float scaleY)
 {
-    Transform scaling(scaleX, 0,      0,
-                      0,      scaleY, 0,
-                      0,      0,      1);
+    // Same as combining with a scaling matrix, without the multiplications by 0 and 1
+    m_matrix[0] *= scaleX; m_matrix[4] *= scaleY;
+    m_matrix[1] *= scaleX; m_matrix[5] *= scaleY;
+    m_matrix[3] *= scaleX; m_matrix[7] *= scaleY;
 
-    return combine(scaling);
+    return *this;
 }
 
 
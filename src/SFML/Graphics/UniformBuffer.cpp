@@ -0,0 +1,386 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/UniformBuffer.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace
+{
+    // Round a size or an offset up to a multiple of an alignment
+    std::size_t alignUp(std::size_t value, std::size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+UniformBuffer::Layout::Layout() :
+m_size(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t UniformBuffer::Layout::add(Type type, std::size_t count)
+{
+    // Base alignment and size of the type, as defined by the std140 rules
+    std::size_t alignment = 16;
+    std::size_t size      = 16;
+    switch (type)
+    {
+        case Float: alignment = 4;  size = 4;  break;
+        case Vec2:  alignment = 8;  size = 8;  break;
+        case Vec3:  alignment = 16; size = 12; break;
+        case Vec4:  alignment = 16; size = 16; break;
+        case Mat4:  alignment = 16; size = 64; break;
+    }
+
+    // The elements of arrays are aligned like vec4
+    if (count > 1)
+    {
+        alignment = 16;
+        size = alignUp(size, 16) * count;
+    }
+
+    std::size_t offset = alignUp(m_size, alignment);
+    m_size = offset + size;
+
+    return offset;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t UniformBuffer::Layout::getSize() const
+{
+    // The block is padded to a multiple of the size of a vec4
+    return alignUp(m_size, 16);
+}
+
+} // namespace sf
+
+
+#ifndef SFML_OPENGL_ES
+
+namespace
+{
+    sf::Mutex mutex;
+
+    bool checkUniformBuffersAvailable()
+    {
+        // Create a temporary context in case the user checks
+        // before a GlResource is created, thus initializing
+        // the shared context
+        sf::Context context;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        return GLEXT_vertex_buffer_object && GLEXT_uniform_buffer_object;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+UniformBuffer::UniformBuffer() :
+m_buffer   (0),
+m_size     (0),
+m_gpuMemory(GpuMemory::Buffers)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+UniformBuffer::~UniformBuffer()
+{
+    if (m_buffer)
+    {
+        ensureGlContext();
+
+        GLuint buffer = static_cast<GLuint>(m_buffer);
+        glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::create(std::size_t size)
+{
+    if (!isAvailable())
+    {
+        err() << "Failed to create uniform buffer: your system doesn't support uniform buffers "
+              << "(you should test UniformBuffer::isAvailable() before trying to use the UniformBuffer class)" << std::endl;
+        return false;
+    }
+
+    ensureGlContext();
+
+    if (!m_buffer)
+    {
+        GLuint buffer = 0;
+        glCheck(GLEXT_glGenBuffers(1, &buffer));
+        m_buffer = static_cast<unsigned int>(buffer);
+    }
+
+    if (!m_buffer)
+    {
+        err() << "Could not create uniform buffer, generation failed" << std::endl;
+        return false;
+    }
+
+    // The buffer is typically updated every frame
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_UNIFORM_BUFFER, m_buffer));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_UNIFORM_BUFFER, size, NULL, GLEXT_GL_DYNAMIC_DRAW));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_UNIFORM_BUFFER, 0));
+
+    m_size = size;
+    m_gpuMemory.setBytes(size);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t UniformBuffer::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::update(std::size_t offset, const void* data, std::size_t size)
+{
+    // Sanity checks
+    if (!m_buffer)
+        return false;
+
+    if (!data)
+        return false;
+
+    if (offset + size > m_size)
+    {
+        err() << "Failed to update uniform buffer, the data doesn't fit in the buffer" << std::endl;
+        return false;
+    }
+
+    ensureGlContext();
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_UNIFORM_BUFFER, m_buffer));
+    glCheck(GLEXT_glBufferSubData(GLEXT_GL_UNIFORM_BUFFER, offset, size, data));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_UNIFORM_BUFFER, 0));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::update(std::size_t offset, float x)
+{
+    return update(offset, &x, sizeof(x));
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::update(std::size_t offset, const Vector2f& vector)
+{
+    float values[2] = {vector.x, vector.y};
+    return update(offset, values, sizeof(values));
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::update(std::size_t offset, const Vector3f& vector)
+{
+    float values[3] = {vector.x, vector.y, vector.z};
+    return update(offset, values, sizeof(values));
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::update(std::size_t offset, const Color& color)
+{
+    float values[4] = {color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f};
+    return update(offset, values, sizeof(values));
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::update(std::size_t offset, const Transform& transform)
+{
+    // std140 matrices are column-major, like the OpenGL matrix of the transform
+    return update(offset, transform.getMatrix(), 16 * sizeof(float));
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setDebugName(const std::string& name)
+{
+    m_gpuMemory.setName(name);
+}
+
+
+////////////////////////////////////////////////////////////
+std::string UniformBuffer::getDebugName() const
+{
+    return m_gpuMemory.getName();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int UniformBuffer::getNativeHandle() const
+{
+    return m_buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::isAvailable()
+{
+    // TODO: Remove this lock when it becomes unnecessary in C++11
+    Lock lock(mutex);
+
+    static bool available = checkUniformBuffersAvailable();
+
+    return available;
+}
+
+} // namespace sf
+
+#else // SFML_OPENGL_ES
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+UniformBuffer::UniformBuffer() :
+m_buffer   (0),
+m_size     (0),
+m_gpuMemory(GpuMemory::Buffers)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+UniformBuffer::~UniformBuffer()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::create(std::size_t)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t UniformBuffer::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::update(std::size_t, const void*, std::size_t)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::update(std::size_t, float)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::update(std::size_t, const Vector2f&)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::update(std::size_t, const Vector3f&)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::update(std::size_t, const Color&)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::update(std::size_t, const Transform&)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::setDebugName(const std::string& name)
+{
+    m_gpuMemory.setName(name);
+}
+
+
+////////////////////////////////////////////////////////////
+std::string UniformBuffer::getDebugName() const
+{
+    return m_gpuMemory.getName();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int UniformBuffer::getNativeHandle() const
+{
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::isAvailable()
+{
+    return false;
+}
+
+} // namespace sf
+
+#endif // SFML_OPENGL_ES
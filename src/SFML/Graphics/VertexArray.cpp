@@ -143,8 +143,14 @@ FloatRect VertexArray::getBounds() const
 ////////////////////////////////////////////////////////////
 void VertexArray::draw(RenderTarget& target, RenderStates states) const
 {
-    if (!m_vertices.empty())
-        target.draw(&m_vertices[0], m_vertices.size(), m_primitiveType, states);
+    if (m_vertices.empty())
+        return;
+
+    // The bounds are not cached (vertices can be modified directly), only compute them if needed
+    if (target.isCullingEnabled() && target.cull(getBounds(), states.transform))
+        return;
+
+    target.draw(&m_vertices[0], m_vertices.size(), m_primitiveType, states);
 }
 
 } // namespace sf
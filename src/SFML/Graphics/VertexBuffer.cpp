@@ -0,0 +1,314 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace
+{
+    sf::Mutex mutex;
+
+    bool checkVertexBuffersAvailable()
+    {
+        // Create a temporary context in case the user checks
+        // before a GlResource is created, thus initializing
+        // the shared context
+        sf::Context context;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        return GLEXT_vertex_buffer_object;
+    }
+
+    GLenum usageToGlEnum(sf::VertexBuffer::Usage usage)
+    {
+        switch (usage)
+        {
+            case sf::VertexBuffer::Static:  return GLEXT_GL_STATIC_DRAW;
+            case sf::VertexBuffer::Dynamic: return GLEXT_GL_DYNAMIC_DRAW;
+            default:                        return GLEXT_GL_STREAM_DRAW;
+        }
+    }
+
+    std::size_t vertexSize(sf::VertexBuffer::Layout layout)
+    {
+        return (layout == sf::VertexBuffer::Compact) ? sizeof(sf::CompactVertex) : sizeof(sf::Vertex);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+VertexBuffer::VertexBuffer() :
+m_buffer       (0),
+m_size         (0),
+m_primitiveType(Points),
+m_usage        (Stream),
+m_layout       (Standard),
+m_gpuMemory    (GpuMemory::Buffers)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+VertexBuffer::VertexBuffer(PrimitiveType type, Usage usage, Layout layout) :
+m_buffer       (0),
+m_size         (0),
+m_primitiveType(type),
+m_usage        (usage),
+m_layout       (layout),
+m_gpuMemory    (GpuMemory::Buffers)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+VertexBuffer::~VertexBuffer()
+{
+    if (m_buffer)
+    {
+        ensureGlContext();
+
+        GLuint buffer = static_cast<GLuint>(m_buffer);
+        glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::create(std::size_t vertexCount)
+{
+    if (!isAvailable())
+        return false;
+
+    ensureGlContext();
+
+    if (!m_buffer)
+    {
+        GLuint buffer = 0;
+        glCheck(GLEXT_glGenBuffers(1, &buffer));
+        m_buffer = static_cast<unsigned int>(buffer);
+    }
+
+    if (!m_buffer)
+    {
+        err() << "Could not create vertex buffer, generation failed" << std::endl;
+        return false;
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, vertexSize(m_layout) * vertexCount, NULL, usageToGlEnum(m_usage)));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+    m_size = vertexCount;
+    m_gpuMemory.setBytes(vertexSize(m_layout) * vertexCount);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VertexBuffer::getVertexCount() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::update(const Vertex* vertices)
+{
+    return update(vertices, m_size, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::update(const Vertex* vertices, std::size_t vertexCount, unsigned int offset)
+{
+    return updateData(vertices, vertexCount, offset, Standard);
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::update(const CompactVertex* vertices)
+{
+    return update(vertices, m_size, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::update(const CompactVertex* vertices, std::size_t vertexCount, unsigned int offset)
+{
+    return updateData(vertices, vertexCount, offset, Compact);
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::setLayout(Layout layout)
+{
+    m_layout = layout;
+}
+
+
+////////////////////////////////////////////////////////////
+VertexBuffer::Layout VertexBuffer::getLayout() const
+{
+    return m_layout;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::setDebugName(const std::string& name)
+{
+    m_gpuMemory.setName(name);
+}
+
+
+////////////////////////////////////////////////////////////
+std::string VertexBuffer::getDebugName() const
+{
+    return m_gpuMemory.getName();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int VertexBuffer::getNativeHandle() const
+{
+    return m_buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::setPrimitiveType(PrimitiveType type)
+{
+    m_primitiveType = type;
+}
+
+
+////////////////////////////////////////////////////////////
+PrimitiveType VertexBuffer::getPrimitiveType() const
+{
+    return m_primitiveType;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::setUsage(Usage usage)
+{
+    m_usage = usage;
+}
+
+
+////////////////////////////////////////////////////////////
+VertexBuffer::Usage VertexBuffer::getUsage() const
+{
+    return m_usage;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::bind(const VertexBuffer* vertexBuffer)
+{
+    if (!isAvailable())
+        return;
+
+    ensureGlContext();
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, vertexBuffer ? vertexBuffer->m_buffer : 0));
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::isAvailable()
+{
+    // TODO: Remove this lock when it becomes unnecessary in C++11
+    Lock lock(mutex);
+
+    static bool available = checkVertexBuffersAvailable();
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_buffer && m_size)
+        target.draw(*this, 0, m_size, states);
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::updateData(const void* vertices, std::size_t vertexCount, unsigned int offset, Layout layout)
+{
+    // Sanity checks
+    if (!m_buffer)
+        return false;
+
+    if (!vertices)
+        return false;
+
+    if (offset && (offset + vertexCount > m_size))
+        return false;
+
+    if (layout != m_layout)
+    {
+        err() << "Failed to update vertex buffer, the vertices don't match its layout" << std::endl;
+        return false;
+    }
+
+    ensureGlContext();
+
+    std::size_t size = vertexSize(m_layout);
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+
+    // Check if we need to enlarge the buffer
+    if (vertexCount > m_size)
+    {
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, size * vertexCount, NULL, usageToGlEnum(m_usage)));
+
+        m_size = vertexCount;
+        m_gpuMemory.setBytes(size * vertexCount);
+    }
+
+    glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, size * offset, size * vertexCount, vertices));
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+    return true;
+}
+
+} // namespace sf
@@ -0,0 +1,302 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/VertexRingBuffer.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+
+
+#ifndef SFML_OPENGL_ES
+
+namespace
+{
+    sf::Mutex mutex;
+
+    bool checkRingBuffersAvailable()
+    {
+        if (!sf::VertexBuffer::isAvailable())
+            return false;
+
+        // Create a temporary context in case the user checks
+        // before a GlResource is created, thus initializing
+        // the shared context
+        sf::Context context;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        return GLEXT_buffer_storage && GLEXT_map_buffer_range && GLEXT_sync;
+    }
+
+    // Both the buffer storage and its mapping must use these flags
+    const GLbitfield mappingFlags = GLEXT_GL_MAP_WRITE_BIT | GLEXT_GL_MAP_PERSISTENT_BIT | GLEXT_GL_MAP_COHERENT_BIT;
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+VertexRingBuffer::VertexRingBuffer() :
+m_buffer  (0),
+m_vertices(NULL),
+m_segment (0),
+m_cursor  (0),
+m_failed  (false)
+{
+    for (int i = 0; i < SegmentCount; ++i)
+        m_fences[i] = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+VertexRingBuffer::~VertexRingBuffer()
+{
+    if (!m_buffer)
+        return;
+
+    ensureGlContext();
+
+    for (int i = 0; i < SegmentCount; ++i)
+    {
+        if (m_fences[i])
+        {
+            glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(m_fences[i])));
+        }
+    }
+
+    // Deleting the buffer also unmaps it
+    GLuint buffer = static_cast<GLuint>(m_buffer);
+    glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+}
+
+
+////////////////////////////////////////////////////////////
+Vertex* VertexRingBuffer::allocate(std::size_t vertexCount, std::size_t& firstVertex)
+{
+    if (vertexCount > SegmentSize)
+        return NULL;
+
+    if (!m_vertices && !create())
+        return NULL;
+
+    if (vertexCount > getRemaining())
+        nextSegment();
+
+    firstVertex = m_cursor;
+    m_cursor += vertexCount;
+
+    return m_vertices + firstVertex;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VertexRingBuffer::getRemaining() const
+{
+    return (m_segment + 1) * SegmentSize - m_cursor;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexRingBuffer::bind(const VertexRingBuffer* buffer)
+{
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, buffer ? buffer->m_buffer : 0));
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexRingBuffer::isAvailable()
+{
+    // TODO: Remove this lock when it becomes unnecessary in C++11
+    Lock lock(mutex);
+
+    static bool available = checkRingBuffersAvailable();
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexRingBuffer::create()
+{
+    // Don't retry on every draw if something went wrong once
+    if (m_failed || !isAvailable())
+        return false;
+
+    m_failed = true;
+
+    ensureGlContext();
+
+    GLuint buffer = 0;
+    glCheck(GLEXT_glGenBuffers(1, &buffer));
+    if (!buffer)
+    {
+        err() << "Failed to create vertex streaming buffer" << std::endl;
+        return false;
+    }
+
+    GLsizeiptr size = static_cast<GLsizeiptr>(sizeof(Vertex) * SegmentSize * SegmentCount);
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, buffer));
+    glCheck(GLEXT_glBufferStorage(GLEXT_GL_ARRAY_BUFFER, size, NULL, mappingFlags));
+    void* data = glCheck(GLEXT_glMapBufferRange(GLEXT_GL_ARRAY_BUFFER, 0, size, mappingFlags));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+    if (!data)
+    {
+        err() << "Failed to map vertex streaming buffer" << std::endl;
+        glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+        return false;
+    }
+
+    m_buffer   = static_cast<unsigned int>(buffer);
+    m_vertices = static_cast<Vertex*>(data);
+    m_segment  = 0;
+    m_cursor   = 0;
+    m_failed   = false;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexRingBuffer::nextSegment()
+{
+    // Protect the segment that was just filled until the GPU is done with it
+    m_fences[m_segment] = glCheck(GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+    m_segment = (m_segment + 1) % SegmentCount;
+    m_cursor = m_segment * SegmentSize;
+
+    // Wait until the GPU no longer reads the segment that we are going to overwrite
+    if (m_fences[m_segment])
+    {
+        GLEXT_GLsync fence = static_cast<GLEXT_GLsync>(m_fences[m_segment]);
+
+        // Flush the pending commands on the first try only, otherwise the
+        // fence might never be signaled; wait by steps of one millisecond
+        GLbitfield flags = GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT;
+        for (;;)
+        {
+            GLenum status = glCheck(GLEXT_glClientWaitSync(fence, flags, 1000000));
+            if ((status == GLEXT_GL_ALREADY_SIGNALED) || (status == GLEXT_GL_CONDITION_SATISFIED))
+                break;
+
+            if (status == GLEXT_GL_WAIT_FAILED)
+            {
+                err() << "Failed to wait for vertex streaming fence" << std::endl;
+                break;
+            }
+
+            flags = 0;
+        }
+
+        glCheck(GLEXT_glDeleteSync(fence));
+        m_fences[m_segment] = NULL;
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#else // SFML_OPENGL_ES
+
+// OpenGL ES 1 doesn't support persistent buffer mappings, vertices are always sent from client memory
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+VertexRingBuffer::VertexRingBuffer() :
+m_buffer  (0),
+m_vertices(NULL),
+m_segment (0),
+m_cursor  (0),
+m_failed  (true)
+{
+    for (int i = 0; i < SegmentCount; ++i)
+        m_fences[i] = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+VertexRingBuffer::~VertexRingBuffer()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Vertex* VertexRingBuffer::allocate(std::size_t, std::size_t&)
+{
+    return NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VertexRingBuffer::getRemaining() const
+{
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexRingBuffer::bind(const VertexRingBuffer*)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexRingBuffer::isAvailable()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexRingBuffer::create()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexRingBuffer::nextSegment()
+{
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#endif // SFML_OPENGL_ES
@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_VERTEXRINGBUFFER_HPP
+#define SFML_VERTEXRINGBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Persistently mapped buffer used to stream vertices
+///        to the graphics card
+///
+/// The buffer is split in several segments which are filled
+/// one after the other. When the writer moves to the next
+/// segment, a fence is inserted after the commands that read
+/// the previous one, and the writer waits for the fence of
+/// the segment it is about to overwrite so that the GPU is
+/// never reading memory that is being written.
+///
+////////////////////////////////////////////////////////////
+class VertexRingBuffer : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The buffer is created on first allocation.
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexRingBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~VertexRingBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate space for vertices in the mapped memory
+    ///
+    /// The returned memory stays valid until the vertices have
+    /// been drawn, and must only be written to. This function
+    /// may have to wait for the GPU if the next segment is still
+    /// in use. It requires an active OpenGL context.
+    ///
+    /// \param vertexCount Number of vertices to allocate
+    /// \param firstVertex Receives the index of the first vertex in the buffer
+    ///
+    /// \return Pointer to the allocated vertices, or NULL if streaming is unavailable
+    ///         or \a vertexCount exceeds the size of a segment
+    ///
+    ////////////////////////////////////////////////////////////
+    Vertex* allocate(std::size_t vertexCount, std::size_t& firstVertex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of vertices that can be allocated
+    ///        without moving to the next segment
+    ///
+    /// Consecutive allocations are contiguous as long as they
+    /// fit in the remaining space.
+    ///
+    /// \return Number of vertices left in the current segment
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getRemaining() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a ring buffer as the current vertex buffer
+    ///
+    /// \param buffer Pointer to the ring buffer to bind, can be null to unbind
+    ///
+    ////////////////////////////////////////////////////////////
+    static void bind(const VertexRingBuffer* buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the system supports persistently
+    ///        mapped buffers
+    ///
+    /// Streaming requires the ARB_buffer_storage, ARB_map_buffer_range
+    /// and ARB_sync extensions.
+    ///
+    /// \return True if vertex streaming is supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create and map the buffer storage
+    ///
+    /// \return True on success
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Fence the current segment and move to the next one
+    ///
+    ////////////////////////////////////////////////////////////
+    void nextSegment();
+
+    ////////////////////////////////////////////////////////////
+    // Constants
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        SegmentCount = 3,    ///< Number of segments, one being written while the GPU reads the others
+        SegmentSize  = 16384 ///< Number of vertices in each segment
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int m_buffer;               ///< OpenGL identifier of the buffer
+    Vertex*      m_vertices;             ///< Mapped storage of the buffer
+    void*        m_fences[SegmentCount]; ///< Fences protecting each segment, if any
+    std::size_t  m_segment;              ///< Index of the segment being written
+    std::size_t  m_cursor;               ///< Index of the next vertex to allocate
+    bool         m_failed;               ///< Did the creation of the buffer fail?
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_VERTEXRINGBUFFER_HPP
@@ -0,0 +1,317 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/VideoTexture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <cstring>
+
+
+namespace
+{
+    // Convert the packed planes: each RGBA texel of a plane holds four
+    // consecutive samples of a row, the vertices give the pixel coordinates
+    const char* conversionShader =
+        "uniform sampler2D planeY;\n"
+        "uniform sampler2D planeU;\n"
+        "uniform sampler2D planeV;\n"
+        "uniform vec2 sizeY;\n"
+        "uniform vec2 sizeUV;\n"
+        "\n"
+        "float fetch(sampler2D plane, vec2 size, vec2 pixel)\n"
+        "{\n"
+        "    float texel = floor(pixel.x / 4.0);\n"
+        "    float index = pixel.x - texel * 4.0;\n"
+        "    vec4 samples = texture2D(plane, (vec2(texel, pixel.y) + 0.5) / size);\n"
+        "    return index < 0.5 ? samples.r : (index < 1.5 ? samples.g : (index < 2.5 ? samples.b : samples.a));\n"
+        "}\n"
+        "\n"
+        "void main()\n"
+        "{\n"
+        "    vec2 pixel = floor(gl_TexCoord[0].xy);\n"
+        "    float y = 1.164 * (fetch(planeY, sizeY, pixel) - 0.0625);\n"
+        "    float u = fetch(planeU, sizeUV, floor(pixel / 2.0)) - 0.5;\n"
+        "    float v = fetch(planeV, sizeUV, floor(pixel / 2.0)) - 0.5;\n"
+        "    gl_FragColor = vec4(y + 1.596 * v, y - 0.391 * u - 0.813 * v, y + 2.018 * u, 1.0);\n"
+        "}\n";
+
+    // Copy a plane into its staging memory, whose rows are padded to a multiple of four samples
+    void stagePlane(sf::TextureUpload& upload, const sf::Uint8* samples, const sf::Vector2u& size)
+    {
+        sf::Uint8* pixels = upload.lock();
+        if (!pixels)
+            return;
+
+        std::size_t pitch = upload.getSize().x * 4;
+        for (unsigned int row = 0; row < size.y; ++row)
+            std::memcpy(pixels + row * pitch, samples + row * size.x, size.x);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+VideoTexture::VideoTexture() :
+m_thread    (&VideoTexture::decode, this),
+m_mutex     (),
+m_freed     (),
+m_size      (),
+m_chromaSize(),
+m_buffers   (),
+m_free      (),
+m_decoded   (),
+m_shader    (),
+m_target    (),
+m_playing   (false),
+m_stop      (false),
+m_finished  (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+VideoTexture::~VideoTexture()
+{
+    for (std::vector<Buffer*>::iterator it = m_buffers.begin(); it != m_buffers.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VideoTexture::create(unsigned int width, unsigned int height, unsigned int bufferedFrames)
+{
+    stop();
+
+    if (!isAvailable())
+    {
+        err() << "Failed to create video texture, your system doesn't support shaders "
+              << "(you should test VideoTexture::isAvailable() before trying to use the VideoTexture class)" << std::endl;
+        return false;
+    }
+
+    Vector2u chromaSize((width + 1) / 2, (height + 1) / 2);
+
+    // Four samples are packed in each texel of the planes
+    Vector2u sizes[3] = {Vector2u((width + 3) / 4, height),
+                         Vector2u((chromaSize.x + 3) / 4, chromaSize.y),
+                         Vector2u((chromaSize.x + 3) / 4, chromaSize.y)};
+    for (int i = 0; i < 3; ++i)
+    {
+        if (!m_planes[i].create(sizes[i].x, sizes[i].y) || !m_uploads[i].create(sizes[i].x, sizes[i].y))
+        {
+            err() << "Failed to create video texture, the planes of the video can't be created" << std::endl;
+            return false;
+        }
+    }
+
+    if (!m_target.create(width, height) || !m_shader.loadFromMemory(conversionShader, Shader::Fragment))
+    {
+        err() << "Failed to create video texture, the color conversion can't be set up" << std::endl;
+        return false;
+    }
+
+    // The texture sizes are the ones of the underlying OpenGL textures, which may be padded
+    m_shader.setParameter("planeY", m_planes[0]);
+    m_shader.setParameter("planeU", m_planes[1]);
+    m_shader.setParameter("planeV", m_planes[2]);
+    m_shader.setParameter("sizeY", Vector2f(m_planes[0].m_actualSize));
+    m_shader.setParameter("sizeUV", Vector2f(m_planes[1].m_actualSize));
+
+    m_size       = Vector2u(width, height);
+    m_chromaSize = chromaSize;
+
+    // Allocate the frames once, they are recycled while playing
+    for (std::vector<Buffer*>::iterator it = m_buffers.begin(); it != m_buffers.end(); ++it)
+        delete *it;
+    m_buffers.clear();
+
+    std::size_t lumaSize = width * height;
+    std::size_t chromaPlaneSize = chromaSize.x * chromaSize.y;
+    for (unsigned int i = 0; i < (bufferedFrames > 0 ? bufferedFrames : 1); ++i)
+    {
+        Buffer* buffer = new Buffer;
+        buffer->pixels.resize(lumaSize + chromaPlaneSize * 2);
+        buffer->frame.y = &buffer->pixels[0];
+        buffer->frame.u = buffer->frame.y + lumaSize;
+        buffer->frame.v = buffer->frame.u + chromaPlaneSize;
+        m_buffers.push_back(buffer);
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void VideoTexture::play()
+{
+    if (m_playing || m_buffers.empty())
+        return;
+
+    m_free.assign(m_buffers.begin(), m_buffers.end());
+    m_decoded.clear();
+    m_stop     = false;
+    m_finished = false;
+    m_playing  = true;
+
+    m_thread.launch();
+}
+
+
+////////////////////////////////////////////////////////////
+void VideoTexture::stop()
+{
+    if (!m_playing)
+        return;
+
+    {
+        Lock lock(m_mutex);
+        m_stop = true;
+        m_freed.notifyAll();
+    }
+    m_thread.wait();
+
+    m_free.clear();
+    m_decoded.clear();
+    m_playing = false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VideoTexture::update(Time offset)
+{
+    Buffer* buffer = NULL;
+    {
+        Lock lock(m_mutex);
+
+        // Take the latest frame that is due, and recycle the ones it replaces
+        while (!m_decoded.empty() && (m_decoded.front()->frame.timestamp <= offset))
+        {
+            if (buffer)
+                m_free.push_back(buffer);
+
+            buffer = m_decoded.front();
+            m_decoded.pop_front();
+        }
+    }
+
+    if (!buffer)
+        return false;
+
+    show(buffer->frame);
+
+    Lock lock(m_mutex);
+    m_free.push_back(buffer);
+    m_freed.notifyAll();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VideoTexture::isFinished() const
+{
+    Lock lock(m_mutex);
+
+    return m_finished && m_decoded.empty();
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& VideoTexture::getTexture() const
+{
+    return m_target.getTexture();
+}
+
+
+////////////////////////////////////////////////////////////
+bool VideoTexture::isAvailable()
+{
+    return Shader::isAvailable();
+}
+
+
+////////////////////////////////////////////////////////////
+void VideoTexture::decode()
+{
+    for (;;)
+    {
+        Buffer* buffer = NULL;
+        {
+            Lock lock(m_mutex);
+
+            while (m_free.empty() && !m_stop)
+                m_freed.wait(m_mutex);
+
+            if (m_stop)
+                return;
+
+            buffer = m_free.front();
+            m_free.pop_front();
+        }
+
+        // Decode outside the lock, so that the render thread can take the decoded frames meanwhile
+        bool decoded = onGetFrame(buffer->frame);
+
+        Lock lock(m_mutex);
+        if (!decoded)
+        {
+            m_free.push_back(buffer);
+            m_finished = true;
+            return;
+        }
+
+        m_decoded.push_back(buffer);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VideoTexture::show(const Frame& frame)
+{
+    // Stage the planes and let the graphics card copy them, without waiting
+    stagePlane(m_uploads[0], frame.y, m_size);
+    stagePlane(m_uploads[1], frame.u, m_chromaSize);
+    stagePlane(m_uploads[2], frame.v, m_chromaSize);
+    for (int i = 0; i < 3; ++i)
+        m_planes[i].updateAsync(m_uploads[i], 0, 0);
+
+    // Convert the whole frame with a single triangle, its texture coordinates are the pixel coordinates
+    Vector2f size(m_size);
+    Vertex vertices[3] =
+    {
+        Vertex(Vector2f(0.f, 0.f),          Vector2f(0.f, 0.f)),
+        Vertex(Vector2f(2.f * size.x, 0.f), Vector2f(2.f * size.x, 0.f)),
+        Vertex(Vector2f(0.f, 2.f * size.y), Vector2f(0.f, 2.f * size.y))
+    };
+
+    m_target.draw(vertices, 3, Triangles, RenderStates(BlendNone, Transform::Identity, NULL, &m_shader));
+    m_target.display();
+}
+
+} // namespace sf
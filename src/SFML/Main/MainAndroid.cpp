@@ -349,7 +349,7 @@ static void onInputQueueCreated(ANativeActivity* activity, AInputQueue* queue)
 
     // Attach the input queue
     {
-        sf::Lock lock(states->mutex);
+        sf::Lock lock(states->inputMutex);
 
         AInputQueue_attachLooper(queue, states->looper, 1, states->processEvent, NULL);
         states->inputQueue = queue;
@@ -365,7 +365,7 @@ static void onInputQueueDestroyed(ANativeActivity* activity, AInputQueue* queue)
 
     // Detach the input queue
     {
-        sf::Lock lock(states->mutex);
+        sf::Lock lock(states->inputMutex);
 
         states->inputQueue = NULL;
         AInputQueue_detachLooper(queue);
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/ChunkedDecoder.hpp>
+#include <algorithm>
+#include <sstream>
+
+
+namespace
+{
+    // Longest line accepted, to protect against malformed bodies
+    const std::size_t maxLineSize = 8192;
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+ChunkedDecoder::ChunkedDecoder() :
+m_state       (ChunkSize),
+m_remaining   (0),
+m_hasExtraData(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool ChunkedDecoder::decode(const char* data, std::size_t size, Http::ResponseHandler& handler)
+{
+    const char* end = data + size;
+    while ((data < end) && (m_state != Complete))
+    {
+        if (m_state == ChunkData)
+        {
+            // Give the chunk data to the handler directly
+            std::size_t count = std::min(m_remaining, static_cast<std::size_t>(end - data));
+            if (!handler.onBodyData(data, count))
+                return false;
+
+            data += count;
+            m_remaining -= count;
+            if (m_remaining == 0)
+                m_state = ChunkEnd;
+
+            continue;
+        }
+
+        // The other states read lines, which may be split over several blocks
+        const char* newLine = std::find(data, end, '\n');
+        m_line.append(data, newLine);
+        if (newLine == end)
+            return m_line.size() <= maxLineSize;
+
+        data = newLine + 1;
+        if (!m_line.empty() && (*m_line.rbegin() == '\r'))
+            m_line.erase(m_line.size() - 1);
+
+        if (m_state == ChunkSize)
+        {
+            // Read the chunk size (the optional chunk-extension is ignored)
+            std::istringstream in(m_line);
+            if (!(in >> std::hex >> m_remaining))
+                return false;
+
+            m_state = (m_remaining > 0) ? ChunkData : Trailers;
+        }
+        else if (m_state == ChunkEnd)
+        {
+            if (!m_line.empty())
+                return false;
+
+            m_state = ChunkSize;
+        }
+        else if (m_line.empty())
+        {
+            // The empty line after the trailers ends the body
+            m_state = Complete;
+        }
+        else
+        {
+            m_trailers += m_line + "\r\n";
+        }
+
+        m_line.clear();
+    }
+
+    m_hasExtraData = (data < end);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ChunkedDecoder::isComplete() const
+{
+    return m_state == Complete;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ChunkedDecoder::hasExtraData() const
+{
+    return m_hasExtraData;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::string& ChunkedDecoder::getTrailers() const
+{
+    return m_trailers;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_CHUNKEDDECODER_HPP
+#define SFML_CHUNKEDDECODER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Http.hpp>
+#include <string>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Decoder of HTTP bodies using the chunked transfer
+///        encoding, fed with the data as it is received
+///
+////////////////////////////////////////////////////////////
+class ChunkedDecoder
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ChunkedDecoder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode a block of received data
+    ///
+    /// The data of the chunks is given to the handler as soon
+    /// as it is decoded. Lines may be split over several blocks.
+    ///
+    /// \param data    Pointer to the received data
+    /// \param size    Size of the received data, in bytes
+    /// \param handler Handler receiving the decoded body
+    ///
+    /// \return False if the body is malformed or if the handler aborted
+    ///
+    ////////////////////////////////////////////////////////////
+    bool decode(const char* data, std::size_t size, Http::ResponseHandler& handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the end of the body was decoded
+    ///
+    /// \return True if the last chunk and the trailers were decoded
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isComplete() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether data was received after the end of the body
+    ///
+    /// \return True if the last block decoded went past the end of the body
+    ///
+    ////////////////////////////////////////////////////////////
+    bool hasExtraData() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the trailers that followed the last chunk
+    ///
+    /// \return Trailer lines, each one ending with "\r\n"
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::string& getTrailers() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Part of the body being decoded
+    ///
+    ////////////////////////////////////////////////////////////
+    enum State
+    {
+        ChunkSize, ///< Line containing the size of the next chunk
+        ChunkData, ///< Data of a chunk
+        ChunkEnd,  ///< Line ending the data of a chunk
+        Trailers,  ///< Trailer lines, after the last chunk
+        Complete   ///< End of the body
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    State       m_state;        ///< Part of the body being decoded
+    std::size_t m_remaining;    ///< Number of bytes left in the current chunk
+    std::string m_line;         ///< Beginning of the line being read
+    std::string m_trailers;     ///< Trailer lines read so far
+    bool        m_hasExtraData; ///< Was data received after the end of the body?
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_CHUNKEDDECODER_HPP
@@ -0,0 +1,280 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/DeltaPacket.hpp>
+#include <cstring>
+
+
+namespace
+{
+    // Changed bytes separated by fewer unchanged bytes than this are
+    // sent together, since a run costs at least two bytes to encode
+    const std::size_t minUnchangedRun = 3;
+
+    // Write an integer 7 bits per byte
+    void writeVarint(std::vector<char>& buffer, sf::Uint64 value)
+    {
+        do
+        {
+            sf::Uint8 byte = static_cast<sf::Uint8>(value & 0x7F);
+            value >>= 7;
+            if (value)
+                byte |= 0x80;
+            buffer.push_back(static_cast<char>(byte));
+        }
+        while (value);
+    }
+
+    // Read an integer written by writeVarint
+    bool readVarint(const sf::Uint8*& data, const sf::Uint8* end, sf::Uint64& value)
+    {
+        value = 0;
+        for (unsigned int shift = 0; (shift < 64) && (data < end); shift += 7)
+        {
+            sf::Uint8 byte = *data++;
+            value |= static_cast<sf::Uint64>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                return true;
+        }
+
+        return false;
+    }
+
+    // Get a byte of a baseline, which is considered as followed by zeros
+    sf::Uint8 baselineByte(const std::vector<char>& baseline, std::size_t index)
+    {
+        return index < baseline.size() ? static_cast<sf::Uint8>(baseline[index]) : 0;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+DeltaPacket::DeltaPacket(std::size_t maxBaselines) :
+m_maxBaselines(maxBaselines),
+m_snapshotId  (0),
+m_baselineId  (0),
+m_isDecoded   (true)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void DeltaPacket::setSnapshotId(Uint32 id)
+{
+    m_snapshotId = id;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 DeltaPacket::getSnapshotId() const
+{
+    return m_snapshotId;
+}
+
+
+////////////////////////////////////////////////////////////
+void DeltaPacket::setBaseline(Uint32 id)
+{
+    m_baselineId = id;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 DeltaPacket::getBaseline() const
+{
+    return m_baselineId;
+}
+
+
+////////////////////////////////////////////////////////////
+bool DeltaPacket::isDecoded() const
+{
+    return m_isDecoded;
+}
+
+
+////////////////////////////////////////////////////////////
+void DeltaPacket::forgetBaselines(Uint32 id)
+{
+    m_baselines.erase(m_baselines.begin(), m_baselines.lower_bound(id));
+}
+
+
+////////////////////////////////////////////////////////////
+const void* DeltaPacket::onSend(std::size_t& size)
+{
+    const Uint8* data = static_cast<const Uint8*>(getData());
+    std::size_t dataSize = getDataSize();
+
+    // Fall back to a full snapshot if the baseline is unknown
+    BaselineMap::const_iterator baseline = m_baselineId ? m_baselines.find(m_baselineId) : m_baselines.end();
+    Uint32 baselineId = (baseline != m_baselines.end()) ? m_baselineId : 0;
+
+    // Header: identifiers of the snapshot and of its baseline, size of the snapshot
+    m_encoded.clear();
+    writeVarint(m_encoded, m_snapshotId);
+    writeVarint(m_encoded, baselineId);
+    writeVarint(m_encoded, dataSize);
+
+    if (!baselineId)
+    {
+        if (dataSize > 0)
+            m_encoded.insert(m_encoded.end(), reinterpret_cast<const char*>(data), reinterpret_cast<const char*>(data) + dataSize);
+    }
+    else
+    {
+        // Alternate runs of unchanged bytes (only their length is written)
+        // and runs of changed bytes, until the end of the snapshot
+        const std::vector<char>& reference = baseline->second;
+        std::size_t i = 0;
+        while (i < dataSize)
+        {
+            std::size_t start = i;
+            while ((i < dataSize) && (data[i] == baselineByte(reference, i)))
+                ++i;
+            writeVarint(m_encoded, i - start);
+
+            if (i == dataSize)
+                break;
+
+            // Extend the changed run until enough unchanged bytes follow
+            start = i;
+            while (i < dataSize)
+            {
+                std::size_t unchanged = 0;
+                while ((i + unchanged < dataSize) && (unchanged < minUnchangedRun) && (data[i + unchanged] == baselineByte(reference, i + unchanged)))
+                    ++unchanged;
+
+                if ((unchanged == minUnchangedRun) || (i + unchanged == dataSize))
+                    break;
+
+                i += unchanged + 1;
+            }
+
+            writeVarint(m_encoded, i - start);
+            m_encoded.insert(m_encoded.end(), reinterpret_cast<const char*>(data) + start, reinterpret_cast<const char*>(data) + i);
+        }
+    }
+
+    // Keep the snapshot to encode the next ones against it
+    storeBaseline();
+
+    size = m_encoded.size();
+    return &m_encoded[0];
+}
+
+
+////////////////////////////////////////////////////////////
+void DeltaPacket::onReceive(const void* data, std::size_t size)
+{
+    m_isDecoded = decode(static_cast<const Uint8*>(data), size);
+
+    // Keep the snapshot to decode the next ones against it
+    if (m_isDecoded)
+        storeBaseline();
+}
+
+
+////////////////////////////////////////////////////////////
+void DeltaPacket::storeBaseline()
+{
+    if (!m_snapshotId || !m_maxBaselines)
+        return;
+
+    const char* data = static_cast<const char*>(getData());
+    m_baselines[m_snapshotId].assign(data, data + getDataSize());
+
+    // Drop the oldest baselines
+    while (m_baselines.size() > m_maxBaselines)
+        m_baselines.erase(m_baselines.begin());
+}
+
+
+////////////////////////////////////////////////////////////
+bool DeltaPacket::decode(const Uint8* data, std::size_t size)
+{
+    const Uint8* end = data + size;
+
+    // Read the header
+    Uint64 snapshotId = 0;
+    Uint64 baselineId = 0;
+    Uint64 dataSize = 0;
+    if (!readVarint(data, end, snapshotId) || !readVarint(data, end, baselineId) || !readVarint(data, end, dataSize))
+        return false;
+
+    m_snapshotId = static_cast<Uint32>(snapshotId);
+    m_baselineId = static_cast<Uint32>(baselineId);
+
+    // Full snapshot
+    if (!baselineId)
+    {
+        if (dataSize != static_cast<Uint64>(end - data))
+            return false;
+
+        append(data, static_cast<std::size_t>(dataSize));
+        return true;
+    }
+
+    BaselineMap::const_iterator baseline = m_baselines.find(m_baselineId);
+    if (baseline == m_baselines.end())
+        return false;
+
+    // Rebuild the snapshot from the runs of unchanged and changed bytes
+    const std::vector<char>& reference = baseline->second;
+    m_encoded.clear();
+    while (m_encoded.size() < dataSize)
+    {
+        Uint64 unchanged = 0;
+        if (!readVarint(data, end, unchanged) || (unchanged > dataSize - m_encoded.size()))
+            return false;
+
+        for (std::size_t i = 0; i < unchanged; ++i)
+            m_encoded.push_back(static_cast<char>(baselineByte(reference, m_encoded.size())));
+
+        if (m_encoded.size() == dataSize)
+            break;
+
+        Uint64 changed = 0;
+        if (!readVarint(data, end, changed) || (changed > dataSize - m_encoded.size()) || (changed > static_cast<Uint64>(end - data)))
+            return false;
+
+        m_encoded.insert(m_encoded.end(), reinterpret_cast<const char*>(data), reinterpret_cast<const char*>(data) + changed);
+        data += changed;
+    }
+
+    if (data != end)
+        return false;
+
+    if (!m_encoded.empty())
+        append(&m_encoded[0], m_encoded.size());
+
+    return true;
+}
+
+} // namespace sf
@@ -33,9 +33,22 @@
 #include <fstream>
 #include <iterator>
 #include <sstream>
+#include <vector>
 #include <cstdio>
 
 
+namespace
+{
+    // Convert a file position to its decimal representation
+    std::string toString(sf::Uint64 value)
+    {
+        std::ostringstream out;
+        out << value;
+        return out.str();
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
@@ -50,7 +63,7 @@ public:
     Ftp::Response open(Ftp::TransferMode mode);
 
     ////////////////////////////////////////////////////////////
-    void send(std::istream& stream);
+    void send(const std::string& filename, Uint64 offset);
 
     ////////////////////////////////////////////////////////////
     void receive(std::ostream& stream);
@@ -275,30 +288,42 @@ Ftp::Response Ftp::deleteFile(const std::string& name)
 
 
 ////////////////////////////////////////////////////////////
-Ftp::Response Ftp::download(const std::string& remoteFile, const std::string& localPath, TransferMode mode)
+Ftp::Response Ftp::download(const std::string& remoteFile, const std::string& localPath, TransferMode mode, bool resume)
 {
+    // Extract the filename from the file path
+    std::string filename = remoteFile;
+    std::string::size_type pos = filename.find_last_of("/\\");
+    if (pos != std::string::npos)
+        filename = filename.substr(pos + 1);
+
+    // Make sure the destination path ends with a slash
+    std::string path = localPath;
+    if (!path.empty() && (path[path.size() - 1] != '\\') && (path[path.size() - 1] != '/'))
+        path += "/";
+
     // Open a data channel using the given transfer mode
     DataChannel data(*this);
     Response response = data.open(mode);
     if (response.isOk())
     {
+        // When resuming, restart the transfer from the end of the local file
+        Uint64 offset = 0;
+        if (resume)
+        {
+            std::ifstream existing((path + filename).c_str(), std::ios_base::binary | std::ios_base::ate);
+            if (existing)
+                offset = static_cast<Uint64>(existing.tellg());
+        }
+        if ((offset > 0) && (sendCommand("REST", toString(offset)).getStatus() != Response::NeedInformation))
+            offset = 0;
+
         // Tell the server to start the transfer
         response = sendCommand("RETR", remoteFile);
         if (response.isOk())
         {
-            // Extract the filename from the file path
-            std::string filename = remoteFile;
-            std::string::size_type pos = filename.find_last_of("/\\");
-            if (pos != std::string::npos)
-                filename = filename.substr(pos + 1);
-
-            // Make sure the destination path ends with a slash
-            std::string path = localPath;
-            if (!path.empty() && (path[path.size() - 1] != '\\') && (path[path.size() - 1] != '/'))
-                path += "/";
-
-            // Create the file and truncate it if necessary
-            std::ofstream file((path + filename).c_str(), std::ios_base::binary | std::ios_base::trunc);
+            // Create the file and truncate it, or append to it when resuming
+            std::ios_base::openmode fileMode = std::ios_base::binary | (offset > 0 ? std::ios_base::app : std::ios_base::trunc);
+            std::ofstream file((path + filename).c_str(), fileMode);
             if (!file)
                 return Response(Response::InvalidFile);
 
@@ -311,8 +336,8 @@ Ftp::Response Ftp::download(const std::string& remoteFile, const std::string& lo
             // Get the response from the server
             response = getResponse();
 
-            // If the download was unsuccessful, delete the partial file
-            if (!response.isOk())
+            // If the download was unsuccessful, delete the partial file (unless it can be resumed)
+            if (!response.isOk() && !resume)
                 std::remove((path + filename).c_str());
         }
     }
@@ -322,12 +347,13 @@ Ftp::Response Ftp::download(const std::string& remoteFile, const std::string& lo
 
 
 ////////////////////////////////////////////////////////////
-Ftp::Response Ftp::upload(const std::string& localFile, const std::string& remotePath, TransferMode mode)
+Ftp::Response Ftp::upload(const std::string& localFile, const std::string& remotePath, TransferMode mode, bool resume)
 {
-    // Get the contents of the file to send
+    // Make sure that the file to send can be read
     std::ifstream file(localFile.c_str(), std::ios_base::binary);
     if (!file)
         return Response(Response::InvalidFile);
+    file.close();
 
     // Extract the filename from the file path
     std::string filename = localFile;
@@ -345,12 +371,24 @@ Ftp::Response Ftp::upload(const std::string& localFile, const std::string& remot
     Response response = data.open(mode);
     if (response.isOk())
     {
+        // When resuming, restart the transfer after the part already on the server
+        Uint64 offset = 0;
+        if (resume)
+        {
+            Response size = sendCommand("SIZE", path + filename);
+            std::istringstream in(size.getMessage());
+            if ((size.getStatus() != Response::FileStatus) || !(in >> offset))
+                offset = 0;
+        }
+        if ((offset > 0) && (sendCommand("REST", toString(offset)).getStatus() != Response::NeedInformation))
+            offset = 0;
+
         // Tell the server to start the transfer
         response = sendCommand("STOR", path + filename);
         if (response.isOk())
         {
             // Send the file data
-            data.send(file);
+            data.send(localFile, offset);
 
             // Get the response from the server
             response = getResponse();
@@ -581,12 +619,12 @@ Ftp::Response Ftp::DataChannel::open(Ftp::TransferMode mode)
 ////////////////////////////////////////////////////////////
 void Ftp::DataChannel::receive(std::ostream& stream)
 {
-    // Receive data
-    char buffer[1024];
+    // Receive data, by blocks large enough to be written directly to the file
+    std::vector<char> buffer(65536);
     std::size_t received;
-    while (m_dataSocket.receive(buffer, sizeof(buffer), received) == Socket::Done)
+    while (m_dataSocket.receive(&buffer[0], buffer.size(), received) == Socket::Done)
     {
-        stream.write(buffer, static_cast<std::streamsize>(received));
+        stream.write(&buffer[0], static_cast<std::streamsize>(received));
 
         if (!stream.good())
         {
@@ -601,37 +639,12 @@ void Ftp::DataChannel::receive(std::ostream& stream)
 
 
 ////////////////////////////////////////////////////////////
-void Ftp::DataChannel::send(std::istream& stream)
+void Ftp::DataChannel::send(const std::string& filename, Uint64 offset)
 {
-    // Send data
-    char buffer[1024];
-    std::size_t count;
-
-    for (;;)
-    {
-        // read some data from the stream
-        stream.read(buffer, sizeof(buffer));
-
-        if (!stream.good() && !stream.eof())
-        {
-            err() << "FTP Error: Reading from the file has failed" << std::endl;
-            break;
-        }
-
-        count = stream.gcount();
-
-        if (count > 0)
-        {
-            // we could read more data from the stream: send them
-            if (m_dataSocket.send(buffer, count) != Socket::Done)
-                break;
-        }
-        else
-        {
-            // no more data: exit the loop
-            break;
-        }
-    }
+    // Send the file, letting the system copy it directly to the network when it can
+    Uint64 sent = 0;
+    if (m_dataSocket.sendFile(filename, offset, sent) != Socket::Done)
+        err() << "FTP Error: Sending the file has failed" << std::endl;
 
     // Close the data socket
     m_dataSocket.disconnect();
@@ -26,7 +26,10 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Http.hpp>
+#include <SFML/Network/ChunkedDecoder.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <cctype>
 #include <algorithm>
 #include <iterator>
@@ -43,6 +46,45 @@ namespace
             *i = static_cast<char>(std::tolower(*i));
         return str;
     }
+
+    // Response handler storing the body in a string
+    class StringHandler : public sf::Http::ResponseHandler
+    {
+    public:
+
+        StringHandler(std::string& body) :
+        m_body(body)
+        {
+        }
+
+        virtual bool onBodyData(const char* data, std::size_t size)
+        {
+            m_body.append(data, size);
+            return true;
+        }
+
+    private:
+
+        std::string& m_body;
+    };
+
+    // Idle persistent connections, shared by all the sf::Http instances
+    typedef std::multimap<std::pair<sf::IpAddress, unsigned short>, sf::TcpSocket*> ConnectionTable;
+    const std::size_t maxIdleConnections = 4; // per host
+
+    struct ConnectionPool
+    {
+        ~ConnectionPool()
+        {
+            for (ConnectionTable::iterator it = connections.begin(); it != connections.end(); ++it)
+                delete it->second;
+        }
+
+        ConnectionTable connections;
+        sf::Mutex       mutex;
+    };
+
+    ConnectionPool connectionPool;
 }
 
 
@@ -296,17 +338,26 @@ void Http::Response::parseFields(std::istream &in)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Http::ResponseHandler::onHeader(const Response&)
+{
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 Http::Http() :
-m_host(),
-m_port(0)
+m_host     (),
+m_port     (0),
+m_keepAlive(false)
 {
 
 }
 
 
 ////////////////////////////////////////////////////////////
-Http::Http(const std::string& host, unsigned short port)
+Http::Http(const std::string& host, unsigned short port) :
+m_keepAlive(false)
 {
     setHost(host, port);
 }
@@ -314,40 +365,155 @@ Http::Http(const std::string& host, unsigned short port)
 
 ////////////////////////////////////////////////////////////
 void Http::setHost(const std::string& host, unsigned short port)
+{
+    parseHost(host, port, m_hostName, m_port);
+
+    m_host = IpAddress(m_hostName);
+}
+
+
+////////////////////////////////////////////////////////////
+Http::Response Http::sendRequest(const Http::Request& request, Time timeout)
+{
+    // Store the body in the response as it is received
+    std::string body;
+    StringHandler handler(body);
+
+    Response response = sendRequest(request, handler, timeout);
+    response.m_body.swap(body);
+
+    return response;
+}
+
+
+////////////////////////////////////////////////////////////
+Http::Response Http::sendRequest(const Http::Request& request, ResponseHandler& handler, Time timeout)
+{
+    // First make sure that the request is valid -- add missing mandatory fields
+    Request toSend = completeRequest(request, m_hostName, m_keepAlive);
+
+    // Prepare the response
+    Response received;
+
+    // Convert the request to string
+    std::string requestStr = toSend.prepare();
+    bool isHead = (toSend.m_method == Request::Head);
+
+    // A persistent connection may have been closed by the server while it was idle:
+    // in this case, the request is sent again with a new connection
+    for (;;)
+    {
+        // Reuse an idle persistent connection if possible
+        TcpSocket* connection = NULL;
+        if (m_keepAlive)
+        {
+            Lock lock(connectionPool.mutex);
+
+            ConnectionTable::iterator it = connectionPool.connections.find(std::make_pair(m_host, m_port));
+            if (it != connectionPool.connections.end())
+            {
+                connection = it->second;
+                connectionPool.connections.erase(it);
+            }
+        }
+
+        // Otherwise connect the socket to the host
+        bool isReused = (connection != NULL);
+        if (!isReused)
+        {
+            connection = m_keepAlive ? new TcpSocket : &m_connection;
+            if (connection->connect(m_host, m_port, timeout) != Socket::Done)
+            {
+                releaseConnection(connection, false);
+                break;
+            }
+        }
+
+        // Send the request through the connected socket, and wait for the server's response
+        std::string header;
+        bool canReuse = false;
+        bool hasResponse = (connection->send(requestStr.c_str(), requestStr.size()) == Socket::Done) &&
+                           receiveResponse(*connection, isHead, header, handler, canReuse);
+
+        // Close the connection or keep it for the next request
+        releaseConnection(connection, canReuse);
+
+        if (hasResponse)
+        {
+            // Build the Response object from the received header
+            received.parse(header);
+            break;
+        }
+
+        if (!isReused)
+            break;
+    }
+
+    return received;
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::setKeepAlive(bool keepAlive)
+{
+    m_keepAlive = keepAlive;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::isKeepAlive() const
+{
+    return m_keepAlive;
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::closeIdleConnections()
+{
+    Lock lock(connectionPool.mutex);
+
+    for (ConnectionTable::iterator it = connectionPool.connections.begin(); it != connectionPool.connections.end(); ++it)
+        delete it->second;
+    connectionPool.connections.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::parseHost(const std::string& host, unsigned short port, std::string& hostName, unsigned short& hostPort)
 {
     // Check the protocol
     if (toLower(host.substr(0, 7)) == "http://")
     {
         // HTTP protocol
-        m_hostName = host.substr(7);
-        m_port     = (port != 0 ? port : 80);
+        hostName = host.substr(7);
+        hostPort = (port != 0 ? port : 80);
     }
     else if (toLower(host.substr(0, 8)) == "https://")
     {
         // HTTPS protocol -- unsupported (requires encryption and certificates and stuff...)
         err() << "HTTPS protocol is not supported by sf::Http" << std::endl;
-        m_hostName = "";
-        m_port     = 0;
+        hostName = "";
+        hostPort = 0;
+        return false;
     }
     else
     {
         // Undefined protocol - use HTTP
-        m_hostName = host;
-        m_port     = (port != 0 ? port : 80);
+        hostName = host;
+        hostPort = (port != 0 ? port : 80);
     }
 
     // Remove any trailing '/' from the host name
-    if (!m_hostName.empty() && (*m_hostName.rbegin() == '/'))
-        m_hostName.erase(m_hostName.size() - 1);
+    if (!hostName.empty() && (*hostName.rbegin() == '/'))
+        hostName.erase(hostName.size() - 1);
 
-    m_host = IpAddress(m_hostName);
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
-Http::Response Http::sendRequest(const Http::Request& request, Time timeout)
+Http::Request Http::completeRequest(const Request& request, const std::string& hostName, bool keepAlive)
 {
-    // First make sure that the request is valid -- add missing mandatory fields
     Request toSend(request);
     if (!toSend.hasField("From"))
     {
@@ -359,7 +525,7 @@ Http::Response Http::sendRequest(const Http::Request& request, Time timeout)
     }
     if (!toSend.hasField("Host"))
     {
-        toSend.setField("Host", m_hostName);
+        toSend.setField("Host", hostName);
     }
     if (!toSend.hasField("Content-Length"))
     {
@@ -371,44 +537,160 @@ Http::Response Http::sendRequest(const Http::Request& request, Time timeout)
     {
         toSend.setField("Content-Type", "application/x-www-form-urlencoded");
     }
+    if (keepAlive && !toSend.hasField("Connection"))
+    {
+        toSend.setField("Connection", "keep-alive");
+    }
     if ((toSend.m_majorVersion * 10 + toSend.m_minorVersion >= 11) && !toSend.hasField("Connection"))
     {
         toSend.setField("Connection", "close");
     }
 
-    // Prepare the response
-    Response received;
+    return toSend;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::isPersistent(const Response& response)
+{
+    // HTTP/1.1 connections are persistent unless told otherwise, HTTP/1.0 ones are not
+    std::string connection = toLower(response.getField("connection"));
+    if (response.getMajorHttpVersion() * 10 + response.getMinorHttpVersion() >= 11)
+        return connection != "close";
+    else
+        return connection == "keep-alive";
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::hasBody(const Response& response, bool isHead)
+{
+    int status = response.getStatus();
+    return !isHead && ((status < 100) || (status >= 200)) && (status != Response::NoContent) && (status != Response::NotModified);
+}
 
-    // Connect the socket to the host
-    if (m_connection.connect(m_host, m_port, timeout) == Socket::Done)
+
+////////////////////////////////////////////////////////////
+bool Http::receiveResponse(TcpSocket& connection, bool isHead, std::string& header, ResponseHandler& handler, bool& canReuse)
+{
+    header.clear();
+    canReuse = false;
+
+    char buffer[16384];
+    std::size_t size = 0;
+
+    // Receive the whole header first
+    std::size_t headerEnd;
+    while ((headerEnd = header.find("\r\n\r\n")) == std::string::npos)
     {
-        // Convert the request to string and send it through the connected socket
-        std::string requestStr = toSend.prepare();
+        if (connection.receive(buffer, sizeof(buffer), size) != Socket::Done)
+            return !header.empty();
+
+        header.append(buffer, buffer + size);
+    }
+    headerEnd += 4;
 
-        if (!requestStr.empty())
+    // The beginning of the body may have been received with the header
+    std::string body = header.substr(headerEnd);
+    header.erase(headerEnd);
+
+    Response response;
+    response.parse(header);
+    if ((response.getStatus() == Response::InvalidResponse) || !handler.onHeader(response))
+        return true;
+
+    bool persistent = isPersistent(response);
+
+    // Some responses never have a body
+    if (!hasBody(response, isHead))
+    {
+        canReuse = persistent && body.empty();
+        return true;
+    }
+
+    // Chunked body: decode until the last chunk
+    if (toLower(response.getField("transfer-encoding")) == "chunked")
+    {
+        priv::ChunkedDecoder decoder;
+        if (!decoder.decode(body.data(), body.size(), handler))
+            return true;
+
+        while (!decoder.isComplete())
         {
-            // Send it through the socket
-            if (m_connection.send(requestStr.c_str(), requestStr.size()) == Socket::Done)
-            {
-                // Wait for the server's response
-                std::string receivedStr;
-                std::size_t size = 0;
-                char buffer[1024];
-                while (m_connection.receive(buffer, sizeof(buffer), size) == Socket::Done)
-                {
-                    receivedStr.append(buffer, buffer + size);
-                }
-
-                // Build the Response object from the received data
-                received.parse(receivedStr);
-            }
+            if ((connection.receive(buffer, sizeof(buffer), size) != Socket::Done) || !decoder.decode(buffer, size, handler))
+                return true;
         }
 
-        // Close the connection
+        // Add the trailers to the fields of the header
+        header.insert(header.size() - 2, decoder.getTrailers());
+
+        canReuse = persistent && !decoder.hasExtraData();
+        return true;
+    }
+
+    // Body with a known length: receive exactly this length
+    std::istringstream lengthField(response.getField("content-length"));
+    std::size_t length = 0;
+    if (lengthField >> length)
+    {
+        std::size_t received = std::min(body.size(), length);
+        if ((received > 0) && !handler.onBodyData(body.data(), received))
+            return true;
+
+        bool hasExtraData = (body.size() > length);
+        while (received < length)
+        {
+            if (connection.receive(buffer, sizeof(buffer), size) != Socket::Done)
+                return true;
+
+            std::size_t count = std::min(size, length - received);
+            if (!handler.onBodyData(buffer, count))
+                return true;
+
+            received += count;
+            hasExtraData = (count < size);
+        }
+
+        canReuse = persistent && !hasExtraData;
+        return true;
+    }
+
+    // Unknown length: the body ends when the server closes the connection
+    if (!body.empty() && !handler.onBodyData(body.data(), body.size()))
+        return true;
+
+    while (connection.receive(buffer, sizeof(buffer), size) == Socket::Done)
+    {
+        if (!handler.onBodyData(buffer, size))
+            return true;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::releaseConnection(TcpSocket* connection, bool canReuse)
+{
+    if (connection == &m_connection)
+    {
         m_connection.disconnect();
+        return;
     }
 
-    return received;
+    if (canReuse)
+    {
+        Lock lock(connectionPool.mutex);
+
+        std::pair<IpAddress, unsigned short> host(m_host, m_port);
+        if (connectionPool.connections.count(host) < maxIdleConnections)
+        {
+            connectionPool.connections.insert(std::make_pair(host, connection));
+            return;
+        }
+    }
+
+    delete connection;
 }
 
 } // namespace sf
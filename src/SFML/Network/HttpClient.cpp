@@ -0,0 +1,664 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/HttpClient.hpp>
+#include <SFML/Network/ChunkedDecoder.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+
+
+namespace
+{
+    // Convert a string to lower case
+    std::string toLower(std::string str)
+    {
+        for (std::string::iterator i = str.begin(); i != str.end(); ++i)
+            *i = static_cast<char>(std::tolower(*i));
+        return str;
+    }
+
+    // Maximum size of the header of a response
+    const std::size_t maxHeaderSize = 64 * 1024;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct HttpClient::Transaction : public Http::ResponseHandler
+{
+    Transaction() :
+    id        (0),
+    isResolved(false),
+    port      (0),
+    isHead    (false),
+    handler   (NULL),
+    isDone    (false),
+    connection(NULL)
+    {
+    }
+
+    virtual bool onHeader(const Http::Response& header)
+    {
+        return handler ? handler->onHeader(header) : true;
+    }
+
+    virtual bool onBodyData(const char* data, std::size_t size)
+    {
+        if (handler)
+            return handler->onBodyData(data, size);
+
+        body.append(data, size);
+        return true;
+    }
+
+    RequestId              id;         ///< Identifier of the request
+    std::string            hostName;   ///< Name of the host
+    IpAddress              address;    ///< Address of the host
+    bool                   isResolved; ///< Was the name of the host resolved?
+    unsigned short         port;       ///< Port of the host
+    std::string            data;       ///< Request, ready to be sent
+    bool                   isHead;     ///< Is it a HEAD request (no body in the response)?
+    Http::ResponseHandler* handler;    ///< Handler given by the user, if any
+    Http::Response         response;   ///< Response received so far
+    std::string            body;       ///< Body received so far, when there's no handler
+    bool                   isDone;     ///< Is the response complete?
+    Connection*            connection; ///< Connection running the request, if any
+};
+
+
+////////////////////////////////////////////////////////////
+struct HttpClient::Connection
+{
+    enum State
+    {
+        Connecting,      ///< Waiting for the connection to be established
+        Idle,            ///< Connected, waiting for a request
+        Sending,         ///< Sending a request
+        ReceivingHeader, ///< Receiving the header of a response
+        ReceivingBody,   ///< Receiving the body of a response
+        Closed           ///< Closed, waiting to be destroyed
+    };
+
+    enum BodyMode
+    {
+        Length,    ///< The body has a known length
+        Chunked,   ///< The body uses the chunked transfer encoding
+        UntilClose ///< The body ends when the server closes the connection
+    };
+
+    Connection() :
+    port       (0),
+    transaction(NULL),
+    state      (Connecting),
+    isReused   (false),
+    sent       (0),
+    mode       (Length),
+    remaining  (0),
+    persistent (false)
+    {
+    }
+
+    TcpSocket            socket;      ///< Socket of the connection
+    IpAddress            address;     ///< Address of the host
+    unsigned short       port;        ///< Port of the host
+    Transaction*         transaction; ///< Request running on the connection, if any
+    State                state;       ///< Current state of the connection
+    bool                 isReused;    ///< Was the connection used by a previous request?
+    std::size_t          sent;        ///< Number of bytes of the request already sent
+    std::string          header;      ///< Header of the response received so far
+    BodyMode             mode;        ///< How the end of the body is detected
+    std::size_t          remaining;   ///< Number of bytes left in a body with a known length
+    priv::ChunkedDecoder decoder;     ///< Decoder of a chunked body
+    bool                 persistent;  ///< Can the connection be reused after the response?
+};
+
+
+////////////////////////////////////////////////////////////
+HttpClient::HttpClient() :
+m_nextId        (1),
+m_maxConnections(6),
+m_pendingCount  (0),
+m_hasFinished   (false)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+HttpClient::~HttpClient()
+{
+    for (std::vector<Connection*>::iterator it = m_connections.begin(); it != m_connections.end(); ++it)
+        delete *it;
+
+    for (TransactionTable::iterator it = m_transactions.begin(); it != m_transactions.end(); ++it)
+        delete it->second;
+}
+
+
+////////////////////////////////////////////////////////////
+void HttpClient::setMaxConnections(std::size_t count)
+{
+    m_maxConnections = std::max(count, static_cast<std::size_t>(1));
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t HttpClient::getMaxConnections() const
+{
+    return m_maxConnections;
+}
+
+
+////////////////////////////////////////////////////////////
+HttpClient::RequestId HttpClient::sendRequest(const Http::Request& request, const std::string& host, unsigned short port, Http::ResponseHandler* handler)
+{
+    Transaction* transaction = new Transaction;
+    transaction->id = m_nextId++;
+    transaction->handler = handler;
+    transaction->isHead = (request.m_method == Http::Request::Head);
+    if (m_nextId == 0)
+        m_nextId = 1;
+
+    m_transactions[transaction->id] = transaction;
+    ++m_pendingCount;
+
+    // The host name is resolved in the background, by startRequests
+    Http::parseHost(host, port, transaction->hostName, transaction->port);
+    transaction->data = Http::completeRequest(request, transaction->hostName, true).prepare();
+
+    m_waiting.push_back(transaction);
+    startRequests();
+
+    return transaction->id;
+}
+
+
+////////////////////////////////////////////////////////////
+bool HttpClient::update(Time timeout)
+{
+    m_hasFinished = false;
+
+    if (m_selector.wait(timeout))
+    {
+        // Copy the events, as processing them may modify the selector
+        std::vector<SocketSelector::ReadyEvent> events = m_selector.getReadyEvents();
+        for (std::vector<SocketSelector::ReadyEvent>::iterator it = events.begin(); it != events.end(); ++it)
+            processConnection(*static_cast<Connection*>(it->userData), it->events);
+    }
+
+    // Destroy the connections that were closed
+    for (std::size_t i = 0; i < m_connections.size();)
+    {
+        if (m_connections[i]->state == Connection::Closed)
+        {
+            delete m_connections[i];
+            m_connections[i] = m_connections.back();
+            m_connections.pop_back();
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    // Give the freed connections to the waiting requests
+    startRequests();
+
+    return m_hasFinished;
+}
+
+
+////////////////////////////////////////////////////////////
+bool HttpClient::isDone(RequestId id) const
+{
+    TransactionTable::const_iterator it = m_transactions.find(id);
+    return (it != m_transactions.end()) && it->second->isDone;
+}
+
+
+////////////////////////////////////////////////////////////
+bool HttpClient::getResponse(RequestId id, Http::Response& response)
+{
+    TransactionTable::iterator it = m_transactions.find(id);
+    if ((it == m_transactions.end()) || !it->second->isDone)
+        return false;
+
+    response = it->second->response;
+    response.m_body.swap(it->second->body);
+
+    delete it->second;
+    m_transactions.erase(it);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void HttpClient::cancel(RequestId id)
+{
+    TransactionTable::iterator it = m_transactions.find(id);
+    if (it == m_transactions.end())
+        return;
+
+    Transaction* transaction = it->second;
+    if (!transaction->isDone)
+    {
+        // The connection is in the middle of the exchange, it can't be reused
+        if (transaction->connection)
+        {
+            transaction->connection->transaction = NULL;
+            closeConnection(*transaction->connection);
+        }
+
+        std::deque<Transaction*>::iterator position = std::find(m_waiting.begin(), m_waiting.end(), transaction);
+        if (position != m_waiting.end())
+            m_waiting.erase(position);
+
+        --m_pendingCount;
+    }
+
+    delete transaction;
+    m_transactions.erase(it);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t HttpClient::getPendingCount() const
+{
+    return m_pendingCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void HttpClient::startRequests()
+{
+    for (std::size_t i = 0; i < m_waiting.size();)
+    {
+        Transaction* transaction = m_waiting[i];
+
+        // Wait until the name of the host is resolved
+        if (!transaction->isResolved)
+        {
+            if (!IpAddress::resolveAsync(transaction->hostName, transaction->address))
+            {
+                ++i;
+                continue;
+            }
+
+            transaction->isResolved = true;
+            if (transaction->address == IpAddress::None)
+            {
+                // The response status is still ConnectionFailed
+                m_waiting.erase(m_waiting.begin() + i);
+                transaction->isDone = true;
+                --m_pendingCount;
+                m_hasFinished = true;
+                continue;
+            }
+        }
+
+        // Look for an idle connection to the same host, and count the connections to it
+        Connection* connection = NULL;
+        std::size_t count = 0;
+        for (std::vector<Connection*>::iterator it = m_connections.begin(); it != m_connections.end(); ++it)
+        {
+            if (((*it)->state != Connection::Closed) && ((*it)->address == transaction->address) && ((*it)->port == transaction->port))
+            {
+                ++count;
+                if (!connection && ((*it)->state == Connection::Idle))
+                    connection = *it;
+            }
+        }
+
+        if (!connection)
+        {
+            // All the connections to this host are busy: wait for one of them
+            if (count >= m_maxConnections)
+            {
+                ++i;
+                continue;
+            }
+
+            connection = openConnection(transaction->address, transaction->port);
+        }
+
+        m_waiting.erase(m_waiting.begin() + i);
+
+        if (!connection)
+        {
+            // The response status is still ConnectionFailed
+            transaction->isDone = true;
+            --m_pendingCount;
+            m_hasFinished = true;
+            continue;
+        }
+
+        connection->transaction = transaction;
+        connection->sent = 0;
+        transaction->connection = connection;
+        transaction->response = Http::Response();
+        transaction->body.clear();
+
+        if (connection->state == Connection::Idle)
+        {
+            connection->state = Connection::Sending;
+            sendData(*connection);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+HttpClient::Connection* HttpClient::openConnection(const IpAddress& address, unsigned short port)
+{
+    Connection* connection = new Connection;
+    connection->address = address;
+    connection->port = port;
+
+    // A non-blocking connection only starts here, its completion is signaled by the Send event
+    connection->socket.setBlocking(false);
+    Socket::Status status = connection->socket.connect(address, port);
+    if ((status != Socket::Done) && (status != Socket::NotReady))
+    {
+        delete connection;
+        return NULL;
+    }
+
+    m_connections.push_back(connection);
+    m_selector.add(connection->socket, SocketSelector::Send, connection);
+
+    return connection;
+}
+
+
+////////////////////////////////////////////////////////////
+void HttpClient::processConnection(Connection& connection, Uint32 events)
+{
+    if (connection.state == Connection::Closed)
+        return;
+
+    if (connection.state == Connection::Connecting)
+    {
+        // The connection has a remote address once it is established
+        if (connection.socket.getRemoteAddress() == IpAddress::None)
+        {
+            finishRequest(connection, false);
+            return;
+        }
+
+        connection.state = Connection::Sending;
+        sendData(connection);
+        return;
+    }
+
+    if (connection.state == Connection::Sending)
+    {
+        if (events & SocketSelector::Send)
+            sendData(connection);
+        return;
+    }
+
+    // Receive everything that is available
+    char buffer[16384];
+    std::size_t size = 0;
+    while (connection.state != Connection::Closed)
+    {
+        Socket::Status status = connection.socket.receive(buffer, sizeof(buffer), size);
+        if (status == Socket::Done)
+        {
+            receiveData(connection, buffer, size);
+        }
+        else
+        {
+            if ((status == Socket::Disconnected) || (status == Socket::Error))
+                handleDisconnection(connection);
+            break;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void HttpClient::sendData(Connection& connection)
+{
+    const std::string& data = connection.transaction->data;
+
+    std::size_t sent = 0;
+    Socket::Status status = connection.socket.send(data.c_str() + connection.sent, data.size() - connection.sent, sent);
+    connection.sent += sent;
+
+    if ((status == Socket::Disconnected) || (status == Socket::Error))
+    {
+        handleDisconnection(connection);
+    }
+    else if (connection.sent < data.size())
+    {
+        // Wait until the socket can send more
+        m_selector.setEvents(connection.socket, SocketSelector::Send);
+    }
+    else
+    {
+        connection.state = Connection::ReceivingHeader;
+        connection.header.clear();
+        m_selector.setEvents(connection.socket, SocketSelector::Receive);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void HttpClient::receiveData(Connection& connection, const char* data, std::size_t size)
+{
+    // Data received while no request is running: the server is misbehaving
+    if (!connection.transaction || (connection.state == Connection::Idle))
+    {
+        closeConnection(connection);
+        return;
+    }
+
+    if (connection.state == Connection::ReceivingBody)
+    {
+        receiveBody(connection, data, size);
+        return;
+    }
+
+    // Receive the whole header first
+    std::size_t previousSize = connection.header.size();
+    connection.header.append(data, size);
+
+    std::size_t headerEnd = connection.header.find("\r\n\r\n", previousSize < 3 ? 0 : previousSize - 3);
+    if (headerEnd == std::string::npos)
+    {
+        if (connection.header.size() > maxHeaderSize)
+        {
+            connection.transaction->response.m_status = Http::Response::InvalidResponse;
+            finishRequest(connection, false);
+        }
+        return;
+    }
+    headerEnd += 4;
+
+    // The beginning of the body may have been received with the header
+    std::string body = connection.header.substr(headerEnd);
+    connection.header.erase(headerEnd);
+
+    Transaction& transaction = *connection.transaction;
+    transaction.response.parse(connection.header);
+    if ((transaction.response.getStatus() == Http::Response::InvalidResponse) || !transaction.onHeader(transaction.response))
+    {
+        finishRequest(connection, false);
+        return;
+    }
+
+    connection.persistent = Http::isPersistent(transaction.response);
+
+    // Some responses never have a body
+    if (!Http::hasBody(transaction.response, transaction.isHead))
+    {
+        finishRequest(connection, connection.persistent && body.empty());
+        return;
+    }
+
+    // Find out how the end of the body will be detected
+    std::istringstream lengthField(transaction.response.getField("content-length"));
+    if (toLower(transaction.response.getField("transfer-encoding")) == "chunked")
+    {
+        connection.mode = Connection::Chunked;
+        connection.decoder = priv::ChunkedDecoder();
+    }
+    else if (lengthField >> connection.remaining)
+    {
+        connection.mode = Connection::Length;
+        if (connection.remaining == 0)
+        {
+            finishRequest(connection, connection.persistent && body.empty());
+            return;
+        }
+    }
+    else
+    {
+        connection.mode = Connection::UntilClose;
+    }
+
+    connection.state = Connection::ReceivingBody;
+    if (!body.empty())
+        receiveBody(connection, body.data(), body.size());
+}
+
+
+////////////////////////////////////////////////////////////
+void HttpClient::receiveBody(Connection& connection, const char* data, std::size_t size)
+{
+    Transaction& transaction = *connection.transaction;
+
+    switch (connection.mode)
+    {
+        case Connection::Chunked:
+        {
+            if (!connection.decoder.decode(data, size, transaction))
+            {
+                finishRequest(connection, false);
+            }
+            else if (connection.decoder.isComplete())
+            {
+                // Add the trailers to the fields of the header
+                connection.header.insert(connection.header.size() - 2, connection.decoder.getTrailers());
+                transaction.response.parse(connection.header);
+
+                finishRequest(connection, connection.persistent && !connection.decoder.hasExtraData());
+            }
+            break;
+        }
+
+        case Connection::Length:
+        {
+            std::size_t count = std::min(size, connection.remaining);
+            if (!transaction.onBodyData(data, count))
+            {
+                finishRequest(connection, false);
+            }
+            else
+            {
+                connection.remaining -= count;
+                if (connection.remaining == 0)
+                    finishRequest(connection, connection.persistent && (count == size));
+            }
+            break;
+        }
+
+        case Connection::UntilClose:
+        {
+            if (!transaction.onBodyData(data, size))
+                finishRequest(connection, false);
+            break;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void HttpClient::handleDisconnection(Connection& connection)
+{
+    Transaction* transaction = connection.transaction;
+
+    // A reused connection may have been closed by the server before it received the
+    // request: nothing was received, so the request can safely be sent again
+    bool nothingReceived = (connection.state == Connection::Sending) ||
+                           ((connection.state == Connection::ReceivingHeader) && connection.header.empty());
+    if (transaction && connection.isReused && nothingReceived)
+    {
+        connection.transaction = NULL;
+        transaction->connection = NULL;
+        m_waiting.push_front(transaction);
+        closeConnection(connection);
+        return;
+    }
+
+    // Otherwise the response ends here; it is only complete if its end is marked by the closing
+    finishRequest(connection, false);
+}
+
+
+////////////////////////////////////////////////////////////
+void HttpClient::finishRequest(Connection& connection, bool canReuse)
+{
+    Transaction* transaction = connection.transaction;
+    if (transaction)
+    {
+        transaction->isDone = true;
+        transaction->connection = NULL;
+        connection.transaction = NULL;
+        --m_pendingCount;
+        m_hasFinished = true;
+    }
+
+    if (canReuse)
+    {
+        // Keep watching the idle connection, to notice when the server closes it
+        connection.state = Connection::Idle;
+        connection.isReused = true;
+        m_selector.setEvents(connection.socket, SocketSelector::Receive);
+    }
+    else
+    {
+        closeConnection(connection);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void HttpClient::closeConnection(Connection& connection)
+{
+    // The connection is destroyed at the end of the update, as it may still be in use
+    m_selector.remove(connection.socket);
+    connection.socket.disconnect();
+    connection.state = Connection::Closed;
+}
+
+} // namespace sf
@@ -28,44 +28,229 @@
 #include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/Http.hpp>
 #include <SFML/Network/SocketImpl.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
 #include <cstring>
+#include <deque>
+#include <map>
 
 
 namespace
 {
-    sf::Uint32 resolve(const std::string& address)
+    // Bytes of the IPv6 unspecified address (::)
+    const sf::Uint8 unspecifiedBytes[16] = {0};
+
+    // Convert a decimal IPv4 address or a hexadecimal IPv6 address, return false if it is not one
+    bool parseAddress(const std::string& address, sf::IpAddress& ip)
     {
         if (address == "255.255.255.255")
         {
             // The broadcast address needs to be handled explicitly,
             // because it is also the value returned by inet_addr on error
-            return INADDR_BROADCAST;
+            ip = sf::IpAddress(255, 255, 255, 255);
+            return true;
+        }
+
+        // Try to convert the address as a byte representation ("xxx.xxx.xxx.xxx")
+        sf::Uint32 ipv4 = inet_addr(address.c_str());
+        if (ipv4 != INADDR_NONE)
+        {
+            ip = sf::IpAddress(ntohl(ipv4));
+            return true;
+        }
+
+        // Host names never contain colons, IPv6 addresses always do
+        if (address.find(':') == std::string::npos)
+            return false;
+
+        addrinfo hints;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_INET6;
+        hints.ai_flags  = AI_NUMERICHOST;
+        addrinfo* result = NULL;
+        if ((getaddrinfo(address.c_str(), NULL, &hints, &result) == 0) && result)
+        {
+            sockaddr_in6* ipv6 = reinterpret_cast<sockaddr_in6*>(result->ai_addr);
+            ip = sf::IpAddress(reinterpret_cast<const sf::Uint8*>(&ipv6->sin6_addr));
+            freeaddrinfo(result);
         }
         else
         {
-            // Try to convert the address as a byte representation ("xxx.xxx.xxx.xxx")
-            sf::Uint32 ip = inet_addr(address.c_str());
-            if (ip != INADDR_NONE)
-                return ip;
-
-            // Not a valid address, try to convert it as a host name
-            addrinfo hints;
-            std::memset(&hints, 0, sizeof(hints));
-            hints.ai_family = AF_INET;
-            addrinfo* result = NULL;
-            if (getaddrinfo(address.c_str(), NULL, &hints, &result) == 0)
+            // Malformed IPv6 address
+            ip = sf::IpAddress::None;
+        }
+
+        return true;
+    }
+
+    // Ask the system to resolve a host name (this may take a while)
+    std::vector<sf::IpAddress> lookUp(const std::string& hostName)
+    {
+        std::vector<sf::IpAddress> addresses;
+
+        addrinfo hints;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family   = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* result = NULL;
+        if (getaddrinfo(hostName.c_str(), NULL, &hints, &result) == 0)
+        {
+            for (addrinfo* info = result; info; info = info->ai_next)
+            {
+                sf::IpAddress address;
+                if (info->ai_family == AF_INET)
+                    address = sf::IpAddress(ntohl(reinterpret_cast<sockaddr_in*>(info->ai_addr)->sin_addr.s_addr));
+                else if (info->ai_family == AF_INET6)
+                    address = sf::IpAddress(reinterpret_cast<const sf::Uint8*>(&reinterpret_cast<sockaddr_in6*>(info->ai_addr)->sin6_addr));
+                else
+                    continue;
+
+                if (std::find(addresses.begin(), addresses.end(), address) == addresses.end())
+                    addresses.push_back(address);
+            }
+
+            freeaddrinfo(result);
+        }
+
+        return addresses;
+    }
+
+    // Choose the address to use when a single one is needed: IPv4 ones come first,
+    // so that hosts that also have an IPv6 address behave as they always did
+    sf::IpAddress getPreferred(const std::vector<sf::IpAddress>& addresses)
+    {
+        for (std::vector<sf::IpAddress>::const_iterator it = addresses.begin(); it != addresses.end(); ++it)
+        {
+            if (!it->isIpv6())
+                return *it;
+        }
+
+        return addresses.empty() ? sf::IpAddress::None : addresses.front();
+    }
+
+    // Cache of the resolved host names, and background thread resolving them
+    struct Resolver
+    {
+        struct Entry
+        {
+            std::vector<sf::IpAddress> addresses;   // Resolved addresses, empty if the resolution failed
+            sf::Time                   expiry;      // Time after which the name must be resolved again
+            bool                       isPending;   // Is the name being resolved by the thread?
+            bool                       isDelivered; // Was the result of the background resolution retrieved?
+        };
+
+        typedef std::map<std::string, Entry> EntryTable;
+
+        Resolver() :
+        duration (sf::seconds(60)),
+        isRunning(false),
+        thread   (&Resolver::run, this)
+        {
+        }
+
+        ~Resolver()
+        {
+            // Don't resolve the names that nobody will ask for anymore
+            {
+                sf::Lock lock(mutex);
+                queue.clear();
+            }
+            thread.wait();
+        }
+
+        // Get the cached addresses, return false if there are none (or if they have expired)
+        bool find(const std::string& hostName, std::vector<sf::IpAddress>& addresses)
+        {
+            EntryTable::iterator it = entries.find(hostName);
+            if ((it == entries.end()) || it->second.isPending)
+                return false;
+
+            // A result resolved by the thread is given at least once, even with no cache
+            if ((clock.getElapsedTime() >= it->second.expiry) && it->second.isDelivered)
+            {
+                entries.erase(it);
+                return false;
+            }
+
+            it->second.isDelivered = true;
+            addresses = it->second.addresses;
+            return true;
+        }
+
+        // Store the resolved addresses in the cache
+        void store(const std::string& hostName, const std::vector<sf::IpAddress>& addresses, bool isDelivered)
+        {
+            Entry& entry = entries[hostName];
+            entry.addresses   = addresses;
+            entry.expiry      = clock.getElapsedTime() + duration;
+            entry.isPending   = false;
+            entry.isDelivered = isDelivered;
+        }
+
+        // Resolve the queued names, until there are no more
+        void run()
+        {
+            for (;;)
             {
-                if (result)
+                std::string hostName;
                 {
-                    ip = reinterpret_cast<sockaddr_in*>(result->ai_addr)->sin_addr.s_addr;
-                    freeaddrinfo(result);
-                    return ip;
+                    sf::Lock lock(mutex);
+                    if (queue.empty())
+                    {
+                        isRunning = false;
+                        return;
+                    }
+
+                    hostName = queue.front();
+                    queue.pop_front();
                 }
+
+                std::vector<sf::IpAddress> addresses = lookUp(hostName);
+
+                sf::Lock lock(mutex);
+                store(hostName, addresses, false);
             }
+        }
+
+        EntryTable              entries;
+        std::deque<std::string> queue;
+        sf::Mutex               mutex;
+        sf::Clock               clock;
+        sf::Time                duration;
+        bool                    isRunning;
+        sf::Thread              thread;
+    };
+
+    Resolver resolver;
 
-            // Not a valid address nor a host name
-            return 0;
+    std::vector<sf::IpAddress> resolveAll(const std::string& address)
+    {
+        std::vector<sf::IpAddress> addresses;
+
+        sf::IpAddress ip;
+        if (parseAddress(address, ip))
+        {
+            if (ip != sf::IpAddress::None)
+                addresses.push_back(ip);
+            return addresses;
         }
+
+        // Not a valid address, try to convert it as a host name (unless it was done recently)
+        {
+            sf::Lock lock(resolver.mutex);
+            if (resolver.find(address, addresses))
+                return addresses;
+        }
+
+        addresses = lookUp(address);
+
+        sf::Lock lock(resolver.mutex);
+        resolver.store(address, addresses, true);
+
+        return addresses;
     }
 }
 
@@ -76,60 +261,107 @@ namespace sf
 const IpAddress IpAddress::None;
 const IpAddress IpAddress::LocalHost(127, 0, 0, 1);
 const IpAddress IpAddress::Broadcast(255, 255, 255, 255);
+const IpAddress IpAddress::Any(unspecifiedBytes);
 
 
 ////////////////////////////////////////////////////////////
-IpAddress::IpAddress() :
-m_address(0)
+IpAddress::IpAddress()
 {
     // We're using 0 (INADDR_ANY) instead of INADDR_NONE to represent the invalid address,
     // because the latter is also the broadcast address (255.255.255.255); it's ok because
-    // SFML doesn't publicly use INADDR_ANY (it is always used implicitly)
+    // SFML doesn't publicly use INADDR_ANY (IpAddress::Any is the IPv6 unspecified address)
+    *this = IpAddress(0u);
+}
+
+
+////////////////////////////////////////////////////////////
+IpAddress::IpAddress(const std::string& address)
+{
+    *this = getPreferred(resolveAll(address));
 }
 
 
 ////////////////////////////////////////////////////////////
-IpAddress::IpAddress(const std::string& address) :
-m_address(resolve(address))
+IpAddress::IpAddress(const char* address)
 {
+    *this = getPreferred(resolveAll(address));
 }
 
 
 ////////////////////////////////////////////////////////////
-IpAddress::IpAddress(const char* address) :
-m_address(resolve(address))
+IpAddress::IpAddress(Uint8 byte0, Uint8 byte1, Uint8 byte2, Uint8 byte3)
 {
+    *this = IpAddress((static_cast<Uint32>(byte0) << 24) | (byte1 << 16) | (byte2 << 8) | byte3);
 }
 
 
 ////////////////////////////////////////////////////////////
-IpAddress::IpAddress(Uint8 byte0, Uint8 byte1, Uint8 byte2, Uint8 byte3) :
-m_address(htonl((byte0 << 24) | (byte1 << 16) | (byte2 << 8) | byte3))
+IpAddress::IpAddress(Uint32 address)
 {
+    // IPv4 addresses are stored in their IPv4-mapped form (::ffff:a.b.c.d)
+    std::memset(m_bytes, 0, 10);
+    m_bytes[10] = 0xFF;
+    m_bytes[11] = 0xFF;
+    m_bytes[12] = static_cast<Uint8>(address >> 24);
+    m_bytes[13] = static_cast<Uint8>(address >> 16);
+    m_bytes[14] = static_cast<Uint8>(address >> 8);
+    m_bytes[15] = static_cast<Uint8>(address);
 }
 
 
 ////////////////////////////////////////////////////////////
-IpAddress::IpAddress(Uint32 address) :
-m_address(htonl(address))
+IpAddress::IpAddress(const Uint8* bytes)
 {
+    std::memcpy(m_bytes, bytes, sizeof(m_bytes));
 }
 
 
 ////////////////////////////////////////////////////////////
 std::string IpAddress::toString() const
 {
-    in_addr address;
-    address.s_addr = m_address;
+    if (!isIpv6())
+    {
+        in_addr address;
+        address.s_addr = htonl(toInteger());
+
+        return inet_ntoa(address);
+    }
 
-    return inet_ntoa(address);
+    sockaddr_in6 address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin6_family = AF_INET6;
+    std::memcpy(&address.sin6_addr, m_bytes, sizeof(m_bytes));
+
+    char buffer[64];
+    if (getnameinfo(reinterpret_cast<sockaddr*>(&address), sizeof(address), buffer, sizeof(buffer), NULL, 0, NI_NUMERICHOST) != 0)
+        return "";
+
+    return buffer;
 }
 
 
 ////////////////////////////////////////////////////////////
 Uint32 IpAddress::toInteger() const
 {
-    return ntohl(m_address);
+    if (isIpv6())
+        return 0;
+
+    return (static_cast<Uint32>(m_bytes[12]) << 24) | (m_bytes[13] << 16) | (m_bytes[14] << 8) | m_bytes[15];
+}
+
+
+////////////////////////////////////////////////////////////
+void IpAddress::toBytes(Uint8* bytes) const
+{
+    std::memcpy(bytes, m_bytes, sizeof(m_bytes));
+}
+
+
+////////////////////////////////////////////////////////////
+bool IpAddress::isIpv6() const
+{
+    static const Uint8 mappedPrefix[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF};
+    return std::memcmp(m_bytes, mappedPrefix, sizeof(mappedPrefix)) != 0;
 }
 
 
@@ -193,10 +425,63 @@ IpAddress IpAddress::getPublicAddress(Time timeout)
 }
 
 
+////////////////////////////////////////////////////////////
+bool IpAddress::resolveAsync(const std::string& address, IpAddress& result)
+{
+    if (parseAddress(address, result))
+        return true;
+
+    Lock lock(resolver.mutex);
+
+    std::vector<IpAddress> addresses;
+    if (resolver.find(address, addresses))
+    {
+        result = getPreferred(addresses);
+        return true;
+    }
+
+    // Queue the name, unless the thread is already resolving it
+    Resolver::Entry& entry = resolver.entries[address];
+    if (!entry.isPending)
+    {
+        entry.isPending = true;
+        resolver.queue.push_back(address);
+
+        if (!resolver.isRunning)
+        {
+            resolver.isRunning = true;
+            resolver.thread.launch();
+        }
+    }
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+std::vector<IpAddress> IpAddress::resolveAll(const std::string& address)
+{
+    return ::resolveAll(address);
+}
+
+
+////////////////////////////////////////////////////////////
+void IpAddress::setResolutionCacheDuration(Time duration)
+{
+    Lock lock(resolver.mutex);
+    resolver.duration = duration;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool operator ==(const IpAddress& left, const IpAddress& right)
 {
-    return left.toInteger() == right.toInteger();
+    Uint8 leftBytes[16];
+    Uint8 rightBytes[16];
+    left.toBytes(leftBytes);
+    right.toBytes(rightBytes);
+
+    return std::memcmp(leftBytes, rightBytes, sizeof(leftBytes)) == 0;
 }
 
 
@@ -210,7 +495,13 @@ bool operator !=(const IpAddress& left, const IpAddress& right)
 ////////////////////////////////////////////////////////////
 bool operator <(const IpAddress& left, const IpAddress& right)
 {
-    return left.toInteger() < right.toInteger();
+    // Comparing the bytes keeps the order of the integers for IPv4 addresses
+    Uint8 leftBytes[16];
+    Uint8 rightBytes[16];
+    left.toBytes(leftBytes);
+    right.toBytes(rightBytes);
+
+    return std::memcmp(leftBytes, rightBytes, sizeof(leftBytes)) < 0;
 }
 
 
@@ -0,0 +1,578 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/NetworkService.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/System/LockFreeQueue.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Flush threshold of the write buffer of the connections
+    const std::size_t writeBufferSize = 65536;
+
+    // Size of the read-ahead buffer of the connections
+    const std::size_t readAheadSize = 16384;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+NetworkService::Connection::Connection(ConnectionId identifier) :
+id        (identifier),
+connecting(false),
+closing   (false),
+dirty     (false)
+{
+    // Many packets sent or received in a row then cost a single system call
+    socket.setBlocking(false);
+    socket.setWriteBuffer(writeBufferSize);
+    socket.setReadAhead(readAheadSize);
+}
+
+
+////////////////////////////////////////////////////////////
+NetworkService::NetworkService(std::size_t queueSize) :
+m_pool        (),
+m_commands    (new priv::MpscQueue<Command>(queueSize)),
+m_events      (new priv::SpscQueue<Event>(queueSize)),
+m_wakePort    (0),
+m_wakePending (0),
+m_running     (1),
+m_nextId      (1),
+m_thread      (&NetworkService::run, this)
+{
+    // The network thread waits on its selector: a datagram sent to this socket wakes it up
+    m_wakeReceiver.bind(Socket::AnyPort, IpAddress::LocalHost);
+    m_wakeReceiver.setBlocking(false);
+    m_wakePort = m_wakeReceiver.getLocalPort();
+    m_wakeSender.bind(Socket::AnyPort, IpAddress::LocalHost);
+    m_selector.add(m_wakeReceiver);
+
+    m_thread.launch();
+}
+
+
+////////////////////////////////////////////////////////////
+NetworkService::~NetworkService()
+{
+    // Stop the network thread
+    priv::atomicStore(m_running, 0);
+    char wake = 0;
+    m_wakeSender.send(&wake, 1, IpAddress::LocalHost, m_wakePort);
+    m_thread.wait();
+
+    // Destroy the connections and listeners
+    for (ConnectionTable::iterator it = m_connections.begin(); it != m_connections.end(); ++it)
+    {
+        for (std::deque<Packet*>::iterator packet = it->second->waiting.begin(); packet != it->second->waiting.end(); ++packet)
+            m_pool.release(*packet);
+
+        delete it->second;
+    }
+
+    for (std::vector<TcpListener*>::iterator it = m_listeners.begin(); it != m_listeners.end(); ++it)
+        delete *it;
+
+    // Release what is left in the queues
+    Command command;
+    while (m_commands->pop(command))
+    {
+        m_pool.release(command.packet);
+        delete command.listener;
+    }
+
+    Event event;
+    while (m_events->pop(event))
+        m_pool.release(event.packet);
+
+    for (std::deque<Event>::iterator it = m_overflow.begin(); it != m_overflow.end(); ++it)
+        m_pool.release(it->packet);
+
+    delete m_commands;
+    delete m_events;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status NetworkService::listen(unsigned short port, const IpAddress& address)
+{
+    // Bind the port right away, the network thread only accepts the connections
+    TcpListener* listener = new TcpListener;
+    listener->setBlocking(false);
+
+    Socket::Status status = listener->listen(port, address);
+    if (status != Socket::Done)
+    {
+        delete listener;
+        return status;
+    }
+
+    Command command;
+    command.type       = Command::Listen;
+    command.connection = 0;
+    command.packet     = NULL;
+    command.listener   = listener;
+    command.port       = 0;
+
+    if (!post(command))
+    {
+        delete listener;
+        return Socket::NotReady;
+    }
+
+    return Socket::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+NetworkService::ConnectionId NetworkService::connect(const IpAddress& remoteAddress, unsigned short remotePort)
+{
+    Command command;
+    command.type       = Command::Connect;
+    command.connection = generateId();
+    command.packet     = NULL;
+    command.listener   = NULL;
+    command.address    = remoteAddress;
+    command.port       = remotePort;
+
+    return post(command) ? command.connection : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool NetworkService::send(ConnectionId connection, Packet* packet)
+{
+    if (!packet)
+        return false;
+
+    Command command;
+    command.type       = Command::Send;
+    command.connection = connection;
+    command.packet     = packet;
+    command.listener   = NULL;
+    command.port       = 0;
+
+    return post(command);
+}
+
+
+////////////////////////////////////////////////////////////
+bool NetworkService::disconnect(ConnectionId connection)
+{
+    Command command;
+    command.type       = Command::Disconnect;
+    command.connection = connection;
+    command.packet     = NULL;
+    command.listener   = NULL;
+    command.port       = 0;
+
+    return post(command);
+}
+
+
+////////////////////////////////////////////////////////////
+bool NetworkService::pollEvent(Event& event)
+{
+    return m_events->pop(event);
+}
+
+
+////////////////////////////////////////////////////////////
+PacketPool& NetworkService::getPacketPool()
+{
+    return m_pool;
+}
+
+
+////////////////////////////////////////////////////////////
+bool NetworkService::post(const Command& command)
+{
+    if (!m_commands->push(command))
+        return false;
+
+    // Only the first request since the last wake-up has to wake the network thread up
+    if (priv::atomicExchange(m_wakePending, 1) == 0)
+    {
+        char wake = 0;
+        m_wakeSender.send(&wake, 1, IpAddress::LocalHost, m_wakePort);
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkService::run()
+{
+    while (priv::atomicLoad(m_running))
+    {
+        if (m_overflow.empty())
+        {
+            // Sleep until a socket is ready or a request arrives
+            if (m_selector.wait())
+                processSockets();
+        }
+        else
+        {
+            // The application is late: leave the received data in the
+            // sockets until it catches up, but keep sending
+            sleep(milliseconds(1));
+            deliverEvents();
+
+            for (ConnectionTable::iterator it = m_connections.begin(); it != m_connections.end();)
+            {
+                Connection* connection = (it++)->second;
+                if (!connection->dirty && (connection->socket.getUnflushedSize() > 0))
+                {
+                    connection->dirty = true;
+                    m_dirty.push_back(connection);
+                }
+
+                // The selector doesn't report the data already read ahead: resume it ourselves
+                if (m_overflow.empty() && !connection->connecting && (connection->socket.getBufferedSize() > 0))
+                {
+                    if (!receivePackets(*connection))
+                        closeConnection(connection);
+                }
+            }
+        }
+
+        processCommands();
+        flushConnections();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkService::processCommands()
+{
+    Command command;
+    while (m_commands->pop(command))
+    {
+        if (command.type == Command::Listen)
+        {
+            m_listeners.push_back(command.listener);
+            m_selector.add(*command.listener);
+            continue;
+        }
+
+        if (command.type == Command::Connect)
+        {
+            Connection* connection = new Connection(command.connection);
+            Socket::Status status = connection->socket.connect(command.address, command.port);
+
+            if (status == Socket::Done)
+            {
+                addConnection(connection);
+                postEvent(Event::Connected, connection->id);
+            }
+            else if (status == Socket::NotReady)
+            {
+                // The connection is established in the background
+                connection->connecting = true;
+                addConnection(connection);
+            }
+            else
+            {
+                postEvent(Event::Disconnected, connection->id);
+                delete connection;
+            }
+
+            continue;
+        }
+
+        // The other requests are for an existing connection
+        ConnectionTable::iterator it = m_connections.find(command.connection);
+        if (it == m_connections.end())
+        {
+            m_pool.release(command.packet);
+            continue;
+        }
+
+        Connection& connection = *it->second;
+        if (command.type == Command::Send)
+        {
+            if (connection.connecting)
+                connection.waiting.push_back(command.packet);
+            else
+                sendPacket(connection, command.packet);
+        }
+        else
+        {
+            // Close the connection once the data written to it is sent
+            connection.closing = true;
+            if (!connection.connecting && !connection.dirty)
+            {
+                connection.dirty = true;
+                m_dirty.push_back(&connection);
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkService::processSockets()
+{
+    // Closing connections removes them from the ready events: work on a copy
+    m_ready = m_selector.getReadyEvents();
+
+    for (ReadyEventArray::const_iterator it = m_ready.begin(); it != m_ready.end(); ++it)
+    {
+        if (it->socket == &m_wakeReceiver)
+        {
+            // Drain the wake-up datagrams, then let the next request wake us up again
+            char buffer[64];
+            std::size_t received;
+            IpAddress sender;
+            unsigned short port;
+            while (m_wakeReceiver.receive(buffer, sizeof(buffer), received, sender, port) == Socket::Done)
+            {
+            }
+
+            priv::atomicStore(m_wakePending, 0);
+            continue;
+        }
+
+        if (!it->userData)
+        {
+            acceptConnections(*static_cast<TcpListener*>(it->socket));
+            continue;
+        }
+
+        Connection* connection = static_cast<Connection*>(it->userData);
+        if (connection->connecting)
+        {
+            // The connection attempt is over, one way or the other
+            if (connection->socket.getRemoteAddress() == IpAddress::None)
+            {
+                closeConnection(connection);
+                continue;
+            }
+
+            connection->connecting = false;
+            m_selector.setEvents(connection->socket, SocketSelector::Receive | SocketSelector::Error);
+            postEvent(Event::Connected, connection->id);
+
+            while (!connection->waiting.empty())
+            {
+                sendPacket(*connection, connection->waiting.front());
+                connection->waiting.pop_front();
+            }
+
+            if (connection->closing && !connection->dirty)
+            {
+                connection->dirty = true;
+                m_dirty.push_back(connection);
+            }
+
+            continue;
+        }
+
+        // Flush the pending data when the socket can send again
+        if ((it->events & SocketSelector::Send) && !connection->dirty)
+        {
+            connection->dirty = true;
+            m_dirty.push_back(connection);
+        }
+
+        if ((it->events & (SocketSelector::Receive | SocketSelector::Error)) && m_overflow.empty())
+        {
+            if (!receivePackets(*connection))
+                closeConnection(connection);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkService::flushConnections()
+{
+    // Closing connections removes them from the dirty list: work on a copy
+    std::vector<Connection*> dirty;
+    dirty.swap(m_dirty);
+
+    for (std::vector<Connection*>::iterator it = dirty.begin(); it != dirty.end(); ++it)
+    {
+        Connection* connection = *it;
+        connection->dirty = false;
+
+        Socket::Status status = connection->socket.flush();
+        if (status == Socket::Done)
+        {
+            if (connection->closing)
+                closeConnection(connection);
+            else
+                m_selector.setEvents(connection->socket, SocketSelector::Receive | SocketSelector::Error);
+        }
+        else if ((status == Socket::Partial) || (status == Socket::NotReady))
+        {
+            // Wait until the socket can send the rest
+            m_selector.setEvents(connection->socket, SocketSelector::Receive | SocketSelector::Send | SocketSelector::Error);
+        }
+        else
+        {
+            closeConnection(connection);
+        }
+    }
+
+    // Give the memory back to the list, unless it got new connections meanwhile
+    if (m_dirty.empty())
+    {
+        dirty.clear();
+        dirty.swap(m_dirty);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkService::acceptConnections(TcpListener& listener)
+{
+    for (;;)
+    {
+        Connection* connection = new Connection(generateId());
+        if (listener.accept(connection->socket) != Socket::Done)
+        {
+            delete connection;
+            return;
+        }
+
+        addConnection(connection);
+        postEvent(Event::Connected, connection->id);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+NetworkService::ConnectionId NetworkService::generateId()
+{
+    ConnectionId id = static_cast<ConnectionId>(priv::atomicFetchAdd(m_nextId, 1));
+
+    // Skip 0 when the counter wraps around
+    if (id == 0)
+        id = static_cast<ConnectionId>(priv::atomicFetchAdd(m_nextId, 1));
+
+    return id;
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkService::addConnection(Connection* connection)
+{
+    m_connections.insert(std::make_pair(connection->id, connection));
+
+    Uint32 events = connection->connecting ? SocketSelector::Send : SocketSelector::Receive;
+    m_selector.add(connection->socket, events | SocketSelector::Error, connection);
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkService::sendPacket(Connection& connection, Packet* packet)
+{
+    // The write buffer takes a copy of the data, the packet can be reused right away
+    Socket::Status status = connection.socket.send(*packet);
+    m_pool.release(packet);
+
+    // A failed connection is closed by the next flush
+    if (status != Socket::Done)
+        connection.closing = true;
+
+    if (!connection.dirty)
+    {
+        connection.dirty = true;
+        m_dirty.push_back(&connection);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool NetworkService::receivePackets(Connection& connection)
+{
+    // Stop when nothing is left, or when the application lags behind
+    while (m_overflow.empty())
+    {
+        Packet* packet = m_pool.acquire();
+        Socket::Status status = connection.socket.receive(*packet);
+
+        if (status != Socket::Done)
+        {
+            m_pool.release(packet);
+            return status == Socket::NotReady;
+        }
+
+        postEvent(Event::Received, connection.id, packet);
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkService::closeConnection(Connection* connection)
+{
+    m_selector.remove(connection->socket);
+    connection->socket.disconnect();
+
+    if (connection->dirty)
+        m_dirty.erase(std::find(m_dirty.begin(), m_dirty.end(), connection));
+
+    for (std::deque<Packet*>::iterator it = connection->waiting.begin(); it != connection->waiting.end(); ++it)
+        m_pool.release(*it);
+
+    postEvent(Event::Disconnected, connection->id);
+
+    m_connections.erase(connection->id);
+    delete connection;
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkService::postEvent(Event::Type type, ConnectionId connection, Packet* packet)
+{
+    Event event;
+    event.type       = type;
+    event.connection = connection;
+    event.packet     = packet;
+
+    // Keep the order of the events: once one overflows, the next ones wait behind it
+    if (!m_overflow.empty() || !m_events->push(event))
+        m_overflow.push_back(event);
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkService::deliverEvents()
+{
+    while (!m_overflow.empty() && m_events->push(m_overflow.front()))
+        m_overflow.pop_front();
+}
+
+} // namespace sf
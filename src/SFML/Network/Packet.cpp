@@ -32,13 +32,49 @@
 #include <cwchar>
 
 
+namespace
+{
+    // Write integers in network byte order (big endian); the loop is the
+    // same whatever the byte order of the host, compilers turn it into
+    // byte swaps that they can vectorize
+    template <typename T>
+    void writeBigEndian(std::vector<char>& buffer, const T* values, std::size_t count)
+    {
+        std::size_t start = buffer.size();
+        buffer.resize(start + count * sizeof(T));
+
+        sf::Uint8* bytes = reinterpret_cast<sf::Uint8*>(&buffer[start]);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            for (std::size_t j = 0; j < sizeof(T); ++j)
+                bytes[i * sizeof(T) + j] = static_cast<sf::Uint8>(values[i] >> ((sizeof(T) - 1 - j) * 8));
+        }
+    }
+
+    // Read integers stored in network byte order (big endian)
+    template <typename T>
+    void readBigEndian(const char* buffer, T* values, std::size_t count)
+    {
+        const sf::Uint8* bytes = reinterpret_cast<const sf::Uint8*>(buffer);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            T value = 0;
+            for (std::size_t j = 0; j < sizeof(T); ++j)
+                value = static_cast<T>((value << 8) | bytes[i * sizeof(T) + j]);
+            values[i] = value;
+        }
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Packet::Packet() :
 m_readPos(0),
 m_sendPos(0),
-m_isValid(true)
+m_isValid(true),
+m_memory (MemoryTracker::Packets)
 {
 
 }
@@ -59,6 +95,7 @@ void Packet::append(const void* data, std::size_t sizeInBytes)
         std::size_t start = m_data.size();
         m_data.resize(start + sizeInBytes);
         std::memcpy(&m_data[start], data, sizeInBytes);
+        m_memory.setBytes(m_data.capacity());
     }
 }
 
@@ -67,11 +104,27 @@ void Packet::append(const void* data, std::size_t sizeInBytes)
 void Packet::clear()
 {
     m_data.clear();
+    m_memory.setBytes(m_data.capacity());
     m_readPos = 0;
     m_isValid = true;
 }
 
 
+////////////////////////////////////////////////////////////
+void Packet::reserve(std::size_t sizeInBytes)
+{
+    m_data.reserve(sizeInBytes);
+    m_memory.setBytes(m_data.capacity());
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Packet::getCapacity() const
+{
+    return m_data.capacity();
+}
+
+
 ////////////////////////////////////////////////////////////
 const void* Packet::getData() const
 {
@@ -570,6 +623,272 @@ Packet& Packet::operator <<(const String& data)
 }
 
 
+////////////////////////////////////////////////////////////
+Packet& Packet::appendVarUint(Uint64 data)
+{
+    // 7 bits per byte, the high bit tells if more bytes follow
+    Uint8 bytes[10];
+    std::size_t size = 0;
+    do
+    {
+        bytes[size] = static_cast<Uint8>(data & 0x7F);
+        data >>= 7;
+        if (data)
+            bytes[size] |= 0x80;
+        size++;
+    }
+    while (data);
+
+    append(bytes, size);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendVarInt(Int64 data)
+{
+    // Zigzag encoding: 0, -1, 1, -2, 2... become 0, 1, 2, 3, 4...
+    Uint64 value = (static_cast<Uint64>(data) << 1) ^ static_cast<Uint64>(data >> 63);
+
+    return appendVarUint(value);
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readVarUint(Uint64& data)
+{
+    Uint64 value = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7)
+    {
+        if (!checkSize(1))
+            return *this;
+
+        Uint8 byte = static_cast<Uint8>(m_data[m_readPos++]);
+        value |= static_cast<Uint64>(byte & 0x7F) << shift;
+
+        if (!(byte & 0x80))
+        {
+            data = value;
+            return *this;
+        }
+    }
+
+    // More than 64 bits: the data is corrupted
+    m_isValid = false;
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readVarInt(Int64& data)
+{
+    Uint64 value = 0;
+    if (readVarUint(value))
+        data = static_cast<Int64>((value >> 1) ^ (~(value & 1) + 1));
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendArray(const Int8* data, std::size_t count)
+{
+    append(data, count);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendArray(const Uint8* data, std::size_t count)
+{
+    append(data, count);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendArray(const Int16* data, std::size_t count)
+{
+    return appendArray(reinterpret_cast<const Uint16*>(data), count);
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendArray(const Uint16* data, std::size_t count)
+{
+    if (data && (count > 0))
+    {
+        writeBigEndian(m_data, data, count);
+        m_memory.setBytes(m_data.capacity());
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendArray(const Int32* data, std::size_t count)
+{
+    return appendArray(reinterpret_cast<const Uint32*>(data), count);
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendArray(const Uint32* data, std::size_t count)
+{
+    if (data && (count > 0))
+    {
+        writeBigEndian(m_data, data, count);
+        m_memory.setBytes(m_data.capacity());
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendArray(const Int64* data, std::size_t count)
+{
+    return appendArray(reinterpret_cast<const Uint64*>(data), count);
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendArray(const Uint64* data, std::size_t count)
+{
+    if (data && (count > 0))
+    {
+        writeBigEndian(m_data, data, count);
+        m_memory.setBytes(m_data.capacity());
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendArray(const float* data, std::size_t count)
+{
+    // Like operator <<, floating point numbers are written as they are
+    append(data, count * sizeof(float));
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendArray(const double* data, std::size_t count)
+{
+    append(data, count * sizeof(double));
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Int8* data, std::size_t count)
+{
+    return readArray(reinterpret_cast<Uint8*>(data), count);
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Uint8* data, std::size_t count)
+{
+    if (data && checkArraySize(count, sizeof(Uint8)) && (count > 0))
+    {
+        std::memcpy(data, &m_data[m_readPos], count);
+        m_readPos += count;
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Int16* data, std::size_t count)
+{
+    return readArray(reinterpret_cast<Uint16*>(data), count);
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Uint16* data, std::size_t count)
+{
+    if (data && checkArraySize(count, sizeof(Uint16)) && (count > 0))
+    {
+        readBigEndian(&m_data[m_readPos], data, count);
+        m_readPos += count * sizeof(Uint16);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Int32* data, std::size_t count)
+{
+    return readArray(reinterpret_cast<Uint32*>(data), count);
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Uint32* data, std::size_t count)
+{
+    if (data && checkArraySize(count, sizeof(Uint32)) && (count > 0))
+    {
+        readBigEndian(&m_data[m_readPos], data, count);
+        m_readPos += count * sizeof(Uint32);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Int64* data, std::size_t count)
+{
+    return readArray(reinterpret_cast<Uint64*>(data), count);
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Uint64* data, std::size_t count)
+{
+    if (data && checkArraySize(count, sizeof(Uint64)) && (count > 0))
+    {
+        readBigEndian(&m_data[m_readPos], data, count);
+        m_readPos += count * sizeof(Uint64);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(float* data, std::size_t count)
+{
+    if (data && checkArraySize(count, sizeof(float)) && (count > 0))
+    {
+        std::memcpy(data, &m_data[m_readPos], count * sizeof(float));
+        m_readPos += count * sizeof(float);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(double* data, std::size_t count)
+{
+    if (data && checkArraySize(count, sizeof(double)) && (count > 0))
+    {
+        std::memcpy(data, &m_data[m_readPos], count * sizeof(double));
+        m_readPos += count * sizeof(double);
+    }
+
+    return *this;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Packet::checkSize(std::size_t size)
 {
@@ -579,6 +898,27 @@ bool Packet::checkSize(std::size_t size)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Packet::checkArraySize(std::size_t count, std::size_t elementSize)
+{
+    // Compare the number of values rather than their size, which could overflow
+    m_isValid = m_isValid && (count <= (m_data.size() - m_readPos) / elementSize);
+
+    return m_isValid;
+}
+
+
+////////////////////////////////////////////////////////////
+char* Packet::extend(std::size_t sizeInBytes)
+{
+    std::size_t start = m_data.size();
+    m_data.resize(start + sizeInBytes);
+    m_memory.setBytes(m_data.capacity());
+
+    return &m_data[start];
+}
+
+
 ////////////////////////////////////////////////////////////
 const void* Packet::onSend(std::size_t& size)
 {
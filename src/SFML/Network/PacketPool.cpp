@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/PacketPool.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/System/Lock.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+PacketPool::PacketPool(std::size_t maxFreePackets, std::size_t maxCapacity) :
+m_maxFreePackets(maxFreePackets),
+m_maxCapacity   (maxCapacity)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+PacketPool::~PacketPool()
+{
+    for (std::vector<Packet*>::iterator it = m_free.begin(); it != m_free.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet* PacketPool::acquire()
+{
+    {
+        Lock lock(m_mutex);
+
+        if (!m_free.empty())
+        {
+            Packet* packet = m_free.back();
+            m_free.pop_back();
+            return packet;
+        }
+    }
+
+    return new Packet;
+}
+
+
+////////////////////////////////////////////////////////////
+void PacketPool::release(Packet* packet)
+{
+    if (!packet)
+        return;
+
+    // Clear the packet outside the lock, it keeps its memory
+    packet->clear();
+
+    if (!m_maxCapacity || (packet->getCapacity() <= m_maxCapacity))
+    {
+        Lock lock(m_mutex);
+
+        if (m_free.size() < m_maxFreePackets)
+        {
+            m_free.push_back(packet);
+            return;
+        }
+    }
+
+    delete packet;
+}
+
+
+////////////////////////////////////////////////////////////
+void PacketPool::reserve(std::size_t count, std::size_t capacity)
+{
+    for (std::size_t i = 0; (i < count) && (getFreeCount() < m_maxFreePackets); ++i)
+    {
+        Packet* packet = new Packet;
+        packet->reserve(capacity);
+        release(packet);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PacketPool::getFreeCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_free.size();
+}
+
+} // namespace sf
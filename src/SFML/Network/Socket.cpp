@@ -26,19 +26,43 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Socket.hpp>
+#include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/SocketImpl.hpp>
+#include <SFML/Network/SocketMonitor.hpp>
+#include <SFML/System/Atomic.hpp>
 #include <SFML/System/Err.hpp>
 
 
+namespace
+{
+    // Names of the socket options, for error messages
+    const char* optionNames[] =
+    {
+        "SendBufferSize",
+        "ReceiveBufferSize",
+        "TypeOfService",
+        "BusyPoll",
+        "NoDelay",
+        "QuickAck",
+        "SegmentationOffload",
+        "ReceiveOffload"
+    };
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Socket::Socket(Type type) :
 m_type      (type),
 m_socket    (priv::SocketImpl::invalidSocket()),
-m_isBlocking(true)
+m_isBlocking(true),
+m_isIpv6    (false)
 {
+    for (int i = 0; i < CounterCount; ++i)
+        m_counters[i] = 0;
 
+    SocketMonitor::add(*this);
 }
 
 
@@ -47,6 +71,8 @@ Socket::~Socket()
 {
     // Close the socket before it gets destructed
     close();
+
+    SocketMonitor::remove(*this);
 }
 
 
@@ -68,6 +94,59 @@ bool Socket::isBlocking() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool Socket::setOption(Option option, int value)
+{
+    if (!priv::SocketImpl::isOptionSupported(option))
+        return false;
+
+    // Apply if the socket is already created
+    if ((m_socket != priv::SocketImpl::invalidSocket()) && !priv::SocketImpl::setOption(m_socket, option, value, m_isIpv6))
+        return false;
+
+    m_options[option] = value;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+int Socket::getOption(Option option) const
+{
+    OptionTable::const_iterator it = m_options.find(option);
+    if (it != m_options.end())
+        return it->second;
+
+    int value = 0;
+    if ((m_socket != priv::SocketImpl::invalidSocket()) && priv::SocketImpl::getOption(m_socket, option, value, m_isIpv6))
+        return value;
+
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Statistics Socket::getStatistics() const
+{
+    Statistics statistics;
+    statistics.bytesSent       = priv::atomicLoadRelaxed(m_counters[BytesSent]);
+    statistics.bytesReceived   = priv::atomicLoadRelaxed(m_counters[BytesReceived]);
+    statistics.packetsSent     = priv::atomicLoadRelaxed(m_counters[PacketsSent]);
+    statistics.packetsReceived = priv::atomicLoadRelaxed(m_counters[PacketsReceived]);
+    statistics.partialSends    = priv::atomicLoadRelaxed(m_counters[PartialSends]);
+    statistics.notReady        = priv::atomicLoadRelaxed(m_counters[NotReadyReturns]);
+
+    return statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::resetStatistics()
+{
+    for (int i = 0; i < CounterCount; ++i)
+        priv::atomicStoreRelaxed(m_counters[i], 0);
+}
+
+
 ////////////////////////////////////////////////////////////
 SocketHandle Socket::getHandle() const
 {
@@ -77,24 +156,65 @@ SocketHandle Socket::getHandle() const
 
 ////////////////////////////////////////////////////////////
 void Socket::create()
+{
+    create(IpAddress::Any);
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::create(const IpAddress& address)
 {
     // Don't create the socket if it already exists
     if (m_socket == priv::SocketImpl::invalidSocket())
     {
-        SocketHandle handle = socket(PF_INET, m_type == Tcp ? SOCK_STREAM : SOCK_DGRAM, 0);
-        create(handle);
+        int type = (m_type == Tcp) ? SOCK_STREAM : SOCK_DGRAM;
+
+        if (address.isIpv6())
+        {
+            SocketHandle handle = socket(PF_INET6, type, 0);
+            if (handle != priv::SocketImpl::invalidSocket())
+            {
+                // Accept IPv4 traffic too, through IPv4-mapped addresses
+                int no = 0;
+                if (setsockopt(handle, IPPROTO_IPV6, IPV6_V6ONLY, reinterpret_cast<char*>(&no), sizeof(no)) == -1)
+                {
+                    // Without dual-stack support, the unspecified address is better served by IPv4
+                    if (address == IpAddress::Any)
+                    {
+                        priv::SocketImpl::close(handle);
+                        handle = priv::SocketImpl::invalidSocket();
+                    }
+                }
+            }
+
+            if ((handle != priv::SocketImpl::invalidSocket()) || (address != IpAddress::Any))
+            {
+                create(handle, true);
+                return;
+            }
+        }
+
+        create(socket(PF_INET, type, 0), false);
     }
 }
 
 
 ////////////////////////////////////////////////////////////
 void Socket::create(SocketHandle handle)
+{
+    create(handle, priv::SocketImpl::isIpv6(handle));
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::create(SocketHandle handle, bool ipv6)
 {
     // Don't create the socket if it already exists
     if (m_socket == priv::SocketImpl::invalidSocket())
     {
         // Assign the new handle
         m_socket = handle;
+        m_isIpv6 = ipv6;
 
         // Set the current blocking state
         setBlocking(m_isBlocking);
@@ -126,6 +246,13 @@ void Socket::create(SocketHandle handle)
                 err() << "Failed to enable broadcast on UDP socket" << std::endl;
             }
         }
+
+        // Apply the options set by the user before the socket was created
+        for (OptionTable::const_iterator it = m_options.begin(); it != m_options.end(); ++it)
+        {
+            if (!priv::SocketImpl::setOption(m_socket, it->first, it->second, m_isIpv6))
+                err() << "Failed to set socket option \"" << optionNames[it->first] << "\" to " << it->second << std::endl;
+        }
     }
 }
 
@@ -141,4 +268,45 @@ void Socket::close()
     }
 }
 
+
+////////////////////////////////////////////////////////////
+bool Socket::isIpv6() const
+{
+    return m_isIpv6;
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::record(Counter counter, Uint64 amount)
+{
+    priv::atomicAddRelaxed(m_counters[counter], amount);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status Socket::recordStatus(Status status)
+{
+    if (status == Partial)
+        record(PartialSends);
+    else if (status == NotReady)
+        record(NotReadyReturns);
+
+    return status;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Socket::isCaptureEnabled() const
+{
+    return SocketMonitor::isCapturing();
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::capture(bool sent, const void* data, std::size_t size, const IpAddress& address, unsigned short port) const
+{
+    if (SocketMonitor::isCapturing())
+        SocketMonitor::capture(*this, sent, data, size, address, port);
+}
+
 } // namespace sf
@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/SocketMonitor.hpp>
+#include <SFML/System/Atomic.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <cstddef>
+#include <set>
+
+
+namespace
+{
+    // The registry is built on first use, so that sockets
+    // constructed by static initializers find it ready
+    struct Registry
+    {
+        Registry() :
+        handler (NULL),
+        sockets (),
+        closed  (),
+        mutex   (),
+        capture (),
+        clock   ()
+        {
+            closed.bytesSent       = 0;
+            closed.bytesReceived   = 0;
+            closed.packetsSent     = 0;
+            closed.packetsReceived = 0;
+            closed.partialSends    = 0;
+            closed.notReady        = 0;
+        }
+
+        void* volatile              handler; // Current capture handler (a SocketMonitor::CaptureHandler*)
+        std::set<const sf::Socket*> sockets; // Sockets that currently exist
+        sf::Socket::Statistics      closed;  // Sum of the counters of the destroyed sockets
+        sf::Mutex                   mutex;   // Protects the sockets and the closed counters
+        sf::Mutex                   capture; // Serializes the calls to the capture handler
+        sf::Clock                   clock;   // Origin of the capture timestamps
+    };
+
+    Registry& getRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    // Add the counters of a socket to a sum
+    void accumulate(sf::Socket::Statistics& total, const sf::Socket::Statistics& statistics)
+    {
+        total.bytesSent       += statistics.bytesSent;
+        total.bytesReceived   += statistics.bytesReceived;
+        total.packetsSent     += statistics.packetsSent;
+        total.packetsReceived += statistics.packetsReceived;
+        total.partialSends    += statistics.partialSends;
+        total.notReady        += statistics.notReady;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SocketMonitor::CaptureHandler::~CaptureHandler()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketMonitor::setCaptureHandler(CaptureHandler* handler)
+{
+    Registry& registry = getRegistry();
+
+    // Once the lock is taken, no packet is being given to the previous handler
+    Lock lock(registry.capture);
+    priv::atomicStorePointer(registry.handler, handler);
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketMonitor::getSockets(std::vector<SocketStatistics>& sockets)
+{
+    Registry& registry = getRegistry();
+    Lock lock(registry.mutex);
+
+    sockets.clear();
+    sockets.reserve(registry.sockets.size());
+    for (std::set<const Socket*>::const_iterator it = registry.sockets.begin(); it != registry.sockets.end(); ++it)
+    {
+        SocketStatistics entry;
+        entry.socket = *it;
+        entry.statistics = (*it)->getStatistics();
+        sockets.push_back(entry);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Statistics SocketMonitor::getTotalStatistics()
+{
+    Registry& registry = getRegistry();
+    Lock lock(registry.mutex);
+
+    Socket::Statistics total = registry.closed;
+    for (std::set<const Socket*>::const_iterator it = registry.sockets.begin(); it != registry.sockets.end(); ++it)
+        accumulate(total, (*it)->getStatistics());
+
+    return total;
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketMonitor::add(const Socket& socket)
+{
+    Registry& registry = getRegistry();
+    Lock lock(registry.mutex);
+
+    registry.sockets.insert(&socket);
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketMonitor::remove(const Socket& socket)
+{
+    Registry& registry = getRegistry();
+    Lock lock(registry.mutex);
+
+    registry.sockets.erase(&socket);
+    accumulate(registry.closed, socket.getStatistics());
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketMonitor::isCapturing()
+{
+    return priv::atomicLoadPointer(getRegistry().handler) != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketMonitor::capture(const Socket& socket, bool sent, const void* data, std::size_t size, const IpAddress& address, unsigned short port)
+{
+    Registry& registry = getRegistry();
+    Lock lock(registry.capture);
+
+    // The handler may have been removed since the caller checked it
+    CaptureHandler* handler = static_cast<CaptureHandler*>(priv::atomicLoadPointer(registry.handler));
+    if (handler)
+        handler->onPacket(socket, sent, registry.clock.getElapsedTime(), data, size, address, port);
+}
+
+} // namespace sf
@@ -30,8 +30,21 @@
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/Err.hpp>
 #include <algorithm>
+#include <map>
 #include <utility>
 
+// Each system uses its most scalable readiness API: epoll on Linux,
+// kqueue on BSD and Apple systems, select elsewhere (Windows)
+#if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID)
+    #define SFML_SELECTOR_EPOLL
+    #include <sys/epoll.h>
+    #include <errno.h>
+#elif defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS) || defined(SFML_SYSTEM_FREEBSD)
+    #define SFML_SELECTOR_KQUEUE
+    #include <sys/event.h>
+    #include <sys/time.h>
+#endif
+
 #ifdef _MSC_VER
     #pragma warning(disable: 4127) // "conditional expression is constant" generated by the FD_SET macro
 #endif
@@ -42,101 +55,377 @@ namespace sf
 ////////////////////////////////////////////////////////////
 struct SocketSelector::SocketSelectorImpl
 {
-    fd_set allSockets;   ///< Set containing all the sockets handles
-    fd_set socketsReady; ///< Set containing handles of the sockets that are ready
-    int    maxSocket;    ///< Maximum socket handle
-    int    socketCount;  ///< Number of socket handles
+    SocketSelectorImpl();
+    SocketSelectorImpl(const SocketSelectorImpl& copy);
+    ~SocketSelectorImpl();
+
+    void open();
+    void close();
+    bool watch(SocketHandle handle, Uint32 events, bool added);
+    void unwatch(SocketHandle handle);
+    void markReady(SocketHandle handle, Uint32 events);
+    void collectReady();
+
+    struct Entry
+    {
+        Socket* socket;   ///< Socket given to add
+        Uint32  events;   ///< Events watched on the socket
+        void*   userData; ///< User data given to add
+    };
+
+    typedef std::map<SocketHandle, Entry> EntryMap;
+    typedef std::pair<SocketHandle, Uint32> HandleEvents;
+
+    EntryMap                   entries;      ///< Sockets of the selector, indexed by their handle
+    std::vector<Socket*>       readySockets; ///< Sockets that were ready after the last wait
+    std::vector<ReadyEvent>    readyEvents;  ///< Events of the sockets that were ready after the last wait
+    std::vector<HandleEvents>  readyHandles; ///< Events of the ready sockets, sorted by handle
+
+#if defined(SFML_SELECTOR_EPOLL)
+
+    int                        queue;        ///< Epoll instance
+    std::vector<epoll_event>   events;       ///< Events returned by epoll_wait
+
+#elif defined(SFML_SELECTOR_KQUEUE)
+
+    int                        queue;        ///< Kernel event queue
+    std::vector<struct kevent> events;       ///< Events returned by kevent
+
+#else
+
+    fd_set                     receiveSet;   ///< Sockets watched for receiving
+    fd_set                     sendSet;      ///< Sockets watched for sending
+    fd_set                     errorSet;     ///< Sockets watched for errors
+    fd_set                     receiveReady; ///< Sockets ready to receive
+    fd_set                     sendReady;    ///< Sockets ready to send
+    fd_set                     errorReady;   ///< Sockets with an error
+
+#endif
+
+private:
+
+    SocketSelectorImpl& operator =(const SocketSelectorImpl&);
 };
 
 
 ////////////////////////////////////////////////////////////
-SocketSelector::SocketSelector() :
-m_impl(new SocketSelectorImpl)
+SocketSelector::SocketSelectorImpl::SocketSelectorImpl()
 {
-    clear();
+    open();
 }
 
 
 ////////////////////////////////////////////////////////////
-SocketSelector::SocketSelector(const SocketSelector& copy) :
-m_impl(new SocketSelectorImpl(*copy.m_impl))
+SocketSelector::SocketSelectorImpl::SocketSelectorImpl(const SocketSelectorImpl& copy) :
+entries     (copy.entries),
+readySockets(copy.readySockets),
+readyEvents (copy.readyEvents),
+readyHandles(copy.readyHandles)
+{
+    // Kernel queues can't be copied, register the sockets again
+    open();
+    for (EntryMap::const_iterator it = entries.begin(); it != entries.end(); ++it)
+        watch(it->first, it->second.events, true);
+}
+
+
+////////////////////////////////////////////////////////////
+SocketSelector::SocketSelectorImpl::~SocketSelectorImpl()
 {
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketSelector::SocketSelectorImpl::open()
+{
+#if defined(SFML_SELECTOR_EPOLL)
+
+    queue = epoll_create(1);
+    if (queue == -1)
+        err() << "Failed to create the epoll instance of the socket selector" << std::endl;
+
+#elif defined(SFML_SELECTOR_KQUEUE)
+
+    queue = kqueue();
+    if (queue == -1)
+        err() << "Failed to create the kernel event queue of the socket selector" << std::endl;
 
+#else
+
+    FD_ZERO(&receiveSet);
+    FD_ZERO(&sendSet);
+    FD_ZERO(&errorSet);
+
+#endif
 }
 
 
 ////////////////////////////////////////////////////////////
-SocketSelector::~SocketSelector()
+void SocketSelector::SocketSelectorImpl::close()
 {
-    delete m_impl;
+#if defined(SFML_SELECTOR_EPOLL) || defined(SFML_SELECTOR_KQUEUE)
+
+    if (queue != -1)
+        ::close(queue);
+    queue = -1;
+
+#endif
 }
 
 
 ////////////////////////////////////////////////////////////
-void SocketSelector::add(Socket& socket)
+bool SocketSelector::SocketSelectorImpl::watch(SocketHandle handle, Uint32 socketEvents, bool added)
 {
-    SocketHandle handle = socket.getHandle();
-    if (handle != priv::SocketImpl::invalidSocket())
+#if defined(SFML_SELECTOR_EPOLL)
+
+    if (queue == -1)
+        return false;
+
+    // Errors and hang-ups are always reported by epoll
+    epoll_event event;
+    event.events = 0;
+    event.data.fd = handle;
+    if (socketEvents & Receive)
+        event.events |= EPOLLIN;
+    if (socketEvents & Send)
+        event.events |= EPOLLOUT;
+    if (socketEvents & EdgeTriggered)
+        event.events |= EPOLLET;
+#ifdef EPOLLRDHUP
+    if (socketEvents & Error)
+        event.events |= EPOLLRDHUP;
+#endif
+
+    // The handle may still be registered if its socket was closed without
+    // being removed and the handle was reused
+    int result = epoll_ctl(queue, added ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, handle, &event);
+    if ((result == -1) && added && (errno == EEXIST))
+        result = epoll_ctl(queue, EPOLL_CTL_MOD, handle, &event);
+
+    if (result == -1)
     {
+        err() << "Failed to watch a socket in the selector (epoll_ctl failed)" << std::endl;
+        return false;
+    }
+
+#elif defined(SFML_SELECTOR_KQUEUE)
+
+    if (queue == -1)
+        return false;
 
-#if defined(SFML_SYSTEM_WINDOWS)
+    // End of file and errors are reported with the read filter
+    unsigned short flags = EV_ADD | ((socketEvents & EdgeTriggered) ? EV_CLEAR : 0);
+    bool read  = (socketEvents & (Receive | Error)) != 0;
+    bool write = (socketEvents & Send) != 0;
 
-        if (m_impl->socketCount >= FD_SETSIZE)
+    // Filters that are no longer wanted may not exist, their removal is allowed to fail
+    struct kevent changes[2];
+    EV_SET(&changes[0], handle, EVFILT_READ, read ? flags : EV_DELETE, 0, 0, NULL);
+    EV_SET(&changes[1], handle, EVFILT_WRITE, write ? flags : EV_DELETE, 0, 0, NULL);
+    for (int i = 0; i < 2; ++i)
+    {
+        if ((kevent(queue, &changes[i], 1, NULL, 0, NULL) == -1) && (changes[i].flags != EV_DELETE))
         {
-            err() << "The socket can't be added to the selector because the "
-                  << "selector is full. This is a limitation of your operating "
-                  << "system's FD_SETSIZE setting.";
-            return;
+            err() << "Failed to watch a socket in the selector (kevent failed)" << std::endl;
+            return false;
         }
+    }
+
+#else
 
-        if (FD_ISSET(handle, &m_impl->allSockets))
-            return;
+    if (added && (entries.size() >= static_cast<std::size_t>(FD_SETSIZE)))
+    {
+        err() << "The socket can't be added to the selector because the "
+              << "selector is full. This is a limitation of your operating "
+              << "system's FD_SETSIZE setting." << std::endl;
+        return false;
+    }
+
+    // Edge-triggered mode is not supported by select
+    unwatch(handle);
+    if (socketEvents & Receive)
+        FD_SET(handle, &receiveSet);
+    if (socketEvents & Send)
+        FD_SET(handle, &sendSet);
+    if (socketEvents & Error)
+        FD_SET(handle, &errorSet);
+
+#endif
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketSelector::SocketSelectorImpl::unwatch(SocketHandle handle)
+{
+    // Errors are ignored: closed handles are already removed from kernel queues
 
-        m_impl->socketCount++;
+#if defined(SFML_SELECTOR_EPOLL)
+
+    epoll_event event; // ignored, but must not be NULL on kernels older than 2.6.9
+    event.events = 0;
+    event.data.fd = handle;
+    if (queue != -1)
+        epoll_ctl(queue, EPOLL_CTL_DEL, handle, &event);
+
+#elif defined(SFML_SELECTOR_KQUEUE)
+
+    struct kevent change;
+    EV_SET(&change, handle, EVFILT_READ, EV_DELETE, 0, 0, NULL);
+    if (queue != -1)
+        kevent(queue, &change, 1, NULL, 0, NULL);
+    EV_SET(&change, handle, EVFILT_WRITE, EV_DELETE, 0, 0, NULL);
+    if (queue != -1)
+        kevent(queue, &change, 1, NULL, 0, NULL);
 
 #else
 
-        if (handle >= FD_SETSIZE)
+    FD_CLR(handle, &receiveSet);
+    FD_CLR(handle, &sendSet);
+    FD_CLR(handle, &errorSet);
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketSelector::SocketSelectorImpl::markReady(SocketHandle handle, Uint32 socketEvents)
+{
+    readyHandles.push_back(std::make_pair(handle, socketEvents));
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketSelector::SocketSelectorImpl::collectReady()
+{
+    // Merge the events reported separately for the same socket
+    std::sort(readyHandles.begin(), readyHandles.end());
+
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < readyHandles.size(); ++i)
+    {
+        EntryMap::const_iterator it = entries.find(readyHandles[i].first);
+        if (it == entries.end())
+            continue;
+
+        // An error also wakes up the sockets waiting to receive or send,
+        // so that the failure is reported by their next receive or send
+        Uint32 socketEvents = readyHandles[i].second;
+        if (socketEvents & Error)
+            socketEvents |= Receive | Send;
+        socketEvents &= it->second.events & (Receive | Send | Error);
+
+        if (socketEvents == 0)
+            continue;
+
+        if ((count > 0) && (readyHandles[count - 1].first == readyHandles[i].first))
         {
-            err() << "The socket can't be added to the selector because its "
-                  << "ID is too high. This is a limitation of your operating "
-                  << "system's FD_SETSIZE setting.";
-            return;
+            readyHandles[count - 1].second |= socketEvents;
+            readyEvents.back().events |= socketEvents;
         }
+        else
+        {
+            readyHandles[count++] = std::make_pair(readyHandles[i].first, socketEvents);
+
+            ReadyEvent event;
+            event.socket   = it->second.socket;
+            event.events   = socketEvents;
+            event.userData = it->second.userData;
+            readyEvents.push_back(event);
+            readySockets.push_back(event.socket);
+        }
+    }
 
-        // SocketHandle is an int in POSIX
-        m_impl->maxSocket = std::max(m_impl->maxSocket, handle);
+    readyHandles.resize(count);
+}
 
-#endif
 
-        FD_SET(handle, &m_impl->allSockets);
-    }
+////////////////////////////////////////////////////////////
+SocketSelector::SocketSelector() :
+m_impl(new SocketSelectorImpl)
+{
 }
 
 
 ////////////////////////////////////////////////////////////
-void SocketSelector::remove(Socket& socket)
+SocketSelector::SocketSelector(const SocketSelector& copy) :
+m_impl(new SocketSelectorImpl(*copy.m_impl))
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+SocketSelector::~SocketSelector()
+{
+    delete m_impl;
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketSelector::add(Socket& socket, Uint32 events, void* userData)
 {
     SocketHandle handle = socket.getHandle();
     if (handle != priv::SocketImpl::invalidSocket())
     {
+        SocketSelectorImpl::EntryMap::iterator it = m_impl->entries.find(handle);
+        if (m_impl->watch(handle, events, it == m_impl->entries.end()))
+        {
+            SocketSelectorImpl::Entry& entry = m_impl->entries[handle];
+            entry.socket   = &socket;
+            entry.events   = events;
+            entry.userData = userData;
+        }
+    }
+}
 
-#if defined(SFML_SYSTEM_WINDOWS)
 
-        if (!FD_ISSET(handle, &m_impl->allSockets))
-            return;
+////////////////////////////////////////////////////////////
+void SocketSelector::setEvents(Socket& socket, Uint32 events)
+{
+    SocketSelectorImpl::EntryMap::iterator it = m_impl->entries.find(socket.getHandle());
+    if ((it != m_impl->entries.end()) && (it->second.socket == &socket))
+    {
+        if (m_impl->watch(it->first, events, false))
+            it->second.events = events;
+    }
+}
 
-        m_impl->socketCount--;
 
-#else
+////////////////////////////////////////////////////////////
+void SocketSelector::remove(Socket& socket)
+{
+    // Find the socket by its handle, or by its address if it was closed since it was added
+    SocketHandle handle = socket.getHandle();
+    SocketSelectorImpl::EntryMap::iterator it = m_impl->entries.find(handle);
+    if ((it == m_impl->entries.end()) || (it->second.socket != &socket))
+    {
+        for (it = m_impl->entries.begin(); it != m_impl->entries.end(); ++it)
+        {
+            if (it->second.socket == &socket)
+                break;
+        }
+    }
 
-        if (handle >= FD_SETSIZE)
-            return;
+    if (it == m_impl->entries.end())
+        return;
 
-#endif
+    handle = it->first;
+    m_impl->unwatch(handle);
+    m_impl->entries.erase(it);
 
-        FD_CLR(handle, &m_impl->allSockets);
-        FD_CLR(handle, &m_impl->socketsReady);
+    // Forget it if it was ready
+    std::vector<SocketSelectorImpl::HandleEvents>::iterator ready = std::lower_bound(m_impl->readyHandles.begin(),
+                                                                                      m_impl->readyHandles.end(),
+                                                                                      std::make_pair(handle, Uint32(0)));
+    if ((ready != m_impl->readyHandles.end()) && (ready->first == handle))
+    {
+        std::size_t index = std::find(m_impl->readySockets.begin(), m_impl->readySockets.end(), &socket) - m_impl->readySockets.begin();
+        m_impl->readySockets.erase(m_impl->readySockets.begin() + index);
+        m_impl->readyEvents.erase(m_impl->readyEvents.begin() + index);
+        m_impl->readyHandles.erase(ready);
     }
 }
 
@@ -144,51 +433,143 @@ void SocketSelector::remove(Socket& socket)
 ////////////////////////////////////////////////////////////
 void SocketSelector::clear()
 {
-    FD_ZERO(&m_impl->allSockets);
-    FD_ZERO(&m_impl->socketsReady);
-
-    m_impl->maxSocket = 0;
-    m_impl->socketCount = 0;
+    // Recreating the kernel queue is cheaper than unregistering every socket
+    m_impl->close();
+    m_impl->open();
+
+    m_impl->entries.clear();
+    m_impl->readySockets.clear();
+    m_impl->readyEvents.clear();
+    m_impl->readyHandles.clear();
 }
 
 
 ////////////////////////////////////////////////////////////
 bool SocketSelector::wait(Time timeout)
 {
+    m_impl->readySockets.clear();
+    m_impl->readyEvents.clear();
+    m_impl->readyHandles.clear();
+
+#if defined(SFML_SELECTOR_EPOLL)
+
+    if (m_impl->queue == -1)
+        return false;
+
+    // epoll only has a millisecond precision, round up so that a short timeout doesn't become a poll
+    int time = timeout != Time::Zero ? static_cast<int>((timeout.asMicroseconds() + 999) / 1000) : -1;
+
+    m_impl->events.resize(std::max<std::size_t>(m_impl->entries.size(), 1));
+    int count = epoll_wait(m_impl->queue, &m_impl->events[0], static_cast<int>(m_impl->events.size()), time);
+
+    for (int i = 0; i < count; ++i)
+    {
+        Uint32 flags = m_impl->events[i].events;
+        Uint32 events = 0;
+        if (flags & EPOLLIN)
+            events |= Receive;
+        if (flags & EPOLLOUT)
+            events |= Send;
+        if (flags & (EPOLLERR | EPOLLHUP))
+            events |= Error;
+#ifdef EPOLLRDHUP
+        if (flags & EPOLLRDHUP)
+            events |= Error;
+#endif
+
+        m_impl->markReady(m_impl->events[i].data.fd, events);
+    }
+
+#elif defined(SFML_SELECTOR_KQUEUE)
+
+    if (m_impl->queue == -1)
+        return false;
+
+    // Setup the timeout
+    timespec time;
+    time.tv_sec  = static_cast<time_t>(timeout.asNanoseconds() / 1000000000);
+    time.tv_nsec = static_cast<long>(timeout.asNanoseconds() % 1000000000);
+
+    // Each socket has up to two filters
+    m_impl->events.resize(std::max<std::size_t>(m_impl->entries.size() * 2, 1));
+    int count = kevent(m_impl->queue, NULL, 0, &m_impl->events[0], static_cast<int>(m_impl->events.size()), timeout != Time::Zero ? &time : NULL);
+
+    for (int i = 0; i < count; ++i)
+    {
+        const struct kevent& event = m_impl->events[i];
+        Uint32 events = (event.filter == EVFILT_WRITE) ? Send : Receive;
+        if (event.flags & (EV_EOF | EV_ERROR))
+            events |= Error;
+
+        m_impl->markReady(static_cast<SocketHandle>(event.ident), events);
+    }
+
+#else
+
     // Setup the timeout
     timeval time;
     time.tv_sec  = static_cast<long>(timeout.asMicroseconds() / 1000000);
     time.tv_usec = static_cast<long>(timeout.asMicroseconds() % 1000000);
 
-    // Initialize the set that will contain the sockets that are ready
-    m_impl->socketsReady = m_impl->allSockets;
+    // Initialize the sets that will contain the sockets that are ready
+    m_impl->receiveReady = m_impl->receiveSet;
+    m_impl->sendReady    = m_impl->sendSet;
+    m_impl->errorReady   = m_impl->errorSet;
+
+    // Wait until one of the sockets is ready, or timeout is reached
+    // The first parameter is ignored on Windows, and empty sets must be passed as NULL
+    int count = select(0, m_impl->receiveReady.fd_count ? &m_impl->receiveReady : NULL,
+                          m_impl->sendReady.fd_count    ? &m_impl->sendReady    : NULL,
+                          m_impl->errorReady.fd_count   ? &m_impl->errorReady   : NULL,
+                          timeout != Time::Zero ? &time : NULL);
 
-    // Wait until one of the sockets is ready for reading, or timeout is reached
-    // The first parameter is ignored on Windows
-    int count = select(m_impl->maxSocket + 1, &m_impl->socketsReady, NULL, NULL, timeout != Time::Zero ? &time : NULL);
+    // On Windows, the sets are arrays of the handles that are ready
+    if (count > 0)
+    {
+        for (u_int i = 0; i < m_impl->receiveReady.fd_count; ++i)
+            m_impl->markReady(m_impl->receiveReady.fd_array[i], Receive);
+        for (u_int i = 0; i < m_impl->sendReady.fd_count; ++i)
+            m_impl->markReady(m_impl->sendReady.fd_array[i], Send);
+        for (u_int i = 0; i < m_impl->errorReady.fd_count; ++i)
+            m_impl->markReady(m_impl->errorReady.fd_array[i], Error);
+    }
 
-    return count > 0;
+#endif
+
+    m_impl->collectReady();
+
+    return !m_impl->readySockets.empty();
 }
 
 
 ////////////////////////////////////////////////////////////
-bool SocketSelector::isReady(Socket& socket) const
+bool SocketSelector::isReady(Socket& socket, Uint32 events) const
 {
     SocketHandle handle = socket.getHandle();
     if (handle != priv::SocketImpl::invalidSocket())
     {
+        std::vector<SocketSelectorImpl::HandleEvents>::const_iterator it = std::lower_bound(m_impl->readyHandles.begin(),
+                                                                                            m_impl->readyHandles.end(),
+                                                                                            std::make_pair(handle, Uint32(0)));
 
-#if !defined(SFML_SYSTEM_WINDOWS)
+        return (it != m_impl->readyHandles.end()) && (it->first == handle) && ((it->second & events) != 0);
+    }
 
-        if (handle >= FD_SETSIZE)
-            return false;
+    return false;
+}
 
-#endif
 
-        return FD_ISSET(handle, &m_impl->socketsReady) != 0;
-    }
+////////////////////////////////////////////////////////////
+const std::vector<Socket*>& SocketSelector::getReadySockets() const
+{
+    return m_impl->readySockets;
+}
 
-    return false;
+
+////////////////////////////////////////////////////////////
+const std::vector<SocketSelector::ReadyEvent>& SocketSelector::getReadyEvents() const
+{
+    return m_impl->readyEvents;
 }
 
 
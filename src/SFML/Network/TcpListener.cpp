@@ -35,7 +35,8 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 TcpListener::TcpListener() :
-Socket(Tcp)
+Socket       (Tcp),
+m_portSharing(false)
 {
 
 }
@@ -47,11 +48,13 @@ unsigned short TcpListener::getLocalPort() const
     if (getHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve informations about the local end of the socket
-        sockaddr_in address;
+        sockaddr_storage address;
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getsockname(getHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return ntohs(address.sin_port);
+            unsigned short port;
+            priv::SocketImpl::getAddress(address, port);
+            return port;
         }
     }
 
@@ -61,22 +64,45 @@ unsigned short TcpListener::getLocalPort() const
 
 
 ////////////////////////////////////////////////////////////
-Socket::Status TcpListener::listen(unsigned short port)
+void TcpListener::setPortSharingEnabled(bool enabled)
 {
-    // Create the internal socket if it doesn't exist
-    create();
+    m_portSharing = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TcpListener::isPortSharingEnabled() const
+{
+    return m_portSharing;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpListener::listen(unsigned short port, const IpAddress& address)
+{
+    // Create the internal socket, of the family matching the address
+    close();
+    create(address);
+
+    // Let the other listeners bind to the same port
+    if (m_portSharing && !priv::SocketImpl::enablePortSharing(getHandle()))
+    {
+        err() << "Failed to share port " << port << " (not supported by the system)" << std::endl;
+        return Error;
+    }
 
     // Bind the socket to the specified port
-    sockaddr_in address = priv::SocketImpl::createAddress(INADDR_ANY, port);
-    if (bind(getHandle(), reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
+    sockaddr_storage localAddress;
+    priv::SocketImpl::AddrLength size = priv::SocketImpl::createAddress(address, port, isIpv6(), localAddress);
+    if ((size == 0) || (bind(getHandle(), reinterpret_cast<sockaddr*>(&localAddress), size) == -1))
     {
         // Not likely to happen, but...
         err() << "Failed to bind listener socket to port " << port << std::endl;
         return Error;
     }
 
-    // Listen to the bound port
-    if (::listen(getHandle(), 0) == -1)
+    // Listen to the bound port, with the longest queue of pending connections allowed
+    if (::listen(getHandle(), SOMAXCONN) == -1)
     {
         // Oops, socket is deaf
         err() << "Failed to listen to port " << port << std::endl;
@@ -106,17 +132,47 @@ Socket::Status TcpListener::accept(TcpSocket& socket)
     }
 
     // Accept a new connection
-    sockaddr_in address;
-    priv::SocketImpl::AddrLength length = sizeof(address);
-    SocketHandle remote = ::accept(getHandle(), reinterpret_cast<sockaddr*>(&address), &length);
+    SocketHandle remote = priv::SocketImpl::accept(getHandle(), socket.isBlocking());
 
     // Check for errors
     if (remote == priv::SocketImpl::invalidSocket())
         return priv::SocketImpl::getErrorStatus();
 
-    // Initialize the new connected socket
-    socket.close();
-    socket.create(remote);
+    // Initialize the new connected socket (it has the same family as the listener)
+    socket.disconnect();
+    socket.create(remote, isIpv6());
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpListener::accept(TcpSocket* const* sockets, std::size_t count, std::size_t& accepted)
+{
+    accepted = 0;
+
+    if (count == 0)
+        return Done;
+
+    // Wait for the first connection, according to the blocking mode of the listener
+    Status status = accept(*sockets[0]);
+    if (status != Done)
+        return status;
+
+    accepted = 1;
+    if (count == 1)
+        return Done;
+
+    // Then take the connections that are already waiting, without blocking
+    bool blocking = isBlocking();
+    if (blocking)
+        priv::SocketImpl::setBlocking(getHandle(), false);
+
+    while ((accepted < count) && (accept(*sockets[accepted]) == Done))
+        ++accepted;
+
+    if (blocking)
+        priv::SocketImpl::setBlocking(getHandle(), true);
 
     return Done;
 }
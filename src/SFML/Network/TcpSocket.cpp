@@ -29,6 +29,7 @@
 #include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/Packet.hpp>
 #include <SFML/Network/SocketImpl.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
 #include <algorithm>
 #include <cstring>
@@ -52,7 +53,11 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 TcpSocket::TcpSocket() :
-Socket(Tcp)
+Socket          (Tcp),
+m_readBegin     (0),
+m_readEnd       (0),
+m_writeThreshold(0),
+m_memory        (MemoryTracker::Sockets)
 {
 
 }
@@ -64,11 +69,13 @@ unsigned short TcpSocket::getLocalPort() const
     if (getHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve informations about the local end of the socket
-        sockaddr_in address;
+        sockaddr_storage address;
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getsockname(getHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return ntohs(address.sin_port);
+            unsigned short port;
+            priv::SocketImpl::getAddress(address, port);
+            return port;
         }
     }
 
@@ -83,11 +90,12 @@ IpAddress TcpSocket::getRemoteAddress() const
     if (getHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve informations about the remote end of the socket
-        sockaddr_in address;
+        sockaddr_storage address;
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getpeername(getHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return IpAddress(ntohl(address.sin_addr.s_addr));
+            unsigned short port;
+            return priv::SocketImpl::getAddress(address, port);
         }
     }
 
@@ -102,11 +110,13 @@ unsigned short TcpSocket::getRemotePort() const
     if (getHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve informations about the remote end of the socket
-        sockaddr_in address;
+        sockaddr_storage address;
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getpeername(getHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return ntohs(address.sin_port);
+            unsigned short port;
+            priv::SocketImpl::getAddress(address, port);
+            return port;
         }
     }
 
@@ -118,18 +128,23 @@ unsigned short TcpSocket::getRemotePort() const
 ////////////////////////////////////////////////////////////
 Socket::Status TcpSocket::connect(const IpAddress& remoteAddress, unsigned short remotePort, Time timeout)
 {
+    // An IPv4 socket, left by a previous connection attempt, can't reach an IPv6 address
+    if ((getHandle() != priv::SocketImpl::invalidSocket()) && remoteAddress.isIpv6() && !isIpv6())
+        close();
+
     // Create the internal socket if it doesn't exist
-    create();
+    create(remoteAddress);
 
     // Create the remote address
-    sockaddr_in address = priv::SocketImpl::createAddress(remoteAddress.toInteger(), remotePort);
+    sockaddr_storage address;
+    priv::SocketImpl::AddrLength addressSize = priv::SocketImpl::createAddress(remoteAddress, remotePort, isIpv6(), address);
 
     if (timeout <= Time::Zero)
     {
         // ----- We're not using a timeout: just try to connect -----
 
         // Connect the socket
-        if (::connect(getHandle(), reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
+        if (::connect(getHandle(), reinterpret_cast<sockaddr*>(&address), addressSize) == -1)
             return priv::SocketImpl::getErrorStatus();
 
         // Connection succeeded
@@ -147,7 +162,7 @@ Socket::Status TcpSocket::connect(const IpAddress& remoteAddress, unsigned short
             setBlocking(false);
 
         // Try to connect to the remote address
-        if (::connect(getHandle(), reinterpret_cast<sockaddr*>(&address), sizeof(address)) >= 0)
+        if (::connect(getHandle(), reinterpret_cast<sockaddr*>(&address), addressSize) >= 0)
         {
             // We got instantly connected! (it may no happen a lot...)
             setBlocking(blocking);
@@ -205,6 +220,146 @@ Socket::Status TcpSocket::connect(const IpAddress& remoteAddress, unsigned short
 }
 
 
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::connect(const std::vector<IpAddress>& remoteAddresses, unsigned short remotePort, Time timeout)
+{
+    disconnect();
+
+    if (remoteAddresses.empty())
+    {
+        err() << "Failed to connect the socket (no address given)" << std::endl;
+        return Error;
+    }
+
+    // Alternate the families, starting with the one of the preferred address
+    std::vector<IpAddress> preferred;
+    std::vector<IpAddress> others;
+    for (std::vector<IpAddress>::const_iterator it = remoteAddresses.begin(); it != remoteAddresses.end(); ++it)
+        (it->isIpv6() == remoteAddresses.front().isIpv6() ? preferred : others).push_back(*it);
+
+    std::vector<IpAddress> candidates;
+    for (std::size_t i = 0; i < std::max(preferred.size(), others.size()); ++i)
+    {
+        if (i < preferred.size())
+            candidates.push_back(preferred[i]);
+        if (i < others.size())
+            candidates.push_back(others[i]);
+    }
+
+    std::vector<SocketHandle> attempts;
+    std::size_t next = 0;
+    SocketHandle winner = priv::SocketImpl::invalidSocket();
+    Status status = Error;
+    Time nextAttempt = Time::Zero;
+    Clock clock;
+
+    while (winner == priv::SocketImpl::invalidSocket())
+    {
+        Time elapsed = clock.getElapsedTime();
+        if ((timeout > Time::Zero) && (elapsed >= timeout))
+        {
+            status = NotReady;
+            break;
+        }
+
+        // Start the next attempt when it is due, or right away if all the others failed
+        if ((next < candidates.size()) && ((elapsed >= nextAttempt) || attempts.empty()))
+        {
+            const IpAddress& candidate = candidates[next++];
+            nextAttempt = elapsed + milliseconds(250);
+
+            SocketHandle handle = socket(candidate.isIpv6() ? PF_INET6 : PF_INET, SOCK_STREAM, 0);
+            if (handle == priv::SocketImpl::invalidSocket())
+                continue;
+
+            priv::SocketImpl::setBlocking(handle, false);
+
+            sockaddr_storage address;
+            priv::SocketImpl::AddrLength addressSize = priv::SocketImpl::createAddress(candidate, remotePort, candidate.isIpv6(), address);
+            if (::connect(handle, reinterpret_cast<sockaddr*>(&address), addressSize) != -1)
+            {
+                winner = handle;
+                break;
+            }
+
+            status = priv::SocketImpl::getErrorStatus();
+            if (status == NotReady)
+                attempts.push_back(handle);
+            else
+                priv::SocketImpl::close(handle);
+
+            continue;
+        }
+
+        // Every address failed
+        if (attempts.empty())
+            break;
+
+        // Wait until an attempt completes, or until the next one is due
+        fd_set writeSet;
+        fd_set errorSet;
+        FD_ZERO(&writeSet);
+        FD_ZERO(&errorSet);
+        SocketHandle maxHandle = 0;
+        for (std::vector<SocketHandle>::iterator it = attempts.begin(); it != attempts.end(); ++it)
+        {
+            FD_SET(*it, &writeSet);
+            FD_SET(*it, &errorSet);
+            maxHandle = std::max(maxHandle, *it);
+        }
+
+        bool hasLimit = (next < candidates.size()) || (timeout > Time::Zero);
+        Time limit = (next < candidates.size()) ? nextAttempt - elapsed : timeout - elapsed;
+        if ((timeout > Time::Zero) && (timeout - elapsed < limit))
+            limit = timeout - elapsed;
+
+        timeval time;
+        time.tv_sec  = static_cast<long>(limit.asMicroseconds() / 1000000);
+        time.tv_usec = static_cast<long>(limit.asMicroseconds() % 1000000);
+
+        if (select(static_cast<int>(maxHandle + 1), NULL, &writeSet, &errorSet, hasLimit ? &time : NULL) <= 0)
+            continue;
+
+        // Check the attempts that completed: the first successful one wins
+        for (std::size_t i = 0; i < attempts.size();)
+        {
+            SocketHandle handle = attempts[i];
+            if (!FD_ISSET(handle, &writeSet) && !FD_ISSET(handle, &errorSet))
+            {
+                ++i;
+                continue;
+            }
+
+            int error = 0;
+            priv::SocketImpl::AddrLength size = sizeof(error);
+            getsockopt(handle, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &size);
+
+            attempts.erase(attempts.begin() + i);
+            if ((error == 0) && FD_ISSET(handle, &writeSet))
+            {
+                winner = handle;
+                break;
+            }
+
+            priv::SocketImpl::close(handle);
+            status = Error;
+        }
+    }
+
+    // Abandon the attempts still in progress
+    for (std::vector<SocketHandle>::iterator it = attempts.begin(); it != attempts.end(); ++it)
+        priv::SocketImpl::close(*it);
+
+    if (winner == priv::SocketImpl::invalidSocket())
+        return status;
+
+    // Keep the winning connection, in the blocking mode of this socket
+    create(winner);
+
+    return Done;
+}
+
+
 ////////////////////////////////////////////////////////////
 void TcpSocket::disconnect()
 {
@@ -213,6 +368,10 @@ void TcpSocket::disconnect()
 
     // Reset the pending packet data
     m_pendingPacket = PendingPacket();
+    m_readBegin = 0;
+    m_readEnd = 0;
+    m_writeBuffer.clear();
+    updateMemoryUsage();
 }
 
 
@@ -238,6 +397,13 @@ Socket::Status TcpSocket::send(const void* data, std::size_t size, std::size_t&
         return Error;
     }
 
+    // Coalesce the data with the previous writes
+    if (m_writeThreshold || !m_writeBuffer.empty())
+    {
+        sent = size;
+        return bufferData(static_cast<const char*>(data), size, NULL, 0);
+    }
+
     // Loop until every byte has been sent
     int result = 0;
     for (sent = 0; sent < size; sent += result)
@@ -248,19 +414,43 @@ Socket::Status TcpSocket::send(const void* data, std::size_t size, std::size_t&
         // Check for errors
         if (result < 0)
         {
+            record(BytesSent, sent);
+
             Status status = priv::SocketImpl::getErrorStatus();
 
             if ((status == NotReady) && sent)
-                return Partial;
+                return recordStatus(Partial);
 
-            return status;
+            return recordStatus(status);
         }
     }
 
+    record(BytesSent, size);
+
     return Done;
 }
 
 
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::sendFile(const std::string& filename, Uint64 offset, Uint64& sent)
+{
+    sent = 0;
+
+    // The buffered data must be sent before the file
+    if (!m_writeBuffer.empty())
+    {
+        Status status = flush();
+        if (status != Done)
+            return (status == Partial) ? NotReady : status;
+    }
+
+    Status status = priv::SocketImpl::sendFile(getHandle(), filename, offset, sent);
+    record(BytesSent, sent);
+
+    return recordStatus(status);
+}
+
+
 ////////////////////////////////////////////////////////////
 Socket::Status TcpSocket::receive(void* data, std::size_t size, std::size_t& received)
 {
@@ -274,12 +464,44 @@ Socket::Status TcpSocket::receive(void* data, std::size_t size, std::size_t& rec
         return Error;
     }
 
+    // Serve the data received in advance first
+    if (m_readBegin < m_readEnd)
+    {
+        received = std::min(size, m_readEnd - m_readBegin);
+        std::memcpy(data, &m_readBuffer[m_readBegin], received);
+        m_readBegin += received;
+        return Done;
+    }
+
+    // Small requests fill the read-ahead buffer, larger ones are received in place
+    if (size < m_readBuffer.size())
+    {
+        int sizeReceived = recv(getHandle(), &m_readBuffer[0], static_cast<int>(m_readBuffer.size()), flags);
+
+        if (sizeReceived > 0)
+        {
+            record(BytesReceived, static_cast<Uint64>(sizeReceived));
+            m_readBegin = 0;
+            m_readEnd = static_cast<std::size_t>(sizeReceived);
+            return receive(data, size, received);
+        }
+        else if (sizeReceived == 0)
+        {
+            return Socket::Disconnected;
+        }
+        else
+        {
+            return recordStatus(priv::SocketImpl::getErrorStatus());
+        }
+    }
+
     // Receive a chunk of bytes
     int sizeReceived = recv(getHandle(), static_cast<char*>(data), static_cast<int>(size), flags);
 
     // Check the number of bytes received
     if (sizeReceived > 0)
     {
+        record(BytesReceived, static_cast<Uint64>(sizeReceived));
         received = static_cast<std::size_t>(sizeReceived);
         return Done;
     }
@@ -289,7 +511,7 @@ Socket::Status TcpSocket::receive(void* data, std::size_t size, std::size_t& rec
     }
     else
     {
-        return priv::SocketImpl::getErrorStatus();
+        return recordStatus(priv::SocketImpl::getErrorStatus());
     }
 }
 
@@ -301,38 +523,75 @@ Socket::Status TcpSocket::send(Packet& packet)
     // This means that we have to send the packet size first, so that the
     // receiver knows the actual end of the packet in the data stream.
 
-    // We allocate an extra memory block so that the size can be sent
-    // together with the data in a single call. This may seem inefficient,
-    // but it is actually required to avoid partial send, which could cause
-    // data corruption on the receiving end.
+    // The size is sent together with the data in a single gathering call,
+    // without copying the packet. Sending it separately would allow
+    // partial sends of the size alone, and double the number of calls.
 
     // Get the data to send from the packet
     std::size_t size = 0;
-    const void* data = packet.onSend(size);
+    const char* data = static_cast<const char*>(packet.onSend(size));
 
     // First convert the packet size to network byte order
     Uint32 packetSize = htonl(static_cast<Uint32>(size));
+    const char* header = reinterpret_cast<const char*>(&packetSize);
+    std::size_t total = sizeof(packetSize) + size;
+
+    // Coalesce the packet with the previous writes, including what remains of a partial send
+    if (m_writeThreshold || !m_writeBuffer.empty())
+    {
+        std::size_t position = packet.m_sendPos;
+        packet.m_sendPos = 0;
 
-    // Allocate memory for the data block to send
-    std::vector<char> blockToSend(sizeof(packetSize) + size);
+        Status status;
+        if (position < sizeof(packetSize))
+            status = bufferData(header + position, sizeof(packetSize) - position, data, size);
+        else
+            status = bufferData(data + position - sizeof(packetSize), total - position, NULL, 0);
 
-    // Copy the packet size and data into the block to send
-    std::memcpy(&blockToSend[0], &packetSize, sizeof(packetSize));
-    if (size > 0)
-        std::memcpy(&blockToSend[0] + sizeof(packetSize), data, size);
+        if (status == Done)
+            recordPacketSent(data, size);
 
-    // Send the data block
-    std::size_t sent;
-    Status status = send(&blockToSend[0] + packet.m_sendPos, blockToSend.size() - packet.m_sendPos, sent);
+        return status;
+    }
+
+    // Loop until every byte has been sent, resuming from the previous partial send
+    std::size_t start = packet.m_sendPos;
+    std::size_t position = start;
+    Status status = Done;
+    while (position < total)
+    {
+        int result;
+        if (position < sizeof(packetSize))
+            result = priv::SocketImpl::send(getHandle(), header + position, sizeof(packetSize) - position, data, size, flags);
+        else
+            result = ::send(getHandle(), data + position - sizeof(packetSize), total - position, flags);
+
+        // Check for errors
+        if (result < 0)
+        {
+            status = priv::SocketImpl::getErrorStatus();
+
+            if ((status == NotReady) && (position != start))
+                status = Partial;
+
+            recordStatus(status);
+            break;
+        }
+
+        position += static_cast<std::size_t>(result);
+    }
+
+    record(BytesSent, position - start);
 
     // In the case of a partial send, record the location to resume from
     if (status == Partial)
     {
-        packet.m_sendPos += sent;
+        packet.m_sendPos = position;
     }
     else if (status == Done)
     {
         packet.m_sendPos = 0;
+        recordPacketSent(data, size);
     }
 
     return status;
@@ -371,41 +630,189 @@ Socket::Status TcpSocket::receive(Packet& packet)
         packetSize = ntohl(m_pendingPacket.Size);
     }
 
+    // The size is known, allocate the whole packet at once and receive directly into it
+    if (m_pendingPacket.Data.size() != packetSize)
+    {
+        m_pendingPacket.Data.resize(packetSize);
+        updateMemoryUsage();
+    }
+
     // Loop until we receive all the packet data
-    char buffer[1024];
-    while (m_pendingPacket.Data.size() < packetSize)
+    while (m_pendingPacket.DataReceived < packetSize)
     {
-        // Receive a chunk of data
-        std::size_t sizeToGet = std::min(static_cast<std::size_t>(packetSize - m_pendingPacket.Data.size()), sizeof(buffer));
-        Status status = receive(buffer, sizeToGet, received);
+        char* data = &m_pendingPacket.Data[0] + m_pendingPacket.DataReceived;
+        Status status = receive(data, packetSize - m_pendingPacket.DataReceived, received);
+        m_pendingPacket.DataReceived += received;
+
         if (status != Done)
             return status;
-
-        // Append it into the packet
-        if (received > 0)
-        {
-            m_pendingPacket.Data.resize(m_pendingPacket.Data.size() + received);
-            char* begin = &m_pendingPacket.Data[0] + m_pendingPacket.Data.size() - received;
-            std::memcpy(begin, buffer, received);
-        }
     }
 
+    record(PacketsReceived);
+
+    if (isCaptureEnabled())
+        capture(false, m_pendingPacket.Data.empty() ? NULL : &m_pendingPacket.Data[0], m_pendingPacket.Data.size(), getRemoteAddress(), getRemotePort());
+
     // We have received all the packet data: we can copy it to the user packet
     if (!m_pendingPacket.Data.empty())
         packet.onReceive(&m_pendingPacket.Data[0], m_pendingPacket.Data.size());
 
-    // Clear the pending packet data
-    m_pendingPacket = PendingPacket();
+    // Clear the pending packet data, but keep its memory for the next packet
+    m_pendingPacket.Size = 0;
+    m_pendingPacket.SizeReceived = 0;
+    m_pendingPacket.Data.clear();
+    m_pendingPacket.DataReceived = 0;
 
     return Done;
 }
 
 
+////////////////////////////////////////////////////////////
+void TcpSocket::setReadAhead(std::size_t size)
+{
+    // Keep the data that was already received in advance
+    std::vector<char> buffer(std::max(size, m_readEnd - m_readBegin));
+    if (m_readBegin < m_readEnd)
+        std::memcpy(&buffer[0], &m_readBuffer[m_readBegin], m_readEnd - m_readBegin);
+
+    m_readEnd -= m_readBegin;
+    m_readBegin = 0;
+    m_readBuffer.swap(buffer);
+    updateMemoryUsage();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TcpSocket::getReadAhead() const
+{
+    return m_readBuffer.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TcpSocket::getBufferedSize() const
+{
+    return m_readEnd - m_readBegin;
+}
+
+
+////////////////////////////////////////////////////////////
+void TcpSocket::setWriteBuffer(std::size_t threshold)
+{
+    m_writeThreshold = threshold;
+
+    if (!m_writeThreshold && !m_writeBuffer.empty())
+        flush();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TcpSocket::getWriteBuffer() const
+{
+    return m_writeThreshold;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TcpSocket::getUnflushedSize() const
+{
+    return m_writeBuffer.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::flush()
+{
+    if (m_writeBuffer.empty())
+        return Done;
+
+    // Loop until every byte has been sent
+    std::size_t sent = 0;
+    Status status = Done;
+    while (sent < m_writeBuffer.size())
+    {
+        int result = ::send(getHandle(), &m_writeBuffer[0] + sent, m_writeBuffer.size() - sent, flags);
+
+        // Check for errors
+        if (result < 0)
+        {
+            status = priv::SocketImpl::getErrorStatus();
+
+            if ((status == NotReady) && sent)
+                status = Partial;
+
+            break;
+        }
+
+        sent += static_cast<std::size_t>(result);
+    }
+
+    record(BytesSent, sent);
+    recordStatus(status);
+
+    // Keep what couldn't be sent for the next flush, and the memory of the buffer
+    if (status == Done)
+        m_writeBuffer.clear();
+    else if (status == Partial)
+        m_writeBuffer.erase(m_writeBuffer.begin(), m_writeBuffer.begin() + sent);
+
+    return status;
+}
+
+
+////////////////////////////////////////////////////////////
+Time TcpSocket::getRoundTripTime() const
+{
+    if (getHandle() == priv::SocketImpl::invalidSocket())
+        return Time::Zero;
+
+    return priv::SocketImpl::getRoundTripTime(getHandle());
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::bufferData(const char* first, std::size_t firstSize, const char* second, std::size_t secondSize)
+{
+    m_writeBuffer.insert(m_writeBuffer.end(), first, first + firstSize);
+    if (secondSize > 0)
+        m_writeBuffer.insert(m_writeBuffer.end(), second, second + secondSize);
+    updateMemoryUsage();
+
+    if (m_writeBuffer.size() < m_writeThreshold)
+        return Done;
+
+    // The data that can't be sent yet stays in the buffer for the next flush
+    Status status = flush();
+    if ((status == Partial) || (status == NotReady))
+        status = Done;
+
+    return status;
+}
+
+
+////////////////////////////////////////////////////////////
+void TcpSocket::recordPacketSent(const char* data, std::size_t size)
+{
+    record(PacketsSent);
+
+    if (isCaptureEnabled())
+        capture(true, data, size, getRemoteAddress(), getRemotePort());
+}
+
+
+////////////////////////////////////////////////////////////
+void TcpSocket::updateMemoryUsage()
+{
+    m_memory.setBytes(m_pendingPacket.Data.capacity() + m_readBuffer.capacity() + m_writeBuffer.capacity());
+}
+
+
 ////////////////////////////////////////////////////////////
 TcpSocket::PendingPacket::PendingPacket() :
 Size        (0),
 SizeReceived(0),
-Data        ()
+Data        (),
+DataReceived(0)
 {
 
 }
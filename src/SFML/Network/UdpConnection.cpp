@@ -0,0 +1,698 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/UdpConnection.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Datagrams are kept below the usual MTU to avoid IP fragmentation
+    const std::size_t maxDatagramSize   = 1200;
+    const std::size_t headerSize        = 8;
+    const std::size_t fragmentSize      = 1024;
+    const std::size_t maxFragmentCount  = 4096;
+    const std::size_t sentDatagramCount = 1024;
+
+    // Number of more recent datagrams acknowledged after which a datagram is considered lost
+    const sf::Uint16 reorderingTolerance = 3;
+
+    // Acknowledgements are not acknowledged themselves, so they are sent several times
+    const unsigned int ackRepeatCount = 3;
+
+    // Number of packets a channel accepts ahead of the next one expected
+    const sf::Uint16 reliableWindow   = 256;
+    const sf::Uint16 unreliableWindow = 64;
+
+    // Flags of the packets
+    const sf::Uint8 reliabilityMask = 0x03;
+    const sf::Uint8 fragmentedFlag  = 0x04;
+
+    // Timings
+    const float    initialTimeout    = 0.5f;
+    const float    minTimeout        = 0.05f;
+    const float    maxTimeout        = 2.f;
+    const sf::Time keepAliveInterval = sf::milliseconds(250);
+
+    // Congestion control, in datagrams
+    const float initialCongestionWindow = 8.f;
+    const float minCongestionWindow     = 2.f;
+    const float maxCongestionWindow     = 512.f;
+    const float initialThreshold        = 64.f;
+
+    // Smoothing factor of the packet loss
+    const float lossSmoothing = 0.1f;
+
+    void writeUint16(std::vector<char>& buffer, sf::Uint16 value)
+    {
+        buffer.push_back(static_cast<char>(value >> 8));
+        buffer.push_back(static_cast<char>(value & 0xFF));
+    }
+
+    void writeUint32(std::vector<char>& buffer, sf::Uint32 value)
+    {
+        writeUint16(buffer, static_cast<sf::Uint16>(value >> 16));
+        writeUint16(buffer, static_cast<sf::Uint16>(value & 0xFFFF));
+    }
+
+    sf::Uint16 readUint16(const char* data)
+    {
+        const sf::Uint8* bytes = reinterpret_cast<const sf::Uint8*>(data);
+        return static_cast<sf::Uint16>((bytes[0] << 8) | bytes[1]);
+    }
+
+    sf::Uint32 readUint32(const char* data)
+    {
+        return (static_cast<sf::Uint32>(readUint16(data)) << 16) | readUint16(data + 2);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+UdpConnection::UdpConnection(UdpSocket& socket, const IpAddress& remoteAddress, unsigned short remotePort) :
+m_socket             (socket),
+m_remoteAddress      (remoteAddress),
+m_remotePort         (remotePort),
+m_channels           (256, Reliable),
+m_sendSequences      (256, 0),
+m_nextFragmentId     (0),
+m_sentDatagrams      (sentDatagramCount),
+m_localSequence      (0),
+m_lastAckedSequence  (0xFFFF),
+m_remoteSequence     (0xFFFF), // acknowledges a datagram that won't be sent until the sequence wraps around
+m_receivedBits       (0),
+m_hasReceived        (false),
+m_ackRepeats         (0),
+m_smoothedRtt        (0.f),
+m_rttVariation       (0.f),
+m_hasRttSample       (false),
+m_packetLoss         (0.f),
+m_congestionWindow   (initialCongestionWindow),
+m_slowStartThreshold (initialThreshold)
+{
+    m_datagram.reserve(maxDatagramSize);
+}
+
+
+////////////////////////////////////////////////////////////
+IpAddress UdpConnection::getRemoteAddress() const
+{
+    return m_remoteAddress;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned short UdpConnection::getRemotePort() const
+{
+    return m_remotePort;
+}
+
+
+////////////////////////////////////////////////////////////
+void UdpConnection::setChannel(Uint8 channel, Reliability reliability)
+{
+    m_channels[channel] = static_cast<Uint8>(reliability);
+}
+
+
+////////////////////////////////////////////////////////////
+UdpConnection::Reliability UdpConnection::getChannel(Uint8 channel) const
+{
+    return static_cast<Reliability>(m_channels[channel]);
+}
+
+
+////////////////////////////////////////////////////////////
+bool UdpConnection::send(Packet& packet, Uint8 channel)
+{
+    // Let the derived class transform the data first
+    std::size_t size = 0;
+    const char* data = static_cast<const char*>(packet.onSend(size));
+
+    std::size_t count = (size > 0) ? (size + fragmentSize - 1) / fragmentSize : 1;
+    if (count > maxFragmentCount)
+    {
+        err() << "Cannot send packet over UDP connection: its size (" << size << " bytes) "
+              << "exceeds the maximum allowed (" << maxFragmentCount * fragmentSize << " bytes)" << std::endl;
+        return false;
+    }
+
+    Uint8 reliability = m_channels[channel];
+    Uint16 sequence = m_sendSequences[channel]++;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        OutgoingFragment* fragment;
+        if (reliability == Reliable)
+        {
+            fragment = &m_reliableFragments[m_nextFragmentId++];
+        }
+        else
+        {
+            m_unreliableFragments.push_back(OutgoingFragment());
+            fragment = &m_unreliableFragments.back();
+        }
+
+        std::size_t begin = i * fragmentSize;
+        std::size_t end = std::min(begin + fragmentSize, size);
+
+        fragment->channel     = channel;
+        fragment->reliability = reliability;
+        fragment->sequence    = sequence;
+        fragment->index       = static_cast<Uint16>(i);
+        fragment->count       = static_cast<Uint16>(count);
+        fragment->isSent      = false;
+        fragment->data.assign(data + begin, data + end);
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UdpConnection::receive(Packet& packet, Uint8& channel)
+{
+    if (m_receivedPackets.empty())
+        return false;
+
+    const std::vector<char>& data = m_receivedPackets.front().second;
+
+    packet.clear();
+    packet.onReceive(data.empty() ? NULL : &data[0], data.size());
+    channel = m_receivedPackets.front().first;
+
+    m_receivedPackets.pop_front();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UdpConnection::handleDatagram(const void* data, std::size_t size)
+{
+    if (size < headerSize)
+        return false;
+
+    const char* begin = static_cast<const char*>(data);
+    const char* end = begin + size;
+
+    Uint16 sequence = readUint16(begin);
+    Uint16 ack = readUint16(begin + 2);
+    Uint32 ackBits = readUint32(begin + 4);
+
+    // Check that the packets of the datagram are well-formed, then process them
+    bool isNew = true;
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        const char* position = begin + headerSize;
+        while (position < end)
+        {
+            if (end - position < 4)
+                return false;
+
+            Uint8 channel = static_cast<Uint8>(position[0]);
+            Uint8 flags = static_cast<Uint8>(position[1]);
+            Uint16 packetSequence = readUint16(position + 2);
+            Uint16 index = 0;
+            Uint16 count = 1;
+            position += 4;
+
+            if (flags & fragmentedFlag)
+            {
+                if (end - position < 4)
+                    return false;
+
+                index = readUint16(position);
+                count = readUint16(position + 2);
+                position += 4;
+            }
+
+            if (end - position < 2)
+                return false;
+
+            std::size_t length = readUint16(position);
+            position += 2;
+
+            Uint8 reliability = flags & reliabilityMask;
+            if ((reliability > Reliable) || (index >= count) || (count > maxFragmentCount) || (length > static_cast<std::size_t>(end - position)))
+                return false;
+
+            if (pass == 1)
+                receiveFragment(channel, reliability, packetSequence, index, count, position, length);
+
+            position += length;
+        }
+
+        if (pass == 1)
+        {
+            // Only the datagrams that contain packets need to be acknowledged
+            if (size > headerSize)
+                m_ackRepeats = ackRepeatCount;
+            break;
+        }
+
+        Time now = m_clock.getElapsedTime();
+        m_lastReceiveTime = now;
+
+        // Process the acknowledgements carried by the datagram
+        acknowledge(ack, now);
+        for (Uint16 i = 0; i < 32; ++i)
+        {
+            if (ackBits & (1u << i))
+                acknowledge(static_cast<Uint16>(ack - i - 1), now);
+        }
+
+        // Record the sequence number of the datagram, and drop duplicates
+        if (!m_hasReceived)
+        {
+            m_hasReceived = true;
+            m_remoteSequence = sequence;
+            m_receivedBits = 0;
+        }
+        else
+        {
+            Uint16 ahead = static_cast<Uint16>(sequence - m_remoteSequence);
+            if (ahead == 0)
+            {
+                isNew = false;
+            }
+            else if (ahead < 0x8000)
+            {
+                m_receivedBits = (ahead < 32) ? (m_receivedBits << ahead) | (1u << (ahead - 1)) : (ahead == 32 ? 1u << 31 : 0);
+                m_remoteSequence = sequence;
+            }
+            else
+            {
+                Uint16 behind = static_cast<Uint16>(m_remoteSequence - sequence);
+                if ((behind > 32) || (m_receivedBits & (1u << (behind - 1))))
+                    isNew = false;
+                else
+                    m_receivedBits |= 1u << (behind - 1);
+            }
+        }
+
+        if (!isNew)
+            break;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpConnection::update()
+{
+    Time now = m_clock.getElapsedTime();
+    Time timeout = getRetransmissionTimeout();
+
+    // Detect the lost datagrams, either because more recent ones were acknowledged
+    // or because they were not acknowledged in time, and count the reliable ones still in flight
+    std::size_t inFlight = 0;
+    bool congestion = false;
+    for (std::vector<SentDatagram>::iterator it = m_sentDatagrams.begin(); it != m_sentDatagrams.end(); ++it)
+    {
+        if (!it->isPending)
+            continue;
+
+        Uint16 behind = static_cast<Uint16>(m_lastAckedSequence - it->sequence);
+        if (((behind >= reorderingTolerance) && (behind < 0x8000)) || (now - it->sendTime > timeout))
+        {
+            // Losses of datagrams sent before the last reduction belong to the same congestion event
+            if (!it->fragments.empty() && (it->sendTime >= m_lastCongestionTime))
+                congestion = true;
+            markLost(*it);
+        }
+        else if (!it->fragments.empty())
+        {
+            inFlight++;
+        }
+    }
+
+    // Halve the congestion window
+    if (congestion)
+    {
+        m_slowStartThreshold = std::max(m_congestionWindow / 2.f, minCongestionWindow);
+        m_congestionWindow = m_slowStartThreshold;
+        m_lastCongestionTime = now;
+    }
+
+    // The oldest reliable packet not acknowledged in each channel limits how far ahead the next ones can go
+    bool hasOldest[256] = {false};
+    Uint16 oldest[256];
+
+    FragmentMap::iterator next = m_reliableFragments.begin();
+    Socket::Status status = Socket::Done;
+    bool hasSent = false;
+    for (;;)
+    {
+        SentDatagram& datagram = m_sentDatagrams[m_localSequence % sentDatagramCount];
+        if (datagram.isPending)
+        {
+            if (!datagram.fragments.empty())
+                inFlight--;
+            markLost(datagram);
+        }
+        datagram.fragments.clear();
+
+        m_datagram.clear();
+        writeUint16(m_datagram, m_localSequence);
+        writeUint16(m_datagram, m_remoteSequence);
+        writeUint32(m_datagram, m_receivedBits);
+
+        // Unreliable fragments are sent once, whatever happens
+        while (!m_unreliableFragments.empty() && writeFragment(m_unreliableFragments.front()))
+            m_unreliableFragments.pop_front();
+
+        // Reliable fragments are sent in order, as long as the congestion window allows it
+        if (inFlight < static_cast<std::size_t>(m_congestionWindow))
+        {
+            for (; next != m_reliableFragments.end(); ++next)
+            {
+                OutgoingFragment& fragment = next->second;
+                if (!hasOldest[fragment.channel])
+                {
+                    hasOldest[fragment.channel] = true;
+                    oldest[fragment.channel] = fragment.sequence;
+                }
+
+                if (fragment.isSent || (static_cast<Uint16>(fragment.sequence - oldest[fragment.channel]) >= reliableWindow))
+                    continue;
+
+                if (!writeFragment(fragment))
+                    break;
+
+                fragment.isSent = true;
+                datagram.fragments.push_back(next->first);
+            }
+        }
+
+        // Without packets, a datagram is only worth sending to repeat the acknowledgements or keep the connection alive
+        bool hasPackets = m_datagram.size() > headerSize;
+        if (!hasPackets && (hasSent || ((m_ackRepeats == 0) && (now - m_lastSendTime < keepAliveInterval))))
+            break;
+
+        status = m_socket.send(&m_datagram[0], m_datagram.size(), m_remoteAddress, m_remotePort);
+        if (status != Socket::Done)
+        {
+            // Keep the reliable fragments for the next update
+            for (std::vector<Uint64>::const_iterator it = datagram.fragments.begin(); it != datagram.fragments.end(); ++it)
+                m_reliableFragments[*it].isSent = false;
+            datagram.fragments.clear();
+            break;
+        }
+
+        datagram.sequence  = m_localSequence++;
+        datagram.sendTime  = now;
+        datagram.isAcked   = false;
+        datagram.isPending = hasPackets;
+        if (!datagram.fragments.empty())
+            inFlight++;
+
+        m_lastSendTime = now;
+        hasSent = true;
+        if (m_ackRepeats > 0)
+            m_ackRepeats--;
+    }
+
+    return status;
+}
+
+
+////////////////////////////////////////////////////////////
+Time UdpConnection::getRoundTripTime() const
+{
+    return seconds(m_smoothedRtt);
+}
+
+
+////////////////////////////////////////////////////////////
+float UdpConnection::getPacketLoss() const
+{
+    return m_packetLoss;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t UdpConnection::getCongestionWindow() const
+{
+    return static_cast<std::size_t>(m_congestionWindow);
+}
+
+
+////////////////////////////////////////////////////////////
+Time UdpConnection::getTimeSinceLastReceive() const
+{
+    return m_clock.getElapsedTime() - m_lastReceiveTime;
+}
+
+
+////////////////////////////////////////////////////////////
+void UdpConnection::acknowledge(Uint16 sequence, Time now)
+{
+    SentDatagram& datagram = m_sentDatagrams[sequence % sentDatagramCount];
+    if ((datagram.sequence != sequence) || datagram.isAcked)
+        return;
+
+    datagram.isAcked = true;
+    if (static_cast<Uint16>(sequence - m_lastAckedSequence) < 0x8000)
+        m_lastAckedSequence = sequence;
+
+    if (datagram.isPending)
+    {
+        datagram.isPending = false;
+
+        // Update the estimation of the round trip time
+        float rtt = (now - datagram.sendTime).asSeconds();
+        if (!m_hasRttSample)
+        {
+            m_smoothedRtt = rtt;
+            m_rttVariation = rtt / 2.f;
+            m_hasRttSample = true;
+        }
+        else
+        {
+            m_rttVariation = 0.75f * m_rttVariation + 0.25f * std::fabs(m_smoothedRtt - rtt);
+            m_smoothedRtt = 0.875f * m_smoothedRtt + 0.125f * rtt;
+        }
+
+        m_packetLoss -= m_packetLoss * lossSmoothing;
+
+        // Grow the congestion window: exponentially up to the threshold, linearly after
+        if (!datagram.fragments.empty())
+        {
+            if (m_congestionWindow < m_slowStartThreshold)
+                m_congestionWindow += 1.f;
+            else
+                m_congestionWindow += 1.f / m_congestionWindow;
+
+            m_congestionWindow = std::min(m_congestionWindow, maxCongestionWindow);
+        }
+    }
+
+    // The reliable fragments of the datagram are delivered, even if it was considered lost
+    for (std::vector<Uint64>::const_iterator it = datagram.fragments.begin(); it != datagram.fragments.end(); ++it)
+        m_reliableFragments.erase(*it);
+    datagram.fragments.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void UdpConnection::markLost(SentDatagram& datagram)
+{
+    datagram.isPending = false;
+    m_packetLoss += (1.f - m_packetLoss) * lossSmoothing;
+
+    for (std::vector<Uint64>::const_iterator it = datagram.fragments.begin(); it != datagram.fragments.end(); ++it)
+    {
+        FragmentMap::iterator fragment = m_reliableFragments.find(*it);
+        if (fragment != m_reliableFragments.end())
+            fragment->second.isSent = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool UdpConnection::writeFragment(const OutgoingFragment& fragment)
+{
+    bool isFragmented = fragment.count > 1;
+    std::size_t size = (isFragmented ? 10 : 6) + fragment.data.size();
+    if (m_datagram.size() + size > maxDatagramSize)
+        return false;
+
+    m_datagram.push_back(static_cast<char>(fragment.channel));
+    m_datagram.push_back(static_cast<char>(fragment.reliability | (isFragmented ? fragmentedFlag : 0)));
+    writeUint16(m_datagram, fragment.sequence);
+    if (isFragmented)
+    {
+        writeUint16(m_datagram, fragment.index);
+        writeUint16(m_datagram, fragment.count);
+    }
+    writeUint16(m_datagram, static_cast<Uint16>(fragment.data.size()));
+    m_datagram.insert(m_datagram.end(), fragment.data.begin(), fragment.data.end());
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void UdpConnection::receiveFragment(Uint8 channel, Uint8 reliability, Uint16 sequence, Uint16 index, Uint16 count, const char* data, std::size_t size)
+{
+    IncomingChannel& incoming = m_incomingChannels[channel];
+    typedef std::map<Uint16, IncomingPacket>::iterator PacketIterator;
+
+    // Drop the packets that are too old or too far ahead
+    Uint16 offset = static_cast<Uint16>(sequence - incoming.nextSequence);
+    if (reliability == Reliable)
+    {
+        if (offset >= reliableWindow)
+            return;
+    }
+    else if (reliability == Sequenced)
+    {
+        if (offset >= 0x8000)
+            return;
+    }
+    else
+    {
+        // Unreliable packets are delivered in any order, but incomplete ones are eventually forgotten
+        if (offset < 0x8000)
+        {
+            incoming.nextSequence = sequence + 1;
+            for (PacketIterator it = incoming.packets.begin(); it != incoming.packets.end();)
+            {
+                if (static_cast<Uint16>(incoming.nextSequence - it->first) > unreliableWindow)
+                    incoming.packets.erase(it++);
+                else
+                    ++it;
+            }
+        }
+        else if (static_cast<Uint16>(incoming.nextSequence - sequence) > unreliableWindow)
+        {
+            return;
+        }
+    }
+
+    // Store the fragment
+    IncomingPacket& packet = incoming.packets[sequence];
+    if (packet.fragments.empty())
+    {
+        packet.fragments.resize(count);
+        packet.received.resize(count, false);
+        packet.missing = count;
+    }
+    else if ((packet.fragments.size() != count) || packet.received[index])
+    {
+        return;
+    }
+
+    packet.fragments[index].assign(data, data + size);
+    packet.received[index] = true;
+    if (--packet.missing > 0)
+        return;
+
+    // Deliver the complete packets
+    if (reliability == Reliable)
+    {
+        PacketIterator it;
+        while (((it = incoming.packets.find(incoming.nextSequence)) != incoming.packets.end()) && (it->second.missing == 0))
+        {
+            deliver(channel, it->second);
+            incoming.packets.erase(it);
+            incoming.nextSequence++;
+        }
+    }
+    else if (reliability == Sequenced)
+    {
+        deliver(channel, packet);
+        incoming.nextSequence = sequence + 1;
+
+        // Forget the older packets
+        for (PacketIterator it = incoming.packets.begin(); it != incoming.packets.end();)
+        {
+            if (static_cast<Uint16>(it->first - incoming.nextSequence) >= 0x8000)
+                incoming.packets.erase(it++);
+            else
+                ++it;
+        }
+    }
+    else
+    {
+        deliver(channel, packet);
+        incoming.packets.erase(sequence);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void UdpConnection::deliver(Uint8 channel, const IncomingPacket& packet)
+{
+    m_receivedPackets.push_back(ReceivedPacket(channel, std::vector<char>()));
+    std::vector<char>& data = m_receivedPackets.back().second;
+
+    std::size_t size = 0;
+    for (std::vector<std::vector<char> >::const_iterator it = packet.fragments.begin(); it != packet.fragments.end(); ++it)
+        size += it->size();
+
+    data.reserve(size);
+    for (std::vector<std::vector<char> >::const_iterator it = packet.fragments.begin(); it != packet.fragments.end(); ++it)
+        data.insert(data.end(), it->begin(), it->end());
+}
+
+
+////////////////////////////////////////////////////////////
+Time UdpConnection::getRetransmissionTimeout() const
+{
+    if (!m_hasRttSample)
+        return seconds(initialTimeout);
+
+    float timeout = m_smoothedRtt + 4.f * m_rttVariation;
+    return seconds(std::min(std::max(timeout, minTimeout), maxTimeout));
+}
+
+
+////////////////////////////////////////////////////////////
+UdpConnection::SentDatagram::SentDatagram() :
+sequence (0),
+sendTime (Time::Zero),
+isAcked  (true),
+isPending(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+UdpConnection::IncomingChannel::IncomingChannel() :
+nextSequence(0)
+{
+}
+
+} // namespace sf
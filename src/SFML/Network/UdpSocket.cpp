@@ -31,6 +31,20 @@
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/Err.hpp>
 #include <algorithm>
+#include <cstring>
+
+// Linux can send and receive several datagrams with a single system call
+#if defined(SFML_SYSTEM_LINUX) && defined(MSG_WAITFORONE)
+    #define SFML_UDP_MMSG
+    #include <netinet/udp.h>
+#endif
+
+
+namespace
+{
+    // Number of datagrams given to each sendmmsg/recvmmsg call
+    const std::size_t batchSize = 64;
+}
 
 
 namespace sf
@@ -50,11 +64,13 @@ unsigned short UdpSocket::getLocalPort() const
     if (getHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve informations about the local end of the socket
-        sockaddr_in address;
+        sockaddr_storage address;
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getsockname(getHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return ntohs(address.sin_port);
+            unsigned short port;
+            priv::SocketImpl::getAddress(address, port);
+            return port;
         }
     }
 
@@ -64,14 +80,16 @@ unsigned short UdpSocket::getLocalPort() const
 
 
 ////////////////////////////////////////////////////////////
-Socket::Status UdpSocket::bind(unsigned short port)
+Socket::Status UdpSocket::bind(unsigned short port, const IpAddress& address)
 {
-    // Create the internal socket if it doesn't exist
-    create();
+    // Create the internal socket, of the family matching the address
+    close();
+    create(address);
 
     // Bind the socket
-    sockaddr_in address = priv::SocketImpl::createAddress(INADDR_ANY, port);
-    if (::bind(getHandle(), reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
+    sockaddr_storage localAddress;
+    priv::SocketImpl::AddrLength size = priv::SocketImpl::createAddress(address, port, isIpv6(), localAddress);
+    if ((size == 0) || (::bind(getHandle(), reinterpret_cast<sockaddr*>(&localAddress), size) == -1))
     {
         err() << "Failed to bind socket to port " << port << std::endl;
         return Error;
@@ -93,7 +111,7 @@ void UdpSocket::unbind()
 Socket::Status UdpSocket::send(const void* data, std::size_t size, const IpAddress& remoteAddress, unsigned short remotePort)
 {
     // Create the internal socket if it doesn't exist
-    create();
+    create(remoteAddress);
 
     // Make sure that all the data will fit in one datagram
     if (size > MaxDatagramSize)
@@ -104,14 +122,23 @@ Socket::Status UdpSocket::send(const void* data, std::size_t size, const IpAddre
     }
 
     // Build the target address
-    sockaddr_in address = priv::SocketImpl::createAddress(remoteAddress.toInteger(), remotePort);
+    sockaddr_storage address;
+    priv::SocketImpl::AddrLength addressSize = priv::SocketImpl::createAddress(remoteAddress, remotePort, isIpv6(), address);
+    if (addressSize == 0)
+    {
+        err() << "Cannot send data to the IPv6 address " << remoteAddress << " from an IPv4 socket" << std::endl;
+        return Error;
+    }
 
     // Send the data (unlike TCP, all the data is always sent in one call)
-    int sent = sendto(getHandle(), static_cast<const char*>(data), static_cast<int>(size), 0, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    int sent = sendto(getHandle(), static_cast<const char*>(data), static_cast<int>(size), 0, reinterpret_cast<sockaddr*>(&address), addressSize);
 
     // Check for errors
     if (sent < 0)
-        return priv::SocketImpl::getErrorStatus();
+        return recordStatus(priv::SocketImpl::getErrorStatus());
+
+    record(BytesSent, static_cast<Uint64>(sent));
+    record(PacketsSent);
 
     return Done;
 }
@@ -133,7 +160,8 @@ Socket::Status UdpSocket::receive(void* data, std::size_t size, std::size_t& rec
     }
 
     // Data that will be filled with the other computer's address
-    sockaddr_in address = priv::SocketImpl::createAddress(INADDR_ANY, 0);
+    sockaddr_storage address;
+    std::memset(&address, 0, sizeof(address));
 
     // Receive a chunk of bytes
     priv::SocketImpl::AddrLength addressSize = sizeof(address);
@@ -141,12 +169,14 @@ Socket::Status UdpSocket::receive(void* data, std::size_t size, std::size_t& rec
 
     // Check for errors
     if (sizeReceived < 0)
-        return priv::SocketImpl::getErrorStatus();
+        return recordStatus(priv::SocketImpl::getErrorStatus());
+
+    record(BytesReceived, static_cast<Uint64>(sizeReceived));
+    record(PacketsReceived);
 
     // Fill the sender informations
     received      = static_cast<std::size_t>(sizeReceived);
-    remoteAddress = IpAddress(ntohl(address.sin_addr.s_addr));
-    remotePort    = ntohs(address.sin_port);
+    remoteAddress = priv::SocketImpl::getAddress(address, remotePort);
 
     return Done;
 }
@@ -168,7 +198,12 @@ Socket::Status UdpSocket::send(Packet& packet, const IpAddress& remoteAddress, u
     const void* data = packet.onSend(size);
 
     // Send it
-    return send(data, size, remoteAddress, remotePort);
+    Status status = send(data, size, remoteAddress, remotePort);
+
+    if ((status == Done) && isCaptureEnabled())
+        capture(true, data, size, remoteAddress, remotePort);
+
+    return status;
 }
 
 
@@ -181,6 +216,9 @@ Socket::Status UdpSocket::receive(Packet& packet, IpAddress& remoteAddress, unsi
     std::size_t received = 0;
     Status status = receive(&m_buffer[0], m_buffer.size(), received, remoteAddress, remotePort);
 
+    if ((status == Done) && isCaptureEnabled())
+        capture(false, &m_buffer[0], received, remoteAddress, remotePort);
+
     // If we received valid data, we can copy it to the user packet
     packet.clear();
     if ((status == Done) && (received > 0))
@@ -190,4 +228,220 @@ Socket::Status UdpSocket::receive(Packet& packet, IpAddress& remoteAddress, unsi
 }
 
 
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::send(const Datagram* datagrams, std::size_t count, std::size_t& sent)
+{
+    sent = 0;
+
+    // Create the internal socket if it doesn't exist
+    create(count ? datagrams[0].address : IpAddress::Any);
+
+    // Make sure that all the data will fit in datagrams
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (datagrams[i].size > MaxDatagramSize)
+        {
+            err() << "Cannot send data over the network "
+                  << "(the number of bytes to send is greater than sf::UdpSocket::MaxDatagramSize)" << std::endl;
+            return Error;
+        }
+    }
+
+#ifdef SFML_UDP_MMSG
+
+    mmsghdr          messages[batchSize];
+    iovec            buffers[batchSize];
+    sockaddr_storage addresses[batchSize];
+
+    while (sent < count)
+    {
+        // Describe the next batch of datagrams
+        unsigned int batch = static_cast<unsigned int>(std::min(count - sent, batchSize));
+        std::memset(messages, 0, batch * sizeof(mmsghdr));
+        for (unsigned int i = 0; i < batch; ++i)
+        {
+            const Datagram& datagram = datagrams[sent + i];
+            priv::SocketImpl::AddrLength addressSize = priv::SocketImpl::createAddress(datagram.address, datagram.port, isIpv6(), addresses[i]);
+            if (addressSize == 0)
+            {
+                err() << "Cannot send data to the IPv6 address " << datagram.address << " from an IPv4 socket" << std::endl;
+                return sent ? Partial : Error;
+            }
+
+            buffers[i].iov_base = datagram.data;
+            buffers[i].iov_len  = datagram.size;
+            messages[i].msg_hdr.msg_name    = &addresses[i];
+            messages[i].msg_hdr.msg_namelen = addressSize;
+            messages[i].msg_hdr.msg_iov     = &buffers[i];
+            messages[i].msg_hdr.msg_iovlen  = 1;
+        }
+
+        int result = sendmmsg(getHandle(), messages, batch, 0);
+
+        // Check for errors
+        if (result <= 0)
+        {
+            Status status = result < 0 ? priv::SocketImpl::getErrorStatus() : NotReady;
+
+            if ((status == NotReady) && sent)
+                return recordStatus(Partial);
+
+            return recordStatus(status);
+        }
+
+        Uint64 bytes = 0;
+        for (int i = 0; i < result; ++i)
+            bytes += messages[i].msg_len;
+
+        record(BytesSent, bytes);
+        record(PacketsSent, static_cast<Uint64>(result));
+
+        sent += static_cast<std::size_t>(result);
+    }
+
+#else
+
+    for (; sent < count; ++sent)
+    {
+        const Datagram& datagram = datagrams[sent];
+        Status status = send(datagram.data, datagram.size, datagram.address, datagram.port);
+
+        // Check for errors
+        if (status != Done)
+        {
+            if ((status == NotReady) && sent)
+                return Partial;
+
+            return status;
+        }
+    }
+
+#endif
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::receive(Datagram* datagrams, std::size_t count, std::size_t& received)
+{
+    received = 0;
+
+    // Check the destination buffers
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (!datagrams[i].data)
+        {
+            err() << "Cannot receive data from the network (the destination buffer is invalid)" << std::endl;
+            return Error;
+        }
+    }
+
+#ifdef SFML_UDP_MMSG
+
+    mmsghdr          messages[batchSize];
+    iovec            buffers[batchSize];
+    sockaddr_storage addresses[batchSize];
+
+#ifdef UDP_GRO
+    // Receive offload tells the size of the coalesced datagrams in a control message
+    char controls[batchSize][CMSG_SPACE(sizeof(int))];
+#endif
+
+    while (received < count)
+    {
+        // Describe the next batch of datagrams
+        unsigned int batch = static_cast<unsigned int>(std::min(count - received, batchSize));
+        std::memset(messages, 0, batch * sizeof(mmsghdr));
+        for (unsigned int i = 0; i < batch; ++i)
+        {
+            Datagram& datagram = datagrams[received + i];
+            buffers[i].iov_base = datagram.data;
+            buffers[i].iov_len  = datagram.capacity;
+            messages[i].msg_hdr.msg_name    = &addresses[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+            messages[i].msg_hdr.msg_iov     = &buffers[i];
+            messages[i].msg_hdr.msg_iovlen  = 1;
+
+        #ifdef UDP_GRO
+            messages[i].msg_hdr.msg_control    = controls[i];
+            messages[i].msg_hdr.msg_controllen = sizeof(controls[i]);
+        #endif
+        }
+
+        // Only the first datagram can block, the following batches take what is already there
+        int flags = received ? MSG_DONTWAIT : MSG_WAITFORONE;
+        int result = recvmmsg(getHandle(), messages, batch, flags, NULL);
+
+        // Check for errors
+        if (result <= 0)
+        {
+            if (received)
+                break;
+
+            return recordStatus(result < 0 ? priv::SocketImpl::getErrorStatus() : NotReady);
+        }
+
+        // Fill the sizes and sender informations
+        Uint64 bytes = 0;
+        for (int i = 0; i < result; ++i)
+        {
+            bytes += messages[i].msg_len;
+
+            Datagram& datagram = datagrams[received + i];
+            datagram.size        = std::min(static_cast<std::size_t>(messages[i].msg_len), datagram.capacity);
+            datagram.address     = priv::SocketImpl::getAddress(addresses[i], datagram.port);
+            datagram.segmentSize = 0;
+
+        #ifdef UDP_GRO
+            msghdr& header = messages[i].msg_hdr;
+            for (cmsghdr* control = CMSG_FIRSTHDR(&header); control; control = CMSG_NXTHDR(&header, control))
+            {
+                if ((control->cmsg_level == SOL_UDP) && (control->cmsg_type == UDP_GRO))
+                {
+                    int segmentSize;
+                    std::memcpy(&segmentSize, CMSG_DATA(control), sizeof(segmentSize));
+                    datagram.segmentSize = static_cast<std::size_t>(segmentSize);
+                }
+            }
+        #endif
+        }
+
+        record(BytesReceived, bytes);
+        record(PacketsReceived, static_cast<Uint64>(result));
+
+        received += static_cast<std::size_t>(result);
+
+        if (static_cast<unsigned int>(result) < batch)
+            break;
+    }
+
+#else
+
+    for (; received < count; ++received)
+    {
+        // In blocking mode, stop when nothing is left rather than waiting for more
+        if (received && isBlocking() && !priv::SocketImpl::getPendingSize(getHandle()))
+            break;
+
+        Datagram& datagram = datagrams[received];
+        datagram.segmentSize = 0;
+        Status status = receive(datagram.data, datagram.capacity, datagram.size, datagram.address, datagram.port);
+
+        // Errors after the first datagram will be reported by the next call
+        if (status != Done)
+        {
+            if (received)
+                break;
+
+            return status;
+        }
+    }
+
+#endif
+
+    return Done;
+}
+
+
 } // namespace sf
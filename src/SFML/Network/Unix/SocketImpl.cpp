@@ -26,10 +26,83 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Unix/SocketImpl.hpp>
+#include <SFML/System/Err.hpp>
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/uio.h>
+#include <netinet/udp.h>
 #include <cstring>
 
+#if defined(SFML_SYSTEM_LINUX)
+    #include <sys/sendfile.h>
+    #include <pthread.h>
+    #include <signal.h>
+#endif
+
+
+namespace
+{
+    // Send a file by reading it in large blocks, when the system can't do it by itself
+    sf::Socket::Status sendBlocks(sf::SocketHandle sock, int file, sf::Uint64 offset, sf::Uint64& sent)
+    {
+        if (lseek(file, static_cast<off_t>(offset + sent), SEEK_SET) == -1)
+            return sf::Socket::Error;
+
+        char buffer[65536];
+        for (;;)
+        {
+            ssize_t size = read(file, buffer, sizeof(buffer));
+            if (size == 0)
+                return sf::Socket::Done;
+            if (size < 0)
+                return sf::Socket::Error;
+
+            for (ssize_t position = 0; position < size;)
+            {
+                ssize_t result = send(sock, buffer + position, size - position, 0);
+                if (result < 0)
+                    return sf::priv::SocketImpl::getErrorStatus();
+
+                position += result;
+                sent += result;
+            }
+        }
+    }
+
+    // Get the level and name of the system option matching a socket option
+    bool getOptionName(sf::Socket::Option option, bool ipv6, int& level, int& name)
+    {
+        switch (option)
+        {
+            case sf::Socket::SendBufferSize:    level = SOL_SOCKET;  name = SO_SNDBUF;   return true;
+            case sf::Socket::ReceiveBufferSize: level = SOL_SOCKET;  name = SO_RCVBUF;   return true;
+            case sf::Socket::NoDelay:           level = IPPROTO_TCP; name = TCP_NODELAY; return true;
+
+            case sf::Socket::TypeOfService:
+                level = ipv6 ? IPPROTO_IPV6 : IPPROTO_IP;
+                name  = ipv6 ? IPV6_TCLASS : IP_TOS;
+                return true;
+
+        #ifdef SO_BUSY_POLL
+            case sf::Socket::BusyPoll:            level = SOL_SOCKET;  name = SO_BUSY_POLL; return true;
+        #endif
+        #ifdef TCP_QUICKACK
+            case sf::Socket::QuickAck:            level = IPPROTO_TCP; name = TCP_QUICKACK; return true;
+        #endif
+        #ifdef UDP_SEGMENT
+            case sf::Socket::SegmentationOffload: level = SOL_UDP;     name = UDP_SEGMENT;  return true;
+        #endif
+        #ifdef UDP_GRO
+            case sf::Socket::ReceiveOffload:      level = SOL_UDP;     name = UDP_GRO;      return true;
+        #endif
+
+            default:
+                return false;
+        }
+    }
+}
+
 
 namespace sf
 {
@@ -52,6 +125,67 @@ sockaddr_in SocketImpl::createAddress(Uint32 address, unsigned short port)
 }
 
 
+////////////////////////////////////////////////////////////
+SocketImpl::AddrLength SocketImpl::createAddress(const IpAddress& address, unsigned short port, bool ipv6, sockaddr_storage& result)
+{
+    std::memset(&result, 0, sizeof(result));
+
+    Uint8 bytes[16];
+    address.toBytes(bytes);
+
+    if (ipv6)
+    {
+        sockaddr_in6& addr = reinterpret_cast<sockaddr_in6&>(result);
+        std::memcpy(&addr.sin6_addr, bytes, 16);
+        addr.sin6_family = AF_INET6;
+        addr.sin6_port   = htons(port);
+
+    #if defined(SFML_SYSTEM_MACOS)
+        addr.sin6_len = sizeof(addr);
+    #endif
+
+        return sizeof(addr);
+    }
+
+    // The unspecified IPv6 address is the only one that has an IPv4 meaning
+    if (address.isIpv6() && (address != IpAddress::Any))
+        return 0;
+
+    sockaddr_in& addr = reinterpret_cast<sockaddr_in&>(result);
+    addr = createAddress(address.toInteger(), port);
+
+    return sizeof(addr);
+}
+
+
+////////////////////////////////////////////////////////////
+IpAddress SocketImpl::getAddress(const sockaddr_storage& address, unsigned short& port)
+{
+    if (address.ss_family == AF_INET6)
+    {
+        const sockaddr_in6& addr = reinterpret_cast<const sockaddr_in6&>(address);
+        port = ntohs(addr.sin6_port);
+        return IpAddress(reinterpret_cast<const Uint8*>(&addr.sin6_addr));
+    }
+
+    const sockaddr_in& addr = reinterpret_cast<const sockaddr_in&>(address);
+    port = ntohs(addr.sin_port);
+    return IpAddress(ntohl(addr.sin_addr.s_addr));
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::isIpv6(SocketHandle sock)
+{
+    sockaddr_storage address;
+    AddrLength size = sizeof(address);
+    if (getsockname(sock, reinterpret_cast<sockaddr*>(&address), &size) == -1)
+        return false;
+
+    return address.ss_family == AF_INET6;
+}
+
+
 ////////////////////////////////////////////////////////////
 SocketHandle SocketImpl::invalidSocket()
 {
@@ -70,10 +204,224 @@ void SocketImpl::close(SocketHandle sock)
 void SocketImpl::setBlocking(SocketHandle sock, bool block)
 {
     int status = fcntl(sock, F_GETFL);
-    if (block)
-        fcntl(sock, F_SETFL, status & ~O_NONBLOCK);
-    else
-        fcntl(sock, F_SETFL, status | O_NONBLOCK);
+    int flags = block ? (status & ~O_NONBLOCK) : (status | O_NONBLOCK);
+
+    // Save a system call if the socket is already in the requested mode
+    if (flags != status)
+        fcntl(sock, F_SETFL, flags);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::enablePortSharing(SocketHandle sock)
+{
+#ifdef SO_REUSEPORT
+    int yes = 1;
+    return setsockopt(sock, SOL_SOCKET, SO_REUSEPORT, reinterpret_cast<char*>(&yes), sizeof(yes)) != -1;
+#else
+    return false;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::isOptionSupported(Socket::Option option)
+{
+    int level, name;
+    return getOptionName(option, false, level, name);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::setOption(SocketHandle sock, Socket::Option option, int value, bool ipv6)
+{
+    int level, name;
+    if (!getOptionName(option, ipv6, level, name))
+        return false;
+
+    if (setsockopt(sock, level, name, reinterpret_cast<char*>(&value), sizeof(value)) == -1)
+        return false;
+
+    // Dual-stack sockets use the IPv4 option for their IPv4 traffic
+    if (ipv6 && (option == Socket::TypeOfService))
+        setsockopt(sock, IPPROTO_IP, IP_TOS, reinterpret_cast<char*>(&value), sizeof(value));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::getOption(SocketHandle sock, Socket::Option option, int& value, bool ipv6)
+{
+    int level, name;
+    if (!getOptionName(option, ipv6, level, name))
+        return false;
+
+    value = 0;
+    AddrLength size = sizeof(value);
+    return getsockopt(sock, level, name, reinterpret_cast<char*>(&value), &size) != -1;
+}
+
+
+////////////////////////////////////////////////////////////
+SocketHandle SocketImpl::accept(SocketHandle sock, bool blocking)
+{
+#if defined(SFML_SYSTEM_LINUX) && defined(SOCK_CLOEXEC)
+
+    // Create the new socket with its final flags, in a single system call
+    int flags = SOCK_CLOEXEC | (blocking ? 0 : SOCK_NONBLOCK);
+    SocketHandle remote = accept4(sock, NULL, NULL, flags);
+
+    // Old kernels don't know accept4
+    if ((remote == invalidSocket()) && (errno == ENOSYS))
+        remote = ::accept(sock, NULL, NULL);
+
+    return remote;
+
+#else
+
+    SocketHandle remote = ::accept(sock, NULL, NULL);
+    if (remote != invalidSocket())
+        setBlocking(remote, blocking);
+
+    return remote;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SocketImpl::getPendingSize(SocketHandle sock)
+{
+    int size = 0;
+    if (ioctl(sock, FIONREAD, &size) == -1)
+        return 0;
+
+    return static_cast<std::size_t>(size);
+}
+
+
+////////////////////////////////////////////////////////////
+Time SocketImpl::getRoundTripTime(SocketHandle sock)
+{
+#if defined(TCP_INFO) && !defined(SFML_SYSTEM_MACOS)
+
+    // Linux and FreeBSD report the smoothed RTT in microseconds
+    tcp_info info;
+    socklen_t size = sizeof(info);
+    if (getsockopt(sock, IPPROTO_TCP, TCP_INFO, &info, &size) == -1)
+        return Time::Zero;
+
+    return microseconds(info.tcpi_rtt);
+
+#elif defined(TCP_CONNECTION_INFO)
+
+    // OS X reports it in milliseconds
+    tcp_connection_info info;
+    socklen_t size = sizeof(info);
+    if (getsockopt(sock, IPPROTO_TCP, TCP_CONNECTION_INFO, &info, &size) == -1)
+        return Time::Zero;
+
+    return milliseconds(info.tcpi_srtt);
+
+#else
+
+    return Time::Zero;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+int SocketImpl::send(SocketHandle sock, const void* first, std::size_t firstSize, const void* second, std::size_t secondSize, int flags)
+{
+    iovec buffers[2];
+    buffers[0].iov_base = const_cast<void*>(first);
+    buffers[0].iov_len  = firstSize;
+    buffers[1].iov_base = const_cast<void*>(second);
+    buffers[1].iov_len  = secondSize;
+
+    // sendmsg is used rather than writev, which can't take the flags
+    msghdr message;
+    std::memset(&message, 0, sizeof(message));
+    message.msg_iov    = buffers;
+    message.msg_iovlen = 2;
+
+    return static_cast<int>(sendmsg(sock, &message, flags));
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status SocketImpl::sendFile(SocketHandle sock, const std::string& filename, Uint64 offset, Uint64& sent)
+{
+    sent = 0;
+
+    int file = open(filename.c_str(), O_RDONLY);
+    if (file == -1)
+    {
+        err() << "Failed to send \"" << filename << "\" (cannot open the file)" << std::endl;
+        return Socket::Error;
+    }
+
+#if defined(SFML_SYSTEM_LINUX)
+
+    // sendfile can't take MSG_NOSIGNAL: block SIGPIPE while it runs
+    sigset_t pipeSignal;
+    sigset_t previousMask;
+    sigset_t pending;
+    sigemptyset(&pipeSignal);
+    sigaddset(&pipeSignal, SIGPIPE);
+    sigpending(&pending);
+    bool wasPending = sigismember(&pending, SIGPIPE) == 1;
+    pthread_sigmask(SIG_BLOCK, &pipeSignal, &previousMask);
+
+    // The kernel copies the file to the socket, without going through user space
+    Socket::Status status = Socket::Done;
+    off_t position = static_cast<off_t>(offset);
+    for (;;)
+    {
+        ssize_t result = ::sendfile(sock, file, &position, 1 << 30);
+        if (result > 0)
+        {
+            sent += result;
+        }
+        else if (result == 0)
+        {
+            break;
+        }
+        else if ((errno == EINVAL) || (errno == ENOSYS))
+        {
+            // The file can't be mapped by sendfile, read it instead
+            status = sendBlocks(sock, file, offset, sent);
+            break;
+        }
+        else if (errno != EINTR)
+        {
+            status = getErrorStatus();
+            break;
+        }
+    }
+
+    // Discard the SIGPIPE raised if the connection was closed
+    if ((status == Socket::Disconnected) && !wasPending)
+    {
+        timespec noWait = {0, 0};
+        sigtimedwait(&pipeSignal, NULL, &noWait);
+    }
+    pthread_sigmask(SIG_SETMASK, &previousMask, NULL);
+
+#else
+
+    Socket::Status status = sendBlocks(sock, file, offset, sent);
+
+#endif
+
+    ::close(file);
+
+    if ((status == Socket::NotReady) && (sent > 0))
+        status = Socket::Partial;
+
+    return status;
 }
 
 
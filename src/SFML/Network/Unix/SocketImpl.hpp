@@ -29,6 +29,8 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Socket.hpp>
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/System/Time.hpp>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
@@ -36,6 +38,7 @@
 #include <arpa/inet.h>
 #include <netdb.h>
 #include <unistd.h>
+#include <string>
 
 
 namespace sf
@@ -67,6 +70,45 @@ public:
     ////////////////////////////////////////////////////////////
     static sockaddr_in createAddress(Uint32 address, unsigned short port);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create an internal address for a socket of a given family
+    ///
+    /// An IPv6 socket reaches IPv4 addresses through their
+    /// IPv4-mapped form; an IPv4 socket can't reach IPv6
+    /// addresses (except the unspecified address, which stands
+    /// for INADDR_ANY).
+    ///
+    /// \param address Target address
+    /// \param port    Target port
+    /// \param ipv6    Is the address for an IPv6 socket?
+    /// \param result  Address to fill
+    ///
+    /// \return Size of the address, or 0 if the address can't be used by this family of socket
+    ///
+    ////////////////////////////////////////////////////////////
+    static AddrLength createAddress(const IpAddress& address, unsigned short port, bool ipv6, sockaddr_storage& result);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Extract the IP address and the port of an internal address
+    ///
+    /// \param address Internal address (IPv4 or IPv6)
+    /// \param port    Port of the address
+    ///
+    /// \return IP address (IPv4-mapped addresses give IPv4 ones)
+    ///
+    ////////////////////////////////////////////////////////////
+    static IpAddress getAddress(const sockaddr_storage& address, unsigned short& port);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a socket is an IPv6 one
+    ///
+    /// \param sock Socket handle
+    ///
+    /// \return True if the socket uses IPv6, false if it uses IPv4
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isIpv6(SocketHandle sock);
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the value of the invalid socket
     ///
@@ -92,6 +134,117 @@ public:
     ////////////////////////////////////////////////////////////
     static void setBlocking(SocketHandle sock, bool block);
 
+    ////////////////////////////////////////////////////////////
+    /// Allow several sockets to bind to the same address and port
+    ///
+    /// On Linux, the incoming connections are then distributed
+    /// among all the listeners sharing the port.
+    ///
+    /// \param sock Socket handle
+    ///
+    /// \return True if the option could be set, false if the system doesn't support it
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool enablePortSharing(SocketHandle sock);
+
+    ////////////////////////////////////////////////////////////
+    /// Tell whether the system supports a socket option
+    ///
+    /// \param option Option to check
+    ///
+    /// \return True if the option is supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isOptionSupported(Socket::Option option);
+
+    ////////////////////////////////////////////////////////////
+    /// Set the value of a socket option
+    ///
+    /// \param sock   Socket handle
+    /// \param option Option to set
+    /// \param value  New value of the option
+    /// \param ipv6   Is the socket an IPv6 one?
+    ///
+    /// \return True on success, false if the option is not supported or was refused
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool setOption(SocketHandle sock, Socket::Option option, int value, bool ipv6);
+
+    ////////////////////////////////////////////////////////////
+    /// Get the value of a socket option
+    ///
+    /// \param sock   Socket handle
+    /// \param option Option to get
+    /// \param value  The value of the option will be written here
+    /// \param ipv6   Is the socket an IPv6 one?
+    ///
+    /// \return True on success, false if the option is not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool getOption(SocketHandle sock, Socket::Option option, int& value, bool ipv6);
+
+    ////////////////////////////////////////////////////////////
+    /// Accept a pending connection on a listening socket
+    ///
+    /// Where possible, the new socket is created with its
+    /// blocking mode and close-on-exec flag already set.
+    ///
+    /// \param sock     Handle of the listening socket
+    /// \param blocking Blocking mode of the new socket
+    ///
+    /// \return Handle of the new socket, or invalidSocket() on error
+    ///
+    ////////////////////////////////////////////////////////////
+    static SocketHandle accept(SocketHandle sock, bool blocking);
+
+    ////////////////////////////////////////////////////////////
+    /// Get the number of bytes that can be received without blocking
+    ///
+    /// \param sock Socket handle
+    ///
+    /// \return Number of bytes waiting in the receive buffer of the socket
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t getPendingSize(SocketHandle sock);
+
+    ////////////////////////////////////////////////////////////
+    /// Get the round-trip time measured by the TCP stack
+    ///
+    /// \param sock TCP socket handle
+    ///
+    /// \return Smoothed round-trip time, or Time::Zero if it is not available
+    ///
+    ////////////////////////////////////////////////////////////
+    static Time getRoundTripTime(SocketHandle sock);
+
+    ////////////////////////////////////////////////////////////
+    /// Send two buffers with a single system call
+    ///
+    /// \param sock       Socket handle
+    /// \param first      First buffer to send
+    /// \param firstSize  Size of the first buffer, in bytes
+    /// \param second     Buffer sent after the first one
+    /// \param secondSize Size of the second buffer, in bytes
+    /// \param flags      Flags of the send call
+    ///
+    /// \return Number of bytes sent, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    static int send(SocketHandle sock, const void* first, std::size_t firstSize, const void* second, std::size_t secondSize, int flags);
+
+    ////////////////////////////////////////////////////////////
+    /// Send the contents of a file, from a given position to its end
+    ///
+    /// \param sock     Socket handle
+    /// \param filename Path of the file to send
+    /// \param offset   Position of the first byte to send in the file
+    /// \param sent     The number of bytes sent will be written here
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    static Socket::Status sendFile(SocketHandle sock, const std::string& filename, Uint64 offset, Uint64& sent);
+
     ////////////////////////////////////////////////////////////
     /// Get the last socket error status
     ///
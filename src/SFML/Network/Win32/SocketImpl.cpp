@@ -26,9 +26,39 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Win32/SocketImpl.hpp>
+#include <SFML/System/Err.hpp>
 #include <cstring>
 
 
+namespace
+{
+    // Get the level and name of the system option matching a socket option
+    bool getOptionName(sf::Socket::Option option, bool ipv6, int& level, int& name)
+    {
+        switch (option)
+        {
+            case sf::Socket::SendBufferSize:    level = SOL_SOCKET;  name = SO_SNDBUF;   return true;
+            case sf::Socket::ReceiveBufferSize: level = SOL_SOCKET;  name = SO_RCVBUF;   return true;
+            case sf::Socket::NoDelay:           level = IPPROTO_TCP; name = TCP_NODELAY; return true;
+
+            case sf::Socket::TypeOfService:
+            #ifdef IPV6_TCLASS
+                level = ipv6 ? IPPROTO_IPV6 : IPPROTO_IP;
+                name  = ipv6 ? IPV6_TCLASS : IP_TOS;
+            #else
+                level = IPPROTO_IP;
+                name  = IP_TOS;
+            #endif
+                return true;
+
+            // The other options are specific to Linux
+            default:
+                return false;
+        }
+    }
+}
+
+
 namespace sf
 {
 namespace priv
@@ -46,6 +76,63 @@ sockaddr_in SocketImpl::createAddress(Uint32 address, unsigned short port)
 }
 
 
+////////////////////////////////////////////////////////////
+SocketImpl::AddrLength SocketImpl::createAddress(const IpAddress& address, unsigned short port, bool ipv6, sockaddr_storage& result)
+{
+    std::memset(&result, 0, sizeof(result));
+
+    Uint8 bytes[16];
+    address.toBytes(bytes);
+
+    if (ipv6)
+    {
+        sockaddr_in6& addr = reinterpret_cast<sockaddr_in6&>(result);
+        std::memcpy(&addr.sin6_addr, bytes, 16);
+        addr.sin6_family = AF_INET6;
+        addr.sin6_port   = htons(port);
+
+        return sizeof(addr);
+    }
+
+    // The unspecified IPv6 address is the only one that has an IPv4 meaning
+    if (address.isIpv6() && (address != IpAddress::Any))
+        return 0;
+
+    sockaddr_in& addr = reinterpret_cast<sockaddr_in&>(result);
+    addr = createAddress(address.toInteger(), port);
+
+    return sizeof(addr);
+}
+
+
+////////////////////////////////////////////////////////////
+IpAddress SocketImpl::getAddress(const sockaddr_storage& address, unsigned short& port)
+{
+    if (address.ss_family == AF_INET6)
+    {
+        const sockaddr_in6& addr = reinterpret_cast<const sockaddr_in6&>(address);
+        port = ntohs(addr.sin6_port);
+        return IpAddress(reinterpret_cast<const Uint8*>(&addr.sin6_addr));
+    }
+
+    const sockaddr_in& addr = reinterpret_cast<const sockaddr_in&>(address);
+    port = ntohs(addr.sin_port);
+    return IpAddress(ntohl(addr.sin_addr.s_addr));
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::isIpv6(SocketHandle sock)
+{
+    sockaddr_storage address;
+    AddrLength size = sizeof(address);
+    if (getsockname(sock, reinterpret_cast<sockaddr*>(&address), &size) == -1)
+        return false;
+
+    return address.ss_family == AF_INET6;
+}
+
+
 ////////////////////////////////////////////////////////////
 SocketHandle SocketImpl::invalidSocket()
 {
@@ -68,6 +155,146 @@ void SocketImpl::setBlocking(SocketHandle sock, bool block)
 }
 
 
+////////////////////////////////////////////////////////////
+bool SocketImpl::enablePortSharing(SocketHandle)
+{
+    // SO_REUSEADDR would let other processes steal the port, and doesn't balance connections
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::isOptionSupported(Socket::Option option)
+{
+    int level, name;
+    return getOptionName(option, false, level, name);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::setOption(SocketHandle sock, Socket::Option option, int value, bool ipv6)
+{
+    int level, name;
+    if (!getOptionName(option, ipv6, level, name))
+        return false;
+
+    if (setsockopt(sock, level, name, reinterpret_cast<char*>(&value), sizeof(value)) == -1)
+        return false;
+
+    // Dual-stack sockets use the IPv4 option for their IPv4 traffic
+    if (ipv6 && (option == Socket::TypeOfService))
+        setsockopt(sock, IPPROTO_IP, IP_TOS, reinterpret_cast<char*>(&value), sizeof(value));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::getOption(SocketHandle sock, Socket::Option option, int& value, bool ipv6)
+{
+    int level, name;
+    if (!getOptionName(option, ipv6, level, name))
+        return false;
+
+    value = 0;
+    AddrLength size = sizeof(value);
+    return getsockopt(sock, level, name, reinterpret_cast<char*>(&value), &size) != -1;
+}
+
+
+////////////////////////////////////////////////////////////
+SocketHandle SocketImpl::accept(SocketHandle sock, bool)
+{
+    // Accepted sockets inherit the blocking mode of the listener, it is set afterwards
+    return ::accept(sock, NULL, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SocketImpl::getPendingSize(SocketHandle sock)
+{
+    u_long size = 0;
+    if (ioctlsocket(sock, FIONREAD, &size) == SOCKET_ERROR)
+        return 0;
+
+    return static_cast<std::size_t>(size);
+}
+
+
+////////////////////////////////////////////////////////////
+Time SocketImpl::getRoundTripTime(SocketHandle)
+{
+    // SIO_TCP_INFO requires Windows 10, the headers target Windows XP
+    return Time::Zero;
+}
+
+
+////////////////////////////////////////////////////////////
+int SocketImpl::send(SocketHandle sock, const void* first, std::size_t firstSize, const void* second, std::size_t secondSize, int flags)
+{
+    WSABUF buffers[2];
+    buffers[0].buf = const_cast<char*>(static_cast<const char*>(first));
+    buffers[0].len = static_cast<u_long>(firstSize);
+    buffers[1].buf = const_cast<char*>(static_cast<const char*>(second));
+    buffers[1].len = static_cast<u_long>(secondSize);
+
+    // Without an overlapped structure, WSASend behaves like send
+    DWORD sent = 0;
+    if (WSASend(sock, buffers, 2, &sent, static_cast<DWORD>(flags), NULL, NULL) == SOCKET_ERROR)
+        return -1;
+
+    return static_cast<int>(sent);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status SocketImpl::sendFile(SocketHandle sock, const std::string& filename, Uint64 offset, Uint64& sent)
+{
+    sent = 0;
+
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        err() << "Failed to send \"" << filename << "\" (cannot open the file)" << std::endl;
+        return Socket::Error;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        return Socket::Error;
+    }
+
+    Socket::Status status = Socket::Done;
+    Uint64 total = static_cast<Uint64>(size.QuadPart);
+    while (offset + sent < total)
+    {
+        LARGE_INTEGER position;
+        position.QuadPart = static_cast<LONGLONG>(offset + sent);
+        SetFilePointerEx(file, position, NULL, FILE_BEGIN);
+
+        // TransmitFile sends from the current position of the file, the kernel copies the data
+        Uint64 remaining = total - offset - sent;
+        DWORD count = static_cast<DWORD>(remaining < (1 << 30) ? remaining : (1 << 30));
+        if (!TransmitFile(sock, file, count, 0, NULL, NULL, 0))
+        {
+            status = getErrorStatus();
+            break;
+        }
+
+        sent += count;
+    }
+
+    CloseHandle(file);
+
+    if ((status == Socket::NotReady) && (sent > 0))
+        status = Socket::Partial;
+
+    return status;
+}
+
+
 ////////////////////////////////////////////////////////////
 Socket::Status SocketImpl::getErrorStatus()
 {
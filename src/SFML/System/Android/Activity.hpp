@@ -70,6 +70,7 @@ struct ActivityStates
     size_t savedStateSize;
 
     Mutex mutex;
+    Mutex inputMutex;
 
     void (*forwardEvent)(const Event& event);
     int (*processEvent)(int fd, int events, void* data);
@@ -0,0 +1,504 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Archive.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+
+namespace
+{
+    // Layout of an archive, all integers are little endian:
+    //
+    // Header (16 bytes):
+    //   "SFPK", version, number of entries, size of the names block
+    // Table of contents (32 bytes per entry, sorted by name):
+    //   name offset in the names block, name length, data offset from
+    //   the beginning of the archive (64 bits), stored size, original
+    //   size, flags, reserved
+    // Names block
+    // Data of the entries
+    const std::size_t headerSize = 16;
+    const std::size_t recordSize = 32;
+    const sf::Uint32  version    = 1;
+    const sf::Uint32  flagLz4    = 1;
+
+    // Decode little endian integers from the archive
+    sf::Uint32 readUint32(const sf::Uint8* data)
+    {
+        return static_cast<sf::Uint32>(data[0])       |
+               static_cast<sf::Uint32>(data[1]) << 8  |
+               static_cast<sf::Uint32>(data[2]) << 16 |
+               static_cast<sf::Uint32>(data[3]) << 24;
+    }
+    sf::Uint64 readUint64(const sf::Uint8* data)
+    {
+        return static_cast<sf::Uint64>(readUint32(data)) | static_cast<sf::Uint64>(readUint32(data + 4)) << 32;
+    }
+
+    // Encode little endian integers into an archive
+    void writeUint32(std::vector<char>& output, sf::Uint32 value)
+    {
+        for (int i = 0; i < 4; ++i)
+            output.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+    void writeUint64(std::vector<char>& output, sf::Uint64 value)
+    {
+        writeUint32(output, static_cast<sf::Uint32>(value & 0xFFFFFFFF));
+        writeUint32(output, static_cast<sf::Uint32>(value >> 32));
+    }
+
+    // Compare the name of an entry with a string, like strcmp
+    int compareNames(const sf::Uint8* name, std::size_t length, const char* other, std::size_t otherLength)
+    {
+        int result = std::memcmp(name, other, std::min(length, otherLength));
+        if (result != 0)
+            return result;
+        else if (length != otherLength)
+            return length < otherLength ? -1 : 1;
+        else
+            return 0;
+    }
+
+    // Write an LZ4 length, continuing the 4 bits stored in the token
+    void writeLz4Length(std::vector<char>& output, std::size_t length)
+    {
+        if (length >= 15)
+        {
+            for (length -= 15; length >= 255; length -= 255)
+                output.push_back(static_cast<char>(255));
+            output.push_back(static_cast<char>(length));
+        }
+    }
+
+    // Write an LZ4 sequence: literals, then a match unless it's the last one
+    void writeLz4Sequence(std::vector<char>& output, const char* literals, std::size_t literalCount, std::size_t offset, std::size_t matchLength)
+    {
+        std::size_t match = matchLength > 0 ? matchLength - 4 : 0;
+        output.push_back(static_cast<char>((std::min<std::size_t>(literalCount, 15) << 4) | std::min<std::size_t>(match, 15)));
+        writeLz4Length(output, literalCount);
+        output.insert(output.end(), literals, literals + literalCount);
+
+        if (matchLength > 0)
+        {
+            output.push_back(static_cast<char>(offset & 0xFF));
+            output.push_back(static_cast<char>(offset >> 8));
+            writeLz4Length(output, match);
+        }
+    }
+
+    // Compress a block in the LZ4 format, with a greedy single-probe matcher
+    void compressLz4(const std::vector<char>& input, std::vector<char>& output)
+    {
+        // The format requires the last 5 bytes to be literals, and
+        // the last match to start at least 12 bytes before the end
+        const std::size_t size = input.size();
+        const std::size_t matchEnd = size > 5 ? size - 5 : 0;
+        const std::size_t matchStart = size > 12 ? size - 12 : 0;
+        const char* data = size > 0 ? &input[0] : NULL;
+
+        std::vector<std::size_t> table(4096, static_cast<std::size_t>(-1));
+        std::size_t anchor = 0;
+        std::size_t position = 0;
+        while (position < matchStart)
+        {
+            sf::Uint32 sequence;
+            std::memcpy(&sequence, data + position, 4);
+            std::size_t hash = (sequence * 2654435761u) >> 20;
+            std::size_t candidate = table[hash];
+            table[hash] = position;
+
+            if ((candidate != static_cast<std::size_t>(-1)) && (position - candidate <= 65535) &&
+                (std::memcmp(data + candidate, data + position, 4) == 0))
+            {
+                std::size_t length = 4;
+                while ((position + length < matchEnd) && (data[candidate + length] == data[position + length]))
+                    ++length;
+
+                writeLz4Sequence(output, data + anchor, position - anchor, position - candidate, length);
+                position += length;
+                anchor = position;
+            }
+            else
+            {
+                ++position;
+            }
+        }
+
+        writeLz4Sequence(output, data + anchor, size - anchor, 0, 0);
+    }
+
+    // Read an LZ4 length, continuing the 4 bits stored in the token
+    bool readLz4Length(const sf::Uint8*& input, const sf::Uint8* end, std::size_t& length)
+    {
+        if (length == 15)
+        {
+            sf::Uint8 byte;
+            do
+            {
+                if (input == end)
+                    return false;
+                byte = *input++;
+                length += byte;
+            }
+            while (byte == 255);
+        }
+
+        return true;
+    }
+
+    // Decompress an LZ4 block, checking that it doesn't read or write out of bounds
+    bool decompressLz4(const sf::Uint8* input, std::size_t inputSize, char* output, std::size_t outputSize)
+    {
+        const sf::Uint8* inputEnd = input + inputSize;
+        char* const begin = output;
+        char* const outputEnd = output + outputSize;
+
+        while (input < inputEnd)
+        {
+            sf::Uint8 token = *input++;
+
+            // Copy the literals
+            std::size_t literalCount = token >> 4;
+            if (!readLz4Length(input, inputEnd, literalCount) ||
+                (literalCount > static_cast<std::size_t>(inputEnd - input)) ||
+                (literalCount > static_cast<std::size_t>(outputEnd - output)))
+                return false;
+            std::memcpy(output, input, literalCount);
+            input += literalCount;
+            output += literalCount;
+
+            // The last sequence has no match
+            if (input == inputEnd)
+                break;
+
+            // Copy the match, byte by byte since it may overlap the output
+            if (inputEnd - input < 2)
+                return false;
+            std::size_t offset = input[0] | (input[1] << 8);
+            input += 2;
+            std::size_t length = token & 15;
+            if (!readLz4Length(input, inputEnd, length))
+                return false;
+            length += 4;
+            if ((offset == 0) || (offset > static_cast<std::size_t>(output - begin)) ||
+                (length > static_cast<std::size_t>(outputEnd - output)))
+                return false;
+            const char* match = output - offset;
+            for (std::size_t i = 0; i < length; ++i)
+                *output++ = *match++;
+        }
+
+        return output == outputEnd;
+    }
+
+    // Orders files by the name of their entry
+    struct EntryNameLess
+    {
+        EntryNameLess(const std::vector<std::string>& names) : names(names) {}
+        bool operator ()(std::size_t left, std::size_t right) const {return names[left] < names[right];}
+        const std::vector<std::string>& names;
+    };
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Archive::Archive() :
+m_data      (NULL),
+m_size      (0),
+m_entryCount(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Archive::openFromFile(const std::string& filename)
+{
+    m_contents.clear();
+    m_data = NULL;
+    m_size = 0;
+    m_entryCount = 0;
+
+    if (!m_file.open(filename))
+    {
+        err() << "Failed to open archive \"" << filename << "\" (couldn't open file)" << std::endl;
+        return false;
+    }
+
+    // Use the mapping of the file if there's one, otherwise read it entirely
+    Int64 size = m_file.getSize();
+    const Uint8* data = static_cast<const Uint8*>(m_file.getData());
+    if (!data && (size > 0))
+    {
+        m_contents.resize(static_cast<std::size_t>(size));
+        if ((m_file.seek(0) != 0) || (m_file.read(&m_contents[0], size) != size))
+        {
+            err() << "Failed to open archive \"" << filename << "\" (couldn't read file)" << std::endl;
+            m_contents.clear();
+            return false;
+        }
+        data = reinterpret_cast<const Uint8*>(&m_contents[0]);
+    }
+
+    // Check the header
+    if ((size < static_cast<Int64>(headerSize)) || (std::memcmp(data, "SFPK", 4) != 0) || (readUint32(data + 4) != version))
+    {
+        err() << "Failed to open archive \"" << filename << "\" (invalid or unsupported archive)" << std::endl;
+        m_contents.clear();
+        return false;
+    }
+
+    // Check that the table of contents, the names and the data all lie
+    // within the file, and that entries are sorted for the binary search
+    Uint64 fileSize = static_cast<Uint64>(size);
+    Uint64 entryCount = readUint32(data + 8);
+    Uint64 namesSize = readUint32(data + 12);
+    Uint64 namesOffset = headerSize + entryCount * recordSize;
+    bool valid = namesOffset + namesSize <= fileSize;
+    for (Uint64 i = 0; valid && (i < entryCount); ++i)
+    {
+        const Uint8* record = data + headerSize + i * recordSize;
+        Uint64 nameOffset = readUint32(record);
+        Uint64 nameLength = readUint32(record + 4);
+        Uint64 dataOffset = readUint64(record + 8);
+        Uint64 storedSize = readUint32(record + 16);
+        Uint32 originalSize = readUint32(record + 20);
+        Uint32 flags = readUint32(record + 24);
+
+        valid = (nameOffset + nameLength <= namesSize) &&
+                (dataOffset <= fileSize) && (storedSize <= fileSize - dataOffset) &&
+                ((flags & flagLz4) || (storedSize == originalSize));
+
+        if (valid && (i > 0))
+        {
+            const Uint8* previous = record - recordSize;
+            valid = compareNames(data + namesOffset + readUint32(previous), readUint32(previous + 4),
+                                 reinterpret_cast<const char*>(data + namesOffset + nameOffset), nameLength) < 0;
+        }
+    }
+
+    if (!valid)
+    {
+        err() << "Failed to open archive \"" << filename << "\" (corrupted table of contents)" << std::endl;
+        m_contents.clear();
+        return false;
+    }
+
+    m_data = data;
+    m_size = static_cast<std::size_t>(size);
+    m_entryCount = static_cast<std::size_t>(entryCount);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Archive::getEntryCount() const
+{
+    return m_entryCount;
+}
+
+
+////////////////////////////////////////////////////////////
+std::string Archive::getEntryName(std::size_t index) const
+{
+    if (index >= m_entryCount)
+        return std::string();
+
+    const Uint8* record = m_data + headerSize + index * recordSize;
+    const char* names = reinterpret_cast<const char*>(m_data + headerSize + m_entryCount * recordSize);
+
+    return std::string(names + readUint32(record), readUint32(record + 4));
+}
+
+
+////////////////////////////////////////////////////////////
+bool Archive::contains(const std::string& name) const
+{
+    return findEntry(name) != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Archive::create(const std::string& filename, const std::vector<std::string>& files, bool compress)
+{
+    // Name the entries and sort them
+    std::vector<std::string> names(files.size());
+    std::vector<std::size_t> order(files.size());
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        names[i] = files[i];
+        std::replace(names[i].begin(), names[i].end(), '\\', '/');
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), EntryNameLess(names));
+
+    std::vector<char> namesBlock;
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        if ((i > 0) && (names[order[i]] == names[order[i - 1]]))
+        {
+            err() << "Failed to create archive \"" << filename << "\" (duplicate entry \"" << names[order[i]] << "\")" << std::endl;
+            return false;
+        }
+        namesBlock.insert(namesBlock.end(), names[order[i]].begin(), names[order[i]].end());
+    }
+
+    std::ofstream output(filename.c_str(), std::ios_base::binary);
+    if (!output)
+    {
+        err() << "Failed to create archive \"" << filename << "\" (couldn't open file)" << std::endl;
+        return false;
+    }
+
+    // Reserve the space of the header, the table of contents and the names
+    std::vector<char> header;
+    header.insert(header.end(), "SFPK", "SFPK" + 4);
+    writeUint32(header, version);
+    writeUint32(header, static_cast<Uint32>(files.size()));
+    writeUint32(header, static_cast<Uint32>(namesBlock.size()));
+    Uint64 offset = headerSize + files.size() * recordSize + namesBlock.size();
+    output.seekp(static_cast<std::streamoff>(offset));
+
+    // Write the entries, compressing them when it makes them smaller
+    std::vector<char> contents;
+    std::vector<char> compressed;
+    Uint32 nameOffset = 0;
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        const std::string& path = files[order[i]];
+        FileInputStream file;
+        Int64 size = file.open(path) ? file.getSize() : -1;
+        if ((size < 0) || (size > 0xFFFFFFFF))
+        {
+            err() << "Failed to create archive \"" << filename << "\" (couldn't read \"" << path << "\")" << std::endl;
+            return false;
+        }
+        contents.resize(static_cast<std::size_t>(size));
+        if ((size > 0) && (file.read(&contents[0], size) != size))
+        {
+            err() << "Failed to create archive \"" << filename << "\" (couldn't read \"" << path << "\")" << std::endl;
+            return false;
+        }
+
+        compressed.clear();
+        if (compress)
+            compressLz4(contents, compressed);
+        bool useCompression = compress && (compressed.size() < contents.size());
+        const std::vector<char>& stored = useCompression ? compressed : contents;
+
+        writeUint32(header, nameOffset);
+        writeUint32(header, static_cast<Uint32>(names[order[i]].size()));
+        writeUint64(header, offset);
+        writeUint32(header, static_cast<Uint32>(stored.size()));
+        writeUint32(header, static_cast<Uint32>(contents.size()));
+        writeUint32(header, useCompression ? flagLz4 : 0);
+        writeUint32(header, 0);
+
+        if (!stored.empty())
+            output.write(&stored[0], stored.size());
+        nameOffset += static_cast<Uint32>(names[order[i]].size());
+        offset += stored.size();
+    }
+
+    // Write the header, the table of contents and the names
+    header.insert(header.end(), namesBlock.begin(), namesBlock.end());
+    output.seekp(0);
+    output.write(&header[0], header.size());
+
+    if (!output)
+    {
+        err() << "Failed to create archive \"" << filename << "\" (couldn't write file)" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Uint8* Archive::findEntry(const std::string& name) const
+{
+    const Uint8* names = m_data + headerSize + m_entryCount * recordSize;
+
+    std::size_t first = 0;
+    std::size_t last = m_entryCount;
+    while (first < last)
+    {
+        std::size_t middle = first + (last - first) / 2;
+        const Uint8* record = m_data + headerSize + middle * recordSize;
+        int result = compareNames(names + readUint32(record), readUint32(record + 4), name.c_str(), name.size());
+        if (result < 0)
+            first = middle + 1;
+        else if (result > 0)
+            last = middle;
+        else
+            return record;
+    }
+
+    return NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Archive::readEntry(const std::string& name, std::vector<char>& buffer, const void*& data, std::size_t& size) const
+{
+    const Uint8* record = findEntry(name);
+    if (!record)
+    {
+        err() << "Failed to open archive entry \"" << name << "\" (not found)" << std::endl;
+        return false;
+    }
+
+    const Uint8* stored = m_data + readUint64(record + 8);
+    std::size_t storedSize = readUint32(record + 16);
+    size = readUint32(record + 20);
+
+    if (readUint32(record + 24) & flagLz4)
+    {
+        buffer.resize(size);
+        if (!decompressLz4(stored, storedSize, size > 0 ? &buffer[0] : NULL, size))
+        {
+            err() << "Failed to open archive entry \"" << name << "\" (corrupted data)" << std::endl;
+            buffer.clear();
+            return false;
+        }
+        data = size > 0 ? static_cast<const void*>(&buffer[0]) : stored;
+    }
+    else
+    {
+        data = stored;
+    }
+
+    return true;
+}
+
+} // namespace sf
@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/ArchiveInputStream.hpp>
+#include <SFML/System/Archive.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ArchiveInputStream::ArchiveInputStream()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool ArchiveInputStream::open(const Archive& archive, const std::string& name)
+{
+    const void* data = NULL;
+    std::size_t size = 0;
+    if (!archive.readEntry(name, m_buffer, data, size))
+    {
+        MemoryInputStream::open(NULL, 0);
+        return false;
+    }
+
+    MemoryInputStream::open(data, size);
+
+    // Release the buffer of a previous compressed entry
+    if (data != (m_buffer.empty() ? NULL : &m_buffer[0]))
+        std::vector<char>().swap(m_buffer);
+
+    return true;
+}
+
+} // namespace sf
@@ -0,0 +1,288 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/AsyncInputStream.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+AsyncInputStream::AsyncInputStream() :
+m_thread     (&AsyncInputStream::run, this),
+m_mutex      (),
+m_request    (),
+m_loaded     (),
+m_source     (NULL),
+m_size       (-1),
+m_position   (0),
+m_blockSize  (0),
+m_blocks     (),
+m_first      (0),
+m_windowStart(0),
+m_nextId     (0),
+m_stop       (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+AsyncInputStream::~AsyncInputStream()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool AsyncInputStream::open(InputStream& source, std::size_t blockSize, std::size_t blockCount)
+{
+    close();
+
+    if ((blockSize == 0) || (blockCount == 0))
+    {
+        err() << "Failed to open asynchronous stream (blocks can't be empty)" << std::endl;
+        return false;
+    }
+
+    m_source    = &source;
+    m_size      = source.getSize();
+    m_position  = std::max(source.tell(), static_cast<Int64>(0));
+    m_blockSize = blockSize;
+    m_stop      = false;
+
+    // Start reading ahead from the current position of the source
+    Block block;
+    block.position = 0;
+    block.size     = 0;
+    block.id       = 0;
+    block.loaded   = false;
+    block.loading  = false;
+    m_blocks.assign(blockCount, block);
+    m_windowStart = -static_cast<Int64>(blockSize * blockCount);
+    moveWindow(m_position);
+
+    m_thread.launch();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void AsyncInputStream::close()
+{
+    if (!m_source)
+        return;
+
+    {
+        Lock lock(m_mutex);
+        m_stop = true;
+        m_request.notifyAll();
+    }
+    m_thread.wait();
+
+    // Leave the source where this stream was, so that it can be used directly
+    m_source->seek(m_position);
+    m_source = NULL;
+    m_blocks.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 AsyncInputStream::read(void* data, Int64 size)
+{
+    if (!m_source)
+        return -1;
+
+    Lock lock(m_mutex);
+
+    char* output = static_cast<char*>(data);
+    Int64 count = 0;
+    while ((count < size) && ((m_size < 0) || (m_position < m_size)))
+    {
+        // Wait for the block containing the reading position
+        Block& block = moveWindow(m_position);
+        while (!block.loaded)
+            m_loaded.wait(m_mutex);
+
+        if (block.size < 0)
+            return count > 0 ? count : -1;
+
+        Int64 offset = m_position - block.position;
+        if (offset >= block.size)
+            break;
+
+        Int64 available = std::min(size - count, block.size - offset);
+        std::memcpy(output + count, &block.data[static_cast<std::size_t>(offset)], static_cast<std::size_t>(available));
+        count += available;
+        m_position += available;
+
+        // A partial block ends the source stream
+        if ((block.size < static_cast<Int64>(m_blockSize)) && (m_position == block.position + block.size))
+            break;
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 AsyncInputStream::seek(Int64 position)
+{
+    if (!m_source || (position < 0))
+        return -1;
+
+    Lock lock(m_mutex);
+
+    m_position = m_size >= 0 ? std::min(position, m_size) : position;
+
+    // Start reading ahead from the new position right away
+    moveWindow(m_position);
+
+    return m_position;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 AsyncInputStream::tell()
+{
+    if (!m_source)
+        return -1;
+
+    Lock lock(m_mutex);
+
+    return m_position;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 AsyncInputStream::getSize()
+{
+    return m_source ? m_size : -1;
+}
+
+
+////////////////////////////////////////////////////////////
+void AsyncInputStream::run()
+{
+    std::vector<char> buffer;
+    Int64 sourcePosition = -1;
+
+    m_mutex.lock();
+    while (!m_stop)
+    {
+        // Find the first block of the window that must be read
+        Block* block = NULL;
+        for (std::size_t i = 0; (i < m_blocks.size()) && !block; ++i)
+        {
+            Block& candidate = m_blocks[(m_first + i) % m_blocks.size()];
+            if (!candidate.loaded && !candidate.loading)
+                block = &candidate;
+        }
+
+        if (!block)
+        {
+            m_request.wait(m_mutex);
+            continue;
+        }
+
+        block->loading = true;
+        Int64 position = block->position;
+        Uint64 id = block->id;
+
+        // Read the source without holding the mutex, so that the
+        // blocks already loaded can be consumed meanwhile
+        m_mutex.unlock();
+        buffer.resize(m_blockSize);
+        Int64 count = -1;
+        if ((sourcePosition == position) || (m_source->seek(position) == position))
+            count = m_source->read(&buffer[0], static_cast<Int64>(m_blockSize));
+        sourcePosition = count >= 0 ? position + count : -1;
+        m_mutex.lock();
+
+        // The block may have been reassigned while it was read
+        if (block->id == id)
+        {
+            block->data.swap(buffer);
+            block->size    = count;
+            block->loaded  = true;
+            block->loading = false;
+            m_loaded.notifyAll();
+        }
+    }
+    m_mutex.unlock();
+}
+
+
+////////////////////////////////////////////////////////////
+void AsyncInputStream::assign(Block& block, Int64 position)
+{
+    block.position = position;
+    block.size     = 0;
+    block.id       = m_nextId++;
+    block.loading  = false;
+
+    // Blocks beyond the end of the source have nothing to read
+    block.loaded = (m_size >= 0) && (position >= m_size);
+}
+
+
+////////////////////////////////////////////////////////////
+AsyncInputStream::Block& AsyncInputStream::moveWindow(Int64 position)
+{
+    Int64 blockSize = static_cast<Int64>(m_blockSize);
+    Int64 start = position - position % blockSize;
+    Int64 end = m_windowStart + blockSize * static_cast<Int64>(m_blocks.size());
+
+    if ((start < m_windowStart) || (start >= end))
+    {
+        // Out of the window: all the blocks are discarded
+        m_windowStart = start;
+        m_first = 0;
+        for (std::size_t i = 0; i < m_blocks.size(); ++i)
+            assign(m_blocks[i], start + blockSize * static_cast<Int64>(i));
+        m_request.notifyOne();
+    }
+    else if (start > m_windowStart)
+    {
+        // Forward in the window: the blocks left behind are recycled at its end
+        while (m_windowStart < start)
+        {
+            assign(m_blocks[m_first], end);
+            m_first = (m_first + 1) % m_blocks.size();
+            m_windowStart += blockSize;
+            end += blockSize;
+        }
+        m_request.notifyOne();
+    }
+
+    return m_blocks[m_first];
+}
+
+} // namespace sf
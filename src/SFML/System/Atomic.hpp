@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_ATOMIC_HPP
+#define SFML_ATOMIC_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+    #pragma intrinsic(_InterlockedCompareExchange, _InterlockedExchange, _InterlockedExchangeAdd, _InterlockedCompareExchange64)
+#endif
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+// Atomic operations on integers shared between threads
+//
+// The loads have acquire semantics (the reads and writes that
+// follow can't be moved before them), the stores have release
+// semantics (the reads and writes that precede can't be moved
+// after them), and the read-modify-write operations are full
+// barriers. The relaxed operations only guarantee that the
+// value is never torn, for counters read by other threads.
+// GCC (4.7 and later) and clang use the __atomic builtins,
+// Visual C++ uses the Interlocked intrinsics.
+////////////////////////////////////////////////////////////
+#if defined(_MSC_VER)
+
+inline unsigned long atomicLoad(const volatile unsigned long& value)
+{
+    return static_cast<unsigned long>(_InterlockedCompareExchange(reinterpret_cast<volatile long*>(const_cast<volatile unsigned long*>(&value)), 0, 0));
+}
+
+inline void atomicStore(volatile unsigned long& value, unsigned long newValue)
+{
+    _InterlockedExchange(reinterpret_cast<volatile long*>(&value), static_cast<long>(newValue));
+}
+
+inline unsigned long atomicExchange(volatile unsigned long& value, unsigned long newValue)
+{
+    return static_cast<unsigned long>(_InterlockedExchange(reinterpret_cast<volatile long*>(&value), static_cast<long>(newValue)));
+}
+
+inline bool atomicCompareExchange(volatile unsigned long& value, unsigned long& expected, unsigned long desired)
+{
+    unsigned long previous = static_cast<unsigned long>(_InterlockedCompareExchange(reinterpret_cast<volatile long*>(&value), static_cast<long>(desired), static_cast<long>(expected)));
+    if (previous == expected)
+        return true;
+
+    expected = previous;
+    return false;
+}
+
+inline unsigned long atomicFetchAdd(volatile unsigned long& value, unsigned long increment)
+{
+    return static_cast<unsigned long>(_InterlockedExchangeAdd(reinterpret_cast<volatile long*>(&value), static_cast<long>(increment)));
+}
+
+inline Uint64 atomicLoadRelaxed(const volatile Uint64& value)
+{
+#if defined(_M_X64)
+    return value;
+#else
+    // 32-bit targets can't read 64-bit values at once
+    return static_cast<Uint64>(_InterlockedCompareExchange64(reinterpret_cast<volatile __int64*>(const_cast<volatile Uint64*>(&value)), 0, 0));
+#endif
+}
+
+inline void atomicStoreRelaxed(volatile Uint64& value, Uint64 newValue)
+{
+    Uint64 expected = atomicLoadRelaxed(value);
+    for (;;)
+    {
+        Uint64 previous = static_cast<Uint64>(_InterlockedCompareExchange64(reinterpret_cast<volatile __int64*>(&value), static_cast<__int64>(newValue), static_cast<__int64>(expected)));
+        if (previous == expected)
+            return;
+
+        expected = previous;
+    }
+}
+
+inline void atomicAddRelaxed(volatile Uint64& value, Uint64 increment)
+{
+    Uint64 expected = atomicLoadRelaxed(value);
+    for (;;)
+    {
+        Uint64 previous = static_cast<Uint64>(_InterlockedCompareExchange64(reinterpret_cast<volatile __int64*>(&value), static_cast<__int64>(expected + increment), static_cast<__int64>(expected)));
+        if (previous == expected)
+            return;
+
+        expected = previous;
+    }
+}
+
+inline void* atomicLoadPointer(void* const volatile& pointer)
+{
+    return _InterlockedCompareExchangePointer(const_cast<void* volatile*>(&pointer), NULL, NULL);
+}
+
+inline void atomicStorePointer(void* volatile& pointer, void* newValue)
+{
+    _InterlockedExchangePointer(&pointer, newValue);
+}
+
+#else
+
+inline unsigned long atomicLoad(const volatile unsigned long& value)
+{
+    return __atomic_load_n(&value, __ATOMIC_ACQUIRE);
+}
+
+inline void atomicStore(volatile unsigned long& value, unsigned long newValue)
+{
+    __atomic_store_n(&value, newValue, __ATOMIC_RELEASE);
+}
+
+inline unsigned long atomicExchange(volatile unsigned long& value, unsigned long newValue)
+{
+    return __atomic_exchange_n(&value, newValue, __ATOMIC_SEQ_CST);
+}
+
+inline bool atomicCompareExchange(volatile unsigned long& value, unsigned long& expected, unsigned long desired)
+{
+    return __atomic_compare_exchange_n(&value, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+inline unsigned long atomicFetchAdd(volatile unsigned long& value, unsigned long increment)
+{
+    return __atomic_fetch_add(&value, increment, __ATOMIC_SEQ_CST);
+}
+
+inline Uint64 atomicLoadRelaxed(const volatile Uint64& value)
+{
+    return __atomic_load_n(&value, __ATOMIC_RELAXED);
+}
+
+inline void atomicStoreRelaxed(volatile Uint64& value, Uint64 newValue)
+{
+    __atomic_store_n(&value, newValue, __ATOMIC_RELAXED);
+}
+
+inline void atomicAddRelaxed(volatile Uint64& value, Uint64 increment)
+{
+    __atomic_fetch_add(&value, increment, __ATOMIC_RELAXED);
+}
+
+inline void* atomicLoadPointer(void* const volatile& pointer)
+{
+    return __atomic_load_n(&pointer, __ATOMIC_ACQUIRE);
+}
+
+inline void atomicStorePointer(void* volatile& pointer, void* newValue)
+{
+    __atomic_store_n(&pointer, newValue, __ATOMIC_RELEASE);
+}
+
+#endif
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_ATOMIC_HPP
@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/FastClock.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Sleep.hpp>
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <SFML/System/Win32/ClockImpl.hpp>
+#else
+    #include <SFML/System/Unix/ClockImpl.hpp>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    #include <intrin.h>
+    #define SFML_FASTCLOCK_TSC
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    #include <x86intrin.h>
+    #define SFML_FASTCLOCK_TSC
+#endif
+
+
+namespace
+{
+#ifdef SFML_FASTCLOCK_TSC
+
+    // Calibration of the time stamp counter against the system clock
+    sf::Mutex  mutex;
+    bool       calibrated     = false;
+    sf::Uint64 referenceTicks = 0;
+    sf::Int64  referenceTime  = 0;
+    double     period         = 1.0; // Nanoseconds per tick
+
+    // Read the counter and the system clock at the same time
+    void sample(sf::Uint64& ticks, sf::Int64& time)
+    {
+        // Reading the counter on both sides of the clock bounds the error
+        sf::Uint64 before = __rdtsc();
+        time = sf::priv::ClockImpl::getCurrentTime().asNanoseconds();
+        sf::Uint64 after = __rdtsc();
+
+        ticks = before + (after - before) / 2;
+    }
+
+    // Measure the period of the counter
+    // The mutex must be locked
+    void update()
+    {
+        if (!calibrated)
+        {
+            sample(referenceTicks, referenceTime);
+            sf::sleep(sf::milliseconds(10));
+            calibrated = true;
+        }
+
+        sf::Uint64 ticks;
+        sf::Int64 time;
+        sample(ticks, time);
+
+        if (ticks > referenceTicks)
+            period = static_cast<double>(time - referenceTime) / static_cast<double>(ticks - referenceTicks);
+    }
+
+#endif
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+Uint64 FastClock::getTicks()
+{
+#ifdef SFML_FASTCLOCK_TSC
+    return __rdtsc();
+#else
+    return static_cast<Uint64>(ClockImpl::getCurrentTime().asNanoseconds());
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void FastClock::calibrate()
+{
+#ifdef SFML_FASTCLOCK_TSC
+    Lock lock(mutex);
+    update();
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+Time FastClock::toTime(Uint64 ticks)
+{
+#ifdef SFML_FASTCLOCK_TSC
+
+    Lock lock(mutex);
+    if (!calibrated)
+        update();
+
+    // The ticks may precede the reference
+    if (ticks >= referenceTicks)
+        return nanoseconds(referenceTime + static_cast<Int64>(static_cast<double>(ticks - referenceTicks) * period));
+    else
+        return nanoseconds(referenceTime - static_cast<Int64>(static_cast<double>(referenceTicks - ticks) * period));
+
+#else
+
+    return nanoseconds(static_cast<Int64>(ticks));
+
+#endif
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_FASTCLOCK_HPP
+#define SFML_FASTCLOCK_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Cheap timestamps for profiling, read from the time
+///        stamp counter of the processor when it has one
+///
+/// On x86 processors, getTicks reads the time stamp counter:
+/// it is a single instruction, without system call, and its
+/// frequency is measured against the system clock when the
+/// ticks are converted to times. Modern processors have an
+/// invariant counter, synchronized between the cores, which
+/// runs at a constant rate whatever their power state. On other
+/// processors the ticks are nanoseconds of the system clock.
+///
+////////////////////////////////////////////////////////////
+class FastClock
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current value of the counter
+    ///
+    /// \return Current number of ticks
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getTicks();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Measure the frequency of the counter again
+    ///
+    /// The frequency is measured from the first conversion (or
+    /// calibration) to now, so it gets more accurate as the
+    /// program runs. The first call waits for 10 milliseconds.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void calibrate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert a value of the counter to a time
+    ///
+    /// The result is on the same timeline as the system clock
+    /// used by sf::Clock. The counter is calibrated first if
+    /// this was never done.
+    ///
+    /// \param ticks Value of the counter
+    ///
+    /// \return Time corresponding to \a ticks
+    ///
+    ////////////////////////////////////////////////////////////
+    static Time toTime(Uint64 ticks);
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_FASTCLOCK_HPP
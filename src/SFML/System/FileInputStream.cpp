@@ -28,7 +28,13 @@
 #include <SFML/System/FileInputStream.hpp>
 #ifdef ANDROID
 #include <SFML/System/Android/ResourceStream.hpp>
+#elif defined(SFML_SYSTEM_WINDOWS)
+#include <SFML/System/Win32/FileMappingImpl.hpp>
+#else
+#include <SFML/System/Unix/FileMappingImpl.hpp>
 #endif
+#include <algorithm>
+#include <cstring>
 
 
 namespace sf
@@ -36,6 +42,10 @@ namespace sf
 ////////////////////////////////////////////////////////////
 FileInputStream::FileInputStream()
 : m_file(NULL)
+#ifndef ANDROID
+, m_mapping(NULL)
+, m_position(0)
+#endif
 {
 
 }
@@ -50,6 +60,7 @@ FileInputStream::~FileInputStream()
 #else
     if (m_file)
         std::fclose(m_file);
+    delete m_mapping;
 #endif
 }
 
@@ -64,7 +75,16 @@ bool FileInputStream::open(const std::string& filename)
 #else
     if (m_file)
         std::fclose(m_file);
+    m_file = NULL;
+
+    // Map the file in memory if possible, the system then reads it lazily
+    if (!m_mapping)
+        m_mapping = new priv::FileMappingImpl;
+    m_position = 0;
+    if (m_mapping->open(filename))
+        return true;
 
+    // Fall back to stdio for files that can't be mapped
     m_file = std::fopen(filename.c_str(), "rb");
 
     return m_file != NULL;
@@ -78,7 +98,21 @@ Int64 FileInputStream::read(void* data, Int64 size)
 #ifdef ANDROID
     return m_file->read(data, size);
 #else
-    if (m_file)
+    if (m_mapping && m_mapping->getData())
+    {
+        Int64 count = std::min(size, static_cast<Int64>(m_mapping->getSize()) - m_position);
+        if (count > 0)
+        {
+            std::memcpy(data, static_cast<const char*>(m_mapping->getData()) + m_position, static_cast<std::size_t>(count));
+            m_position += count;
+            return count;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (m_file)
         return std::fread(data, 1, static_cast<std::size_t>(size), m_file);
     else
         return -1;
@@ -92,7 +126,12 @@ Int64 FileInputStream::seek(Int64 position)
 #ifdef ANDROID
     return m_file->seek(position);
 #else
-    if (m_file)
+    if (m_mapping && m_mapping->getData())
+    {
+        m_position = std::min(std::max(position, static_cast<Int64>(0)), static_cast<Int64>(m_mapping->getSize()));
+        return m_position;
+    }
+    else if (m_file)
     {
         std::fseek(m_file, static_cast<std::size_t>(position), SEEK_SET);
         return tell();
@@ -111,7 +150,9 @@ Int64 FileInputStream::tell()
 #ifdef ANDROID
     return m_file->tell();
 #else
-    if (m_file)
+    if (m_mapping && m_mapping->getData())
+        return m_position;
+    else if (m_file)
         return std::ftell(m_file);
     else
         return -1;
@@ -125,7 +166,11 @@ Int64 FileInputStream::getSize()
 #ifdef ANDROID
     return m_file->getSize();
 #else
-    if (m_file)
+    if (m_mapping && m_mapping->getData())
+    {
+        return static_cast<Int64>(m_mapping->getSize());
+    }
+    else if (m_file)
     {
         sf::Int64 position = tell();
         std::fseek(m_file, 0, SEEK_END);
@@ -140,4 +185,15 @@ Int64 FileInputStream::getSize()
 #endif
 }
 
+
+////////////////////////////////////////////////////////////
+const void* FileInputStream::getData() const
+{
+#ifdef ANDROID
+    return NULL;
+#else
+    return m_mapping ? m_mapping->getData() : NULL;
+#endif
+}
+
 } // namespace sf
@@ -0,0 +1,249 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_LOCKFREEQUEUE_HPP
+#define SFML_LOCKFREEQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Atomic.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Round a queue capacity up to a power of two
+///
+////////////////////////////////////////////////////////////
+inline std::size_t getQueueCapacity(std::size_t capacity)
+{
+    std::size_t result = 2;
+    while (result < capacity)
+        result *= 2;
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Bounded lock-free queue with a single producer
+///        thread and a single consumer thread
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class SpscQueue : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the queue
+    ///
+    /// \param capacity Maximum number of elements (rounded up to a power of two)
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SpscQueue(std::size_t capacity) :
+    m_elements(getQueueCapacity(capacity)),
+    m_mask    (m_elements.size() - 1),
+    m_head    (0),
+    m_tail    (0)
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an element at the end of the queue (producer thread only)
+    ///
+    /// \param element Element to add
+    ///
+    /// \return False if the queue is full
+    ///
+    ////////////////////////////////////////////////////////////
+    bool push(const T& element)
+    {
+        unsigned long tail = m_tail;
+        if (tail - atomicLoad(m_head) > m_mask)
+            return false;
+
+        m_elements[tail & m_mask] = element;
+        atomicStore(m_tail, tail + 1);
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove the first element of the queue (consumer thread only)
+    ///
+    /// \param element The removed element will be written here
+    ///
+    /// \return False if the queue is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pop(T& element)
+    {
+        unsigned long head = m_head;
+        if (head == atomicLoad(m_tail))
+            return false;
+
+        element = m_elements[head & m_mask];
+        atomicStore(m_head, head + 1);
+
+        return true;
+    }
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<T>         m_elements;     ///< Circular buffer of elements
+    unsigned long          m_mask;         ///< Capacity - 1, to wrap the positions
+    char                   m_padding1[64]; ///< Keeps the positions on separate cache lines
+    volatile unsigned long m_head;         ///< Position of the next element to pop, written by the consumer
+    char                   m_padding2[64]; ///< Keeps the positions on separate cache lines
+    volatile unsigned long m_tail;         ///< Position of the next element to push, written by the producer
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Bounded lock-free queue with any number of
+///        producer threads and a single consumer thread
+///
+/// Each slot carries a sequence number that tells whether
+/// it is free or filled for a given round, so that producers
+/// only compete on the reservation of a position.
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class MpscQueue : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the queue
+    ///
+    /// \param capacity Maximum number of elements (rounded up to a power of two)
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit MpscQueue(std::size_t capacity) :
+    m_slots   (getQueueCapacity(capacity)),
+    m_mask    (m_slots.size() - 1),
+    m_head    (0),
+    m_tail    (0)
+    {
+        for (std::size_t i = 0; i < m_slots.size(); ++i)
+            m_slots[i].sequence = i;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an element at the end of the queue (any thread)
+    ///
+    /// \param element Element to add
+    ///
+    /// \return False if the queue is full
+    ///
+    ////////////////////////////////////////////////////////////
+    bool push(const T& element)
+    {
+        unsigned long tail = atomicLoad(m_tail);
+        for (;;)
+        {
+            Slot& slot = m_slots[tail & m_mask];
+            long difference = static_cast<long>(atomicLoad(slot.sequence) - tail);
+
+            if (difference == 0)
+            {
+                // The slot is free for this round: try to reserve it
+                if (atomicCompareExchange(m_tail, tail, tail + 1))
+                {
+                    slot.element = element;
+                    atomicStore(slot.sequence, tail + 1);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                // The slot still holds the element of the previous round
+                return false;
+            }
+            else
+            {
+                // Another producer took this position
+                tail = atomicLoad(m_tail);
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove the first element of the queue (consumer thread only)
+    ///
+    /// \param element The removed element will be written here
+    ///
+    /// \return False if the queue is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pop(T& element)
+    {
+        Slot& slot = m_slots[m_head & m_mask];
+        if (atomicLoad(slot.sequence) != m_head + 1)
+            return false;
+
+        element = slot.element;
+        atomicStore(slot.sequence, m_head + m_mask + 1);
+        ++m_head;
+
+        return true;
+    }
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Element of the queue, with its sequence number
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Slot
+    {
+        volatile unsigned long sequence; ///< Position + 1 when filled, position when free
+        T                      element;  ///< Element stored in the slot
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Slot>      m_slots;        ///< Circular buffer of slots
+    unsigned long          m_mask;         ///< Capacity - 1, to wrap the positions
+    char                   m_padding1[64]; ///< Keeps the positions on separate cache lines
+    unsigned long          m_head;         ///< Position of the next element to pop, only used by the consumer
+    char                   m_padding2[64]; ///< Keeps the positions on separate cache lines
+    volatile unsigned long m_tail;         ///< Position of the next element to push, shared by the producers
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_LOCKFREEQUEUE_HPP
@@ -98,4 +98,11 @@ Int64 MemoryInputStream::getSize()
     return m_size;
 }
 
+
+////////////////////////////////////////////////////////////
+const void* MemoryInputStream::getData() const
+{
+    return m_data;
+}
+
 } // namespace sf
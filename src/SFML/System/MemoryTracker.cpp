@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/MemoryTracker.hpp>
+#include <SFML/System/Atomic.hpp>
+
+
+namespace
+{
+    // Counters of each category, updated atomically by all threads
+    volatile sf::Uint64 categoryBytes[sf::MemoryTracker::CategoryCount];
+    volatile sf::Uint64 categoryBuffers[sf::MemoryTracker::CategoryCount];
+
+    // Move a counter from an amount to another
+    void report(sf::MemoryTracker::Category category, sf::Uint64 previous, sf::Uint64 current)
+    {
+        // Unsigned additions wrap around, which subtracts when the amount decreases
+        sf::priv::atomicAddRelaxed(categoryBytes[category], current - previous);
+        if ((previous == 0) != (current == 0))
+            sf::priv::atomicAddRelaxed(categoryBuffers[category], current ? 1 : static_cast<sf::Uint64>(-1));
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+MemoryTracker::Usage::Usage() :
+bytes  (0),
+buffers(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+MemoryTracker::Counter::Counter(Category category) :
+m_category(category),
+m_bytes   (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+MemoryTracker::Counter::Counter(const Counter& copy) :
+m_category(copy.m_category),
+m_bytes   (0)
+{
+    setBytes(copy.m_bytes);
+}
+
+
+////////////////////////////////////////////////////////////
+MemoryTracker::Counter::~Counter()
+{
+    setBytes(0);
+}
+
+
+////////////////////////////////////////////////////////////
+MemoryTracker::Counter& MemoryTracker::Counter::operator =(const Counter& right)
+{
+    setBytes(right.m_bytes);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void MemoryTracker::Counter::setBytes(Uint64 bytes)
+{
+    if (bytes != m_bytes)
+    {
+        report(m_category, m_bytes, bytes);
+        m_bytes = bytes;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+MemoryTracker::Usage MemoryTracker::getUsage(Category category)
+{
+    Usage usage;
+    usage.bytes = priv::atomicLoadRelaxed(categoryBytes[category]);
+    usage.buffers = priv::atomicLoadRelaxed(categoryBuffers[category]);
+
+    return usage;
+}
+
+
+////////////////////////////////////////////////////////////
+MemoryTracker::Usage MemoryTracker::getTotalUsage()
+{
+    Usage total;
+    for (int i = 0; i < CategoryCount; ++i)
+    {
+        Usage usage = getUsage(static_cast<Category>(i));
+        total.bytes += usage.bytes;
+        total.buffers += usage.buffers;
+    }
+
+    return total;
+}
+
+} // namespace sf
@@ -39,7 +39,14 @@ namespace sf
 ////////////////////////////////////////////////////////////
 Mutex::Mutex()
 {
-    m_mutexImpl = new priv::MutexImpl;
+    m_mutexImpl = new priv::MutexImpl(true);
+}
+
+
+////////////////////////////////////////////////////////////
+Mutex::Mutex(bool recursive)
+{
+    m_mutexImpl = new priv::MutexImpl(recursive);
 }
 
 
@@ -0,0 +1,262 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Profiler.hpp>
+#include <SFML/System/Atomic.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/FastClock.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/ThreadLocalPtr.hpp>
+#include <fstream>
+#include <iomanip>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+    // A recorded zone, timed with the ticks of the fast clock
+    struct Event
+    {
+        const char* name;
+        sf::Uint64  start;
+        sf::Uint64  duration;
+    };
+
+    // Events are stored in chunks; the thread that owns the chunk publishes
+    // each event by incrementing the count, and links a new chunk when full
+    const unsigned long chunkCapacity = 1024;
+    struct Chunk
+    {
+        Chunk() : count(0), next(NULL) {}
+
+        Event                  events[chunkCapacity];
+        volatile unsigned long count;
+        void* volatile         next;
+    };
+
+    // Events of a thread: the thread writes to the tail, readers
+    // (serialized by the mutex) consume from the head
+    struct ThreadBuffer
+    {
+        unsigned int  id;
+        Chunk*        head;
+        unsigned long read;
+        Chunk*        tail;
+    };
+
+    sf::Mutex                        mutex;
+    std::vector<ThreadBuffer*>       buffers;
+    sf::ThreadLocalPtr<ThreadBuffer> currentBuffer;
+    volatile unsigned long           enabled = 1;
+
+    // Append an event to the buffer of the calling thread, without locking
+    // except the first time the thread records something
+    void record(const char* name, sf::Uint64 start, sf::Uint64 duration)
+    {
+        ThreadBuffer* buffer = currentBuffer;
+        if (!buffer)
+        {
+            buffer = new ThreadBuffer;
+            buffer->head = new Chunk;
+            buffer->read = 0;
+            buffer->tail = buffer->head;
+
+            sf::Lock lock(mutex);
+            buffer->id = static_cast<unsigned int>(buffers.size() + 1);
+            buffers.push_back(buffer);
+            currentBuffer = buffer;
+        }
+
+        Chunk* chunk = buffer->tail;
+        unsigned long count = chunk->count;
+        if (count == chunkCapacity)
+        {
+            Chunk* next = new Chunk;
+            sf::priv::atomicStorePointer(chunk->next, next);
+            buffer->tail = chunk = next;
+            count = 0;
+        }
+
+        Event& event = chunk->events[count];
+        event.name = name;
+        event.start = start;
+        event.duration = duration;
+        sf::priv::atomicStore(chunk->count, count + 1);
+    }
+
+    // Consume the events published so far by all threads
+    // The mutex must be locked
+    void consume(std::vector<std::pair<unsigned int, Event> >* events)
+    {
+        for (std::vector<ThreadBuffer*>::iterator it = buffers.begin(); it != buffers.end(); ++it)
+        {
+            ThreadBuffer& buffer = **it;
+            for (;;)
+            {
+                // Once the next chunk is linked, the current one is full and the thread never touches it again
+                Chunk* chunk = buffer.head;
+                Chunk* next = static_cast<Chunk*>(sf::priv::atomicLoadPointer(chunk->next));
+                unsigned long count = sf::priv::atomicLoad(chunk->count);
+
+                if (events)
+                {
+                    for (unsigned long i = buffer.read; i < count; ++i)
+                        events->push_back(std::make_pair(buffer.id, chunk->events[i]));
+                }
+                buffer.read = count;
+
+                if (!next)
+                    break;
+
+                buffer.head = next;
+                buffer.read = 0;
+                delete chunk;
+            }
+        }
+    }
+
+    // Write a string to a JSON document
+    void writeString(std::ostream& stream, const char* string)
+    {
+        stream << '"';
+        for (; *string; ++string)
+        {
+            if ((*string == '"') || (*string == '\\'))
+                stream << '\\';
+            stream << *string;
+        }
+        stream << '"';
+    }
+
+    // Write a number of nanoseconds as fractional microseconds, the unit of the trace format
+    void writeMicroseconds(std::ostream& stream, sf::Int64 nanoseconds)
+    {
+        if (nanoseconds < 0)
+        {
+            stream << '-';
+            nanoseconds = -nanoseconds;
+        }
+
+        stream << nanoseconds / 1000 << '.' << std::setw(3) << std::setfill('0') << nanoseconds % 1000;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Profiler::Zone::Zone(const char* name) :
+m_name (NULL),
+m_start(0)
+{
+    if (priv::atomicLoad(enabled))
+    {
+        m_name = name;
+        m_start = priv::FastClock::getTicks();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Profiler::Zone::~Zone()
+{
+    if (m_name)
+        record(m_name, m_start, priv::FastClock::getTicks() - m_start);
+}
+
+
+////////////////////////////////////////////////////////////
+void Profiler::setEnabled(bool enable)
+{
+    priv::atomicStore(enabled, enable ? 1 : 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Profiler::isEnabled()
+{
+    return priv::atomicLoad(enabled) != 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Profiler::saveToFile(const std::string& filename)
+{
+    std::vector<std::pair<unsigned int, Event> > events;
+    {
+        Lock lock(mutex);
+        consume(&events);
+    }
+
+    // The longer the program ran, the more accurate the conversion of the ticks
+    priv::FastClock::calibrate();
+
+    std::ofstream file(filename.c_str(), std::ios_base::binary);
+    if (!file)
+    {
+        err() << "Failed to save profiling trace \"" << filename << "\" (couldn't open file)" << std::endl;
+        return false;
+    }
+
+    // Write the events in the trace event format, as complete ("X") events
+    file << "{\"traceEvents\":[";
+    for (std::size_t i = 0; i < events.size(); ++i)
+    {
+        const Event& event = events[i].second;
+        Int64 start = priv::FastClock::toTime(event.start).asNanoseconds();
+        Int64 end = priv::FastClock::toTime(event.start + event.duration).asNanoseconds();
+
+        file << (i > 0 ? ",\n" : "\n") << "{\"name\":";
+        writeString(file, event.name);
+        file << ",\"ph\":\"X\",\"ts\":";
+        writeMicroseconds(file, start);
+        file << ",\"dur\":";
+        writeMicroseconds(file, end - start);
+        file << ",\"pid\":1,\"tid\":" << events[i].first << "}";
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    if (!file)
+    {
+        err() << "Failed to save profiling trace \"" << filename << "\" (couldn't write file)" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Profiler::clear()
+{
+    Lock lock(mutex);
+    consume(NULL);
+}
+
+} // namespace sf
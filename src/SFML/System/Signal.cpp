@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Signal.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Lock.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Signal::Signal() :
+m_mutex    (),
+m_condition(),
+m_set      (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Signal::notify()
+{
+    Lock lock(m_mutex);
+
+    if (!m_set)
+    {
+        m_set = true;
+        m_condition.notifyOne();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Signal::wait()
+{
+    Lock lock(m_mutex);
+
+    while (!m_set)
+        m_condition.wait(m_mutex);
+
+    m_set = false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Signal::wait(Time timeout)
+{
+    Lock lock(m_mutex);
+
+    // Spurious wake-ups must not restart the whole timeout
+    Clock clock;
+    while (!m_set)
+    {
+        Time remaining = timeout - clock.getElapsedTime();
+        if ((remaining <= Time::Zero) || !m_condition.wait(m_mutex, remaining))
+            break;
+    }
+
+    if (!m_set)
+        return false;
+
+    m_set = false;
+
+    return true;
+}
+
+} // namespace sf
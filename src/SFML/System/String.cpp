@@ -177,12 +177,20 @@ std::wstring String::toWideString() const
 ////////////////////////////////////////////////////////////
 std::basic_string<Uint8> String::toUtf8() const
 {
-    // Prepare the output string
     std::basic_string<Uint8> output;
-    output.reserve(m_string.length());
-
-    // Convert
-    Utf32::toUtf8(m_string.begin(), m_string.end(), std::back_inserter(output));
+    if (m_string.empty())
+        return output;
+
+    // Size the output for the encoded characters, so that the bulk converter can write in place
+    std::size_t size = 0;
+    for (std::basic_string<Uint32>::const_iterator it = m_string.begin(); it != m_string.end(); ++it)
+        size += (*it < 0x80) ? 1 : (*it < 0x800) ? 2 : (*it < 0x10000) ? 3 : 4;
+
+    // Convert; invalid characters are skipped, so the result may be shorter
+    output.resize(size);
+    const Uint32* data = m_string.data();
+    Uint8* end = Utf32::toUtf8(data, data + m_string.size(), &output[0]);
+    output.resize(end - &output[0]);
 
     return output;
 }
@@ -0,0 +1,485 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/ThreadPool.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <deque>
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <SFML/System/Win32/ThreadImpl.hpp>
+#else
+    #include <SFML/System/Unix/ThreadImpl.hpp>
+#endif
+
+
+namespace
+{
+    // The shared pool is never destroyed, tasks may still be
+    // pushed to it by static objects at exit
+    sf::Mutex       defaultPoolMutex;
+    sf::ThreadPool* defaultPool = NULL;
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+struct TaskState
+{
+    TaskState(ThreadFunc* taskFunction, ThreadPool* taskPool) :
+    function  (taskFunction),
+    pool      (taskPool),
+    references(2),
+    done      (false)
+    {
+    }
+
+    ThreadFunc*             function;      ///< Function to run, deleted once it has run
+    ThreadPool*             pool;          ///< Pool the task belongs to
+    FastMutex               mutex;         ///< Protects the members below
+    unsigned int            references;    ///< Handles and queues referring to the task
+    bool                    done;          ///< Has the function finished running?
+    std::vector<TaskState*> continuations; ///< Tasks to schedule once this one is done
+};
+
+} // namespace priv
+} // namespace sf
+
+
+namespace
+{
+    // A task is referenced by its handles and by the queue it waits in
+    // (either a worker's queue or the continuation list of its parent)
+    void addReference(sf::priv::TaskState* state)
+    {
+        sf::Lock lock(state->mutex);
+        ++state->references;
+    }
+
+    void removeReference(sf::priv::TaskState* state)
+    {
+        bool last;
+        {
+            sf::Lock lock(state->mutex);
+            last = (--state->references == 0);
+        }
+
+        if (last)
+        {
+            delete state->function;
+            delete state;
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct ThreadPool::Worker
+{
+    Worker(ThreadPool* workerPool, std::size_t workerIndex) :
+    pool  (workerPool),
+    index (workerIndex),
+    thread(NULL)
+    {
+    }
+
+    ThreadPool*                  pool;   ///< Pool owning the worker
+    std::size_t                  index;  ///< Index of the worker in the pool
+    Thread*                      thread; ///< Thread running the worker
+    FastMutex                    mutex;  ///< Protects the queue
+    std::deque<priv::TaskState*> tasks;  ///< Tasks waiting to be run
+};
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::Task::Task() :
+m_state(NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::Task::Task(const Task& copy) :
+m_state(copy.m_state)
+{
+    if (m_state)
+        addReference(m_state);
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::Task::Task(priv::TaskState* state) :
+m_state(state)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::Task::~Task()
+{
+    if (m_state)
+        removeReference(m_state);
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::Task& ThreadPool::Task::operator =(const Task& right)
+{
+    if (right.m_state)
+        addReference(right.m_state);
+
+    if (m_state)
+        removeReference(m_state);
+
+    m_state = right.m_state;
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ThreadPool::Task::isValid() const
+{
+    return m_state != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ThreadPool::Task::isDone() const
+{
+    if (!m_state)
+        return true;
+
+    Lock lock(m_state->mutex);
+    return m_state->done;
+}
+
+
+////////////////////////////////////////////////////////////
+void ThreadPool::Task::wait() const
+{
+    if (!m_state)
+        return;
+
+    // Help the pool instead of blocking, so that waiting from a
+    // task can't starve the workers
+    ThreadPool* pool = m_state->pool;
+    for (;;)
+    {
+        std::size_t epoch = pool->getEpoch();
+
+        if (isDone())
+            return;
+
+        if (!pool->runPendingTask(NULL))
+            pool->waitForActivity(epoch);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::Task ThreadPool::Task::thenFunction(priv::ThreadFunc* function) const
+{
+    if (!m_state)
+    {
+        delete function;
+        return Task();
+    }
+
+    priv::TaskState* continuation = new priv::TaskState(function, m_state->pool);
+
+    {
+        Lock lock(m_state->mutex);
+        if (!m_state->done)
+        {
+            m_state->continuations.push_back(continuation);
+            return Task(continuation);
+        }
+    }
+
+    // The parent has already finished, the continuation can run right away
+    m_state->pool->schedule(continuation);
+
+    return Task(continuation);
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::ThreadPool(unsigned int threadCount) :
+m_nextWorker(0),
+m_pending   (0),
+m_epoch     (0),
+m_waiters   (0),
+m_running   (true),
+m_mutex     (),
+m_activity  ()
+{
+    if (threadCount == 0)
+        threadCount = getCoreCount();
+
+    // Create all the queues before starting any thread, workers steal from each other
+    for (unsigned int i = 0; i < threadCount; ++i)
+        m_workers.push_back(new Worker(this, i));
+
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        (*it)->thread = new Thread(&ThreadPool::runWorker, *it);
+        (*it)->thread->launch();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::~ThreadPool()
+{
+    wait();
+
+    {
+        Lock lock(m_mutex);
+        m_running = false;
+        m_activity.notifyAll();
+    }
+
+    // Stop all the threads before destroying any queue, idle workers keep looking into each other's
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+        delete (*it)->thread;
+
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+void ThreadPool::wait()
+{
+    for (;;)
+    {
+        std::size_t epoch;
+        {
+            Lock lock(m_mutex);
+            if (m_pending == 0)
+                return;
+
+            epoch = m_epoch;
+        }
+
+        if (!runPendingTask(NULL))
+            waitForActivity(epoch);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int ThreadPool::getThreadCount() const
+{
+    return static_cast<unsigned int>(m_workers.size());
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool& ThreadPool::getDefault()
+{
+    Lock lock(defaultPoolMutex);
+
+    if (!defaultPool)
+        defaultPool = new ThreadPool;
+
+    return *defaultPool;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int ThreadPool::getCoreCount()
+{
+    return priv::ThreadImpl::getCoreCount();
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::Task ThreadPool::pushFunction(priv::ThreadFunc* function)
+{
+    priv::TaskState* state = new priv::TaskState(function, this);
+    schedule(state);
+
+    return Task(state);
+}
+
+
+////////////////////////////////////////////////////////////
+void ThreadPool::schedule(priv::TaskState* state)
+{
+    Worker* worker;
+    {
+        Lock lock(m_mutex);
+        ++m_pending;
+        worker = m_workers[m_nextWorker];
+        m_nextWorker = (m_nextWorker + 1) % m_workers.size();
+    }
+
+    {
+        Lock lock(worker->mutex);
+        worker->tasks.push_back(state);
+    }
+
+    // Wake up a sleeping worker only once the task can be found; the threads
+    // waiting for a task may leave without running it, so they can't take
+    // the only notification
+    Lock lock(m_mutex);
+    ++m_epoch;
+    if (m_waiters > 0)
+        m_activity.notifyAll();
+    else
+        m_activity.notifyOne();
+}
+
+
+////////////////////////////////////////////////////////////
+bool ThreadPool::runPendingTask(Worker* self)
+{
+    priv::TaskState* state = NULL;
+
+    // Newest task of our own queue first, its data is most likely still in cache
+    if (self)
+    {
+        Lock lock(self->mutex);
+        if (!self->tasks.empty())
+        {
+            state = self->tasks.back();
+            self->tasks.pop_back();
+        }
+    }
+
+    // Otherwise steal the oldest task of another worker
+    std::size_t start = self ? self->index + 1 : 0;
+    for (std::size_t i = 0; !state && (i < m_workers.size()); ++i)
+    {
+        Worker* victim = m_workers[(start + i) % m_workers.size()];
+        if (victim == self)
+            continue;
+
+        Lock lock(victim->mutex);
+        if (!victim->tasks.empty())
+        {
+            state = victim->tasks.front();
+            victim->tasks.pop_front();
+        }
+    }
+
+    if (!state)
+        return false;
+
+    state->function->run();
+    complete(state);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ThreadPool::complete(priv::TaskState* state)
+{
+    delete state->function;
+    state->function = NULL;
+
+    std::vector<priv::TaskState*> continuations;
+    {
+        Lock lock(state->mutex);
+        state->done = true;
+        continuations.swap(state->continuations);
+    }
+
+    // Continuations are scheduled before this task stops counting
+    // as pending, so that wait() never sees a gap between them
+    for (std::vector<priv::TaskState*>::iterator it = continuations.begin(); it != continuations.end(); ++it)
+        schedule(*it);
+
+    // Release the reference held by the queue
+    removeReference(state);
+
+    Lock lock(m_mutex);
+    --m_pending;
+    ++m_epoch;
+
+    // Idle workers don't care about finished tasks, only wake up the threads that wait for them
+    if (m_waiters > 0)
+        m_activity.notifyAll();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ThreadPool::getEpoch() const
+{
+    Lock lock(m_mutex);
+
+    return m_epoch;
+}
+
+
+////////////////////////////////////////////////////////////
+void ThreadPool::waitForActivity(std::size_t epoch)
+{
+    Lock lock(m_mutex);
+
+    ++m_waiters;
+    while (m_running && (m_epoch == epoch))
+        m_activity.wait(m_mutex);
+    --m_waiters;
+}
+
+
+////////////////////////////////////////////////////////////
+void ThreadPool::runWorker(Worker* worker)
+{
+    ThreadPool* pool = worker->pool;
+
+    for (;;)
+    {
+        std::size_t epoch;
+        {
+            Lock lock(pool->m_mutex);
+            if (!pool->m_running)
+                break;
+
+            epoch = pool->m_epoch;
+        }
+
+        // Sleep when there's nothing to run, the next scheduled task wakes us up
+        if (!pool->runPendingTask(worker))
+        {
+            Lock lock(pool->m_mutex);
+            while (pool->m_running && (pool->m_epoch == epoch))
+                pool->m_activity.wait(pool->m_mutex);
+        }
+    }
+}
+
+} // namespace sf
@@ -36,7 +36,7 @@ const Time Time::Zero;
 
 ////////////////////////////////////////////////////////////
 Time::Time() :
-m_microseconds(0)
+m_nanoseconds(0)
 {
 }
 
@@ -44,27 +44,34 @@ m_microseconds(0)
 ////////////////////////////////////////////////////////////
 float Time::asSeconds() const
 {
-    return m_microseconds / 1000000.f;
+    return static_cast<float>(m_nanoseconds / 1000000000.0);
 }
 
 
 ////////////////////////////////////////////////////////////
 Int32 Time::asMilliseconds() const
 {
-    return static_cast<Int32>(m_microseconds / 1000);
+    return static_cast<Int32>(m_nanoseconds / 1000000);
 }
 
 
 ////////////////////////////////////////////////////////////
 Int64 Time::asMicroseconds() const
 {
-    return m_microseconds;
+    return m_nanoseconds / 1000;
 }
 
 
 ////////////////////////////////////////////////////////////
-Time::Time(Int64 microseconds) :
-m_microseconds(microseconds)
+Int64 Time::asNanoseconds() const
+{
+    return m_nanoseconds;
+}
+
+
+////////////////////////////////////////////////////////////
+Time::Time(Int64 nanoseconds) :
+m_nanoseconds(nanoseconds)
 {
 }
 
@@ -72,19 +79,26 @@ m_microseconds(microseconds)
 ////////////////////////////////////////////////////////////
 Time seconds(float amount)
 {
-    return Time(static_cast<Int64>(amount * 1000000));
+    return Time(static_cast<Int64>(amount * 1000000000.0));
 }
 
 
 ////////////////////////////////////////////////////////////
 Time milliseconds(Int32 amount)
 {
-    return Time(static_cast<Int64>(amount) * 1000);
+    return Time(static_cast<Int64>(amount) * 1000000);
 }
 
 
 ////////////////////////////////////////////////////////////
 Time microseconds(Int64 amount)
+{
+    return Time(amount * 1000);
+}
+
+
+////////////////////////////////////////////////////////////
+Time nanoseconds(Int64 amount)
 {
     return Time(amount);
 }
@@ -93,56 +107,56 @@ Time microseconds(Int64 amount)
 ////////////////////////////////////////////////////////////
 bool operator ==(Time left, Time right)
 {
-    return left.asMicroseconds() == right.asMicroseconds();
+    return left.asNanoseconds() == right.asNanoseconds();
 }
 
 
 ////////////////////////////////////////////////////////////
 bool operator !=(Time left, Time right)
 {
-    return left.asMicroseconds() != right.asMicroseconds();
+    return left.asNanoseconds() != right.asNanoseconds();
 }
 
 
 ////////////////////////////////////////////////////////////
 bool operator <(Time left, Time right)
 {
-    return left.asMicroseconds() < right.asMicroseconds();
+    return left.asNanoseconds() < right.asNanoseconds();
 }
 
 
 ////////////////////////////////////////////////////////////
 bool operator >(Time left, Time right)
 {
-    return left.asMicroseconds() > right.asMicroseconds();
+    return left.asNanoseconds() > right.asNanoseconds();
 }
 
 
 ////////////////////////////////////////////////////////////
 bool operator <=(Time left, Time right)
 {
-    return left.asMicroseconds() <= right.asMicroseconds();
+    return left.asNanoseconds() <= right.asNanoseconds();
 }
 
 
 ////////////////////////////////////////////////////////////
 bool operator >=(Time left, Time right)
 {
-    return left.asMicroseconds() >= right.asMicroseconds();
+    return left.asNanoseconds() >= right.asNanoseconds();
 }
 
 
 ////////////////////////////////////////////////////////////
 Time operator -(Time right)
 {
-    return microseconds(-right.asMicroseconds());
+    return nanoseconds(-right.asNanoseconds());
 }
 
 
 ////////////////////////////////////////////////////////////
 Time operator +(Time left, Time right)
 {
-    return microseconds(left.asMicroseconds() + right.asMicroseconds());
+    return nanoseconds(left.asNanoseconds() + right.asNanoseconds());
 }
 
 
@@ -156,7 +170,7 @@ Time& operator +=(Time& left, Time right)
 ////////////////////////////////////////////////////////////
 Time operator -(Time left, Time right)
 {
-    return microseconds(left.asMicroseconds() - right.asMicroseconds());
+    return nanoseconds(left.asNanoseconds() - right.asNanoseconds());
 }
 
 
@@ -177,7 +191,7 @@ Time operator *(Time left, float right)
 ////////////////////////////////////////////////////////////
 Time operator *(Time left, Int64 right)
 {
-    return microseconds(left.asMicroseconds() * right);
+    return nanoseconds(left.asNanoseconds() * right);
 }
 
 
@@ -219,7 +233,7 @@ Time operator /(Time left, float right)
 ////////////////////////////////////////////////////////////
 Time operator /(Time left, Int64 right)
 {
-    return microseconds(left.asMicroseconds() / right);
+    return nanoseconds(left.asNanoseconds() / right);
 }
 
 
@@ -247,7 +261,7 @@ float operator /(Time left, Time right)
 ////////////////////////////////////////////////////////////
 Time operator %(Time left, Time right)
 {
-    return microseconds(left.asMicroseconds() % right.asMicroseconds());
+    return nanoseconds(left.asNanoseconds() % right.asNanoseconds());
 }
 
 
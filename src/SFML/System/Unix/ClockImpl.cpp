@@ -47,14 +47,14 @@ Time ClockImpl::getCurrentTime()
     if (frequency.denom == 0)
         mach_timebase_info(&frequency);
     Uint64 nanoseconds = mach_absolute_time() * frequency.numer / frequency.denom;
-    return sf::microseconds(nanoseconds / 1000);
+    return sf::nanoseconds(static_cast<Int64>(nanoseconds));
 
 #else
 
     // POSIX implementation
     timespec time;
     clock_gettime(CLOCK_MONOTONIC, &time);
-    return sf::microseconds(static_cast<Uint64>(time.tv_sec) * 1000000 + time.tv_nsec / 1000);
+    return sf::nanoseconds(static_cast<Int64>(time.tv_sec) * 1000000000 + time.tv_nsec);
 
 #endif
 }
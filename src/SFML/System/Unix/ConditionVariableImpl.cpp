@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Unix/ConditionVariableImpl.hpp>
+#include <SFML/System/Unix/MutexImpl.hpp>
+#include <sys/time.h>
+#include <errno.h>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+ConditionVariableImpl::ConditionVariableImpl()
+{
+    pthread_cond_init(&m_condition, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+ConditionVariableImpl::~ConditionVariableImpl()
+{
+    pthread_cond_destroy(&m_condition);
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariableImpl::wait(MutexImpl& mutex)
+{
+    pthread_cond_wait(&m_condition, &mutex.m_mutex);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ConditionVariableImpl::wait(MutexImpl& mutex, Time timeout)
+{
+    if (timeout < Time::Zero)
+        timeout = Time::Zero;
+
+    // pthread_cond_timedwait takes an absolute time on the real-time clock;
+    // gettimeofday is used because clock_gettime is missing on older OS X
+    timeval now;
+    gettimeofday(&now, NULL);
+
+    Int64 usecs = static_cast<Int64>(now.tv_usec) + timeout.asMicroseconds();
+
+    timespec deadline;
+    deadline.tv_sec = now.tv_sec + static_cast<time_t>(usecs / 1000000);
+    deadline.tv_nsec = static_cast<long>(usecs % 1000000) * 1000;
+
+    return pthread_cond_timedwait(&m_condition, &mutex.m_mutex, &deadline) != ETIMEDOUT;
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariableImpl::notifyOne()
+{
+    pthread_cond_signal(&m_condition);
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariableImpl::notifyAll()
+{
+    pthread_cond_broadcast(&m_condition);
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Unix/FileMappingImpl.hpp>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+FileMappingImpl::FileMappingImpl() :
+m_data(NULL),
+m_size(0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+FileMappingImpl::~FileMappingImpl()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool FileMappingImpl::open(const std::string& filename)
+{
+    close();
+
+    int file = ::open(filename.c_str(), O_RDONLY);
+    if (file < 0)
+        return false;
+
+    // Only regular files can be mapped, and mapping an empty file fails
+    struct stat status;
+    if ((fstat(file, &status) != 0) || !S_ISREG(status.st_mode) || (status.st_size <= 0))
+    {
+        ::close(file);
+        return false;
+    }
+
+    // The mapping remains valid after the file is closed
+    void* data = mmap(NULL, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED, file, 0);
+    ::close(file);
+    if (data == MAP_FAILED)
+        return false;
+
+    m_data = data;
+    m_size = static_cast<std::size_t>(status.st_size);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void FileMappingImpl::close()
+{
+    if (m_data)
+        munmap(m_data, m_size);
+
+    m_data = NULL;
+    m_size = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+const void* FileMappingImpl::getData() const
+{
+    return m_data;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t FileMappingImpl::getSize() const
+{
+    return m_size;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_FILEMAPPINGIMPL_HPP
+#define SFML_FILEMAPPINGIMPL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <string>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Unix implementation of read-only memory-mapped files
+////////////////////////////////////////////////////////////
+class FileMappingImpl : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    FileMappingImpl();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~FileMappingImpl();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Map a file in memory
+    ///
+    /// Empty files and files that are not regular files
+    /// can't be mapped.
+    ///
+    /// \param filename Path of the file to map
+    ///
+    /// \return True on success, false on error
+    ///
+    ////////////////////////////////////////////////////////////
+    bool open(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unmap the file
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the address of the mapped contents
+    ///
+    /// \return Pointer to the contents, or NULL if no file is mapped
+    ///
+    ////////////////////////////////////////////////////////////
+    const void* getData() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the mapped contents
+    ///
+    /// \return Size of the file, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    void*       m_data; ///< Address of the mapped region
+    std::size_t m_size; ///< Size of the mapped region
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_FILEMAPPINGIMPL_HPP
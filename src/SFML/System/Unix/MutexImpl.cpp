@@ -33,14 +33,28 @@ namespace sf
 namespace priv
 {
 ////////////////////////////////////////////////////////////
-MutexImpl::MutexImpl()
+MutexImpl::MutexImpl(bool recursive)
 {
-    // Make it recursive to follow the expected behavior
     pthread_mutexattr_t attributes;
     pthread_mutexattr_init(&attributes);
-    pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+
+    if (recursive)
+    {
+        // Make it recursive to follow the expected behavior
+        pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+    }
+    else
+    {
+#if defined(__GLIBC__) && defined(__USE_GNU)
+        // Spin for a short while before sleeping, locks are usually held briefly
+        pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_ADAPTIVE_NP);
+#else
+        pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_NORMAL);
+#endif
+    }
 
     pthread_mutex_init(&m_mutex, &attributes);
+    pthread_mutexattr_destroy(&attributes);
 }
 
 
@@ -46,8 +46,10 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
+    /// \param recursive True to allow the same thread to lock the mutex several times
+    ///
     ////////////////////////////////////////////////////////////
-    MutexImpl();
+    explicit MutexImpl(bool recursive);
 
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
@@ -69,6 +71,8 @@ public:
 
 private:
 
+    friend class ConditionVariableImpl;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
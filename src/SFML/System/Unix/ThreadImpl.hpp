@@ -66,6 +66,14 @@ public:
     ////////////////////////////////////////////////////////////
     void terminate();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of processor cores of the system
+    ///
+    /// \return Number of logical cores, at least 1
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getCoreCount();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -0,0 +1,178 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Utf.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_UTF_SSE2
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define SFML_UTF_NEON
+#endif
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Uint32* Utf<8>::toUtf32(const Uint8* begin, const Uint8* end, Uint32* output)
+{
+    while (begin < end)
+    {
+    #if defined(SFML_UTF_SSE2)
+
+        // Widen blocks of 16 ASCII characters, until one has its high bit set
+        const __m128i zero = _mm_setzero_si128();
+        while (end - begin >= 16)
+        {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+            if (_mm_movemask_epi8(bytes) != 0)
+                break;
+
+            __m128i low  = _mm_unpacklo_epi8(bytes, zero);
+            __m128i high = _mm_unpackhi_epi8(bytes, zero);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output +  0), _mm_unpacklo_epi16(low, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output +  4), _mm_unpackhi_epi16(low, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output +  8), _mm_unpacklo_epi16(high, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 12), _mm_unpackhi_epi16(high, zero));
+
+            begin += 16;
+            output += 16;
+        }
+
+    #elif defined(SFML_UTF_NEON)
+
+        // Widen blocks of 16 ASCII characters, until one has its high bit set
+        while (end - begin >= 16)
+        {
+            uint8x16_t bytes = vld1q_u8(begin);
+            uint32x2_t bits  = vreinterpret_u32_u8(vorr_u8(vget_low_u8(bytes), vget_high_u8(bytes)));
+            if ((vget_lane_u32(bits, 0) | vget_lane_u32(bits, 1)) & 0x80808080)
+                break;
+
+            uint16x8_t low  = vmovl_u8(vget_low_u8(bytes));
+            uint16x8_t high = vmovl_u8(vget_high_u8(bytes));
+            vst1q_u32(output +  0, vmovl_u16(vget_low_u16(low)));
+            vst1q_u32(output +  4, vmovl_u16(vget_high_u16(low)));
+            vst1q_u32(output +  8, vmovl_u16(vget_low_u16(high)));
+            vst1q_u32(output + 12, vmovl_u16(vget_high_u16(high)));
+
+            begin += 16;
+            output += 16;
+        }
+
+    #endif
+
+        if (begin >= end)
+            break;
+
+        // Tail of the buffer, or a multi-byte character
+        if (*begin < 0x80)
+            *output++ = *begin++;
+        else
+            begin = decode(begin, end, *output++);
+    }
+
+    return output;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32* Utf<8>::toUtf32(const char* begin, const char* end, Uint32* output)
+{
+    return toUtf32(reinterpret_cast<const Uint8*>(begin), reinterpret_cast<const Uint8*>(end), output);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint8* Utf<32>::toUtf8(const Uint32* begin, const Uint32* end, Uint8* output)
+{
+    while (begin < end)
+    {
+    #if defined(SFML_UTF_SSE2)
+
+        // Narrow blocks of 16 ASCII characters, until one doesn't fit in 7 bits
+        const __m128i zero     = _mm_setzero_si128();
+        const __m128i highBits = _mm_set1_epi32(~0x7F);
+        while (end - begin >= 16)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin +  0));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin +  4));
+            __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin +  8));
+            __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + 12));
+
+            __m128i any = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), highBits);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(any, zero)) != 0xFFFF)
+                break;
+
+            // The values are below 128, the signed saturations never kick in
+            __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output), bytes);
+
+            begin += 16;
+            output += 16;
+        }
+
+    #elif defined(SFML_UTF_NEON)
+
+        // Narrow blocks of 16 ASCII characters, until one doesn't fit in 7 bits
+        while (end - begin >= 16)
+        {
+            uint32x4_t a = vld1q_u32(begin +  0);
+            uint32x4_t b = vld1q_u32(begin +  4);
+            uint32x4_t c = vld1q_u32(begin +  8);
+            uint32x4_t d = vld1q_u32(begin + 12);
+
+            uint32x4_t any  = vshrq_n_u32(vorrq_u32(vorrq_u32(a, b), vorrq_u32(c, d)), 7);
+            uint32x2_t bits = vorr_u32(vget_low_u32(any), vget_high_u32(any));
+            if (vget_lane_u32(bits, 0) | vget_lane_u32(bits, 1))
+                break;
+
+            uint8x8_t low  = vmovn_u16(vcombine_u16(vmovn_u32(a), vmovn_u32(b)));
+            uint8x8_t high = vmovn_u16(vcombine_u16(vmovn_u32(c), vmovn_u32(d)));
+            vst1q_u8(output, vcombine_u8(low, high));
+
+            begin += 16;
+            output += 16;
+        }
+
+    #endif
+
+        if (begin >= end)
+            break;
+
+        // Tail of the buffer, or a multi-byte character
+        if (*begin < 0x80)
+            *output++ = static_cast<Uint8>(*begin++);
+        else
+            output = Utf<8>::encode(*begin++, output);
+    }
+
+    return output;
+}
+
+} // namespace sf
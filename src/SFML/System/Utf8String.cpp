@@ -0,0 +1,323 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Utf8String.hpp>
+#include <SFML/System/Utf.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Utf8String::Utf8String() :
+m_size       (0),
+m_length     (0),
+m_capacity   (LocalCapacity),
+m_cacheIndex (0),
+m_cacheOffset(0)
+{
+    m_local[0] = '\0';
+}
+
+
+////////////////////////////////////////////////////////////
+Utf8String::Utf8String(const char* utf8String) :
+m_size       (0),
+m_length     (0),
+m_capacity   (LocalCapacity),
+m_cacheIndex (0),
+m_cacheOffset(0)
+{
+    m_local[0] = '\0';
+
+    if (utf8String)
+        assign(utf8String, std::strlen(utf8String));
+}
+
+
+////////////////////////////////////////////////////////////
+Utf8String::Utf8String(const std::string& utf8String) :
+m_size       (0),
+m_length     (0),
+m_capacity   (LocalCapacity),
+m_cacheIndex (0),
+m_cacheOffset(0)
+{
+    m_local[0] = '\0';
+    assign(utf8String.data(), utf8String.size());
+}
+
+
+////////////////////////////////////////////////////////////
+Utf8String::Utf8String(const char* data, std::size_t size) :
+m_size       (0),
+m_length     (0),
+m_capacity   (LocalCapacity),
+m_cacheIndex (0),
+m_cacheOffset(0)
+{
+    m_local[0] = '\0';
+
+    if (data)
+        assign(data, size);
+}
+
+
+////////////////////////////////////////////////////////////
+Utf8String::Utf8String(const String& string) :
+m_size       (0),
+m_length     (0),
+m_capacity   (LocalCapacity),
+m_cacheIndex (0),
+m_cacheOffset(0)
+{
+    m_local[0] = '\0';
+
+    std::basic_string<Uint8> utf8 = string.toUtf8();
+    assign(reinterpret_cast<const char*>(utf8.data()), utf8.size());
+}
+
+
+////////////////////////////////////////////////////////////
+Utf8String::Utf8String(const Utf8String& copy) :
+m_size       (0),
+m_length     (0),
+m_capacity   (LocalCapacity),
+m_cacheIndex (0),
+m_cacheOffset(0)
+{
+    m_local[0] = '\0';
+    assign(copy.getData(), copy.m_size);
+}
+
+
+////////////////////////////////////////////////////////////
+Utf8String::~Utf8String()
+{
+    if (!isLocal())
+        delete[] m_heap;
+}
+
+
+////////////////////////////////////////////////////////////
+Utf8String& Utf8String::operator =(const Utf8String& right)
+{
+    if (this != &right)
+        assign(right.getData(), right.m_size);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Utf8String& Utf8String::operator +=(const Utf8String& right)
+{
+    // Read the size of the right operand first, it may be this string
+    Uint32 size = right.m_size;
+    Uint32 length = right.m_length;
+
+    reserve(m_size + size);
+
+    char* buffer = isLocal() ? m_local : m_heap;
+    std::memcpy(buffer + m_size, right.getData(), size);
+    buffer[m_size + size] = '\0';
+
+    m_size += size;
+    m_length += length;
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+String Utf8String::toString() const
+{
+    const char* data = getData();
+
+    return String::fromUtf8(data, data + m_size);
+}
+
+
+////////////////////////////////////////////////////////////
+std::string Utf8String::toStdString() const
+{
+    return std::string(getData(), m_size);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 Utf8String::operator [](std::size_t index) const
+{
+    const char* data = getData();
+
+    // Pure ASCII: one byte per character
+    if (m_length == m_size)
+        return static_cast<Uint8>(data[index]);
+
+    // Walk from the last accessed character, or from the start when going backward
+    if (index < m_cacheIndex)
+    {
+        m_cacheIndex = 0;
+        m_cacheOffset = 0;
+    }
+
+    const char* end = data + m_size;
+    const char* position = data + m_cacheOffset;
+    for (; m_cacheIndex < index; ++m_cacheIndex)
+        position = Utf8::next(position, end);
+
+    m_cacheOffset = static_cast<Uint32>(position - data);
+
+    Uint32 codePoint = 0;
+    Utf8::decode(position, end, codePoint);
+
+    return codePoint;
+}
+
+
+////////////////////////////////////////////////////////////
+void Utf8String::clear()
+{
+    char* buffer = isLocal() ? m_local : m_heap;
+    buffer[0] = '\0';
+
+    m_size = 0;
+    m_length = 0;
+    m_cacheIndex = 0;
+    m_cacheOffset = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Utf8String::getSize() const
+{
+    return m_length;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Utf8String::getByteSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Utf8String::isEmpty() const
+{
+    return m_size == 0;
+}
+
+
+////////////////////////////////////////////////////////////
+const char* Utf8String::getData() const
+{
+    return isLocal() ? m_local : m_heap;
+}
+
+
+////////////////////////////////////////////////////////////
+void Utf8String::assign(const char* data, std::size_t size)
+{
+    reserve(size);
+
+    char* buffer = isLocal() ? m_local : m_heap;
+    std::memcpy(buffer, data, size);
+    buffer[size] = '\0';
+
+    m_size = static_cast<Uint32>(size);
+    m_length = static_cast<Uint32>(Utf8::count(data, data + size));
+    m_cacheIndex = 0;
+    m_cacheOffset = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void Utf8String::reserve(std::size_t size)
+{
+    if (size <= m_capacity)
+        return;
+
+    // Grow geometrically, so that repeated appends stay linear
+    std::size_t capacity = std::max<std::size_t>(size, m_capacity * 2);
+
+    char* buffer = new char[capacity + 1];
+    std::memcpy(buffer, getData(), m_size + 1);
+
+    if (!isLocal())
+        delete[] m_heap;
+
+    m_heap = buffer;
+    m_capacity = static_cast<Uint32>(capacity);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Utf8String::isLocal() const
+{
+    // Heap buffers are always bigger than the local one
+    return m_capacity == LocalCapacity;
+}
+
+
+////////////////////////////////////////////////////////////
+bool operator ==(const Utf8String& left, const Utf8String& right)
+{
+    return (left.getByteSize() == right.getByteSize()) &&
+           (std::memcmp(left.getData(), right.getData(), left.getByteSize()) == 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool operator !=(const Utf8String& left, const Utf8String& right)
+{
+    return !(left == right);
+}
+
+
+////////////////////////////////////////////////////////////
+bool operator <(const Utf8String& left, const Utf8String& right)
+{
+    // memcmp compares unsigned bytes, which orders UTF-8 like the code points
+    std::size_t size = std::min(left.getByteSize(), right.getByteSize());
+    int result = std::memcmp(left.getData(), right.getData(), size);
+
+    return (result < 0) || ((result == 0) && (left.getByteSize() < right.getByteSize()));
+}
+
+
+////////////////////////////////////////////////////////////
+Utf8String operator +(const Utf8String& left, const Utf8String& right)
+{
+    Utf8String string = left;
+    string += right;
+
+    return string;
+}
+
+} // namespace sf
@@ -37,6 +37,12 @@ namespace
         QueryPerformanceFrequency(&frequency);
         return frequency;
     }
+
+    bool isWindowsXpOrOlder()
+    {
+        // Windows XP was the last 5.x version of Windows
+        return static_cast<DWORD>(LOBYTE(LOWORD(GetVersion()))) < 6;
+    }
 }
 
 namespace sf
@@ -46,24 +52,35 @@ namespace priv
 ////////////////////////////////////////////////////////////
 Time ClockImpl::getCurrentTime()
 {
-    // Force the following code to run on first core
-    // (see http://msdn.microsoft.com/en-us/library/windows/desktop/ms644904(v=vs.85).aspx)
-    HANDLE currentThread = GetCurrentThread();
-    DWORD_PTR previousMask = SetThreadAffinityMask(currentThread, 1);
-
     // Get the frequency of the performance counter
     // (it is constant across the program lifetime)
     static LARGE_INTEGER frequency = getFrequency();
 
+    // The performance counters of the cores of old systems may differ, so the
+    // following code must then run on the first core; Vista and later versions
+    // synchronize them, and changing the affinity would only slow every call down
+    // (see http://msdn.microsoft.com/en-us/library/windows/desktop/ms644904(v=vs.85).aspx)
+    static bool oldWindowsVersion = isWindowsXpOrOlder();
+
     // Get the current time
     LARGE_INTEGER time;
-    QueryPerformanceCounter(&time);
-
-    // Restore the thread affinity
-    SetThreadAffinityMask(currentThread, previousMask);
+    if (oldWindowsVersion)
+    {
+        HANDLE currentThread = GetCurrentThread();
+        DWORD_PTR previousMask = SetThreadAffinityMask(currentThread, 1);
+        QueryPerformanceCounter(&time);
+        SetThreadAffinityMask(currentThread, previousMask);
+    }
+    else
+    {
+        QueryPerformanceCounter(&time);
+    }
 
-    // Return the current time as microseconds
-    return sf::microseconds(1000000 * time.QuadPart / frequency.QuadPart);
+    // Return the current time as nanoseconds; the whole seconds are converted
+    // separately, so that the multiplication doesn't overflow
+    Int64 seconds = time.QuadPart / frequency.QuadPart;
+    Int64 remainder = time.QuadPart % frequency.QuadPart;
+    return sf::nanoseconds(seconds * 1000000000 + remainder * 1000000000 / frequency.QuadPart);
 }
 
 } // namespace priv
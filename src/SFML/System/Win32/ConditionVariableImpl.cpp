@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Win32/ConditionVariableImpl.hpp>
+#include <SFML/System/Win32/MutexImpl.hpp>
+#include <climits>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+ConditionVariableImpl::ConditionVariableImpl() :
+m_waiters(0),
+m_signals(0)
+{
+    // Native condition variables require Vista, build them from
+    // semaphores to keep supporting XP
+    InitializeCriticalSection(&m_lock);
+    m_wakeUp = CreateSemaphore(NULL, 0, LONG_MAX, NULL);
+    m_woken = CreateSemaphore(NULL, 0, LONG_MAX, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+ConditionVariableImpl::~ConditionVariableImpl()
+{
+    CloseHandle(m_woken);
+    CloseHandle(m_wakeUp);
+    DeleteCriticalSection(&m_lock);
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariableImpl::wait(MutexImpl& mutex)
+{
+    waitFor(mutex, INFINITE);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ConditionVariableImpl::wait(MutexImpl& mutex, Time timeout)
+{
+    DWORD milliseconds = timeout > Time::Zero ? static_cast<DWORD>(timeout.asMilliseconds()) : 0;
+
+    return waitFor(mutex, milliseconds);
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariableImpl::notifyOne()
+{
+    EnterCriticalSection(&m_lock);
+
+    if (m_waiters > m_signals)
+    {
+        m_signals++;
+        ReleaseSemaphore(m_wakeUp, 1, NULL);
+        LeaveCriticalSection(&m_lock);
+
+        // Wait for the woken thread, so that it can't miss its wake-up
+        WaitForSingleObject(m_woken, INFINITE);
+    }
+    else
+    {
+        LeaveCriticalSection(&m_lock);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariableImpl::notifyAll()
+{
+    EnterCriticalSection(&m_lock);
+
+    if (m_waiters > m_signals)
+    {
+        LONG count = m_waiters - m_signals;
+        m_signals = m_waiters;
+        ReleaseSemaphore(m_wakeUp, count, NULL);
+        LeaveCriticalSection(&m_lock);
+
+        for (LONG i = 0; i < count; ++i)
+            WaitForSingleObject(m_woken, INFINITE);
+    }
+    else
+    {
+        LeaveCriticalSection(&m_lock);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool ConditionVariableImpl::waitFor(MutexImpl& mutex, DWORD milliseconds)
+{
+    EnterCriticalSection(&m_lock);
+    m_waiters++;
+    LeaveCriticalSection(&m_lock);
+
+    mutex.unlock();
+
+    bool notified = WaitForSingleObject(m_wakeUp, milliseconds) == WAIT_OBJECT_0;
+
+    EnterCriticalSection(&m_lock);
+
+    // A notification may have been sent between the timeout and here,
+    // consume it so that the semaphore stays in sync with the counters
+    if (m_signals > 0)
+    {
+        if (!notified)
+            WaitForSingleObject(m_wakeUp, INFINITE);
+
+        ReleaseSemaphore(m_woken, 1, NULL);
+        m_signals--;
+        notified = true;
+    }
+
+    m_waiters--;
+
+    LeaveCriticalSection(&m_lock);
+
+    mutex.lock();
+
+    return notified;
+}
+
+} // namespace priv
+
+} // namespace sf
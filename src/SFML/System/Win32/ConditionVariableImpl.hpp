@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_CONDITIONVARIABLEIMPL_HPP
+#define SFML_CONDITIONVARIABLEIMPL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <windows.h>
+
+
+namespace sf
+{
+namespace priv
+{
+class MutexImpl;
+
+////////////////////////////////////////////////////////////
+/// \brief Windows implementation of condition variables
+////////////////////////////////////////////////////////////
+class ConditionVariableImpl : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ConditionVariableImpl();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ConditionVariableImpl();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the condition variable is notified
+    ///
+    /// \param mutex Locked mutex, released while waiting
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait(MutexImpl& mutex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the condition variable is notified, or a timeout expires
+    ///
+    /// \param mutex   Locked mutex, released while waiting
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return False if the timeout expired, true otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait(MutexImpl& mutex, Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wake up one waiting thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void notifyOne();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wake up all the waiting threads
+    ///
+    ////////////////////////////////////////////////////////////
+    void notifyAll();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the mutex, wait for a notification and lock the mutex again
+    ///
+    /// \param mutex        Locked mutex, released while waiting
+    /// \param milliseconds Maximum time to wait, or INFINITE
+    ///
+    /// \return False if the timeout expired, true otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    bool waitFor(MutexImpl& mutex, DWORD milliseconds);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    CRITICAL_SECTION m_lock;    ///< Protects the counters
+    HANDLE           m_wakeUp;  ///< Semaphore released once per woken thread
+    HANDLE           m_woken;   ///< Semaphore released by each woken thread
+    LONG             m_waiters; ///< Number of waiting threads
+    LONG             m_signals; ///< Number of woken threads that haven't acknowledged yet
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_CONDITIONVARIABLEIMPL_HPP
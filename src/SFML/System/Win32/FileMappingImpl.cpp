@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Win32/FileMappingImpl.hpp>
+#include <windows.h>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+FileMappingImpl::FileMappingImpl() :
+m_data(NULL),
+m_size(0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+FileMappingImpl::~FileMappingImpl()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool FileMappingImpl::open(const std::string& filename)
+{
+    close();
+
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    // Mapping an empty file fails, and a view can't be larger than the address space
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || (size.QuadPart <= 0) || (static_cast<ULONGLONG>(size.QuadPart) > static_cast<SIZE_T>(-1)))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    // The view keeps the mapping alive after the handles are closed
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping)
+        return false;
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!data)
+        return false;
+
+    m_data = data;
+    m_size = static_cast<std::size_t>(size.QuadPart);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void FileMappingImpl::close()
+{
+    if (m_data)
+        UnmapViewOfFile(m_data);
+
+    m_data = NULL;
+    m_size = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+const void* FileMappingImpl::getData() const
+{
+    return m_data;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t FileMappingImpl::getSize() const
+{
+    return m_size;
+}
+
+} // namespace priv
+
+} // namespace sf
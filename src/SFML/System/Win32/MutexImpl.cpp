@@ -33,9 +33,14 @@ namespace sf
 namespace priv
 {
 ////////////////////////////////////////////////////////////
-MutexImpl::MutexImpl()
+MutexImpl::MutexImpl(bool recursive)
 {
-    InitializeCriticalSection(&m_mutex);
+    // Critical sections are always recursive; the non-recursive mutexes only
+    // guard short sections, so they spin for a while before sleeping
+    if (recursive)
+        InitializeCriticalSection(&m_mutex);
+    else
+        InitializeCriticalSectionAndSpinCount(&m_mutex, 4000);
 }
 
 
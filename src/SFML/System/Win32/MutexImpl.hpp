@@ -46,8 +46,10 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
+    /// \param recursive True to allow the same thread to lock the mutex several times
+    ///
     ////////////////////////////////////////////////////////////
-    MutexImpl();
+    explicit MutexImpl(bool recursive);
 
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Win32/ReadWriteMutexImpl.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+ReadWriteMutexImpl::ReadWriteMutexImpl() :
+m_readers(0)
+{
+    // Slim reader/writer locks require Vista, build the lock from
+    // critical sections and an event to keep supporting XP
+    InitializeCriticalSection(&m_writeMutex);
+    InitializeCriticalSectionAndSpinCount(&m_readerMutex, 4000);
+    m_noReaders = CreateEvent(NULL, TRUE, TRUE, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+ReadWriteMutexImpl::~ReadWriteMutexImpl()
+{
+    CloseHandle(m_noReaders);
+    DeleteCriticalSection(&m_readerMutex);
+    DeleteCriticalSection(&m_writeMutex);
+}
+
+
+////////////////////////////////////////////////////////////
+void ReadWriteMutexImpl::lockRead()
+{
+    // Going through the writer's mutex makes new readers wait for a pending writer
+    EnterCriticalSection(&m_writeMutex);
+
+    EnterCriticalSection(&m_readerMutex);
+    if (m_readers++ == 0)
+        ResetEvent(m_noReaders);
+    LeaveCriticalSection(&m_readerMutex);
+
+    LeaveCriticalSection(&m_writeMutex);
+}
+
+
+////////////////////////////////////////////////////////////
+void ReadWriteMutexImpl::unlockRead()
+{
+    EnterCriticalSection(&m_readerMutex);
+    if (--m_readers == 0)
+        SetEvent(m_noReaders);
+    LeaveCriticalSection(&m_readerMutex);
+}
+
+
+////////////////////////////////////////////////////////////
+void ReadWriteMutexImpl::lockWrite()
+{
+    // Block the new readers, then wait for the current ones to leave
+    EnterCriticalSection(&m_writeMutex);
+    WaitForSingleObject(m_noReaders, INFINITE);
+}
+
+
+////////////////////////////////////////////////////////////
+void ReadWriteMutexImpl::unlockWrite()
+{
+    LeaveCriticalSection(&m_writeMutex);
+}
+
+} // namespace priv
+
+} // namespace sf
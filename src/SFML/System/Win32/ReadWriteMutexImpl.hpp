@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_READWRITEMUTEXIMPL_HPP
+#define SFML_READWRITEMUTEXIMPL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/NonCopyable.hpp>
+#include <windows.h>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Win32 implementation of read-write mutexes
+////////////////////////////////////////////////////////////
+class ReadWriteMutexImpl : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ReadWriteMutexImpl();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ReadWriteMutexImpl();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Lock the mutex for reading
+    ///
+    ////////////////////////////////////////////////////////////
+    void lockRead();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release a read lock of the mutex
+    ///
+    ////////////////////////////////////////////////////////////
+    void unlockRead();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Lock the mutex for writing
+    ///
+    ////////////////////////////////////////////////////////////
+    void lockWrite();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the write lock of the mutex
+    ///
+    ////////////////////////////////////////////////////////////
+    void unlockWrite();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    CRITICAL_SECTION m_writeMutex;  ///< Held by the writer, and briefly by each new reader
+    CRITICAL_SECTION m_readerMutex; ///< Protects the reader count
+    HANDLE           m_noReaders;   ///< Manual-reset event signaled when no reader holds the lock
+    unsigned int     m_readers;     ///< Number of threads holding a read lock
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_READWRITEMUTEXIMPL_HPP
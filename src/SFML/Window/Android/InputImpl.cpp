@@ -43,6 +43,18 @@ bool InputImpl::isKeyPressed(Keyboard::Key key)
     return false;
 }
 
+////////////////////////////////////////////////////////////
+Keyboard::State InputImpl::getKeyboardState()
+{
+    // Querying a single key is cheap on this system
+    Keyboard::State state;
+    for (int i = 0; i < Keyboard::KeyCount; ++i)
+        state.keys[i] = isKeyPressed(static_cast<Keyboard::Key>(i));
+
+    return state;
+}
+
+
 ////////////////////////////////////////////////////////////
 void InputImpl::setVirtualKeyboardVisible(bool visible)
 {
@@ -129,8 +141,9 @@ bool InputImpl::isMouseButtonPressed(Mouse::Button button)
 {
     ALooper_pollAll(0, NULL, NULL, NULL);
 
+    // The input states are only written by the input callbacks, which
+    // run on this thread during ALooper_pollAll
     priv::ActivityStates* states = priv::getActivity(NULL);
-    Lock lock(states->mutex);
 
     return states->isButtonPressed[button];
 }
@@ -141,8 +154,9 @@ Vector2i InputImpl::getMousePosition()
 {
     ALooper_pollAll(0, NULL, NULL, NULL);
 
+    // The input states are only written by the input callbacks, which
+    // run on this thread during ALooper_pollAll
     priv::ActivityStates* states = priv::getActivity(NULL);
-    Lock lock(states->mutex);
 
     return states->mousePosition;
 }
@@ -155,6 +169,30 @@ Vector2i InputImpl::getMousePosition(const Window& relativeTo)
 }
 
 
+////////////////////////////////////////////////////////////
+Mouse::State InputImpl::getMouseState()
+{
+    Mouse::State state;
+    for (int i = 0; i < Mouse::ButtonCount; ++i)
+        state.buttons[i] = isMouseButtonPressed(static_cast<Mouse::Button>(i));
+    state.position = getMousePosition();
+
+    return state;
+}
+
+
+////////////////////////////////////////////////////////////
+Mouse::State InputImpl::getMouseState(const Window& relativeTo)
+{
+    Mouse::State state;
+    for (int i = 0; i < Mouse::ButtonCount; ++i)
+        state.buttons[i] = isMouseButtonPressed(static_cast<Mouse::Button>(i));
+    state.position = getMousePosition(relativeTo);
+
+    return state;
+}
+
+
 ////////////////////////////////////////////////////////////
 void InputImpl::setMousePosition(const Vector2i& position)
 {
@@ -174,8 +212,9 @@ bool InputImpl::isTouchDown(unsigned int finger)
 {
     ALooper_pollAll(0, NULL, NULL, NULL);
 
+    // The input states are only written by the input callbacks, which
+    // run on this thread during ALooper_pollAll
     priv::ActivityStates* states = priv::getActivity(NULL);
-    Lock lock(states->mutex);
 
     return states->touchEvents.find(finger) != states->touchEvents.end();
 }
@@ -186,8 +225,9 @@ Vector2i InputImpl::getTouchPosition(unsigned int finger)
 {
     ALooper_pollAll(0, NULL, NULL, NULL);
 
+    // The input states are only written by the input callbacks, which
+    // run on this thread during ALooper_pollAll
     priv::ActivityStates* states = priv::getActivity(NULL);
-    Lock lock(states->mutex);
 
     return states->touchEvents.find(finger)->second;
 }
@@ -55,6 +55,14 @@ bool JoystickImpl::isConnected(unsigned int index)
 }
 
 
+////////////////////////////////////////////////////////////
+bool JoystickImpl::isUpdateNeeded()
+{
+    // To implement
+    return false;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool JoystickImpl::open(unsigned int index)
 {
@@ -89,15 +89,13 @@ bool SensorImpl::open(Sensor::Type sensor)
     if (!m_sensor)
         return false;
 
-    // Get the minimum delay allowed between events
-    Time minimumDelay = microseconds(ASensor_getMinDelay(m_sensor));
-
-    // Set the event rate (not to consume too much battery)
-    ASensorEventQueue_setEventRate(sensorEventQueue, m_sensor, minimumDelay.asMicroseconds());
-
     // Save the index of the sensor
     m_index = static_cast<unsigned int>(sensor);
 
+    // Use the fastest rate, without batching, until told otherwise
+    m_interval = Time::Zero;
+    m_maxReportLatency = Time::Zero;
+
     return true;
 }
 
@@ -122,10 +120,37 @@ Vector3f SensorImpl::update()
 ////////////////////////////////////////////////////////////
 void SensorImpl::setEnabled(bool enabled)
 {
-    if (enabled)
-        ASensorEventQueue_enableSensor(sensorEventQueue, m_sensor);
-    else
+    if (!enabled)
+    {
         ASensorEventQueue_disableSensor(sensorEventQueue, m_sensor);
+        return;
+    }
+
+    // Never ask for more than the sensor can deliver
+    Time minimumDelay = microseconds(ASensor_getMinDelay(m_sensor));
+    Time interval = m_interval > minimumDelay ? m_interval : minimumDelay;
+
+#if __ANDROID_API__ >= 26
+    // Let the hardware FIFO batch the samples if a report latency was requested
+    if (m_maxReportLatency > Time::Zero)
+    {
+        if (ASensorEventQueue_registerSensor(sensorEventQueue, m_sensor, static_cast<int32_t>(interval.asMicroseconds()),
+                                             m_maxReportLatency.asMicroseconds()) >= 0)
+            return;
+    }
+#endif
+
+    // The event rate can only be changed once the sensor is enabled
+    ASensorEventQueue_enableSensor(sensorEventQueue, m_sensor);
+    ASensorEventQueue_setEventRate(sensorEventQueue, m_sensor, static_cast<int32_t>(interval.asMicroseconds()));
+}
+
+
+////////////////////////////////////////////////////////////
+void SensorImpl::setRate(Time interval, Time maxReportLatency)
+{
+    m_interval = interval;
+    m_maxReportLatency = maxReportLatency;
 }
 
 
@@ -147,63 +172,70 @@ ASensor const* SensorImpl::getDefaultSensor(Sensor::Type sensor)
 ////////////////////////////////////////////////////////////
 int SensorImpl::processSensorEvents(int fd, int events, void* data)
 {
-    ASensorEvent event;
+    // Drain the queue in blocks, batched sensors can deliver many samples at once;
+    // only the latest value of each sensor is kept
+    ASensorEvent buffer[16];
+    ssize_t count;
 
-    while (ASensorEventQueue_getEvents(sensorEventQueue, &event, 1) > 0)
+    while ((count = ASensorEventQueue_getEvents(sensorEventQueue, buffer, 16)) > 0)
     {
-        unsigned int type = Sensor::Count;
-        Vector3f data;
-
-        switch (event.type)
+        for (ssize_t i = 0; i < count; ++i)
         {
-            case ASENSOR_TYPE_ACCELEROMETER:
-                type = Sensor::Accelerometer;
-                data.x = event.acceleration.x;
-                data.y = event.acceleration.y;
-                data.z = event.acceleration.z;
-                break;
-
-            case ASENSOR_TYPE_GYROSCOPE:
-                type = Sensor::Gyroscope;
-                data.x = event.vector.x;
-                data.y = event.vector.y;
-                data.z = event.vector.z;
-                break;
-
-            case ASENSOR_TYPE_MAGNETIC_FIELD:
-                type = Sensor::Magnetometer;
-                data.x = event.magnetic.x;
-                data.y = event.magnetic.y;
-                data.z = event.magnetic.z;
-                break;
-
-            case ASENSOR_TYPE_GRAVITY:
-                type = Sensor::Gravity;
-                data.x = event.vector.x;
-                data.y = event.vector.y;
-                data.z = event.vector.z;
-                break;
-
-            case ASENSOR_TYPE_LINEAR_ACCELERATION:
-                type = Sensor::UserAcceleration;
-                data.x = event.acceleration.x;
-                data.y = event.acceleration.y;
-                data.z = event.acceleration.z;
-                break;
-
-            case ASENSOR_TYPE_ORIENTATION:
-                type = Sensor::Orientation;
-                data.x = event.vector.x;
-                data.y = event.vector.y;
-                data.z = event.vector.z;
-                break;
+            const ASensorEvent& event = buffer[i];
+            unsigned int type = Sensor::Count;
+            Vector3f data;
+
+            switch (event.type)
+            {
+                case ASENSOR_TYPE_ACCELEROMETER:
+                    type = Sensor::Accelerometer;
+                    data.x = event.acceleration.x;
+                    data.y = event.acceleration.y;
+                    data.z = event.acceleration.z;
+                    break;
+
+                case ASENSOR_TYPE_GYROSCOPE:
+                    type = Sensor::Gyroscope;
+                    data.x = event.vector.x;
+                    data.y = event.vector.y;
+                    data.z = event.vector.z;
+                    break;
+
+                case ASENSOR_TYPE_MAGNETIC_FIELD:
+                    type = Sensor::Magnetometer;
+                    data.x = event.magnetic.x;
+                    data.y = event.magnetic.y;
+                    data.z = event.magnetic.z;
+                    break;
+
+                case ASENSOR_TYPE_GRAVITY:
+                    type = Sensor::Gravity;
+                    data.x = event.vector.x;
+                    data.y = event.vector.y;
+                    data.z = event.vector.z;
+                    break;
+
+                case ASENSOR_TYPE_LINEAR_ACCELERATION:
+                    type = Sensor::UserAcceleration;
+                    data.x = event.acceleration.x;
+                    data.y = event.acceleration.y;
+                    data.z = event.acceleration.z;
+                    break;
+
+                case ASENSOR_TYPE_ORIENTATION:
+                    type = Sensor::Orientation;
+                    data.x = event.vector.x;
+                    data.y = event.vector.y;
+                    data.z = event.vector.z;
+                    break;
+            }
+
+            // An unknown sensor event has been detected, we don't know how to process it
+            if (type == Sensor::Count)
+                continue;
+
+            sensorData[type] = data;
         }
-
-        // An unknown sensor event has been detected, we don't know how to process it
-        if (type == Sensor::Count)
-            continue;
-
-        sensorData[type] = data;
     }
 
     return 1;
@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/System/Vector3.hpp>
+#include <SFML/System/Time.hpp>
 #include <android/sensor.h>
 
 
@@ -98,6 +99,15 @@ public:
     ////////////////////////////////////////////////////////////
     void setEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the sampling rate used the next time the sensor is enabled
+    ///
+    /// \param interval         Requested delay between two samples (zero for the fastest)
+    /// \param maxReportLatency Maximum delay before batched samples are reported
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRate(Time interval, Time maxReportLatency);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -125,8 +135,10 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    const ASensor* m_sensor; ///< Android sensor structure
-    unsigned int   m_index;  ///< Index of the sensor
+    const ASensor* m_sensor;           ///< Android sensor structure
+    unsigned int   m_index;            ///< Index of the sensor
+    Time           m_interval;         ///< Requested delay between two samples
+    Time           m_maxReportLatency; ///< Maximum delay before batched samples are reported
 };
 
 } // namespace priv
@@ -30,6 +30,7 @@
 #include <SFML/Window/Android/WindowImplAndroid.hpp>
 #include <SFML/Window/Event.hpp>
 #include <SFML/System/Lock.hpp>
+#include <SFML/System/LockFreeQueue.hpp>
 #include <SFML/System/Err.hpp>
 #include <android/looper.h>
 
@@ -37,6 +38,12 @@
 #define AMOTION_EVENT_ACTION_HOVER_MOVE 0x00000007
 #define AMOTION_EVENT_ACTION_SCROLL 0x00000008
 
+namespace
+{
+    // Events sent by the activity callbacks (UI thread) to the window (main thread)
+    sf::priv::SpscQueue<sf::Event> activityEvents(64);
+}
+
 ////////////////////////////////////////////////////////////
 // Private data
 ////////////////////////////////////////////////////////////
@@ -98,10 +105,37 @@ WindowHandle WindowImplAndroid::getSystemHandle() const
 ////////////////////////////////////////////////////////////
 void WindowImplAndroid::processEvents()
 {
-    // Process incoming OS events
+    // Process incoming OS events; the input callbacks run on this
+    // thread and push their events directly
     ALooper_pollAll(0, NULL, NULL, NULL);
 
     ActivityStates* states = getActivity(NULL);
+
+    // Handle the events sent by the activity callbacks
+    Event event;
+    while (activityEvents.pop(event))
+    {
+        if (event.type == Event::GainedFocus)
+        {
+            m_size.x = ANativeWindow_getWidth(states->window);
+            m_size.y = ANativeWindow_getHeight(states->window);
+            m_windowBeingCreated = true;
+            m_hasFocus = true;
+        }
+        else if (event.type == Event::LostFocus)
+        {
+            m_windowBeingDestroyed = true;
+            m_hasFocus = false;
+        }
+
+        pushEvent(event);
+    }
+
+    // The activity mutex is only needed for the surface changes,
+    // the activity callback waits for them to be done
+    if (!m_windowBeingCreated && !m_windowBeingDestroyed)
+        return;
+
     sf::Lock lock(states->mutex);
 
     if (m_windowBeingCreated)
@@ -200,22 +234,10 @@ bool WindowImplAndroid::hasFocus() const
 ////////////////////////////////////////////////////////////
 void WindowImplAndroid::forwardEvent(const Event& event)
 {
-    ActivityStates* states = getActivity(NULL);
-
-    if (event.type == Event::GainedFocus)
-    {
-        WindowImplAndroid::singleInstance->m_size.x = ANativeWindow_getWidth(states->window);
-        WindowImplAndroid::singleInstance->m_size.y = ANativeWindow_getHeight(states->window);
-        WindowImplAndroid::singleInstance->m_windowBeingCreated = true;
-        WindowImplAndroid::singleInstance->m_hasFocus = true;
-    }
-    else if (event.type == Event::LostFocus)
-    {
-        WindowImplAndroid::singleInstance->m_windowBeingDestroyed = true;
-        WindowImplAndroid::singleInstance->m_hasFocus = false;
-    }
-
-    WindowImplAndroid::singleInstance->pushEvent(event);
+    // Lifecycle events are rare, the queue can only fill up if the
+    // application stopped polling its events
+    if (!activityEvents.push(event))
+        err() << "Failed to forward an activity event, the event queue is full" << std::endl;
 }
 
 
@@ -223,7 +245,14 @@ void WindowImplAndroid::forwardEvent(const Event& event)
 int WindowImplAndroid::processEvent(int fd, int events, void* data)
 {
     ActivityStates* states = getActivity(NULL);
-    Lock lock(states->mutex);
+
+    // This callback runs on the main thread, only the input queue
+    // itself is shared with the UI thread (which creates and destroys it)
+    Lock lock(states->inputMutex);
+
+    // The queue has been detached, unregister the callback
+    if (!states->inputQueue)
+        return 0;
 
     AInputEvent* _event = NULL;
 
@@ -347,7 +376,7 @@ void WindowImplAndroid::processScrollEvent(AInputEvent* _event, ActivityStates*
     event.mouseWheel.x = AMotionEvent_getX(_event, 0);
     event.mouseWheel.y = AMotionEvent_getY(_event, 0);
 
-    forwardEvent(event);
+    singleInstance->pushEvent(event);
 
     // Detach this thread from the JVM
     lJavaVM->DetachCurrentThread();
@@ -373,26 +402,26 @@ void WindowImplAndroid::processKeyEvent(AInputEvent* _event, ActivityStates* sta
     {
     case AKEY_EVENT_ACTION_DOWN:
         event.type = Event::KeyPressed;
-        forwardEvent(event);
+        singleInstance->pushEvent(event);
         break;
     case AKEY_EVENT_ACTION_UP:
         event.type = Event::KeyReleased;
-        forwardEvent(event);
+        singleInstance->pushEvent(event);
 
         if (int unicode = getUnicode(_event))
         {
             event.type = Event::TextEntered;
             event.text.unicode = unicode;
-            forwardEvent(event);
+            singleInstance->pushEvent(event);
         }
         break;
     case AKEY_EVENT_ACTION_MULTIPLE:
         // Since complex inputs don't get separate key down/up events
         // both have to be faked at once
         event.type = Event::KeyPressed;
-        forwardEvent(event);
+        singleInstance->pushEvent(event);
         event.type = Event::KeyReleased;
-        forwardEvent(event);
+        singleInstance->pushEvent(event);
 
         // This requires some special treatment, since this might represent
         // a repetition of key presses or a complete sequence
@@ -411,7 +440,7 @@ void WindowImplAndroid::processKeyEvent(AInputEvent* _event, ActivityStates* sta
 
                 int32_t repeats = AKeyEvent_getRepeatCount(_event);
                 for (int32_t i = 0; i < repeats; ++i)
-                    forwardEvent(event);
+                    singleInstance->pushEvent(event);
             }
         }
         break;
@@ -460,7 +489,7 @@ void WindowImplAndroid::processMotionEvent(AInputEvent* _event, ActivityStates*
             states->touchEvents[id] = Vector2i(event.touch.x, event.touch.y);
         }
 
-        forwardEvent(event);
+        singleInstance->pushEvent(event);
      }
 }
 
@@ -524,7 +553,7 @@ void WindowImplAndroid::processPointerEvent(bool isDown, AInputEvent* _event, Ac
         }
     }
 
-    forwardEvent(event);
+    singleInstance->pushEvent(event);
 }
 
 
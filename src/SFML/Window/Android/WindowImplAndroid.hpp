@@ -169,6 +169,16 @@ public:
     ////////////////////////////////////////////////////////////
     virtual bool hasFocus() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send an event from the activity callbacks to the window
+    ///
+    /// The activity callbacks run on the UI thread: the event is
+    /// stored in a lock-free queue and handled by the next call
+    /// to processEvents on the main thread.
+    ///
+    /// \param event Event to send
+    ///
+    ////////////////////////////////////////////////////////////
     static void forwardEvent(const Event& event);
     static WindowImplAndroid* singleInstance;
 
@@ -60,6 +60,20 @@ GlFunctionPointer Context::getFunction(const char* name)
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 Context::getActiveContextId()
+{
+    return priv::GlContext::getActiveContextId();
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Context::getSwitchCount()
+{
+    return priv::GlContext::getSwitchCount();
+}
+
+
 ////////////////////////////////////////////////////////////
 Context::Context(const ContextSettings& settings, unsigned int width, unsigned int height)
 {
@@ -39,9 +39,71 @@
 #ifdef SFML_SYSTEM_LINUX
     #include <X11/Xlib.h>
 #endif
+#include <cstring>
+
+#if !defined(EGL_PLATFORM_SURFACELESS_MESA)
+    #define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
 
 namespace
 {
+#if defined(SFML_SYSTEM_LINUX) && !defined(SFML_OPENGL_ES)
+
+    typedef EGLDisplay (*eglGetPlatformDisplayEXTFuncType)(EGLenum, void*, const EGLint*);
+
+    ////////////////////////////////////////////////////////////
+    EGLDisplay getHeadlessDisplay()
+    {
+        // The surfaceless platform doesn't need any display server,
+        // use it when the EGL implementation supports it
+        const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+        if (extensions && std::strstr(extensions, "EGL_MESA_platform_surfaceless"))
+        {
+            eglGetPlatformDisplayEXTFuncType eglGetPlatformDisplayEXT =
+                reinterpret_cast<eglGetPlatformDisplayEXTFuncType>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+            if (eglGetPlatformDisplayEXT)
+            {
+                EGLDisplay display = eglCheck(eglGetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL));
+                if (display != EGL_NO_DISPLAY)
+                    return display;
+            }
+        }
+
+        return eglCheck(eglGetDisplay(EGL_DEFAULT_DISPLAY));
+    }
+
+#endif
+
+    ////////////////////////////////////////////////////////////
+    unsigned int getDefaultBitsPerPixel()
+    {
+#if defined(SFML_OPENGL_ES)
+
+        return sf::VideoMode::getDesktopMode().bitsPerPixel;
+
+#else
+
+        // Headless contexts have no desktop to query the pixel depth from
+        return 32;
+
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////
+    void bindApi()
+    {
+#if !defined(SFML_OPENGL_ES)
+
+        // The bound API is a per-thread state, and defaults to OpenGL ES
+        eglCheck(eglBindAPI(EGL_OPENGL_API));
+
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////
     EGLDisplay getInitializedDisplay()
     {
 #if defined(SFML_SYSTEM_LINUX)
@@ -50,7 +112,11 @@ namespace
 
         if (display == EGL_NO_DISPLAY)
         {
+        #if !defined(SFML_OPENGL_ES)
+            display = getHeadlessDisplay();
+        #else
             display = eglCheck(eglGetDisplay(EGL_DEFAULT_DISPLAY));
+        #endif
             eglCheck(eglInitialize(display, NULL, NULL));
         }
 
@@ -84,7 +150,7 @@ m_config  (NULL)
     m_display = getInitializedDisplay();
 
     // Get the best EGL config matching the default video settings
-    m_config = getBestConfig(m_display, VideoMode::getDesktopMode().bitsPerPixel, ContextSettings());
+    m_config = getBestConfig(m_display, getDefaultBitsPerPixel(), ContextSettings());
 
     // Note: The EGL specs say that attrib_list can be NULL when passed to eglCreatePbufferSurface,
     // but this is resulting in a segfault. Bug in Android?
@@ -142,6 +208,23 @@ m_context (EGL_NO_CONTEXT),
 m_surface (EGL_NO_SURFACE),
 m_config  (NULL)
 {
+    // Get the initialized EGL display
+    m_display = getInitializedDisplay();
+
+    // Get the best EGL config matching the requested video settings
+    m_config = getBestConfig(m_display, getDefaultBitsPerPixel(), settings);
+
+    // Create a pbuffer surface of the requested size as the rendering target
+    EGLint attrib_list[] = {
+        EGL_WIDTH, static_cast<EGLint>(width),
+        EGL_HEIGHT, static_cast<EGLint>(height),
+        EGL_NONE
+    };
+
+    m_surface = eglCheck(eglCreatePbufferSurface(m_display, m_config, attrib_list));
+
+    // Create EGL context
+    createContext(shared);
 }
 
 
@@ -170,9 +253,18 @@ EglContext::~EglContext()
 }
 
 
+////////////////////////////////////////////////////////////
+GlFunctionPointer EglContext::getFunction(const char* name)
+{
+    return reinterpret_cast<GlFunctionPointer>(eglGetProcAddress(name));
+}
+
+
 ////////////////////////////////////////////////////////////
 bool EglContext::makeCurrent()
 {
+    bindApi();
+
     return m_surface != EGL_NO_SURFACE && eglCheck(eglMakeCurrent(m_display, m_surface, m_surface, m_context));
 }
 
@@ -192,13 +284,53 @@ void EglContext::setVerticalSyncEnabled(bool enabled)
 }
 
 
+////////////////////////////////////////////////////////////
+bool EglContext::setSwapInterval(int interval)
+{
+    if (!isSwapIntervalSupported(interval))
+        return false;
+
+    eglCheck(eglSwapInterval(m_display, interval));
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool EglContext::isSwapIntervalSupported(int interval)
+{
+    // EGL has no adaptive synchronization, and clamps the
+    // interval to the range supported by the config
+    EGLint minInterval = 0;
+    EGLint maxInterval = 1;
+    eglCheck(eglGetConfigAttrib(m_display, m_config, EGL_MIN_SWAP_INTERVAL, &minInterval));
+    eglCheck(eglGetConfigAttrib(m_display, m_config, EGL_MAX_SWAP_INTERVAL, &maxInterval));
+
+    return (interval >= minInterval) && (interval <= maxInterval);
+}
+
+
 ////////////////////////////////////////////////////////////
 void EglContext::createContext(EglContext* shared)
 {
+#if defined(SFML_OPENGL_ES2)
+    // OpenGL ES 3 contexts are backward compatible, drivers may return one
+    const EGLint contextVersion[] = {
+        EGL_CONTEXT_CLIENT_VERSION, 2,
+        EGL_NONE
+    };
+#elif defined(SFML_OPENGL_ES)
     const EGLint contextVersion[] = {
         EGL_CONTEXT_CLIENT_VERSION, 1,
         EGL_NONE
     };
+#else
+    // Desktop OpenGL through EGL: request a default (compatibility) context
+    const EGLint contextVersion[] = {
+        EGL_NONE
+    };
+#endif
+
+    bindApi();
 
     EGLContext toShared;
 
@@ -239,8 +371,16 @@ EGLConfig EglContext::getBestConfig(EGLDisplay display, unsigned int bitsPerPixe
         EGL_DEPTH_SIZE, settings.depthBits,
         EGL_STENCIL_SIZE, settings.stencilBits,
         EGL_SAMPLE_BUFFERS, settings.antialiasingLevel,
+#if defined(SFML_OPENGL_ES2)
+        EGL_SURFACE_TYPE, EGL_WINDOW_BIT | EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+#elif defined(SFML_OPENGL_ES)
         EGL_SURFACE_TYPE, EGL_WINDOW_BIT | EGL_PBUFFER_BIT,
         EGL_RENDERABLE_TYPE, EGL_OPENGL_ES_BIT,
+#else
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+#endif
         EGL_NONE
     };
 
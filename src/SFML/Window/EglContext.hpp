@@ -79,6 +79,16 @@ public:
     ////////////////////////////////////////////////////////////
     ~EglContext();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the address of an OpenGL function
+    ///
+    /// \param name Name of the function to get the address of
+    ///
+    /// \return Address of the OpenGL function, 0 on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    static GlFunctionPointer getFunction(const char* name);
+
     ////////////////////////////////////////////////////////////
     /// \brief Activate the context as the current target
     ///        for rendering
@@ -107,6 +117,26 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setVerticalSyncEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of vertical blanks to wait for between two swaps
+    ///
+    /// \param interval Swap interval, negative for adaptive vertical synchronization
+    ///
+    /// \return True if the interval was applied, false if it is not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool setSwapInterval(int interval);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether a swap interval is supported by the context
+    ///
+    /// \param interval Swap interval to check
+    ///
+    /// \return True if setSwapInterval supports \a interval
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool isSwapIntervalSupported(int interval);
+
     ////////////////////////////////////////////////////////////
     /// \brief Create the context
     ///
@@ -196,6 +196,22 @@ bool JoystickImpl::isConnected(unsigned int index)
 }
 
 
+////////////////////////////////////////////////////////////
+bool JoystickImpl::isUpdateNeeded()
+{
+    // The joysticks can only be polled
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool JoystickImpl::getWaitDescriptors(std::vector<int>&)
+{
+    // The HID reports are polled
+    return false;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool JoystickImpl::open(unsigned int index)
 {
@@ -67,6 +67,30 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isConnected(unsigned int index);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the joysticks may have changed since the last update
+    ///
+    /// When this function returns false, updating the joysticks
+    /// would neither change their state nor connect new ones.
+    ///
+    /// \return True if the joysticks must be updated
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isUpdateNeeded();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the file descriptors that signal joystick changes
+    ///
+    /// The descriptors become readable when a joystick is
+    /// connected, disconnected or moved.
+    ///
+    /// \param descriptors Array to which the descriptors are appended
+    ///
+    /// \return True if the descriptors signal all the changes, false if the joysticks must also be polled
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool getWaitDescriptors(std::vector<int>& descriptors);
+
     ////////////////////////////////////////////////////////////
     /// \brief Open the joystick
     ///
@@ -47,6 +47,14 @@
         #include <SFML/Window/Unix/GlxContext.hpp>
         typedef sf::priv::GlxContext ContextType;
 
+        #if defined(SFML_EGL_HEADLESS)
+
+            #include <SFML/Window/EglContext.hpp>
+            #include <SFML/Window/Unix/Display.hpp>
+            typedef sf::priv::EglContext HeadlessContextType;
+
+        #endif
+
     #elif defined(SFML_SYSTEM_MACOS)
 
         #include <SFML/Window/OSX/SFContext.hpp>
@@ -124,11 +132,26 @@ namespace
     // or pixel format operations are performed simultaneously
     sf::Mutex mutex;
 
+    // Identifier given to the next created context; contexts are identified by
+    // number rather than by address, which could be reused after a deletion
+    sf::Uint64 nextContextId = 1;
+
+    // Number of times a context was actually made current (activations
+    // of the context that is already current are not counted)
+    sf::Uint64 switchCount = 0;
+
     // This per-thread variable holds the current context for each thread
     sf::ThreadLocalPtr<sf::priv::GlContext> currentContext(NULL);
 
     // The hidden, inactive context that will be shared with all other contexts
-    ContextType* sharedContext = NULL;
+    sf::priv::GlContext* sharedContext = NULL;
+
+#if defined(SFML_EGL_HEADLESS)
+
+    // True when there's no display server, contexts are then backed by EGL pbuffers
+    bool headless = false;
+
+#endif
 
     // Internal contexts
     sf::ThreadLocalPtr<sf::priv::GlContext> internalContext(NULL);
@@ -172,7 +195,13 @@ void GlContext::globalInit()
     Lock lock(mutex);
 
     // Create the shared context
+#if defined(SFML_EGL_HEADLESS)
+    headless = !isDisplayAvailable();
+    sharedContext = headless ? static_cast<GlContext*>(new HeadlessContextType(NULL)) : new ContextType(NULL);
+#else
     sharedContext = new ContextType(NULL);
+#endif
+
     sharedContext->initialize();
 
     // This call makes sure that:
@@ -214,7 +243,17 @@ GlContext* GlContext::create()
     Lock lock(mutex);
 
     // Create the context
-    GlContext* context = new ContextType(sharedContext);
+#if defined(SFML_EGL_HEADLESS)
+    if (headless)
+    {
+        GlContext* context = new HeadlessContextType(static_cast<HeadlessContextType*>(sharedContext));
+        context->initialize();
+
+        return context;
+    }
+#endif
+
+    GlContext* context = new ContextType(static_cast<ContextType*>(sharedContext));
     context->initialize();
 
     return context;
@@ -230,7 +269,8 @@ GlContext* GlContext::create(const ContextSettings& settings, const WindowImpl*
     Lock lock(mutex);
 
     // Create the context
-    GlContext* context = new ContextType(sharedContext, settings, owner, bitsPerPixel);
+    // (a window can't exist without a display server, so there's no headless variant)
+    GlContext* context = new ContextType(static_cast<ContextType*>(sharedContext), settings, owner, bitsPerPixel);
     context->initialize();
     context->checkSettings(settings);
 
@@ -247,7 +287,18 @@ GlContext* GlContext::create(const ContextSettings& settings, unsigned int width
     Lock lock(mutex);
 
     // Create the context
-    GlContext* context = new ContextType(sharedContext, settings, width, height);
+#if defined(SFML_EGL_HEADLESS)
+    if (headless)
+    {
+        GlContext* context = new HeadlessContextType(static_cast<HeadlessContextType*>(sharedContext), settings, width, height);
+        context->initialize();
+        context->checkSettings(settings);
+
+        return context;
+    }
+#endif
+
+    GlContext* context = new ContextType(static_cast<ContextType*>(sharedContext), settings, width, height);
     context->initialize();
     context->checkSettings(settings);
 
@@ -262,6 +313,11 @@ GlFunctionPointer GlContext::getFunction(const char* name)
 
     Lock lock(mutex);
 
+#if defined(SFML_EGL_HEADLESS)
+    if (headless)
+        return HeadlessContextType::getFunction(name);
+#endif
+
     return ContextType::getFunction(name);
 
 #else
@@ -272,6 +328,22 @@ GlFunctionPointer GlContext::getFunction(const char* name)
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 GlContext::getActiveContextId()
+{
+    return currentContext ? currentContext->m_id : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 GlContext::getSwitchCount()
+{
+    Lock lock(mutex);
+
+    return switchCount;
+}
+
+
 ////////////////////////////////////////////////////////////
 GlContext::~GlContext()
 {
@@ -302,6 +374,7 @@ bool GlContext::setActive(bool active)
             {
                 // Set it as the new current context for this thread
                 currentContext = this;
+                switchCount++;
                 return true;
             }
             else
@@ -332,10 +405,30 @@ bool GlContext::setActive(bool active)
 }
 
 
+////////////////////////////////////////////////////////////
+bool GlContext::setSwapInterval(int interval)
+{
+    if (!isSwapIntervalSupported(interval))
+        return false;
+
+    setVerticalSyncEnabled(interval != 0);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlContext::isSwapIntervalSupported(int interval)
+{
+    return (interval == 0) || (interval == 1);
+}
+
+
 ////////////////////////////////////////////////////////////
 GlContext::GlContext()
 {
-    // Nothing to do
+    Lock lock(mutex);
+
+    m_id = nextContextId++;
 }
 
 
@@ -130,6 +130,22 @@ public:
     ////////////////////////////////////////////////////////////
     static GlFunctionPointer getFunction(const char* name);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the unique identifier of the context active on the current thread
+    ///
+    /// \return Identifier of the active context, or 0 if no context is active
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getActiveContextId();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of context switches performed so far
+    ///
+    /// \return Number of times a context was made current, on all threads
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getSwitchCount();
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -183,6 +199,33 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setVerticalSyncEnabled(bool enabled) = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of vertical blanks to wait for between two swaps
+    ///
+    /// A negative interval enables the adaptive vertical
+    /// synchronization, where late swaps happen immediately.
+    /// The default implementation supports 0 and 1 through
+    /// setVerticalSyncEnabled.
+    ///
+    /// \param interval Swap interval
+    ///
+    /// \return True if the interval was applied, false if it is not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool setSwapInterval(int interval);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether a swap interval is supported by the context
+    ///
+    /// The context must be active.
+    ///
+    /// \param interval Swap interval to check
+    ///
+    /// \return True if setSwapInterval supports \a interval
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool isSwapIntervalSupported(int interval);
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -242,6 +285,11 @@ private:
     ///
     ////////////////////////////////////////////////////////////
     void checkSettings(const ContextSettings& requestedSettings);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Uint64 m_id; ///< Unique number that identifies the context
 };
 
 } // namespace priv
@@ -64,6 +64,12 @@ const Joystick::Identification& JoystickManager::getIdentification(unsigned int
 ////////////////////////////////////////////////////////////
 void JoystickManager::update()
 {
+    // Don't read anything if the system reports no change
+    if (!JoystickImpl::isUpdateNeeded())
+        return;
+
+    ++m_updateCount;
+
     for (int i = 0; i < Joystick::Count; ++i)
     {
         Item& item = m_joysticks[i];
@@ -100,7 +106,15 @@ void JoystickManager::update()
 
 
 ////////////////////////////////////////////////////////////
-JoystickManager::JoystickManager()
+unsigned int JoystickManager::getUpdateCount() const
+{
+    return m_updateCount;
+}
+
+
+////////////////////////////////////////////////////////////
+JoystickManager::JoystickManager() :
+m_updateCount(0)
 {
     JoystickImpl::initialize();
 }
@@ -86,9 +86,23 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Update the state of all the joysticks
     ///
+    /// The joysticks are only read when the system reports
+    /// that they may have changed.
+    ///
     ////////////////////////////////////////////////////////////
     void update();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of updates that read the joysticks
+    ///
+    /// The states can only have changed if this number is
+    /// different from the one returned before.
+    ///
+    /// \return Number of updates that read the joysticks
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getUpdateCount() const;
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -118,7 +132,8 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Item m_joysticks[Joystick::Count]; ///< Joysticks information and state
+    Item         m_joysticks[Joystick::Count]; ///< Joysticks information and state
+    unsigned int m_updateCount;                ///< Number of updates that read the joysticks
 };
 
 } // namespace priv
@@ -31,6 +31,21 @@
 
 namespace sf
 {
+////////////////////////////////////////////////////////////
+Keyboard::State::State()
+{
+    for (int i = 0; i < KeyCount; ++i)
+        keys[i] = false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Keyboard::State::isKeyPressed(Key key) const
+{
+    return (key >= 0) && (key < KeyCount) && keys[key];
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Keyboard::isKeyPressed(Key key)
 {
@@ -38,6 +53,13 @@ bool Keyboard::isKeyPressed(Key key)
 }
 
 
+////////////////////////////////////////////////////////////
+Keyboard::State Keyboard::getState()
+{
+    return priv::InputImpl::getKeyboardState();
+}
+
+
 ////////////////////////////////////////////////////////////
 void Keyboard::setVirtualKeyboardVisible(bool visible)
 {
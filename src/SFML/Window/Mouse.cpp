@@ -32,6 +32,22 @@
 
 namespace sf
 {
+////////////////////////////////////////////////////////////
+Mouse::State::State() :
+position(0, 0)
+{
+    for (int i = 0; i < ButtonCount; ++i)
+        buttons[i] = false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Mouse::State::isButtonPressed(Button button) const
+{
+    return (button >= 0) && (button < ButtonCount) && buttons[button];
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Mouse::isButtonPressed(Button button)
 {
@@ -53,6 +69,20 @@ Vector2i Mouse::getPosition(const Window& relativeTo)
 }
 
 
+////////////////////////////////////////////////////////////
+Mouse::State Mouse::getState()
+{
+    return priv::InputImpl::getMouseState();
+}
+
+
+////////////////////////////////////////////////////////////
+Mouse::State Mouse::getState(const Window& relativeTo)
+{
+    return priv::InputImpl::getMouseState(relativeTo);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Mouse::setPosition(const Vector2i& position)
 {
@@ -129,6 +129,18 @@ bool InputImpl::isKeyPressed(Keyboard::Key key)
 }
 
 
+////////////////////////////////////////////////////////////
+Keyboard::State InputImpl::getKeyboardState()
+{
+    // Querying a single key is cheap on this system
+    Keyboard::State state;
+    for (int i = 0; i < Keyboard::KeyCount; ++i)
+        state.keys[i] = isKeyPressed(static_cast<Keyboard::Key>(i));
+
+    return state;
+}
+
+
 ////////////////////////////////////////////////////////////
 void InputImpl::setVirtualKeyboardVisible(bool /*visible*/)
 {
@@ -174,6 +186,30 @@ Vector2i InputImpl::getMousePosition(const Window& relativeTo)
 }
 
 
+////////////////////////////////////////////////////////////
+Mouse::State InputImpl::getMouseState()
+{
+    Mouse::State state;
+    for (int i = 0; i < Mouse::ButtonCount; ++i)
+        state.buttons[i] = isMouseButtonPressed(static_cast<Mouse::Button>(i));
+    state.position = getMousePosition();
+
+    return state;
+}
+
+
+////////////////////////////////////////////////////////////
+Mouse::State InputImpl::getMouseState(const Window& relativeTo)
+{
+    Mouse::State state;
+    for (int i = 0; i < Mouse::ButtonCount; ++i)
+        state.buttons[i] = isMouseButtonPressed(static_cast<Mouse::Button>(i));
+    state.position = getMousePosition(relativeTo);
+
+    return state;
+}
+
+
 ////////////////////////////////////////////////////////////
 void InputImpl::setMousePosition(const Vector2i& position)
 {
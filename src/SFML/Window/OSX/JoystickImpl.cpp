@@ -181,6 +181,14 @@ bool JoystickImpl::isConnected(unsigned int index)
 }
 
 
+////////////////////////////////////////////////////////////
+bool JoystickImpl::isUpdateNeeded()
+{
+    // The joysticks can only be polled
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool JoystickImpl::open(unsigned int index)
 {
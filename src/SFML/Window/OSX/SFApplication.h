@@ -43,6 +43,15 @@
 +(void)processEvent;
 
 
+////////////////////////////////////////////////////////////
+/// \brief Wait for an event, without removing it from the queue
+///
+/// \param timeout Maximum time to wait, in seconds
+///
+////////////////////////////////////////////////////////////
++(void)waitEvent:(NSTimeInterval)timeout;
+
+
 ////////////////////////////////////////////////////////////
 /// \brief Set up the menu bar and its items
 ///
@@ -49,6 +49,19 @@
 }
 
 
+////////////////////////////////////////////////////////
++(void)waitEvent:(NSTimeInterval)timeout
+{
+    [SFApplication sharedApplication]; // Make sure NSApp exists
+
+    // The event stays in the queue for processEvent
+    [NSApp nextEventMatchingMask:NSAnyEventMask
+                       untilDate:[NSDate dateWithTimeIntervalSinceNow:timeout]
+                          inMode:NSDefaultRunLoopMode
+                         dequeue:NO];
+}
+
+
 ////////////////////////////////////////////////////////
 +(void)setUpMenuBar
 {
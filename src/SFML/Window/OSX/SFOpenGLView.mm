@@ -591,6 +591,9 @@ BOOL isValidTextUnicode(NSEvent* event);
 {
     if (m_requester != 0)
     {
+        // The relative motion is reported even outside the view
+        m_requester->mouseMovedBy([theEvent deltaX], [theEvent deltaY]);
+
         NSPoint loc = [self cursorPositionFromEvent:theEvent];
 
         // Make sure the point is inside the view.
@@ -159,6 +159,18 @@ public:
     ////////////////////////////////////////////////////////////
     void mouseMovedAt(int x, int y);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Relative Mouse Moved Event - called by the cocoa view object
+    ///
+    /// Send a raw mouse event to SFML WindowImpl class, if the
+    /// raw mouse input is enabled.
+    ///
+    /// \param deltaX horizontal motion
+    /// \param deltaY vertical motion
+    ///
+    ////////////////////////////////////////////////////////////
+    void mouseMovedBy(float deltaX, float deltaY);
+
     ////////////////////////////////////////////////////////////
     /// \brief Mouse Wheel Scrolled Event - called by the cocoa view object
     ///
@@ -321,6 +333,14 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setKeyRepeatEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the raw mouse input
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setMouseRawInputEnabled(bool enabled);
+
     ////////////////////////////////////////////////////////////
     /// \brief Request the current window to be made the active
     ///        foreground window
@@ -344,13 +364,20 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void processEvents();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until new events may be available
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void waitEvents();
+
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    WindowImplDelegateRef m_delegate;   ///< Implementation in Obj-C.
-    bool                  m_showCursor; ///< Is the cursor displayed or hidden?
+    WindowImplDelegateRef m_delegate;      ///< Implementation in Obj-C.
+    bool                  m_showCursor;    ///< Is the cursor displayed or hidden?
+    bool                  m_rawMouseInput; ///< Are raw mouse events generated?
 };
 
 } // namespace priv
@@ -29,6 +29,7 @@
 #include <SFML/Window/OSX/WindowImplCocoa.hpp>
 #include <SFML/System/Err.hpp>
 #include <SFML/System/String.hpp>
+#include <cmath>
 
 #import <SFML/Window/OSX/AutoreleasePoolWrapper.h>
 #import <SFML/Window/OSX/cpp_objc_conversion.h>
@@ -152,7 +153,8 @@ void showMouseCursor()
 
 ////////////////////////////////////////////////////////////
 WindowImplCocoa::WindowImplCocoa(WindowHandle handle) :
-m_showCursor(true)
+m_showCursor(true),
+m_rawMouseInput(false)
 {
     // Ask for a pool.
     retainPool();
@@ -194,7 +196,8 @@ WindowImplCocoa::WindowImplCocoa(VideoMode mode,
                                  const String& title,
                                  unsigned long style,
                                  const ContextSettings& /*settings*/) :
-m_showCursor(true)
+m_showCursor(true),
+m_rawMouseInput(false)
 {
     // Transform the app process.
     setUpProcess();
@@ -369,6 +372,26 @@ void WindowImplCocoa::mouseMovedAt(int x, int y)
     pushEvent(event);
 }
 
+
+////////////////////////////////////////////////////////////
+void WindowImplCocoa::mouseMovedBy(float deltaX, float deltaY)
+{
+    if (!m_rawMouseInput)
+        return;
+
+    int x = static_cast<int>(std::floor(deltaX + 0.5f));
+    int y = static_cast<int>(std::floor(deltaY + 0.5f));
+    if ((x == 0) && (y == 0))
+        return;
+
+    Event event;
+    event.type = Event::MouseMovedRaw;
+    event.mouseMoveRaw.deltaX = x;
+    event.mouseMoveRaw.deltaY = y;
+
+    pushEvent(event);
+}
+
 ////////////////////////////////////////////////////////////
 void WindowImplCocoa::mouseWheelScrolledAt(float deltaX, float deltaY, int x, int y)
 {
@@ -470,6 +493,15 @@ void WindowImplCocoa::processEvents()
     drainCurrentPool(); // Reduce memory footprint
 }
 
+
+////////////////////////////////////////////////////////////
+void WindowImplCocoa::waitEvents()
+{
+    // Return as soon as an event arrives; the joysticks
+    // can't signal their changes, they are polled every 10 milliseconds
+    [SFApplication waitEvent:0.01];
+}
+
 #pragma mark
 #pragma mark WindowImplCocoa's private methods
 
@@ -568,6 +600,15 @@ void WindowImplCocoa::setKeyRepeatEnabled(bool enabled)
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImplCocoa::setMouseRawInputEnabled(bool enabled)
+{
+    // The deltas of the mouse events are not limited by the screen
+    // borders, so there is nothing to set up on the system side
+    m_rawMouseInput = enabled;
+}
+
+
 ////////////////////////////////////////////////////////////
 void WindowImplCocoa::requestFocus()
 {
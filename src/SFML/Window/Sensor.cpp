@@ -44,6 +44,12 @@ void Sensor::setEnabled(Type sensor, bool enabled)
     return priv::SensorManager::getInstance().setEnabled(sensor, enabled);
 }
 
+////////////////////////////////////////////////////////////
+void Sensor::setEnabled(Type sensor, bool enabled, Time interval, Time maxReportLatency)
+{
+    return priv::SensorManager::getInstance().setEnabled(sensor, enabled, interval, maxReportLatency);
+}
+
 ////////////////////////////////////////////////////////////
 Vector3f Sensor::getValue(Type sensor)
 {
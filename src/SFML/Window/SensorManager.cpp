@@ -50,10 +50,19 @@ bool SensorManager::isAvailable(Sensor::Type sensor)
 
 ////////////////////////////////////////////////////////////
 void SensorManager::setEnabled(Sensor::Type sensor, bool enabled)
+{
+    setEnabled(sensor, enabled, Time::Zero, Time::Zero);
+}
+
+
+////////////////////////////////////////////////////////////
+void SensorManager::setEnabled(Sensor::Type sensor, bool enabled, Time interval, Time maxReportLatency)
 {
     if (m_sensors[sensor].available)
     {
         m_sensors[sensor].enabled = enabled;
+        if (enabled)
+            m_sensors[sensor].sensor.setRate(interval, maxReportLatency);
         m_sensors[sensor].sensor.setEnabled(enabled);
     }
     else
@@ -72,6 +72,17 @@ public:
     ////////////////////////////////////////////////////////////
     void setEnabled(Sensor::Type sensor, bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable a sensor with a custom sampling rate
+    ///
+    /// \param sensor           Sensor to modify
+    /// \param enabled          Whether it should be enabled or not
+    /// \param interval         Requested delay between two samples (zero for the fastest)
+    /// \param maxReportLatency Maximum delay before batched samples are reported
+    ///
+    ////////////////////////////////////////////////////////////
+    void setEnabled(Sensor::Type sensor, bool enabled, Time interval, Time maxReportLatency);
+
     ////////////////////////////////////////////////////////////
     /// \brief Check if a sensor is enabled
     ///
@@ -243,6 +243,21 @@ Display* OpenDisplay()
 }
 
 
+////////////////////////////////////////////////////////////
+bool isDisplayAvailable()
+{
+    if (referenceCount > 0)
+        return true;
+
+    Display* display = XOpenDisplay(NULL);
+    if (!display)
+        return false;
+
+    XCloseDisplay(display);
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 xcb_connection_t* OpenConnection()
 {
@@ -47,6 +47,17 @@ namespace priv
 ////////////////////////////////////////////////////////////
 Display* OpenDisplay();
 
+////////////////////////////////////////////////////////////
+/// \brief Check whether an X display can be opened
+///
+/// Unlike OpenDisplay, this function doesn't abort the
+/// program when there is no display server.
+///
+/// \return True if the display is available
+///
+////////////////////////////////////////////////////////////
+bool isDisplayAvailable();
+
 ////////////////////////////////////////////////////////////
 /// \brief Get the xcb connection of the shared Display
 ///
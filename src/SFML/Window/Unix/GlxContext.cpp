@@ -30,7 +30,13 @@
 #include <SFML/Window/Unix/Display.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
+#include <SFML/System/ReadLock.hpp>
+#include <SFML/System/ReadWriteMutex.hpp>
+#include <SFML/System/WriteLock.hpp>
 #include <SFML/System/Err.hpp>
+#include <map>
+#include <string>
+#include <utility>
 
 #if !defined(GLX_DEBUGGING) && defined(SFML_DEBUG)
     // Enable this to print messages to err() everytime GLX produces errors
@@ -71,6 +77,97 @@ namespace
         ::Display* m_display;
         int      (*m_previousHandler)(::Display*, XErrorEvent*);
     };
+
+    // Parameters of a visual selection, the X server is identified
+    // by its name since the same display can be closed and reopened
+    struct VisualKey
+    {
+        std::string  display;
+        unsigned int bitsPerPixel;
+        unsigned int depthBits;
+        unsigned int stencilBits;
+        unsigned int antialiasingLevel;
+
+        bool operator <(const VisualKey& other) const
+        {
+            if (display != other.display)
+                return display < other.display;
+            if (bitsPerPixel != other.bitsPerPixel)
+                return bitsPerPixel < other.bitsPerPixel;
+            if (depthBits != other.depthBits)
+                return depthBits < other.depthBits;
+            if (stencilBits != other.stencilBits)
+                return stencilBits < other.stencilBits;
+            return antialiasingLevel < other.antialiasingLevel;
+        }
+    };
+
+    // Visual IDs are defined by the server, so they stay valid across connections;
+    // the results of the evaluations are cached since they never change
+    typedef std::map<VisualKey, std::pair<int, VisualID> > VisualCache;
+    typedef std::map<std::pair<std::string, VisualID>, int> FBConfigCache;
+    VisualCache visualCache;
+    FBConfigCache fbConfigCache;
+    sf::ReadWriteMutex cacheMutex;
+
+    // Find the visual of an ID, on the given screen
+    bool getVisualFromId(::Display* display, int screen, VisualID visualId, XVisualInfo& visualInfo)
+    {
+        XVisualInfo tpl;
+        tpl.screen   = screen;
+        tpl.visualid = visualId;
+        int count = 0;
+        XVisualInfo* visuals = XGetVisualInfo(display, VisualIDMask | VisualScreenMask, &tpl, &count);
+        if (!visuals)
+            return false;
+
+        visualInfo = visuals[0];
+        XFree(visuals);
+
+        return true;
+    }
+
+    // Get the ID of the GLXFBConfig that corresponds to a visual, 0 if there's none
+    int getFBConfigId(::Display* display, int screen, VisualID visualId)
+    {
+        std::pair<std::string, VisualID> key(DisplayString(display), visualId);
+
+        {
+            sf::ReadLock lock(cacheMutex);
+
+            FBConfigCache::const_iterator it = fbConfigCache.find(key);
+            if (it != fbConfigCache.end())
+                return it->second;
+        }
+
+        // We don't supply attributes to match against, since
+        // the visual we are matching against was already
+        // deemed suitable in selectBestVisual()
+        int configId = 0;
+        int nbConfigs = 0;
+        GLXFBConfig* configs = glXChooseFBConfig(display, screen, NULL, &nbConfigs);
+
+        for (int i = 0; configs && (i < nbConfigs) && !configId; ++i)
+        {
+            XVisualInfo* visual = glXGetVisualFromFBConfig(display, configs[i]);
+
+            if (!visual)
+                continue;
+
+            if (visual->visualid == visualId)
+                glXGetFBConfigAttrib(display, configs[i], GLX_FBCONFIG_ID, &configId);
+
+            XFree(visual);
+        }
+
+        if (configs)
+            XFree(configs);
+
+        sf::WriteLock lock(cacheMutex);
+        fbConfigCache[key] = configId;
+
+        return configId;
+    }
 }
 
 
@@ -273,8 +370,29 @@ void GlxContext::display()
 ////////////////////////////////////////////////////////////
 void GlxContext::setVerticalSyncEnabled(bool enabled)
 {
-    // Make sure that extensions are initialized
-    ensureExtensionsInit(m_display, DefaultScreen(m_display));
+    if (isSwapIntervalSupported(enabled ? 1 : 0))
+    {
+        setSwapInterval(enabled ? 1 : 0);
+    }
+    else
+    {
+        static bool warned = false;
+
+        if (!warned)
+        {
+            err() << "Setting vertical sync not supported" << std::endl;
+
+            warned = true;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlxContext::setSwapInterval(int interval)
+{
+    if (!isSwapIntervalSupported(interval))
+        return false;
 
     int result = 0;
 
@@ -284,36 +402,64 @@ void GlxContext::setVerticalSyncEnabled(bool enabled)
     // which would require us to link in an additional library
     if (sfglx_ext_EXT_swap_control == sfglx_LOAD_SUCCEEDED)
     {
-        glXSwapIntervalEXT(m_display, glXGetCurrentDrawable(), enabled ? 1 : 0);
+        glXSwapIntervalEXT(m_display, glXGetCurrentDrawable(), interval);
     }
     else if (sfglx_ext_MESA_swap_control == sfglx_LOAD_SUCCEEDED)
     {
-        result = sf_ptrc_glXSwapIntervalMESA(enabled ? 1 : 0);
-    }
-    else if (sfglx_ext_SGI_swap_control == sfglx_LOAD_SUCCEEDED)
-    {
-        result = glXSwapIntervalSGI(enabled ? 1 : 0);
+        result = sf_ptrc_glXSwapIntervalMESA(interval);
     }
     else
     {
-        static bool warned = false;
-
-        if (!warned)
-        {
-            err() << "Setting vertical sync not supported" << std::endl;
-
-            warned = true;
-        }
+        result = glXSwapIntervalSGI(interval);
     }
 
     if (result != 0)
         err() << "Setting vertical sync failed" << std::endl;
+
+    return result == 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlxContext::isSwapIntervalSupported(int interval)
+{
+    // Make sure that extensions are initialized
+    ensureExtensionsInit(m_display, DefaultScreen(m_display));
+
+    // Negative intervals (late swaps tear) are only defined for the EXT variant
+    if (interval < 0)
+        return (sfglx_ext_EXT_swap_control == sfglx_LOAD_SUCCEEDED) &&
+               (sfglx_ext_EXT_swap_control_tear == sfglx_LOAD_SUCCEEDED);
+
+    if ((sfglx_ext_EXT_swap_control == sfglx_LOAD_SUCCEEDED) ||
+        (sfglx_ext_MESA_swap_control == sfglx_LOAD_SUCCEEDED))
+        return true;
+
+    // SGI doesn't allow disabling the synchronization
+    return (sfglx_ext_SGI_swap_control == sfglx_LOAD_SUCCEEDED) && (interval > 0);
 }
 
 
 ////////////////////////////////////////////////////////////
 XVisualInfo GlxContext::selectBestVisual(::Display* display, unsigned int bitsPerPixel, const ContextSettings& settings)
 {
+    VisualKey key;
+    key.display           = DisplayString(display);
+    key.bitsPerPixel      = bitsPerPixel;
+    key.depthBits         = settings.depthBits;
+    key.stencilBits       = settings.stencilBits;
+    key.antialiasingLevel = settings.antialiasingLevel;
+
+    // If the same parameters were already evaluated, reuse the result
+    {
+        ReadLock lock(cacheMutex);
+
+        VisualCache::const_iterator it = visualCache.find(key);
+        XVisualInfo cachedVisual;
+        if ((it != visualCache.end()) && getVisualFromId(display, it->second.first, it->second.second, cachedVisual))
+            return cachedVisual;
+    }
+
     // Retrieve all the visuals
     int count;
     XVisualInfo* visuals = XGetVisualInfo(display, 0, NULL, &count);
@@ -368,6 +514,13 @@ XVisualInfo GlxContext::selectBestVisual(::Display* display, unsigned int bitsPe
         // Free the array of visuals
         XFree(visuals);
 
+        // Remember the choice for the next contexts and windows
+        if (bestScore != 0x7FFFFFFF)
+        {
+            WriteLock lock(cacheMutex);
+            visualCache[key] = std::make_pair(bestVisual.screen, bestVisual.visualid);
+        }
+
         return bestVisual;
     }
     else
@@ -431,25 +584,23 @@ void GlxContext::createContext(GlxContext* shared, unsigned int bitsPerPixel, co
     {
         // Get a GLXFBConfig that matches the the window's visual, for glXCreateContextAttribsARB
         GLXFBConfig* config = NULL;
+        GLXFBConfig* configs = NULL;
 
-        // We don't supply attributes to match against, since
-        // the visual we are matching against was already
-        // deemed suitable in selectBestVisual()
-        int nbConfigs = 0;
-        GLXFBConfig* configs = glXChooseFBConfig(m_display, DefaultScreen(m_display), NULL, &nbConfigs);
-
-        for (int i = 0; configs && (i < nbConfigs); ++i)
+        // The matching config is looked up once per visual, then selected directly by its ID
+        int configId = getFBConfigId(m_display, DefaultScreen(m_display), visualInfo->visualid);
+        if (configId)
         {
-            XVisualInfo* visual = glXGetVisualFromFBConfig(m_display, configs[i]);
+            int configAttributes[] =
+            {
+                GLX_FBCONFIG_ID, configId,
+                0,               0
+            };
 
-            if (!visual)
-                continue;
+            int nbConfigs = 0;
+            configs = glXChooseFBConfig(m_display, DefaultScreen(m_display), configAttributes, &nbConfigs);
 
-            if (visual->visualid == visualInfo->visualid)
-            {
-                config = &configs[i];
-                break;
-            }
+            if (configs && (nbConfigs > 0))
+                config = &configs[0];
         }
 
         if (!config)
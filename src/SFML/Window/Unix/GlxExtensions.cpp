@@ -37,6 +37,7 @@ static sf::GlFunctionPointer IntGetProcAddress(const char* name)
 }
 
 int sfglx_ext_EXT_swap_control = sfglx_LOAD_FAILED;
+int sfglx_ext_EXT_swap_control_tear = sfglx_LOAD_FAILED;
 int sfglx_ext_MESA_swap_control = sfglx_LOAD_FAILED;
 int sfglx_ext_SGI_swap_control = sfglx_LOAD_FAILED;
 int sfglx_ext_ARB_multisample = sfglx_LOAD_FAILED;
@@ -91,8 +92,9 @@ typedef struct sfglx_StrToExtMap_s
     PFN_LOADFUNCPOINTERS LoadExtension;
 } sfglx_StrToExtMap;
 
-static sfglx_StrToExtMap ExtensionMap[6] = {
+static sfglx_StrToExtMap ExtensionMap[7] = {
     {"GLX_EXT_swap_control", &sfglx_ext_EXT_swap_control, Load_EXT_swap_control},
+    {"GLX_EXT_swap_control_tear", &sfglx_ext_EXT_swap_control_tear, NULL},
     {"GLX_MESA_swap_control", &sfglx_ext_MESA_swap_control, Load_MESA_swap_control},
     {"GLX_SGI_swap_control", &sfglx_ext_SGI_swap_control, Load_SGI_swap_control},
     {"GLX_ARB_multisample", &sfglx_ext_ARB_multisample, NULL},
@@ -100,7 +102,7 @@ static sfglx_StrToExtMap ExtensionMap[6] = {
     {"GLX_ARB_create_context_profile", &sfglx_ext_ARB_create_context_profile, NULL},
 };
 
-static int g_extensionMapSize = 6;
+static int g_extensionMapSize = 7;
 
 static sfglx_StrToExtMap *FindExtEntry(const char *extensionName)
 {
@@ -118,6 +120,7 @@ static sfglx_StrToExtMap *FindExtEntry(const char *extensionName)
 static void ClearExtensionVars(void)
 {
     sfglx_ext_EXT_swap_control = sfglx_LOAD_FAILED;
+    sfglx_ext_EXT_swap_control_tear = sfglx_LOAD_FAILED;
     sfglx_ext_MESA_swap_control = sfglx_LOAD_FAILED;
     sfglx_ext_SGI_swap_control = sfglx_LOAD_FAILED;
     sfglx_ext_ARB_multisample = sfglx_LOAD_FAILED;
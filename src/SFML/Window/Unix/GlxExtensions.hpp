@@ -142,6 +142,7 @@ extern "C" {
 #endif /*__cplusplus*/
 
 extern int sfglx_ext_EXT_swap_control;
+extern int sfglx_ext_EXT_swap_control_tear;
 extern int sfglx_ext_MESA_swap_control;
 extern int sfglx_ext_SGI_swap_control;
 extern int sfglx_ext_ARB_multisample;
@@ -151,6 +152,8 @@ extern int sfglx_ext_ARB_create_context_profile;
 #define GLX_MAX_SWAP_INTERVAL_EXT 0x20F2
 #define GLX_SWAP_INTERVAL_EXT 0x20F1
 
+#define GLX_LATE_SWAPS_TEAR_EXT 0x20F3
+
 #define GLX_SAMPLES_ARB 100001
 #define GLX_SAMPLE_BUFFERS_ARB 100000
 
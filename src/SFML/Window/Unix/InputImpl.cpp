@@ -166,6 +166,64 @@ namespace
 
         mapBuilt = true;
     }
+
+    bool isButtonInMask(uint16_t mask, sf::Mouse::Button button)
+    {
+        switch (button)
+        {
+            case sf::Mouse::Left:     return (mask & XCB_BUTTON_MASK_1) != 0;
+            case sf::Mouse::Right:    return (mask & XCB_BUTTON_MASK_3) != 0;
+            case sf::Mouse::Middle:   return (mask & XCB_BUTTON_MASK_2) != 0;
+            case sf::Mouse::XButton1: return false; // not supported by X
+            case sf::Mouse::XButton2: return false; // not supported by X
+            default:                  return false;
+        }
+    }
+
+    sf::Mouse::State queryMouseState(xcb_window_t window, bool desktopCoordinates)
+    {
+        // Open a connection with the X server
+        xcb_connection_t* connection = sf::priv::OpenConnection();
+
+        if (!window)
+            window = XCBDefaultRootWindow(connection);
+
+        sf::priv::ScopedXcbPtr<xcb_generic_error_t> error(NULL);
+
+        // Buttons and position come with the same reply
+        sf::priv::ScopedXcbPtr<xcb_query_pointer_reply_t> pointer(
+            xcb_query_pointer_reply(
+                connection,
+                xcb_query_pointer(
+                    connection,
+                    window
+                ),
+                &error
+            )
+        );
+
+        // Close the connection with the X server
+        sf::priv::CloseConnection(connection);
+
+        sf::Mouse::State state;
+
+        if (error)
+        {
+            sf::err() << "Failed to query pointer" << std::endl;
+
+            return state;
+        }
+
+        for (int i = 0; i < sf::Mouse::ButtonCount; ++i)
+            state.buttons[i] = isButtonInMask(pointer->mask, static_cast<sf::Mouse::Button>(i));
+
+        if (desktopCoordinates)
+            state.position = sf::Vector2i(pointer->root_x, pointer->root_y);
+        else
+            state.position = sf::Vector2i(pointer->win_x, pointer->win_y);
+
+        return state;
+    }
 }
 
 
@@ -215,6 +273,48 @@ bool InputImpl::isKeyPressed(Keyboard::Key key)
 }
 
 
+////////////////////////////////////////////////////////////
+Keyboard::State InputImpl::getKeyboardState()
+{
+    if (!mapBuilt)
+        buildMap();
+
+    ScopedXcbPtr<xcb_generic_error_t> error(NULL);
+
+    // Open a connection with the X server
+    xcb_connection_t* connection = OpenConnection();
+
+    // A single round-trip gives the state of all the keys
+    ScopedXcbPtr<xcb_query_keymap_reply_t> keymap(
+        xcb_query_keymap_reply(
+            connection,
+            xcb_query_keymap(connection),
+            &error
+        )
+    );
+
+    // Close the connection with the X server
+    CloseConnection(connection);
+
+    Keyboard::State state;
+
+    if (error)
+    {
+        err() << "Failed to query keymap" << std::endl;
+
+        return state;
+    }
+
+    for (int i = 0; i < Keyboard::KeyCount; ++i)
+    {
+        xcb_keycode_t keycode = keycodeMap[i];
+        state.keys[i] = (keymap->keys[keycode / 8] & (1 << (keycode % 8))) != 0;
+    }
+
+    return state;
+}
+
+
 ////////////////////////////////////////////////////////////
 void InputImpl::setVirtualKeyboardVisible(bool /*visible*/)
 {
@@ -252,17 +352,7 @@ bool InputImpl::isMouseButtonPressed(Mouse::Button button)
         return false;
     }
 
-    uint16_t buttons = pointer->mask;
-
-    switch (button)
-    {
-        case Mouse::Left:     return buttons & XCB_BUTTON_MASK_1;
-        case Mouse::Right:    return buttons & XCB_BUTTON_MASK_3;
-        case Mouse::Middle:   return buttons & XCB_BUTTON_MASK_2;
-        case Mouse::XButton1: return false; // not supported by X
-        case Mouse::XButton2: return false; // not supported by X
-        default:              return false;
-    }
+    return isButtonInMask(pointer->mask, button);
 }
 
 
@@ -340,6 +430,24 @@ Vector2i InputImpl::getMousePosition(const Window& relativeTo)
 }
 
 
+////////////////////////////////////////////////////////////
+Mouse::State InputImpl::getMouseState()
+{
+    return queryMouseState(0, true);
+}
+
+
+////////////////////////////////////////////////////////////
+Mouse::State InputImpl::getMouseState(const Window& relativeTo)
+{
+    WindowHandle handle = relativeTo.getSystemHandle();
+    if (handle)
+        return queryMouseState(handle, false);
+    else
+        return Mouse::State();
+}
+
+
 ////////////////////////////////////////////////////////////
 void InputImpl::setMousePosition(const Vector2i& position)
 {
@@ -26,12 +26,15 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/JoystickImpl.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
 #include <linux/joystick.h>
 #include <libudev.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <poll.h>
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <cstring>
@@ -43,14 +46,32 @@ namespace
 
     struct JoystickRecord
     {
+        JoystickRecord() : plugged(false), cached(false) {}
+
         std::string deviceNode;
         std::string systemPath;
         bool plugged;
+
+        // Properties queried when the device is first opened, until it is plugged again
+        bool cached;
+        char mapping[ABS_MAX + 1];
+        sf::priv::JoystickCaps capabilities;
+        sf::Joystick::Identification identification;
     };
 
     typedef std::vector<JoystickRecord> JoystickList;
     JoystickList joystickList;
 
+    // File descriptors of the opened joysticks
+    std::vector<int> openedFiles;
+
+    // Set until the joysticks found by the initial scan are opened
+    bool initialUpdate = false;
+
+    // Without the udev monitor, the devices are scanned again at this rate
+    sf::Clock scanTimer;
+    const sf::Time connectionRefreshDelay = sf::milliseconds(500);
+
     bool isJoystick(udev_device* udevDevice)
     {
         // If anything goes wrong, we go safe and return true
@@ -138,6 +159,7 @@ namespace
 
                                 record->plugged = true;
                                 record->systemPath = syspath ? syspath : "";
+                                record->cached = false;
                                 break;
                             }
                             else if (std::strstr(action, "remove"))
@@ -225,6 +247,13 @@ namespace
                 {
                     if (record->deviceNode == devnode)
                     {
+                        // A new system path means that another device was plugged
+                        if (record->systemPath != syspath)
+                        {
+                            record->systemPath = syspath;
+                            record->cached = false;
+                        }
+
                         record->plugged = true;
                         break;
                     }
@@ -262,6 +291,25 @@ namespace
                FD_ISSET(monitorFd, &descriptorSet);
     }
 
+    // Apply the connections and disconnections reported by the udev monitor
+    void processMonitorEvents()
+    {
+        while (hasMonitorEvent())
+        {
+            udev_device* udevDevice = udev_monitor_receive_device(udevMonitor);
+
+            // If we can't get the specific device, a full scan finds all the changes
+            if (!udevDevice)
+            {
+                updatePluggedList();
+                break;
+            }
+
+            updatePluggedList(udevDevice);
+            udev_device_unref(udevDevice);
+        }
+    }
+
     // Get a property value from a udev device
     const char* getUdevAttribute(udev_device* udevDevice, const std::string& attributeName)
     {
@@ -391,27 +439,17 @@ namespace
         return 0;
     }
 
-    // Get the joystick name
-    std::string getJoystickName(unsigned int index)
+    // Get the joystick name, from its opened file if possible
+    std::string getJoystickName(unsigned int index, int file)
     {
         std::string devnode = joystickList[index].deviceNode;
 
         // First try using ioctl with JSIOCGNAME
-        int fd = ::open(devnode.c_str(), O_RDONLY | O_NONBLOCK);
-
-        if (fd >= 0)
-        {
-            // Get the name
-            char name[128];
-            std::memset(name, 0, sizeof(name));
-
-            int result = ioctl(fd, JSIOCGNAME(sizeof(name)), name);
+        char name[128];
+        std::memset(name, 0, sizeof(name));
 
-            ::close(fd);
-
-            if (result >= 0)
-                return std::string(name);
-        }
+        if (ioctl(file, JSIOCGNAME(sizeof(name)), name) >= 0)
+            return std::string(name);
 
         // Fall back to manual USB chain walk via udev
         if (udevContext)
@@ -432,6 +470,42 @@ namespace
 
         return std::string("Unknown Joystick");
     }
+
+    // Get the capabilities of an opened joystick
+    sf::priv::JoystickCaps getJoystickCapabilities(int file, const char* mapping)
+    {
+        sf::priv::JoystickCaps caps;
+
+        // Get the number of buttons
+        char buttonCount = 0;
+        ioctl(file, JSIOCGBUTTONS, &buttonCount);
+        caps.buttonCount = buttonCount;
+        if (caps.buttonCount > sf::Joystick::ButtonCount)
+            caps.buttonCount = sf::Joystick::ButtonCount;
+
+        // Get the supported axes
+        char axesCount = 0;
+        ioctl(file, JSIOCGAXES, &axesCount);
+        for (int i = 0; i < axesCount; ++i)
+        {
+            switch (mapping[i])
+            {
+                case ABS_X:        caps.axes[sf::Joystick::X]    = true; break;
+                case ABS_Y:        caps.axes[sf::Joystick::Y]    = true; break;
+                case ABS_Z:
+                case ABS_THROTTLE: caps.axes[sf::Joystick::Z]    = true; break;
+                case ABS_RZ:
+                case ABS_RUDDER:   caps.axes[sf::Joystick::R]    = true; break;
+                case ABS_RX:       caps.axes[sf::Joystick::U]    = true; break;
+                case ABS_RY:       caps.axes[sf::Joystick::V]    = true; break;
+                case ABS_HAT0X:    caps.axes[sf::Joystick::PovX] = true; break;
+                case ABS_HAT0Y:    caps.axes[sf::Joystick::PovY] = true; break;
+                default:           break;
+            }
+        }
+
+        return caps;
+    }
 }
 
 
@@ -483,6 +557,8 @@ void JoystickImpl::initialize()
 
     // Do an initial scan
     updatePluggedList();
+    scanTimer.restart();
+    initialUpdate = true;
 }
 
 
@@ -508,30 +584,77 @@ void JoystickImpl::cleanup()
 ////////////////////////////////////////////////////////////
 bool JoystickImpl::isConnected(unsigned int index)
 {
-    // See if we can skip scanning if udev monitor is available
-    if (!udevMonitor)
+    // The list is kept up to date by isUpdateNeeded, which runs before
+    if (index >= joystickList.size())
+        return false;
+
+    return joystickList[index].plugged;
+}
+
+
+////////////////////////////////////////////////////////////
+bool JoystickImpl::isUpdateNeeded()
+{
+    if (initialUpdate)
     {
-        // udev monitor is not available, perform a scan every query
-        updatePluggedList();
+        initialUpdate = false;
+        return true;
     }
-    else if (hasMonitorEvent())
+
+    // Without the monitor, the connections are found by scanning the devices
+    if (udevContext && !udevMonitor && (scanTimer.getElapsedTime() >= connectionRefreshDelay))
     {
-        // Check if new joysticks were added/removed since last update
-        udev_device* udevDevice = udev_monitor_receive_device(udevMonitor);
+        updatePluggedList();
+        scanTimer.restart();
+        return true;
+    }
 
-        // If we can get the specific device, we check that,
-        // otherwise just do a full scan if udevDevice == NULL
-        updatePluggedList(udevDevice);
+    // Otherwise, only the joystick and monitor events can change something
+    pollfd descriptors[Joystick::Count + 1];
+    nfds_t count = 0;
+    for (std::vector<int>::const_iterator it = openedFiles.begin(); it != openedFiles.end(); ++it)
+    {
+        descriptors[count].fd      = *it;
+        descriptors[count].events  = POLLIN;
+        descriptors[count].revents = 0;
+        ++count;
+    }
 
-        if (udevDevice)
-            udev_device_unref(udevDevice);
+    if (udevMonitor)
+    {
+        descriptors[count].fd      = udev_monitor_get_fd(udevMonitor);
+        descriptors[count].events  = POLLIN;
+        descriptors[count].revents = 0;
+        ++count;
     }
 
-    if (index >= joystickList.size())
+    // Errors and disconnections are reported as events too
+    if ((count == 0) || (poll(descriptors, count, 0) == 0))
         return false;
 
-    // Then check if the joystick is connected
-    return joystickList[index].plugged;
+    // Apply the connections before the manager checks them
+    if (udevMonitor && descriptors[count - 1].revents)
+        processMonitorEvents();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool JoystickImpl::getWaitDescriptors(std::vector<int>& descriptors)
+{
+    descriptors.insert(descriptors.end(), openedFiles.begin(), openedFiles.end());
+
+    // Without udev, no joystick can be connected
+    if (!udevContext)
+        return true;
+
+    // Without the monitor, the connections are found by scanning the devices
+    if (!udevMonitor)
+        return false;
+
+    descriptors.push_back(udev_monitor_get_fd(udevMonitor));
+    return true;
 }
 
 ////////////////////////////////////////////////////////////
@@ -540,29 +663,45 @@ bool JoystickImpl::open(unsigned int index)
     if (index >= joystickList.size())
         return false;
 
-    if (joystickList[index].plugged)
+    JoystickRecord& record = joystickList[index];
+    if (record.plugged)
     {
-        std::string devnode = joystickList[index].deviceNode;
+        std::string devnode = record.deviceNode;
 
         // Open the joystick's file descriptor (read-only and non-blocking)
         m_file = ::open(devnode.c_str(), O_RDONLY | O_NONBLOCK);
         if (m_file >= 0)
         {
-            // Retrieve the axes mapping
-            ioctl(m_file, JSIOCGAXMAP, m_mapping);
+            // The properties of the device are only queried the first time it is opened
+            if (!record.cached)
+            {
+                // Retrieve the axes mapping
+                std::memset(record.mapping, 0, sizeof(record.mapping));
+                ioctl(m_file, JSIOCGAXMAP, record.mapping);
 
-            // Get info
-            m_identification.name = getJoystickName(index);
+                // Get info
+                record.capabilities = getJoystickCapabilities(m_file, record.mapping);
+                record.identification = Joystick::Identification();
+                record.identification.name = getJoystickName(index, m_file);
 
-            if (udevContext)
-            {
-                m_identification.vendorId  = getJoystickVendorId(index);
-                m_identification.productId = getJoystickProductId(index);
+                if (udevContext)
+                {
+                    record.identification.vendorId  = getJoystickVendorId(index);
+                    record.identification.productId = getJoystickProductId(index);
+                }
+
+                record.cached = true;
             }
 
+            std::memcpy(m_mapping, record.mapping, sizeof(m_mapping));
+            m_capabilities   = record.capabilities;
+            m_identification = record.identification;
+
             // Reset the joystick state
             m_state = JoystickState();
 
+            openedFiles.push_back(m_file);
+
             return true;
         }
         else
@@ -578,6 +717,8 @@ bool JoystickImpl::open(unsigned int index)
 ////////////////////////////////////////////////////////////
 void JoystickImpl::close()
 {
+    openedFiles.erase(std::remove(openedFiles.begin(), openedFiles.end(), m_file), openedFiles.end());
+
     ::close(m_file);
     m_file = -1;
 }
@@ -586,40 +727,7 @@ void JoystickImpl::close()
 ////////////////////////////////////////////////////////////
 JoystickCaps JoystickImpl::getCapabilities() const
 {
-    JoystickCaps caps;
-
-    if (m_file < 0)
-        return caps;
-
-    // Get the number of buttons
-    char buttonCount;
-    ioctl(m_file, JSIOCGBUTTONS, &buttonCount);
-    caps.buttonCount = buttonCount;
-    if (caps.buttonCount > Joystick::ButtonCount)
-        caps.buttonCount = Joystick::ButtonCount;
-
-    // Get the supported axes
-    char axesCount;
-    ioctl(m_file, JSIOCGAXES, &axesCount);
-    for (int i = 0; i < axesCount; ++i)
-    {
-        switch (m_mapping[i])
-        {
-            case ABS_X:        caps.axes[Joystick::X]    = true; break;
-            case ABS_Y:        caps.axes[Joystick::Y]    = true; break;
-            case ABS_Z:
-            case ABS_THROTTLE: caps.axes[Joystick::Z]    = true; break;
-            case ABS_RZ:
-            case ABS_RUDDER:   caps.axes[Joystick::R]    = true; break;
-            case ABS_RX:       caps.axes[Joystick::U]    = true; break;
-            case ABS_RY:       caps.axes[Joystick::V]    = true; break;
-            case ABS_HAT0X:    caps.axes[Joystick::PovX] = true; break;
-            case ABS_HAT0Y:    caps.axes[Joystick::PovY] = true; break;
-            default:           break;
-        }
-    }
-
-    return caps;
+    return m_capabilities;
 }
 
 
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/JoystickImpl.hpp>
 #include <linux/input.h>
+#include <vector>
 
 
 namespace sf
@@ -66,6 +67,30 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isConnected(unsigned int index);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the joysticks may have changed since the last update
+    ///
+    /// When this function returns false, updating the joysticks
+    /// would neither change their state nor connect new ones.
+    ///
+    /// \return True if the joysticks must be updated
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isUpdateNeeded();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the file descriptors that signal joystick changes
+    ///
+    /// The descriptors become readable when a joystick is
+    /// connected, disconnected or moved.
+    ///
+    /// \param descriptors Array to which the descriptors are appended
+    ///
+    /// \return True if the descriptors signal all the changes, false if the joysticks must also be polled
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool getWaitDescriptors(std::vector<int>& descriptors);
+
     ////////////////////////////////////////////////////////////
     /// \brief Open the joystick
     ///
@@ -114,6 +139,7 @@ private:
     int                          m_file;                 ///< File descriptor of the joystick
     char                         m_mapping[ABS_MAX + 1]; ///< Axes mapping (index to axis id)
     JoystickState                m_state;                ///< Current state of the joystick
+    JoystickCaps                 m_capabilities;         ///< Capabilities of the joystick
     sf::Joystick::Identification m_identification;       ///< Identification of the joystick
 };
 
@@ -83,6 +83,13 @@ void SensorImpl::setEnabled(bool /*enabled*/)
     // To be implemented
 }
 
+
+////////////////////////////////////////////////////////////
+void SensorImpl::setRate(Time /*interval*/, Time /*maxReportLatency*/)
+{
+    // To be implemented
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -29,22 +29,26 @@
 #include <SFML/Window/Unix/WindowImplX11.hpp>
 #include <SFML/Window/Unix/Display.hpp>
 #include <SFML/Window/Unix/ScopedXcbPtr.hpp>
+#include <SFML/Window/JoystickImpl.hpp>
 #include <SFML/System/Utf.hpp>
 #include <SFML/System/Err.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <xcb/xcb_image.h>
 #include <xcb/randr.h>
+#include <xcb/xinput.h>
 #include <X11/Xlibint.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include <libgen.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <algorithm>
 #include <vector>
 #include <string>
 #include <cstring>
+#include <cmath>
 
 // So we don't have to require xcb dri2 to be present
 #define XCB_DRI2_BUFFER_SWAP_COMPLETE 0
@@ -66,8 +70,14 @@ namespace
     sf::priv::WindowImplX11*              fullscreenWindow = NULL;
     std::vector<sf::priv::WindowImplX11*> allWindows;
     sf::Mutex                             allWindowsMutex;
+    unsigned int                          rawInputWindowCount = 0;
     sf::String                            windowManagerName;
 
+    // Offset from the clock of the X server to the event clock, in microseconds
+    sf::Mutex                             serverTimeMutex;
+    sf::Int64                             serverTimeOffset = 0;
+    bool                                  serverTimeKnown = false;
+
     bool mapBuilt = false;
 
     // We use a simple array instead of a map => constant time lookup
@@ -80,6 +90,27 @@ namespace
                                                       XCB_EVENT_MASK_KEY_RELEASE    | XCB_EVENT_MASK_STRUCTURE_NOTIFY |
                                                       XCB_EVENT_MASK_ENTER_WINDOW   | XCB_EVENT_MASK_LEAVE_WINDOW;
 
+    // Convert a time of the X server (in milliseconds) to the event clock
+    sf::Time convertServerTime(xcb_timestamp_t time)
+    {
+        sf::Lock lock(serverTimeMutex);
+
+        sf::Int64 now = sf::priv::WindowImpl::getEventTime().asMicroseconds();
+        sf::Int64 server = static_cast<sf::Int64>(time) * 1000;
+
+        // An event is always received after it happened, so the smallest
+        // offset seen is the closest to the actual one. A much larger one
+        // means that the server clock wrapped around or jumped backwards
+        sf::Int64 offset = now - server;
+        if (!serverTimeKnown || (offset < serverTimeOffset) || (offset > serverTimeOffset + 1000000))
+        {
+            serverTimeOffset = offset;
+            serverTimeKnown = true;
+        }
+
+        return sf::microseconds(server + serverTimeOffset);
+    }
+
     // Find the name of the current executable
     std::string findExecutableName()
     {
@@ -237,6 +268,63 @@ namespace
         return true;
     }
 
+    // Get the major opcode of the XInput extension, or 0 if XInput 2 is not available
+    uint8_t getXInputOpcode()
+    {
+        static bool    checked = false;
+        static uint8_t opcode  = 0;
+
+        if (checked)
+            return opcode;
+
+        checked = true;
+
+        xcb_connection_t* connection = sf::priv::OpenConnection();
+
+        const xcb_query_extension_reply_t* inputExt = xcb_get_extension_data(connection, &xcb_input_id);
+
+        if (inputExt && inputExt->present)
+        {
+            sf::priv::ScopedXcbPtr<xcb_generic_error_t> error(NULL);
+
+            // The server has to know which version we speak before sending XInput 2 events
+            sf::priv::ScopedXcbPtr<xcb_input_xi_query_version_reply_t> version(xcb_input_xi_query_version_reply(
+                connection,
+                xcb_input_xi_query_version(
+                    connection,
+                    2,
+                    2
+                ),
+                &error
+            ));
+
+            if (!error && version && (version->major_version >= 2))
+                opcode = inputExt->major_opcode;
+        }
+
+        // Close the connection with the X server
+        sf::priv::CloseConnection(connection);
+
+        return opcode;
+    }
+
+    // Select or deselect the raw motion events of all the mice on the root window
+    void selectRawMotion(xcb_connection_t* connection, bool enabled)
+    {
+        struct
+        {
+            xcb_input_event_mask_t header;
+            uint32_t               mask;
+        } eventMask;
+
+        eventMask.header.deviceid = XCB_INPUT_DEVICE_ALL_MASTER;
+        eventMask.header.mask_len = 1;
+        eventMask.mask            = enabled ? XCB_INPUT_XI_EVENT_MASK_RAW_MOTION : 0;
+
+        xcb_input_xi_select_events(connection, sf::priv::XCBDefaultRootWindow(connection), 1, &eventMask.header);
+        xcb_flush(connection);
+    }
+
     xcb_query_extension_reply_t getDriExtension()
     {
         xcb_connection_t* connection = sf::priv::OpenConnection();
@@ -507,7 +595,10 @@ m_hiddenCursor   (0),
 m_keyRepeat      (true),
 m_previousSize   (-1, -1),
 m_useSizeHints   (false),
-m_fullscreen     (false)
+m_fullscreen     (false),
+m_focused        (false),
+m_rawMouseInput  (false),
+m_urgent         (true)
 {
     // Open a connection with the X server
     m_display = OpenDisplay();
@@ -561,7 +652,10 @@ m_hiddenCursor   (0),
 m_keyRepeat      (true),
 m_previousSize   (-1, -1),
 m_useSizeHints   (false),
-m_fullscreen     ((style & Style::Fullscreen) != 0)
+m_fullscreen     ((style & Style::Fullscreen) != 0),
+m_focused        (false),
+m_rawMouseInput  (false),
+m_urgent         (false)
 {
     // Open a connection with the X server
     m_display = OpenDisplay();
@@ -696,6 +790,9 @@ WindowImplX11::~WindowImplX11()
     // Cleanup graphical resources
     cleanup();
 
+    // Stop receiving the raw mouse events, if they were enabled
+    setMouseRawInputEnabled(false);
+
     // Destroy the cursor
     if (m_hiddenCursor)
         xcb_free_cursor(m_connection, m_hiddenCursor);
@@ -739,20 +836,11 @@ void WindowImplX11::processEvents()
     // to check for the matching key press event and if so, discard the release
     // event.
 
-    xcb_generic_event_t* event = NULL;
+    bool connectionRead = false;
+    xcb_generic_event_t* event = pollEvent(connectionRead);
     xcb_key_release_event_t* lastKeyReleaseEvent = NULL;
     uint8_t eventType = 0;
 
-    if (!m_xcbEvents.empty())
-    {
-        event = m_xcbEvents.front();
-        m_xcbEvents.pop_front();
-    }
-    else
-    {
-        event = xcb_poll_for_event(m_connection);
-    }
-
     while (event)
     {
         eventType = event->response_type & ~0x80;
@@ -774,16 +862,7 @@ void WindowImplX11::processEvents()
                 {
                     free(event);
 
-                    if (!m_xcbEvents.empty())
-                    {
-                        event = m_xcbEvents.front();
-                        m_xcbEvents.pop_front();
-                    }
-                    else
-                    {
-                        event = xcb_poll_for_event(m_connection);
-                    }
-
+                    event = pollEvent(connectionRead);
                     continue;
                 }
             }
@@ -814,15 +893,7 @@ void WindowImplX11::processEvents()
                 free(event);
         }
 
-        if (!m_xcbEvents.empty())
-        {
-            event = m_xcbEvents.front();
-            m_xcbEvents.pop_front();
-        }
-        else
-        {
-            event = xcb_poll_for_event(m_connection);
-        }
+        event = pollEvent(connectionRead);
     }
 
     // Process any held back release event.
@@ -836,6 +907,33 @@ void WindowImplX11::processEvents()
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImplX11::waitEvents()
+{
+    // Events passed by the other windows are already there
+    if (!m_xcbEvents.empty())
+        return;
+
+    // The requests must reach the server before waiting for its answer
+    xcb_flush(m_connection);
+
+    // The buffers are reused, so that waiting doesn't allocate at every frame
+    m_waitFiles.assign(1, xcb_get_file_descriptor(m_connection));
+    bool signaled = JoystickImpl::getWaitDescriptors(m_waitFiles);
+
+    m_waitDescriptors.resize(m_waitFiles.size());
+    for (std::size_t i = 0; i < m_waitFiles.size(); ++i)
+    {
+        m_waitDescriptors[i].fd      = m_waitFiles[i];
+        m_waitDescriptors[i].events  = POLLIN;
+        m_waitDescriptors[i].revents = 0;
+    }
+
+    // Joysticks that can't signal their changes are polled every 10 milliseconds
+    poll(&m_waitDescriptors[0], m_waitDescriptors.size(), signaled ? -1 : 10);
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2i WindowImplX11::getPosition() const
 {
@@ -1196,6 +1294,28 @@ void WindowImplX11::setKeyRepeatEnabled(bool enabled)
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImplX11::setMouseRawInputEnabled(bool enabled)
+{
+    if (enabled == m_rawMouseInput)
+        return;
+
+    if (enabled && !getXInputOpcode())
+    {
+        err() << "Raw mouse input requires the XInput 2 extension" << std::endl;
+        return;
+    }
+
+    m_rawMouseInput = enabled;
+
+    // The selection on the root window is shared by all the windows of the connection
+    Lock lock(allWindowsMutex);
+
+    if (enabled ? (rawInputWindowCount++ == 0) : (--rawInputWindowCount == 0))
+        selectRawMotion(m_connection, enabled);
+}
+
+
 ////////////////////////////////////////////////////////////
 void WindowImplX11::requestFocus()
 {
@@ -1694,6 +1814,8 @@ void WindowImplX11::setMotifHints(unsigned long style)
 ////////////////////////////////////////////////////////////
 void WindowImplX11::setWMHints(const WMHints& hints)
 {
+    m_urgent = (hints.flags & (1 << 8)) != 0;
+
     if (!changeWindowProperty(XCB_ATOM_WM_HINTS, XCB_ATOM_WM_HINTS, 32, sizeof(hints) / 4, &hints))
         sf::err() << "Failed to set WM_HINTS property" << std::endl;
 }
@@ -1865,6 +1987,8 @@ bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
             if (passEvent(windowEvent, reinterpret_cast<xcb_focus_in_event_t*>(windowEvent)->event))
                 return false;
 
+            m_focused = true;
+
             // Update the input context
             if (m_inputContext)
                 XSetICFocus(m_inputContext);
@@ -1873,7 +1997,11 @@ bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
             event.type = Event::GainedFocus;
             pushEvent(event);
 
-            // If the window has been previously marked urgent (notification) as a result of a focus request, undo that
+            // If the window has been previously marked urgent (notification) as a result of a focus request, undo that.
+            // Reading the hints back waits for the server, so it is skipped when we know the flag isn't set
+            if (!m_urgent)
+                break;
+
             ScopedXcbPtr<xcb_generic_error_t> error(NULL);
 
             ScopedXcbPtr<xcb_get_property_reply_t> hintsReply(xcb_get_property_reply(
@@ -1910,6 +2038,8 @@ bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
             if (passEvent(windowEvent, reinterpret_cast<xcb_focus_out_event_t*>(windowEvent)->event))
                 return false;
 
+            m_focused = false;
+
             // Update the input context
             if (m_inputContext)
                 XUnsetICFocus(m_inputContext);
@@ -1988,6 +2118,7 @@ bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
                 return false;
 
             xcb_key_press_event_t* e = reinterpret_cast<xcb_key_press_event_t*>(windowEvent);
+            Time timestamp = convertServerTime(e->time);
 
             // Fill the event parameters
             // TODO: if modifiers are wrong, use XGetModifierMapping to retrieve the actual modifiers mapping
@@ -1998,7 +2129,7 @@ bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
             event.key.control = e->state & XCB_MOD_MASK_CONTROL;
             event.key.shift   = e->state & XCB_MOD_MASK_SHIFT;
             event.key.system  = e->state & XCB_MOD_MASK_4;
-            pushEvent(event);
+            pushEvent(event, timestamp);
 
             XEvent fakeEvent;
             fakeEvent.type = KeyPress;
@@ -2034,7 +2165,7 @@ bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
                             Event textEvent;
                             textEvent.type         = Event::TextEntered;
                             textEvent.text.unicode = unicode;
-                            pushEvent(textEvent);
+                            pushEvent(textEvent, timestamp);
                         }
                     }
                 }
@@ -2048,7 +2179,7 @@ bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
                         Event textEvent;
                         textEvent.type         = Event::TextEntered;
                         textEvent.text.unicode = static_cast<Uint32>(keyBuffer[0]);
-                        pushEvent(textEvent);
+                        pushEvent(textEvent, timestamp);
                     }
                 }
             }
@@ -2072,7 +2203,7 @@ bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
             event.key.control = e->state & XCB_MOD_MASK_CONTROL;
             event.key.shift   = e->state & XCB_MOD_MASK_SHIFT;
             event.key.system  = e->state & XCB_MOD_MASK_4;
-            pushEvent(event);
+            pushEvent(event, convertServerTime(e->time));
 
             break;
         }
@@ -2106,7 +2237,7 @@ bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
                 case 8:                  event.mouseButton.button = Mouse::XButton1; break;
                 case 9:                  event.mouseButton.button = Mouse::XButton2; break;
                 }
-                pushEvent(event);
+                pushEvent(event, convertServerTime(e->time));
             }
             break;
         }
@@ -2138,7 +2269,7 @@ bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
                 case 8:                  event.mouseButton.button = Mouse::XButton1; break;
                 case 9:                  event.mouseButton.button = Mouse::XButton2; break;
                 }
-                pushEvent(event);
+                pushEvent(event, convertServerTime(e->time));
             }
             else if ((button == XCB_BUTTON_INDEX_4) || (button == XCB_BUTTON_INDEX_5))
             {
@@ -2148,14 +2279,14 @@ bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
                 event.mouseWheel.delta = (button == XCB_BUTTON_INDEX_4) ? 1 : -1;
                 event.mouseWheel.x     = e->event_x;
                 event.mouseWheel.y     = e->event_y;
-                pushEvent(event);
+                pushEvent(event, convertServerTime(e->time));
 
                 event.type                   = Event::MouseWheelScrolled;
                 event.mouseWheelScroll.wheel = Mouse::VerticalWheel;
                 event.mouseWheelScroll.delta = (button == XCB_BUTTON_INDEX_4) ? 1 : -1;
                 event.mouseWheelScroll.x     = e->event_x;
                 event.mouseWheelScroll.y     = e->event_y;
-                pushEvent(event);
+                pushEvent(event, convertServerTime(e->time));
             }
             else if ((button == 6) || (button == 7))
             {
@@ -2165,7 +2296,7 @@ bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
                 event.mouseWheelScroll.delta = (button == 6) ? 1 : -1;
                 event.mouseWheelScroll.x     = e->event_x;
                 event.mouseWheelScroll.y     = e->event_y;
-                pushEvent(event);
+                pushEvent(event, convertServerTime(e->time));
             }
             break;
         }
@@ -2181,7 +2312,7 @@ bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
             event.type        = Event::MouseMoved;
             event.mouseMove.x = e->event_x;
             event.mouseMove.y = e->event_y;
-            pushEvent(event);
+            pushEvent(event, convertServerTime(e->time));
             break;
         }
 
@@ -2197,7 +2328,7 @@ bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
             {
                 Event event;
                 event.type = Event::MouseEntered;
-                pushEvent(event);
+                pushEvent(event, convertServerTime(enterNotifyEvent->time));
             }
             break;
         }
@@ -2214,7 +2345,7 @@ bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
             {
                 Event event;
                 event.type = Event::MouseLeft;
-                pushEvent(event);
+                pushEvent(event, convertServerTime(leaveNotifyEvent->time));
             }
             break;
         }
@@ -2251,6 +2382,51 @@ bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
 
             // Handle any extension events first
 
+            // XInput raw motion
+            if (responseType == XCB_GE_GENERIC)
+            {
+                xcb_ge_generic_event_t* genericEvent = reinterpret_cast<xcb_ge_generic_event_t*>(windowEvent);
+                uint8_t xinputOpcode = getXInputOpcode();
+
+                if (xinputOpcode && (genericEvent->extension == xinputOpcode) && (genericEvent->event_type == XCB_INPUT_RAW_MOTION))
+                {
+                    if (passRawEvent(windowEvent))
+                        return false;
+
+                    if (!m_rawMouseInput || !m_focused)
+                        return true;
+
+                    xcb_input_raw_motion_event_t* e = reinterpret_cast<xcb_input_raw_motion_event_t*>(windowEvent);
+
+                    // The values are only given for the valuators set in the mask;
+                    // the first two valuators of a mouse are its X and Y axes
+                    const uint32_t* valuators = xcb_input_raw_button_press_valuator_mask(e);
+                    const xcb_input_fp3232_t* values = xcb_input_raw_button_press_axisvalues_raw(e);
+                    int valuatorCount = xcb_input_raw_button_press_valuator_mask_length(e) * 32;
+
+                    double delta[2] = {0, 0};
+                    int index = 0;
+                    for (int i = 0; (i < 2) && (i < valuatorCount); ++i)
+                    {
+                        if (valuators[0] & (1u << i))
+                        {
+                            delta[i] = values[index].integral + values[index].frac / 4294967296.0;
+                            ++index;
+                        }
+                    }
+
+                    Event event;
+                    event.type                = Event::MouseMovedRaw;
+                    event.mouseMoveRaw.deltaX = static_cast<int>(std::floor(delta[0] + 0.5));
+                    event.mouseMoveRaw.deltaY = static_cast<int>(std::floor(delta[1] + 0.5));
+
+                    if (event.mouseMoveRaw.deltaX || event.mouseMoveRaw.deltaY)
+                        pushEvent(event, convertServerTime(e->time));
+
+                    return true;
+                }
+            }
+
             // DRI2
             static xcb_query_extension_reply_t driExtension = getDriExtension();
             if (driExtension.present)
@@ -2313,6 +2489,31 @@ bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
 }
 
 
+////////////////////////////////////////////////////////////
+xcb_generic_event_t* WindowImplX11::pollEvent(bool& connectionRead)
+{
+    if (!m_xcbEvents.empty())
+    {
+        xcb_generic_event_t* event = m_xcbEvents.front();
+        m_xcbEvents.pop_front();
+        return event;
+    }
+
+    // Events read along with previous events or replies are already queued
+    xcb_generic_event_t* event = xcb_poll_for_queued_event(m_connection);
+
+    // Read the connection once the queue is empty; everything the server sent
+    // so far is read at once, and returned by the next calls from the queue
+    if (!event && !connectionRead)
+    {
+        connectionRead = true;
+        event = xcb_poll_for_event(m_connection);
+    }
+
+    return event;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool WindowImplX11::passEvent(xcb_generic_event_t* windowEvent, xcb_window_t window)
 {
@@ -2339,6 +2540,28 @@ bool WindowImplX11::passEvent(xcb_generic_event_t* windowEvent, xcb_window_t win
     return false;
 }
 
+
+////////////////////////////////////////////////////////////
+bool WindowImplX11::passRawEvent(xcb_generic_event_t* windowEvent)
+{
+    if (m_rawMouseInput && m_focused)
+        return false;
+
+    Lock lock(allWindowsMutex);
+
+    for (std::vector<WindowImplX11*>::iterator i = allWindows.begin(); i != allWindows.end(); ++i)
+    {
+        if ((*i != this) && (*i)->m_rawMouseInput && (*i)->m_focused)
+        {
+            (*i)->m_xcbEvents.push_back(windowEvent);
+            return true;
+        }
+    }
+
+    // Nobody wants the event, it will be dropped
+    return false;
+}
+
 } // namespace priv
 
 } // namespace sf
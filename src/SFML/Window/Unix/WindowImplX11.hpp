@@ -33,7 +33,9 @@
 #include <SFML/System/String.hpp>
 #include <X11/Xlib-xcb.h>
 #include <xcb/randr.h>
+#include <poll.h>
 #include <deque>
+#include <vector>
 
 
 namespace sf
@@ -155,6 +157,14 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setKeyRepeatEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the raw mouse input
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setMouseRawInputEnabled(bool enabled);
+
     ////////////////////////////////////////////////////////////
     /// \brief Request the current window to be made the active
     ///        foreground window
@@ -178,6 +188,12 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void processEvents();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until new events may be available
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void waitEvents();
+
 private:
 
     struct WMHints
@@ -303,6 +319,23 @@ private:
     ////////////////////////////////////////////////////////////
     bool processEvent(xcb_generic_event_t* windowEvent);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the next event to process
+    ///
+    /// The events passed by other windows come first, then the
+    /// ones already read from the connection. The connection
+    /// is read only once they are exhausted, and only once per
+    /// call to processEvents (tracked by \a connectionRead), so
+    /// that draining a busy queue doesn't cost a system call
+    /// per event.
+    ///
+    /// \param connectionRead Has the connection already been read? Set to true when it is
+    ///
+    /// \return Next event, or NULL if there are no more events
+    ///
+    ////////////////////////////////////////////////////////////
+    xcb_generic_event_t* pollEvent(bool& connectionRead);
+
     ////////////////////////////////////////////////////////////
     /// \brief Pass an incoming event to another window
     ///
@@ -314,6 +347,19 @@ private:
     ////////////////////////////////////////////////////////////
     bool passEvent(xcb_generic_event_t* windowEvent, xcb_window_t window);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Pass a raw mouse event to the window that wants it
+    ///
+    /// Raw events are sent to the root window, so they go to
+    /// the focused window that enabled the raw mouse input.
+    ///
+    /// \param windowEvent Event which is being processed
+    ///
+    /// \return True if the event was passed to another window, false if it is destined for the current window
+    ///
+    ////////////////////////////////////////////////////////////
+    bool passRawEvent(xcb_generic_event_t* windowEvent);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -331,6 +377,11 @@ private:
     Vector2i                          m_previousSize;    ///< Previous size of the window, to find if a ConfigureNotify event is a resize event (could be a move event only)
     bool                              m_useSizeHints;    ///< Is the size of the window fixed with size hints?
     bool                              m_fullscreen;      ///< Is window in fullscreen?
+    bool                              m_focused;         ///< Does the window have the input focus (according to the last focus event)?
+    bool                              m_rawMouseInput;   ///< Are raw mouse events generated?
+    bool                              m_urgent;          ///< May the WM hints have the urgency flag? Gaining focus only reads them back in this case
+    std::vector<int>                  m_waitFiles;       ///< Files to wait on in waitEvents, kept to avoid allocating at each call
+    std::vector<pollfd>               m_waitDescriptors; ///< Poll descriptors of the files to wait on
 };
 
 } // namespace priv
@@ -54,6 +54,14 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isKeyPressed(Keyboard::Key key);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the state of all the keys at once
+    ///
+    /// \return State of the keyboard
+    ///
+    ////////////////////////////////////////////////////////////
+    static Keyboard::State getKeyboardState();
+
     ////////////////////////////////////////////////////////////
     /// \brief Show or hide the virtual keyboard
     ///
@@ -97,6 +105,24 @@ public:
     ////////////////////////////////////////////////////////////
     static Vector2i getMousePosition(const Window& relativeTo);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the buttons and the position of the mouse in desktop coordinates
+    ///
+    /// \return State of the mouse
+    ///
+    ////////////////////////////////////////////////////////////
+    static Mouse::State getMouseState();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the buttons and the position of the mouse in window coordinates
+    ///
+    /// \param relativeTo Reference window
+    ///
+    /// \return State of the mouse
+    ///
+    ////////////////////////////////////////////////////////////
+    static Mouse::State getMouseState(const Window& relativeTo);
+
     ////////////////////////////////////////////////////////////
     /// \brief Set the current position of the mouse in desktop coordinates
     ///
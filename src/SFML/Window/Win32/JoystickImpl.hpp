@@ -77,6 +77,17 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isConnected(unsigned int index);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the joysticks may have changed since the last update
+    ///
+    /// When this function returns false, updating the joysticks
+    /// would neither change their state nor connect new ones.
+    ///
+    /// \return True if the joysticks must be updated
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isUpdateNeeded();
+
     ////////////////////////////////////////////////////////////
     /// \brief Open the joystick
     ///
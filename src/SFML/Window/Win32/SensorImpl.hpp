@@ -91,6 +91,15 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     void setEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the sampling rate used the next time the sensor is enabled
+    ///
+    /// \param interval         Requested delay between two samples (zero for the fastest)
+    /// \param maxReportLatency Maximum delay before batched samples are reported
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRate(Time interval, Time maxReportLatency);
 };
 
 } // namespace priv
@@ -193,13 +193,9 @@ void WglContext::display()
 ////////////////////////////////////////////////////////////
 void WglContext::setVerticalSyncEnabled(bool enabled)
 {
-    // Make sure that extensions are initialized
-    ensureExtensionsInit(m_deviceContext);
-
-    if (sfwgl_ext_EXT_swap_control == sfwgl_LOAD_SUCCEEDED)
+    if (isSwapIntervalSupported(enabled ? 1 : 0))
     {
-        if (wglSwapIntervalEXT(enabled ? 1 : 0) == FALSE)
-            err() << "Setting vertical sync failed" << std::endl;
+        setSwapInterval(enabled ? 1 : 0);
     }
     else
     {
@@ -216,6 +212,36 @@ void WglContext::setVerticalSyncEnabled(bool enabled)
 }
 
 
+////////////////////////////////////////////////////////////
+bool WglContext::setSwapInterval(int interval)
+{
+    if (!isSwapIntervalSupported(interval))
+        return false;
+
+    if (wglSwapIntervalEXT(interval) == FALSE)
+    {
+        err() << "Setting vertical sync failed" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool WglContext::isSwapIntervalSupported(int interval)
+{
+    // Make sure that extensions are initialized
+    ensureExtensionsInit(m_deviceContext);
+
+    if (sfwgl_ext_EXT_swap_control != sfwgl_LOAD_SUCCEEDED)
+        return false;
+
+    // Negative intervals make the late swaps tear instead of waiting
+    return (interval >= 0) || (sfwgl_ext_EXT_swap_control_tear == sfwgl_LOAD_SUCCEEDED);
+}
+
+
 ////////////////////////////////////////////////////////////
 int WglContext::selectBestPixelFormat(HDC deviceContext, unsigned int bitsPerPixel, const ContextSettings& settings)
 {
@@ -118,6 +118,26 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setVerticalSyncEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of vertical blanks to wait for between two swaps
+    ///
+    /// \param interval Swap interval, negative for adaptive vertical synchronization
+    ///
+    /// \return True if the interval was applied, false if it is not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool setSwapInterval(int interval);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether a swap interval is supported by the context
+    ///
+    /// \param interval Swap interval to check
+    ///
+    /// \return True if setSwapInterval supports \a interval
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool isSwapIntervalSupported(int interval);
+
     ////////////////////////////////////////////////////////////
     /// \brief Select the best pixel format for a given set of settings
     ///
@@ -37,6 +37,7 @@ static sf::GlFunctionPointer IntGetProcAddress(const char* name)
 }
 
 int sfwgl_ext_EXT_swap_control = sfwgl_LOAD_FAILED;
+int sfwgl_ext_EXT_swap_control_tear = sfwgl_LOAD_FAILED;
 int sfwgl_ext_ARB_multisample = sfwgl_LOAD_FAILED;
 int sfwgl_ext_ARB_pixel_format = sfwgl_LOAD_FAILED;
 int sfwgl_ext_ARB_create_context = sfwgl_LOAD_FAILED;
@@ -92,15 +93,16 @@ typedef struct sfwgl_StrToExtMap_s
     PFN_LOADFUNCPOINTERS LoadExtension;
 } sfwgl_StrToExtMap;
 
-static sfwgl_StrToExtMap ExtensionMap[5] = {
+static sfwgl_StrToExtMap ExtensionMap[6] = {
     {"WGL_EXT_swap_control", &sfwgl_ext_EXT_swap_control, Load_EXT_swap_control},
+    {"WGL_EXT_swap_control_tear", &sfwgl_ext_EXT_swap_control_tear, NULL},
     {"WGL_ARB_multisample", &sfwgl_ext_ARB_multisample, NULL},
     {"WGL_ARB_pixel_format", &sfwgl_ext_ARB_pixel_format, Load_ARB_pixel_format},
     {"WGL_ARB_create_context", &sfwgl_ext_ARB_create_context, Load_ARB_create_context},
     {"WGL_ARB_create_context_profile", &sfwgl_ext_ARB_create_context_profile, NULL},
 };
 
-static int g_extensionMapSize = 5;
+static int g_extensionMapSize = 6;
 
 static sfwgl_StrToExtMap *FindExtEntry(const char *extensionName)
 {
@@ -118,6 +120,7 @@ static sfwgl_StrToExtMap *FindExtEntry(const char *extensionName)
 static void ClearExtensionVars(void)
 {
     sfwgl_ext_EXT_swap_control = sfwgl_LOAD_FAILED;
+    sfwgl_ext_EXT_swap_control_tear = sfwgl_LOAD_FAILED;
     sfwgl_ext_ARB_multisample = sfwgl_LOAD_FAILED;
     sfwgl_ext_ARB_pixel_format = sfwgl_LOAD_FAILED;
     sfwgl_ext_ARB_create_context = sfwgl_LOAD_FAILED;
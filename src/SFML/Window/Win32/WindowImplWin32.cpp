@@ -61,6 +61,7 @@ namespace
     unsigned int               windowCount      = 0;
     const wchar_t*             className        = L"SFML_Window";
     sf::priv::WindowImplWin32* fullscreenWindow = NULL;
+    sf::priv::WindowImplWin32* rawInputWindow   = NULL;
 
     void setProcessDpiAware()
     {
@@ -215,6 +216,10 @@ m_mouseInside     (false)
 ////////////////////////////////////////////////////////////
 WindowImplWin32::~WindowImplWin32()
 {
+    // Stop receiving the raw mouse input, if it was enabled
+    if (rawInputWindow == this)
+        setMouseRawInputEnabled(false);
+
     // Destroy the custom icon, if any
     if (m_icon)
         DestroyIcon(m_icon);
@@ -263,6 +268,15 @@ void WindowImplWin32::processEvents()
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImplWin32::waitEvents()
+{
+    // Return as soon as a message arrives; the joysticks
+    // can't signal their changes, they are polled every 10 milliseconds
+    MsgWaitForMultipleObjectsEx(0, NULL, 10, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2i WindowImplWin32::getPosition() const
 {
@@ -370,6 +384,30 @@ void WindowImplWin32::setKeyRepeatEnabled(bool enabled)
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImplWin32::setMouseRawInputEnabled(bool enabled)
+{
+    // The raw input devices are registered for the whole process,
+    // with a single target window: the last window that enabled them
+    if (!enabled && (rawInputWindow != this))
+        return;
+
+    RAWINPUTDEVICE device;
+    device.usUsagePage = 0x01; // Generic desktop controls
+    device.usUsage     = 0x02; // Mouse
+    device.dwFlags     = enabled ? 0 : RIDEV_REMOVE;
+    device.hwndTarget  = enabled ? m_handle : NULL;
+
+    if (!RegisterRawInputDevices(&device, 1, sizeof(device)))
+    {
+        err() << "Failed to " << (enabled ? "register" : "unregister") << " the raw mouse input" << std::endl;
+        return;
+    }
+
+    rawInputWindow = enabled ? this : NULL;
+}
+
+
 ////////////////////////////////////////////////////////////
 void WindowImplWin32::requestFocus()
 {
@@ -892,6 +930,28 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
             pushEvent(event);
             break;
         }
+
+        // Raw input event
+        case WM_INPUT:
+        {
+            RAWINPUT input;
+            UINT size = sizeof(input);
+
+            if (GetRawInputData(reinterpret_cast<HRAWINPUT>(lParam), RID_INPUT, &input, &size, sizeof(RAWINPUTHEADER)) == static_cast<UINT>(-1))
+                break;
+
+            // Only relative motions are raw (tablets and remote desktops send absolute positions)
+            if ((input.header.dwType == RIM_TYPEMOUSE) && !(input.data.mouse.usFlags & MOUSE_MOVE_ABSOLUTE) &&
+                (input.data.mouse.lLastX || input.data.mouse.lLastY))
+            {
+                Event event;
+                event.type                = Event::MouseMovedRaw;
+                event.mouseMoveRaw.deltaX = input.data.mouse.lLastX;
+                event.mouseMoveRaw.deltaY = input.data.mouse.lLastY;
+                pushEvent(event);
+            }
+            break;
+        }
     }
 }
 
@@ -153,6 +153,14 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setKeyRepeatEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the raw mouse input
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setMouseRawInputEnabled(bool enabled);
+
     ////////////////////////////////////////////////////////////
     /// \brief Request the current window to be made the active
     ///        foreground window
@@ -176,6 +184,12 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void processEvents();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until new events may be available
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void waitEvents();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -28,13 +28,19 @@
 #include <SFML/Window/Window.hpp>
 #include <SFML/Window/GlContext.hpp>
 #include <SFML/Window/WindowImpl.hpp>
+#include <SFML/System/Profiler.hpp>
 #include <SFML/System/Sleep.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 
 
 namespace
 {
     const sf::Window* fullscreenWindow = NULL;
+
+    // Bounds of the busy-waited part of the frame delay
+    const sf::Int64 minSleepMargin = 500;
+    const sf::Int64 maxSleepMargin = 4000;
 }
 
 
@@ -42,10 +48,16 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Window::Window() :
-m_impl          (NULL),
-m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
-m_size          (0, 0)
+m_impl           (NULL),
+m_context        (NULL),
+m_frameTimeLimit (Time::Zero),
+m_frameDeadline  (Time::Zero),
+m_frameEnd       (Time::Zero),
+m_sleepMargin    (Time::Zero),
+m_frameTimeTotal (Time::Zero),
+m_frameStatistics(),
+m_switchCount    (0),
+m_size           (0, 0)
 {
 
 }
@@ -53,10 +65,16 @@ m_size          (0, 0)
 
 ////////////////////////////////////////////////////////////
 Window::Window(VideoMode mode, const String& title, Uint32 style, const ContextSettings& settings) :
-m_impl          (NULL),
-m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
-m_size          (0, 0)
+m_impl           (NULL),
+m_context        (NULL),
+m_frameTimeLimit (Time::Zero),
+m_frameDeadline  (Time::Zero),
+m_frameEnd       (Time::Zero),
+m_sleepMargin    (Time::Zero),
+m_frameTimeTotal (Time::Zero),
+m_frameStatistics(),
+m_switchCount    (0),
+m_size           (0, 0)
 {
     create(mode, title, style, settings);
 }
@@ -64,10 +82,16 @@ m_size          (0, 0)
 
 ////////////////////////////////////////////////////////////
 Window::Window(WindowHandle handle, const ContextSettings& settings) :
-m_impl          (NULL),
-m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
-m_size          (0, 0)
+m_impl           (NULL),
+m_context        (NULL),
+m_frameTimeLimit (Time::Zero),
+m_frameDeadline  (Time::Zero),
+m_frameEnd       (Time::Zero),
+m_sleepMargin    (Time::Zero),
+m_frameTimeTotal (Time::Zero),
+m_frameStatistics(),
+m_switchCount    (0),
+m_size           (0, 0)
 {
     create(handle, settings);
 }
@@ -209,6 +233,29 @@ bool Window::waitEvent(Event& event)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Window::pollEvents(std::vector<Event>& events)
+{
+    events.clear();
+
+    if (!m_impl)
+        return false;
+
+    m_impl->popEvents(events);
+    for (std::vector<Event>::const_iterator it = events.begin(); it != events.end(); ++it)
+        filterEvent(*it);
+
+    return !events.empty();
+}
+
+
+////////////////////////////////////////////////////////////
+Time Window::getEventTime()
+{
+    return priv::WindowImpl::getEventTime();
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2i Window::getPosition() const
 {
@@ -280,6 +327,26 @@ void Window::setVerticalSyncEnabled(bool enabled)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Window::setSwapInterval(int interval)
+{
+    if (setActive())
+        return m_context->setSwapInterval(interval);
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Window::isSwapIntervalSupported(int interval) const
+{
+    if (setActive())
+        return m_context->isSwapIntervalSupported(interval);
+
+    return false;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Window::setMouseCursorVisible(bool visible)
 {
@@ -296,6 +363,22 @@ void Window::setKeyRepeatEnabled(bool enabled)
 }
 
 
+////////////////////////////////////////////////////////////
+void Window::setMouseRawInputEnabled(bool enabled)
+{
+    if (m_impl)
+        m_impl->setMouseRawInputEnabled(enabled);
+}
+
+
+////////////////////////////////////////////////////////////
+void Window::setMouseMoveCoalescingEnabled(bool enabled)
+{
+    if (m_impl)
+        m_impl->setMouseMoveCoalescingEnabled(enabled);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Window::setFramerateLimit(unsigned int limit)
 {
@@ -303,6 +386,9 @@ void Window::setFramerateLimit(unsigned int limit)
         m_frameTimeLimit = seconds(1.f / limit);
     else
         m_frameTimeLimit = Time::Zero;
+
+    // Start counting the frames from now
+    m_frameDeadline = m_clock.getElapsedTime();
 }
 
 
@@ -355,16 +441,57 @@ bool Window::hasFocus() const
 
 void Window::display()
 {
+    SFML_PROFILE_ZONE("Window::display");
+
     // Display the backbuffer on screen
     if (setActive())
         m_context->display();
 
     // Limit the framerate if needed
     if (m_frameTimeLimit != Time::Zero)
-    {
-        sleep(m_frameTimeLimit - m_clock.getElapsedTime());
-        m_clock.restart();
-    }
+        waitFrameDeadline();
+
+    // Update the frame statistics
+    Time now = m_clock.getElapsedTime();
+    Time frameTime = now - m_frameEnd;
+    m_frameEnd = now;
+
+    FrameStatistics& stats = m_frameStatistics;
+    stats.lastFrameTime = frameTime;
+    if (!stats.frameCount || (frameTime < stats.minFrameTime))
+        stats.minFrameTime = frameTime;
+    if (!stats.frameCount || (frameTime > stats.maxFrameTime))
+        stats.maxFrameTime = frameTime;
+    if ((m_frameTimeLimit != Time::Zero) && (frameTime > m_frameTimeLimit * 1.5f))
+        stats.missedFrames++;
+    stats.frameCount++;
+    m_frameTimeTotal += frameTime;
+    stats.averageFrameTime = m_frameTimeTotal / static_cast<Int64>(stats.frameCount);
+
+    Uint64 switchCount = priv::GlContext::getSwitchCount();
+    stats.contextSwitches = static_cast<Uint32>(switchCount - m_switchCount);
+    m_switchCount = switchCount;
+}
+
+
+////////////////////////////////////////////////////////////
+const Window::FrameStatistics& Window::getFrameStatistics() const
+{
+    return m_frameStatistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void Window::resetFrameStatistics()
+{
+    m_frameStatistics.lastFrameTime = Time::Zero;
+    m_frameStatistics.averageFrameTime = Time::Zero;
+    m_frameStatistics.minFrameTime = Time::Zero;
+    m_frameStatistics.maxFrameTime = Time::Zero;
+    m_frameStatistics.frameCount = 0;
+    m_frameStatistics.missedFrames = 0;
+    m_frameStatistics.contextSwitches = 0;
+    m_frameTimeTotal = Time::Zero;
 }
 
 
@@ -422,6 +549,11 @@ void Window::initialize()
 
     // Reset frame time
     m_clock.restart();
+    m_frameDeadline = Time::Zero;
+    m_frameEnd = Time::Zero;
+    m_sleepMargin = microseconds(minSleepMargin);
+    m_switchCount = priv::GlContext::getSwitchCount();
+    resetFrameStatistics();
 
     // Activate the window
     setActive();
@@ -430,4 +562,46 @@ void Window::initialize()
     onCreate();
 }
 
+
+////////////////////////////////////////////////////////////
+void Window::waitFrameDeadline()
+{
+    // The deadline advances by exactly one frame, so that the
+    // errors of the previous waits are compensated
+    m_frameDeadline += m_frameTimeLimit;
+
+    Time now = m_clock.getElapsedTime();
+    if (now >= m_frameDeadline)
+    {
+        // Don't try to catch up if we're more than one frame late
+        if (now - m_frameDeadline > m_frameTimeLimit)
+            m_frameDeadline = now;
+
+        return;
+    }
+
+    // Sleep for most of the remaining time...
+    Time remaining = m_frameDeadline - now;
+    if (remaining > m_sleepMargin)
+    {
+        Time requested = remaining - m_sleepMargin;
+        sleep(requested);
+
+        // ... and adapt the margin to how much the sleep overshot
+        Int64 overshoot = (m_clock.getElapsedTime() - now - requested).asMicroseconds();
+        Int64 margin = m_sleepMargin.asMicroseconds();
+        if (overshoot > margin)
+            margin = overshoot;
+        else
+            margin -= (margin - overshoot) / 16;
+
+        m_sleepMargin = microseconds(std::max(minSleepMargin, std::min(margin, maxSleepMargin)));
+    }
+
+    // ... then busy-wait for the rest
+    while (m_clock.getElapsedTime() < m_frameDeadline)
+    {
+    }
+}
+
 } // namespace sf
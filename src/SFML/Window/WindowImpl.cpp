@@ -29,6 +29,8 @@
 #include <SFML/Window/Event.hpp>
 #include <SFML/Window/JoystickManager.hpp>
 #include <SFML/Window/SensorManager.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Profiler.hpp>
 #include <SFML/System/Sleep.hpp>
 #include <algorithm>
 #include <cmath>
@@ -61,6 +63,20 @@
 #endif
 
 
+namespace
+{
+    // Number of events that the queue can hold before growing
+    const std::size_t initialEventCapacity = 64;
+
+    // Origin of the event timestamps, shared by all the windows
+    sf::Clock& getEventClock()
+    {
+        static sf::Clock clock;
+        return clock;
+    }
+}
+
+
 namespace sf
 {
 namespace priv
@@ -81,12 +97,18 @@ WindowImpl* WindowImpl::create(WindowHandle handle)
 
 ////////////////////////////////////////////////////////////
 WindowImpl::WindowImpl() :
-m_joystickThreshold(0.1f)
+m_events             (initialEventCapacity),
+m_eventsBegin        (0),
+m_eventCount         (0),
+m_joystickThreshold  (0.1f),
+m_joystickUpdateCount(0),
+m_coalesceMouseMoves (false)
 {
     // Get the initial joystick states
     JoystickManager::getInstance().update();
     for (unsigned int i = 0; i < Joystick::Count; ++i)
         m_joystickStates[i] = JoystickManager::getInstance().getState(i);
+    m_joystickUpdateCount = JoystickManager::getInstance().getUpdateCount();
 
     // Get the initial sensor states
     for (unsigned int i = 0; i < Sensor::Count; ++i)
@@ -108,26 +130,44 @@ void WindowImpl::setJoystickThreshold(float threshold)
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImpl::setMouseMoveCoalescingEnabled(bool enabled)
+{
+    m_coalesceMouseMoves = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::setMouseRawInputEnabled(bool /*enabled*/)
+{
+    // Not supported by default
+}
+
+
 ////////////////////////////////////////////////////////////
 bool WindowImpl::popEvent(Event& event, bool block)
 {
     // If the event queue is empty, let's first check if new events are available from the OS
-    if (m_events.empty())
+    if (!m_eventCount)
     {
         // Get events from the system
-        processJoystickEvents();
-        processSensorEvents();
-        processEvents();
+        {
+            SFML_PROFILE_ZONE("WindowImpl::processEvents");
+            processJoystickEvents();
+            processSensorEvents();
+            processEvents();
+        }
 
         // In blocking mode, we must process events until one is triggered
         if (block)
         {
-            // Here we use a manual wait loop instead of the optimized
-            // wait-event provided by the OS, so that we don't skip joystick
-            // events (which require polling)
-            while (m_events.empty())
+            // The platform wait must also wake up for the joystick
+            // and sensor events, which are generated here
+            while (!m_eventCount)
             {
-                sleep(milliseconds(10));
+                waitEvents();
+
+                SFML_PROFILE_ZONE("WindowImpl::processEvents");
                 processJoystickEvents();
                 processSensorEvents();
                 processEvents();
@@ -136,10 +176,11 @@ bool WindowImpl::popEvent(Event& event, bool block)
     }
 
     // Pop the first event of the queue, if it is not empty
-    if (!m_events.empty())
+    if (m_eventCount)
     {
-        event = m_events.front();
-        m_events.pop();
+        event = m_events[m_eventsBegin];
+        m_eventsBegin = (m_eventsBegin + 1) % m_events.size();
+        --m_eventCount;
 
         return true;
     }
@@ -148,10 +189,94 @@ bool WindowImpl::popEvent(Event& event, bool block)
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImpl::popEvents(std::vector<Event>& events)
+{
+    // If the event queue is empty, let's first check if new events are available from the OS
+    if (!m_eventCount)
+    {
+        SFML_PROFILE_ZONE("WindowImpl::processEvents");
+        processJoystickEvents();
+        processSensorEvents();
+        processEvents();
+    }
+
+    // Copy the ring buffer in two parts at most
+    std::size_t first = std::min(m_eventCount, m_events.size() - m_eventsBegin);
+    events.insert(events.end(), m_events.begin() + m_eventsBegin, m_events.begin() + m_eventsBegin + first);
+    events.insert(events.end(), m_events.begin(), m_events.begin() + (m_eventCount - first));
+
+    m_eventsBegin = 0;
+    m_eventCount = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+Time WindowImpl::getEventTime()
+{
+    return getEventClock().getElapsedTime();
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::waitEvents()
+{
+    sleep(milliseconds(10));
+}
+
+
 ////////////////////////////////////////////////////////////
 void WindowImpl::pushEvent(const Event& event)
 {
-    m_events.push(event);
+    pushEvent(event, getEventTime());
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::pushEvent(const Event& event, Time timestamp)
+{
+    // Merge the mouse moves into the last one of the same type, as long as
+    // only mouse moves were queued after it (the two types can interleave)
+    if (m_coalesceMouseMoves && ((event.type == Event::MouseMoved) || (event.type == Event::MouseMovedRaw)))
+    {
+        for (std::size_t i = m_eventCount; i > 0; --i)
+        {
+            Event& queued = m_events[(m_eventsBegin + i - 1) % m_events.size()];
+
+            if (queued.type == event.type)
+            {
+                if (event.type == Event::MouseMoved)
+                {
+                    queued.mouseMove = event.mouseMove;
+                }
+                else
+                {
+                    queued.mouseMoveRaw.deltaX += event.mouseMoveRaw.deltaX;
+                    queued.mouseMoveRaw.deltaY += event.mouseMoveRaw.deltaY;
+                }
+                queued.timestamp = timestamp;
+                return;
+            }
+
+            if ((queued.type != Event::MouseMoved) && (queued.type != Event::MouseMovedRaw))
+                break;
+        }
+    }
+
+    // Grow the ring buffer when it is full, keeping the events in order
+    if (m_eventCount == m_events.size())
+    {
+        std::vector<Event> events(m_events.size() * 2);
+        std::copy(m_events.begin() + m_eventsBegin, m_events.end(), events.begin());
+        std::copy(m_events.begin(), m_events.begin() + m_eventsBegin, events.begin() + (m_events.size() - m_eventsBegin));
+        m_events.swap(events);
+        m_eventsBegin = 0;
+    }
+
+    Event& slot = m_events[(m_eventsBegin + m_eventCount) % m_events.size()];
+    slot = event;
+    slot.timestamp = timestamp;
+    ++m_eventCount;
 }
 
 
@@ -161,6 +286,13 @@ void WindowImpl::processJoystickEvents()
     // First update the global joystick states
     JoystickManager::getInstance().update();
 
+    // Nothing to compare if the joysticks were not read since the last time
+    unsigned int updateCount = JoystickManager::getInstance().getUpdateCount();
+    if (updateCount == m_joystickUpdateCount)
+        return;
+
+    m_joystickUpdateCount = updateCount;
+
     for (unsigned int i = 0; i < Joystick::Count; ++i)
     {
         // Copy the previous state of the joystick and get the new one
@@ -39,8 +39,8 @@
 #include <SFML/Window/VideoMode.hpp>
 #include <SFML/Window/WindowHandle.hpp>
 #include <SFML/Window/ContextSettings.hpp>
-#include <queue>
 #include <set>
+#include <vector>
 
 namespace sf
 {
@@ -96,6 +96,14 @@ public:
     ////////////////////////////////////////////////////////////
     void setJoystickThreshold(float threshold);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the merging of consecutive mouse moves
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMouseMoveCoalescingEnabled(bool enabled);
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the next window event available
     ///
@@ -112,6 +120,25 @@ public:
     ////////////////////////////////////////////////////////////
     bool popEvent(Event& event, bool block);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return all the window events available
+    ///
+    /// If there's no event available, this function calls the
+    /// window's internal event processing function first.
+    ///
+    /// \param events Array to which the events are appended
+    ///
+    ////////////////////////////////////////////////////////////
+    void popEvents(std::vector<Event>& events);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current time on the clock of the event timestamps
+    ///
+    /// \return Current time
+    ///
+    ////////////////////////////////////////////////////////////
+    static Time getEventTime();
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the OS-specific handle of the window
     ///
@@ -194,6 +221,17 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setKeyRepeatEnabled(bool enabled) = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the raw mouse input
+    ///
+    /// The default implementation does nothing, for the
+    /// systems that have no raw mouse input.
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setMouseRawInputEnabled(bool enabled);
+
     ////////////////////////////////////////////////////////////
     /// \brief Request the current window to be made the active
     ///        foreground window
@@ -224,17 +262,44 @@ protected:
     /// notify the SFML window that a new event was triggered
     /// by the system.
     ///
+    /// The event is stamped with the current time.
+    ///
     /// \param event Event to push
     ///
     ////////////////////////////////////////////////////////////
     void pushEvent(const Event& event);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Push a new event into the event queue, with the time it happened
+    ///
+    /// This function is to be used by derived classes that
+    /// know when the system generated the event.
+    ///
+    /// \param event     Event to push
+    /// \param timestamp Time of the event, on the clock of getEventTime
+    ///
+    ////////////////////////////////////////////////////////////
+    void pushEvent(const Event& event, Time timestamp);
+
     ////////////////////////////////////////////////////////////
     /// \brief Process incoming events from the operating system
     ///
     ////////////////////////////////////////////////////////////
     virtual void processEvents() = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until new events may be available
+    ///
+    /// This function is called by waitEvent when the event
+    /// queue is empty, before processing the events again.
+    /// Implementations return as soon as the system has new
+    /// window events, and often enough to catch the joystick
+    /// and sensor changes that can't be waited for.
+    /// The default implementation sleeps for 10 milliseconds.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void waitEvents();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -252,10 +317,14 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::queue<Event> m_events;                          ///< Queue of available events
-    JoystickState     m_joystickStates[Joystick::Count]; ///< Previous state of the joysticks
-    Vector3f          m_sensorValue[Sensor::Count];      ///< Previous value of the sensors
-    float             m_joystickThreshold;               ///< Joystick threshold (minimum motion for "move" event to be generated)
+    std::vector<Event> m_events;                          ///< Ring buffer of the available events
+    std::size_t        m_eventsBegin;                     ///< Index of the first available event in the ring buffer
+    std::size_t        m_eventCount;                      ///< Number of available events
+    JoystickState      m_joystickStates[Joystick::Count]; ///< Previous state of the joysticks
+    Vector3f           m_sensorValue[Sensor::Count];      ///< Previous value of the sensors
+    float              m_joystickThreshold;               ///< Joystick threshold (minimum motion for "move" event to be generated)
+    unsigned int       m_joystickUpdateCount;             ///< Update count of the joystick manager when the states were compared
+    bool               m_coalesceMouseMoves;              ///< Merge the consecutive mouse moves in the queue?
 };
 
 } // namespace priv
@@ -32,9 +32,44 @@
 #include <SFML/System/Sleep.hpp>
 #include <OpenGLES/EAGL.h>
 #include <OpenGLES/EAGLDrawable.h>
-#include <OpenGLES/ES1/glext.h>
 #include <QuartzCore/CAEAGLLayer.h>
 
+#if defined(SFML_OPENGL_ES2)
+
+    #include <OpenGLES/ES2/gl.h>
+    #include <OpenGLES/ES2/glext.h>
+
+    // Framebuffer objects are core in OpenGL ES 2, and lost their OES suffix
+    #define glBindFramebufferOES            glBindFramebuffer
+    #define glBindRenderbufferOES           glBindRenderbuffer
+    #define glCheckFramebufferStatusOES     glCheckFramebufferStatus
+    #define glDeleteFramebuffersOES         glDeleteFramebuffers
+    #define glDeleteRenderbuffersOES        glDeleteRenderbuffers
+    #define glFramebufferRenderbufferOES    glFramebufferRenderbuffer
+    #define glGenFramebuffersOES            glGenFramebuffers
+    #define glGenRenderbuffersOES           glGenRenderbuffers
+    #define glGetRenderbufferParameterivOES glGetRenderbufferParameteriv
+    #define glRenderbufferStorageOES        glRenderbufferStorage
+    #define GL_COLOR_ATTACHMENT0_OES        GL_COLOR_ATTACHMENT0
+    #define GL_DEPTH_ATTACHMENT_OES         GL_DEPTH_ATTACHMENT
+    #define GL_DEPTH_COMPONENT16_OES        GL_DEPTH_COMPONENT16
+    #define GL_FRAMEBUFFER_COMPLETE_OES     GL_FRAMEBUFFER_COMPLETE
+    #define GL_FRAMEBUFFER_OES              GL_FRAMEBUFFER
+    #define GL_RENDERBUFFER_HEIGHT_OES      GL_RENDERBUFFER_HEIGHT
+    #define GL_RENDERBUFFER_OES             GL_RENDERBUFFER
+    #define GL_RENDERBUFFER_WIDTH_OES       GL_RENDERBUFFER_WIDTH
+    #define GL_STENCIL_ATTACHMENT_OES       GL_STENCIL_ATTACHMENT
+
+    #define SFML_EAGL_API kEAGLRenderingAPIOpenGLES2
+
+#else
+
+    #include <OpenGLES/ES1/glext.h>
+
+    #define SFML_EAGL_API kEAGLRenderingAPIOpenGLES1
+
+#endif
+
 
 namespace sf
 {
@@ -51,9 +86,9 @@ m_clock       ()
 {
     // Create the context
     if (shared)
-        m_context = [[EAGLContext alloc] initWithAPI:kEAGLRenderingAPIOpenGLES1 sharegroup:[shared->m_context sharegroup]];
+        m_context = [[EAGLContext alloc] initWithAPI:SFML_EAGL_API sharegroup:[shared->m_context sharegroup]];
     else
-        m_context = [[EAGLContext alloc] initWithAPI:kEAGLRenderingAPIOpenGLES1];
+        m_context = [[EAGLContext alloc] initWithAPI:SFML_EAGL_API];
 }
 
 
@@ -215,9 +250,9 @@ void EaglContext::createContext(EaglContext* shared,
 
     // Create the context
     if (shared)
-        m_context = [[EAGLContext alloc] initWithAPI:kEAGLRenderingAPIOpenGLES1 sharegroup:[shared->m_context sharegroup]];
+        m_context = [[EAGLContext alloc] initWithAPI:SFML_EAGL_API sharegroup:[shared->m_context sharegroup]];
     else
-        m_context = [[EAGLContext alloc] initWithAPI:kEAGLRenderingAPIOpenGLES1];
+        m_context = [[EAGLContext alloc] initWithAPI:SFML_EAGL_API];
 
     // Activate it
     makeCurrent();
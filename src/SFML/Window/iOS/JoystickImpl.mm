@@ -54,6 +54,14 @@ bool JoystickImpl::isConnected(unsigned int index)
 }
 
 
+////////////////////////////////////////////////////////////
+bool JoystickImpl::isUpdateNeeded()
+{
+    // Not implemented
+    return false;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool JoystickImpl::open(unsigned int index)
 {
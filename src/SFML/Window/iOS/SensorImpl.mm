@@ -93,30 +93,7 @@ bool SensorImpl::open(Sensor::Type sensor)
     m_enabled = false;
 
     // Set the refresh rate (use the maximum allowed)
-    static const NSTimeInterval updateInterval = 1. / 60.;
-    switch (sensor)
-    {
-        case Sensor::Accelerometer:
-            [SFAppDelegate getInstance].motionManager.accelerometerUpdateInterval = updateInterval;
-            break;
-
-        case Sensor::Gyroscope:
-            [SFAppDelegate getInstance].motionManager.gyroUpdateInterval = updateInterval;
-            break;
-
-        case Sensor::Magnetometer:
-            [SFAppDelegate getInstance].motionManager.magnetometerUpdateInterval = updateInterval;
-            break;
-
-        case Sensor::Gravity:
-        case Sensor::UserAcceleration:
-        case Sensor::Orientation:
-            [SFAppDelegate getInstance].motionManager.deviceMotionUpdateInterval = updateInterval;
-            break;
-
-        default:
-            break;
-    }
+    setRate(Time::Zero, Time::Zero);
 
     return true;
 }
@@ -237,6 +214,38 @@ void SensorImpl::setEnabled(bool enabled)
     m_enabled = enabled;
 }
 
+
+////////////////////////////////////////////////////////////
+void SensorImpl::setRate(Time interval, Time /*maxReportLatency*/)
+{
+    // Core Motion doesn't batch samples, only the interval can be controlled;
+    // a zero interval selects the maximum rate we allow
+    NSTimeInterval updateInterval = interval > Time::Zero ? interval.asSeconds() : 1. / 60.;
+    switch (m_sensor)
+    {
+        case Sensor::Accelerometer:
+            [SFAppDelegate getInstance].motionManager.accelerometerUpdateInterval = updateInterval;
+            break;
+
+        case Sensor::Gyroscope:
+            [SFAppDelegate getInstance].motionManager.gyroUpdateInterval = updateInterval;
+            break;
+
+        case Sensor::Magnetometer:
+            [SFAppDelegate getInstance].motionManager.magnetometerUpdateInterval = updateInterval;
+            break;
+
+        case Sensor::Gravity:
+        case Sensor::UserAcceleration:
+        case Sensor::Orientation:
+            [SFAppDelegate getInstance].motionManager.deviceMotionUpdateInterval = updateInterval;
+            break;
+
+        default:
+            break;
+    }
+}
+
 } // namespace priv
 
 } // namespace sf